@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks SQL expressions read from a file over fuzzed inputs in several
+// encodings and null ratios and writes the results as JSON. Example:
+//
+//  velox_expression_benchmark_runner \
+//      --expression_file=exprs.sql \
+//      --schema="struct<a:bigint,b:double,c:string>" \
+//      --encodings=flat,dictionary --null_ratios=0,0.5 \
+//      --output=results.json
+//
+// exprs.sql has one expression per line. Empty lines and lines starting with
+// '#' are ignored.
+
+#include <array>
+#include <fstream>
+#include <iostream>
+
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "velox/common/time/CpuWallTimer.h"
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/type/fbhive/HiveTypeParser.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_string(
+    expression_file,
+    "",
+    "File with one SQL expression per line to benchmark");
+
+DEFINE_string(
+    schema,
+    "",
+    "Input row type in Hive syntax, e.g. struct<a:bigint,b:string>");
+
+DEFINE_string(
+    encodings,
+    "flat,dictionary,constant",
+    "Comma separated encodings of the input columns. One of flat, dictionary "
+    "and constant");
+
+DEFINE_string(
+    null_ratios,
+    "0,0.1,0.5",
+    "Comma separated ratios of nulls in the input columns");
+
+DEFINE_int32(batch_size, 10'000, "Number of rows in each input batch");
+
+DEFINE_int32(iterations, 100, "Number of evaluations of each expression");
+
+DEFINE_int64(seed, 99887766, "Seed for the input data generator");
+
+DEFINE_bool(
+    perf_counters,
+    true,
+    "Count cycles, instructions and cache misses with perf_event_open() "
+    "where available");
+
+DEFINE_string(output, "", "File to write JSON results to. Stdout if empty");
+
+using namespace facebook::velox;
+
+namespace {
+
+// Counts hardware events of the calling thread with perf_event_open(). The
+// counters are not available in some containers and VMs, in which case they
+// are not reported.
+class PerfCounters {
+ public:
+  PerfCounters() {
+#ifdef __linux__
+    if (!FLAGS_perf_counters) {
+      return;
+    }
+    for (auto i = 0; i < kNumEvents; ++i) {
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = kEvents[i].config;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fds_[i] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+  }
+
+  ~PerfCounters() {
+#ifdef __linux__
+    for (auto fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    for (auto fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // Returns the counts since start() by event name.
+  folly::dynamic stop() {
+    folly::dynamic counts = folly::dynamic::object;
+#ifdef __linux__
+    for (auto i = 0; i < kNumEvents; ++i) {
+      if (fds_[i] < 0) {
+        continue;
+      }
+      ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t count;
+      if (read(fds_[i], &count, sizeof(count)) == sizeof(count)) {
+        counts[kEvents[i].name] = count;
+      }
+    }
+#endif
+    return counts;
+  }
+
+ private:
+  static constexpr int32_t kNumEvents = 4;
+
+#ifdef __linux__
+  struct Event {
+    const char* name;
+    uint64_t config;
+  };
+
+  static constexpr Event kEvents[kNumEvents] = {
+      {"cycles", PERF_COUNT_HW_CPU_CYCLES},
+      {"instructions", PERF_COUNT_HW_INSTRUCTIONS},
+      {"cacheMisses", PERF_COUNT_HW_CACHE_MISSES},
+      {"branchMisses", PERF_COUNT_HW_BRANCH_MISSES},
+  };
+#endif
+
+  std::array<int, kNumEvents> fds_{-1, -1, -1, -1};
+};
+
+std::vector<std::string> readExpressions(const std::string& path) {
+  std::ifstream in(path);
+  VELOX_USER_CHECK(in.good(), "Cannot open expression file: {}", path);
+  std::vector<std::string> expressions;
+  std::string line;
+  while (std::getline(in, line)) {
+    auto trimmed = folly::trimWhitespace(line);
+    if (trimmed.empty() || trimmed.front() == '#') {
+      continue;
+    }
+    expressions.emplace_back(trimmed);
+  }
+  return expressions;
+}
+
+template <typename T>
+std::vector<T> splitList(const std::string& list) {
+  std::vector<T> result;
+  folly::split(',', list, result);
+  return result;
+}
+
+class ExpressionBenchmarkRunner
+    : public functions::test::FunctionBenchmarkBase {
+ public:
+  ExpressionBenchmarkRunner() {
+    functions::prestosql::registerAllScalarFunctions();
+  }
+
+  folly::dynamic run(
+      const std::vector<std::string>& expressions,
+      const RowTypePtr& rowType) {
+    folly::dynamic results = folly::dynamic::array;
+    for (const auto& encoding : splitList<std::string>(FLAGS_encodings)) {
+      for (auto nullRatio : splitList<double>(FLAGS_null_ratios)) {
+        auto input = makeInput(rowType, encoding, nullRatio);
+        for (const auto& expression : expressions) {
+          auto result = runExpression(expression, input);
+          result["encoding"] = encoding;
+          result["nullRatio"] = nullRatio;
+          results.push_back(std::move(result));
+        }
+      }
+    }
+    return results;
+  }
+
+ private:
+  RowVectorPtr makeInput(
+      const RowTypePtr& rowType,
+      const std::string& encoding,
+      double nullRatio) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_batch_size;
+    options.nullRatio = nullRatio;
+    VectorFuzzer fuzzer(options, pool(), FLAGS_seed);
+
+    std::vector<VectorPtr> children;
+    for (const auto& type : rowType->children()) {
+      if (encoding == "flat") {
+        children.push_back(fuzzer.fuzzFlat(type));
+      } else if (encoding == "dictionary") {
+        children.push_back(fuzzer.fuzzDictionary(fuzzer.fuzzFlat(type)));
+      } else if (encoding == "constant") {
+        children.push_back(fuzzer.fuzzConstant(type));
+      } else {
+        VELOX_USER_FAIL("Unknown encoding: {}", encoding);
+      }
+    }
+    return std::make_shared<RowVector>(
+        pool(), rowType, nullptr, FLAGS_batch_size, std::move(children));
+  }
+
+  folly::dynamic runExpression(
+      const std::string& expression,
+      const RowVectorPtr& input) {
+    auto exprSet = compileExpression(expression, input->type());
+    SelectivityVector rows(input->size());
+    exec::EvalCtx evalCtx(&execCtx_, &exprSet, input.get());
+    std::vector<VectorPtr> results(1);
+
+    // Warm up, e.g. allocate the result and any memoized state.
+    exprSet.eval(rows, evalCtx, results);
+
+    CpuWallTiming timing;
+    PerfCounters counters;
+    counters.start();
+    {
+      CpuWallTimer timer(timing);
+      for (auto i = 0; i < FLAGS_iterations; ++i) {
+        exprSet.eval(rows, evalCtx, results);
+      }
+    }
+    auto counts = counters.stop();
+
+    const auto numRows = static_cast<double>(input->size()) * FLAGS_iterations;
+    folly::dynamic result = folly::dynamic::object;
+    result["expression"] = expression;
+    result["compiled"] = exprSet.toString();
+    result["iterations"] = FLAGS_iterations;
+    result["batchSize"] = input->size();
+    result["wallNanos"] = timing.wallNanos;
+    result["cpuNanos"] = timing.cpuNanos;
+    result["wallNanosPerRow"] = timing.wallNanos / numRows;
+    result["cpuNanosPerRow"] = timing.cpuNanos / numRows;
+    for (auto& [name, count] : counts.items()) {
+      result[name.asString() + "PerRow"] = count.asInt() / numRows;
+    }
+    result["perfCounters"] = std::move(counts);
+    return result;
+  }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  VELOX_USER_CHECK(
+      !FLAGS_expression_file.empty(), "--expression_file is empty");
+  VELOX_USER_CHECK(!FLAGS_schema.empty(), "--schema is empty");
+  auto rowType = asRowType(type::fbhive::HiveTypeParser().parse(FLAGS_schema));
+  VELOX_USER_CHECK_NOT_NULL(rowType, "--schema must be a struct");
+
+  ExpressionBenchmarkRunner runner;
+  auto results = runner.run(readExpressions(FLAGS_expression_file), rowType);
+  auto json = folly::toPrettyJson(results);
+  if (FLAGS_output.empty()) {
+    std::cout << json << std::endl;
+  } else {
+    std::ofstream out(FLAGS_output);
+    out << json << std::endl;
+  }
+  return 0;
+}
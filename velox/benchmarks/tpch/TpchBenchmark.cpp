@@ -19,6 +19,7 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
@@ -34,6 +35,7 @@
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TpchQueryBuilder.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -105,6 +107,10 @@ DEFINE_int32(
     run_query_verbose,
     -1,
     "Run a given query and print execution statistics");
+DEFINE_bool(
+    run_all_queries_verbose,
+    false,
+    "Run all TPC-H queries and print execution statistics for each");
 DEFINE_int32(
     io_meter_column_pct,
     0,
@@ -175,6 +181,25 @@ DEFINE_int32(
     512 << 10,
     "Maximum distance in bytes in which coalesce will combine requests");
 
+DEFINE_bool(
+    enable_spill,
+    false,
+    "Enables spilling of aggregations, hash joins and order bys");
+DEFINE_string(
+    spill_path,
+    "",
+    "Directory for spill files with --enable_spill. A temporary directory "
+    "is used if empty");
+DEFINE_int64(
+    spill_memory_threshold_mb,
+    0,
+    "MB of memory an aggregation, hash join or order by can use before "
+    "spilling with --enable_spill. 0 means no limit");
+DEFINE_int64(
+    query_memory_mb,
+    0,
+    "Memory limit of a query in MB. 0 means no limit");
+
 DEFINE_int32(
     parquet_prefetch_rowgroups,
     1,
@@ -250,6 +275,11 @@ class TpchBenchmark {
 
     ioExecutor_ =
         std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::thread::hardware_concurrency());
+    if (FLAGS_spill_path.empty()) {
+      tempSpillDirectory_ = TempDirectoryPath::create();
+    }
 
     // Add new values into the hive configuration...
     auto configurationValues = std::unordered_map<std::string, std::string>();
@@ -270,7 +300,36 @@ class TpchBenchmark {
   }
 
   void shutdown() {
-    cache_->shutdown();
+    if (cache_) {
+      cache_->shutdown();
+    }
+  }
+
+  // Makes a QueryCtx with the memory limit and spill settings of the flags.
+  std::shared_ptr<core::QueryCtx> makeQueryCtx() {
+    std::unordered_map<std::string, std::string> config;
+    if (FLAGS_enable_spill) {
+      const auto threshold =
+          std::to_string(FLAGS_spill_memory_threshold_mb << 20);
+      config[core::QueryConfig::kSpillEnabled] = "true";
+      config[core::QueryConfig::kAggregationSpillMemoryThreshold] = threshold;
+      config[core::QueryConfig::kJoinSpillMemoryThreshold] = threshold;
+      config[core::QueryConfig::kOrderBySpillMemoryThreshold] = threshold;
+    }
+    static std::atomic<uint64_t> queryId{0};
+    const auto id = fmt::format("TpchBenchmark_{}", queryId++);
+    auto pool = memory::defaultMemoryManager().addRootPool(
+        core::QueryCtx::generatePoolName(id),
+        FLAGS_query_memory_mb > 0 ? FLAGS_query_memory_mb << 20
+                                  : memory::kMaxMemory);
+    return std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        core::QueryConfig(std::move(config)),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        cache::AsyncDataCache::getInstance(),
+        std::move(pool),
+        nullptr,
+        id);
   }
 
   std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
@@ -281,6 +340,12 @@ class TpchBenchmark {
         CursorParameters params;
         params.maxDrivers = FLAGS_num_drivers;
         params.planNode = tpchPlan.plan;
+        params.queryCtx = makeQueryCtx();
+        if (FLAGS_enable_spill) {
+          params.spillDirectory = FLAGS_spill_path.empty()
+              ? tempSpillDirectory_->path
+              : FLAGS_spill_path;
+        }
         const int numSplitsPerFile = FLAGS_num_splits_per_file;
 
         bool noMoreSplits = false;
@@ -313,46 +378,74 @@ class TpchBenchmark {
   }
 
   void runMain(std::ostream& out, RunStats& runStats) {
-    if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
+    if (FLAGS_run_all_queries_verbose) {
+      for (auto queryId = 1; queryId <= 22; ++queryId) {
+        out << "Q" << queryId << std::endl;
+        runVerbose(queryBuilder->getQueryPlan(queryId), out, runStats);
+      }
+    } else if (
+        FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
     } else {
       const auto queryPlan = FLAGS_io_meter_column_pct > 0
           ? queryBuilder->getIoMeterPlan(FLAGS_io_meter_column_pct)
           : queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
-      auto [cursor, actualResults] = run(queryPlan);
-      if (!cursor) {
-        LOG(ERROR) << "Query terminated with error. Exiting";
-        exit(1);
-      }
-      auto task = cursor->task();
-      ensureTaskCompletion(task.get());
-      if (FLAGS_include_results) {
-        printResults(actualResults, out);
-        out << std::endl;
+      runVerbose(queryPlan, out, runStats);
+    }
+  }
+
+  // Runs 'queryPlan' and prints its execution statistics, with the time,
+  // memory and spilling of each operator, to 'out'. Adds the raw bytes read by
+  // the query to 'runStats'.
+  void runVerbose(
+      const TpchPlan& queryPlan,
+      std::ostream& out,
+      RunStats& runStats) {
+    auto [cursor, actualResults] = run(queryPlan);
+    if (!cursor) {
+      LOG(ERROR) << "Query terminated with error. Exiting";
+      exit(1);
+    }
+    auto task = cursor->task();
+    ensureTaskCompletion(task.get());
+    if (FLAGS_include_results) {
+      printResults(actualResults, out);
+      out << std::endl;
+    }
+    const auto stats = task->taskStats();
+    int64_t rawInputBytes = 0;
+    uint64_t spilledBytes = 0;
+    uint64_t spilledRows = 0;
+    for (auto& pipeline : stats.pipelineStats) {
+      auto& first = pipeline.operatorStats[0];
+      if (first.operatorType == "TableScan") {
+        rawInputBytes += first.rawInputBytes;
       }
-      const auto stats = task->taskStats();
-      int64_t rawInputBytes = 0;
-      for (auto& pipeline : stats.pipelineStats) {
-        auto& first = pipeline.operatorStats[0];
-        if (first.operatorType == "TableScan") {
-          rawInputBytes += first.rawInputBytes;
-        }
+      for (const auto& operatorStats : pipeline.operatorStats) {
+        spilledBytes += operatorStats.spilledBytes;
+        spilledRows += operatorStats.spilledRows;
       }
-      runStats.rawInputBytes = rawInputBytes;
-      out << fmt::format(
-                 "Execution time: {}",
-                 succinctMillis(
-                     stats.executionEndTimeMs - stats.executionStartTimeMs))
-          << std::endl;
-      out << fmt::format(
-                 "Splits total: {}, finished: {}",
-                 stats.numTotalSplits,
-                 stats.numFinishedSplits)
-          << std::endl;
-      out << printPlanWithStats(
-                 *queryPlan.plan, stats, FLAGS_include_custom_stats)
-          << std::endl;
     }
+    runStats.rawInputBytes += rawInputBytes;
+    out << fmt::format(
+               "Execution time: {}",
+               succinctMillis(
+                   stats.executionEndTimeMs - stats.executionStartTimeMs))
+        << std::endl;
+    out << fmt::format(
+               "Splits total: {}, finished: {}",
+               stats.numTotalSplits,
+               stats.numFinishedSplits)
+        << std::endl;
+    out << fmt::format(
+               "Peak memory: {}, spilled: {} ({} rows)",
+               succinctBytes(task->pool()->peakBytes()),
+               succinctBytes(spilledBytes),
+               spilledRows)
+        << std::endl;
+    out << printPlanWithStats(
+               *queryPlan.plan, stats, FLAGS_include_custom_stats)
+        << std::endl;
   }
 
   void readCombinations() {
@@ -470,6 +563,8 @@ class TpchBenchmark {
   }
 
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<TempDirectoryPath> tempSpillDirectory_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
   std::shared_ptr<cache::AsyncDataCache> cache_;
@@ -487,11 +582,21 @@ BENCHMARK(q1) {
   benchmark.run(planContext);
 }
 
+BENCHMARK(q2) {
+  const auto planContext = queryBuilder->getQueryPlan(2);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q3) {
   const auto planContext = queryBuilder->getQueryPlan(3);
   benchmark.run(planContext);
 }
 
+BENCHMARK(q4) {
+  const auto planContext = queryBuilder->getQueryPlan(4);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q5) {
   const auto planContext = queryBuilder->getQueryPlan(5);
   benchmark.run(planContext);
@@ -522,6 +627,11 @@ BENCHMARK(q10) {
   benchmark.run(planContext);
 }
 
+BENCHMARK(q11) {
+  const auto planContext = queryBuilder->getQueryPlan(11);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q12) {
   const auto planContext = queryBuilder->getQueryPlan(12);
   benchmark.run(planContext);
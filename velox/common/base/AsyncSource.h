@@ -65,6 +65,7 @@ class AsyncSource {
       exception_ = std::current_exception();
     }
     std::unique_ptr<ContinuePromise> promise;
+    std::vector<ContinuePromise> readyPromises;
     {
       std::lock_guard<std::mutex> l(mutex_);
       VELOX_CHECK_NULL(item_);
@@ -73,10 +74,14 @@ class AsyncSource {
       }
       making_ = false;
       promise.swap(promise_);
+      readyPromises.swap(readyPromises_);
     }
     if (promise != nullptr) {
       promise->setValue();
     }
+    for (auto& readyPromise : readyPromises) {
+      readyPromise.setValue();
+    }
   }
 
   // Returns the item to the first caller and nullptr to subsequent callers. If
@@ -130,6 +135,19 @@ class AsyncSource {
     return std::move(item_);
   }
 
+  // Returns true if prepare() is making the item and sets 'future' to be
+  // realized when it is done. Lets a consumer wait for the item without
+  // blocking a thread in move().
+  bool isPreparing(ContinueFuture& future) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!making_) {
+      return false;
+    }
+    readyPromises_.emplace_back("AsyncSource::isPreparing");
+    future = readyPromises_.back().getSemiFuture();
+    return true;
+  }
+
   // If true, move() will not block. But there is no guarantee that somebody
   // else will not get the item first.
   bool hasValue() const {
@@ -149,6 +167,8 @@ class AsyncSource {
   // True if 'prepare() is making the item.
   bool making_{false};
   std::unique_ptr<ContinuePromise> promise_;
+  // Promises of the futures from isPreparing().
+  std::vector<ContinuePromise> readyPromises_;
   std::unique_ptr<Item> item_;
   std::function<std::unique_ptr<Item>()> make_;
   std::exception_ptr exception_;
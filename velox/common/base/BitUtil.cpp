@@ -19,8 +19,46 @@
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/process/ProcessBase.h"
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 namespace facebook::velox::bits {
 
+namespace {
+#ifdef __x86_64__
+// Compiled for AVX-512 regardless of the build flags. Called only after
+// process::hasAvx512Popcnt().
+__attribute__((target("avx512f,avx512vpopcntdq"))) int64_t
+countWordBitsAvx512(const uint64_t* words, int32_t numWords) {
+  __m512i counts = _mm512_setzero_si512();
+  int32_t i = 0;
+  for (; i + 8 <= numWords; i += 8) {
+    counts = _mm512_add_epi64(
+        counts, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+  }
+  int64_t count = _mm512_reduce_add_epi64(counts);
+  for (; i < numWords; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+#endif
+} // namespace
+
+int64_t countWordBits(const uint64_t* words, int32_t numWords) {
+#ifdef __x86_64__
+  if (process::hasAvx512Popcnt()) {
+    return countWordBitsAvx512(words, numWords);
+  }
+#endif
+  int64_t count = 0;
+  for (int32_t i = 0; i < numWords; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
 namespace {
 // Naive implementation that does not rely on BMI2.
 void scatterBitsSimple(
@@ -315,7 +315,23 @@ inline void fillBits(uint64_t* bits, int32_t begin, int32_t end, bool value) {
       [bits, value](int32_t idx) { bits[idx] = value ? -1 : 0; });
 }
 
+/// Returns the number of set bits in the 'numWords' words at 'words'. Uses
+/// AVX-512 VPOPCNTDQ if the host has it, also in builds for older
+/// architectures.
+int64_t countWordBits(const uint64_t* words, int32_t numWords);
+
+/// Number of bits from which countBits() counts the full words with
+/// countWordBits().
+constexpr int32_t kMinBitsForCountWordBits = 1024;
+
 inline int32_t countBits(const uint64_t* bits, int32_t begin, int32_t end) {
+  if (end - begin >= kMinBitsForCountWordBits) {
+    const int32_t firstWord = roundUp(begin, 64) / 64;
+    const int32_t lastWord = end / 64;
+    return countBits(bits, begin, firstWord * 64) +
+        countWordBits(bits + firstWord, lastWord - firstWord) +
+        countBits(bits, lastWord * 64, end);
+  }
   int32_t count = 0;
   forEachWord(
       begin,
@@ -24,6 +24,42 @@ void registerVeloxCounters() {
   // P50, P90, P99, and P100.
   REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
       kCounterHiveFileHandleGenerateLatencyMs, 10, 0, 100000, 50, 90, 99, 100);
+
+  // Track the in-memory bytes spilled per spill run in range of [0, 4GB] with
+  // 32MB buckets and reports P50, P90, P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterSpillRunBytes, 32L << 20, 0, 4L << 30, 50, 90, 99, 100);
+
+  // Track the number of streams merged from spilled data in range of [0, 1024]
+  // and reports P50, P90, P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterSpillMergeFanIn, 8, 0, 1024, 50, 90, 99, 100);
+
+  // The spill write and read times tell whether spilling is bound by CPU
+  // (serialization, flush with compression) or by the storage.
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillSerializationTimeUs, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillFlushTimeUs, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillWriteTimeUs, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillFileCloseTimeUs, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillReadTimeUs, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillReadWaitTimeUs, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterSpillReadBytes, facebook::velox::StatType::SUM);
+
+  // Lookups of regular expressions with non-constant patterns in the
+  // process-wide cache of compiled expressions.
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterRegexCacheHits, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterRegexCacheMisses, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterRegexCacheEvictions, facebook::velox::StatType::SUM);
 }
 
 } // namespace facebook::velox
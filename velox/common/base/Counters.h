@@ -25,4 +25,58 @@ void registerVeloxCounters();
 
 constexpr folly::StringPiece kCounterHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
+
+constexpr folly::StringPiece kCounterSpillRunBytes{"velox.spill_run_bytes"};
+
+constexpr folly::StringPiece kCounterSpillSerializationTimeUs{
+    "velox.spill_serialization_time_us"};
+
+constexpr folly::StringPiece kCounterSpillFlushTimeUs{
+    "velox.spill_flush_time_us"};
+
+constexpr folly::StringPiece kCounterSpillWriteTimeUs{
+    "velox.spill_write_time_us"};
+
+constexpr folly::StringPiece kCounterSpillFileCloseTimeUs{
+    "velox.spill_file_close_time_us"};
+
+constexpr folly::StringPiece kCounterSpillReadTimeUs{
+    "velox.spill_read_time_us"};
+
+constexpr folly::StringPiece kCounterSpillReadWaitTimeUs{
+    "velox.spill_read_wait_time_us"};
+
+constexpr folly::StringPiece kCounterSpillReadBytes{"velox.spill_read_bytes"};
+
+constexpr folly::StringPiece kCounterSpillMergeFanIn{
+    "velox.spill_merge_fan_in"};
+
+constexpr folly::StringPiece kCounterRegexCacheHits{"velox.regex_cache_hits"};
+
+constexpr folly::StringPiece kCounterRegexCacheMisses{
+    "velox.regex_cache_misses"};
+
+constexpr folly::StringPiece kCounterRegexCacheEvictions{
+    "velox.regex_cache_evictions"};
+
+// The metrics below are recorded with the MetricCounter and MetricHistogram of
+// Metrics.h and reach the StatsReporter through exportMetrics().
+constexpr folly::StringPiece kCounterMemoryCacheHits{
+    "velox.memory_cache_hits"};
+
+constexpr folly::StringPiece kCounterMemoryCacheMisses{
+    "velox.memory_cache_misses"};
+
+constexpr folly::StringPiece kCounterExchangePageBytes{
+    "velox.exchange_page_bytes"};
+
+constexpr folly::StringPiece kCounterArbitrationQueueTimeMs{
+    "velox.arbitration_queue_time_ms"};
+
+constexpr folly::StringPiece kCounterArbitrationTimeMs{
+    "velox.arbitration_time_ms"};
+
+// Prefix of the per operator type counters, e.g.
+// velox.operator.HashBuild.input_rows.
+constexpr folly::StringPiece kCounterOperatorPrefix{"velox.operator."};
 } // namespace facebook::velox
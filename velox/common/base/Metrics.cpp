@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/Metrics.h"
+
+#include <folly/Singleton.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+namespace detail {
+int32_t nextMetricShard() {
+  static std::atomic<int32_t> nextShard{0};
+  return nextShard.fetch_add(1, std::memory_order_relaxed) % kNumMetricShards;
+}
+} // namespace detail
+
+namespace {
+int32_t checkedNumBuckets(int64_t bucketWidth, int64_t min, int64_t max) {
+  VELOX_CHECK_GT(bucketWidth, 0);
+  VELOX_CHECK_LT(min, max);
+  // One bucket for each width plus one for 'max' and above.
+  return (max - min) / bucketWidth + 2;
+}
+
+struct MetricRegistry {
+  // Serializes registration and export.
+  std::mutex mutex;
+  std::unordered_set<Metric*> metrics;
+  // The metrics made by metricCounter().
+  std::unordered_map<std::string, std::unique_ptr<MetricCounter>> counters;
+};
+
+// Never destroyed so that static metrics can unregister at exit.
+MetricRegistry& registry() {
+  static auto* registry = new MetricRegistry();
+  return *registry;
+}
+} // namespace
+
+Metric::Metric(folly::StringPiece name) : name_(name.str()) {
+  auto& instance = registry();
+  std::lock_guard<std::mutex> l(instance.mutex);
+  instance.metrics.insert(this);
+}
+
+Metric::~Metric() {
+  auto& instance = registry();
+  std::lock_guard<std::mutex> l(instance.mutex);
+  instance.metrics.erase(this);
+}
+
+int64_t MetricCounter::read() const {
+  int64_t sum = 0;
+  for (const auto& cell : cells_) {
+    sum += cell.value.load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+void MetricCounter::addExportType(const BaseStatsReporter& reporter) const {
+  reporter.addStatExportType(folly::StringPiece(name()), statType_);
+}
+
+void MetricCounter::exportTo(const BaseStatsReporter& reporter) {
+  const auto value = read();
+  if (value != exported_) {
+    reporter.addStatValue(folly::StringPiece(name()), value - exported_);
+    exported_ = value;
+  }
+}
+
+MetricHistogram::MetricHistogram(
+    folly::StringPiece name,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    std::vector<int32_t> percentiles)
+    : Metric(name),
+      bucketWidth_(bucketWidth),
+      min_(min),
+      max_(max),
+      percentiles_(std::move(percentiles)),
+      numBuckets_(checkedNumBuckets(bucketWidth, min, max)),
+      bucketStride_(bits::roundUp(
+          numBuckets_,
+          folly::hardware_destructive_interference_size / sizeof(int64_t))),
+      cells_(std::make_unique<std::atomic<int64_t>[]>(
+          detail::kNumMetricShards * bucketStride_)),
+      exported_(numBuckets_) {}
+
+int64_t MetricHistogram::bucketCount(int32_t bucket) const {
+  VELOX_CHECK_LT(bucket, numBuckets_);
+  int64_t count = 0;
+  for (auto shard = 0; shard < detail::kNumMetricShards; ++shard) {
+    count += cells_[shard * bucketStride_ + bucket].load(
+        std::memory_order_relaxed);
+  }
+  return count;
+}
+
+void MetricHistogram::addExportType(const BaseStatsReporter& reporter) const {
+  reporter.addHistogramExportPercentiles(
+      folly::StringPiece(name()), bucketWidth_, min_, max_, percentiles_);
+}
+
+void MetricHistogram::exportTo(const BaseStatsReporter& reporter) {
+  for (auto bucket = 0; bucket < numBuckets_; ++bucket) {
+    const auto count = bucketCount(bucket);
+    if (count == exported_[bucket]) {
+      continue;
+    }
+    const int64_t value = bucket == numBuckets_ - 1
+        ? max_
+        : min_ + bucket * bucketWidth_;
+    reporter.addHistogramValues(
+        folly::StringPiece(name()),
+        std::max<int64_t>(0, value),
+        count - exported_[bucket]);
+    exported_[bucket] = count;
+  }
+}
+
+MetricCounter& metricCounter(const std::string& name, StatType statType) {
+  auto& instance = registry();
+  {
+    std::lock_guard<std::mutex> l(instance.mutex);
+    auto it = instance.counters.find(name);
+    if (it != instance.counters.end()) {
+      return *it->second;
+    }
+  }
+  // Made outside of the lock since the constructor registers the counter.
+  auto counter = std::make_unique<MetricCounter>(name, statType);
+  std::lock_guard<std::mutex> l(instance.mutex);
+  auto& entry = instance.counters[name];
+  if (entry == nullptr) {
+    entry = std::move(counter);
+  }
+  return *entry;
+}
+
+void exportMetrics(const BaseStatsReporter& reporter) {
+  auto& instance = registry();
+  std::lock_guard<std::mutex> l(instance.mutex);
+  for (auto* metric : instance.metrics) {
+    if (!metric->exportTypeAdded_) {
+      metric->addExportType(reporter);
+      metric->exportTypeAdded_ = true;
+    }
+    metric->exportTo(reporter);
+  }
+}
+
+void exportMetrics() {
+  if (!BaseStatsReporter::registered) {
+    return;
+  }
+  auto reporter = folly::Singleton<BaseStatsReporter>::try_get_fast();
+  if (reporter != nullptr) {
+    exportMetrics(*reporter);
+  }
+}
+
+MetricsExporter::MetricsExporter(std::chrono::milliseconds period)
+    : period_(period) {
+  VELOX_CHECK_GT(period_.count(), 0);
+  thread_ = std::thread([this]() {
+    std::unique_lock<std::mutex> l(mutex_);
+    while (!stopCv_.wait_for(l, period_, [&]() { return stop_; })) {
+      l.unlock();
+      exportMetrics();
+      l.lock();
+    }
+  });
+}
+
+MetricsExporter::~MetricsExporter() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stop_ = true;
+  }
+  stopCv_.notify_one();
+  thread_.join();
+  exportMetrics();
+}
+
+} // namespace facebook::velox
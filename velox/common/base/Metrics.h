@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Range.h>
+#include <folly/lang/Align.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "velox/common/base/StatsReporter.h"
+
+/// Metrics for hot paths. Recording a value is a relaxed atomic add on a
+/// cache line that is shared by few threads, with no lock and no call into
+/// the StatsReporter. exportMetrics() adds what was recorded since the
+/// previous export to the StatsReporter, so that the cost of reporting is paid
+/// once per export period instead of once per value. The metrics are meant to
+/// be static, e.g.
+///
+///   static MetricCounter hits(kCounterCacheHits);
+///   hits.add();
+namespace facebook::velox {
+
+namespace detail {
+// The number of cells of a metric. A thread always updates the same cell.
+constexpr int32_t kNumMetricShards = 16;
+
+int32_t nextMetricShard();
+
+// Returns the cell of a metric updated by the calling thread.
+inline int32_t metricShard() {
+  thread_local const int32_t shard = nextMetricShard();
+  return shard;
+}
+
+struct alignas(folly::hardware_destructive_interference_size) MetricCell {
+  std::atomic<int64_t> value{0};
+};
+} // namespace detail
+
+class Metric {
+ public:
+  /// Registers 'this' for export by exportMetrics().
+  explicit Metric(folly::StringPiece name);
+
+  virtual ~Metric();
+
+  Metric(const Metric&) = delete;
+  Metric& operator=(const Metric&) = delete;
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  /// Registers the export type of 'this' with 'reporter'. Called once before
+  /// the first export.
+  virtual void addExportType(const BaseStatsReporter& reporter) const = 0;
+
+  /// Adds the values recorded since the previous call to 'reporter'. Calls
+  /// are serialized by exportMetrics().
+  virtual void exportTo(const BaseStatsReporter& reporter) = 0;
+
+ private:
+  const std::string name_;
+
+  // Set by exportMetrics() after the export type is registered.
+  bool exportTypeAdded_{false};
+
+  friend void exportMetrics(const BaseStatsReporter& reporter);
+};
+
+/// A sum of values, e.g. rows processed or cache hits.
+class MetricCounter : public Metric {
+ public:
+  explicit MetricCounter(
+      folly::StringPiece name,
+      StatType statType = StatType::SUM)
+      : Metric(name), statType_(statType) {}
+
+  void add(int64_t value = 1) {
+    cells_[detail::metricShard()].value.fetch_add(
+        value, std::memory_order_relaxed);
+  }
+
+  /// Returns the sum of all the values added so far.
+  int64_t read() const;
+
+  void addExportType(const BaseStatsReporter& reporter) const override;
+
+  void exportTo(const BaseStatsReporter& reporter) override;
+
+ private:
+  const StatType statType_;
+  detail::MetricCell cells_[detail::kNumMetricShards];
+  // The value of read() at the previous export.
+  int64_t exported_{0};
+};
+
+/// Counts values in buckets of 'bucketWidth' between 'min' and 'max'. Values
+/// outside of the range count in the first or last bucket. The export reports
+/// the lower bound of a bucket for each value in the bucket.
+class MetricHistogram : public Metric {
+ public:
+  MetricHistogram(
+      folly::StringPiece name,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      std::vector<int32_t> percentiles);
+
+  void add(int64_t value) {
+    cells_[detail::metricShard() * bucketStride_ + bucketIndex(value)]
+        .fetch_add(1, std::memory_order_relaxed);
+  }
+
+  int32_t numBuckets() const {
+    return numBuckets_;
+  }
+
+  /// Returns the number of values recorded so far in 'bucket'.
+  int64_t bucketCount(int32_t bucket) const;
+
+  void addExportType(const BaseStatsReporter& reporter) const override;
+
+  void exportTo(const BaseStatsReporter& reporter) override;
+
+ private:
+  int32_t bucketIndex(int64_t value) const {
+    if (value <= min_) {
+      return 0;
+    }
+    if (value >= max_) {
+      return numBuckets_ - 1;
+    }
+    return (value - min_) / bucketWidth_;
+  }
+
+  const int64_t bucketWidth_;
+  const int64_t min_;
+  const int64_t max_;
+  const std::vector<int32_t> percentiles_;
+  const int32_t numBuckets_;
+  // Distance between the buckets of consecutive shards in 'cells_'. A
+  // multiple of a cache line so that the shards do not share cache lines.
+  const int32_t bucketStride_;
+  std::unique_ptr<std::atomic<int64_t>[]> cells_;
+  // The bucket counts at the previous export.
+  std::vector<int64_t> exported_;
+};
+
+/// Returns the counter named 'name', making it on first use. For metrics with
+/// names known only at runtime, e.g. per operator type. Takes a lock, so hot
+/// paths should keep the returned reference.
+MetricCounter& metricCounter(
+    const std::string& name,
+    StatType statType = StatType::SUM);
+
+/// Adds the values recorded since the previous export of all the metrics to
+/// 'reporter'.
+void exportMetrics(const BaseStatsReporter& reporter);
+
+/// Exports to the process-wide BaseStatsReporter if there is one.
+void exportMetrics();
+
+/// Calls exportMetrics() every 'period' on a background thread until
+/// destroyed. The last values are exported on destruction.
+class MetricsExporter {
+ public:
+  explicit MetricsExporter(std::chrono::milliseconds period);
+
+  ~MetricsExporter();
+
+ private:
+  const std::chrono::milliseconds period_;
+  std::mutex mutex_;
+  std::condition_variable stopCv_;
+  bool stop_{false};
+  std::thread thread_;
+};
+
+} // namespace facebook::velox
@@ -1374,4 +1374,100 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+size_t
+simdStrstr(const char* s, size_t n, const char* needle, size_t k, const A&) {
+  if (k == 0) {
+    return 0;
+  }
+  if (k > n) {
+    return std::string_view::npos;
+  }
+  if (k == 1) {
+    auto* found = std::memchr(s, needle[0], n);
+    return found ? reinterpret_cast<const char*>(found) - s
+                 : std::string_view::npos;
+  }
+
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr size_t kBatch = Batch::size;
+  const Batch first(static_cast<uint8_t>(needle[0]));
+  const Batch last(static_cast<uint8_t>(needle[k - 1]));
+  auto* bytes = reinterpret_cast<const uint8_t*>(s);
+  size_t i = 0;
+  // Each iteration checks the candidate starts [i, i + kBatch).
+  for (; i + kBatch + k - 1 <= n; i += kBatch) {
+    const auto matchFirst = Batch::load_unaligned(bytes + i) == first;
+    const auto matchLast = Batch::load_unaligned(bytes + i + k - 1) == last;
+    uint64_t candidates = toBitMask(matchFirst && matchLast);
+    while (candidates) {
+      const auto offset = i + __builtin_ctzll(candidates);
+      if (std::memcmp(s + offset + 1, needle + 1, k - 2) == 0) {
+        return offset;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  for (; i + k <= n; ++i) {
+    if (s[i] == needle[0] && s[i + k - 1] == needle[k - 1] &&
+        std::memcmp(s + i + 1, needle + 1, k - 2) == 0) {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+template <typename A>
+bool isAscii(const char* data, size_t size, const A&) {
+  using Batch = xsimd::batch<uint8_t, A>;
+  auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  size_t i = 0;
+  if (size >= Batch::size) {
+    Batch bits(static_cast<uint8_t>(0));
+    for (; i + Batch::size <= size; i += Batch::size) {
+      bits |= Batch::load_unaligned(bytes + i);
+    }
+    if (toBitMask((bits & Batch(0x80)) != Batch(0)) != 0) {
+      return false;
+    }
+  }
+  uint64_t word = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t value;
+    std::memcpy(&value, bytes + i, sizeof(value));
+    word |= value;
+  }
+  for (; i < size; ++i) {
+    word |= bytes[i];
+  }
+  return (word & 0x8080808080808080ULL) == 0;
+}
+
+template <bool kUpper, typename A>
+void changeAsciiCase(
+    char* output,
+    const char* input,
+    size_t size,
+    const A&) {
+  using Batch = xsimd::batch<int8_t, A>;
+  // Bytes over 0x7f are negative and never in the range.
+  constexpr int8_t kFirst = kUpper ? 'a' : 'A';
+  constexpr int8_t kLast = kUpper ? 'z' : 'Z';
+  constexpr int8_t kShift = kUpper ? -32 : 32;
+  const Batch first(kFirst);
+  const Batch last(kLast);
+  const Batch shift(kShift);
+  size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    auto chars =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(input + i));
+    xsimd::select((chars >= first) && (chars <= last), chars + shift, chars)
+        .store_unaligned(reinterpret_cast<int8_t*>(output + i));
+  }
+  for (; i < size; ++i) {
+    const auto c = input[i];
+    output[i] = c >= kFirst && c <= kLast ? c + kShift : c;
+  }
+}
+
 } // namespace facebook::velox::simd
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <string_view>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 
@@ -430,6 +432,35 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of the 'k' bytes at 'needle' in
+// the 'n' bytes at 's' or std::string_view::npos if there is none. Compares
+// the first and last bytes of the needle at SIMD width positions at a time and
+// compares the rest only where both match. Does not read past the end of
+// either.
+template <typename A = xsimd::default_arch>
+size_t simdStrstr(
+    const char* s,
+    size_t n,
+    const char* needle,
+    size_t k,
+    const A& = {});
+
+// Returns true if none of the 'size' bytes at 'data' has the high bit set,
+// i.e. all are ASCII. ORs the bytes SIMD width at a time and checks the high
+// bits once at the end.
+template <typename A = xsimd::default_arch>
+bool isAscii(const char* data, size_t size, const A& = {});
+
+// Writes the 'size' bytes at 'input' to 'output' with ASCII lowercase letters
+// made uppercase if 'kUpper' and ASCII uppercase letters made lowercase
+// otherwise. Other bytes are copied as is. 'output' may be 'input'.
+template <bool kUpper, typename A = xsimd::default_arch>
+void changeAsciiCase(
+    char* output,
+    const char* input,
+    size_t size,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -109,6 +109,18 @@ class BaseStatsReporter {
   virtual void addHistogramValue(folly::StringPiece key, size_t value)
       const = 0;
 
+  /// Add 'count' times the given value to the histogram. Used for exporting
+  /// pre-aggregated histograms. Reporters that can add a count at once should
+  /// override this.
+  virtual void addHistogramValues(
+      folly::StringPiece key,
+      size_t value,
+      size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+      addHistogramValue(key, value);
+    }
+  }
+
   static bool registered;
 };
 
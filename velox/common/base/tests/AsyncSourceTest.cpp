@@ -47,6 +47,32 @@ TEST(AsyncSourceTest, basic) {
   EXPECT_TRUE(error.hasValue());
 }
 
+TEST(AsyncSourceTest, isPreparing) {
+  std::atomic<bool> making{false};
+  std::atomic<bool> release{false};
+  AsyncSource<Gizmo> gizmo([&]() {
+    making = true;
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+    }
+    return std::make_unique<Gizmo>(11);
+  });
+  ContinueFuture future;
+  EXPECT_FALSE(gizmo.isPreparing(future));
+
+  std::thread thread([&]() { gizmo.prepare(); });
+  while (!making) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+  }
+  EXPECT_TRUE(gizmo.isPreparing(future));
+  EXPECT_FALSE(future.isReady());
+  release = true;
+  thread.join();
+  EXPECT_TRUE(future.isReady());
+  EXPECT_FALSE(gizmo.isPreparing(future));
+  EXPECT_EQ(11, gizmo.move()->id);
+}
+
 TEST(AsyncSourceTest, threads) {
   constexpr int32_t kNumThreads = 10;
   constexpr int32_t kNumGizmos = 2000;
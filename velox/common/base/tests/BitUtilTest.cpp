@@ -27,6 +27,7 @@
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
 
+DECLARE_bool(avx512); // NOLINT
 DECLARE_bool(bmi2); // NOLINT
 
 namespace facebook {
@@ -115,6 +116,32 @@ TEST_F(BitUtilTest, countBits) {
   }
 }
 
+TEST_F(BitUtilTest, countBitsLongRanges) {
+  constexpr int32_t kNumWords = 200;
+  folly::Random::DefaultGenerator rng(1);
+  std::vector<uint64_t> data(kNumWords);
+  for (auto& word : data) {
+    word = folly::Random::rand64(rng);
+  }
+  constexpr int32_t kNumBits = kNumWords * 64;
+  for (auto avx512 : {false, true}) {
+    FLAGS_avx512 = avx512; // NOLINT
+    for (auto [begin, end] : std::vector<std::pair<int32_t, int32_t>>{
+             {0, kNumBits},
+             {1, kNumBits - 1},
+             {63, kMinBitsForCountWordBits + 65},
+             {64, kMinBitsForCountWordBits + 64},
+             {100, kNumBits - 200},
+             {kNumBits - kMinBitsForCountWordBits - 3, kNumBits}}) {
+      EXPECT_EQ(
+          countBits(data.data(), begin, end),
+          simpleCountBits(data.data(), begin, end))
+          << "avx512 " << avx512 << " begin " << begin << " end " << end;
+    }
+  }
+  FLAGS_avx512 = true; // NOLINT
+}
+
 TEST_F(BitUtilTest, reverseBits) {
   const unsigned char BitReverseTable256[] = {
       0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0,
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/Metrics.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace facebook::velox {
+namespace {
+
+class RecordingReporter : public DummyStatsReporter {
+ public:
+  mutable std::map<std::string, StatType> statTypes;
+  mutable std::map<std::string, std::vector<int32_t>> percentiles;
+  mutable std::map<std::string, size_t> values;
+  // Histogram key to value to count.
+  mutable std::map<std::string, std::map<size_t, size_t>> histograms;
+
+  void addStatExportType(folly::StringPiece key, StatType statType)
+      const override {
+    statTypes[key.str()] = statType;
+  }
+
+  void addHistogramExportPercentiles(
+      folly::StringPiece key,
+      int64_t /*bucketWidth*/,
+      int64_t /*min*/,
+      int64_t /*max*/,
+      const std::vector<int32_t>& pcts) const override {
+    percentiles[key.str()] = pcts;
+  }
+
+  void addStatValue(folly::StringPiece key, size_t value) const override {
+    values[key.str()] += value;
+  }
+
+  void addHistogramValues(folly::StringPiece key, size_t value, size_t count)
+      const override {
+    histograms[key.str()][value] += count;
+  }
+};
+
+TEST(MetricsTest, counter) {
+  MetricCounter counter("test.counter");
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 8; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < 10'000; ++j) {
+        counter.add(2);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(160'000, counter.read());
+
+  RecordingReporter reporter;
+  exportMetrics(reporter);
+  EXPECT_EQ(StatType::SUM, reporter.statTypes["test.counter"]);
+  EXPECT_EQ(160'000, reporter.values["test.counter"]);
+
+  // Only the values added since the previous export are reported.
+  counter.add(5);
+  exportMetrics(reporter);
+  EXPECT_EQ(160'005, reporter.values["test.counter"]);
+  reporter.values.clear();
+  exportMetrics(reporter);
+  EXPECT_EQ(0, reporter.values.count("test.counter"));
+}
+
+TEST(MetricsTest, histogram) {
+  MetricHistogram histogram("test.histogram", 10, 0, 100, {50, 99});
+  EXPECT_EQ(12, histogram.numBuckets());
+  for (auto value : {-5, 0, 5, 15, 15, 99, 100, 1'000}) {
+    histogram.add(value);
+  }
+  EXPECT_EQ(3, histogram.bucketCount(0));
+  EXPECT_EQ(2, histogram.bucketCount(1));
+  EXPECT_EQ(1, histogram.bucketCount(9));
+  EXPECT_EQ(2, histogram.bucketCount(11));
+
+  RecordingReporter reporter;
+  exportMetrics(reporter);
+  EXPECT_EQ(
+      std::vector<int32_t>({50, 99}), reporter.percentiles["test.histogram"]);
+  std::map<size_t, size_t> expected = {{0, 3}, {10, 2}, {90, 1}, {100, 2}};
+  EXPECT_EQ(expected, reporter.histograms["test.histogram"]);
+
+  histogram.add(12);
+  reporter.histograms.clear();
+  exportMetrics(reporter);
+  expected = {{10, 1}};
+  EXPECT_EQ(expected, reporter.histograms["test.histogram"]);
+}
+
+TEST(MetricsTest, namedCounter) {
+  auto& counter = metricCounter("test.named");
+  EXPECT_EQ(&counter, &metricCounter("test.named"));
+  counter.add(3);
+  EXPECT_EQ(3, metricCounter("test.named").read());
+}
+
+} // namespace
+} // namespace facebook::velox
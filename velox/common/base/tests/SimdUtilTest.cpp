@@ -399,4 +399,74 @@ TEST_F(SimdUtilTest, memEqual) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, simdStrstr) {
+  auto find = [](std::string_view s, std::string_view needle) {
+    return simd::simdStrstr(s.data(), s.size(), needle.data(), needle.size());
+  };
+  constexpr auto npos = std::string_view::npos;
+
+  std::string text(200, 'a');
+  text[150] = 'b';
+  text[199] = 'c';
+  EXPECT_EQ(find(text, ""), 0);
+  EXPECT_EQ(find(text, "b"), 150);
+  EXPECT_EQ(find(text, "ab"), 149);
+  EXPECT_EQ(find(text, "aab"), 148);
+  EXPECT_EQ(find(text, "aaaba"), 147);
+  EXPECT_EQ(find(text, "ac"), 198);
+  EXPECT_EQ(find(text, "bc"), npos);
+  EXPECT_EQ(find(text, "d"), npos);
+  EXPECT_EQ(find("ab", "abc"), npos);
+
+  // The needle at every offset and across SIMD width boundaries, with a
+  // partial match just before it.
+  for (auto offset = 0; offset < 100; ++offset) {
+    std::string haystack(100, 'x');
+    haystack.replace(offset, 4, "xyzw", std::min(4, 100 - offset));
+    if (offset >= 3) {
+      haystack.replace(offset - 3, 3, "xyz");
+    }
+    const auto expected = offset + 4 <= 100 ? offset : npos;
+    EXPECT_EQ(find(haystack, "xyzw"), expected) << offset;
+  }
+}
+
+TEST_F(SimdUtilTest, isAscii) {
+  std::string text(100, 'a');
+  for (auto size = 0; size <= text.size(); ++size) {
+    EXPECT_TRUE(simd::isAscii(text.data(), size)) << size;
+  }
+  // A non-ASCII byte in the SIMD part, the word part and the byte tail.
+  for (auto position = 0; position < text.size(); ++position) {
+    auto copy = text;
+    copy[position] = '\xc3';
+    EXPECT_FALSE(simd::isAscii(copy.data(), copy.size())) << position;
+    EXPECT_TRUE(simd::isAscii(copy.data(), position)) << position;
+  }
+}
+
+TEST_F(SimdUtilTest, changeAsciiCase) {
+  const std::string text = "Hello, World! @[`{ az AZ \xc3\xa9 0123456789 xyz";
+  std::string expectedUpper = text;
+  std::string expectedLower = text;
+  for (auto i = 0; i < text.size(); ++i) {
+    if (text[i] >= 'a' && text[i] <= 'z') {
+      expectedUpper[i] = text[i] - 32;
+    }
+    if (text[i] >= 'A' && text[i] <= 'Z') {
+      expectedLower[i] = text[i] + 32;
+    }
+  }
+  std::string result(text.size(), '\0');
+  simd::changeAsciiCase<true>(result.data(), text.data(), text.size());
+  EXPECT_EQ(result, expectedUpper);
+  simd::changeAsciiCase<false>(result.data(), text.data(), text.size());
+  EXPECT_EQ(result, expectedLower);
+
+  // In place.
+  result = text;
+  simd::changeAsciiCase<true>(result.data(), result.data(), result.size());
+  EXPECT_EQ(result, expectedUpper);
+}
+
 } // namespace
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SplitBlockBloomFilter.h"
+
+#include <folly/Hash.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+
+namespace {
+
+uint64_t hashOf(int32_t value) {
+  return folly::hasher<int32_t>()(value);
+}
+
+class SplitBlockBloomFilterTest : public ::testing::Test {};
+
+TEST_F(SplitBlockBloomFilterTest, basic) {
+  constexpr int32_t kSize = 10'000;
+  SplitBlockBloomFilter bloom;
+  EXPECT_FALSE(bloom.isSet());
+  bloom.reset(kSize);
+  EXPECT_TRUE(bloom.isSet());
+  EXPECT_EQ(bits::nextPowerOfTwo(kSize * 2), bloom.numBytes());
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(hashOf(i));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(hashOf(i)));
+    numFalsePositives += bloom.mayContain(hashOf(i + kSize));
+  }
+  EXPECT_GT(1, 100 * numFalsePositives / kSize);
+}
+
+TEST_F(SplitBlockBloomFilterTest, batch) {
+  constexpr int32_t kSize = 5'000;
+  std::vector<uint64_t> hashes(2 * kSize);
+  for (auto i = 0; i < hashes.size(); ++i) {
+    hashes[i] = hashOf(i);
+  }
+  SplitBlockBloomFilter bloom;
+  bloom.reset(kSize);
+  bloom.insert(hashes.data(), kSize);
+
+  std::vector<uint64_t> result(bits::nwords(hashes.size()), ~0UL);
+  const auto numHits =
+      bloom.mayContain(hashes.data(), hashes.size(), result.data());
+  EXPECT_LE(kSize, numHits);
+  EXPECT_EQ(numHits, bits::countBits(result.data(), 0, hashes.size()));
+  for (auto i = 0; i < hashes.size(); ++i) {
+    EXPECT_EQ(bloom.mayContain(hashes[i]), bits::isBitSet(result.data(), i));
+  }
+  EXPECT_TRUE(bits::isAllSet(result.data(), 0, kSize));
+}
+
+// The blocks are those of a Parquet split block Bloom filter.
+TEST_F(SplitBlockBloomFilterTest, parquetLayout) {
+  SplitBlockBloomFilter bloom;
+  bloom.reset(1, 1);
+  ASSERT_EQ(SplitBlockBloomFilter<>::kBytesPerBlock, bloom.numBytes());
+  // Key 1 sets bit salt >> 27 of each word.
+  bloom.insert(1);
+  const uint32_t expected[] = {
+      1U << 8,
+      1U << 8,
+      1U << 17,
+      1U << 20,
+      1U << 14,
+      1U << 5,
+      1U << 19,
+      1U << 11};
+  for (auto i = 0; i < SplitBlockBloomFilter<>::kWordsPerBlock; ++i) {
+    EXPECT_EQ(expected[i], bloom.blocks()[i]) << i;
+  }
+
+  SplitBlockBloomFilter copy;
+  copy.initialize(
+      reinterpret_cast<const char*>(bloom.blocks()), bloom.numBytes());
+  EXPECT_TRUE(copy.mayContain(1));
+  EXPECT_FALSE(copy.mayContain(2));
+}
+
+TEST_F(SplitBlockBloomFilterTest, serialize) {
+  constexpr int32_t kSize = 1024;
+  SplitBlockBloomFilter bloom;
+  bloom.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(hashOf(i));
+  }
+  std::string data(bloom.serializedSize(), '\0');
+  bloom.serialize(data.data());
+  SplitBlockBloomFilter deserialized;
+  deserialized.merge(data.data());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(deserialized.mayContain(hashOf(i)));
+  }
+  EXPECT_EQ(bloom.serializedSize(), deserialized.serializedSize());
+  EXPECT_EQ(
+      0, memcmp(bloom.blocks(), deserialized.blocks(), bloom.numBytes()));
+}
+
+TEST_F(SplitBlockBloomFilterTest, merge) {
+  constexpr int32_t kSize = 100;
+  SplitBlockBloomFilter bloom;
+  bloom.reset(kSize);
+  SplitBlockBloomFilter other;
+  other.reset(kSize);
+  SplitBlockBloomFilter serializedOther;
+  serializedOther.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(hashOf(i));
+    other.insert(hashOf(i + kSize));
+    serializedOther.insert(hashOf(i + 2 * kSize));
+  }
+  std::string data(serializedOther.serializedSize(), '\0');
+  serializedOther.serialize(data.data());
+
+  bloom.merge(other);
+  bloom.merge(data.data());
+  for (auto i = 0; i < 3 * kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(hashOf(i)));
+  }
+
+  SplitBlockBloomFilter differentSize;
+  differentSize.reset(kSize * 10);
+  EXPECT_THROW(bloom.merge(differentSize), VeloxException);
+}
+
+} // namespace
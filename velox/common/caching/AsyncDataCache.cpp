@@ -19,6 +19,10 @@
 #include "velox/common/caching/SsdCache.h"
 
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include <iomanip>
+#include <shared_mutex>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Metrics.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 
@@ -27,6 +31,30 @@ namespace facebook::velox::cache {
 using memory::MachinePageCount;
 using memory::MemoryAllocator;
 
+namespace {
+MetricCounter& cacheHits() {
+  static MetricCounter counter(kCounterMemoryCacheHits);
+  return counter;
+}
+
+MetricCounter& cacheMisses() {
+  static MetricCounter counter(kCounterMemoryCacheMisses);
+  return counter;
+}
+} // namespace
+
+std::string cacheEvictionPolicyName(CacheEvictionPolicy policy) {
+  switch (policy) {
+    case CacheEvictionPolicy::kClock:
+      return "CLOCK";
+    case CacheEvictionPolicy::kClockPro:
+      return "CLOCK_PRO";
+    default:
+      VELOX_UNREACHABLE(
+          "Unknown cache eviction policy {}", static_cast<int>(policy));
+  }
+}
+
 AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
   accessStats_.reset();
 }
@@ -40,7 +68,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
@@ -59,7 +87,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr)) {
     auto* ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
-    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
+    if (ssdCache->shouldSaveToSsd(*this)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
     }
@@ -97,6 +125,9 @@ memory::MachinePageCount AsyncDataCacheEntry::setPrefetch(bool flag) {
 void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
+  ssdBypass_ = false;
+  // A recycled entry must not inherit the uses of its previous contents.
+  accessStats_.reset();
   key_ = std::move(key);
   auto* cache = shard_->cache();
   ClockTimer t(shard_->allocClocks());
@@ -152,11 +183,33 @@ CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
-  AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    // Hits on readable, non-prefetched entries only take the shard mutex in
+    // shared mode so that concurrent readers of hot entries do not serialize.
+    // Anything else retries below in exclusive mode.
+    std::shared_lock<folly::SharedMutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
+    if (it != entryMap_.end()) {
+      auto* found = it->second;
+      if (!found->isExclusive() && !found->isPrefetch() &&
+          found->size() >= size) {
+        found->touch();
+        ++numHit_;
+        hitBytes_ += found->size();
+        cacheHits().add();
+        ++found->numPins_;
+        CachePin pin;
+        pin.setEntry(found);
+        return pin;
+      }
+    }
+  }
+
+  AsyncDataCacheEntry* entryToInit = nullptr;
+  {
+    std::lock_guard<folly::SharedMutex> l(mutex_);
+    auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* found = it->second;
       if (found->isExclusive()) {
@@ -176,6 +229,7 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          cacheHits().add();
         }
         ++found->numPins_;
         CachePin pin;
@@ -199,6 +253,13 @@ CachePin CacheShard::findOrCreate(
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    if (cache_->evictionPolicy() == CacheEvictionPolicy::kClockPro &&
+        removeGhost(key)) {
+      // Reused soon after eviction. A recency-only policy would evict it
+      // again before its next use.
+      ++numGhostHit_;
+      setHot(newEntry.get(), true);
+    }
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -209,6 +270,7 @@ CachePin CacheShard::findOrCreate(
       entries_[index] = std::move(newEntry);
     }
     ++numNew_;
+    cacheMisses().add();
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
@@ -218,7 +280,7 @@ CachePin CacheShard::findOrCreate(
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -243,6 +305,84 @@ CachePin CacheShard::initEntry(
   return pin;
 }
 
+void FileLoadPlanner::add(const std::shared_ptr<CoalescedLoad>& load) {
+  for (const auto& key : load->keys()) {
+    auto& fileShard = shard(key.fileNum);
+    std::lock_guard<std::mutex> l(fileShard.mutex);
+    auto& loads = fileShard.files[key.fileNum];
+    auto it = loads.find(key.offset);
+    if (it == loads.end() || it->second.expired()) {
+      loads[key.offset] = load;
+    }
+  }
+}
+
+std::shared_ptr<CoalescedLoad> FileLoadPlanner::find(RawFileCacheKey key) {
+  auto& fileShard = shard(key.fileNum);
+  std::shared_ptr<CoalescedLoad> load;
+  {
+    std::lock_guard<std::mutex> l(fileShard.mutex);
+    auto fileIt = fileShard.files.find(key.fileNum);
+    if (fileIt == fileShard.files.end()) {
+      return nullptr;
+    }
+    auto it = fileIt->second.find(key.offset);
+    if (it == fileIt->second.end()) {
+      return nullptr;
+    }
+    load = it->second.lock();
+    if (load == nullptr) {
+      fileIt->second.erase(it);
+      if (fileIt->second.empty()) {
+        fileShard.files.erase(fileIt);
+      }
+      return nullptr;
+    }
+  }
+  // Outside of the shard mutex. A loaded or cancelled load is left for
+  // remove().
+  const auto state = load->state();
+  if (state == CoalescedLoad::State::kPlanned ||
+      state == CoalescedLoad::State::kLoading) {
+    return load;
+  }
+  return nullptr;
+}
+
+void FileLoadPlanner::remove(const CoalescedLoad& load) {
+  for (const auto& key : load.keys()) {
+    auto& fileShard = shard(key.fileNum);
+    std::lock_guard<std::mutex> l(fileShard.mutex);
+    auto fileIt = fileShard.files.find(key.fileNum);
+    if (fileIt == fileShard.files.end()) {
+      continue;
+    }
+    auto it = fileIt->second.find(key.offset);
+    if (it == fileIt->second.end()) {
+      continue;
+    }
+    // An expired pointer is dropped regardless of who registered it.
+    const auto registered = it->second.lock();
+    if (registered == nullptr || registered.get() == &load) {
+      fileIt->second.erase(it);
+      if (fileIt->second.empty()) {
+        fileShard.files.erase(fileIt);
+      }
+    }
+  }
+}
+
+int64_t FileLoadPlanner::numKeys() const {
+  int64_t numKeys = 0;
+  for (const auto& fileShard : shards_) {
+    std::lock_guard<std::mutex> l(fileShard.mutex);
+    for (const auto& [fileNum, loads] : fileShard.files) {
+      numKeys += loads.size();
+    }
+  }
+  return numKeys;
+}
+
 CoalescedLoad::~CoalescedLoad() {
   // Continue possibly waiting threads.
   setEndState(State::kCancelled);
@@ -300,7 +440,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -308,6 +448,7 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  setHot(entry, false);
   if (!entry->key_.fileNum.hasValue()) {
     return;
   }
@@ -343,8 +484,10 @@ void CacheShard::evict(
   bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  const bool clockPro =
+      cache_->evictionPolicy() == CacheEvictionPolicy::kClockPro;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     int size = entries_.size();
     if (!size) {
       return;
@@ -367,22 +510,33 @@ void CacheShard::evict(
       }
       ++numChecked;
       ++clockHand_;
-      if (evictionThreshold_ == kNoThreshold ||
-          eventCounter_ > entries_.size() / 4 ||
-          numChecked > entries_.size() / 8) {
+      if (!clockPro &&
+          (evictionThreshold_ == kNoThreshold ||
+           eventCounter_ > entries_.size() / 4 ||
+           numChecked > entries_.size() / 8)) {
         now = accessTime();
         calibrateThreshold();
         numChecked = 0;
         eventCounter_ = 0;
       }
       int32_t score = 0;
-      if (candidate->numPins_ == 0 &&
-          (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+      const bool evictCandidate = clockPro
+          ? clockProShouldEvict(candidate, evictAllUnpinned)
+          : candidate->numPins_ == 0 &&
+              (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
+               (score = candidate->score(now)) >= evictionThreshold_);
+      if (evictCandidate) {
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
+        if (clockPro && candidate->key_.fileNum.hasValue()) {
+          score = candidate->score(now);
+          if (!candidate->isHot_ && !evictAllUnpinned) {
+            addGhost(
+                {candidate->key_.fileNum.id(), candidate->key_.offset});
+          }
+        }
         largeFreed += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           auto candidatePages = candidate->data().numPages();
@@ -441,6 +595,63 @@ void CacheShard::freeAllocations(std::vector<memory::Allocation>& allocations) {
   allocations.clear();
 }
 
+bool CacheShard::clockProShouldEvict(
+    AsyncDataCacheEntry* candidate,
+    bool evictAllUnpinned) {
+  if (candidate->numPins_ != 0) {
+    return false;
+  }
+  auto& accessStats = candidate->accessStats_;
+  if (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
+      accessStats.lastUse == 0) {
+    return true;
+  }
+  if (candidate->isHot_) {
+    if (accessStats.numUses > 0) {
+      // Second chance for an entry used since the last visit.
+      accessStats.numUses = 0;
+    } else if (numHot_ > kMaxHotPct * entryMap_.size() / 100) {
+      setHot(candidate, false);
+    }
+    return false;
+  }
+  // The first use of a new entry is usually by the load that created it. A
+  // second use means reuse.
+  if (accessStats.numUses >= 2) {
+    setHot(candidate, true);
+    accessStats.numUses = 0;
+    return false;
+  }
+  return true;
+}
+
+void CacheShard::setHot(AsyncDataCacheEntry* entry, bool hot) {
+  if (entry->isHot_ == hot) {
+    return;
+  }
+  entry->isHot_ = hot;
+  numHot_ += hot ? 1 : -1;
+}
+
+void CacheShard::addGhost(const RawFileCacheKey& key) {
+  ghosts_[key] = ++ghostSequence_;
+  ghostQueue_.emplace_back(key, ghostSequence_);
+  const auto maxGhosts = std::max<size_t>(kMinGhosts, entryMap_.size());
+  while (ghostQueue_.size() > maxGhosts) {
+    const auto& [oldKey, sequence] = ghostQueue_.front();
+    // A key can be queued more than once. Only its newest position counts.
+    auto it = ghosts_.find(oldKey);
+    if (it != ghosts_.end() && it->second == sequence) {
+      ghosts_.erase(it);
+    }
+    ghostQueue_.pop_front();
+  }
+}
+
+bool CacheShard::removeGhost(const RawFileCacheKey& key) {
+  return ghosts_.erase(key) > 0;
+}
+
 void CacheShard::calibrateThreshold() {
   auto numSamples = std::min<int32_t>(10, entries_.size());
   auto now = accessTime();
@@ -465,7 +676,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -497,10 +708,12 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
   stats.allocClocks += allocClocks_;
+  stats.numHot += numHot_;
+  stats.numGhostHit += numGhostHit_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch.If SSD save
   // is slower than storage read, we must not have a situation where
   // SSD save pins everything and stops reading.
@@ -524,8 +737,12 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheEvictionPolicy evictionPolicy)
+    : allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      evictionPolicy_(evictionPolicy),
+      cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this));
   }
@@ -536,8 +753,10 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheEvictionPolicy evictionPolicy) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), evictionPolicy);
   allocator->registerCache(cache);
   return cache;
 }
@@ -573,6 +792,9 @@ CachePin AsyncDataCache::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (ssdCache_ != nullptr) {
+    ssdCache_->recordAccess(key);
+  }
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
   return shards_[shard]->findOrCreate(key, size, wait);
 }
@@ -739,6 +961,7 @@ void AsyncDataCache::saveToSsd() {
 
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
+  stats.evictionPolicy = evictionPolicy_;
   for (auto& shard : shards_) {
     shard->updateStats(stats);
   }
@@ -756,6 +979,23 @@ void AsyncDataCache::clear() {
   }
 }
 
+uint64_t AsyncDataCache::shrink(uint64_t targetBytes) {
+  if (targetBytes == 0) {
+    return 0;
+  }
+  const uint64_t cachedBytes =
+      memory::AllocationTraits::pageBytes(cachedPages_);
+  const uint64_t bytesPerShard = (targetBytes + kNumShards - 1) / kNumShards;
+  for (auto& shard : shards_) {
+    memory::Allocation acquired;
+    shard->evict(bytesPerShard, false, 0, acquired);
+    VELOX_CHECK(acquired.empty());
+  }
+  const uint64_t remainingBytes =
+      memory::AllocationTraits::pageBytes(cachedPages_);
+  return cachedBytes > remainingBytes ? cachedBytes - remainingBytes : 0;
+}
+
 std::string AsyncDataCache::toString(bool details) const {
   auto stats = refreshStats();
   std::stringstream out;
@@ -792,7 +1032,14 @@ std::string CacheStats::toString() const {
       << "Cache access miss: " << numNew << " hit: " << numHit
       << " hit bytes: " << succinctBytes(hitBytes) << " eviction: " << numEvict
       << " eviction checks: " << numEvictChecks
-      << "\n"
+      << "\n";
+  if (evictionPolicy != CacheEvictionPolicy::kClock) {
+    out << "Eviction policy: " << cacheEvictionPolicyName(evictionPolicy)
+        << " hit rate: " << std::fixed << std::setprecision(3) << hitRate()
+        << " hot entries: " << numHot << " ghost hits: " << numGhostHit
+        << "\n";
+  }
+  out
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <array>
 #include <deque>
 
 #include <fmt/format.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/futures/SharedPromise.h>
 #include "folly/GLog.h"
@@ -60,8 +62,9 @@ inline AccessTime accessTime() {
 }
 
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  // Updated by concurrent cache hits that hold the shard mutex in shared mode.
+  tsan_atomic<AccessTime> lastUse{0};
+  tsan_atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -91,6 +94,24 @@ struct AccessStats {
   }
 };
 
+/// Selects how a CacheShard picks the entries to evict.
+enum class CacheEvictionPolicy {
+  /// Clock scan evicting the entries whose score, the time since the last use
+  /// divided by the number of uses, is above a sampled 80th percentile.
+  kClock,
+  /// CLOCK-Pro style scan separating recency from frequency. New entries are
+  /// cold and are evicted at the first visit of the clock hand unless they
+  /// were used at least twice, in which case they become hot. Hot entries get
+  /// a second chance for each use and become cold again when they exceed
+  /// their share of the shard. The keys of evicted cold entries are kept as
+  /// ghosts and an entry that is created for a ghost key starts hot. A large
+  /// scan therefore only cycles through cold entries and leaves hot entries,
+  /// e.g. of dimension tables, in place.
+  kClockPro,
+};
+
+std::string cacheEvictionPolicyName(CacheEvictionPolicy policy);
+
 // Owning reference to a file id and an offset.
 struct FileCacheKey {
   StringIdLease fileNum;
@@ -241,10 +262,28 @@ class AsyncDataCacheEntry {
     trackingId_ = id;
   }
 
+  TrackingId trackingId() const {
+    return trackingId_;
+  }
+
   void setGroupId(uint64_t groupId) {
     groupId_ = groupId;
   }
 
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
+  /// Marks 'this' as loaded by a scan that bypasses the SSD cache, e.g. a
+  /// one-off backfill. Such entries are not written to SSD.
+  void setSsdBypass(bool ssdBypass) {
+    ssdBypass_ = ssdBypass;
+  }
+
+  bool ssdBypass() const {
+    return ssdBypass_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -285,7 +324,9 @@ class AsyncDataCacheEntry {
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this to kExclusive requires owning shard_->mutex_ in exclusive
+  // mode. Adding a read pin to a readable entry requires owning it in shared
+  // mode. Eviction requires exclusive mode, so it never races with a new pin.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -306,6 +347,13 @@ class AsyncDataCacheEntry {
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
+  // True if 'this' must not be written to SSD. See setSsdBypass().
+  bool ssdBypass_{false};
+
+  // True if 'this' is hot for CacheEvictionPolicy::kClockPro. Set inside the
+  // shard mutex in exclusive mode.
+  bool isHot_{false};
+
   // SSD file from which this was loaded or nullptr if not backed by
   // SsdFile. Used to avoid re-adding items that already come from
   // SSD. The exact file and offset are needed to include uses in RAM
@@ -436,6 +484,10 @@ class CoalescedLoad {
   /// Returns the cache space 'this' will occupy after loaded.
   virtual int64_t size() const = 0;
 
+  const std::vector<RawFileCacheKey>& keys() const {
+    return keys_;
+  }
+
   virtual std::string toString() const {
     return "<CoalescedLoad>";
   }
@@ -465,6 +517,47 @@ class CoalescedLoad {
   std::vector<int32_t> sizes_;
 };
 
+/// Registry of the CoalescedLoads that are planned or in progress, by file
+/// and offset. Readers of different splits of the same file consult this
+/// before planning their own loads so that a range that a concurrent reader
+/// is about to load is not read twice. Holds weak references. Finished and
+/// destroyed loads are dropped as they are found.
+class FileLoadPlanner {
+ public:
+  /// Registers 'load' as the pending load of its keys. Keys that already
+  /// have a pending load keep it.
+  void add(const std::shared_ptr<CoalescedLoad>& load);
+
+  /// Returns the planned or in progress load of 'key' or nullptr if none.
+  std::shared_ptr<CoalescedLoad> find(RawFileCacheKey key);
+
+  /// Removes the keys of 'load' that are registered to 'load'.
+  void remove(const CoalescedLoad& load);
+
+  /// Returns the number of registered keys, including finished loads not
+  /// yet dropped.
+  int64_t numKeys() const;
+
+ private:
+  static constexpr int32_t kNumShards = 16; // Must be power of 2.
+
+  struct Shard {
+    mutable std::mutex mutex;
+    // File number -> offset -> load.
+    folly::F14FastMap<
+        uint64_t,
+        folly::F14FastMap<uint64_t, std::weak_ptr<CoalescedLoad>>>
+        files;
+  };
+
+  Shard& shard(uint64_t fileNum) {
+    // File numbers are consecutive ids from StringIdMap.
+    return shards_[fileNum & (kNumShards - 1)];
+  }
+
+  std::array<Shard, kNumShards> shards_;
+};
+
 // Struct for CacheShard stats. Stats from all shards are added into
 // this struct to provide a snapshot of state.
 struct CacheStats {
@@ -514,6 +607,20 @@ struct CacheStats {
   int64_t sharedPinnedBytes{0};
   int64_t exclusivePinnedBytes{0};
 
+  CacheEvictionPolicy evictionPolicy{CacheEvictionPolicy::kClock};
+  // Number of hot entries with CacheEvictionPolicy::kClockPro.
+  int32_t numHot{0};
+  // Number of new entries created for the key of a recently evicted entry
+  // with CacheEvictionPolicy::kClockPro.
+  int64_t numGhostHit{0};
+
+  /// Returns the fraction of lookups that found the entry in the cache.
+  double hitRate() const {
+    return numHit + numNew == 0
+        ? 0
+        : static_cast<double>(numHit) / (numHit + numNew);
+  }
+
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
   std::string toString() const;
@@ -540,7 +647,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -583,10 +690,29 @@ class CacheShard {
 
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
+  // Maximum percentage of hot entries with CacheEvictionPolicy::kClockPro.
+  static constexpr int32_t kMaxHotPct = 75;
+  // Minimum number of ghosts kept with CacheEvictionPolicy::kClockPro.
+  static constexpr size_t kMinGhosts = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
   void calibrateThreshold();
 
+  // Returns true if 'candidate' at the clock hand is to be evicted with
+  // CacheEvictionPolicy::kClockPro. Moves 'candidate' between hot and cold.
+  bool clockProShouldEvict(
+      AsyncDataCacheEntry* candidate,
+      bool evictAllUnpinned);
+
+  // Sets 'entry' hot or cold and maintains 'numHot_'.
+  void setHot(AsyncDataCacheEntry* entry, bool hot);
+
+  // Records the key of an evicted cold entry as a ghost.
+  void addGhost(const RawFileCacheKey& key);
+
+  // Removes 'key' from the ghosts. Returns true if it was a ghost.
+  bool removeGhost(const RawFileCacheKey& key);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -603,7 +729,10 @@ class CacheShard {
 
   AsyncDataCache* const cache_;
 
-  mutable std::mutex mutex_;
+  // Held in shared mode for hits on readable entries and in exclusive mode for
+  // any change to 'entryMap_' or to the entries' pin state other than adding
+  // a read pin to an entry that is already readable.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -616,13 +745,23 @@ class CacheShard {
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{0};
   // Number of gets since last stats sampling.
-  uint32_t eventCounter_{0};
+  tsan_atomic<uint32_t> eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
+  // Number of hot entries for CacheEvictionPolicy::kClockPro.
+  int32_t numHot_{0};
+  // Keys of recently evicted cold entries for CacheEvictionPolicy::kClockPro,
+  // mapped to their position in 'ghostQueue_'. The oldest ghosts are dropped
+  // so that there are about as many ghosts as entries.
+  folly::F14FastMap<RawFileCacheKey, uint64_t> ghosts_;
+  std::deque<std::pair<RawFileCacheKey, uint64_t>> ghostQueue_;
+  uint64_t ghostSequence_{0};
+  // Cumulative count of new entries created for a ghost key.
+  uint64_t numGhostHit_{0};
   // Cumulative count of cache hits.
-  uint64_t numHit_{0};
+  tsan_atomic<uint64_t> numHit_{0};
   // Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  tsan_atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -644,13 +783,15 @@ class AsyncDataCache : public memory::Cache {
  public:
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheEvictionPolicy evictionPolicy = CacheEvictionPolicy::kClock);
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheEvictionPolicy evictionPolicy = CacheEvictionPolicy::kClock);
 
   static AsyncDataCache* getInstance();
 
@@ -714,6 +855,16 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  /// Returns the registry of pending loads shared between the readers of
+  /// 'this'.
+  FileLoadPlanner& loadPlanner() {
+    return loadPlanner_;
+  }
+
+  CacheEvictionPolicy evictionPolicy() const {
+    return evictionPolicy_;
+  }
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -757,6 +908,11 @@ class AsyncDataCache : public memory::Cache {
   // Drops all unpinned entries. Pins stay valid.
   void clear();
 
+  /// Evicts unpinned entries, least valuable first, until about 'targetBytes'
+  /// of cache memory is freed. Returns the freed bytes. Used to shed memory
+  /// under memory pressure.
+  uint64_t shrink(uint64_t targetBytes);
+
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
   void saveToSsd();
 
@@ -780,6 +936,8 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const CacheEvictionPolicy evictionPolicy_;
+  FileLoadPlanner loadPlanner_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
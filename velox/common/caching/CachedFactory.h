@@ -62,8 +62,11 @@ class CachedFactory {
   // is ready.
   // The function returns a pair. The boolean in the pair indicates whether a
   // cache hit or miss. The Value is the generator output for the key if cache
-  // miss, or Value in the cache if cache hit.
-  std::pair<bool, Value> generate(const Key& key);
+  // miss, or Value in the cache if cache hit. 'args' are passed to the
+  // Generator after the key, e.g. to give it metadata about the key. They are
+  // not part of the key and are not used on a cache hit.
+  template <typename... Args>
+  std::pair<bool, Value> generate(const Key& key, const Args&... args);
 
   // Advanced function taking in a group of keys. Separates those keys into
   // one's present in the cache (returning CachedPtrs for them) and those not
@@ -116,8 +119,10 @@ class CachedFactory {
 //
 
 template <typename Key, typename Value, typename Generator>
+template <typename... Args>
 std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
-    const Key& key) {
+    const Key& key,
+    const Args&... args) {
   process::TraceContext trace("CachedFactory::generate");
   std::unique_lock<std::mutex> pending_lock(pendingMu_);
   {
@@ -139,14 +144,14 @@ std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
       }
     }
     pending_lock.unlock();
-    return generate(key); // Regenerate in the edge case.
+    return generate(key, args...); // Regenerate in the edge case.
   } else {
     pending_.insert(key);
     pending_lock.unlock();
     Value generatedValue;
     // TODO: consider using folly/ScopeGuard here.
     try {
-      generatedValue = (*generator_)(key);
+      generatedValue = (*generator_)(key, args...);
     } catch (const std::exception& e) {
       {
         std::lock_guard<std::mutex> pending_lock(pendingMu_);
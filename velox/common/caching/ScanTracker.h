@@ -17,6 +17,7 @@
 #pragma once
 
 #include <folly/container/F14Map.h>
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 
@@ -176,6 +177,16 @@ class ScanTracker {
     return fileGroupStats_;
   }
 
+  // Marks the scan as one-off, e.g. a backfill. The data it loads into the
+  // memory cache is not written to SSD.
+  void setSsdBypass(bool ssdBypass) {
+    ssdBypass_ = ssdBypass;
+  }
+
+  bool ssdBypass() const {
+    return ssdBypass_;
+  }
+
   std::string toString() const;
 
  private:
@@ -191,6 +202,7 @@ class ScanTracker {
   // size is unlimited.
   const int32_t loadQuantum_;
   FileGroupStats* FOLLY_NULLABLE fileGroupStats_;
+  std::atomic<bool> ssdBypass_{false};
 };
 
 } // namespace facebook::velox::cache
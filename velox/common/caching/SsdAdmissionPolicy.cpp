@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+TinyLfuAdmissionPolicy::TinyLfuAdmissionPolicy(Options options)
+    : minFrequency_(options.minFrequency),
+      sampleSize_(
+          options.sampleSize != 0
+              ? options.sampleSize
+              : 10 * bits::nextPowerOfTwo(options.numCounters)),
+      counterMask_(bits::nextPowerOfTwo(options.numCounters) - 1),
+      counters_(std::make_unique<std::atomic<uint8_t>[]>(counterMask_ + 1)) {
+  VELOX_CHECK_GT(options.numCounters, 0);
+  VELOX_CHECK_GT(options.minFrequency, 0);
+  VELOX_CHECK_LE(options.minFrequency, kMaxCount);
+  VELOX_CHECK_GT(sampleSize_, 0);
+  for (auto i = 0; i <= counterMask_; ++i) {
+    counters_[i] = 0;
+  }
+}
+
+int32_t TinyLfuAdmissionPolicy::counterIndex(uint64_t hash, int32_t i) const {
+  // Double hashing. The odd step makes the kNumHashes indices distinct.
+  const uint64_t step = folly::hash::twang_mix64(hash) | 1;
+  return (hash + i * step) & counterMask_;
+}
+
+void TinyLfuAdmissionPolicy::recordAccess(const RawFileCacheKey& key) {
+  const uint64_t hash = std::hash<RawFileCacheKey>()(key);
+  for (auto i = 0; i < kNumHashes; ++i) {
+    auto& counter = counters_[counterIndex(hash, i)];
+    auto count = counter.load(std::memory_order_relaxed);
+    while (count < kMaxCount &&
+           !counter.compare_exchange_weak(
+               count, count + 1, std::memory_order_relaxed)) {
+    }
+  }
+  if (numAccesses_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+      sampleSize_) {
+    reset();
+    numAccesses_ -= sampleSize_;
+  }
+}
+
+void TinyLfuAdmissionPolicy::reset() {
+  // Concurrent increments may be lost or survive the halving. This only
+  // perturbs the estimate.
+  for (auto i = 0; i <= counterMask_; ++i) {
+    counters_[i].store(
+        counters_[i].load(std::memory_order_relaxed) / 2,
+        std::memory_order_relaxed);
+  }
+  ++numResets_;
+}
+
+int32_t TinyLfuAdmissionPolicy::frequency(const RawFileCacheKey& key) const {
+  const uint64_t hash = std::hash<RawFileCacheKey>()(key);
+  int32_t result = kMaxCount;
+  for (auto i = 0; i < kNumHashes; ++i) {
+    result = std::min<int32_t>(
+        result,
+        counters_[counterIndex(hash, i)].load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+bool TinyLfuAdmissionPolicy::shouldAdmit(const AsyncDataCacheEntry& entry) {
+  const auto& key = entry.key();
+  if (frequency({key.fileNum.id(), key.offset}) >= minFrequency_) {
+    ++numAdmitted_;
+    return true;
+  }
+  ++numRejected_;
+  return false;
+}
+
+std::string TinyLfuAdmissionPolicy::toString() const {
+  return fmt::format(
+      "TinyLfuAdmissionPolicy: {} counters, min frequency {}, admitted {} "
+      "rejected {} resets {}",
+      counterMask_ + 1,
+      minFrequency_,
+      numAdmitted_.load(),
+      numRejected_.load(),
+      numResets_.load());
+}
+
+} // namespace facebook::velox::cache
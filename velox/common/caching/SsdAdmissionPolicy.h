@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "velox/common/caching/AsyncDataCache.h"
+
+namespace facebook::velox::cache {
+
+/// Decides which entries of AsyncDataCache are written to SsdCache. The policy
+/// sees every lookup of the memory cache through recordAccess() and is asked
+/// through shouldAdmit() when an entry becomes a candidate for saving to SSD.
+/// Entries loaded by scans that bypass the SSD cache and entries rejected by
+/// FileGroupStats are never offered to the policy. Implementations must be
+/// thread-safe.
+class SsdAdmissionPolicy {
+ public:
+  virtual ~SsdAdmissionPolicy() = default;
+
+  /// Records a lookup of 'key' in the memory cache, hit or miss.
+  virtual void recordAccess(const RawFileCacheKey& key) = 0;
+
+  /// Returns true if 'entry' should be written to SSD.
+  virtual bool shouldAdmit(const AsyncDataCacheEntry& entry) = 0;
+
+  virtual std::string toString() const = 0;
+};
+
+/// Admits entries whose key has been looked up at least 'minFrequency' times
+/// in the recent past. The frequencies are estimated by a count-min sketch of
+/// 4 bit saturating counters as in TinyLFU. All counters are halved after
+/// 'sampleSize' recorded accesses so that the estimate follows the recent
+/// working set. A scan that reads each key once does not pass the filter, so
+/// large one-off scans do not wash out the SSD working set.
+class TinyLfuAdmissionPolicy : public SsdAdmissionPolicy {
+ public:
+  struct Options {
+    /// Number of counters in the sketch. Rounded up to a power of 2. About
+    /// the number of distinct entries in the SSD working set.
+    int32_t numCounters{1 << 20};
+
+    /// The estimated number of accesses for an entry to be admitted.
+    int32_t minFrequency{2};
+
+    /// Number of accesses after which the counters are halved. 0 means 10 x
+    /// 'numCounters'.
+    int64_t sampleSize{0};
+  };
+
+  explicit TinyLfuAdmissionPolicy(Options options);
+
+  void recordAccess(const RawFileCacheKey& key) override;
+
+  bool shouldAdmit(const AsyncDataCacheEntry& entry) override;
+
+  std::string toString() const override;
+
+  /// Returns the estimated number of accesses to 'key' since the counters
+  /// were last halved, at most 15.
+  int32_t frequency(const RawFileCacheKey& key) const;
+
+  /// Returns the number of times the counters have been halved.
+  int64_t numResets() const {
+    return numResets_;
+  }
+
+ private:
+  static constexpr int32_t kNumHashes = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  // Returns the index of the 'i'th counter of the key with 'hash'.
+  int32_t counterIndex(uint64_t hash, int32_t i) const;
+
+  // Halves all counters.
+  void reset();
+
+  const int32_t minFrequency_;
+  const int64_t sampleSize_;
+  const int32_t counterMask_;
+  std::unique_ptr<std::atomic<uint8_t>[]> counters_;
+
+  // Accesses since the last reset().
+  std::atomic<int64_t> numAccesses_{0};
+  std::atomic<int64_t> numResets_{0};
+  std::atomic<uint64_t> numAdmitted_{0};
+  std::atomic<uint64_t> numRejected_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -56,7 +56,8 @@ SsdCache::SsdCache(
         i,
         fileMaxRegions,
         checkpointIntervalBytes / numShards,
-        disableFileCow));
+        disableFileCow,
+        executor_));
   }
 }
 
@@ -78,6 +79,16 @@ bool SsdCache::startWrite() {
   return false;
 }
 
+bool SsdCache::shouldSaveToSsd(const AsyncDataCacheEntry& entry) const {
+  if (entry.ssdBypass()) {
+    return false;
+  }
+  if (!groupStats_->shouldSaveToSsd(entry.groupId(), entry.trackingId())) {
+    return false;
+  }
+  return admissionPolicy_ == nullptr || admissionPolicy_->shouldAdmit(entry);
+}
+
 void SsdCache::write(std::vector<CachePin> pins) {
   VELOX_CHECK_LE(numShards_, writesInProgress_);
 
@@ -152,6 +163,9 @@ std::string SsdCache::toString() const {
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
   out << "\nGroupStats: " << groupStats_->toString(capacity);
+  if (admissionPolicy_ != nullptr) {
+    out << "\n" << admissionPolicy_->toString();
+  }
   return out.str();
 }
 
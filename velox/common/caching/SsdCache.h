@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/SsdAdmissionPolicy.h"
 #include "velox/common/caching/SsdFile.h"
 
 namespace facebook::velox::cache {
@@ -83,6 +84,27 @@ class SsdCache {
     return *groupStats_;
   }
 
+  /// Sets the policy that selects the entries to save on top of
+  /// 'groupStats_'. nullptr admits every entry that 'groupStats_' selects.
+  /// Must be set before the cache is used.
+  void setAdmissionPolicy(std::unique_ptr<SsdAdmissionPolicy> policy) {
+    admissionPolicy_ = std::move(policy);
+  }
+
+  SsdAdmissionPolicy* admissionPolicy() const {
+    return admissionPolicy_.get();
+  }
+
+  /// Records a lookup of 'key' in the memory cache for the admission policy.
+  void recordAccess(const RawFileCacheKey& key) {
+    if (admissionPolicy_ != nullptr) {
+      admissionPolicy_->recordAccess(key);
+    }
+  }
+
+  /// Returns true if 'entry' should be written to SSD.
+  bool shouldSaveToSsd(const AsyncDataCacheEntry& entry) const;
+
   /// Drops all entries. Outstanding pins become invalid but reading them will
   /// mostly succeed since the files will not be rewritten until new content is
   /// stored.
@@ -107,6 +129,7 @@ class SsdCache {
 
   // Stats for selecting entries to save from AsyncDataCache.
   std::unique_ptr<FileGroupStats> groupStats_;
+  std::unique_ptr<SsdAdmissionPolicy> admissionPolicy_;
   folly::Executor* executor_;
   std::atomic<bool> isShutdown_{false};
 };
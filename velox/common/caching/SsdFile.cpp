@@ -16,6 +16,7 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/hash/Checksum.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SuccinctPrinter.h"
@@ -29,11 +30,17 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <condition_variable>
 #include <fstream>
 #include <numeric>
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_int32(
+    ssd_max_parallel_reads,
+    8,
+    "Max number of coalesced reads of one SSD cache load that are in flight "
+    "at a time. Reads beyond the first run on the SSD cache executor");
 
 namespace facebook::velox::cache {
 
@@ -79,6 +86,22 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+uint32_t entryChecksum(AsyncDataCacheEntry& entry) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  uint32_t checksum = ~0U;
+  for (const auto& iov : iovecs) {
+    checksum = folly::crc32c(
+        reinterpret_cast<const uint8_t*>(iov.iov_base), iov.iov_len, checksum);
+  }
+  return checksum;
+}
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+  out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -186,6 +209,7 @@ void SsdFile::unpinRegion(uint64_t offset) {
 SsdPin SsdFile::find(RawFileCacheKey key) {
   FileCacheKey ssdKey{StringIdLease(fileIds(), key.fileNum), key.offset};
   SsdRun run;
+  std::optional<uint32_t> checksum;
   {
     std::lock_guard<std::shared_mutex> l(mutex_);
     if (suspended_) {
@@ -198,10 +222,53 @@ SsdPin SsdFile::find(RawFileCacheKey key) {
     }
     run = it->second;
     pinRegionLocked(run.offset());
+    if (!unverifiedEntries_.empty()) {
+      auto unverified = unverifiedEntries_.find(ssdKey);
+      if (unverified != unverifiedEntries_.end()) {
+        if (unverified->second.first == run.bits()) {
+          checksum = unverified->second.second;
+        } else {
+          // Rewritten since recovery.
+          unverifiedEntries_.erase(unverified);
+        }
+      }
+    }
+  }
+  if (checksum.has_value() &&
+      !verifyRecoveredEntry(ssdKey, run, checksum.value())) {
+    unpinRegion(run.offset());
+    return SsdPin();
   }
   return SsdPin(*this, run);
 }
 
+bool SsdFile::verifyRecoveredEntry(
+    const FileCacheKey& key,
+    SsdRun run,
+    uint32_t checksum) {
+  // The region is pinned by the caller, so the data cannot be overwritten
+  // while reading.
+  auto data = std::make_unique<char[]>(run.size());
+  const auto rc = ::pread(fd_, data.get(), run.size(), run.offset());
+  const bool valid = rc == static_cast<ssize_t>(run.size()) &&
+      folly::crc32c(
+          reinterpret_cast<const uint8_t*>(data.get()), run.size(), ~0U) ==
+          checksum;
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  unverifiedEntries_.erase(key);
+  if (!valid) {
+    ++stats_.readChecksumErrors;
+    const auto it = entries_.find(key);
+    if (it != entries_.end() && it->second.bits() == run.bits()) {
+      entries_.erase(it);
+    }
+    VELOX_SSD_CACHE_LOG(WARNING)
+        << "Dropping entry recovered from checkpoint log with bad checksum: "
+        << fileName_ << " offset " << run.offset() << " size " << run.size();
+  }
+  return valid;
+}
+
 bool SsdFile::erase(RawFileCacheKey key) {
   FileCacheKey ssdKey{StringIdLease(fileIds(), key.fileNum), key.offset};
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -210,6 +277,7 @@ bool SsdFile::erase(RawFileCacheKey key) {
     return false;
   }
   entries_.erase(it);
+  unverifiedEntries_.erase(ssdKey);
   return true;
 }
 
@@ -237,6 +305,7 @@ CoalesceIoStats SsdFile::load(
     stats_.bytesRead += entry->size();
   }
 
+  std::vector<ReadRequest> reads;
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
@@ -253,8 +322,9 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        reads.push_back({offset, buffers});
       });
+  readBatch(reads);
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -268,6 +338,63 @@ void SsdFile::read(
   readFile_->preadv(offset, buffers);
 }
 
+void SsdFile::readBatch(const std::vector<ReadRequest>& reads) {
+  const int32_t numStreams = std::min<int32_t>(
+      std::max<int32_t>(FLAGS_ssd_max_parallel_reads, 1), reads.size());
+  if (executor_ == nullptr || numStreams <= 1) {
+    for (const auto& request : reads) {
+      read(request.offset, request.buffers);
+    }
+    return;
+  }
+
+  // Stream 'i' does the reads at 'i', 'i' + 'numStreams' and so on. The
+  // streams are claimed by this thread and by tasks on 'executor_'. This
+  // thread runs the streams no task has claimed, so that it never waits for a
+  // task that has not started, e.g. because 'executor_' is busy.
+  struct State {
+    std::atomic<int32_t> nextStream{0};
+    std::mutex mutex;
+    std::condition_variable finishedCv;
+    int32_t numFinished{0};
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<State>();
+  const auto runStreams = [this, state, numStreams, readsPtr = &reads]() {
+    for (;;) {
+      const auto stream = state->nextStream++;
+      if (stream >= numStreams) {
+        return;
+      }
+      std::exception_ptr error;
+      try {
+        for (auto i = stream; i < readsPtr->size(); i += numStreams) {
+          read((*readsPtr)[i].offset, (*readsPtr)[i].buffers);
+        }
+      } catch (const std::exception&) {
+        error = std::current_exception();
+      }
+      std::lock_guard<std::mutex> l(state->mutex);
+      if (error != nullptr && state->error == nullptr) {
+        state->error = error;
+      }
+      ++state->numFinished;
+      state->finishedCv.notify_all();
+    }
+  };
+  for (auto i = 1; i < numStreams; ++i) {
+    executor_->add(runStreams);
+  }
+  runStreams();
+  // The buffers belong to the caller's pins, so all claimed streams must finish
+  // before returning, also on error.
+  std::unique_lock<std::mutex> l(state->mutex);
+  state->finishedCv.wait(l, [&]() { return state->numFinished == numStreams; });
+  if (state->error != nullptr) {
+    std::rethrow_exception(state->error);
+  }
+}
+
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const std::vector<CachePin>& pins,
     int32_t begin) {
@@ -391,6 +518,14 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
 
+    std::vector<uint32_t> checksums;
+    if (checkpointIntervalBytes_ > 0) {
+      checksums.reserve(numWritten);
+      for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
+        checksums.push_back(entryChecksum(*pins[i].checkedEntry()));
+      }
+    }
+
     const auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
     if (rc != bytes) {
       VELOX_SSD_CACHE_LOG(ERROR)
@@ -421,6 +556,10 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         stats_.bytesWritten += size;
         bytesAfterCheckpoint_ += size;
       }
+      if (checkpointIntervalBytes_ > 0) {
+        logEntriesLocked(
+            pins, storeIndex, storeIndex + numWritten, checksums);
+      }
     }
     storeIndex += numWritten;
   }
@@ -496,11 +635,20 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.readChecksumErrors += stats_.readChecksumErrors;
 }
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
+  if (numRegions_ > 0) {
+    // The regions are rewritten from the start, so none of their entries in
+    // the checkpoint may be recovered.
+    std::vector<int32_t> regions(numRegions_);
+    std::iota(regions.begin(), regions.end(), 0);
+    logEviction(regions);
+  }
   entries_.clear();
+  unverifiedEntries_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
@@ -520,11 +668,46 @@ void SsdFile::deleteFile() {
 
 void SsdFile::logEviction(const std::vector<int32_t>& regions) {
   if (checkpointIntervalBytes_ > 0) {
-    const int32_t rc = ::write(
-        evictLogFd_, regions.data(), regions.size() * sizeof(regions[0]));
-    if (rc != regions.size() * sizeof(regions[0])) {
-      checkpointError(rc, "Failed to log eviction");
+    std::string record;
+    appendNumber(record, kLogEviction);
+    appendNumber<uint64_t>(record, regions.size());
+    record.append(
+        reinterpret_cast<const char*>(regions.data()),
+        regions.size() * sizeof(regions[0]));
+    appendToLog(record, "Failed to log eviction");
+  }
+}
+
+void SsdFile::logEntriesLocked(
+    const std::vector<CachePin>& pins,
+    int32_t begin,
+    int32_t end,
+    const std::vector<uint32_t>& checksums) {
+  std::string records;
+  for (auto i = begin; i < end; ++i) {
+    auto* entry = pins[i].checkedEntry();
+    const auto fileNum = entry->key().fileNum.id();
+    if (loggedFileNums_.insert(fileNum).second) {
+      const auto name = fileIds().string(fileNum);
+      appendNumber(records, kLogFileName);
+      appendNumber(records, fileNum);
+      appendNumber<uint64_t>(records, name.size());
+      records.append(name);
     }
+    appendNumber(records, kLogEntry);
+    appendNumber(records, fileNum);
+    appendNumber<uint64_t>(records, entry->offset());
+    appendNumber<uint64_t>(
+        records, SsdRun(entry->ssdOffset(), entry->size()).bits());
+    appendNumber<uint64_t>(records, checksums[i - begin]);
+  }
+  appendToLog(records, "Failed to log written entries");
+}
+
+void SsdFile::appendToLog(std::string_view data, const char* what) {
+  const auto rc = ::write(evictLogFd_, data.data(), data.size());
+  if (rc != data.size()) {
+    checkpointError(rc, what);
   }
 }
 
@@ -544,6 +727,7 @@ void SsdFile::deleteCheckpoint(bool keepLog) {
   }
 
   checkpointDeleted_ = true;
+  loggedFileNums_.clear();
   const auto logPath = fileName_ + kLogExtension;
   int32_t logRc = 0;
   if (!keepLog) {
@@ -674,6 +858,9 @@ void SsdFile::checkpoint(bool force) {
     // log evictions. The latter might lead to data consistent issue.
     checkRc(::ftruncate(evictLogFd_, 0), "Truncate of event log");
     checkRc(::fsync(evictLogFd_), "Sync of evict log");
+    loggedFileNums_.clear();
+    // The data of all entries is synced now.
+    unverifiedEntries_.clear();
   } catch (const std::exception& e) {
     try {
       checkpointError(-1, e.what());
@@ -718,6 +905,7 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      unverifiedEntries_.clear();
       deleteCheckpoint(true);
     } catch (const std::exception& e) {
     }
@@ -775,14 +963,6 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     idMap[id] = std::move(lease);
   }
 
-  const auto logSize = ::lseek(evictLogFd_, 0, SEEK_END);
-  std::vector<uint32_t> evicted(logSize / sizeof(uint32_t));
-  const auto rc = ::pread(evictLogFd_, evicted.data(), logSize, 0);
-  VELOX_CHECK_EQ(logSize, rc, "Failed to read eviction log");
-  std::unordered_set<uint32_t> evictedMap;
-  for (auto region : evicted) {
-    evictedMap.insert(region);
-  }
   for (;;) {
     const uint64_t fileNum = readNumber<uint64_t>(state);
     if (fileNum == kCheckpointEndMarker) {
@@ -790,30 +970,127 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     }
     const uint64_t offset = readNumber<uint64_t>(state);
     const auto run = SsdRun(readNumber<uint64_t>(state));
-    // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
-      auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
-      FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
+    // The file may have a different id on restore.
+    auto it = idMap.find(fileNum);
+    VELOX_CHECK(it != idMap.end());
+    FileCacheKey key{it->second, offset};
+    entries_[std::move(key)] = run;
+  }
+  const auto evictedRegions = replayLog(idMap);
+
+  // Drop the entries past the end of the file. Count the regions the file has
+  // grown by after the snapshot and size each region by its entries.
+  const int32_t fileRegions = fileSize_ / kRegionSize;
+  std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    const auto end = it->second.offset() + it->second.size();
+    const auto region = regionIndex(it->second.offset());
+    if (region >= fileRegions || end > fileSize_) {
+      unverifiedEntries_.erase(it->first);
+      it = entries_.erase(it);
+      continue;
     }
+    numRegions_ = std::max(numRegions_, region + 1);
+    regionSizes_[region] = std::max<uint32_t>(
+        regionSizes_[region], end - region * kRegionSize);
+    ++it;
   }
+
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
-  // Set the writable regions by deduplicated evicted regions.
+  // Set the writable regions by deduplicated evicted regions. Writes continue
+  // after the entries logged into them.
   writableRegions_.clear();
-  for (auto region : evictedMap) {
-    writableRegions_.push_back(region);
+  for (auto region : evictedRegions) {
+    if (region < numRegions_) {
+      writableRegions_.push_back(region);
+    }
   }
   tracker_.setRegionScores(scores);
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} regions with {} free.",
+      "Starting shard {} from checkpoint with {} entries, {} from the log, "
+      "{} regions with {} free.",
       shardId_,
       entries_.size(),
+      unverifiedEntries_.size(),
       numRegions_,
       writableRegions_.size());
 }
 
+std::unordered_set<int32_t> SsdFile::replayLog(
+    std::unordered_map<uint64_t, StringIdLease>& idMap) {
+  const uint64_t logSize = ::lseek(evictLogFd_, 0, SEEK_END);
+  std::string log(logSize, 0);
+  const auto rc = ::pread(evictLogFd_, log.data(), logSize, 0);
+  VELOX_CHECK_EQ(
+      logSize, static_cast<uint64_t>(rc), "Failed to read checkpoint log");
+
+  std::unordered_set<int32_t> evictedRegions;
+  uint64_t position = 0;
+  // A crash while appending may leave a partial record at the end.
+  const auto hasBytes = [&](uint64_t size) {
+    return position + size <= logSize;
+  };
+  const auto next = [&]() {
+    uint64_t value;
+    ::memcpy(&value, log.data() + position, sizeof(value));
+    position += sizeof(value);
+    return value;
+  };
+  while (hasBytes(2 * sizeof(uint64_t))) {
+    const auto tag = next();
+    if (tag == kLogEviction) {
+      const auto numRegions = next();
+      if (!hasBytes(numRegions * sizeof(int32_t))) {
+        break;
+      }
+      std::unordered_set<int32_t> regions;
+      for (uint64_t i = 0; i < numRegions; ++i) {
+        int32_t region;
+        ::memcpy(&region, log.data() + position, sizeof(region));
+        position += sizeof(region);
+        regions.insert(region);
+        evictedRegions.insert(region);
+      }
+      for (auto it = entries_.begin(); it != entries_.end();) {
+        if (regions.count(regionIndex(it->second.offset())) != 0) {
+          unverifiedEntries_.erase(it->first);
+          it = entries_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    } else if (tag == kLogFileName) {
+      if (!hasBytes(2 * sizeof(uint64_t))) {
+        break;
+      }
+      const auto fileNum = next();
+      const auto length = next();
+      if (!hasBytes(length)) {
+        break;
+      }
+      idMap[fileNum] = StringIdLease(
+          fileIds(), std::string_view(log.data() + position, length));
+      position += length;
+    } else if (tag == kLogEntry) {
+      if (!hasBytes(4 * sizeof(uint64_t))) {
+        break;
+      }
+      const auto fileNum = next();
+      const auto offset = next();
+      const auto runBits = next();
+      const uint32_t checksum = next();
+      auto it = idMap.find(fileNum);
+      VELOX_CHECK(it != idMap.end(), "Checkpoint log entry without file name");
+      FileCacheKey key{it->second, offset};
+      entries_[key] = SsdRun(runBits);
+      unverifiedEntries_[std::move(key)] = {runBits, checksum};
+    } else {
+      VELOX_FAIL("Bad checkpoint log record tag {}", tag);
+    }
+  }
+  return evictedRegions;
+}
+
 } // namespace facebook::velox::cache
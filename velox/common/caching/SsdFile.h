@@ -20,10 +20,14 @@
 #include "velox/common/caching/SsdFileTracker.h"
 #include "velox/common/file/File.h"
 
+#include <folly/container/F14Set.h>
 #include <gflags/gflags.h>
+#include <unordered_map>
+#include <unordered_set>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_int32(ssd_max_parallel_reads);
 
 namespace facebook::velox::cache {
 
@@ -144,6 +148,7 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    readChecksumErrors = tsanAtomicValue(other.readChecksumErrors);
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +168,9 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Entries recovered from the checkpoint log whose data did not match the
+  // logged checksum.
+  tsan_atomic<uint32_t> readChecksumErrors{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -193,13 +201,18 @@ class SsdFile {
   void write(std::vector<CachePin>& pins);
 
   // Finds an entry for 'key'. If no entry is found, the returned pin is empty.
+  // The first find() of an entry recovered from the checkpoint log reads the
+  // entry and verifies its checksum. An entry that fails verification is
+  // erased and not found.
   SsdPin find(RawFileCacheKey key);
 
   // Erases 'key'
   bool erase(RawFileCacheKey key);
 
   // Copies the data in 'ssdPins' into 'pins'. Coalesces IO for nearby
-  // entries if they are in ascending order and near enough.
+  // entries if they are in ascending order and near enough. If there is an
+  // executor, up to FLAGS_ssd_max_parallel_reads of the coalesced reads are
+  // in flight at a time.
   CoalesceIoStats load(
       const std::vector<SsdPin>& ssdPins,
       const std::vector<CachePin>& pins);
@@ -248,7 +261,10 @@ class SsdFile {
   // Writes a checkpoint state that can be recovered from. The
   // checkpoint is serialized on 'mutex_'. If 'force' is false,
   // rechecks that at least 'checkpointIntervalBytes_' have been
-  // written since last checkpoint and silently returns if not.
+  // written since last checkpoint and silently returns if not. The
+  // checkpoint is a snapshot of 'entries_' plus a log of the evictions and
+  // writes after the snapshot. Recovery replays the log over the snapshot,
+  // so entries written between snapshots also survive a restart.
   void checkpoint(bool force = false);
 
   /// Returns true if copy on write is disabled for this file. Used in testing.
@@ -257,7 +273,7 @@ class SsdFile {
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  static constexpr const char* kCheckpointMagic = "CPT2";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -289,6 +305,18 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // A coalesced read of load().
+  struct ReadRequest {
+    uint64_t offset;
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  // Performs 'reads'. Spreads them over the calling thread and up to
+  // FLAGS_ssd_max_parallel_reads - 1 tasks on 'executor_' so that the device
+  // sees several reads at a time. Returns after all reads are done and
+  // rethrows the first error.
+  void readBatch(const std::vector<ReadRequest>& reads);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
@@ -312,10 +340,44 @@ class SsdFile {
   // the files for making new checkpoints.
   void initializeCheckpoint();
 
+  // Tags of the records in the checkpoint log. An eviction record is followed
+  // by the number of regions and the region indices. A file name record is
+  // followed by the file id, the name length and the name. An entry record is
+  // followed by the file id, the offset in the file, the SsdRun bits and the
+  // checksum of the data.
+  static constexpr uint64_t kLogEviction = 1;
+  static constexpr uint64_t kLogFileName = 2;
+  static constexpr uint64_t kLogEntry = 3;
+
   // Synchronously logs that 'regions' are no longer valid in a possibly xisting
   // checkpoint.
   void logEviction(const std::vector<int32_t>& regions);
 
+  // Logs the entries of 'pins' from 'begin' to 'end' that have just been
+  // written with their 'checksums'. Called inside 'mutex_'. The log is not
+  // synced. Unsynced entries are caught by the checksums on recovery.
+  void logEntriesLocked(
+      const std::vector<CachePin>& pins,
+      int32_t begin,
+      int32_t end,
+      const std::vector<uint32_t>& checksums);
+
+  // Appends 'data' to the checkpoint log. 'what' describes the data for
+  // errors.
+  void appendToLog(std::string_view data, const char* what);
+
+  // Replays the checkpoint log over the entries restored from the snapshot.
+  // Returns the regions evicted after the snapshot.
+  std::unordered_set<int32_t> replayLog(
+      std::unordered_map<uint64_t, StringIdLease>& idMap);
+
+  // Reads the data of 'run' recovered for 'key' and compares its checksum
+  // with 'checksum'. Erases the entry on mismatch. Returns true on match.
+  bool verifyRecoveredEntry(
+      const FileCacheKey& key,
+      SsdRun run,
+      uint32_t checksum);
+
   static constexpr const char* kLogExtension = ".log";
   static constexpr const char* kCheckpointExtension = ".cpt";
 
@@ -373,7 +435,7 @@ class SsdFile {
   // checkpointing fails.
   int64_t checkpointIntervalBytes_{0};
 
-  // Executor for async fsync in checkpoint.
+  // Executor for async fsync in checkpoint and parallel reads in load().
   folly::Executor* executor_;
 
   // Count of bytes written after last checkpoint.
@@ -384,6 +446,15 @@ class SsdFile {
 
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
+
+  // Ids of the files that have a name record in the checkpoint log.
+  folly::F14FastSet<uint64_t> loggedFileNums_;
+
+  // SsdRun bits and checksums of the entries recovered from the checkpoint
+  // log that have not yet been verified. Their data may not have reached the
+  // disk before the restart.
+  folly::F14FastMap<FileCacheKey, std::pair<uint64_t, uint32_t>>
+      unverifiedEntries_;
 };
 
 } // namespace facebook::velox::cache
@@ -80,7 +80,10 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      CacheEvictionPolicy evictionPolicy = CacheEvictionPolicy::kClock) {
     std::unique_ptr<SsdCache> ssdCache;
     if (ssdBytes > 0) {
       // tmpfs does not support O_DIRECT, so turn this off for testing.
@@ -108,7 +111,8 @@ class AsyncDataCacheTest : public testing::Test {
     memory::MmapAllocator::Options options;
     options.capacity = maxBytes;
     allocator_ = std::make_shared<memory::MmapAllocator>(options);
-    cache_ = AsyncDataCache::create(allocator_.get(), std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_.get(), std::move(ssdCache), evictionPolicy);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -578,6 +582,56 @@ TEST_F(AsyncDataCacheTest, pin) {
   EXPECT_EQ(0, cache_->incrementPrefetchPages(0));
 }
 
+TEST_F(AsyncDataCacheTest, concurrentHits) {
+  constexpr int32_t kNumKeys = 8;
+  constexpr int32_t kSize = 16 << 10;
+  constexpr int32_t kNumThreads = 16;
+  constexpr int32_t kNumHitsPerThread = 10'000;
+  initializeCache(64 << 20);
+  StringIdLease file(fileIds(), std::string_view("testingfile"));
+  for (auto i = 0; i < kNumKeys; ++i) {
+    RawFileCacheKey key{file.id(), static_cast<uint64_t>(i * kSize)};
+    auto pin = cache_->findOrCreate(key, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    initializeContents(key.fileNum + key.offset, pin.checkedEntry()->data());
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  const auto numHitsBefore = cache_->refreshStats().numHit;
+
+  // Readers of the same hot entries pin them under the shared shard mutex
+  // while other threads evict what is not pinned.
+  std::atomic<int32_t> numEvictRounds{0};
+  runThreads(kNumThreads, [&](int32_t threadIndex) {
+    for (auto i = 0; i < kNumHitsPerThread; ++i) {
+      if (threadIndex == 0 && i % 100 == 0) {
+        cache_->shrink(kSize);
+        ++numEvictRounds;
+        continue;
+      }
+      RawFileCacheKey key{
+          file.id(), static_cast<uint64_t>((i % kNumKeys) * kSize)};
+      auto pin = cache_->findOrCreate(key, kSize, nullptr);
+      if (pin.empty()) {
+        continue;
+      }
+      auto* entry = pin.checkedEntry();
+      if (entry->isExclusive()) {
+        initializeContents(key.fileNum + key.offset, entry->data());
+        entry->setExclusiveToShared();
+        continue;
+      }
+      ASSERT_EQ(key.offset, entry->offset());
+      checkContents(*entry);
+    }
+  });
+  EXPECT_LT(0, numEvictRounds);
+  EXPECT_LT(numHitsBefore, cache_->refreshStats().numHit);
+
+  const auto stats = cache_->refreshStats();
+  EXPECT_EQ(0, stats.numShared);
+  EXPECT_EQ(0, stats.numExclusive);
+}
+
 TEST_F(AsyncDataCacheTest, replace) {
   constexpr int64_t kMaxBytes = 64 << 20;
   FLAGS_velox_exception_user_stacktrace_enabled = false;
@@ -644,6 +698,95 @@ TEST_F(AsyncDataCacheTest, largeEvict) {
   LOG(INFO) << "Reties after failed evict: " << numLargeRetries_;
 }
 
+TEST_F(AsyncDataCacheTest, shrink) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  initializeCache(kMaxBytes);
+  loadLoop(0, kMaxBytes / 2);
+  const auto cachedPages = cache_->incrementCachedPages(0);
+  ASSERT_LT(0, cachedPages);
+
+  ASSERT_EQ(0, cache_->shrink(0));
+  const auto freedBytes = cache_->shrink(kMaxBytes / 8);
+  EXPECT_LT(0, freedBytes);
+  EXPECT_EQ(
+      cachedPages - freedBytes / memory::AllocationTraits::kPageSize,
+      cache_->incrementCachedPages(0));
+  EXPECT_LT(0, cache_->refreshStats().numEvict);
+}
+
+TEST_F(AsyncDataCacheTest, clockProScanResistance) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kEntrySize = 64 << 10;
+  constexpr int32_t kNumHot = 64;
+  initializeCache(kMaxBytes, 0, CacheEvictionPolicy::kClockPro);
+  StringIdLease hotFile(fileIds(), std::string_view("hotfile"));
+  StringIdLease scanFile(fileIds(), std::string_view("scanfile"));
+  auto load = [&](RawFileCacheKey key) {
+    auto pin = cache_->findOrCreate(key, kEntrySize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    if (pin.checkedEntry()->isExclusive()) {
+      initializeContents(key.fileNum + key.offset, pin.checkedEntry()->data());
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+  };
+  auto hotKey = [&](int32_t i) {
+    return RawFileCacheKey{hotFile.id(), static_cast<uint64_t>(i) * kEntrySize};
+  };
+
+  // A small working set that is read repeatedly.
+  for (auto round = 0; round < 3; ++round) {
+    for (auto i = 0; i < kNumHot; ++i) {
+      load(hotKey(i));
+    }
+  }
+  // A one-off scan of 4x the cache capacity.
+  for (auto i = 0; i < 4 * kMaxBytes / kEntrySize; ++i) {
+    load({scanFile.id(), static_cast<uint64_t>(i) * kEntrySize});
+  }
+
+  int32_t numHotLeft = 0;
+  for (auto i = 0; i < kNumHot; ++i) {
+    numHotLeft += cache_->exists(hotKey(i));
+  }
+  EXPECT_EQ(kNumHot, numHotLeft);
+  auto stats = cache_->refreshStats();
+  EXPECT_EQ(CacheEvictionPolicy::kClockPro, stats.evictionPolicy);
+  EXPECT_LE(kNumHot, stats.numHot);
+  EXPECT_LT(0, stats.numEvict);
+  EXPECT_NE(std::string::npos, stats.toString().find("CLOCK_PRO"));
+
+  // Scan entries evicted and read again soon after start hot.
+  EXPECT_EQ(0, stats.numGhostHit);
+  load({scanFile.id(), 0});
+  EXPECT_EQ(1, cache_->refreshStats().numGhostHit);
+}
+
+TEST_F(AsyncDataCacheTest, ssdAdmissionPolicy) {
+  constexpr uint64_t kRamBytes = 64 << 20;
+  constexpr uint64_t kSsdBytes = 256 << 20;
+  initializeCache(kRamBytes, kSsdBytes);
+  auto* ssdCache = cache_->ssdCache();
+  ssdCache->setAdmissionPolicy(std::make_unique<TinyLfuAdmissionPolicy>(
+      TinyLfuAdmissionPolicy::Options{1 << 10, 2}));
+  const RawFileCacheKey key{filenames_[0].id(), 0};
+
+  // An entry looked up once, as by a one-off scan, is not admitted.
+  auto pin = cache_->findOrCreate(key, 4096, nullptr);
+  ASSERT_FALSE(pin.empty());
+  auto* entry = pin.checkedEntry();
+  EXPECT_FALSE(ssdCache->shouldSaveToSsd(*entry));
+
+  // The entry is exclusive, so the second lookup returns no pin but counts as
+  // an access.
+  ASSERT_TRUE(cache_->findOrCreate(key, 4096, nullptr).empty());
+  EXPECT_TRUE(ssdCache->shouldSaveToSsd(*entry));
+
+  entry->setSsdBypass(true);
+  EXPECT_FALSE(ssdCache->shouldSaveToSsd(*entry));
+  EXPECT_NE(
+      std::string::npos, ssdCache->toString().find("TinyLfuAdmissionPolicy"));
+}
+
 TEST_F(AsyncDataCacheTest, outOfCapacity) {
   const int64_t kMaxBytes = 64
       << 20; // 64MB as MmapAllocator's min size is 64MB
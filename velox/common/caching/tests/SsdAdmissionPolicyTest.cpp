@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/SsdAdmissionPolicy.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(SsdAdmissionPolicyTest, frequency) {
+  TinyLfuAdmissionPolicy policy({1 << 16, 2, 1 << 30});
+  for (auto i = 0; i < 1'000; ++i) {
+    for (auto j = 0; j <= i % 4; ++j) {
+      policy.recordAccess({1, i * 1024UL});
+    }
+  }
+  // Count-min estimates never undercount. With 64K counters for 1000 keys the
+  // estimates are mostly exact.
+  int32_t numExact = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    const auto frequency = policy.frequency({1, i * 1024UL});
+    ASSERT_LE(i % 4 + 1, frequency);
+    numExact += frequency == i % 4 + 1;
+  }
+  EXPECT_LT(990, numExact);
+  EXPECT_EQ(0, policy.frequency({2, 0}));
+
+  // Counters saturate at 15.
+  for (auto i = 0; i < 100; ++i) {
+    policy.recordAccess({3, 0});
+  }
+  EXPECT_EQ(15, policy.frequency({3, 0}));
+}
+
+TEST(SsdAdmissionPolicyTest, reset) {
+  constexpr int32_t kSampleSize = 100;
+  TinyLfuAdmissionPolicy policy({1 << 16, 2, kSampleSize});
+  for (auto i = 0; i < 8; ++i) {
+    policy.recordAccess({1, 0});
+  }
+  EXPECT_EQ(8, policy.frequency({1, 0}));
+  EXPECT_EQ(0, policy.numResets());
+
+  // Accesses to other keys age out the frequency of {1, 0}.
+  for (auto i = 8; i < kSampleSize; ++i) {
+    policy.recordAccess({2, static_cast<uint64_t>(i)});
+  }
+  EXPECT_EQ(1, policy.numResets());
+  EXPECT_EQ(4, policy.frequency({1, 0}));
+
+  for (auto i = 0; i < kSampleSize; ++i) {
+    policy.recordAccess({2, static_cast<uint64_t>(i)});
+  }
+  EXPECT_EQ(2, policy.numResets());
+  EXPECT_EQ(2, policy.frequency({1, 0}));
+}
@@ -18,9 +18,12 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 using namespace facebook::velox;
 using namespace facebook::velox::cache;
@@ -53,7 +56,9 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      folly::Executor* executor = nullptr,
+      int64_t checkpointIntervalBytes = 0) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(MemoryAllocator::getInstance());
@@ -62,11 +67,16 @@ class SsdFileTest : public testing::Test {
 
     tempDirectory_ = exec::test::TempDirectoryPath::create();
     ssdFile_ = std::make_unique<SsdFile>(
-        fmt::format("{}/ssdtest", tempDirectory_->path),
+        ssdFilePath(),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
-        setNoCowFlag);
+        checkpointIntervalBytes,
+        setNoCowFlag,
+        executor);
+  }
+
+  std::string ssdFilePath() const {
+    return fmt::format("{}/ssdtest", tempDirectory_->path);
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -299,6 +309,120 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, parallelLoad) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  initializeCache(128 * kMB, kSsdSize, false, executor.get());
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+  ssdFile_->write(pins);
+  pins.clear();
+  cache_->clear();
+
+  for (const auto maxParallelReads : {1, 3, 8}) {
+    SCOPED_TRACE(fmt::format("maxParallelReads {}", maxParallelReads));
+    FLAGS_ssd_max_parallel_reads = maxParallelReads;
+    // Every other entry so that the load has several coalesced reads.
+    auto allPins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+    std::vector<CachePin> loadPins;
+    std::vector<SsdPin> ssdPins;
+    for (auto i = 0; i < allPins.size(); i += 2) {
+      auto* entry = allPins[i].checkedEntry();
+      ASSERT_TRUE(entry->isExclusive());
+      // Clears the initialized contents so that the check sees the SSD data.
+      for (auto run = 0; run < entry->data().numRuns(); ++run) {
+        std::memset(
+            entry->data().runAt(run).data(),
+            0,
+            entry->data().runAt(run).numBytes());
+      }
+      ssdPins.push_back(ssdFile_->find(
+          RawFileCacheKey{fileName_.id(), entry->key().offset}));
+      ASSERT_FALSE(ssdPins.back().empty());
+      loadPins.push_back(std::move(allPins[i]));
+    }
+    allPins.clear();
+    const auto stats = ssdFile_->load(ssdPins, loadPins);
+    ASSERT_GT(stats.numIos, 1);
+    for (const auto& pin : loadPins) {
+      checkContents(pin.entry()->data(), pin.entry()->size());
+    }
+    ssdPins.clear();
+    loadPins.clear();
+    cache_->clear();
+  }
+  FLAGS_ssd_max_parallel_reads = 8;
+}
+
+TEST_F(SsdFileTest, checkpointLogRecovery) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  // Large enough that only the explicit checkpoint below is made.
+  constexpr int64_t kCheckpointIntervalBytes = 1L << 40;
+  initializeCache(
+      128 * kMB, kSsdSize, false, nullptr, kCheckpointIntervalBytes);
+  auto writeEntries = [&](uint64_t startOffset) {
+    std::vector<TestEntry> entries;
+    auto pins = makePins(fileName_.id(), startOffset, 4096, 64 << 10, 4 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_NE(nullptr, pin.entry()->ssdFile());
+      entries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+    return entries;
+  };
+  const auto snapshotEntries = writeEntries(0);
+  ssdFile_->checkpoint(true);
+  // Written after the snapshot, so only in the checkpoint log.
+  const auto loggedEntries = writeEntries(16 * kMB);
+  cache_->clear();
+
+  // Simulate a logged entry whose data did not reach the disk.
+  const auto& corrupted = loggedEntries[loggedEntries.size() / 2];
+  const auto fd = ::open(ssdFilePath().c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  const std::string garbage(16, 'x');
+  ASSERT_EQ(
+      garbage.size(),
+      ::pwrite(fd, garbage.data(), garbage.size(), corrupted.ssdOffset));
+  ::close(fd);
+
+  // Restart from the checkpoint.
+  ssdFile_ = std::make_unique<SsdFile>(
+      ssdFilePath(),
+      0,
+      kSsdSize / SsdFile::kRegionSize,
+      kCheckpointIntervalBytes);
+  for (const auto& entry : snapshotEntries) {
+    EXPECT_FALSE(
+        ssdFile_->find({fileName_.id(), entry.key.offset}).empty());
+  }
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(0, stats.readChecksumErrors);
+  for (const auto& entry : loggedEntries) {
+    const auto pin = ssdFile_->find({fileName_.id(), entry.key.offset});
+    EXPECT_EQ(&entry == &corrupted, pin.empty());
+  }
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(1, stats.readChecksumErrors);
+  EXPECT_TRUE(
+      ssdFile_->find({fileName_.id(), corrupted.key.offset}).empty());
+
+  // New writes do not overwrite the recovered entries.
+  writeEntries(32 * kMB);
+  cache_->clear();
+  auto pins = makePins(fileName_.id(), 16 * kMB, 4096, 64 << 10, 4 * kMB);
+  std::vector<CachePin> validPins;
+  for (auto& pin : pins) {
+    if (pin.entry()->key().offset != corrupted.key.offset) {
+      validPins.push_back(std::move(pin));
+    }
+  }
+  pins.clear();
+  readAndCheckPins(validPins);
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
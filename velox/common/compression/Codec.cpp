@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/Codec.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <lz4.h>
+#include <snappy.h>
+#include <zstd.h>
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace facebook::velox::common {
+namespace {
+
+// Keeps the compression and decompression contexts for the life of the codec.
+// ZSTD_compress() and ZSTD_decompress() make and free a context on each call,
+// which is a large part of the cost of small blocks.
+class ZstdCodec : public Codec {
+ public:
+  // The default level of folly's ZSTD codec.
+  static constexpr int32_t kLevel = 1;
+
+  ZstdCodec()
+      : compressContext_(ZSTD_createCCtx()),
+        decompressContext_(ZSTD_createDCtx()) {
+    VELOX_CHECK_NOT_NULL(compressContext_);
+    VELOX_CHECK_NOT_NULL(decompressContext_);
+  }
+
+  ~ZstdCodec() override {
+    ZSTD_freeCCtx(compressContext_);
+    ZSTD_freeDCtx(decompressContext_);
+  }
+
+  CompressionKind kind() const override {
+    return CompressionKind_ZSTD;
+  }
+
+  uint64_t maxCompressedLength(uint64_t length) const override {
+    return ZSTD_compressBound(length);
+  }
+
+  uint64_t compress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) override {
+    const auto size = ZSTD_compressCCtx(
+        compressContext_, output, outputLength, input, inputLength, kLevel);
+    VELOX_CHECK(
+        !ZSTD_isError(size),
+        "ZSTD compression failed: {}",
+        ZSTD_getErrorName(size));
+    return size;
+  }
+
+  uint64_t decompress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) override {
+    const auto size = ZSTD_decompressDCtx(
+        decompressContext_, output, outputLength, input, inputLength);
+    VELOX_CHECK(
+        !ZSTD_isError(size),
+        "ZSTD decompression failed: {}",
+        ZSTD_getErrorName(size));
+    return size;
+  }
+
+  std::optional<uint64_t> decompressedLength(
+      const char* input,
+      uint64_t inputLength) const override {
+    const auto size = ZSTD_getFrameContentSize(input, inputLength);
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR) {
+      return std::nullopt;
+    }
+    return size;
+  }
+
+ private:
+  ZSTD_CCtx* const compressContext_;
+  ZSTD_DCtx* const decompressContext_;
+};
+
+// LZ4 block format without a size header, as written by folly's LZ4 codec.
+class Lz4Codec : public Codec {
+ public:
+  CompressionKind kind() const override {
+    return CompressionKind_LZ4;
+  }
+
+  uint64_t maxCompressedLength(uint64_t length) const override {
+    return LZ4_compressBound(length);
+  }
+
+  uint64_t compress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) override {
+    const auto size =
+        LZ4_compress_default(input, output, inputLength, outputLength);
+    VELOX_CHECK_GT(size, 0, "LZ4 compression failed");
+    return size;
+  }
+
+  uint64_t decompress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) override {
+    const auto size =
+        LZ4_decompress_safe(input, output, inputLength, outputLength);
+    VELOX_CHECK_GE(size, 0, "LZ4 decompression failed");
+    return size;
+  }
+};
+
+class SnappyCodec : public Codec {
+ public:
+  CompressionKind kind() const override {
+    return CompressionKind_SNAPPY;
+  }
+
+  uint64_t maxCompressedLength(uint64_t length) const override {
+    return snappy::MaxCompressedLength(length);
+  }
+
+  uint64_t compress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) override {
+    VELOX_CHECK_GE(outputLength, maxCompressedLength(inputLength));
+    size_t size;
+    snappy::RawCompress(input, inputLength, output, &size);
+    return size;
+  }
+
+  uint64_t decompress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) override {
+    const auto size = decompressedLength(input, inputLength);
+    VELOX_CHECK(size.has_value(), "Corrupt Snappy input");
+    VELOX_CHECK_LE(
+        size.value(), outputLength, "Snappy output does not fit in buffer");
+    VELOX_CHECK(
+        snappy::RawUncompress(input, inputLength, output),
+        "Snappy decompression failed");
+    return size.value();
+  }
+
+  std::optional<uint64_t> decompressedLength(
+      const char* input,
+      uint64_t inputLength) const override {
+    size_t size;
+    if (!snappy::GetUncompressedLength(input, inputLength, &size)) {
+      return std::nullopt;
+    }
+    return size;
+  }
+};
+
+std::unique_ptr<Codec> makeBuiltinCodec(CompressionKind kind) {
+  switch (static_cast<int32_t>(kind)) {
+    case CompressionKind_ZSTD:
+      return std::make_unique<ZstdCodec>();
+    case CompressionKind_LZ4:
+      return std::make_unique<Lz4Codec>();
+    case CompressionKind_SNAPPY:
+      return std::make_unique<SnappyCodec>();
+    default:
+      return nullptr;
+  }
+}
+
+struct Registry {
+  std::mutex mutex;
+  std::unordered_map<int32_t, CodecFactory> factories;
+  // Changes on each registration so that threads drop their codecs.
+  std::atomic<uint64_t> generation{0};
+};
+
+Registry& registry() {
+  static Registry registry;
+  return registry;
+}
+} // namespace
+
+void registerCodecFactory(CompressionKind kind, CodecFactory factory) {
+  VELOX_CHECK_NOT_NULL(factory);
+  auto& instance = registry();
+  std::lock_guard<std::mutex> l(instance.mutex);
+  instance.factories[kind] = std::move(factory);
+  ++instance.generation;
+}
+
+void unregisterCodecFactory(CompressionKind kind) {
+  auto& instance = registry();
+  std::lock_guard<std::mutex> l(instance.mutex);
+  instance.factories.erase(kind);
+  ++instance.generation;
+}
+
+std::unique_ptr<Codec> makeCodec(CompressionKind kind) {
+  CodecFactory factory;
+  {
+    auto& instance = registry();
+    std::lock_guard<std::mutex> l(instance.mutex);
+    auto it = instance.factories.find(kind);
+    if (it != instance.factories.end()) {
+      factory = it->second;
+    }
+  }
+  if (factory) {
+    auto codec = factory();
+    VELOX_CHECK_NOT_NULL(codec);
+    VELOX_CHECK_EQ(codec->kind(), kind);
+    return codec;
+  }
+  return makeBuiltinCodec(kind);
+}
+
+Codec* threadLocalCodec(CompressionKind kind) {
+  struct ThreadCodecs {
+    uint64_t generation{0};
+    // nullptr for the kinds without a codec.
+    std::unordered_map<int32_t, std::unique_ptr<Codec>> codecs;
+  };
+  thread_local ThreadCodecs threadCodecs;
+  const auto generation = registry().generation.load();
+  if (threadCodecs.generation != generation) {
+    threadCodecs.codecs.clear();
+    threadCodecs.generation = generation;
+  }
+  auto it = threadCodecs.codecs.find(kind);
+  if (it == threadCodecs.codecs.end()) {
+    it = threadCodecs.codecs.emplace(kind, makeCodec(kind)).first;
+  }
+  return it->second.get();
+}
+
+} // namespace facebook::velox::common
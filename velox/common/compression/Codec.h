@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "velox/common/compression/Compression.h"
+
+namespace facebook::velox::common {
+
+/// Compresses and decompresses whole blocks between caller provided buffers,
+/// so that the file readers and serializers decompress straight into their
+/// destination. A Codec may keep working memory, e.g. ZSTD contexts, between
+/// calls and is not thread safe. threadLocalCodec() gives each thread its own.
+class Codec {
+ public:
+  virtual ~Codec() = default;
+
+  virtual CompressionKind kind() const = 0;
+
+  /// Returns the maximum size of compressing 'length' bytes.
+  virtual uint64_t maxCompressedLength(uint64_t length) const = 0;
+
+  /// Compresses 'inputLength' bytes from 'input' into 'output' which has
+  /// 'outputLength' bytes. Returns the compressed size.
+  virtual uint64_t compress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) = 0;
+
+  /// Decompresses 'inputLength' bytes from 'input' into 'output' which has
+  /// space for 'outputLength' bytes. Returns the decompressed size. Throws if
+  /// 'input' is corrupt or does not fit in 'output'.
+  virtual uint64_t decompress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t outputLength) = 0;
+
+  /// Returns the decompressed size of 'input' if the format records it.
+  virtual std::optional<uint64_t> decompressedLength(
+      const char* /*input*/,
+      uint64_t /*inputLength*/) const {
+    return std::nullopt;
+  }
+};
+
+using CodecFactory = std::function<std::unique_ptr<Codec>()>;
+
+/// Registers 'factory' for making the codecs of 'kind', replacing the previous
+/// one. This is the hook for e.g. codecs that offload to compression hardware.
+/// ZSTD, LZ4 and SNAPPY have built-in codecs. The codecs made by the previous
+/// factory are dropped on their next use by threadLocalCodec().
+void registerCodecFactory(CompressionKind kind, CodecFactory factory);
+
+/// Removes the factory of 'kind'. Built-in codecs are restored.
+void unregisterCodecFactory(CompressionKind kind);
+
+/// Returns a new codec for 'kind' or nullptr if there is no codec for 'kind'.
+/// Callers then fall back to compressionKindToCodec().
+std::unique_ptr<Codec> makeCodec(CompressionKind kind);
+
+/// Returns the calling thread's codec for 'kind' or nullptr if there is no
+/// codec for 'kind'. The codec is reused across calls so that its setup is
+/// paid once per thread instead of once per block.
+Codec* threadLocalCodec(CompressionKind kind);
+
+} // namespace facebook::velox::common
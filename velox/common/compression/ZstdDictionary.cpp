@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/compression/ZstdDictionary.h"
+#include "velox/common/base/Exceptions.h"
+
+#include <zdict.h>
+#include <zstd.h>
+
+namespace facebook::velox::common {
+namespace {
+struct CompressContextDeleter {
+  void operator()(ZSTD_CCtx* context) const {
+    ZSTD_freeCCtx(context);
+  }
+};
+
+struct DecompressContextDeleter {
+  void operator()(ZSTD_DCtx* context) const {
+    ZSTD_freeDCtx(context);
+  }
+};
+
+// The contexts hold the working memory of (de)compression and are reused
+// across calls on the same thread.
+ZSTD_CCtx* compressContext() {
+  thread_local std::unique_ptr<ZSTD_CCtx, CompressContextDeleter> context(
+      ZSTD_createCCtx());
+  return context.get();
+}
+
+ZSTD_DCtx* decompressContext() {
+  thread_local std::unique_ptr<ZSTD_DCtx, DecompressContextDeleter> context(
+      ZSTD_createDCtx());
+  return context.get();
+}
+} // namespace
+
+ZstdDictionary::ZstdDictionary(std::string data, int32_t level)
+    : data_(std::move(data)),
+      id_(ZDICT_getDictID(data_.data(), data_.size())),
+      compressDictionary_(
+          ZSTD_createCDict(data_.data(), data_.size(), level)),
+      decompressDictionary_(ZSTD_createDDict(data_.data(), data_.size())) {
+  VELOX_CHECK_NE(id_, 0, "Invalid ZSTD dictionary");
+  VELOX_CHECK_NOT_NULL(compressDictionary_);
+  VELOX_CHECK_NOT_NULL(decompressDictionary_);
+}
+
+ZstdDictionary::~ZstdDictionary() {
+  ZSTD_freeCDict(compressDictionary_);
+  ZSTD_freeDDict(decompressDictionary_);
+}
+
+std::unique_ptr<ZstdDictionary> ZstdDictionary::train(
+    const std::string& samples,
+    const std::vector<size_t>& sampleSizes,
+    size_t maxSize,
+    int32_t level) {
+  std::string data(maxSize, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      data.data(),
+      data.size(),
+      samples.data(),
+      sampleSizes.data(),
+      sampleSizes.size());
+  if (ZDICT_isError(size)) {
+    VLOG(1) << "Failed to train ZSTD dictionary on " << sampleSizes.size()
+            << " samples: " << ZDICT_getErrorName(size);
+    return nullptr;
+  }
+  data.resize(size);
+  return std::make_unique<ZstdDictionary>(std::move(data), level);
+}
+
+size_t ZstdDictionary::maxCompressedLength(size_t size) {
+  return ZSTD_compressBound(size);
+}
+
+size_t ZstdDictionary::compress(
+    const char* input,
+    size_t size,
+    char* output,
+    size_t outputSize) const {
+  const auto compressedSize = ZSTD_compress_usingCDict(
+      compressContext(), output, outputSize, input, size, compressDictionary_);
+  VELOX_CHECK(
+      !ZSTD_isError(compressedSize),
+      "ZSTD compression failed: {}",
+      ZSTD_getErrorName(compressedSize));
+  return compressedSize;
+}
+
+void ZstdDictionary::decompress(
+    const char* input,
+    size_t size,
+    char* output,
+    size_t outputSize) const {
+  const auto uncompressedSize = ZSTD_decompress_usingDDict(
+      decompressContext(),
+      output,
+      outputSize,
+      input,
+      size,
+      decompressDictionary_);
+  VELOX_CHECK(
+      !ZSTD_isError(uncompressedSize),
+      "ZSTD decompression failed: {}",
+      ZSTD_getErrorName(uncompressedSize));
+  VELOX_CHECK_EQ(uncompressedSize, outputSize);
+}
+
+uint32_t ZstdDictionary::frameDictionaryId(const char* input, size_t size) {
+  return ZSTD_getDictID_fromFrame(input, size);
+}
+
+} // namespace facebook::velox::common
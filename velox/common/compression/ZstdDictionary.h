@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// A ZSTD dictionary for compressing many small buffers with similar
+/// contents, e.g. the pages sent to one exchange destination, which compress
+/// poorly one by one. The dictionary is trained on samples of such buffers
+/// and must be available for decompressing the buffers compressed with it.
+class ZstdDictionary {
+ public:
+  static constexpr int32_t kDefaultLevel = 3;
+
+  /// Creates a dictionary from its serialized 'data', e.g. as received from
+  /// the producer of the compressed buffers.
+  explicit ZstdDictionary(std::string data, int32_t level = kDefaultLevel);
+
+  ~ZstdDictionary();
+
+  /// Trains a dictionary of at most 'maxSize' bytes on 'samples' which holds
+  /// the samples back to back with sizes 'sampleSizes'. Returns nullptr if
+  /// 'samples' are not enough to train a dictionary.
+  static std::unique_ptr<ZstdDictionary> train(
+      const std::string& samples,
+      const std::vector<size_t>& sampleSizes,
+      size_t maxSize,
+      int32_t level = kDefaultLevel);
+
+  /// The id of the dictionary. Frames compressed with the dictionary carry
+  /// this id.
+  uint32_t id() const {
+    return id_;
+  }
+
+  /// The serialized dictionary.
+  const std::string& data() const {
+    return data_;
+  }
+
+  /// Returns the maximum size of compressing 'size' bytes.
+  static size_t maxCompressedLength(size_t size);
+
+  /// Compresses 'size' bytes from 'input' into 'output' which has
+  /// 'outputSize' bytes. Returns the compressed size.
+  size_t compress(
+      const char* input,
+      size_t size,
+      char* output,
+      size_t outputSize) const;
+
+  /// Decompresses 'size' bytes from 'input' into 'output' which has space for
+  /// exactly the 'outputSize' uncompressed bytes.
+  void decompress(
+      const char* input,
+      size_t size,
+      char* output,
+      size_t outputSize) const;
+
+  /// Returns the id of the dictionary used to compress the frame in 'input'
+  /// or 0 if the frame is compressed without a dictionary.
+  static uint32_t frameDictionaryId(const char* input, size_t size);
+
+ private:
+  const std::string data_;
+  const uint32_t id_;
+  ZSTD_CDict_s* compressDictionary_;
+  ZSTD_DDict_s* decompressDictionary_;
+};
+
+} // namespace facebook::velox::common
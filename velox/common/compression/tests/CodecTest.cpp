@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/VeloxException.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/compression/Codec.h"
+
+namespace facebook::velox::common {
+namespace {
+
+std::string testData() {
+  std::string data;
+  for (auto i = 0; i < 10'000; ++i) {
+    data += fmt::format("row {} value {};", i, i % 17);
+  }
+  return data;
+}
+
+class CodecTest : public testing::TestWithParam<CompressionKind> {};
+
+TEST_P(CodecTest, roundTrip) {
+  auto* codec = threadLocalCodec(GetParam());
+  ASSERT_NE(codec, nullptr);
+  EXPECT_EQ(GetParam(), codec->kind());
+  // The thread keeps its codec.
+  EXPECT_EQ(codec, threadLocalCodec(GetParam()));
+
+  const auto data = testData();
+  std::string compressed(codec->maxCompressedLength(data.size()), '\0');
+  const auto compressedSize = codec->compress(
+      data.data(), data.size(), compressed.data(), compressed.size());
+  EXPECT_LT(compressedSize, data.size());
+
+  std::string decompressed(data.size(), '\0');
+  EXPECT_EQ(
+      data.size(),
+      codec->decompress(
+          compressed.data(),
+          compressedSize,
+          decompressed.data(),
+          decompressed.size()));
+  EXPECT_EQ(data, decompressed);
+
+  // Output that is too small.
+  EXPECT_THROW(
+      codec->decompress(
+          compressed.data(), compressedSize, decompressed.data(), 100),
+      VeloxException);
+}
+
+// The codecs read the format of the folly codecs used by the serializers and
+// writers.
+TEST_P(CodecTest, decompressFolly) {
+  const auto data = testData();
+  auto follyCodec = compressionKindToCodec(GetParam());
+  auto compressed = follyCodec->compress(
+      folly::IOBuf::wrapBuffer(data.data(), data.size()).get());
+  compressed->coalesce();
+  std::string decompressed(data.size(), '\0');
+  EXPECT_EQ(
+      data.size(),
+      threadLocalCodec(GetParam())
+          ->decompress(
+              reinterpret_cast<const char*>(compressed->data()),
+              compressed->length(),
+              decompressed.data(),
+              decompressed.size()));
+  EXPECT_EQ(data, decompressed);
+}
+
+VELOX_INSTANTIATE_TEST_SUITE_P(
+    CodecTest,
+    CodecTest,
+    testing::Values(
+        CompressionKind_ZSTD,
+        CompressionKind_LZ4,
+        CompressionKind_SNAPPY));
+
+class CopyCodec : public Codec {
+ public:
+  CompressionKind kind() const override {
+    return CompressionKind_ZLIB;
+  }
+
+  uint64_t maxCompressedLength(uint64_t length) const override {
+    return length;
+  }
+
+  uint64_t compress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t /*outputLength*/) override {
+    memcpy(output, input, inputLength);
+    return inputLength;
+  }
+
+  uint64_t decompress(
+      const char* input,
+      uint64_t inputLength,
+      char* output,
+      uint64_t /*outputLength*/) override {
+    memcpy(output, input, inputLength);
+    return inputLength;
+  }
+};
+
+TEST(CodecRegistryTest, registerFactory) {
+  EXPECT_EQ(nullptr, threadLocalCodec(CompressionKind_ZLIB));
+  EXPECT_EQ(nullptr, makeCodec(CompressionKind_NONE));
+
+  int32_t numMade = 0;
+  registerCodecFactory(CompressionKind_ZLIB, [&]() {
+    ++numMade;
+    return std::make_unique<CopyCodec>();
+  });
+  auto* codec = threadLocalCodec(CompressionKind_ZLIB);
+  ASSERT_NE(nullptr, codec);
+  EXPECT_EQ(codec, threadLocalCodec(CompressionKind_ZLIB));
+  EXPECT_EQ(1, numMade);
+
+  unregisterCodecFactory(CompressionKind_ZLIB);
+  EXPECT_EQ(nullptr, threadLocalCodec(CompressionKind_ZLIB));
+  EXPECT_NE(nullptr, threadLocalCodec(CompressionKind_ZSTD));
+}
+
+} // namespace
+} // namespace facebook::velox::common
@@ -17,6 +17,16 @@
 #include "velox/common/base/Exceptions.h"
 
 namespace facebook::velox::common {
+SpillFileFormat stringToSpillFileFormat(const std::string& format) {
+  if (format == "presto") {
+    return SpillFileFormat::kPresto;
+  }
+  if (format == "compact_row") {
+    return SpillFileFormat::kCompactRow;
+  }
+  VELOX_USER_FAIL("Unsupported spill file format: {}", format);
+}
+
 SpillConfig::SpillConfig(
     const std::string& _filePath,
     uint64_t _maxFileSize,
@@ -30,7 +40,10 @@ SpillConfig::SpillConfig(
     int32_t _maxSpillLevel,
     uint64_t _writerFlushThresholdSize,
     int32_t _testSpillPct,
-    const std::string& _compressionKind)
+    const std::string& _compressionKind,
+    const std::string& _fileFormat,
+    int32_t _readAheadBuffers,
+    uint64_t _maxReadAheadBytes)
     : filePath(_filePath),
       maxFileSize(
           _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -45,11 +58,25 @@ SpillConfig::SpillConfig(
       maxSpillLevel(_maxSpillLevel),
       writerFlushThresholdSize(_writerFlushThresholdSize),
       testSpillPct(_testSpillPct),
-      compressionKind(common::stringToCompressionKind(_compressionKind)) {
+      compressionKind(
+          _compressionKind == kAdaptiveSpillCompression
+              ? CompressionKind_NONE
+              : common::stringToCompressionKind(_compressionKind)),
+      adaptiveCompression(_compressionKind == kAdaptiveSpillCompression),
+      fileFormat(stringToSpillFileFormat(_fileFormat)),
+      readAheadBuffers(_readAheadBuffers),
+      maxReadAheadBytes(_maxReadAheadBytes) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
       "Spillable memory reservation growth pct should not be lower than minimum available pct");
+  VELOX_USER_CHECK(
+      fileFormat == SpillFileFormat::kPresto ||
+          compressionKind == CompressionKind_NONE,
+      "Spill compression is only supported with the presto spill file format");
+  VELOX_USER_CHECK(
+      fileFormat == SpillFileFormat::kPresto || !adaptiveCompression,
+      "Spill compression is only supported with the presto spill file format");
 }
 
 int32_t SpillConfig::joinSpillLevel(uint8_t startBitOffset) const {
@@ -21,6 +21,24 @@
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
+/// Specifies the serialization format of the spill files.
+enum class SpillFileFormat {
+  /// Columnar Presto serialization format. Supports compression.
+  kPresto,
+  /// Row-wise CompactRow format. Each row is written with its byte size and
+  /// rows are read back without decoding per-column streams. Does not support
+  /// compression.
+  kCompactRow,
+};
+
+/// Converts 'format' which is one of "presto" or "compact_row" to
+/// SpillFileFormat.
+SpillFileFormat stringToSpillFileFormat(const std::string& format);
+
+/// The compression kind which picks the compression of each spill file
+/// adaptively. See SpillConfig::adaptiveCompression.
+inline constexpr std::string_view kAdaptiveSpillCompression{"adaptive"};
+
 /// Specifies the config for spilling.
 struct SpillConfig {
   SpillConfig(
@@ -36,7 +54,10 @@ struct SpillConfig {
       int32_t _maxSpillLevel,
       uint64_t _writerFlushThresholdSize,
       int32_t _testSpillPct,
-      const std::string& _compressionKind);
+      const std::string& _compressionKind,
+      const std::string& _fileFormat = "presto",
+      int32_t _readAheadBuffers = 0,
+      uint64_t _maxReadAheadBytes = 0);
 
   /// Returns the hash join spilling level with given 'startBitOffset'.
   ///
@@ -103,5 +124,22 @@ struct SpillConfig {
 
   /// CompressionKind when spilling, CompressionKind_NONE means no compression.
   common::CompressionKind compressionKind;
+
+  /// If true, the compression of each spill file is chosen among none, LZ4
+  /// and ZSTD from the measured compression ratio, codec throughput and disk
+  /// write throughput, instead of 'compressionKind'. Set by the "adaptive"
+  /// compression kind.
+  bool adaptiveCompression;
+
+  /// The serialization format of the spill files.
+  SpillFileFormat fileFormat;
+
+  /// The max number of read buffers read ahead per spill file on 'executor'
+  /// when merging sorted spill files. 0 disables read-ahead.
+  int32_t readAheadBuffers;
+
+  /// The memory budget of the read-ahead buffers of all the spill files in a
+  /// merge.
+  uint64_t maxReadAheadBytes;
 };
 } // namespace facebook::velox::common
@@ -19,6 +19,7 @@
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <cstdlib>
 #include <memory>
 #include <stdexcept>
 
@@ -94,8 +95,26 @@ uint64_t InMemoryWriteFile::size() const {
   return file_->size();
 }
 
-LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
-  fd_ = open(path_.c_str(), O_RDONLY);
+LocalReadFile::LocalReadFile(
+    std::string_view path,
+    folly::Executor* executor,
+    bool directIo)
+    : path_(path), executor_(executor) {
+#ifdef O_DIRECT
+  if (directIo) {
+    fd_ = open(path_.c_str(), O_RDONLY | O_DIRECT);
+    // Some file systems, e.g. tmpfs, do not support O_DIRECT. Open errors are
+    // reported by the buffered open below.
+    directIo_ = fd_ >= 0;
+    if (!directIo_ && errno == EINVAL) {
+      LOG(WARNING) << "O_DIRECT is not supported for " << path_
+                   << ", using buffered reads";
+    }
+  }
+#endif
+  if (!directIo_) {
+    fd_ = open(path_.c_str(), O_RDONLY);
+  }
   VELOX_CHECK_GE(
       fd_,
       0,
@@ -127,6 +146,10 @@ LocalReadFile::~LocalReadFile() {
 void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   bytesRead_ += length;
+  if (directIo_) {
+    preadDirect(offset, length, pos);
+    return;
+  }
   auto bytesRead = ::pread(fd_, pos, length, offset);
   VELOX_CHECK_EQ(
       bytesRead,
@@ -136,6 +159,47 @@ void LocalReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
       length);
 }
 
+void LocalReadFile::preadDirect(uint64_t offset, uint64_t length, char* pos)
+    const {
+  constexpr uint64_t kAlignmentMask = kDirectIoAlignment - 1;
+  if ((offset & kAlignmentMask) == 0 && (length & kAlignmentMask) == 0 &&
+      (reinterpret_cast<uintptr_t>(pos) & kAlignmentMask) == 0) {
+    const auto bytesRead = ::pread(fd_, pos, length, offset);
+    VELOX_CHECK_EQ(
+        bytesRead,
+        length,
+        "pread failure in LocalReadFile::preadDirect, {}",
+        folly::errnoStr(errno));
+    return;
+  }
+  // Unaligned reads go through an aligned buffer. The reads are rounded out
+  // to the alignment and may be short at the end of the file.
+  constexpr uint64_t kBounceBufferSize = 1 << 20;
+  static thread_local std::unique_ptr<char, void (*)(void*)> bounceBuffer(
+      static_cast<char*>(
+          std::aligned_alloc(kDirectIoAlignment, kBounceBufferSize)),
+      std::free);
+  VELOX_CHECK_NOT_NULL(bounceBuffer.get());
+  while (length > 0) {
+    const uint64_t alignedOffset = offset & ~kAlignmentMask;
+    const uint64_t skip = offset - alignedOffset;
+    const uint64_t readSize = std::min(
+        kBounceBufferSize, (skip + length + kAlignmentMask) & ~kAlignmentMask);
+    const uint64_t copySize = std::min(length, readSize - skip);
+    const auto bytesRead =
+        ::pread(fd_, bounceBuffer.get(), readSize, alignedOffset);
+    VELOX_CHECK_GE(
+        bytesRead,
+        static_cast<ssize_t>(skip + copySize),
+        "pread failure in LocalReadFile::preadDirect, {}",
+        folly::errnoStr(errno));
+    memcpy(pos, bounceBuffer.get() + skip, copySize);
+    offset += copySize;
+    pos += copySize;
+    length -= copySize;
+  }
+}
+
 std::string_view
 LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
   preadInternal(offset, length, static_cast<char*>(buf));
@@ -145,6 +209,19 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
 uint64_t LocalReadFile::preadv(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) const {
+  if (directIo_) {
+    // O_DIRECT needs aligned iovecs. Reads the ranges one by one and skips
+    // the dropped ones.
+    uint64_t totalBytesRead = 0;
+    for (const auto& range : buffers) {
+      if (range.data()) {
+        preadDirect(offset, range.size(), range.data());
+      }
+      offset += range.size();
+      totalBytesRead += range.size();
+    }
+    return totalBytesRead;
+  }
   // Dropped bytes sized so that a typical dropped range of 50K is not
   // too many iovecs.
   static thread_local std::vector<char> droppedBytes(16 * 1024);
@@ -198,6 +275,18 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return folly::via(
+             executor_,
+             [this, offset, buffers]() { return preadv(offset, buffers); })
+      .semi();
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
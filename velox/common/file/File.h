@@ -33,6 +33,7 @@
 #include <string>
 #include <string_view>
 
+#include <folly/Executor.h>
 #include <folly/Range.h>
 #include <folly/futures/Future.h>
 
@@ -225,7 +226,15 @@ class InMemoryWriteFile final : public WriteFile {
 
 class LocalReadFile final : public ReadFile {
  public:
-  explicit LocalReadFile(std::string_view path);
+  /// Reads 'path'. If 'executor' is set, preadvAsync() runs the reads on it
+  /// instead of the calling thread. If 'directIo' is true, the file is opened
+  /// with O_DIRECT so that reads bypass the page cache. Reads into unaligned
+  /// buffers then go through an aligned bounce buffer. Falls back to buffered
+  /// reads if the file system does not support O_DIRECT.
+  explicit LocalReadFile(
+      std::string_view path,
+      folly::Executor* executor = nullptr,
+      bool directIo = false);
 
   explicit LocalReadFile(int32_t fd);
 
@@ -240,12 +249,25 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override;
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
     return false;
   }
 
+  /// Returns true if the file is read with O_DIRECT.
+  bool directIo() const {
+    return directIo_;
+  }
+
   std::string getName() const override {
     if (path_.empty()) {
       return "<LocalReadFile>";
@@ -258,12 +280,21 @@ class LocalReadFile final : public ReadFile {
   }
 
  private:
+  // Alignment of offsets, lengths and buffers for O_DIRECT reads.
+  static constexpr uint64_t kDirectIoAlignment = 4096;
+
   void preadInternal(uint64_t offset, uint64_t length, char* FOLLY_NONNULL pos)
       const;
 
+  // Reads 'length' bytes at 'offset' into 'pos' from an O_DIRECT 'fd_'.
+  void preadDirect(uint64_t offset, uint64_t length, char* FOLLY_NONNULL pos)
+      const;
+
   std::string path_;
   int32_t fd_;
   long size_;
+  folly::Executor* const executor_{nullptr};
+  bool directIo_{false};
 };
 
 class LocalWriteFile final : public WriteFile {
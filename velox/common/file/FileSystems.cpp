@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/file/FileSystems.h"
+#include <folly/Synchronized.h>
 #include <folly/synchronization/CallOnce.h>
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/File.h"
@@ -65,6 +66,11 @@ namespace {
 
 folly::once_flag localFSInstantiationFlag;
 
+folly::Synchronized<LocalFileSystemOptions>& localFileSystemOptions() {
+  static folly::Synchronized<LocalFileSystemOptions> options;
+  return options;
+}
+
 // Implement Local FileSystem.
 class LocalFileSystem : public FileSystem {
  public:
@@ -87,7 +93,9 @@ class LocalFileSystem : public FileSystem {
   std::unique_ptr<ReadFile> openFileForRead(
       std::string_view path,
       const FileOptions& /*unused*/) override {
-    return std::make_unique<LocalReadFile>(extractPath(path));
+    const auto options = localFileSystemOptions().copy();
+    return std::make_unique<LocalReadFile>(
+        extractPath(path), options.ioExecutor, options.directIo);
   }
 
   std::unique_ptr<WriteFile> openFileForWrite(
@@ -199,7 +207,8 @@ class LocalFileSystem : public FileSystem {
 };
 } // namespace
 
-void registerLocalFileSystem() {
+void registerLocalFileSystem(const LocalFileSystemOptions& options) {
+  *localFileSystemOptions().wlock() = options;
   registerFileSystem(
       LocalFileSystem::schemeMatcher(), LocalFileSystem::fileSystemGenerator());
 }
@@ -18,8 +18,11 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/memory/MemoryPool.h"
 
+#include <folly/Executor.h>
+
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string_view>
 
 namespace facebook::velox {
@@ -37,6 +40,9 @@ namespace facebook::velox::filesystems {
 struct FileOptions {
   std::unordered_map<std::string, std::string> values;
   memory::MemoryPool* pool{nullptr};
+  /// Size of the file to read if known, e.g. from the split. File systems
+  /// that request the size when opening a file, like S3, use it instead.
+  std::optional<int64_t> fileSize;
 };
 
 /// An abstract FileSystem
@@ -105,7 +111,18 @@ void registerFileSystem(
         std::shared_ptr<const Config>,
         std::string_view)> fileSystemGenerator);
 
-/// Register the local filesystem.
-void registerLocalFileSystem();
+/// Options for the files opened by the local file system.
+struct LocalFileSystemOptions {
+  /// If set, LocalReadFile::preadvAsync() runs the reads on this executor.
+  /// Must outlive the files opened by the local file system.
+  folly::Executor* ioExecutor{nullptr};
+
+  /// If true, files are read with O_DIRECT, bypassing the page cache.
+  bool directIo{false};
+};
+
+/// Register the local filesystem. 'options' apply to the files opened after
+/// the call.
+void registerLocalFileSystem(const LocalFileSystemOptions& options = {});
 
 } // namespace facebook::velox::filesystems
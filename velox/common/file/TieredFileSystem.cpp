@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/TieredFileSystem.h"
+#include "velox/common/file/File.h"
+
+namespace facebook::velox::filesystems {
+namespace {
+
+// Accounts the appended bytes to the location of the file.
+class TieredWriteFile : public WriteFile {
+ public:
+  TieredWriteFile(
+      std::unique_ptr<WriteFile> file,
+      std::function<void(uint64_t)> onAppend)
+      : file_(std::move(file)), onAppend_(std::move(onAppend)) {}
+
+  void append(std::string_view data) override {
+    file_->append(data);
+    onAppend_(data.size());
+  }
+
+  void flush() override {
+    file_->flush();
+  }
+
+  void close() override {
+    file_->close();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+ private:
+  const std::unique_ptr<WriteFile> file_;
+  const std::function<void(uint64_t)> onAppend_;
+};
+
+std::string_view trimTrailingSlash(std::string_view path) {
+  while (!path.empty() && path.back() == '/') {
+    path.remove_suffix(1);
+  }
+  return path;
+}
+} // namespace
+
+TieredFileSystem::TieredFileSystem(
+    std::string name,
+    std::vector<StorageLocation> locations,
+    StorageAdmission admission)
+    : FileSystem(nullptr),
+      name_(std::move(name)),
+      pathPrefix_(fmt::format("{}{}", kScheme, name_)),
+      locations_(std::move(locations)),
+      admission_(std::move(admission)) {
+  VELOX_USER_CHECK(!name_.empty(), "Tiered file system name is empty");
+  VELOX_USER_CHECK_EQ(
+      name_.find('/'),
+      std::string::npos,
+      "Tiered file system name must not contain '/': {}",
+      name_);
+  VELOX_USER_CHECK(
+      !locations_.empty(), "Tiered file system {} has no locations", name_);
+  for (const auto& location : locations_) {
+    VELOX_USER_CHECK(
+        !location.directory.empty(),
+        "Storage location directory is empty in tiered file system {}",
+        name_);
+    VELOX_USER_CHECK_GT(
+        location.weight,
+        0,
+        "Storage location {} weight must be positive",
+        location.directory);
+    placements_.usedBytes.push_back(std::make_shared<std::atomic<uint64_t>>(0));
+  }
+}
+
+std::string_view TieredFileSystem::relativePath(std::string_view path) const {
+  VELOX_CHECK_EQ(
+      path.find(pathPrefix_),
+      0,
+      "Path {} is not in tiered file system {}",
+      path,
+      name_);
+  path.remove_prefix(pathPrefix_.size());
+  VELOX_CHECK(
+      path.empty() || path.front() == '/',
+      "Path {} is not in tiered file system {}",
+      path,
+      name_);
+  while (!path.empty() && path.front() == '/') {
+    path.remove_prefix(1);
+  }
+  return path;
+}
+
+std::string TieredFileSystem::locationPath(
+    int32_t index,
+    std::string_view relativePath) const {
+  const auto directory = trimTrailingSlash(locations_[index].directory);
+  if (relativePath.empty()) {
+    return std::string(directory);
+  }
+  return fmt::format("{}/{}", directory, relativePath);
+}
+
+std::shared_ptr<FileSystem> TieredFileSystem::locationFileSystem(
+    int32_t index) const {
+  return getFileSystem(locations_[index].directory, config_);
+}
+
+int32_t TieredFileSystem::selectLocation(std::string_view path) const {
+  int32_t selected = -1;
+  double selectedScore = 0;
+  for (int32_t i = 0; i < locations_.size(); ++i) {
+    const auto& location = locations_[i];
+    if (selected != -1 && location.tier > locations_[selected].tier) {
+      continue;
+    }
+    if (admission_ != nullptr && !admission_(location, path)) {
+      continue;
+    }
+    double freeFraction = 1;
+    if (location.capacity != 0) {
+      const uint64_t used = placements_.usedBytes[i]->load();
+      if (used >= location.capacity) {
+        continue;
+      }
+      freeFraction = static_cast<double>(location.capacity - used) /
+          static_cast<double>(location.capacity);
+    }
+    const double score = location.weight * freeFraction;
+    if (selected == -1 || location.tier < locations_[selected].tier ||
+        score > selectedScore) {
+      selected = i;
+      selectedScore = score;
+    }
+  }
+  VELOX_CHECK_NE(
+      selected,
+      -1,
+      "No storage location of tiered file system {} has room for {}",
+      name_,
+      path);
+  return selected;
+}
+
+int32_t TieredFileSystem::findLocation(std::string_view relativePath) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = placements_.files.find(relativePath);
+    if (it != placements_.files.end()) {
+      return it->second->location;
+    }
+  }
+  for (int32_t i = 0; i < locations_.size(); ++i) {
+    if (locationFileSystem(i)->exists(locationPath(i, relativePath))) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// static
+void TieredFileSystem::release(Placement& placement) {
+  placement.usedBytes->fetch_sub(placement.bytes.exchange(0));
+}
+
+std::unique_ptr<ReadFile> TieredFileSystem::openFileForRead(
+    std::string_view path,
+    const FileOptions& options) {
+  const auto relative = relativePath(path);
+  const auto index = findLocation(relative);
+  VELOX_CHECK_NE(index, -1, "File {} not found", path);
+  return locationFileSystem(index)->openFileForRead(
+      locationPath(index, relative), options);
+}
+
+std::unique_ptr<WriteFile> TieredFileSystem::openFileForWrite(
+    std::string_view path,
+    const FileOptions& options) {
+  const std::string relative(relativePath(path));
+  std::shared_ptr<Placement> placement;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto index = selectLocation(path);
+    placement =
+        std::make_shared<Placement>(index, placements_.usedBytes[index]);
+    auto& file = placements_.files[relative];
+    if (file != nullptr) {
+      release(*file);
+    }
+    file = placement;
+  }
+  auto file = locationFileSystem(placement->location)
+                  ->openFileForWrite(
+                      locationPath(placement->location, relative), options);
+  return std::make_unique<TieredWriteFile>(
+      std::move(file), [placement](uint64_t bytes) {
+        placement->bytes += bytes;
+        placement->usedBytes->fetch_add(bytes);
+      });
+}
+
+void TieredFileSystem::remove(std::string_view path) {
+  const std::string relative(relativePath(path));
+  const auto index = findLocation(relative);
+  if (index == -1) {
+    return;
+  }
+  locationFileSystem(index)->remove(locationPath(index, relative));
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = placements_.files.find(relative);
+  if (it != placements_.files.end()) {
+    release(*it->second);
+    placements_.files.erase(it);
+  }
+}
+
+void TieredFileSystem::rename(
+    std::string_view oldPath,
+    std::string_view newPath,
+    bool overwrite) {
+  const std::string oldRelative(relativePath(oldPath));
+  const std::string newRelative(relativePath(newPath));
+  const auto index = findLocation(oldRelative);
+  VELOX_USER_CHECK_NE(index, -1, "File {} not found", oldPath);
+  const auto newIndex = findLocation(newRelative);
+  if (newIndex != -1 && newIndex != index) {
+    VELOX_USER_CHECK(
+        overwrite,
+        "Failed to rename file {} to {} as {} exists.",
+        oldPath,
+        newPath,
+        newPath);
+    remove(newPath);
+  }
+  locationFileSystem(index)->rename(
+      locationPath(index, oldRelative),
+      locationPath(index, newRelative),
+      overwrite);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = placements_.files.find(oldRelative);
+  if (it == placements_.files.end()) {
+    return;
+  }
+  auto placement = std::move(it->second);
+  placements_.files.erase(it);
+  auto& file = placements_.files[newRelative];
+  if (file != nullptr) {
+    release(*file);
+  }
+  file = std::move(placement);
+}
+
+bool TieredFileSystem::exists(std::string_view path) {
+  return findLocation(relativePath(path)) != -1;
+}
+
+std::vector<std::string> TieredFileSystem::list(std::string_view path) {
+  const auto relative = relativePath(path);
+  std::vector<std::string> paths;
+  for (int32_t i = 0; i < locations_.size(); ++i) {
+    auto fs = locationFileSystem(i);
+    const auto directory = locationPath(i, relative);
+    if (!fs->exists(directory)) {
+      continue;
+    }
+    for (auto& entry : fs->list(directory)) {
+      std::string_view name(entry);
+      const auto pos = name.rfind('/');
+      if (pos != std::string_view::npos) {
+        name.remove_prefix(pos + 1);
+      }
+      paths.push_back(
+          relative.empty()
+              ? fmt::format("{}/{}", pathPrefix_, name)
+              : fmt::format("{}/{}/{}", pathPrefix_, relative, name));
+    }
+  }
+  return paths;
+}
+
+void TieredFileSystem::mkdir(std::string_view path) {
+  const auto relative = relativePath(path);
+  for (int32_t i = 0; i < locations_.size(); ++i) {
+    locationFileSystem(i)->mkdir(locationPath(i, relative));
+  }
+}
+
+void TieredFileSystem::rmdir(std::string_view path) {
+  const std::string relative(trimTrailingSlash(relativePath(path)));
+  for (int32_t i = 0; i < locations_.size(); ++i) {
+    auto fs = locationFileSystem(i);
+    const auto directory = locationPath(i, relative);
+    if (fs->exists(directory)) {
+      fs->rmdir(directory);
+    }
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto it = placements_.files.begin(); it != placements_.files.end();) {
+    const auto& file = it->first;
+    if (relative.empty() ||
+        (file.size() > relative.size() && file.find(relative) == 0 &&
+         file[relative.size()] == '/')) {
+      release(*it->second);
+      it = placements_.files.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+int32_t TieredFileSystem::testingLocation(std::string_view path) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = placements_.files.find(relativePath(path));
+  return it == placements_.files.end() ? -1 : it->second->location;
+}
+
+std::shared_ptr<TieredFileSystem> registerTieredFileSystem(
+    const std::string& name,
+    std::vector<StorageLocation> locations,
+    StorageAdmission admission) {
+  auto fs = std::make_shared<TieredFileSystem>(
+      name, std::move(locations), std::move(admission));
+  const auto prefix = fmt::format("{}/", fs->pathPrefix());
+  registerFileSystem(
+      [prefix](std::string_view path) {
+        return path.find(prefix) == 0 || path == trimTrailingSlash(prefix);
+      },
+      [fs](std::shared_ptr<const Config>, std::string_view) { return fs; });
+  return fs;
+}
+
+} // namespace facebook::velox::filesystems
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/file/FileSystems.h"
+
+namespace facebook::velox::filesystems {
+
+/// A directory which a TieredFileSystem places files on, e.g. a local NVMe
+/// device or a remote object store location such as "s3://bucket/spill".
+struct StorageLocation {
+  /// The root directory of the files placed on this location. Its file
+  /// system is looked up with getFileSystem().
+  std::string directory;
+
+  /// The preference of this location. New files go to the lowest tier which
+  /// has a location with room for them.
+  int32_t tier{0};
+
+  /// The max number of bytes of the files on this location. 0 means no
+  /// limit.
+  uint64_t capacity{0};
+
+  /// The relative share of new files among the locations of the same tier,
+  /// scaled by the free fraction of each location's capacity.
+  uint32_t weight{1};
+};
+
+/// Decides whether a new file 'path' may be placed on 'location'. For
+/// example, this keeps the spill files of some partitions on the local tier
+/// while the others overflow to a remote one.
+using StorageAdmission = std::function<
+    bool(const StorageLocation& location, std::string_view path)>;
+
+/// A FileSystem spreading its files over a list of storage locations. The
+/// paths are of the form "tiered://<name>/<relative path>", and a file is
+/// stored at "<location directory>/<relative path>" on the location picked
+/// when it is opened for write. The bytes written to each location are
+/// accounted against its capacity, and are released when the file or its
+/// directory is removed. Directories are created and removed on all the
+/// locations.
+///
+/// NOTE: a file's location is only known to the instance which wrote it. A
+/// file unknown to this instance is looked up on all the locations in order.
+class TieredFileSystem : public FileSystem {
+ public:
+  static constexpr std::string_view kScheme{"tiered://"};
+
+  TieredFileSystem(
+      std::string name,
+      std::vector<StorageLocation> locations,
+      StorageAdmission admission = nullptr);
+
+  std::string name() const override {
+    return fmt::format("Tiered FS {}", name_);
+  }
+
+  /// Returns the path prefix handled by this file system.
+  const std::string& pathPrefix() const {
+    return pathPrefix_;
+  }
+
+  std::unique_ptr<ReadFile> openFileForRead(
+      std::string_view path,
+      const FileOptions& options = {}) override;
+
+  std::unique_ptr<WriteFile> openFileForWrite(
+      std::string_view path,
+      const FileOptions& options = {}) override;
+
+  void remove(std::string_view path) override;
+
+  void rename(
+      std::string_view oldPath,
+      std::string_view newPath,
+      bool overwrite = false) override;
+
+  bool exists(std::string_view path) override;
+
+  std::vector<std::string> list(std::string_view path) override;
+
+  void mkdir(std::string_view path) override;
+
+  void rmdir(std::string_view path) override;
+
+  /// Returns the number of bytes of the files on location 'index'.
+  uint64_t usedBytes(int32_t index) const {
+    return placements_.usedBytes.at(index)->load();
+  }
+
+  /// Returns the index of the location of 'path' or -1 if this instance has
+  /// not placed it.
+  int32_t testingLocation(std::string_view path) const;
+
+ private:
+  // The location of a file and the bytes written to it.
+  struct Placement {
+    Placement(int32_t _location, std::shared_ptr<std::atomic<uint64_t>> _used)
+        : location(_location), usedBytes(std::move(_used)) {}
+
+    const int32_t location;
+    // The bytes of all the files on 'location'.
+    const std::shared_ptr<std::atomic<uint64_t>> usedBytes;
+    std::atomic<uint64_t> bytes{0};
+  };
+
+  struct Placements {
+    std::vector<std::shared_ptr<std::atomic<uint64_t>>> usedBytes;
+    // Keyed by relative path.
+    folly::F14FastMap<std::string, std::shared_ptr<Placement>> files;
+  };
+
+  // Returns the path of 'path' relative to the location directories.
+  std::string_view relativePath(std::string_view path) const;
+
+  // Returns the path of 'relativePath' on location 'index'.
+  std::string locationPath(int32_t index, std::string_view relativePath) const;
+
+  std::shared_ptr<FileSystem> locationFileSystem(int32_t index) const;
+
+  // Returns the location for new file 'path'. Throws if no location admits it
+  // or has room for it.
+  int32_t selectLocation(std::string_view path) const;
+
+  // Returns the location of 'relativePath' or -1 if not found.
+  int32_t findLocation(std::string_view relativePath);
+
+  // Releases the bytes of 'placement'.
+  static void release(Placement& placement);
+
+  const std::string name_;
+  const std::string pathPrefix_;
+  const std::vector<StorageLocation> locations_;
+  const StorageAdmission admission_;
+
+  mutable std::mutex mutex_;
+  Placements placements_;
+};
+
+/// Registers a TieredFileSystem named 'name' which serves the paths starting
+/// with "tiered://<name>/" and returns it. Spilling to 'locations' is enabled
+/// by passing such a path as the task spill directory.
+std::shared_ptr<TieredFileSystem> registerTieredFileSystem(
+    const std::string& name,
+    std::vector<StorageLocation> locations,
+    StorageAdmission admission = nullptr);
+
+} // namespace facebook::velox::filesystems
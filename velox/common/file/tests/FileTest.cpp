@@ -16,6 +16,8 @@
 
 #include <fcntl.h>
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -143,6 +145,40 @@ TEST(LocalFile, viaRegistry) {
   lfs->remove(filename);
 }
 
+TEST(LocalFile, directIoAndAsync) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  folly::CPUThreadPoolExecutor executor(2);
+  // Falls back to buffered reads if the temp directory does not support
+  // O_DIRECT.
+  LocalReadFile readFile(filename, &executor, true);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+
+  char head[12];
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)(kOneMB - 4)),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile.preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  filesystems::registerLocalFileSystem({&executor, true});
+  auto lfs = filesystems::getFileSystem(filename, nullptr);
+  auto registryFile = lfs->openFileForRead(filename);
+  ASSERT_TRUE(registryFile->hasPreadvAsync());
+  readData(registryFile.get());
+  filesystems::registerLocalFileSystem();
+  ASSERT_FALSE(lfs->openFileForRead(filename)->hasPreadvAsync());
+}
+
 TEST(LocalFile, rename) {
   filesystems::registerLocalFileSystem();
   auto tempFolder = ::exec::test::TempDirectoryPath::create();
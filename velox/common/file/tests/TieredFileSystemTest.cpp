@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/TieredFileSystem.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/File.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::filesystems;
+
+namespace {
+void writeFile(FileSystem& fs, const std::string& path, uint64_t size) {
+  auto file = fs.openFileForWrite(path);
+  file->append(std::string(size, 'x'));
+  file->close();
+}
+} // namespace
+
+TEST(TieredFileSystem, overflow) {
+  registerLocalFileSystem();
+  auto local = ::exec::test::TempDirectoryPath::create();
+  auto remote = ::exec::test::TempDirectoryPath::create();
+  TieredFileSystem fs("overflow", {{local->path, 0, 100}, {remote->path, 1}});
+  ASSERT_EQ(fs.pathPrefix(), "tiered://overflow");
+
+  fs.mkdir("tiered://overflow/task");
+  writeFile(fs, "tiered://overflow/task/a", 60);
+  writeFile(fs, "tiered://overflow/task/b", 60);
+  // 'a' and 'b' exceed the local capacity, so 'c' overflows.
+  writeFile(fs, "tiered://overflow/task/c", 10);
+  ASSERT_EQ(fs.testingLocation("tiered://overflow/task/a"), 0);
+  ASSERT_EQ(fs.testingLocation("tiered://overflow/task/b"), 0);
+  ASSERT_EQ(fs.testingLocation("tiered://overflow/task/c"), 1);
+  ASSERT_EQ(fs.usedBytes(0), 120);
+  ASSERT_EQ(fs.usedBytes(1), 10);
+  ASSERT_TRUE(
+      getFileSystem(local->path, nullptr)->exists(local->path + "/task/a"));
+  ASSERT_TRUE(
+      getFileSystem(remote->path, nullptr)->exists(remote->path + "/task/c"));
+
+  auto readFile = fs.openFileForRead("tiered://overflow/task/c");
+  ASSERT_EQ(readFile->size(), 10);
+  ASSERT_EQ(fs.list("tiered://overflow/task").size(), 3);
+
+  // Removing a local file makes room for new files on the local tier.
+  fs.remove("tiered://overflow/task/a");
+  ASSERT_FALSE(fs.exists("tiered://overflow/task/a"));
+  ASSERT_EQ(fs.usedBytes(0), 60);
+  writeFile(fs, "tiered://overflow/task/d", 10);
+  ASSERT_EQ(fs.testingLocation("tiered://overflow/task/d"), 0);
+
+  fs.rename("tiered://overflow/task/d", "tiered://overflow/task/e");
+  ASSERT_FALSE(fs.exists("tiered://overflow/task/d"));
+  ASSERT_EQ(fs.testingLocation("tiered://overflow/task/e"), 0);
+
+  fs.rmdir("tiered://overflow/task");
+  ASSERT_FALSE(fs.exists("tiered://overflow/task/c"));
+  ASSERT_EQ(fs.usedBytes(0), 0);
+  ASSERT_EQ(fs.usedBytes(1), 0);
+}
+
+TEST(TieredFileSystem, weight) {
+  registerLocalFileSystem();
+  auto first = ::exec::test::TempDirectoryPath::create();
+  auto second = ::exec::test::TempDirectoryPath::create();
+  TieredFileSystem fs(
+      "weight", {{first->path, 0, 1'000, 1}, {second->path, 0, 1'000, 3}});
+  // The second location is picked until three times its free fraction drops
+  // below the free fraction of the first one.
+  for (int i = 0; i < 8; ++i) {
+    writeFile(fs, fmt::format("tiered://weight/{}", i), 100);
+  }
+  ASSERT_EQ(fs.usedBytes(0), 100);
+  ASSERT_EQ(fs.usedBytes(1), 700);
+}
+
+TEST(TieredFileSystem, admission) {
+  registerLocalFileSystem();
+  auto local = ::exec::test::TempDirectoryPath::create();
+  auto remote = ::exec::test::TempDirectoryPath::create();
+  const auto localPath = local->path;
+  TieredFileSystem fs(
+      "admission",
+      {{local->path}, {remote->path, 1}},
+      [&](const StorageLocation& location, std::string_view path) {
+        return location.directory != localPath ||
+            path.find("hot") != std::string_view::npos;
+      });
+  writeFile(fs, "tiered://admission/hot", 1);
+  writeFile(fs, "tiered://admission/cold", 1);
+  ASSERT_EQ(fs.testingLocation("tiered://admission/hot"), 0);
+  ASSERT_EQ(fs.testingLocation("tiered://admission/cold"), 1);
+}
+
+TEST(TieredFileSystem, full) {
+  registerLocalFileSystem();
+  auto local = ::exec::test::TempDirectoryPath::create();
+  TieredFileSystem fs("full", {{local->path, 0, 10}});
+  writeFile(fs, "tiered://full/a", 10);
+  VELOX_ASSERT_THROW(
+      writeFile(fs, "tiered://full/b", 1),
+      "No storage location of tiered file system full has room for tiered://full/b");
+  VELOX_ASSERT_THROW(
+      fs.openFileForRead("tiered://other/a"),
+      "Path tiered://other/a is not in tiered file system full");
+}
+
+TEST(TieredFileSystem, register) {
+  registerLocalFileSystem();
+  auto local = ::exec::test::TempDirectoryPath::create();
+  auto fs = registerTieredFileSystem("registered", {{local->path}});
+  ASSERT_EQ(getFileSystem("tiered://registered/a", nullptr), fs);
+  ASSERT_EQ(getFileSystem("tiered://registered", nullptr), fs);
+  VELOX_ASSERT_THROW(
+      getFileSystem("tiered://registeredOther/a", nullptr),
+      "No registered file system matched with file path 'tiered://registeredOther/a'");
+}
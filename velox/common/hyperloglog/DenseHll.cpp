@@ -18,6 +18,7 @@
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/hyperloglog/BiasCorrection.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -89,6 +90,36 @@ int8_t getOverflowImpl(
   return 0;
 }
 
+/// Merges the 4-bit buckets of 'otherDeltas' into 'deltas' by taking the max
+/// of each bucket. Both HLLs must have the same baseline and no overflows.
+/// Returns the number of buckets with zero delta after the merge.
+int32_t mergeDeltas(int8_t* deltas, const int8_t* otherDeltas, int32_t size) {
+  using Batch = xsimd::batch<uint8_t>;
+  auto* data = reinterpret_cast<uint8_t*>(deltas);
+  auto* otherData = reinterpret_cast<const uint8_t*>(otherDeltas);
+  const Batch lowMask(0x0F);
+  const Batch highMask(0xF0);
+  const Batch zero(0);
+  int32_t numZeros = 0;
+  int32_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    const auto slots = Batch::load_unaligned(data + i);
+    const auto otherSlots = Batch::load_unaligned(otherData + i);
+    const auto low = xsimd::max(slots & lowMask, otherSlots & lowMask);
+    const auto high = xsimd::max(slots & highMask, otherSlots & highMask);
+    (low | high).store_unaligned(data + i);
+    numZeros += __builtin_popcountll(simd::toBitMask(low == zero)) +
+        __builtin_popcountll(simd::toBitMask(high == zero));
+  }
+  for (; i < size; ++i) {
+    const uint8_t low = std::max(data[i] & 0x0F, otherData[i] & 0x0F);
+    const uint8_t high = std::max(data[i] & 0xF0, otherData[i] & 0xF0);
+    data[i] = low | high;
+    numZeros += (low == 0) + (high == 0);
+  }
+  return numZeros;
+}
+
 double correctBias(double rawEstimate, int8_t indexBitLength) {
   const auto& estimates = BiasCorrection::kRawEstimates[indexBitLength - 4];
   if (rawEstimate < estimates[0] ||
@@ -143,6 +174,17 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  for (auto i = 0; i < numHashes; ++i) {
+    const int8_t value = numberOfLeadingZeros(hashes[i], indexBitLength_) + 1;
+    // A value at or below the baseline never raises a bucket. This is the
+    // common case once all buckets are populated.
+    if (value > baseline_) {
+      insert(computeIndex(hashes[i], indexBitLength_), value);
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
@@ -567,6 +609,13 @@ void DenseHll::mergeWith(
     int16_t otherOverflows,
     const uint16_t* otherOverflowBuckets,
     const int8_t* otherOverflowValues) {
+  if (baseline_ == otherBaseline && overflows_ == 0 && otherOverflows == 0) {
+    // No bucket can overflow, so the buckets merge independently.
+    baselineCount_ = mergeDeltas(deltas_.data(), otherDeltas, deltas_.size());
+    adjustBaselineIfNeeded();
+    return;
+  }
+
   int8_t newBaseline = std::max(baseline_, otherBaseline);
   int32_t baselineCount = 0;
 
@@ -238,22 +238,29 @@ void SparseHll::verify() const {
 
 void SparseHll::toDense(DenseHll& denseHll) const {
   auto indexBitLength = denseHll.indexBitLength();
-
-  for (auto i = 0; i < entries_.size(); i++) {
-    auto entry = entries_[i];
-    auto index = entry >> (32 - indexBitLength);
-    auto shiftedValue = entry << indexBitLength;
-    auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
-
-    // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
-    // were zeros, so look at the entry value, which contains the number of
-    // leading 0 *after* kIndexBitLength.
-    auto bits = kIndexBitLength - indexBitLength;
-    if (zeros >= bits) {
-      zeros = bits + decodeValue(entry);
+  auto bits = kIndexBitLength - indexBitLength;
+
+  // Entries are sorted by index, so the entries that map to the same dense
+  // bucket are adjacent. Only the largest value of each bucket is inserted.
+  for (auto i = 0; i < entries_.size();) {
+    const auto index = entries_[i] >> (32 - indexBitLength);
+    int8_t value = 0;
+    for (; i < entries_.size() && entries_[i] >> (32 - indexBitLength) == index;
+         ++i) {
+      auto entry = entries_[i];
+      auto shiftedValue = entry << indexBitLength;
+      auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
+
+      // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
+      // were zeros, so look at the entry value, which contains the number of
+      // leading 0 *after* kIndexBitLength.
+      if (zeros >= bits) {
+        zeros = bits + decodeValue(entry);
+      }
+      value = std::max<int8_t>(value, zeros + 1);
     }
 
-    denseHll.insert(index, zeros + 1);
+    denseHll.insert(index, value);
   }
 }
 
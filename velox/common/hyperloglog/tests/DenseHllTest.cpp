@@ -220,6 +220,32 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < 100'000; i++) {
+    hashes.push_back(hashOne(i));
+  }
+
+  DenseHll expected{indexBitLength, &allocator_};
+  for (auto hash : hashes) {
+    expected.insertHash(hash);
+  }
+
+  // Insert in batches of different sizes.
+  DenseHll hll{indexBitLength, &allocator_};
+  int32_t offset = 0;
+  for (auto batchSize = 1; offset < hashes.size(); batchSize *= 3) {
+    auto numHashes = std::min<int32_t>(batchSize, hashes.size() - offset);
+    hll.insertHashes(hashes.data() + offset, numHashes);
+    offset += numHashes;
+  }
+
+  ASSERT_EQ(hll.cardinality(), expected.cardinality());
+  ASSERT_EQ(serialize(hll), serialize(expected));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/io/IoScheduler.h"
+
+#include <chrono>
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::io {
+namespace {
+
+uint64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+class QueueExecutor : public folly::Executor {
+ public:
+  QueueExecutor(
+      IoScheduler* scheduler,
+      std::string queueId,
+      IoScheduler::Priority priority,
+      std::shared_ptr<IoStatistics> ioStats,
+      double weight)
+      : scheduler_(scheduler),
+        queueId_(std::move(queueId)),
+        priority_(priority),
+        ioStats_(std::move(ioStats)),
+        weight_(weight) {}
+
+  void add(folly::Func func) override {
+    scheduler_->add(queueId_, priority_, std::move(func), ioStats_, weight_);
+  }
+
+ private:
+  IoScheduler* const scheduler_;
+  const std::string queueId_;
+  const IoScheduler::Priority priority_;
+  const std::shared_ptr<IoStatistics> ioStats_;
+  const double weight_;
+};
+
+} // namespace
+
+std::string IoScheduler::Stats::toString() const {
+  return fmt::format(
+      "IoScheduler: {} tasks, {} by deadline, max queued {}, queued {}us",
+      numTasks,
+      numDeadlineTasks,
+      maxQueued,
+      queuedUs);
+}
+
+std::deque<IoScheduler::Task>* IoScheduler::Queue::head() {
+  for (auto& deque : tasks) {
+    if (!deque.empty()) {
+      return &deque;
+    }
+  }
+  return nullptr;
+}
+
+IoScheduler::IoScheduler(folly::Executor* executor, Options options)
+    : executor_(executor), options_(options) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GT(options_.maxInFlight, 0);
+}
+
+IoScheduler::~IoScheduler() {
+  std::unique_lock<std::mutex> l(mutex_);
+  idleCv_.wait(l, [&]() { return numQueued_ == 0 && numInFlight_ == 0; });
+}
+
+void IoScheduler::add(
+    const std::string& queueId,
+    Priority priority,
+    folly::Func func,
+    std::shared_ptr<IoStatistics> ioStats,
+    double weight) {
+  VELOX_CHECK_GT(weight, 0);
+  const auto now = nowUs();
+  uint64_t deadlineUs = 0;
+  switch (priority) {
+    case Priority::kBlocking:
+      deadlineUs = now;
+      break;
+    case Priority::kPrefetch:
+      if (options_.prefetchDeadlineUs != 0) {
+        deadlineUs = now + options_.prefetchDeadlineUs;
+      }
+      break;
+    case Priority::kBackground:
+      if (options_.backgroundDeadlineUs != 0) {
+        deadlineUs = now + options_.backgroundDeadlineUs;
+      }
+      break;
+  }
+  std::optional<Task> task;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto [it, inserted] = queues_.try_emplace(queueId);
+    auto& queue = it->second;
+    if (inserted) {
+      queue.virtualTime = virtualTime_;
+    }
+    queue.weight = weight;
+    queue.tasks[static_cast<int32_t>(priority)].push_back(
+        Task{std::move(func), std::move(ioStats), now, deadlineUs});
+    ++numQueued_;
+    ++stats_.numTasks;
+    stats_.maxQueued =
+        std::max<uint64_t>(stats_.maxQueued, static_cast<uint64_t>(numQueued_));
+    task = nextTaskLocked();
+  }
+  if (task.has_value()) {
+    executor_->add([this, task = std::move(task.value())]() mutable {
+      run(std::move(task));
+    });
+  }
+}
+
+std::optional<IoScheduler::Task> IoScheduler::nextTaskLocked() {
+  if (numQueued_ == 0 || numInFlight_ >= options_.maxInFlight) {
+    return std::nullopt;
+  }
+  const auto now = nowUs();
+  // Tasks past their deadline go first, earliest deadline first. Otherwise
+  // the queue that has had the smallest share of the executor goes first.
+  decltype(queues_)::iterator best = queues_.end();
+  std::deque<Task>* bestHead = nullptr;
+  bool bestOverdue = false;
+  for (auto it = queues_.begin(); it != queues_.end(); ++it) {
+    auto* head = it->second.head();
+    VELOX_CHECK_NOT_NULL(head);
+    const auto deadlineUs = head->front().deadlineUs;
+    const bool overdue = deadlineUs != 0 && deadlineUs <= now;
+    bool better;
+    if (bestHead == nullptr) {
+      better = true;
+    } else if (overdue != bestOverdue) {
+      better = overdue;
+    } else if (overdue) {
+      better = deadlineUs < bestHead->front().deadlineUs;
+    } else {
+      better = it->second.virtualTime < best->second.virtualTime;
+    }
+    if (better) {
+      best = it;
+      bestHead = head;
+      bestOverdue = overdue;
+    }
+  }
+  auto& queue = best->second;
+  Task task = std::move(bestHead->front());
+  bestHead->pop_front();
+  virtualTime_ = std::max(virtualTime_, queue.virtualTime);
+  queue.virtualTime += 1 / queue.weight;
+  if (queue.head() == nullptr) {
+    queues_.erase(best);
+  }
+  --numQueued_;
+  ++numInFlight_;
+  stats_.numDeadlineTasks += bestOverdue;
+  stats_.queuedUs += now - task.enqueueUs;
+  if (task.ioStats != nullptr) {
+    task.ioStats->ioSchedulerWait().increment(now - task.enqueueUs);
+  }
+  return task;
+}
+
+void IoScheduler::run(Task task) {
+  std::optional<Task> next = std::move(task);
+  while (next.has_value()) {
+    try {
+      next->func();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "IO task failed: " << e.what();
+    }
+    std::lock_guard<std::mutex> l(mutex_);
+    --numInFlight_;
+    next = nextTaskLocked();
+    if (numQueued_ == 0 && numInFlight_ == 0) {
+      idleCv_.notify_all();
+    }
+  }
+}
+
+std::unique_ptr<folly::Executor> IoScheduler::executor(
+    std::string queueId,
+    Priority priority,
+    std::shared_ptr<IoStatistics> ioStats,
+    double weight) {
+  return std::make_unique<QueueExecutor>(
+      this, std::move(queueId), priority, std::move(ioStats), weight);
+}
+
+int64_t IoScheduler::numQueued() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numQueued_;
+}
+
+int32_t IoScheduler::numInFlight() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numInFlight_;
+}
+
+IoScheduler::Stats IoScheduler::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+} // namespace facebook::velox::io
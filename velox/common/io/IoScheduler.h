@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <folly/Executor.h>
+
+#include "velox/common/io/IoStatistics.h"
+
+namespace facebook::velox::io {
+
+/// Shares an IO executor between queries. Each query has a queue of IO tasks.
+/// At most 'maxInFlight' tasks run on the executor at a time. The tasks a
+/// query thread waits for, e.g. on-demand reads and spill writes, have
+/// Priority::kBlocking and run before the others in the order of their
+/// deadlines. The remaining tasks are taken from the queues by weighted fair
+/// sharing, so that a query issuing many prefetches gets a share of the
+/// executor in proportion to its weight instead of starving the queries that
+/// issue few. Within a queue, tasks run by priority and then in FIFO order.
+///
+/// CachedBufferedInput, DirectBufferedInput, SsdFile and Spiller take a
+/// folly::Executor. Pass them an executor() of the scheduler to queue their IO
+/// under a query's queue and priority.
+class IoScheduler {
+ public:
+  enum class Priority {
+    /// A query thread waits for the task. The deadline is the time of add().
+    kBlocking = 0,
+    /// Read-ahead for a query.
+    kPrefetch = 1,
+    /// Work no query waits for, e.g. writes to SSD cache.
+    kBackground = 2,
+  };
+
+  struct Options {
+    /// The maximum number of tasks running on the executor at a time.
+    int32_t maxInFlight{32};
+
+    /// If non-0, kPrefetch tasks that have waited this long are run with the
+    /// kBlocking ones in the order of their deadlines.
+    uint64_t prefetchDeadlineUs{0};
+
+    /// Same as 'prefetchDeadlineUs' for kBackground tasks.
+    uint64_t backgroundDeadlineUs{0};
+  };
+
+  struct Stats {
+    /// Number of tasks added.
+    uint64_t numTasks{0};
+    /// Number of tasks run because their deadline had passed. Includes all
+    /// kBlocking tasks.
+    uint64_t numDeadlineTasks{0};
+    /// The largest number of tasks waiting in the queues at a time.
+    uint64_t maxQueued{0};
+    /// Sum of the times in microseconds that tasks waited in the queues.
+    uint64_t queuedUs{0};
+
+    std::string toString() const;
+  };
+
+  IoScheduler(folly::Executor* executor, Options options);
+
+  /// Waits for the queued and running tasks to finish.
+  ~IoScheduler();
+
+  /// Queues 'func' under 'queueId' with 'priority'. 'weight' sets the share
+  /// of the executor for the queue relative to the other queues. If
+  /// 'ioStats' is set, the time 'func' waits is added to its
+  /// ioSchedulerWait(). Exceptions thrown by 'func' are logged.
+  void add(
+      const std::string& queueId,
+      Priority priority,
+      folly::Func func,
+      std::shared_ptr<IoStatistics> ioStats = nullptr,
+      double weight = 1);
+
+  /// Returns an executor that queues its tasks on 'this' with 'queueId',
+  /// 'priority', 'ioStats' and 'weight'. 'this' must outlive the executor.
+  std::unique_ptr<folly::Executor> executor(
+      std::string queueId,
+      Priority priority,
+      std::shared_ptr<IoStatistics> ioStats = nullptr,
+      double weight = 1);
+
+  /// Returns the number of tasks waiting in the queues.
+  int64_t numQueued() const;
+
+  /// Returns the number of tasks running on the executor.
+  int32_t numInFlight() const;
+
+  Stats stats() const;
+
+ private:
+  static constexpr int32_t kNumPriorities = 3;
+
+  struct Task {
+    folly::Func func;
+    std::shared_ptr<IoStatistics> ioStats;
+    uint64_t enqueueUs;
+    // 0 if the task has no deadline.
+    uint64_t deadlineUs;
+  };
+
+  struct Queue {
+    std::array<std::deque<Task>, kNumPriorities> tasks;
+    double weight{1};
+    // Advances by 1 / 'weight' for each task run from the queue.
+    double virtualTime{0};
+
+    // Returns the highest priority non-empty deque or nullptr if empty.
+    std::deque<Task>* head();
+  };
+
+  // Takes the next task to run if a slot on the executor is free. Increments
+  // 'numInFlight_' if a task is returned.
+  std::optional<Task> nextTaskLocked();
+
+  // Runs 'task' and the tasks that become runnable as the previous ones
+  // finish. Called on the executor.
+  void run(Task task);
+
+  folly::Executor* const executor_;
+  const Options options_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable idleCv_;
+  std::unordered_map<std::string, Queue> queues_;
+  // Virtual time of the last task run. Queues that become active start at
+  // this time.
+  double virtualTime_{0};
+  int64_t numQueued_{0};
+  int32_t numInFlight_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::io
@@ -104,7 +104,9 @@ void IoStatistics::merge(const IoStatistics& other) {
   read_.merge(other.read_);
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
+  sharedLoad_.merge(other.sharedLoad_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  ioSchedulerWait_.merge(other.ioSchedulerWait_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
@@ -95,10 +95,18 @@ class IoStatistics {
     return ramHit_;
   }
 
+  IoCounter& sharedLoad() {
+    return sharedLoad_;
+  }
+
   IoCounter& queryThreadIoLatency() {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& ioSchedulerWait() {
+    return ioSchedulerWait_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -135,10 +143,17 @@ class IoStatistics {
   // reads.
   IoCounter ssdRead_;
 
+  // Reads left out of planned loads because a reader of another split of the
+  // same file had planned or started loading the same range.
+  IoCounter sharedLoad_;
+
   // Time spent by a query processing thread waiting for synchronously
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Time in microseconds spent by IO tasks in the queues of an IoScheduler.
+  IoCounter ioSchedulerWait_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
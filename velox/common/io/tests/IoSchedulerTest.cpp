@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/io/IoScheduler.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::io;
+
+namespace {
+
+using Priority = IoScheduler::Priority;
+
+// Runs one task at a time on a ManualExecutor and records the order.
+class IoSchedulerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    scheduler_ = std::make_unique<IoScheduler>(
+        &executor_, IoScheduler::Options{.maxInFlight = 1});
+  }
+
+  void TearDown() override {
+    executor_.drain();
+    scheduler_.reset();
+  }
+
+  void add(const std::string& queueId, Priority priority, double weight = 1) {
+    scheduler_->add(
+        queueId,
+        priority,
+        [this, queueId]() { order_.push_back(queueId); },
+        nullptr,
+        weight);
+  }
+
+  // Returns the number of 'queueId' tasks among the first 'n' run.
+  int32_t countInFirst(const std::string& queueId, int32_t n) const {
+    return std::count(order_.begin(), order_.begin() + n, queueId);
+  }
+
+  folly::ManualExecutor executor_;
+  std::unique_ptr<IoScheduler> scheduler_;
+  std::vector<std::string> order_;
+};
+
+TEST_F(IoSchedulerTest, fairShare) {
+  for (auto i = 0; i < 20; ++i) {
+    add("big", Priority::kPrefetch);
+  }
+  add("point", Priority::kPrefetch);
+  add("point", Priority::kPrefetch);
+  EXPECT_EQ(21, scheduler_->numQueued());
+  EXPECT_EQ(1, scheduler_->numInFlight());
+  executor_.drain();
+  ASSERT_EQ(22, order_.size());
+  // The point query does not wait for the prefetches of the big one.
+  EXPECT_EQ(2, countInFirst("point", 5));
+  EXPECT_EQ(0, scheduler_->numQueued());
+  EXPECT_EQ(0, scheduler_->numInFlight());
+  EXPECT_EQ(22, scheduler_->stats().numTasks);
+  EXPECT_EQ(21, scheduler_->stats().maxQueued);
+}
+
+TEST_F(IoSchedulerTest, weights) {
+  for (auto i = 0; i < 40; ++i) {
+    add("heavy", Priority::kPrefetch, 3);
+    add("light", Priority::kPrefetch, 1);
+  }
+  executor_.drain();
+  ASSERT_EQ(80, order_.size());
+  const auto numHeavy = countInFirst("heavy", 40);
+  EXPECT_LE(28, numHeavy);
+  EXPECT_GE(32, numHeavy);
+}
+
+TEST_F(IoSchedulerTest, blockingFirst) {
+  for (auto i = 0; i < 10; ++i) {
+    add("big", Priority::kPrefetch);
+    add("background", Priority::kBackground);
+  }
+  add("point", Priority::kBlocking);
+  executor_.drain();
+  ASSERT_EQ(21, order_.size());
+  // Only the task already running when the blocking task came goes first.
+  EXPECT_EQ("point", order_[1]);
+  EXPECT_EQ(1, scheduler_->stats().numDeadlineTasks);
+
+  // Within a queue, higher priorities go first.
+  order_.clear();
+  add("query", Priority::kBackground);
+  add("query", Priority::kBackground);
+  add("query", Priority::kPrefetch);
+  add("other", Priority::kPrefetch);
+  scheduler_->add(
+      "query", Priority::kBlocking, [&]() { order_.push_back("blocking"); });
+  executor_.drain();
+  ASSERT_EQ(5, order_.size());
+  EXPECT_EQ("blocking", order_[1]);
+  EXPECT_EQ("query", order_.back());
+}
+
+TEST_F(IoSchedulerTest, prefetchDeadline) {
+  scheduler_ = std::make_unique<IoScheduler>(
+      &executor_,
+      IoScheduler::Options{.maxInFlight = 1, .prefetchDeadlineUs = 1});
+  add("first", Priority::kPrefetch);
+  add("big", Priority::kPrefetch);
+  add("big", Priority::kPrefetch);
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  add("new", Priority::kPrefetch);
+  executor_.drain();
+  // The prefetches run in the order of their deadlines once these have
+  // passed.
+  EXPECT_EQ(
+      (std::vector<std::string>{"first", "big", "big", "new"}), order_);
+  EXPECT_LE(2, scheduler_->stats().numDeadlineTasks);
+}
+
+TEST_F(IoSchedulerTest, executorAndStats) {
+  auto ioStats = std::make_shared<IoStatistics>();
+  int32_t numRun = 0;
+  {
+    folly::CPUThreadPoolExecutor threads(4);
+    IoScheduler scheduler(&threads, {.maxInFlight = 2});
+    auto executor =
+        scheduler.executor("query", Priority::kPrefetch, ioStats);
+    std::mutex mutex;
+    for (auto i = 0; i < 100; ++i) {
+      executor->add([&]() {
+        EXPECT_GE(2, scheduler.numInFlight());
+        std::lock_guard<std::mutex> l(mutex);
+        ++numRun;
+      });
+    }
+    executor->add([]() { throw std::runtime_error("failing task"); });
+    // The destructor waits for the tasks.
+  }
+  EXPECT_EQ(100, numRun);
+  EXPECT_EQ(101, ioStats->ioSchedulerWait().count());
+}
+
+} // namespace
@@ -82,11 +82,31 @@ char* AllocationPool::allocateFixed(uint64_t bytes, int32_t alignment) {
   return result;
 }
 
+void AllocationPool::setContiguousArena(int64_t maxBytes) {
+  VELOX_CHECK_EQ(
+      0, numRanges(), "Contiguous arena must be set before first allocation");
+  VELOX_CHECK_GT(maxBytes, 0);
+  VELOX_CHECK_LE(maxBytes, kMaxContiguousArenaBytes);
+  contiguousArenaBytes_ =
+      bits::roundUp(maxBytes, AllocationTraits::kHugePageSize);
+  hugePageThreshold_ = 0;
+}
+
 void AllocationPool::growLastAllocation() {
   VELOX_CHECK_GT(bytesInRun_, AllocationTraits::kHugePageSize);
-  const auto bytesToReserve = bits::roundUp(
+  auto bytesToReserve = bits::roundUp(
       currentOffset_ - endOfReservedRun(), AllocationTraits::kHugePageSize);
-  largeAllocations_.back().grow(AllocationTraits::numPages(bytesToReserve));
+  auto& lastAllocation = largeAllocations_.back();
+  if (contiguousArenaBytes_ > 0 && largeAllocations_.size() == 1) {
+    // Double the reservation of the contiguous arena to grow it a logarithmic
+    // number of times.
+    bytesToReserve = std::max<int64_t>(
+        bytesToReserve,
+        std::min<int64_t>(
+            lastAllocation.size(),
+            lastAllocation.maxSize() - lastAllocation.size()));
+  }
+  lastAllocation.grow(AllocationTraits::numPages(bytesToReserve));
   usedBytes_ += bytesToReserve;
 }
 
@@ -103,6 +123,9 @@ void AllocationPool::newRunImpl(MachinePageCount numPages) {
             16 * AllocationTraits::kHugePageSize,
             bits::nextPowerOfTwo(
                 usedBytes_ + AllocationTraits::kHugePageSize)));
+    if (contiguousArenaBytes_ > 0 && largeAllocations_.empty()) {
+      nextSize = contiguousArenaBytes_ + AllocationTraits::kHugePageSize;
+    }
     // Round 'numPages' to no of pages in huge page. Allocating this plus an
     // extra huge page guarantees that 'numPages' worth of contiguous aligned
     // huge pages will be founfd in the allocation.
@@ -105,6 +105,30 @@ class AllocationPool {
     hugePageThreshold_ = size;
   }
 
+  /// Makes 'this' allocate from a single contiguous range of up to 'maxBytes'
+  /// of address space. The range is mapped on first allocation and its
+  /// reservation in 'pool_' grows by doubling as it fills up. Allocations
+  /// beyond 'maxBytes' go to new ranges as usual. Must be called before the
+  /// first allocation. 'maxBytes' is at most kMaxContiguousArenaBytes so that
+  /// positions in the range fit in 32 bits.
+  void setContiguousArena(int64_t maxBytes);
+
+  /// Returns true if all allocations of 'this' are in one contiguous range.
+  bool isContiguous() const {
+    return allocations_.empty() && largeAllocations_.size() <= 1;
+  }
+
+  /// Returns the start of the only range of 'this'. Requires isContiguous()
+  /// and at least one allocation.
+  char* contiguousStart() const {
+    VELOX_DCHECK(isContiguous());
+    VELOX_DCHECK_NOT_NULL(startOfRun_);
+    return startOfRun_;
+  }
+
+  /// Largest range for setContiguousArena().
+  static constexpr int64_t kMaxContiguousArenaBytes = 4L << 30;
+
   int64_t testingFreeAddressableBytes() const {
     return freeAddressableBytes();
   }
@@ -157,6 +181,10 @@ class AllocationPool {
 
   // Start using large mmaps with huge pages after 'usedBytes_' exceeds this.
   int64_t hugePageThreshold_{kDefaultHugePageThreshold};
+
+  // Size of the address range of the first large allocation if not 0. See
+  // setContiguousArena().
+  int64_t contiguousArenaBytes_{0};
 };
 
 } // namespace facebook::velox::memory
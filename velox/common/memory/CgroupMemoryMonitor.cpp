@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/CgroupMemoryMonitor.h"
+
+#include <cstring>
+
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+
+namespace facebook::velox::memory {
+
+namespace {
+std::optional<std::string> readCgroupFile(
+    const std::string& cgroupPath,
+    const char* fileName) {
+  std::string content;
+  if (!folly::readFile((cgroupPath + "/" + fileName).c_str(), content)) {
+    return std::nullopt;
+  }
+  return content;
+}
+} // namespace
+
+std::string CgroupMemoryStats::toString() const {
+  return fmt::format(
+      "CGROUP[limit {} current {} some avg10 {:.2f} full avg10 {:.2f}]",
+      limitBytes == kMaxMemory ? "UNLIMITED" : succinctBytes(limitBytes),
+      succinctBytes(currentBytes),
+      someAvg10,
+      fullAvg10);
+}
+
+std::string CgroupMemoryMonitor::Stats::toString() const {
+  return fmt::format(
+      "numPressureEvents {} cacheShrunkBytes {} poolShrunkBytes {}",
+      numPressureEvents,
+      succinctBytes(cacheShrunkBytes),
+      succinctBytes(poolShrunkBytes));
+}
+
+CgroupMemoryMonitor::CgroupMemoryMonitor(
+    MemoryManager* manager,
+    Options options)
+    : manager_(manager), options_(std::move(options)) {
+  VELOX_CHECK_NOT_NULL(manager_);
+  VELOX_CHECK_GE(options_.reservedBytes, 0);
+  VELOX_CHECK_GE(options_.minFreeBytes, 0);
+}
+
+std::optional<int64_t> CgroupMemoryMonitor::parseMemoryBytes(
+    const std::string& content) {
+  const auto value = folly::trimWhitespace(content);
+  if (value == "max") {
+    return kMaxMemory;
+  }
+  auto result = folly::tryTo<int64_t>(value);
+  if (result.hasError()) {
+    return std::nullopt;
+  }
+  return result.value();
+}
+
+bool CgroupMemoryMonitor::parsePressure(
+    const std::string& content,
+    CgroupMemoryStats& stats) {
+  // Each line is like 'some avg10=1.23 avg60=0.50 avg300=0.10 total=12345'.
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', content, lines, true);
+  for (const auto& line : lines) {
+    std::vector<folly::StringPiece> fields;
+    folly::split(' ', line, fields, true);
+    if (fields.size() < 2 || !fields[1].startsWith("avg10=")) {
+      return false;
+    }
+    auto avg10 =
+        folly::tryTo<double>(fields[1].subpiece(std::strlen("avg10=")));
+    if (avg10.hasError()) {
+      return false;
+    }
+    if (fields[0] == "some") {
+      stats.someAvg10 = avg10.value();
+    } else if (fields[0] == "full") {
+      stats.fullAvg10 = avg10.value();
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<CgroupMemoryStats> CgroupMemoryMonitor::readStats(
+    const std::string& cgroupPath) {
+  const auto maxContent = readCgroupFile(cgroupPath, "memory.max");
+  const auto currentContent = readCgroupFile(cgroupPath, "memory.current");
+  if (!maxContent.has_value() || !currentContent.has_value()) {
+    return std::nullopt;
+  }
+  const auto limitBytes = parseMemoryBytes(maxContent.value());
+  const auto currentBytes = parseMemoryBytes(currentContent.value());
+  if (!limitBytes.has_value() || !currentBytes.has_value()) {
+    return std::nullopt;
+  }
+  CgroupMemoryStats stats;
+  stats.limitBytes = limitBytes.value();
+  stats.currentBytes = currentBytes.value();
+  const auto pressureContent = readCgroupFile(cgroupPath, "memory.pressure");
+  if (pressureContent.has_value() &&
+      !parsePressure(pressureContent.value(), stats)) {
+    VELOX_MEM_LOG_EVERY_MS(WARNING, 60'000)
+        << "Malformed memory.pressure in " << cgroupPath;
+  }
+  return stats;
+}
+
+bool CgroupMemoryMonitor::refresh() {
+  auto cgroupStats = readStats(options_.cgroupPath);
+  if (!cgroupStats.has_value()) {
+    return false;
+  }
+  cgroupStats_ = cgroupStats.value();
+  manager_->arbitrator()->setCapacityLimit(capacityLimit());
+  if (underPressure()) {
+    shedMemory();
+  }
+  return true;
+}
+
+uint64_t CgroupMemoryMonitor::capacityLimit() const {
+  if (cgroupStats_.limitBytes == kMaxMemory) {
+    return manager_->arbitrator()->capacity();
+  }
+  // The memory used in the cgroup outside of 'manager_', e.g. by the page
+  // cache or by other processes.
+  const int64_t externalBytes = std::max<int64_t>(
+      0, cgroupStats_.currentBytes - manager_->getTotalBytes());
+  return std::max<int64_t>(
+      0, cgroupStats_.limitBytes - options_.reservedBytes - externalBytes);
+}
+
+bool CgroupMemoryMonitor::underPressure() const {
+  if (cgroupStats_.someAvg10 >= options_.pressureThreshold) {
+    return true;
+  }
+  return cgroupStats_.limitBytes != kMaxMemory &&
+      cgroupStats_.limitBytes - cgroupStats_.currentBytes <
+      options_.minFreeBytes;
+}
+
+void CgroupMemoryMonitor::shedMemory() {
+  ++stats_.numPressureEvents;
+  uint64_t targetBytes = options_.shrinkBytes;
+  if (cgroupStats_.limitBytes != kMaxMemory) {
+    const int64_t missingBytes = options_.minFreeBytes -
+        (cgroupStats_.limitBytes - cgroupStats_.currentBytes);
+    targetBytes = std::max<int64_t>(targetBytes, missingBytes);
+  }
+  uint64_t freedBytes{0};
+  if (options_.shrinkCache != nullptr) {
+    freedBytes = options_.shrinkCache(targetBytes);
+    stats_.cacheShrunkBytes += freedBytes;
+  }
+  if (freedBytes < targetBytes) {
+    const uint64_t shrunkBytes =
+        manager_->shrinkPools(targetBytes - freedBytes);
+    stats_.poolShrunkBytes += shrunkBytes;
+    freedBytes += shrunkBytes;
+  }
+  VELOX_MEM_LOG(WARNING) << "Memory pressure in " << cgroupStats_.toString()
+                         << ", freed " << succinctBytes(freedBytes)
+                         << " of target " << succinctBytes(targetBytes);
+}
+
+} // namespace facebook::velox::memory
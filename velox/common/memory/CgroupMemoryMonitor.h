@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::memory {
+
+/// Memory usage and pressure of a cgroup v2 as read from its 'memory.max',
+/// 'memory.current' and 'memory.pressure' files.
+struct CgroupMemoryStats {
+  /// The memory limit in bytes, kMaxMemory if unlimited.
+  int64_t limitBytes{kMaxMemory};
+  /// The memory usage in bytes, including the page cache.
+  int64_t currentBytes{0};
+  /// The percentage of the last 10 seconds in which at least one task of the
+  /// cgroup was stalled on memory.
+  double someAvg10{0};
+  /// The percentage of the last 10 seconds in which all tasks of the cgroup
+  /// were stalled on memory.
+  double fullAvg10{0};
+
+  std::string toString() const;
+};
+
+/// Follows the memory available to the process in a cgroup v2 container and
+/// sheds memory under pressure before the kernel OOM killer acts. The capacity
+/// limit of the memory arbitrator is set to the memory which is neither used
+/// outside of 'manager' nor reserved. When memory is short or the cgroup
+/// reports memory stalls, the monitor first shrinks the data cache through
+/// 'shrinkCache' and then reclaims from the memory pools of 'manager', which
+/// spills the queries that support it. The host calls refresh() periodically,
+/// e.g. once per second.
+class CgroupMemoryMonitor {
+ public:
+  struct Options {
+    /// The cgroup directory of the process.
+    std::string cgroupPath{"/sys/fs/cgroup"};
+
+    /// The memory under the cgroup limit that is not given to the memory
+    /// arbitrator. Covers untracked allocations, thread stacks and the page
+    /// cache needed for spilling.
+    int64_t reservedBytes{512 << 20};
+
+    /// The monitor sheds memory when the cgroup has less than this free.
+    int64_t minFreeBytes{256 << 20};
+
+    /// The monitor sheds memory when the cgroup 'some' memory stall average
+    /// over 10 seconds is at or above this percentage.
+    double pressureThreshold{10};
+
+    /// The minimum amount of memory to shed per refresh() under pressure.
+    uint64_t shrinkBytes{256 << 20};
+
+    /// If set, invoked first under pressure to free up to the given bytes of
+    /// cache memory. Returns the freed bytes. Typically calls
+    /// AsyncDataCache::shrink().
+    std::function<uint64_t(uint64_t)> shrinkCache;
+  };
+
+  struct Stats {
+    /// The number of refresh() calls that found memory pressure.
+    uint64_t numPressureEvents{0};
+    /// The bytes freed by 'shrinkCache'.
+    uint64_t cacheShrunkBytes{0};
+    /// The capacity freed from the memory pools of the memory manager.
+    uint64_t poolShrunkBytes{0};
+
+    std::string toString() const;
+  };
+
+  CgroupMemoryMonitor(MemoryManager* manager, Options options);
+
+  /// Reads the cgroup memory stats, sets the arbitrator capacity limit and
+  /// sheds memory under pressure. Returns false without changing anything if
+  /// the cgroup files cannot be read, e.g. outside of a cgroup v2 container.
+  bool refresh();
+
+  /// Returns the cgroup memory stats read by the last successful refresh().
+  const CgroupMemoryStats& cgroupStats() const {
+    return cgroupStats_;
+  }
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  /// Reads the memory stats of the cgroup at 'cgroupPath'. Returns
+  /// std::nullopt if 'memory.max' or 'memory.current' cannot be read. A
+  /// missing 'memory.pressure' reads as no pressure.
+  static std::optional<CgroupMemoryStats> readStats(
+      const std::string& cgroupPath);
+
+  /// Parses the content of 'memory.max' or 'memory.current'. "max" parses as
+  /// kMaxMemory.
+  static std::optional<int64_t> parseMemoryBytes(const std::string& content);
+
+  /// Parses the 'some' and 'full' avg10 values from the content of
+  /// 'memory.pressure' into 'stats'. Returns false on malformed content.
+  static bool parsePressure(
+      const std::string& content,
+      CgroupMemoryStats& stats);
+
+ private:
+  // Returns the capacity limit for the memory arbitrator from 'cgroupStats_'.
+  uint64_t capacityLimit() const;
+
+  // Returns true if 'cgroupStats_' shows memory pressure.
+  bool underPressure() const;
+
+  // Frees at least 'options_.shrinkBytes' from the cache and the memory pools.
+  void shedMemory();
+
+  MemoryManager* const manager_;
+  const Options options_;
+  CgroupMemoryStats cgroupStats_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::memory
@@ -308,8 +308,21 @@ void HashStringAllocator::freeRestOfBlock(Header* header, int32_t keepBytes) {
   free(newHeader);
 }
 
-int32_t HashStringAllocator::freeListIndex(int size) {
-  return std::min(size - kMinAlloc, kNumFreeLists - 1);
+int32_t HashStringAllocator::findFreeListWithSize(int32_t size) const {
+  const auto index = freeListIndex(size);
+  if (index < kNumExactFreeLists) {
+    return bits::findFirstBit(freeNonEmpty_, index, kNumFreeLists);
+  }
+  // Blocks in a size class list can be smaller than 'size'. Check the first
+  // block of the list of 'size' before looking at the larger size classes.
+  if (bits::isBitSet(freeNonEmpty_, index) &&
+      headerOf(free_[index].next())->size() >= size) {
+    return index;
+  }
+  if (index + 1 >= kNumFreeLists) {
+    return -1;
+  }
+  return bits::findFirstBit(freeNonEmpty_, index + 1, kNumFreeLists);
 }
 
 void HashStringAllocator::removeFromFreeList(Header* header) {
@@ -351,10 +364,10 @@ HashStringAllocator::allocateFromFreeLists(
     return nullptr;
   }
   preferredSize = std::max(kMinAlloc, preferredSize);
-  const auto index = freeListIndex(preferredSize);
-  auto available = bits::findFirstBit(freeNonEmpty_, index, kNumFreeLists);
+  auto available = findFreeListWithSize(preferredSize);
   if (!mustHaveSize && available == -1) {
-    available = bits::findLastBit(freeNonEmpty_, 0, index);
+    available =
+        bits::findLastBit(freeNonEmpty_, 0, freeListIndex(preferredSize) + 1);
   }
   if (available == -1) {
     return nullptr;
@@ -523,28 +536,25 @@ inline bool HashStringAllocator::storeStringFast(
     int32_t numBytes,
     char* destination) {
   auto roundedBytes = std::max(numBytes, kMinAlloc);
+  if (roundedBytes >= kMaxAlloc) {
+    return false;
+  }
+  const auto available = findFreeListWithSize(roundedBytes);
+  if (available < 0) {
+    return false;
+  }
   Header* header = nullptr;
-  if (free_[kNumFreeLists - 1].empty()) {
-    if (roundedBytes >= kMaxAlloc) {
-      return false;
-    }
-    auto index = freeListIndex(roundedBytes);
-    auto available = bits::findFirstBit(freeNonEmpty_, index, kNumFreeLists);
-    if (available < 0) {
-      return false;
-    }
+  if (available < kNumExactFreeLists) {
     header = allocateFromFreeList(roundedBytes, true, true, available);
     VELOX_CHECK_NOT_NULL(header);
   } else {
-    auto& freeList = free_[kNumFreeLists - 1];
+    auto& freeList = free_[available];
     header = headerOf(freeList.next());
-    auto size = header->size();
-    if (roundedBytes > size) {
-      return false;
-    }
-    const auto spaceTaken = roundedBytes + sizeof(Header);
-    if (size - spaceTaken > kMaxAlloc) {
-      // The entry after allocation stays in the largest free list.
+    const auto size = header->size();
+    const int32_t spaceTaken = roundedBytes + sizeof(Header);
+    if (size - spaceTaken > kMaxAlloc &&
+        freeListIndex(size - spaceTaken) == available) {
+      // The entry after allocation stays in the same size class free list.
       // The size at the end of the block is changed in place.
       reinterpret_cast<int32_t*>(header->end())[-1] -= spaceTaken;
       auto freeHeader = new (header->begin() + roundedBytes)
@@ -558,11 +568,8 @@ inline bool HashStringAllocator::storeStringFast(
       freeBytes_ -= spaceTaken;
       cumulativeBytes_ += roundedBytes;
     } else {
-      header =
-          allocateFromFreeList(roundedBytes, true, true, kNumFreeLists - 1);
-      if (!header) {
-        return false;
-      }
+      header = allocateFromFreeList(roundedBytes, true, true, available);
+      VELOX_CHECK_NOT_NULL(header);
     }
   }
   simd::memcpy(header->begin(), bytes, numBytes);
@@ -599,6 +606,7 @@ std::string HashStringAllocator::toString() const {
   out << "standalone allocations: " << sizeFromPool_ << " bytes in "
       << allocationsFromPool_.size() << " allocations" << std::endl;
   out << "ranges: " << pool_.numRanges() << std::endl;
+  out << fragmentationStats().toString() << std::endl;
 
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
 
@@ -629,6 +637,39 @@ std::string HashStringAllocator::toString() const {
   return out.str();
 }
 
+std::string HashStringAllocator::FragmentationStats::toString() const {
+  return fmt::format(
+      "fragmentation: {:.2f} free blocks: {} free bytes: {} largest free "
+      "block: {} arena bytes: {}",
+      fragmentation(),
+      numFreeBlocks,
+      freeBytes,
+      largestFreeBlock,
+      arenaBytes);
+}
+
+HashStringAllocator::FragmentationStats
+HashStringAllocator::fragmentationStats() const {
+  FragmentationStats stats;
+  stats.numFreeBlocks = numFree_;
+  stats.freeBytes = freeBytes_;
+  stats.arenaBytes = pool_.allocatedBytes();
+  const auto largest = bits::findLastBit(freeNonEmpty_, 0, kNumFreeLists);
+  if (largest < 0) {
+    return stats;
+  }
+  if (largest < kNumExactFreeLists) {
+    stats.largestFreeBlock = largest + kMinAlloc;
+    return stats;
+  }
+  for (auto free = free_[largest].next(); free != &free_[largest];
+       free = free->next()) {
+    stats.largestFreeBlock = std::max<uint64_t>(
+        stats.largestFreeBlock, headerOf(free)->size());
+  }
+  return stats;
+}
+
 int64_t HashStringAllocator::checkConsistency() const {
   static const auto kHugePageSize = memory::AllocationTraits::kHugePageSize;
 
@@ -701,11 +742,7 @@ int64_t HashStringAllocator::checkConsistency() const {
           "free list previous link inconsistent");
       auto size = headerOf(free)->size();
       VELOX_CHECK_GE(size, kMinAlloc);
-      if (size - kMinAlloc < kNumFreeLists - 1) {
-        VELOX_CHECK_EQ(size - kMinAlloc, i);
-      } else {
-        VELOX_CHECK_GE(size - kMinAlloc, kNumFreeLists - 1);
-      }
+      VELOX_CHECK_EQ(freeListIndex(size), i);
       bytesInFreeList += size + sizeof(Header);
     }
   }
@@ -39,6 +39,11 @@ namespace facebook::velox {
 // below is free. In this case the uint32_t below the header has the size of the
 // previous free block. The last word of a Allocation::PageRun backing a
 // HashStringAllocator is set to kArenaEnd.
+//
+// Free blocks are kept in segregated free lists. Sizes up to kMaxAlloc have one
+// list per exact size. Larger free blocks are binned by power of two. A bitmap
+// has a bit set for each non-empty list, so that the smallest list with blocks
+// of at least a given size is found with a bit scan.
 class HashStringAllocator : public StreamArena {
  public:
   // The minimum allocation must have space after the header for the
@@ -342,10 +347,54 @@ class HashStringAllocator : public StreamArena {
 
   std::string toString() const;
 
+  /// Summary of the free space of a HashStringAllocator. Free blocks are
+  /// coalesced with their neighbors on free() but blocks cannot be moved since
+  /// callers hold raw pointers to allocated blocks. A large free space with a
+  /// small largest free block indicates that the arena is fragmented.
+  struct FragmentationStats {
+    /// Number of free blocks.
+    uint64_t numFreeBlocks{0};
+
+    /// Bytes in free blocks, including headers.
+    uint64_t freeBytes{0};
+
+    /// Size of the largest free block, excluding header.
+    uint64_t largestFreeBlock{0};
+
+    /// Bytes of memory obtained from the pool for arenas.
+    uint64_t arenaBytes{0};
+
+    /// Returns a number between 0 and 1. 0 means that all free space is in
+    /// one block. Values close to 1 mean that the free space is scattered in
+    /// many small blocks.
+    double fragmentation() const {
+      if (freeBytes == 0) {
+        return 0;
+      }
+      return 1 - static_cast<double>(largestFreeBlock) / freeBytes;
+    }
+
+    std::string toString() const;
+  };
+
+  /// Returns the free space and fragmentation of 'this'. Visits at most the
+  /// blocks of the largest non-empty free list.
+  FragmentationStats fragmentationStats() const;
+
  private:
   static constexpr int32_t kUnitSize = 16 * memory::AllocationTraits::kPageSize;
   static constexpr int32_t kMinContiguous = 48;
-  static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
+  // Number of free lists for exact sizes in [kMinAlloc, kMaxAlloc].
+  static constexpr int32_t kNumExactFreeLists = kMaxAlloc - kMinAlloc + 1;
+  // Power of two of the smallest size that goes to a size class free list.
+  static constexpr int32_t kMinSizeClassBits = 11;
+  static_assert((1 << kMinSizeClassBits) <= kMaxAlloc);
+  static_assert((1 << (kMinSizeClassBits + 1)) > kMaxAlloc);
+  // Number of power of two size class free lists for sizes over kMaxAlloc, up
+  // to Header::kSizeMask.
+  static constexpr int32_t kNumSizeClassFreeLists = 29 - kMinSizeClassBits;
+  static constexpr int32_t kNumFreeLists =
+      kNumExactFreeLists + kNumSizeClassFreeLists;
 
   void newRange(int32_t bytes, ByteRange* range, bool contiguous);
 
@@ -388,8 +437,20 @@ class HashStringAllocator : public StreamArena {
   // has no effect if returns false.
   bool storeStringFast(const char* bytes, int32_t size, char* destination);
 
-  // Returns the free list index for 'size'.
-  int32_t freeListIndex(int size);
+  // Returns the free list index for 'size'. A list for an exact size has
+  // blocks of exactly that size. A size class list has blocks of sizes in
+  // [2^n, 2^(n + 1)).
+  static int32_t freeListIndex(int32_t size) {
+    if (size <= kMaxAlloc) {
+      return size - kMinAlloc;
+    }
+    return kNumExactFreeLists + (63 - bits::countLeadingZeros<uint64_t>(size)) -
+        kMinSizeClassBits;
+  }
+
+  // Returns the first non-empty free list that is guaranteed to have blocks of
+  // at least 'size' bytes or -1 if none.
+  int32_t findFreeListWithSize(int32_t size) const;
 
   // Circular list of free blocks.
   CompactDoubleList free_[kNumFreeLists];
@@ -111,6 +111,11 @@ struct MemoryManagerOptions {
   /// during the memory arbitration.
   uint64_t memoryPoolTransferCapacity{32 << 20};
 
+  /// If true, the memory arbitrator reclaims used memory incrementally from
+  /// several memory pools of the lowest priority. See
+  /// MemoryArbitrator::Config::incrementalReclaim.
+  bool incrementalReclaim{false};
+
   /// Provided by the query system to validate the state after a memory pool
   /// enters arbitration if not null. For instance, Prestissimo provides
   /// callback to check if a memory arbitration request is issued from a driver
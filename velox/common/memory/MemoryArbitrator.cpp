@@ -287,7 +287,9 @@ MemoryArbitrator::Stats::Stats(
     uint64_t _reclaimTimeUs,
     uint64_t _numNonReclaimableAttempts,
     uint64_t _numReserveRequest,
-    uint64_t _numReleaseRequest)
+    uint64_t _numReleaseRequest,
+    uint64_t _numReclaims,
+    uint64_t _numPriorityReclaims)
     : numRequests(_numRequests),
       numSucceeded(_numSucceeded),
       numAborted(_numAborted),
@@ -301,12 +303,15 @@ MemoryArbitrator::Stats::Stats(
       reclaimTimeUs(_reclaimTimeUs),
       numNonReclaimableAttempts(_numNonReclaimableAttempts),
       numReserveRequest(_numReserveRequest),
-      numReleaseRequest(_numReleaseRequest) {}
+      numReleaseRequest(_numReleaseRequest),
+      numReclaims(_numReclaims),
+      numPriorityReclaims(_numPriorityReclaims) {}
 
 std::string MemoryArbitrator::Stats::toString() const {
   return fmt::format(
       "STATS[numRequests {} numSucceeded {} numAborted {} numFailures {} "
       "numNonReclaimableAttempts {} numReserveRequest {} numReleaseRequest {} "
+      "numReclaims {} numPriorityReclaims {} "
       "queueTime {} arbitrationTime {} reclaimTime {} shrunkMemory {} "
       "reclaimedMemory {} maxCapacity {} freeCapacity {}]",
       numRequests,
@@ -316,6 +321,8 @@ std::string MemoryArbitrator::Stats::toString() const {
       numNonReclaimableAttempts,
       numReserveRequest,
       numReleaseRequest,
+      numReclaims,
+      numPriorityReclaims,
       succinctMicros(queueTimeUs),
       succinctMicros(arbitrationTimeUs),
       succinctMicros(reclaimTimeUs),
@@ -343,6 +350,8 @@ MemoryArbitrator::Stats MemoryArbitrator::Stats::operator-(
       numNonReclaimableAttempts - other.numNonReclaimableAttempts;
   result.numReserveRequest = numReserveRequest - other.numReserveRequest;
   result.numReleaseRequest = numReleaseRequest - other.numReleaseRequest;
+  result.numReclaims = numReclaims - other.numReclaims;
+  result.numPriorityReclaims = numPriorityReclaims - other.numPriorityReclaims;
   return result;
 }
 
@@ -361,7 +370,9 @@ bool MemoryArbitrator::Stats::operator==(const Stats& other) const {
              reclaimTimeUs,
              numNonReclaimableAttempts,
              numReserveRequest,
-             numReleaseRequest) ==
+             numReleaseRequest,
+             numReclaims,
+             numPriorityReclaims) ==
       std::tie(
              other.numRequests,
              other.numSucceeded,
@@ -376,7 +387,9 @@ bool MemoryArbitrator::Stats::operator==(const Stats& other) const {
              other.reclaimTimeUs,
              other.numNonReclaimableAttempts,
              other.numReserveRequest,
-             other.numReleaseRequest);
+             other.numReleaseRequest,
+             other.numReclaims,
+             other.numPriorityReclaims);
 }
 
 bool MemoryArbitrator::Stats::operator!=(const Stats& other) const {
@@ -410,6 +423,8 @@ bool MemoryArbitrator::Stats::operator<(const Stats& other) const {
   UPDATE_COUNTER(numNonReclaimableAttempts);
   UPDATE_COUNTER(numReserveRequest);
   UPDATE_COUNTER(numReleaseRequest);
+  UPDATE_COUNTER(numReclaims);
+  UPDATE_COUNTER(numPriorityReclaims);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -63,6 +63,12 @@ class MemoryArbitrator {
     /// during the memory arbitration.
     uint64_t memoryPoolTransferCapacity{32 << 20};
 
+    /// If true, used memory is reclaimed in rounds of at most
+    /// 'memoryPoolTransferCapacity' from each candidate of the lowest
+    /// reclaimer priority instead of as much as needed from the candidate with
+    /// the most reclaimable memory.
+    bool incrementalReclaim{false};
+
     /// Provided by the query system to validate the state after a memory pool
     /// enters arbitration if not null. For instance, Prestissimo provides
     /// callback to check if a memory arbitration request is issued from a
@@ -105,6 +111,21 @@ class MemoryArbitrator {
     return capacity_;
   }
 
+  /// Returns the capacity available for arbitration. This is capacity() unless
+  /// lowered by setCapacityLimit().
+  virtual uint64_t capacityLimit() const {
+    return capacity_;
+  }
+
+  /// Sets the capacity available for arbitration to 'limitBytes', capped at
+  /// capacity(). Used to follow the memory actually available to the process,
+  /// e.g. in a container whose memory is shared with other tenants. Lowering
+  /// the limit does not take capacity back from memory pools. The capacity is
+  /// withheld from the free capacity as the pools return it. Use
+  /// shrinkMemory() to reclaim it from the pools sooner. The default
+  /// implementation ignores the limit.
+  virtual void setCapacityLimit(uint64_t /*unused*/) {}
+
   virtual ~MemoryArbitrator() = default;
 
   /// Invoked by the memory manager to reserve up to 'bytes' memory capacity
@@ -140,7 +161,9 @@ class MemoryArbitrator {
 
   /// Invoked by the memory manager to shrink memory from a given list of memory
   /// pools. The freed memory capacity is given back to the arbitrator. The
-  /// function returns the actual freed memory capacity in bytes.
+  /// function returns the actual freed memory capacity in bytes. The memory
+  /// arbitrator can reclaim used memory from the pools, e.g. by spilling, if
+  /// shrinking their free capacity does not free 'targetBytes'.
   virtual uint64_t shrinkMemory(
       const std::vector<std::shared_ptr<MemoryPool>>& pools,
       uint64_t targetBytes) = 0;
@@ -178,6 +201,11 @@ class MemoryArbitrator {
     uint64_t numReserveRequest{0};
     /// The total number of invoking releaseMemory method.
     uint64_t numReleaseRequest{0};
+    /// The number of used memory reclaims from a candidate memory pool.
+    uint64_t numReclaims{0};
+    /// The number of used memory reclaims from a candidate memory pool with a
+    /// lower reclaimer priority than the requestor.
+    uint64_t numPriorityReclaims{0};
 
     Stats(
         uint64_t _numRequests,
@@ -193,7 +221,9 @@ class MemoryArbitrator {
         uint64_t _reclaimTimeUs,
         uint64_t _numNonReclaimableAttempts,
         uint64_t _numReserveRequest,
-        uint64_t _numReleaseRequest);
+        uint64_t _numReleaseRequest,
+        uint64_t _numReclaims,
+        uint64_t _numPriorityReclaims);
 
     Stats() = default;
 
@@ -215,6 +245,14 @@ class MemoryArbitrator {
 
   virtual Stats stats() const = 0;
 
+  /// Returns true if a memory arbitration is in progress and sets 'future' to
+  /// be fulfilled when no memory arbitration is in progress. A driver can use
+  /// this to yield its thread instead of waiting in the arbitration queue. The
+  /// default implementation returns false.
+  virtual bool arbitrationInProgress(ContinueFuture* /*unused*/) {
+    return false;
+  }
+
   /// Returns the debug string of this memory arbitrator.
   virtual std::string toString() const = 0;
 
@@ -223,11 +261,13 @@ class MemoryArbitrator {
       : capacity_(config.capacity),
         memoryPoolInitCapacity_(config.memoryPoolInitCapacity),
         memoryPoolTransferCapacity_(config.memoryPoolTransferCapacity),
+        incrementalReclaim_(config.incrementalReclaim),
         arbitrationStateCheckCb_(config.arbitrationStateCheckCb) {}
 
   const uint64_t capacity_;
   const uint64_t memoryPoolInitCapacity_;
   const uint64_t memoryPoolTransferCapacity_;
+  const bool incrementalReclaim_;
   const MemoryArbitrationStateCheckCB arbitrationStateCheckCb_;
 };
 
@@ -301,6 +341,15 @@ class MemoryReclaimer {
   /// enterArbitration has been called.
   virtual void leaveArbitration() noexcept {}
 
+  /// Returns the priority of the memory pool of 'this' for memory arbitration.
+  /// The memory arbitrator reclaims from and aborts the root memory pools of
+  /// lower priority first. The query system can use this to protect
+  /// interactive queries or queries which have made much progress. The
+  /// default priority is 0.
+  virtual int32_t priority() const {
+    return 0;
+  }
+
   /// Invoked by the memory arbitrator to get the amount of memory bytes that
   /// can be reclaimed from 'pool'. The function returns true if 'pool' is
   /// reclaimable and returns the estimated reclaimable bytes in
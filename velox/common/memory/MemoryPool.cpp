@@ -147,6 +147,10 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
   }
+#define DEBUG_SNAPSHOT(reason)         \
+  if (FOLLY_UNLIKELY(debugEnabled_)) { \
+    snapshotDbg(reason);               \
+  }
 } // namespace
 
 std::string MemoryPool::Stats::toString() const {
@@ -372,6 +376,8 @@ MemoryPoolImpl::MemoryPoolImpl(
       allocator_{&manager_->allocator()},
       destructionCb_(std::move(destructionCb)),
       debugPoolNameRegex_(debugEnabled_ ? *(debugPoolNameRegex().rlock()) : ""),
+      debugSampleInterval_(std::max<uint32_t>(1, options.debugSampleInterval)),
+      debugSnapshotBytes_(options.debugSnapshotBytes),
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
       // actually used memory arbitration policy.
@@ -429,6 +435,7 @@ void* MemoryPoolImpl::allocate(int64_t size) {
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
     release(alignedSize);
+    DEBUG_SNAPSHOT("allocation failure");
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with {} from {} {}",
         __FUNCTION__,
@@ -448,6 +455,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   void* buffer = allocator_->allocateZeroFilled(alignedSize);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
     release(alignedSize);
+    DEBUG_SNAPSHOT("allocation failure");
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with {} entries and {} each from {} {}",
         __FUNCTION__,
@@ -468,6 +476,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
   if (FOLLY_UNLIKELY(newP == nullptr)) {
     release(alignedNewSize);
+    DEBUG_SNAPSHOT("allocation failure");
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with new {} and old {} from {} {}",
         __FUNCTION__,
@@ -517,6 +526,7 @@ void MemoryPoolImpl::allocateNonContiguous(
           },
           minSizeClass)) {
     VELOX_CHECK(out.empty());
+    DEBUG_SNAPSHOT("allocation failure");
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with {} pages from {} {}",
         __FUNCTION__,
@@ -569,6 +579,7 @@ void MemoryPoolImpl::allocateContiguous(
           },
           maxPages)) {
     VELOX_CHECK(out.empty());
+    DEBUG_SNAPSHOT("allocation failure");
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with {} pages from {} {}",
         __FUNCTION__,
@@ -602,6 +613,7 @@ void MemoryPoolImpl::growContiguous(
               release(allocBytes);
             }
           })) {
+    DEBUG_SNAPSHOT("allocation failure");
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with {} pages from {} {}",
         __FUNCTION__,
@@ -640,7 +652,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .checkUsageLeak = checkUsageLeak_,
-          .debugEnabled = debugEnabled_});
+          .debugEnabled = debugEnabled_,
+          .debugSampleInterval = debugSampleInterval_,
+          .debugSnapshotBytes = debugSnapshotBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -708,6 +722,7 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
       // unused reservation but no used reservation if a retry memory
       // reservation attempt run into memory capacity exceeded error.
       releaseThreadSafe(0, false);
+      DEBUG_SNAPSHOT("reservation failure");
       std::rethrow_exception(std::current_exception());
     }
   }
@@ -989,6 +1004,14 @@ bool MemoryPoolImpl::aborted() const {
   return aborted_;
 }
 
+bool MemoryPoolImpl::arbitrationInProgress(ContinueFuture* future) const {
+  if (manager_ == nullptr) {
+    return false;
+  }
+  auto* arbitrator = manager_->arbitrator();
+  return arbitrator != nullptr && arbitrator->arbitrationInProgress(future);
+}
+
 void MemoryPoolImpl::abort(const std::exception_ptr& error) {
   VELOX_CHECK_NOT_NULL(error);
   if (parent_ != nullptr) {
@@ -1029,7 +1052,6 @@ bool MemoryPoolImpl::needRecordDbg(bool /* isAlloc */) {
   if (!debugPoolNameRegex_.empty()) {
     return RE2::FullMatch(name_, debugPoolNameRegex_);
   }
-  // TODO(jtan6): Add sample based condition support.
   return true;
 }
 
@@ -1038,10 +1060,18 @@ void MemoryPoolImpl::recordAllocDbg(const void* addr, uint64_t size) {
   if (!needRecordDbg(true)) {
     return;
   }
+  if (debugSampleInterval_ > 1 &&
+      numDebugAllocs_++ % debugSampleInterval_ != 0) {
+    maybeSnapshotDbg();
+    return;
+  }
   const auto stackTrace = process::StackTrace().toString();
-  std::lock_guard<std::mutex> l(debugAllocMutex_);
-  debugAllocRecords_.emplace(
-      reinterpret_cast<uint64_t>(addr), AllocationRecord{size, stackTrace});
+  {
+    std::lock_guard<std::mutex> l(debugAllocMutex_);
+    debugAllocRecords_.emplace(
+        reinterpret_cast<uint64_t>(addr), AllocationRecord{size, stackTrace});
+  }
+  maybeSnapshotDbg();
 }
 
 void MemoryPoolImpl::recordAllocDbg(const Allocation& allocation) {
@@ -1069,6 +1099,10 @@ void MemoryPoolImpl::recordFreeDbg(const void* addr, uint64_t size) {
   uint64_t addrUint64 = reinterpret_cast<uint64_t>(addr);
   auto allocResult = debugAllocRecords_.find(addrUint64);
   if (allocResult == debugAllocRecords_.end()) {
+    if (debugSampleInterval_ > 1) {
+      // The allocation has not been sampled.
+      return;
+    }
     VELOX_FAIL("Freeing of un-allocated memory. Free address {}.", addrUint64);
   }
   const auto allocRecord = allocResult->second;
@@ -1113,11 +1147,99 @@ void MemoryPoolImpl::recordGrowDbg(const void* addr, uint64_t newSize) {
   uint64_t addrUint64 = reinterpret_cast<uint64_t>(addr);
   auto allocResult = debugAllocRecords_.find(addrUint64);
   if (allocResult == debugAllocRecords_.end()) {
+    if (debugSampleInterval_ > 1) {
+      // The allocation has not been sampled.
+      return;
+    }
     VELOX_FAIL("Growing of un-allocated memory. Free address {}.", addrUint64);
   }
   allocResult->second.size = newSize;
 }
 
+void MemoryPoolImpl::maybeSnapshotDbg() {
+  if (debugSnapshotBytes_ == 0) {
+    return;
+  }
+  const uint64_t usedBytes = currentBytes();
+  {
+    std::lock_guard<std::mutex> l(debugAllocMutex_);
+    if (usedBytes < nextDebugSnapshotBytes_) {
+      return;
+    }
+    while (nextDebugSnapshotBytes_ <= usedBytes) {
+      nextDebugSnapshotBytes_ *= 2;
+    }
+  }
+  snapshotDbg(fmt::format("usage reached {}", succinctBytes(usedBytes)));
+}
+
+void MemoryPoolImpl::snapshotDbg(const std::string& reason) {
+  const auto usedBytes = currentBytes();
+  const auto peakBytes = this->peakBytes();
+  std::lock_guard<std::mutex> l(debugAllocMutex_);
+  debugSnapshot_ = fmt::format(
+      "Memory pool {} {} with {} used, peak {}:\n{}",
+      name_,
+      reason,
+      succinctBytes(usedBytes),
+      succinctBytes(peakBytes),
+      debugAllocationSummaryLocked(10));
+  LOG(WARNING) << debugSnapshot_;
+}
+
+std::string MemoryPoolImpl::debugAllocationSummary(size_t maxCallSites) const {
+  if (!debugEnabled_) {
+    return "";
+  }
+  std::lock_guard<std::mutex> l(debugAllocMutex_);
+  return debugAllocationSummaryLocked(maxCallSites);
+}
+
+std::string MemoryPoolImpl::debugAllocationSnapshot() const {
+  std::lock_guard<std::mutex> l(debugAllocMutex_);
+  return debugSnapshot_;
+}
+
+std::string MemoryPoolImpl::debugAllocationSummaryLocked(
+    size_t maxCallSites) const {
+  struct CallSite {
+    uint64_t bytes{0};
+    uint64_t numAllocs{0};
+  };
+  std::unordered_map<std::string_view, CallSite> callSites;
+  for (const auto& [_, record] : debugAllocRecords_) {
+    auto& callSite = callSites[record.callStack];
+    callSite.bytes += record.size;
+    ++callSite.numAllocs;
+  }
+  std::vector<std::pair<std::string_view, CallSite>> sortedCallSites(
+      callSites.begin(), callSites.end());
+  std::sort(
+      sortedCallSites.begin(),
+      sortedCallSites.end(),
+      [](const auto& left, const auto& right) {
+        return left.second.bytes > right.second.bytes;
+      });
+  if (sortedCallSites.size() > maxCallSites) {
+    sortedCallSites.resize(maxCallSites);
+  }
+
+  std::stringstream out;
+  out << "Top " << sortedCallSites.size() << " of " << callSites.size()
+      << " allocation call sites";
+  if (debugSampleInterval_ > 1) {
+    out << " sampled one in " << debugSampleInterval_;
+  }
+  out << ":\n";
+  for (const auto& [callStack, callSite] : sortedCallSites) {
+    out << "======== " << succinctBytes(callSite.bytes * debugSampleInterval_)
+        << " in " << callSite.numAllocs * debugSampleInterval_
+        << " allocations ========\n"
+        << callStack;
+  }
+  return out.str();
+}
+
 void MemoryPoolImpl::leakCheckDbg() {
   VELOX_CHECK(debugEnabled_);
   if (debugAllocRecords_.empty()) {
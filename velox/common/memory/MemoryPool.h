@@ -32,6 +32,8 @@
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_uint32(velox_memory_pool_debug_sample_interval);
+DECLARE_uint64(velox_memory_pool_debug_snapshot_bytes);
 
 namespace facebook::velox::memory {
 #define VELOX_MEM_POOL_CAP_EXCEEDED(errorMessage)                   \
@@ -160,6 +162,17 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// If true, tracks the allocation and free call stacks to detect the source
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
+
+    /// If debug mode is enabled, records the call stack of one in
+    /// 'debugSampleInterval' allocations. Sampling makes debug mode cheap
+    /// enough to attribute the memory usage of large queries to call sites.
+    uint32_t debugSampleInterval{FLAGS_velox_memory_pool_debug_sample_interval};
+
+    /// If debug mode is enabled and this is not 0, a leaf memory pool takes a
+    /// snapshot of its top allocation call sites when its usage first exceeds
+    /// 'debugSnapshotBytes' and every time the usage doubles after that. A
+    /// snapshot is also taken on allocation failure.
+    uint64_t debugSnapshotBytes{FLAGS_velox_memory_pool_debug_snapshot_bytes};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -424,6 +437,11 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Returns true if this memory pool has been aborted.
   virtual bool aborted() const = 0;
 
+  /// Returns true if the memory arbitrator of this memory pool has a memory
+  /// arbitration in progress and sets 'future' to be fulfilled when it
+  /// finishes. See MemoryArbitrator::arbitrationInProgress().
+  virtual bool arbitrationInProgress(ContinueFuture* future) const = 0;
+
   /// The memory pool's execution stats.
   struct Stats {
     /// The current memory usage.
@@ -642,6 +660,8 @@ class MemoryPoolImpl : public MemoryPool {
 
   bool aborted() const override;
 
+  bool arbitrationInProgress(ContinueFuture* future) const override;
+
   std::string toString() const override {
     std::lock_guard<std::mutex> l(mutex_);
     return toStringLocked();
@@ -694,6 +714,17 @@ class MemoryPoolImpl : public MemoryPool {
     return debugAllocRecords_;
   }
 
+  /// Returns up to 'maxCallSites' call sites of the live allocations recorded
+  /// in debug mode, ordered by bytes. With sampling, the bytes of each call
+  /// site are scaled up by the sample interval. Returns an empty string if
+  /// debug mode is disabled.
+  std::string debugAllocationSummary(size_t maxCallSites = 10) const;
+
+  /// Returns the last snapshot of debugAllocationSummary() taken when the usage
+  /// of this pool crossed the snapshot threshold or an allocation failed.
+  /// Returns an empty string if no snapshot has been taken.
+  std::string debugAllocationSnapshot() const;
+
   static void setDebugPoolNameRegex(const std::string& regex) {
     debugPoolNameRegex() = regex;
   }
@@ -954,6 +985,17 @@ class MemoryPoolImpl : public MemoryPool {
   // Accounts for ContiguousAllocation size change in growContiguous().
   void recordGrowDbg(const void* addr, uint64_t newSize);
 
+  // Invoked on each allocation in debug mode to take a snapshot of the top
+  // allocation call sites if the usage of this pool has crossed the next
+  // snapshot threshold.
+  void maybeSnapshotDbg();
+
+  // Takes a snapshot of the top allocation call sites and logs it with
+  // 'reason'.
+  void snapshotDbg(const std::string& reason);
+
+  std::string debugAllocationSummaryLocked(size_t maxCallSites) const;
+
   // Invoked by memory pool destructor to detect the sources of leaked memory
   // allocations from the call sites which are still recorded in
   // 'debugAllocRecords_'. If there is no memory leaks, 'debugAllocRecords_'
@@ -971,6 +1013,14 @@ class MemoryPoolImpl : public MemoryPool {
   // name matches the specified regular expression 'debugPoolNameRegex_'.
   const std::string debugPoolNameRegex_;
 
+  // Records the call stack of one in 'debugSampleInterval_' allocations in
+  // debug mode.
+  const uint32_t debugSampleInterval_;
+
+  // The usage at which the first snapshot of allocation call sites is taken in
+  // debug mode. 0 means no snapshots on usage.
+  const uint64_t debugSnapshotBytes_;
+
   // Serializes updates on 'grantedReservationBytes_', 'usedReservationBytes_'
   // and 'minReservationBytes_' to make reservation decision on a consistent
   // read/write of those counters. incrementReservation()/decrementReservation()
@@ -1019,11 +1069,21 @@ class MemoryPoolImpl : public MemoryPool {
   // memory reservation requests.
   std::atomic<uint64_t> numCollisions_{0};
 
-  // Mutex for 'debugAllocRecords_'.
-  std::mutex debugAllocMutex_;
+  // Mutex for 'debugAllocRecords_', 'nextDebugSnapshotBytes_' and
+  // 'debugSnapshot_'.
+  mutable std::mutex debugAllocMutex_;
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // The number of allocations seen in debug mode for sampling.
+  std::atomic<uint64_t> numDebugAllocs_{0};
+
+  // The usage at which the next snapshot is taken in debug mode.
+  uint64_t nextDebugSnapshotBytes_{debugSnapshotBytes_};
+
+  // The last snapshot of the top allocation call sites.
+  std::string debugSnapshot_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
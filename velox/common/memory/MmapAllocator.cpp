@@ -17,14 +17,61 @@
 #include "velox/common/memory/MmapAllocator.h"
 
 #include <sys/mman.h>
+#ifdef linux
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+namespace {
+// Sets the local NUMA memory policy for the pages in the 'bytes' at 'data'.
+// Calls the system call directly to avoid a dependency on libnuma.
+void bindNumaLocal(void* data, size_t bytes) {
+#if defined(linux) && defined(SYS_mbind)
+  // MPOL_LOCAL from linux/mempolicy.h.
+  constexpr int kMpolLocal = 4;
+  if (::syscall(SYS_mbind, data, bytes, kMpolLocal, nullptr, 0, 0) != 0) {
+    VELOX_MEM_LOG(WARNING) << "mbind MPOL_LOCAL errno="
+                           << folly::errnoStr(errno);
+  }
+#endif
+}
+
+// Maps 'bytes' of anonymous memory at an address aligned to 'alignment'.
+// Returns MAP_FAILED on failure.
+void* mmapAligned(size_t bytes, size_t alignment) {
+  void* ptr = ::mmap(
+      nullptr,
+      bytes + alignment,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (ptr == MAP_FAILED) {
+    return ptr;
+  }
+  auto* start = reinterpret_cast<uint8_t*>(ptr);
+  auto* aligned = reinterpret_cast<uint8_t*>(
+      bits::roundUp(reinterpret_cast<uint64_t>(start), alignment));
+  if (aligned > start) {
+    ::munmap(start, aligned - start);
+  }
+  const auto tailBytes = (start + bytes + alignment) - (aligned + bytes);
+  if (tailBytes > 0) {
+    ::munmap(aligned + bytes, tailBytes);
+  }
+  return aligned;
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      numaLocal_(options.numaLocal),
+      useThreadCache_(options.useThreadCache),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -34,7 +81,10 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    const bool useHugePages = options.hugePageMinSizeClass != 0 &&
+        size >= options.hugePageMinSizeClass;
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size, size, useHugePages, numaLocal_));
   }
 
   if (useMmapArena_) {
@@ -47,6 +97,11 @@ MmapAllocator::MmapAllocator(const Options& options)
 }
 
 MmapAllocator::~MmapAllocator() {
+  if (useThreadCache_) {
+    for (auto& cache : threadCaches_.accessAllThreads()) {
+      flushThreadCache(cache);
+    }
+  }
   VELOX_CHECK(
       (numAllocated_ == 0) && (numExternalMapped_ == 0), "{}", toString());
 }
@@ -368,6 +423,9 @@ bool MmapAllocator::allocateContiguousImpl(
           MAP_PRIVATE | MAP_ANONYMOUS,
           -1,
           0);
+      if (data != MAP_FAILED && numaLocal_) {
+        bindNumaLocal(data, AllocationTraits::pageBytes(maxPages));
+      }
     }
   }
   // TODO: add handling of MAP_FAILED.
@@ -479,9 +537,24 @@ void* MmapAllocator::allocateBytesWithoutRetry(
   if (bytes <= AllocationTraits::pageBytes(sizeClassSizes_.back())) {
     Allocation allocation;
     const auto numPages = roundUpToSizeClassSize(bytes, sizeClassSizes_);
+    auto* cachedPages = threadCachePages(numPages);
+    if (cachedPages != nullptr && !cachedPages->empty()) {
+      auto* data = cachedPages->back();
+      cachedPages->pop_back();
+      numThreadCachedPages_ -= numPages;
+      return data;
+    }
     if (!allocateNonContiguousWithoutRetry(
             numPages, allocation, nullptr, numPages)) {
-      return nullptr;
+      if (cachedPages == nullptr) {
+        return nullptr;
+      }
+      // Retries after giving the pages cached by this thread back.
+      flushThreadCache(*threadCaches_);
+      if (!allocateNonContiguousWithoutRetry(
+              numPages, allocation, nullptr, numPages)) {
+        return nullptr;
+      }
     }
     auto run = allocation.runAt(0);
     VELOX_CHECK_EQ(
@@ -514,6 +587,12 @@ void MmapAllocator::freeBytes(void* p, uint64_t bytes) noexcept {
   if (bytes <= AllocationTraits::pageBytes(sizeClassSizes_.back())) {
     Allocation allocation;
     auto numPages = roundUpToSizeClassSize(bytes, sizeClassSizes_);
+    auto* cachedPages = threadCachePages(numPages);
+    if (cachedPages != nullptr && cachedPages->size() < kThreadCacheEntries) {
+      cachedPages->push_back(p);
+      numThreadCachedPages_ += numPages;
+      return;
+    }
     allocation.append(reinterpret_cast<uint8_t*>(p), numPages);
     freeNonContiguous(allocation);
     return;
@@ -524,6 +603,27 @@ void MmapAllocator::freeBytes(void* p, uint64_t bytes) noexcept {
   freeContiguous(allocation);
 }
 
+std::vector<void*>* MmapAllocator::threadCachePages(
+    MachinePageCount numPages) {
+  if (!useThreadCache_ || numPages > kThreadCacheMaxClassPages) {
+    return nullptr;
+  }
+  return &threadCaches_->pages[__builtin_ctzll(numPages)];
+}
+
+void MmapAllocator::flushThreadCache(ThreadCache& cache) {
+  for (auto i = 0; i < kNumThreadCacheClasses; ++i) {
+    const MachinePageCount numPages = 1 << i;
+    for (auto* data : cache.pages[i]) {
+      Allocation allocation;
+      allocation.append(reinterpret_cast<uint8_t*>(data), numPages);
+      freeNonContiguous(allocation);
+      numThreadCachedPages_ -= numPages;
+    }
+    cache.pages[i].clear();
+  }
+}
+
 void MmapAllocator::markAllMapped(const Allocation& allocation) {
   for (auto& sizeClass : sizeClasses_) {
     sizeClass->setAllMapped(allocation, true);
@@ -541,7 +641,11 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages,
+    bool numaLocal)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -555,13 +659,16 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
-  void* ptr = mmap(
-      nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
+  // A huge page aligned range lets the class pages that are multiples of the
+  // huge page size be advised away without splitting huge pages.
+  void* ptr = useHugePages
+      ? mmapAligned(byteSize_, AllocationTraits::kHugePageSize)
+      : mmap(nullptr,
+             byteSize_,
+             PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS,
+             -1,
+             0);
   if (ptr == MAP_FAILED || ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory "
@@ -570,6 +677,15 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaLocal) {
+    bindNumaLocal(address_, byteSize_);
+  }
+#ifdef linux
+  if (useHugePages && ::madvise(address_, byteSize_, MADV_HUGEPAGE) != 0) {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
+                           << folly::errnoStr(errno);
+  }
+#endif
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -992,7 +1108,8 @@ std::string MmapAllocator::toString() const {
   out << "Memory Allocator[" << kindString(kind_) << " capacity "
       << ((capacity_ == kMaxMemory) ? "UNLIMITED" : succinctBytes(capacity_))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_
+      << " thread cached pages " << numThreadCachedPages_ << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
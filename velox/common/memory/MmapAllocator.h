@@ -24,6 +24,8 @@
 #include <mutex>
 #include <unordered_set>
 
+#include <folly/ThreadLocal.h>
+
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MmapArena.h"
@@ -75,8 +77,36 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If not zero, the address ranges of size classes whose class page is at
+    /// least this many machine pages are aligned to the huge page size and
+    /// advised for transparent huge pages. This reduces TLB misses on large
+    /// hash tables and row containers. Contiguous allocations use huge pages
+    /// as controlled by FLAGS_velox_memory_use_hugepages.
+    MachinePageCount hugePageMinSizeClass = 0;
+
+    /// If set true, the size classes and the contiguous allocations made by
+    /// system mmap use the local NUMA memory policy regardless of the policy
+    /// of the process. Each page is then backed by memory of the NUMA node of
+    /// the thread that first touches it after mapping or after being advised
+    /// away.
+    bool numaLocal = false;
+
+    /// If set true, each thread keeps up to kThreadCacheEntries of the class
+    /// pages it frees through freeBytes() for each size class of at most
+    /// kThreadCacheMaxClassPages, and reuses them in allocateBytes() without
+    /// taking the size class lock. The cached pages stay counted as
+    /// allocated. They are returned to the size classes when the thread
+    /// exits, when an allocation fails or when 'this' is destroyed.
+    bool useThreadCache = false;
   };
 
+  /// Max number of free class pages a thread caches per size class.
+  static constexpr int32_t kThreadCacheEntries = 8;
+
+  /// Largest size class in machine pages that is cached per thread.
+  static constexpr MachinePageCount kThreadCacheMaxClassPages = 16;
+
   explicit MmapAllocator(const Options& options);
 
   ~MmapAllocator();
@@ -147,6 +177,11 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_;
   }
 
+  /// Returns the number of machine pages held in thread caches.
+  MachinePageCount numThreadCachedPages() const {
+    return numThreadCachedPages_;
+  }
+
   Stats stats() const override {
     auto stats = stats_;
     stats.numAdvise = numAdvisedPages_;
@@ -162,7 +197,11 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        bool useHugePages,
+        bool numaLocal);
 
     ~SizeClass();
 
@@ -370,6 +409,37 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Number of size classes cached per thread. The size classes are powers of
+  // two.
+  static constexpr int32_t kNumThreadCacheClasses =
+      __builtin_ctzll(kThreadCacheMaxClassPages) + 1;
+
+  // Free class pages of one thread by log2 of the size class size.
+  struct ThreadCache {
+    explicit ThreadCache(MmapAllocator* _allocator) : allocator(_allocator) {
+      // Reserves upfront so that noexcept freeBytes() does not allocate.
+      for (auto& classPages : pages) {
+        classPages.reserve(kThreadCacheEntries);
+      }
+    }
+
+    ~ThreadCache() {
+      allocator->flushThreadCache(*this);
+    }
+
+    MmapAllocator* const allocator;
+    std::array<std::vector<void*>, kNumThreadCacheClasses> pages;
+  };
+
+  struct ThreadCacheTag {};
+
+  // Returns the thread cache free list for class pages of 'numPages' or
+  // nullptr if these are not cached.
+  std::vector<void*>* threadCachePages(MachinePageCount numPages);
+
+  // Returns the class pages of 'cache' to the size classes.
+  void flushThreadCache(ThreadCache& cache);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -377,6 +447,12 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // If true, the memory of size classes and system mmapped contiguous
+  // allocations is placed with the local NUMA policy.
+  const bool numaLocal_;
+
+  const bool useThreadCache_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
@@ -413,6 +489,7 @@ class MmapAllocator : public MemoryAllocator {
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
   std::atomic<uint64_t> numMallocBytes_ = 0;
+  std::atomic<MachinePageCount> numThreadCachedPages_ = 0;
 
   // Allocations that are larger than largest size classes will be delegated to
   // ManagedMmapArenas, to avoid calling mmap on every allocation.
@@ -420,6 +497,11 @@ class MmapAllocator : public MemoryAllocator {
   std::unique_ptr<ManagedMmapArenas> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
+
+  // Declared last so that the caches are flushed before the size classes are
+  // destroyed.
+  folly::ThreadLocal<ThreadCache, ThreadCacheTag> threadCaches_{
+      [this]() { return new ThreadCache(this); }};
 };
 
 } // namespace facebook::velox::memory
@@ -111,3 +111,50 @@ TEST_F(AllocationPoolTest, hugePages) {
   // Should be empty after destruction.
   EXPECT_EQ(0, pool_->currentBytes());
 }
+
+TEST_F(AllocationPoolTest, contiguousArena) {
+  constexpr int64_t kHugePageSize = memory::AllocationTraits::kHugePageSize;
+  constexpr int64_t kArenaBytes = 64 << 20;
+  auto allocationPool = std::make_unique<memory::AllocationPool>(pool_.get());
+  allocationPool->setContiguousArena(kArenaBytes);
+  EXPECT_TRUE(allocationPool->isContiguous());
+
+  // The first allocation maps the whole arena and reserves one huge page.
+  auto* start = allocationPool->allocateFixed(100);
+  EXPECT_EQ(1, allocationPool->numRanges());
+  EXPECT_EQ(start, allocationPool->contiguousStart());
+  EXPECT_LE(kArenaBytes - 100, allocationPool->testingFreeAddressableBytes());
+  EXPECT_EQ(kHugePageSize, allocationPool->allocatedBytes());
+
+  // The reservation doubles as the arena fills up.
+  int64_t allocatedBytes = kHugePageSize;
+  int32_t numGrows = 0;
+  int64_t totalBytes = 100;
+  while (totalBytes + (64 << 10) <= kArenaBytes) {
+    auto* data = allocationPool->allocateFixed(64 << 10);
+    EXPECT_EQ(start + totalBytes, data);
+    totalBytes += 64 << 10;
+    if (allocationPool->allocatedBytes() != allocatedBytes) {
+      EXPECT_GE(allocationPool->allocatedBytes(), 2 * allocatedBytes);
+      allocatedBytes = allocationPool->allocatedBytes();
+      ++numGrows;
+    }
+  }
+  EXPECT_TRUE(allocationPool->isContiguous());
+  EXPECT_EQ(1, allocationPool->numRanges());
+  EXPECT_LE(numGrows, 6);
+  EXPECT_LE(allocationPool->allocatedBytes(), kArenaBytes + kHugePageSize);
+  EXPECT_LE(allocationPool->allocatedBytes(), pool_->currentBytes());
+
+  // Allocating past the arena starts a new range.
+  allocationPool->allocateFixed(kArenaBytes);
+  EXPECT_FALSE(allocationPool->isContiguous());
+  EXPECT_EQ(2, allocationPool->numRanges());
+
+  allocationPool->clear();
+  EXPECT_EQ(0, allocationPool->numRanges());
+  VELOX_ASSERT_THROW(
+      allocationPool->setContiguousArena(
+          memory::AllocationPool::kMaxContiguousArenaBytes + 1),
+      "");
+}
@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Multi-threaded allocation benchmark over allocators, memory consumers,
+// memory pool hierarchy depths and thread counts. Each thread keeps a working
+// set of allocations with sizes drawn from a size distribution and replaces
+// random allocations with new ones. Reports the throughput, the median and
+// p99 latency of an allocation or free and the RSS above the working set.
+//
+// Example:
+//   velox_allocator_suite_benchmark --allocators=mmap --num_threads=1,64
+//       --consumers=memory_pool --size_trace=/tmp/sizes.txt
+
+#include <folly/Conv.h>
+#include <folly/FileUtil.h>
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "velox/common/memory/AllocationPool.h"
+#include "velox/common/memory/HashStringAllocator.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/memory/MmapAllocator.h"
+
+DEFINE_string(
+    allocators,
+    "malloc,mmap",
+    "Comma separated memory allocators to run: malloc, mmap");
+DEFINE_string(
+    consumers,
+    "memory_pool,hash_string_allocator,allocation_pool",
+    "Comma separated memory consumers to run: memory_pool (MemoryPool "
+    "allocate and free), hash_string_allocator (HashStringAllocator allocate "
+    "and free), allocation_pool (AllocationPool allocateFixed and clear)");
+DEFINE_string(
+    pool_depths,
+    "2,4",
+    "Comma separated numbers of memory pool levels from the root pool to the "
+    "leaf pool of each thread. The pools above the leaf are shared by all "
+    "threads");
+DEFINE_string(
+    num_threads,
+    "1,4,16,64,128",
+    "Comma separated numbers of allocating threads");
+DEFINE_uint64(
+    working_set_bytes,
+    1UL << 30,
+    "The bytes allocated and not freed, divided among the threads");
+DEFINE_uint64(
+    capacity_bytes,
+    8UL << 30,
+    "The capacity of the memory allocator");
+DEFINE_uint32(
+    num_ops_per_thread,
+    200'000,
+    "The number of allocations per thread in each run");
+DEFINE_uint32(
+    latency_sample_interval,
+    8,
+    "Times one in this many allocations and frees for latency percentiles");
+DEFINE_string(
+    size_trace,
+    "",
+    "If set, a file of '<bytes> <count>' lines giving the allocation size "
+    "distribution, e.g. aggregated from a MemoryPool debug mode allocation "
+    "summary. Uses a built-in distribution if empty");
+DEFINE_uint32(seed, 1234, "Random seed");
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+namespace {
+
+// A range of allocation sizes and its relative frequency.
+struct SizeBucket {
+  int64_t minBytes;
+  int64_t maxBytes;
+  double weight;
+};
+
+// Shaped after allocation size histograms of analytical queries: mostly small
+// string, row and accumulator allocations, vector buffers of a few KB up to
+// 1MB and rare multi-MB hash table and exchange buffers.
+const std::vector<SizeBucket> kDefaultSizes = {
+    {8, 64, 30},
+    {65, 512, 25},
+    {513, 4 << 10, 20},
+    {(4 << 10) + 1, 64 << 10, 15},
+    {(64 << 10) + 1, 1 << 20, 9},
+    {(1 << 20) + 1, 8 << 20, 1},
+};
+
+std::vector<SizeBucket> readSizeTrace(const std::string& path) {
+  std::string content;
+  VELOX_CHECK(folly::readFile(path.c_str(), content), "Cannot read {}", path);
+  std::vector<folly::StringPiece> lines;
+  folly::split('\n', content, lines, true);
+  std::vector<SizeBucket> sizes;
+  for (const auto& line : lines) {
+    std::vector<folly::StringPiece> fields;
+    folly::split(' ', line, fields, true);
+    VELOX_CHECK_EQ(fields.size(), 2, "Malformed size trace line: {}", line);
+    const auto bytes = folly::to<int64_t>(fields[0]);
+    VELOX_CHECK_GT(bytes, 0);
+    sizes.push_back({bytes, bytes, folly::to<double>(fields[1])});
+  }
+  VELOX_CHECK(!sizes.empty(), "Empty size trace {}", path);
+  return sizes;
+}
+
+// Draws allocation sizes from a list of SizeBuckets.
+class SizeDistribution {
+ public:
+  explicit SizeDistribution(const std::vector<SizeBucket>& buckets)
+      : buckets_(buckets) {
+    double sum = 0;
+    for (const auto& bucket : buckets_) {
+      sum += bucket.weight;
+      cumulativeWeights_.push_back(sum);
+    }
+  }
+
+  int64_t next(folly::Random::DefaultGenerator& rng) const {
+    const double point =
+        folly::Random::randDouble01(rng) * cumulativeWeights_.back();
+    const auto index = std::min<size_t>(
+        std::upper_bound(
+            cumulativeWeights_.begin(), cumulativeWeights_.end(), point) -
+            cumulativeWeights_.begin(),
+        buckets_.size() - 1);
+    const auto& bucket = buckets_[index];
+    return bucket.minBytes +
+        folly::Random::rand64(bucket.maxBytes - bucket.minBytes + 1, rng);
+  }
+
+ private:
+  const std::vector<SizeBucket> buckets_;
+  std::vector<double> cumulativeWeights_;
+};
+
+int64_t residentBytes() {
+  std::string statm;
+  if (!folly::readFile("/proc/self/statm", statm)) {
+    return 0;
+  }
+  std::vector<folly::StringPiece> fields;
+  folly::split(' ', statm, fields, true);
+  return fields.size() < 2
+      ? 0
+      : folly::to<int64_t>(fields[1]) * sysconf(_SC_PAGESIZE);
+}
+
+// The allocation interface of a memory consumer. One instance per thread.
+class Consumer {
+ public:
+  virtual ~Consumer() = default;
+
+  virtual void* allocate(int64_t bytes) = 0;
+
+  // Returns false if individual allocations cannot be freed. Then the
+  // benchmark frees everything with clear().
+  virtual bool canFree() const = 0;
+
+  virtual void free(void* ptr, int64_t bytes) = 0;
+
+  virtual void clear() = 0;
+};
+
+class MemoryPoolConsumer : public Consumer {
+ public:
+  explicit MemoryPoolConsumer(MemoryPool* pool) : pool_(pool) {}
+
+  void* allocate(int64_t bytes) override {
+    return pool_->allocate(bytes);
+  }
+
+  bool canFree() const override {
+    return true;
+  }
+
+  void free(void* ptr, int64_t bytes) override {
+    pool_->free(ptr, bytes);
+  }
+
+  void clear() override {}
+
+ private:
+  MemoryPool* const pool_;
+};
+
+class HashStringAllocatorConsumer : public Consumer {
+ public:
+  explicit HashStringAllocatorConsumer(MemoryPool* pool) : allocator_(pool) {}
+
+  void* allocate(int64_t bytes) override {
+    return allocator_.allocate(bytes);
+  }
+
+  bool canFree() const override {
+    return true;
+  }
+
+  void free(void* ptr, int64_t /*bytes*/) override {
+    allocator_.free(reinterpret_cast<HashStringAllocator::Header*>(ptr));
+  }
+
+  void clear() override {
+    allocator_.clear();
+  }
+
+ private:
+  HashStringAllocator allocator_;
+};
+
+class AllocationPoolConsumer : public Consumer {
+ public:
+  explicit AllocationPoolConsumer(MemoryPool* pool) : allocationPool_(pool) {}
+
+  void* allocate(int64_t bytes) override {
+    return allocationPool_.allocateFixed(bytes);
+  }
+
+  bool canFree() const override {
+    return false;
+  }
+
+  void free(void* /*ptr*/, int64_t /*bytes*/) override {
+    VELOX_UNREACHABLE();
+  }
+
+  void clear() override {
+    allocationPool_.clear();
+  }
+
+ private:
+  AllocationPool allocationPool_;
+};
+
+std::unique_ptr<Consumer> makeConsumer(
+    const std::string& kind,
+    MemoryPool* pool) {
+  if (kind == "memory_pool") {
+    return std::make_unique<MemoryPoolConsumer>(pool);
+  }
+  if (kind == "hash_string_allocator") {
+    return std::make_unique<HashStringAllocatorConsumer>(pool);
+  }
+  if (kind == "allocation_pool") {
+    return std::make_unique<AllocationPoolConsumer>(pool);
+  }
+  VELOX_USER_FAIL("Unknown consumer: {}", kind);
+}
+
+// Runs the allocations of one thread.
+class Worker {
+ public:
+  Worker(
+      std::unique_ptr<Consumer> consumer,
+      const SizeDistribution& sizes,
+      int64_t workingSetBytes,
+      uint32_t numOps,
+      uint32_t seed)
+      : consumer_(std::move(consumer)),
+        sizes_(sizes),
+        workingSetBytes_(workingSetBytes),
+        numOps_(numOps),
+        rng_(seed) {
+    // Sized before the run so that the samples do not count as RSS overhead.
+    latencies_.resize(2 * numOps_ / FLAGS_latency_sample_interval + 2);
+    latencies_.resize(0);
+  }
+
+  ~Worker() {
+    freeAll();
+  }
+
+  void run() {
+    for (uint32_t i = 0; i < numOps_; ++i) {
+      const int64_t bytes = sizes_.next(rng_);
+      while (liveBytes_ > 0 && liveBytes_ + bytes > workingSetBytes_) {
+        if (!consumer_->canFree()) {
+          timed([&]() { consumer_->clear(); });
+          allocations_.clear();
+          liveBytes_ = 0;
+          break;
+        }
+        freeRandom();
+      }
+      void* ptr;
+      timed([&]() { ptr = consumer_->allocate(bytes); });
+      allocations_.push_back({ptr, bytes});
+      liveBytes_ += bytes;
+      peakLiveBytes_ = std::max(peakLiveBytes_, liveBytes_);
+    }
+  }
+
+  void freeAll() {
+    if (consumer_->canFree()) {
+      for (const auto& allocation : allocations_) {
+        consumer_->free(allocation.ptr, allocation.bytes);
+      }
+    }
+    consumer_->clear();
+    allocations_.clear();
+    liveBytes_ = 0;
+  }
+
+  uint64_t numTimedOps() const {
+    return numTimedOps_;
+  }
+
+  uint64_t elapsedNanos() const {
+    return elapsedNanos_;
+  }
+
+  int64_t peakLiveBytes() const {
+    return peakLiveBytes_;
+  }
+
+  const std::vector<uint32_t>& latencies() const {
+    return latencies_;
+  }
+
+ private:
+  struct Allocation {
+    void* ptr;
+    int64_t bytes;
+  };
+
+  void freeRandom() {
+    const auto index = folly::Random::rand32(allocations_.size(), rng_);
+    const auto allocation = allocations_[index];
+    allocations_[index] = allocations_.back();
+    allocations_.pop_back();
+    timed([&]() { consumer_->free(allocation.ptr, allocation.bytes); });
+    liveBytes_ -= allocation.bytes;
+  }
+
+  template <typename Func>
+  void timed(Func func) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+    elapsedNanos_ += nanos;
+    if (numTimedOps_++ % FLAGS_latency_sample_interval == 0) {
+      latencies_.push_back(std::min<int64_t>(nanos, UINT32_MAX));
+    }
+  }
+
+  const std::unique_ptr<Consumer> consumer_;
+  const SizeDistribution& sizes_;
+  const int64_t workingSetBytes_;
+  const uint32_t numOps_;
+  folly::Random::DefaultGenerator rng_;
+  std::vector<Allocation> allocations_;
+  int64_t liveBytes_{0};
+  int64_t peakLiveBytes_{0};
+  uint64_t numTimedOps_{0};
+  uint64_t elapsedNanos_{0};
+  std::vector<uint32_t> latencies_;
+};
+
+struct Scenario {
+  std::string allocator;
+  std::string consumer;
+  int32_t poolDepth;
+  int32_t numThreads;
+};
+
+struct Result {
+  double opsPerSecond;
+  uint64_t p50Nanos;
+  uint64_t p99Nanos;
+  int64_t peakRssBytes;
+  // Peak RSS growth above the peak working set, relative to the working set.
+  double rssOverhead;
+};
+
+std::unique_ptr<MemoryManager> makeMemoryManager(
+    const std::string& allocatorKind,
+    std::shared_ptr<MemoryAllocator>& allocator) {
+  const auto capacity = static_cast<int64_t>(FLAGS_capacity_bytes);
+  if (allocatorKind == "malloc") {
+    return std::make_unique<MemoryManager>(
+        MemoryManagerOptions{.capacity = capacity});
+  }
+  if (allocatorKind == "mmap") {
+    MmapAllocator::Options options;
+    options.capacity = capacity;
+    allocator = std::make_shared<MmapAllocator>(options);
+    return std::make_unique<MemoryManager>(MemoryManagerOptions{
+        .capacity = capacity, .allocator = allocator.get()});
+  }
+  VELOX_USER_FAIL("Unknown allocator: {}", allocatorKind);
+}
+
+Result runScenario(const Scenario& scenario, const SizeDistribution& sizes) {
+  std::shared_ptr<MemoryAllocator> allocator;
+  auto manager = makeMemoryManager(scenario.allocator, allocator);
+
+  // The pools above the leaves are shared by all threads as the pools of a
+  // query and its tasks are shared by its drivers.
+  std::vector<std::shared_ptr<MemoryPool>> sharedPools;
+  sharedPools.push_back(manager->addRootPool("root"));
+  for (auto i = 2; i < scenario.poolDepth; ++i) {
+    sharedPools.push_back(
+        sharedPools.back()->addAggregateChild(fmt::format("level{}", i)));
+  }
+  std::vector<std::shared_ptr<MemoryPool>> leafPools;
+  std::vector<std::unique_ptr<Worker>> workers;
+  const int64_t workingSetBytes = FLAGS_working_set_bytes / scenario.numThreads;
+  for (auto i = 0; i < scenario.numThreads; ++i) {
+    leafPools.push_back(
+        sharedPools.back()->addLeafChild(fmt::format("leaf{}", i)));
+    workers.push_back(std::make_unique<Worker>(
+        makeConsumer(scenario.consumer, leafPools.back().get()),
+        sizes,
+        workingSetBytes,
+        FLAGS_num_ops_per_thread,
+        FLAGS_seed + i));
+  }
+
+  const int64_t baseRssBytes = residentBytes();
+  std::atomic<bool> done{false};
+  std::atomic<int64_t> peakRssBytes{baseRssBytes};
+  std::thread rssSampler([&]() {
+    while (!done) {
+      peakRssBytes = std::max<int64_t>(peakRssBytes, residentBytes());
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  threads.reserve(scenario.numThreads);
+  for (auto& worker : workers) {
+    threads.emplace_back([rawWorker = worker.get()]() { rawWorker->run(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto wallNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  done = true;
+  rssSampler.join();
+  peakRssBytes = std::max<int64_t>(peakRssBytes, residentBytes());
+
+  uint64_t numOps{0};
+  int64_t peakLiveBytes{0};
+  std::vector<uint32_t> latencies;
+  for (const auto& worker : workers) {
+    numOps += worker->numTimedOps();
+    peakLiveBytes += worker->peakLiveBytes();
+    const auto& workerLatencies = worker->latencies();
+    latencies.insert(
+        latencies.end(), workerLatencies.begin(), workerLatencies.end());
+  }
+  workers.clear();
+
+  Result result;
+  result.opsPerSecond = numOps * 1.0e9 / std::max<int64_t>(wallNanos, 1);
+  const auto percentile = [&](double fraction) -> uint64_t {
+    if (latencies.empty()) {
+      return 0;
+    }
+    const size_t index = fraction * (latencies.size() - 1);
+    std::nth_element(
+        latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index];
+  };
+  result.p50Nanos = percentile(0.5);
+  result.p99Nanos = percentile(0.99);
+  result.peakRssBytes = peakRssBytes - baseRssBytes;
+  result.rssOverhead = peakLiveBytes == 0
+      ? 0
+      : (result.peakRssBytes - peakLiveBytes) /
+          static_cast<double>(peakLiveBytes);
+  return result;
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> items;
+  folly::split(',', list, items, true);
+  return items;
+}
+
+std::vector<int32_t> splitIntList(const std::string& list) {
+  std::vector<int32_t> values;
+  for (const auto& item : splitList(list)) {
+    values.push_back(folly::to<int32_t>(item));
+  }
+  return values;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  VELOX_CHECK_GT(FLAGS_latency_sample_interval, 0);
+  const SizeDistribution sizes(
+      FLAGS_size_trace.empty() ? kDefaultSizes
+                               : readSizeTrace(FLAGS_size_trace));
+
+  std::cout << std::left << std::setw(8) << "ALLOC" << std::setw(24)
+            << "CONSUMER" << std::setw(7) << "DEPTH" << std::setw(9)
+            << "THREADS" << std::setw(14) << "OPS/S" << std::setw(10)
+            << "P50(ns)" << std::setw(10) << "P99(ns)" << std::setw(12)
+            << "PEAK_RSS"
+            << "RSS_OVERHEAD" << std::endl;
+  for (const auto& allocator : splitList(FLAGS_allocators)) {
+    for (const auto& consumer : splitList(FLAGS_consumers)) {
+      for (const auto poolDepth : splitIntList(FLAGS_pool_depths)) {
+        VELOX_USER_CHECK_GE(poolDepth, 2, "A pool depth is at least 2");
+        for (const auto numThreads : splitIntList(FLAGS_num_threads)) {
+          const Scenario scenario{allocator, consumer, poolDepth, numThreads};
+          const auto result = runScenario(scenario, sizes);
+          std::cout << std::left << std::setw(8) << allocator << std::setw(24)
+                    << consumer << std::setw(7) << poolDepth << std::setw(9)
+                    << numThreads << std::setw(14)
+                    << static_cast<uint64_t>(result.opsPerSecond)
+                    << std::setw(10) << result.p50Nanos << std::setw(10)
+                    << result.p99Nanos << std::setw(12)
+                    << succinctBytes(std::max<int64_t>(result.peakRssBytes, 0))
+                    << std::fixed << std::setprecision(1)
+                    << result.rssOverhead * 100 << "%" << std::endl;
+        }
+      }
+    }
+  }
+  return 0;
+}
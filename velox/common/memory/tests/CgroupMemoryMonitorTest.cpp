@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/CgroupMemoryMonitor.h"
+
+#include <folly/FileUtil.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/memory/MallocAllocator.h"
+#include "velox/exec/SharedArbitrator.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+
+using namespace facebook::velox::exec::test;
+
+namespace facebook::velox::memory {
+namespace {
+constexpr int64_t MB = 1L << 20;
+constexpr int64_t GB = 1L << 30;
+constexpr int64_t kCapacity = 4 * GB;
+
+class CgroupMemoryMonitorTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    exec::SharedArbitrator::registerFactory();
+  }
+
+  void SetUp() override {
+    allocator_ = std::make_shared<MallocAllocator>(kCapacity);
+    MemoryManagerOptions options;
+    options.allocator = allocator_.get();
+    options.capacity = kCapacity;
+    options.arbitratorKind = "SHARED";
+    manager_ = std::make_unique<MemoryManager>(options);
+    cgroupDir_ = TempDirectoryPath::create();
+  }
+
+  void writeCgroup(
+      const std::string& maxBytes,
+      int64_t currentBytes,
+      double someAvg10 = 0) {
+    writeCgroupFile("memory.max", maxBytes + "\n");
+    writeCgroupFile("memory.current", fmt::format("{}\n", currentBytes));
+    writeCgroupFile(
+        "memory.pressure",
+        fmt::format(
+            "some avg10={:.2f} avg60=0.00 avg300=0.00 total=100\n"
+            "full avg10=0.00 avg60=0.00 avg300=0.00 total=10\n",
+            someAvg10));
+  }
+
+  void writeCgroupFile(const std::string& name, const std::string& content) {
+    const auto path = cgroupDir_->path + "/" + name;
+    ASSERT_TRUE(folly::writeFile(content, path.c_str()));
+  }
+
+  CgroupMemoryMonitor::Options monitorOptions() const {
+    CgroupMemoryMonitor::Options options;
+    options.cgroupPath = cgroupDir_->path;
+    options.reservedBytes = 512 * MB;
+    options.minFreeBytes = 256 * MB;
+    options.shrinkBytes = 64 * MB;
+    return options;
+  }
+
+  std::shared_ptr<MemoryAllocator> allocator_;
+  std::unique_ptr<MemoryManager> manager_;
+  std::shared_ptr<TempDirectoryPath> cgroupDir_;
+};
+
+TEST_F(CgroupMemoryMonitorTest, parse) {
+  EXPECT_EQ(kMaxMemory, CgroupMemoryMonitor::parseMemoryBytes("max\n"));
+  EXPECT_EQ(1234, CgroupMemoryMonitor::parseMemoryBytes("1234\n"));
+  EXPECT_FALSE(CgroupMemoryMonitor::parseMemoryBytes("12ab").has_value());
+  EXPECT_FALSE(CgroupMemoryMonitor::parseMemoryBytes("").has_value());
+
+  CgroupMemoryStats stats;
+  ASSERT_TRUE(CgroupMemoryMonitor::parsePressure(
+      "some avg10=12.50 avg60=3.00 avg300=1.00 total=123\n"
+      "full avg10=2.25 avg60=1.00 avg300=0.10 total=45\n",
+      stats));
+  EXPECT_EQ(12.5, stats.someAvg10);
+  EXPECT_EQ(2.25, stats.fullAvg10);
+  EXPECT_FALSE(CgroupMemoryMonitor::parsePressure("some 12\n", stats));
+  EXPECT_FALSE(
+      CgroupMemoryMonitor::parsePressure("other avg10=1.00\n", stats));
+}
+
+TEST_F(CgroupMemoryMonitorTest, noCgroup) {
+  auto options = monitorOptions();
+  options.cgroupPath = cgroupDir_->path + "/nonexistent";
+  CgroupMemoryMonitor monitor(manager_.get(), options);
+  EXPECT_FALSE(CgroupMemoryMonitor::readStats(options.cgroupPath).has_value());
+  EXPECT_FALSE(monitor.refresh());
+  EXPECT_EQ(kCapacity, manager_->arbitrator()->capacityLimit());
+}
+
+TEST_F(CgroupMemoryMonitorTest, capacityLimit) {
+  CgroupMemoryMonitor monitor(manager_.get(), monitorOptions());
+  auto* arbitrator = manager_->arbitrator();
+
+  // The memory used outside of the memory manager and the reserved memory are
+  // taken out of the arbitrator capacity.
+  writeCgroup(fmt::format("{}", 3 * GB), 1 * GB);
+  ASSERT_TRUE(monitor.refresh());
+  EXPECT_EQ(3 * GB, monitor.cgroupStats().limitBytes);
+  EXPECT_EQ(1 * GB, monitor.cgroupStats().currentBytes);
+  EXPECT_EQ(3 * GB - 512 * MB - 1 * GB, arbitrator->capacityLimit());
+  EXPECT_EQ(
+      3 * GB - 512 * MB - 1 * GB, arbitrator->stats().freeCapacityBytes);
+  EXPECT_EQ(0, monitor.stats().numPressureEvents);
+
+  // The limit is capped at the arbitrator capacity.
+  writeCgroup(fmt::format("{}", 16 * GB), 0);
+  ASSERT_TRUE(monitor.refresh());
+  EXPECT_EQ(kCapacity, arbitrator->capacityLimit());
+  EXPECT_EQ(kCapacity, arbitrator->stats().freeCapacityBytes);
+
+  writeCgroup("max", 1 * GB);
+  ASSERT_TRUE(monitor.refresh());
+  EXPECT_EQ(kMaxMemory, monitor.cgroupStats().limitBytes);
+  EXPECT_EQ(kCapacity, arbitrator->capacityLimit());
+  EXPECT_EQ(0, monitor.stats().numPressureEvents);
+}
+
+TEST_F(CgroupMemoryMonitorTest, pressure) {
+  std::vector<uint64_t> cacheShrinkTargets;
+  auto options = monitorOptions();
+  options.shrinkCache = [&](uint64_t targetBytes) {
+    cacheShrinkTargets.push_back(targetBytes);
+    return 16 * MB;
+  };
+  CgroupMemoryMonitor monitor(manager_.get(), options);
+
+  // Enough free memory and no stalls.
+  writeCgroup(fmt::format("{}", 2 * GB), 1 * GB);
+  ASSERT_TRUE(monitor.refresh());
+  EXPECT_TRUE(cacheShrinkTargets.empty());
+
+  // Less than 'minFreeBytes' free sheds the missing free memory.
+  writeCgroup(fmt::format("{}", 2 * GB), 2 * GB - 100 * MB);
+  ASSERT_TRUE(monitor.refresh());
+  ASSERT_EQ(1, cacheShrinkTargets.size());
+  EXPECT_EQ(156 * MB, cacheShrinkTargets.back());
+  EXPECT_EQ(0, manager_->arbitrator()->capacityLimit());
+
+  // Memory stalls shed 'shrinkBytes'.
+  writeCgroup(fmt::format("{}", 2 * GB), 1 * GB, 25.0);
+  ASSERT_TRUE(monitor.refresh());
+  ASSERT_EQ(2, cacheShrinkTargets.size());
+  EXPECT_EQ(64 * MB, cacheShrinkTargets.back());
+  EXPECT_EQ(25.0, monitor.cgroupStats().someAvg10);
+
+  EXPECT_EQ(2, monitor.stats().numPressureEvents);
+  EXPECT_EQ(32 * MB, monitor.stats().cacheShrunkBytes);
+  // There are no memory pools to shrink.
+  EXPECT_EQ(0, monitor.stats().poolShrunkBytes);
+}
+} // namespace
+} // namespace facebook::velox::memory
@@ -497,6 +497,60 @@ TEST_F(HashStringAllocatorTest, freeLists) {
   ASSERT_LT(std::chrono::steady_clock::now() - t0, std::chrono::seconds(30));
 }
 
+TEST_F(HashStringAllocatorTest, fragmentationStats) {
+  auto stats = allocator_->fragmentationStats();
+  ASSERT_EQ(0, stats.numFreeBlocks);
+  ASSERT_EQ(0, stats.freeBytes);
+  ASSERT_EQ(0, stats.fragmentation());
+
+  // Allocate a small block followed by two medium blocks and free the medium
+  // blocks. Each pair coalesces into a block that is larger than kMaxAlloc and
+  // goes to a size class free list.
+  constexpr int32_t kSmall = 32;
+  constexpr int32_t kMedium = 2'000;
+  constexpr int32_t kNumGroups = 1'000;
+  std::vector<HSA::Header*> small;
+  std::vector<HSA::Header*> medium;
+  for (auto i = 0; i < kNumGroups; ++i) {
+    small.push_back(allocate(kSmall));
+    medium.push_back(allocate(kMedium));
+    medium.push_back(allocate(kMedium));
+  }
+  for (auto* header : medium) {
+    allocator_->free(header);
+  }
+  allocator_->checkConsistency();
+  stats = allocator_->fragmentationStats();
+  ASSERT_GE(stats.numFreeBlocks, kNumGroups);
+  ASSERT_GE(stats.largestFreeBlock, 2 * kMedium + sizeof(HSA::Header));
+  ASSERT_GT(stats.fragmentation(), 0);
+  ASSERT_LT(stats.fragmentation(), 1);
+  ASSERT_LE(stats.freeBytes, stats.arenaBytes);
+  ASSERT_NE(allocator_->toString().find(stats.toString()), std::string::npos);
+
+  // Allocations larger than the medium blocks fit in the coalesced free blocks
+  // and do not grow the arena. Some pairs may straddle two arenas and not
+  // coalesce, so allocate fewer blocks than there are groups.
+  constexpr int32_t kLarge = 3'000;
+  std::vector<HSA::Header*> large;
+  for (auto i = 0; i < kNumGroups / 2; ++i) {
+    large.push_back(allocate(kLarge));
+  }
+  allocator_->checkConsistency();
+  ASSERT_EQ(stats.arenaBytes, allocator_->fragmentationStats().arenaBytes);
+
+  // Freeing everything leaves one free block per arena.
+  for (auto* header : small) {
+    allocator_->free(header);
+  }
+  for (auto* header : large) {
+    allocator_->free(header);
+  }
+  ASSERT_TRUE(allocator_->isEmpty());
+  stats = allocator_->fragmentationStats();
+  ASSERT_LE(stats.numFreeBlocks, stats.arenaBytes / (64 << 10));
+}
+
 TEST_F(HashStringAllocatorTest, strings) {
   constexpr uint64_t kMagic1 = 0x133788a07;
   constexpr uint64_t kMagic2 = 0xe7ababe11e;
@@ -464,6 +464,79 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorHugePagesAndNumaLocal) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.hugePageMinSizeClass = 64;
+  options.numaLocal = true;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  for (auto size : mmapAllocator->sizeClasses()) {
+    Allocation allocation;
+    ASSERT_TRUE(mmapAllocator->allocateNonContiguous(4 * size, allocation));
+    for (auto i = 0; i < allocation.numRuns(); ++i) {
+      auto run = allocation.runAt(i);
+      std::memset(run.data(), 1, run.numBytes());
+    }
+    ASSERT_TRUE(mmapAllocator->checkConsistency());
+    mmapAllocator->freeNonContiguous(allocation);
+  }
+  ContiguousAllocation contiguous;
+  ASSERT_TRUE(mmapAllocator->allocateContiguous(1024, nullptr, contiguous));
+  std::memset(contiguous.data(), 1, contiguous.size());
+  mmapAllocator->freeContiguous(contiguous);
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
+TEST_P(MemoryAllocatorTest, mmapAllocatorThreadCache) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useThreadCache = true;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  constexpr uint64_t kBytes = 2 * AllocationTraits::kPageSize;
+  void* first = mmapAllocator->allocateBytes(kBytes);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(mmapAllocator->numAllocated(), 2);
+  mmapAllocator->freeBytes(first, kBytes);
+  ASSERT_EQ(mmapAllocator->numThreadCachedPages(), 2);
+  ASSERT_EQ(mmapAllocator->numAllocated(), 2);
+  ASSERT_EQ(mmapAllocator->allocateBytes(kBytes), first);
+  ASSERT_EQ(mmapAllocator->numThreadCachedPages(), 0);
+
+  // The class pages past kThreadCacheEntries go back to the size class.
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 2 * MmapAllocator::kThreadCacheEntries; ++i) {
+    buffers.push_back(mmapAllocator->allocateBytes(kBytes));
+  }
+  for (auto* buffer : buffers) {
+    mmapAllocator->freeBytes(buffer, kBytes);
+  }
+  ASSERT_EQ(
+      mmapAllocator->numThreadCachedPages(),
+      2 * MmapAllocator::kThreadCacheEntries);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+
+  // The cache of an exiting thread is returned to the size classes.
+  std::thread thread([&]() {
+    mmapAllocator->freeBytes(
+        mmapAllocator->allocateBytes(4 * kBytes), 4 * kBytes);
+    ASSERT_EQ(
+        mmapAllocator->numThreadCachedPages(),
+        2 * MmapAllocator::kThreadCacheEntries + 8);
+  });
+  thread.join();
+  ASSERT_EQ(
+      mmapAllocator->numThreadCachedPages(),
+      2 * MmapAllocator::kThreadCacheEntries);
+  mmapAllocator->freeBytes(first, kBytes);
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
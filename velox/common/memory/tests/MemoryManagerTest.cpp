@@ -103,8 +103,9 @@ TEST_F(MemoryManagerTest, Ctor) {
         "allocated pages 0 mapped pages 0]\n"
         "ARBITRATOR[SHARED CAPACITY[4.00GB] STATS[numRequests 0 numSucceeded 0 "
         "numAborted 0 numFailures 0 numNonReclaimableAttempts 0 "
-        "numReserveRequest 0 numReleaseRequest 0 queueTime 0us "
-        "arbitrationTime 0us reclaimTime 0us shrunkMemory 0B "
+        "numReserveRequest 0 numReleaseRequest 0 numReclaims 0 "
+        "numPriorityReclaims 0 queueTime 0us arbitrationTime 0us "
+        "reclaimTime 0us shrunkMemory 0B "
         "reclaimedMemory 0B maxCapacity 4.00GB freeCapacity 4.00GB]]]");
   }
   {
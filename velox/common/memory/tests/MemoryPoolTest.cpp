@@ -2431,6 +2431,48 @@ TEST(MemoryPoolTest, debugMode) {
   EXPECT_EQ(allocRecords.size(), 0);
 }
 
+TEST(MemoryPoolTest, debugModeWithSampling) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_memory_pool_debug_sample_interval = 4;
+  FLAGS_velox_memory_pool_debug_snapshot_bytes = 1 * MB;
+  constexpr int32_t kNumAllocs = 100;
+  constexpr int64_t kAllocSize = 32 * KB;
+
+  auto allocator =
+      std::make_shared<MallocAllocator>(MemoryAllocator::kDefaultCapacityBytes);
+  MemoryManager manager{{.debugEnabled = true, .allocator = allocator.get()}};
+  auto pool = manager.addRootPool("root")->addLeafChild("child");
+  auto* poolImpl = dynamic_cast<MemoryPoolImpl*>(pool.get());
+  const auto& allocRecords = poolImpl->testingDebugAllocRecords();
+  ASSERT_TRUE(poolImpl->debugAllocationSnapshot().empty());
+
+  std::vector<void*> allocs;
+  for (int32_t i = 0; i < kNumAllocs; ++i) {
+    allocs.push_back(pool->allocate(kAllocSize));
+  }
+  // Only one in four allocations has its call stack recorded.
+  ASSERT_EQ(allocRecords.size(), kNumAllocs / 4);
+
+  // The usage has crossed the snapshot threshold.
+  const auto snapshot = poolImpl->debugAllocationSnapshot();
+  ASSERT_NE(snapshot.find("usage reached"), std::string::npos) << snapshot;
+  ASSERT_NE(snapshot.find("sampled one in 4"), std::string::npos);
+
+  // All allocations come from the same call site and the sampled bytes are
+  // scaled up by the sample interval.
+  const auto summary = poolImpl->debugAllocationSummary(1);
+  ASSERT_NE(summary.find("Top 1 of 1"), std::string::npos) << summary;
+  ASSERT_NE(
+      summary.find(succinctBytes(kNumAllocs * kAllocSize)), std::string::npos)
+      << summary;
+
+  // Frees of allocations that are not sampled are ignored.
+  for (auto* alloc : allocs) {
+    pool->free(alloc, kAllocSize);
+  }
+  ASSERT_TRUE(allocRecords.empty());
+}
+
 TEST(MemoryPoolTest, debugModeWithFilter) {
   constexpr int64_t kMaxMemory = 10 * GB;
   constexpr int64_t kNumIterations = 100;
@@ -66,11 +66,17 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
-    MemoryReclaimer(const std::shared_ptr<MockTask>& task) : task_(task) {}
+    MemoryReclaimer(const std::shared_ptr<MockTask>& task, int32_t priority)
+        : task_(task), priority_(priority) {}
 
     static std::unique_ptr<MemoryReclaimer> create(
-        const std::shared_ptr<MockTask>& task) {
-      return std::make_unique<MemoryReclaimer>(task);
+        const std::shared_ptr<MockTask>& task,
+        int32_t priority = 0) {
+      return std::make_unique<MemoryReclaimer>(task, priority);
+    }
+
+    int32_t priority() const override {
+      return priority_;
     }
 
     void abort(MemoryPool* pool, const std::exception_ptr& error) override {
@@ -84,13 +90,17 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
    private:
     std::weak_ptr<MockTask> task_;
+    const int32_t priority_;
   };
 
-  void initTaskPool(MemoryManager* manager, uint64_t capacity) {
+  void initTaskPool(
+      MemoryManager* manager,
+      uint64_t capacity,
+      int32_t priority = 0) {
     root_ = manager->addRootPool(
         fmt::format("RootPool-{}", poolId_++),
         capacity,
-        MemoryReclaimer::create(shared_from_this()));
+        MemoryReclaimer::create(shared_from_this(), priority));
   }
 
   MemoryPool* pool() const {
@@ -402,7 +412,8 @@ class MockSharedArbitrationTest : public testing::Test {
       int64_t memoryCapacity = 0,
       uint64_t memoryPoolInitCapacity = kMaxMemory,
       uint64_t memoryPoolTransferCapacity = 0,
-      std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr) {
+      std::function<void(MemoryPool&)> arbitrationStateCheckCb = nullptr,
+      bool incrementalReclaim = false) {
     if (memoryPoolInitCapacity == kMaxMemory) {
       memoryPoolInitCapacity = kMemoryPoolInitCapacity;
     }
@@ -420,15 +431,18 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolInitCapacity = memoryPoolInitCapacity;
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.arbitrationStateCheckCb = std::move(arbitrationStateCheckCb);
+    options.incrementalReclaim = incrementalReclaim;
     options.checkUsageLeak = true;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), arbitratorKind);
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
   }
 
-  std::shared_ptr<MockTask> addTask(int64_t capacity = kMaxMemory) {
+  std::shared_ptr<MockTask> addTask(
+      int64_t capacity = kMaxMemory,
+      int32_t priority = 0) {
     auto task = std::make_shared<MockTask>();
-    task->initTaskPool(manager_.get(), capacity);
+    task->initTaskPool(manager_.get(), capacity, priority);
     return task;
   }
 
@@ -590,7 +604,65 @@ TEST_F(MockSharedArbitrationTest, arbitrationFailsTask) {
 
 TEST_F(MockSharedArbitrationTest, shrinkMemory) {
   std::vector<std::shared_ptr<MemoryPool>> pools;
-  ASSERT_THROW(arbitrator_->shrinkMemory(pools, 128), VeloxException);
+  ASSERT_EQ(arbitrator_->shrinkMemory(pools, 128), 0);
+
+  auto* freeOp = addMemoryOp();
+  freeOp->allocate(kMemoryPoolTransferCapacity);
+  freeOp->freeAll();
+  auto* usedOp = addMemoryOp();
+  usedOp->allocate(kMemoryPoolTransferCapacity);
+  const auto freeCapacity = arbitrator_->stats().freeCapacityBytes;
+
+  // The free capacity is shrunk first.
+  ASSERT_EQ(
+      manager_->shrinkPools(kMemoryPoolInitCapacity), kMemoryPoolInitCapacity);
+  ASSERT_EQ(freeOp->pool()->capacity(), 0);
+  ASSERT_EQ(usedOp->pool()->capacity(), kMemoryPoolInitCapacity);
+  ASSERT_EQ(usedOp->reclaimer()->stats().numReclaims, 0);
+
+  // The used memory is reclaimed next.
+  ASSERT_EQ(
+      manager_->shrinkPools(kMemoryPoolInitCapacity), kMemoryPoolInitCapacity);
+  ASSERT_EQ(usedOp->pool()->capacity(), 0);
+  ASSERT_EQ(usedOp->reclaimer()->stats().numReclaims, 1);
+  const auto stats = arbitrator_->stats();
+  ASSERT_EQ(
+      stats.freeCapacityBytes, freeCapacity + 2 * kMemoryPoolInitCapacity);
+  ASSERT_EQ(stats.numReclaimedBytes, kMemoryPoolTransferCapacity);
+}
+
+TEST_F(MockSharedArbitrationTest, capacityLimit) {
+  ASSERT_EQ(arbitrator_->capacityLimit(), kMemoryCapacity);
+  auto* memOp = addMemoryOp();
+  memOp->allocate(kMemoryPoolTransferCapacity);
+  ASSERT_EQ(
+      arbitrator_->stats().freeCapacityBytes,
+      kMemoryCapacity - kMemoryPoolInitCapacity);
+
+  // Lowering the limit withholds the free capacity but leaves the capacity of
+  // the pools alone.
+  arbitrator_->setCapacityLimit(kMemoryPoolTransferCapacity);
+  ASSERT_EQ(arbitrator_->capacityLimit(), kMemoryPoolTransferCapacity);
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, 0);
+  ASSERT_EQ(memOp->pool()->capacity(), kMemoryPoolInitCapacity);
+  ASSERT_NE(
+      arbitrator_->toString().find("CAPACITY_LIMIT[8.00MB]"),
+      std::string::npos);
+
+  // The capacity returned beyond the limit is withheld.
+  memOp->freeAll();
+  ASSERT_EQ(
+      manager_->shrinkPools(kMemoryPoolInitCapacity), kMemoryPoolInitCapacity);
+  ASSERT_EQ(
+      arbitrator_->stats().freeCapacityBytes, kMemoryPoolTransferCapacity);
+  VELOX_ASSERT_THROW(memOp->allocate(kMemoryPoolInitCapacity), "");
+
+  // Raising the limit returns the withheld capacity.
+  arbitrator_->setCapacityLimit(kMaxMemory);
+  ASSERT_EQ(arbitrator_->capacityLimit(), kMemoryCapacity);
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, kMemoryCapacity);
+  memOp->allocate(kMemoryPoolInitCapacity);
+  memOp->freeAll();
 }
 
 TEST_F(MockSharedArbitrationTest, singlePoolGrowWithoutArbitration) {
@@ -986,6 +1058,52 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, incrementalReclaimByPriority) {
+  const uint64_t memoryCapacity = 240 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  setupMemory(memoryCapacity, minPoolCapacity, 0, nullptr, true);
+  const int allocateSize = 8 * MB;
+  std::vector<MockMemoryOperator*> ops;
+  for (const int32_t priority : {0, 0, 10}) {
+    tasks_.push_back(addTask(kMaxMemory, priority));
+    ops.push_back(addMemoryOp(tasks_.back()));
+    while (ops.back()->pool()->currentBytes() < memoryCapacity / 3) {
+      ops.back()->allocate(allocateSize);
+    }
+  }
+  ASSERT_EQ(arbitrator_->stats().freeCapacityBytes, 0);
+
+  // The high priority task grows by reclaiming one transfer capacity from each
+  // of the low priority tasks.
+  ops[2]->allocate(2 * allocateSize);
+  ASSERT_EQ(ops[0]->pool()->currentBytes(), memoryCapacity / 3 - 8 * MB);
+  ASSERT_EQ(ops[1]->pool()->currentBytes(), memoryCapacity / 3 - 8 * MB);
+  ASSERT_EQ(ops[2]->pool()->currentBytes(), memoryCapacity / 3 + 16 * MB);
+  ASSERT_EQ(arbitrator_->stats().numReclaims, 2);
+  ASSERT_EQ(arbitrator_->stats().numPriorityReclaims, 2);
+  clearTasks();
+}
+
+DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, arbitrationInProgress) {
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  ASSERT_FALSE(arbitrator_->arbitrationInProgress(&future));
+  ASSERT_FALSE(future.valid());
+
+  ContinueFuture inProgressFuture = ContinueFuture::makeEmpty();
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::memory::SharedArbitrator::startArbitration",
+      std::function<void(const MemoryPool*)>(
+          ([&](const MemoryPool* /*unused*/) {
+            ASSERT_TRUE(arbitrator_->arbitrationInProgress(&inProgressFuture));
+            ASSERT_FALSE(inProgressFuture.isReady());
+          })));
+  auto* memOp = addMemoryOp();
+  memOp->allocate(kMemoryPoolInitCapacity + kMemoryPoolTransferCapacity);
+  ASSERT_TRUE(inProgressFuture.valid());
+  ASSERT_TRUE(inProgressFuture.isReady());
+  ASSERT_FALSE(arbitrator_->arbitrationInProgress(&future));
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
@@ -63,6 +63,11 @@ bool hasAvx2();
 // flag.
 bool hasBmi2();
 
+// True if the machine has Intel AVX-512 VPOPCNTDQ instructions and these are
+// not disabled by flag. Checked at run time by kernels compiled for AVX-512
+// regardless of the target architecture of the build.
+bool hasAvx512Popcnt();
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <glog/logging.h>
+
+#include <signal.h>
+#include <sys/time.h>
+
+#include <algorithm>
+
+namespace facebook::velox::process {
+
+namespace {
+constexpr int32_t kMaxFrames = 8;
+constexpr int32_t kMaxSamples = 64;
+
+struct Sample {
+  int32_t numFrames;
+  const char* frames[kMaxFrames];
+};
+
+// The profile state of a thread. Trivially constructible so that the signal
+// handler does not run a thread local initializer.
+struct ThreadProfileState {
+  CpuProfile* profile;
+  // The number of pushed frames. May be over kMaxFrames, in which case the
+  // innermost frames are not recorded.
+  int32_t numFrames;
+  const char* frames[kMaxFrames];
+  int32_t numSamples;
+  Sample samples[kMaxSamples];
+  // Samples dropped because 'samples' was full.
+  int64_t numDropped;
+};
+
+thread_local ThreadProfileState threadState;
+
+void onSigprof(int /*signal*/) {
+  auto& state = threadState;
+  if (state.profile == nullptr) {
+    return;
+  }
+  if (state.numSamples == kMaxSamples) {
+    ++state.numDropped;
+    return;
+  }
+  auto& sample = state.samples[state.numSamples];
+  sample.numFrames = std::min(state.numFrames, kMaxFrames);
+  std::copy(state.frames, state.frames + sample.numFrames, sample.frames);
+  std::atomic_signal_fence(std::memory_order_release);
+  ++state.numSamples;
+}
+
+// Adds the samples of the calling thread to its CpuProfile. SIGPROF is
+// blocked meanwhile so that the handler does not write to 'samples'.
+void flushSamples() {
+  auto& state = threadState;
+  if (state.numSamples == 0 && state.numDropped == 0) {
+    return;
+  }
+  sigset_t sigprof;
+  sigemptyset(&sigprof);
+  sigaddset(&sigprof, SIGPROF);
+  sigset_t previous;
+  pthread_sigmask(SIG_BLOCK, &sigprof, &previous);
+  if (state.profile != nullptr) {
+    for (auto i = 0; i < state.numSamples; ++i) {
+      state.profile->add(state.samples[i].frames, state.samples[i].numFrames);
+    }
+    if (state.numDropped > 0) {
+      const char* dropped = "[dropped]";
+      state.profile->add(&dropped, 1, state.numDropped);
+    }
+  }
+  state.numSamples = 0;
+  state.numDropped = 0;
+  pthread_sigmask(SIG_SETMASK, &previous, nullptr);
+}
+
+// Returns a copy of 'label' that is never freed. Each thread keeps the labels
+// it has seen so that the process-wide set is only locked for new labels.
+const char* internLabel(std::string_view label) {
+  thread_local folly::F14FastMap<std::string, const char*> threadLabels;
+  auto it = threadLabels.find(label);
+  if (it != threadLabels.end()) {
+    return it->second;
+  }
+  static std::mutex mutex;
+  static auto* labels = new folly::F14NodeSet<std::string>();
+  const char* interned;
+  {
+    std::lock_guard<std::mutex> l(mutex);
+    interned = labels->emplace(label).first->c_str();
+  }
+  threadLabels.emplace(label, interned);
+  return interned;
+}
+} // namespace
+
+void CpuProfile::add(
+    const char* const* frames,
+    int32_t numFrames,
+    int64_t count) {
+  std::string stack;
+  for (auto i = 0; i < numFrames; ++i) {
+    if (i > 0) {
+      stack += ';';
+    }
+    stack += frames[i];
+  }
+  if (stack.empty()) {
+    stack = "[unknown]";
+  }
+  numSamples_ += count;
+  std::lock_guard<std::mutex> l(mutex_);
+  stacks_[stack] += count;
+}
+
+std::unordered_map<std::string, int64_t> CpuProfile::stacks() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stacks_;
+}
+
+std::atomic<bool> SamplingProfiler::running_{false};
+
+void SamplingProfiler::start(std::chrono::microseconds interval) {
+  static std::once_flag installed;
+  std::call_once(installed, []() {
+    struct sigaction action {};
+    action.sa_handler = onSigprof;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    PCHECK(sigaction(SIGPROF, &action, nullptr) == 0);
+  });
+  itimerval timer{};
+  timer.it_interval.tv_sec = interval.count() / 1'000'000;
+  timer.it_interval.tv_usec = interval.count() % 1'000'000;
+  timer.it_value = timer.it_interval;
+  PCHECK(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+  running_ = true;
+}
+
+void SamplingProfiler::stop() {
+  running_ = false;
+  itimerval timer{};
+  PCHECK(setitimer(ITIMER_PROF, &timer, nullptr) == 0);
+}
+
+ScopedCpuProfile::ScopedCpuProfile(CpuProfile* profile)
+    : prevProfile_(threadState.profile) {
+  flushSamples();
+  threadState.profile = profile;
+}
+
+ScopedCpuProfile::~ScopedCpuProfile() {
+  flushSamples();
+  threadState.profile = prevProfile_;
+}
+
+void ScopedProfileFrame::push(std::string_view label) {
+  auto& state = threadState;
+  if (state.numSamples >= kMaxSamples / 2) {
+    flushSamples();
+  }
+  const auto* interned = internLabel(label);
+  if (state.numFrames < kMaxFrames) {
+    state.frames[state.numFrames] = interned;
+  }
+  std::atomic_signal_fence(std::memory_order_release);
+  ++state.numFrames;
+}
+
+void ScopedProfileFrame::pop() {
+  --threadState.numFrames;
+}
+
+} // namespace facebook::velox::process
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace facebook::velox::process {
+
+/// CPU samples of a task, aggregated by stack of profile frames. A stack is
+/// the frames pushed by ScopedProfileFrame on the sampled thread, e.g. plan
+/// node and operator, operator method and function.
+class CpuProfile {
+ public:
+  /// Adds 'count' samples of the stack of 'numFrames' 'frames', outermost
+  /// first.
+  void add(const char* const* frames, int32_t numFrames, int64_t count = 1);
+
+  /// Returns the number of samples of each stack. The key is the frames
+  /// joined by ';', the folded format of flame graph tools.
+  std::unordered_map<std::string, int64_t> stacks() const;
+
+  int64_t numSamples() const {
+    return numSamples_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, int64_t> stacks_;
+  std::atomic<int64_t> numSamples_{0};
+};
+
+/// Samples the CPU of the process with SIGPROF. A sample of a thread goes to
+/// the CpuProfile set by ScopedCpuProfile on the thread, if any, with the
+/// thread's profile frames. The signal handler only copies the frames to a
+/// thread local buffer. The buffer is added to the CpuProfile outside of the
+/// handler, when the thread leaves the ScopedCpuProfile or pushes a frame.
+class SamplingProfiler {
+ public:
+  /// Starts sampling every 'interval' of process CPU time. Replaces the
+  /// interval if already running.
+  static void start(std::chrono::microseconds interval);
+
+  /// Stops sampling. Samples already taken are kept.
+  static void stop();
+
+  static bool running() {
+    return running_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static std::atomic<bool> running_;
+};
+
+/// Sets the CpuProfile that receives the samples of the calling thread.
+class ScopedCpuProfile {
+ public:
+  explicit ScopedCpuProfile(CpuProfile* profile);
+
+  ~ScopedCpuProfile();
+
+ private:
+  CpuProfile* const prevProfile_;
+};
+
+/// Pushes 'label' on the profile frames of the calling thread while in scope.
+/// Does nothing if the SamplingProfiler is not running or 'label' is empty.
+/// The label is copied once per thread and label, so that the frames stay
+/// valid for samples taken after the owner of 'label' is gone.
+class ScopedProfileFrame {
+ public:
+  explicit ScopedProfileFrame(std::string_view label) {
+    if (SamplingProfiler::running() && !label.empty()) {
+      push(label);
+      pushed_ = true;
+    }
+  }
+
+  ~ScopedProfileFrame() {
+    if (pushed_) {
+      pop();
+    }
+  }
+
+ private:
+  static void push(std::string_view label);
+  static void pop();
+
+  bool pushed_{false};
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/SamplingProfiler.h"
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::process;
+
+namespace {
+
+// Spins for 'duration' of wall time so that the thread gets CPU samples.
+uint64_t spin(std::chrono::milliseconds duration) {
+  const auto end = std::chrono::steady_clock::now() + duration;
+  uint64_t sum = 0;
+  while (std::chrono::steady_clock::now() < end) {
+    for (auto i = 0; i < 1'000; ++i) {
+      sum += i * i;
+    }
+  }
+  return sum;
+}
+
+TEST(SamplingProfilerTest, basic) {
+  CpuProfile profile;
+  SamplingProfiler::start(std::chrono::microseconds(1'000));
+  {
+    ScopedCpuProfile scopedProfile(&profile);
+    std::string node = "0 TableScan";
+    ScopedProfileFrame nodeFrame(node);
+    // The label is copied.
+    node = "changed";
+    {
+      ScopedProfileFrame methodFrame("getOutput");
+      spin(std::chrono::milliseconds(200));
+    }
+    spin(std::chrono::milliseconds(200));
+  }
+  // Not in a ScopedCpuProfile.
+  spin(std::chrono::milliseconds(50));
+  SamplingProfiler::stop();
+
+  const auto stacks = profile.stacks();
+  EXPECT_GT(profile.numSamples(), 0);
+  int64_t total = 0;
+  for (const auto& [stack, count] : stacks) {
+    EXPECT_TRUE(
+        stack == "0 TableScan" || stack == "0 TableScan;getOutput" ||
+        stack == "[dropped]")
+        << stack;
+    total += count;
+  }
+  EXPECT_EQ(profile.numSamples(), total);
+  EXPECT_EQ(1, stacks.count("0 TableScan;getOutput"));
+}
+
+TEST(SamplingProfilerTest, notRunning) {
+  CpuProfile profile;
+  ScopedCpuProfile scopedProfile(&profile);
+  ScopedProfileFrame frame("frame");
+  spin(std::chrono::milliseconds(20));
+  EXPECT_EQ(0, profile.numSamples());
+}
+
+} // namespace
@@ -53,6 +53,28 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  /// Returns splits that together cover the data of 'this', each covering
+  /// about 'targetBytes', or an empty vector if 'this' cannot be divided.
+  /// Lets the Drivers of a Task share the work of one large split.
+  virtual std::vector<std::shared_ptr<ConnectorSplit>> divide(
+      uint64_t /*targetBytes*/) const {
+    return {};
+  }
+
+  /// Returns a string that identifies the data of 'this', including the
+  /// version of the underlying files, so that the results of processing
+  /// 'this' can be cached and reused under the key. Returns an empty string
+  /// if the data cannot be identified, which disables caching.
+  virtual std::string cacheKey() const {
+    return "";
+  }
+
+  /// Returns the bucket of a bucketed table that the data of 'this' is in.
+  /// Used as the split group of the split in grouped execution.
+  virtual std::optional<int32_t> bucketNumber() const {
+    return std::nullopt;
+  }
 };
 
 class ColumnHandle : public ISerializable {
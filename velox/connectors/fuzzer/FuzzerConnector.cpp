@@ -15,9 +15,34 @@
  */
 
 #include "velox/connectors/fuzzer/FuzzerConnector.h"
+
+#include <random>
+
+#include "velox/functions/lib/ZetaDistribution.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 namespace facebook::velox::connector::fuzzer {
+namespace {
+template <typename T>
+VectorPtr makeKeys(
+    const TypePtr& type,
+    vector_size_t size,
+    double nullRatio,
+    const std::function<int64_t()>& nextKey,
+    std::mt19937& rng,
+    memory::MemoryPool* pool) {
+  auto keys = BaseVector::create<FlatVector<T>>(type, size, pool);
+  std::bernoulli_distribution isNull(nullRatio);
+  for (auto i = 0; i < size; ++i) {
+    if (nullRatio > 0 && isNull(rng)) {
+      keys->setNull(i, true);
+    } else {
+      keys->set(i, static_cast<T>(nextKey()));
+    }
+  }
+  return keys;
+}
+} // namespace
 
 FuzzerDataSource::FuzzerDataSource(
     const std::shared_ptr<const RowType>& outputType,
@@ -32,6 +57,68 @@ FuzzerDataSource::FuzzerDataSource(
 
   vectorFuzzer_ = std::make_unique<VectorFuzzer>(
       fuzzerTableHandle->fuzzerOptions, pool_, fuzzerTableHandle->fuzzerSeed);
+  if (fuzzerTableHandle->vectorPoolOptions.numVectors > 0) {
+    makeVectorPool(
+        fuzzerTableHandle->fuzzerOptions,
+        fuzzerTableHandle->fuzzerSeed,
+        fuzzerTableHandle->vectorPoolOptions);
+  }
+}
+
+void FuzzerDataSource::makeVectorPool(
+    const VectorFuzzer::Options& fuzzerOptions,
+    size_t fuzzerSeed,
+    const FuzzerVectorPoolOptions& options) {
+  VELOX_CHECK_GT(fuzzerOptions.vectorSize, 0);
+  std::mt19937 rng(fuzzerSeed);
+  std::function<int64_t()> nextKey;
+  if (options.cardinality > 0) {
+    if (options.skew > 1) {
+      VELOX_CHECK_LE(options.cardinality, std::numeric_limits<int32_t>::max());
+      auto zeta = std::make_shared<functions::ZetaDistribution>(
+          options.skew, options.cardinality);
+      nextKey = [zeta, &rng]() { return (*zeta)(rng) - 1; };
+    } else {
+      auto uniform = std::make_shared<std::uniform_int_distribution<int64_t>>(
+          0, options.cardinality - 1);
+      nextKey = [uniform, &rng]() { return (*uniform)(rng); };
+    }
+  }
+
+  vectorPool_.reserve(options.numVectors);
+  for (auto i = 0; i < options.numVectors; ++i) {
+    auto vector = options.flat ? vectorFuzzer_->fuzzInputFlatRow(outputType_)
+                               : vectorFuzzer_->fuzzInputRow(outputType_);
+    if (nextKey) {
+      for (auto column = 0; column < outputType_->size(); ++column) {
+        const auto& type = outputType_->childAt(column);
+        const auto size = vector->size();
+        const auto nullRatio = fuzzerOptions.nullRatio;
+        auto& child = vector->childAt(column);
+        switch (type->kind()) {
+          case TypeKind::TINYINT:
+            child =
+                makeKeys<int8_t>(type, size, nullRatio, nextKey, rng, pool_);
+            break;
+          case TypeKind::SMALLINT:
+            child =
+                makeKeys<int16_t>(type, size, nullRatio, nextKey, rng, pool_);
+            break;
+          case TypeKind::INTEGER:
+            child =
+                makeKeys<int32_t>(type, size, nullRatio, nextKey, rng, pool_);
+            break;
+          case TypeKind::BIGINT:
+            child =
+                makeKeys<int64_t>(type, size, nullRatio, nextKey, rng, pool_);
+            break;
+          default:
+            break;
+        }
+      }
+    }
+    vectorPool_.push_back(std::move(vector));
+  }
 }
 
 void FuzzerDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
@@ -60,10 +147,21 @@ std::optional<RowVectorPtr> FuzzerDataSource::next(
     return nullptr;
   }
 
-  const size_t outputRows = std::min(size, (splitEnd_ - splitOffset_));
+  size_t outputRows = std::min(size, (splitEnd_ - splitOffset_));
+  RowVectorPtr outputVector;
+  if (vectorPool_.empty()) {
+    outputVector = vectorFuzzer_->fuzzRow(outputType_, outputRows);
+  } else {
+    outputVector = vectorPool_[nextPoolIndex_];
+    nextPoolIndex_ = (nextPoolIndex_ + 1) % vectorPool_.size();
+    if (outputVector->size() > outputRows) {
+      outputVector = std::static_pointer_cast<RowVector>(
+          outputVector->slice(0, outputRows));
+    }
+    outputRows = outputVector->size();
+  }
   splitOffset_ += outputRows;
 
-  auto outputVector = vectorFuzzer_->fuzzRow(outputType_, outputRows);
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
   return outputVector;
@@ -31,15 +31,40 @@ namespace facebook::velox::connector::fuzzer {
 /// FuzzerConnectorSplit lets clients specify how many rows are expected to be
 /// generated.
 
+/// Options for a pool of vectors that FuzzerDataSource fuzzes once and then
+/// returns in turn, so that a batch costs no more than returning a pointer.
+/// This is for benchmarking operators end to end at the rate they process
+/// data. The vectors have VectorFuzzer::Options::vectorSize rows each and
+/// nulls by VectorFuzzer::Options::nullRatio.
+struct FuzzerVectorPoolOptions {
+  /// Number of vectors in the pool. 0 means that next() fuzzes each batch.
+  int32_t numVectors{0};
+
+  /// If true, all vectors in the pool are flat. Otherwise the encodings are
+  /// chosen randomly by VectorFuzzer.
+  bool flat{true};
+
+  /// If > 0, the top-level integer columns get values in [0, 'cardinality'),
+  /// e.g. for grouping or join keys with a known number of distinct values.
+  int64_t cardinality{0};
+
+  /// If > 1 and 'cardinality' is set, the values follow a Zeta distribution
+  /// with this exponent, so that smaller values are more frequent. Otherwise
+  /// they are uniform.
+  double skew{0};
+};
+
 class FuzzerTableHandle : public ConnectorTableHandle {
  public:
   explicit FuzzerTableHandle(
       std::string connectorId,
       VectorFuzzer::Options options,
-      size_t fuzzerSeed = 0)
+      size_t fuzzerSeed = 0,
+      FuzzerVectorPoolOptions vectorPoolOptions = {})
       : ConnectorTableHandle(std::move(connectorId)),
         fuzzerOptions(options),
-        fuzzerSeed(fuzzerSeed) {}
+        fuzzerSeed(fuzzerSeed),
+        vectorPoolOptions(vectorPoolOptions) {}
 
   ~FuzzerTableHandle() override {}
 
@@ -49,6 +74,7 @@ class FuzzerTableHandle : public ConnectorTableHandle {
 
   const VectorFuzzer::Options fuzzerOptions;
   size_t fuzzerSeed;
+  const FuzzerVectorPoolOptions vectorPoolOptions;
 };
 
 class FuzzerDataSource : public DataSource {
@@ -83,9 +109,22 @@ class FuzzerDataSource : public DataSource {
   }
 
  private:
+  // Fuzzes the vectors of 'vectorPool_'.
+  void makeVectorPool(
+      const VectorFuzzer::Options& fuzzerOptions,
+      size_t fuzzerSeed,
+      const FuzzerVectorPoolOptions& options);
+
   const RowTypePtr outputType_;
   std::unique_ptr<VectorFuzzer> vectorFuzzer_;
 
+  // The vectors returned in turn by next() if FuzzerVectorPoolOptions are
+  // set. Empty if each batch is fuzzed.
+  std::vector<RowVectorPtr> vectorPool_;
+
+  // The index in 'vectorPool_' of the next vector to return.
+  size_t nextPoolIndex_{0};
+
   // The current split being processed.
   std::shared_ptr<FuzzerConnectorSplit> currentSplit_;
 
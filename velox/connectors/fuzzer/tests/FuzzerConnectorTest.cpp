@@ -97,6 +97,43 @@ TEST_F(FuzzerConnectorTest, randomTypes) {
   }
 }
 
+TEST_F(FuzzerConnectorTest, vectorPool) {
+  const size_t rowsPerSplit = 1'000;
+  const size_t numSplits = 10;
+  auto type = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+
+  FuzzerVectorPoolOptions poolOptions;
+  poolOptions.numVectors = 3;
+  poolOptions.cardinality = 20;
+  poolOptions.skew = 2;
+  auto plan =
+      PlanBuilder()
+          .tableScan(type, makeFuzzerTableHandle(0, poolOptions), {})
+          .planNode();
+  auto result = exec::test::AssertQueryBuilder(plan)
+                    .splits(makeFuzzerSplits(rowsPerSplit, numSplits))
+                    .copyResults(pool());
+  ASSERT_EQ(result->size(), rowsPerSplit * numSplits);
+
+  // The output cycles through the 3 pooled vectors of 100 rows.
+  const auto poolRows = 3 * 100;
+  for (auto i = 0; i + poolRows < result->size(); ++i) {
+    ASSERT_TRUE(result->equalValueAt(result.get(), i, i + poolRows));
+  }
+
+  // Keys are in [0, 20) and skewed towards 0.
+  auto keys = result->childAt(0)->asFlatVector<int64_t>();
+  std::vector<int32_t> counts(poolOptions.cardinality);
+  for (auto i = 0; i < keys->size(); ++i) {
+    ASSERT_FALSE(keys->isNullAt(i));
+    const auto key = keys->valueAt(i);
+    ASSERT_GE(key, 0);
+    ASSERT_LT(key, poolOptions.cardinality);
+    ++counts[key];
+  }
+  ASSERT_GT(counts[0], counts[poolOptions.cardinality - 1]);
+}
+
 TEST_F(FuzzerConnectorTest, reproducible) {
   const size_t numRows = 100;
   auto type = ROW({BIGINT(), ARRAY(INTEGER()), VARCHAR()});
@@ -56,9 +56,10 @@ class FuzzerConnectorTestBase : public exec::test::OperatorTestBase {
   }
 
   std::shared_ptr<FuzzerTableHandle> makeFuzzerTableHandle(
-      size_t fuzzerSeed = 0) const {
+      size_t fuzzerSeed = 0,
+      FuzzerVectorPoolOptions vectorPoolOptions = {}) const {
     return std::make_shared<FuzzerTableHandle>(
-        kFuzzerConnectorId, fuzzerOptions_, fuzzerSeed);
+        kFuzzerConnectorId, fuzzerOptions_, fuzzerSeed, vectorPoolOptions);
   }
 
  private:
@@ -20,6 +20,7 @@
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
 
+#include <algorithm>
 #include <atomic>
 
 namespace facebook::velox {
@@ -31,20 +32,45 @@ std::string groupName(const std::string& filename) {
   return slash ? std::string(filename.data(), slash - filename.data())
                : filename;
 }
+
+FileHandleCacheStats sumStats(const std::vector<FileHandleCacheStats>& stats) {
+  size_t maxSize{0};
+  size_t curSize{0};
+  size_t numHits{0};
+  size_t numLookups{0};
+  for (const auto& shardStats : stats) {
+    maxSize += shardStats.maxSize;
+    curSize += shardStats.curSize;
+    numHits += shardStats.numHits;
+    numLookups += shardStats.numLookups;
+  }
+  return FileHandleCacheStats(maxSize, curSize, numHits, numLookups);
+}
 } // namespace
 
 std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
-    const std::string& filename) {
+    const std::string& filename,
+    const FileProperties* properties) {
   // We have seen cases where drivers are stuck when creating file handles.
   // Adding a trace here to spot this more easily in future.
   process::TraceContext trace("FileHandleGenerator::operator()");
+  checkFailedOpen(filename);
   uint64_t elapsedTimeUs{0};
   std::shared_ptr<FileHandle> fileHandle;
   {
     MicrosecondTimer timer(&elapsedTimeUs);
     fileHandle = std::make_shared<FileHandle>();
-    fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename);
+    filesystems::FileOptions options;
+    if (properties != nullptr) {
+      options.fileSize = properties->fileSize;
+    }
+    try {
+      fileHandle->file = filesystems::getFileSystem(filename, properties_)
+                             ->openFileForRead(filename, options);
+    } catch (const std::exception&) {
+      addFailedOpen(filename, std::current_exception());
+      throw;
+    }
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
@@ -58,4 +84,89 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
   return fileHandle;
 }
 
+void FileHandleGenerator::checkFailedOpen(const std::string& filename) {
+  if (negativeCacheTtlMs_ == 0) {
+    return;
+  }
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> l(failedOpensMutex_);
+    auto it = failedOpens_.find(filename);
+    if (it == failedOpens_.end()) {
+      return;
+    }
+    if (it->second.first <= getCurrentTimeMs()) {
+      failedOpens_.erase(it);
+      return;
+    }
+    error = it->second.second;
+  }
+  std::rethrow_exception(error);
+}
+
+void FileHandleGenerator::addFailedOpen(
+    const std::string& filename,
+    std::exception_ptr error) {
+  if (negativeCacheTtlMs_ == 0) {
+    return;
+  }
+  const uint64_t now = getCurrentTimeMs();
+  std::lock_guard<std::mutex> l(failedOpensMutex_);
+  // Failed opens are rare, so the expired ones are removed on each failure.
+  for (auto it = failedOpens_.begin(); it != failedOpens_.end();) {
+    if (it->second.first <= now) {
+      it = failedOpens_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  failedOpens_[filename] = {now + negativeCacheTtlMs_, std::move(error)};
+}
+
+FileHandleFactory::FileHandleFactory(
+    int32_t maxEntries,
+    std::shared_ptr<const Config> properties,
+    uint64_t negativeCacheTtlMs,
+    int32_t numShards) {
+  VELOX_CHECK_GT(numShards, 0);
+  // Each shard holds at least one entry.
+  numShards = std::max(1, std::min(numShards, maxEntries));
+  shards_.reserve(numShards);
+  for (auto i = 0; i < numShards; ++i) {
+    // The first shards get the remainder of the division.
+    const int32_t shardEntries =
+        maxEntries / numShards + (i < maxEntries % numShards ? 1 : 0);
+    shards_.push_back(std::make_unique<Shard>(
+        std::make_unique<
+            SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
+            shardEntries),
+        std::make_unique<FileHandleGenerator>(
+            properties, negativeCacheTtlMs)));
+  }
+}
+
+std::pair<bool, std::shared_ptr<FileHandle>> FileHandleFactory::generate(
+    const std::string& filename,
+    const FileProperties* properties) {
+  return shard(filename).generate(filename, properties);
+}
+
+FileHandleCacheStats FileHandleFactory::cacheStats() {
+  std::vector<FileHandleCacheStats> stats;
+  stats.reserve(shards_.size());
+  for (auto& shard : shards_) {
+    stats.push_back(shard->cacheStats());
+  }
+  return sumStats(stats);
+}
+
+FileHandleCacheStats FileHandleFactory::clearCache() {
+  std::vector<FileHandleCacheStats> stats;
+  stats.reserve(shards_.size());
+  for (auto& shard : shards_) {
+    stats.push_back(shard->clearCache());
+  }
+  return sumStats(stats);
+}
+
 } // namespace facebook::velox
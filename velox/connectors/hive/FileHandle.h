@@ -26,9 +26,14 @@
 #pragma once
 
 #include <cstdint>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 
+#include <folly/container/F14Map.h>
+
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/File.h"
@@ -61,23 +66,86 @@ struct FileHandle {
 
 using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
 
+// Metadata of a file known before opening it, e.g. from the split. Lets the
+// file system skip requests for the metadata, e.g. HEAD on S3.
+struct FileProperties {
+  std::optional<int64_t> fileSize;
+};
+
 // Creates FileHandles via the Generator interface the CachedFactory requires.
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const Config> properties)
-      : properties_(std::move(properties)) {}
-  std::shared_ptr<FileHandle> operator()(const std::string& filename);
+  FileHandleGenerator(
+      std::shared_ptr<const Config> properties,
+      uint64_t negativeCacheTtlMs = 0)
+      : properties_(std::move(properties)),
+        negativeCacheTtlMs_(negativeCacheTtlMs) {}
+
+  std::shared_ptr<FileHandle> operator()(
+      const std::string& filename,
+      const FileProperties* properties = nullptr);
 
  private:
+  // Rethrows the error of the last open of 'filename' if it failed less than
+  // 'negativeCacheTtlMs_' ago.
+  void checkFailedOpen(const std::string& filename);
+
+  void addFailedOpen(const std::string& filename, std::exception_ptr error);
+
   const std::shared_ptr<const Config> properties_;
-};
 
-using FileHandleFactory = CachedFactory<
-    std::string,
-    std::shared_ptr<FileHandle>,
-    FileHandleGenerator>;
+  // Time in ms for which a failed open is remembered, so that the splits of a
+  // missing file fail without a request to storage each. 0 means that failed
+  // opens are not remembered.
+  const uint64_t negativeCacheTtlMs_{0};
+
+  std::mutex failedOpensMutex_;
+  // The expiration time in ms and the error of the failed opens.
+  folly::F14FastMap<std::string, std::pair<uint64_t, std::exception_ptr>>
+      failedOpens_;
+};
 
 using FileHandleCacheStats = SimpleLRUCacheStats;
 
+// Caches FileHandles in shards that are CachedFactories with their own locks
+// and an equal part of the capacity, so that the drivers that open different
+// files do not wait for one lock.
+class FileHandleFactory {
+ public:
+  static constexpr int32_t kDefaultNumShards = 16;
+
+  // Makes a cache of up to 'maxEntries' FileHandles in 'numShards' shards.
+  // 'negativeCacheTtlMs' is the time for which a failed open is remembered.
+  FileHandleFactory(
+      int32_t maxEntries,
+      std::shared_ptr<const Config> properties,
+      uint64_t negativeCacheTtlMs = 0,
+      int32_t numShards = kDefaultNumShards);
+
+  // Returns the FileHandle of 'filename' and true if it was in the cache.
+  // Opens the file with 'properties' and caches its FileHandle if it was not.
+  std::pair<bool, std::shared_ptr<FileHandle>> generate(
+      const std::string& filename,
+      const FileProperties* properties = nullptr);
+
+  // Returns the stats summed over the shards.
+  FileHandleCacheStats cacheStats();
+
+  // Clears the cache and returns the stats summed over the shards.
+  FileHandleCacheStats clearCache();
+
+ private:
+  using Shard = CachedFactory<
+      std::string,
+      std::shared_ptr<FileHandle>,
+      FileHandleGenerator>;
+
+  Shard& shard(const std::string& filename) {
+    return *shards_[std::hash<std::string>()(filename) % shards_.size()];
+  }
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
 } // namespace facebook::velox
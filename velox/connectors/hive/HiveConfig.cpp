@@ -67,6 +67,18 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* config) {
   return config->get<uint32_t>(kMaxPartitionsPerWriters, 100);
 }
 
+// static
+uint32_t HiveConfig::maxOpenWriterFiles(const Config* config) {
+  return config->get<uint32_t>(kMaxOpenWriterFiles, 0);
+}
+
+// static
+uint64_t HiveConfig::maxTargetFileSize(const Config* config) {
+  return toCapacity(
+      config->get<std::string>(kMaxTargetFileSize, "0B"),
+      core::CapacityUnit::BYTE);
+}
+
 // static
 bool HiveConfig::immutablePartitions(const Config* config) {
   return config->get<bool>(kImmutablePartitions, false);
@@ -126,6 +138,46 @@ std::string HiveConfig::s3IAMRoleSessionName(const Config* config) {
   return config->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+// static
+int32_t HiveConfig::s3MaxConnections(const Config* config) {
+  return config->get<int32_t>(kS3MaxConnections, 64);
+}
+
+// static
+int32_t HiveConfig::s3IoThreads(const Config* config) {
+  return config->get<int32_t>(kS3IoThreads, 32);
+}
+
+// static
+uint64_t HiveConfig::s3ReadPartSize(const Config* config) {
+  return config->get<uint64_t>(kS3ReadPartSize, 8UL << 20);
+}
+
+// static
+int32_t HiveConfig::s3MaxParallelReads(const Config* config) {
+  return config->get<int32_t>(kS3MaxParallelReads, 8);
+}
+
+// static
+bool HiveConfig::s3HedgedReadsEnabled(const Config* config) {
+  return config->get<bool>(kS3HedgedReadsEnabled, false);
+}
+
+// static
+int32_t HiveConfig::s3HedgedReadsMinDelayMs(const Config* config) {
+  return config->get<int32_t>(kS3HedgedReadsMinDelayMs, 100);
+}
+
+// static
+int32_t HiveConfig::s3MaxParallelUploads(const Config* config) {
+  return config->get<int32_t>(kS3MaxParallelUploads, 4);
+}
+
+// static
+int32_t HiveConfig::s3UploadPartRetries(const Config* config) {
+  return config->get<int32_t>(kS3UploadPartRetries, 3);
+}
+
 // static
 std::string HiveConfig::gcsEndpoint(const Config* config) {
   return config->get<std::string>(kGCSEndpoint, std::string(""));
@@ -166,6 +218,16 @@ int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+uint64_t HiveConfig::fileHandleNegativeCacheTtlMs(const Config* config) {
+  return config->get<uint64_t>(kFileHandleNegativeCacheTtlMs, 0);
+}
+
+// static.
+int32_t HiveConfig::ioSchedulerMaxInFlight(const Config* config) {
+  return config->get<int32_t>(kIoSchedulerMaxInFlight, 0);
+}
+
 uint64_t HiveConfig::getOrcWriterMaxStripeSize(
     const Config* connectorQueryCtxConfig,
     const Config* connectorPropertiesConfig) {
@@ -209,4 +271,26 @@ uint64_t HiveConfig::getOrcWriterMaxDictionaryMemory(
   return 16L * 1024L * 1024L;
 }
 
+uint64_t HiveConfig::getSortWriterMaxBufferSize(
+    const Config* connectorQueryCtxConfig,
+    const Config* connectorPropertiesConfig) {
+  if (connectorQueryCtxConfig != nullptr &&
+      connectorQueryCtxConfig->isValueExists(kSortWriterMaxBufferSize)) {
+    return toCapacity(
+        connectorQueryCtxConfig->get<std::string>(kSortWriterMaxBufferSize)
+            .value(),
+        core::CapacityUnit::BYTE);
+  }
+  if (connectorPropertiesConfig != nullptr &&
+      connectorPropertiesConfig->isValueExists(
+          kSortWriterMaxBufferSizeConfig)) {
+    return toCapacity(
+        connectorPropertiesConfig
+            ->get<std::string>(kSortWriterMaxBufferSizeConfig)
+            .value(),
+        core::CapacityUnit::BYTE);
+  }
+  return 0;
+}
+
 } // namespace facebook::velox::connector::hive
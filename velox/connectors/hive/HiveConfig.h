@@ -44,6 +44,21 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWriters =
       "max_partitions_per_writers";
 
+  /// Maximum number of files a table writer keeps open at a time when writing
+  /// a partitioned, non-bucketed table. Past the limit, the file that was
+  /// written least recently is closed and later rows of its partition go to a
+  /// new file. Memory reclaim then also closes files instead of failing to
+  /// reclaim from writers that can't spill. Zero means no limit, in which case
+  /// files are closed only at the end of the write.
+  static constexpr const char* kMaxOpenWriterFiles = "max_open_writer_files";
+
+  /// Size of the written files past which a table writer closes the file and
+  /// writes the later rows of its partition to a new one, e.g. "512MB". Files
+  /// grow in steps of stripes, so they end a part of a stripe past the size.
+  /// Bucketed tables are not rolled since each bucket is a single file. Zero
+  /// means that files are not rolled.
+  static constexpr const char* kMaxTargetFileSize = "max_target_file_size";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -81,6 +96,39 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Maximum number of concurrent HTTP connections of the S3 client. Idle
+  /// connections are kept open for reuse.
+  static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
+
+  /// Number of threads that execute the S3 requests of parallel reads.
+  static constexpr const char* kS3IoThreads = "hive.s3.io-threads";
+
+  /// Reads larger than this are split into ranged GETs of this size that are
+  /// issued in parallel. 0 disables splitting.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// Maximum number of ranged GETs in flight for one read.
+  static constexpr const char* kS3MaxParallelReads =
+      "hive.s3.max-parallel-reads";
+
+  /// Reissues a ranged GET that has not completed within the 99th percentile
+  /// of recent GET latencies and uses whichever completes first.
+  static constexpr const char* kS3HedgedReadsEnabled =
+      "hive.s3.hedged-reads.enabled";
+
+  /// Minimum time in milliseconds before a ranged GET is reissued.
+  static constexpr const char* kS3HedgedReadsMinDelayMs =
+      "hive.s3.hedged-reads.min-delay-ms";
+
+  /// Maximum number of multipart upload parts in flight for one written file.
+  /// Each part buffers 10MB of the writer's memory pool.
+  static constexpr const char* kS3MaxParallelUploads =
+      "hive.s3.max-parallel-uploads";
+
+  /// Number of times a failed multipart upload part is reissued.
+  static constexpr const char* kS3UploadPartRetries =
+      "hive.s3.upload-part-retries";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -107,6 +155,18 @@ class HiveConfig {
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Time in ms for which a failed file open is remembered, so that the other
+  /// splits of a missing file fail without a request to storage. 0 disables
+  /// the caching of failed opens.
+  static constexpr const char* kFileHandleNegativeCacheTtlMs =
+      "file-handle-negative-cache-ttl-ms";
+
+  /// Maximum number of read-ahead tasks running on the connector's executor
+  /// at a time. The tasks of concurrent queries get a fair share of these.
+  /// 0 runs read-ahead directly on the executor without scheduling.
+  static constexpr const char* kIoSchedulerMaxInFlight =
+      "io-scheduler-max-in-flight";
+
   // TODO: Refactor and merge config and session property.
   static constexpr const char* kOrcWriterMaxStripeSize =
       "orc_optimized_writer_max_stripe_size";
@@ -118,11 +178,24 @@ class HiveConfig {
   static constexpr const char* kOrcWriterMaxDictionaryMemoryConfig =
       "hive.orc.writer.dictionary-max-memory";
 
+  /// Maximum bytes a sorted bucket writer buffers in memory before it spills
+  /// a sorted run to disk. The limit applies to each bucket writer separately
+  /// and only if spilling is enabled. Zero means no limit, in which case
+  /// sorted writers only spill when memory arbitration reclaims from them.
+  static constexpr const char* kSortWriterMaxBufferSize =
+      "sort_writer_max_buffer_size";
+  static constexpr const char* kSortWriterMaxBufferSizeConfig =
+      "hive.sort-writer.max-buffer-size";
+
   static InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* config);
 
   static uint32_t maxPartitionsPerWriters(const Config* config);
 
+  static uint32_t maxOpenWriterFiles(const Config* config);
+
+  static uint64_t maxTargetFileSize(const Config* config);
+
   static bool immutablePartitions(const Config* config);
 
   static bool s3UseVirtualAddressing(const Config* config);
@@ -143,6 +216,22 @@ class HiveConfig {
 
   static std::string s3IAMRoleSessionName(const Config* config);
 
+  static int32_t s3MaxConnections(const Config* config);
+
+  static int32_t s3IoThreads(const Config* config);
+
+  static uint64_t s3ReadPartSize(const Config* config);
+
+  static int32_t s3MaxParallelReads(const Config* config);
+
+  static bool s3HedgedReadsEnabled(const Config* config);
+
+  static int32_t s3HedgedReadsMinDelayMs(const Config* config);
+
+  static int32_t s3MaxParallelUploads(const Config* config);
+
+  static int32_t s3UploadPartRetries(const Config* config);
+
   static std::string gcsEndpoint(const Config* config);
 
   static std::string gcsScheme(const Config* config);
@@ -159,6 +248,10 @@ class HiveConfig {
 
   static int32_t numCacheFileHandles(const Config* config);
 
+  static uint64_t fileHandleNegativeCacheTtlMs(const Config* config);
+
+  static int32_t ioSchedulerMaxInFlight(const Config* config);
+
   static uint64_t fileWriterFlushThresholdBytes(const Config* config);
 
   static uint64_t getOrcWriterMaxStripeSize(
@@ -168,6 +261,10 @@ class HiveConfig {
   static uint64_t getOrcWriterMaxDictionaryMemory(
       const Config* connectorQueryCtxConfig,
       const Config* connectorPropertiesConfig);
+
+  static uint64_t getSortWriterMaxBufferSize(
+      const Config* connectorQueryCtxConfig,
+      const Config* connectorPropertiesConfig);
 };
 
 } // namespace facebook::velox::connector::hive
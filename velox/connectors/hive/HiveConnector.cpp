@@ -58,11 +58,18 @@ HiveConnector::HiveConnector(
     folly::Executor* FOLLY_NULLABLE executor)
     : Connector(id, properties),
       fileHandleFactory_(
-          std::make_unique<
-              SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
-              numCachedFileHandles(properties.get())),
-          std::make_unique<FileHandleGenerator>(properties)),
+          numCachedFileHandles(properties.get()),
+          properties,
+          properties
+              ? HiveConfig::fileHandleNegativeCacheTtlMs(properties.get())
+              : 0),
       executor_(executor) {
+  const auto maxInFlight =
+      properties ? HiveConfig::ioSchedulerMaxInFlight(properties.get()) : 0;
+  if (executor_ != nullptr && maxInFlight > 0) {
+    ioScheduler_ = std::make_unique<io::IoScheduler>(
+        executor_, io::IoScheduler::Options{.maxInFlight = maxInFlight});
+  }
   LOG(INFO) << "Hive connector " << connectorId() << " created with maximum of "
             << numCachedFileHandles(properties.get())
             << " cached file handles.";
@@ -95,7 +102,9 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       connectorQueryCtx->cache(),
       connectorQueryCtx->scanId(),
       executor_,
-      options);
+      options,
+      ioScheduler_.get(),
+      connectorQueryCtx->queryId());
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
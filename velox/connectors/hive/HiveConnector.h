@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/io/IoScheduler.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/core/PlanNode.h"
@@ -72,6 +73,9 @@ class HiveConnector : public Connector {
  protected:
   FileHandleFactory fileHandleFactory_;
   folly::Executor* FOLLY_NULLABLE executor_;
+  // Schedules the read-ahead of concurrent queries on 'executor_'. Set if
+  // HiveConfig::kIoSchedulerMaxInFlight is non-0.
+  std::unique_ptr<io::IoScheduler> ioScheduler_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
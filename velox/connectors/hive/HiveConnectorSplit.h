@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Conv.h>
+#include <map>
 #include <optional>
 #include <unordered_map>
 #include "velox/connectors/Connector.h"
@@ -23,6 +25,14 @@
 namespace facebook::velox::connector::hive {
 
 struct HiveConnectorSplit : public connector::ConnectorSplit {
+  /// Key in 'customSplitInfo' of the modification time of the file. The cache
+  /// key of a split without it is empty.
+  static constexpr const char* kFileModifiedTime = "$file_modified_time";
+
+  /// Key in 'customSplitInfo' of the size of the file in bytes. Opening the
+  /// file then needs no request for its size, e.g. HEAD on S3.
+  static constexpr const char* kFileSize = "$file_size";
+
   const std::string filePath;
   dwio::common::FileFormat fileFormat;
   const uint64_t start;
@@ -69,6 +79,62 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  /// Divides the byte range of 'this' into ranges of 'targetBytes'. The
+  /// readers read the stripes or row groups that start in the range of a
+  /// split, so each of them is read by exactly one of the divided splits. A
+  /// split with no known length is not divided.
+  std::vector<std::shared_ptr<ConnectorSplit>> divide(
+      uint64_t targetBytes) const override {
+    std::vector<std::shared_ptr<ConnectorSplit>> splits;
+    if (targetBytes == 0 ||
+        length == std::numeric_limits<uint64_t>::max() ||
+        length <= 2 * targetBytes) {
+      return splits;
+    }
+    const auto end = start + length;
+    for (auto offset = start; offset < end; offset += targetBytes) {
+      splits.push_back(std::make_shared<HiveConnectorSplit>(
+          connectorId,
+          filePath,
+          fileFormat,
+          offset,
+          std::min(targetBytes, end - offset),
+          partitionKeys,
+          tableBucketNumber,
+          customSplitInfo,
+          extraFileInfo,
+          serdeParameters));
+    }
+    return splits;
+  }
+
+  std::optional<int32_t> bucketNumber() const override {
+    return tableBucketNumber;
+  }
+
+  std::string cacheKey() const override {
+    auto it = customSplitInfo.find(kFileModifiedTime);
+    if (it == customSplitInfo.end()) {
+      return "";
+    }
+    std::map<std::string, std::optional<std::string>> sortedKeys(
+        partitionKeys.begin(), partitionKeys.end());
+    std::string key = fmt::format("{} {}", toString(), it->second);
+    for (const auto& [name, value] : sortedKeys) {
+      key += fmt::format(" {}={}", name, value.value_or("<null>"));
+    }
+    return key;
+  }
+
+  /// Returns the size of the file from 'customSplitInfo', if there.
+  std::optional<int64_t> fileSize() const {
+    auto it = customSplitInfo.find(kFileSize);
+    if (it == customSplitInfo.end()) {
+      return std::nullopt;
+    }
+    return folly::to<int64_t>(it->second);
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
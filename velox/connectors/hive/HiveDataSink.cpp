@@ -298,6 +298,10 @@ HiveDataSink::HiveDataSink(
       connectorProperties_(connectorProperties),
       maxOpenWriters_(
           HiveConfig::maxPartitionsPerWriters(connectorQueryCtx_->config())),
+      maxOpenFiles_(
+          HiveConfig::maxOpenWriterFiles(connectorQueryCtx_->config())),
+      maxTargetFileSize_(
+          HiveConfig::maxTargetFileSize(connectorQueryCtx_->config())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty() ? std::make_unique<PartitionIdGenerator>(
@@ -395,6 +399,8 @@ void HiveDataSink::appendData(RowVectorPtr input) {
         ? input
         : exec::wrap(partitionSize, partitionRows_[index], input);
     write(index, writerInput);
+    // The writer may be closed once it has no rows of 'input' pending.
+    partitionSizes_[index] = 0;
   }
 }
 
@@ -402,6 +408,16 @@ void HiveDataSink::write(size_t index, const VectorPtr& input) {
   WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
   writers_[index]->write(input);
   writerInfo_[index]->numWrittenRows += input->size();
+  writerLastWrites_[index] = ++numWrites_;
+  maybeRollFile(index);
+}
+
+void HiveDataSink::maybeRollFile(uint32_t index) {
+  if (maxTargetFileSize_ == 0 || !canCloseWriters() ||
+      ioStats_[index]->rawBytesWritten() < maxTargetFileSize_) {
+    return;
+  }
+  closeWriter(index);
 }
 
 void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
@@ -502,21 +518,75 @@ void HiveDataSink::closeInternal(bool abort) {
   if (!abort) {
     closed_ = true;
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->close();
     }
   } else {
     aborted_ = true;
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i] == nullptr) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
   }
 }
 
+void HiveDataSink::closeWriter(uint32_t index) {
+  VELOX_CHECK(canCloseWriters());
+  VELOX_CHECK_NOT_NULL(writers_[index]);
+  {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(index);
+    writers_[index]->close();
+    writers_[index].reset();
+  }
+  --numOpenWriters_;
+}
+
+void HiveDataSink::closeLeastRecentlyUsedWriter() {
+  std::optional<uint32_t> leastRecentlyUsed;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writers_[i] != nullptr && partitionSizes_[i] == 0 &&
+        (!leastRecentlyUsed.has_value() ||
+         writerLastWrites_[i] < writerLastWrites_[*leastRecentlyUsed])) {
+      leastRecentlyUsed = i;
+    }
+  }
+  // All the open writers have rows of the current input. The limit is
+  // exceeded until the input is written.
+  if (leastRecentlyUsed.has_value()) {
+    closeWriter(*leastRecentlyUsed);
+  }
+}
+
+uint64_t HiveDataSink::closeWriterForReclaim(HiveWriterInfo* writerInfo) {
+  if (!canCloseWriters() || closedOrAborted()) {
+    return 0;
+  }
+  for (uint32_t i = 0; i < writerInfo_.size(); ++i) {
+    if (writerInfo_[i].get() != writerInfo) {
+      continue;
+    }
+    if (writers_[i] == nullptr || partitionSizes_[i] != 0) {
+      return 0;
+    }
+    const auto bytesBeforeClose = writerInfo->writerPool->currentBytes();
+    closeWriter(i);
+    const auto bytesAfterClose = writerInfo->writerPool->currentBytes();
+    return bytesBeforeClose > bytesAfterClose
+        ? bytesBeforeClose - bytesAfterClose
+        : 0;
+  }
+  return 0;
+}
+
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
-  if (it != writerIndexMap_.end()) {
+  if (it != writerIndexMap_.end() && writers_[it->second] != nullptr) {
     return it->second;
   }
   return appendWriter(id);
@@ -525,9 +595,12 @@ uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
 uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   // Check max open writers.
   VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+      writerIndexMap_.size(), maxOpenWriters_, "Exceeded open writer limit");
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
-  VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
+  if (maxOpenFiles_ > 0 && canCloseWriters() &&
+      numOpenWriters_ >= maxOpenFiles_) {
+    closeLeastRecentlyUsedWriter();
+  }
 
   std::optional<std::string> partitionName;
   if (isPartitioned()) {
@@ -582,12 +655,14 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
       options);
   writer = maybeCreateBucketSortWriter(std::move(writer));
   writers_.emplace_back(std::move(writer));
+  writerLastWrites_.emplace_back(numWrites_);
+  ++numOpenWriters_;
   // Extends the buffer used for partition rows calculations.
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
   rawPartitionRows_.emplace_back(nullptr);
 
-  writerIndexMap_.emplace(id, writers_.size() - 1);
+  writerIndexMap_[id] = writers_.size() - 1;
   return writerIndexMap_[id];
 }
 
@@ -608,7 +683,9 @@ HiveDataSink::maybeCreateBucketSortWriter(
       sortPool,
       writerInfo_.back()->nonReclaimableSectionHolder.get(),
       &numSpillRuns_,
-      spillConfig_);
+      spillConfig_,
+      HiveConfig::getSortWriterMaxBufferSize(
+          connectorQueryCtx_->config(), connectorProperties_.get()));
   return std::make_unique<dwio::common::SortingWriter>(
       std::move(writer), std::move(sortBuffer));
 }
@@ -818,7 +895,7 @@ bool HiveDataSink::WriterReclaimer::reclaimableBytes(
     uint64_t& reclaimableBytes) const {
   VELOX_CHECK_EQ(pool.name(), writerInfo_->writerPool->name());
   reclaimableBytes = 0;
-  if (!dataSink_->canReclaim()) {
+  if (!dataSink_->canReclaim() && !dataSink_->canCloseWriters()) {
     return false;
   }
   return exec::MemoryReclaimer::reclaimableBytes(pool, reclaimableBytes);
@@ -829,7 +906,7 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
     uint64_t targetBytes,
     memory::MemoryReclaimer::Stats& stats) {
   VELOX_CHECK_EQ(pool->name(), writerInfo_->writerPool->name());
-  if (!dataSink_->canReclaim()) {
+  if (!dataSink_->canReclaim() && !dataSink_->canCloseWriters()) {
     return 0;
   }
 
@@ -843,6 +920,11 @@ uint64_t HiveDataSink::WriterReclaimer::reclaim(
     return 0;
   }
 
+  if (!dataSink_->canReclaim()) {
+    // Writers that can't spill free their memory by closing their file.
+    return dataSink_->closeWriterForReclaim(writerInfo_);
+  }
+
   const uint64_t memoryUsageBeforeReclaim = pool->currentBytes();
   const std::string memoryUsageTreeBeforeReclaim = pool->treeMemoryUsage();
   const auto reclaimedBytes =
@@ -475,6 +475,30 @@ class HiveDataSink : public DataSink {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
 
+  // Returns true if open writers may be closed before the end of the write,
+  // with later rows of their partition going to a new file. Bucketed writers
+  // are never closed early because each bucket is written to a single file.
+  FOLLY_ALWAYS_INLINE bool canCloseWriters() const {
+    return !isBucketed() &&
+        ((maxOpenFiles_ > 0 && isPartitioned()) || maxTargetFileSize_ > 0);
+  }
+
+  // Closes the writer at 'index' if its file has reached
+  // 'maxTargetFileSize_', so that the next rows of its partition go to a new
+  // file.
+  void maybeRollFile(uint32_t index);
+
+  // Closes the file of the writer at 'index' in 'writers_'.
+  void closeWriter(uint32_t index);
+
+  // Closes the least recently written open writer that has no rows of the
+  // current input pending.
+  void closeLeastRecentlyUsedWriter();
+
+  // Closes the writer of 'writerInfo' to free its memory unless it has rows of
+  // the current input pending. Returns the number of bytes freed.
+  uint64_t closeWriterForReclaim(HiveWriterInfo* writerInfo);
+
   std::shared_ptr<memory::MemoryPool> createWriterPool(
       const HiveWriterId& writerId);
 
@@ -541,6 +565,8 @@ class HiveDataSink : public DataSink {
   const CommitStrategy commitStrategy_;
   const std::shared_ptr<const Config> connectorProperties_;
   const uint32_t maxOpenWriters_;
+  const uint32_t maxOpenFiles_;
+  const uint64_t maxTargetFileSize_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   const int32_t bucketCount_{0};
@@ -558,13 +584,21 @@ class HiveDataSink : public DataSink {
   tsan_atomic<bool> nonReclaimableSection_{false};
 
   // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
+  // After a writer is closed by closeWriter(), a new writer for the same id
+  // replaces it in the map.
   folly::F14FastMap<HiveWriterId, uint32_t, HiveWriterIdHasher, HiveWriterIdEq>
       writerIndexMap_;
 
-  // Below are structures for partitions from all inputs. writerInfo_ and
-  // writers_ are both indexed by partitionId.
+  // Below are structures for the files of all inputs. writerInfo_ and
+  // writers_ are both indexed by the writer index.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
+  // nullptr for the writers closed by closeWriter().
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
+  // The value of 'numWrites_' at the last write to each writer. Used for
+  // picking the writer to close if canCloseWriters().
+  std::vector<uint64_t> writerLastWrites_;
+  uint64_t numWrites_{0};
+  uint32_t numOpenWriters_{0};
   // IO statistics collected for each writer.
   std::vector<std::shared_ptr<io::IoStatistics>> ioStats_;
 
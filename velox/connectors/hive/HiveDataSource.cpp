@@ -291,6 +291,20 @@ void checkColumnNameLowerCase(const core::TypedExprPtr& typeExpr) {
   }
 }
 
+// Returns true if 'expr' may reference a column. Lambda arguments count as
+// columns.
+bool referencesColumns(const core::TypedExprPtr& expr) {
+  if (dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get()) ||
+      dynamic_cast<const core::InputTypedExpr*>(expr.get())) {
+    return true;
+  }
+  if (auto* lambda = dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return referencesColumns(lambda->body());
+  }
+  return std::any_of(
+      expr->inputs().begin(), expr->inputs().end(), referencesColumns);
+}
+
 const std::string& getColumnName(const common::Subfield& subfield) {
   VELOX_CHECK_GT(subfield.path().size(), 0);
   auto* field = dynamic_cast<const common::Subfield::NestedField*>(
@@ -351,6 +365,39 @@ core::TypedExprPtr HiveDataSource::extractFiltersFromRemainingFilter(
   return expr;
 }
 
+core::TypedExprPtr HiveDataSource::extractColumnFreeConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& columnFree) {
+  if (!expr) {
+    return nullptr;
+  }
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call && call->name() == "and") {
+    const auto numColumnFree = columnFree.size();
+    std::vector<core::TypedExprPtr> remaining;
+    for (auto& input : call->inputs()) {
+      if (auto rest = extractColumnFreeConjuncts(input, columnFree)) {
+        remaining.push_back(std::move(rest));
+      }
+    }
+    if (remaining.empty()) {
+      return nullptr;
+    }
+    if (columnFree.size() == numColumnFree) {
+      return expr;
+    }
+    if (remaining.size() == 1) {
+      return remaining[0];
+    }
+    return replaceInputs(call, std::move(remaining));
+  }
+  if (!referencesColumns(expr)) {
+    columnFree.push_back(expr);
+    return nullptr;
+  }
+  return expr;
+}
+
 HiveDataSource::HiveDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<connector::ConnectorTableHandle>& tableHandle,
@@ -362,7 +409,9 @@ HiveDataSource::HiveDataSource(
     cache::AsyncDataCache* cache,
     const std::string& scanId,
     folly::Executor* executor,
-    const dwio::common::ReaderOptions& options)
+    const dwio::common::ReaderOptions& options,
+    io::IoScheduler* ioScheduler,
+    const std::string& queryId)
     : fileHandleFactory_(fileHandleFactory),
       readerOpts_(options),
       pool_(&options.getMemoryPool()),
@@ -425,6 +474,22 @@ HiveDataSource::HiveDataSource(
       expressionEvaluator_,
       false,
       filters);
+  if (auto it = filters.find(common::Subfield(kBucket)); it != filters.end()) {
+    bucketFilter_ = it->second->clone();
+  }
+  // Conjuncts that reference no column, e.g. rand() < 0.1, are evaluated
+  // before reading so that no column is decoded for the rows they drop.
+  fullRemainingFilter_ = remainingFilter;
+  std::vector<core::TypedExprPtr> columnFreeConjuncts;
+  remainingFilter =
+      extractColumnFreeConjuncts(remainingFilter, columnFreeConjuncts);
+  if (!columnFreeConjuncts.empty()) {
+    columnFreeFilterExprSet_ = expressionEvaluator_->compile(
+        columnFreeConjuncts.size() == 1
+            ? columnFreeConjuncts[0]
+            : std::make_shared<core::CallTypedExpr>(
+                  BOOLEAN(), std::move(columnFreeConjuncts), "and"));
+  }
 
   std::vector<common::Subfield> remainingFilterSubfields;
   if (remainingFilter) {
@@ -476,6 +541,11 @@ HiveDataSource::HiveDataSource(
 
   readerOpts_.setFileSchema(hiveTableHandle_->dataColumns());
   ioStats_ = std::make_shared<io::IoStatistics>();
+  if (ioScheduler != nullptr) {
+    ioExecutor_ = ioScheduler->executor(
+        queryId, io::IoScheduler::Priority::kPrefetch, ioStats_);
+    executor_ = ioExecutor_.get();
+  }
 }
 
 inline uint8_t parseDelimiter(const std::string& delim) {
@@ -552,13 +622,18 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     readerOpts_.setFileFormat(split_->fileFormat);
   }
 
-  auto fileHandle = fileHandleFactory_->generate(split_->filePath).second;
-  auto input = createBufferedInput(*fileHandle, readerOpts_);
-
   if (splitReader_) {
     splitReader_.reset();
   }
   splitReader_ = createSplitReader();
+  if (splitReader_->skipByPartitionKeys(bucketFilter_.get(), runtimeStats_)) {
+    return;
+  }
+
+  FileProperties fileProperties{split_->fileSize()};
+  auto fileHandle =
+      fileHandleFactory_->generate(split_->filePath, &fileProperties).second;
+  auto input = createBufferedInput(*fileHandle, readerOpts_);
   splitReader_->prepareSplit(
       hiveTableHandle_,
       readerOpts_,
@@ -581,11 +656,12 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
 
-  // TODO Check if remaining filter has a conjunct that doesn't depend on
-  // any column, e.g. rand() < 0.1. Evaluate that conjunct first, then scan
-  // only rows that passed.
-
-  auto rowsScanned = splitReader_->next(size, output_);
+  dwio::common::Mutation mutation;
+  if (columnFreeFilterExprSet_) {
+    mutation.deletedRows = evaluateColumnFreeFilter(size);
+  }
+  auto rowsScanned = splitReader_->next(
+      size, output_, mutation.deletedRows ? &mutation : nullptr);
   completedRows_ += rowsScanned;
 
   if (rowsScanned) {
@@ -672,9 +748,17 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"numRamRead", RuntimeCounter(ioStats_->ramHit().count())},
        {"ramReadBytes",
         RuntimeCounter(ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes)},
+       {"numSharedLoad", RuntimeCounter(ioStats_->sharedLoad().count())},
+       {"sharedLoadBytes",
+        RuntimeCounter(
+            ioStats_->sharedLoad().sum(), RuntimeCounter::Unit::kBytes)},
        {"totalScanTime",
         RuntimeCounter(
             ioStats_->totalScanTime(), RuntimeCounter::Unit::kNanos)},
+       {"ioSchedulerWaitNanos",
+        RuntimeCounter(
+            ioStats_->ioSchedulerWait().sum() * 1000,
+            RuntimeCounter::Unit::kNanos)},
        {"ioWaitNanos",
         RuntimeCounter(
             ioStats_->queryThreadIoLatency().sum() * 1000,
@@ -703,6 +787,11 @@ void HiveDataSource::setFromDataSource(
   // balance to that.
   source->ioStats_->merge(*ioStats_);
   ioStats_ = std::move(source->ioStats_);
+  // The buffered inputs of 'source' queue their read-ahead on its executor.
+  if (source->ioExecutor_ != nullptr) {
+    ioExecutor_ = std::move(source->ioExecutor_);
+    executor_ = ioExecutor_.get();
+  }
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
@@ -824,6 +913,32 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
       filterResult_, filterRows_, filterEvalCtx_, pool_);
 }
 
+const uint64_t* HiveDataSource::evaluateColumnFreeFilter(vector_size_t size) {
+  auto input = std::make_shared<RowVector>(
+      pool_, ROW({}, {}), nullptr, size, std::vector<VectorPtr>{});
+  SelectivityVector rows(size);
+  VectorPtr result;
+  try {
+    expressionEvaluator_->evaluate(
+        columnFreeFilterExprSet_.get(), rows, *input, result);
+  } catch (const VeloxException&) {
+    // The error is not raised for rows where the other conjuncts are false.
+    // Evaluate the whole filter after reading from here on.
+    columnFreeFilterExprSet_.reset();
+    remainingFilterExprSet_ =
+        expressionEvaluator_->compile(fullRemainingFilter_);
+    return nullptr;
+  }
+  DecodedVector decoded(*result, rows);
+  deletedRows_.assign(bits::nwords(size), 0);
+  for (vector_size_t i = 0; i < size; ++i) {
+    if (decoded.isNullAt(i) || !decoded.valueAt<bool>(i)) {
+      bits::setBit(deletedRows_.data(), i);
+    }
+  }
+  return deletedRows_.data();
+}
+
 void HiveDataSource::resetSplit() {
   split_.reset();
   splitReader_->resetSplit();
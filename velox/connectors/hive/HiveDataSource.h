@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/io/IoScheduler.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
@@ -42,7 +43,9 @@ class HiveDataSource : public DataSource {
       cache::AsyncDataCache* cache,
       const std::string& scanId,
       folly::Executor* executor,
-      const dwio::common::ReaderOptions& options);
+      const dwio::common::ReaderOptions& options,
+      io::IoScheduler* ioScheduler = nullptr,
+      const std::string& queryId = "");
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -92,6 +95,13 @@ class HiveDataSource : public DataSource {
       bool negated,
       SubfieldFilters& filters);
 
+  // Internal API, made public to be accessible in unit tests. Moves the top
+  // level conjuncts of 'expr' that reference no column into 'columnFree'.
+  // Returns the remaining conjuncts or nullptr if none.
+  static core::TypedExprPtr extractColumnFreeConjuncts(
+      const core::TypedExprPtr& expr,
+      std::vector<core::TypedExprPtr>& columnFree);
+
  protected:
   virtual std::unique_ptr<SplitReader> createSplitReader();
 
@@ -124,6 +134,12 @@ class HiveDataSource : public DataSource {
   // filterEvalCtx_.selectedIndices and selectedBits are not updated.
   vector_size_t evaluateRemainingFilter(RowVectorPtr& rowVector);
 
+  // Evaluates 'columnFreeFilterExprSet_' on the next 'size' rows before they
+  // are read. Returns a bit mask of the rows that do not pass, or nullptr if
+  // the evaluation failed, in which case the whole remaining filter is
+  // evaluated after reading from then on.
+  const uint64_t* evaluateColumnFreeFilter(vector_size_t size);
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -144,7 +160,17 @@ class HiveDataSource : public DataSource {
   const RowTypePtr outputType_;
   std::shared_ptr<io::IoStatistics> ioStats_;
   std::shared_ptr<common::MetadataFilter> metadataFilter_;
+  // The filter on the $bucket column. Skips the splits of the buckets that
+  // fail it, e.g. the buckets not chosen by the planner for the values of an
+  // IN list on the bucket keys.
+  std::unique_ptr<common::Filter> bucketFilter_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
+  // The conjuncts of the remaining filter that reference no column.
+  std::unique_ptr<exec::ExprSet> columnFreeFilterExprSet_;
+  // The remaining filter before the column free conjuncts were taken out.
+  core::TypedExprPtr fullRemainingFilter_;
+  // Rows dropped by 'columnFreeFilterExprSet_' in the current batch.
+  std::vector<uint64_t> deletedRows_;
   RowVectorPtr emptyOutput_;
   dwio::common::RuntimeStatistics runtimeStats_;
   core::ExpressionEvaluator* expressionEvaluator_;
@@ -158,6 +184,9 @@ class HiveDataSource : public DataSource {
   cache::AsyncDataCache* const cache_{nullptr};
   const std::string& scanId_;
   folly::Executor* executor_;
+  // Queues the read-ahead of 'this' on an IoScheduler. 'executor_' points to
+  // it if set.
+  std::unique_ptr<folly::Executor> ioExecutor_;
 };
 
 } // namespace facebook::velox::connector::hive
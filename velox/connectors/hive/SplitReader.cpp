@@ -69,10 +69,13 @@ bool testFilters(
         // If missing column is partition key.
         auto iter = partitionKey.find(name);
         if (iter != partitionKey.end() && iter->second.has_value()) {
-          return applyPartitionFilter(
-              partitionKeysHandle[name]->dataType()->kind(),
-              iter->second.value(),
-              child->filter());
+          if (!applyPartitionFilter(
+                  partitionKeysHandle[name]->dataType()->kind(),
+                  iter->second.value(),
+                  child->filter())) {
+            return false;
+          }
+          continue;
         }
         // Column is missing. Most likely due to schema evolution.
         if (child->filter()->isDeterministic() &&
@@ -100,6 +103,39 @@ bool testFilters(
   return true;
 }
 
+// Returns false if the filters on the partition keys of a split rule out all
+// its rows. Unlike testFilters(), needs no reader, so that a split of a pruned
+// partition is skipped without opening its file.
+bool testPartitionFilters(
+    common::ScanSpec* scanSpec,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    const auto& name = child->fieldName();
+    auto iter = partitionKey.find(name);
+    if (iter == partitionKey.end() || partitionKeysHandle.count(name) == 0) {
+      continue;
+    }
+    if (iter->second.has_value()) {
+      if (!applyPartitionFilter(
+              partitionKeysHandle[name]->dataType()->kind(),
+              iter->second.value(),
+              child->filter())) {
+        return false;
+      }
+    } else if (
+        child->filter()->isDeterministic() && !child->filter()->testNull()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <TypeKind ToKind>
 velox::variant convertFromString(const std::optional<std::string>& value) {
   if (value.has_value()) {
@@ -143,6 +179,25 @@ SplitReader::SplitReader(
       scanSpec_(std::move(scanSpec)),
       pool_(pool) {}
 
+bool SplitReader::skipByPartitionKeys(
+    const common::Filter* bucketFilter,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  const bool bucketPasses = bucketFilter == nullptr ||
+      !hiveSplit_->tableBucketNumber.has_value() ||
+      bucketFilter->testInt64(hiveSplit_->tableBucketNumber.value());
+  if (bucketPasses &&
+      testPartitionFilters(
+          scanSpec_.get(), hiveSplit_->partitionKeys, partitionKeys_)) {
+    return false;
+  }
+  VLOG(1) << "Skipping " << hiveSplit_->filePath
+          << " based on partition keys, bucket and filters";
+  emptySplit_ = true;
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  return true;
+}
+
 void SplitReader::prepareSplit(
     const std::shared_ptr<HiveTableHandle>& hiveTableHandle,
     const dwio::common::ReaderOptions& readerOptions,
@@ -242,8 +297,11 @@ std::vector<TypePtr> SplitReader::adaptColumns(
   return columnTypes;
 }
 
-uint64_t SplitReader::next(int64_t size, VectorPtr& output) {
-  return baseRowReader_->next(size, output);
+uint64_t SplitReader::next(
+    int64_t size,
+    VectorPtr& output,
+    const dwio::common::Mutation* mutation) {
+  return baseRowReader_->next(size, output, mutation);
 }
 
 void SplitReader::resetFilterCaches() {
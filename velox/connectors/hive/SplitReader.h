@@ -52,6 +52,14 @@ class SplitReader {
 
   virtual ~SplitReader() = default;
 
+  /// Returns true and marks the split as empty if the filters on the partition
+  /// keys or 'bucketFilter' on the $bucket column rule out all rows of the
+  /// split. Called before prepareSplit(), so that the file of a skipped split
+  /// is not opened.
+  bool skipByPartitionKeys(
+      const common::Filter* bucketFilter,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
   /// This function is used by different table formats like Iceberg and Hudi to
   /// do additional preparations before reading the split, e.g. Open delete
   /// files or log files, and add column adapatations for metadata columns
@@ -62,7 +70,10 @@ class SplitReader {
       std::shared_ptr<common::MetadataFilter> metadataFilter,
       dwio::common::RuntimeStatistics& runtimeStats);
 
-  virtual uint64_t next(int64_t size, VectorPtr& output);
+  virtual uint64_t next(
+      int64_t size,
+      VectorPtr& output,
+      const dwio::common::Mutation* mutation = nullptr);
 
   void resetFilterCaches();
 
@@ -19,19 +19,24 @@
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
+#include <aws/core/http/HttpRequest.h>
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
@@ -69,21 +74,126 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Tuning of S3ReadFile. See the corresponding HiveConfig properties.
+struct S3ReadOptions {
+  // Reads larger than this are split into parallel ranged GETs. 0 means no
+  // splitting.
+  uint64_t partSize{0};
+  // Maximum number of ranged GETs in flight for one read.
+  int32_t maxParallelReads{1};
+  bool hedgedReads{false};
+  // Minimum time before a ranged GET is reissued.
+  uint64_t minHedgeDelayUs{0};
+};
+
+// The state of one ranged GET, issued once and possibly reissued as a hedge
+// if the first attempt is slow. The first attempt writes into 'buffer' and
+// the hedge into 'hedgeBuffer'. Shared with the SDK callbacks, which may
+// complete after the read has returned.
+struct RangeRead {
+  RangeRead(uint64_t _offset, uint64_t _length, char* _buffer)
+      : offset(_offset), length(_length), buffer(_buffer) {}
+
+  const uint64_t offset;
+  const uint64_t length;
+  char* const buffer;
+  std::string hedgeBuffer;
+
+  // Serializes the members below and is signalled when an attempt finishes.
+  std::mutex mutex;
+  std::condition_variable finished;
+  int32_t numIssued{0};
+  int32_t numDone{0};
+  // The first attempt that succeeded, -1 if none.
+  int32_t winner{-1};
+  // The error of the last failed attempt.
+  std::optional<Aws::Client::AWSError<Aws::S3::S3Errors>> error;
+
+  // Serializes the writes of the attempts with 'cancelled'. Once set, no
+  // attempt writes into 'buffer' and incomplete transfers are aborted.
+  std::mutex writeMutex;
+  std::atomic<bool> cancelled{false};
+
+  // Called once when the read succeeds or all attempts have failed.
+  std::function<void(RangeRead&)> onDone;
+
+  bool isDone() const {
+    return winner >= 0 || (numIssued > 0 && numDone == numIssued);
+  }
+
+  void cancel() {
+    std::lock_guard<std::mutex> l(writeMutex);
+    cancelled = true;
+  }
+};
+
+// Response stream for one attempt of a RangeRead. Drops the data and fails
+// the transfer once the RangeRead is cancelled.
+class RangeReadStreamBuf : public std::streambuf {
+ public:
+  RangeReadStreamBuf(std::shared_ptr<RangeRead> read, char* data)
+      : read_(std::move(read)), data_(data) {}
+
+ protected:
+  std::streamsize xsputn(const char* bytes, std::streamsize size) override {
+    std::lock_guard<std::mutex> l(read_->writeMutex);
+    if (read_->cancelled) {
+      return 0;
+    }
+    size = std::min<std::streamsize>(size, read_->length - position_);
+    ::memcpy(data_ + position_, bytes, size);
+    position_ += size;
+    return size;
+  }
+
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    const char byte = traits_type::to_char_type(c);
+    return xsputn(&byte, 1) == 1 ? c : traits_type::eof();
+  }
+
+ private:
+  const std::shared_ptr<RangeRead> read_;
+  char* const data_;
+  uint64_t position_{0};
+};
+
+class RangeReadStream : RangeReadStreamBuf, public std::iostream {
+ public:
+  RangeReadStream(std::shared_ptr<RangeRead> read, char* data)
+      : RangeReadStreamBuf(std::move(read), data), std::iostream(this) {}
+};
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      S3ReadOptions options = {},
+      std::shared_ptr<S3LatencyTracker> latencyTracker = nullptr)
+      : client_(client),
+        options_(options),
+        latencyTracker_(std::move(latencyTracker)) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
   // Gets the length of the file.
   // Checks if there are any issues reading the file.
-  void initialize() {
+  void initialize(const filesystems::FileOptions& options) {
     // Make it a no-op if invoked twice.
     if (length_ != -1) {
       return;
     }
+    // A known size saves the HEAD request. Errors accessing the object then
+    // surface on the first read.
+    if (options.fileSize.has_value()) {
+      VELOX_CHECK_GE(options.fileSize.value(), 0);
+      length_ = options.fileSize.value();
+      return;
+    }
 
     Aws::S3::Model::HeadObjectRequest request;
     request.SetBucket(awsString(bucket_));
@@ -125,16 +235,68 @@ class S3ReadFile final : public ReadFile {
     // TODO: allocate from a memory pool
     std::string result(length, 0);
     preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
-    }
+    copyToBuffers(result, buffers);
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    // The parts are issued at once and complete on the threads of the S3
+    // client. Slow parts are not hedged since no thread waits for them.
+    struct AsyncRead {
+      std::string data;
+      std::vector<folly::Range<char*>> buffers;
+      folly::Promise<uint64_t> promise;
+      std::atomic<int32_t> numPending{0};
+      std::atomic<bool> failed{false};
+      std::vector<std::shared_ptr<RangeRead>> parts;
+    };
+    auto asyncRead = std::make_shared<AsyncRead>();
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    if (length == 0) {
+      return folly::makeSemiFuture<uint64_t>(0);
+    }
+    asyncRead->data.resize(length);
+    asyncRead->buffers = buffers;
+    auto future = asyncRead->promise.getSemiFuture();
+    asyncRead->parts = makeParts(offset, length, asyncRead->data.data());
+    asyncRead->numPending = asyncRead->parts.size();
+    for (auto& part : asyncRead->parts) {
+      // The callback holds 'asyncRead' alive until the last part is done.
+      part->onDone = [asyncRead, bucket = bucket_, key = key_](
+                         RangeRead& read) {
+        if (read.winner < 0) {
+          if (!asyncRead->failed.exchange(true)) {
+            for (auto& other : asyncRead->parts) {
+              other->cancel();
+            }
+            try {
+              throwError(*read.error, bucket, key);
+            } catch (const std::exception& e) {
+              asyncRead->promise.setException(
+                  folly::exception_wrapper(std::current_exception(), e));
+            }
+          }
+        } else if (--asyncRead->numPending == 0 && !asyncRead->failed) {
+          copyToBuffers(asyncRead->data, asyncRead->buffers);
+          asyncRead->promise.setValue(asyncRead->data.size());
+        }
+      };
+    }
+    for (auto& part : asyncRead->parts) {
+      issue(part, 0);
+    }
+    return future;
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -158,25 +320,163 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
-  // The assumption here is that "position" has space for at least "length"
-  // bytes.
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
+  static void copyToBuffers(
+      const std::string& data,
+      const std::vector<folly::Range<char*>>& buffers) {
+    size_t offset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), &(data.data()[offset]), range.size());
+      }
+      offset += range.size();
+    }
+  }
+
+  // Splits the range of 'length' bytes at 'offset' into ranged GETs of at
+  // most 'options_.partSize' bytes. 'buffer' receives the data.
+  std::vector<std::shared_ptr<RangeRead>>
+  makeParts(uint64_t offset, uint64_t length, char* buffer) const {
+    const auto partSize = options_.partSize == 0 ? length : options_.partSize;
+    std::vector<std::shared_ptr<RangeRead>> parts;
+    for (uint64_t partOffset = 0; partOffset < length;
+         partOffset += partSize) {
+      parts.push_back(std::make_shared<RangeRead>(
+          offset + partOffset,
+          std::min(partSize, length - partOffset),
+          buffer + partOffset));
+    }
+    return parts;
+  }
 
+  // Issues attempt 'attempt' of 'read'. Attempt 0 writes into 'read->buffer'
+  // and attempt 1 into 'read->hedgeBuffer'.
+  void issue(const std::shared_ptr<RangeRead>& read, int32_t attempt) const {
+    {
+      std::lock_guard<std::mutex> l(read->mutex);
+      ++read->numIssued;
+    }
+    char* data = attempt == 0 ? read->buffer : read->hedgeBuffer.data();
+    Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(awsString(bucket_));
     request.SetKey(awsString(key_));
     std::stringstream ss;
-    ss << "bytes=" << offset << "-" << offset + length - 1;
+    ss << "bytes=" << read->offset << "-" << read->offset + read->length - 1;
     request.SetRange(awsString(ss.str()));
-    request.SetResponseStreamFactory(
-        AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
-    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    request.SetResponseStreamFactory([read, data]() {
+      return Aws::New<RangeReadStream>("", read, data);
+    });
+    request.SetContinueRequestHandler(
+        [read](const Aws::Http::HttpRequest* /*request*/) {
+          return !read->cancelled;
+        });
+    const auto startUs = getCurrentTimeMicro();
+    client_->GetObjectAsync(
+        request,
+        [read, attempt, startUs, latencyTracker = latencyTracker_](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::GetObjectRequest& /*request*/,
+            const auto& outcome,
+            const auto& /*context*/) {
+          // Moved out when 'read' is done. This breaks a reference cycle
+          // between 'read' and the state captured by the callback.
+          std::function<void(RangeRead&)> onDone;
+          {
+            std::lock_guard<std::mutex> l(read->mutex);
+            const bool wasDone = read->isDone();
+            ++read->numDone;
+            if (outcome.IsSuccess()) {
+              if (read->winner < 0) {
+                read->winner = attempt;
+                if (latencyTracker != nullptr) {
+                  latencyTracker->record(getCurrentTimeMicro() - startUs);
+                }
+              }
+            } else {
+              read->error = outcome.GetError();
+            }
+            if (!wasDone && read->isDone()) {
+              onDone = std::move(read->onDone);
+            }
+          }
+          read->finished.notify_all();
+          if (onDone) {
+            onDone(*read);
+          }
+        });
+  }
+
+  // Waits for 'read' to finish. Issues a hedge if hedging is on and the first
+  // attempt has not finished within the high percentile of recent latencies.
+  void wait(const std::shared_ptr<RangeRead>& read) const {
+    std::unique_lock<std::mutex> l(read->mutex);
+    const auto isDone = [&]() { return read->isDone(); };
+    if (options_.hedgedReads && latencyTracker_ != nullptr) {
+      const auto estimateUs = latencyTracker_->estimate();
+      if (estimateUs.has_value() &&
+          !read->finished.wait_for(
+              l,
+              std::chrono::microseconds(
+                  std::max(options_.minHedgeDelayUs, estimateUs.value())),
+              isDone)) {
+        read->hedgeBuffer.resize(read->length);
+        l.unlock();
+        issue(read, 1);
+        l.lock();
+      }
+    }
+    read->finished.wait(l, isDone);
+    if (read->winner < 0) {
+      throwError(*read->error, bucket_, key_);
+    }
+    const auto winner = read->winner;
+    l.unlock();
+    // No attempt writes into 'read->buffer' after this.
+    read->cancel();
+    if (winner == 1) {
+      ::memcpy(read->buffer, read->hedgeBuffer.data(), read->length);
+    }
+  }
+
+  [[noreturn]] static void throwError(
+      const Aws::Client::AWSError<Aws::S3::S3Errors>& error,
+      const std::string& bucket,
+      const std::string& key) {
+    const Aws::S3::Model::GetObjectOutcome outcome(error);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket, key);
+    VELOX_UNREACHABLE();
+  }
+
+  // The assumption here is that "position" has space for at least "length"
+  // bytes. Reads in parallel ranged GETs of 'options_.partSize' with at most
+  // 'options_.maxParallelReads' in flight.
+  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    if (length == 0) {
+      return;
+    }
+    auto parts = makeParts(offset, length, position);
+    const auto maxInFlight =
+        std::max<int32_t>(1, options_.maxParallelReads);
+    int32_t numIssued = 0;
+    try {
+      for (auto i = 0; i < parts.size(); ++i) {
+        for (; numIssued < parts.size() && numIssued < i + maxInFlight;
+             ++numIssued) {
+          issue(parts[numIssued], 0);
+        }
+        wait(parts[i]);
+      }
+    } catch (const std::exception&) {
+      // The parts in flight must not write into 'position' after this.
+      for (auto i = 0; i < numIssued; ++i) {
+        parts[i]->cancel();
+      }
+      throw;
+    }
   }
 
   Aws::S3::S3Client* client_;
+  const S3ReadOptions options_;
+  const std::shared_ptr<S3LatencyTracker> latencyTracker_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -214,13 +514,19 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      int32_t maxParallelUploads,
+      int32_t maxPartRetries)
+      : client_(client),
+        pool_(pool),
+        maxParallelUploads_(maxParallelUploads),
+        maxPartRetries_(maxPartRetries) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
+    VELOX_CHECK_GT(maxParallelUploads_, 0);
+    VELOX_CHECK_GE(maxPartRetries_, 0);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
-    currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
-    currentPart_->reserve(kPartUploadSize);
+    currentPart_ = newPart();
     // Check that the object doesn't exist, if it does throw an error.
     {
       Aws::S3::Model::HeadObjectRequest request;
@@ -265,6 +571,13 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The uploads in flight reference 'this' and the memory of 'pool_'.
+    std::unique_lock<std::mutex> l(uploadState_.mutex);
+    uploadState_.partDone.wait(
+        l, [&]() { return uploadState_.numInFlight == 0; });
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -290,7 +603,8 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
-    uploadPart({currentPart_->data(), currentPart_->size()}, true);
+    uploadCurrentPart(true);
+    waitForUploads(0);
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
     {
@@ -306,7 +620,6 @@ class S3WriteFile::Impl {
       VELOX_CHECK_AWS_OUTCOME(
           outcome, "Failed to complete multiple part upload", bucket_, key_);
     }
-    currentPart_->clear();
   }
 
   // Current file size, i.e. the sum of all previous appends.
@@ -323,18 +636,36 @@ class S3WriteFile::Impl {
   static constexpr const char* kApplicationOctetStream =
       "application/octet-stream";
 
+  using PartBuffer = dwio::common::DataBuffer<char>;
+
   bool closed() const {
-    return (currentPart_->capacity() == 0);
+    return currentPart_ == nullptr;
   }
 
   // Holds state for the multipart upload.
   struct UploadState {
+    // Indexed by part number - 1. Filled in as the uploads complete.
     Aws::Vector<Aws::S3::Model::CompletedPart> completedParts;
     int64_t partNumber = 0;
     Aws::String id;
+
+    // Serializes the members below between the writer and the completion
+    // callbacks of the uploads.
+    std::mutex mutex;
+    std::condition_variable partDone;
+    int32_t numInFlight{0};
+    // The error of the first part that failed after all retries.
+    std::optional<Aws::Client::AWSError<Aws::S3::S3Errors>> error;
   };
   UploadState uploadState_;
 
+  // Returns an empty part buffer. The memory is charged to 'pool_'.
+  std::unique_ptr<PartBuffer> newPart() const {
+    auto part = std::make_unique<PartBuffer>(*pool_);
+    part->reserve(kPartUploadSize);
+    return part;
+  }
+
   // Data can be smaller or larger than the kPartUploadSize.
   // Complete the currentPart_ and upload kPartUploadSize chunks of data.
   // Save the remaining into currentPart_.
@@ -342,49 +673,108 @@ class S3WriteFile::Impl {
     auto dataPtr = data.data();
     auto dataSize = data.size();
     // Fill-up the remaining currentPart_.
-    auto remainingBufferSize = currentPart_->capacity() - currentPart_->size();
+    auto remainingBufferSize = kPartUploadSize - currentPart_->size();
     currentPart_->unsafeAppend(dataPtr, remainingBufferSize);
-    uploadPart({currentPart_->data(), currentPart_->size()});
+    uploadCurrentPart(false);
     dataPtr += remainingBufferSize;
     dataSize -= remainingBufferSize;
+    // 'data' is not valid after append() returns. Each part is copied into a
+    // buffer that lives until its upload completes.
     while (dataSize > kPartUploadSize) {
-      uploadPart({dataPtr, kPartUploadSize});
+      currentPart_->unsafeAppend(dataPtr, kPartUploadSize);
+      uploadCurrentPart(false);
       dataPtr += kPartUploadSize;
       dataSize -= kPartUploadSize;
     }
     // Stash the remaining at the beginning of currentPart.
-    currentPart_->unsafeAppend(0, dataPtr, dataSize);
+    currentPart_->unsafeAppend(dataPtr, dataSize);
   }
 
-  void uploadPart(const std::string_view part, bool isLast = false) {
+  // Starts the upload of 'currentPart_' and replaces it with an empty buffer
+  // unless 'isLast'. Waits while 'maxParallelUploads_' parts are in flight so
+  // that at most that many part buffers are held by uploads.
+  void uploadCurrentPart(bool isLast) {
     // Only the last part can be less than kPartUploadSize.
-    VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
+    VELOX_CHECK(isLast || currentPart_->size() == kPartUploadSize);
+    waitForUploads(maxParallelUploads_ - 1);
+    std::shared_ptr<PartBuffer> part = std::move(currentPart_);
+    if (!isLast) {
+      currentPart_ = newPart();
+    }
+    int64_t partNumber;
     {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
+      std::lock_guard<std::mutex> l(uploadState_.mutex);
+      partNumber = ++uploadState_.partNumber;
+      uploadState_.completedParts.resize(partNumber);
+      ++uploadState_.numInFlight;
+    }
+    uploadPart(partNumber, std::move(part), 0);
+  }
+
+  // Issues the upload of 'part' as 'partNumber' on the executor of
+  // 'client_'. A failed upload is reissued up to 'maxPartRetries_' times
+  // independently of the other parts.
+  void uploadPart(
+      int64_t partNumber,
+      std::shared_ptr<PartBuffer> part,
+      int32_t attempt) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part->size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part->data(), part->size()));
+    client_->UploadPartAsync(
+        request,
+        [this, partNumber, part = std::move(part), attempt](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::UploadPartRequest& /*request*/,
+            const auto& outcome,
+            const auto& /*context*/) {
+          if (!outcome.IsSuccess() && attempt < maxPartRetries_) {
+            LOG(WARNING) << "Retrying upload of part " << partNumber << " of "
+                         << s3URI(bucket_, key_) << ": "
+                         << outcome.GetError().GetMessage();
+            uploadPart(partNumber, part, attempt + 1);
+            return;
+          }
+          {
+            std::lock_guard<std::mutex> l(uploadState_.mutex);
+            if (outcome.IsSuccess()) {
+              // Append ETag and part number for this uploaded part.
+              // This will be needed for upload completion in Close().
+              auto& completedPart =
+                  uploadState_.completedParts[partNumber - 1];
+              completedPart.SetPartNumber(partNumber);
+              completedPart.SetETag(outcome.GetResult().GetETag());
+            } else if (!uploadState_.error.has_value()) {
+              uploadState_.error = outcome.GetError();
+            }
+            --uploadState_.numInFlight;
+          }
+          uploadState_.partDone.notify_all();
+        });
+  }
 
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
+  // Waits until at most 'maxInFlight' uploads are in flight. Throws the error
+  // of a part that failed.
+  void waitForUploads(int32_t maxInFlight) {
+    std::unique_lock<std::mutex> l(uploadState_.mutex);
+    uploadState_.partDone.wait(
+        l, [&]() { return uploadState_.numInFlight <= maxInFlight; });
+    if (uploadState_.error.has_value()) {
+      const Aws::S3::Model::UploadPartOutcome outcome(*uploadState_.error);
+      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
     }
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
+  const int32_t maxParallelUploads_;
+  const int32_t maxPartRetries_;
+  std::unique_ptr<PartBuffer> currentPart_;
   std::string bucket_;
   std::string key_;
   size_t fileSize_ = -1;
@@ -393,8 +783,11 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    int32_t maxParallelUploads,
+    int32_t maxPartRetries) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, maxParallelUploads, maxPartRetries);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -516,6 +909,22 @@ class S3FileSystem::Impl {
     } else {
       clientConfig.scheme = Aws::Http::Scheme::HTTP;
     }
+    // The ranged GETs of parallel reads run on a fixed pool of threads and
+    // reuse the pooled keep-alive connections of the client.
+    clientConfig.maxConnections = HiveConfig::s3MaxConnections(config_);
+    clientConfig.enableTcpKeepAlive = true;
+    clientConfig.executor =
+        Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+            "S3FileSystem", HiveConfig::s3IoThreads(config_));
+
+    readOptions_.partSize = HiveConfig::s3ReadPartSize(config_);
+    readOptions_.maxParallelReads = HiveConfig::s3MaxParallelReads(config_);
+    readOptions_.hedgedReads = HiveConfig::s3HedgedReadsEnabled(config_);
+    readOptions_.minHedgeDelayUs =
+        HiveConfig::s3HedgedReadsMinDelayMs(config_) * 1'000UL;
+    if (readOptions_.hedgedReads) {
+      latencyTracker_ = std::make_shared<S3LatencyTracker>();
+    }
 
     auto credentialsProvider = getCredentialsProvider();
 
@@ -606,9 +1015,21 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  const S3ReadOptions& readOptions() const {
+    return readOptions_;
+  }
+
+  // Latencies of the ranged GETs of all files of 'this'. Set if hedged reads
+  // are enabled.
+  const std::shared_ptr<S3LatencyTracker>& latencyTracker() const {
+    return latencyTracker_;
+  }
+
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  S3ReadOptions readOptions_;
+  std::shared_ptr<S3LatencyTracker> latencyTracker_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -622,10 +1043,14 @@ std::string S3FileSystem::getLogLevelName() const {
 
 std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
-    const FileOptions& /*unused*/) {
+    const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
-  s3file->initialize();
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      impl_->readOptions(),
+      impl_->latencyTracker());
+  s3file->initialize(options);
   return s3file;
 }
 
@@ -633,8 +1058,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      HiveConfig::s3MaxParallelUploads(config_.get()),
+      HiveConfig::s3UploadPartRetries(config_.get()));
   return s3file;
 }
 
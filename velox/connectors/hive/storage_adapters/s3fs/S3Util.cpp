@@ -21,6 +21,8 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 
+#include <algorithm>
+
 namespace facebook::velox {
 
 std::string getErrorStringFromS3Error(
@@ -43,4 +45,28 @@ std::string getErrorStringFromS3Error(
   }
 }
 
+void S3LatencyTracker::record(uint64_t latencyUs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (samples_.size() < kNumSamples) {
+    samples_.push_back(latencyUs);
+  } else {
+    samples_[numRecorded_ % kNumSamples] = latencyUs;
+  }
+  ++numRecorded_;
+  if (numRecorded_ < kMinSamples ||
+      (estimate_.has_value() && numRecorded_ % kRefreshInterval != 0)) {
+    return;
+  }
+  auto sorted = samples_;
+  const auto index = std::min<size_t>(
+      sorted.size() - 1, sorted.size() * percentile_ / 100);
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  estimate_ = sorted[index];
+}
+
+std::optional<uint64_t> S3LatencyTracker::estimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return estimate_;
+}
+
 } // namespace facebook::velox
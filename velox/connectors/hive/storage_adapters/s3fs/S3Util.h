@@ -21,6 +21,10 @@
 
 #pragma once
 
+#include <mutex>
+#include <optional>
+#include <vector>
+
 #include <aws/s3/S3Errors.h>
 #include <aws/s3/model/HeadObjectResult.h>
 
@@ -128,6 +132,34 @@ inline Aws::String awsString(const std::string& s) {
 std::string getErrorStringFromS3Error(
     const Aws::Client::AWSError<Aws::S3::S3Errors>& error);
 
+/// Estimates a percentile of the latencies of the last kNumSamples S3
+/// requests. Used for deciding when to hedge a slow request. Thread-safe.
+class S3LatencyTracker {
+ public:
+  static constexpr int32_t kNumSamples = 1024;
+  /// No estimate is made before this many requests have been recorded.
+  static constexpr int32_t kMinSamples = 100;
+
+  explicit S3LatencyTracker(double percentile = 99) : percentile_(percentile) {}
+
+  void record(uint64_t latencyUs);
+
+  /// Returns the estimated latency in microseconds or std::nullopt if fewer
+  /// than kMinSamples latencies have been recorded.
+  std::optional<uint64_t> estimate() const;
+
+ private:
+  // The estimate is refreshed after this many new samples.
+  static constexpr int32_t kRefreshInterval = 32;
+
+  const double percentile_;
+  mutable std::mutex mutex_;
+  // Ring buffer of the last kNumSamples latencies.
+  std::vector<uint64_t> samples_;
+  int64_t numRecorded_{0};
+  std::optional<uint64_t> estimate_;
+};
+
 namespace {
 inline std::string getS3BackendService(
     const Aws::Http::HeaderValueCollection& headers) {
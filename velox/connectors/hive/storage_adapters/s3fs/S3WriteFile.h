@@ -42,15 +42,20 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
-/// TODO: Implement retry on failure.
+/// Parts are uploaded asynchronously on the executor of the S3 client, at most
+/// 'maxParallelUploads' at a time. The part buffers are allocated from 'pool'.
+/// append() blocks while that many parts are in flight, which bounds the
+/// memory of a file to 'maxParallelUploads' + 1 parts. A failed part is
+/// reissued up to 'maxPartRetries' times. The error of a part that still fails
+/// is thrown from the next append() or close().
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      int32_t maxParallelUploads = 1,
+      int32_t maxPartRetries = 0);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
@@ -65,7 +70,7 @@ class S3WriteFile : public WriteFile {
   /// Current file size, i.e. the sum of all previous Appends.
   uint64_t size() const override;
 
-  /// Return the number of parts uploaded so far.
+  /// Return the number of parts whose upload has been started so far.
   int numPartsUploaded() const;
 
  protected:
@@ -70,12 +70,15 @@ TEST_F(S3FileSystemRegistrationTest, fileHandle) {
     writeData(&writeFile);
   }
   auto hiveConfig = minioServer_->hiveConfig();
-  FileHandleFactory factory(
-      std::make_unique<
-          SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(1000),
-      std::make_unique<FileHandleGenerator>(hiveConfig));
+  FileHandleFactory factory(1000, hiveConfig);
   auto fileHandle = factory.generate(s3File).second;
   readData(fileHandle->file.get());
+
+  // With a known size, the file is opened without a HEAD request.
+  FileHandleFactory sizedFactory(1000, hiveConfig);
+  FileProperties properties{fileHandle->file->size()};
+  fileHandle = sizedFactory.generate(s3File, &properties).second;
+  readData(fileHandle->file.get());
 }
 
 TEST_F(S3FileSystemRegistrationTest, finalize) {
@@ -60,6 +60,42 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRangedReads) {
+  const char* bucketName = "data-parallel";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Small parts so that the 1MB reads are split. With hedging and no minimum
+  // delay, the slowest reads are reissued once enough latencies are known.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "65536"},
+       {"hive.s3.max-parallel-reads", "4"},
+       {"hive.s3.hedged-reads.enabled", "true"},
+       {"hive.s3.hedged-reads.min-delay-ms", "0"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto readFile = s3fs.openFileForRead(s3File);
+  for (auto i = 0; i < 10; ++i) {
+    readData(readFile.get());
+  }
+
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  char head[12];
+  char tail[7];
+  const uint64_t gap = 15 + kOneMB - sizeof(head) - sizeof(tail);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)gap),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+}
+
 TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   {
     const std::unordered_map<std::string, std::string> config(
@@ -250,3 +286,38 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   // Verify the last chunk.
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
+
+TEST_F(S3FileSystemTest, parallelUploadMemory) {
+  const auto bucketName = "writedataparallel";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+  constexpr int64_t kPartSize = 10 << 20;
+
+  auto hiveConfig =
+      minioServer_->hiveConfig({{"hive.s3.max-parallel-uploads", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool =
+      memory::defaultMemoryManager().addLeafPool("S3FileSystemUploadTest");
+  auto writeFile = s3fs.openFileForWrite(s3File, {{}, pool.get()});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // 6 full parts and some in one append. At most 2 parts are in flight and
+  // one is being filled.
+  std::string data(6 * kPartSize + 100, 'x');
+  for (auto i = 0; i < data.size(); i += 4096) {
+    data[i] = 'a' + (i / kPartSize);
+  }
+  writeFile->append(data);
+  EXPECT_EQ(6, s3WriteFile->numPartsUploaded());
+  EXPECT_LT(pool->currentBytes(), 4 * kPartSize);
+  writeFile->close();
+  EXPECT_EQ(7, s3WriteFile->numPartsUploaded());
+
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(data.size(), readFile->size());
+  for (auto i = 0; i < 7; ++i) {
+    const auto offset = i * kPartSize;
+    const auto length = std::min<int64_t>(kPartSize, data.size() - offset);
+    ASSERT_EQ(readFile->pread(offset, length), data.substr(offset, length));
+  }
+}
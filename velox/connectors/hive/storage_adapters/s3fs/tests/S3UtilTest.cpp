@@ -108,3 +108,25 @@ TEST(S3UtilTest, bucketAndKeyFromS3Path) {
   EXPECT_EQ(bucket, "bucket");
   EXPECT_EQ(key, "file.txt");
 }
+
+TEST(S3UtilTest, latencyTracker) {
+  S3LatencyTracker tracker;
+  for (auto i = 0; i < S3LatencyTracker::kMinSamples - 1; ++i) {
+    tracker.record(1'000);
+  }
+  EXPECT_FALSE(tracker.estimate().has_value());
+  tracker.record(1'000);
+  EXPECT_EQ(1'000, tracker.estimate().value());
+
+  // 1 in 50 requests is slow. The 99th percentile is the slow latency.
+  for (auto i = 0; i < S3LatencyTracker::kNumSamples; ++i) {
+    tracker.record(i % 50 == 0 ? 100'000 : 1'000);
+  }
+  EXPECT_EQ(100'000, tracker.estimate().value());
+
+  // Old samples age out.
+  for (auto i = 0; i < S3LatencyTracker::kNumSamples; ++i) {
+    tracker.record(2'000);
+  }
+  EXPECT_EQ(2'000, tracker.estimate().value());
+}
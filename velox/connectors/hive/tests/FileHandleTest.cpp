@@ -17,6 +17,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 
 #include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
@@ -36,10 +37,7 @@ TEST(FileHandleTest, localFile) {
     writeFile.append("foo");
   }
 
-  FileHandleFactory factory(
-      std::make_unique<
-          SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(1000),
-      std::make_unique<FileHandleGenerator>());
+  FileHandleFactory factory(1000, nullptr);
   auto fileHandle = factory.generate(filename).second;
   ASSERT_EQ(fileHandle->file->size(), 3);
   char buffer[3];
@@ -48,3 +46,63 @@ TEST(FileHandleTest, localFile) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, shards) {
+  filesystems::registerLocalFileSystem();
+
+  std::vector<std::shared_ptr<::exec::test::TempFilePath>> files;
+  for (auto i = 0; i < 20; ++i) {
+    files.push_back(::exec::test::TempFilePath::create());
+    LocalWriteFile writeFile(files.back()->path);
+    writeFile.append("foo");
+  }
+
+  FileHandleFactory factory(100, nullptr, 0, 4);
+  for (auto round = 0; round < 2; ++round) {
+    for (const auto& file : files) {
+      auto [hit, fileHandle] = factory.generate(file->path);
+      ASSERT_EQ(hit, round == 1);
+      ASSERT_EQ(fileHandle->file->size(), 3);
+    }
+  }
+  auto stats = factory.cacheStats();
+  ASSERT_EQ(stats.maxSize, 100);
+  ASSERT_EQ(stats.curSize, 20);
+  ASSERT_EQ(stats.numHits, 20);
+  ASSERT_EQ(stats.numLookups, 40);
+
+  stats = factory.clearCache();
+  ASSERT_EQ(stats.curSize, 0);
+
+  // Fewer entries than shards.
+  FileHandleFactory smallFactory(2, nullptr);
+  ASSERT_EQ(smallFactory.cacheStats().maxSize, 2);
+  ASSERT_FALSE(smallFactory.generate(files[0]->path).first);
+  ASSERT_TRUE(smallFactory.generate(files[0]->path).first);
+}
+
+TEST(FileHandleTest, negativeCache) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path;
+  remove(filename.c_str());
+
+  FileHandleFactory factory(1000, nullptr, 1'000'000);
+  VELOX_ASSERT_THROW(
+      factory.generate(filename), "open failure in LocalReadFile");
+
+  // The failed open is remembered, so the file that now exists is not opened.
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+  VELOX_ASSERT_THROW(
+      factory.generate(filename), "open failure in LocalReadFile");
+
+  // Without negative caching the file is opened.
+  FileHandleFactory uncachedFactory(1000, nullptr);
+  ASSERT_EQ(uncachedFactory.generate(filename).second->file->size(), 3);
+
+  remove(filename.c_str());
+}
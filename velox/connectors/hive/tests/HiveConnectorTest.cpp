@@ -433,5 +433,32 @@ TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
       remaining->toString(), "not(lt(ROW[\"c2\"],cast 0 as DECIMAL(20, 0)))");
 }
 
+TEST_F(HiveConnectorTest, extractColumnFreeConjuncts) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+
+  auto expr = parseExpr("c0 > c1 and rand() < 0.5 and c1 > 0", rowType);
+  std::vector<core::TypedExprPtr> columnFree;
+  auto remaining =
+      HiveDataSource::extractColumnFreeConjuncts(expr, columnFree);
+  ASSERT_EQ(columnFree.size(), 1);
+  ASSERT_NE(columnFree[0]->toString().find("rand"), std::string::npos);
+  ASSERT_TRUE(remaining);
+  ASSERT_EQ(remaining->toString().find("rand"), std::string::npos);
+
+  columnFree.clear();
+  expr = parseExpr("rand() < 0.5", rowType);
+  ASSERT_FALSE(HiveDataSource::extractColumnFreeConjuncts(expr, columnFree));
+  ASSERT_EQ(columnFree.size(), 1);
+
+  // Conjuncts under 'or' and lambdas over columns stay.
+  columnFree.clear();
+  expr = parseExpr(
+      "(rand() < 0.5 or c0 > 0) and any_match(array[c0], x -> x > 0)",
+      rowType);
+  remaining = HiveDataSource::extractColumnFreeConjuncts(expr, columnFree);
+  ASSERT_TRUE(columnFree.empty());
+  ASSERT_EQ(remaining, expr);
+}
+
 } // namespace
 } // namespace facebook::velox::connector::hive
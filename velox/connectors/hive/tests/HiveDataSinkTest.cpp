@@ -20,8 +20,10 @@
 #include <folly/init/Init.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/Options.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
@@ -835,6 +837,188 @@ TEST_F(HiveDataSinkTest, memoryReclaimAfterClose) {
     }
   }
 }
+
+TEST_F(HiveDataSinkTest, sortWriterMaxBufferSize) {
+  VectorFuzzer::Options options;
+  options.vectorSize = 500;
+  VectorFuzzer fuzzer(options, pool());
+  std::vector<RowVectorPtr> vectors;
+  const int numBatches{10};
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(rowType_));
+  }
+
+  const auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      4,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{true, true})});
+
+  // Returns the connector memory usage after all the input is added.
+  auto writeSorted = [&](const std::string& maxBufferSize) {
+    setConnectorConfig(
+        {{HiveConfig::kSortWriterMaxBufferSizeConfig, maxBufferSize}});
+    setupMemoryPools();
+    const auto spillDirectory = exec::test::TempDirectoryPath::create();
+    const auto spillConfig = getSpillConfig(spillDirectory->path, 1 << 30);
+    setConnectorQueryContext(std::make_unique<connector::ConnectorQueryCtx>(
+        opPool_.get(),
+        connectorPool_.get(),
+        connectorConfig_.get(),
+        spillConfig.get(),
+        nullptr,
+        nullptr,
+        "query.HiveDataSinkTest",
+        "task.HiveDataSinkTest",
+        "planNodeId.HiveDataSinkTest",
+        0));
+
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->path,
+        dwio::common::FileFormat::DWRF,
+        {"c6"},
+        bucketProperty);
+    for (int i = 0; i < numBatches; ++i) {
+      dataSink->appendData(vectors[i]);
+    }
+    const auto usedBytes = connectorPool_->currentBytes();
+    const auto results = dataSink->close(true);
+    EXPECT_GE(results.size(), 1);
+
+    // Each bucket file is sorted on 'c1' whether or not it was spilled.
+    uint64_t numRows{0};
+    for (const auto& filePath : listFiles(outputDirectory->path)) {
+      const auto data = AssertQueryBuilder(
+                            PlanBuilder().tableScan(rowType_).planNode())
+                            .split(makeHiveConnectorSplit(filePath))
+                            .copyResults(pool());
+      const auto* sortColumn = data->childAt(1)->asFlatVector<int32_t>();
+      for (auto row = 1; row < data->size(); ++row) {
+        if (sortColumn->isNullAt(row)) {
+          EXPECT_TRUE(sortColumn->isNullAt(row - 1));
+        } else if (!sortColumn->isNullAt(row - 1)) {
+          EXPECT_LE(sortColumn->valueAt(row - 1), sortColumn->valueAt(row));
+        }
+      }
+      numRows += data->size();
+    }
+    EXPECT_EQ(numRows, numBatches * options.vectorSize);
+    return usedBytes;
+  };
+
+  // A tiny limit spills each bucket's sorted run before adding more input.
+  const auto unlimitedBytes = writeSorted("0B");
+  const auto limitedBytes = writeSorted("1B");
+  ASSERT_LT(limitedBytes, unlimitedBytes);
+}
+
+TEST_F(HiveDataSinkTest, maxOpenWriterFiles) {
+  VectorFuzzer::Options options;
+  options.vectorSize = 100;
+  VectorFuzzer fuzzer(options, pool());
+  // Batches of 4 partitions in turn, so that a partition is written again
+  // after its file was closed. The last batch has more partitions than may be
+  // open at a time.
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < 8; ++i) {
+    auto vector = fuzzer.fuzzInputRow(rowType_);
+    vector->childAt(1) = makeFlatVector<int32_t>(
+        options.vectorSize, [&](auto /*row*/) { return i % 4; });
+    vectors.push_back(vector);
+  }
+  auto lastVector = fuzzer.fuzzInputRow(rowType_);
+  lastVector->childAt(1) = makeFlatVector<int32_t>(
+      options.vectorSize, [](auto row) { return row % 4; });
+  vectors.push_back(lastVector);
+
+  for (const auto maxOpenFiles : {0, 2}) {
+    SCOPED_TRACE(fmt::format("maxOpenFiles {}", maxOpenFiles));
+    setConnectorConfig(
+        {{HiveConfig::kMaxOpenWriterFiles, std::to_string(maxOpenFiles)}});
+    setupMemoryPools();
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->path,
+        dwio::common::FileFormat::DWRF,
+        {"c1"});
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto numFiles = dataSink->numWrittenFiles();
+    const auto results = dataSink->close(true);
+    ASSERT_EQ(results.size(), numFiles);
+    const auto filePaths = listFiles(outputDirectory->path);
+    ASSERT_EQ(filePaths.size(), numFiles);
+    if (maxOpenFiles == 0) {
+      ASSERT_EQ(numFiles, 4);
+    } else {
+      // Each of the first 8 batches goes to a new file. The last batch closes
+      // the 2 open files for its first 2 partitions and then exceeds the
+      // limit, so that all its 4 partitions go to new files.
+      ASSERT_EQ(numFiles, 12);
+    }
+
+    uint64_t numRows{0};
+    for (const auto& filePath : filePaths) {
+      numRows += AssertQueryBuilder(PlanBuilder().tableScan(rowType_).planNode())
+                     .split(makeHiveConnectorSplit(filePath))
+                     .copyResults(pool())
+                     ->size();
+    }
+    ASSERT_EQ(numRows, vectors.size() * options.vectorSize);
+  }
+}
+
+TEST_F(HiveDataSinkTest, maxTargetFileSize) {
+  VectorFuzzer::Options options;
+  options.vectorSize = 100;
+  VectorFuzzer fuzzer(options, pool());
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < 10; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(rowType_));
+  }
+
+  for (const auto* maxTargetFileSize : {"0B", "1B"}) {
+    SCOPED_TRACE(fmt::format("maxTargetFileSize {}", maxTargetFileSize));
+    // Small stripes, so that each batch is flushed to the file.
+    setConnectorConfig(
+        {{HiveConfig::kMaxTargetFileSize, maxTargetFileSize},
+         {HiveConfig::kOrcWriterMaxStripeSizeConfig, "1KB"}});
+    setupMemoryPools();
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_, outputDirectory->path, dwio::common::FileFormat::DWRF);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto numFiles = dataSink->numWrittenFiles();
+    const auto results = dataSink->close(true);
+    ASSERT_EQ(results.size(), numFiles);
+    const auto filePaths = listFiles(outputDirectory->path);
+    ASSERT_EQ(filePaths.size(), numFiles);
+    if (std::string(maxTargetFileSize) == "0B") {
+      ASSERT_EQ(numFiles, 1);
+    } else {
+      ASSERT_GT(numFiles, 1);
+      ASSERT_LE(numFiles, vectors.size());
+    }
+
+    uint64_t numRows{0};
+    for (const auto& filePath : filePaths) {
+      numRows += AssertQueryBuilder(PlanBuilder().tableScan(rowType_).planNode())
+                     .split(makeHiveConnectorSplit(filePath))
+                     .copyResults(pool())
+                     ->size();
+    }
+    ASSERT_EQ(numRows, vectors.size() * options.vectorSize);
+  }
+}
 } // namespace
 } // namespace facebook::velox::connector::hive
 
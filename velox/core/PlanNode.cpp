@@ -112,7 +112,8 @@ AggregationNode::AggregationNode(
     const std::vector<vector_size_t>& globalGroupingSets,
     const std::optional<FieldAccessTypedExprPtr>& groupId,
     bool ignoreNullKeys,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    std::optional<int64_t> estimatedNumGroups)
     : PlanNode(id),
       step_(step),
       groupingKeys_(groupingKeys),
@@ -122,6 +123,7 @@ AggregationNode::AggregationNode(
       ignoreNullKeys_(ignoreNullKeys),
       groupId_(groupId),
       globalGroupingSets_(globalGroupingSets),
+      estimatedNumGroups_(estimatedNumGroups),
       sources_{source},
       outputType_(getAggregationOutputType(
           groupingKeys_,
@@ -166,6 +168,13 @@ AggregationNode::AggregationNode(
     VELOX_USER_CHECK(
         groupId_.has_value(), "Global grouping sets require GroupId key");
   }
+
+  if (estimatedNumGroups_.has_value()) {
+    VELOX_USER_CHECK_GE(
+        estimatedNumGroups_.value(),
+        0,
+        "Estimated number of groups must not be negative");
+  }
 }
 
 AggregationNode::AggregationNode(
@@ -228,14 +237,6 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: add spilling for aggregations with sorting or with distinct later:
-  // https://github.com/facebookincubator/velox/issues/7454
-  // https://github.com/facebookincubator/velox/issues/7455
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
-      return false;
-    }
-  }
   // TODO: add spilling for pre-grouped aggregation later:
   // https://github.com/facebookincubator/velox/issues/3264
   return (isFinal() || isSingle()) && preGroupedKeys().empty() &&
@@ -277,6 +278,10 @@ void AggregationNode::addDetails(std::stringstream& stream) const {
   if (groupId_.has_value()) {
     stream << " Group Id key: " << groupId_.value()->name();
   }
+
+  if (estimatedNumGroups_.has_value()) {
+    stream << " estimated groups: " << estimatedNumGroups_.value();
+  }
 }
 
 namespace {
@@ -330,6 +335,9 @@ folly::dynamic AggregationNode::serialize() const {
   if (groupId_.has_value()) {
     obj["groupId"] = ISerializable::serialize(groupId_.value());
   }
+  if (estimatedNumGroups_.has_value()) {
+    obj["estimatedNumGroups"] = estimatedNumGroups_.value();
+  }
   obj["ignoreNullKeys"] = ignoreNullKeys_;
   return obj;
 }
@@ -430,6 +438,11 @@ PlanNodePtr AggregationNode::create(const folly::dynamic& obj, void* context) {
         obj["groupId"], context);
   }
 
+  std::optional<int64_t> estimatedNumGroups;
+  if (obj.count("estimatedNumGroups")) {
+    estimatedNumGroups = obj["estimatedNumGroups"].asInt();
+  }
+
   return std::make_shared<AggregationNode>(
       deserializePlanNodeId(obj),
       stepFromName(obj["step"].asString()),
@@ -440,7 +453,8 @@ PlanNodePtr AggregationNode::create(const folly::dynamic& obj, void* context) {
       globalGroupingSets,
       groupId,
       obj["ignoreNullKeys"].asBool(),
-      deserializeSingleSource(obj, context));
+      deserializeSingleSource(obj, context),
+      estimatedNumGroups);
 }
 
 namespace {
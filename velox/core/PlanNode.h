@@ -541,6 +541,10 @@ class AggregationNode : public PlanNode {
   /// GlobalGroupingSets and groupId trigger special handling when the input
   /// data set is empty (no rows). In that case, aggregation generates a single
   /// row with the default global aggregate value per global grouping set.
+  ///
+  /// @param estimatedNumGroups Optional estimate of the number of groups, e.g.
+  /// from the optimizer's statistics. Used to size the hash table of a final
+  /// or single aggregation up front instead of growing it by rehashing.
   AggregationNode(
       const PlanNodeId& id,
       Step step,
@@ -551,7 +555,8 @@ class AggregationNode : public PlanNode {
       const std::vector<vector_size_t>& globalGroupingSets,
       const std::optional<FieldAccessTypedExprPtr>& groupId,
       bool ignoreNullKeys,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      std::optional<int64_t> estimatedNumGroups = std::nullopt);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -593,6 +598,10 @@ class AggregationNode : public PlanNode {
     return groupId_;
   }
 
+  std::optional<int64_t> estimatedNumGroups() const {
+    return estimatedNumGroups_;
+  }
+
   std::string_view name() const override {
     return "Aggregation";
   }
@@ -623,6 +632,7 @@ class AggregationNode : public PlanNode {
 
   std::optional<FieldAccessTypedExprPtr> groupId_;
   std::vector<vector_size_t> globalGroupingSets_;
+  const std::optional<int64_t> estimatedNumGroups_;
 
   const std::vector<PlanNodePtr> sources_;
   const RowTypePtr outputType_;
@@ -1013,6 +1023,16 @@ class PartitionFunctionSpec : public ISerializable {
   virtual std::unique_ptr<PartitionFunction> create(
       int numPartitions) const = 0;
 
+  /// Creates a partition function for the drivers of split group
+  /// 'splitGroupId' in grouped execution. 'splitGroupId' is the max uint32_t
+  /// value in ungrouped execution. Partition functions that don't depend on
+  /// the split group ignore it.
+  virtual std::unique_ptr<PartitionFunction> createForSplitGroup(
+      int numPartitions,
+      uint32_t /*splitGroupId*/) const {
+    return create(numPartitions);
+  }
+
   virtual ~PartitionFunctionSpec() = default;
 
   virtual std::string toString() const = 0;
@@ -2222,6 +2242,10 @@ class MarkDistinctNode : public PlanNode {
     return distinctKeys_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
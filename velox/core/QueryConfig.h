@@ -87,6 +87,27 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// The maximum size of a dictionary base for which an expression memoizes
+  /// its results across batches. The memo holds a reference to the base and
+  /// one result per base position, so this bounds the memory held by each
+  /// memoizing expression. 0 disables memoization.
+  static constexpr const char* kExprMaxMemoBaseSize =
+      "expression.max_memo_base_size";
+  static constexpr uint32_t kDefaultExprMaxMemoBaseSize = 1 << 20;
+
+  /// Whether to fuse trees of DOUBLE arithmetic and comparison functions over
+  /// fields and constants, e.g. a * b + c > d, into a single pass without
+  /// intermediate vectors. False by default.
+  static constexpr const char* kExprFuseArithmetic =
+      "expression.fuse_arithmetic";
+
+  /// Profiles one in this many batches evaluated by each set of expressions,
+  /// e.g. the projections and filter of a FilterProject, recording the time,
+  /// rows and null results of each top level expression. Reported as runtime
+  /// stats of the operator. 0 disables profiling.
+  static constexpr const char* kExprProfileSampleRate =
+      "expression.profile_sample_rate";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
@@ -130,8 +151,16 @@ class QueryConfig {
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// If true, Exchange deserializes one received page per output batch into
+  /// vectors whose buffers point into the page instead of copying the data,
+  /// if the serde supports it.
+  static constexpr const char* kExchangeZeroCopyEnabled =
+      "exchange.zero_copy_enabled";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
-  /// exchange. Enforced approximately, not strictly.
+  /// exchange. Enforced approximately, not strictly. Each source starts with
+  /// an even share. Sources that the merge has to wait for get a larger share
+  /// from what is left.
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
@@ -141,12 +170,54 @@ class QueryConfig {
   static constexpr const char* kMaxExtendedPartialAggregationMemory =
       "max_extended_partial_aggregation_memory";
 
+  /// If true, a driver of a query with little free memory capacity yields
+  /// with BlockingReason::kWaitForMemory while a memory arbitration is in
+  /// progress instead of blocking its thread in the arbitration queue.
+  static constexpr const char* kAsyncMemoryArbitrationEnabled =
+      "async_memory_arbitration_enabled";
+
+  /// The wall time in ms after which a Driver that stays on thread yields
+  /// with StopReason::kYield and is enqueued again. 0 disables the time
+  /// slice. Used with MultiLevelDriverExecutor to move the Drivers of Tasks
+  /// that use a lot of CPU to lower priority levels.
+  static constexpr const char* kDriverCpuTimeSliceLimitMs =
+      "driver_cpu_time_slice_limit_ms";
+
+  /// In grouped execution, a split group is started next to the ones that are
+  /// already running only while the query uses less than this percentage of
+  /// its memory capacity. The number of concurrent split groups then follows
+  /// the available memory, up to the concurrentSplitGroups passed to
+  /// Task::start(). At least one split group always runs. 100 means no limit
+  /// other than concurrentSplitGroups.
+  static constexpr const char* kSplitGroupAdmissionMemoryPct =
+      "split_group_admission_memory_pct";
+
+  /// If true, each Driver records the times it spends queued, on thread and
+  /// blocked, with the StopReason or BlockingReason and blocked operator.
+  /// Exported by Task::driverTimelinesToChromeTrace().
+  static constexpr const char* kDriverTimelineEnabled =
+      "driver_timeline_enabled";
+
+  /// Operators that hold on to their input across batches compact the string
+  /// buffers of the input when its strings take less than this percentage of
+  /// the buffers they retain. See BaseVector::compactStringBuffers(). 0
+  /// disables compaction.
+  static constexpr const char* kCompactStringBuffersMinLivePct =
+      "compact_string_buffers_min_live_pct";
+
   static constexpr const char* kAbandonPartialAggregationMinRows =
       "abandon_partial_aggregation_min_rows";
 
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// Number of input rows that pass through an abandoned partial aggregation
+  /// before it estimates the number of groups in the next
+  /// 'abandon_partial_aggregation_min_rows' rows and resumes aggregating if
+  /// they are reducing again. 0 disables resuming.
+  static constexpr const char* kAbandonPartialAggregationResampleRows =
+      "abandon_partial_aggregation_resample_rows";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -175,12 +246,64 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, TableScan, Exchange and HashProbe size their output batches
+  /// from the average output row size measured in their OperatorStats,
+  /// taking the widest of their rows and the rows of the FilterProjects that
+  /// follow them in the pipeline, so that a batch takes about
+  /// kAdaptiveOutputBatchBytes.
+  static constexpr const char* kAdaptiveOutputBatchSizingEnabled =
+      "adaptive_output_batch_sizing_enabled";
+
+  /// The target size in bytes of an output batch with
+  /// kAdaptiveOutputBatchSizingEnabled. The default fits the batch in a
+  /// typical L2 cache.
+  static constexpr const char* kAdaptiveOutputBatchBytes =
+      "adaptive_output_batch_bytes";
+
+  /// The most splits per Driver that a TableScan preloads in the background.
+  /// The preload depth starts at one split and grows towards this when a
+  /// preloaded split is still not ready when the scan gets to it, i.e. when
+  /// the I/O latency is longer than the time to read a split. The depth goes
+  /// back to one when the query uses more than half of its memory capacity.
+  /// Setting the split_preload_per_driver flag to 0 still disables preload.
+  static constexpr const char* kMaxSplitPreloadPerDriver =
+      "max_split_preload_per_driver";
+
+  /// If true, a FilterProject right after a TableScan or HashProbe is
+  /// evaluated in the output path of that operator. The filter then drops
+  /// rows before the output leaves the operator, so that a batch with no
+  /// passing rows does not make a round trip through the Driver and the
+  /// HashProbe continues with the next join results. The time of the filter
+  /// and projections is counted in the stats of the producing operator.
+  static constexpr const char* kFilterProjectFusionEnabled =
+      "filter_project_fusion_enabled";
+
+  /// If true, a TableScan caches its output for a split, after any fused
+  /// FilterProject, in the AsyncDataCache and returns the cached output when
+  /// the same plan reads the same split again. Only splits that can identify
+  /// the version of their data, see ConnectorSplit::cacheKey(), are cached.
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment_result_cache_enabled";
+
+  /// The most serialized bytes of output of one split that are cached with
+  /// fragment_result_cache_enabled. A split with more output is not cached.
+  static constexpr const char* kFragmentResultCacheMaxSplitBytes =
+      "fragment_result_cache_max_split_bytes";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
   static constexpr const char* kTableScanGetOutputTimeLimitMs =
       "table_scan_getoutput_time_limit_ms";
 
+  /// If non-zero, a split that covers more than twice this many bytes of a
+  /// file is broken into morsels of about this many bytes when a TableScan
+  /// takes it, so that the Drivers that run out of splits take over the rest
+  /// of a large split instead of waiting on the Driver that has it. Zero
+  /// means splits are not broken up.
+  static constexpr const char* kTableScanSplitMorselBytes =
+      "table_scan_split_morsel_bytes";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -219,6 +342,10 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -257,9 +384,29 @@ class QueryConfig {
   /// spilled files.
   static constexpr const char* kMinSpillRunSize = "min_spill_run_size";
 
+  /// The compression codec of spill files. "adaptive" chooses none, lz4 or
+  /// zstd for each spill file from the measured compression ratio and codec
+  /// and disk write throughputs.
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// The serialization format of spill files, "presto" or "compact_row". The
+  /// row-wise "compact_row" format is cheaper to read back but does not
+  /// support spill compression.
+  static constexpr const char* kSpillFileFormat = "spill_file_format";
+
+  /// The max number of read buffers read ahead per spill file on the spill
+  /// executor when merging sorted spill files. If it is zero, then spill
+  /// files are read synchronously.
+  static constexpr const char* kSpillReadAheadBuffers =
+      "spill_read_ahead_buffers";
+
+  /// The memory budget in bytes of the read-ahead buffers of all the spill
+  /// files in a merge. Fewer buffers are read ahead per file if the merge has
+  /// many spill files.
+  static constexpr const char* kMaxSpillReadAheadBytes =
+      "max_spill_read_ahead_bytes";
+
   /// Specifies spill write buffer size in bytes. The spiller tries to buffer
   /// serialized spill data up to the specified size before write to storage
   /// underneath for io efficiency. If it is set to zero, then spill write
@@ -273,6 +420,13 @@ class QueryConfig {
   static constexpr const char* kJoinSpillPartitionBits =
       "join_spiller_partition_bits";
 
+  /// If true, HashBuild predicts before restoring a spilled partition whether
+  /// it fits in memory by comparing its size with the largest spill run so
+  /// far. A partition predicted not to fit is split into the next level spill
+  /// partitions directly instead of building and then spilling a table.
+  static constexpr const char* kJoinSpillPartitionPredictionEnabled =
+      "join_spill_partition_prediction_enabled";
+
   static constexpr const char* kMinSpillableReservationPct =
       "min_spillable_reservation_pct";
 
@@ -317,11 +471,93 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The max size in bytes of a Bloom filter built from a join key of a hash
+  /// join build side that has too many distinct values for an exact dynamic
+  /// filter. The Bloom filter is pushed down into the probe side table scan.
+  /// Zero disables Bloom filter dynamic filters.
+  static constexpr const char* kHashBuildBloomFilterMaxBytes =
+      "hash_build_bloom_filter_max_bytes";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The minimum size in bytes of the bucket array of a hash join table at
+  /// which the probe groups each batch of probe rows by the region of the
+  /// table they hit. This keeps the probes of a group within a cache sized
+  /// part of a table that is too large for the CPU caches. 0 disables this.
+  static constexpr const char* kHashProbePartitionedMinTableBytes =
+      "hash_probe_partitioned_min_table_bytes";
+
+  /// If true, a hash join build side with multiple keys uses a normalized key
+  /// of two words when the value ids of the keys do not fit in one. This
+  /// avoids comparing the keys column by column on probe at the cost of 16
+  /// instead of 8 bytes per build row for the normalized key.
+  static constexpr const char* kHashJoinWideNormalizedKeyEnabled =
+      "hash_join_wide_normalized_key_enabled";
+
+  /// If true, the parallel hash join table build inserts the rows of each
+  /// build driver into the shared table concurrently, one thread per driver,
+  /// with a lock per bucket. This replaces the partitioning of the rows by
+  /// table range and the serial insertion of the rows that overflow their
+  /// range.
+  static constexpr const char* kHashJoinConcurrentBuildEnabled =
+      "hash_join_concurrent_build_enabled";
+
+  /// The estimated number of build side rows at and above which a join key is
+  /// a heavy hitter. HashBuild finds these keys with a stream summary of the
+  /// key hashes. HashProbe yields after
+  /// 'hash_probe_heavy_hitter_time_slice_ms' of producing results for an
+  /// input batch that hits a heavy hitter. 0 disables the detection.
+  static constexpr const char* kHashJoinHeavyHitterMinRows =
+      "hash_join_heavy_hitter_min_rows";
+
+  /// The time in ms for which HashProbe produces results for a probe batch
+  /// that hits a heavy hitter key before it yields the thread.
+  static constexpr const char* kHashProbeHeavyHitterTimeSliceMs =
+      "hash_probe_heavy_hitter_time_slice_ms";
+
+  /// If true, hash join and aggregation tables that use one word normalized
+  /// keys store the keys in the hash table next to the row pointers, so that
+  /// probes compare keys without accessing the rows. This doubles the size
+  /// of the hash table.
+  static constexpr const char* kHashTableInlineKeysEnabled =
+      "hash_table_inline_keys_enabled";
+
+  /// The maximum number of rows in a block of nested loop join build rows.
+  /// The build side coalesces consecutive smaller input vectors into blocks
+  /// of up to this many rows, so that the probe evaluates the join condition
+  /// over larger tiles of the cross product. 0 keeps the input vectors.
+  static constexpr const char* kNestedLoopJoinBuildBlockRows =
+      "nested_loop_join_build_block_rows";
+
+  /// If true, merge join produces output batches that combine a single batch
+  /// of input from each side by wrapping the inputs in dictionaries instead
+  /// of copying the rows. Applies to large sets of rows with matching keys.
+  static constexpr const char* kMergeJoinDictionaryOutputEnabled =
+      "merge_join_dictionary_output_enabled";
+
+  /// If true, the drivers of a final or single step hash aggregation with
+  /// grouping keys insert their input into tables shared by all the drivers
+  /// of the pipeline. The tables are radix partitioned by the grouping keys
+  /// and each driver produces the output of one partition. The input then
+  /// does not need to be hash partitioned by a local exchange. Disables
+  /// spilling of such aggregations.
+  static constexpr const char* kHashAggregationSharedTablesEnabled =
+      "hash_aggregation_shared_tables_enabled";
+
+  /// The max number of partitions a window operator evaluates concurrently
+  /// on the query executor after sorting its input. 1 evaluates partitions
+  /// one at a time on the driver thread.
+  static constexpr const char* kWindowParallelism = "window_parallelism";
+
+  /// The max number of threads an order by operator sorts its rows with on
+  /// the query executor after all its input is added. 1 sorts on the driver
+  /// thread.
+  static constexpr const char* kOrderBySortParallelism =
+      "order_by_sort_parallelism";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -353,6 +589,26 @@ class QueryConfig {
     return get<uint64_t>(kMaxExtendedPartialAggregationMemory, kDefault);
   }
 
+  bool asyncMemoryArbitrationEnabled() const {
+    return get<bool>(kAsyncMemoryArbitrationEnabled, false);
+  }
+
+  uint32_t driverCpuTimeSliceLimitMs() const {
+    return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
+  }
+
+  int32_t splitGroupAdmissionMemoryPct() const {
+    return get<int32_t>(kSplitGroupAdmissionMemoryPct, 100);
+  }
+
+  bool driverTimelineEnabled() const {
+    return get<bool>(kDriverTimelineEnabled, false);
+  }
+
+  int32_t compactStringBuffersMinLivePct() const {
+    return get<int32_t>(kCompactStringBuffersMinLivePct, 50);
+  }
+
   int32_t abandonPartialAggregationMinRows() const {
     return get<int32_t>(kAbandonPartialAggregationMinRows, 100'000);
   }
@@ -361,6 +617,10 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int64_t abandonPartialAggregationResampleRows() const {
+    return get<int64_t>(kAbandonPartialAggregationResampleRows, 1'000'000);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -403,6 +663,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  bool exchangeZeroCopyEnabled() const {
+    return get<bool>(kExchangeZeroCopyEnabled, false);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
@@ -421,10 +685,40 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchSizingEnabled() const {
+    return get<bool>(kAdaptiveOutputBatchSizingEnabled, false);
+  }
+
+  uint64_t adaptiveOutputBatchBytes() const {
+    static constexpr uint64_t kDefault = 1UL << 20;
+    return get<uint64_t>(kAdaptiveOutputBatchBytes, kDefault);
+  }
+
+  int32_t maxSplitPreloadPerDriver() const {
+    return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
+  }
+
+  bool filterProjectFusionEnabled() const {
+    return get<bool>(kFilterProjectFusionEnabled, false);
+  }
+
+  bool fragmentResultCacheEnabled() const {
+    return get<bool>(kFragmentResultCacheEnabled, false);
+  }
+
+  uint64_t fragmentResultCacheMaxSplitBytes() const {
+    static constexpr uint64_t kDefault = 8UL << 20;
+    return get<uint64_t>(kFragmentResultCacheMaxSplitBytes, kDefault);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
 
+  uint64_t tableScanSplitMorselBytes() const {
+    return get<uint64_t>(kTableScanSplitMorselBytes, 0);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -530,6 +824,12 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for MarkDistinct operator. Must also
+  /// check the spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
   /// Returns a percentage of aggregation or join input batches that will be
   /// forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -561,6 +861,10 @@ class QueryConfig {
         kMaxBits, get<uint8_t>(kJoinSpillPartitionBits, kDefaultBits));
   }
 
+  bool joinSpillPartitionPredictionEnabled() const {
+    return get<bool>(kJoinSpillPartitionPredictionEnabled, false);
+  }
+
   uint64_t writerFlushThresholdBytes() const {
     return get<uint64_t>(kWriterFlushThresholdBytes, 96L << 20);
   }
@@ -579,6 +883,19 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  std::string spillFileFormat() const {
+    return get<std::string>(kSpillFileFormat, "presto");
+  }
+
+  int32_t spillReadAheadBuffers() const {
+    return get<int32_t>(kSpillReadAheadBuffers, 0);
+  }
+
+  uint64_t maxSpillReadAheadBytes() const {
+    constexpr uint64_t kDefaultMaxReadAheadBytes = 64 << 20; // 64MB.
+    return get<uint64_t>(kMaxSpillReadAheadBytes, kDefaultMaxReadAheadBytes);
+  }
+
   uint64_t spillWriteBufferSize() const {
     // The default write buffer size set to 1MB.
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
@@ -641,6 +958,18 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  uint32_t exprProfileSampleRate() const {
+    return get<uint32_t>(kExprProfileSampleRate, 0);
+  }
+
+  bool exprFuseArithmetic() const {
+    return get<bool>(kExprFuseArithmetic, false);
+  }
+
+  uint32_t exprMaxMemoBaseSize() const {
+    return get<uint32_t>(kExprMaxMemoBaseSize, kDefaultExprMaxMemoBaseSize);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
@@ -658,10 +987,58 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashBuildBloomFilterMaxBytes() const {
+    return get<uint64_t>(kHashBuildBloomFilterMaxBytes, 0);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t hashProbePartitionedMinTableBytes() const {
+    return get<uint64_t>(kHashProbePartitionedMinTableBytes, 0);
+  }
+
+  bool hashJoinWideNormalizedKeyEnabled() const {
+    return get<bool>(kHashJoinWideNormalizedKeyEnabled, false);
+  }
+
+  bool hashJoinConcurrentBuildEnabled() const {
+    return get<bool>(kHashJoinConcurrentBuildEnabled, false);
+  }
+
+  uint64_t hashJoinHeavyHitterMinRows() const {
+    return get<uint64_t>(kHashJoinHeavyHitterMinRows, 0);
+  }
+
+  uint32_t hashProbeHeavyHitterTimeSliceMs() const {
+    return get<uint32_t>(kHashProbeHeavyHitterTimeSliceMs, 100);
+  }
+
+  bool hashTableInlineKeysEnabled() const {
+    return get<bool>(kHashTableInlineKeysEnabled, false);
+  }
+
+  uint32_t nestedLoopJoinBuildBlockRows() const {
+    return get<uint32_t>(kNestedLoopJoinBuildBlockRows, 0);
+  }
+
+  bool mergeJoinDictionaryOutputEnabled() const {
+    return get<bool>(kMergeJoinDictionaryOutputEnabled, false);
+  }
+
+  bool hashAggregationSharedTablesEnabled() const {
+    return get<bool>(kHashAggregationSharedTablesEnabled, false);
+  }
+
+  int32_t windowParallelism() const {
+    return get<int32_t>(kWindowParallelism, 1);
+  }
+
+  int32_t orderBySortParallelism() const {
+    return get<int32_t>(kOrderBySortParallelism, 1);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
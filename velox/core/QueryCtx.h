@@ -153,15 +153,25 @@ class QueryCtx {
 // Represents the state of one thread of query execution.
 class ExecCtx {
  public:
-  ExecCtx(memory::MemoryPool* pool, QueryCtx* queryCtx)
+  /// If 'parentVectorPool' is set, it receives the vectors that do not fit in
+  /// the vector pool of 'this' and is used to get recycled vectors before
+  /// allocating new ones. See VectorPool.
+  ExecCtx(
+      memory::MemoryPool* pool,
+      QueryCtx* queryCtx,
+      VectorPool* parentVectorPool = nullptr)
       : pool_(pool),
         queryCtx_(queryCtx),
         exprEvalCacheEnabled_(
             !queryCtx ||
             queryCtx->queryConfig().isExpressionEvaluationCacheEnabled()),
+        exprMaxMemoBaseSize_(
+            queryCtx ? queryCtx->queryConfig().exprMaxMemoBaseSize()
+                     : QueryConfig::kDefaultExprMaxMemoBaseSize),
         vectorPool_(
-            exprEvalCacheEnabled_ ? std::make_unique<VectorPool>(pool)
-                                  : nullptr) {}
+            exprEvalCacheEnabled_
+                ? std::make_unique<VectorPool>(pool, parentVectorPool)
+                : nullptr) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -265,12 +275,19 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// The maximum size of a dictionary base memoized by an expression. See
+  /// QueryConfig::kExprMaxMemoBaseSize.
+  uint32_t exprMaxMemoBaseSize() const {
+    return exprMaxMemoBaseSize_;
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
   QueryCtx* const queryCtx_;
 
   const bool exprEvalCacheEnabled_;
+  const uint32_t exprMaxMemoBaseSize_;
   // A pool of preallocated DecodedVectors for use by expressions and operators.
   std::vector<std::unique_ptr<DecodedVector>> decodedVectorPool_;
   // A pool of preallocated SelectivityVectors for use by expressions
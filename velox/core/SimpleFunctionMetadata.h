@@ -51,6 +51,17 @@ struct udf_is_default_ascii_behavior<
     util::detail::void_t<decltype(T::is_default_ascii_behavior)>>
     : std::integral_constant<bool, T::is_default_ascii_behavior> {};
 
+// Functions are not assumed to be safe to call in a loop without per-row
+// error handling unless specified explicitly.
+template <class T, class = void>
+struct udf_is_vectorizable : std::false_type {};
+
+template <class T>
+struct udf_is_vectorizable<
+    T,
+    util::detail::void_t<decltype(T::is_vectorizable)>>
+    : std::integral_constant<bool, T::is_vectorizable> {};
+
 // If a UDF doesn't declare a default help(),
 template <class T, class = void>
 struct udf_help {
@@ -652,6 +663,16 @@ class UDFHolder final
   static constexpr bool is_default_ascii_behavior =
       udf_is_default_ascii_behavior<Fun>();
 
+  // A vectorizable function never throws and never returns null. Its call()
+  // is invoked in a plain loop over the rows that the compiler can
+  // auto-vectorize.
+  static constexpr bool is_vectorizable = udf_is_vectorizable<Fun>();
+  static_assert(
+      !is_vectorizable ||
+          (udf_has_call_return_void && !udf_has_callNullable &&
+           !udf_has_callNullFree && !udf_has_callAscii),
+      "A vectorizable function must only provide a call() returning void.");
+
   template <typename T>
   struct ptrfy {
     using type = const T*;
@@ -206,6 +206,7 @@ void CacheInputStream::loadSync(Region region) {
       // missed, fall back to remote fetching.
       entry->setGroupId(groupId_);
       entry->setTrackingId(trackingId_);
+      entry->setSsdBypass(tracker_ != nullptr && tracker_->ssdBypass());
       if (loadFromSsd(region, *entry)) {
         return;
       }
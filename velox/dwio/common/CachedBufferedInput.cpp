@@ -165,6 +165,8 @@ void CachedBufferedInput::load(const LogType) {
   // Extra requests made for preloadable regions that are larger then
   // 'loadQuantum'.
   std::vector<std::unique_ptr<CacheRequest>> extraRequests;
+  // Pending loads of other readers that cover requests of 'this'.
+  StreamLoadMap sharedLoads;
   // We loop over access frequency buckets. For example readPct 80
   // will get all streams where 80% or more of the referenced data is
   // actually loaded.
@@ -186,7 +188,7 @@ void CachedBufferedInput::load(const LogType) {
         auto parts = makeRequestParts(
             request, trackingData, options_.loadQuantum(), extraRequests);
         for (auto part : parts) {
-          if (cache_->exists(part->key)) {
+          if (cache_->exists(part->key) || findSharedLoad(*part, sharedLoads)) {
             continue;
           }
           if (ssdFile) {
@@ -209,6 +211,31 @@ void CachedBufferedInput::load(const LogType) {
     makeLoads(std::move(storageLoad), isPrefetchPct(readPct));
     makeLoads(std::move(ssdLoad), isPrefetchPct(readPct));
   }
+  if (!sharedLoads.empty()) {
+    // A stream that has a load of its own triggers that one. Its parts that
+    // are loaded by other readers are waited for when accessed.
+    coalescedLoads_.withWLock([&](auto& loads) {
+      for (auto& [stream, load] : sharedLoads) {
+        loads.emplace(stream, std::move(load));
+      }
+    });
+  }
+}
+
+bool CachedBufferedInput::findSharedLoad(
+    const CacheRequest& request,
+    StreamLoadMap& sharedLoads) {
+  auto load = cache_->loadPlanner().find(request.key);
+  if (load == nullptr) {
+    return false;
+  }
+  if (ioStats_) {
+    ioStats_->sharedLoad().increment(request.size);
+  }
+  // A large request is split into parts. The stream triggers the load of
+  // its first part.
+  sharedLoads.emplace(request.stream, std::move(load));
+  return true;
 }
 
 void CachedBufferedInput::makeLoads(
@@ -284,6 +311,7 @@ void CachedBufferedInput::makeLoads(
     // CachedBufferedInput has multiple cycles of enqueues and loads.
     for (int32_t i = doneIndices.size() - 1; i >= 0; --i) {
       assert(!doneIndices.empty()); // lint
+      cache_->loadPlanner().remove(*allCoalescedLoads_[doneIndices[i]]);
       allCoalescedLoads_.erase(allCoalescedLoads_.begin() + doneIndices[i]);
     }
   }
@@ -381,10 +409,12 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
+      int32_t maxCoalesceDistance,
+      bool ssdBypass)
       : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        ssdBypass_(ssdBypass) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<CachePin> pins;
@@ -392,10 +422,14 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     cache_.makePins(
         keys_,
         [&](int32_t index) { return sizes_[index]; },
-        [&](int32_t /*index*/, CachePin pin) {
+        [&](int32_t index, CachePin pin) {
+          auto* entry = pin.checkedEntry();
           if (isPrefetch) {
-            pin.checkedEntry()->setPrefetch(true);
+            entry->setPrefetch(true);
           }
+          entry->setGroupId(groupId_);
+          entry->setTrackingId(requests_[index].trackingId);
+          entry->setSsdBypass(ssdBypass_);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -419,6 +453,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  const bool ssdBypass_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -472,9 +507,11 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        options_.maxCoalesceDistance(),
+        tracker_ != nullptr && tracker_->ssdBypass());
   }
   allCoalescedLoads_.push_back(load);
+  cache_->loadPlanner().add(load);
   coalescedLoads_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
       loads[request->stream] = load;
@@ -491,6 +528,8 @@ std::shared_ptr<cache::CoalescedLoad> CachedBufferedInput::coalescedLoad(
           return nullptr;
         }
         auto load = std::move(it->second);
+        // A load shared from another reader does not contain 'stream'.
+        loads.erase(stream);
         auto dwioLoad = dynamic_cast<DwioCoalescedLoadBase*>(load.get());
         for (auto& request : dwioLoad->requests()) {
           loads.erase(request.stream);
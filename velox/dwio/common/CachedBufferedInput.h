@@ -101,6 +101,7 @@ class CachedBufferedInput : public BufferedInput {
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
       load->cancel();
+      cache_->loadPlanner().remove(*load);
     }
   }
 
@@ -164,6 +165,10 @@ class CachedBufferedInput : public BufferedInput {
   }
 
  private:
+  using StreamLoadMap = folly::F14FastMap<
+      const SeekableInputStream*,
+      std::shared_ptr<cache::CoalescedLoad>>;
+
   // Sorts requests and makes CoalescedLoads for nearby requests. If 'prefetch'
   // is true, starts background loading.
   void makeLoads(std::vector<CacheRequest*> requests, bool prefetch);
@@ -175,6 +180,11 @@ class CachedBufferedInput : public BufferedInput {
 
   void readRegion(std::vector<CacheRequest*> requests, bool prefetch);
 
+  // Returns true if 'request' is covered by a pending load of another reader
+  // of the same file. Records the load in 'sharedLoads' for the stream of
+  // 'request'.
+  bool findSharedLoad(const CacheRequest& request, StreamLoadMap& sharedLoads);
+
   cache::AsyncDataCache* FOLLY_NONNULL cache_;
   const uint64_t fileNum_;
   std::shared_ptr<cache::ScanTracker> tracker_;
@@ -186,10 +196,7 @@ class CachedBufferedInput : public BufferedInput {
   std::vector<CacheRequest> requests_;
 
   // Coalesced loads spanning multiple cache entries in one IO.
-  folly::Synchronized<folly::F14FastMap<
-      const SeekableInputStream*,
-      std::shared_ptr<cache::CoalescedLoad>>>
-      coalescedLoads_;
+  folly::Synchronized<StreamLoadMap> coalescedLoads_;
 
   // Distinct coalesced loads in 'coalescedLoads_'.
   std::vector<std::shared_ptr<cache::CoalescedLoad>> allCoalescedLoads_;
@@ -160,6 +160,9 @@ class IntDecoder {
   int64_t readVsLong();
   int64_t readLongLE();
 
+  // Reads a 16 byte little endian value. 'numBytes' must be 16.
+  int128_t readInt128LE();
+
   template <typename cppType>
   cppType readLittleEndianFromBigEndian();
 
@@ -354,6 +357,22 @@ inline int64_t IntDecoder<isSigned>::readLongLE() {
   return result;
 }
 
+template <bool isSigned>
+inline int128_t IntDecoder<isSigned>::readInt128LE() {
+  VELOX_DCHECK_EQ(numBytes, sizeof(int128_t));
+  int128_t result;
+  if (bufferStart && bufferStart + sizeof(int128_t) <= bufferEnd) {
+    memcpy(&result, bufferStart, sizeof(int128_t));
+    bufferStart += sizeof(int128_t);
+    return result;
+  }
+  auto bytes = reinterpret_cast<char*>(&result);
+  for (auto i = 0; i < sizeof(int128_t); ++i) {
+    bytes[i] = readByte();
+  }
+  return result;
+}
+
 template <bool isSigned>
 template <typename cppType>
 inline cppType IntDecoder<isSigned>::readLittleEndianFromBigEndian() {
@@ -440,7 +459,7 @@ inline T IntDecoder<isSigned>::readInt() {
     return readLittleEndianFromBigEndian<T>();
   } else {
     if constexpr (std::is_same_v<T, int128_t>) {
-      VELOX_NYI();
+      return readInt128LE();
     }
     return readLongLE();
   }
@@ -117,6 +117,12 @@ class RowReaderOptions {
   // 'ioExecutor' enables parallelism when performing file system read
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
+  std::shared_ptr<folly::Executor> ioExecutor_;
+  // Number of stripes after the current one that are fetched on 'ioExecutor_'
+  // while the current stripe is read. 0 disables read ahead.
+  uint32_t numStripesAhead_ = 0;
+  // Maximum total size of the stripes being read ahead.
+  uint64_t stripesAheadMemoryBytes_ = 256 << 20;
   bool appendRowNumberColumn_ = false;
   // Function to populate metrics related to feature projection stats
   // in Koski. This gets fired in FlatMapColumnReader.
@@ -308,6 +314,31 @@ class RowReaderOptions {
     decodingExecutor_ = executor;
   }
 
+  void setIOExecutor(std::shared_ptr<folly::Executor> executor) {
+    ioExecutor_ = std::move(executor);
+  }
+
+  /// Sets the number of stripes after the current one that are fetched on the
+  /// IO executor while the current stripe is being read. Has no effect
+  /// without an IO executor.
+  void setNumStripesAhead(uint32_t numStripes) {
+    numStripesAhead_ = numStripes;
+  }
+
+  uint32_t getNumStripesAhead() const {
+    return numStripesAhead_;
+  }
+
+  /// Sets the maximum total size of the stripes that are read ahead. A stripe
+  /// is not read ahead if it would take the total over 'bytes'.
+  void setStripesAheadMemoryBytes(uint64_t bytes) {
+    stripesAheadMemoryBytes_ = bytes;
+  }
+
+  uint64_t getStripesAheadMemoryBytes() const {
+    return stripesAheadMemoryBytes_;
+  }
+
   /*
    * Set to true, if you want to add a new column to the results containing the
    * row numbers.  These row numbers are relative to the beginning of file (0 as
@@ -363,6 +394,10 @@ class RowReaderOptions {
   const std::shared_ptr<folly::Executor>& getDecodingExecutor() const {
     return decodingExecutor_;
   }
+
+  const std::shared_ptr<folly::Executor>& getIOExecutor() const {
+    return ioExecutor_;
+  }
 };
 
 /**
@@ -23,6 +23,10 @@
 namespace facebook::velox::dwio::common {
 
 /// Sorting Writer object is used to write sorted data into a single file.
+/// Input is buffered in 'sortBuffer' which spills sorted runs to disk when its
+/// memory limit is exceeded or memory is reclaimed. On close, the in-memory and
+/// spilled runs are merged and streamed into the underlying writer in batches,
+/// so the sorted output is never materialized as a whole.
 class SortingWriter : public Writer {
  public:
   SortingWriter(
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/common/compression/Codec.h"
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/IntCodecCommon.h"
 #include "velox/dwio/common/compression/PagedInputStream.h"
@@ -35,6 +36,26 @@ using memory::MemoryPool;
 
 namespace {
 
+// Decompresses with the calling thread's codec for 'kind', so that the
+// decompression of all streams on the thread shares the codec state and a
+// registered codec, e.g. with hardware offload, is used. 'destLength' is the
+// space in 'dest'.
+uint64_t decompressWithCodec(
+    CompressionKind kind,
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength,
+    const std::string& streamDebugInfo) {
+  auto* codec = velox::common::threadLocalCodec(kind);
+  DWIO_ENSURE_NOT_NULL(codec);
+  try {
+    return codec->decompress(src, srcLength, dest, destLength);
+  } catch (const VeloxException& e) {
+    DWIO_RAISE(e.message(), " Info: ", streamDebugInfo);
+  }
+}
+
 class ZstdCompressor : public Compressor {
  public:
   explicit ZstdCompressor(int32_t level) : Compressor{level} {}
@@ -380,20 +401,18 @@ uint64_t Lz4Decompressor::decompressInternal(
     uint64_t srcLength,
     char* dest,
     uint64_t destLength) {
-  int32_t result = LZ4_decompress_safe(
+  return decompressWithCodec(
+      velox::common::CompressionKind_LZ4,
       src,
+      srcLength,
       dest,
-      static_cast<int32_t>(srcLength),
-      static_cast<int32_t>(destLength));
-
-  DWIO_ENSURE_GE(
-      result, 0, "lz4 failed to decompress. Info: ", streamDebugInfo_);
-  return static_cast<uint64_t>(result);
+      destLength,
+      streamDebugInfo_);
 }
 
-// NOTE: We do not keep `ZSTD_DCtx' around on purpose, because if we keep it
-// around, in flat map column reader we have hundreds of thousands of
-// decompressors at same time and causing OOM.
+// NOTE: The `ZSTD_DCtx' is per thread, not per decompressor, because in flat
+// map column reader we have hundreds of thousands of decompressors at same
+// time and would run out of memory.
 class ZstdDecompressor : public Decompressor {
  public:
   explicit ZstdDecompressor(
@@ -417,14 +436,13 @@ uint64_t ZstdDecompressor::decompress(
     uint64_t srcLength,
     char* dest,
     uint64_t destLength) {
-  auto ret = ZSTD_decompress(dest, destLength, src, srcLength);
-  DWIO_ENSURE(
-      !ZSTD_isError(ret),
-      "ZSTD returned an error: ",
-      ZSTD_getErrorName(ret),
-      " Info: ",
+  return decompressWithCodec(
+      velox::common::CompressionKind_ZSTD,
+      src,
+      srcLength,
+      dest,
+      destLength,
       streamDebugInfo_);
-  return ret;
 }
 
 std::pair<int64_t, bool> ZstdDecompressor::getDecompressedLength(
@@ -470,11 +488,13 @@ uint64_t SnappyDecompressor::decompress(
     uint64_t destLength) {
   auto [length, _] = getDecompressedLength(src, srcLength);
   DWIO_ENSURE_GE(destLength, length);
-  DWIO_ENSURE(
-      snappy::RawUncompress(src, srcLength, dest),
-      "Snappy decompress failed. Info: ",
+  return decompressWithCodec(
+      velox::common::CompressionKind_SNAPPY,
+      src,
+      srcLength,
+      dest,
+      destLength,
       streamDebugInfo_);
-  return length;
 }
 
 std::pair<int64_t, bool> SnappyDecompressor::getDecompressedLength(
@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::dwrf {
+
+namespace {
+
+// Murmur3 constants as used by the Hive/ORC 64 bit variant.
+constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+constexpr uint32_t kR1 = 31;
+constexpr uint32_t kR2 = 27;
+constexpr uint64_t kM = 5;
+constexpr uint64_t kN1 = 0x52dce729;
+constexpr uint64_t kSeed = 104729;
+
+inline uint64_t rotl64(uint64_t value, uint32_t shift) {
+  return (value << shift) | (value >> (64 - shift));
+}
+
+inline uint64_t mixK(uint64_t k) {
+  k *= kC1;
+  k = rotl64(k, kR1);
+  k *= kC2;
+  return k;
+}
+
+inline uint64_t fmix64(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+uint64_t optimalNumBits(uint64_t expectedEntries, double fpp) {
+  return static_cast<uint64_t>(
+      -static_cast<double>(expectedEntries) * std::log(fpp) /
+      (std::log(2.0) * std::log(2.0)));
+}
+
+uint32_t optimalNumHashFunctions(uint64_t expectedEntries, uint64_t numBits) {
+  return std::max<uint32_t>(
+      1,
+      static_cast<uint32_t>(std::round(
+          static_cast<double>(numBits) / expectedEntries * std::log(2.0))));
+}
+
+template <typename TestFunc>
+bool testAny(const std::vector<int64_t>& values, TestFunc test) {
+  for (auto value : values) {
+    if (test(value)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+BloomFilter::BloomFilter(uint64_t expectedEntries, double fpp) {
+  VELOX_CHECK_GT(expectedEntries, 0);
+  VELOX_CHECK(fpp > 0.0 && fpp < 1.0, "Invalid Bloom filter fpp: {}", fpp);
+  const auto numWords =
+      (std::max<uint64_t>(optimalNumBits(expectedEntries, fpp), 1) + 63) / 64;
+  bits_.resize(numWords);
+  numHashFunctions_ = optimalNumHashFunctions(expectedEntries, numWords * 64);
+}
+
+BloomFilter::BloomFilter(const proto::BloomFilter& proto)
+    : numHashFunctions_{proto.numhashfunctions()} {
+  if (proto.has_utf8bitset()) {
+    const auto& bytes = proto.utf8bitset();
+    VELOX_CHECK_EQ(bytes.size() % sizeof(uint64_t), 0, "Invalid Bloom filter");
+    bits_.resize(bytes.size() / sizeof(uint64_t));
+    for (auto i = 0; i < bits_.size(); ++i) {
+      bits_[i] = folly::Endian::little(
+          folly::loadUnaligned<uint64_t>(bytes.data() + i * sizeof(uint64_t)));
+    }
+  } else {
+    bits_.assign(proto.bitset().begin(), proto.bitset().end());
+  }
+  VELOX_CHECK(!bits_.empty(), "Empty Bloom filter");
+  VELOX_CHECK_GT(numHashFunctions_, 0, "Invalid Bloom filter");
+}
+
+// static
+uint64_t BloomFilter::hashLong(int64_t value) {
+  auto key = static_cast<uint64_t>(value);
+  key = (~key) + (key << 21);
+  key ^= key >> 24;
+  key = (key + (key << 3)) + (key << 8);
+  key ^= key >> 14;
+  key = (key + (key << 2)) + (key << 4);
+  key ^= key >> 28;
+  key += key << 31;
+  return key;
+}
+
+// static
+uint64_t BloomFilter::hashBytes(const char* data, size_t size) {
+  auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  uint64_t h = kSeed;
+  const size_t numBlocks = size / 8;
+  for (size_t i = 0; i < numBlocks; ++i) {
+    auto k =
+        folly::Endian::little(folly::loadUnaligned<uint64_t>(bytes + i * 8));
+    h ^= mixK(k);
+    h = rotl64(h, kR2) * kM + kN1;
+  }
+  uint64_t k = 0;
+  const size_t tail = numBlocks * 8;
+  switch (size - tail) {
+    case 7:
+      k ^= static_cast<uint64_t>(bytes[tail + 6]) << 48;
+      [[fallthrough]];
+    case 6:
+      k ^= static_cast<uint64_t>(bytes[tail + 5]) << 40;
+      [[fallthrough]];
+    case 5:
+      k ^= static_cast<uint64_t>(bytes[tail + 4]) << 32;
+      [[fallthrough]];
+    case 4:
+      k ^= static_cast<uint64_t>(bytes[tail + 3]) << 24;
+      [[fallthrough]];
+    case 3:
+      k ^= static_cast<uint64_t>(bytes[tail + 2]) << 16;
+      [[fallthrough]];
+    case 2:
+      k ^= static_cast<uint64_t>(bytes[tail + 1]) << 8;
+      [[fallthrough]];
+    case 1:
+      k ^= static_cast<uint64_t>(bytes[tail]);
+      h ^= mixK(k);
+      break;
+    default:
+      break;
+  }
+  h ^= size;
+  return fmix64(h);
+}
+
+void BloomFilter::addHash(uint64_t hash) {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto pos = static_cast<uint64_t>(combined) % numBits;
+    bits_[pos / 64] |= 1ULL << (pos % 64);
+  }
+}
+
+bool BloomFilter::testHash(uint64_t hash) const {
+  const auto hash1 = static_cast<uint32_t>(hash);
+  const auto hash2 = static_cast<uint32_t>(hash >> 32);
+  const auto numBits = this->numBits();
+  for (uint32_t i = 1; i <= numHashFunctions_; ++i) {
+    auto combined = static_cast<int32_t>(hash1 + i * hash2);
+    if (combined < 0) {
+      combined = ~combined;
+    }
+    const auto pos = static_cast<uint64_t>(combined) % numBits;
+    if ((bits_[pos / 64] & (1ULL << (pos % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::reset() {
+  std::fill(bits_.begin(), bits_.end(), 0);
+}
+
+void BloomFilter::toProto(proto::BloomFilter& proto) const {
+  proto.set_numhashfunctions(numHashFunctions_);
+  proto.mutable_bitset()->Reserve(bits_.size());
+  for (auto word : bits_) {
+    proto.add_bitset(word);
+  }
+}
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter) {
+  if (filter.testNull()) {
+    return true;
+  }
+  auto testLong = [&](int64_t value) { return bloomFilter.testLong(value); };
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      const auto& range = static_cast<const common::BigintRange&>(filter);
+      return !range.isSingleValue() || testLong(range.lower());
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return testAny(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values(),
+          testLong);
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return testAny(
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values(),
+          testLong);
+    case common::FilterKind::kBytesRange: {
+      const auto& range = static_cast<const common::BytesRange&>(filter);
+      return !range.isSingleValue() ||
+          bloomFilter.testBytes(range.lower().data(), range.lower().size());
+    }
+    case common::FilterKind::kBytesValues: {
+      const auto& values =
+          static_cast<const common::BytesValues&>(filter).values();
+      for (const auto& value : values) {
+        if (bloomFilter.testBytes(value.data(), value.size())) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::dwrf
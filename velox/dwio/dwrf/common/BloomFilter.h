@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+
+namespace facebook::velox::common {
+class Filter;
+}
+
+namespace facebook::velox::dwrf {
+
+/// Bloom filter of the values of a column in a row index stride. The layout
+/// and hashing follow the ORC specification, so that filters written here are
+/// understood by other ORC/DWRF readers: strings are hashed with Murmur3
+/// (64 bit), integers with Thomas Wang's 64 bit integer hash, and each value
+/// sets 'numHashFunctions' bits derived from the two 32 bit halves of the
+/// hash.
+class BloomFilter {
+ public:
+  /// Creates an empty filter sized for 'expectedEntries' distinct values at
+  /// a false positive probability of 'fpp'.
+  BloomFilter(uint64_t expectedEntries, double fpp);
+
+  /// Reads a filter written by toProto().
+  explicit BloomFilter(const proto::BloomFilter& proto);
+
+  void addLong(int64_t value) {
+    addHash(hashLong(value));
+  }
+
+  void addBytes(const char* data, size_t size) {
+    addHash(hashBytes(data, size));
+  }
+
+  bool testLong(int64_t value) const {
+    return testHash(hashLong(value));
+  }
+
+  bool testBytes(const char* data, size_t size) const {
+    return testHash(hashBytes(data, size));
+  }
+
+  /// Clears all bits, keeping the size.
+  void reset();
+
+  void toProto(proto::BloomFilter& proto) const;
+
+  uint32_t numHashFunctions() const {
+    return numHashFunctions_;
+  }
+
+  uint64_t numBits() const {
+    return bits_.size() * 64;
+  }
+
+  static uint64_t hashLong(int64_t value);
+
+  static uint64_t hashBytes(const char* data, size_t size);
+
+ private:
+  void addHash(uint64_t hash);
+
+  bool testHash(uint64_t hash) const;
+
+  uint32_t numHashFunctions_;
+  std::vector<uint64_t> bits_;
+};
+
+/// Returns false if no value accepted by 'filter' can be in 'bloomFilter'.
+/// Only equality and IN filters on integers and strings are tested, all other
+/// filters return true. Filters that accept nulls return true as well since
+/// nulls are not added to Bloom filters.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter);
+
+} // namespace facebook::velox::dwrf
@@ -47,6 +47,10 @@ class Config : public common::ConfigBase<Config> {
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
   static Entry<bool> DICTIONARY_SORT_KEYS;
+  /// Number of values of a string column after which the dictionary encoding
+  /// decision is made on the values seen so far, instead of at the end of the
+  /// first stripe. 0 disables the early decision.
+  static Entry<uint32_t> DICTIONARY_STRING_SAMPLE_SIZE;
   static Entry<float> ENTROPY_KEY_STRING_SIZE_THRESHOLD;
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
@@ -60,6 +64,11 @@ class Config : public common::ConfigBase<Config> {
   static Entry<const std::vector<std::vector<std::string>>>
       MAP_FLAT_COLS_STRUCT_KEYS;
   static Entry<uint32_t> MAP_FLAT_MAX_KEYS;
+  /// Top level columns for which a Bloom filter is written per row index
+  /// stride. Applies to integer and string columns.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLUMNS;
+  /// False positive probability of the Bloom filters of BLOOM_FILTER_COLUMNS.
+  static Entry<float> BLOOM_FILTER_FPP;
   static Entry<uint64_t> MAX_DICTIONARY_SIZE;
   static Entry<uint64_t> STRIPE_SIZE;
   /// With this config, we don't even try the more memory intensive encodings on
@@ -425,34 +425,36 @@ uint64_t RleDecoderV2<isSigned>::nextPatched(
 
   uint64_t nRead = std::min(runLength - runRead, numValues);
 
-  for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
-    // skip null positions
-    if (nulls && bits::isBitNull(nulls, pos)) {
-      continue;
+  if (!nulls) {
+    // Add the base to all values in one loop and then patch the few values
+    // that have a patch in the range.
+    const auto* values = unpacked.data() + unpackedIdx;
+    auto* result = data + offset;
+    for (uint64_t i = 0; i < nRead; ++i) {
+      result[i] = base + values[i];
     }
-    if (static_cast<int64_t>(unpackedIdx) != actualGap) {
-      // no patching required. add base to unpacked value to get final value
-      data[pos] = base + unpacked[unpackedIdx];
-    } else {
-      // extract the patch value
-      int64_t patchedVal = unpacked[unpackedIdx] | (curPatch << bitSize);
-
-      // add base to patched value
-      data[pos] = base + patchedVal;
-
-      // increment the patch to point to next entry in patch list
+    const uint64_t end = unpackedIdx + nRead;
+    while (patchIdx < unpackedPatch.size() &&
+           static_cast<uint64_t>(actualGap) < end) {
+      const uint64_t patched = actualGap;
+      result[patched - unpackedIdx] =
+          base + (unpacked[patched] | (curPatch << bitSize));
       ++patchIdx;
-
       if (patchIdx < unpackedPatch.size()) {
         adjustGapAndPatch();
-
-        // next gap is relative to the current gap
-        actualGap += unpackedIdx;
+        actualGap += patched;
       }
     }
+    runRead += nRead;
+    unpackedIdx = end;
+    return nRead;
+  }
 
-    ++runRead;
-    ++unpackedIdx;
+  for (uint64_t pos = offset; pos < offset + nRead; ++pos) {
+    // skip null positions
+    if (!bits::isBitNull(nulls, pos)) {
+      data[pos] = nextPatchedValue();
+    }
   }
 
   return nRead;
@@ -520,7 +522,20 @@ uint64_t RleDecoderV2<isSigned>::nextDelta(
     ++runRead;
   }
 
-  if (bitSize == 0) {
+  if (bitSize == 0 && !nulls) {
+    // Each value is a multiple of the fixed delta away from 'prevValue' which
+    // lets the loop vectorize. Unsigned arithmetic wraps like repeated adds.
+    const auto start = static_cast<uint64_t>(prevValue);
+    const auto delta = static_cast<uint64_t>(deltaBase);
+    const uint64_t count = offset + nRead - pos;
+    for (uint64_t i = 0; i < count; ++i) {
+      data[pos + i] = static_cast<int64_t>(start + (i + 1) * delta);
+    }
+    if (count > 0) {
+      prevValue = data[pos + count - 1];
+      runRead += count;
+    }
+  } else if (bitSize == 0) {
     // add fixed deltas to adjacent values
     for (; pos < offset + nRead; ++pos) {
       // skip null positions
@@ -549,7 +564,22 @@ uint64_t RleDecoderV2<isSigned>::nextDelta(
     uint64_t remaining = (offset + nRead) - pos;
     runRead += readLongs(data, pos, remaining, bitSize, nulls);
 
-    if (deltaBase < 0) {
+    if (!nulls) {
+      // Prefix sum of the deltas without checking for nulls.
+      auto value = static_cast<uint64_t>(prevValue);
+      if (deltaBase < 0) {
+        for (; pos < offset + nRead; ++pos) {
+          value -= static_cast<uint64_t>(data[pos]);
+          data[pos] = static_cast<int64_t>(value);
+        }
+      } else {
+        for (; pos < offset + nRead; ++pos) {
+          value += static_cast<uint64_t>(data[pos]);
+          data[pos] = static_cast<int64_t>(value);
+        }
+      }
+      prevValue = static_cast<int64_t>(value);
+    } else if (deltaBase < 0) {
       for (; pos < offset + nRead; ++pos) {
         // skip null positions
         if (nulls && bits::isBitNull(nulls, pos)) {
@@ -583,7 +613,7 @@ template uint64_t RleDecoderV2<false>::nextDelta(
     const uint64_t* const nulls);
 
 template <bool isSigned>
-int64_t RleDecoderV2<isSigned>::readValue() {
+int64_t RleDecoderV2<isSigned>::readValueSlow() {
   if (runRead == runLength) {
     resetRun();
   }
@@ -610,8 +640,8 @@ int64_t RleDecoderV2<isSigned>::readValue() {
   return value;
 }
 
-template int64_t RleDecoderV2<true>::readValue();
+template int64_t RleDecoderV2<true>::readValueSlow();
 
-template int64_t RleDecoderV2<false>::readValue();
+template int64_t RleDecoderV2<false>::readValueSlow();
 
 } // namespace facebook::velox::dwrf
@@ -168,6 +168,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t len,
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
+    if (!nulls && fb <= 56) {
+      readLongsNoNulls(data + offset, len, fb);
+      return len;
+    }
     uint64_t ret = 0;
 
     // TODO: unroll to improve performance
@@ -199,6 +203,52 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Unpacks 'len' big endian values of 'fb' bits into 'data'. Keeps a 64 bit
+  // window of input bits so that each value is extracted with one shift and
+  // mask instead of a byte at a time. 'fb' is at most 56 so that a value and
+  // the bits left over from the previous byte fit in the window.
+  void readLongsNoNulls(int64_t* data, uint64_t len, uint64_t fb) {
+    const uint64_t mask = (1ULL << fb) - 1;
+    uint64_t window = curByte & ((1U << bitsLeft) - 1);
+    uint32_t windowBits = bitsLeft;
+    for (uint64_t i = 0; i < len; ++i) {
+      while (windowBits < fb) {
+        window = (window << 8) | readByte();
+        windowBits += 8;
+      }
+      windowBits -= fb;
+      data[i] = static_cast<int64_t>((window >> windowBits) & mask);
+    }
+    // Less than 8 bits are left, all in the last byte read.
+    bitsLeft = windowBits;
+    curByte = window & 0xff;
+  }
+
+  // Returns the next value of a PATCHED_BASE run whose header has been read.
+  int64_t nextPatchedValue() {
+    int64_t value;
+    if (static_cast<int64_t>(unpackedIdx) != actualGap) {
+      // no patching required. add base to unpacked value to get final value
+      value = base + unpacked[unpackedIdx];
+    } else {
+      // add base to the patched value
+      value = base + (unpacked[unpackedIdx] | (curPatch << bitSize));
+
+      // increment the patch to point to next entry in patch list
+      ++patchIdx;
+
+      if (patchIdx < unpackedPatch.size()) {
+        adjustGapAndPatch();
+
+        // next gap is relative to the current gap
+        actualGap += unpackedIdx;
+      }
+    }
+    ++runRead;
+    ++unpackedIdx;
+    return value;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -220,7 +270,29 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t numValues,
       const uint64_t* nulls);
 
-  int64_t readValue();
+  // Returns the next value. Values inside PATCHED_BASE and DELTA runs are
+  // decoded inline since the visitor path reads one value at a time.
+  int64_t readValue() {
+    if (runRead > 0 && runRead < runLength) {
+      if (type == DELTA) {
+        ++runRead;
+        if (bitSize == 0 || runRead == 2) {
+          // Fixed delta run or the second value of a run.
+          return prevValue += deltaBase;
+        }
+        int64_t delta;
+        readLongs(&delta, 0, 1, bitSize);
+        return prevValue =
+                   deltaBase < 0 ? prevValue - delta : prevValue + delta;
+      }
+      if (type == PATCHED_BASE) {
+        return nextPatchedValue();
+      }
+    }
+    return readValueSlow();
+  }
+
+  int64_t readValueSlow();
 
   unsigned char firstByte;
   uint64_t runLength;
@@ -93,6 +93,11 @@ DwrfRowReader::DwrfRowReader(
   }
   stripeLoadStatuses_ = folly::Synchronized(
       std::vector<FetchStatus>(numberOfStripes, FetchStatus::NOT_STARTED));
+
+  if (options_.getIOExecutor() && options_.getNumStripesAhead() > 0) {
+    readAheadBarrier_ = std::make_unique<dwio::common::ExecutorBarrier>(
+        options_.getIOExecutor());
+  }
 }
 
 uint64_t DwrfRowReader::seekToRow(uint64_t rowNumber) {
@@ -104,6 +109,7 @@ uint64_t DwrfRowReader::seekToRow(uint64_t rowNumber) {
   DWIO_ENSURE(
       !prefetchHasOccurred_,
       "Prefetch already called. Currently, seek after prefetch is disallowed in DwrfRowReader");
+  discardStripesAhead();
 
   // If we are reading only a portion of the file
   // (bounded by firstStripe and lastStripe),
@@ -526,7 +532,7 @@ DwrfRowReader::FetchResult DwrfRowReader::fetch(uint32_t stripeIndex) {
   // during column reader construction
   // if planReads is off which means stripe data loaded as whole
   if (!preload) {
-    VLOG(1) << "[DWRF] Load read plan for stripe " << currentStripe;
+    VLOG(1) << "[DWRF] Load read plan for stripe " << stripeIndex;
     stripeStreams.loadReadPlan();
   }
 
@@ -573,6 +579,12 @@ void DwrfRowReader::safeFetchNextStripe() {
     VLOG(1) << "Waiting on baton for stripe: " << currentStripe;
     stripeLoadBatons_[currentStripe]->wait();
     VLOG(1) << "Acquired baton for stripe " << currentStripe;
+    if (!prefetchedStripeStates_.rlock()->contains(currentStripe)) {
+      // Reading the stripe ahead failed. Fetch it on this thread so that the
+      // error, if any, is seen by the reader.
+      stripeLoadBatons_[currentStripe] = std::make_unique<folly::Baton<>>();
+      fetch(currentStripe);
+    }
   }
   auto reportBlockedOnIoMetric = options_.getBlockedOnIoCallback();
   if (reportBlockedOnIoMetric) {
@@ -621,6 +633,12 @@ void DwrfRowReader::startNextStripe() {
   DWIO_ENSURE(freeStripeAt(currentStripe));
 
   newStripeReadyForRead = true;
+  auto it = stripesAheadBytes_.find(currentStripe);
+  if (it != stripesAheadBytes_.end()) {
+    totalStripesAheadBytes_ -= it->second;
+    stripesAheadBytes_.erase(it);
+  }
+  readStripesAhead();
   auto endTime = std::chrono::high_resolution_clock::now();
   VLOG(1) << " time to complete startNextStripe: "
           << std::chrono::duration_cast<std::chrono::microseconds>(
@@ -628,6 +646,65 @@ void DwrfRowReader::startNextStripe() {
                  .count();
 }
 
+void DwrfRowReader::readStripesAhead() {
+  if (!readAheadBarrier_) {
+    return;
+  }
+  auto& footer = getReader().getFooter();
+  const auto endStripe = std::min<uint64_t>(
+      lastStripe,
+      static_cast<uint64_t>(currentStripe) + 1 +
+          options_.getNumStripesAhead());
+  for (uint32_t stripeIndex = currentStripe + 1; stripeIndex < endStripe;
+       ++stripeIndex) {
+    if (stripesAheadBytes_.contains(stripeIndex) ||
+        stripeLoadStatuses_.rlock()->at(stripeIndex) !=
+            FetchStatus::NOT_STARTED) {
+      continue;
+    }
+    auto stripe = footer.stripes(stripeIndex);
+    const uint64_t bytes =
+        stripe.indexLength() + stripe.dataLength() + stripe.footerLength();
+    if (totalStripesAheadBytes_ + bytes >
+        options_.getStripesAheadMemoryBytes()) {
+      break;
+    }
+    stripesAheadBytes_[stripeIndex] = bytes;
+    totalStripesAheadBytes_ += bytes;
+    readAheadBarrier_->add(
+        [this, stripeIndex]() { readStripeAhead(stripeIndex); });
+  }
+}
+
+void DwrfRowReader::readStripeAhead(uint32_t stripeIndex) {
+  try {
+    fetch(stripeIndex);
+  } catch (const std::exception& e) {
+    VLOG(1) << "Read ahead of stripe " << stripeIndex
+            << " failed: " << e.what();
+    stripeLoadStatuses_.wlock()->operator[](stripeIndex) =
+        FetchStatus::NOT_STARTED;
+    stripeLoadBatons_[stripeIndex]->post();
+  }
+}
+
+void DwrfRowReader::discardStripesAhead() {
+  if (!readAheadBarrier_ || stripesAheadBytes_.empty()) {
+    return;
+  }
+  // readStripeAhead() does not throw.
+  readAheadBarrier_->waitAll();
+  for (auto& [stripeIndex, _] : stripesAheadBytes_) {
+    prefetchedStripeStates_.wlock()->erase(stripeIndex);
+    freeStripeAt(stripeIndex);
+    stripeLoadBatons_[stripeIndex] = std::make_unique<folly::Baton<>>();
+    stripeLoadStatuses_.wlock()->operator[](stripeIndex) =
+        FetchStatus::NOT_STARTED;
+  }
+  stripesAheadBytes_.clear();
+  totalStripesAheadBytes_ = 0;
+}
+
 size_t DwrfRowReader::estimatedReaderMemory() const {
   return 2 * DwrfReader::getMemoryUse(getReader(), -1, *columnSelector_);
 }
@@ -18,6 +18,7 @@
 
 #include "folly/Executor.h"
 #include "folly/synchronization/Baton.h"
+#include "velox/dwio/common/ExecutorBarrier.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/dwrf/reader/SelectiveDwrfReader.h"
 
@@ -131,6 +132,18 @@ class DwrfRowReader : public StrideIndexProvider,
   FetchResult fetch(uint32_t stripeIndex);
   FetchResult prefetch(uint32_t stripeToFetch);
 
+  // Schedules fetch() of up to getNumStripesAhead() stripes after
+  // 'currentStripe' on the IO executor, within the read ahead memory budget.
+  void readStripesAhead();
+
+  // Fetches 'stripeIndex' on the IO executor. On error the stripe is left to be
+  // fetched again by the thread that reads it, which then gets the error.
+  void readStripeAhead(uint32_t stripeIndex);
+
+  // Waits for the stripes being read ahead and drops them. Called before a
+  // seek, which reloads the stripes it lands on.
+  void discardStripesAhead();
+
   // footer
   std::vector<uint64_t> firstRowOfStripe;
   mutable std::shared_ptr<const dwio::common::TypeWithId> selectedSchema;
@@ -194,6 +207,16 @@ class DwrfRowReader : public StrideIndexProvider,
 
   dwio::common::ColumnReaderStatistics columnReaderStatistics_;
 
+  // Sizes of the stripes read ahead and not yet started, keyed on stripe
+  // index. Only accessed on the thread that reads 'this'.
+  folly::F14FastMap<uint32_t, uint64_t> stripesAheadBytes_;
+  uint64_t totalStripesAheadBytes_{0};
+
+  // Runs the read ahead fetches. Set if there is an IO executor and
+  // getNumStripesAhead() > 0. Declared last so that its destructor waits for
+  // pending fetches before the state they use is destroyed.
+  std::unique_ptr<dwio::common::ExecutorBarrier> readAheadBarrier_;
+
   // internal methods
 
   std::optional<size_t> estimatedRowSizeHelper(
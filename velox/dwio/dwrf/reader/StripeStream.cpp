@@ -166,7 +166,11 @@ void StripeStreamsImpl::loadStreams() {
       offset = stream.offset();
     }
     if (projectedNodes.contains(stream.node())) {
-      streams_[stream] = {offset, stream};
+      DwrfStreamIdentifier id{stream};
+      if (streams_.insert_or_assign(id, StreamInformationImpl{offset, stream})
+              .second) {
+        nodeStreams_[stream.node()].push_back(id);
+      }
     }
     offset += stream.length();
   };
@@ -312,15 +316,14 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
     uint32_t node,
     std::function<void(const StreamInformation&)> visitor) const {
-  uint32_t count = 0;
-  for (auto& item : streams_) {
-    if (item.first.encodingKey().node() == node) {
-      visitor(item.second);
-      ++count;
-    }
+  auto it = nodeStreams_.find(node);
+  if (it == nodeStreams_.end()) {
+    return 0;
   }
-
-  return count;
+  for (const auto& id : it->second) {
+    visitor(streams_.at(id));
+  }
+  return it->second.size();
 }
 
 bool StripeStreamsImpl::getUseVInts(const DwrfStreamIdentifier& si) const {
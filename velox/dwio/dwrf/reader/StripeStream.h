@@ -241,6 +241,10 @@ class StripeStreamsImpl : public StripeStreamsBase {
       StreamInformationImpl,
       dwio::common::StreamIdentifierHash>
       streams_;
+  // Ids of the streams in 'streams_' by node, so that visiting the streams of
+  // a node, e.g. the keys of a flat map, does not scan all streams of the
+  // stripe.
+  folly::F14FastMap<uint32_t, std::vector<DwrfStreamIdentifier>> nodeStreams_;
   folly::F14FastMap<EncodingKey, uint32_t, EncodingKeyHash> encodings_;
   folly::F14FastMap<EncodingKey, proto::ColumnEncoding, EncodingKeyHash>
       decryptedEncodings_;
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <folly/lang/Bits.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+#include "velox/type/Filter.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+TEST(BloomFilterTests, addAndTest) {
+  // 1000 integers and 1000 strings.
+  BloomFilter filter{2'000, 0.05};
+  EXPECT_EQ(filter.numBits() % 64, 0);
+  EXPECT_GT(filter.numHashFunctions(), 0);
+  for (int64_t i = 0; i < 1'000; ++i) {
+    filter.addLong(i * 3);
+    auto value = fmt::format("value_{}", i * 3);
+    filter.addBytes(value.data(), value.size());
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 3'000; ++i) {
+    auto value = fmt::format("value_{}", i);
+    if (i % 3 == 0) {
+      // No false negatives.
+      EXPECT_TRUE(filter.testLong(i));
+      EXPECT_TRUE(filter.testBytes(value.data(), value.size()));
+    } else {
+      numFalsePositives += filter.testLong(i);
+      numFalsePositives += filter.testBytes(value.data(), value.size());
+    }
+  }
+  EXPECT_LT(numFalsePositives, 4'000 * 0.1);
+
+  filter.reset();
+  EXPECT_FALSE(filter.testLong(0));
+}
+
+TEST(BloomFilterTests, proto) {
+  BloomFilter filter{100, 0.01};
+  filter.addLong(-7);
+  filter.addBytes("abc", 3);
+  proto::BloomFilter proto;
+  filter.toProto(proto);
+  EXPECT_EQ(proto.numhashfunctions(), filter.numHashFunctions());
+  EXPECT_EQ(proto.bitset_size() * 64, filter.numBits());
+
+  BloomFilter fromProto{proto};
+  EXPECT_TRUE(fromProto.testLong(-7));
+  EXPECT_TRUE(fromProto.testBytes("abc", 3));
+
+  // The utf8bitset form stores the same words as little endian bytes.
+  proto::BloomFilter utf8Proto;
+  utf8Proto.set_numhashfunctions(proto.numhashfunctions());
+  std::string bytes(proto.bitset_size() * sizeof(uint64_t), '\0');
+  for (auto i = 0; i < proto.bitset_size(); ++i) {
+    auto word = folly::Endian::little(proto.bitset(i));
+    memcpy(bytes.data() + i * sizeof(uint64_t), &word, sizeof(word));
+  }
+  utf8Proto.set_utf8bitset(bytes);
+  BloomFilter fromUtf8Proto{utf8Proto};
+  EXPECT_TRUE(fromUtf8Proto.testLong(-7));
+  EXPECT_TRUE(fromUtf8Proto.testBytes("abc", 3));
+}
+
+TEST(BloomFilterTests, testFilter) {
+  BloomFilter filter{100, 0.01};
+  filter.addLong(10);
+  filter.addBytes("abc", 3);
+
+  EXPECT_TRUE(testBloomFilter(common::BigintRange(10, 10, false), filter));
+  EXPECT_FALSE(testBloomFilter(common::BigintRange(11, 11, false), filter));
+  // Ranges and filters that accept nulls are not tested.
+  EXPECT_TRUE(testBloomFilter(common::BigintRange(11, 12, false), filter));
+  EXPECT_TRUE(testBloomFilter(common::BigintRange(11, 11, true), filter));
+
+  EXPECT_TRUE(testBloomFilter(
+      common::BigintValuesUsingHashTable(10, 1'000, {10, 1'000}, false),
+      filter));
+  EXPECT_FALSE(testBloomFilter(
+      common::BigintValuesUsingHashTable(11, 1'000, {11, 1'000}, false),
+      filter));
+  EXPECT_FALSE(testBloomFilter(
+      common::BigintValuesUsingBitmask(11, 13, {11, 13}, false), filter));
+
+  EXPECT_TRUE(testBloomFilter(
+      common::BytesRange("abc", false, false, "abc", false, false, false),
+      filter));
+  EXPECT_FALSE(testBloomFilter(
+      common::BytesRange("abd", false, false, "abd", false, false, false),
+      filter));
+  EXPECT_TRUE(testBloomFilter(
+      common::BytesValues(std::vector<std::string>{"x", "abc"}, false),
+      filter));
+  EXPECT_FALSE(testBloomFilter(
+      common::BytesValues(std::vector<std::string>{"x", "y"}, false), filter));
+}
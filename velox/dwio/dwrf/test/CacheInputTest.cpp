@@ -586,6 +586,43 @@ TEST_F(CacheTest, ssdThreads) {
   LOG(INFO) << cache_->toString();
 }
 
+TEST_F(CacheTest, sharedLoad) {
+  initializeCache(512 << 20);
+  constexpr int32_t kNumColumns = 20;
+  uint64_t fileId;
+  uint64_t groupId;
+  auto readFile = inputByPath("sharedLoadFile", fileId, groupId);
+  // Two splits of the same file plan loads for the same stripe.
+  auto first = makeStripeData(
+      readFile, kNumColumns, nullptr, fileId, groupId, 0, ioStats_);
+  first->input->load(LogType::TEST);
+  const auto numPlannedKeys = cache_->loadPlanner().numKeys();
+  EXPECT_LT(0, numPlannedKeys);
+
+  auto secondStats = std::make_shared<IoStatistics>();
+  auto second = makeStripeData(
+      readFile, kNumColumns, nullptr, fileId, groupId, 0, secondStats);
+  second->input->load(LogType::TEST);
+  EXPECT_EQ(0, ioStats_->sharedLoad().count());
+  EXPECT_EQ(numPlannedKeys, secondStats->sharedLoad().count());
+  EXPECT_EQ(numPlannedKeys, cache_->loadPlanner().numKeys());
+
+  // The second split triggers the loads of the first. The first then finds
+  // its data in the cache without further IO.
+  for (auto i = 0; i < kNumColumns; ++i) {
+    readStream(*second, i);
+  }
+  const auto numIos = readFile->numIos();
+  for (auto i = 0; i < kNumColumns; ++i) {
+    readStream(*first, i);
+  }
+  EXPECT_EQ(numIos, readFile->numIos());
+
+  first.reset();
+  second.reset();
+  EXPECT_EQ(0, cache_->loadPlanner().numKeys());
+}
+
 class FileWithReadAhead {
  public:
   static constexpr int32_t kFileSize = 21 << 20;
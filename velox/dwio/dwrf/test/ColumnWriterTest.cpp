@@ -4102,6 +4102,51 @@ TEST(ColumnWriterTest, StringColumnWriterAbandonLowValueDictionaries) {
   }
 }
 
+TEST(ColumnWriterTest, StringColumnWriterSampledEncoding) {
+  auto pool = addDefaultLeafMemoryPool();
+  VectorMaker maker{pool.get()};
+  const vector_size_t size = 1'000;
+  const size_t numBatches = 3;
+
+  for (bool highCardinality : {true, false}) {
+    SCOPED_TRACE(fmt::format("highCardinality {}", highCardinality));
+    auto config = std::make_shared<Config>();
+    config->set(Config::DICTIONARY_STRING_SAMPLE_SIZE, 1'500U);
+    WriterContext context{config, defaultMemoryManager().addRootPool()};
+    context.initBuffer();
+    auto typeWithId = TypeWithId::create(VARCHAR(), 1);
+    auto columnWriter = BaseColumnWriter::create(context, *typeWithId);
+
+    for (size_t batch = 0; batch < numBatches; ++batch) {
+      std::vector<std::string> strings(size);
+      for (auto i = 0; i < size; ++i) {
+        strings[i] = highCardinality ? fmt::format("value_{}_{}", batch, i)
+                                     : fmt::format("value_{}", i % 10);
+      }
+      auto vector = maker.flatVector<StringView>(
+          size, [&](auto row) { return StringView(strings[row]); });
+      columnWriter->write(vector, common::Ranges::of(0, size));
+      columnWriter->createIndexEntry();
+      // The decision is made once, when the second batch completes the
+      // sample.
+      EXPECT_EQ(
+          context.takeSampledDirectEncodings(),
+          batch == 1 && highCardinality ? 1 : 0);
+    }
+
+    proto::StripeFooter stripeFooter;
+    columnWriter->flush(
+        [&stripeFooter](uint32_t /* unused */) -> proto::ColumnEncoding& {
+          return *stripeFooter.add_encoding();
+        });
+    ASSERT_EQ(
+        stripeFooter.encoding(0).kind(),
+        highCardinality
+            ? proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DIRECT
+            : proto::ColumnEncoding_Kind::ColumnEncoding_Kind_DICTIONARY);
+  }
+}
+
 TEST(ColumnWriterTest, IntDictWriterDirectValueOverflow) {
   auto config = std::make_shared<Config>();
   auto pool = addDefaultLeafMemoryPool();
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/config/SpillConfig.h"
@@ -786,6 +787,111 @@ TEST_F(E2EWriterTest, mapStatsMultiStrides) {
   testFlatMapFileStats(type, {0, 1, 2, 3, 4, 5}, /*strideSize=*/1000);
 }
 
+TEST_F(E2EWriterTest, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "float_val:float,"
+      "double_val:double,"
+      "string_val:string,"
+      "binary_val:binary,"
+      "timestamp_val:timestamp,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>,"
+      "flat_map_val:map<bigint,string>,"
+      "struct_val:struct<a:float,b:double>"
+      ">");
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set<const std::vector<uint32_t>>(dwrf::Config::MAP_FLAT_COLS, {11});
+  // Small compression blocks so that columns compress pages concurrently.
+  config->set(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1024UL);
+  config->set(dwrf::Config::COMPRESSION_BLOCK_SIZE_MIN, 1024UL);
+
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 5; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1'000, *leafPool_, nullptr, i));
+  }
+
+  auto write = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    dwrf::Writer writer{std::move(sink), options};
+    for (auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  const auto expected = write(nullptr);
+  ASSERT_EQ(write(executor), expected);
+}
+
+TEST_F(E2EWriterTest, encodedStringInput) {
+  auto type = ROW(
+      {"dict_val", "const_val", "null_val"}, {VARCHAR(), VARCHAR(), VARCHAR()});
+  const vector_size_t size = 1'000;
+  auto* pool = leafPool_.get();
+  VectorMaker maker{pool};
+
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    auto base = maker.flatVector<std::string>(
+        100,
+        [&](auto row) { return fmt::format("value_{}_{}", i, row % 37); },
+        VectorMaker::nullEvery(13));
+    auto indices = AlignedBuffer::allocate<vector_size_t>(size, pool);
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    auto nulls = allocateNulls(size, pool);
+    auto* rawNulls = nulls->asMutable<uint64_t>();
+    for (auto row = 0; row < size; ++row) {
+      rawIndices[row] = (row * 7) % base->size();
+      bits::setNull(rawNulls, row, row % 17 == 0);
+    }
+    batches.push_back(maker.rowVector(
+        type->names(),
+        {BaseVector::wrapInDictionary(nulls, indices, size, base),
+         BaseVector::createConstant(
+             VARCHAR(), fmt::format("constant_{}", i), size, pool),
+         BaseVector::createNullConstant(VARCHAR(), size, pool)}));
+  }
+
+  auto write = [&](bool flatten) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = std::make_shared<dwrf::Config>();
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    dwrf::Writer writer{std::move(sink), options};
+    for (auto& batch : batches) {
+      writer.write(flatten ? BaseVector::copy(*batch) : batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  // Remapping the ids of encoded input produces the same file as adding the
+  // rows one by one.
+  ASSERT_EQ(write(false), write(true));
+}
+
 TEST_F(E2EWriterTest, PartialStride) {
   auto type = ROW({"bool_val"}, {INTEGER()});
 
@@ -181,4 +181,68 @@ TEST(LayoutPlannerTests, Basic) {
   });
   ASSERT_EQ(pos, dataStreams.size());
 }
+
+TEST(LayoutPlannerTests, HotColumns) {
+  auto config = std::make_shared<Config>();
+  config->set(
+      Config::COMPRESSION, common::CompressionKind::CompressionKind_NONE);
+  WriterContext context{
+      config,
+      facebook::velox::memory::defaultMemoryManager().addRootPool(
+          "LayoutPlannerTests")};
+  std::vector<DwrfStreamIdentifier> streams;
+  std::array<char, 256> data;
+  std::memset(data.data(), 'a', data.size());
+  auto addStream = [&](uint32_t node,
+                       uint32_t col,
+                       StreamKind kind,
+                       uint32_t size) {
+    auto streamId = DwrfStreamIdentifier{node, 0, col, kind};
+    streams.push_back(streamId);
+    dwio::common::AppendOnlyBufferedStream out{context.newStream(streamId)};
+    out.write(data.data(), size);
+    out.flush();
+  };
+
+  addStream(1, 0, StreamKind::StreamKind_DATA, 6); // 0
+  addStream(2, 1, StreamKind::StreamKind_DATA, 1); // 1
+  addStream(3, 2, StreamKind::StreamKind_DATA, 20); // 2
+  addStream(1, 0, StreamKind::StreamKind_ROW_INDEX, 200); // 3
+  addStream(3, 2, StreamKind::StreamKind_ROW_INDEX, 50); // 4
+
+  auto encryptionHandler =
+      std::make_unique<velox::dwrf::encryption::EncryptionHandler>();
+  EncodingManager encodingManager{*encryptionHandler};
+  for (uint32_t node = 1; node <= 3; ++node) {
+    auto& encoding = encodingManager.addEncodingToFooter(node);
+    encoding.set_node(node);
+    encoding.set_kind(proto::ColumnEncoding::DIRECT);
+  }
+
+  auto typeWithId =
+      dwio::common::TypeWithId::create(ROW({INTEGER(), INTEGER(), INTEGER()}));
+  auto verify = [&](const LayoutPlanner& planner,
+                    const std::vector<size_t>& indexStreams,
+                    const std::vector<size_t>& dataStreams) {
+    auto result = planner.plan(encodingManager, getStreamList(context));
+    size_t pos = 0;
+    result.iterateIndexStreams([&](auto& stream, auto& /* ignored */) {
+      ASSERT_LT(pos, indexStreams.size());
+      ASSERT_EQ(stream, streams.at(indexStreams[pos++]));
+    });
+    ASSERT_EQ(pos, indexStreams.size());
+    pos = 0;
+    result.iterateDataStreams([&](auto& stream, auto& /* ignored */) {
+      ASSERT_LT(pos, dataStreams.size());
+      ASSERT_EQ(stream, streams.at(dataStreams[pos++]));
+    });
+    ASSERT_EQ(pos, dataStreams.size());
+  };
+
+  // Without hotness, streams are ordered by node size.
+  verify(LayoutPlanner{*typeWithId}, {4, 3}, {1, 0, 2});
+  // Hot columns come first in the given order, the rest by node size.
+  verify(HotColumnLayoutPlanner{*typeWithId, {0, 2}}, {3, 4}, {0, 2, 1});
+  verify(HotColumnLayoutPlanner{*typeWithId, {2}}, {4, 3}, {2, 1, 0});
+}
 } // namespace facebook::velox::dwrf
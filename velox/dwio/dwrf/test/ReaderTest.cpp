@@ -1185,6 +1185,48 @@ TEST_F(TestReader, testBlockedIoCallbackFiredWithFirstStripeLoad) {
   EXPECT_EQ(metricToIncrement, metricAfterFirstStripe);
 }
 
+TEST_F(TestReader, readStripesAhead) {
+  dwio::common::ReaderOptions readerOpts{pool()};
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(getFMLargeFile(), readerOpts.getMemoryPool()),
+      readerOpts);
+  auto ioExecutor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+
+  // A budget of 0 disables read ahead but must give the same result.
+  for (uint64_t budget : {256UL << 20, 0UL}) {
+    SCOPED_TRACE(fmt::format("budget {}", budget));
+    RowReaderOptions expectedOpts;
+    auto expectedReader = reader->createRowReader(expectedOpts);
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setIOExecutor(ioExecutor);
+    rowReaderOpts.setNumStripesAhead(2);
+    rowReaderOpts.setStripesAheadMemoryBytes(budget);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    VectorPtr expected;
+    VectorPtr actual;
+    // Stripes in fm_large are 1000 rows, so reads of 700 rows cross stripe
+    // boundaries.
+    while (expectedReader->next(700, expected) > 0) {
+      ASSERT_EQ(rowReader->next(700, actual), expected->size());
+      for (auto i = 0; i < expected->size(); ++i) {
+        ASSERT_TRUE(actual->equalValueAt(expected.get(), i, i)) << i;
+      }
+    }
+    ASSERT_EQ(rowReader->next(700, actual), 0);
+
+    // Seeking drops the stripes read ahead and reads ahead from the new
+    // position.
+    dynamic_cast<DwrfRowReader&>(*expectedReader).seekToRow(1500);
+    dynamic_cast<DwrfRowReader&>(*rowReader).seekToRow(1500);
+    ASSERT_GT(expectedReader->next(1000, expected), 0);
+    ASSERT_EQ(rowReader->next(1000, actual), expected->size());
+    for (auto i = 0; i < expected->size(); ++i) {
+      ASSERT_TRUE(actual->equalValueAt(expected.get(), i, i)) << i;
+    }
+  }
+}
+
 TEST_F(TestReader, testEstimatedSize) {
   dwio::common::ReaderOptions readerOpts{pool()};
   {
@@ -2623,6 +2665,67 @@ TEST_F(TestReader, failToReuseReaderNulls) {
   }
 }
 
+TEST_F(TestReader, bloomFilterStrideSkipping) {
+  constexpr int kStrideSize = 1'000;
+  constexpr int kNumStrides = 10;
+  // Every stride covers the same value range, so that only the Bloom filters
+  // can tell the strides apart.
+  auto value = [](auto row) {
+    return (row % kStrideSize) * kNumStrides + row / kStrideSize;
+  };
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kStrideSize * kNumStrides, value),
+      makeFlatVector<std::string>(
+          kStrideSize * kNumStrides,
+          [&](auto row) { return fmt::format("user_{}", value(row)); }),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, kStrideSize);
+  config->set<const std::vector<uint32_t>>(
+      dwrf::Config::BLOOM_FILTER_COLUMNS, {0, 1});
+  config->set(dwrf::Config::BLOOM_FILTER_FPP, 0.01f);
+  auto [writer, reader] = createWriterReader({batch}, pool(), config);
+
+  auto rowType = reader->rowType();
+  auto countRows = [&](const std::string& column,
+                       std::unique_ptr<common::Filter> filter) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType);
+    spec->childByName(column)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType, 0, pool());
+    vector_size_t numRows = 0;
+    while (rowReader->next(kStrideSize, result) > 0) {
+      numRows += result->size();
+    }
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return std::make_pair(numRows, stats.skippedStrides);
+  };
+
+  // 15 is only in stride 5.
+  auto [numRows, skippedStrides] =
+      countRows("c0", std::make_unique<common::BigintRange>(15, 15, false));
+  ASSERT_EQ(numRows, 1);
+  ASSERT_GE(skippedStrides, kNumStrides - 2);
+
+  // 15 and 27 are in strides 5 and 7.
+  std::tie(numRows, skippedStrides) = countRows(
+      "c1",
+      std::make_unique<common::BytesValues>(
+          std::vector<std::string>{"user_15", "user_27"}, false));
+  ASSERT_EQ(numRows, 2);
+  ASSERT_GE(skippedStrides, kNumStrides - 3);
+
+  // Range filters are not tested against the Bloom filters.
+  std::tie(numRows, skippedStrides) =
+      countRows("c0", std::make_unique<common::BigintRange>(15, 16, false));
+  ASSERT_EQ(numRows, 2);
+  ASSERT_EQ(skippedStrides, 0);
+}
+
 TEST_F(TestReader, readFlatMapsSomeEmpty) {
   // Test reading a flat map where the key filter means that some maps are
   // empty.
@@ -60,6 +60,22 @@ std::vector<int64_t> decodeRLEv2(
   return results;
 }
 
+// Decodes one value at a time through nextLengths(), which takes the same per
+// value path as the visitors of the selective readers.
+std::vector<int64_t>
+decodeRLEv2Lengths(const unsigned char* bytes, unsigned long l, size_t count) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  auto rle = createRleDecoder<true>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(bytes, l),
+      RleVersion_2,
+      *pool,
+      true /* doesn't matter */,
+      dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+  std::vector<int32_t> lengths(count);
+  rle->nextLengths(lengths.data(), count);
+  return std::vector<int64_t>(lengths.begin(), lengths.end());
+}
+
 void checkResults(
     const std::vector<int64_t>& e,
     const std::vector<int64_t>& a,
@@ -87,6 +103,7 @@ TEST(RLEv2, basicDelta0) {
   checkResults(values, decodeRLEv2(bytes, l, 3, count), 3);
   checkResults(values, decodeRLEv2(bytes, l, 7, count), 7);
   checkResults(values, decodeRLEv2(bytes, l, count, count), count);
+  checkResults(values, decodeRLEv2Lengths(bytes, l, count), 1);
 };
 
 TEST(RLEv2, basicDelta1) {
@@ -108,6 +125,7 @@ TEST(RLEv2, basicDelta1) {
       values,
       decodeRLEv2(bytes, l, values.size(), values.size()),
       values.size());
+  checkResults(values, decodeRLEv2Lengths(bytes, l, values.size()), 1);
 };
 
 TEST(RLEv2, basicDelta2) {
@@ -150,6 +168,7 @@ TEST(RLEv2, basicDelta3) {
       values,
       decodeRLEv2(bytes, l, values.size(), values.size()),
       values.size());
+  checkResults(values, decodeRLEv2Lengths(bytes, l, values.size()), 1);
 };
 
 TEST(RLEv2, basicDelta4) {
@@ -447,6 +466,7 @@ TEST(RLEv2, basicPatched0) {
       values,
       decodeRLEv2(bytes, l, values.size(), values.size()),
       values.size());
+  checkResults(values, decodeRLEv2Lengths(bytes, l, values.size()), 1);
 };
 
 TEST(RLEv2, basicPatched1) {
@@ -486,6 +506,7 @@ TEST(RLEv2, basicPatched1) {
       values,
       decodeRLEv2(bytes, l, values.size(), values.size()),
       values.size());
+  checkResults(values, decodeRLEv2Lengths(bytes, l, values.size()), 1);
 };
 
 TEST(RLEv2, mixedPatchedAndShortRepeats) {
@@ -546,6 +567,7 @@ TEST(RLEv2, mixedPatchedAndShortRepeats) {
       values,
       decodeRLEv2(bytes, l, values.size(), values.size()),
       values.size());
+  checkResults(values, decodeRLEv2Lengths(bytes, l, values.size()), 1);
 };
 
 TEST(RLEv2, basicDirectSeek) {
@@ -212,6 +212,60 @@ TEST(StripeStream, filterSequences) {
   }
 }
 
+TEST(StripeStream, visitStreamsOfNode) {
+  auto pool = addDefaultLeafMemoryPool();
+  google::protobuf::Arena arena;
+  auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(&arena);
+  footer->set_rowindexstride(100);
+  auto type = HiveTypeParser().parse("struct<a:map<int,float>,b:int>");
+  ProtoUtils::writeType(*type, *footer);
+  auto readerBase = std::make_shared<ReaderBase>(
+      *pool,
+      std::make_unique<BufferedInput>(
+          std::make_unique<RecordingInputStream>(), *pool),
+      std::make_unique<PostScript>(proto::PostScript{}),
+      footer,
+      nullptr);
+  ColumnSelector cs{readerBase->getSchema()};
+
+  auto stripeFooter =
+      google::protobuf::Arena::CreateMessage<proto::StripeFooter>(&arena);
+  std::vector<std::tuple<uint64_t, StreamKind, uint64_t, uint64_t>> ss{
+      std::make_tuple(1, StreamKind::StreamKind_PRESENT, 100, 0),
+      std::make_tuple(3, StreamKind::StreamKind_IN_MAP, 100, 1),
+      std::make_tuple(3, StreamKind::StreamKind_DATA, 100, 1),
+      std::make_tuple(3, StreamKind::StreamKind_IN_MAP, 100, 2),
+      std::make_tuple(3, StreamKind::StreamKind_DATA, 100, 2),
+      std::make_tuple(4, StreamKind::StreamKind_DATA, 100, 0)};
+  for (const auto& s : ss) {
+    auto&& stream = stripeFooter->add_streams();
+    stream->set_node(std::get<0>(s));
+    stream->set_kind(static_cast<proto::Stream_Kind>(std::get<1>(s)));
+    stream->set_length(std::get<2>(s));
+    stream->set_sequence(std::get<3>(s));
+  }
+  StripeReaderBase stripeReader{readerBase, stripeFooter};
+  auto streams = createAndLoadStripeStreams(stripeReader, cs);
+
+  std::vector<std::pair<uint32_t, StreamKind>> visited;
+  ASSERT_EQ(
+      streams.visitStreamsOfNode(
+          3,
+          [&](const StreamInformation& stream) {
+            EXPECT_EQ(stream.getNode(), 3);
+            visited.emplace_back(stream.getSequence(), stream.getKind());
+          }),
+      4);
+  std::sort(visited.begin(), visited.end());
+  std::vector<std::pair<uint32_t, StreamKind>> expected{
+      {1, StreamKind::StreamKind_DATA},
+      {1, StreamKind::StreamKind_IN_MAP},
+      {2, StreamKind::StreamKind_DATA},
+      {2, StreamKind::StreamKind_IN_MAP}};
+  ASSERT_EQ(visited, expected);
+  ASSERT_EQ(streams.visitStreamsOfNode(2, [](const auto& /*stream*/) {}), 0);
+}
+
 TEST(StripeStream, zeroLength) {
   auto pool = addDefaultLeafMemoryPool();
   google::protobuf::Arena arena;
@@ -15,8 +15,10 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include <numeric>
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ExecutorBarrier.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +37,8 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  auto localSelected = context_.getLocalSelectivityVector(slice->size());
+  auto& selected = localSelected.get();
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -48,8 +51,35 @@ WriterContext::LocalDecodedVector BaseColumnWriter::decode(
   return localDecoded;
 }
 
+void BaseColumnWriter::initBloomFilter() {
+  if (sequence_ != 0 || type_.parent() == nullptr ||
+      type_.parent()->id() != 0) {
+    return;
+  }
+  const auto& columns = getConfig(Config::BLOOM_FILTER_COLUMNS);
+  if (std::find(columns.begin(), columns.end(), type_.column()) ==
+      columns.end()) {
+    return;
+  }
+  bloomFilter_ = std::make_unique<BloomFilter>(
+      getConfig(Config::ROW_INDEX_STRIDE), getConfig(Config::BLOOM_FILTER_FPP));
+  bloomFilterOut_ = newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8);
+}
+
 namespace {
 
+// Returns true if 'type' is a direct child of the root that is written as a
+// flat map.
+bool isFlatMapColumn(const WriterContext& context, const TypeWithId& type) {
+  if (!context.getConfig(Config::FLATTEN_MAP) || type.parent() == nullptr ||
+      type.parent()->id() != 0) {
+    return false;
+  }
+  const auto& flatMapCols = context.getConfig(Config::MAP_FLAT_COLS);
+  return std::find(flatMapCols.begin(), flatMapCols.end(), type.column()) !=
+      flatMapCols.end();
+}
+
 template <typename T>
 class ByteRleColumnWriter : public BaseColumnWriter {
  public:
@@ -214,6 +244,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
     DWIO_ENSURE_GE(dictionaryKeySizeThreshold_, 0.0);
     DWIO_ENSURE_LE(dictionaryKeySizeThreshold_, 1.0);
     DWIO_ENSURE(firstStripe_);
+    initBloomFilter();
     if (!useDictionaryEncoding_) {
       // Suppress the stream used to initialize dictionary encoder.
       // TODO: passing factory method into the dict encoder also works
@@ -300,6 +331,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    addBloomFilterEntry();
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -401,6 +433,20 @@ class IntegerColumnWriter : public BaseColumnWriter {
     ensureValidStreamWriters(dictEncoding);
   }
 
+  // Decides between dictionary and direct encoding once the first stripe has
+  // 'dictionarySampleSize_' values, so that a high cardinality column does not
+  // buffer a dictionary for the whole stripe before switching to direct.
+  void decideEncodingOnSample() {
+    if (dictionarySampleSize_ == 0 || sampleDecided_ || !firstStripe_ ||
+        rows_.size() < dictionarySampleSize_) {
+      return;
+    }
+    sampleDecided_ = true;
+    if (tryAbandonDictionaries(false)) {
+      context_.incSampledDirectEncodings();
+    }
+  }
+
   // NOTE: This should be called *before* clearing the rows_ buffer.
   bool shouldKeepDictionary() const {
     // TODO(T91508412): Move the dictionary efficiency based decision into
@@ -510,6 +556,9 @@ uint64_t IntegerColumnWriter<T>::writeDict(
     T value = decodedVector.valueAt<T>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(value));
     statsBuilder.addValues(value);
+    if (bloomFilter_) {
+      bloomFilter_->addLong(value);
+    }
   };
 
   uint64_t nullCount = 0;
@@ -548,6 +597,13 @@ uint64_t IntegerColumnWriter<T>::writeDirect(
   auto vals = flatVector->rawValues();
 
   auto count = dataDirect_->add(vals, ranges, nulls);
+  if (bloomFilter_) {
+    for (auto& pos : ranges) {
+      if (!nulls || !bits::isBitNull(nulls, pos)) {
+        bloomFilter_->addLong(vals[pos]);
+      }
+    }
+  }
   StatisticsBuilderUtils::addValues<T>(
       dynamic_cast<IntegerStatisticsBuilder&>(*indexStatsBuilder_),
       slice,
@@ -805,8 +861,11 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
         useDictionaryEncoding_{useDictionaryEncoding()},
-        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
+        strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)},
+        dictionarySampleSize_{
+            getConfig(Config::DICTIONARY_STRING_SAMPLE_SIZE)} {
     DWIO_ENSURE(firstStripe_);
+    initBloomFilter();
     if (!useDictionaryEncoding_) {
       initStreamWriters(useDictionaryEncoding_);
     }
@@ -894,6 +953,7 @@ class StringColumnWriter : public BaseColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    addBloomFilterEntry();
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -964,6 +1024,21 @@ class StringColumnWriter : public BaseColumnWriter {
       DecodedVector& decodedVector,
       const common::Ranges& ranges);
 
+  // Returns true if 'decodedVector' is constant or dictionary encoded over a
+  // base that is no larger than 'ranges'. Such input is dictionary encoded by
+  // adding each distinct base value once and remapping the base indices.
+  static bool canRemapDict(
+      const DecodedVector& decodedVector,
+      const common::Ranges& ranges) {
+    return decodedVector.isConstantMapping() ||
+        (!decodedVector.isIdentityMapping() &&
+         decodedVector.base()->size() <= ranges.size());
+  }
+
+  uint64_t writeDictRemapped(
+      DecodedVector& decodedVector,
+      const common::Ranges& ranges);
+
   uint64_t writeDirect(
       DecodedVector& decodedVector,
       const common::Ranges& ranges);
@@ -1084,6 +1159,8 @@ class StringColumnWriter : public BaseColumnWriter {
   bool useDictionaryEncoding_;
   bool firstStripe_{true};
   DataBuffer<size_t> strideOffsets_;
+  const uint32_t dictionarySampleSize_;
+  bool sampleDecided_{false};
 };
 
 uint64_t StringColumnWriter::write(
@@ -1093,7 +1170,11 @@ uint64_t StringColumnWriter::write(
   auto& decodedVector = localDecoded.get();
 
   if (useDictionaryEncoding_) {
-    return writeDict(decodedVector, ranges);
+    const auto rawSize = canRemapDict(decodedVector, ranges)
+        ? writeDictRemapped(decodedVector, ranges)
+        : writeDict(decodedVector, ranges);
+    decideEncodingOnSample();
+    return rawSize;
   } else {
     return writeDirect(decodedVector, ranges);
   }
@@ -1113,6 +1194,9 @@ uint64_t StringColumnWriter::writeDict(
     auto sp = decodedVector.valueAt<StringView>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
     statsBuilder.addValues(sp);
+    if (bloomFilter_) {
+      bloomFilter_->addBytes(sp.data(), sp.size());
+    }
     rawSize += sp.size();
   };
 
@@ -1139,6 +1223,66 @@ uint64_t StringColumnWriter::writeDict(
   return rawSize;
 }
 
+uint64_t StringColumnWriter::writeDictRemapped(
+    DecodedVector& decodedVector,
+    const common::Ranges& ranges) {
+  auto& statsBuilder =
+      dynamic_cast<StringStatisticsBuilder&>(*indexStatsBuilder_);
+  writeNulls(decodedVector, ranges);
+  rows_.reserve(rows_.size() + ranges.size());
+  size_t strideIndex = strideOffsets_.size() - 1;
+
+  // All rows of a constant map to the same base value.
+  const bool isConstant = decodedVector.isConstantMapping();
+  const vector_size_t numBaseValues =
+      isConstant ? 1 : decodedVector.base()->size();
+  auto baseIndex = [&](vector_size_t pos) {
+    return isConstant ? 0 : decodedVector.index(pos);
+  };
+
+  // Count the rows of each base value first, so that the dictionary keys,
+  // their counts and the stats come out the same as when adding row by row.
+  DataBuffer<uint32_t> counts{getMemoryPool(MemoryUsageCategory::GENERAL)};
+  counts.resize(numBaseValues);
+  uint64_t nullCount = 0;
+  for (auto& pos : ranges) {
+    if (decodedVector.isNullAt(pos)) {
+      ++nullCount;
+    } else {
+      ++counts[baseIndex(pos)];
+    }
+  }
+
+  static constexpr uint32_t kNoId = std::numeric_limits<uint32_t>::max();
+  DataBuffer<uint32_t> ids{getMemoryPool(MemoryUsageCategory::GENERAL)};
+  ids.resize(numBaseValues);
+  std::fill(ids.data(), ids.data() + numBaseValues, kNoId);
+  uint64_t rawSize = 0;
+  for (auto& pos : ranges) {
+    if (decodedVector.isNullAt(pos)) {
+      continue;
+    }
+    const auto index = baseIndex(pos);
+    if (ids[index] == kNoId) {
+      auto sp = decodedVector.valueAt<StringView>(pos);
+      ids[index] = dictEncoder_.addKey(sp, strideIndex, counts[index]);
+      statsBuilder.addValues(sp, counts[index]);
+      rawSize += sp.size() * counts[index];
+      if (bloomFilter_) {
+        bloomFilter_->addBytes(sp.data(), sp.size());
+      }
+    }
+    rows_.unsafeAppend(ids[index]);
+  }
+
+  if (nullCount > 0) {
+    statsBuilder.setHasNull();
+    rawSize += nullCount * NULL_SIZE;
+  }
+  statsBuilder.increaseRawSize(rawSize);
+  return rawSize;
+}
+
 uint64_t StringColumnWriter::writeDirect(
     DecodedVector& decodedVector,
     const common::Ranges& ranges) {
@@ -1158,6 +1302,9 @@ uint64_t StringColumnWriter::writeDirect(
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
     statsBuilder.addValues(sp);
+    if (bloomFilter_) {
+      bloomFilter_->addBytes(sp.data(), size);
+    }
     rawSize += size;
     lengths.unsafeAppend(size);
   };
@@ -1619,6 +1766,12 @@ class StructColumnWriter : public BaseColumnWriter {
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // Writes the children of the root on the context's encoding executor.
+  // Returns the sum of their raw sizes.
+  uint64_t writeChildrenInParallel(
+      const RowVector* rowSlice,
+      const common::Ranges& ranges);
 };
 
 uint64_t StructColumnWriter::writeChildrenAndStats(
@@ -1627,8 +1780,12 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (isRoot() && context_.encodingExecutor() && children_.size() > 1) {
+      rawSize = writeChildrenInParallel(rowSlice, ranges);
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
@@ -1640,6 +1797,32 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
   return rawSize;
 }
 
+uint64_t StructColumnWriter::writeChildrenInParallel(
+    const RowVector* rowSlice,
+    const common::Ranges& ranges) {
+  // Each column writer only touches its own streams, encoders and stats, so
+  // the output does not depend on the order the columns are encoded in. Flat
+  // map writers add streams to the context while writing and stay on this
+  // thread.
+  std::vector<uint64_t> rawSizes(children_.size(), 0);
+  dwio::common::ExecutorBarrier barrier(*context_.encodingExecutor());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (isFlatMapColumn(context_, children_[i]->getType())) {
+      continue;
+    }
+    barrier.add([&, i]() {
+      rawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    });
+  }
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (isFlatMapColumn(context_, children_[i]->getType())) {
+      rawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    }
+  }
+  barrier.waitAll();
+  return std::accumulate(rawSizes.begin(), rawSizes.end(), 0UL);
+}
+
 uint64_t StructColumnWriter::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
@@ -1981,19 +2164,13 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
     std::function<void(IndexBuilder&)> onRecordPosition) {
   const auto flatMapEnabled = context.getConfig(Config::FLATTEN_MAP) &&
       type.parent() != nullptr && (type.parent()->id() == 0);
-  bool isFlatMapColumn{false};
-  if (flatMapEnabled) {
-    const auto& flatMapCols = context.getConfig(Config::MAP_FLAT_COLS);
-    isFlatMapColumn =
-        std::find(flatMapCols.begin(), flatMapCols.end(), type.column()) !=
-        flatMapCols.end();
-  }
+  const bool isFlatMap = isFlatMapColumn(context, type);
 
   // When flat map is enabled, all columns provided in the MAP_FLAT_COLS config,
   // must be of MAP type. We only check top level columns (columns which are
   // direct children of the root node).
   if (flatMapEnabled) {
-    if (isFlatMapColumn && type.type()->kind() != TypeKind::MAP) {
+    if (isFlatMap && type.type()->kind() != TypeKind::MAP) {
       DWIO_RAISE(fmt::format(
           "MAP_FLAT_COLS contains column {}, but the root type of this column is {}."
           " Column root types must be of type MAP",
@@ -2009,7 +2186,7 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
           "MAP_FLAT_COLS_STRUCT_KEYS size must match number of columns.");
       if (!structColumnKeys[type.column()].empty()) {
         DWIO_ENSURE(
-            isFlatMapColumn,
+            isFlatMap,
             "Struct input found in MAP_FLAT_COLS_STRUCT_KEYS. Column must also be in MAP_FLAT_COLS.");
       }
     }
@@ -2060,7 +2237,7 @@ std::unique_ptr<BaseColumnWriter> BaseColumnWriter::create(
 
       // We only flatten maps which are direct children of the root node.
       // All other (nested) maps are treated as regular maps.
-      if (isFlatMapColumn) {
+      if (isFlatMap) {
         DWIO_ENSURE(onRecordPosition == nullptr, "unexpected flat map nesting");
         return FlatMapColumnWriter<TypeKind::INVALID>::create(
             context, type, sequence);
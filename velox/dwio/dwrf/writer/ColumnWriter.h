@@ -18,6 +18,7 @@
 
 #include "velox/common/base/GTestMacros.h"
 #include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
@@ -84,6 +85,7 @@ class BaseColumnWriter : public ColumnWriter {
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    addBloomFilterEntry();
     recordPosition();
     for (auto& child : children_) {
       child->createIndexEntry();
@@ -117,6 +119,11 @@ class BaseColumnWriter : public ColumnWriter {
     setEncoding(encoding);
     encodingOverride(encoding);
     indexBuilder_->flush();
+    if (bloomFilter_) {
+      bloomFilterIndex_.SerializeToZeroCopyStream(bloomFilterOut_.get());
+      bloomFilterOut_->flush();
+      bloomFilterIndex_.Clear();
+    }
   }
 
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
@@ -257,6 +264,20 @@ class BaseColumnWriter : public ColumnWriter {
       const VectorPtr& slice,
       const common::Ranges& ranges);
 
+  /// Creates 'bloomFilter_' if this is a top level column listed in
+  /// Config::BLOOM_FILTER_COLUMNS. Called by the writers that add their
+  /// values to the filter.
+  void initBloomFilter();
+
+  /// Adds the Bloom filter of the finished stride to the Bloom filter index
+  /// and clears it for the next stride.
+  void addBloomFilterEntry() {
+    if (bloomFilter_) {
+      bloomFilter_->toProto(*bloomFilterIndex_.add_bloomfilter());
+      bloomFilter_->reset();
+    }
+  }
+
   const dwio::common::TypeWithId& type_;
   std::vector<std::unique_ptr<BaseColumnWriter>> children_;
   std::unique_ptr<IndexBuilder> indexBuilder_;
@@ -264,6 +285,11 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
   bool hasNull_ = false;
+  // Bloom filter of the current stride. Set only for the columns in
+  // Config::BLOOM_FILTER_COLUMNS.
+  std::unique_ptr<BloomFilter> bloomFilter_;
+  proto::BloomFilterIndex bloomFilterIndex_;
+  std::unique_ptr<BufferedOutputStream> bloomFilterOut_;
   // callback used to inject the logic that captures positions for flat map
   // in_map stream
   const std::function<void(IndexBuilder&)> onRecordPosition_;
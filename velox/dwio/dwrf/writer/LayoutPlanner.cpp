@@ -357,6 +357,40 @@ void LayoutPlanner::sortBySize(
   });
 }
 
+HotColumnLayoutPlanner::HotColumnLayoutPlanner(
+    const dwio::common::TypeWithId& schema,
+    const std::vector<uint32_t>& hotColumns)
+    : LayoutPlanner{schema} {
+  for (auto column : hotColumns) {
+    columnRanks_.emplace(column, columnRanks_.size());
+  }
+}
+
+LayoutResult HotColumnLayoutPlanner::plan(
+    const EncodingContainer& encoding,
+    StreamList streams) const {
+  auto iter = std::partition(streams.begin(), streams.end(), [](auto& stream) {
+    return isIndexStream(stream.first->kind());
+  });
+  const size_t indexCount = iter - streams.begin();
+  auto flatMapCols = getFlatMapColumns(encoding, nodeToColumnMap_);
+  sortBySize(streams.begin(), iter, flatMapCols);
+  sortBySize(iter, streams.end(), flatMapCols);
+
+  // Columns not in 'columnRanks_' rank after all hot columns and keep their
+  // relative order.
+  const auto coldRank = columnRanks_.size();
+  auto rank = [&](const auto& stream) {
+    auto it = columnRanks_.find(stream.first->column());
+    return it == columnRanks_.end() ? coldRank : it->second;
+  };
+  auto byRank = [&](const auto& a, const auto& b) { return rank(a) < rank(b); };
+  std::stable_sort(streams.begin(), iter, byRank);
+  std::stable_sort(iter, streams.end(), byRank);
+
+  return LayoutResult{std::move(streams), indexCount};
+}
+
 folly::F14FastSet<uint32_t> LayoutPlanner::getFlatMapColumns(
     const EncodingContainer& encoding,
     const folly::F14FastMap<uint32_t, uint32_t>& nodeToColumnMap) {
@@ -151,4 +151,24 @@ class LayoutPlanner {
   VELOX_FRIEND_TEST(LayoutPlannerTests, Basic);
 };
 
+/// Places the streams of frequently read top level columns first and next to
+/// each other, so that a reader projecting them issues fewer, larger reads.
+/// 'hotColumns' lists top level column ids, most frequently read first, e.g.
+/// as derived from the access stats of a ScanTracker. The streams of other
+/// columns follow in the order of LayoutPlanner. Within a column the
+/// LayoutPlanner order is kept.
+class HotColumnLayoutPlanner : public LayoutPlanner {
+ public:
+  HotColumnLayoutPlanner(
+      const dwio::common::TypeWithId& schema,
+      const std::vector<uint32_t>& hotColumns);
+
+  LayoutResult plan(const EncodingContainer& encoding, StreamList streamList)
+      const override;
+
+ private:
+  // Position of each column of 'hotColumns'.
+  folly::F14FastMap<uint32_t, uint32_t> columnRanks_;
+};
+
 } // namespace facebook::velox::dwrf
@@ -79,6 +79,7 @@ Writer::Writer(
   writerBase_->initBuffers();
 
   context.buildPhysicalSizeAggregators(*schema_);
+  context.setEncodingExecutor(options.encodingExecutor);
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
@@ -552,6 +553,10 @@ void Writer::flushStripe(bool close) {
   addThreadLocalRuntimeStat(
       "stripeSize",
       RuntimeCounter(metrics.stripeSize, RuntimeCounter::Unit::kBytes));
+  if (const auto numSampled = context.takeSampledDirectEncodings()) {
+    addThreadLocalRuntimeStat(
+        "sampledDirectEncodings", RuntimeCounter(numSampled));
+  }
   // Add flush overhead and other ratio logging.
   context.metricLogger()->logStripeFlush(metrics);
 
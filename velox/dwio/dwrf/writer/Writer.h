@@ -47,6 +47,10 @@ struct WriterOptions {
   std::shared_ptr<encryption::EncryptionSpecification> encryptionSpec;
   std::shared_ptr<dwio::common::encryption::EncrypterFactory> encrypterFactory;
   int64_t memoryBudget = std::numeric_limits<int64_t>::max();
+  /// If set, the top level columns of each batch are encoded in parallel on
+  /// this executor. Flat map columns are encoded on the calling thread. The
+  /// written file is the same as when encoding serially.
+  std::shared_ptr<folly::Executor> encodingExecutor;
   std::function<std::unique_ptr<ColumnWriter>(
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
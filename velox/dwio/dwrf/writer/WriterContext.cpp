@@ -147,7 +147,8 @@ void WriterContext::abort() {
   dictEncoders_.clear();
   decodedVectorPool_.clear();
   decodedVectorPool_.shrink_to_fit();
-  selectivityVector_.reset();
+  selectivityVectorPool_.clear();
+  selectivityVectorPool_.shrink_to_fit();
   releaseMemoryReservation();
 }
 } // namespace facebook::velox::dwrf
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <limits>
+#include <mutex>
+#include "folly/Executor.h"
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -167,6 +170,18 @@ class WriterContext : public CompressionBufferPool {
     }
   }
 
+  /// Records that a string column chose direct encoding after sampling
+  /// Config::DICTIONARY_STRING_SAMPLE_SIZE values.
+  void incSampledDirectEncodings() {
+    ++numSampledDirectEncodings_;
+  }
+
+  /// Returns the number of columns recorded by incSampledDirectEncodings()
+  /// since the last call.
+  uint32_t takeSampledDirectEncodings() {
+    return numSampledDirectEncodings_.exchange(0);
+  }
+
   void incRowCount(uint64_t count) {
     stripeRowCount_ += count;
     if (indexEnabled_) {
@@ -247,8 +262,19 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  // With an encoding executor, columns may compress pages concurrently. The
+  // ones that find the shared buffer taken get a temporary buffer that is
+  // freed on return, so that memory usage between writes is the same as when
+  // encoding serially.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ == nullptr && encodingExecutor_ != nullptr) {
+      auto buffer = std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+      VELOX_CHECK_GE(buffer->size(), size);
+      return buffer;
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -257,10 +283,24 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
+    std::lock_guard<std::mutex> l(mutex_);
+    if (compressionBuffer_ != nullptr && encodingExecutor_ != nullptr) {
+      return;
+    }
     VELOX_CHECK_NULL(compressionBuffer_);
     compressionBuffer_ = std::move(buffer);
   }
 
+  /// Sets the executor on which the top level columns of a batch are encoded
+  /// in parallel. The written file is the same as when encoding serially.
+  void setEncodingExecutor(std::shared_ptr<folly::Executor> executor) {
+    encodingExecutor_ = std::move(executor);
+  }
+
+  const std::shared_ptr<folly::Executor>& encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
   void incrementNodeSize(uint32_t node, uint64_t size) {
     nodeSize_[node] += size;
   }
@@ -559,13 +599,33 @@ class WriterContext : public CompressionBufferPool {
     return LocalDecodedVector{*this};
   }
 
-  SelectivityVector& getSharedSelectivityVector(velox::vector_size_t size) {
-    if (FOLLY_UNLIKELY(selectivityVector_ == nullptr)) {
-      selectivityVector_ = std::make_unique<velox::SelectivityVector>(size);
-    } else {
-      selectivityVector_->resize(size);
+  class LocalSelectivityVector {
+   public:
+    LocalSelectivityVector(WriterContext& context, velox::vector_size_t size)
+        : context_(context), vector_(context_.getSelectivityVector(size)) {}
+
+    LocalSelectivityVector(LocalSelectivityVector&& other) noexcept
+        : context_{other.context_}, vector_{std::move(other.vector_)} {}
+
+    LocalSelectivityVector& operator=(LocalSelectivityVector&& other) = delete;
+
+    ~LocalSelectivityVector() {
+      if (vector_) {
+        context_.releaseSelectivityVector(std::move(vector_));
+      }
     }
-    return *selectivityVector_;
+
+    SelectivityVector& get() {
+      return *vector_;
+    }
+
+   private:
+    WriterContext& context_;
+    std::unique_ptr<velox::SelectivityVector> vector_;
+  };
+
+  LocalSelectivityVector getLocalSelectivityVector(velox::vector_size_t size) {
+    return LocalSelectivityVector{*this, size};
   }
 
   void abort();
@@ -578,6 +638,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -587,9 +648,33 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
+  std::unique_ptr<velox::SelectivityVector> getSelectivityVector(
+      velox::vector_size_t size) {
+    std::unique_ptr<velox::SelectivityVector> vector;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!selectivityVectorPool_.empty()) {
+        vector = std::move(selectivityVectorPool_.back());
+        selectivityVectorPool_.pop_back();
+      }
+    }
+    if (vector == nullptr) {
+      return std::make_unique<velox::SelectivityVector>(size);
+    }
+    vector->resize(size);
+    return vector;
+  }
+
+  void releaseSelectivityVector(
+      std::unique_ptr<velox::SelectivityVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
+    selectivityVectorPool_.push_back(std::move(vector));
+  }
+
   const std::shared_ptr<const Config> config_;
   const std::shared_ptr<memory::MemoryPool> pool_;
   const std::shared_ptr<memory::MemoryPool> dictionaryPool_;
@@ -624,11 +709,17 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
+  std::shared_ptr<folly::Executor> encodingExecutor_;
+  std::atomic<uint32_t> numSampledDirectEncodings_{0};
+  // Serializes access to the compression buffer and the vector pools by
+  // columns encoded in parallel.
+  std::mutex mutex_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
-  // Reusable SelectivityVector
-  std::unique_ptr<velox::SelectivityVector> selectivityVector_;
+  // A pool of reusable SelectivityVectors.
+  std::vector<std::unique_ptr<velox::SelectivityVector>>
+      selectivityVectorPool_;
 
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize_;
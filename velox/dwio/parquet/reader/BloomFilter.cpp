@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Salts for setting the bits in each 32 bit word of a block. From the Parquet
+// spec.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Upper bound of the serialized size of a BloomFilterHeader. Used for reading
+// the header without knowing its size.
+constexpr uint64_t kMaxHeaderSize = 64;
+
+// Largest bitset a writer is expected to produce. Larger sizes are treated as
+// corruption.
+constexpr int32_t kMaxBloomFilterBytes = 128 << 20;
+
+template <typename T>
+uint64_t xxHash(T value) {
+  return XXH64(&value, sizeof(T), 0);
+}
+} // namespace
+
+BloomFilter::BloomFilter(int32_t numBytes)
+    : bitset_(
+          bits::roundUp(std::max(numBytes, kBytesPerBlock), kBytesPerBlock) /
+          sizeof(uint32_t)) {}
+
+// static
+std::unique_ptr<BloomFilter> BloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset) {
+  auto fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset past end of file");
+  auto headerStream = input.read(
+      offset,
+      std::min<uint64_t>(kMaxHeaderSize, fileSize - offset),
+      dwio::common::LogType::FOOTER);
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(headerStream->Next(&buffer, &size), "Empty Bloom filter stream");
+  auto bufferStart = reinterpret_cast<const char*>(buffer);
+  auto bufferEnd = bufferStart + size;
+  auto transport = std::make_shared<thrift::ThriftStreamingTransport>(
+      headerStream.get(), bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  auto headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return nullptr;
+  }
+  VELOX_CHECK(
+      header.numBytes > 0 && header.numBytes <= kMaxBloomFilterBytes &&
+          header.numBytes % kBytesPerBlock == 0,
+      "Invalid Bloom filter size {}",
+      header.numBytes);
+  VELOX_CHECK_LE(
+      offset + headerSize + header.numBytes,
+      fileSize,
+      "Bloom filter past end of file");
+  auto filter = std::make_unique<BloomFilter>(header.numBytes);
+  auto bitsetStream = input.read(
+      offset + headerSize, header.numBytes, dwio::common::LogType::FOOTER);
+  bufferStart = bufferEnd = nullptr;
+  dwio::common::readBytes(
+      header.numBytes,
+      bitsetStream.get(),
+      filter->bitset_.data(),
+      bufferStart,
+      bufferEnd);
+  return filter;
+}
+
+// static
+uint64_t BloomFilter::hash(int32_t value) {
+  return xxHash(value);
+}
+
+// static
+uint64_t BloomFilter::hash(int64_t value) {
+  return xxHash(value);
+}
+
+// static
+uint64_t BloomFilter::hash(float value) {
+  return xxHash(value);
+}
+
+// static
+uint64_t BloomFilter::hash(double value) {
+  return xxHash(value);
+}
+
+// static
+uint64_t BloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+void BloomFilter::insert(uint64_t hash) {
+  auto block = const_cast<uint32_t*>(blockAt(hash));
+  auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < 8; ++i) {
+    block[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+bool BloomFilter::mayContain(uint64_t hash) const {
+  auto block = blockAt(hash);
+  auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < 8; ++i) {
+    if ((block[i] & (1U << ((key * kSalt[i]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+uint64_t hashInteger(int64_t value, thrift::Type::type parquetType) {
+  return parquetType == thrift::Type::INT32
+      ? BloomFilter::hash(static_cast<int32_t>(value))
+      : BloomFilter::hash(value);
+}
+
+bool isIntegerType(thrift::Type::type parquetType) {
+  return parquetType == thrift::Type::INT32 ||
+      parquetType == thrift::Type::INT64;
+}
+
+bool isBytesType(thrift::Type::type parquetType) {
+  return parquetType == thrift::Type::BYTE_ARRAY;
+}
+} // namespace
+
+bool canUseBloomFilter(
+    const common::Filter& filter,
+    thrift::Type::type parquetType) {
+  if (filter.testNull()) {
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return isIntegerType(parquetType) &&
+          static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return isIntegerType(parquetType);
+    case common::FilterKind::kBytesRange:
+      return isBytesType(parquetType) &&
+          static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesValues:
+      return isBytesType(parquetType);
+    default:
+      return false;
+  }
+}
+
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type parquetType) {
+  if (!canUseBloomFilter(filter, parquetType)) {
+    return true;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return bloomFilter.mayContain(hashInteger(
+          static_cast<const common::BigintRange&>(filter).lower(),
+          parquetType));
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      for (auto value :
+           static_cast<const common::BigintValuesUsingHashTable&>(filter)
+               .values()) {
+        if (bloomFilter.mayContain(hashInteger(value, parquetType))) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      for (auto value :
+           static_cast<const common::BigintValuesUsingBitmask&>(filter)
+               .values()) {
+        if (bloomFilter.mayContain(hashInteger(value, parquetType))) {
+          return true;
+        }
+      }
+      return false;
+    case common::FilterKind::kBytesRange:
+      return bloomFilter.mayContain(BloomFilter::hash(
+          static_cast<const common::BytesRange&>(filter).lower()));
+    case common::FilterKind::kBytesValues:
+      for (auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (bloomFilter.mayContain(BloomFilter::hash(value))) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
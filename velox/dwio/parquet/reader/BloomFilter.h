@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+#include <memory>
+
+namespace facebook::velox::dwio::common {
+class BufferedInput;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter as defined in the Parquet spec. The bitset is an
+/// array of 256 bit blocks. A value sets one bit in each of the 8 32 bit words
+/// of the block selected by the high half of its xxHash64.
+class BloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Makes an empty filter of 'numBytes', rounded up to a whole number of
+  /// blocks.
+  explicit BloomFilter(int32_t numBytes);
+
+  /// Reads the Bloom filter header and bitset at 'offset' from 'input'.
+  /// Returns nullptr if the filter uses an algorithm, hash or compression
+  /// that is not supported.
+  static std::unique_ptr<BloomFilter> read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset);
+
+  /// Returns the xxHash64 of the PLAIN encoding of 'value' without a length
+  /// prefix.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(float value);
+  static uint64_t hash(double value);
+  static uint64_t hash(std::string_view value);
+
+  void insert(uint64_t hash);
+
+  /// False if no value with 'hash' was inserted.
+  bool mayContain(uint64_t hash) const;
+
+ private:
+  const uint32_t* blockAt(uint64_t hash) const {
+    auto numBlocks = bitset_.size() / (kBytesPerBlock / sizeof(uint32_t));
+    auto index = ((hash >> 32) * numBlocks) >> 32;
+    return bitset_.data() + index * (kBytesPerBlock / sizeof(uint32_t));
+  }
+
+  std::vector<uint32_t> bitset_;
+};
+
+/// True if 'filter' may have hits in a column chunk of 'parquetType' with
+/// 'bloomFilter'. Only equality and IN filters can be decided. All other
+/// filters and filters that pass nulls return true.
+bool testBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type parquetType);
+
+/// True if testBloomFilter() can return false for 'filter' so that it is
+/// worth reading the Bloom filter.
+bool canUseBloomFilter(
+    const common::Filter& filter,
+    thrift::Type::type parquetType);
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RawVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Decodes DELTA_BINARY_PACKED data. The stream consists of a header
+/// <block size> <miniblocks per block> <total value count> <first value>
+/// followed by blocks of <min delta> <miniblock bit widths> <miniblocks>. Each
+/// miniblock is unpacked as a whole into 'deltas_' and prefix summed into
+/// 'values_', so that the per-value work is a plain copy from a contiguous
+/// buffer.
+class DeltaBpDecoder {
+ public:
+  DeltaBpDecoder(const char* FOLLY_NONNULL start, const char* FOLLY_NONNULL end)
+      : bufferStart_(start), bufferEnd_(end) {
+    valuesPerBlock_ = readVarint();
+    miniBlocksPerBlock_ = readVarint();
+    totalValueCount_ = readVarint();
+    lastValue_ = readZigZagVarint();
+    VELOX_CHECK_GT(valuesPerBlock_, 0, "Invalid DELTA_BINARY_PACKED block");
+    VELOX_CHECK_GT(miniBlocksPerBlock_, 0, "Invalid DELTA_BINARY_PACKED block");
+    VELOX_CHECK_EQ(
+        valuesPerBlock_ % 128, 0, "DELTA_BINARY_PACKED block size % 128 != 0");
+    valuesPerMiniBlock_ = valuesPerBlock_ / miniBlocksPerBlock_;
+    VELOX_CHECK_EQ(
+        valuesPerMiniBlock_ % 32,
+        0,
+        "DELTA_BINARY_PACKED miniblock size % 32 != 0");
+    bitWidths_.resize(miniBlocksPerBlock_);
+    deltas_.resize(valuesPerMiniBlock_);
+    values_.resize(valuesPerMiniBlock_);
+  }
+
+  /// Returns the number of values in the stream, including the first value
+  /// that is stored in the header.
+  int64_t totalValueCount() const {
+    return totalValueCount_;
+  }
+
+  /// Returns the number of values not yet returned by readValues() or skip().
+  int64_t numValuesLeft() const {
+    return totalValueCount_ - numValuesRead_;
+  }
+
+  /// Returns the position after the last byte consumed. After all values have
+  /// been read this is the end of the encoded data, which is the start of the
+  /// byte array data for DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY.
+  const char* FOLLY_NONNULL bufferStart() const {
+    return bufferStart_;
+  }
+
+  /// Decodes the next 'numValues' values into 'result'. 'T' is int32_t or
+  /// int64_t. Arithmetic is done modulo 2^64 as required by the spec, so that
+  /// narrowing to 'T' gives the right result for INT32 columns.
+  template <typename T>
+  void readValues(T* FOLLY_NONNULL result, int64_t numValues) {
+    VELOX_CHECK_LE(numValues, numValuesLeft(), "Read past end of delta page");
+    int64_t numRead = 0;
+    if (numValues > 0 && numValuesRead_ == 0) {
+      result[numRead++] = static_cast<T>(lastValue_);
+      ++numValuesRead_;
+    }
+    while (numRead < numValues) {
+      if (valueIndex_ == numDecodedValues_) {
+        decodeMiniBlock();
+      }
+      auto numToCopy = std::min<int64_t>(
+          numValues - numRead, numDecodedValues_ - valueIndex_);
+      if constexpr (sizeof(T) == sizeof(uint64_t)) {
+        memcpy(result + numRead, values_.data() + valueIndex_, numToCopy * 8);
+      } else {
+        for (auto i = 0; i < numToCopy; ++i) {
+          result[numRead + i] = static_cast<T>(values_[valueIndex_ + i]);
+        }
+      }
+      valueIndex_ += numToCopy;
+      numRead += numToCopy;
+      numValuesRead_ += numToCopy;
+    }
+  }
+
+  /// Skips 'numValues' values.
+  void skip(int64_t numValues) {
+    VELOX_CHECK_LE(numValues, numValuesLeft(), "Skip past end of delta page");
+    if (numValues > 0 && numValuesRead_ == 0) {
+      --numValues;
+      ++numValuesRead_;
+    }
+    while (numValues > 0) {
+      if (valueIndex_ == numDecodedValues_) {
+        decodeMiniBlock();
+      }
+      auto numToSkip =
+          std::min<int64_t>(numValues, numDecodedValues_ - valueIndex_);
+      valueIndex_ += numToSkip;
+      numValues -= numToSkip;
+      numValuesRead_ += numToSkip;
+    }
+  }
+
+ private:
+  uint64_t readVarint() {
+    uint64_t result = 0;
+    for (auto shift = 0; shift < 64; shift += 7) {
+      VELOX_CHECK_LT(
+          bufferStart_, bufferEnd_, "Truncated DELTA_BINARY_PACKED varint");
+      uint8_t byte = *bufferStart_++;
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+    }
+    VELOX_FAIL("Malformed DELTA_BINARY_PACKED varint");
+  }
+
+  uint64_t readZigZagVarint() {
+    auto value = readVarint();
+    return (value >> 1) ^ -(value & 1);
+  }
+
+  void readBlockHeader() {
+    minDelta_ = readZigZagVarint();
+    VELOX_CHECK_LE(
+        bufferStart_ + miniBlocksPerBlock_,
+        bufferEnd_,
+        "Truncated DELTA_BINARY_PACKED block header");
+    for (auto i = 0; i < miniBlocksPerBlock_; ++i) {
+      bitWidths_[i] = static_cast<uint8_t>(bufferStart_[i]);
+      VELOX_CHECK_LE(
+          bitWidths_[i], 64, "Invalid DELTA_BINARY_PACKED bit width");
+    }
+    bufferStart_ += miniBlocksPerBlock_;
+    miniBlockIndex_ = 0;
+  }
+
+  // Unpacks and prefix sums the next miniblock. Only the values that are part
+  // of the stream are made available, the padding of the last miniblock is
+  // ignored.
+  void decodeMiniBlock() {
+    if (miniBlockIndex_ == miniBlocksPerBlock_ || !blockHeaderRead_) {
+      readBlockHeader();
+      blockHeaderRead_ = true;
+    }
+    auto bitWidth = bitWidths_[miniBlockIndex_++];
+    auto numBytes = static_cast<int64_t>(bitWidth) * valuesPerMiniBlock_ / 8;
+    VELOX_CHECK_LE(
+        bufferStart_ + numBytes,
+        bufferEnd_,
+        "Truncated DELTA_BINARY_PACKED miniblock");
+    unpack(bitWidth);
+    bufferStart_ += numBytes;
+    auto numValues = std::min<int64_t>(valuesPerMiniBlock_, numValuesLeft());
+    auto last = lastValue_;
+    auto minDelta = minDelta_;
+    auto deltas = deltas_.data();
+    auto values = values_.data();
+    for (auto i = 0; i < numValues; ++i) {
+      last += minDelta + deltas[i];
+      values[i] = last;
+    }
+    lastValue_ = last;
+    numDecodedValues_ = numValues;
+    valueIndex_ = 0;
+  }
+
+  // Unpacks 'valuesPerMiniBlock_' little endian bit fields of 'bitWidth' from
+  // 'bufferStart_' into 'deltas_'.
+  void unpack(uint8_t bitWidth) {
+    auto deltas = deltas_.data();
+    if (bitWidth == 0) {
+      std::fill(deltas, deltas + valuesPerMiniBlock_, 0);
+      return;
+    }
+    auto data = reinterpret_cast<const uint8_t*>(bufferStart_);
+    const auto numBytes =
+        static_cast<int64_t>(bitWidth) * valuesPerMiniBlock_ / 8;
+    const uint64_t mask = bitWidth == 64 ? ~0ULL : bits::lowMask(bitWidth);
+    uint64_t bitOffset = 0;
+    for (auto i = 0; i < valuesPerMiniBlock_; ++i, bitOffset += bitWidth) {
+      auto byte = bitOffset >> 3;
+      auto shift = bitOffset & 7;
+      uint64_t word;
+      if (byte + sizeof(uint64_t) <= numBytes) {
+        word = folly::loadUnaligned<uint64_t>(data + byte);
+      } else {
+        word = bits::loadPartialWord(data + byte, numBytes - byte);
+      }
+      uint64_t value = word >> shift;
+      if (shift + bitWidth > 64) {
+        value |= static_cast<uint64_t>(data[byte + 8]) << (64 - shift);
+      }
+      deltas[i] = value & mask;
+    }
+  }
+
+  const char* FOLLY_NONNULL bufferStart_;
+  const char* FOLLY_NONNULL const bufferEnd_;
+
+  uint64_t valuesPerBlock_{0};
+  uint64_t miniBlocksPerBlock_{0};
+  uint64_t valuesPerMiniBlock_{0};
+  int64_t totalValueCount_{0};
+
+  // Number of values returned or skipped, including the first value.
+  int64_t numValuesRead_{0};
+
+  // The last value that was decoded. The next value is 'lastValue_' +
+  // 'minDelta_' + next delta.
+  uint64_t lastValue_{0};
+  uint64_t minDelta_{0};
+
+  bool blockHeaderRead_{false};
+  uint64_t miniBlockIndex_{0};
+  raw_vector<uint8_t> bitWidths_;
+
+  // Unpacked deltas of the current miniblock.
+  raw_vector<uint64_t> deltas_;
+
+  // Decoded values of the current miniblock.
+  raw_vector<uint64_t> values_;
+  int64_t numDecodedValues_{0};
+  int64_t valueIndex_{0};
+};
+
+} // namespace facebook::velox::parquet
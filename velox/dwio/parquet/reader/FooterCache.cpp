@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/FooterCache.h"
+
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::parquet {
+
+// static
+FooterCache& FooterCache::instance() {
+  static FooterCache cache;
+  return cache;
+}
+
+void FooterCache::setCapacity(int64_t capacity) {
+  std::lock_guard<std::mutex> l(mutex_);
+  capacity_ = capacity;
+  evictLocked();
+}
+
+std::shared_ptr<const thrift::FileMetaData> FooterCache::get(
+    std::string_view path,
+    uint64_t fileLength) {
+  if (!enabled()) {
+    return nullptr;
+  }
+  auto fileId = fileIds().id(path);
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  if (fileId == StringIdMap::kNoId) {
+    return nullptr;
+  }
+  auto it = entries_.find(Key{fileId, fileLength});
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->metaData;
+}
+
+void FooterCache::put(
+    std::string_view path,
+    uint64_t fileLength,
+    std::shared_ptr<const thrift::FileMetaData> metaData,
+    int64_t size) {
+  if (!enabled() || size > capacity_) {
+    return;
+  }
+  StringIdLease fileId(fileIds(), path);
+  std::lock_guard<std::mutex> l(mutex_);
+  Key key{fileId.id(), fileLength};
+  if (entries_.count(key)) {
+    // Another split of the same file got here first.
+    return;
+  }
+  lru_.push_front(
+      Entry{std::move(fileId), fileLength, std::move(metaData), size});
+  entries_[key] = lru_.begin();
+  size_ += size;
+  evictLocked();
+}
+
+void FooterCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  size_ = 0;
+}
+
+SimpleLRUCacheStats FooterCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return {
+      static_cast<size_t>(capacity_),
+      static_cast<size_t>(size_),
+      numHits_,
+      numLookups_};
+}
+
+void FooterCache::evictLocked() {
+  while (size_ > capacity_ && !lru_.empty()) {
+    auto& entry = lru_.back();
+    entries_.erase(Key{entry.fileId.id(), entry.fileLength});
+    size_ -= entry.size;
+    lru_.pop_back();
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/caching/StringIdMap.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+namespace facebook::velox::parquet {
+
+/// Process wide cache of parsed Parquet footers, shared by the readers of all
+/// splits of a file. Entries are keyed on the id of the file path in
+/// fileIds() and the file size, so that a file rewritten with a different size
+/// is not served a stale footer. The size of an entry is the size of the
+/// serialized footer. Entries are evicted in LRU order when the total size
+/// exceeds the capacity. A capacity of 0, the default, disables the cache.
+/// Thread safe.
+class FooterCache {
+ public:
+  explicit FooterCache(int64_t capacity = 0) : capacity_(capacity) {}
+
+  /// Returns the cache used by ParquetReader.
+  static FooterCache& instance();
+
+  /// Sets the maximum total size of cached footers. Evicts entries if the new
+  /// capacity is smaller than the current size.
+  void setCapacity(int64_t capacity);
+
+  bool enabled() const {
+    return capacity_ > 0;
+  }
+
+  /// Returns the footer of 'path' of 'fileLength' bytes or nullptr if none is
+  /// cached.
+  std::shared_ptr<const thrift::FileMetaData> get(
+      std::string_view path,
+      uint64_t fileLength);
+
+  /// Adds 'metaData' for 'path' of 'fileLength' bytes. 'size' is the size of
+  /// the serialized footer. Does nothing if disabled or if 'size' is larger
+  /// than the capacity.
+  void put(
+      std::string_view path,
+      uint64_t fileLength,
+      std::shared_ptr<const thrift::FileMetaData> metaData,
+      int64_t size);
+
+  void clear();
+
+  /// Returns the capacity and current size in bytes and the hit counts.
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  struct Key {
+    uint64_t fileId;
+    uint64_t fileLength;
+
+    bool operator==(const Key& other) const {
+      return fileId == other.fileId && fileLength == other.fileLength;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return folly::hash::hash_combine(key.fileId, key.fileLength);
+    }
+  };
+
+  struct Entry {
+    // Keeps the id of the file path live while the entry is cached.
+    StringIdLease fileId;
+    uint64_t fileLength;
+    std::shared_ptr<const thrift::FileMetaData> metaData;
+    int64_t size;
+  };
+
+  // Removes least recently used entries until the size is at most
+  // 'capacity_'. 'mutex_' must be held.
+  void evictLocked();
+
+  mutable std::mutex mutex_;
+  std::atomic<int64_t> capacity_;
+  int64_t size_{0};
+  uint64_t numHits_{0};
+  uint64_t numLookups_{0};
+
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<Key, std::list<Entry>::iterator, KeyHasher> entries_;
+};
+
+} // namespace facebook::velox::parquet
@@ -34,10 +34,7 @@ class IntegerColumnReader : public dwio::common::SelectiveIntegerColumnReader {
             std::move(fileType)) {}
 
   bool hasBulkPath() const override {
-    return !this->fileType().type()->isLongDecimal() &&
-        ((this->fileType().type()->isShortDecimal())
-             ? formatData_->as<ParquetData>().hasDictionary()
-             : true);
+    return !this->fileType().type()->isLongDecimal();
   }
 
   void seekToRowGroup(uint32_t index) override {
@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
@@ -28,9 +29,10 @@ namespace facebook::velox::parquet {
 using thrift::Encoding;
 using thrift::PageHeader;
 
-void PageReader::seekToPage(int64_t row) {
+void PageReader::seekToPage(int64_t row, bool mayPrune) {
   defineDecoder_.reset();
   repeatDecoder_.reset();
+  pagePruned_ = false;
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
@@ -46,13 +48,21 @@ void PageReader::seekToPage(int64_t row) {
 
     switch (pageHeader.type) {
       case thrift::PageType::DATA_PAGE:
-        prepareDataPageV1(pageHeader, row);
-        break;
       case thrift::PageType::DATA_PAGE_V2:
-        prepareDataPageV2(pageHeader, row);
+        ++dataPageIndex_;
+        pagePruned_ = false;
+        if (mayPrune && row != kRepDefOnly &&
+            dataPageIndex_ < prunedPages_.size() &&
+            prunedPages_[dataPageIndex_]) {
+          skipPrunedPage(pageHeader, dataStart);
+        } else if (pageHeader.type == thrift::PageType::DATA_PAGE) {
+          prepareDataPageV1(pageHeader, row);
+        } else {
+          prepareDataPageV2(pageHeader, row);
+        }
         break;
       case thrift::PageType::DICTIONARY_PAGE:
-        if (row == kRepDefOnly) {
+        if (row == kRepDefOnly || nullsOnly_) {
           skipBytes(
               pageHeader.compressed_page_size,
               inputStream_.get(),
@@ -72,6 +82,44 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::skipPrunedPage(
+    const PageHeader& pageHeader,
+    uint64_t pageStart) {
+  VELOX_DCHECK(isTopLevel_);
+  numRepDefsInPage_ = pageHeader.type == thrift::PageType::DATA_PAGE
+      ? pageHeader.data_page_header.num_values
+      : pageHeader.data_page_header_v2.num_values;
+  setPageRowInfo(false);
+  dwio::common::skipBytes(
+      pageHeader.compressed_page_size,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  pagePruned_ = true;
+  prunedPageStart_ = pageStart;
+}
+
+void PageReader::loadPrunedPage() {
+  VELOX_CHECK(pagePruned_);
+  pagePruned_ = false;
+  std::vector<uint64_t> position = {prunedPageStart_};
+  dwio::common::PositionProvider positionProvider(position);
+  inputStream_->seekToPosition(positionProvider);
+  bufferStart_ = bufferEnd_ = nullptr;
+  pageStart_ = prunedPageStart_;
+  auto pageHeader = readPageHeader();
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  if (pageHeader.type == thrift::PageType::DATA_PAGE) {
+    prepareDataPageV1(pageHeader, rowOfPage_);
+  } else {
+    prepareDataPageV2(pageHeader, rowOfPage_);
+  }
+  auto numSkipped = std::max<int64_t>(0, firstUnvisited_ - rowOfPage_);
+  if (numSkipped > 0) {
+    skipInPage(numSkipped);
+  }
+}
+
 PageHeader PageReader::readPageHeader() {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
@@ -272,7 +320,7 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
     readPageDefLevels();
   }
 
-  if (row != kRepDefOnly) {
+  if (row != kRepDefOnly && !nullsOnly_) {
     makeDecoder();
   }
 }
@@ -315,6 +363,11 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
   auto levelsSize = repeatLength + defineLength;
   pageData_ += levelsSize;
+  if (nullsOnly_) {
+    // The levels are not compressed in V2 pages, the values are not needed.
+    encodedDataSize_ = 0;
+    return;
+  }
   if (pageHeader.data_page_header_v2.__isset.is_compressed ||
       pageHeader.data_page_header_v2.is_compressed) {
     pageData_ = decompressData(
@@ -493,15 +546,100 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
   }
 }
 
-void PageReader::makeFilterCache(dwio::common::ScanState& state) {
+namespace {
+template <typename T>
+void testDictionaryValues(
+    const common::Filter& filter,
+    const T* values,
+    int32_t numValues,
+    uint8_t* cache) {
+  int32_t i = 0;
+  if constexpr (std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>) {
+    constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+    for (; i + kBatchSize <= numValues; i += kBatchSize) {
+      auto passed = simd::toBitMask(
+          filter.testValues(xsimd::load_unaligned(values + i)));
+      for (auto j = 0; j < kBatchSize; ++j) {
+        cache[i + j] = (passed & (1 << j))
+            ? dwio::common::FilterResult::kSuccess
+            : dwio::common::FilterResult::kFailure;
+      }
+    }
+  }
+  for (; i < numValues; ++i) {
+    cache[i] = common::applyFilter(filter, values[i])
+        ? dwio::common::FilterResult::kSuccess
+        : dwio::common::FilterResult::kFailure;
+  }
+}
+} // namespace
+
+void PageReader::makeFilterCache(
+    dwio::common::ScanState& state,
+    const common::Filter* filter) {
   VELOX_CHECK(
       !state.dictionary2.values, "Parquet supports only one dictionary");
   state.filterCache.resize(state.dictionary.numValues);
+  state.rawState.filterCache = state.filterCache.data();
+  // Evaluating the filter on the whole dictionary up front lets the
+  // dictionary visitors filter ids with a plain gather from the cache. This
+  // pays off when the dictionary is not larger than the rows being read,
+  // otherwise the entries are filled in on first use.
+  if (filter && filter->isDeterministic() &&
+      dictionary_.numValues <= numVisitorRows_ &&
+      fillFilterCache(*filter, state.filterCache.data())) {
+    return;
+  }
   simd::memset(
       state.filterCache.data(),
       dwio::common::FilterResult::kUnknown,
       state.filterCache.size());
-  state.rawState.filterCache = state.filterCache.data();
+}
+
+bool PageReader::fillFilterCache(const common::Filter& filter, uint8_t* cache) {
+  const auto numValues = dictionary_.numValues;
+  const auto& type = type_->type();
+  switch (type_->parquetType_.value()) {
+    case thrift::Type::INT32:
+      if (type->isShortDecimal()) {
+        testDictionaryValues(
+            filter, dictionary_.values->as<int64_t>(), numValues, cache);
+      } else {
+        testDictionaryValues(
+            filter, dictionary_.values->as<int32_t>(), numValues, cache);
+      }
+      return true;
+    case thrift::Type::INT64:
+      testDictionaryValues(
+          filter, dictionary_.values->as<int64_t>(), numValues, cache);
+      return true;
+    case thrift::Type::FLOAT:
+      testDictionaryValues(
+          filter, dictionary_.values->as<float>(), numValues, cache);
+      return true;
+    case thrift::Type::DOUBLE:
+      testDictionaryValues(
+          filter, dictionary_.values->as<double>(), numValues, cache);
+      return true;
+    case thrift::Type::BYTE_ARRAY:
+      testDictionaryValues(
+          filter, dictionary_.values->as<StringView>(), numValues, cache);
+      return true;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      if (type->isShortDecimal()) {
+        testDictionaryValues(
+            filter, dictionary_.values->as<int64_t>(), numValues, cache);
+        return true;
+      }
+      if (type->isLongDecimal()) {
+        testDictionaryValues(
+            filter, dictionary_.values->as<int128_t>(), numValues, cache);
+        return true;
+      }
+      return false;
+    default:
+      return false;
+  }
 }
 
 namespace {
@@ -517,6 +655,38 @@ int32_t parquetTypeBytes(thrift::Type::type type) {
       VELOX_FAIL("Type does not have a byte width {}", type);
   }
 }
+
+// Returns the big endian two's complement decimal of 'numBytes' at 'data' as
+// a little endian 'T'.
+template <typename T>
+inline T readBigEndianDecimal(const char* data, int32_t numBytes) {
+  T value = static_cast<int8_t>(data[0]) < 0 ? -1 : 0;
+  memcpy(
+      reinterpret_cast<char*>(&value) + sizeof(T) - numBytes, data, numBytes);
+  if constexpr (sizeof(T) == sizeof(int64_t)) {
+    return __builtin_bswap64(value);
+  } else {
+    return bits::builtin_bswap128(value);
+  }
+}
+
+template <typename T>
+void readBigEndianDecimals(
+    const char* data,
+    int32_t typeLength,
+    int64_t numValues,
+    T* values) {
+  if (typeLength == sizeof(T)) {
+    // Constant width so that the loop compiles to loads and byte swaps.
+    for (auto i = 0; i < numValues; ++i) {
+      values[i] = readBigEndianDecimal<T>(data + i * sizeof(T), sizeof(T));
+    }
+  } else {
+    for (auto i = 0; i < numValues; ++i) {
+      values[i] = readBigEndianDecimal<T>(data + i * typeLength, typeLength);
+    }
+  }
+}
 } // namespace
 
 void PageReader::preloadRepDefs() {
@@ -556,6 +726,7 @@ void PageReader::preloadRepDefs() {
   bufferStart_ = bufferEnd_ = nullptr;
   rowOfPage_ = 0;
   numRowsInPage_ = 0;
+  dataPageIndex_ = -1;
   pageData_ = nullptr;
 }
 
@@ -649,6 +820,11 @@ void PageReader::makeDecoder() {
               pageData_, pageData_ + encodedDataSize_);
           break;
         case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+          if (type_->type()->isDecimal()) {
+            makeDecimalDecoder(
+                pageData_, encodedDataSize_ / type_->typeLength_);
+            break;
+          }
           directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
               std::make_unique<dwio::common::SeekableArrayInputStream>(
                   pageData_, encodedDataSize_),
@@ -656,6 +832,12 @@ void PageReader::makeDecoder() {
               type_->typeLength_,
               true);
           break;
+        case thrift::Type::INT32:
+          if (type_->type()->isShortDecimal()) {
+            makeDecimalDecoder(pageData_, encodedDataSize_ / sizeof(int32_t));
+            break;
+          }
+          [[fallthrough]];
         default: {
           directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
               std::make_unique<dwio::common::SeekableArrayInputStream>(
@@ -666,11 +848,164 @@ void PageReader::makeDecoder() {
       }
       break;
     case Encoding::DELTA_BINARY_PACKED:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          makeDeltaBinaryPackedDecoder();
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BINARY_PACKED is only valid for INT32 and INT64, not {}",
+              parquetType);
+      }
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      switch (parquetType) {
+        case thrift::Type::BYTE_ARRAY:
+        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+          makeDeltaByteArrayDecoder();
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "Encoding {} is only valid for byte arrays, not {}",
+              encoding_,
+              parquetType);
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makeDeltaBinaryPackedDecoder() {
+  DeltaBpDecoder decoder(pageData_, pageData_ + encodedDataSize_);
+  auto numValues = decoder.totalValueCount();
+  auto typeBytes = parquetTypeBytes(type_->parquetType_.value());
+  auto numBytes = numValues * typeBytes;
+  dwio::common::ensureCapacity<char>(decodedPageData_, numBytes, &pool_);
+  if (typeBytes == sizeof(int32_t)) {
+    decoder.readValues(decodedPageData_->asMutable<int32_t>(), numValues);
+    if (type_->type()->isShortDecimal()) {
+      makeDecimalDecoder(decodedPageData_->as<char>(), numValues);
+      return;
+    }
+  } else {
+    decoder.readValues(decodedPageData_->asMutable<int64_t>(), numValues);
+  }
+  // The page is now in PLAIN layout, so the direct decoder and its fast path
+  // apply as is.
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          decodedPageData_->as<char>(), numBytes),
+      false,
+      typeBytes);
+}
+
+void PageReader::makeDeltaByteArrayDecoder() {
+  const bool isFixedLength =
+      type_->parquetType_.value() == thrift::Type::FIXED_LEN_BYTE_ARRAY;
+  const char* data = pageData_;
+  const char* end = pageData_ + encodedDataSize_;
+  // DELTA_BYTE_ARRAY prefixes the suffix lengths and suffixes with the
+  // DELTA_BINARY_PACKED lengths of the prefix shared with the previous value.
+  raw_vector<int32_t> prefixLengths;
+  if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    DeltaBpDecoder prefixDecoder(data, end);
+    prefixLengths.resize(prefixDecoder.totalValueCount());
+    prefixDecoder.readValues(prefixLengths.data(), prefixLengths.size());
+    data = prefixDecoder.bufferStart();
+  }
+  DeltaBpDecoder lengthDecoder(data, end);
+  raw_vector<int32_t> lengths(lengthDecoder.totalValueCount());
+  lengthDecoder.readValues(lengths.data(), lengths.size());
+  const char* suffixes = lengthDecoder.bufferStart();
+  const int32_t numValues = lengths.size();
+  VELOX_CHECK(
+      prefixLengths.empty() || prefixLengths.size() == lengths.size(),
+      "DELTA_BYTE_ARRAY prefix and suffix counts differ");
+
+  // Rewrite the values into PLAIN layout, i.e. 4 byte length followed by the
+  // bytes for variable width and the bare bytes for fixed width values.
+  int64_t numBytes = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    VELOX_CHECK_GE(lengths[i], 0, "Negative length in {}", encoding_);
+    numBytes += lengths[i] + (prefixLengths.empty() ? 0 : prefixLengths[i]);
+  }
+  if (!isFixedLength) {
+    numBytes += numValues * sizeof(int32_t);
+  }
+  dwio::common::ensureCapacity<char>(decodedPageData_, numBytes, &pool_);
+  auto* out = decodedPageData_->asMutable<char>();
+  const char* previous = nullptr;
+  int32_t previousLength = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    auto prefixLength = prefixLengths.empty() ? 0 : prefixLengths[i];
+    VELOX_CHECK_LE(
+        prefixLength, previousLength, "DELTA_BYTE_ARRAY prefix too long");
+    VELOX_CHECK_LE(suffixes + lengths[i], end, "Read past end of page");
+    int32_t length = prefixLength + lengths[i];
+    if (isFixedLength) {
+      VELOX_CHECK_EQ(length, type_->typeLength_);
+    } else {
+      memcpy(out, &length, sizeof(int32_t));
+      out += sizeof(int32_t);
+    }
+    if (prefixLength) {
+      memmove(out, previous, prefixLength);
+    }
+    memcpy(out + prefixLength, suffixes, lengths[i]);
+    suffixes += lengths[i];
+    previous = out;
+    previousLength = length;
+    out += length;
+  }
+  if (isFixedLength && type_->type()->isDecimal()) {
+    makeDecimalDecoder(decodedPageData_->as<char>(), numValues);
+  } else if (isFixedLength) {
+    directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            decodedPageData_->as<char>(), numBytes),
+        false,
+        type_->typeLength_,
+        true);
+  } else {
+    stringDecoder_ = std::make_unique<StringDecoder>(
+        decodedPageData_->as<char>(), decodedPageData_->as<char>() + numBytes);
+  }
+}
+
+void PageReader::makeDecimalDecoder(const char* data, int64_t numValues) {
+  const bool isLongDecimal = type_->type()->isLongDecimal();
+  const int32_t veloxTypeLength =
+      isLongDecimal ? sizeof(int128_t) : sizeof(int64_t);
+  const int64_t numBytes = numValues * veloxTypeLength;
+  dwio::common::ensureCapacity<char>(decimalPageData_, numBytes, &pool_);
+  if (type_->parquetType_.value() == thrift::Type::INT32) {
+    auto values = decimalPageData_->asMutable<int64_t>();
+    for (auto i = 0; i < numValues; ++i) {
+      values[i] = folly::loadUnaligned<int32_t>(data + i * sizeof(int32_t));
+    }
+  } else if (isLongDecimal) {
+    readBigEndianDecimals(
+        data,
+        type_->typeLength_,
+        numValues,
+        decimalPageData_->asMutable<int128_t>());
+  } else {
+    readBigEndianDecimals(
+        data,
+        type_->typeLength_,
+        numValues,
+        decimalPageData_->asMutable<int64_t>());
+  }
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          decimalPageData_->as<char>(), numBytes),
+      false,
+      veloxTypeLength);
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -685,9 +1020,17 @@ void PageReader::skip(int64_t numRows) {
     toSkip -= rowOfPage_ - firstUnvisited_;
   }
   firstUnvisited_ += numRows;
+  if (pagePruned_) {
+    // Nothing is decoded on a pruned page. loadPrunedPage() positions the
+    // decoders at 'firstUnvisited_' if the page is read later.
+    return;
+  }
+  skipInPage(toSkip);
+}
 
+void PageReader::skipInPage(int64_t numRows) {
   // Skip nulls
-  toSkip = skipNulls(toSkip);
+  auto toSkip = skipNulls(numRows);
 
   // Skip the decoder
   if (isDictionary()) {
@@ -725,6 +1068,11 @@ int32_t PageReader::skipNulls(int32_t numValues) {
 }
 
 void PageReader::skipNullsOnly(int64_t numRows) {
+  if (nullsOnly_ && maxDefine_ == 0) {
+    // A required column has no nulls and no page needs to be read.
+    firstUnvisited_ += numRows;
+    return;
+  }
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
     return;
@@ -735,6 +1083,9 @@ void PageReader::skipNullsOnly(int64_t numRows) {
     firstUnvisited_ += numRows;
     toSkip = firstUnvisited_ - rowOfPage_;
   } else {
+    if (pagePruned_) {
+      loadPrunedPage();
+    }
     firstUnvisited_ += numRows;
   }
 
@@ -744,6 +1095,11 @@ void PageReader::skipNullsOnly(int64_t numRows) {
 
 void PageReader::readNullsOnly(int64_t numValues, BufferPtr& buffer) {
   VELOX_CHECK(!maxRepeat_);
+  if (nullsOnly_ && maxDefine_ == 0) {
+    firstUnvisited_ += numValues;
+    buffer = nullptr;
+    return;
+  }
   auto toRead = numValues;
   if (buffer) {
     dwio::common::ensureCapacity<bool>(buffer, numValues, &pool_);
@@ -754,6 +1110,8 @@ void PageReader::readNullsOnly(int64_t numValues, BufferPtr& buffer) {
     if (!availableOnPage) {
       seekToPage(firstUnvisited_);
       availableOnPage = numRowsInPage_;
+    } else if (pagePruned_) {
+      loadPrunedPage();
     }
     auto numRead = std::min(availableOnPage, toRead);
     auto nulls = readNulls(numRead, nullsInReadRange_);
@@ -802,6 +1160,7 @@ bool PageReader::rowsForPage(
     bool mayProduceNulls,
     folly::Range<const vector_size_t*>& rows,
     const uint64_t* FOLLY_NULLABLE& nulls) {
+  VELOX_DCHECK(!nullsOnly_, "Reading values from a nulls only column");
   if (currentVisitorRow_ == numVisitorRows_) {
     return false;
   }
@@ -809,18 +1168,36 @@ bool PageReader::rowsForPage(
   // Check if the first row to go to is in the current page. If not, seek to the
   // page that contains the row.
   auto rowZero = visitBase_ + visitorRows_[currentVisitorRow_];
+  const bool mayPrune = hasFilter && !prunedPages_.empty();
   if (rowZero >= rowOfPage_ + numRowsInPage_) {
-    seekToPage(rowZero);
+    seekToPage(rowZero, mayPrune);
     if (hasChunkRepDefs_) {
       numLeafNullsConsumed_ = rowOfPage_;
     }
+  } else if (pagePruned_ && !mayPrune) {
+    loadPrunedPage();
+  }
+  while (pagePruned_) {
+    // No row on a pruned page passes the filter. Move to the first row to
+    // visit after the page without decoding anything.
+    int32_t firstOnNextPage = rowOfPage_ + numRowsInPage_ - visitBase_;
+    auto next = std::lower_bound(
+        visitorRows_ + currentVisitorRow_,
+        visitorRows_ + numVisitorRows_,
+        firstOnNextPage);
+    currentVisitorRow_ = next - visitorRows_;
+    if (currentVisitorRow_ == numVisitorRows_) {
+      firstUnvisited_ = visitBase_ + visitorRows_[numVisitorRows_ - 1] + 1;
+      return false;
+    }
+    seekToPage(visitBase_ + visitorRows_[currentVisitorRow_], true);
   }
   auto& scanState = reader.scanState();
   if (isDictionary()) {
     if (scanState.dictionary.values != dictionary_.values) {
       scanState.dictionary = dictionary_;
       if (hasFilter) {
-        makeFilterCache(scanState);
+        makeFilterCache(scanState, reader.scanSpec()->filter());
       }
       scanState.updateRawState();
     }
@@ -71,6 +71,26 @@ class PageReader {
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Reads the dictionary and decompresses and decodes the first data page if
+  /// no page has been read yet. This may run on a thread other than the one
+  /// doing the reads, so that the first pages of different columns are
+  /// prepared in parallel.
+  void preloadFirstPage() {
+    if (rowOfPage_ == 0 && numRowsInPage_ == 0) {
+      seekToPage(0, !prunedPages_.empty());
+    }
+  }
+
+  /// Makes 'this' read only definition levels. Dictionary pages are skipped
+  /// and no value decoders are made. V2 data pages are not decompressed since
+  /// their levels are stored uncompressed. Must be set before the first page
+  /// is read and only if readNullsOnly() and skipNullsOnly() are the only
+  /// accesses to the column chunk.
+  void setNullsOnly() {
+    VELOX_CHECK(isTopLevel_);
+    nullsOnly_ = true;
+  }
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -132,6 +152,13 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Sets a flag per data page of the column chunk. A true flag means that no
+  /// row of the page passes the filter of the column, so that the page is not
+  /// decompressed or decoded when read with the filter.
+  void setPrunedPages(std::vector<bool> prunedPages) {
+    prunedPages_ = std::move(prunedPages);
+  }
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -150,8 +177,17 @@ class PageReader {
   // current page.
   int32_t skipNulls(int32_t numRows);
 
-  // Initializes a filter result cache for the dictionary in 'state'.
-  void makeFilterCache(dwio::common::ScanState& state);
+  // Initializes a filter result cache for the dictionary in 'state'. If
+  // 'filter' is given and the dictionary is small compared to the rows being
+  // read, the cache is filled by evaluating 'filter' on all dictionary
+  // entries.
+  void makeFilterCache(
+      dwio::common::ScanState& state,
+      const common::Filter* FOLLY_NULLABLE filter);
+
+  // Sets 'cache' to the result of 'filter' for each entry of 'dictionary_'.
+  // Returns false if the dictionary type is not supported.
+  bool fillFilterCache(const common::Filter& filter, uint8_t* cache);
 
   // Makes a decoder based on 'encoding_' for bytes from ''pageData_' to
   // 'pageData_' + 'encodedDataSize_'.
@@ -163,8 +199,22 @@ class PageReader {
   // getting repdefs for the next page. If non-top level column, 'row'
   // is interpreted in terms of leaf rows, including leaf
   // nulls. Seeking ahead of pages covered by decodeRepDefs is not
-  // allowed for non-top level columns.
-  void seekToPage(int64_t row);
+  // allowed for non-top level columns. If 'mayPrune' is true, a page flagged
+  // in 'prunedPages_' is skipped over without decompression and
+  // 'pagePruned_' is set.
+  void seekToPage(int64_t row, bool mayPrune = false);
+
+  // Skips the data of a data page that is flagged in 'prunedPages_'. Sets the
+  // row info for the page so that rows can be counted without decoding.
+  void skipPrunedPage(const thrift::PageHeader& pageHeader, uint64_t pageStart);
+
+  // Rereads and decodes the current page after it was skipped as pruned and
+  // positions the decoders at 'firstUnvisited_'. Called when the pruned page
+  // is accessed without the filter.
+  void loadPrunedPage();
+
+  // Advances the nulls and the decoder of the current page by 'numRows'.
+  void skipInPage(int64_t numRows);
 
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
@@ -188,6 +238,21 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Decodes a DELTA_BINARY_PACKED page into 'decodedPageData_' in PLAIN layout
+  // and makes a direct decoder over it.
+  void makeDeltaBinaryPackedDecoder();
+
+  // Decodes a DELTA_LENGTH_BYTE_ARRAY or DELTA_BYTE_ARRAY page into
+  // 'decodedPageData_' in PLAIN layout and makes a string or fixed length
+  // decoder over it.
+  void makeDeltaByteArrayDecoder();
+
+  // Converts 'numValues' decimals at 'data' from their Parquet layout, i.e.
+  // INT32 or big endian FIXED_LEN_BYTE_ARRAY, into little endian int64_t or
+  // int128_t in 'decimalPageData_' and makes a direct decoder over them. The
+  // direct decoder fast path then applies to short decimals.
+  void makeDecimalDecoder(const char* data, int64_t numValues);
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -258,8 +323,7 @@ class PageReader {
       Visitor visitor) {
     if (nulls) {
       nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor) &&
-          (!this->type_->type()->isLongDecimal()) &&
-          (this->type_->type()->isShortDecimal() ? isDictionary() : true);
+          !this->type_->type()->isLongDecimal();
 
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
@@ -273,8 +337,7 @@ class PageReader {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else {
-        directDecoder_->readWithVisitor<false>(
-            nulls, visitor, !this->type_->type()->isShortDecimal());
+        directDecoder_->readWithVisitor<false>(nulls, visitor);
       }
     }
   }
@@ -371,6 +434,23 @@ class PageReader {
   // Number of leaf values in each data page of column chunk.
   std::vector<int32_t> numLeavesInPage_;
 
+  // Ordinal of the current data page in the column chunk. -1 means before
+  // first data page.
+  int32_t dataPageIndex_{-1};
+
+  // Flag per data page, true if no row of the page can pass the filter
+  // according to the page index.
+  std::vector<bool> prunedPages_;
+
+  // True if the current page was skipped over as pruned and has no decoder.
+  bool pagePruned_{false};
+
+  // Offset of the header of the current page if 'pagePruned_'.
+  uint64_t prunedPageStart_{0};
+
+  // True if only nulls are read. See setNullsOnly().
+  bool nullsOnly_{false};
+
   // First position in '*levels_' for the range of last decodeRepDefs().
   int32_t repDefBegin_{0};
 
@@ -412,6 +492,12 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Values of a page with a delta encoding, rewritten in PLAIN layout.
+  BufferPtr decodedPageData_;
+
+  // Decimal values of a page, converted to the Velox representation.
+  BufferPtr decimalPageData_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
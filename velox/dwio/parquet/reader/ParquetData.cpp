@@ -17,7 +17,11 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
 
 namespace facebook::velox::parquet {
 
@@ -25,9 +29,27 @@ using thrift::RowGroup;
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, pool(), &scanSpec, input_);
+}
+
+namespace {
+// Reads a thrift struct from the start of 'stream'.
+template <typename T>
+void readThrift(dwio::common::SeekableInputStream& stream, T& object) {
+  const void* buffer;
+  int32_t size;
+  VELOX_CHECK(stream.Next(&buffer, &size), "Empty thrift stream");
+  auto bufferStart = reinterpret_cast<const char*>(buffer);
+  auto bufferEnd = bufferStart + size;
+  auto transport = std::make_shared<thrift::ThriftStreamingTransport>(
+      &stream, bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  object.read(&protocol);
 }
+} // namespace
 
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
@@ -79,9 +101,36 @@ bool ParquetData::rowGroupMatches(
         rowGroup.columns[column].meta_data.statistics,
         *type,
         rowGroup.num_rows);
-    return testFilter(filter, columnStats.get(), rowGroup.num_rows, type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.num_rows, type)) {
+      return false;
+    }
   }
-  return true;
+  return bloomFilterMatches(rowGroupId, *filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  auto& chunk = rowGroups_[rowGroupId].columns[type_->column()];
+  if (!input_ || !chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset ||
+      !type_->parquetType_.has_value() || type_->type()->isDecimal() ||
+      !canUseBloomFilter(filter, type_->parquetType_.value())) {
+    return true;
+  }
+  auto it = bloomFilters_.find(rowGroupId);
+  if (it == bloomFilters_.end()) {
+    it = bloomFilters_
+             .emplace(
+                 rowGroupId,
+                 BloomFilter::read(
+                     *input_, chunk.meta_data.bloom_filter_offset))
+             .first;
+  }
+  if (!it->second) {
+    return true;
+  }
+  return testBloomFilter(filter, *it->second, type_->parquetType_.value());
 }
 
 void ParquetData::enqueueRowGroup(
@@ -109,6 +158,82 @@ void ParquetData::enqueueRowGroup(
 
   auto id = dwio::common::StreamIdentifier(type_->column());
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+
+  if (usePageIndex(chunk)) {
+    columnIndexStreams_.resize(rowGroups_.size());
+    offsetIndexStreams_.resize(rowGroups_.size());
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.column_index_offset),
+         static_cast<uint64_t>(chunk.column_index_length)},
+        &id);
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offset_index_offset),
+         static_cast<uint64_t>(chunk.offset_index_length)},
+        &id);
+  }
+}
+
+bool ParquetData::usePageIndex(const thrift::ColumnChunk& chunk) const {
+  if (!scanSpec_ || !scanSpec_->filter() || maxRepeat_ > 0 ||
+      maxDefine_ > 1) {
+    return false;
+  }
+  return chunk.__isset.column_index_offset &&
+      chunk.__isset.column_index_length && chunk.__isset.offset_index_offset &&
+      chunk.__isset.offset_index_length && chunk.column_index_length > 0 &&
+      chunk.offset_index_length > 0;
+}
+
+std::vector<bool> ParquetData::prunedPages(uint32_t index) {
+  if (index >= columnIndexStreams_.size() || !columnIndexStreams_[index] ||
+      !scanSpec_->filter()) {
+    return {};
+  }
+  thrift::ColumnIndex columnIndex;
+  thrift::OffsetIndex offsetIndex;
+  readThrift(*columnIndexStreams_[index], columnIndex);
+  readThrift(*offsetIndexStreams_[index], offsetIndex);
+  columnIndexStreams_[index].reset();
+  offsetIndexStreams_[index].reset();
+
+  auto& locations = offsetIndex.page_locations;
+  const auto numPages = locations.size();
+  if (columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages ||
+      (columnIndex.__isset.null_counts &&
+       columnIndex.null_counts.size() != numPages)) {
+    // Malformed index. Read all pages.
+    return {};
+  }
+  auto* filter = scanSpec_->filter();
+  auto type = type_->type();
+  const auto rowGroupRows = rowGroups_[index].num_rows;
+  std::vector<bool> pruned(numPages);
+  bool anyPruned = false;
+  for (auto i = 0; i < numPages; ++i) {
+    const int64_t numRows =
+        (i + 1 < numPages ? locations[i + 1].first_row_index : rowGroupRows) -
+        locations[i].first_row_index;
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(numRows);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (columnIndex.__isset.null_counts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, numRows);
+    pruned[i] = !testFilter(filter, columnStats.get(), numRows, type);
+    anyPruned |= pruned[i];
+  }
+  if (!anyPruned) {
+    return {};
+  }
+  return pruned;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -122,9 +247,31 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  auto pruned = prunedPages(index);
+  if (!pruned.empty()) {
+    reader_->setPrunedPages(std::move(pruned));
+  }
+  if (readsNullsOnly()) {
+    reader_->setNullsOnly();
+  }
   return dwio::common::PositionProvider(empty);
 }
 
+bool ParquetData::readsNullsOnly() const {
+  if (!scanSpec_ || !scanSpec_->filter() || maxRepeat_ > 0 || maxDefine_ > 1) {
+    return false;
+  }
+  // Only direct children of the root are read with readNullsOnly() and
+  // skipNullsOnly() alone. Members of structs may be skipped with skip().
+  if (!type_->parent() || type_->parent()->parent()) {
+    return false;
+  }
+  // Same condition as SelectiveColumnReader::readsNullsOnly().
+  auto kind = scanSpec_->filter()->kind();
+  return kind == common::FilterKind::kIsNull ||
+      (!scanSpec_->keepValues() && kind == common::FilterKind::kIsNotNull);
+}
+
 std::pair<int64_t, int64_t> ParquetData::getRowGroupRegion(
     uint32_t index) const {
   auto& rowGroup = rowGroups_[index];
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -35,14 +38,18 @@ class ParquetParams : public dwio::common::FormatParams {
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const thrift::FileMetaData& metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const thrift::FileMetaData& metaData,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr)
+      : FormatParams(pool, stats), metaData_(metaData), input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const thrift::FileMetaData& metaData_;
+  // Input for reading Bloom filters on demand. Bloom filters are not used if
+  // not set.
+  dwio::common::BufferedInput* FOLLY_NULLABLE const input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +58,14 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const common::ScanSpec* FOLLY_NULLABLE scanSpec = nullptr,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        scanSpec_(scanSpec),
+        input_(input),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -77,6 +88,15 @@ class ParquetData : public dwio::common::FormatData {
     return reader_.get();
   }
 
+  /// Prepares the first page of the current row group. See
+  /// PageReader::preloadFirstPage(). Repeated columns are skipped since their
+  /// pages are read together with the repdefs of the whole chunk.
+  void preloadFirstPage() {
+    if (reader_ && maxRepeat_ == 0) {
+      reader_->preloadFirstPage();
+    }
+  }
+
   // Reads null flags for 'numValues' next top level rows. The first 'numValues'
   // bits of 'nulls' are set and the reader is advanced by numValues'.
   void readNullsOnly(int32_t numValues, BufferPtr& nulls) {
@@ -187,13 +207,46 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if the Bloom filter of the column chunk in 'rowGroupId' rules out
+  /// all values that pass 'filter'. The Bloom filter is read on first use.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  /// True if the only filter is on nullness and the values of the column are
+  /// never read, so that pages can be read for their definition levels only.
+  bool readsNullsOnly() const;
+
+  /// True if the filter of 'scanSpec_' can be tested against the page index
+  /// of 'chunk'. Page skipping is limited to top level non-repeated columns,
+  /// where page row ranges are known without decoding repdefs.
+  bool usePageIndex(const thrift::ColumnChunk& chunk) const;
+
+  /// Returns a flag per data page of 'index'th row group that is true if the
+  /// ColumnIndex min/max/null counts show that the page has no rows passing
+  /// the filter of 'scanSpec_'. Returns an empty vector if no page can be
+  /// skipped or if there is no page index.
+  std::vector<bool> prunedPages(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
+  // Spec for the column of 'this'. The filter is tested against the page
+  // index when positioning at a row group.
+  const common::ScanSpec* FOLLY_NULLABLE const scanSpec_;
+  // Input for reading Bloom filters.
+  dwio::common::BufferedInput* FOLLY_NULLABLE const input_;
+  // Bloom filters of the column chunks, indexed by row group. A nullptr entry
+  // means unsupported filter. Entries are added on first use.
+  folly::F14FastMap<uint32_t, std::unique_ptr<BloomFilter>> bloomFilters_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
+  // Streams for the ColumnIndex and OffsetIndex of each of 'rowGroups_'. Set
+  // only if the column has a filter and the file has a page index.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
 
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 
+#include "velox/dwio/common/ExecutorBarrier.h"
+#include "velox/dwio/parquet/reader/FooterCache.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -111,7 +113,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // May be shared with readers of other splits through FooterCache.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -139,6 +142,13 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto& footerCache = FooterCache::instance();
+  const auto fileName = input_->getReadFile()->getName();
+  if (auto cached = footerCache.get(fileName, fileLength_)) {
+    fileMetaData_ = std::move(cached);
+    return;
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, directorySizeGuess_);
   uint64_t readSize = preloadFile ? fileLength_ : directorySizeGuess_;
@@ -185,8 +195,10 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  footerCache.put(fileName, fileLength_, fileMetaData_, footerLength);
 }
 
 void ReaderBase::initializeSchema() {
@@ -637,7 +649,11 @@ ParquetRowReader::ParquetRowReader(
   if (rowGroups_.empty()) {
     return; // TODO
   }
-  ParquetParams params(pool_, columnReaderStats_, readerBase_->fileMetaData());
+  ParquetParams params(
+      pool_,
+      columnReaderStats_,
+      readerBase_->fileMetaData(),
+      &readerBase_->bufferedInput());
   auto columnSelector = std::make_shared<ColumnSelector>(
       ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
   columnReader_ = ParquetColumnReader::build(
@@ -645,6 +661,15 @@ ParquetRowReader::ParquetRowReader(
       readerBase_->schemaWithId(), // Id is schema id
       params,
       *options_.getScanSpec());
+  // Top level maps and arrays without filters are returned as LazyVectors.
+  // Their repdefs and leaves are then decoded only for the rows that pass the
+  // filters on the other columns, and not at all if they are never loaded.
+  for (auto* child : columnReader_->children()) {
+    auto kind = child->fileType().type()->kind();
+    if (kind == TypeKind::MAP || kind == TypeKind::ARRAY) {
+      child->setIsTopLevel();
+    }
+  }
 
   filterRowGroups();
   if (!rowGroupIds_.empty()) {
@@ -740,6 +765,15 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowInGroup_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
+  if (auto& executor = options_.getDecodingExecutor()) {
+    // Decompress and decode the first page of each column in parallel. The
+    // buffers are allocated from the reader's pool and are the ones the
+    // column readers would allocate on their first read, so the read-ahead
+    // is bounded by one page per column.
+    dwio::common::ExecutorBarrier barrier(*executor);
+    static_cast<StructColumnReader&>(*columnReader_).preloadPages(barrier);
+    barrier.waitAll();
+  }
   return true;
 }
 
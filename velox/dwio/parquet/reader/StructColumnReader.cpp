@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ExecutorBarrier.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/RepeatedColumnReader.h"
 
@@ -150,6 +151,27 @@ void StructColumnReader::seekToRowGroup(uint32_t index) {
   }
 }
 
+void StructColumnReader::preloadPages(dwio::common::ExecutorBarrier& barrier) {
+  for (auto* child : children_) {
+    if (!child) {
+      continue;
+    }
+    switch (child->fileType().type()->kind()) {
+      case TypeKind::ROW:
+        reinterpret_cast<StructColumnReader*>(child)->preloadPages(barrier);
+        break;
+      case TypeKind::ARRAY:
+      case TypeKind::MAP:
+        break;
+      default:
+        barrier.add([child]() {
+          child->formatData().as<ParquetData>().preloadFirstPage();
+        });
+        break;
+    }
+  }
+}
+
 void StructColumnReader::seekToEndOfPresetNulls() {
   auto numUnread = formatData_->as<ParquetData>().presetNullsLeft();
   for (auto i = 0; i < children_.size(); ++i) {
@@ -22,6 +22,7 @@
 
 namespace facebook::velox::dwio::common {
 class BufferedInput;
+class ExecutorBarrier;
 }
 
 namespace facebook::velox::parquet {
@@ -43,6 +44,11 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
 
   void seekToRowGroup(uint32_t index) override;
 
+  /// Adds a task to 'barrier' for each leaf non-repeated column that prepares
+  /// the first page of the current row group. Must be called after
+  /// seekToRowGroup() and before the first read.
+  void preloadPages(dwio::common::ExecutorBarrier& barrier);
+
   /// Creates the streams for 'rowGroup'. Checks whether row 'rowGroup'
   /// has been buffered in 'input'. If true, return the input. Or else creates
   /// the streams in a new input and loads.
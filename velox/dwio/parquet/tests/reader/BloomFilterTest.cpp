@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+class BloomFilterTest : public testing::Test {
+ protected:
+  // Makes a filter with the even numbers in [0, 2 * 'numValues').
+  std::unique_ptr<BloomFilter> makeEvenNumbers(
+      int32_t numValues,
+      thrift::Type::type parquetType) {
+    auto filter = std::make_unique<BloomFilter>(numValues);
+    for (int64_t i = 0; i < numValues; ++i) {
+      filter->insert(
+          parquetType == thrift::Type::INT32
+              ? BloomFilter::hash(static_cast<int32_t>(i * 2))
+              : BloomFilter::hash(i * 2));
+    }
+    return filter;
+  }
+};
+
+TEST_F(BloomFilterTest, insertAndTest) {
+  constexpr int32_t kNumValues = 10'000;
+  auto filter = makeEvenNumbers(kNumValues, thrift::Type::INT64);
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < kNumValues; ++i) {
+    EXPECT_TRUE(filter->mayContain(BloomFilter::hash(i * 2)));
+    numFalsePositives += filter->mayContain(BloomFilter::hash(i * 2 + 1));
+  }
+  // One byte per value gives a false positive rate of a few percent.
+  EXPECT_LT(numFalsePositives, kNumValues / 10);
+}
+
+TEST_F(BloomFilterTest, integerFilters) {
+  for (auto parquetType : {thrift::Type::INT32, thrift::Type::INT64}) {
+    auto bloomFilter = makeEvenNumbers(1'000, parquetType);
+    common::BigintRange hit(10, 10, false);
+    EXPECT_TRUE(canUseBloomFilter(hit, parquetType));
+    EXPECT_TRUE(testBloomFilter(hit, *bloomFilter, parquetType));
+
+    // Ranges and filters passing nulls cannot be decided.
+    common::BigintRange range(11, 13, false);
+    EXPECT_FALSE(canUseBloomFilter(range, parquetType));
+    EXPECT_TRUE(testBloomFilter(range, *bloomFilter, parquetType));
+    common::BigintRange nullAllowed(5'001, 5'001, true);
+    EXPECT_FALSE(canUseBloomFilter(nullAllowed, parquetType));
+
+    // Values that are not in the filter are rejected with high
+    // probability. Use values far out of the inserted range so that the test
+    // is deterministic with respect to the hash.
+    int32_t numHits = 0;
+    for (int64_t i = 0; i < 100; ++i) {
+      common::BigintRange miss(1'000'001 + i * 2, 1'000'001 + i * 2, false);
+      numHits += testBloomFilter(miss, *bloomFilter, parquetType);
+    }
+    EXPECT_LT(numHits, 20);
+
+    auto values = common::createBigintValues({3, 5, 7, 100'003}, false);
+    EXPECT_TRUE(canUseBloomFilter(*values, parquetType));
+    auto withHit = common::createBigintValues({3, 5, 8, 100'003}, false);
+    EXPECT_TRUE(testBloomFilter(*withHit, *bloomFilter, parquetType));
+  }
+}
+
+TEST_F(BloomFilterTest, bytesFilters) {
+  BloomFilter bloomFilter(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter.insert(BloomFilter::hash(fmt::format("key{}", i)));
+  }
+  common::BytesValues hit({"key1", "nokey", "key3"}, false);
+  EXPECT_TRUE(canUseBloomFilter(hit, thrift::Type::BYTE_ARRAY));
+  EXPECT_TRUE(testBloomFilter(hit, bloomFilter, thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(canUseBloomFilter(hit, thrift::Type::INT64));
+
+  common::BytesRange single(
+      "key500", false, false, "key500", false, false, false);
+  EXPECT_TRUE(testBloomFilter(single, bloomFilter, thrift::Type::BYTE_ARRAY));
+
+  int32_t numHits = 0;
+  for (auto i = 0; i < 100; ++i) {
+    common::BytesValues miss({fmt::format("other{}", i)}, false);
+    numHits += testBloomFilter(miss, bloomFilter, thrift::Type::BYTE_ARRAY);
+  }
+  EXPECT_LT(numHits, 20);
+}
@@ -18,6 +18,7 @@
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 using namespace facebook::velox;
@@ -85,8 +86,18 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
+  void setUpRowReaderOptions(
+      dwio::common::RowReaderOptions& opts,
+      const std::shared_ptr<ScanSpec>& spec) override {
+    E2EFilterTestBase::setUpRowReaderOptions(opts, spec);
+    if (decodingExecutor_) {
+      opts.setDecodingExecutor(decodingExecutor_);
+    }
+  }
+
   std::unique_ptr<facebook::velox::parquet::Writer> writer_;
   facebook::velox::parquet::WriterOptions options_;
+  std::shared_ptr<folly::Executor> decodingExecutor_;
   uint64_t rowsInRowGroup_ = 10'000;
   int64_t bytesInRowGroup_ = 128 * 1'024 * 1'024;
 };
@@ -128,6 +139,50 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BINARY_PACKED;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "long_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            10000000000, // rareMax
+            true); // keepNulls
+        makeStringUnique("string_val");
+      },
+      true,
+      {"short_val", "int_val", "long_val", "string_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {common::CompressionKind_SNAPPY,
@@ -194,6 +249,37 @@ TEST_F(E2EFilterTest, compression) {
   }
 }
 
+TEST_F(E2EFilterTest, parallelPagePreload) {
+  decodingExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  options_.dataPageSize = 4 * 1024;
+  if (facebook::velox::parquet::Writer::isCodecAvailable(
+          common::CompressionKind_ZSTD)) {
+    options_.compression = common::CompressionKind_ZSTD;
+  }
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string,"
+      "struct_val:struct<a:bigint,b:double>",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "long_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            10000000000, // rareMax
+            true); // keepNulls
+        makeStringDistribution("string_val", 100, true, false);
+      },
+      false,
+      {"short_val", "int_val", "long_val", "string_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, integerDictionary) {
   options_.dataPageSize = 4 * 1024;
 
@@ -430,6 +516,26 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaEncoded) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  for (auto encoding :
+       {facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY,
+        facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY}) {
+    options_.encoding = encoding;
+    testWithTypes(
+        "string_val:string,"
+        "string_val_2:string",
+        [&]() {
+          makeStringUnique("string_val");
+          makeStringDistribution("string_val_2", 170, false, true);
+        },
+        true,
+        {"string_val", "string_val_2"},
+        20);
+  }
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -445,6 +551,47 @@ TEST_F(E2EFilterTest, stringDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDictionaryOutput) {
+  // Strings from a dictionary encoded column chunk are returned as indices
+  // into the dictionary instead of being copied into a flat vector.
+  rowType_ = ROW({"s"}, {VARCHAR()});
+  const std::vector<std::string> distinct = {"apple", "banana", "cherry"};
+  constexpr int32_t kSize = 1'000;
+  auto strings = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kSize, leafPool_.get());
+  for (auto i = 0; i < kSize; ++i) {
+    strings->set(i, StringView(distinct[i % distinct.size()]));
+  }
+  std::vector<RowVectorPtr> batches = {std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kSize,
+      std::vector<VectorPtr>{strings})};
+  writeToMemory(rowType_, batches, false);
+
+  dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+  std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+  auto input = std::make_unique<BufferedInput>(
+      std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+  auto reader = makeReader(readerOpts, std::move(input));
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  dwio::common::RowReaderOptions rowReaderOpts;
+  setUpRowReaderOptions(rowReaderOpts, spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+  ASSERT_TRUE(rowReader->next(kSize, result));
+  ASSERT_EQ(result->size(), kSize);
+  auto column = result->as<RowVector>()->childAt(0);
+  EXPECT_EQ(column->encoding(), VectorEncoding::Simple::DICTIONARY);
+  EXPECT_EQ(column->valueVector()->size(), distinct.size());
+  for (auto i = 0; i < kSize; ++i) {
+    ASSERT_TRUE(column->equalValueAt(strings.get(), i, i));
+  }
+}
+
 TEST_F(E2EFilterTest, dedictionarize) {
   rowsInRowGroup_ = 10'000;
   options_.dictionaryPageSizeLimit = 20'000;
@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/dwio/parquet/reader/FooterCache.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 
+#include <folly/ScopeGuard.h>
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
@@ -788,6 +791,45 @@ TEST_F(ParquetReaderTest, preloadSmallFile) {
   }
 }
 
+TEST_F(ParquetReaderTest, footerCache) {
+  auto& cache = FooterCache::instance();
+  cache.clear();
+  cache.setCapacity(1 << 20);
+  SCOPE_EXIT {
+    cache.setCapacity(0);
+    cache.clear();
+  };
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  facebook::velox::dwio::common::ReaderOptions readerOptions{defaultPool.get()};
+  auto first = createReader(sample, readerOptions);
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numHits, 0);
+  EXPECT_GT(stats.curSize, 0);
+
+  // The second reader of the same file reuses the footer.
+  auto file = std::make_shared<LocalReadFile>(sample);
+  auto input = std::make_unique<BufferedInput>(file, *defaultPool);
+  auto second =
+      std::make_unique<ParquetReader>(std::move(input), readerOptions);
+  EXPECT_EQ(cache.stats().numHits, 1);
+  EXPECT_EQ(file->bytesRead(), 0);
+  EXPECT_EQ(second->numberOfRows(), 20ULL);
+
+  auto rowReaderOpts = getReaderOpts(sampleSchema());
+  rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+  auto rowReader = second->createRowReader(rowReaderOpts);
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  assertReadWithReaderAndExpected(
+      sampleSchema(), *rowReader, expected, *leafPool_);
+
+  // Shrinking the capacity below the footer size evicts it.
+  cache.setCapacity(1);
+  EXPECT_EQ(cache.stats().curSize, 0);
+}
+
 TEST_F(ParquetReaderTest, prefetchRowGroups) {
   auto rowType = ROW({"id"}, {BIGINT()});
   const std::string sample(getExampleFilePath("multiple_row_groups.parquet"));
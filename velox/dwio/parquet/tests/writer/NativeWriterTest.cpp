@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fstream>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+class NativeWriterTest : public ParquetTestBase {
+ protected:
+  std::string writeFile(
+      const std::string& name,
+      const std::vector<RowVectorPtr>& batches,
+      WriterOptions options = {}) {
+    auto path = fmt::format("{}/{}", tempPath_->path, name);
+    options.memoryPool = rootPool_.get();
+    NativeWriter writer{createSink(path), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return path;
+  }
+
+  void assertRead(
+      const std::string& path,
+      const std::vector<RowVectorPtr>& batches) {
+    auto rowType = asRowType(batches[0]->type());
+    auto expected = BaseVector::create<RowVector>(rowType, 0, leafPool_.get());
+    for (const auto& batch : batches) {
+      expected->append(batch.get());
+    }
+    dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+    auto reader = createReader(path, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), expected->size());
+    auto rowReaderOptions = getReaderOpts(rowType);
+    rowReaderOptions.setScanSpec(makeScanSpec(rowType));
+    auto rowReader = reader->createRowReader(rowReaderOptions);
+    assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+  }
+
+  static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+};
+
+TEST_F(NativeWriterTest, roundTrip) {
+  auto rowType = ROW(
+      {"bool", "tiny", "small", "int", "date", "big", "real", "double", "s"},
+      {BOOLEAN(),
+       TINYINT(),
+       SMALLINT(),
+       INTEGER(),
+       DATE(),
+       BIGINT(),
+       REAL(),
+       DOUBLE(),
+       VARCHAR()});
+  VectorFuzzer fuzzer({.vectorSize = 1'000, .nullRatio = 0.1}, leafPool_.get());
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 5; ++i) {
+    batches.push_back(fuzzer.fuzzInputFlatRow(rowType));
+  }
+
+  // Small pages and row groups that are cut inside batches.
+  WriterOptions options;
+  options.dataPageSize = 1'024;
+  options.flushPolicyFactory = [] {
+    return std::make_unique<DefaultFlushPolicy>(1'500, kBytesInRowGroup);
+  };
+  assertRead(writeFile("dictionary.parquet", batches, options), batches);
+
+  options.enableDictionary = false;
+  assertRead(writeFile("plain.parquet", batches, options), batches);
+}
+
+TEST_F(NativeWriterTest, dictionaryFallback) {
+  // Mostly distinct strings overflow a small dictionary, so that each row
+  // group has dictionary encoded pages followed by PLAIN pages.
+  auto batch = makeRowVector(
+      {makeFlatVector<StringView>(
+           10'000,
+           [](auto row) {
+             return StringView::makeInline(fmt::format("value {}", row));
+           }),
+       makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  WriterOptions options;
+  options.dictionaryPageSizeLimit = 4'096;
+  options.dataPageSize = 4'096;
+  assertRead(writeFile("fallback.parquet", {batch}), {batch});
+  assertRead(writeFile("fallbackSmall.parquet", {batch}, options), {batch});
+}
+
+TEST_F(NativeWriterTest, encodedInput) {
+  // Dictionary and constant encoded input is mapped to the column
+  // dictionary once per base value and writes the same file as flat input.
+  const vector_size_t size = 5'000;
+  auto base = makeFlatVector<StringView>(
+      100,
+      [](auto row) {
+        return StringView::makeInline(fmt::format("string {}", row % 37));
+      },
+      nullEvery(11));
+  auto indices = makeIndices(size, [](auto row) { return (row * 7) % 100; });
+  auto batch = makeRowVector(
+      {BaseVector::wrapInDictionary(nullptr, indices, size, base),
+       BaseVector::createConstant(BIGINT(), 42, size, leafPool_.get()),
+       wrapInDictionary(
+           indices,
+           size,
+           makeFlatVector<int32_t>(100, [](auto row) { return row % 13; }))});
+  auto flat = std::static_pointer_cast<RowVector>(BaseVector::copy(*batch));
+
+  auto encodedPath = writeFile("encoded.parquet", {batch});
+  auto flatPath = writeFile("flat.parquet", {flat});
+  EXPECT_EQ(readFile(encodedPath), readFile(flatPath));
+  assertRead(encodedPath, {batch});
+}
+
+TEST_F(NativeWriterTest, compression) {
+  auto rowType = ROW({"a", "b", "c"}, {BIGINT(), DOUBLE(), VARCHAR()});
+  VectorFuzzer fuzzer({.vectorSize = 2'000, .nullRatio = 0.1}, leafPool_.get());
+  std::vector<RowVectorPtr> batches{
+      fuzzer.fuzzInputFlatRow(rowType), fuzzer.fuzzInputFlatRow(rowType)};
+  for (auto kind :
+       {common::CompressionKind_SNAPPY, common::CompressionKind_ZSTD}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    WriterOptions options;
+    options.compression = kind;
+    options.dataPageSize = 8'192;
+    assertRead(
+        writeFile(
+            fmt::format("{}.parquet", common::compressionKindToString(kind)),
+            batches,
+            options),
+        batches);
+  }
+}
+
+TEST_F(NativeWriterTest, unsupportedType) {
+  auto batch = makeRowVector({makeArrayVector<int32_t>({{1, 2}, {3}})});
+  auto path = fmt::format("{}/unsupported.parquet", tempPath_->path);
+  WriterOptions options;
+  options.memoryPool = rootPool_.get();
+  NativeWriter writer{createSink(path), options};
+  VELOX_ASSERT_THROW(
+      writer.write(batch), "Unsupported type for Parquet native writer");
+}
@@ -18,6 +18,7 @@
 
 #include <thrift/transport/TVirtualTransport.h>
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/DataBuffer.h"
 
 namespace facebook::velox::parquet::thrift {
 
@@ -92,4 +93,20 @@ class ThriftBufferedTransport : public ThriftTransport {
   uint64_t offset_;
 };
 
+/// Appends serialized Thrift structs to a DataBuffer.
+class ThriftBufferSink
+    : public apache::thrift::transport::TVirtualTransport<ThriftBufferSink> {
+ public:
+  explicit ThriftBufferSink(dwio::common::DataBuffer<char>& buffer)
+      : buffer_(buffer) {}
+
+  void write(const uint8_t* buf, uint32_t len) {
+    buffer_.extendAppend(
+        buffer_.size(), reinterpret_cast<const char*>(buf), len);
+  }
+
+ private:
+  dwio::common::DataBuffer<char>& buffer_;
+};
+
 } // namespace facebook::velox::parquet::thrift
@@ -0,0 +1,884 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+
+#include <folly/Random.h>
+#include <folly/container/F14Map.h>
+#include <folly/io/IOBuf.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#include "velox/common/compression/Compression.h"
+#include "velox/common/memory/AllocationPool.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+using dwio::common::DataBuffer;
+
+namespace {
+
+constexpr std::string_view kMagic{"PAR1"};
+constexpr uint32_t kNoId = std::numeric_limits<uint32_t>::max();
+// Maximum number of groups of 8 values in one bit packed run. Keeps the run
+// header in one byte.
+constexpr uint64_t kMaxBitPackedGroups = 63;
+
+template <typename T>
+void serialize(const T& object, DataBuffer<char>& out) {
+  auto transport = std::make_shared<thrift::ThriftBufferSink>(out);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftBufferSink>
+      protocol(transport);
+  object.write(&protocol);
+}
+
+template <typename T>
+void appendValue(T value, DataBuffer<char>& out) {
+  out.extendAppend(
+      out.size(), reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+std::string toBytes(T value) {
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void resetBuffer(DataBuffer<T>& buffer) {
+  if (buffer.size() > 0) {
+    buffer.resize(0);
+  }
+}
+
+void appendVarint(uint64_t value, DataBuffer<char>& out) {
+  while (value >= 0x80) {
+    out.append(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.append(static_cast<char>(value));
+}
+
+// Returns the number of bits needed for values up to 'maxValue', at least 1.
+int32_t bitWidth(uint64_t maxValue) {
+  return maxValue == 0 ? 1 : 64 - __builtin_clzll(maxValue);
+}
+
+// Returns true if 8 equal values start at 'begin'.
+template <typename T>
+bool startsRepeat(const T* values, uint64_t begin, uint64_t end) {
+  if (begin + 8 > end) {
+    return false;
+  }
+  for (auto i = begin + 1; i < begin + 8; ++i) {
+    if (values[i] != values[begin]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Appends 'values' in the RLE / bit packing hybrid encoding of the Parquet
+// spec. Runs of at least 8 equal values are run length encoded, everything
+// else is bit packed in groups of 8.
+template <typename T>
+void encodeRleBitPacked(
+    const T* values,
+    uint64_t numValues,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  const int32_t valueBytes = (bitWidth + 7) / 8;
+  uint64_t i = 0;
+  while (i < numValues) {
+    uint64_t repeat = 1;
+    while (i + repeat < numValues && values[i + repeat] == values[i]) {
+      ++repeat;
+    }
+    if (repeat >= 8) {
+      appendVarint(repeat << 1, out);
+      const uint64_t value = values[i];
+      for (auto byte = 0; byte < valueBytes; ++byte) {
+        out.append(static_cast<char>(value >> (byte * 8)));
+      }
+      i += repeat;
+      continue;
+    }
+    // Bit pack up to the next repeat. The last group is padded with zeros.
+    uint64_t end = i + 8;
+    while (end < numValues && end - i < kMaxBitPackedGroups * 8 &&
+           !startsRepeat(values, end, numValues)) {
+      end += 8;
+    }
+    appendVarint((end - i) / 8 << 1 | 1, out);
+    uint64_t bits = 0;
+    int32_t numBits = 0;
+    for (auto j = i; j < end; ++j) {
+      const uint64_t value = j < numValues ? values[j] : 0;
+      bits |= value << numBits;
+      numBits += bitWidth;
+      while (numBits >= 8) {
+        out.append(static_cast<char>(bits));
+        bits >>= 8;
+        numBits -= 8;
+      }
+    }
+    i = end;
+  }
+}
+
+thrift::CompressionCodec::type toThriftCodec(common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    case common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported compression for Parquet native writer: {}",
+          common::compressionKindToString(kind));
+  }
+}
+
+thrift::Type::type toPhysicalType(const TypePtr& type) {
+  VELOX_CHECK(
+      NativeWriter::isSupportedType(type),
+      "Unsupported type for Parquet native writer: {}",
+      type->toString());
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return thrift::Type::BOOLEAN;
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+      return thrift::Type::INT32;
+    case TypeKind::BIGINT:
+      return thrift::Type::INT64;
+    case TypeKind::REAL:
+      return thrift::Type::FLOAT;
+    case TypeKind::DOUBLE:
+      return thrift::Type::DOUBLE;
+    default:
+      return thrift::Type::BYTE_ARRAY;
+  }
+}
+
+template <typename P, typename T>
+P toPhysical(T value) {
+  if constexpr (std::is_same_v<T, StringView>) {
+    return std::string_view(value.data(), value.size());
+  } else {
+    return static_cast<P>(value);
+  }
+}
+
+} // namespace
+
+/// Encodes the values of one column into the pages of the column chunk of the
+/// current row group.
+class ColumnChunkWriter {
+ public:
+  ColumnChunkWriter(
+      std::string name,
+      TypePtr type,
+      const WriterOptions& options,
+      memory::MemoryPool& pool)
+      : name_(std::move(name)),
+        type_(std::move(type)),
+        physicalType_(toPhysicalType(type_)),
+        codec_(toThriftCodec(options.compression)),
+        enableDictionary_(
+            options.enableDictionary &&
+            physicalType_ != thrift::Type::BOOLEAN),
+        dataPageSize_(options.dataPageSize),
+        dictionaryPageSizeLimit_(options.dictionaryPageSizeLimit),
+        compressor_(
+            codec_ == thrift::CompressionCodec::UNCOMPRESSED
+                ? nullptr
+                : common::compressionKindToCodec(options.compression)),
+        defLevels_(pool),
+        indices_(pool),
+        plain_(pool),
+        pageBody_(pool),
+        chunk_(pool),
+        dictionaryMode_(enableDictionary_),
+        dictionary_(pool),
+        fixedIds_(memory::StlAllocator<std::pair<const uint64_t, uint32_t>>(
+            pool)),
+        stringIds_(
+            memory::StlAllocator<std::pair<const std::string_view, uint32_t>>(
+                pool)),
+        stringPool_(&pool),
+        baseIds_(pool) {}
+
+  /// Appends rows [begin, end) of 'decoded'.
+  void write(
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end) {
+    switch (type_->kind()) {
+      case TypeKind::BOOLEAN:
+        return writeValues<bool, bool>(decoded, begin, end);
+      case TypeKind::TINYINT:
+        return writeValues<int8_t, int32_t>(decoded, begin, end);
+      case TypeKind::SMALLINT:
+        return writeValues<int16_t, int32_t>(decoded, begin, end);
+      case TypeKind::INTEGER:
+        return writeValues<int32_t, int32_t>(decoded, begin, end);
+      case TypeKind::BIGINT:
+        return writeValues<int64_t, int64_t>(decoded, begin, end);
+      case TypeKind::REAL:
+        return writeValues<float, float>(decoded, begin, end);
+      case TypeKind::DOUBLE:
+        return writeValues<double, double>(decoded, begin, end);
+      default:
+        return writeValues<StringView, std::string_view>(decoded, begin, end);
+    }
+  }
+
+  /// Returns the size of the encoded data of the current row group.
+  int64_t bufferedBytes() const {
+    return chunk_.size() + dictionary_.size() + pageBytes();
+  }
+
+  /// Appends the column chunk of the current row group to 'out' and starts a
+  /// new row group. 'fileOffset' is the offset of the end of 'out' in the
+  /// file.
+  thrift::ColumnChunk flush(DataBuffer<char>& out, int64_t fileOffset);
+
+  thrift::SchemaElement schemaElement() const;
+
+ private:
+  template <typename T, typename P>
+  void writeValues(
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end);
+
+  // Sizes 'baseIds_' for mapping the base values of 'decoded' to dictionary
+  // ids once per base value. Returns false if the base has more values than
+  // 'numRows' or if there is no base.
+  bool prepareBaseIds(const DecodedVector& decoded, vector_size_t numRows);
+
+  // Returns the dictionary id of 'value', adding it if new.
+  template <typename P>
+  uint32_t addToDictionary(P value);
+
+  template <typename P>
+  void appendPlain(P value, DataBuffer<char>& out);
+
+  template <typename P>
+  void updateStats(P value);
+
+  // Returns the PLAIN encoded min or max for the column chunk statistics.
+  std::string statsValue(bool min) const;
+
+  // Estimated size of the current page.
+  int64_t pageBytes() const {
+    const int64_t valueBytes = physicalType_ == thrift::Type::BOOLEAN
+        ? plain_.size() / 8
+        : plain_.size();
+    return valueBytes + indices_.size() * bitWidth(dictionarySize_) / 8 +
+        defLevels_.size() / 8;
+  }
+
+  // Encodes the current page into 'chunk_'.
+  void finishPage();
+
+  // Compresses 'size' bytes at 'data' into a page with 'header' and appends
+  // it to 'out'. Returns the uncompressed size of the page with its header.
+  int64_t writePage(
+      thrift::PageHeader& header,
+      const char* data,
+      uint64_t size,
+      DataBuffer<char>& out);
+
+  const std::string name_;
+  const TypePtr type_;
+  const thrift::Type::type physicalType_;
+  const thrift::CompressionCodec::type codec_;
+  const bool enableDictionary_;
+  const int64_t dataPageSize_;
+  const int64_t dictionaryPageSizeLimit_;
+  const std::unique_ptr<folly::io::Codec> compressor_;
+
+  // The current page. 'defLevels_' has 1 for a non-null and 0 for a null row.
+  int32_t pageNumValues_{0};
+  DataBuffer<uint8_t> defLevels_;
+  DataBuffer<uint32_t> indices_;
+  DataBuffer<char> plain_;
+  DataBuffer<char> pageBody_;
+
+  // The data pages of the current row group.
+  DataBuffer<char> chunk_;
+  int64_t chunkUncompressedBytes_{0};
+  int64_t numValues_{0};
+  int64_t nullCount_{0};
+  bool hasDictionaryPages_{false};
+  bool hasPlainPages_{false};
+
+  // False after falling back to PLAIN for the rest of the row group.
+  bool dictionaryMode_;
+  // The PLAIN encoded dictionary of the current row group.
+  DataBuffer<char> dictionary_;
+  uint32_t dictionarySize_{0};
+  // Dictionary ids by bit pattern of fixed width values. Keying on the bits
+  // makes NaNs equal.
+  folly::F14FastMap<
+      uint64_t,
+      uint32_t,
+      folly::f14::DefaultHasher<uint64_t>,
+      folly::f14::DefaultKeyEqual<uint64_t>,
+      memory::StlAllocator<std::pair<const uint64_t, uint32_t>>>
+      fixedIds_;
+  // Dictionary ids of strings. The keys point into 'stringPool_'.
+  folly::F14FastMap<
+      std::string_view,
+      uint32_t,
+      folly::f14::DefaultHasher<std::string_view>,
+      folly::f14::DefaultKeyEqual<std::string_view>,
+      memory::StlAllocator<std::pair<const std::string_view, uint32_t>>>
+      stringIds_;
+  memory::AllocationPool stringPool_;
+  // Dictionary id of each base value of dictionary or constant encoded input,
+  // kNoId if not seen yet.
+  DataBuffer<uint32_t> baseIds_;
+
+  // Min and max of the current row group.
+  bool hasMinMax_{false};
+  int64_t minInt_{0};
+  int64_t maxInt_{0};
+  double minDouble_{0};
+  double maxDouble_{0};
+  std::string minString_;
+  std::string maxString_;
+};
+
+template <typename T, typename P>
+void ColumnChunkWriter::writeValues(
+    const DecodedVector& decoded,
+    vector_size_t begin,
+    vector_size_t end) {
+  const bool passThrough =
+      dictionaryMode_ && prepareBaseIds(decoded, end - begin);
+  for (auto row = begin; row < end; ++row) {
+    ++pageNumValues_;
+    if (decoded.isNullAt(row)) {
+      defLevels_.append(0);
+      ++nullCount_;
+    } else {
+      defLevels_.append(1);
+      if (dictionaryMode_) {
+        uint32_t id;
+        if (passThrough) {
+          auto& baseId = baseIds_[decoded.isConstantMapping()
+                                      ? 0
+                                      : decoded.index(row)];
+          if (baseId == kNoId) {
+            baseId = addToDictionary(toPhysical<P>(decoded.valueAt<T>(row)));
+          }
+          id = baseId;
+        } else {
+          id = addToDictionary(toPhysical<P>(decoded.valueAt<T>(row)));
+        }
+        indices_.append(id);
+        if (dictionary_.size() > dictionaryPageSizeLimit_) {
+          finishPage();
+          dictionaryMode_ = false;
+        }
+      } else {
+        const auto value = toPhysical<P>(decoded.valueAt<T>(row));
+        updateStats(value);
+        appendPlain(value, plain_);
+      }
+    }
+    if (pageBytes() >= dataPageSize_) {
+      finishPage();
+    }
+  }
+}
+
+bool ColumnChunkWriter::prepareBaseIds(
+    const DecodedVector& decoded,
+    vector_size_t numRows) {
+  if (decoded.isIdentityMapping()) {
+    return false;
+  }
+  const vector_size_t baseSize =
+      decoded.isConstantMapping() ? 1 : decoded.base()->size();
+  if (baseSize == 0 || baseSize > numRows) {
+    return false;
+  }
+  baseIds_.resize(baseSize);
+  std::fill(baseIds_.data(), baseIds_.data() + baseSize, kNoId);
+  return true;
+}
+
+template <typename P>
+uint32_t ColumnChunkWriter::addToDictionary(P value) {
+  if constexpr (std::is_same_v<P, std::string_view>) {
+    auto it = stringIds_.find(value);
+    if (it != stringIds_.end()) {
+      return it->second;
+    }
+    std::string_view key;
+    if (!value.empty()) {
+      auto* copy = stringPool_.allocateFixed(value.size());
+      std::memcpy(copy, value.data(), value.size());
+      key = std::string_view(copy, value.size());
+    }
+    stringIds_.emplace(key, dictionarySize_);
+  } else {
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(P));
+    auto [it, inserted] = fixedIds_.try_emplace(bits, dictionarySize_);
+    if (!inserted) {
+      return it->second;
+    }
+  }
+  updateStats(value);
+  appendPlain(value, dictionary_);
+  return dictionarySize_++;
+}
+
+template <typename P>
+void ColumnChunkWriter::appendPlain(P value, DataBuffer<char>& out) {
+  if constexpr (std::is_same_v<P, std::string_view>) {
+    appendValue<uint32_t>(value.size(), out);
+    out.extendAppend(out.size(), value.data(), value.size());
+  } else if constexpr (std::is_same_v<P, bool>) {
+    // Bit packed when the page is finished.
+    out.append(value ? 1 : 0);
+  } else {
+    appendValue(value, out);
+  }
+}
+
+template <typename P>
+void ColumnChunkWriter::updateStats(P value) {
+  if constexpr (std::is_same_v<P, std::string_view>) {
+    if (!hasMinMax_ || value < minString_) {
+      minString_ = value;
+    }
+    if (!hasMinMax_ || value > maxString_) {
+      maxString_ = value;
+    }
+  } else if constexpr (std::is_floating_point_v<P>) {
+    // NaNs are left out of the statistics.
+    if (std::isnan(value)) {
+      return;
+    }
+    if (!hasMinMax_ || value < minDouble_) {
+      minDouble_ = value;
+    }
+    if (!hasMinMax_ || value > maxDouble_) {
+      maxDouble_ = value;
+    }
+  } else {
+    if (!hasMinMax_ || value < minInt_) {
+      minInt_ = value;
+    }
+    if (!hasMinMax_ || value > maxInt_) {
+      maxInt_ = value;
+    }
+  }
+  hasMinMax_ = true;
+}
+
+std::string ColumnChunkWriter::statsValue(bool min) const {
+  switch (physicalType_) {
+    case thrift::Type::BOOLEAN:
+      return toBytes<bool>(min ? minInt_ : maxInt_);
+    case thrift::Type::INT32:
+      return toBytes<int32_t>(min ? minInt_ : maxInt_);
+    case thrift::Type::INT64:
+      return toBytes<int64_t>(min ? minInt_ : maxInt_);
+    case thrift::Type::FLOAT:
+    case thrift::Type::DOUBLE: {
+      // Zeros are written as -0.0 for min and +0.0 for max so that readers
+      // comparing either zero get the right answer.
+      auto value = min ? minDouble_ : maxDouble_;
+      if (value == 0) {
+        value = min ? -0.0 : 0.0;
+      }
+      return physicalType_ == thrift::Type::FLOAT
+          ? toBytes<float>(value)
+          : toBytes<double>(value);
+    }
+    default:
+      return min ? minString_ : maxString_;
+  }
+}
+
+void ColumnChunkWriter::finishPage() {
+  resetBuffer(pageBody_);
+  // Definition levels prefixed by their size.
+  appendValue<int32_t>(0, pageBody_);
+  encodeRleBitPacked(defLevels_.data(), defLevels_.size(), 1, pageBody_);
+  const int32_t levelsSize = pageBody_.size() - sizeof(int32_t);
+  std::memcpy(pageBody_.data(), &levelsSize, sizeof(int32_t));
+
+  thrift::Encoding::type encoding;
+  if (indices_.size() > 0) {
+    const auto indexBitWidth = bitWidth(dictionarySize_ - 1);
+    pageBody_.append(static_cast<char>(indexBitWidth));
+    encodeRleBitPacked(
+        indices_.data(), indices_.size(), indexBitWidth, pageBody_);
+    encoding = thrift::Encoding::RLE_DICTIONARY;
+    hasDictionaryPages_ = true;
+  } else {
+    if (physicalType_ == thrift::Type::BOOLEAN) {
+      uint8_t byte = 0;
+      for (auto i = 0; i < plain_.size(); ++i) {
+        byte |= plain_[i] << (i % 8);
+        if (i % 8 == 7) {
+          pageBody_.append(byte);
+          byte = 0;
+        }
+      }
+      if (plain_.size() % 8 != 0) {
+        pageBody_.append(byte);
+      }
+    } else {
+      pageBody_.extendAppend(pageBody_.size(), plain_.data(), plain_.size());
+    }
+    encoding = thrift::Encoding::PLAIN;
+    hasPlainPages_ = true;
+  }
+
+  thrift::DataPageHeader dataPageHeader;
+  dataPageHeader.__set_num_values(pageNumValues_);
+  dataPageHeader.__set_encoding(encoding);
+  dataPageHeader.__set_definition_level_encoding(thrift::Encoding::RLE);
+  dataPageHeader.__set_repetition_level_encoding(thrift::Encoding::RLE);
+  thrift::PageHeader header;
+  header.__set_type(thrift::PageType::DATA_PAGE);
+  header.__set_data_page_header(dataPageHeader);
+  chunkUncompressedBytes_ +=
+      writePage(header, pageBody_.data(), pageBody_.size(), chunk_);
+
+  numValues_ += pageNumValues_;
+  pageNumValues_ = 0;
+  resetBuffer(defLevels_);
+  resetBuffer(indices_);
+  resetBuffer(plain_);
+}
+
+int64_t ColumnChunkWriter::writePage(
+    thrift::PageHeader& header,
+    const char* data,
+    uint64_t size,
+    DataBuffer<char>& out) {
+  header.__set_uncompressed_page_size(size);
+  std::unique_ptr<folly::IOBuf> compressed;
+  if (compressor_) {
+    compressed =
+        compressor_->compress(folly::IOBuf::wrapBuffer(data, size).get());
+    header.__set_compressed_page_size(compressed->computeChainDataLength());
+  } else {
+    header.__set_compressed_page_size(size);
+  }
+  const auto headerStart = out.size();
+  serialize(header, out);
+  const int64_t headerSize = out.size() - headerStart;
+  if (compressed) {
+    for (auto range : *compressed) {
+      out.extendAppend(
+          out.size(),
+          reinterpret_cast<const char*>(range.data()),
+          range.size());
+    }
+  } else {
+    out.extendAppend(out.size(), data, size);
+  }
+  return headerSize + size;
+}
+
+thrift::ColumnChunk ColumnChunkWriter::flush(
+    DataBuffer<char>& out,
+    int64_t fileOffset) {
+  if (pageNumValues_ > 0) {
+    finishPage();
+  }
+  const auto chunkStart = out.size();
+  thrift::ColumnMetaData metaData;
+  std::vector<thrift::Encoding::type> encodings{thrift::Encoding::RLE};
+  int64_t uncompressedBytes = chunkUncompressedBytes_;
+  if (hasDictionaryPages_) {
+    thrift::DictionaryPageHeader dictionaryPageHeader;
+    dictionaryPageHeader.__set_num_values(dictionarySize_);
+    dictionaryPageHeader.__set_encoding(thrift::Encoding::PLAIN);
+    thrift::PageHeader header;
+    header.__set_type(thrift::PageType::DICTIONARY_PAGE);
+    header.__set_dictionary_page_header(dictionaryPageHeader);
+    metaData.__set_dictionary_page_offset(fileOffset);
+    uncompressedBytes +=
+        writePage(header, dictionary_.data(), dictionary_.size(), out);
+    encodings.push_back(thrift::Encoding::RLE_DICTIONARY);
+  }
+  if (hasDictionaryPages_ || hasPlainPages_) {
+    encodings.push_back(thrift::Encoding::PLAIN);
+  }
+  metaData.__set_data_page_offset(fileOffset + (out.size() - chunkStart));
+  out.extendAppend(out.size(), chunk_.data(), chunk_.size());
+
+  metaData.__set_type(physicalType_);
+  metaData.__set_encodings(encodings);
+  metaData.__set_path_in_schema({name_});
+  metaData.__set_codec(codec_);
+  metaData.__set_num_values(numValues_);
+  metaData.__set_total_uncompressed_size(uncompressedBytes);
+  metaData.__set_total_compressed_size(out.size() - chunkStart);
+  thrift::Statistics statistics;
+  statistics.__set_null_count(nullCount_);
+  if (hasMinMax_) {
+    statistics.__set_min_value(statsValue(true));
+    statistics.__set_max_value(statsValue(false));
+  }
+  metaData.__set_statistics(statistics);
+
+  thrift::ColumnChunk columnChunk;
+  columnChunk.__set_file_offset(fileOffset);
+  columnChunk.__set_meta_data(metaData);
+
+  resetBuffer(chunk_);
+  chunkUncompressedBytes_ = 0;
+  numValues_ = 0;
+  nullCount_ = 0;
+  hasDictionaryPages_ = false;
+  hasPlainPages_ = false;
+  dictionaryMode_ = enableDictionary_;
+  resetBuffer(dictionary_);
+  dictionarySize_ = 0;
+  fixedIds_.clear();
+  stringIds_.clear();
+  stringPool_.clear();
+  hasMinMax_ = false;
+  return columnChunk;
+}
+
+thrift::SchemaElement ColumnChunkWriter::schemaElement() const {
+  thrift::SchemaElement element;
+  element.__set_name(name_);
+  element.__set_type(physicalType_);
+  element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+  switch (type_->kind()) {
+    case TypeKind::TINYINT:
+      element.__set_converted_type(thrift::ConvertedType::INT_8);
+      break;
+    case TypeKind::SMALLINT:
+      element.__set_converted_type(thrift::ConvertedType::INT_16);
+      break;
+    case TypeKind::INTEGER:
+      if (type_->isDate()) {
+        element.__set_converted_type(thrift::ConvertedType::DATE);
+      }
+      break;
+    case TypeKind::VARCHAR:
+      element.__set_converted_type(thrift::ConvertedType::UTF8);
+      break;
+    default:
+      break;
+  }
+  return element;
+}
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : options_(options),
+      pool_(std::move(pool)),
+      generalPool_{pool_->addLeafChild(".general")},
+      sink_(std::move(sink)) {
+  if (options.flushPolicyFactory) {
+    flushPolicy_ = options.flushPolicyFactory();
+  } else {
+    flushPolicy_ = std::make_unique<DefaultFlushPolicy>();
+  }
+  // Fails early on an unsupported codec.
+  toThriftCodec(options.compression);
+}
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options)
+    : NativeWriter{
+          std::move(sink),
+          options,
+          options.memoryPool->addAggregateChild(fmt::format(
+              "writer_node_{}",
+              folly::to<std::string>(folly::Random::rand64())))} {}
+
+NativeWriter::~NativeWriter() = default;
+
+// static
+bool NativeWriter::isSupportedType(const TypePtr& type) {
+  if (type->isDecimal()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void NativeWriter::initialize(const RowTypePtr& type) {
+  type_ = type;
+  columns_.reserve(type_->size());
+  for (auto i = 0; i < type_->size(); ++i) {
+    columns_.push_back(std::make_unique<ColumnChunkWriter>(
+        type_->nameOf(i), type_->childAt(i), options_, *generalPool_));
+  }
+}
+
+dwio::common::StripeProgress NativeWriter::progress() const {
+  int64_t bytes = 0;
+  for (const auto& column : columns_) {
+    bytes += column->bufferedBytes();
+  }
+  return dwio::common::StripeProgress{
+      .stripeRowCount = stagingRows_, .stripeSizeEstimate = bytes};
+}
+
+void NativeWriter::write(const VectorPtr& data) {
+  auto* input = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(input, "Parquet writer expects a RowVector");
+  if (!type_) {
+    initialize(asRowType(data->type()));
+  }
+  VELOX_CHECK(
+      type_->equivalent(*data->type()),
+      "All batches must have the same type: {} vs {}",
+      type_->toString(),
+      data->type()->toString());
+
+  const vector_size_t numRows = data->size();
+  vector_size_t offset = 0;
+  while (offset < numRows) {
+    if (flushPolicy_->shouldFlush(progress())) {
+      flush();
+    }
+    // Row groups are cut at 'rowsInRowGroup' even inside a batch.
+    const auto maxRows = flushPolicy_->rowsInRowGroup() > stagingRows_
+        ? flushPolicy_->rowsInRowGroup() - stagingRows_
+        : 0;
+    if (maxRows == 0) {
+      flush();
+      continue;
+    }
+    const auto end = offset +
+        static_cast<vector_size_t>(
+                         std::min<uint64_t>(numRows - offset, maxRows));
+    for (auto i = 0; i < columns_.size(); ++i) {
+      decoded_.decode(*input->childAt(i));
+      columns_[i]->write(decoded_, offset, end);
+    }
+    stagingRows_ += end - offset;
+    offset = end;
+  }
+}
+
+void NativeWriter::writeHeader() {
+  if (bytesWritten_ == 0) {
+    DataBuffer<char> buffer{*generalPool_};
+    buffer.extendAppend(0, kMagic.data(), kMagic.size());
+    writeToSink(buffer);
+  }
+}
+
+void NativeWriter::writeToSink(DataBuffer<char>& buffer) {
+  bytesWritten_ += buffer.size();
+  sink_->write(std::move(buffer));
+}
+
+void NativeWriter::flush() {
+  if (stagingRows_ == 0) {
+    return;
+  }
+  writeHeader();
+  DataBuffer<char> buffer{*generalPool_};
+  std::vector<thrift::ColumnChunk> columnChunks;
+  columnChunks.reserve(columns_.size());
+  int64_t totalBytes = 0;
+  for (auto& column : columns_) {
+    columnChunks.push_back(
+        column->flush(buffer, bytesWritten_ + buffer.size()));
+    totalBytes += columnChunks.back().meta_data.total_uncompressed_size;
+  }
+  thrift::RowGroup rowGroup;
+  rowGroup.__set_columns(columnChunks);
+  rowGroup.__set_num_rows(stagingRows_);
+  rowGroup.__set_total_byte_size(totalBytes);
+  rowGroup.__set_file_offset(bytesWritten_);
+  rowGroup.__set_total_compressed_size(buffer.size());
+  rowGroup.__set_ordinal(static_cast<int16_t>(rowGroups_.size()));
+  rowGroups_.push_back(std::move(rowGroup));
+  numRows_ += stagingRows_;
+  stagingRows_ = 0;
+  writeToSink(buffer);
+}
+
+void NativeWriter::close() {
+  flush();
+  if (type_) {
+    writeHeader();
+    std::vector<thrift::SchemaElement> schema;
+    schema.reserve(columns_.size() + 1);
+    thrift::SchemaElement root;
+    root.__set_name("schema");
+    root.__set_num_children(columns_.size());
+    schema.push_back(std::move(root));
+    std::vector<thrift::ColumnOrder> columnOrders(columns_.size());
+    for (auto i = 0; i < columns_.size(); ++i) {
+      schema.push_back(columns_[i]->schemaElement());
+      columnOrders[i].__set_TYPE_ORDER(thrift::TypeDefinedOrder());
+    }
+    thrift::FileMetaData metaData;
+    metaData.__set_version(1);
+    metaData.__set_schema(schema);
+    metaData.__set_num_rows(numRows_);
+    metaData.__set_row_groups(rowGroups_);
+    metaData.__set_created_by("velox");
+    metaData.__set_column_orders(columnOrders);
+
+    DataBuffer<char> buffer{*generalPool_};
+    serialize(metaData, buffer);
+    appendValue<uint32_t>(buffer.size(), buffer);
+    buffer.extendAppend(buffer.size(), kMagic.data(), kMagic.size());
+    writeToSink(buffer);
+  }
+  sink_->close();
+}
+
+void NativeWriter::abort() {
+  sink_.reset();
+  columns_.clear();
+}
+
+} // namespace facebook::velox::parquet
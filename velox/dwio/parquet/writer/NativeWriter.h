@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/Writer.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+class ColumnChunkWriter;
+
+/// Writes Velox vectors into a Parquet file without going through Arrow.
+/// Values are encoded directly from the decoded input vectors and all buffers
+/// are allocated from Velox memory pools. Dictionary encoded input is passed
+/// through: each distinct base value is looked up in the column dictionary
+/// once per batch instead of once per row.
+///
+/// Supports top level columns of BOOLEAN, TINYINT, SMALLINT, INTEGER, DATE,
+/// BIGINT, REAL, DOUBLE, VARCHAR and VARBINARY types. Data pages are V1 pages
+/// with RLE definition levels and RLE_DICTIONARY or PLAIN values. Each column
+/// starts a row group dictionary encoded and falls back to PLAIN once the
+/// dictionary exceeds 'dictionaryPageSizeLimit'. Uses 'enableDictionary',
+/// 'dataPageSize', 'dictionaryPageSizeLimit', 'compression' and the flush
+/// policy of WriterOptions. Compression may be NONE, SNAPPY, GZIP or ZSTD.
+class NativeWriter : public dwio::common::Writer {
+ public:
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options);
+
+  ~NativeWriter() override;
+
+  /// Returns true if columns of 'type' can be written.
+  static bool isSupportedType(const TypePtr& type);
+
+  /// Appends 'data' into the writer. All calls must have the same row type.
+  void write(const VectorPtr& data) override;
+
+  /// Writes the buffered rows as a row group.
+  void flush() override;
+
+  /// Flushes and writes the footer. 'sink' stays live until destruction of
+  /// 'this'.
+  void close() override;
+
+  void abort() override;
+
+ private:
+  void initialize(const RowTypePtr& type);
+
+  dwio::common::StripeProgress progress() const;
+
+  // Writes the magic at the start of the file if not yet written.
+  void writeHeader();
+
+  void writeToSink(dwio::common::DataBuffer<char>& buffer);
+
+  const WriterOptions options_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::shared_ptr<memory::MemoryPool> generalPool_;
+  std::unique_ptr<dwio::common::FileSink> sink_;
+  std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
+
+  RowTypePtr type_;
+  std::vector<std::unique_ptr<ColumnChunkWriter>> columns_;
+  DecodedVector decoded_;
+
+  // Rows buffered for the current row group.
+  uint64_t stagingRows_{0};
+  // Bytes written to 'sink_'.
+  int64_t bytesWritten_{0};
+  int64_t numRows_{0};
+  std::vector<thrift::RowGroup> rowGroups_;
+};
+
+} // namespace facebook::velox::parquet
@@ -130,12 +130,18 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   if (!options.enableDictionary) {
     properties = properties->disable_dictionary();
   }
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
   properties = properties->data_pagesize(options.dataPageSize);
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
+  if (options.encoding.has_value()) {
+    properties = properties->encoding(options.encoding.value());
+  }
   return properties->build();
 }
 
@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
 
@@ -86,6 +87,8 @@ class LambdaFlushPolicy : public DefaultFlushPolicy {
 
 struct WriterOptions {
   bool enableDictionary = true;
+  // Writes the ColumnIndex and OffsetIndex of each column chunk.
+  bool enablePageIndex = false;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
@@ -98,6 +101,8 @@ struct WriterOptions {
   // policy with the configs in its ctor.
   std::function<std::unique_ptr<DefaultFlushPolicy>()> flushPolicyFactory;
   std::shared_ptr<CodecOptions> codecOptions;
+  // Encoding for non-dictionary pages. The writer default is used if not set.
+  std::optional<arrow::Encoding::type> encoding;
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
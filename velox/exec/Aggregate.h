@@ -149,6 +149,22 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  // Same as addRawInput() for a hash table that has at most 'numGroupIds'
+  // groups, each with a dense id. Low cardinality aggregations can
+  // accumulate the rows into arrays indexed by group id and then update each
+  // group once per call. The default implementation calls addRawInput().
+  // @param groupIds Group id of each row. 'groupIds[row]' is the id of
+  // 'groups[row]' and is less than 'numGroupIds'.
+  virtual void addRawInputForDenseGroups(
+      char** groups,
+      const uint64_t* /*groupIds*/,
+      int32_t /*numGroupIds*/,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) {
+    addRawInput(groups, rows, args, mayPushdown);
+  }
+
   // Updates final accumulators from intermediate results.
   // @param groups Pointers to the start of the group rows. These are aligned
   // with the 'args', e.g. data in the i-th row of the 'args' goes to the i-th
@@ -28,7 +28,9 @@ namespace {
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
-// to frameEnd boundaries at that row using singleGroup.
+// to frameEnd boundaries at that row using singleGroup. Large sliding frames
+// combine the intermediate results of a segment tree over the partition
+// instead of aggregating every row of the frame.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -66,6 +68,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
         resultType,
         config);
     aggregate_->setAllocator(stringAllocator_);
+    intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
 
     // Aggregate initialization.
     // Row layout is:
@@ -114,6 +117,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.clear();
   }
 
   void apply(
@@ -161,6 +165,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -175,6 +182,14 @@ class AggregateWindowFunction : public exec::WindowFunction {
     previousFrameMetadata_ = frameMetadata;
   }
 
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kFrameRows;
+  }
+
+  std::optional<RowOffsets> streamingRowOffsets() const override {
+    return RowOffsets{};
+  }
+
  private:
   struct FrameMetadata {
     // Min frame start row required for aggregation.
@@ -343,6 +358,160 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are large enough on average for
+  // the segment tree to beat aggregating each frame.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] + 1 - rawFrameStarts[i];
+    });
+    return numFrameRows >=
+        static_cast<int64_t>(validRows.countSelected()) *
+        kMinSegmentTreeFrameSize;
+  }
+
+  void initializeSingleGroup() {
+    static const auto kSingleGroup = std::vector<vector_size_t>{0};
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    aggregateInitialized_ = true;
+  }
+
+  // Adds the partition rows [begin, end) to the single group.
+  void addRawInput(vector_size_t begin, vector_size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    fillArgVectors(begin, end - 1);
+    SelectivityVector rows(end - begin);
+    aggregate_->addSingleGroupRawInput(
+        rawSingleGroupRow_, rows, argVectors_, false);
+  }
+
+  // Computes the intermediate result of the node at 'index' in 'level' of
+  // the segment tree unless already computed. A node at level 0 covers
+  // kSegmentTreeLeafSize rows. A node at level l covers its 2 children at
+  // level l - 1. Nodes are computed on first use, so only the parts of the
+  // partition covered by frames are aggregated, and only once. Uses the
+  // single group and 'nodeInputs_'.
+  void ensureSegmentTreeNode(int32_t level, vector_size_t index) {
+    if (segmentTree_.size() <= level) {
+      segmentTree_.resize(level + 1);
+    }
+    auto& node = segmentTree_[level];
+    if (node.computed.size() <= index) {
+      node.computed.resize(index + 1, false);
+    }
+    if (node.computed[index]) {
+      return;
+    }
+
+    if (level == 0) {
+      initializeSingleGroup();
+      const auto begin = index * kSegmentTreeLeafSize;
+      addRawInput(begin, begin + kSegmentTreeLeafSize);
+    } else {
+      // The children are computed before the group is initialized since
+      // computing them also uses the group.
+      ensureSegmentTreeNode(level - 1, 2 * index);
+      ensureSegmentTreeNode(level - 1, 2 * index + 1);
+      const auto& children = segmentTree_[level - 1].values;
+      nodeInputs_->copy(children.get(), 0, 2 * index, 2);
+      initializeSingleGroup();
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, SelectivityVector(2), {nodeInputs_}, false);
+    }
+
+    BaseVector::prepareForReuse(nodeResult_, 1);
+    aggregate_->extractAccumulators(&rawSingleGroupRow_, 1, &nodeResult_);
+    auto& values = segmentTree_[level].values;
+    if (!values) {
+      values = BaseVector::create(intermediateType_, index + 1, pool_);
+    } else if (values->size() <= index) {
+      values->resize(index + 1);
+    }
+    values->copy(nodeResult_.get(), index, 0, 1);
+    segmentTree_[level].computed[index] = true;
+  }
+
+  // Computes each frame from the raw rows at its ends that do not fill a leaf
+  // and the intermediate results of at most 2 nodes per level of the segment
+  // tree in between. This is O(log(frame size)) combines per row rather than
+  // O(frame size) raw rows.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (!nodeInputs_) {
+      nodeInputs_ = BaseVector::create(intermediateType_, 2, pool_);
+      nodeResult_ = BaseVector::create(intermediateType_, 1, pool_);
+    }
+
+    std::vector<std::pair<int32_t, vector_size_t>> nodes;
+    validRows.applyToSelected([&](auto i) {
+      const vector_size_t begin = rawFrameStarts[i];
+      const vector_size_t end = rawFrameEnds[i] + 1;
+      const vector_size_t firstLeaf =
+          bits::roundUp(begin, kSegmentTreeLeafSize) / kSegmentTreeLeafSize;
+      const vector_size_t lastLeaf =
+          std::max(firstLeaf, end / kSegmentTreeLeafSize);
+
+      // Covers the leaves [firstLeaf, lastLeaf) with the largest aligned
+      // nodes.
+      nodes.clear();
+      for (auto leaf = firstLeaf; leaf < lastLeaf;) {
+        int32_t level = 0;
+        while ((leaf & ((2 << level) - 1)) == 0 &&
+               leaf + (2 << level) <= lastLeaf) {
+          ++level;
+        }
+        nodes.emplace_back(level, leaf >> level);
+        leaf += 1 << level;
+      }
+
+      // All nodes are computed before any is copied to 'nodeInputs_' since
+      // computing a node overwrites 'nodeInputs_'.
+      for (const auto& [level, index] : nodes) {
+        ensureSegmentTreeNode(level, index);
+      }
+      if (nodeInputs_->size() < nodes.size()) {
+        nodeInputs_->resize(nodes.size());
+      }
+      for (auto j = 0; j < nodes.size(); ++j) {
+        const auto& [level, index] = nodes[j];
+        nodeInputs_->copy(segmentTree_[level].values.get(), j, index, 1);
+      }
+
+      initializeSingleGroup();
+      if (!nodes.empty()) {
+        aggregate_->addSingleGroupIntermediateResults(
+            rawSingleGroupRow_,
+            SelectivityVector(nodes.size()),
+            {nodeInputs_},
+            false);
+      }
+      if (firstLeaf < lastLeaf) {
+        addRawInput(begin, firstLeaf * kSegmentTreeLeafSize);
+        addRawInput(lastLeaf * kSegmentTreeLeafSize, end);
+      } else {
+        addRawInput(begin, end);
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -356,9 +525,36 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregate_->clear();
   }
 
+  // Number of rows aggregated into a leaf of the segment tree.
+  static constexpr vector_size_t kSegmentTreeLeafSize = 32;
+
+  // Average frame size from which frames are computed with the segment tree.
+  static constexpr vector_size_t kMinSegmentTreeFrameSize =
+      2 * kSegmentTreeLeafSize;
+
+  // A level of the segment tree. 'values' has the intermediate results of the
+  // nodes at the level. Only the nodes with 'computed' set are valid.
+  struct SegmentTreeLevel {
+    VectorPtr values;
+    std::vector<bool> computed;
+  };
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
+  // Intermediate type of 'aggregate_'. The type of the segment tree nodes.
+  TypePtr intermediateType_;
+
+  // Levels of the segment tree over the current partition, from the leaves
+  // up. Built on demand by ensureSegmentTreeNode().
+  std::vector<SegmentTreeLevel> segmentTree_;
+
+  // The node intermediate results combined for a frame or a parent node.
+  VectorPtr nodeInputs_;
+
+  // The intermediate result of a node being computed.
+  VectorPtr nodeResult_;
+
   bool aggregateInitialized_{false};
 
   // Current WindowPartition used for accessing rows in the apply method.
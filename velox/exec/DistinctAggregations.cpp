@@ -43,8 +43,8 @@ class TypedDistinctAggregations : public DistinctAggregations {
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
-        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-          VELOX_UNREACHABLE();
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
@@ -55,6 +55,10 @@ class TypedDistinctAggregations : public DistinctAggregations {
         }};
   }
 
+  TypePtr spillType() const override {
+    return ARRAY(inputType_);
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
@@ -102,6 +106,19 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    auto* arrayVector = input->as<ArrayVector>();
+    VELOX_CHECK_NOT_NULL(arrayVector);
+    decodedInput_.decode(*arrayVector->elements());
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    accumulator->addValues(*arrayVector, index, decodedInput_, allocator_);
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -142,6 +159,40 @@ class TypedDistinctAggregations : public DistinctAggregations {
     return aggregates_[0]->inputs.size() == 1;
   }
 
+  // Extracts the distinct inputs of each group into an array of the
+  // 'result' vector of spillType().
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    auto* arrayVector = result->as<ArrayVector>();
+    VELOX_CHECK_NOT_NULL(arrayVector);
+    arrayVector->resize(groups.size());
+
+    vector_size_t numValues = 0;
+    for (auto* group : groups) {
+      numValues += reinterpret_cast<AccumulatorType*>(group + offset_)->size();
+    }
+    auto& elements = arrayVector->elements();
+    elements->resize(numValues);
+
+    auto* rawOffsets =
+        arrayVector->mutableOffsets(groups.size())->asMutable<vector_size_t>();
+    auto* rawSizes =
+        arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+    vector_size_t offset = 0;
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      arrayVector->setNull(i, false);
+      rawOffsets[i] = offset;
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        rawSizes[i] = accumulator->extractValues(*elements, offset);
+      } else {
+        rawSizes[i] = accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), offset);
+      }
+      offset += rawSizes[i];
+    }
+  }
+
   void decodeInput(const RowVectorPtr& input, const SelectivityVector& rows) {
     inputForAccumulator_ = makeInputForAccumulator(input);
     decodedInput_.decode(*inputForAccumulator_, rows);
@@ -41,6 +41,10 @@ class DistinctAggregations {
 
   virtual Accumulator accumulator() const = 0;
 
+  /// Returns the type of the accumulator when spilled: an array of the
+  /// distinct inputs of a group.
+  virtual TypePtr spillType() const = 0;
+
   /// Aggregate-like APIs to aggregate input rows per group.
   void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
@@ -71,6 +75,13 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct inputs of a spilled accumulator to 'group'. 'input' is
+  /// an array vector of spillType() and 'index' is the row to add.
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
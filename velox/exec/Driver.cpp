@@ -16,12 +16,18 @@
 
 #include "Driver.h"
 #include <folly/ScopeGuard.h>
+#include <folly/container/F14Map.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Metrics.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/FilterProject.h"
+#include "velox/exec/MultiLevelDriverExecutor.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
@@ -97,6 +103,52 @@ void recordSilentThrows(Operator& op) {
   }
 }
 
+// The process-wide rows, bytes and time of one operator type.
+struct OperatorMetrics {
+  explicit OperatorMetrics(const std::string& operatorType)
+      : inputRows(metricCounter(name(operatorType, "input_rows"))),
+        inputBytes(metricCounter(name(operatorType, "input_bytes"))),
+        outputRows(metricCounter(name(operatorType, "output_rows"))),
+        outputBytes(metricCounter(name(operatorType, "output_bytes"))),
+        cpuTimeUs(metricCounter(name(operatorType, "cpu_time_us"))),
+        wallTimeUs(metricCounter(name(operatorType, "wall_time_us"))) {}
+
+  static std::string name(const std::string& operatorType, const char* stat) {
+    return fmt::format(
+        "{}{}.{}", kCounterOperatorPrefix.str(), operatorType, stat);
+  }
+
+  MetricCounter& inputRows;
+  MetricCounter& inputBytes;
+  MetricCounter& outputRows;
+  MetricCounter& outputBytes;
+  MetricCounter& cpuTimeUs;
+  MetricCounter& wallTimeUs;
+};
+
+// Adds the stats of an operator of a finished driver to the metrics of its
+// operator type. Called once per operator and driver, so that the processing
+// loop is not instrumented.
+void recordOperatorMetrics(const OperatorStats& stats) {
+  // The metrics of the operator types seen by this thread.
+  thread_local folly::F14FastMap<std::string, std::unique_ptr<OperatorMetrics>>
+      threadMetrics;
+  auto& metrics = threadMetrics[stats.operatorType];
+  if (metrics == nullptr) {
+    metrics = std::make_unique<OperatorMetrics>(stats.operatorType);
+  }
+  CpuWallTiming timing;
+  timing.add(stats.addInputTiming);
+  timing.add(stats.getOutputTiming);
+  timing.add(stats.finishTiming);
+  metrics->inputRows.add(stats.inputPositions);
+  metrics->inputBytes.add(stats.inputBytes);
+  metrics->outputRows.add(stats.outputPositions);
+  metrics->outputBytes.add(stats.outputBytes);
+  metrics->cpuTimeUs.add(timing.cpuNanos / 1'000);
+  metrics->wallTimeUs.add(timing.wallNanos / 1'000);
+}
+
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -110,7 +162,11 @@ DriverCtx::DriverCtx(
       splitGroupId(_splitGroupId),
       partitionId(_partitionId),
       task(_task),
-      threadDebugInfo({task->queryCtx()->queryId(), task->taskId(), nullptr}) {}
+      threadDebugInfo({task->queryCtx()->queryId(), task->taskId(), nullptr}),
+      vectorPool_(
+          queryConfig().isExpressionEvaluationCacheEnabled()
+              ? std::make_unique<VectorPool>(nullptr)
+              : nullptr) {}
 
 const core::QueryConfig& DriverCtx::queryConfig() const {
   return task->queryCtx()->queryConfig();
@@ -145,7 +201,10 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillLevel(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.testingSpillPct(),
-      queryConfig.spillCompressionKind());
+      queryConfig.spillCompressionKind(),
+      queryConfig.spillFileFormat(),
+      queryConfig.spillReadAheadBuffers(),
+      queryConfig.maxSpillReadAheadBytes());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -182,6 +241,16 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          if (auto* timeline = driver->timeline()) {
+            timeline->add(
+                DriverTimelineEvent::Kind::kBlocked,
+                state->sinceMicros_,
+                getCurrentTimeMicro(),
+                fmt::format(
+                    "{} {}",
+                    blockingReasonToString(state->reason_),
+                    state->operator_->operatorType()));
+          }
         }
         VELOX_CHECK(!driver->state().isSuspended);
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -239,8 +308,14 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* multiLevelExecutor =
+          dynamic_cast<MultiLevelDriverExecutor*>(executor)) {
+    multiLevelExecutor->add(
+        driver->task(), [driver]() { Driver::run(driver); });
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -252,6 +327,30 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  asyncMemoryArbitration_ = ctx_->queryConfig().asyncMemoryArbitrationEnabled();
+  timeSliceLimitMicros_ =
+      ctx_->queryConfig().driverCpuTimeSliceLimitMs() * 1'000UL;
+  if (ctx_->queryConfig().driverTimelineEnabled()) {
+    timeline_ = std::make_shared<DriverTimeline>(
+        ctx_->pipelineId, ctx_->driverId);
+    ctx_->task->addDriverTimeline(timeline_);
+  }
+}
+
+bool Driver::shouldWaitForMemoryArbitration(ContinueFuture* future) {
+  // A query with this much free capacity is likely to run without entering
+  // the memory arbitration. Matches the growth quantum of
+  // MemoryPool::maybeReserve().
+  constexpr uint64_t kAsyncArbitrationMinFreeBytes = 8 << 20;
+  if (!asyncMemoryArbitration_) {
+    return false;
+  }
+  auto* pool = task()->pool();
+  if (pool->root()->capacity() == memory::kMaxMemory ||
+      pool->freeBytes() >= kAsyncArbitrationMinFreeBytes) {
+    return false;
+  }
+  return pool->arbitrationInProgress(future);
 }
 
 void Driver::initializeOperators() {
@@ -262,6 +361,15 @@ void Driver::initializeOperators() {
   for (auto& op : operators_) {
     op->initialize();
   }
+  if (ctx_->queryConfig().filterProjectFusionEnabled()) {
+    for (auto i = 1; i < operators_.size(); ++i) {
+      auto* filterProject = dynamic_cast<FilterProject*>(operators_[i].get());
+      if (filterProject != nullptr &&
+          operators_[i - 1]->canFuseFilterProject()) {
+        operators_[i - 1]->fuseFilterProject(filterProject);
+      }
+    }
+  }
 }
 
 void Driver::pushdownFilters(int operatorIndex) {
@@ -316,6 +424,7 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
   auto self = shared_from_this();
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
+  process::ScopedCpuProfile scopedCpuProfile(&self->task()->cpuProfile());
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   RowVectorPtr result;
   auto stop = runInternal(self, blockingState, result);
@@ -344,6 +453,10 @@ void Driver::enqueueInternal() {
     Operator::NonReclaimableSectionGuard nonReclaimableGuard(operatorPtr); \
     RuntimeStatWriterScopeGuard statsWriterGuard(operatorPtr);             \
     threadNumVeloxThrow() = 0;                                             \
+    process::ScopedProfileFrame operatorFrame(                             \
+        process::SamplingProfiler::running() ? operatorPtr->profileLabel() \
+                                             : std::string_view());        \
+    process::ScopedProfileFrame methodFrame(operatorMethod);               \
     opCallStatus_.start(operatorId, operatorMethod);                       \
     auto stopGuard = folly::makeGuard([&]() { opCallStatus_.stop(); });    \
     call;                                                                  \
@@ -483,14 +596,34 @@ StopReason Driver::runInternal(
 
     const int32_t numOperators = operators_.size();
     ContinueFuture future;
+    const auto yieldAtMicros =
+        timeSliceLimitMicros_ ? now + timeSliceLimitMicros_ : 0;
 
     for (;;) {
+      if (shouldWaitForMemoryArbitration(&future)) {
+        blockingReason_ = BlockingReason::kWaitForMemory;
+        blockingState = std::make_shared<BlockingState>(
+            self,
+            std::move(future),
+            operators_[curOperatorId_].get(),
+            blockingReason_);
+        guard.notThrown();
+        return StopReason::kBlock;
+      }
       for (int32_t i = numOperators - 1; i >= 0; --i) {
         stop = task()->shouldStop();
         if (stop != StopReason::kNone) {
           guard.notThrown();
           return stop;
         }
+        if (yieldAtMicros && getCurrentTimeMicro() >= yieldAtMicros) {
+          // The time slice is used up. Go to the back of the queue so that
+          // the executor can run other Drivers.
+          operators_[i]->addRuntimeStat(
+              "driverTimeSliceYields", RuntimeCounter(1));
+          guard.notThrown();
+          return StopReason::kYield;
+        }
 
         auto op = operators_[i].get();
         VELOX_CHECK(op->isInitialized());
@@ -701,10 +834,22 @@ void Driver::run(std::shared_ptr<Driver> self) {
   process::TraceContext trace("Driver::run");
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
+  process::ScopedCpuProfile scopedCpuProfile(&self->task()->cpuProfile());
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
+  const auto queuedSinceMicros = self->queueTimeStartMicros_;
+  const auto startMicros = getCurrentTimeMicro();
   auto reason = self->runInternal(self, blockingState, nullResult);
+  if (self->timeline_ != nullptr) {
+    self->timeline_->add(
+        DriverTimelineEvent::Kind::kQueued, queuedSinceMicros, startMicros);
+    self->timeline_->add(
+        DriverTimelineEvent::Kind::kOnThread,
+        startMicros,
+        getCurrentTimeMicro(),
+        stopReasonString(reason));
+  }
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -769,8 +914,24 @@ void Driver::closeOperators() {
   for (auto& op : operators_) {
     auto stats = op->stats(true);
     stats.numDrivers = 1;
+    recordOperatorMetrics(stats);
     task()->addOperatorStats(stats);
   }
+
+  if (auto* vectorPool = ctx_->vectorPool()) {
+    vectorPool->clear();
+  }
+}
+
+size_t Driver::clearVectorPools() {
+  size_t numFreed = 0;
+  for (auto& op : operators_) {
+    numFreed += op->clearVectorPool();
+  }
+  if (auto* vectorPool = ctx_->vectorPool()) {
+    numFreed += vectorPool->clear();
+  }
+  return numFreed;
 }
 
 void Driver::close() {
@@ -967,6 +1128,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForConnector";
     case BlockingReason::kWaitForSpill:
       return "kWaitForSpill";
+    case BlockingReason::kWaitForPeers:
+      return "kWaitForPeers";
     case BlockingReason::kYield:
       return "kYield";
   }
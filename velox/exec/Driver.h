@@ -26,6 +26,7 @@
 #include "velox/core/PlanFragment.h"
 #include "velox/core/PlanNode.h"
 #include "velox/core/QueryCtx.h"
+#include "velox/exec/DriverTimeline.h"
 #include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
@@ -162,6 +163,10 @@ enum class BlockingReason {
   /// Build operator is blocked waiting for all its peers to stop to run group
   /// spill on all of them.
   kWaitForSpill,
+  /// Operator is blocked waiting for all its peers in the pipeline to reach
+  /// the same point, e.g. a hash aggregation with tables shared by its peers
+  /// waiting for all of them to finish their input.
+  kWaitForPeers,
   /// Some operators (like Table Scan) may run long loops and can 'voluntarily'
   /// exit them because Task requested to yield or stop or after a certain time.
   /// This is the blocking reason used in such cases.
@@ -244,8 +249,20 @@ struct DriverCtx {
       const core::PlanNodeId& planNodeId,
       const std::string& operatorType);
 
+  /// Returns the pool of recycled vectors shared by the operators of this
+  /// driver or nullptr if expression evaluation cache is disabled. Vectors
+  /// that do not fit in the vector pool of an operator go here and are reused
+  /// by the other operators of the pipeline. This has no memory pool of its
+  /// own and must not be used to allocate new vectors.
+  VectorPool* vectorPool() const {
+    return vectorPool_.get();
+  }
+
   /// Builds the spill config for the operator with specified 'operatorId'.
   std::optional<common::SpillConfig> makeSpillConfig(int32_t operatorId) const;
+
+ private:
+  const std::unique_ptr<VectorPool> vectorPool_;
 };
 
 constexpr const char* kOpMethodNone = "";
@@ -327,6 +344,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return state_.isTerminated;
   }
 
+  /// Returns the timeline of 'this' or nullptr if
+  /// QueryConfig::kDriverTimelineEnabled is not set.
+  DriverTimeline* timeline() const {
+    return timeline_.get();
+  }
+
   std::string label() const;
 
   ThreadState& state() {
@@ -338,6 +361,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// Close operators and add operator stats to the task.
   void closeOperators();
 
+  /// Frees the vectors cached for reuse by the operators of this driver and
+  /// by the pipeline level vector pool, e.g. on memory pressure. Must be
+  /// called when the driver is off thread or suspended. Returns the number of
+  /// freed vectors.
+  size_t clearVectorPools();
+
   /// Returns true if all operators between the source and 'aggregation' are
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
@@ -415,6 +444,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   void close();
 
+  // Returns true and sets 'future' if 'asyncMemoryArbitration_' is set, the
+  // query of 'this' has less than kAsyncArbitrationMinFreeBytes of free
+  // memory capacity and a memory arbitration is in progress. The driver then
+  // goes off thread until the arbitration finishes.
+  bool shouldWaitForMemoryArbitration(ContinueFuture* future);
+
   // Push down dynamic filters produced by the operator at the specified
   // position in the pipeline.
   void pushdownFilters(int operatorIndex);
@@ -451,6 +486,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   // Timer used to track down the time we are sitting in the driver queue.
   size_t queueTimeStartMicros_{0};
+
+  // Set with QueryConfig::kDriverTimelineEnabled. Also referenced by the Task,
+  // which exports it after 'this' is gone.
+  std::shared_ptr<DriverTimeline> timeline_;
+
   // Id (index in the vector) of the current operator to run (or the 1st one if
   // we haven't started yet). Used to determine which operator's queueTime we
   // should update.
@@ -462,6 +502,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool asyncMemoryArbitration_{false};
+
+  // See QueryConfig::driverCpuTimeSliceLimitMs(). 0 if there is no time
+  // slice.
+  uint64_t timeSliceLimitMicros_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverTimeline.h"
+
+#include <fmt/format.h>
+#include <folly/json.h>
+
+namespace facebook::velox::exec {
+
+std::string driverTimelineEventKindName(DriverTimelineEvent::Kind kind) {
+  switch (kind) {
+    case DriverTimelineEvent::Kind::kQueued:
+      return "Queued";
+    case DriverTimelineEvent::Kind::kOnThread:
+      return "OnThread";
+    case DriverTimelineEvent::Kind::kBlocked:
+      return "Blocked";
+    default:
+      return fmt::format("UNKNOWN_KIND {}", static_cast<int>(kind));
+  }
+}
+
+void DriverTimeline::add(
+    DriverTimelineEvent::Kind kind,
+    uint64_t startMicros,
+    uint64_t endMicros,
+    std::string detail) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() >= kMaxEvents) {
+    ++numDroppedEvents_;
+    return;
+  }
+  events_.push_back(
+      DriverTimelineEvent{kind, startMicros, endMicros, std::move(detail)});
+}
+
+std::vector<DriverTimelineEvent> DriverTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return events_;
+}
+
+int64_t DriverTimeline::numDroppedEvents() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDroppedEvents_;
+}
+
+std::string toChromeTrace(
+    const std::vector<std::shared_ptr<DriverTimeline>>& timelines) {
+  auto traceEvents = folly::dynamic::array();
+  for (const auto& timeline : timelines) {
+    for (const auto& event : timeline->events()) {
+      folly::dynamic traceEvent = folly::dynamic::object;
+      traceEvent["name"] = driverTimelineEventKindName(event.kind);
+      // A complete event with a duration.
+      traceEvent["ph"] = "X";
+      traceEvent["ts"] = static_cast<int64_t>(event.startMicros);
+      traceEvent["dur"] =
+          static_cast<int64_t>(event.endMicros - event.startMicros);
+      traceEvent["pid"] = timeline->pipelineId();
+      traceEvent["tid"] = timeline->driverId();
+      if (!event.detail.empty()) {
+        traceEvent["args"] = folly::dynamic::object("detail", event.detail);
+      }
+      traceEvents.push_back(std::move(traceEvent));
+    }
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  return folly::toJson(trace);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// A span of time in the life of a Driver.
+struct DriverTimelineEvent {
+  enum class Kind {
+    /// Waiting in the executor queue.
+    kQueued,
+    /// Running on a thread. 'detail' is the StopReason.
+    kOnThread,
+    /// Off thread on a blocking future. 'detail' is the BlockingReason and
+    /// the blocked operator.
+    kBlocked,
+  };
+
+  Kind kind;
+  uint64_t startMicros;
+  uint64_t endMicros;
+  std::string detail;
+};
+
+std::string driverTimelineEventKindName(DriverTimelineEvent::Kind kind);
+
+/// Records the queued, on-thread and blocked times of a Driver with
+/// QueryConfig::kDriverTimelineEnabled. A Driver adds the events from
+/// whichever thread it is on or is resumed from, so the events are kept
+/// under a mutex. There is an event per quantum of running, not per batch.
+class DriverTimeline {
+ public:
+  /// The most events kept per Driver. Later events are counted as dropped.
+  static constexpr int32_t kMaxEvents = 100'000;
+
+  DriverTimeline(int32_t pipelineId, int32_t driverId)
+      : pipelineId_(pipelineId), driverId_(driverId) {}
+
+  void add(
+      DriverTimelineEvent::Kind kind,
+      uint64_t startMicros,
+      uint64_t endMicros,
+      std::string detail = "");
+
+  int32_t pipelineId() const {
+    return pipelineId_;
+  }
+
+  int32_t driverId() const {
+    return driverId_;
+  }
+
+  std::vector<DriverTimelineEvent> events() const;
+
+  int64_t numDroppedEvents() const;
+
+ private:
+  const int32_t pipelineId_;
+  const int32_t driverId_;
+
+  mutable std::mutex mutex_;
+  std::vector<DriverTimelineEvent> events_;
+  int64_t numDroppedEvents_{0};
+};
+
+/// Returns 'timelines' in the Chrome trace event JSON format, viewable in
+/// chrome://tracing or Perfetto. Each pipeline is a process and each Driver a
+/// thread of it.
+std::string toChromeTrace(
+    const std::vector<std::shared_ptr<DriverTimeline>>& timelines);
+
+} // namespace facebook::velox::exec
@@ -64,8 +64,10 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
-      ? preferredOutputBatchBytes_
+  // Zero-copy output refers to a single page per batch.
+  const auto maxBytes =
+      getSerde()->supportsAppendInDeserialize() && !zeroCopy()
+      ? outputBatchBytes()
       : 1;
 
   ContinueFuture dataFuture;
@@ -95,6 +97,22 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
   return BlockingReason::kWaitForProducer;
 }
 
+uint64_t Exchange::outputBatchBytes() const {
+  uint64_t serializedBytes;
+  uint64_t outputPositions;
+  {
+    const auto lockedStats = stats_.rlock();
+    serializedBytes = lockedStats->rawInputBytes;
+    outputPositions = lockedStats->outputPositions;
+  }
+  const auto rows = adaptiveOutputBatchRows(0);
+  if (rows == 0 || outputPositions == 0) {
+    return preferredOutputBatchBytes_;
+  }
+  // Pages are fetched by their serialized size.
+  return std::max<uint64_t>(rows * serializedBytes / outputPositions, 1);
+}
+
 bool Exchange::isFinished() {
   return atEnd_ && currentPages_.empty();
 }
@@ -106,12 +124,26 @@ RowVectorPtr Exchange::getOutput() {
 
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
-  for (const auto& page : currentPages_) {
+  for (auto& page : currentPages_) {
     rawInputBytes += page->size();
 
     ByteStream inputStream;
     page->prepareStreamForDeserialize(&inputStream);
 
+    if (zeroCopy() && resultOffset == 0) {
+      std::shared_ptr<SerializedPage> sharedPage = std::move(page);
+      getSerde()->deserializeZeroCopy(
+          &inputStream, pool(), outputType_, &result_, sharedPage);
+      if (!inputStream.atEnd()) {
+        // More input is appended to 'result_', which requires writable
+        // buffers.
+        auto copy = BaseVector::create<RowVector>(outputType_, 0, pool());
+        copy->append(result_.get());
+        result_ = std::move(copy);
+      }
+      resultOffset = result_->size();
+    }
+
     while (!inputStream.atEnd()) {
       getSerde()->deserialize(
           &inputStream, pool(), outputType_, &result_, resultOffset);
@@ -130,6 +162,10 @@ RowVectorPtr Exchange::getOutput() {
   return result_;
 }
 
+bool Exchange::zeroCopy() {
+  return zeroCopyEnabled_ && getSerde()->supportsZeroCopyDeserialize();
+}
+
 void Exchange::close() {
   SourceOperator::close();
   currentPages_.clear();
@@ -47,6 +47,7 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        zeroCopyEnabled_{driverCtx->queryConfig().exchangeZeroCopyEnabled()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {}
 
@@ -79,8 +80,18 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  /// Returns true if pages are deserialized without copying their data.
+  bool zeroCopy();
+
+  /// Returns the serialized bytes to fetch for an output batch. These are
+  /// 'preferredOutputBatchBytes_' unless adaptive output batch sizing is
+  /// enabled. See Operator::adaptiveOutputBatchRows().
+  uint64_t outputBatchBytes() const;
+
   const uint64_t preferredOutputBatchBytes_;
 
+  const bool zeroCopyEnabled_;
+
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
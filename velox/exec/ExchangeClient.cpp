@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -47,6 +48,7 @@ void ExchangeClient::addRemoteTaskId(const std::string& taskId) {
       toClose = std::move(source);
     } else {
       sources_.push_back(source);
+      sourceStates_[source.get()] = SourceState{};
       queue_->addSourceLocked();
       // Put new source into 'producingSources_' queue to prioritise fetching
       // from these to find out whether these are productive or not.
@@ -77,6 +79,8 @@ void ExchangeClient::close() {
     }
     closed_ = true;
     sources = std::move(sources_);
+    sourceStates_.clear();
+    outstandingBytes_ = 0;
   }
 
   // Outside of mutex.
@@ -129,10 +133,33 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
   return pages;
 }
 
+int64_t ExchangeClient::maxQueuedBytes() const {
+  std::lock_guard<std::mutex> l(queue_->mutex());
+  return maxQueuedBytes_;
+}
+
+void ExchangeClient::setMaxQueuedBytes(int64_t maxQueuedBytes) {
+  RequestSpec requestSpec;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    const bool grows = maxQueuedBytes > maxQueuedBytes_;
+    maxQueuedBytes_ = maxQueuedBytes;
+    if (!grows) {
+      return;
+    }
+    requestSpec = pickSourcesToRequestLocked();
+  }
+
+  // Outside of lock.
+  request(requestSpec);
+}
+
 void ExchangeClient::request(const RequestSpec& requestSpec) {
   auto& exec = folly::QueuedImmediateExecutor::instance();
-  for (auto& source : requestSpec.sources) {
-    auto future = source->request(requestSpec.maxBytes, kDefaultMaxWaitSeconds);
+  for (auto i = 0; i < requestSpec.sources.size(); ++i) {
+    const auto& source = requestSpec.sources[i];
+    auto future =
+        source->request(requestSpec.maxBytes[i], kDefaultMaxWaitSeconds);
     VELOX_CHECK(future.valid());
     std::move(future)
         .via(&exec)
@@ -140,6 +167,7 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
           RequestSpec requestSpec;
           {
             std::lock_guard<std::mutex> l(queue_->mutex());
+            updateSourceStateLocked(requestSource.get(), response.bytes);
             if (!response.atEnd) {
               if (response.bytes > 0) {
                 producingSources_.push(requestSource);
@@ -147,6 +175,8 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
                 emptySources_.push(requestSource);
               }
             }
+            // Request the next data right away, before the received pages
+            // are consumed, if the queue has room for it.
             requestSpec = pickSourcesToRequestLocked();
           }
           request(requestSpec);
@@ -157,14 +187,39 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
   }
 }
 
-int32_t ExchangeClient::countPendingSourcesLocked() {
-  int32_t numPending = 0;
-  for (auto& source : sources_) {
-    if (source->isRequestPendingLocked()) {
-      ++numPending;
-    }
+void ExchangeClient::updateSourceStateLocked(
+    const ExchangeSource* source,
+    int64_t bytes) {
+  auto it = sourceStates_.find(source);
+  if (it == sourceStates_.end()) {
+    // Closed.
+    return;
+  }
+  auto& state = it->second;
+  outstandingBytes_ -= state.outstandingBytes;
+  state.outstandingBytes = 0;
+
+  const double oldBytesPerSecond = state.bytesPerSecond;
+  if (bytes > 0) {
+    const auto elapsedUs =
+        std::max<uint64_t>(1, getCurrentTimeMicro() - state.requestTimeUs);
+    const double bytesPerSecond = bytes * 1'000'000.0 / elapsedUs;
+    state.bytesPerSecond = oldBytesPerSecond == 0
+        ? bytesPerSecond
+        : 0.7 * oldBytesPerSecond + 0.3 * bytesPerSecond;
+  } else {
+    // No data within the wait time. Lower the credit of the source.
+    state.bytesPerSecond = oldBytesPerSecond / 2;
+  }
+
+  if (oldBytesPerSecond > 0) {
+    totalBytesPerSecond_ -= oldBytesPerSecond;
+    --numMeasuredSources_;
+  }
+  if (state.bytesPerSecond > 0) {
+    totalBytesPerSecond_ += state.bytesPerSecond;
+    ++numMeasuredSources_;
   }
-  return numPending;
 }
 
 int64_t ExchangeClient::getAveragePageSize() {
@@ -177,28 +232,42 @@ int64_t ExchangeClient::getAveragePageSize() {
   return averagePageSize;
 }
 
-int32_t ExchangeClient::getNumSourcesToRequestLocked(int64_t averagePageSize) {
-  // Figure out how many more 'averagePageSize' fit into 'maxQueuedBytes_'.
-  // Make sure to leave room for 'numPending' pages.
-  const auto numPending = countPendingSourcesLocked();
-
-  auto numToRequest = std::max<int32_t>(
-      1, (maxQueuedBytes_ - queue_->totalBytes()) / averagePageSize);
-  if (numToRequest <= numPending) {
-    return 0;
+int64_t ExchangeClient::creditLocked(
+    const SourceState& state,
+    int64_t averagePageSize,
+    int64_t availableBytes) const {
+  int64_t credit = averagePageSize;
+  if (state.bytesPerSecond > 0 && totalBytesPerSecond_ > 0) {
+    const double averageBytesPerSecond =
+        totalBytesPerSecond_ / numMeasuredSources_;
+    credit = averagePageSize * (state.bytesPerSecond / averageBytesPerSecond);
   }
-
-  return numToRequest - numPending;
+  credit = std::clamp<int64_t>(
+      credit,
+      std::max<int64_t>(1, averagePageSize / kMaxCreditRatio),
+      averagePageSize * kMaxCreditRatio);
+  return std::max<int64_t>(1, std::min(credit, availableBytes));
 }
 
 void ExchangeClient::pickSourcesToRequestLocked(
     RequestSpec& requestSpec,
-    int32_t numToRequest,
+    int64_t averagePageSize,
+    int64_t& availableBytes,
     std::queue<std::shared_ptr<ExchangeSource>>& sources) {
-  while (requestSpec.sources.size() < numToRequest && !sources.empty()) {
+  // Always allow one request when none is outstanding to make progress.
+  while (!sources.empty() &&
+         (availableBytes > 0 ||
+          (outstandingBytes_ == 0 && requestSpec.sources.empty()))) {
     auto& source = sources.front();
     if (source->shouldRequestLocked()) {
+      auto& state = sourceStates_[source.get()];
+      const auto credit = creditLocked(state, averagePageSize, availableBytes);
+      state.outstandingBytes = credit;
+      state.requestTimeUs = getCurrentTimeMicro();
+      outstandingBytes_ += credit;
+      availableBytes -= credit;
       requestSpec.sources.push_back(source);
+      requestSpec.maxBytes.push_back(credit);
     }
     sources.pop();
   }
@@ -210,19 +279,17 @@ ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
   }
 
   const auto averagePageSize = getAveragePageSize();
-  const auto numToRequest = getNumSourcesToRequestLocked(averagePageSize);
-
-  if (numToRequest == 0) {
-    return {};
-  }
+  // Leave room for the data of the pending requests.
+  int64_t availableBytes =
+      maxQueuedBytes_ - queue_->totalBytes() - outstandingBytes_;
 
+  // Give credit to the next sources to request data from until the queue
+  // budget is used up. Prioritize new sources and sources that return data.
   RequestSpec requestSpec;
-  requestSpec.maxBytes = averagePageSize;
-
-  // Pick up to 'numToRequest' next sources to request data from. Prioritize
-  // sources that return data.
-  pickSourcesToRequestLocked(requestSpec, numToRequest, producingSources_);
-  pickSourcesToRequestLocked(requestSpec, numToRequest, emptySources_);
+  pickSourcesToRequestLocked(
+      requestSpec, averagePageSize, availableBytes, producingSources_);
+  pickSourcesToRequestLocked(
+      requestSpec, averagePageSize, availableBytes, emptySources_);
 
   return requestSpec;
 }
@@ -27,6 +27,8 @@ class ExchangeClient {
  public:
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
   static constexpr int32_t kDefaultMaxWaitSeconds = 2;
+  // Bounds of the credit of a source relative to the average page size.
+  static constexpr int32_t kMaxCreditRatio = 4;
   static inline const std::string kBackgroundCpuTimeMs = "backgroundCpuTimeMs";
 
   ExchangeClient(
@@ -81,37 +83,66 @@ class ExchangeClient {
   std::vector<std::unique_ptr<SerializedPage>>
   next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future);
 
+  /// Returns the limit on the bytes of queued and requested pages.
+  int64_t maxQueuedBytes() const;
+
+  /// Changes the limit on the bytes of queued and requested pages. If the limit
+  /// grows, requests more data right away.
+  void setMaxQueuedBytes(int64_t maxQueuedBytes);
+
   std::string toString() const;
 
   std::string toJsonString() const;
 
  private:
   // A list of sources to request data from and how much to request from each
-  // (in bytes).
+  // (in bytes). 'maxBytes[i]' is the credit given to 'sources[i]'.
   struct RequestSpec {
     std::vector<std::shared_ptr<ExchangeSource>> sources;
-    int64_t maxBytes;
+    std::vector<int64_t> maxBytes;
   };
 
-  int64_t getAveragePageSize();
+  // Flow control state of a source.
+  struct SourceState {
+    // Bytes requested by the pending request. These count against
+    // 'maxQueuedBytes_' until the response arrives.
+    int64_t outstandingBytes{0};
+    // Time the pending request was sent.
+    uint64_t requestTimeUs{0};
+    // Moving average of the response throughput. 0 until the first response
+    // with data.
+    double bytesPerSecond{0};
+  };
 
-  int32_t getNumSourcesToRequestLocked(int64_t averagePageSize);
+  int64_t getAveragePageSize();
 
   RequestSpec pickSourcesToRequestLocked();
 
   void pickSourcesToRequestLocked(
       RequestSpec& requestSpec,
-      int32_t numToRequest,
+      int64_t averagePageSize,
+      int64_t& availableBytes,
       std::queue<std::shared_ptr<ExchangeSource>>& sources);
 
-  int32_t countPendingSourcesLocked();
+  // Returns the bytes to request from 'state' out of 'availableBytes'. Sources
+  // that produce faster than the average get more credit, slower ones less,
+  // so that slow producers do not hold most of the queue budget.
+  int64_t creditLocked(
+      const SourceState& state,
+      int64_t averagePageSize,
+      int64_t availableBytes) const;
+
+  // Releases the credit of a completed request from 'source' and updates its
+  // throughput with a response of 'bytes'.
+  void updateSourceStateLocked(const ExchangeSource* source, int64_t bytes);
 
   void request(const RequestSpec& requestSpec);
 
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
-  const int64_t maxQueuedBytes_;
+  // Guarded by 'queue_->mutex()'.
+  int64_t maxQueuedBytes_;
   memory::MemoryPool* const pool_;
   std::shared_ptr<ExchangeQueue> queue_;
   std::unordered_set<std::string> taskIds_;
@@ -123,6 +154,13 @@ class ExchangeClient {
   std::queue<std::shared_ptr<ExchangeSource>> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  folly::F14FastMap<const ExchangeSource*, SourceState> sourceStates_;
+  // Sum of 'outstandingBytes' over 'sourceStates_'.
+  int64_t outstandingBytes_{0};
+  // Sum and count of non-zero 'bytesPerSecond' over 'sourceStates_'.
+  double totalBytesPerSecond_{0};
+  int32_t numMeasuredSources_{0};
 };
 
 } // namespace facebook::velox::exec
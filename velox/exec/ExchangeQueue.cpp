@@ -14,9 +14,21 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Metrics.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Tracks the size of the received pages in range of [0, 8MB] with 32KB
+// buckets and reports P50, P90, P99, and P100.
+MetricHistogram& pageBytes() {
+  static MetricHistogram histogram(
+      kCounterExchangePageBytes, 32 << 10, 0, 8 << 20, {50, 90, 99, 100});
+  return histogram;
+}
+} // namespace
+
 SerializedPage::SerializedPage(
     std::unique_ptr<folly::IOBuf> iobuf,
     std::function<void(folly::IOBuf&)> onDestructionCb)
@@ -82,6 +94,7 @@ void ExchangeQueue::enqueueLocked(
 
   ++receivedPages_;
   receivedBytes_ += page->size();
+  pageBytes().add(page->size());
 
   queue_.push_back(std::move(page));
   if (!promises_.empty()) {
@@ -81,7 +81,12 @@ void FilterProject::initialize() {
     isIdentityProjection_ = true;
   }
   numExprs_ = allExprs.size();
-  exprs_ = makeExprSetFromFlag(std::move(allExprs), operatorCtx_->execCtx());
+  // The drivers of a pipeline compile the same expressions. Share the
+  // constant folding and function resolution between them.
+  exprs_ = makeExprSetFromFlag(
+      std::move(allExprs),
+      operatorCtx_->execCtx(),
+      &operatorCtx_->task()->exprCompileCache());
 
   if (numExprs_ > 0 && !identityProjections_.empty()) {
     const auto inputType = project_ ? project_->sources()[0]->outputType()
@@ -107,12 +112,55 @@ void FilterProject::addInput(RowVectorPtr input) {
   numProcessedInputRows_ = 0;
 }
 
+void FilterProject::recycleInput() {
+  // The flat children of an input that is not referenced elsewhere go to the
+  // vector pool for reuse by this or the other operators of the pipeline.
+  if (input_.unique()) {
+    operatorCtx_->execCtx()->releaseVectors(input_->children());
+  }
+  input_ = nullptr;
+}
+
+void FilterProject::recordExprProfiles() {
+  const auto profiles = exprs_->profiles();
+  std::vector<std::string> labels(profiles.size());
+  if (hasFilter_) {
+    labels[0] = "filter";
+  }
+  for (const auto& projection : resultProjections_) {
+    labels[projection.inputChannel] =
+        outputType_->nameOf(projection.outputChannel);
+  }
+  auto lockedStats = stats_.wlock();
+  for (auto i = 0; i < profiles.size(); ++i) {
+    const auto& profile = profiles[i];
+    if (profile.numSampledVectors == 0) {
+      continue;
+    }
+    auto addStat = [&](const char* metric, const RuntimeCounter& counter) {
+      lockedStats->addRuntimeStat(
+          fmt::format("expr.{}.{}", labels[i], metric), counter);
+    };
+    addStat(
+        "sampledWallNanos",
+        RuntimeCounter(profile.timing.wallNanos, RuntimeCounter::Unit::kNanos));
+    addStat(
+        "sampledCpuNanos",
+        RuntimeCounter(profile.timing.cpuNanos, RuntimeCounter::Unit::kNanos));
+    addStat("sampledBatches", RuntimeCounter(profile.numSampledVectors));
+    addStat("sampledRows", RuntimeCounter(profile.numSampledRows));
+    addStat("sampledNullRows", RuntimeCounter(profile.numSampledNullRows));
+    addStat("peelAttempts", RuntimeCounter(profile.numPeelAttempts));
+    addStat("peeled", RuntimeCounter(profile.numPeeled));
+  }
+}
+
 bool FilterProject::allInputProcessed() {
   if (!input_) {
     return true;
   }
   if (numProcessedInputRows_ == input_->size()) {
-    input_ = nullptr;
+    recycleInput();
     return true;
   }
   return false;
@@ -123,10 +171,50 @@ bool FilterProject::isFinished() {
 }
 
 RowVectorPtr FilterProject::getOutput() {
+  if (fused_) {
+    return std::move(input_);
+  }
   if (allInputProcessed()) {
     return nullptr;
   }
+  return evaluate();
+}
+
+RowVectorPtr FilterProject::evaluateFused(RowVectorPtr input) {
+  VELOX_CHECK(fused_);
+  VELOX_CHECK_NULL(input_);
+  input_ = std::move(input);
+  numProcessedInputRows_ = 0;
+  auto output = evaluate();
+  input_ = nullptr;
+  return output;
+}
+
+std::string FilterProject::cacheKey() const {
+  VELOX_CHECK_NOT_NULL(exprs_);
+  for (const auto& expr : exprs_->exprs()) {
+    if (!expr->isDeterministic()) {
+      return "";
+    }
+  }
+  std::string key = fmt::format(
+      "{} filter: {} exprs: {} identity:",
+      outputType_->toString(),
+      hasFilter_,
+      exprs_->toString(false));
+  for (const auto& projection : identityProjections_) {
+    key += fmt::format(
+        " {}->{}", projection.inputChannel, projection.outputChannel);
+  }
+  key += " result:";
+  for (const auto& projection : resultProjections_) {
+    key += fmt::format(
+        " {}->{}", projection.inputChannel, projection.outputChannel);
+  }
+  return key;
+}
 
+RowVectorPtr FilterProject::evaluate() {
   vector_size_t size = input_->size();
   LocalSelectivityVector localRows(*operatorCtx_->execCtx(), size);
   auto* rows = localRows.get();
@@ -152,7 +240,7 @@ RowVectorPtr FilterProject::getOutput() {
   auto numOut = filter(evalCtx, *rows);
   numProcessedInputRows_ = size;
   if (numOut == 0) { // no rows passed the filer
-    input_ = nullptr;
+    recycleInput();
     return nullptr;
   }
 
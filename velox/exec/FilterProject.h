@@ -52,6 +52,9 @@ class FilterProject : public Operator {
   bool isFinished() override;
 
   void close() override {
+    if (exprs_ != nullptr) {
+      recordExprProfiles();
+    }
     Operator::close();
     if (exprs_ != nullptr) {
       exprs_->clear();
@@ -73,12 +76,48 @@ class FilterProject : public Operator {
 
   void initialize() override;
 
+  /// Makes 'this' evaluated in the output path of the preceding operator,
+  /// which calls evaluateFused(). addInput() and getOutput() then pass
+  /// through the rows that have already been filtered and projected.
+  void setFused() {
+    fused_ = true;
+  }
+
+  bool isFused() const {
+    return fused_;
+  }
+
+  /// Returns the filtered and projected 'input', or nullptr if no row passes
+  /// the filter. Called by the operator 'this' is fused into.
+  RowVectorPtr evaluateFused(RowVectorPtr input);
+
+  const RowTypePtr& outputType() const {
+    return outputType_;
+  }
+
+  /// Returns a string that identifies the filter and projections of an
+  /// initialized 'this', or an empty string if they are not deterministic.
+  /// Used in the keys of cached results.
+  std::string cacheKey() const;
+
  private:
+  // Evaluates the filter and projections on the unprocessed rows of 'input_'.
+  RowVectorPtr evaluate();
+
   // Tests if 'numProcessedRows_' equals to the length of input_ and clears
   // outstanding references to input_ if done. Returns true if getOutput
   // should return nullptr.
   bool allInputProcessed();
 
+  // Clears 'input_' and releases its children to the vector pool if they are
+  // not referenced elsewhere.
+  void recycleInput();
+
+  // Adds the sampled profile of the filter and each projection as runtime
+  // stats named expr.<filter or output column>.<metric>. No-op unless
+  // QueryConfig::kExprProfileSampleRate is set.
+  void recordExprProfiles();
+
   // Evaluate filter on all rows. Return number of rows that passed the filter.
   // Populate filterEvalCtx_.selectedBits and selectedIndices with the indices
   // of the passing rows if only some rows pass the filter. If all or no rows
@@ -101,6 +140,9 @@ class FilterProject : public Operator {
   std::shared_ptr<const core::FilterNode> filter_;
   bool initialized_{false};
 
+  // True if evaluated in the output path of the preceding operator.
+  bool fused_{false};
+
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
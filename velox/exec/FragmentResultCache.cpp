@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+namespace {
+// Prefix of the cache file names of fragment results. Distinguishes them from
+// the paths of cached files.
+constexpr std::string_view kKeyPrefix = "fragment-result:";
+
+std::string cacheFileName(const std::string& key) {
+  return fmt::format("{}{}", kKeyPrefix, key);
+}
+
+std::vector<ByteRange> makeRanges(cache::AsyncDataCacheEntry* entry) {
+  std::vector<ByteRange> ranges;
+  if (entry->tinyData() != nullptr) {
+    ranges.push_back(ByteRange{
+        reinterpret_cast<uint8_t*>(entry->tinyData()), entry->size(), 0});
+    return ranges;
+  }
+  const auto& allocation = entry->data();
+  int64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < entry->size(); ++i) {
+    auto run = allocation.runAt(i);
+    const int64_t bytes = std::min<int64_t>(
+        run.numPages() * memory::AllocationTraits::kPageSize,
+        entry->size() - offset);
+    ranges.push_back(
+        ByteRange{run.data<uint8_t>(), static_cast<int32_t>(bytes), 0});
+    offset += bytes;
+  }
+  return ranges;
+}
+
+void copyToEntry(
+    const folly::IOBuf& serialized,
+    cache::AsyncDataCacheEntry* entry) {
+  if (entry->tinyData() != nullptr) {
+    auto* out = entry->tinyData();
+    for (const auto& range : serialized) {
+      ::memcpy(out, range.data(), range.size());
+      out += range.size();
+    }
+    return;
+  }
+  const auto& allocation = entry->data();
+  int32_t runIndex = 0;
+  uint64_t offsetInRun = 0;
+  for (const auto& range : serialized) {
+    uint64_t copied = 0;
+    while (copied < range.size()) {
+      auto run = allocation.runAt(runIndex);
+      const uint64_t runBytes =
+          run.numPages() * memory::AllocationTraits::kPageSize;
+      const auto bytes =
+          std::min<uint64_t>(runBytes - offsetInRun, range.size() - copied);
+      ::memcpy(
+          run.data<char>() + offsetInRun, range.data() + copied, bytes);
+      copied += bytes;
+      offsetInRun += bytes;
+      if (offsetInRun == runBytes) {
+        ++runIndex;
+        offsetInRun = 0;
+      }
+    }
+  }
+}
+} // namespace
+
+std::optional<std::vector<RowVectorPtr>> FragmentResultCache::get(
+    const std::string& key,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  if (cache_ == nullptr) {
+    return std::nullopt;
+  }
+  const auto fileNum = fileIds().id(cacheFileName(key));
+  if (fileNum == StringIdMap::kNoId || !cache_->exists({fileNum, 0})) {
+    return std::nullopt;
+  }
+  auto pin = cache_->findOrCreate({fileNum, 0}, 1);
+  if (pin.empty()) {
+    // Being written by another thread.
+    return std::nullopt;
+  }
+  auto* entry = pin.checkedEntry();
+  if (entry->isExclusive()) {
+    // Evicted after exists(). The unfilled entry is dropped with 'pin'.
+    return std::nullopt;
+  }
+
+  ByteStream input;
+  input.resetInput(makeRanges(entry));
+  std::vector<RowVectorPtr> vectors;
+  while (!input.atEnd()) {
+    RowVectorPtr vector;
+    VectorStreamGroup::read(&input, pool, type, &vector);
+    vectors.push_back(std::move(vector));
+  }
+  return vectors;
+}
+
+bool FragmentResultCache::put(
+    const std::string& key,
+    const folly::IOBuf& serialized) {
+  const auto size = serialized.computeChainDataLength();
+  if (cache_ == nullptr || size == 0) {
+    return false;
+  }
+  // The lease keeps the id until the entry, which takes its own reference,
+  // exists.
+  StringIdLease fileNum(fileIds(), cacheFileName(key));
+  cache::CachePin pin;
+  try {
+    pin = cache_->findOrCreate({fileNum.id(), 0}, size);
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kNoCacheSpace.c_str()) {
+      throw;
+    }
+    return false;
+  }
+  if (pin.empty() || pin.checkedEntry()->isShared()) {
+    return false;
+  }
+  auto* entry = pin.checkedEntry();
+  copyToEntry(serialized, entry);
+  entry->setExclusiveToShared();
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Stores the serialized output of a plan fragment for one split in the
+/// AsyncDataCache, under a key that identifies the fragment and the data of
+/// the split. A hit replaces reading and processing the split. The entries
+/// compete for the cache memory with the cached file data and are evicted
+/// with the same policy.
+class FragmentResultCache {
+ public:
+  explicit FragmentResultCache(cache::AsyncDataCache* cache) : cache_(cache) {}
+
+  /// Returns the vectors cached for 'key', deserialized into 'pool', or
+  /// std::nullopt if there are none.
+  std::optional<std::vector<RowVectorPtr>> get(
+      const std::string& key,
+      const RowTypePtr& type,
+      memory::MemoryPool* pool);
+
+  /// Caches 'serialized', the concatenated serialized vectors of a fragment
+  /// for 'key'. Returns false if the entry is being or has been written by
+  /// another thread or if there is no space in the cache.
+  bool put(const std::string& key, const folly::IOBuf& serialized);
+
+ private:
+  cache::AsyncDataCache* const cache_;
+};
+
+} // namespace facebook::velox::exec
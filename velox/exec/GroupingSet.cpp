@@ -38,6 +38,11 @@ bool areAllLazyNotLoaded(const std::vector<VectorPtr>& vectors) {
   });
 }
 
+// Max number of entries of an array mode hash table for which raw input is
+// accumulated per dense group id. Keeps the per aggregate scratch arrays
+// cache resident.
+constexpr uint64_t kMaxDenseGroupIds = 1'024;
+
 std::vector<std::optional<column_index_t>> maskChannels(
     const std::vector<AggregateInfo>& aggregates) {
   std::vector<std::optional<column_index_t>> masks;
@@ -59,6 +64,7 @@ GroupingSet::GroupingSet(
     bool isRawInput,
     const std::vector<vector_size_t>& globalGroupingSets,
     const std::optional<column_index_t>& groupIdChannel,
+    std::optional<int64_t> estimatedNumGroups,
     const common::SpillConfig* spillConfig,
     uint32_t* numSpillRuns,
     tsan_atomic<bool>* nonReclaimableSection,
@@ -77,6 +83,7 @@ GroupingSet::GroupingSet(
                                 .aggregationSpillMemoryThreshold()),
       globalGroupingSets_(globalGroupingSets),
       groupIdChannel_(groupIdChannel),
+      estimatedNumGroups_(estimatedNumGroups),
       spillConfig_(spillConfig),
       numSpillRuns_(numSpillRuns),
       nonReclaimableSection_(nonReclaimableSection),
@@ -142,27 +149,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*globalGroupingSets*/ std::vector<vector_size_t>{},
-      /*groupIdColumn*/ std::nullopt,
-      /*spillConfig*/ nullptr,
-      /*numSpillRuns*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -260,6 +246,7 @@ void GroupingSet::addInputForActiveRows(
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
+  const auto* groupIds = isRawInput_ ? denseGroupIds() : nullptr;
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -295,7 +282,15 @@ void GroupingSet::addInputForActiveRows(
     // this.
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
-    if (isRawInput_) {
+    if (groupIds) {
+      function->addRawInputForDenseGroups(
+          groups,
+          groupIds,
+          table_->capacity(),
+          rows,
+          tempVectors_,
+          canPushdown);
+    } else if (isRawInput_) {
       function->addRawInput(groups, rows, tempVectors_, canPushdown);
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
@@ -377,6 +372,10 @@ void GroupingSet::createHashTable() {
     table_ = HashTable<false>::createForAggregation(
         std::move(hashers_), accumulators(false), &pool_);
   }
+  table_->setInlineKeys(queryConfig_.hashTableInlineKeysEnabled());
+  if (estimatedNumGroups_.has_value() && !isPartial_) {
+    table_->setExpectedNumDistinct(estimatedNumGroups_.value());
+  }
 
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
@@ -711,6 +710,14 @@ const SelectivityVector& GroupingSet::getSelectivityVector(
   return *rows;
 }
 
+const uint64_t* GroupingSet::denseGroupIds() const {
+  if (table_->hashMode() != BaseHashTable::HashMode::kArray ||
+      table_->capacity() > kMaxDenseGroupIds) {
+    return nullptr;
+  }
+  return lookup_->hashes.data();
+}
+
 bool GroupingSet::getOutput(
     int32_t maxOutputRows,
     int32_t maxOutputBytes,
@@ -944,30 +951,27 @@ void GroupingSet::spill() {
 
   if (!hasSpilled()) {
     auto rows = table_->rows();
-    auto types = rows->keyTypes();
-    for (const auto& aggregate : aggregates_) {
-      types.push_back(aggregate.intermediateType);
-    }
-    std::vector<std::string> names;
-    for (auto i = 0; i < types.size(); ++i) {
-      names.push_back(fmt::format("s{}", i));
-    }
     VELOX_DCHECK(pool_.trackUsage());
     spiller_ = std::make_unique<Spiller>(
         Spiller::Type::kAggregateInput,
         rows,
-        ROW(std::move(names), std::move(types)),
+        spillType(),
         rows->keyTypes().size(),
         std::vector<CompareFlags>(),
         spillConfig_->filePath,
         spillConfig_->writeBufferSize,
         spillConfig_->compressionKind,
         memory::spillMemoryPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->fileFormat,
+        spillConfig_->adaptiveCompression);
   }
   ++(*numSpillRuns_);
   spiller_->spill();
   table_->clear();
+  if (sortedAggregations_) {
+    sortedAggregations_->clear();
+  }
 }
 
 void GroupingSet::spill(const RowContainerIterator& rowIterator) {
@@ -978,28 +982,45 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
   }
 
   auto* rows = table_->rows();
-  auto types = rows->keyTypes();
-  for (const auto& aggregate : aggregates_) {
-    types.push_back(aggregate.intermediateType);
-  }
-  std::vector<std::string> names;
-  for (auto i = 0; i < types.size(); ++i) {
-    names.push_back(fmt::format("s{}", i));
-  }
   VELOX_CHECK(pool_.trackUsage());
   spiller_ = std::make_unique<Spiller>(
       Spiller::Type::kAggregateOutput,
       rows,
-      ROW(std::move(names), std::move(types)),
+      spillType(),
       spillConfig_->filePath,
       spillConfig_->writeBufferSize,
       spillConfig_->compressionKind,
       memory::spillMemoryPool(),
-      spillConfig_->executor);
+      spillConfig_->executor,
+      spillConfig_->fileFormat,
+      spillConfig_->adaptiveCompression);
 
   ++(*numSpillRuns_);
   spiller_->spill(rowIterator);
   table_->clear();
+  if (sortedAggregations_) {
+    sortedAggregations_->clear();
+  }
+}
+
+RowTypePtr GroupingSet::spillType() const {
+  auto types = table_->rows()->keyTypes();
+  for (const auto& aggregate : aggregates_) {
+    types.push_back(aggregate.intermediateType);
+  }
+  if (sortedAggregations_) {
+    types.push_back(sortedAggregations_->spillType());
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      types.push_back(aggregation->spillType());
+    }
+  }
+  std::vector<std::string> names;
+  for (auto i = 0; i < types.size(); ++i) {
+    names.push_back(fmt::format("s{}", i));
+  }
+  return ROW(std::move(names), std::move(types));
 }
 
 bool GroupingSet::getOutputWithSpill(
@@ -1035,7 +1056,8 @@ bool GroupingSet::getOutputWithSpill(
     VELOX_CHECK_EQ(table_->rows()->numRows(), 0);
     spiller_->finalizeSpill();
 
-    merge_ = spiller_->startMerge();
+    merge_ = spiller_->startMerge(
+        spillConfig_->readAheadBuffers, spillConfig_->maxReadAheadBytes);
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
@@ -1135,9 +1157,19 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     mergeRows_->store(stream.decoded(i), stream.currentIndex(), mergeState_, i);
   }
   vector_size_t zero = 0;
-  for (auto& aggregate : aggregates_) {
-    aggregate.function->initializeNewGroups(
-        &row, folly::Range<const vector_size_t*>(&zero, 1));
+  const folly::Range<const vector_size_t*> singleRow(&zero, 1);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (!aggregates_[i].sortingKeys.empty()) {
+      continue;
+    }
+    if (aggregates_[i].distinct) {
+      distinctAggregations_[i]->initializeNewGroups(&row, singleRow);
+    } else {
+      aggregates_[i].function->initializeNewGroups(&row, singleRow);
+    }
+  }
+  if (sortedAggregations_) {
+    sortedAggregations_->initializeNewGroups(&row, singleRow);
   }
 }
 
@@ -1150,6 +1182,9 @@ void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
   }
   extractGroups(folly::Range<char**>(rows.data(), rows.size()), result);
   mergeRows_->clear();
+  if (sortedAggregations_) {
+    sortedAggregations_->clear();
+  }
 }
 
 void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
@@ -1160,11 +1195,28 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
+    // Sorted and distinct aggregations are computed from their spilled inputs
+    // below.
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
+      continue;
+    }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
     aggregates_[i].function->addSingleGroupIntermediateResults(
         row, mergeSelection_, mergeArgs_, false);
   }
   mergeSelection_.setValid(input.currentIndex(), false);
+
+  auto column = keyChannels_.size() + aggregates_.size();
+  if (sortedAggregations_) {
+    sortedAggregations_->addSingleGroupSpillInput(
+        row, input.current().childAt(column++), input.currentIndex());
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->addSingleGroupSpillInput(
+          row, input.current().childAt(column++), input.currentIndex());
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
@@ -1192,6 +1244,12 @@ void GroupingSet::abandonPartialAggregation() {
   table_.reset();
 }
 
+void GroupingSet::resumePartialAggregation() {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  VELOX_CHECK_NULL(table_);
+  abandonedPartialAggregation_ = false;
+}
+
 namespace {
 // Recursive resize all children.
 
@@ -38,6 +38,7 @@ class GroupingSet {
       bool isRawInput,
       const std::vector<vector_size_t>& globalGroupingSets,
       const std::optional<column_index_t>& groupIdChannel,
+      std::optional<int64_t> estimatedNumGroups,
       const common::SpillConfig* spillConfig,
       uint32_t* numSpillRuns,
       tsan_atomic<bool>* nonReclaimableSection,
@@ -45,13 +46,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -136,6 +130,10 @@ class GroupingSet {
   // non-productive. Must be called before toIntermediate() is used.
   void abandonPartialAggregation();
 
+  /// Undoes abandonPartialAggregation() when the input has become reducing
+  /// again. The next addInput() creates a new hash table.
+  void resumePartialAggregation();
+
   /// Translates the raw input in input to accumulators initialized from a
   /// single input row. Passes grouping keys through.
   void toIntermediate(const RowVectorPtr& input, RowVectorPtr& result);
@@ -189,6 +187,11 @@ class GroupingSet {
   // index for this aggregation), otherwise it returns reference to activeRows_.
   const SelectivityVector& getSelectivityVector(size_t aggregateIndex) const;
 
+  // Returns the dense group ids of the rows of the last probe of 'table_' if
+  // the table is in array mode with at most kMaxDenseGroupIds entries.
+  // Returns nullptr otherwise.
+  const uint64_t* denseGroupIds() const;
+
   // Checks if input will fit in the existing memory and increases reservation
   // if not. If reservation cannot be increased, spills enough to make 'input'
   // fit.
@@ -213,6 +216,11 @@ class GroupingSet {
       int32_t maxOutputBytes,
       const RowVectorPtr& result);
 
+  // Returns the type of the spilled rows: the grouping keys followed by the
+  // intermediate results of 'aggregates_' and the spilled accumulators of the
+  // sorted and distinct aggregations, in the order of accumulators().
+  RowTypePtr spillType() const;
+
   // Reads from spilled rows until producing a batch of final results in
   // 'result'. Returns false and leaves 'result' empty when the spilled data is
   // fully read. 'maxOutputRows' and 'maxOutputBytes' specify the max number of
@@ -289,6 +297,11 @@ class GroupingSet {
   // Column for groupId for a GROUPING SET.
   std::optional<column_index_t> groupIdChannel_;
 
+  // Expected number of groups. Sizes the hash table of a final or single
+  // aggregation on creation. Not used for partial aggregation, whose table is
+  // flushed at a memory limit.
+  const std::optional<int64_t> estimatedNumGroups_;
+
   const common::SpillConfig* const spillConfig_;
 
   uint32_t* const numSpillRuns_;
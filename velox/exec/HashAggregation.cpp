@@ -15,6 +15,7 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include <folly/hash/Hash.h>
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortedAggregations.h"
@@ -71,6 +72,19 @@ void populateAggregateInputs(
   }
 }
 
+// Returns true if the drivers of 'aggregationNode' aggregate into tables
+// shared by all the drivers of the pipeline.
+bool useSharedTables(
+    const core::AggregationNode& aggregationNode,
+    const DriverCtx& driverCtx) {
+  return driverCtx.queryConfig().hashAggregationSharedTablesEnabled() &&
+      !isPartialOutput(aggregationNode.step()) &&
+      !aggregationNode.groupingKeys().empty() &&
+      !aggregationNode.aggregates().empty() &&
+      aggregationNode.preGroupedKeys().empty() &&
+      aggregationNode.globalGroupingSets().empty() &&
+      driverCtx.task->isUngroupedExecution();
+}
 } // namespace
 
 HashAggregation::HashAggregation(
@@ -85,7 +99,8 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          aggregationNode->canSpill(driverCtx->queryConfig()) &&
+                  !useSharedTables(*aggregationNode, *driverCtx)
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       aggregationNode_(aggregationNode),
@@ -98,8 +113,11 @@ HashAggregation::HashAggregation(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationResampleRows_(
+          driverCtx->queryConfig().abandonPartialAggregationResampleRows()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      sharedTables_(useSharedTables(*aggregationNode, *driverCtx)) {}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -213,11 +231,25 @@ void HashAggregation::initialize() {
       isRawInput(aggregationNode_->step()),
       aggregationNode_->globalGroupingSets(),
       groupIdChannel,
+      aggregationNode_->estimatedNumGroups(),
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
       &numSpillRuns_,
       &nonReclaimableSection_,
       operatorCtx_.get());
 
+  if (sharedTables_) {
+    partitionHashers_ =
+        createVectorHashers(inputType, aggregationNode_->groupingKeys());
+    sharedPartition_ = std::make_shared<SharedPartition>();
+    sharedPartition_->groupingSet = groupingSet_.get();
+  }
+
+  if (isPartialOutput_ && !isGlobal_ &&
+      abandonPartialAggregationResampleRows_ > 0) {
+    sampleHashers_ =
+        createVectorHashers(inputType, aggregationNode_->groupingKeys());
+  }
+
   aggregationNode_.reset();
 }
 
@@ -228,11 +260,16 @@ bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
 }
 
 void HashAggregation::addInput(RowVectorPtr input) {
+  if (sharedTables_) {
+    addSharedInput(input);
+    numInputRows_ += input->size();
+    return;
+  }
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
-  if (abandonedPartialAggregation_) {
+  if (abandonedPartialAggregation_ && !maybeResumePartialAggregation(input)) {
     input_ = input;
     numInputRows_ += input->size();
     return;
@@ -269,6 +306,192 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+bool HashAggregation::maybeResumePartialAggregation(
+    const RowVectorPtr& input) {
+  // Number of index bits of the estimate. Gives a standard error of 2.3%.
+  constexpr int8_t kSampleIndexBitLength = 11;
+  VELOX_CHECK(abandonedPartialAggregation_);
+  if (sampleHashers_.empty()) {
+    return false;
+  }
+  const auto numRows = input->size();
+  if (numPassedThroughRows_ < abandonPartialAggregationResampleRows_) {
+    numPassedThroughRows_ += numRows;
+    return false;
+  }
+
+  if (sampleHll_ == nullptr) {
+    sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kSampleIndexBitLength, sampleAllocator_.get());
+  }
+  const SelectivityVector rows(numRows);
+  sampleHashes_.resize(numRows);
+  for (auto& hasher : sampleHashers_) {
+    hasher->decode(*input->childAt(hasher->channel()), rows);
+  }
+  VectorHasher::hash(sampleHashers_, rows, sampleHashes_);
+  for (auto row = 0; row < numRows; ++row) {
+    sampleHll_->insertHash(folly::hash::twang_mix64(sampleHashes_[row]));
+  }
+  numSampledRows_ += numRows;
+  if (numSampledRows_ < abandonPartialAggregationMinRows_) {
+    return false;
+  }
+
+  const auto numGroups = sampleHll_->cardinality();
+  const auto numSampledRows = numSampledRows_;
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+  numSampledRows_ = 0;
+  numPassedThroughRows_ = 0;
+  if (100 * numGroups / numSampledRows >= abandonPartialAggregationMinPct_) {
+    return false;
+  }
+
+  groupingSet_->resumePartialAggregation();
+  abandonedPartialAggregation_ = false;
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  addRuntimeStat("resumedPartialAggregation", RuntimeCounter(1));
+  return true;
+}
+
+void HashAggregation::addSharedInput(const RowVectorPtr& input) {
+  VELOX_CHECK_EQ(numSharedBarriers_, 1);
+  // The peers read 'input' on their threads. Loads lazy vectors up front.
+  input->loadedVector();
+  const auto numRows = input->size();
+  const SelectivityVector rows(numRows);
+  partitionHashes_.resize(numRows);
+  for (auto& hasher : partitionHashers_) {
+    hasher->decode(*input->childAt(hasher->channel()), rows);
+  }
+  VectorHasher::hash(partitionHashers_, rows, partitionHashes_);
+
+  const auto numPartitions = sharedPartitions_.size();
+  partitionOfRow_.resize(numRows);
+  partitionSizes_.assign(numPartitions, 0);
+  for (auto row = 0; row < numRows; ++row) {
+    // Mixes the hash so that the partition does not correlate with the bits
+    // that select the buckets of the tables.
+    const uint32_t partition =
+        folly::hash::twang_mix64(partitionHashes_[row]) % numPartitions;
+    partitionOfRow_[row] = partition;
+    ++partitionSizes_[partition];
+  }
+  std::vector<BufferPtr> indices(numPartitions);
+  std::vector<vector_size_t*> rawIndices(numPartitions, nullptr);
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    if (partitionSizes_[partition] > 0) {
+      indices[partition] = allocateIndices(partitionSizes_[partition], pool());
+      rawIndices[partition] = indices[partition]->asMutable<vector_size_t>();
+      partitionSizes_[partition] = 0;
+    }
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    const auto partition = partitionOfRow_[row];
+    rawIndices[partition][partitionSizes_[partition]++] = row;
+  }
+
+  auto addPartitionInput = [&](uint32_t partition) {
+    auto* groupingSet = sharedPartitions_[partition]->groupingSet;
+    VELOX_CHECK_NOT_NULL(
+        groupingSet, "Peer of hash aggregation with shared tables is closed");
+    const auto size = partitionSizes_[partition];
+    groupingSet->addInput(
+        size == numRows ? input : wrap(size, indices[partition], input),
+        false);
+  };
+
+  // Adds the partitions that are not locked by a peer first and comes back
+  // to the others at the end.
+  const auto driverId = operatorCtx_->driverCtx()->driverId;
+  std::vector<uint32_t> lockedPartitions;
+  for (auto i = 0; i < numPartitions; ++i) {
+    const uint32_t partition = (driverId + i) % numPartitions;
+    if (partitionSizes_[partition] == 0) {
+      continue;
+    }
+    std::unique_lock<std::mutex> l(
+        sharedPartitions_[partition]->mutex, std::try_to_lock);
+    if (!l.owns_lock()) {
+      lockedPartitions.push_back(partition);
+      continue;
+    }
+    addPartitionInput(partition);
+  }
+  for (auto partition : lockedPartitions) {
+    std::lock_guard<std::mutex> l(sharedPartitions_[partition]->mutex);
+    addPartitionInput(partition);
+  }
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (!sharedTables_) {
+    return BlockingReason::kNotBlocked;
+  }
+  if (waitingForPeers_) {
+    // Continued by the last peer to reach the barrier.
+    waitingForPeers_ = false;
+    passSharedBarrier();
+  }
+  // All peers create their grouping sets before any input is added and add
+  // all their input before any output is produced.
+  const int32_t numBarriers = noMoreInput_ ? 2 : 1;
+  while (numSharedBarriers_ < numBarriers) {
+    if (!allPeersReached(future)) {
+      waitingForPeers_ = true;
+      return BlockingReason::kWaitForPeers;
+    }
+    passSharedBarrier();
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+bool HashAggregation::allPeersReached(ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), future, promises, peers)) {
+    return false;
+  }
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return true;
+}
+
+void HashAggregation::passSharedBarrier() {
+  ++numSharedBarriers_;
+  if (numSharedBarriers_ == 1) {
+    const auto peers = operatorCtx_->task()->findPeerOperators(
+        operatorCtx_->driverCtx()->pipelineId, this);
+    sharedPartitions_.resize(peers.size());
+    for (auto* peer : peers) {
+      auto* aggregation = dynamic_cast<HashAggregation*>(peer);
+      VELOX_CHECK_NOT_NULL(aggregation);
+      const auto driverId = aggregation->operatorCtx_->driverCtx()->driverId;
+      VELOX_CHECK_LT(driverId, peers.size());
+      sharedPartitions_[driverId] = aggregation->sharedPartition_;
+    }
+    for (const auto& partition : sharedPartitions_) {
+      VELOX_CHECK_NOT_NULL(partition);
+    }
+    return;
+  }
+
+  // All peers have added their input. 'groupingSet_' is only accessed by
+  // 'this' from here on.
+  VELOX_CHECK_EQ(numSharedBarriers_, 2);
+  sharedPartitions_.clear();
+  updateEstimatedOutputRowSize();
+  groupingSet_->noMoreInput();
+  updateRuntimeStats();
+  pool()->release();
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -292,6 +515,8 @@ void HashAggregation::updateRuntimeStats() {
   runtimeStats["hashtable.capacity"] = RuntimeMetric(hashTableStats.capacity);
   runtimeStats["hashtable.numRehashes"] =
       RuntimeMetric(hashTableStats.numRehashes);
+  runtimeStats["hashtable.rehashTime"] = RuntimeMetric(
+      hashTableStats.rehashTimeUs * 1'000, RuntimeCounter::Unit::kNanos);
   runtimeStats["hashtable.numDistinct"] =
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats["hashtable.numTombstones"] =
@@ -358,6 +583,7 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     pool()->release();
     addRuntimeStat("abandonedPartialAggregation", RuntimeCounter(1));
     abandonedPartialAggregation_ = true;
+    numPassedThroughRows_ = 0;
     return;
   }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
@@ -386,6 +612,9 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (sharedTables_ && numSharedBarriers_ < 2) {
+    return nullptr;
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
@@ -498,6 +727,12 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (sharedTables_) {
+    // The peers may still add input to 'groupingSet_'. The input is complete
+    // after the last barrier in passSharedBarrier().
+    Operator::noMoreInput();
+    return;
+  }
   updateEstimatedOutputRowSize();
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
@@ -559,6 +794,11 @@ void HashAggregation::reclaim(
 void HashAggregation::close() {
   Operator::close();
 
+  if (sharedPartition_ != nullptr) {
+    std::lock_guard<std::mutex> l(sharedPartition_->mutex);
+    sharedPartition_->groupingSet = nullptr;
+  }
+  sharedPartitions_.clear();
   output_ = nullptr;
   groupingSet_.reset();
 }
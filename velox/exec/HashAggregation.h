@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -39,9 +40,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -53,6 +52,27 @@ class HashAggregation : public Operator {
   void abort() override;
 
  private:
+  // The grouping set of a HashAggregation with shared tables. Its peers
+  // insert the input rows of this partition under 'mutex'. Shared with the
+  // peers so that 'groupingSet' can be cleared when 'this' is closed.
+  struct SharedPartition {
+    std::mutex mutex;
+    GroupingSet* groupingSet{nullptr};
+  };
+
+  // Hash partitions 'input' by the grouping keys and inserts each partition
+  // into the grouping set of the peer that owns it.
+  void addSharedInput(const RowVectorPtr& input);
+
+  // Returns true if all peers have reached the current barrier. Otherwise
+  // sets 'future' to be realized when the last peer reaches it.
+  bool allPeersReached(ContinueFuture* future);
+
+  // Runs the actions that follow the barriers of a HashAggregation with
+  // shared tables. The first barrier is reached when all peers have created
+  // their grouping sets, the second when all peers have added their input.
+  void passSharedBarrier();
+
   void updateRuntimeStats();
 
   void prepareOutput(vector_size_t size);
@@ -72,6 +92,13 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Invoked on the input of an abandoned partial aggregation. After
+  // 'abandonPartialAggregationResampleRows_' rows, estimates the number of
+  // groups in the next 'abandonPartialAggregationMinRows_' rows. Resumes
+  // partial aggregation and returns true if these rows are reducing, i.e. less
+  // than 'abandonPartialAggregationMinPct_' % of them are unique.
+  bool maybeResumePartialAggregation(const RowVectorPtr& input);
+
   RowVectorPtr getDistinctOutput();
 
   // Invoked to record the spilling stats in operator stats after processing all
@@ -92,6 +119,9 @@ class HashAggregation : public Operator {
   // Min unique rows pct for partial aggregation. If more than this many rows
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
+  // Number of rows to pass through an abandoned partial aggregation before
+  // checking whether to resume it. 0 if the aggregation is never resumed.
+  const int64_t abandonPartialAggregationResampleRows_;
 
   int64_t maxPartialAggregationMemoryUsage_;
   std::unique_ptr<GroupingSet> groupingSet_;
@@ -118,8 +148,43 @@ class HashAggregation : public Operator {
   // flush.
   int64_t numOutputRows_ = 0;
 
+  // Number of input rows passed through since partial aggregation was
+  // abandoned or last checked for resuming.
+  int64_t numPassedThroughRows_{0};
+
+  // Hashers on the grouping keys and the estimate of the number of groups in
+  // the rows sampled by maybeResumePartialAggregation().
+  std::vector<std::unique_ptr<VectorHasher>> sampleHashers_;
+  raw_vector<uint64_t> sampleHashes_;
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  int64_t numSampledRows_{0};
+
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // True if the peers in the pipeline aggregate into shared tables. Each
+  // peer owns the groups of one hash partition of the grouping keys.
+  const bool sharedTables_;
+
+  // The partition owned by 'this', if 'sharedTables_'.
+  std::shared_ptr<SharedPartition> sharedPartition_;
+
+  // The partitions of all peers, indexed by driver id. Set after the first
+  // barrier.
+  std::vector<std::shared_ptr<SharedPartition>> sharedPartitions_;
+
+  // Hashers on the grouping keys for partitioning the input between peers.
+  std::vector<std::unique_ptr<VectorHasher>> partitionHashers_;
+  raw_vector<uint64_t> partitionHashes_;
+  std::vector<uint32_t> partitionOfRow_;
+  std::vector<vector_size_t> partitionSizes_;
+
+  // Number of barriers with the peers passed so far.
+  int32_t numSharedBarriers_{0};
+
+  // True if waiting for the peers to reach a barrier.
+  bool waitingForPeers_{false};
 };
 
 } // namespace facebook::velox::exec
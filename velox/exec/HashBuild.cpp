@@ -24,6 +24,9 @@ using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 namespace {
+// Number of key hashes tracked by the heavy hitter summary of each HashBuild.
+constexpr int32_t kHeavyHitterSummaryCapacity = 256;
+
 // Map HashBuild 'state' to the corresponding driver blocking reason.
 BlockingReason fromStateToBlockingReason(HashBuild::State state) {
   switch (state) {
@@ -64,10 +67,23 @@ HashBuild::HashBuild(
           planNodeId())),
       spillMemoryThreshold_(
           operatorCtx_->driverCtx()->queryConfig().joinSpillMemoryThreshold()),
-      keyChannelMap_(joinNode_->rightKeys().size()) {
+      keyChannelMap_(joinNode_->rightKeys().size()),
+      heavyHitterMinRows_(operatorCtx_->driverCtx()
+                              ->queryConfig()
+                              .hashJoinHeavyHitterMinRows()),
+      spillPartitionPredictionEnabled_(
+          operatorCtx_->driverCtx()
+              ->queryConfig()
+              .joinSpillPartitionPredictionEnabled()) {
   VELOX_CHECK(pool()->trackUsage());
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
+  if (heavyHitterMinRows_ > 0) {
+    keyHashSummary_ = std::make_unique<
+        functions::ApproxMostFrequentStreamSummary<uint64_t>>();
+    keyHashSummary_->setCapacity(kHeavyHitterSummaryCapacity);
+  }
+
   spillGroup_ = spillEnabled()
       ? operatorCtx_->task()->getSpillOperatorGroupLocked(
             operatorCtx_->driverCtx()->splitGroupId, planNodeId())
@@ -143,6 +159,7 @@ void HashBuild::setupTable() {
   for (int i = numKeys; i < tableType_->size(); ++i) {
     dependentTypes.emplace_back(tableType_->childAt(i));
   }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
   if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
       joinNode_->isRightSemiProjectJoin()) {
     // Do not ignore null keys.
@@ -151,10 +168,9 @@ void HashBuild::setupTable() {
         dependentTypes,
         true, // allowDuplicates
         true, // hasProbedFlag
-        operatorCtx_->driverCtx()
-            ->queryConfig()
-            .minTableRowsForParallelJoinBuild(),
-        pool());
+        queryConfig.minTableRowsForParallelJoinBuild(),
+        pool(),
+        queryConfig.hashJoinWideNormalizedKeyEnabled());
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -171,10 +187,9 @@ void HashBuild::setupTable() {
           dependentTypes,
           !dropDuplicates, // allowDuplicates
           needProbedFlag, // hasProbedFlag
-          operatorCtx_->driverCtx()
-              ->queryConfig()
-              .minTableRowsForParallelJoinBuild(),
-          pool());
+          queryConfig.minTableRowsForParallelJoinBuild(),
+          pool(),
+          queryConfig.hashJoinWideNormalizedKeyEnabled());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -182,12 +197,15 @@ void HashBuild::setupTable() {
           dependentTypes,
           !dropDuplicates, // allowDuplicates
           needProbedFlag, // hasProbedFlag
-          operatorCtx_->driverCtx()
-              ->queryConfig()
-              .minTableRowsForParallelJoinBuild(),
-          pool());
+          queryConfig.minTableRowsForParallelJoinBuild(),
+          pool(),
+          queryConfig.hashJoinWideNormalizedKeyEnabled());
     }
   }
+  table_->setMinTableBytesForPartitionedProbe(
+      queryConfig.hashProbePartitionedMinTableBytes());
+  table_->setConcurrentJoinBuild(queryConfig.hashJoinConcurrentBuildEnabled());
+  table_->setInlineKeys(queryConfig.hashTableInlineKeysEnabled());
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
@@ -211,6 +229,12 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
     LOG(INFO) << "Setup reader to read spilled input from "
               << spillPartition->toString()
               << ", memory pool: " << pool()->name();
+    stats_.wlock()->addRuntimeStat(
+        fmt::format(
+            "spillRestoredBytesLevel{}",
+            spillConfig.joinSpillLevel(
+                spillPartition->id().partitionBitOffset())),
+        RuntimeCounter(spillPartition->size(), RuntimeCounter::Unit::kBytes));
     spillInputReader_ = spillPartition->createReader();
 
     const auto startBit = spillPartition->id().partitionBitOffset() +
@@ -238,7 +262,9 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.writeBufferSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.fileFormat,
+      spillConfig.adaptiveCompression);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -373,6 +399,10 @@ void HashBuild::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (keyHashSummary_ != nullptr) {
+    addKeyHashesToSummary();
+  }
+
   if (analyzeKeys_ && hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
   }
@@ -409,6 +439,35 @@ void HashBuild::addInput(RowVectorPtr input) {
   });
 }
 
+void HashBuild::addKeyHashesToSummary() {
+  auto& hashers = table_->hashers();
+  keyHashes_.resize(activeRows_.end());
+  VectorHasher::hash(hashers, activeRows_, keyHashes_);
+  activeRows_.applyToSelected(
+      [&](auto row) { keyHashSummary_->insert(keyHashes_[row]); });
+}
+
+folly::F14FastSet<uint64_t> HashBuild::findHeavyHitters(
+    const std::vector<HashBuild*>& otherBuilds) {
+  folly::F14FastSet<uint64_t> heavyHitters;
+  if (keyHashSummary_ == nullptr) {
+    return heavyHitters;
+  }
+  for (auto* build : otherBuilds) {
+    const auto& summary = *build->keyHashSummary_;
+    for (auto i = 0; i < summary.size(); ++i) {
+      keyHashSummary_->insert(summary.values()[i], summary.counts()[i]);
+    }
+  }
+  for (auto i = 0; i < keyHashSummary_->size(); ++i) {
+    if (keyHashSummary_->counts()[i] >=
+        static_cast<int64_t>(heavyHitterMinRows_)) {
+      heavyHitters.insert(keyHashSummary_->values()[i]);
+    }
+  }
+  return heavyHitters;
+}
+
 bool HashBuild::ensureInputFits(RowVectorPtr& input) {
   // NOTE: we don't need memory reservation if all the partitions are spilling
   // as we spill all the input rows to disk directly.
@@ -677,6 +736,7 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
   VELOX_CHECK_GT(targetRows, 0);
   VELOX_CHECK_GT(targetBytes, 0);
 
+  const auto prevSpilledBytes = spilledBytes(spillOperators);
   // TODO: consider to offload the partition spill processing to an executor to
   // run in parallel.
   for (auto& spillOp : spillOperators) {
@@ -685,6 +745,19 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
     build->table_->clear();
     build->pool()->release();
   }
+  if (spillPartitionPredictionEnabled_) {
+    joinBridge_->addSpillRun(spilledBytes(spillOperators) - prevSpilledBytes);
+  }
+}
+
+// static
+uint64_t HashBuild::spilledBytes(const std::vector<Operator*>& operators) {
+  uint64_t bytes{0};
+  for (auto* op : operators) {
+    auto* build = static_cast<HashBuild*>(op);
+    bytes += build->spiller_->stats().spilledBytes;
+  }
+  return bytes;
 }
 
 void HashBuild::addAndClearSpillTarget(uint64_t& numRows, uint64_t& numBytes) {
@@ -810,9 +883,23 @@ bool HashBuild::finishHashBuild() {
       std::move(otherTables),
       allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                              : nullptr);
+  // Heavy hitters are not tracked for the tables restored from spill.
+  if (spillPartitions.empty() && !isInputFromSpill()) {
+    auto heavyHitters = findHeavyHitters(otherBuilds);
+    if (!heavyHitters.empty()) {
+      addRuntimeStat("heavyHitterKeys", RuntimeCounter(heavyHitters.size()));
+      table_->setHeavyHitterHashes(std::move(heavyHitters));
+    }
+  }
   addRuntimeStats();
+  auto keyFilters = spillPartitions.empty()
+      ? makeKeyBloomFilters(numRows)
+      : std::vector<std::shared_ptr<common::Filter>>{};
   if (joinBridge_->setHashTable(
-          std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
+          std::move(table_),
+          std::move(spillPartitions),
+          joinHasNullKeys_,
+          std::move(keyFilters))) {
     spillGroup_->restart();
   }
 
@@ -822,6 +909,124 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+namespace {
+template <typename T>
+void addKeysToBloomFilter(
+    char** rows,
+    int32_t numRows,
+    RowColumn column,
+    BloomFilter<>& bloomFilter,
+    int64_t& min,
+    int64_t& max) {
+  for (auto i = 0; i < numRows; ++i) {
+    if (RowContainer::isNullAt(rows[i], column.nullByte(), column.nullMask())) {
+      continue;
+    }
+    const int64_t value =
+        *reinterpret_cast<const T*>(rows[i] + column.offset());
+    bloomFilter.insert(common::BigintValuesUsingBloomFilter::hashValue(value));
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+}
+} // namespace
+
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeKeyBloomFilters(
+    uint64_t numRows) const {
+  const uint64_t maxBytes =
+      operatorCtx_->driverCtx()->queryConfig().hashBuildBloomFilterMaxBytes();
+  // Dynamic filters are only pushed down for these join types by HashProbe.
+  // The probe side does not push down filters built from restored spill data.
+  const bool pushesDownFilters = isInnerJoin(joinType_) ||
+      isLeftSemiFilterJoin(joinType_) || isRightSemiFilterJoin(joinType_) ||
+      isRightSemiProjectJoin(joinType_);
+  if (maxBytes == 0 || isInputFromSpill() || !pushesDownFilters) {
+    return {};
+  }
+  // BloomFilter::reset() allocates 2 bytes per value rounded up to a power of
+  // 2, with a minimum of 4 words.
+  const uint64_t numBytes =
+      std::max<uint64_t>(4, bits::nextPowerOfTwo(numRows) / 4) *
+      sizeof(uint64_t);
+  if (numRows == 0 || numBytes > maxBytes ||
+      numRows > std::numeric_limits<int32_t>::max()) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  std::vector<std::shared_ptr<BloomFilter<>>> bloomFilters(hashers.size());
+  bool hasBloomFilter = false;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    // Keys with few enough distinct values get an exact filter in HashProbe.
+    if (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+        !hashers[i]->distinctOverflow()) {
+      continue;
+    }
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        bloomFilters[i] = std::make_shared<BloomFilter<>>();
+        bloomFilters[i]->reset(numRows);
+        hasBloomFilter = true;
+        break;
+      default:
+        break;
+    }
+  }
+  if (!hasBloomFilter) {
+    return {};
+  }
+
+  std::vector<int64_t> mins(
+      hashers.size(), std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> maxs(
+      hashers.size(), std::numeric_limits<int64_t>::min());
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  BaseHashTable::RowsIterator iter;
+  while (const auto numListed = table_->listAllRows(
+             &iter, kBatchSize, RowContainer::kUnlimited, rows.data())) {
+    for (auto i = 0; i < hashers.size(); ++i) {
+      if (bloomFilters[i] == nullptr) {
+        continue;
+      }
+      const auto column = table_->rows()->columnAt(i);
+      auto& bloomFilter = *bloomFilters[i];
+      switch (hashers[i]->typeKind()) {
+        case TypeKind::TINYINT:
+          addKeysToBloomFilter<int8_t>(
+              rows.data(), numListed, column, bloomFilter, mins[i], maxs[i]);
+          break;
+        case TypeKind::SMALLINT:
+          addKeysToBloomFilter<int16_t>(
+              rows.data(), numListed, column, bloomFilter, mins[i], maxs[i]);
+          break;
+        case TypeKind::INTEGER:
+          addKeysToBloomFilter<int32_t>(
+              rows.data(), numListed, column, bloomFilter, mins[i], maxs[i]);
+          break;
+        case TypeKind::BIGINT:
+          addKeysToBloomFilter<int64_t>(
+              rows.data(), numListed, column, bloomFilter, mins[i], maxs[i]);
+          break;
+        default:
+          VELOX_UNREACHABLE();
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> keyFilters(hashers.size());
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (bloomFilters[i] != nullptr && mins[i] <= maxs[i]) {
+      keyFilters[i] = std::make_shared<common::BigintValuesUsingBloomFilter>(
+          mins[i], maxs[i], std::move(bloomFilters[i]), false);
+    }
+  }
+  return keyFilters;
+}
+
 void HashBuild::recordSpillStats() {
   if (spiller_ != nullptr) {
     const auto spillStats = spiller_->stats();
@@ -908,6 +1113,16 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
 
   setupTable();
   setupSpiller(spillInput.spillPartition.get());
+  if (spillInput.repartition && spiller_ != nullptr) {
+    // The restoring partition is predicted not to fit in memory. Spill all the
+    // input rows directly into the next level partitions instead of building
+    // a table which would have to be spilled again.
+    SpillPartitionNumSet partitions;
+    for (auto i = 0; i < spiller_->hashBits().numPartitions(); ++i) {
+      partitions.insert(i);
+    }
+    spiller_->setPartitionsSpilled(partitions);
+  }
 
   // Start to process spill input.
   processSpillInput();
@@ -1128,6 +1343,7 @@ void HashBuild::reclaim(
     explicit SpillResult(std::exception_ptr _error) : error(_error) {}
   };
 
+  const auto prevSpilledBytes = spilledBytes(operators);
   std::vector<std::shared_ptr<AsyncSource<SpillResult>>> spillTasks;
   auto* spillExecutor = spillConfig()->executor;
   for (auto* op : operators) {
@@ -1171,6 +1387,9 @@ void HashBuild::reclaim(
       std::rethrow_exception(result->error);
     }
   }
+  if (spillPartitionPredictionEnabled_) {
+    joinBridge_->addSpillRun(spilledBytes(operators) - prevSpilledBytes);
+  }
 }
 
 bool HashBuild::nonReclaimableState() const {
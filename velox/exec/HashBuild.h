@@ -24,6 +24,7 @@
 #include "velox/exec/UnorderedStreamReader.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/Expr.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -214,6 +215,11 @@ class HashBuild final : public Operator {
   // 'numRows' and 'numBytes'.
   void addAndClearSpillTarget(uint64_t& numRows, uint64_t& numBytes);
 
+  // Returns the total bytes spilled so far by the HashBuild 'operators'. Used
+  // to measure the size of a group spill run for
+  // HashJoinBridge::addSpillRun().
+  static uint64_t spilledBytes(const std::vector<Operator*>& operators);
+
   // Invoked to reset the operator state to restore previously spilled data. It
   // setup (recursive) spiller and spill input reader from 'spillInput' received
   // from 'joinBride_'. 'spillInput' contains a shard of previously spilled
@@ -238,6 +244,24 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Invoked by the last build driver after the join table is prepared. Returns
+  // a Bloom filter over the values of each integer join key that has too many
+  // distinct values for VectorHasher::getFilter(). The filters are handed
+  // over to HashProbe operators to push down into the probe side table scans.
+  // Returns an empty list if the Bloom filters are disabled or would exceed
+  // the configured size. 'numRows' is the number of rows in the join table.
+  std::vector<std::shared_ptr<common::Filter>> makeKeyBloomFilters(
+      uint64_t numRows) const;
+
+  // Adds the hashes of the join keys of 'activeRows_' to 'keyHashSummary_'.
+  void addKeyHashesToSummary();
+
+  // Invoked by the last build driver. Merges the key hash summaries of
+  // 'otherBuilds' into the one of 'this' and returns the hashes of the keys
+  // with at least 'heavyHitterMinRows_' estimated rows.
+  folly::F14FastSet<uint64_t> findHeavyHitters(
+      const std::vector<HashBuild*>& otherBuilds);
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
@@ -289,6 +313,21 @@ class HashBuild final : public Operator {
   // Temporary space for hash numbers.
   raw_vector<uint64_t> hashes_;
 
+  // See QueryConfig::hashJoinHeavyHitterMinRows(). 0 if heavy hitters are not
+  // tracked.
+  const uint64_t heavyHitterMinRows_;
+
+  // See QueryConfig::joinSpillPartitionPredictionEnabled().
+  const bool spillPartitionPredictionEnabled_;
+
+  // The approximate most frequent join key hashes of the input of 'this'. Set
+  // if 'heavyHitterMinRows_' is not 0.
+  std::unique_ptr<functions::ApproxMostFrequentStreamSummary<uint64_t>>
+      keyHashSummary_;
+
+  // Temporary space for the key hashes added to 'keyHashSummary_'.
+  raw_vector<uint64_t> keyHashes_;
+
   // Set of active rows during addInput().
   SelectivityVector activeRows_;
 
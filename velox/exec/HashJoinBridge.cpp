@@ -32,7 +32,8 @@ void HashJoinBridge::addBuilder() {
 bool HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> keyFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -62,7 +63,8 @@ bool HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(keyFilters));
     restoringSpillPartitionId_.reset();
 
     hasSpillData = !spillPartitionSets_.empty();
@@ -89,6 +91,11 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
   notify(std::move(promises));
 }
 
+void HashJoinBridge::addSpillRun(uint64_t spilledBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  maxSpillRunBytes_ = std::max(maxSpillRunBytes_, spilledBytes);
+}
+
 std::optional<HashJoinBridge::HashBuildResult> HashJoinBridge::tableOrFuture(
     ContinueFuture* future) {
   std::lock_guard<std::mutex> l(mutex_);
@@ -127,6 +134,8 @@ bool HashJoinBridge::probeFinished() {
     if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
       restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
+      restoringSpillPartitionOversized_ = maxSpillRunBytes_ > 0 &&
+          spillPartitionSets_.begin()->second->size() > maxSpillRunBytes_;
       restoringSpillShards_ =
           spillPartitionSets_.begin()->second->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
@@ -160,7 +169,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(std::move(spillShard), restoringSpillPartitionOversized_);
 }
 
 bool isLeftNullAwareJoinWithFilter(
@@ -38,14 +38,23 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'keyFilters' has an optional
+  /// Bloom filter per join key for HashProbe operators to push down.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> keyFilters = {});
 
   void setAntiJoinHasNullKeys();
 
+  /// Invoked by a HashBuild operator after a group spill run to record the
+  /// 'spilledBytes' written by all the peer operators in that run. A spill run
+  /// writes out about as much data as fits in memory, so the largest run is
+  /// used by probeFinished() to predict whether a spilled partition can be
+  /// restored into a hash table without spilling again.
+  void addSpillRun(uint64_t spilledBytes);
+
   /// Represents the result of HashBuild operators: a hash table, an optional
   /// restored spill partition id associated with the table, and the spilled
   /// partitions while building the table if not empty. In case of an anti join,
@@ -57,11 +66,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _keyFilters = {})
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          keyFilters(std::move(_keyFilters)) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -69,6 +80,8 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    // Either empty or one per join key, null for keys without a filter.
+    std::vector<std::shared_ptr<common::Filter>> keyFilters;
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -87,13 +100,19 @@ class HashJoinBridge : public JoinBridge {
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
-  /// data to restore.
+  /// data to restore. 'repartition' is true if the restoring partition is
+  /// predicted not to fit in memory, in which case the HashBuild operator
+  /// streams the shard directly into the next level spill partitions instead
+  /// of building a table from it first.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool repartition = false)
+        : spillPartition(std::move(spillPartition)),
+          repartition(repartition) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    bool repartition;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -124,6 +143,14 @@ class HashJoinBridge : public JoinBridge {
   // of spill files and will be processed by one of the HashBuild operator.
   std::vector<std::unique_ptr<SpillPartition>> restoringSpillShards_;
 
+  // True if the restoring spill partition is larger than
+  // 'maxSpillRunBytes_'.
+  bool restoringSpillPartitionOversized_{false};
+
+  // The largest number of bytes written by a single group spill run. 0 if no
+  // spill run has been recorded.
+  uint64_t maxSpillRunBytes_{0};
+
   // The spill partitions remaining to restore. This set is populated using
   // information provided by the HashBuild operators if spilling is enabled.
   // This set can grow if HashBuild operator cannot load full partition in
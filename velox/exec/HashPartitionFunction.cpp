@@ -49,6 +49,7 @@ void HashPartitionFunction::init(
       hashers_.emplace_back(
           VectorHasher::create(inputType->childAt(channel), channel));
     } else {
+      hasConstantKeys_ = true;
       const auto& constValue = constValues[constChannel++];
       hashers_.emplace_back(VectorHasher::create(constValue->type(), channel));
       hashers_.back()->precompute(*constValue);
@@ -68,13 +69,20 @@ std::optional<uint32_t> HashPartitionFunction::partition(
   rows_.setAll();
 
   hashes_.resize(size);
-  for (auto i = 0; i < hashers_.size(); ++i) {
-    auto& hasher = hashers_[i];
-    if (hasher->channel() != kConstantChannel) {
-      hashers_[i]->decode(*input.childAt(hasher->channel()), rows_);
-      hashers_[i]->hash(rows_, i > 0, hashes_);
-    } else {
-      hashers_[i]->hashPrecomputed(rows_, i > 0, hashes_);
+  if (!hasConstantKeys_) {
+    for (auto& hasher : hashers_) {
+      hasher->decode(*input.childAt(hasher->channel()), rows_);
+    }
+    VectorHasher::hash(hashers_, rows_, hashes_);
+  } else {
+    for (auto i = 0; i < hashers_.size(); ++i) {
+      auto& hasher = hashers_[i];
+      if (hasher->channel() != kConstantChannel) {
+        hashers_[i]->decode(*input.childAt(hasher->channel()), rows_);
+        hashers_[i]->hash(rows_, i > 0, hashes_);
+      } else {
+        hashers_[i]->hashPrecomputed(rows_, i > 0, hashes_);
+      }
     }
   }
 
@@ -61,6 +61,10 @@ class HashPartitionFunction : public core::PartitionFunction {
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  // True if some of 'hashers_' are for constant keys. All keys are then
+  // hashed one at a time.
+  bool hasConstantKeys_{false};
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
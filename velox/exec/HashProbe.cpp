@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashProbe.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -62,6 +63,10 @@ void extractColumns(
     const std::vector<TypePtr>& resultTypes,
     std::vector<VectorPtr>& resultVectors) {
   VELOX_CHECK_EQ(resultTypes.size(), resultVectors.size())
+  std::vector<int32_t> columns;
+  std::vector<VectorPtr> children;
+  columns.reserve(projections.size());
+  children.reserve(projections.size());
   for (auto projection : projections) {
     const auto resultChannel = projection.outputChannel;
     VELOX_CHECK_LT(resultChannel, resultVectors.size())
@@ -73,9 +78,10 @@ void extractColumns(
       child = BaseVector::create(resultTypes[resultChannel], rows.size(), pool);
     }
     child->resize(rows.size());
-    table->rows()->extractColumn(
-        rows.data(), rows.size(), projection.inputChannel, child);
+    columns.push_back(projection.inputChannel);
+    children.push_back(child);
   }
+  table->rows()->extractColumns(rows.data(), rows.size(), columns, children);
 }
 
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
@@ -119,6 +125,8 @@ HashProbe::HashProbe(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
+      heavyHitterTimeSliceMs_{
+          driverCtx->queryConfig().hashProbeHeavyHitterTimeSliceMs()},
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
@@ -233,6 +241,11 @@ void HashProbe::maybeSetupSpillInput(
     VELOX_CHECK(iter != spillPartitionSet_.end());
     auto partition = std::move(iter->second);
     VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
+    stats_.wlock()->addRuntimeStat(
+        fmt::format(
+            "spillRestoredBytesLevel{}",
+            spillConfig_->joinSpillLevel(partition->id().partitionBitOffset())),
+        RuntimeCounter(partition->size(), RuntimeCounter::Unit::kBytes));
     spillInputReader_ = partition->createReader();
     spillPartitionSet_.erase(iter);
   }
@@ -259,7 +272,9 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.writeBufferSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.fileFormat,
+      spillConfig.adaptiveCompression);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -317,24 +332,35 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->keyFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. Keys with too many distinct values for an exact
+    // filter may have a Bloom filter built by HashBuild.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& keyFilters = hashBuildResult->keyFilters;
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::shared_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(false);
+      }
+      if (filter == nullptr && !keyFilters.empty()) {
+        filter = keyFilters[i];
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
   }
@@ -455,6 +481,15 @@ void HashProbe::prepareInputIndicesBuffers(
 }
 
 BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (yield_) {
+    VELOX_CHECK(isRunning());
+    yield_ = false;
+    // Starts a new time slice when the driver runs again.
+    heavyHitterSliceStartMs_ = 0;
+    *future = ContinueFuture{folly::Unit{}};
+    return BlockingReason::kYield;
+  }
+
   switch (state_) {
     case ProbeOperatorState::kWaitForBuild:
       VELOX_CHECK_NULL(table_);
@@ -496,9 +531,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBigintValuesUsingBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -582,15 +620,25 @@ void HashProbe::addInput(RowVectorPtr input) {
   lookup_->hashes.resize(input_->size());
   auto mode = table_->hashMode();
   auto& buildHashers = table_->hashers();
-  for (auto i = 0; i < keyChannels_.size(); ++i) {
-    if (mode != BaseHashTable::HashMode::kHash) {
+  const auto numFirstWordKeys = table_->numFirstWordKeys();
+  if (numFirstWordKeys < keyChannels_.size()) {
+    lookup_->secondNormalizedKeys.resize(input_->size());
+  }
+  if (mode == BaseHashTable::HashMode::kHash) {
+    VectorHasher::hash(hashers_, activeRows_, lookup_->hashes);
+  } else {
+    for (auto i = 0; i < keyChannels_.size(); ++i) {
       auto key = input_->childAt(keyChannels_[i]);
       buildHashers[i]->lookupValueIds(
-          *key, activeRows_, scratchMemory_, lookup_->hashes);
-    } else {
-      hashers_[i]->hash(activeRows_, i > 0, lookup_->hashes);
+          *key,
+          activeRows_,
+          scratchMemory_,
+          i < numFirstWordKeys ? lookup_->hashes
+                               : lookup_->secondNormalizedKeys);
     }
   }
+  inputHitsHeavyHitters_ = hitsHeavyHitters();
+  heavyHitterSliceStartMs_ = 0;
   lookup_->rows.clear();
   if (activeRows_.isAllSelected()) {
     lookup_->rows.resize(activeRows_.size());
@@ -631,6 +679,41 @@ void HashProbe::addInput(RowVectorPtr input) {
   results_.reset(*lookup_);
 }
 
+bool HashProbe::hitsHeavyHitters() {
+  const auto& heavyHitters = table_->heavyHitterHashes();
+  if (heavyHitters.empty()) {
+    return false;
+  }
+  // The heavy hitters are identified by the hashes of the keys, which are in
+  // 'lookup_' only in kHash mode.
+  const uint64_t* hashes = lookup_->hashes.data();
+  if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+    keyHashes_.resize(input_->size());
+    VectorHasher::hash(hashers_, activeRows_, keyHashes_);
+    hashes = keyHashes_.data();
+  }
+  int64_t numHeavyHitterRows = 0;
+  activeRows_.applyToSelected([&](auto row) {
+    numHeavyHitterRows += heavyHitters.contains(hashes[row]);
+  });
+  if (numHeavyHitterRows == 0) {
+    return false;
+  }
+  addRuntimeStat("heavyHitterProbeRows", RuntimeCounter(numHeavyHitterRows));
+  return true;
+}
+
+bool HashProbe::heavyHitterSliceExpired() {
+  if (!inputHitsHeavyHitters_) {
+    return false;
+  }
+  const auto nowMs = getCurrentTimeMs();
+  if (heavyHitterSliceStartMs_ == 0) {
+    heavyHitterSliceStartMs_ = nowMs;
+  }
+  return nowMs - heavyHitterSliceStartMs_ >= heavyHitterTimeSliceMs_;
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -723,25 +806,26 @@ void HashProbe::fillOutput(vector_size_t size) {
 }
 
 RowVectorPtr HashProbe::getBuildSideOutput() {
-  outputTableRows_.resize(outputBatchSize_);
+  const auto outputBatchSize = adaptiveOutputBatchRows(outputBatchSize_);
+  outputTableRows_.resize(outputBatchSize);
   int32_t numOut;
   if (isRightSemiFilterJoin(joinType_)) {
     numOut = table_->listProbedRows(
         &lastProbeIterator_,
-        outputBatchSize_,
+        outputBatchSize,
         RowContainer::kUnlimited,
         outputTableRows_.data());
   } else if (isRightSemiProjectJoin(joinType_)) {
     numOut = table_->listAllRows(
         &lastProbeIterator_,
-        outputBatchSize_,
+        outputBatchSize,
         RowContainer::kUnlimited,
         outputTableRows_.data());
   } else {
     // Must be a right join or full join.
     numOut = table_->listNotProbedRows(
         &lastProbeIterator_,
-        outputBatchSize_,
+        outputBatchSize,
         RowContainer::kUnlimited,
         outputTableRows_.data());
   }
@@ -862,9 +946,10 @@ RowVectorPtr HashProbe::getOutput() {
   if (!input_) {
     if (!hasMoreInput()) {
       if (needLastProbe() && lastProber_) {
-        auto output = getBuildSideOutput();
-        if (output != nullptr) {
-          return output;
+        while (auto output = getBuildSideOutput()) {
+          if (auto fusedOutput = applyFusedFilterProject(std::move(output))) {
+            return fusedOutput;
+          }
         }
       }
       if (hasMoreSpillData()) {
@@ -884,7 +969,7 @@ RowVectorPtr HashProbe::getOutput() {
     addRuntimeStat("replacedWithDynamicFilterRows", RuntimeCounter(inputSize));
     auto output = Operator::fillOutput(inputSize, nullptr);
     input_ = nullptr;
-    return output;
+    return applyFusedFilterProject(std::move(output));
   }
 
   const bool isLeftSemiOrAntiJoinNoFilter = !filter_ &&
@@ -898,7 +983,7 @@ RowVectorPtr HashProbe::getOutput() {
   // no extra filter we can process each batch of input in one go.
   auto outputBatchSize = (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide)
       ? inputSize
-      : outputBatchSize_;
+      : adaptiveOutputBatchRows(outputBatchSize_);
   auto mapping =
       initializeRowNumberMapping(outputRowMapping_, outputBatchSize, pool());
   outputTableRows_.resize(outputBatchSize);
@@ -954,6 +1039,12 @@ RowVectorPtr HashProbe::getOutput() {
     numOut = evalFilter(numOut);
 
     if (!numOut) {
+      // The filter may drop most of the results of a heavy hitter. Yield
+      // instead of producing them all in one call.
+      if (heavyHitterSliceExpired()) {
+        yield_ = true;
+        return nullptr;
+      }
       continue;
     }
 
@@ -976,7 +1067,14 @@ RowVectorPtr HashProbe::getOutput() {
     if (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide) {
       input_ = nullptr;
     }
-    return output_;
+    auto output = applyFusedFilterProject(output_);
+    yield_ = input_ != nullptr && heavyHitterSliceExpired();
+    if (output == nullptr && input_ != nullptr && !yield_) {
+      // The fused FilterProject dropped all rows. Continue with the next
+      // join results of 'input_'.
+      continue;
+    }
+    return output;
   }
 }
 
@@ -1007,6 +1105,13 @@ void HashProbe::prepareFilterRowsForNullAwareJoin(
   if (filterTableInput_ == nullptr) {
     filterTableInput_ =
         BaseVector::create<RowVector>(filterInputType_, kBatchSize, pool());
+    filterTableColumns_.resize(filterInputType_->size());
+    for (auto& projection : filterTableProjections_) {
+      filterTableColumns_[projection.outputChannel] = BaseVector::create(
+          filterInputType_->childAt(projection.outputChannel),
+          kBatchSize,
+          pool());
+    }
   }
 
   if (filterPropagateNulls) {
@@ -1074,50 +1179,135 @@ void HashProbe::applyFilterOnTableRowsForNullAwareJoin(
   }
   auto* tableRows = table_->rows();
   VELOX_CHECK(tableRows, "Should not move rows in hash joins");
+
+  // Probe rows which have not passed the filter with any table row so far. A
+  // probe row is dropped as soon as it passes and the table scan stops once
+  // no probe row is left.
+  std::vector<vector_size_t> pendingRows;
+  pendingRows.reserve(rows.countSelected());
+  rows.applyToSelected([&](vector_size_t row) {
+    if (!filterPassedRows.isValid(row)) {
+      pendingRows.push_back(row);
+    }
+  });
+
   char* data[kBatchSize];
-  while (auto numRows = iterator(data, kBatchSize)) {
-    filterTableInput_->resize(numRows);
-    filterTableInputRows_.resizeFill(numRows, true);
+  while (!pendingRows.empty()) {
+    const auto numTableRows = iterator(data, kBatchSize);
+    if (numTableRows == 0) {
+      break;
+    }
     for (auto& projection : filterTableProjections_) {
+      auto& column = filterTableColumns_[projection.outputChannel];
+      column->resize(numTableRows);
       tableRows->extractColumn(
-          data,
-          numRows,
-          projection.inputChannel,
-          filterTableInput_->childAt(projection.outputChannel));
+          data, numTableRows, projection.inputChannel, column);
+    }
+    // Combine as many probe rows with the table rows as fit in one batch so
+    // that a small build side does not cost one filter evaluation per probe
+    // row.
+    const int32_t probesPerBatch = std::max(1, kBatchSize / numTableRows);
+    const int32_t numPendingRows = pendingRows.size();
+    for (int32_t i = 0; i < numPendingRows; i += probesPerBatch) {
+      const int32_t numProbeRows =
+          std::min(probesPerBatch, numPendingRows - i);
+      applyFilterOnCrossProduct(
+          pendingRows.data() + i,
+          numProbeRows,
+          numTableRows,
+          filterPassedRows);
+    }
+    pendingRows.erase(
+        std::remove_if(
+            pendingRows.begin(),
+            pendingRows.end(),
+            [&](vector_size_t row) { return filterPassedRows.isValid(row); }),
+        pendingRows.end());
+  }
+}
+
+void HashProbe::applyFilterOnCrossProduct(
+    const vector_size_t* probeRows,
+    int32_t numProbeRows,
+    int32_t numTableRows,
+    SelectivityVector& filterPassedRows) {
+  const auto numRows = numProbeRows * numTableRows;
+  filterTableInput_->resize(numRows);
+  filterTableInputRows_.resizeFill(numRows, true);
+  if (numProbeRows == 1) {
+    for (auto& projection : filterTableProjections_) {
+      filterTableInput_->childAt(projection.outputChannel) =
+          filterTableColumns_[projection.outputChannel];
     }
-    rows.applyToSelected([&](vector_size_t row) {
-      for (auto& projection : filterInputProjections_) {
-        filterTableInput_->childAt(projection.outputChannel) =
-            BaseVector::wrapInConstant(
-                numRows, row, input_->childAt(projection.inputChannel));
+    for (auto& projection : filterInputProjections_) {
+      filterTableInput_->childAt(projection.outputChannel) =
+          BaseVector::wrapInConstant(
+              numRows, probeRows[0], input_->childAt(projection.inputChannel));
+    }
+  } else {
+    // Row 'i * numTableRows + j' combines probe row 'probeRows[i]' with table
+    // row 'j'.
+    auto tableIndices = allocateIndices(numRows, pool());
+    auto probeIndices = allocateIndices(numRows, pool());
+    auto* rawTableIndices = tableIndices->asMutable<vector_size_t>();
+    auto* rawProbeIndices = probeIndices->asMutable<vector_size_t>();
+    for (auto i = 0; i < numProbeRows; ++i) {
+      for (auto j = 0; j < numTableRows; ++j) {
+        rawTableIndices[i * numTableRows + j] = j;
+        rawProbeIndices[i * numTableRows + j] = probeRows[i];
       }
-      EvalCtx evalCtx(
-          operatorCtx_->execCtx(), filter_.get(), filterTableInput_.get());
-      filter_->eval(filterTableInputRows_, evalCtx, filterTableResult_);
-      if (auto* values = getFlatFilterResult(filterTableResult_[0])) {
-        if (!bits::testSetBits(
-                values, 0, numRows, [](vector_size_t) { return false; })) {
-          filterPassedRows.setValid(row, true);
-        }
-      } else {
-        decodedFilterTableResult_.decode(
-            *filterTableResult_[0], filterTableInputRows_);
-        if (decodedFilterTableResult_.isConstantMapping()) {
-          if (!decodedFilterTableResult_.isNullAt(0) &&
-              decodedFilterTableResult_.valueAt<bool>(0)) {
-            filterPassedRows.setValid(row, true);
-          }
-        } else {
-          for (vector_size_t i = 0; i < numRows; ++i) {
-            if (!decodedFilterTableResult_.isNullAt(i) &&
-                decodedFilterTableResult_.valueAt<bool>(i)) {
-              filterPassedRows.setValid(row, true);
-              break;
-            }
-          }
-        }
+    }
+    for (auto& projection : filterTableProjections_) {
+      filterTableInput_->childAt(projection.outputChannel) =
+          BaseVector::wrapInDictionary(
+              nullptr,
+              tableIndices,
+              numRows,
+              filterTableColumns_[projection.outputChannel]);
+    }
+    for (auto& projection : filterInputProjections_) {
+      filterTableInput_->childAt(projection.outputChannel) =
+          BaseVector::wrapInDictionary(
+              nullptr,
+              probeIndices,
+              numRows,
+              input_->childAt(projection.inputChannel));
+    }
+  }
+
+  EvalCtx evalCtx(
+      operatorCtx_->execCtx(), filter_.get(), filterTableInput_.get());
+  filter_->eval(filterTableInputRows_, evalCtx, filterTableResult_);
+
+  // Marks probe row 'i' if the filter passes on any of its table rows.
+  if (auto* values = getFlatFilterResult(filterTableResult_[0])) {
+    for (auto i = 0; i < numProbeRows; ++i) {
+      if (bits::findFirstBit(
+              values, i * numTableRows, (i + 1) * numTableRows) >= 0) {
+        filterPassedRows.setValid(probeRows[i], true);
       }
-    });
+    }
+    return;
+  }
+  decodedFilterTableResult_.decode(
+      *filterTableResult_[0], filterTableInputRows_);
+  if (decodedFilterTableResult_.isConstantMapping()) {
+    if (!decodedFilterTableResult_.isNullAt(0) &&
+        decodedFilterTableResult_.valueAt<bool>(0)) {
+      for (auto i = 0; i < numProbeRows; ++i) {
+        filterPassedRows.setValid(probeRows[i], true);
+      }
+    }
+    return;
+  }
+  for (auto i = 0; i < numProbeRows; ++i) {
+    for (auto j = i * numTableRows; j < (i + 1) * numTableRows; ++j) {
+      if (!decodedFilterTableResult_.isNullAt(j) &&
+          decodedFilterTableResult_.valueAt<bool>(j)) {
+        filterPassedRows.setValid(probeRows[i], true);
+        break;
+      }
+    }
   }
 }
 
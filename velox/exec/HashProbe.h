@@ -59,6 +59,10 @@ class HashProbe : public Operator {
 
   bool isFinished() override;
 
+  bool canFuseFilterProject() const override {
+    return true;
+  }
+
   /// NOTE: we can't reclaim memory from a hash probe operator. The disk
   /// spilling in hash probe is used to coordinate with the disk spilling
   /// triggered by the hash build operator.
@@ -101,6 +105,14 @@ class HashProbe : public Operator {
   // Check if output_ can be re-used and if not make a new one.
   void prepareOutput(vector_size_t size);
 
+  // Returns true if an active row of 'input_' has the key of a heavy hitter of
+  // the build side. Adds the number of such rows to the runtime stats.
+  bool hitsHeavyHitters();
+
+  // Returns true if 'input_' hits a heavy hitter and the current time slice for
+  // producing its results is over. Starts a time slice if none is started.
+  bool heavyHitterSliceExpired();
+
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
@@ -155,6 +167,16 @@ class HashProbe : public Operator {
       SelectivityVector& filterPassedRows,
       std::function<int32_t(char**, int32_t)> iterator);
 
+  // Evaluates the filter on the cross product of 'numProbeRows' probe rows at
+  // 'probeRows' and the first 'numTableRows' rows in 'filterTableColumns_' in
+  // a single call. Marks the probe rows that pass with any table row in
+  // 'filterPassedRows'.
+  void applyFilterOnCrossProduct(
+      const vector_size_t* probeRows,
+      int32_t numProbeRows,
+      int32_t numTableRows,
+      SelectivityVector& filterPassedRows);
+
   void ensureLoadedIfNotAtEnd(column_index_t channel);
 
   // Indicates if the operator has more probe inputs from either the upstream
@@ -243,6 +265,9 @@ class HashProbe : public Operator {
   // TODO: Define batch size as bytes based on RowContainer row sizes.
   const uint32_t outputBatchSize_;
 
+  // See QueryConfig::hashProbeHeavyHitterTimeSliceMs().
+  const uint32_t heavyHitterTimeSliceMs_;
+
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
   const core::JoinType joinType_;
@@ -291,6 +316,21 @@ class HashProbe : public Operator {
   // True if the join became a no-op after pushing down the filter.
   bool replacedWithDynamicFilter_{false};
 
+  // True if a row of 'input_' has the key of a build side heavy hitter. The
+  // results for 'input_' are then produced in time slices of
+  // 'heavyHitterTimeSliceMs_', between which the driver yields.
+  bool inputHitsHeavyHitters_{false};
+
+  // Start of the current time slice. 0 if not started.
+  size_t heavyHitterSliceStartMs_{0};
+
+  // True if isBlocked() should yield the driver.
+  bool yield_{false};
+
+  // Hashes of the probe keys for finding heavy hitters in modes other than
+  // kHash.
+  raw_vector<uint64_t> keyHashes_;
+
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
   // Table shared between other HashProbes in other Drivers of the
@@ -341,7 +381,7 @@ class HashProbe : public Operator {
   // this operator.
   RowVectorPtr filterInput_;
 
-  // The following six fields are used in null-aware anti join filter
+  // The following seven fields are used in null-aware anti join filter
   // processing.
 
   // Used to decode a probe side filter input column to check nulls.
@@ -356,6 +396,11 @@ class HashProbe : public Operator {
   RowVectorPtr filterTableInput_;
   SelectivityVector filterTableInputRows_;
 
+  // Build side filter columns extracted from the table rows, indexed by
+  // channel in 'filterTableInput_'. Wrapped to form the cross product with
+  // the probe rows.
+  std::vector<VectorPtr> filterTableColumns_;
+
   // Used to store the filter result for null-key joined rows.
   std::vector<VectorPtr> filterTableResult_;
   DecodedVector decodedFilterTableResult_;
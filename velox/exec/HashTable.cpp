@@ -20,6 +20,7 @@
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/process/ProcessBase.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/VectorTypeUtils.h"
 
@@ -51,10 +52,12 @@ HashTable<ignoreNullKeys>::HashTable(
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
     memory::MemoryPool* pool,
-    const std::shared_ptr<velox::HashStringAllocator>& stringArena)
+    const std::shared_ptr<velox::HashStringAllocator>& stringArena,
+    bool enableWideNormalizedKeys)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
-      isJoinBuild_(isJoinBuild) {
+      isJoinBuild_(isJoinBuild),
+      numFirstWordKeys_(hashers_.size()) {
   std::vector<TypePtr> keys;
   for (auto& hasher : hashers_) {
     keys.push_back(hasher->type());
@@ -62,6 +65,9 @@ HashTable<ignoreNullKeys>::HashTable(
       hashMode_ = HashMode::kHash;
     }
   }
+  // A single key always fits in one word.
+  enableWideNormalizedKeys_ = enableWideNormalizedKeys && isJoinBuild &&
+      hashers_.size() > 1 && hashMode_ != HashMode::kHash;
 
   rows_ = std::make_unique<RowContainer>(
       keys,
@@ -73,7 +79,8 @@ HashTable<ignoreNullKeys>::HashTable(
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
       pool,
-      stringArena);
+      stringArena,
+      enableWideNormalizedKeys_ ? 2 : 1);
   nextOffset_ = rows_->nextOffset();
 }
 
@@ -204,10 +211,14 @@ class ProbeState {
     }
   }
 
-  template <typename Table>
-  FOLLY_ALWAYS_INLINE char* FOLLY_NULLABLE
-  joinNormalizedKeyFullProbe(const Table& table, const uint64_t* keys) {
-    if (group_ && RowContainer::normalizedKey(group_) == keys[row_]) {
+  // 'secondKeys' are the second words of two word normalized keys if
+  // 'wideKeys' is true.
+  template <bool wideKeys, typename Table>
+  FOLLY_ALWAYS_INLINE char* FOLLY_NULLABLE joinNormalizedKeyFullProbe(
+      const Table& table,
+      const uint64_t* keys,
+      const uint64_t* secondKeys) {
+    if (group_ && normalizedKeyMatches<wideKeys>(group_, keys, secondKeys)) {
       table.incrementHits();
       return group_;
     }
@@ -220,8 +231,10 @@ class ProbeState {
         }
       } else {
         loadNextHit<Operation::kProbe>(
-            table, -static_cast<int32_t>(sizeof(normalized_key_t)));
-        if (RowContainer::normalizedKey(group_) == keys[row_]) {
+            table,
+            -static_cast<int32_t>(
+                (wideKeys ? 2 : 1) * sizeof(normalized_key_t)));
+        if (normalizedKeyMatches<wideKeys>(group_, keys, secondKeys)) {
           table.incrementHits();
           return group_;
         }
@@ -234,9 +247,67 @@ class ProbeState {
     }
   }
 
+  // Loads the tags of the first bucket without loading a row. Used with
+  // inline keys, where the keys are compared before the row is loaded.
+  template <typename Table>
+  inline void firstInlineKeyProbe(const Table& table) {
+    tagsInTable_ = BaseHashTable::loadTags(
+        reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
+    table.incrementTagLoads();
+    hits_ = simd::toBitMask(tagsInTable_ == wantedTags_);
+  }
+
+  // Returns the row whose inline key is 'keys[row_]' or nullptr if there is
+  // none. Only the row of the matching entry is accessed.
+  template <typename Table>
+  FOLLY_ALWAYS_INLINE char* FOLLY_NULLABLE
+  joinInlineKeyFullProbe(const Table& table, const uint64_t* keys) {
+    const auto key = keys[row_];
+    const auto kEmptyGroup = BaseHashTable::TagVector::broadcast(kEmptyTag);
+    for (;;) {
+      auto* bucket = table.bucketAt(bucketOffset_);
+      while (hits_) {
+        const auto hit = bits::getAndClearLastSetBit(hits_);
+        if (bucket->inlineKeyAt(hit) == key) {
+          table.incrementHits();
+          return bucket->pointerAt(hit);
+        }
+      }
+      if (simd::toBitMask(tagsInTable_ == kEmptyGroup)) {
+        return nullptr;
+      }
+      bucketOffset_ = table.nextBucketOffset(bucketOffset_);
+      tagsInTable_ = BaseHashTable::loadTags(
+          reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
+      hits_ = simd::toBitMask(tagsInTable_ == wantedTags_) & kFullMask;
+    }
+  }
+
+  // Returns the inline key of the entry of the last loaded hit.
+  template <typename Table>
+  FOLLY_ALWAYS_INLINE normalized_key_t inlineKey(const Table& table) const {
+    return table.bucketAt(bucketOffset_)->inlineKeyAt(hit_);
+  }
+
  private:
   static constexpr uint8_t kNotSet = 0xff;
 
+  // Compares the normalized key of 'group' with the one of 'row_'. Both words
+  // of a two word key are compared without a branch on the first word.
+  template <bool wideKeys>
+  FOLLY_ALWAYS_INLINE bool normalizedKeyMatches(
+      char* group,
+      const uint64_t* keys,
+      const uint64_t* secondKeys) const {
+    if constexpr (wideKeys) {
+      return ((RowContainer::normalizedKey(group) ^ keys[row_]) |
+              (RowContainer::secondNormalizedKey(group) ^ secondKeys[row_])) ==
+          0;
+    } else {
+      return RowContainer::normalizedKey(group) == keys[row_];
+    }
+  }
+
   template <Operation op, typename Table>
   inline void loadNextHit(Table& table, int32_t firstKey) {
     int32_t hit = bits::getAndClearLastSetBit(hits_);
@@ -244,6 +315,7 @@ class ProbeState {
     if (op == Operation::kErase) {
       indexInTags_ = hit;
     }
+    hit_ = hit;
     group_ = table.row(bucketOffset_, hit);
     __builtin_prefetch(group_ + firstKey);
     table.incrementRowLoads();
@@ -261,6 +333,8 @@ class ProbeState {
   }
 
   char* group_;
+  // Slot of 'group_' in the bucket at 'bucketOffset_'.
+  int32_t hit_;
   BaseHashTable::TagVector wantedTags_;
   BaseHashTable::TagVector tagsInTable_;
   int32_t row_;
@@ -302,6 +376,10 @@ void HashTable<ignoreNullKeys>::storeRowPointer(
   const auto slotIndex = index & (sizeof(TagVector) - 1);
   bucket->setTag(slotIndex, hashTag(hash));
   bucket->setPointer(slotIndex, row);
+  if (inlineKeys_) {
+    VELOX_DCHECK_LT(slotIndex, Bucket::kNumInlineKeySlots);
+    bucket->setInlineKey(slotIndex, RowContainer::normalizedKey(row));
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -312,13 +390,14 @@ char* HashTable<ignoreNullKeys>::insertEntry(
   char* group = rows_->newRow();
   lookup.hits[row] = group; // NOLINT
   storeKeys(lookup, row);
-  storeRowPointer(index, lookup.hashes[row], group);
   if (hashMode_ == HashMode::kNormalizedKey) {
     // We store the unique digest of key values (normalized key) in
     // the word below the row. Space was reserved in the allocation
-    // unless we have given up on normalized keys.
+    // unless we have given up on normalized keys. This is stored before the
+    // row pointer since inline keys are copied from the row.
     RowContainer::normalizedKey(group) = lookup.normalizedKeys[row]; // NOLINT
   }
+  storeRowPointer(index, lookup.hashes[row], group);
   ++numDistinct_;
   lookup.newGroups.push_back(row);
   return group;
@@ -358,13 +437,29 @@ bool HashTable<ignoreNullKeys>::compareKeys(
 }
 
 template <bool ignoreNullKeys>
-template <bool isJoin, bool isNormalizedKey>
+template <bool isJoin, bool isNormalizedKey, bool inlineKeys>
 FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
     HashLookup& lookup,
     ProbeState& state,
     bool extraCheck) {
   constexpr ProbeState::Operation op =
       isJoin ? ProbeState::Operation::kProbe : ProbeState::Operation::kInsert;
+  if constexpr (inlineKeys) {
+    static_assert(isNormalizedKey);
+    // NOLINT
+    lookup.hits[state.row()] = state.fullProbe<op>(
+        *this,
+        -static_cast<int32_t>(sizeof(normalized_key_t)),
+        [&](char* /*group*/, int32_t row) INLINE_LAMBDA {
+          return state.inlineKey(*this) == lookup.normalizedKeys[row];
+        },
+        [&](int32_t row, uint64_t index) {
+          return isJoin ? nullptr : insertEntry(lookup, index, row);
+        },
+        numTombstones_,
+        !isJoin && extraCheck);
+    return;
+  }
   if constexpr (isNormalizedKey) {
     // NOLINT
     lookup.hits[state.row()] = state.fullProbe<op>(
@@ -401,6 +496,11 @@ inline uint64_t mixNormalizedKey(uint64_t k, uint8_t bits) {
   return folly::hasher<uint64_t>()(k);
 }
 
+// Makes the hash number of a two word normalized key.
+inline uint64_t mixWideNormalizedKey(uint64_t first, uint64_t second) {
+  return bits::hashMix(first, second);
+}
+
 void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
   lookup.normalizedKeys.resize(lookup.rows.back() + 1);
   uint64_t* __restrict hashes = lookup.hashes.data();
@@ -422,6 +522,20 @@ void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
     hashes[row] = mixNormalizedKey(hash, sizeBits);
   }
 }
+
+// Same as populateNormalizedKeys() for two word normalized keys. The second
+// words are expected in 'lookup.secondNormalizedKeys'.
+void populateWideNormalizedKeys(HashLookup& lookup) {
+  lookup.normalizedKeys.resize(lookup.rows.back() + 1);
+  uint64_t* __restrict hashes = lookup.hashes.data();
+  uint64_t* __restrict keys = lookup.normalizedKeys.data();
+  const uint64_t* __restrict secondKeys = lookup.secondNormalizedKeys.data();
+  for (auto row : lookup.rows) {
+    auto hash = hashes[row];
+    keys[row] = hash; // NOLINT
+    hashes[row] = mixWideNormalizedKey(hash, secondKeys[row]);
+  }
+}
 } // namespace
 
 template <bool ignoreNullKeys>
@@ -437,7 +551,11 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   checkSize(lookup.rows.size(), false);
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
-    groupNormalizedKeyProbe(lookup);
+    if (inlineKeys_) {
+      groupNormalizedKeyProbe<true>(lookup);
+    } else {
+      groupNormalizedKeyProbe<false>(lookup);
+    }
     return;
   }
   ProbeState state1;
@@ -476,6 +594,7 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
 }
 
 template <bool ignoreNullKeys>
+template <bool inlineKeys>
 void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   ProbeState state1;
   ProbeState state2;
@@ -499,16 +618,16 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
     state2.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
     state3.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
     state4.firstProbe<ProbeState::Operation::kInsert>(*this, kKeyOffset);
-    fullProbe<false, true>(lookup, state1, false);
-    fullProbe<false, true>(lookup, state2, true);
-    fullProbe<false, true>(lookup, state3, true);
-    fullProbe<false, true>(lookup, state4, true);
+    fullProbe<false, true, inlineKeys>(lookup, state1, false);
+    fullProbe<false, true, inlineKeys>(lookup, state2, true);
+    fullProbe<false, true, inlineKeys>(lookup, state3, true);
+    fullProbe<false, true, inlineKeys>(lookup, state4, true);
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
     state1.firstProbe(*this, kKeyOffset);
-    fullProbe<false, true>(lookup, state1, false);
+    fullProbe<false, true, inlineKeys>(lookup, state1, false);
   }
 }
 
@@ -571,13 +690,21 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     return;
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
-    populateNormalizedKeys(lookup, sizeBits_);
-    joinNormalizedKeyProbe(lookup);
+    if (hasWideNormalizedKeys()) {
+      populateWideNormalizedKeys(lookup);
+      joinNormalizedKeyProbe<true>(lookup);
+    } else if (inlineKeys_) {
+      populateNormalizedKeys(lookup, sizeBits_);
+      joinInlineKeyProbe(lookup);
+    } else {
+      populateNormalizedKeys(lookup, sizeBits_);
+      joinNormalizedKeyProbe<false>(lookup);
+    }
     return;
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = probeRows(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -608,6 +735,37 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::probeRows(HashLookup& lookup) {
+  const int32_t numRows = lookup.rows.size();
+  if (minTableBytesForPartitionedProbe_ == 0 ||
+      sizeMask_ + 1 < minTableBytesForPartitionedProbe_ ||
+      sizeBits_ <= kProbePartitionBits ||
+      numRows < kMinRowsForPartitionedProbe) {
+    return lookup.rows.data();
+  }
+  // The bucket offset is the low 'sizeBits_' bits of the hash, so its high
+  // bits select a contiguous region of the table. Counting sort the rows by
+  // these bits.
+  const int32_t partitionBits = std::min<int32_t>(
+      kMaxProbePartitionBits, sizeBits_ - kProbePartitionBits);
+  const int32_t shift = sizeBits_ - partitionBits;
+  const uint64_t* hashes = lookup.hashes.data();
+  std::array<int32_t, (1 << kMaxProbePartitionBits) + 1> offsets{};
+  for (auto row : lookup.rows) {
+    ++offsets[1 + (bucketOffset(hashes[row]) >> shift)];
+  }
+  for (auto i = 1; i <= (1 << partitionBits); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  lookup.partitionedRows.resize(numRows);
+  auto* partitionedRows = lookup.partitionedRows.data();
+  for (auto row : lookup.rows) {
+    partitionedRows[offsets[bucketOffset(hashes[row]) >> shift]++] = row;
+  }
+  return partitionedRows;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -651,17 +809,20 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 }
 
 template <bool ignoreNullKeys>
+template <bool wideKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = probeRows(lookup);
   constexpr int32_t groupSize = 64;
   ProbeState states[groupSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
+  const uint64_t* secondKeys =
+      wideKeys ? lookup.secondNormalizedKeys.data() : nullptr;
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
-      -static_cast<int32_t>(sizeof(normalized_key_t));
+      -static_cast<int32_t>((wideKeys ? 2 : 1) * sizeof(normalized_key_t));
   for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
     for (int32_t i = 0; i < groupSize; ++i) {
       int32_t row = rows[probeIndex + i];
@@ -671,14 +832,61 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
       states[i].firstProbe(*this, kKeyOffset);
     }
     for (int32_t i = 0; i < groupSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
+      hits[states[i].row()] =
+          states[i].joinNormalizedKeyFullProbe<wideKeys>(
+              *this, keys, secondKeys);
     }
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     states[0].preProbe(*this, lookup.hashes[row], row);
     states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
+    hits[row] =
+        states[0].joinNormalizedKeyFullProbe<wideKeys>(*this, keys, secondKeys);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinInlineKeyProbe(HashLookup& lookup) {
+  int32_t probeIndex = 0;
+  int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = probeRows(lookup);
+  constexpr int32_t groupSize = 64;
+  ProbeState states[groupSize];
+  const uint64_t* keys = lookup.normalizedKeys.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  char** hits = lookup.hits.data();
+  for (; probeIndex + groupSize <= numProbes; probeIndex += groupSize) {
+    for (int32_t i = 0; i < groupSize; ++i) {
+      int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    for (int32_t i = 0; i < groupSize; ++i) {
+      states[i].firstInlineKeyProbe(*this);
+    }
+    for (int32_t i = 0; i < groupSize; ++i) {
+      hits[states[i].row()] = states[i].joinInlineKeyFullProbe(*this, keys);
+    }
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    int32_t row = rows[probeIndex];
+    states[0].preProbe(*this, hashes[row], row);
+    states[0].firstInlineKeyProbe(*this);
+    hits[row] = states[0].joinInlineKeyFullProbe(*this, keys);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::initializeUnusedTags() {
+  if (!inlineKeys_) {
+    return;
+  }
+  for (int64_t offset = 0; offset < sizeMask_; offset += kBucketSize) {
+    auto* bucket = bucketAt(offset);
+    for (auto slot = Bucket::kNumInlineKeySlots; slot < sizeof(TagVector);
+         ++slot) {
+      bucket->setTag(slot, kUnusedTag);
+    }
   }
 }
 
@@ -688,25 +896,29 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   VELOX_CHECK_GT(size, 0);
   capacity_ = size;
   numTombstones_ = 0;
-  sizeMask_ = (capacity_ * sizeof(void*)) - 1;
+  inlineKeys_ = inlineKeysEnabled_ &&
+      hashMode_ == HashMode::kNormalizedKey && !hasWideNormalizedKeys();
+  sizeMask_ = (capacity_ * bucketSlotSize()) - 1;
   sizeBits_ = __builtin_popcountll(sizeMask_);
   bucketOffsetMask_ = sizeMask_ & ~(kBucketSize - 1);
   // The total size is 8 bytes per slot, in groups of 16 slots with 16 bytes of
   // tags and 16 * 6 bytes of pointers and a padding of 16 bytes to round up the
-  // cache line.
+  // cache line. With inline keys, the groups are of 8 slots.
   const auto numPages =
-      memory::AllocationTraits::numPages(size * tableSlotSize());
+      memory::AllocationTraits::numPages(size * bucketSlotSize());
   rows_->pool()->allocateContiguous(numPages, tableAllocation_);
   table_ = tableAllocation_.data<char*>();
-  memset(table_, 0, capacity_ * sizeof(char*));
+  memset(table_, 0, capacity_ * bucketSlotSize());
+  initializeUnusedTags();
 }
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::clear() {
   rows_->clear();
   if (table_) {
-    // All modes have 8 bytes per slot.
-    memset(table_, 0, capacity_ * sizeof(char*));
+    // All modes have 8 bytes per slot, except for 16 with inline keys.
+    memset(table_, 0, capacity_ * bucketSlotSize());
+    initializeUnusedTags();
   }
   numDistinct_ = 0;
   numTombstones_ = 0;
@@ -728,7 +940,13 @@ void HashTable<ignoreNullKeys>::checkSize(
 
   const int64_t newNumDistincts = numNew + numDistinct_;
   if (table_ == nullptr || capacity_ == 0) {
-    const auto newSize = newHashTableEntries(numDistinct_, numNew);
+    const auto newSize = newHashTableEntries(
+        numDistinct_,
+        std::max<uint64_t>(
+            numNew,
+            expectedNumDistinct_ > numDistinct_
+                ? expectedNumDistinct_ - numDistinct_
+                : 0));
     allocateTables(newSize);
     if (numDistinct_ > 0) {
       rehash(initNormalizedKeys);
@@ -756,7 +974,17 @@ bool HashTable<ignoreNullKeys>::hashRows(
   if (rows.empty()) {
     return true;
   }
+  const bool wideKeys =
+      hashMode_ == HashMode::kNormalizedKey && hasWideNormalizedKeys();
   if (!initNormalizedKeys && hashMode_ == HashMode::kNormalizedKey) {
+    if (wideKeys) {
+      for (auto i = 0; i < rows.size(); ++i) {
+        hashes[i] = mixWideNormalizedKey(
+            RowContainer::normalizedKey(rows[i]),
+            RowContainer::secondNormalizedKey(rows[i]));
+      }
+      return true;
+    }
     for (auto i = 0; i < rows.size(); ++i) {
       hashes[i] =
           mixNormalizedKey(RowContainer::normalizedKey(rows[i]), sizeBits_);
@@ -764,6 +992,12 @@ bool HashTable<ignoreNullKeys>::hashRows(
     return true;
   }
 
+  // The value ids of the keys of the second word of a two word normalized key.
+  // Not a member since this may run on several threads in a parallel build.
+  raw_vector<uint64_t> secondWords;
+  if (wideKeys) {
+    secondWords.resize(rows.size());
+  }
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
     if (hashMode_ == HashMode::kHash) {
@@ -777,13 +1011,19 @@ bool HashTable<ignoreNullKeys>::hashRows(
               column.offset(),
               column.nullByte(),
               ignoreNullKeys ? 0 : column.nullMask(),
-              hashes)) {
+              wideKeys && i >= numFirstWordKeys_ ? secondWords : hashes)) {
         // Must reconsider 'hashMode_' and start over.
         return false;
       }
     }
   }
-  if (hashMode_ == HashMode::kNormalizedKey && initNormalizedKeys) {
+  if (wideKeys && initNormalizedKeys) {
+    for (auto i = 0; i < rows.size(); ++i) {
+      RowContainer::normalizedKey(rows[i]) = hashes[i];
+      RowContainer::secondNormalizedKey(rows[i]) = secondWords[i];
+      hashes[i] = mixWideNormalizedKey(hashes[i], secondWords[i]);
+    }
+  } else if (hashMode_ == HashMode::kNormalizedKey && initNormalizedKeys) {
     for (auto i = 0; i < rows.size(); ++i) {
       RowContainer::normalizedKey(rows[i]) = hashes[i];
       hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
@@ -941,6 +1181,103 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::concurrentJoinBuild() {
+  TestValue::adjust(
+      "facebook::velox::exec::HashTable::concurrentJoinBuild", rows_->pool());
+  std::vector<std::shared_ptr<AsyncSource<bool>>> insertSteps;
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw.
+    std::exception_ptr error;
+    syncWorkItems(insertSteps, error, offThreadBuildTiming_, true);
+  });
+
+  for (auto i = 0; i <= otherTables_.size(); ++i) {
+    auto* table = i == 0 ? this : otherTables_[i - 1].get();
+    insertSteps.push_back(
+        std::make_shared<AsyncSource<bool>>([this, table]() {
+          insertRowsConcurrently(*table);
+          return std::make_unique<bool>(true);
+        }));
+    VELOX_CHECK(!insertSteps.empty());
+    buildExecutor_->add([step = insertSteps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  syncWorkItems(insertSteps, error, offThreadBuildTiming_);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::insertRowsConcurrently(
+    HashTable<ignoreNullKeys>& subtable) {
+  constexpr int32_t kBatch = 1024;
+  raw_vector<char*> rows(kBatch);
+  raw_vector<uint64_t> hashes(kBatch);
+  RowContainerIterator iter;
+  while (auto numRows = subtable.rows_->listRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes);
+    for (auto i = 0; i < numRows; ++i) {
+      insertRowConcurrently(rows[i], hashes[i]);
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::joinRowKeysEqual(char* group, char* inserted) {
+  if (hashMode_ != HashMode::kNormalizedKey) {
+    return compareKeys(group, inserted);
+  }
+  if (RowContainer::normalizedKey(group) !=
+      RowContainer::normalizedKey(inserted)) {
+    return false;
+  }
+  return !hasWideNormalizedKeys() ||
+      RowContainer::secondNormalizedKey(group) ==
+      RowContainer::secondNormalizedKey(inserted);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::insertRowConcurrently(
+    char* inserted,
+    uint64_t hash) {
+  const auto tag = BaseHashTable::TagVector::broadcast(hashTag(hash));
+  const auto kEmptyGroup =
+      BaseHashTable::TagVector::broadcast(ProbeState::kEmptyTag);
+  int64_t offset = bucketOffset(hash);
+  for (int64_t numBuckets = 0; numBuckets <= sizeMask_ / kBucketSize;
+       ++numBuckets) {
+    auto* bucket = bucketAt(offset);
+    // Rows are only added during the build, so that a key that is not in the
+    // buckets visited so far is not in the table if there is a free slot in
+    // the current bucket.
+    std::lock_guard<folly::MicroSpinLock> l(bucket->buildLock());
+    const auto tags = loadTags(offset);
+    auto hits = simd::toBitMask(tags == tag);
+    while (hits) {
+      const auto slot = bits::getAndClearLastSetBit(hits);
+      auto* group = bucket->pointerAt(slot);
+      if (joinRowKeysEqual(group, inserted)) {
+        pushNext(group, inserted);
+        return;
+      }
+    }
+    MaskType free =
+        simd::toBitMask(tags == kEmptyGroup) & ProbeState::kFullMask;
+    if (free) {
+      const auto slot = bits::getAndClearLastSetBit(free);
+      bucket->setTag(slot, hashTag(hash));
+      bucket->setPointer(slot, inserted);
+      return;
+    }
+    offset = nextBucketOffset(offset);
+  }
+  VELOX_UNREACHABLE("No free slot in hash join table");
+}
+
 namespace {
 // Returns an index into 'buildPartitionBounds_' given an index into tags of the
 // HashTable.
@@ -1121,7 +1458,27 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::buildFullProbe(
     storeRowPointer(index, hash, inserted);
     return nullptr;
   };
-  if (hashMode_ == HashMode::kNormalizedKey) {
+  if (hashMode_ == HashMode::kNormalizedKey && hasWideNormalizedKeys()) {
+    state.fullProbe<ProbeState::Operation::kInsert>(
+        *this,
+        -static_cast<int32_t>(2 * sizeof(normalized_key_t)),
+        [&](char* group, int32_t /*row*/) {
+          if (RowContainer::normalizedKey(group) ==
+                  RowContainer::normalizedKey(inserted) &&
+              RowContainer::secondNormalizedKey(group) ==
+                  RowContainer::secondNormalizedKey(inserted)) {
+            if (nextOffset_) {
+              pushNext(group, inserted);
+            }
+            return true;
+          }
+          return false;
+        },
+        insertFn,
+        numTombstones_,
+        extraCheck,
+        partitionEnd);
+  } else if (hashMode_ == HashMode::kNormalizedKey) {
     state.fullProbe<ProbeState::Operation::kInsert>(
         *this,
         -static_cast<int32_t>(sizeof(normalized_key_t)),
@@ -1199,7 +1556,12 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
   ++numRehashes_;
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
-    parallelJoinBuild();
+    // The build locks overlap the inline keys.
+    if (concurrentJoinBuild_ && !inlineKeys_) {
+      concurrentJoinBuild();
+    } else {
+      parallelJoinBuild();
+    }
     return;
   }
   raw_vector<uint64_t> hashes;
@@ -1212,11 +1574,18 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
     RowContainerIterator iterator;
     int32_t numGroups;
     do {
-      numGroups = (i == 0 ? this : otherTables_[i - 1].get())
-                      ->rows()
-                      ->listRows(&iterator, kHashBatchSize, groups);
-      if (!insertBatch(
-              groups, numGroups, hashes, initNormalizedKeys || i != 0)) {
+      bool inserted;
+      {
+        // Time only the reinsertion. A failed insert falls back to kHash mode
+        // below, which rehashes again and times itself.
+        MicrosecondTimer timer(&rehashTimeUs_);
+        numGroups = (i == 0 ? this : otherTables_[i - 1].get())
+                        ->rows()
+                        ->listRows(&iterator, kHashBatchSize, groups);
+        inserted = insertBatch(
+            groups, numGroups, hashes, initNormalizedKeys || i != 0);
+      }
+      if (!inserted) {
         VELOX_CHECK_NE(hashMode_, HashMode::kHash);
         setHashMode(HashMode::kHash, 0);
         return;
@@ -1228,7 +1597,11 @@ void HashTable<ignoreNullKeys>::rehash(bool initNormalizedKeys) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   VELOX_CHECK_NE(hashMode_, HashMode::kHash);
+  if (mode != HashMode::kNormalizedKey) {
+    numFirstWordKeys_ = hashers_.size();
+  }
   if (mode == HashMode::kArray) {
+    inlineKeys_ = false;
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
     rows_->pool()->allocateContiguous(numPages, tableAllocation_);
@@ -1359,6 +1732,9 @@ uint64_t HashTable<ignoreNullKeys>::setHasherMode(
   uint64_t multiplier = 1;
   // A group by leaves 50% space for values not yet seen.
   for (int i = 0; i < hashers.size(); ++i) {
+    if (i == numFirstWordKeys_) {
+      multiplier = 1;
+    }
     multiplier = useRange.size() > i && useRange[i]
         ? hashers[i]->enableValueRange(multiplier, reservePct())
         : hashers[i]->enableValueIds(multiplier, reservePct());
@@ -1374,6 +1750,38 @@ void HashTable<ignoreNullKeys>::clearUseRange(std::vector<bool>& useRange) {
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::splitWideNormalizedKey(
+    const std::vector<uint64_t>& rangeSizes,
+    const std::vector<uint64_t>& distinctSizes,
+    const std::vector<bool>& useRange) {
+  const auto keySize = [&](int32_t i) {
+    return useRange[i] ? rangeSizes[i] : distinctSizes[i];
+  };
+  const int32_t numKeys = hashers_.size();
+  uint64_t firstWord = 1;
+  int32_t split = 0;
+  for (; split < numKeys; ++split) {
+    const auto product = safeMul(firstWord, keySize(split));
+    if (product == VectorHasher::kRangeTooLarge) {
+      break;
+    }
+    firstWord = product;
+  }
+  if (split == 0 || split == numKeys) {
+    return false;
+  }
+  uint64_t secondWord = 1;
+  for (auto i = split; i < numKeys; ++i) {
+    secondWord = safeMul(secondWord, keySize(i));
+    if (secondWord == VectorHasher::kRangeTooLarge) {
+      return false;
+    }
+  }
+  numFirstWordKeys_ = split;
+  return true;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::decideHashMode(
     int32_t numNew,
@@ -1391,6 +1799,7 @@ void HashTable<ignoreNullKeys>::decideHashMode(
     return;
   }
   disableRangeArrayHash_ |= disableRangeArrayHash;
+  numFirstWordKeys_ = hashers_.size();
   if (numDistinct_ && !isJoinBuild_) {
     if (!analyze()) {
       setHashMode(HashMode::kHash, numNew);
@@ -1449,6 +1858,13 @@ void HashTable<ignoreNullKeys>::decideHashMode(
   }
   if (distinctsWithReserve == VectorHasher::kRangeTooLarge &&
       rangesWithReserve == VectorHasher::kRangeTooLarge) {
+    // The key concatenation may still fit in two words.
+    if (enableWideNormalizedKeys_ &&
+        splitWideNormalizedKey(rangeSizes, distinctSizes, useRange)) {
+      setHasherMode(hashers_, useRange, rangeSizes, distinctSizes);
+      setHashMode(HashMode::kNormalizedKey, numNew);
+      return;
+    }
     setHashMode(HashMode::kHash, numNew);
     return;
   }
@@ -1500,7 +1916,8 @@ std::string HashTable<ignoreNullKeys>::toString() {
     for (int64_t bucketOffset = 0; bucketOffset < sizeMask_;
          bucketOffset += kBucketSize) {
       auto tags = loadTags(bucketOffset);
-      auto filled = simd::toBitMask(tags != TagVector::broadcast(0));
+      auto filled = simd::toBitMask(tags != TagVector::broadcast(0)) &
+          bits::lowMask(slotsPerBucket());
       ++numGroups[__builtin_popcount(filled)];
       occupied += filled;
     }
@@ -1786,6 +2203,12 @@ void HashTable<ignoreNullKeys>::erase(folly::Range<char**> rows) {
   raw_vector<uint64_t> hashes;
   hashes.resize(numRows);
 
+  if (hashMode_ == HashMode::kNormalizedKey && hasWideNormalizedKeys()) {
+    // The hashes are made from the normalized keys stored below the rows.
+    hashRows(rows, false, hashes);
+    eraseWithHashes(rows, hashes.data());
+    return;
+  }
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
     if (hashMode_ == HashMode::kHash) {
@@ -1817,7 +2240,7 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
       table_[hashes[i]] = nullptr;
     }
   } else {
-    if (hashMode_ == HashMode::kNormalizedKey) {
+    if (hashMode_ == HashMode::kNormalizedKey && !hasWideNormalizedKeys()) {
       for (auto i = 0; i < numRows; ++i) {
         hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
       }
@@ -1864,7 +2287,7 @@ void HashTable<ignoreNullKeys>::checkConsistency() const {
   uint64_t numTombstone = 0;
   for (auto start = 0; start < sizeMask_; start += kBucketSize) {
     auto bucket = bucketAt(start);
-    for (auto i = 0; i < sizeof(TagVector); ++i) {
+    for (auto i = 0; i < slotsPerBucket(); ++i) {
       if (bucket->tagAt(i) == ProbeState::kTombstoneTag) {
         ++numTombstone;
         continue;
@@ -1909,14 +2332,13 @@ void BaseHashTable::prepareForProbe(
 
   bool rehash = false;
   const auto mode = hashMode();
-  for (auto i = 0; i < hashers.size(); ++i) {
-    auto& hasher = hashers[i];
-    if (mode != BaseHashTable::HashMode::kHash) {
+  if (mode == BaseHashTable::HashMode::kHash) {
+    VectorHasher::hash(hashers, rows, lookup.hashes);
+  } else {
+    for (auto& hasher : hashers) {
       if (!hasher->computeValueIds(rows, lookup.hashes)) {
         rehash = true;
       }
-    } else {
-      hasher->hash(rows, i > 0, lookup.hashes);
     }
   }
 
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+#include <folly/synchronization/MicroSpinLock.h>
+
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/Operator.h"
@@ -43,8 +46,15 @@ struct HashLookup {
   raw_vector<uint64_t> hashes;
   // If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   raw_vector<uint64_t> normalizedKeys;
+  // Second word of two word normalized keys. These are the concatenated
+  // valueIds of the keys from BaseHashTable::numFirstWordKeys() on. 1:1 with
+  // 'hashes'.
+  raw_vector<uint64_t> secondNormalizedKeys;
   // Hit for each row of input corresponding group row or join row.
   raw_vector<char*> hits;
+  // Permutation of 'rows' ordered by hash table partition. Used by joinProbe()
+  // on large tables.
+  raw_vector<vector_size_t> partitionedRows;
   // Indices of newly inserted rows (not found during probe).
   std::vector<vector_size_t> newGroups;
 };
@@ -52,6 +62,8 @@ struct HashLookup {
 struct HashTableStats {
   int64_t capacity{0};
   int64_t numRehashes{0};
+  /// Time spent reinserting the rows into the table on rehash.
+  uint64_t rehashTimeUs{0};
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
@@ -183,6 +195,50 @@ class BaseHashTable {
       std::vector<std::unique_ptr<BaseHashTable>> tables,
       folly::Executor* executor = nullptr) = 0;
 
+  /// Sets the size in bytes of the bucket array at and above which
+  /// joinProbe() groups the probe rows of a batch by the region of the table
+  /// they hit, so that consecutive probes stay within a cache sized part of
+  /// the table. 0 disables this.
+  void setMinTableBytesForPartitionedProbe(uint64_t bytes) {
+    minTableBytesForPartitionedProbe_ = bytes;
+  }
+
+  /// If true, prepareJoinTable() inserts the rows of all the build side tables
+  /// into the join table concurrently, one thread per table, instead of first
+  /// partitioning the rows by table range. Applies wherever the parallel join
+  /// build applies.
+  void setConcurrentJoinBuild(bool concurrent) {
+    concurrentJoinBuild_ = concurrent;
+  }
+
+  /// Sets the hashes of the join keys that have many build side rows, as
+  /// estimated by HashBuild. The hash of a key is the VectorHasher::hash() of
+  /// its columns mixed in key order, which is independent of the hash mode.
+  void setHeavyHitterHashes(folly::F14FastSet<uint64_t> hashes) {
+    heavyHitterHashes_ = std::move(hashes);
+  }
+
+  const folly::F14FastSet<uint64_t>& heavyHitterHashes() const {
+    return heavyHitterHashes_;
+  }
+
+  /// If true, a table in kNormalizedKey mode with one word normalized keys
+  /// stores the normalized key of each entry in the bucket next to the row
+  /// pointer. A probe then compares keys without accessing the row. Each
+  /// bucket holds 8 instead of 16 entries, so that the bucket array is twice
+  /// as large. Must be set before rows are inserted.
+  void setInlineKeys(bool enable) {
+    inlineKeysEnabled_ = enable;
+  }
+
+  /// Sets the expected number of distinct entries. The first allocation of
+  /// the table in kHash or kNormalizedKey mode is sized to hold this many
+  /// entries without rehashing. Has no effect on kArray mode tables, whose
+  /// size follows from the key value ranges.
+  void setExpectedNumDistinct(uint64_t numDistinct) {
+    expectedNumDistinct_ = numDistinct;
+  }
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -219,6 +275,12 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// Returns the number of leading keys whose value ids are concatenated into
+  /// the first word of the normalized key. The value ids of the other keys go
+  /// into HashLookup::secondNormalizedKeys. This is the number of keys unless
+  /// the table is in kNormalizedKey mode with two word normalized keys.
+  virtual int32_t numFirstWordKeys() const = 0;
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode() {
     setHashMode(HashMode::kHash, 0);
@@ -307,6 +369,21 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // See setMinTableBytesForPartitionedProbe().
+  uint64_t minTableBytesForPartitionedProbe_{0};
+
+  // See setConcurrentJoinBuild().
+  bool concurrentJoinBuild_{false};
+
+  // See setHeavyHitterHashes().
+  folly::F14FastSet<uint64_t> heavyHitterHashes_;
+
+  // See setInlineKeys().
+  bool inlineKeysEnabled_{false};
+
+  // See setExpectedNumDistinct().
+  uint64_t expectedNumDistinct_{0};
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -328,6 +405,8 @@ class HashTable : public BaseHashTable {
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
   // that matches join condition for right and full outer joins.
+  // 'enableWideNormalizedKeys' allows a join build side with multiple keys to
+  // use two word normalized keys if the key value ids do not fit in one word.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -337,7 +416,8 @@ class HashTable : public BaseHashTable {
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
       memory::MemoryPool* pool,
-      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr);
+      const std::shared_ptr<velox::HashStringAllocator>& stringArena = nullptr,
+      bool enableWideNormalizedKeys = false);
 
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
@@ -363,7 +443,8 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool enableWideNormalizedKeys = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -372,7 +453,9 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        nullptr, // stringArena
+        enableWideNormalizedKeys);
   }
 
   void groupProbe(HashLookup& lookup) override;
@@ -430,7 +513,7 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_, numRehashes_, rehashTimeUs_, numDistinct_, numTombstones_};
   }
 
   bool hasDuplicateKeys() const override {
@@ -441,6 +524,10 @@ class HashTable : public BaseHashTable {
     return hashMode_;
   }
 
+  int32_t numFirstWordKeys() const override {
+    return numFirstWordKeys_;
+  }
+
   void decideHashMode(int32_t numNew, bool disableRangeArrayHash = false)
       override;
 
@@ -465,7 +552,7 @@ class HashTable : public BaseHashTable {
       // If rehashed, the table adds size_ entries (i.e. doubles),
       // adding one pointer worth for each new position.  (16 tags, 16 6 byte
       // pointers, 16 bytes padding).
-      return capacity_ * tableSlotSize();
+      return capacity_ * bucketSlotSize();
     }
     return 0;
   }
@@ -477,7 +564,8 @@ class HashTable : public BaseHashTable {
     return bits::roundUp(
         std::max(
             maxByteSizeInArrayMode,
-            newHashTableEntries(numDistinct, 0) * tableSlotSize()),
+            newHashTableEntries(numDistinct, 0) * tableSlotSize() *
+                (inlineKeysEnabled_ ? 2 : 1)),
         memory::AllocationTraits::kPageSize);
   }
 
@@ -516,7 +604,12 @@ class HashTable : public BaseHashTable {
   // 16 slots. Each slot has a 1 byte tag (a field of hash number) and a 48 bit
   // pointer. All the tags are in a 16 byte SIMD word followed by the 6 byte
   // pointers. There are 16 bytes of padding at the end to make the bucket
-  // occupy exactly two (64 bytes) cache lines.
+  // occupy exactly two (64 bytes) cache lines. The last byte of the padding is
+  // a lock for concurrent join build. A zeroed bucket is unlocked.
+  //
+  // With inline keys, only the first 8 slots are used. The tags and pointers
+  // of these are in the first cache line and their normalized keys fill the
+  // second one. The tags of the other slots are kUnusedTag.
   class Bucket {
    public:
     Bucket() {
@@ -543,19 +636,58 @@ class HashTable : public BaseHashTable {
       *slot = (*slot & ~kPointerMask) | reinterpret_cast<uintptr_t>(pointer);
     }
 
+    folly::MicroSpinLock& buildLock() {
+      return buildLock_;
+    }
+
+    normalized_key_t inlineKeyAt(int32_t slotIndex) {
+      return inlineKeys()[slotIndex];
+    }
+
+    void setInlineKey(int32_t slotIndex, normalized_key_t key) {
+      inlineKeys()[slotIndex] = key;
+    }
+
+    static constexpr int32_t kNumInlineKeySlots = 8;
+
    private:
     static constexpr uint8_t kPointerSignificantBits = 48;
     static constexpr uint64_t kPointerMask =
         bits::lowMask(kPointerSignificantBits);
     static constexpr int32_t kPointerSize = kPointerSignificantBits / 8;
+    static constexpr int32_t kInlineKeysOffset = 64;
+
+    normalized_key_t* inlineKeys() {
+      return reinterpret_cast<normalized_key_t*>(
+          reinterpret_cast<char*>(this) + kInlineKeysOffset);
+    }
 
     TagVector tags_;
     char pointers_[sizeof(TagVector) * kPointerSize];
-    char padding_[16];
+    // setPointer() of the last slot writes over the first 2 bytes of padding.
+    char padding_[15];
+    folly::MicroSpinLock buildLock_;
   };
 
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // Tag of the slots of a bucket that are not used with inline keys. Counts as
+  // occupied and never matches a hashTag().
+  static constexpr uint8_t kUnusedTag = 0x01;
+
+  // Returns the bytes of bucket array per slot.
+  size_t bucketSlotSize() const {
+    return inlineKeys_ ? 2 * tableSlotSize() : tableSlotSize();
+  }
+
+  // Returns the number of slots used per bucket.
+  int32_t slotsPerBucket() const {
+    return inlineKeys_ ? Bucket::kNumInlineKeySlots : sizeof(TagVector);
+  }
+
+  // Sets the tags of the slots not used with inline keys to kUnusedTag.
+  void initializeUnusedTags();
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -608,7 +740,8 @@ class HashTable : public BaseHashTable {
       std::vector<bool>& useRange);
 
   // Sets value ranges or distinct value ids mode for VectorHashers in a kArray
-  // or kNormalizedKeys mode table.
+  // or kNormalizedKeys mode table. The multiplier starts over at the first key
+  // of the second word of a two word normalized key.
   uint64_t setHasherMode(
       const std::vector<std::unique_ptr<VectorHasher>>& hashers,
       const std::vector<bool>& useRange,
@@ -619,6 +752,20 @@ class HashTable : public BaseHashTable {
   // VectorHashers.
   void clearUseRange(std::vector<bool>& useRange);
 
+  // Splits the keys into a prefix and a suffix whose value ids each fit in one
+  // word, using ranges where 'useRange' is set and distinct values elsewhere.
+  // Sets 'numFirstWordKeys_' to the size of the prefix and returns true on
+  // success. Returns false if the keys do not fit in two words.
+  bool splitWideNormalizedKey(
+      const std::vector<uint64_t>& rangeSizes,
+      const std::vector<uint64_t>& distinctSizes,
+      const std::vector<bool>& useRange);
+
+  // True if the normalized keys have two words.
+  bool hasWideNormalizedKeys() const {
+    return numFirstWordKeys_ < hashers_.size();
+  }
+
   void rehash(bool initNormalizedKeys);
   void storeKeys(HashLookup& lookup, vector_size_t row);
 
@@ -685,6 +832,23 @@ class HashTable : public BaseHashTable {
   // else.
   void parallelJoinBuild();
 
+  // Inserts the rows of 'this' and 'otherTables_' into 'this' with one thread
+  // per table using 'buildExecutor_'. Threads take the lock of each bucket
+  // they visit, so that a key is inserted in the first bucket with a free
+  // slot on its probe sequence or added to the rows of an existing entry.
+  void concurrentJoinBuild();
+
+  // Inserts the rows of 'subtable' on behalf of concurrentJoinBuild().
+  void insertRowsConcurrently(HashTable<ignoreNullKeys>& subtable);
+
+  // Inserts 'inserted' with 'hash' into the table while other threads may be
+  // inserting.
+  void insertRowConcurrently(char* inserted, uint64_t hash);
+
+  // Returns true if the keys of the join build side rows 'group' and 'inserted'
+  // are equal. Uses the normalized keys in kNormalizedKey mode.
+  bool joinRowKeysEqual(char* group, char* inserted);
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
   // The rows that would have gone past the end of the partition are returned in
   // 'overflow'.
@@ -717,18 +881,41 @@ class HashTable : public BaseHashTable {
 
   bool compareKeys(const char* group, const char* inserted);
 
-  template <bool isJoin, bool isNormalizedKey = false>
+  // 'inlineKeys' is true if 'isNormalizedKey' is true and the keys are
+  // compared with the inline keys of the table.
+  template <bool isJoin, bool isNormalizedKey = false, bool inlineKeys = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
   // Shortcut path for group by with normalized keys.
+  template <bool inlineKeys>
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
+  // Shortcut for probe with inline normalized keys.
+  void joinInlineKeyProbe(HashLookup& lookup);
+
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
-  // Shortcut for probe with normalized keys.
+  // Shortcut for probe with normalized keys. 'wideKeys' is true for two word
+  // normalized keys.
+  template <bool wideKeys>
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Log2 of the size in bytes of the table region probed together by a
+  // partitioned probe. Sized to stay resident in L2 cache.
+  static constexpr int32_t kProbePartitionBits = 20;
+  // A partitioned probe has at most 2^kMaxProbePartitionBits partitions.
+  static constexpr int32_t kMaxProbePartitionBits = 8;
+  // Batches with fewer probe rows are probed in input order.
+  static constexpr int32_t kMinRowsForPartitionedProbe = 256;
+
+  // Returns the rows of 'lookup' in the order they are to be probed. These are
+  // 'lookup.rows' unless the table is large enough for a partitioned probe,
+  // in which case the rows are grouped into 'lookup.partitionedRows' by the
+  // high bits of their bucket offset. The hits are set by row number, so the
+  // order of probing does not affect the result.
+  const vector_size_t* probeRows(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -755,7 +942,8 @@ class HashTable : public BaseHashTable {
   // for array or normalized key.
   bool analyze();
   // Erases the entries of rows from the hash table and its RowContainer.
-  // 'hashes' must be computed according to 'hashMode_'.
+  // 'hashes' must be computed according to 'hashMode_'. With two word
+  // normalized keys, these are the hashes made by hashRows().
   void eraseWithHashes(folly::Range<char**> rows, uint64_t* hashes);
 
   // Returns the percentage of values to reserve for new keys in range
@@ -845,6 +1033,9 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+
+  // Time spent in rehash() reinserting rows.
+  uint64_t rehashTimeUs_{0};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
@@ -881,6 +1072,17 @@ class HashTable : public BaseHashTable {
 
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
+
+  // True if the rows have space for two word normalized keys. See
+  // 'enableWideNormalizedKeys' of the constructor.
+  bool enableWideNormalizedKeys_{false};
+
+  // See numFirstWordKeys().
+  int32_t numFirstWordKeys_;
+
+  // True if the buckets have inline keys. See setInlineKeys(). Decided when
+  // the bucket array is allocated.
+  bool inlineKeys_{false};
 };
 
 } // namespace facebook::velox::exec
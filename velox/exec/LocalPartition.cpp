@@ -29,30 +29,33 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = true;
+  // A consumer may have decreased the memory usage before 'hasPromises_' is
+  // set, in which case it does not resume the producer blocked here.
+  if (bufferedBytes_ < continueBufferSize_) {
+    hasPromises_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
-  std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  if (bufferedBytes_.fetch_sub(removed) - removed >= continueBufferSize_ ||
+      !hasPromises_) {
+    return {};
   }
-  return promises;
+
+  std::lock_guard<std::mutex> l(mutex_);
+  hasPromises_ = false;
+  return std::move(promises_);
 }
 
 void LocalExchangeQueue::addProducer() {
@@ -87,7 +90,10 @@ BlockingReason LocalExchangeQueue::enqueue(
       return true;
     }
     queue.push(std::move(input));
-    consumerPromises = std::move(consumerPromises_);
+    if (!consumerPromises_.empty()) {
+      consumerPromises.push_back(std::move(consumerPromises_.back()));
+      consumerPromises_.pop_back();
+    }
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
       blockedOnConsumer = true;
@@ -125,7 +131,6 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -142,12 +147,13 @@ BlockingReason LocalExchangeQueue::next(
     *data = queue.front();
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+  if (*data != nullptr) {
+    auto memoryPromises =
+        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
@@ -251,7 +257,8 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().createForSplitGroup(
+                    numPartitions_, ctx->splitGroupId)) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
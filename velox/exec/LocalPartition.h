@@ -21,25 +21,37 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is updated without taking 'mutex_' unless a
+/// producer needs to block or blocked producers need to be resumed.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
-      : maxBufferSize_{maxBufferSize} {}
+      : maxBufferSize_{maxBufferSize},
+        continueBufferSize_{
+            std::max<int64_t>(1, maxBufferSize * kContinuePct / 100)} {}
 
   /// Returns 'true' if memory limit is reached or exceeded and sets future that
-  /// will be complete when memory usage is update to be below the limit.
+  /// will be complete when memory usage goes below 'continueBufferSize_'.
   bool increaseMemoryUsage(ContinueFuture* future, int64_t added);
 
   /// Decreases the memory usage by 'removed' bytes. If the memory usage goes
-  /// below the limit after the decrease, the function returns 'promises_' to
-  /// caller to fulfill.
+  /// below 'continueBufferSize_' after the decrease, the function returns
+  /// 'promises_' to caller to fulfill.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
  private:
+  // Percentage of 'maxBufferSize_' below which blocked producers are resumed.
+  // Resuming them below the limit instead of at the limit lets the consumers
+  // make room for more than one batch before waking up the producers.
+  static constexpr int32_t kContinuePct = 90;
+
   const int64_t maxBufferSize_;
+  const int64_t continueBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' is not empty. Lets decreaseMemoryUsage() skip
+  // 'mutex_' if no producer is blocked.
+  std::atomic<bool> hasPromises_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -96,7 +108,8 @@ class LocalExchangeQueue {
   folly::Synchronized<std::queue<RowVectorPtr>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
-  // and pendingProducers_ is zero.
+  // and pendingProducers_ is zero. Each enqueue() satisfies only one of them
+  // as only one consumer can fetch the enqueued data.
   std::vector<ContinuePromise> consumerPromises_;
   int pendingProducers_{0};
   bool noMoreProducers_{false};
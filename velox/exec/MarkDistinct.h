@@ -13,14 +13,20 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
 
+/// Marks the first row of each distinct value of the distinct keys. Spills
+/// under memory pressure like RowNumber: the distinct keys seen so far are
+/// spilled by hash partition, and the input received afterwards is spilled to
+/// the matching partitions. After all the input is received, the partitions
+/// are restored one at a time, so the input rows of spilled partitions are
+/// output out of order.
 class MarkDistinct : public Operator {
  public:
   MarkDistinct(
@@ -29,7 +35,7 @@ class MarkDistinct : public Operator {
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
   bool preservesOrder() const override {
-    return true;
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -38,6 +44,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +54,61 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Probes 'input_' into 'table_' to find the first rows of new distinct
+  // values.
+  void probeInput();
+
+  void ensureInputFits(const RowVectorPtr& input);
+
+  void setupHashTableSpiller();
+
+  void setupInputSpiller();
+
+  void spill();
+
+  void spillInput(const RowVectorPtr& input, memory::MemoryPool* pool);
+
+  void restoreNextSpillPartition();
+
+  // Adds the distinct keys of 'partition' to 'table_'.
+  void restoreHashTable(SpillPartition& partition);
+
+  // Spills the distinct keys of the partition being restored after
+  // noMoreInput(). They are restored before probing the next input batch.
+  void spillRestoredHashTable();
+
+  // Hash table of the distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  RowTypePtr inputType_;
+
+  // Spiller for contents of the HashTable.
+  std::unique_ptr<Spiller> hashTableSpiller_;
+
+  SpillPartitionSet spillHashTablePartitionSet_;
+
+  // Spiller for input received after spilling has been triggered.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Used to restore previously spilled input.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Used to calculate the spill partition numbers of the inputs.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+
+  // The distinct keys of the partition being restored if they were spilled
+  // by reclaim() after noMoreInput().
+  std::unique_ptr<SpillPartition> reclaimedHashTablePartition_;
 };
 } // namespace facebook::velox::exec
@@ -60,7 +60,10 @@ void Merge::initializeTreeOfLosers() {
   sourceCursors.reserve(sources_.size());
   for (auto& source : sources_) {
     sourceCursors.push_back(std::make_unique<SourceStream>(
-        source.get(), sortingKeys_, outputBatchSize_));
+        source.get(),
+        sortingKeys_,
+        outputType_->childAt(sortingKeys_[0].first),
+        outputBatchSize_));
   }
 
   // Save the pointers to cursors before moving these into the TreeOfLosers.
@@ -154,16 +157,20 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
-    if (stream->setOutputRow(outputSize_)) {
-      // The stream is at end of input batch. Need to copy out the rows before
-      // fetching next batch in 'pop'.
-      stream->copyToOutput(output_);
+    addOutputRow(stream);
+
+    if (stream == lastStream_) {
+      // 'stream' won twice in a row and may have a run of rows that sort
+      // before the other streams. Take its rows while next() would keep
+      // returning it, comparing each to the runner-up only.
+      const auto* runnerUp = treeOfLosers_->runnerUp();
+      while (outputSize_ < outputBatchSize_ &&
+             sourceBlockingFutures_.empty() && stream->hasData() &&
+             (runnerUp == nullptr || !(*runnerUp < *stream))) {
+        addOutputRow(stream);
+      }
     }
-
-    ++outputSize_;
-
-    // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+    lastStream_ = stream;
 
     if (outputSize_ == outputBatchSize_) {
       // Copy out data from all sources.
@@ -181,15 +188,91 @@ RowVectorPtr Merge::getOutput() {
   }
 }
 
+void Merge::addOutputRow(SourceStream* stream) {
+  if (stream->setOutputRow(outputSize_)) {
+    // The stream is at end of input batch. Need to copy out the rows before
+    // fetching next batch in 'pop'.
+    stream->copyToOutput(output_);
+  }
+
+  ++outputSize_;
+
+  // Advance the stream.
+  stream->pop(sourceBlockingFutures_);
+}
+
 void Merge::close() {
   for (auto& source : sources_) {
     source->close();
   }
 }
 
+// static
+bool SourceStream::isCachedKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void SourceStream::cacheHeadKey() {
+  if (!firstKeyKind_.has_value()) {
+    return;
+  }
+  const auto* key = keyColumns_[0];
+  const auto& compareFlags = sortingKeys_[0].second;
+  if (key->isNullAt(currentSourceRow_)) {
+    headKey_ = 0;
+    headKeyRank_ = compareFlags.nullsFirst ? 0 : 2;
+    return;
+  }
+  switch (firstKeyKind_.value()) {
+    case TypeKind::BOOLEAN:
+      headKey_ = key->asUnchecked<SimpleVector<bool>>()->valueAt(
+          currentSourceRow_);
+      break;
+    case TypeKind::TINYINT:
+      headKey_ = key->asUnchecked<SimpleVector<int8_t>>()->valueAt(
+          currentSourceRow_);
+      break;
+    case TypeKind::SMALLINT:
+      headKey_ = key->asUnchecked<SimpleVector<int16_t>>()->valueAt(
+          currentSourceRow_);
+      break;
+    case TypeKind::INTEGER:
+      headKey_ = key->asUnchecked<SimpleVector<int32_t>>()->valueAt(
+          currentSourceRow_);
+      break;
+    case TypeKind::BIGINT:
+      headKey_ = key->asUnchecked<SimpleVector<int64_t>>()->valueAt(
+          currentSourceRow_);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  // ~x reverses the order of all int64_t values without overflow.
+  if (!compareFlags.ascending) {
+    headKey_ = ~headKey_;
+  }
+  headKeyRank_ = 1;
+}
+
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
-  for (auto i = 0; i < sortingKeys_.size(); ++i) {
+  int32_t firstKey = 0;
+  if (firstKeyKind_.has_value()) {
+    if (const auto result = compareHeadKeys(otherCursor)) {
+      return result < 0;
+    }
+    firstKey = 1;
+  }
+  for (auto i = firstKey; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
         compareFlags.nullHandlingMode == CompareFlags::NullHandlingMode::NoStop,
@@ -215,6 +298,7 @@ bool SourceStream::pop(std::vector<ContinueFuture>& futures) {
     return fetchMoreData(futures);
   }
 
+  cacheHeadKey();
   return false;
 }
 
@@ -264,6 +348,7 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    cacheHeadKey();
   }
   return false;
 }
@@ -338,6 +423,8 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
                   maxMergeExchangeBufferSize / remoteSourceTaskIds_.size(),
                   MergeSource::kMaxQueuedBytesLowerLimit),
               MergeSource::kMaxQueuedBytesUpperLimit);
+          availableQueuedBytes_ = maxMergeExchangeBufferSize -
+              maxQueuedBytesPerSource * remoteSourceTaskIds_.size();
           for (uint32_t remoteSourceIndex = 0;
                remoteSourceIndex < remoteSourceTaskIds_.size();
                ++remoteSourceIndex) {
@@ -364,4 +451,20 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   }
 }
 
+int64_t MergeExchange::growSourceQueue(int64_t maxQueuedBytes) {
+  const auto newMaxQueuedBytes = std::min<int64_t>(
+      maxQueuedBytes * 2, MergeSource::kMaxQueuedBytesUpperLimit);
+  const auto extraBytes = newMaxQueuedBytes - maxQueuedBytes;
+  if (extraBytes <= 0 || extraBytes > availableQueuedBytes_) {
+    return maxQueuedBytes;
+  }
+  availableQueuedBytes_ -= extraBytes;
+  addRuntimeStat("sourceQueueGrowths", RuntimeCounter(1));
+  return newMaxQueuedBytes;
+}
+
+void MergeExchange::releaseSourceQueue(int64_t maxQueuedBytes) {
+  availableQueuedBytes_ += maxQueuedBytes;
+}
+
 } // namespace facebook::velox::exec
@@ -58,6 +58,9 @@ class Merge : public SourceOperator {
  private:
   void initializeTreeOfLosers();
 
+  /// Adds the current row of 'stream' to 'output_' and advances 'stream'.
+  void addOutputRow(SourceStream* stream);
+
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
@@ -70,6 +73,9 @@ class Merge : public SourceOperator {
   /// Used to merge data from two or more sources.
   std::unique_ptr<TreeOfLosers<SourceStream>> treeOfLosers_;
 
+  /// The stream returned by the previous 'treeOfLosers_->next()'.
+  SourceStream* lastStream_{nullptr};
+
   RowVectorPtr output_;
 
   /// Number of rows accumulated in 'output_' so far.
@@ -84,12 +90,17 @@ class Merge : public SourceOperator {
 
 class SourceStream final : public MergeStream {
  public:
+  /// 'firstKeyType' is the type of the first sorting key.
   SourceStream(
       MergeSource* source,
       const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+      const TypePtr& firstKeyType,
       uint32_t outputBatchSize)
       : source_{source},
         sortingKeys_{sortingKeys},
+        firstKeyKind_{
+            isCachedKeyType(firstKeyType) ? std::optional(firstKeyType->kind())
+                                          : std::nullopt},
         outputRows_(outputBatchSize, false),
         sourceRows_(outputBatchSize) {
     keyColumns_.reserve(sortingKeys.size());
@@ -134,12 +145,39 @@ class SourceStream final : public MergeStream {
   void copyToOutput(RowVectorPtr& output);
 
  private:
+  /// Returns true if a first sorting key of 'type' is cached in 'headKey_'.
+  static bool isCachedKeyType(const TypePtr& type);
+
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  /// Sets 'headKey_' and 'headKeyRank_' from the current row.
+  void cacheHeadKey();
+
+  /// Compares the cached first sorting keys of the current rows of 'this' and
+  /// 'other' without branching on the key values.
+  int32_t compareHeadKeys(const SourceStream& other) const {
+    const int32_t valueResult =
+        (headKey_ > other.headKey_) - (headKey_ < other.headKey_);
+    return (headKeyRank_ - other.headKeyRank_) * 4 + valueResult;
+  }
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
 
+  /// Kind of the first sorting key if it is cached in 'headKey_'. Comparing
+  /// the cached key saves a virtual call and a decoding per comparison, of
+  /// which there are as many per row as levels in the tree of losers.
+  const std::optional<TypeKind> firstKeyKind_;
+
+  /// Value of the first sorting key of the current row, complemented if
+  /// descending and zero if null.
+  int64_t headKey_{0};
+
+  /// 0 if the first sorting key of the current row is a null that sorts first,
+  /// 2 if it is a null that sorts last, 1 otherwise.
+  int32_t headKeyRank_{1};
+
   /// Ordered source rows.
   RowVectorPtr data_;
 
@@ -191,6 +229,17 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  /// Called by a source that ran out of data after having received some and
+  /// whose queue is limited to 'maxQueuedBytes'. Returns the new limit. The
+  /// limit doubles up to MergeSource::kMaxQueuedBytesUpperLimit while the total
+  /// over all sources stays within QueryConfig::maxMergeExchangeBufferSize().
+  /// Sources that are consumed faster than their producers respond so get more
+  /// of the buffer and stall the merge less often.
+  int64_t growSourceQueue(int64_t maxQueuedBytes);
+
+  /// Called by a source that is at end to return the buffer of its queue.
+  void releaseSourceQueue(int64_t maxQueuedBytes);
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
@@ -198,6 +247,9 @@ class MergeExchange : public Merge {
   bool noMoreSplits_ = false;
   // Task Ids from all the splits we took to process so far.
   std::vector<std::string> remoteSourceTaskIds_;
+  // Part of the merge exchange buffer not given to the queues of the sources.
+  // Negative if the sources got more than the buffer at their minimum size.
+  int64_t availableQueuedBytes_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -31,12 +31,18 @@ MergeJoin::MergeJoin(
           joinNode->id(),
           "MergeJoin"),
       outputBatchSize_{outputBatchRows()},
+      dictionaryOutput_{
+          driverCtx->queryConfig().mergeJoinDictionaryOutputEnabled()},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
       joinNode_(joinNode) {
   VELOX_USER_CHECK(
-      joinNode_->isInnerJoin() || joinNode_->isLeftJoin(),
-      "Merge join supports only inner and left joins. Other join types are not supported yet.");
+      joinNode_->isInnerJoin() || joinNode_->isLeftJoin() ||
+          joinNode_->isRightJoin() || joinNode_->isFullJoin(),
+      "Merge join supports only inner, left, right and full joins. Other join types are not supported yet.");
+  VELOX_USER_CHECK(
+      !joinNode_->isFullJoin() || joinNode_->filter() == nullptr,
+      "Merge join does not support full joins with a filter yet.");
 }
 
 void MergeJoin::initialize() {
@@ -75,8 +81,8 @@ void MergeJoin::initialize() {
   if (joinNode_->filter()) {
     initializeFilter(joinNode_->filter(), leftType, rightType);
 
-    if (joinNode_->isLeftJoin()) {
-      leftJoinTracker_ = LeftJoinTracker(outputBatchSize_, pool());
+    if (joinNode_->isLeftJoin() || joinNode_->isRightJoin()) {
+      joinTracker_ = JoinTracker(outputBatchSize_, pool());
     }
   }
   joinNode_.reset();
@@ -167,8 +173,8 @@ void MergeJoin::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   index_ = 0;
 
-  if (leftJoinTracker_) {
-    leftJoinTracker_->resetLastVector();
+  if (joinTracker_ && isLeftJoin(joinType_)) {
+    joinTracker_->resetLastVector();
   }
 }
 
@@ -191,6 +197,23 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+int32_t MergeJoin::compare() const {
+  if (needsRightMisses()) {
+    for (auto key : leftKeys_) {
+      if (input_->childAt(key)->isNullAt(index_)) {
+        return -1;
+      }
+    }
+    for (auto key : rightKeys_) {
+      if (rightInput_->childAt(key)->isNullAt(rightIndex_)) {
+        return 1;
+      }
+    }
+  }
+  return compare(
+      leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -253,9 +276,27 @@ void MergeJoin::addOutputRowForLeftJoin(
     target->setNull(outputSize_, true);
   }
 
-  if (leftJoinTracker_) {
+  if (joinTracker_) {
     // Record left-side row with no match on the right side.
-    leftJoinTracker_->addMiss(outputSize_);
+    joinTracker_->addMiss(outputSize_);
+  }
+
+  ++outputSize_;
+}
+
+void MergeJoin::addOutputRowForRightJoin(
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
+
+  for (const auto& projection : leftProjections_) {
+    const auto& target = output_->childAt(projection.outputChannel);
+    target->setNull(outputSize_, true);
+  }
+
+  if (joinTracker_) {
+    // Record right-side row with no match on the left side.
+    joinTracker_->addMiss(outputSize_);
   }
 
   ++outputSize_;
@@ -273,9 +314,13 @@ void MergeJoin::addOutputRow(
     copyRow(left, leftIndex, filterInput_, outputSize_, filterLeftInputs_);
     copyRow(right, rightIndex, filterInput_, outputSize_, filterRightInputs_);
 
-    if (leftJoinTracker_) {
-      // Record left-side row with a match on the right-side.
-      leftJoinTracker_->addMatch(left, leftIndex, outputSize_);
+    if (joinTracker_) {
+      // Record tracked-side row with a match on the other side.
+      if (isRightJoin(joinType_)) {
+        joinTracker_->addMatch(right, rightIndex, outputSize_);
+      } else {
+        joinTracker_->addMatch(left, leftIndex, outputSize_);
+      }
     }
   }
 
@@ -284,6 +329,11 @@ void MergeJoin::addOutputRow(
 
 void MergeJoin::prepareOutput() {
   if (output_ == nullptr) {
+    if (dictionaryFilterInput_) {
+      filterInput_ = nullptr;
+      dictionaryFilterInput_ = false;
+    }
+
     std::vector<VectorPtr> localColumns(outputType_->size());
     for (auto i = 0; i < outputType_->size(); ++i) {
       localColumns[i] = BaseVector::create(
@@ -347,49 +397,70 @@ void MergeJoin::prepareOutput() {
 }
 
 bool MergeJoin::addToOutput() {
+  auto& outer = rightSideOuter() ? rightMatch_.value() : leftMatch_.value();
+  auto& inner = rightSideOuter() ? leftMatch_.value() : rightMatch_.value();
+
+  if (dictionaryOutput_ && !joinTracker_ &&
+      (output_ == nullptr || outputSize_ == 0)) {
+    if (addDictionaryOutput(outer, inner)) {
+      return true;
+    }
+  }
+
   prepareOutput();
 
-  size_t firstLeftBatch;
-  vector_size_t leftStartIndex;
-  if (leftMatch_->cursor) {
-    firstLeftBatch = leftMatch_->cursor->batchIndex;
-    leftStartIndex = leftMatch_->cursor->index;
+  auto addRow = [&](const RowVectorPtr& outerInput,
+                    vector_size_t outerIndex,
+                    const RowVectorPtr& innerInput,
+                    vector_size_t innerIndex) {
+    if (rightSideOuter()) {
+      addOutputRow(innerInput, innerIndex, outerInput, outerIndex);
+    } else {
+      addOutputRow(outerInput, outerIndex, innerInput, innerIndex);
+    }
+  };
+
+  size_t firstOuterBatch;
+  vector_size_t outerStartIndex;
+  if (outer.cursor) {
+    firstOuterBatch = outer.cursor->batchIndex;
+    outerStartIndex = outer.cursor->index;
   } else {
-    firstLeftBatch = 0;
-    leftStartIndex = leftMatch_->startIndex;
+    firstOuterBatch = 0;
+    outerStartIndex = outer.startIndex;
   }
 
-  size_t numLefts = leftMatch_->inputs.size();
-  for (size_t l = firstLeftBatch; l < numLefts; ++l) {
-    auto left = leftMatch_->inputs[l];
-    auto leftStart = l == firstLeftBatch ? leftStartIndex : 0;
-    auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+  size_t numOuters = outer.inputs.size();
+  for (size_t l = firstOuterBatch; l < numOuters; ++l) {
+    auto outerInput = outer.inputs[l];
+    auto outerStart = l == firstOuterBatch ? outerStartIndex : 0;
+    auto outerEnd = l == numOuters - 1 ? outer.endIndex : outerInput->size();
 
-    for (auto i = leftStart; i < leftEnd; ++i) {
-      auto firstRightBatch =
-          (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
-          ? rightMatch_->cursor->batchIndex
+    for (auto i = outerStart; i < outerEnd; ++i) {
+      auto firstInnerBatch =
+          (l == firstOuterBatch && i == outerStart && inner.cursor)
+          ? inner.cursor->batchIndex
           : 0;
 
-      auto rightStartIndex =
-          (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
-          ? rightMatch_->cursor->index
-          : rightMatch_->startIndex;
+      auto innerStartIndex =
+          (l == firstOuterBatch && i == outerStart && inner.cursor)
+          ? inner.cursor->index
+          : inner.startIndex;
 
-      auto numRights = rightMatch_->inputs.size();
-      for (size_t r = firstRightBatch; r < numRights; ++r) {
-        auto right = rightMatch_->inputs[r];
-        auto rightStart = r == firstRightBatch ? rightStartIndex : 0;
-        auto rightEnd =
-            r == numRights - 1 ? rightMatch_->endIndex : right->size();
+      auto numInners = inner.inputs.size();
+      for (size_t r = firstInnerBatch; r < numInners; ++r) {
+        auto innerInput = inner.inputs[r];
+        auto innerStart = r == firstInnerBatch ? innerStartIndex : 0;
+        auto innerEnd =
+            r == numInners - 1 ? inner.endIndex : innerInput->size();
 
-        for (auto j = rightStart; j < rightEnd; ++j) {
+        for (auto j = innerStart; j < innerEnd; ++j) {
           if (outputSize_ == outputBatchSize_) {
-            leftMatch_->setCursor(l, i);
-            rightMatch_->setCursor(r, j);
+            outer.setCursor(l, i);
+            inner.setCursor(r, j);
             return true;
           }
-          addOutputRow(left, i, right, j);
+          addRow(outerInput, i, innerInput, j);
         }
       }
     }
@@ -401,6 +472,109 @@ bool MergeJoin::addToOutput() {
   return outputSize_ == outputBatchSize_;
 }
 
+bool MergeJoin::addDictionaryOutput(Match& outer, Match& inner) {
+  size_t outerBatch{0};
+  vector_size_t outerIndex{outer.startIndex};
+  size_t innerBatch{0};
+  vector_size_t innerIndex{inner.startIndex};
+  if (outer.cursor) {
+    VELOX_CHECK(inner.cursor);
+    outerBatch = outer.cursor->batchIndex;
+    outerIndex = outer.cursor->index;
+    innerBatch = inner.cursor->batchIndex;
+    innerIndex = inner.cursor->index;
+  }
+
+  const auto numOuters = outer.inputs.size();
+  const auto numInners = inner.inputs.size();
+  const auto& outerInput = outer.inputs[outerBatch];
+  const auto& innerInput = inner.inputs[innerBatch];
+  const vector_size_t outerEnd =
+      outerBatch == numOuters - 1 ? outer.endIndex : outerInput->size();
+  const vector_size_t innerEnd =
+      innerBatch == numInners - 1 ? inner.endIndex : innerInput->size();
+
+  // The number of output rows from the current position which combine
+  // 'outerInput' with 'innerInput'. If the inner rows span multiple batches,
+  // the next outer row starts over with the first inner batch.
+  int64_t numRows = innerEnd - innerIndex;
+  if (numInners == 1) {
+    numRows += static_cast<int64_t>(outerEnd - outerIndex - 1) *
+        (innerEnd - inner.startIndex);
+  }
+  if (numRows < outputBatchSize_) {
+    return false;
+  }
+
+  const vector_size_t size = outputBatchSize_;
+  BufferPtr outerIndices = allocateIndices(size, pool());
+  BufferPtr innerIndices = allocateIndices(size, pool());
+  auto* rawOuterIndices = outerIndices->asMutable<vector_size_t>();
+  auto* rawInnerIndices = innerIndices->asMutable<vector_size_t>();
+  for (auto i = 0; i < size; ++i) {
+    rawOuterIndices[i] = outerIndex;
+    rawInnerIndices[i] = innerIndex++;
+    if (innerIndex == innerEnd && numInners == 1) {
+      innerIndex = inner.startIndex;
+      ++outerIndex;
+    }
+  }
+
+  const bool rightOuter = rightSideOuter();
+  const auto& left = rightOuter ? innerInput : outerInput;
+  const auto& right = rightOuter ? outerInput : innerInput;
+  const auto& leftIndices = rightOuter ? innerIndices : outerIndices;
+  const auto& rightIndices = rightOuter ? outerIndices : innerIndices;
+  // Lazy vectors cannot be wrapped in different dictionaries.
+  loadColumns(left, *operatorCtx_->execCtx());
+  loadColumns(right, *operatorCtx_->execCtx());
+
+  std::vector<VectorPtr> projectedChildren(outputType_->size());
+  projectChildren(
+      projectedChildren, left, leftProjections_, size, leftIndices);
+  projectChildren(
+      projectedChildren, right, rightProjections_, size, rightIndices);
+  output_ = std::make_shared<RowVector>(
+      pool(), outputType_, nullptr, size, std::move(projectedChildren));
+  outputSize_ = size;
+
+  if (filter_) {
+    std::vector<VectorPtr> inputs(filterInputType_->size());
+    for (const auto [filterInputChannel, outputChannel] :
+         filterInputToOutputChannel_) {
+      inputs[filterInputChannel] = output_->childAt(outputChannel);
+    }
+    projectChildren(inputs, left, filterLeftInputs_, size, leftIndices);
+    projectChildren(inputs, right, filterRightInputs_, size, rightIndices);
+    filterInput_ = std::make_shared<RowVector>(
+        pool(), filterInputType_, nullptr, size, std::move(inputs));
+    dictionaryFilterInput_ = true;
+  }
+
+  // Move the cursors past the produced rows.
+  if (numInners > 1 && innerIndex == innerEnd) {
+    ++innerBatch;
+    innerIndex = 0;
+    if (innerBatch == numInners) {
+      innerBatch = 0;
+      innerIndex = inner.startIndex;
+      ++outerIndex;
+    }
+  }
+  if (outerIndex == outerEnd) {
+    ++outerBatch;
+    outerIndex = 0;
+  }
+  if (outerBatch == numOuters) {
+    leftMatch_.reset();
+    rightMatch_.reset();
+  } else {
+    outer.setCursor(outerBatch, outerIndex);
+    inner.setCursor(innerBatch, innerIndex);
+  }
+  return true;
+}
+
 namespace {
 vector_size_t firstNonNull(
     const RowVectorPtr& rowVector,
@@ -423,6 +597,13 @@ vector_size_t firstNonNull(
 }
 } // namespace
 
+vector_size_t MergeJoin::firstRightRow(vector_size_t start) const {
+  if (needsRightMisses()) {
+    return start;
+  }
+  return firstNonNull(rightInput_, rightKeys_, start);
+}
+
 RowVectorPtr MergeJoin::getOutput() {
   // Make sure to have is-blocked or needs-input as true if returning null
   // output. Otherwise, Driver assumes the operator is finished.
@@ -466,7 +647,10 @@ RowVectorPtr MergeJoin::getOutput() {
         }
 
         if (rightInput_) {
-          rightIndex_ = firstNonNull(rightInput_, rightKeys_);
+          if (joinTracker_ && isRightJoin(joinType_)) {
+            joinTracker_->resetLastVector();
+          }
+          rightIndex_ = firstRightRow(0);
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
@@ -525,8 +709,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
-        rightIndex_ =
-            firstNonNull(rightInput_, rightKeys_, rightMatch_->endIndex);
+        rightIndex_ = firstRightRow(rightMatch_->endIndex);
         if (rightIndex_ == rightInput_->size()) {
           rightInput_ = nullptr;
         }
@@ -551,29 +734,61 @@ RowVectorPtr MergeJoin::doGetOutput() {
   }
 
   if (!input_ || !rightInput_) {
-    if (isLeftJoin(joinType_)) {
-      if (input_ && noMoreRightInput_) {
-        prepareOutput();
-        while (true) {
-          if (outputSize_ == outputBatchSize_) {
-            return std::move(output_);
-          }
+    if (needsLeftMisses() && input_ && noMoreRightInput_) {
+      prepareOutput();
+      while (true) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
 
-          addOutputRowForLeftJoin(input_, index_);
+        addOutputRowForLeftJoin(input_, index_);
 
-          ++index_;
-          if (index_ == input_->size()) {
-            // Ran out of rows on the left side.
-            input_ = nullptr;
-            return nullptr;
-          }
+        ++index_;
+        if (index_ == input_->size()) {
+          // Ran out of rows on the left side.
+          input_ = nullptr;
+          return nullptr;
         }
       }
+    }
+
+    if (needsRightMisses() && rightInput_ && noMoreInput_) {
+      prepareOutput();
+      while (true) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
 
+        ++rightIndex_;
+        if (rightIndex_ == rightInput_->size()) {
+          // Ran out of rows on the right side.
+          rightInput_ = nullptr;
+          return nullptr;
+        }
+      }
+    }
+
+    if (isLeftJoin(joinType_)) {
       if (noMoreInput_ && output_) {
         output_->resize(outputSize_);
         return std::move(output_);
       }
+    } else if (isRightJoin(joinType_)) {
+      // Rows on the left side can only match rows on the right side.
+      if (noMoreRightInput_ && !rightInput_) {
+        if (output_) {
+          output_->resize(outputSize_);
+          return std::move(output_);
+        }
+        input_ = nullptr;
+      }
+    } else if (isFullJoin(joinType_)) {
+      if (noMoreInput_ && noMoreRightInput_ && !rightInput_ && output_) {
+        output_->resize(outputSize_);
+        return std::move(output_);
+      }
     } else {
       if (noMoreInput_ || noMoreRightInput_) {
         if (output_) {
@@ -594,7 +809,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
   for (;;) {
     // Catch up input_ with rightInput_.
     while (compareResult < 0) {
-      if (isLeftJoin(joinType_)) {
+      if (needsLeftMisses()) {
         prepareOutput();
 
         if (outputSize_ == outputBatchSize_) {
@@ -615,7 +830,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      if (needsRightMisses()) {
+        prepareOutput();
+
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+      }
+
+      rightIndex_ = firstRightRow(rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -666,7 +891,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       index_ = endIndex;
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, endRightIndex);
+      rightIndex_ = firstRightRow(endRightIndex);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -694,8 +919,8 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
   auto rawIndices = indices->asMutable<vector_size_t>();
   vector_size_t numPassed = 0;
 
-  if (leftJoinTracker_) {
-    const auto& filterRows = leftJoinTracker_->matchingRows(numRows);
+  if (joinTracker_) {
+    const auto& filterRows = joinTracker_->matchingRows(numRows);
 
     if (!filterRows.hasSelections()) {
       // No matches in the output, no need to evaluate the filter.
@@ -704,12 +929,14 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
 
     evaluateFilter(filterRows);
 
-    // If all matches for a given left-side row fail the filter, add a row to
-    // the output with nulls for the right-side columns.
+    // If all matches for a given tracked-side row fail the filter, add a row
+    // to the output with nulls for the columns of the other side.
+    const auto& nullProjections =
+        isRightJoin(joinType_) ? leftProjections_ : rightProjections_;
     auto onMiss = [&](auto row) {
       rawIndices[numPassed++] = row;
 
-      for (auto& projection : rightProjections_) {
+      for (auto& projection : nullProjections) {
         auto target = output->childAt(projection.outputChannel);
         target->setNull(row, true);
       }
@@ -720,20 +947,20 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
         const bool passed = !decodedFilterResult_.isNullAt(i) &&
             decodedFilterResult_.valueAt<bool>(i);
 
-        leftJoinTracker_->processFilterResult(i, passed, onMiss);
+        joinTracker_->processFilterResult(i, passed, onMiss);
 
         if (passed) {
           rawIndices[numPassed++] = i;
         }
       } else {
-        // This row doesn't have a match on the right side. Keep it
+        // This row doesn't have a match on the other side. Keep it
         // unconditionally.
         rawIndices[numPassed++] = i;
       }
     }
 
     if (!leftMatch_) {
-      leftJoinTracker_->noMoreFilterResults(onMiss);
+      joinTracker_->noMoreFilterResults(onMiss);
     }
   } else {
     filterRows_.resize(numRows);
@@ -771,6 +998,12 @@ void MergeJoin::evaluateFilter(const SelectivityVector& rows) {
 }
 
 bool MergeJoin::isFinished() {
+  if (needsRightMisses()) {
+    // Right-side rows without a match are produced after the left side is
+    // done.
+    return noMoreInput_ && input_ == nullptr && noMoreRightInput_ &&
+        rightInput_ == nullptr && !leftMatch_ && output_ == nullptr;
+  }
   return noMoreInput_ && input_ == nullptr;
 }
 
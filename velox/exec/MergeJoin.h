@@ -64,10 +64,11 @@ class MergeJoin : public Operator {
       vector_size_t otherIndex);
 
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
-  int32_t compare() const {
-    return compare(
-        leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
-  }
+  // Rows with null keys never match. For right and full joins, where rows with
+  // null keys on the right side are not skipped, a left row with a null key
+  // compares less and a right row with a null key compares greater than any
+  // row on the other side.
+  int32_t compare() const;
 
   // Compare two rows on the left: index_ and index.
   int32_t compareLeft(vector_size_t index) const {
@@ -155,6 +156,11 @@ class MergeJoin : public Operator {
   /// it is null.
   void prepareOutput();
 
+  // Returns the first row at or after 'start' in 'rightInput_' to join. Rows
+  // with null keys are skipped unless the join type emits right-side rows
+  // without a match.
+  vector_size_t firstRightRow(vector_size_t start) const;
+
   // Appends a cartesian product of the current set of matching rows, leftMatch_
   // x rightMatch_, to output_. Returns true if output_ is full. Sets
   // leftMatchCursor_ and rightMatchCursor_ if output_ filled up before all the
@@ -164,13 +170,21 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Produces a full batch of output from the current set of matching rows by
+  // wrapping one left-side and one right-side batch in dictionaries, instead
+  // of copying. Applies only if the rows starting at the cursors of 'outer'
+  // and 'inner' fill a batch of output from a single batch on each side.
+  // 'outer' is the side iterated in the outer loop of addToOutput(). Returns
+  // false, without producing output, if it does not apply.
+  bool addDictionaryOutput(Match& outer, Match& inner);
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
   //
-  // TODO: Copying is inefficient especially for complex type values. Consider
-  // an optimization of using dictionary wrapping when full batch of output can
-  // be produced using single batch of input from the left side and single batch
-  // of input from the right side.
+  // NOTE: Copying is inefficient especially for complex type values.
+  // addDictionaryOutput() avoids the copies when a full batch of output can
+  // be produced using single batch of input from the left side and single
+  // batch of input from the right side.
   void addOutputRow(
       const RowVectorPtr& left,
       vector_size_t leftIndex,
@@ -184,6 +198,30 @@ class MergeJoin : public Operator {
       const RowVectorPtr& left,
       vector_size_t leftIndex);
 
+  /// Adds one row of output for a right-side row with no left-side match.
+  /// Copies values from the 'rightIndex' row of 'right' and fills in nulls
+  /// for columns that correspond to the left side.
+  void addOutputRowForRightJoin(
+      const RowVectorPtr& right,
+      vector_size_t rightIndex);
+
+  // True if the output includes left-side rows without a match.
+  bool needsLeftMisses() const {
+    return isLeftJoin(joinType_) || isFullJoin(joinType_);
+  }
+
+  // True if the output includes right-side rows without a match.
+  bool needsRightMisses() const {
+    return isRightJoin(joinType_) || isFullJoin(joinType_);
+  }
+
+  // True if addToOutput() iterates over the right-side rows of a match in the
+  // outer loop. Used for right joins with a filter, so that the output rows
+  // for one right-side row are consecutive in the output.
+  bool rightSideOuter() const {
+    return isRightJoin(joinType_) && filter_ != nullptr;
+  }
+
   /// Evaluates join filter on 'filterInput_' and returns 'output' that contains
   /// a subset of rows on which the filter passed. Returns nullptr if no rows
   /// passed the filter.
@@ -193,9 +231,11 @@ class MergeJoin : public Operator {
   /// the result using 'decodedFilterResult_'.
   void evaluateFilter(const SelectivityVector& rows);
 
-  /// As we populate the results of the left join, we track whether a given
-  /// output row is a result of a match between left and right sides or a miss.
-  /// We use LeftJoinTracker::addMatch and addMiss methods for that.
+  /// As we populate the results of the left or right join, we track whether a
+  /// given output row is a result of a match between left and right sides or
+  /// a miss. We use JoinTracker::addMatch and addMiss methods for that. The
+  /// tracked side is the left side for left joins and the right side for right
+  /// joins. The rest of this comment describes left joins.
   ///
   /// Once we have a batch of output, we evaluate the filter on a subset of rows
   /// which correspond to matches between left and right sides. There is no
@@ -207,8 +247,8 @@ class MergeJoin : public Operator {
   /// block, we keep the subset of passing rows. However, if the filter failed
   /// on all rows in such a block, we add one of these rows back and update
   /// build-side columns to null.
-  struct LeftJoinTracker {
-    LeftJoinTracker(vector_size_t numRows, memory::MemoryPool* pool)
+  struct JoinTracker {
+    JoinTracker(vector_size_t numRows, memory::MemoryPool* pool)
         : matchingRows_{numRows, false} {
       leftRowNumbers_ = AlignedBuffer::allocate<vector_size_t>(numRows, pool);
       rawLeftRowNumbers_ = leftRowNumbers_->asMutable<vector_size_t>();
@@ -336,11 +376,15 @@ class MergeJoin : public Operator {
     bool currentRowPassed_{false};
   };
 
-  std::optional<LeftJoinTracker> leftJoinTracker_{std::nullopt};
+  std::optional<JoinTracker> joinTracker_{std::nullopt};
 
   // Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
+  // If true, output batches that combine a single batch of input from each
+  // side are produced by addDictionaryOutput().
+  const bool dictionaryOutput_;
+
   // Type of join.
   const core::JoinType joinType_;
 
@@ -376,6 +420,9 @@ class MergeJoin : public Operator {
 
   // Reusable memory for filter evaluation.
   RowVectorPtr filterInput_;
+  // True if 'filterInput_' wraps input vectors in dictionaries. Such
+  // 'filterInput_' is not reused for copied output.
+  bool dictionaryFilterInput_{false};
   SelectivityVector filterRows_;
   std::vector<VectorPtr> filterResult_;
   DecodedVector decodedFilterResult_;
@@ -127,7 +127,8 @@ class MergeExchangeSource : public MergeSource {
             taskId,
             destination,
             pool,
-            maxQueuedBytes)) {
+            maxQueuedBytes)),
+        maxQueuedBytes_(maxQueuedBytes) {
     client_->addRemoteTaskId(taskId);
     client_->noMoreRemoteTasks();
   }
@@ -146,10 +147,23 @@ class MergeExchangeSource : public MergeSource {
 
       if (!currentPage_) {
         if (atEnd_) {
+          mergeExchange_->releaseSourceQueue(maxQueuedBytes_);
+          maxQueuedBytes_ = 0;
           return BlockingReason::kNotBlocked;
         }
+        if (receivedData_) {
+          // The merge waits for this source. Let more of its data be fetched
+          // ahead of consumption.
+          const auto maxQueuedBytes =
+              mergeExchange_->growSourceQueue(maxQueuedBytes_);
+          if (maxQueuedBytes != maxQueuedBytes_) {
+            maxQueuedBytes_ = maxQueuedBytes;
+            client_->setMaxQueuedBytes(maxQueuedBytes_);
+          }
+        }
         return BlockingReason::kWaitForProducer;
       }
+      receivedData_ = true;
     }
     if (!inputStream_) {
       inputStream_ = std::make_unique<ByteStream>();
@@ -192,6 +206,12 @@ class MergeExchangeSource : public MergeSource {
   std::unique_ptr<ByteStream> inputStream_;
   std::unique_ptr<SerializedPage> currentPage_;
   bool atEnd_ = false;
+  // Limit on the queued bytes of 'client_'. Given back to 'mergeExchange_' at
+  // end.
+  int64_t maxQueuedBytes_;
+  // True once a page was received. Waits before that are not stalls caused by
+  // a short queue.
+  bool receivedData_ = false;
 
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future) override {
     VELOX_FAIL();
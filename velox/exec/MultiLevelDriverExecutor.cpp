@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/MultiLevelDriverExecutor.h"
+
+#include <folly/ExceptionString.h>
+#include <folly/String.h>
+#include <glog/logging.h>
+
+#include <fstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/CpuWallTimer.h"
+
+namespace facebook::velox::exec {
+namespace {
+// Number of Task additions between the removals of the CPU times of finished
+// Tasks.
+constexpr int32_t kCleanupInterval = 1'024;
+
+// Parses a CPU list like "0-7,16-23".
+std::vector<int32_t> parseCpuList(const std::string& cpuList) {
+  std::vector<int32_t> cpus;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpuList), ranges, true);
+  for (const auto& range : ranges) {
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (folly::split('-', range, first, last)) {
+      for (auto cpu = folly::to<int32_t>(first);
+           cpu <= folly::to<int32_t>(last);
+           ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } else {
+      cpus.push_back(folly::to<int32_t>(range));
+    }
+  }
+  return cpus;
+}
+
+void pinCurrentThread(const std::vector<int32_t>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    CPU_SET(cpu, &cpuSet);
+  }
+  const auto result =
+      pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+  if (result != 0) {
+    LOG(WARNING) << "MultiLevelDriverExecutor: failed to pin a thread to "
+                 << cpus.size() << " CPUs: " << folly::errnoStr(result);
+  }
+#endif
+}
+} // namespace
+
+// static
+std::vector<std::vector<int32_t>>
+MultiLevelDriverExecutor::systemNumaNodeCpus() {
+  std::vector<std::vector<int32_t>> nodeCpus;
+  for (auto node = 0;; ++node) {
+    std::ifstream file(
+        fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+    if (!file.is_open()) {
+      break;
+    }
+    std::string cpuList;
+    std::getline(file, cpuList);
+    try {
+      nodeCpus.push_back(parseCpuList(cpuList));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "MultiLevelDriverExecutor: cannot parse the CPUs "
+                   << cpuList << " of NUMA node " << node << ": " << e.what();
+      return {};
+    }
+  }
+  return nodeCpus;
+}
+
+MultiLevelDriverExecutor::MultiLevelDriverExecutor(Options options)
+    : options_(std::move(options)), levelShares_(numLevels()) {
+  VELOX_CHECK_GT(options_.numThreads, 0);
+  VELOX_CHECK_GE(options_.levelTimeMultiplier, 1);
+  for (auto i = 1; i < options_.levelThresholdNanos.size(); ++i) {
+    VELOX_CHECK_GT(
+        options_.levelThresholdNanos[i], options_.levelThresholdNanos[i - 1]);
+  }
+  levelShares_[0] = 1;
+  for (auto level = 1; level < numLevels(); ++level) {
+    levelShares_[level] =
+        levelShares_[level - 1] / options_.levelTimeMultiplier;
+  }
+  const auto numNodes = std::max<int32_t>(1, options_.numaNodeCpus.size());
+  VELOX_CHECK_GE(
+      options_.numThreads, numNodes, "Each NUMA node needs a thread");
+  for (auto i = 0; i < numNodes; ++i) {
+    auto node = std::make_unique<Node>();
+    node->levels.resize(numLevels());
+    node->levelScaledNanos.resize(numLevels(), 0);
+    if (!options_.numaNodeCpus.empty()) {
+      node->cpus = options_.numaNodeCpus[i];
+      VELOX_CHECK(!node->cpus.empty(), "NUMA node {} has no CPUs", i);
+    }
+    nodes_.push_back(std::move(node));
+  }
+  threads_.reserve(options_.numThreads);
+  for (auto i = 0; i < options_.numThreads; ++i) {
+    auto* node = nodes_[i % numNodes].get();
+    threads_.emplace_back([this, node]() { workerLoop(*node); });
+  }
+}
+
+MultiLevelDriverExecutor::~MultiLevelDriverExecutor() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stopped_ = true;
+  }
+  for (auto& node : nodes_) {
+    node->workAvailable.notify_all();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void MultiLevelDriverExecutor::add(folly::Func func) {
+  Node* node;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    node = nodes_[nextFuncNode_].get();
+    nextFuncNode_ = (nextFuncNode_ + 1) % nodes_.size();
+    enqueueLocked(*node, 0, Entry{std::move(func), nullptr});
+  }
+  node->workAvailable.notify_one();
+}
+
+void MultiLevelDriverExecutor::add(
+    const std::shared_ptr<Task>& task,
+    folly::Func func) {
+  Node* node;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& taskCpu = tasks_[task.get()];
+    // A Task at the address of a destroyed one starts with no CPU time.
+    if (taskCpu == nullptr || taskCpu->task.expired()) {
+      // Not counted in the load of its previous node.
+      taskCpu = nullptr;
+      const auto taskNode = leastLoadedNodeLocked();
+      taskCpu = std::make_shared<TaskCpu>();
+      taskCpu->task = task;
+      taskCpu->node = taskNode;
+      if (++numAddsSinceCleanup_ >= kCleanupInterval) {
+        removeFinishedTasksLocked();
+      }
+    }
+    node = nodes_[taskCpu->node].get();
+    enqueueLocked(
+        *node, levelLocked(taskCpu->cpuNanos), Entry{std::move(func), taskCpu});
+  }
+  node->workAvailable.notify_one();
+}
+
+uint64_t MultiLevelDriverExecutor::taskCpuNanos(const Task* task) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tasks_.find(task);
+  return it == tasks_.end() ? 0 : it->second->cpuNanos;
+}
+
+int32_t MultiLevelDriverExecutor::taskLevel(const Task* task) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tasks_.find(task);
+  return it == tasks_.end() ? 0 : levelLocked(it->second->cpuNanos);
+}
+
+int32_t MultiLevelDriverExecutor::taskNumaNode(const Task* task) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = tasks_.find(task);
+  return it == tasks_.end() ? -1 : it->second->node;
+}
+
+int32_t MultiLevelDriverExecutor::leastLoadedNodeLocked() const {
+  if (nodes_.size() == 1) {
+    return 0;
+  }
+  std::vector<int32_t> numTasks(nodes_.size(), 0);
+  for (const auto& [task, taskCpu] : tasks_) {
+    if (taskCpu != nullptr && !taskCpu->task.expired()) {
+      ++numTasks[taskCpu->node];
+    }
+  }
+  return std::min_element(numTasks.begin(), numTasks.end()) -
+      numTasks.begin();
+}
+
+int32_t MultiLevelDriverExecutor::levelLocked(uint64_t cpuNanos) const {
+  const auto& thresholds = options_.levelThresholdNanos;
+  return std::upper_bound(thresholds.begin(), thresholds.end(), cpuNanos) -
+      thresholds.begin();
+}
+
+void MultiLevelDriverExecutor::enqueueLocked(
+    Node& node,
+    int32_t level,
+    Entry entry) {
+  auto& levels = node.levels;
+  auto& levelScaledNanos = node.levelScaledNanos;
+  if (levels[level].empty()) {
+    // A level that had no work does not get to catch up on the time it did
+    // not use, which would starve the other levels.
+    for (auto i = 0; i < numLevels(); ++i) {
+      if (!levels[i].empty()) {
+        levelScaledNanos[level] =
+            std::max(levelScaledNanos[level], levelScaledNanos[i]);
+      }
+    }
+  }
+  levels[level].push_back(std::move(entry));
+}
+
+int32_t MultiLevelDriverExecutor::nextLevelLocked(const Node& node) const {
+  int32_t nextLevel = -1;
+  for (auto level = 0; level < numLevels(); ++level) {
+    if (node.levels[level].empty()) {
+      continue;
+    }
+    if (nextLevel < 0 ||
+        node.levelScaledNanos[level] < node.levelScaledNanos[nextLevel]) {
+      nextLevel = level;
+    }
+  }
+  return nextLevel;
+}
+
+void MultiLevelDriverExecutor::removeFinishedTasksLocked() {
+  numAddsSinceCleanup_ = 0;
+  for (auto it = tasks_.begin(); it != tasks_.end();) {
+    if (it->second->task.expired()) {
+      it = tasks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void MultiLevelDriverExecutor::workerLoop(Node& node) {
+  if (!node.cpus.empty()) {
+    pinCurrentThread(node.cpus);
+  }
+  for (;;) {
+    Entry entry;
+    int32_t level;
+    {
+      std::unique_lock<std::mutex> l(mutex_);
+      node.workAvailable.wait(
+          l, [&]() { return stopped_ || nextLevelLocked(node) >= 0; });
+      level = nextLevelLocked(node);
+      if (level < 0) {
+        // Stopped and there is no work left.
+        return;
+      }
+      entry = std::move(node.levels[level].front());
+      node.levels[level].pop_front();
+    }
+
+    CpuWallTiming timing;
+    {
+      CpuWallTimer timer(timing);
+      try {
+        entry.func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "MultiLevelDriverExecutor: func threw unhandled "
+                   << folly::exceptionStr(e);
+      }
+      // Destroy the func and what it holds, e.g. the Driver, while timed.
+      entry.func = nullptr;
+    }
+
+    std::lock_guard<std::mutex> l(mutex_);
+    node.levelScaledNanos[level] += timing.cpuNanos / levelShares_[level];
+    if (entry.taskCpu != nullptr) {
+      entry.taskCpu->cpuNanos += timing.cpuNanos;
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+class Task;
+
+/// Executor for Drivers with multi-level feedback queues. The Drivers of a
+/// Task are queued at the level given by the CPU time the Task has used on
+/// 'this', so that the Drivers of Tasks that have used a lot of CPU move to
+/// lower priority levels. Each level gets a share of the CPU time that is
+/// 'levelTimeMultiplier' times the share of the next lower priority level, so
+/// that the lower levels are not starved. Within a level, Drivers run in FIFO
+/// order.
+///
+/// Drivers are enqueued again when they are unblocked or yield. Together with
+/// QueryConfig::kDriverCpuTimeSliceLimitMs, which makes a Driver yield after
+/// a time slice, a short query gets a low latency next to long running ones.
+/// Set as the executor of the QueryCtx.
+///
+/// With 'numaNodeCpus', the worker threads are divided between the NUMA
+/// nodes and pinned to the CPUs of their node, and each Task is placed on one
+/// node whose threads run all its Drivers. The memory a Driver touches first,
+/// e.g. of a hash table, is then allocated on the node of the Task by the
+/// first touch policy of the kernel, and the build and probe sides of a join
+/// in the Task run next to that memory.
+class MultiLevelDriverExecutor : public folly::Executor {
+ public:
+  struct Options {
+    /// Number of worker threads.
+    int32_t numThreads{
+        static_cast<int32_t>(std::thread::hardware_concurrency())};
+
+    /// The Task CPU times in ns at which the Drivers of a Task move to the
+    /// next lower priority level. Must be increasing. There are
+    /// levelThresholdNanos.size() + 1 levels.
+    std::vector<uint64_t> levelThresholdNanos{
+        1'000'000'000UL,
+        10'000'000'000UL,
+        60'000'000'000UL,
+        300'000'000'000UL};
+
+    /// The share of the CPU time of a level is this many times the share of
+    /// the next lower priority level.
+    double levelTimeMultiplier{2};
+
+    /// The CPUs of each NUMA node to place Tasks on, e.g. from
+    /// systemNumaNodeCpus(). Empty means that the threads are not pinned and
+    /// the Drivers of a Task run on any thread.
+    std::vector<std::vector<int32_t>> numaNodeCpus;
+  };
+
+  /// Returns the CPUs of each NUMA node of the host. Empty if the host does
+  /// not report its NUMA topology.
+  static std::vector<std::vector<int32_t>> systemNumaNodeCpus();
+
+  explicit MultiLevelDriverExecutor(Options options);
+
+  /// Runs the queued work and joins the threads.
+  ~MultiLevelDriverExecutor() override;
+
+  /// Runs 'func' at the highest priority level. Used for work that is not
+  /// from a Driver.
+  void add(folly::Func func) override;
+
+  /// Runs 'func' at the level of the CPU time used by 'task' and adds the CPU
+  /// time of 'func' to 'task'. Used by Driver::enqueue().
+  void add(const std::shared_ptr<Task>& task, folly::Func func);
+
+  int32_t numLevels() const {
+    return options_.levelThresholdNanos.size() + 1;
+  }
+
+  /// Returns the CPU time in ns used on 'this' by the work of 'task'.
+  uint64_t taskCpuNanos(const Task* task) const;
+
+  /// Returns the level the work of 'task' is queued at.
+  int32_t taskLevel(const Task* task) const;
+
+  /// Returns the number of NUMA nodes Tasks are placed on, 1 without
+  /// 'numaNodeCpus'.
+  int32_t numNumaNodes() const {
+    return nodes_.size();
+  }
+
+  /// Returns the NUMA node 'task' is placed on, or -1 if it has not run on
+  /// 'this'.
+  int32_t taskNumaNode(const Task* task) const;
+
+ private:
+  // CPU time used by a Task and the node it runs on.
+  struct TaskCpu {
+    std::weak_ptr<Task> task;
+    uint64_t cpuNanos{0};
+    int32_t node{0};
+  };
+
+  struct Entry {
+    folly::Func func;
+    // nullptr if not from a Task.
+    std::shared_ptr<TaskCpu> taskCpu;
+  };
+
+  // The queues and threads of a NUMA node.
+  struct Node {
+    std::vector<std::deque<Entry>> levels;
+
+    // The CPU time in ns that each level has run for, divided by its share.
+    std::vector<double> levelScaledNanos;
+
+    std::condition_variable workAvailable;
+
+    // The CPUs the threads of the node are pinned to. Empty if not pinned.
+    std::vector<int32_t> cpus;
+  };
+
+  int32_t levelLocked(uint64_t cpuNanos) const;
+
+  void enqueueLocked(Node& node, int32_t level, Entry entry);
+
+  // Returns the non-empty level of 'node' that has run for the least time
+  // relative to its share.
+  int32_t nextLevelLocked(const Node& node) const;
+
+  // Returns the node with the fewest live Tasks, for placing a new Task.
+  int32_t leastLoadedNodeLocked() const;
+
+  // Removes the CPU times of the Tasks that no longer exist.
+  void removeFinishedTasksLocked();
+
+  void workerLoop(Node& node);
+
+  const Options options_;
+
+  mutable std::mutex mutex_;
+
+  std::vector<std::unique_ptr<Node>> nodes_;
+
+  // The share of CPU time of each level. 1 at level 0.
+  std::vector<double> levelShares_;
+
+  // The node the next function that is not from a Task runs on.
+  int32_t nextFuncNode_{0};
+
+  std::unordered_map<const Task*, std::shared_ptr<TaskCpu>> tasks_;
+
+  // Number of Task additions since the last removeFinishedTasksLocked().
+  int32_t numAddsSinceCleanup_{0};
+
+  bool stopped_{false};
+
+  std::vector<std::thread> threads_;
+};
+
+} // namespace facebook::velox::exec
@@ -50,7 +50,9 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      compactStringBuffersMinLivePct_(
+          driverCtx->queryConfig().compactStringBuffersMinLivePct()) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -58,6 +60,14 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
     for (auto& child : input->children()) {
       child->loadedVector();
     }
+    if (compactStringBuffersMinLivePct_ > 0) {
+      // The input is held until the end of the join. Drops the parts of the
+      // string buffers and of the bases of selective dictionaries that no row
+      // references.
+      VectorPtr vector = std::move(input);
+      BaseVector::compactStringBuffers(vector, compactStringBuffersMinLivePct_);
+      input = std::static_pointer_cast<RowVector>(vector);
+    }
     dataVectors_.emplace_back(std::move(input));
   }
 }
@@ -105,12 +115,47 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
+  const auto maxBlockRows =
+      operatorCtx_->driverCtx()->queryConfig().nestedLoopJoinBuildBlockRows();
+  if (maxBlockRows > 0) {
+    coalesceDataVectors(maxBlockRows);
+  }
+
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
       ->setData(std::move(dataVectors_));
 }
 
+void NestedLoopJoinBuild::coalesceDataVectors(vector_size_t maxBlockRows) {
+  std::vector<RowVectorPtr> blocks;
+  blocks.reserve(dataVectors_.size());
+  for (auto i = 0; i < dataVectors_.size();) {
+    // Finds the run of vectors [i, end) which fits in one block.
+    auto end = i + 1;
+    vector_size_t numRows = dataVectors_[i]->size();
+    while (end < dataVectors_.size() &&
+           numRows + dataVectors_[end]->size() <= maxBlockRows) {
+      numRows += dataVectors_[end]->size();
+      ++end;
+    }
+    if (end == i + 1) {
+      blocks.push_back(std::move(dataVectors_[i]));
+    } else {
+      auto block = BaseVector::create<RowVector>(
+          dataVectors_[i]->type(), numRows, pool());
+      vector_size_t offset = 0;
+      for (auto j = i; j < end; ++j) {
+        block->copy(dataVectors_[j].get(), offset, 0, dataVectors_[j]->size());
+        offset += dataVectors_[j]->size();
+      }
+      blocks.push_back(std::move(block));
+    }
+    i = end;
+  }
+  dataVectors_ = std::move(blocks);
+}
+
 bool NestedLoopJoinBuild::isFinished() {
   return !future_.valid() && noMoreInput_;
 }
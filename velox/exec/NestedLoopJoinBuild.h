@@ -59,6 +59,12 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // Coalesces runs of consecutive vectors in 'dataVectors_' into blocks of at
+  // most 'maxBlockRows' rows. Vectors with more rows are kept as they are.
+  void coalesceDataVectors(vector_size_t maxBlockRows);
+
+  const int32_t compactStringBuffersMinLivePct_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
@@ -17,6 +17,7 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/FilterProject.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
@@ -40,11 +41,18 @@ OperatorCtx::OperatorCtx(
 core::ExecCtx* OperatorCtx::execCtx() const {
   if (!execCtx_) {
     execCtx_ = std::make_unique<core::ExecCtx>(
-        pool_, driverCtx_->task->queryCtx().get());
+        pool_, driverCtx_->task->queryCtx().get(), driverCtx_->vectorPool());
   }
   return execCtx_.get();
 }
 
+size_t OperatorCtx::clearVectorPool() const {
+  if (execCtx_ == nullptr || execCtx_->vectorPool() == nullptr) {
+    return 0;
+  }
+  return execCtx_->vectorPool()->clear();
+}
+
 std::shared_ptr<connector::ConnectorQueryCtx>
 OperatorCtx::createConnectorQueryCtx(
     const std::string& connectorId,
@@ -276,6 +284,62 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+uint32_t Operator::adaptiveOutputBatchRows(uint32_t defaultRows) const {
+  // The fewest rows of an adaptive batch. Keeps the per-batch overhead low
+  // for very wide rows.
+  static constexpr uint64_t kMinAdaptiveBatchRows = 64;
+
+  const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  if (!queryConfig.adaptiveOutputBatchSizingEnabled()) {
+    return defaultRows;
+  }
+
+  uint64_t maxRowSize = 0;
+  auto addRowSize = [&](const Operator& op) {
+    const auto lockedStats = op.stats_.rlock();
+    if (lockedStats->outputPositions == 0) {
+      return false;
+    }
+    maxRowSize = std::max<uint64_t>(
+        maxRowSize, lockedStats->outputBytes / lockedStats->outputPositions);
+    return true;
+  };
+  if (!addRowSize(*this)) {
+    return defaultRows;
+  }
+  if (auto* driver = operatorCtx_->driver()) {
+    const auto operators = driver->operators();
+    auto it = std::find(operators.begin(), operators.end(), this);
+    if (it != operators.end()) {
+      for (++it; it != operators.end() &&
+           (*it)->operatorType() == "FilterProject";
+           ++it) {
+        addRowSize(**it);
+      }
+    }
+  }
+  return std::clamp<uint64_t>(
+      queryConfig.adaptiveOutputBatchBytes() /
+          std::max<uint64_t>(maxRowSize, 1),
+      kMinAdaptiveBatchRows,
+      std::max<uint64_t>(
+          queryConfig.maxOutputBatchRows(), kMinAdaptiveBatchRows));
+}
+
+void Operator::fuseFilterProject(FilterProject* filterProject) {
+  VELOX_CHECK(canFuseFilterProject());
+  VELOX_CHECK_NULL(fusedFilterProject_);
+  fusedFilterProject_ = filterProject;
+  fusedFilterProject_->setFused();
+}
+
+RowVectorPtr Operator::applyFusedFilterProject(RowVectorPtr output) {
+  if (fusedFilterProject_ == nullptr || output == nullptr) {
+    return output;
+  }
+  return fusedFilterProject_->evaluateFused(std::move(output));
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -351,6 +415,25 @@ void Operator::recordSpillStats(const SpillStats& spillStats) {
                 Timestamp::kNanosecondsInMicrosecond),
             RuntimeCounter::Unit::kNanos});
   }
+  if (spillStats.spillFileCloseTimeUs != 0) {
+    lockedStats->addRuntimeStat(
+        "spillFileCloseTime",
+        RuntimeCounter{
+            static_cast<int64_t>(
+                spillStats.spillFileCloseTimeUs *
+                Timestamp::kNanosecondsInMicrosecond),
+            RuntimeCounter::Unit::kNanos});
+  }
+  if (spillStats.spilledLz4Files != 0) {
+    lockedStats->addRuntimeStat(
+        "spilledLz4Files",
+        RuntimeCounter{static_cast<int64_t>(spillStats.spilledLz4Files)});
+  }
+  if (spillStats.spilledZstdFiles != 0) {
+    lockedStats->addRuntimeStat(
+        "spilledZstdFiles",
+        RuntimeCounter{static_cast<int64_t>(spillStats.spilledZstdFiles)});
+  }
   if (numSpillRuns_ != 0) {
     lockedStats->addRuntimeStat(
         "spillRuns", RuntimeCounter{static_cast<int64_t>(numSpillRuns_)});
@@ -25,6 +25,8 @@
 
 namespace facebook::velox::exec {
 
+class FilterProject;
+
 // Represents a column that is copied from input to output, possibly
 // with cardinality change, i.e. values removed or duplicated.
 struct IdentityProjection {
@@ -231,6 +233,10 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Frees the vectors cached for reuse in the vector pool of 'execCtx_'.
+  /// Returns the number of freed vectors.
+  size_t clearVectorPool() const;
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -404,6 +410,16 @@ class Operator : public BaseRuntimeStatWriter {
         toString());
   }
 
+  /// Returns true if a FilterProject right after 'this' can be evaluated in
+  /// the output path of 'this'. See QueryConfig::kFilterProjectFusionEnabled.
+  virtual bool canFuseFilterProject() const {
+    return false;
+  }
+
+  /// Makes 'this' evaluate 'filterProject' on its output. Called by the Driver
+  /// only if canFuseFilterProject() returns true.
+  void fuseFilterProject(FilterProject* filterProject);
+
   /// Returns a list of identify projections, e.g. columns that are projected
   /// as-is possibly after applying a filter.
   const std::vector<IdentityProjection>& identityProjections() const {
@@ -477,6 +493,12 @@ class Operator : public BaseRuntimeStatWriter {
     return reclaimable;
   }
 
+  /// Frees the vectors cached for reuse by the expression evaluation of this
+  /// operator. Returns the number of freed vectors.
+  size_t clearVectorPool() {
+    return operatorCtx_->clearVectorPool();
+  }
+
   /// Invoked by the memory arbitrator to reclaim memory from this operator with
   /// specified reclaim target bytes. If 'targetBytes' is zero, then it tries to
   /// reclaim all the reclaimable memory from this operator.
@@ -507,6 +529,15 @@ class Operator : public BaseRuntimeStatWriter {
     return operatorCtx_->operatorType();
   }
 
+  /// Returns the profile frame of 'this' for process::SamplingProfiler, e.g.
+  /// '3 HashProbe'.
+  const std::string& profileLabel() const {
+    if (profileLabel_.empty()) {
+      profileLabel_ = fmt::format("{} {}", planNodeId(), operatorType());
+    }
+    return profileLabel_;
+  }
+
   /// Registers 'translator' for mapping user defined PlanNode subclass
   /// instances to user-defined Operators.
   static void registerOperator(std::unique_ptr<PlanNodeTranslator> translator);
@@ -677,6 +708,18 @@ class Operator : public BaseRuntimeStatWriter {
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns the number of rows for the output batch with
+  /// QueryConfig::adaptiveOutputBatchSizingEnabled(). These are the rows that
+  /// fit in adaptiveOutputBatchBytes() for the widest average output row
+  /// measured in the stats of 'this' and of the FilterProjects that directly
+  /// follow it in the pipeline, which process the same batches. Returns
+  /// 'defaultRows' if adaptive sizing is off or 'this' has no output yet.
+  uint32_t adaptiveOutputBatchRows(uint32_t defaultRows) const;
+
+  /// Returns 'output' after the fused FilterProject, or 'output' itself if
+  /// there is none. Returns nullptr if no row of 'output' passes the filter.
+  RowVectorPtr applyFusedFilterProject(RowVectorPtr output);
+
   /// Invoked to record spill stats in operator stats.
   void recordSpillStats(const SpillStats& spillStats);
 
@@ -716,6 +759,12 @@ class Operator : public BaseRuntimeStatWriter {
 
   /// The number of times that spilling run on this operator.
   uint32_t numSpillRuns_{0};
+
+  /// The FilterProject evaluated on the output of 'this'. Not owned.
+  FilterProject* fusedFilterProject_{nullptr};
+
+  /// Made on first use by profileLabel().
+  mutable std::string profileLabel_;
 };
 
 /// Given a row type returns indices for the specified subset of columns.
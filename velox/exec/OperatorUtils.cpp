@@ -420,4 +420,75 @@ void projectChildren(
         wrapChild(size, mapping, src[inputChannel]);
   }
 }
+bool isThresholdFilterType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+      return true;
+    case TypeKind::BIGINT:
+      // Readers do not apply BigintRange to short decimals.
+      return !type->isDecimal();
+    default:
+      return false;
+  }
+}
+
+std::optional<int64_t>
+thresholdAt(const char* row, const RowColumn& column, TypeKind kind) {
+  if (RowContainer::isNullAt(row, column.nullByte(), column.nullMask())) {
+    return std::nullopt;
+  }
+  const char* value = row + column.offset();
+  switch (kind) {
+    case TypeKind::TINYINT:
+      return *reinterpret_cast<const int8_t*>(value);
+    case TypeKind::SMALLINT:
+      return *reinterpret_cast<const int16_t*>(value);
+    case TypeKind::INTEGER:
+      return *reinterpret_cast<const int32_t*>(value);
+    case TypeKind::BIGINT:
+      return *reinterpret_cast<const int64_t*>(value);
+    default:
+      VELOX_UNREACHABLE("Unexpected threshold type: {}", kind);
+  }
+}
+
+std::shared_ptr<common::Filter> makeThresholdFilter(
+    const std::optional<int64_t>& threshold,
+    const core::SortOrder& order,
+    bool inclusive) {
+  if (!threshold.has_value()) {
+    if (!order.isNullsFirst()) {
+      // Any value sorts before a null that sorts last.
+      return nullptr;
+    }
+    return std::make_shared<common::IsNull>();
+  }
+
+  const auto value = threshold.value();
+  int64_t lower = std::numeric_limits<int64_t>::min();
+  int64_t upper = std::numeric_limits<int64_t>::max();
+  if (order.isAscending()) {
+    upper = inclusive || value == lower ? value : value - 1;
+  } else {
+    lower = inclusive || value == upper ? value : value + 1;
+  }
+  return std::make_shared<common::BigintRange>(
+      lower, upper, order.isNullsFirst());
+}
+
+bool canPushdownThresholdFilter(
+    const Driver& driver,
+    const Operator* op,
+    column_index_t channel) {
+  const auto operators = driver.operators();
+  for (auto i = 1; i < operators.size() && operators[i] != op; ++i) {
+    if (operators[i]->operatorType() != "FilterProject") {
+      return false;
+    }
+  }
+  return driver.canPushdownFilters(op, {channel}).count(channel) > 0;
+}
+
 } // namespace facebook::velox::exec
@@ -158,4 +158,30 @@ void projectChildren(
     int32_t size,
     const BufferPtr& mapping);
 
+/// Returns true if 'type' is an integer sorting key type for which
+/// makeThresholdFilter() can make a filter.
+bool isThresholdFilterType(const TypePtr& type);
+
+/// Returns the value of an integer column of a RowContainer row as int64_t, or
+/// std::nullopt if it is null. 'kind' must be an isThresholdFilterType() kind.
+std::optional<int64_t>
+thresholdAt(const char* row, const RowColumn& column, TypeKind kind);
+
+/// Returns a filter on a sorting key that passes the values that sort before
+/// or, if 'inclusive', together with 'threshold'. A std::nullopt 'threshold' is
+/// a null. Returns nullptr if every value passes.
+std::shared_ptr<common::Filter> makeThresholdFilter(
+    const std::optional<int64_t>& threshold,
+    const core::SortOrder& order,
+    bool inclusive);
+
+/// Returns true if a threshold filter on 'channel' produced by 'op' can be
+/// pushed to the source of 'driver'. This requires every operator between the
+/// source and 'op' to be a FilterProject. Operators that limit, number or add
+/// rows would make such a filter change the result.
+bool canPushdownThresholdFilter(
+    const Driver& driver,
+    const Operator* op,
+    column_index_t channel);
+
 } // namespace facebook::velox::exec
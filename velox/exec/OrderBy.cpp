@@ -69,7 +69,9 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       &numSpillRuns_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold());
+      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold(),
+      operatorCtx_->task()->queryCtx()->executor(),
+      operatorCtx_->driverCtx()->queryConfig().orderBySortParallelism());
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
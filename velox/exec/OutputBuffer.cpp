@@ -62,6 +62,42 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+void BroadcastBuffer::noMoreData() {
+  // Drop duplicate end markers.
+  if (hasNoMoreData()) {
+    return;
+  }
+  pages_.push_back(nullptr);
+}
+
+void BroadcastBuffer::enqueue(std::unique_ptr<SerializedPage> page) {
+  VELOX_CHECK_NOT_NULL(page, "Unexpected null page");
+  VELOX_CHECK(!hasNoMoreData(), "Broadcast buffer has set no more data marker");
+  pages_.push_back(std::shared_ptr<SerializedPage>(page.release()));
+}
+
+std::vector<std::shared_ptr<SerializedPage>> BroadcastBuffer::freePages(
+    int64_t sequence) {
+  std::vector<std::shared_ptr<SerializedPage>> freed;
+  // NOTE: keep the end marker in broadcast buffer to signal the destinations
+  // which haven't fetched it yet.
+  while (firstSequence_ < sequence && !pages_.empty() &&
+         pages_.front() != nullptr) {
+    freed.push_back(std::move(pages_.front()));
+    pages_.pop_front();
+    ++firstSequence_;
+  }
+  return freed;
+}
+
+std::string BroadcastBuffer::toString() const {
+  return fmt::format(
+      "[BROADCAST_BUFFER PAGES[{}] FIRST SEQUENCE[{}] NO MORE DATA[{}]]",
+      pages_.size() - !!hasNoMoreData(),
+      firstSequence_,
+      hasNoMoreData());
+}
+
 std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
@@ -73,7 +109,8 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     loadData(arbitraryBuffer, maxBytes);
   }
 
-  if (sequence - sequence_ > data_.size()) {
+  const int64_t numAvailable = this->numAvailable();
+  if (sequence - sequence_ > numAvailable) {
     VLOG(1) << this << " Out of order get: " << sequence << " over "
             << sequence_ << " Setting second notify " << notifySequence_
             << " / " << sequence;
@@ -82,7 +119,7 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     notifyMaxBytes_ = maxBytes;
     return {};
   }
-  if (sequence - sequence_ == data_.size()) {
+  if (sequence - sequence_ == numAvailable) {
     notify_ = std::move(notify);
     notifySequence_ = sequence;
     notifyMaxBytes_ = maxBytes;
@@ -91,15 +128,16 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
 
   std::vector<std::unique_ptr<folly::IOBuf>> result;
   uint64_t resultBytes = 0;
-  for (auto i = sequence - sequence_; i < data_.size(); ++i) {
+  for (auto i = sequence - sequence_; i < numAvailable; ++i) {
+    const auto& page = pageAt(i);
     // nullptr is used as end marker
-    if (data_[i] == nullptr) {
-      VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
+    if (page == nullptr) {
+      VELOX_CHECK_EQ(i, numAvailable - 1, "null marker found in the middle");
       result.push_back(nullptr);
       break;
     }
-    result.push_back(data_[i]->getIOBuf());
-    resultBytes += data_[i]->size();
+    result.push_back(page->getIOBuf());
+    resultBytes += page->size();
     if (resultBytes >= maxBytes) {
       break;
     }
@@ -108,6 +146,8 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
 }
 
 void DestinationBuffer::enqueue(std::shared_ptr<SerializedPage> data) {
+  VELOX_CHECK_NULL(
+      broadcastBuffer_, "Broadcast destination reads from broadcast buffer");
   // Drop duplicate end markers.
   if (data == nullptr && !data_.empty() && data_.back() == nullptr) {
     return;
@@ -168,7 +208,11 @@ std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::acknowledge(
   }
 
   VELOX_CHECK_LE(
-      numDeleted, data_.size(), "Ack received for a not yet produced item");
+      numDeleted, numAvailable(), "Ack received for a not yet produced item");
+  if (broadcastBuffer_ != nullptr) {
+    sequence_ += numDeleted;
+    return {};
+  }
   std::vector<std::shared_ptr<SerializedPage>> freed;
   for (auto i = 0; i < numDeleted; ++i) {
     if (data_[i] == nullptr) {
@@ -198,7 +242,7 @@ DestinationBuffer::deleteResults() {
 
 std::string DestinationBuffer::toString() {
   std::stringstream out;
-  out << "[available: " << data_.size() << ", "
+  out << "[available: " << numAvailable() << ", "
       << "sequence: " << sequence_ << ", "
       << (notify_ ? "notify registered, " : "") << this << "]";
   return out.str();
@@ -231,10 +275,13 @@ OutputBuffer::OutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      broadcastBuffer_(
+          isBroadcast() ? std::make_unique<BroadcastBuffer>() : nullptr),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
-    buffers_.push_back(std::make_unique<DestinationBuffer>());
+    buffers_.push_back(
+        std::make_unique<DestinationBuffer>(broadcastBuffer_.get()));
   }
 }
 
@@ -246,6 +293,7 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
     return;
   }
 
+  std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   bool isFinished;
   {
@@ -261,10 +309,13 @@ void OutputBuffer::updateOutputBuffers(int numBuffers, bool noMoreBuffers) {
 
     noMoreBuffers_ = true;
     isFinished = isFinishedLocked();
-    updateAfterAcknowledgeLocked(dataToBroadcast_, promises);
+    if (isBroadcast()) {
+      freed = freeBroadcastPagesLocked();
+    }
+    updateAfterAcknowledgeLocked(freed, promises);
   }
 
-  releaseAfterAcknowledge(dataToBroadcast_, promises);
+  releaseAfterAcknowledge(freed, promises);
   if (isFinished) {
     task_->setAllOutputConsumed();
   }
@@ -290,17 +341,27 @@ void OutputBuffer::addOutputBuffersLocked(int numBuffers) {
   VELOX_CHECK(!isPartitioned());
   buffers_.reserve(numBuffers);
   for (int32_t i = buffers_.size(); i < numBuffers; ++i) {
-    auto buffer = std::make_unique<DestinationBuffer>();
-    if (isBroadcast()) {
-      for (const auto& data : dataToBroadcast_) {
-        buffer->enqueue(data);
-      }
-    }
-    if (atEnd_ && isBroadcast()) {
-      buffer->enqueue(nullptr);
+    // NOTE: broadcast pages are not freed before receiving the no more buffers
+    // signal so a new destination can read them all from the start.
+    VELOX_CHECK(!isBroadcast() || broadcastBuffer_->firstSequence() == 0);
+    buffers_.emplace_back(
+        std::make_unique<DestinationBuffer>(broadcastBuffer_.get()));
+  }
+}
+
+std::vector<std::shared_ptr<SerializedPage>>
+OutputBuffer::freeBroadcastPagesLocked() {
+  VELOX_DCHECK(isBroadcast());
+  if (!noMoreBuffers_) {
+    return {};
+  }
+  int64_t minSequence = broadcastBuffer_->endSequence();
+  for (const auto& buffer : buffers_) {
+    if (buffer != nullptr) {
+      minSequence = std::min(minSequence, buffer->sequence());
     }
-    buffers_.emplace_back(std::move(buffer));
   }
+  return broadcastBuffer_->freePages(minSequence);
 }
 
 bool OutputBuffer::enqueue(
@@ -354,21 +415,15 @@ void OutputBuffer::enqueueBroadcastOutputLocked(
     std::vector<DataAvailable>& dataAvailableCbs) {
   VELOX_DCHECK(isBroadcast());
   VELOX_CHECK_NULL(arbitraryBuffer_);
+  VELOX_DCHECK_NOT_NULL(broadcastBuffer_);
   VELOX_DCHECK(dataAvailableCbs.empty());
 
-  std::shared_ptr<SerializedPage> sharedData(data.release());
+  broadcastBuffer_->enqueue(std::move(data));
   for (auto& buffer : buffers_) {
     if (buffer != nullptr) {
-      buffer->enqueue(sharedData);
       dataAvailableCbs.emplace_back(buffer->getAndClearNotify());
     }
   }
-
-  // NOTE: we don't need to add new buffer to 'dataToBroadcast_' if there is no
-  // more output buffers.
-  if (!noMoreBuffers_) {
-    dataToBroadcast_.emplace_back(sharedData);
-  }
 }
 
 void OutputBuffer::enqueueArbitraryOutputLocked(
@@ -451,6 +506,13 @@ void OutputBuffer::checkIfDone(bool oneDriverFinished) {
           finished.push_back(buffer->getAndClearNotify());
         }
       }
+    } else if (isBroadcast()) {
+      broadcastBuffer_->noMoreData();
+      for (auto& buffer : buffers_) {
+        if (buffer != nullptr) {
+          finished.push_back(buffer->getAndClearNotify());
+        }
+      }
     } else {
       for (auto& buffer : buffers_) {
         if (buffer != nullptr) {
@@ -499,6 +561,9 @@ void OutputBuffer::acknowledge(int destination, int64_t sequence) {
       return;
     }
     freed = buffer->acknowledge(sequence, false);
+    if (isBroadcast()) {
+      freed = freeBroadcastPagesLocked();
+    }
     updateAfterAcknowledgeLocked(freed, promises);
   }
   releaseAfterAcknowledge(freed, promises);
@@ -548,6 +613,9 @@ bool OutputBuffer::deleteResults(int destination) {
     buffers_[destination] = nullptr;
     ++numFinalAcknowledges_;
     isFinished = isFinishedLocked();
+    if (isBroadcast()) {
+      freed = freeBroadcastPagesLocked();
+    }
     updateAfterAcknowledgeLocked(freed, promises);
   }
 
@@ -588,6 +656,9 @@ void OutputBuffer::getData(
         destination,
         sequence);
     freed = buffer->acknowledge(sequence, true);
+    if (isBroadcast()) {
+      freed = freeBroadcastPagesLocked();
+    }
     updateAfterAcknowledgeLocked(freed, promises);
     data = buffer->getData(maxBytes, sequence, notify, arbitraryBuffer_.get());
   }
@@ -628,6 +699,9 @@ std::string OutputBuffer::toStringLocked() const {
   if (isArbitrary()) {
     out << arbitraryBuffer_->toString();
   }
+  if (isBroadcast()) {
+    out << broadcastBuffer_->toString();
+  }
   out << "]" << std::endl;
   return out.str();
 }
@@ -74,8 +74,65 @@ class ArbitraryBuffer {
   std::deque<std::shared_ptr<SerializedPage>> pages_;
 };
 
+/// The class is used to buffer the output pages for broadcast output. Each
+/// page is stored once and all the destinations read it by sequence number
+/// which is the same for all the destinations. A page is freed after the
+/// slowest destination has acknowledged it.
+///
+/// NOTE: there is only one broadcast buffer setup for broadcast output to
+/// share among destinations. Also, this class is not thread-safe.
+class BroadcastBuffer {
+ public:
+  /// Returns true if this broadcast buffer will not receive any new pages
+  /// from enqueue().
+  bool hasNoMoreData() const {
+    return !pages_.empty() && (pages_.back() == nullptr);
+  }
+
+  /// Marks this broadcast buffer will not receive any new incoming pages. It
+  /// appends a null page at the end of 'pages_' as end marker.
+  void noMoreData();
+
+  void enqueue(std::unique_ptr<SerializedPage> page);
+
+  /// Returns the sequence number of the first buffered page.
+  int64_t firstSequence() const {
+    return firstSequence_;
+  }
+
+  /// Returns the sequence number after the last buffered page, including the
+  /// end marker.
+  int64_t endSequence() const {
+    return firstSequence_ + pages_.size();
+  }
+
+  /// Returns the page with 'sequence'. nullptr is the end marker.
+  const std::shared_ptr<SerializedPage>& page(int64_t sequence) const {
+    VELOX_DCHECK_GE(sequence, firstSequence_);
+    VELOX_DCHECK_LT(sequence, endSequence());
+    return pages_[sequence - firstSequence_];
+  }
+
+  /// Removes the pages with sequence number below 'sequence' and returns
+  /// them. This is called with the lowest sequence acknowledged by all the
+  /// destinations.
+  std::vector<std::shared_ptr<SerializedPage>> freePages(int64_t sequence);
+
+  std::string toString() const;
+
+ private:
+  std::deque<std::shared_ptr<SerializedPage>> pages_;
+  // The sequence number of the first page in 'pages_'.
+  int64_t firstSequence_{0};
+};
+
 class DestinationBuffer {
  public:
+  /// If 'broadcastBuffer' is set, this destination reads the pages from the
+  /// shared broadcast buffer instead of buffering them in 'data_'.
+  explicit DestinationBuffer(const BroadcastBuffer* broadcastBuffer = nullptr)
+      : broadcastBuffer_(broadcastBuffer) {}
+
   void enqueue(std::shared_ptr<SerializedPage> data);
 
   /// Invoked to load data with up to 'notifyMaxBytes_' bytes from arbitrary
@@ -99,7 +156,9 @@ class DestinationBuffer {
       DataAvailableCallback notify,
       ArbitraryBuffer* arbitraryBuffer = nullptr);
 
-  // Removes data from the queue and returns removed data. If 'fromGetData' we
+  // Removes data from the queue and returns removed data. A broadcast
+  // destination only advances its sequence and never returns any data, which
+  // is freed by the shared broadcast buffer instead. If 'fromGetData' we
   // do not give a warning for the case where no data is removed, otherwise we
   // expect that data does get freed. We cannot assert that data gets
   // deleted because acknowledge messages can arrive out of order.
@@ -114,9 +173,29 @@ class DestinationBuffer {
   // the callback.
   DataAvailable getAndClearNotify();
 
+  /// Returns the sequence number of the first not acknowledged page.
+  int64_t sequence() const {
+    return sequence_;
+  }
+
   std::string toString();
 
  private:
+  // Returns the number of pages available from 'sequence_' on.
+  int64_t numAvailable() const {
+    return broadcastBuffer_ != nullptr
+        ? broadcastBuffer_->endSequence() - sequence_
+        : data_.size();
+  }
+
+  // Returns the 'index'th page from 'sequence_' on.
+  const std::shared_ptr<SerializedPage>& pageAt(int64_t index) const {
+    return broadcastBuffer_ != nullptr
+        ? broadcastBuffer_->page(sequence_ + index)
+        : data_[index];
+  }
+
+  const BroadcastBuffer* const broadcastBuffer_;
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
@@ -207,10 +286,16 @@ class OutputBuffer {
       const std::vector<std::shared_ptr<SerializedPage>>& freed,
       std::vector<ContinuePromise>& promises);
 
-  /// Given an updated total number of broadcast buffers, add any missing ones
-  /// and enqueue data that has been produced so far (e.g. dataToBroadcast_).
+  /// Given an updated total number of broadcast buffers, add any missing ones.
+  /// New broadcast buffers read the data produced so far from
+  /// 'broadcastBuffer_'.
   void addOutputBuffersLocked(int numBuffers);
 
+  // Frees the pages in 'broadcastBuffer_' acknowledged by all the
+  // destinations and returns them. Pages are kept until receiving the no more
+  // (destination) buffers signal as new destinations read from the start.
+  std::vector<std::shared_ptr<SerializedPage>> freeBroadcastPagesLocked();
+
   void enqueueBroadcastOutputLocked(
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
@@ -247,6 +332,7 @@ class OutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  const std::unique_ptr<BroadcastBuffer> broadcastBuffer_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -257,11 +343,6 @@ class OutputBuffer {
   // applies for non-partitioned output buffer type.
   bool noMoreBuffers_{false};
 
-  // While noMoreBuffers_ is false, stores the enqueued data to
-  // broadcast to destinations that have not yet been initialized. Cleared
-  // after receiving no-more-broadcast-buffers signal.
-  std::vector<std::shared_ptr<SerializedPage>> dataToBroadcast_;
-
   std::mutex mutex_;
   // Actual data size in 'buffers_'.
   uint64_t totalSize_ = 0;
@@ -21,25 +21,11 @@
 namespace facebook::velox::exec {
 
 namespace detail {
-BlockingReason Destination::advance(
+void Destination::collect(
     uint64_t maxBytes,
     const std::vector<vector_size_t>& sizes,
-    const RowVectorPtr& output,
-    OutputBufferManager& bufferManager,
-    const std::function<void()>& bufferReleaseFn,
-    bool* atEnd,
-    ContinueFuture* future) {
-  if (rangeIdx_ >= ranges_.size()) {
-    *atEnd = true;
-    return BlockingReason::kNotBlocked;
-  }
-
-  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
-  if (bytesInCurrent_ >= adjustedMaxBytes) {
-    return flush(bufferManager, bufferReleaseFn, future);
-  }
-
-  // Collect ranges to serialize.
+    const RowVectorPtr& output) {
+  VELOX_CHECK(!atEnd());
   rangesToSerialize_.clear();
   bool shouldFlush = false;
   while (rangeIdx_ < ranges_.size() && !shouldFlush) {
@@ -49,8 +35,7 @@ BlockingReason Destination::advance(
          rowsInCurrentRange_++) {
       ++rowsInCurrent_;
       bytesInCurrent_ += sizes[currRange.begin + rowsInCurrentRange_];
-      shouldFlush = bytesInCurrent_ >= adjustedMaxBytes ||
-          rowsInCurrent_ >= targetNumRows_;
+      shouldFlush = needsFlush(maxBytes);
     }
     rangesToSerialize_.push_back(
         {currRange.begin + startRow, rowsInCurrentRange_ - startRow});
@@ -60,22 +45,11 @@ BlockingReason Destination::advance(
     }
   }
 
-  // Serialize
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
     current_->createStreamTree(rowType, rowsInCurrent_);
   }
-  current_->append(
-      output, folly::Range(&rangesToSerialize_[0], rangesToSerialize_.size()));
-  // Update output state variable.
-  if (rangeIdx_ == ranges_.size()) {
-    *atEnd = true;
-  }
-  if (shouldFlush) {
-    return flush(bufferManager, bufferReleaseFn, future);
-  }
-  return BlockingReason::kNotBlocked;
 }
 
 BlockingReason Destination::flush(
@@ -318,29 +292,42 @@ RowVectorPtr PartitionedOutput::getOutput() {
   bool workLeft;
   do {
     workLeft = false;
+    scatterDestinations_.clear();
     for (auto& destination : destinations_) {
-      bool atEnd = false;
-      blockingReason_ = destination->advance(
-          maxPageSize,
-          rowSize_,
-          output_,
-          *bufferManager,
-          bufferReleaseFn_,
-          &atEnd,
-          &future_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        blockedDestination = destination.get();
-        workLeft = false;
-        // We stop on first blocked. Adding data to unflushed targets
-        // would be possible but could allocate memory. We wait for
-        // free space in the outgoing queue.
-        break;
+      if (destination->atEnd()) {
+        continue;
       }
-      if (!atEnd) {
+      if (destination->needsFlush(maxPageSize)) {
+        blockingReason_ =
+            destination->flush(*bufferManager, bufferReleaseFn_, &future_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          blockedDestination = destination.get();
+          break;
+        }
+      }
+      destination->collect(maxPageSize, rowSize_, output_);
+      scatterDestinations_.push_back(destination.get());
+    }
+
+    scatterCollected();
+
+    for (auto* destination : scatterDestinations_) {
+      if (blockedDestination == nullptr &&
+          destination->needsFlush(maxPageSize)) {
+        blockingReason_ =
+            destination->flush(*bufferManager, bufferReleaseFn_, &future_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          // We stop on first blocked. Adding data to unflushed targets
+          // would be possible but could allocate memory. We wait for
+          // free space in the outgoing queue.
+          blockedDestination = destination;
+        }
+      }
+      if (!destination->atEnd()) {
         workLeft = true;
       }
     }
-  } while (workLeft);
+  } while (workLeft && blockedDestination == nullptr);
 
   if (blockedDestination) {
     // If we are going off-thread, we may as well make the output in
@@ -376,6 +363,19 @@ RowVectorPtr PartitionedOutput::getOutput() {
   return nullptr;
 }
 
+void PartitionedOutput::scatterCollected() {
+  if (scatterDestinations_.empty()) {
+    return;
+  }
+  scatterGroups_.clear();
+  scatterRanges_.clear();
+  for (auto* destination : scatterDestinations_) {
+    scatterGroups_.push_back(destination->current());
+    scatterRanges_.push_back(destination->rangesToSerialize());
+  }
+  VectorStreamGroup::scatter(output_, scatterGroups_, scatterRanges_);
+}
+
 bool PartitionedOutput::isFinished() {
   return finished_;
 }
@@ -49,15 +49,35 @@ class Destination {
     ranges_.push_back(rows);
   }
 
-  // Serializes row from 'output' till either 'maxBytes' have been serialized or
-  BlockingReason advance(
+  // Returns true if all rows of the current batch are collected.
+  bool atEnd() const {
+    return rangeIdx_ >= ranges_.size();
+  }
+
+  // Returns true if the rows collected since the last flush() reach the
+  // target page size for 'maxBytes' or the target row count.
+  bool needsFlush(uint64_t maxBytes) const {
+    return bytesInCurrent_ >= (maxBytes * targetSizePct_) / 100 ||
+        rowsInCurrent_ >= targetNumRows_;
+  }
+
+  // Collects the rows of the current batch to serialize next into
+  // 'rangesToSerialize_' until needsFlush('maxBytes') or the batch ends.
+  // 'sizes' are the estimated serialized row sizes. The rows are appended
+  // to current() for all destinations at once with
+  // VectorStreamGroup::scatter().
+  void collect(
       uint64_t maxBytes,
       const std::vector<vector_size_t>& sizes,
-      const RowVectorPtr& output,
-      OutputBufferManager& bufferManager,
-      const std::function<void()>& bufferReleaseFn,
-      bool* atEnd,
-      ContinueFuture* future);
+      const RowVectorPtr& output);
+
+  VectorStreamGroup* current() const {
+    return current_.get();
+  }
+
+  folly::Range<const IndexRange*> rangesToSerialize() const {
+    return folly::Range(rangesToSerialize_.data(), rangesToSerialize_.size());
+  }
 
   BlockingReason flush(
       OutputBufferManager& bufferManager,
@@ -98,9 +118,9 @@ class Destination {
   // Number of rows serialized in 'current_'
   vector_size_t rowsInCurrent_{0};
   std::vector<IndexRange> ranges_;
-  // List of ranges to be serialized. This is only used by
-  // Destination::advance() and defined as a member variable to reuse allocated
-  // capacity between calls.
+  // List of ranges to be serialized. This is only filled by
+  // Destination::collect() and defined as a member variable to reuse
+  // allocated capacity between calls.
   std::vector<IndexRange> rangesToSerialize_;
 
   // First range index of 'ranges_' that is not appended to 'current_'.
@@ -187,6 +207,10 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Appends the rows collected by the destinations in 'scatterDestinations_'
+  // to their streams in one pass over the columns of 'output_'.
+  void scatterCollected();
+
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
@@ -215,6 +239,9 @@ class PartitionedOutput : public Operator {
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
+  std::vector<detail::Destination*> scatterDestinations_;
+  std::vector<VectorStreamGroup*> scatterGroups_;
+  std::vector<folly::Range<const IndexRange*>> scatterRanges_;
 };
 
 } // namespace facebook::velox::exec
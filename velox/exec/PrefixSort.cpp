@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+
+namespace facebook::velox::exec {
+namespace {
+struct PrefixEntry {
+  uint64_t prefix;
+  char* row;
+};
+
+using PrefixEntries =
+    std::vector<PrefixEntry, memory::StlAllocator<PrefixEntry>>;
+
+// Describes how one key column is packed into the prefix. A nullable key
+// takes one null bit right above its value bits.
+struct KeyEncoding {
+  RowColumn column;
+  TypeKind kind;
+  bool nullable;
+  CompareFlags flags;
+  // Number of bits of the key value type.
+  int32_t valueBits;
+  // Number of high value bits kept in the prefix. Less than 'valueBits' if
+  // the key is truncated.
+  int32_t prefixBits;
+  // Position of the lowest bit of the key in the prefix.
+  int32_t shift;
+};
+
+int32_t valueBits(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      return 1;
+    case TypeKind::TINYINT:
+      return 8;
+    case TypeKind::SMALLINT:
+      return 16;
+    case TypeKind::INTEGER:
+      return 32;
+    case TypeKind::BIGINT:
+      return 64;
+    default:
+      return 0;
+  }
+}
+
+inline uint64_t lowMask(int32_t bits) {
+  return bits == 64 ? ~0ULL : (1ULL << bits) - 1;
+}
+
+template <typename T>
+inline T valueAt(const char* row, int32_t offset) {
+  return *reinterpret_cast<const T*>(row + offset);
+}
+
+// Maps a signed integer to an unsigned one of the same width and order.
+template <typename T>
+inline uint64_t toOrderedUnsigned(T value) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<U>(static_cast<U>(value) ^ (U(1) << (sizeof(T) * 8 - 1)));
+}
+
+// Returns the key value of 'row' as an unsigned integer which sorts in the
+// key order, truncated to the high 'prefixBits' of the value.
+inline uint64_t orderedValue(const char* row, const KeyEncoding& key) {
+  const auto offset = key.column.offset();
+  uint64_t value;
+  switch (key.kind) {
+    case TypeKind::BOOLEAN:
+      value = valueAt<bool>(row, offset) ? 1 : 0;
+      break;
+    case TypeKind::TINYINT:
+      value = toOrderedUnsigned(valueAt<int8_t>(row, offset));
+      break;
+    case TypeKind::SMALLINT:
+      value = toOrderedUnsigned(valueAt<int16_t>(row, offset));
+      break;
+    case TypeKind::INTEGER:
+      value = toOrderedUnsigned(valueAt<int32_t>(row, offset));
+      break;
+    case TypeKind::BIGINT:
+      value = toOrderedUnsigned(valueAt<int64_t>(row, offset));
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  if (!key.flags.ascending) {
+    value = ~value & lowMask(key.valueBits);
+  }
+  return value >> (key.valueBits - key.prefixBits);
+}
+
+inline uint64_t encodePrefix(
+    const char* row,
+    const std::vector<KeyEncoding>& keys) {
+  uint64_t prefix{0};
+  for (const auto& key : keys) {
+    uint64_t field;
+    if (key.nullable &&
+        RowContainer::isNullAt(
+            row, key.column.nullByte(), key.column.nullMask())) {
+      field = key.flags.nullsFirst ? 0 : 1ULL << key.prefixBits;
+    } else {
+      field = orderedValue(row, key);
+      if (key.nullable && key.flags.nullsFirst) {
+        field |= 1ULL << key.prefixBits;
+      }
+    }
+    prefix |= field << key.shift;
+  }
+  return prefix;
+}
+
+// LSD radix sort of 'entries' on the prefix, one byte per pass. Bytes which
+// are the same in all the prefixes are skipped. 'buffer' must have the same
+// size as 'entries'.
+void radixSort(PrefixEntries& entries, PrefixEntries& buffer) {
+  uint64_t diffBits{0};
+  const uint64_t first = entries[0].prefix;
+  for (const auto& entry : entries) {
+    diffBits |= entry.prefix ^ first;
+  }
+  std::array<size_t, 256> offsets;
+  for (int32_t shift = 0; shift < 64; shift += 8) {
+    if (((diffBits >> shift) & 0xff) == 0) {
+      continue;
+    }
+    offsets.fill(0);
+    for (const auto& entry : entries) {
+      ++offsets[(entry.prefix >> shift) & 0xff];
+    }
+    size_t offset{0};
+    for (auto& count : offsets) {
+      const auto next = offset + count;
+      count = offset;
+      offset = next;
+    }
+    for (const auto& entry : entries) {
+      buffer[offsets[(entry.prefix >> shift) & 0xff]++] = entry;
+    }
+    entries.swap(buffer);
+  }
+}
+} // namespace
+
+// static
+bool PrefixSort::canEncode(const TypePtr& type) {
+  return valueBits(type->kind()) != 0;
+}
+
+// static
+bool PrefixSort::sort(
+    RowContainer* container,
+    int32_t numKeys,
+    const std::vector<CompareFlags>& compareFlags,
+    char** rows,
+    size_t numRows,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK(
+      compareFlags.empty() ||
+      compareFlags.size() == static_cast<size_t>(numKeys));
+  const auto& keyTypes = container->keyTypes();
+
+  // Pack the leading keys from the high bits of the prefix down. The first key
+  // which doesn't fit is truncated and the rest are left to the full row
+  // comparison.
+  std::vector<KeyEncoding> keys;
+  int32_t firstUncoveredKey{numKeys};
+  int32_t remainingBits{64};
+  for (int32_t i = 0; i < numKeys; ++i) {
+    const auto bits = valueBits(keyTypes[i]->kind());
+    if (bits == 0) {
+      firstUncoveredKey = i;
+      break;
+    }
+    const auto column = container->columnAt(i);
+    const bool nullable = column.nullMask() != 0;
+    const auto flags = compareFlags.empty() ? CompareFlags() : compareFlags[i];
+    int32_t prefixBits = bits;
+    if (bits + nullable > remainingBits) {
+      prefixBits = remainingBits - nullable;
+      if (prefixBits <= 0) {
+        firstUncoveredKey = i;
+        break;
+      }
+    }
+    remainingBits -= prefixBits + nullable;
+    keys.push_back(
+        {column,
+         keyTypes[i]->kind(),
+         nullable,
+         flags,
+         bits,
+         prefixBits,
+         remainingBits});
+    if (prefixBits < bits) {
+      firstUncoveredKey = i;
+      break;
+    }
+  }
+  if (keys.empty()) {
+    return false;
+  }
+  if (numRows < 2) {
+    return true;
+  }
+
+  PrefixEntries entries(numRows, *pool);
+  for (size_t i = 0; i < numRows; ++i) {
+    entries[i] = {encodePrefix(rows[i], keys), rows[i]};
+  }
+
+  // Compares the keys which the prefix doesn't fully cover.
+  auto compareUncovered = [&](const char* left, const char* right) {
+    for (int32_t i = firstUncoveredKey; i < numKeys; ++i) {
+      if (auto result = container->compare(
+              left,
+              right,
+              i,
+              compareFlags.empty() ? CompareFlags() : compareFlags[i])) {
+        return result < 0;
+      }
+    }
+    return false;
+  };
+
+  if (numRows < kMinRadixSortRows) {
+    std::stable_sort(
+        entries.begin(),
+        entries.end(),
+        [&](const PrefixEntry& left, const PrefixEntry& right) {
+          if (left.prefix != right.prefix) {
+            return left.prefix < right.prefix;
+          }
+          return compareUncovered(left.row, right.row);
+        });
+  } else {
+    PrefixEntries buffer(numRows, *pool);
+    radixSort(entries, buffer);
+    if (firstUncoveredKey < numKeys) {
+      auto tieBegin = entries.begin();
+      while (tieBegin != entries.end()) {
+        auto tieEnd = tieBegin + 1;
+        while (tieEnd != entries.end() && tieEnd->prefix == tieBegin->prefix) {
+          ++tieEnd;
+        }
+        if (tieEnd - tieBegin > 1) {
+          std::stable_sort(
+              tieBegin,
+              tieEnd,
+              [&](const PrefixEntry& left, const PrefixEntry& right) {
+                return compareUncovered(left.row, right.row);
+              });
+        }
+        tieBegin = tieEnd;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < numRows; ++i) {
+    rows[i] = entries[i].row;
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Sorts rows of a RowContainer on their leading key columns using a
+/// normalized 64-bit prefix per row. The prefix packs the leading integer and
+/// boolean keys, including their null flags and sort order, so that comparing
+/// two prefixes as unsigned integers gives the same order as comparing the
+/// encoded keys. The (prefix, row) pairs are radix sorted and the full row
+/// comparison only runs on rows with equal prefixes when the prefix does not
+/// cover all the keys. The sort is stable.
+class PrefixSort {
+ public:
+  /// Sorts 'numRows' 'rows' of 'container' on its first 'numKeys' columns
+  /// with 'compareFlags', one per key or empty for the default flags. Returns
+  /// false without touching 'rows' if the first key can't be encoded into a
+  /// prefix, in which case the caller is expected to sort with the full row
+  /// comparison. 'pool' is used for the prefix buffers.
+  static bool sort(
+      RowContainer* container,
+      int32_t numKeys,
+      const std::vector<CompareFlags>& compareFlags,
+      char** rows,
+      size_t numRows,
+      memory::MemoryPool* pool);
+
+  /// Returns true if a key of 'type' can be encoded into a prefix.
+  static bool canEncode(const TypePtr& type);
+
+  /// Minimum number of rows for sort() to radix sort. Smaller inputs are
+  /// sorted by comparing the prefixes.
+  static constexpr size_t kMinRadixSortRows = 256;
+};
+
+} // namespace facebook::velox::exec
@@ -122,7 +122,8 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    std::shared_ptr<HashStringAllocator> stringAllocator)
+    std::shared_ptr<HashStringAllocator> stringAllocator,
+    int32_t normalizedKeyWords)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
@@ -236,7 +237,8 @@ RowContainer::RowContainer(
     }
   }
   originalNormalizedKeySize_ = hasNormalizedKeys_
-      ? bits::roundUp(sizeof(normalized_key_t), alignment_)
+      ? bits::roundUp(
+            normalizedKeyWords * sizeof(normalized_key_t), alignment_)
       : 0;
   normalizedKeySize_ = originalNormalizedKeySize_;
   for (auto i = 0; i < offsets_.size(); ++i) {
@@ -603,13 +605,25 @@ void RowContainer::hash(
 
 void RowContainer::clear() {
   const bool sharedStringAllocator = !stringAllocator_.unique();
-  if (checkFree_ || sharedStringAllocator || usesExternalMemory_) {
-    constexpr int32_t kBatch = 1000;
+  constexpr int32_t kBatch = 1000;
+  if (checkFree_ || sharedStringAllocator) {
     std::vector<char*> rows(kBatch);
     RowContainerIterator iter;
     while (auto numRows = listRows(&iter, kBatch, rows.data())) {
       eraseRows(folly::Range<char**>(rows.data(), numRows));
     }
+  } else if (usesExternalMemory_) {
+    // Memory from 'stringAllocator_' is released in bulk below. Only the
+    // accumulators that hold memory outside of it are destroyed row by row.
+    std::vector<char*> rows(kBatch);
+    RowContainerIterator iter;
+    while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+      for (auto& accumulator : accumulators_) {
+        if (accumulator.usesExternalMemory()) {
+          accumulator.destroy(folly::Range<char**>(rows.data(), numRows));
+        }
+      }
+    }
   }
   rows_.clear();
   if (!sharedStringAllocator) {
@@ -634,6 +648,37 @@ void RowContainer::setProbedFlag(char** rows, int32_t numRows) {
   }
 }
 
+void RowContainer::extractColumns(
+    const char* const* rows,
+    int32_t numRows,
+    folly::Range<const int32_t*> columnIndices,
+    folly::Range<const VectorPtr*> results) {
+  VELOX_CHECK_EQ(columnIndices.size(), results.size());
+  if (columnIndices.size() < 2 || numRows <= kExtractColumnsTileRows) {
+    for (auto i = 0; i < columnIndices.size(); ++i) {
+      extractColumn(rows, numRows, columnIndices[i], results[i]);
+    }
+    return;
+  }
+  for (const auto& result : results) {
+    result->resize(numRows);
+  }
+  for (int32_t begin = 0; begin < numRows; begin += kExtractColumnsTileRows) {
+    const auto numTileRows =
+        std::min<int32_t>(kExtractColumnsTileRows, numRows - begin);
+    for (auto i = 0; i < columnIndices.size(); ++i) {
+      VELOX_DYNAMIC_TYPE_DISPATCH_ALL(
+          extractColumnTile,
+          results[i]->typeKind(),
+          rows + begin,
+          numTileRows,
+          columnAt(columnIndices[i]),
+          begin,
+          results[i]);
+    }
+  }
+}
+
 void RowContainer::extractProbedFlags(
     const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
     int32_t numRows,
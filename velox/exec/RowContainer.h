@@ -207,6 +207,9 @@ class RowContainer {
   /// 'stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. This is needed for spilling where the same
   /// aggregates are used for reading one container and merging into another.
+  /// 'normalizedKeyWords' is the number of words left below each row if
+  /// 'hasNormalizedKey' is true. A hash join build side uses 2 for keys that
+  /// do not fit in one word.
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -217,7 +220,8 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* FOLLY_NONNULL pool,
-      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr);
+      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr,
+      int32_t normalizedKeyWords = 1);
 
   /// Allocates a new row and initializes possible aggregates to null.
   char* FOLLY_NONNULL newRow();
@@ -358,6 +362,22 @@ class RowContainer {
     extractColumn(rows, numRows, columnAt(columnIndex), resultOffset, result);
   }
 
+  /// Copies the values at each of 'columnIndices' into the vector at the same
+  /// position in 'results' for the 'numRows' rows pointed to by 'rows'.
+  /// Extracts all the columns for a tile of kExtractColumnsTileRows rows
+  /// before moving to the next tile, so that the rows of the tile stay in
+  /// cache. With wide rows, extracting one column at a time over all rows
+  /// reads each row from memory once per column.
+  void extractColumns(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      int32_t numRows,
+      folly::Range<const int32_t*> columnIndices,
+      folly::Range<const VectorPtr*> results);
+
+  /// Number of rows for which extractColumns() extracts all columns at a
+  /// time.
+  static constexpr int32_t kExtractColumnsTileRows = 64;
+
   /// Copies the values at 'columnIndex' at positions in the 'rowNumbers' array
   /// for the rows pointed to by 'rows'. The values are copied into the 'result'
   /// vector at the offset pointed by 'resultOffset'. If an entry in 'rows'
@@ -558,6 +578,13 @@ class RowContainer {
     return reinterpret_cast<normalized_key_t*>(group)[-1];
   }
 
+  /// Allows get/set of the second word of a two word normalized key. This is
+  /// stored in the word below the first word.
+  static inline normalized_key_t& secondNormalizedKey(
+      char* FOLLY_NONNULL group) {
+    return reinterpret_cast<normalized_key_t*>(group)[-2];
+  }
+
   void disableNormalizedKeys() {
     normalizedKeySize_ = 0;
   }
@@ -597,6 +624,35 @@ class RowContainer {
     return rows_.allocatedBytes() + stringAllocator_->retainedSize();
   }
 
+  /// Makes the rows of 'this' be allocated from one contiguous range of up to
+  /// 'maxBytes' of address space. The memory reservation of the range grows by
+  /// doubling. While all rows fit in the range, rows can be addressed by 32 bit
+  /// offsets with rowOffset() and rowAt() and listRows() scans the rows
+  /// sequentially. Must be called before the first row is added.
+  void setContiguousRowArena(int64_t maxBytes) {
+    VELOX_CHECK_EQ(0, numRows_);
+    rows_.setContiguousArena(maxBytes);
+  }
+
+  /// Returns true if all rows are in one contiguous range.
+  bool hasContiguousRows() const {
+    return rows_.isContiguous();
+  }
+
+  /// Returns the offset of 'row' from the start of the contiguous range of
+  /// rows. Requires hasContiguousRows().
+  uint32_t rowOffset(const char* FOLLY_NONNULL row) const {
+    const auto offset = row - rows_.contiguousStart();
+    VELOX_DCHECK_GE(offset, 0);
+    VELOX_DCHECK_LT(offset, memory::AllocationPool::kMaxContiguousArenaBytes);
+    return offset;
+  }
+
+  /// Returns the row at 'offset' returned by rowOffset().
+  char* FOLLY_NONNULL rowAt(uint32_t offset) const {
+    return rows_.contiguousStart() + offset;
+  }
+
   /// Returns the number of fixed size rows that can be allocated without
   /// growing the container and the number of unused bytes of reserved storage
   /// for variable length data.
@@ -723,14 +779,31 @@ class RowContainer {
       int32_t resultOffset,
       const VectorPtr& result) {
     if (rowNumbers.size() > 0) {
+      // Resize the result vector before all copies.
+      result->resize(rowNumbers.size() + resultOffset);
       extractColumnTypedInternal<true, Kind>(
           rows, rowNumbers, rowNumbers.size(), column, resultOffset, result);
     } else {
+      result->resize(numRows + resultOffset);
       extractColumnTypedInternal<false, Kind>(
           rows, rowNumbers, numRows, column, resultOffset, result);
     }
   }
 
+  // Copies the values at 'column' for 'numRows' rows into 'result' from
+  // 'resultOffset'. Unlike extractColumnTyped(), expects 'result' to be sized
+  // for all the tiles of extractColumns().
+  template <TypeKind Kind>
+  static void extractColumnTile(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      int32_t numRows,
+      RowColumn column,
+      int32_t resultOffset,
+      const VectorPtr& result) {
+    extractColumnTypedInternal<false, Kind>(
+        rows, {}, numRows, column, resultOffset, result);
+  }
+
   template <bool useRowNumbers, TypeKind Kind>
   static void extractColumnTypedInternal(
       const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
@@ -739,9 +812,6 @@ class RowContainer {
       RowColumn column,
       int32_t resultOffset,
       const VectorPtr& result) {
-    // Resize the result vector before all copies.
-    result->resize(numRows + resultOffset);
-
     if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
         Kind == TypeKind::MAP) {
       extractComplexType<useRowNumbers>(
@@ -1295,6 +1365,16 @@ inline void RowContainer::storeNoNulls<TypeKind::HUGEINT>(
   HugeInt::serialize(decoded.valueAt<int128_t>(index), row + offset);
 }
 
+template <>
+inline void RowContainer::extractColumnTile<TypeKind::OPAQUE>(
+    const char* FOLLY_NONNULL const* FOLLY_NONNULL /*rows*/,
+    int32_t /*numRows*/,
+    RowColumn /*column*/,
+    int32_t /*resultOffset*/,
+    const VectorPtr& /*result*/) {
+  VELOX_UNSUPPORTED("RowContainer doesn't support values of type OPAQUE");
+}
+
 template <>
 inline void RowContainer::extractColumnTyped<TypeKind::OPAQUE>(
     const char* FOLLY_NONNULL const* FOLLY_NONNULL /*rows*/,
@@ -132,47 +132,57 @@ void RowNumber::restoreNextSpillPartition() {
     return;
   }
 
+  // The spill partitions have disjoint partition keys, so the counts of the
+  // previous spill partition are not needed anymore.
+  table_->clear();
+  pool()->release();
+
   auto it = spillInputPartitionSet_.begin();
   spillInputReader_ = it->second->createReader();
 
   // Find matching partition for the hash table.
   auto hashTableIt = spillHashTablePartitionSet_.find(it->first);
   if (hashTableIt != spillHashTablePartitionSet_.end()) {
-    spillHashTableReader_ = hashTableIt->second->createReader();
-
-    RowVectorPtr data;
-    while (spillHashTableReader_->nextBatch(data)) {
-      // 'data' contains partition-by keys and count. Transform 'data' to match
-      // 'inputType_' so it can be added to the 'table_'. Move partition-by
-      // columns and leave other columns unset.
-      std::vector<VectorPtr> columns(inputType_->size());
-
-      const auto& hashers = table_->hashers();
-      for (auto i = 0; i < hashers.size(); ++i) {
-        columns[hashers[i]->channel()] = data->childAt(i);
-      }
+    restoreHashTable(*hashTableIt->second);
+  }
 
-      auto input = std::make_shared<RowVector>(
-          pool(), inputType_, nullptr, data->size(), std::move(columns));
+  spillInputPartitionSet_.erase(it);
 
-      const auto numInput = input->size();
-      SelectivityVector rows(numInput);
-      table_->prepareForProbe(*lookup_, input, rows, false);
-      table_->groupProbe(*lookup_);
+  spillInputReader_->nextBatch(input_);
+  addSpillInput();
+}
 
-      auto* counts = data->children().back()->as<FlatVector<int64_t>>();
+void RowNumber::restoreHashTable(SpillPartition& spillPartition) {
+  spillHashTableReader_ = spillPartition.createReader();
 
-      for (auto i = 0; i < numInput; ++i) {
-        auto* partition = lookup_->hits[i];
-        setNumRows(partition, counts->valueAt(i));
-      }
+  RowVectorPtr data;
+  while (spillHashTableReader_->nextBatch(data)) {
+    // 'data' contains partition-by keys and count. Transform 'data' to match
+    // 'inputType_' so it can be added to the 'table_'. Move partition-by
+    // columns and leave other columns unset.
+    std::vector<VectorPtr> columns(inputType_->size());
+
+    const auto& hashers = table_->hashers();
+    for (auto i = 0; i < hashers.size(); ++i) {
+      columns[hashers[i]->channel()] = data->childAt(i);
     }
-  }
 
-  spillInputPartitionSet_.erase(it);
+    auto input = std::make_shared<RowVector>(
+        pool(), inputType_, nullptr, data->size(), std::move(columns));
 
-  spillInputReader_->nextBatch(input_);
-  addSpillInput();
+    const auto numInput = input->size();
+    SelectivityVector rows(numInput);
+    table_->prepareForProbe(*lookup_, input, rows, false);
+    table_->groupProbe(*lookup_);
+
+    auto* counts = data->children().back()->as<FlatVector<int64_t>>();
+
+    for (auto i = 0; i < numInput; ++i) {
+      auto* partition = lookup_->hits[i];
+      setNumRows(partition, counts->valueAt(i));
+    }
+  }
+  spillHashTableReader_ = nullptr;
 }
 
 void RowNumber::ensureInputFits(const RowVectorPtr& input) {
@@ -259,6 +269,13 @@ RowVectorPtr RowNumber::getOutput() {
     return getOutputForSinglePartition();
   }
 
+  if (reclaimedHashTablePartition_ != nullptr) {
+    // Restores the partitions spilled by reclaim() and probes 'input_' again.
+    restoreHashTable(*reclaimedHashTablePartition_);
+    reclaimedHashTablePartition_.reset();
+    addSpillInput();
+  }
+
   const auto numInput = input_->size();
 
   BufferPtr mapping;
@@ -367,6 +384,19 @@ void RowNumber::reclaim(
     return;
   }
 
+  if (noMoreInput_) {
+    if (spillInputReader_ == nullptr) {
+      // The row numbers of the pending input are computed from the partitions
+      // in 'table_'.
+      if (input_ != nullptr) {
+        ++stats.numNonReclaimableAttempts;
+      }
+      return;
+    }
+    spillRestoredHashTable();
+    return;
+  }
+
   if (hashTableSpiller_) {
     // Already spilled.
     return;
@@ -396,7 +426,9 @@ void RowNumber::setupHashTableSpiller() {
       spillConfig.writeBufferSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.fileFormat,
+      spillConfig.adaptiveCompression);
 }
 
 void RowNumber::setupInputSpiller() {
@@ -413,7 +445,9 @@ void RowNumber::setupInputSpiller() {
       spillConfig.writeBufferSize,
       spillConfig.compressionKind,
       memory::spillMemoryPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.fileFormat,
+      spillConfig.adaptiveCompression);
 
   const auto& hashers = table_->hashers();
 
@@ -450,6 +484,24 @@ void RowNumber::spill() {
   }
 }
 
+void RowNumber::spillRestoredHashTable() {
+  VELOX_CHECK_NULL(reclaimedHashTablePartition_);
+
+  // All the partitions restored from a spill partition map to the same spill
+  // partition.
+  setupHashTableSpiller();
+  hashTableSpiller_->spill();
+
+  SpillPartitionSet partitionSet;
+  hashTableSpiller_->finishSpill(partitionSet);
+  recordSpillStats(hashTableSpiller_->stats());
+  VELOX_CHECK_EQ(partitionSet.size(), 1);
+  reclaimedHashTablePartition_ = std::move(partitionSet.begin()->second);
+
+  table_->clear();
+  pool()->release();
+}
+
 void RowNumber::spillInput(
     const RowVectorPtr& input,
     memory::MemoryPool* pool) {
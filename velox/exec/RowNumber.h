@@ -70,6 +70,13 @@ class RowNumber : public Operator {
 
   void restoreNextSpillPartition();
 
+  // Adds the partitions and their row counts in 'spillPartition' to 'table_'.
+  void restoreHashTable(SpillPartition& spillPartition);
+
+  // Spills the partitions restored after noMoreInput(). They are restored
+  // in the next getOutput() call.
+  void spillRestoredHashTable();
+
   int64_t numRows(char* partition);
 
   void setNumRows(char* partition, int64_t numRows);
@@ -116,5 +123,9 @@ class RowNumber : public Operator {
 
   // Used to calculate the spill partition numbers of the inputs.
   std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+
+  // The partitions restored from the current spill partition if they were
+  // spilled by reclaim() after noMoreInput().
+  std::unique_ptr<SpillPartition> reclaimedHashTablePartition_;
 };
 } // namespace facebook::velox::exec
@@ -16,7 +16,9 @@
 
 #include "velox/exec/SharedArbitrator.h"
 
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Metrics.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -57,20 +59,45 @@ std::string memoryPoolAbortMessage(
       << victim->treeMemoryUsage();
   return out.str();
 }
+
+// Returns the arbitration priority of the root memory 'pool'.
+int32_t priority(const MemoryPool& pool) {
+  const auto* reclaimer = pool.reclaimer();
+  return reclaimer == nullptr ? 0 : reclaimer->priority();
+}
+
+// Tracks the time a request waits for the running arbitration in range of
+// [0, 600s] with 1s buckets and reports P50, P90, P99, and P100.
+MetricHistogram& arbitrationQueueTimeMs() {
+  static MetricHistogram histogram(
+      kCounterArbitrationQueueTimeMs, 1'000, 0, 600'000, {50, 90, 99, 100});
+  return histogram;
+}
+
+// Tracks the time a request runs the arbitration, same range as above.
+MetricHistogram& arbitrationTimeMs() {
+  static MetricHistogram histogram(
+      kCounterArbitrationTimeMs, 1'000, 0, 600'000, {50, 90, 99, 100});
+  return histogram;
+}
 } // namespace
 
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
-    : MemoryArbitrator(config), freeCapacity_(capacity_) {
+    : MemoryArbitrator(config),
+      freeCapacity_(capacity_),
+      capacityLimit_(capacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
 }
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] "
+      "PRIORITY[{}]]",
       pool->root()->name(),
       reclaimable,
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
 }
 
 void SharedArbitrator::sortCandidatesByFreeCapacity(
@@ -99,6 +126,9 @@ void SharedArbitrator::sortCandidatesByReclaimableMemory(
         if (!rhs.reclaimable) {
           return true;
         }
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -113,16 +143,24 @@ SharedArbitrator::findCandidateWithLargestCapacity(
     uint64_t targetBytes,
     const std::vector<Candidate>& candidates) const {
   VELOX_CHECK(!candidates.empty());
+  // Only the candidates of the lowest priority can be aborted.
+  int32_t minPriority = candidates[0].priority;
+  for (const auto& candidate : candidates) {
+    minPriority = std::min(minPriority, candidate.priority);
+  }
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
+    if (candidates[i].priority != minPriority) {
+      continue;
+    }
     const bool isCandidate = candidates[i].pool == requestor;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
@@ -145,7 +183,8 @@ SharedArbitrator::findCandidateWithLargestCapacity(
 }
 
 SharedArbitrator::~SharedArbitrator() {
-  VELOX_CHECK_EQ(freeCapacity_, capacity_, "{}", toString());
+  VELOX_CHECK_EQ(
+      freeCapacity_ + withheldCapacity_, capacity_, "{}", toString());
 }
 
 void SharedArbitrator::reserveMemory(MemoryPool* pool, uint64_t /*unused*/) {
@@ -178,7 +217,11 @@ std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
     uint64_t reclaimableBytes;
     const bool reclaimable = pool->reclaimableBytes(reclaimableBytes);
     candidates.push_back(
-        {reclaimable, reclaimableBytes, pool->freeBytes(), pool.get()});
+        {reclaimable,
+         reclaimableBytes,
+         pool->freeBytes(),
+         pool.get(),
+         priority(*pool)});
   }
   return candidates;
 }
@@ -231,17 +274,67 @@ bool SharedArbitrator::growMemory(
   return false;
 }
 
+uint64_t SharedArbitrator::shrinkMemory(
+    const std::vector<std::shared_ptr<MemoryPool>>& pools,
+    uint64_t targetBytes) {
+  if (targetBytes == 0) {
+    return 0;
+  }
+  startArbitration(nullptr);
+  const auto startTime = std::chrono::steady_clock::now();
+  auto finishGuard = folly::makeGuard([&]() {
+    arbitrationTimeUs_ += std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - startTime)
+                              .count();
+    finishArbitration();
+  });
+
+  std::vector<Candidate> candidates = getCandidateStats(pools);
+  uint64_t freedBytes =
+      reclaimFreeMemoryFromCandidates(candidates, targetBytes);
+  if (freedBytes < targetBytes) {
+    sortCandidatesByReclaimableMemory(candidates);
+    for (const auto& candidate : candidates) {
+      if (!candidate.reclaimable || candidate.reclaimableBytes == 0) {
+        break;
+      }
+      ++numReclaims_;
+      freedBytes += reclaim(
+          candidate.pool,
+          std::max(targetBytes - freedBytes, memoryPoolTransferCapacity_));
+      if (freedBytes >= targetBytes) {
+        break;
+      }
+    }
+  }
+  incrementFreeCapacity(freedBytes);
+  return freedBytes;
+}
+
+void SharedArbitrator::setCapacityLimit(uint64_t limitBytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  capacityLimit_ = std::min(limitBytes, capacity_);
+  const uint64_t maxWithheldBytes = capacity_ - capacityLimit_;
+  if (withheldCapacity_ > maxWithheldBytes) {
+    freeCapacity_ += withheldCapacity_ - maxWithheldBytes;
+    withheldCapacity_ = maxWithheldBytes;
+    return;
+  }
+  withholdFreeCapacityLocked();
+}
+
 bool SharedArbitrator::checkCapacityGrowth(
     const MemoryPool& pool,
     uint64_t targetBytes) const {
   return (maxGrowBytes(pool) >= targetBytes) &&
-      (capacityAfterGrowth(pool, targetBytes) <= capacity_);
+      (capacityAfterGrowth(pool, targetBytes) <= capacityLimit_);
 }
 
 bool SharedArbitrator::ensureCapacity(
     MemoryPool* requestor,
     uint64_t targetBytes) {
-  if ((targetBytes > capacity_) || (targetBytes > requestor->maxCapacity())) {
+  if ((targetBytes > capacityLimit_) ||
+      (targetBytes > requestor->maxCapacity())) {
     return false;
   }
   if (checkCapacityGrowth(*requestor, targetBytes)) {
@@ -380,6 +473,9 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
     uint64_t targetBytes) {
   // Sort candidate memory pools based on their reclaimable memory.
   sortCandidatesByReclaimableMemory(candidates);
+  if (incrementalReclaim_) {
+    return reclaimUsedMemoryIncrementally(requestor, candidates, targetBytes);
+  }
 
   int64_t freedBytes{0};
   for (const auto& candidate : candidates) {
@@ -390,7 +486,7 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
     const int64_t bytesToReclaim = std::max<int64_t>(
         targetBytes - freedBytes, memoryPoolTransferCapacity_);
     VELOX_CHECK_GT(bytesToReclaim, 0);
-    freedBytes += reclaim(candidate.pool, bytesToReclaim);
+    freedBytes += reclaimUsedMemory(requestor, candidate, bytesToReclaim);
     if ((freedBytes >= targetBytes) || requestor->aborted()) {
       break;
     }
@@ -398,6 +494,65 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
   return freedBytes;
 }
 
+uint64_t SharedArbitrator::reclaimUsedMemoryIncrementally(
+    MemoryPool* requestor,
+    std::vector<Candidate>& candidates,
+    uint64_t targetBytes) {
+  uint64_t freedBytes{0};
+  size_t groupStart{0};
+  while (groupStart < candidates.size()) {
+    if (!candidates[groupStart].reclaimable) {
+      break;
+    }
+    // The reclaimable candidates of the same priority are contiguous after
+    // sorting.
+    const int32_t groupPriority = candidates[groupStart].priority;
+    size_t groupEnd = groupStart + 1;
+    while (groupEnd < candidates.size() && candidates[groupEnd].reclaimable &&
+           candidates[groupEnd].priority == groupPriority) {
+      ++groupEnd;
+    }
+    // Reclaims round robin from the group until the target is met or a round
+    // frees nothing.
+    for (;;) {
+      uint64_t roundFreedBytes{0};
+      for (auto i = groupStart; i < groupEnd; ++i) {
+        if (candidates[i].reclaimableBytes == 0) {
+          continue;
+        }
+        const uint64_t bytesToReclaim =
+            std::min(targetBytes - freedBytes, memoryPoolTransferCapacity_);
+        const uint64_t reclaimedBytes =
+            reclaimUsedMemory(requestor, candidates[i], bytesToReclaim);
+        if (reclaimedBytes == 0) {
+          candidates[i].reclaimableBytes = 0;
+        }
+        roundFreedBytes += reclaimedBytes;
+        freedBytes += reclaimedBytes;
+        if ((freedBytes >= targetBytes) || requestor->aborted()) {
+          return freedBytes;
+        }
+      }
+      if (roundFreedBytes == 0) {
+        break;
+      }
+    }
+    groupStart = groupEnd;
+  }
+  return freedBytes;
+}
+
+uint64_t SharedArbitrator::reclaimUsedMemory(
+    MemoryPool* requestor,
+    const Candidate& candidate,
+    uint64_t targetBytes) {
+  ++numReclaims_;
+  if (candidate.priority < priority(*requestor)) {
+    ++numPriorityReclaims_;
+  }
+  return reclaim(candidate.pool, targetBytes);
+}
+
 uint64_t SharedArbitrator::reclaim(
     MemoryPool* pool,
     uint64_t targetBytes) noexcept {
@@ -473,13 +628,21 @@ void SharedArbitrator::incrementFreeCapacity(uint64_t bytes) {
 
 void SharedArbitrator::incrementFreeCapacityLocked(uint64_t bytes) {
   freeCapacity_ += bytes;
-  if (FOLLY_UNLIKELY(freeCapacity_ > capacity_)) {
+  if (FOLLY_UNLIKELY(freeCapacity_ + withheldCapacity_ > capacity_)) {
     VELOX_FAIL(
         "The free capacity {} is larger than the max capacity {}, {}",
-        succinctBytes(freeCapacity_),
+        succinctBytes(freeCapacity_ + withheldCapacity_),
         succinctBytes(capacity_),
         toStringLocked());
   }
+  withholdFreeCapacityLocked();
+}
+
+void SharedArbitrator::withholdFreeCapacityLocked() {
+  const uint64_t bytesToWithhold = std::min(
+      freeCapacity_, capacity_ - capacityLimit_ - withheldCapacity_);
+  freeCapacity_ -= bytesToWithhold;
+  withheldCapacity_ += bytesToWithhold;
 }
 
 MemoryArbitrator::Stats SharedArbitrator::stats() const {
@@ -503,6 +666,8 @@ MemoryArbitrator::Stats SharedArbitrator::statsLocked() const {
   stats.numNonReclaimableAttempts = numNonReclaimableAttempts_;
   stats.numReserveRequest = numReserveRequest_;
   stats.numReleaseRequest = numReleaseRequest_;
+  stats.numReclaims = numReclaims_;
+  stats.numPriorityReclaims = numPriorityReclaims_;
   return stats;
 }
 
@@ -513,9 +678,12 @@ std::string SharedArbitrator::toString() const {
 
 std::string SharedArbitrator::toStringLocked() const {
   return fmt::format(
-      "ARBITRATOR[{} CAPACITY[{}] {}]",
+      "ARBITRATOR[{} CAPACITY[{}]{} {}]",
       kind_,
       succinctBytes(capacity_),
+      capacityLimit_ < capacity_
+          ? fmt::format(" CAPACITY_LIMIT[{}]", succinctBytes(capacityLimit_))
+          : "",
       statsLocked().toString());
 }
 
@@ -539,20 +707,26 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
       std::chrono::duration_cast<std::chrono::microseconds>(
           std::chrono::steady_clock::now() - startTime_);
   arbitrator_->arbitrationTimeUs_ += arbitrationTime.count();
+  arbitrationTimeMs().add(arbitrationTime.count() / 1'000);
   arbitrator_->finishArbitration();
 }
 
 void SharedArbitrator::startArbitration(MemoryPool* requestor) {
-  requestor->enterArbitration();
+  if (requestor != nullptr) {
+    requestor->enterArbitration();
+  }
   ContinueFuture waitPromise{ContinueFuture::makeEmpty()};
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++numRequests_;
     if (running_) {
-      waitPromises_.emplace_back(fmt::format(
-          "Wait for arbitration, requestor: {}[{}]",
-          requestor->name(),
-          requestor->root()->name()));
+      waitPromises_.emplace_back(
+          requestor == nullptr
+              ? std::string("Wait for arbitration, shrink memory")
+              : fmt::format(
+                    "Wait for arbitration, requestor: {}[{}]",
+                    requestor->name(),
+                    requestor->root()->name()));
       waitPromise = waitPromises_.back().getSemiFuture();
     } else {
       VELOX_CHECK(waitPromises_.empty());
@@ -570,11 +744,13 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
       waitPromise.wait();
     }
     queueTimeUs_ += waitTimeUs;
+    arbitrationQueueTimeMs().add(waitTimeUs / 1'000);
   }
 }
 
 void SharedArbitrator::finishArbitration() {
   ContinuePromise resumePromise{ContinuePromise::makeEmpty()};
+  std::vector<ContinuePromise> finishPromises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(running_);
@@ -583,11 +759,25 @@ void SharedArbitrator::finishArbitration() {
       waitPromises_.pop_back();
     } else {
       running_ = false;
+      finishPromises.swap(finishPromises_);
     }
   }
   if (resumePromise.valid()) {
     resumePromise.setValue();
   }
+  for (auto& promise : finishPromises) {
+    promise.setValue();
+  }
+}
+
+bool SharedArbitrator::arbitrationInProgress(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!running_) {
+    return false;
+  }
+  finishPromises_.emplace_back("Wait for memory arbitration to finish");
+  *future = finishPromises_.back().getSemiFuture();
+  return true;
 }
 
 std::string SharedArbitrator::kind() const {
@@ -52,14 +52,23 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
       uint64_t targetBytes) final;
 
+  /// Frees up to 'targetBytes' of capacity from 'pools', first by shrinking
+  /// their free capacity and then by reclaiming their used memory. The
+  /// reclaim is serialized with the other arbitration requests.
   uint64_t shrinkMemory(
-      const std::vector<std::shared_ptr<MemoryPool>>& /*unused*/,
-      uint64_t /*unused*/) override final {
-    VELOX_NYI("shrinkMemory is not supported by SharedArbitrator");
+      const std::vector<std::shared_ptr<MemoryPool>>& pools,
+      uint64_t targetBytes) final;
+
+  uint64_t capacityLimit() const final {
+    return capacityLimit_;
   }
 
+  void setCapacityLimit(uint64_t limitBytes) final;
+
   Stats stats() const final;
 
+  bool arbitrationInProgress(ContinueFuture* future) final;
+
   std::string kind() const override;
 
   std::string toString() const final;
@@ -70,6 +79,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    int32_t priority{0};
 
     std::string toString() const;
   };
@@ -128,7 +138,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   // Invoked to start next memory arbitration request, and it will wait for the
   // serialized execution if there is a running or other waiting arbitration
-  // requests.
+  // requests. 'requestor' is null for a shrinkMemory() request.
   void startArbitration(MemoryPool* requestor);
 
   // Invoked by a finished memory arbitration request to kick off the next
@@ -153,6 +163,22 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
+  // Invoked to reclaim used memory capacity from 'candidates' in rounds of up
+  // to 'memoryPoolTransferCapacity_' per candidate. The candidates of the
+  // lowest priority are reclaimed from first. 'candidates' must be sorted by
+  // sortCandidatesByReclaimableMemory().
+  uint64_t reclaimUsedMemoryIncrementally(
+      MemoryPool* requestor,
+      std::vector<Candidate>& candidates,
+      uint64_t targetBytes);
+
+  // Invoked to reclaim used memory from 'candidate' on behalf of 'requestor'
+  // and to record the reclaim decision in stats.
+  uint64_t reclaimUsedMemory(
+      MemoryPool* requestor,
+      const Candidate& candidate,
+      uint64_t targetBytes);
+
   // Invoked to reclaim used memory from 'pool' with specified 'targetBytes'.
   // The function returns the actually freed capacity.
   uint64_t reclaim(MemoryPool* pool, uint64_t targetBytes) noexcept;
@@ -180,12 +206,21 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void incrementFreeCapacity(uint64_t bytes);
   void incrementFreeCapacityLocked(uint64_t bytes);
 
+  // Moves free capacity to 'withheldCapacity_' until the free and allocated
+  // capacity is within 'capacityLimit_'.
+  void withholdFreeCapacityLocked();
+
   std::string toStringLocked() const;
 
   Stats statsLocked() const;
 
   mutable std::mutex mutex_;
   uint64_t freeCapacity_{0};
+  // The capacity available for arbitration. Set by setCapacityLimit().
+  tsan_atomic<uint64_t> capacityLimit_;
+  // The capacity taken out of 'freeCapacity_' to enforce 'capacityLimit_'. At
+  // most 'capacity_' - 'capacityLimit_'.
+  uint64_t withheldCapacity_{0};
   // Indicates if there is a running arbitration request or not.
   bool running_{false};
 
@@ -193,6 +228,10 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // execution.
   std::vector<ContinuePromise> waitPromises_;
 
+  // The promises of the callers of arbitrationInProgress() waiting for the
+  // running and waiting arbitration requests to finish.
+  std::vector<ContinuePromise> finishPromises_;
+
   tsan_atomic<uint64_t> numRequests_{0};
   std::atomic<uint64_t> numSucceeded_{0};
   tsan_atomic<uint64_t> numAborted_{0};
@@ -205,5 +244,7 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   tsan_atomic<uint64_t> numNonReclaimableAttempts_{0};
   tsan_atomic<uint64_t> numReserveRequest_{0};
   tsan_atomic<uint64_t> numReleaseRequest_{0};
+  tsan_atomic<uint64_t> numReclaims_{0};
+  tsan_atomic<uint64_t> numPriorityReclaims_{0};
 };
 } // namespace facebook::velox::exec
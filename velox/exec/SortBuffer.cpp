@@ -16,6 +16,8 @@
 
 #include "SortBuffer.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/common/base/AsyncSource.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/vector/BaseVector.h"
 
 namespace facebook::velox::exec {
@@ -29,7 +31,9 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     uint32_t* numSpillRuns,
     const common::SpillConfig* spillConfig,
-    uint64_t spillMemoryThreshold)
+    uint64_t spillMemoryThreshold,
+    folly::Executor* executor,
+    int32_t sortParallelism)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       outputBatchSize_(outputBatchSize),
@@ -37,7 +41,9 @@ SortBuffer::SortBuffer(
       nonReclaimableSection_(nonReclaimableSection),
       numSpillRuns_(numSpillRuns),
       spillConfig_(spillConfig),
-      spillMemoryThreshold_(spillMemoryThreshold) {
+      spillMemoryThreshold_(spillMemoryThreshold),
+      executor_(executor),
+      sortParallelism_(sortParallelism) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -118,19 +124,7 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    sortInParallel();
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -144,7 +138,8 @@ void SortBuffer::noMoreInput() {
     VELOX_CHECK_LE(spiller_->stats().spilledPartitions, 1);
 
     VELOX_CHECK_NULL(spillMerger_);
-    spillMerger_ = spiller_->startMerge();
+    spillMerger_ = spiller_->startMerge(
+        spillConfig_->readAheadBuffers, spillConfig_->maxReadAheadBytes);
     spillSources_.resize(outputBatchSize_);
     spillSourceRows_.resize(outputBatchSize_);
   }
@@ -187,7 +182,9 @@ void SortBuffer::spill() {
         spillConfig_->writeBufferSize,
         spillConfig_->compressionKind,
         memory::spillMemoryPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->fileFormat,
+        spillConfig_->adaptiveCompression);
     VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   }
 
@@ -280,6 +277,176 @@ void SortBuffer::prepareOutput() {
   }
 }
 
+bool SortBuffer::lessThan(const char* lhs, const char* rhs) const {
+  for (vector_size_t index = 0; index < sortCompareFlags_.size(); ++index) {
+    if (auto result =
+            data_->compare(lhs, rhs, index, sortCompareFlags_[index])) {
+      return result < 0;
+    }
+  }
+  return false;
+}
+
+void SortBuffer::sortRows(char** rows, size_t numRows) {
+  if (!PrefixSort::sort(
+          data_.get(),
+          sortCompareFlags_.size(),
+          sortCompareFlags_,
+          rows,
+          numRows,
+          pool_)) {
+    std::sort(rows, rows + numRows, [this](const char* lhs, const char* rhs) {
+      return lessThan(lhs, rhs);
+    });
+  }
+}
+
+namespace {
+
+// Runs 'tasks' on 'executor' and waits for them. The tasks that did not start
+// on the executor run on the calling thread. Rethrows the first error after
+// all the tasks are done.
+void runTasks(
+    std::vector<std::function<void()>> tasks,
+    folly::Executor* executor) {
+  std::vector<std::shared_ptr<AsyncSource<bool>>> sources;
+  sources.reserve(tasks.size());
+  for (auto& task : tasks) {
+    auto source =
+        std::make_shared<AsyncSource<bool>>([task = std::move(task)]() {
+          task();
+          return std::make_unique<bool>(true);
+        });
+    executor->add([source]() { source->prepare(); });
+    sources.push_back(std::move(source));
+  }
+  std::exception_ptr error;
+  for (auto& source : sources) {
+    try {
+      source->move();
+    } catch (const std::exception&) {
+      if (error == nullptr) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Returns the number of rows of the sorted 'left' run among the first
+// 'numOutput' rows of the stable merge of 'left' and 'right'.
+template <typename Less>
+size_t mergePathSplit(
+    char* const* left,
+    size_t numLeft,
+    char* const* right,
+    size_t numRight,
+    size_t numOutput,
+    Less less) {
+  size_t low = numOutput > numRight ? numOutput - numRight : 0;
+  size_t high = std::min(numOutput, numLeft);
+  while (low < high) {
+    const auto i = low + (high - low) / 2;
+    const auto j = numOutput - i;
+    if (j > 0 && !less(right[j - 1], left[i])) {
+      // left[i] does not sort after right[j - 1], so it is merged before.
+      low = i + 1;
+    } else {
+      high = i;
+    }
+  }
+  return low;
+}
+
+} // namespace
+
+void SortBuffer::sortInParallel() {
+  const auto numRows = sortedRows_.size();
+  const auto numRuns = std::min<size_t>(
+      std::max<int32_t>(sortParallelism_, 1), numRows / kMinParallelSortRows);
+  if (executor_ == nullptr || numRuns <= 1) {
+    sortRows(sortedRows_.data(), numRows);
+    return;
+  }
+
+  // Sorts runs of the same size concurrently.
+  std::vector<size_t> runStarts;
+  runStarts.reserve(numRuns + 1);
+  std::vector<std::function<void()>> tasks;
+  for (auto i = 0; i < numRuns; ++i) {
+    const auto begin = numRows * i / numRuns;
+    const auto end = numRows * (i + 1) / numRuns;
+    runStarts.push_back(begin);
+    tasks.push_back([this, begin, end]() {
+      sortRows(sortedRows_.data() + begin, end - begin);
+    });
+  }
+  runStarts.push_back(numRows);
+  runTasks(std::move(tasks), executor_);
+
+  // Merges adjacent runs pairwise until one run is left. Each merge is split
+  // into segments of about the same number of output rows so that all the
+  // threads are busy when few runs are left.
+  auto less = [this](const char* lhs, const char* rhs) {
+    return lessThan(lhs, rhs);
+  };
+  std::vector<char*> buffer(numRows);
+  char** source = sortedRows_.data();
+  char** target = buffer.data();
+  while (runStarts.size() > 2) {
+    const auto numMerges = (runStarts.size() - 1) / 2;
+    const auto numSegments =
+        std::max<size_t>(1, (sortParallelism_ + numMerges - 1) / numMerges);
+    std::vector<size_t> mergedRunStarts;
+    tasks.clear();
+    for (auto i = 0; i + 1 < runStarts.size(); i += 2) {
+      const auto begin = runStarts[i];
+      mergedRunStarts.push_back(begin);
+      if (i + 2 == runStarts.size()) {
+        // The last run has no run to merge with.
+        const auto end = runStarts[i + 1];
+        tasks.push_back([source, target, begin, end]() {
+          std::copy(source + begin, source + end, target + begin);
+        });
+        continue;
+      }
+      const auto middle = runStarts[i + 1];
+      const auto end = runStarts[i + 2];
+      auto* left = source + begin;
+      auto* right = source + middle;
+      const auto numLeft = middle - begin;
+      const auto numRight = end - middle;
+      for (auto segment = 0; segment < numSegments; ++segment) {
+        const auto outputBegin = (end - begin) * segment / numSegments;
+        const auto outputEnd = (end - begin) * (segment + 1) / numSegments;
+        tasks.push_back([=]() {
+          const auto leftBegin = mergePathSplit(
+              left, numLeft, right, numRight, outputBegin, less);
+          const auto leftEnd =
+              mergePathSplit(left, numLeft, right, numRight, outputEnd, less);
+          std::merge(
+              left + leftBegin,
+              left + leftEnd,
+              right + (outputBegin - leftBegin),
+              right + (outputEnd - leftEnd),
+              target + begin + outputBegin,
+              less);
+        });
+      }
+    }
+    mergedRunStarts.push_back(numRows);
+    runTasks(std::move(tasks), executor_);
+    tasks.clear();
+    runStarts = std::move(mergedRunStarts);
+    std::swap(source, target);
+  }
+  if (source != sortedRows_.data()) {
+    sortedRows_.swap(buffer);
+  }
+}
+
 void SortBuffer::getOutputWithoutSpill() {
   VELOX_CHECK_GT(output_->size(), 0);
   VELOX_DCHECK_LE(output_->size(), outputBatchSize_);
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
@@ -28,6 +30,9 @@ namespace facebook::velox::exec {
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
 /// limit.
+///
+/// With an executor and a sort parallelism above 1, the in-memory rows are
+/// split into runs that are sorted concurrently and then merged in parallel.
 class SortBuffer {
  public:
   SortBuffer(
@@ -39,7 +44,9 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       uint32_t* numSpillRuns,
       const common::SpillConfig* spillConfig = nullptr,
-      uint64_t spillMemoryThreshold = 0);
+      uint64_t spillMemoryThreshold = 0,
+      folly::Executor* executor = nullptr,
+      int32_t sortParallelism = 1);
 
   void addInput(const VectorPtr& input);
 
@@ -72,6 +79,10 @@ class SortBuffer {
     return spiller_->stats();
   }
 
+  /// Minimum number of rows per run for the in-memory rows to be sorted in
+  /// parallel.
+  static constexpr size_t kMinParallelSortRows = 16 << 10;
+
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
@@ -80,6 +91,18 @@ class SortBuffer {
   void getOutputWithoutSpill();
   void getOutputWithSpill();
 
+  // Returns true if 'lhs' sorts before 'rhs'.
+  bool lessThan(const char* lhs, const char* rhs) const;
+
+  // Sorts 'numRows' 'rows' of 'data_' on the driver thread.
+  void sortRows(char** rows, size_t numRows);
+
+  // Sorts 'sortedRows_' on 'executor_' with up to 'sortParallelism_' threads
+  // if there are enough rows, or on the driver thread otherwise. The runs
+  // sorted by each thread are merged pairwise, and each merge is split into
+  // segments of equal size that are merged concurrently.
+  void sortInParallel();
+
   const RowTypePtr input_;
   const std::vector<CompareFlags> sortCompareFlags_;
   // Maximum number of rows to return in one output batch.
@@ -97,6 +120,10 @@ class SortBuffer {
   //
   // NOTE: 'spillMemoryThreshold_' only applies if disk spilling is enabled.
   const uint64_t spillMemoryThreshold_;
+  // Runs the sorts and merges of the in-memory rows if 'sortParallelism_' is
+  // above 1.
+  folly::Executor* const executor_;
+  const int32_t sortParallelism_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
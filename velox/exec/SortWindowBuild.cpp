@@ -16,10 +16,15 @@
 
 #include "velox/exec/SortWindowBuild.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/SpilledWindowPartition.h"
 
 namespace facebook::velox::exec {
 
 namespace {
+// Number of rows of a partition read from spilled data between the checks
+// whether the partition fits in memory.
+constexpr vector_size_t kPartitionSpillCheckRows = 1024;
+
 std::vector<CompareFlags> makeSpillCompareFlags(
     int32_t numPartitionKeys,
     const std::vector<core::SortOrder>& sortingOrders) {
@@ -143,7 +148,9 @@ void SortWindowBuild::setupSpiller() {
       spillConfig_->writeBufferSize,
       spillConfig_->compressionKind,
       memory::spillMemoryPool(),
-      spillConfig_->executor);
+      spillConfig_->executor,
+      spillConfig_->fileFormat,
+      spillConfig_->adaptiveCompression);
 }
 
 void SortWindowBuild::spill() {
@@ -211,7 +218,8 @@ void SortWindowBuild::noMoreInput() {
     spill();
 
     spiller_->finalizeSpill();
-    merge_ = spiller_->startMerge();
+    merge_ = spiller_->startMerge(
+        spillConfig_->readAheadBuffers, spillConfig_->maxReadAheadBytes);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -225,6 +233,7 @@ void SortWindowBuild::noMoreInput() {
 void SortWindowBuild::loadNextPartitionFromSpill() {
   sortedRows_.clear();
   data_->clear();
+  numSpilledPartitionRows_ = 0;
 
   for (;;) {
     auto next = merge_->next();
@@ -260,11 +269,105 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
     }
     sortedRows_.push_back(newRow);
     next->pop();
+
+    if (spilledPartitionsEnabled_ &&
+        sortedRows_.size() % kPartitionSpillCheckRows == 0 &&
+        !ensurePartitionFits()) {
+      // Keeps the last row to compare with the partition keys of the next
+      // row.
+      spillPartitionRows(sortedRows_.size() - 1);
+    }
+  }
+
+  if (partitionSpillState_ != nullptr) {
+    spillPartitionRows(sortedRows_.size());
+    partitionSpillState_->finishWrite(0);
+    spilledPartitionFiles_ = partitionSpillState_->files(0);
+    partitionSpillState_.reset();
+  }
+}
+
+bool SortWindowBuild::ensurePartitionFits() {
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct > 0) {
+    return false;
+  }
+
+  const auto currentUsage = data_->pool()->currentBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  if (data_->pool()->availableReservation() >= minReservationBytes) {
+    return true;
+  }
+
+  const auto targetIncrementBytes =
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100;
+  ReclaimableSectionGuard guard(nonReclaimableSection_);
+  return data_->pool()->maybeReserve(targetIncrementBytes);
+}
+
+void SortWindowBuild::spillPartitionRows(vector_size_t numRows) {
+  if (partitionSpillState_ == nullptr) {
+    partitionSpillState_ = std::make_unique<SpillState>(
+        spillConfig_->filePath,
+        1,
+        0,
+        std::vector<CompareFlags>{},
+        spillConfig_->maxFileSize,
+        spillConfig_->writeBufferSize,
+        spillConfig_->compressionKind,
+        memory::spillMemoryPool(),
+        &partitionSpillStats_,
+        spillConfig_->executor,
+        spillConfig_->fileFormat,
+        spillConfig_->adaptiveCompression);
+    partitionSpillState_->setPartitionSpilled(0);
+  }
+
+  RowVectorPtr rows;
+  for (vector_size_t offset = 0; offset < numRows;
+       offset += kPartitionSpillCheckRows) {
+    const auto numBatchRows =
+        std::min(kPartitionSpillCheckRows, numRows - offset);
+    if (rows == nullptr) {
+      rows = BaseVector::create<RowVector>(
+          inputType_, numBatchRows, memory::spillMemoryPool());
+    } else {
+      rows->prepareForReuse();
+      rows->resize(numBatchRows);
+    }
+    for (auto i = 0; i < inputType_->size(); ++i) {
+      data_->extractColumn(
+          sortedRows_.data() + offset, numBatchRows, i, rows->childAt(i));
+    }
+    partitionSpillState_->appendToPartition(0, rows);
   }
+
+  data_->eraseRows(folly::Range(sortedRows_.data(), numRows));
+  sortedRows_.erase(sortedRows_.begin(), sortedRows_.begin() + numRows);
+  numSpilledPartitionRows_ += numRows;
+}
+
+std::optional<SpillStats> SortWindowBuild::takePartitionSpillStats() {
+  auto lockedStats = partitionSpillStats_.wlock();
+  if (lockedStats->empty()) {
+    return std::nullopt;
+  }
+  auto stats = *lockedStats;
+  lockedStats->reset();
+  return stats;
 }
 
 std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
   if (merge_ != nullptr) {
+    if (numSpilledPartitionRows_ > 0) {
+      return std::make_unique<SpilledWindowPartition>(
+          data_.get(),
+          std::move(spilledPartitionFiles_),
+          numSpilledPartitionRows_,
+          inputColumns_,
+          sortKeyInfo_);
+    }
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
     return std::make_unique<WindowPartition>(
@@ -292,7 +395,7 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
 bool SortWindowBuild::hasNextPartition() {
   if (merge_ != nullptr) {
     loadNextPartitionFromSpill();
-    return !sortedRows_.empty();
+    return !sortedRows_.empty() || numSpilledPartitionRows_ > 0;
   }
 
   return partitionStartRows_.size() > 0 &&
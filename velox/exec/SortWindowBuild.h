@@ -48,12 +48,24 @@ class SortWindowBuild : public WindowBuild {
     return spiller_->stats();
   }
 
+  void enableSpilledPartitions() override {
+    spilledPartitionsEnabled_ = spillConfig_ != nullptr;
+  }
+
+  std::optional<SpillStats> takePartitionSpillStats() override;
+
   void noMoreInput() override;
 
   bool hasNextPartition() override;
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  /// Partitions are ranges of 'sortedRows_' unless the input was spilled, in
+  /// which case each partition is read into 'data_' in turn.
+  bool concurrentPartitions() const override {
+    return merge_ == nullptr;
+  }
+
  private:
   void ensureInputFits(const RowVectorPtr& input);
 
@@ -70,8 +82,18 @@ class SortWindowBuild : public WindowBuild {
   void computePartitionStartRows();
 
   // Reads next partition from spilled data into 'data_' and 'sortedRows_'.
+  // If spilled partitions are enabled and the partition does not fit in
+  // memory, writes the partition rows to 'spilledPartitionFiles_' instead.
   void loadNextPartitionFromSpill();
 
+  // Returns true if there is memory to load more rows of the current
+  // partition from the merged spill data.
+  bool ensurePartitionFits();
+
+  // Writes the first 'numRows' rows of 'sortedRows_' to the spill files of
+  // the current partition and removes them from 'data_'.
+  void spillPartitionRows(vector_size_t numRows);
+
   const size_t numPartitionKeys_;
 
   // Compare flags for partition and sorting keys. Compare flags for partition
@@ -107,6 +129,22 @@ class SortWindowBuild : public WindowBuild {
 
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // True if partitions read from 'merge_' that do not fit in memory are
+  // returned as SpilledWindowPartitions.
+  bool spilledPartitionsEnabled_{false};
+
+  // Spills the rows of the partition being read from 'merge_'. Set when the
+  // partition does not fit in memory.
+  std::unique_ptr<SpillState> partitionSpillState_;
+
+  // The spill files and the number of rows of the spilled partition read by
+  // the last loadNextPartitionFromSpill().
+  SpillFiles spilledPartitionFiles_;
+  vector_size_t numSpilledPartitionRows_{0};
+
+  // Stats of 'partitionSpillState_'.
+  folly::Synchronized<SpillStats> partitionSpillStats_;
 };
 
 } // namespace facebook::velox::exec
@@ -91,8 +91,10 @@ SortedAggregations::SortedAggregations(
 
   inputMapping_.resize(inputType->size());
 
+  std::vector<std::string> names;
   std::vector<TypePtr> types;
   for (auto input : allInputs) {
+    names.push_back(inputType->nameOf(input));
     types.push_back(inputType->childAt(input));
 
     inputMapping_[input] = inputs_.size();
@@ -100,6 +102,7 @@ SortedAggregations::SortedAggregations(
   }
 
   inputData_ = std::make_unique<RowContainer>(types, pool);
+  inputRowType_ = ROW(std::move(names), std::move(types));
   decodedInputs_.resize(inputs_.size());
 
   for (auto& aggregate : aggregates) {
@@ -127,8 +130,8 @@ Accumulator SortedAggregations::accumulator() const {
       sizeof(RowPointers),
       false,
       1,
-      [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
-        VELOX_UNREACHABLE();
+      [this](folly::Range<char**> groups, VectorPtr& result) {
+        extractForSpill(groups, result);
       },
       [this](folly::Range<char**> groups) {
         for (auto* group : groups) {
@@ -138,6 +141,42 @@ Accumulator SortedAggregations::accumulator() const {
       }};
 }
 
+TypePtr SortedAggregations::spillType() const {
+  return ARRAY(inputRowType_);
+}
+
+void SortedAggregations::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  auto* arrayVector = result->as<ArrayVector>();
+  VELOX_CHECK_NOT_NULL(arrayVector);
+  arrayVector->resize(groups.size());
+
+  auto* rawOffsets =
+      arrayVector->mutableOffsets(groups.size())->asMutable<vector_size_t>();
+  auto* rawSizes =
+      arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+  std::vector<char*> allRows;
+  for (auto i = 0; i < groups.size(); ++i) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
+    arrayVector->setNull(i, false);
+    rawOffsets[i] = allRows.size();
+    rawSizes[i] = accumulator->size;
+    if (accumulator->size > 0) {
+      auto groupRows = accumulator->read(*allocator_);
+      allRows.insert(allRows.end(), groupRows.begin(), groupRows.end());
+    }
+  }
+
+  auto* elements = arrayVector->elements()->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(elements);
+  elements->resize(allRows.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputData_->extractColumn(
+        allRows.data(), allRows.size(), i, elements->childAt(i));
+  }
+}
+
 void SortedAggregations::initializeNewGroups(
     char** groups,
     folly::Range<const vector_size_t*> indices) {
@@ -195,6 +234,35 @@ void SortedAggregations::addSingleGroupInput(
   }
 }
 
+void SortedAggregations::addSingleGroupSpillInput(
+    char* group,
+    const VectorPtr& input,
+    vector_size_t index) {
+  auto* arrayVector = input->as<ArrayVector>();
+  VELOX_CHECK_NOT_NULL(arrayVector);
+  auto* elements = arrayVector->elements()->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(elements);
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    decodedInputs_[i].decode(*elements->childAt(i));
+  }
+
+  const auto offset = arrayVector->offsetAt(index);
+  const auto size = arrayVector->sizeAt(index);
+  for (auto row = offset; row < offset + size; ++row) {
+    char* newRow = inputData_->newRow();
+
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      inputData_->store(decodedInputs_[i], row, newRow, i);
+    }
+
+    addNewRow(group, newRow);
+  }
+}
+
+void SortedAggregations::clear() {
+  inputData_->clear();
+}
+
 bool SortedAggregations::compareRowsWithKeys(
     const char* lhs,
     const char* rhs,
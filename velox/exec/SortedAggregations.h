@@ -38,6 +38,10 @@ class SortedAggregations {
   /// Returns metadata about the accumulator used to store lists of input rows.
   Accumulator accumulator() const;
 
+  /// Returns the type of the accumulator when spilled: an array of the input
+  /// rows of a group.
+  TypePtr spillType() const;
+
   /// Aggregate-like APIs to aggregate input rows per group.
   void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
@@ -62,8 +66,19 @@ class SortedAggregations {
 
   void addSingleGroupInput(char* group, const RowVectorPtr& input);
 
+  /// Adds the input rows of a spilled accumulator to 'group'. 'input' is an
+  /// array vector of spillType() and 'index' is the row to add.
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index);
+
   void noMoreInput();
 
+  /// Frees the input rows of all groups. Called after the groups have been
+  /// spilled or extracted and cleared from their row container.
+  void clear();
+
   /// Sorts input row for the specified groups, computes aggregations and stores
   /// results in the specified 'result' vector.
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result);
@@ -71,6 +86,8 @@ class SortedAggregations {
  private:
   void addNewRow(char* group, char* newRow);
 
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
+
   // A list of sorting keys along with sorting orders.
   using SortingSpec = std::vector<std::pair<column_index_t, core::SortOrder>>;
 
@@ -126,6 +143,9 @@ class SortedAggregations {
   // Indices of all inputs for all aggregates.
   std::vector<column_index_t> inputs_;
 
+  // Type of the rows in 'inputData_'.
+  RowTypePtr inputRowType_;
+
   // Stores all input rows for all groups.
   std::unique_ptr<RowContainer> inputData_;
 
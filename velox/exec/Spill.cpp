@@ -15,9 +15,13 @@
  */
 
 #include "velox/exec/Spill.h"
+#include <folly/ScopeGuard.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/row/CompactRow.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -31,6 +35,14 @@ namespace {
 // preserves precision.
 static const bool kDefaultUseLosslessTimestamp = true;
 
+// The max byte size of the buffer used for reading a spill file.
+constexpr uint64_t kMaxReadBufferSize =
+    (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+
+// The byte size of the rows read in one batch from a spill file in
+// CompactRow format.
+constexpr uint64_t kMaxCompactRowBatchSize = 1 << 20;
+
 std::vector<folly::Synchronized<SpillStats>>& allSpillStats() {
   static std::vector<folly::Synchronized<SpillStats>> spillStatsList(
       std::thread::hardware_concurrency());
@@ -46,12 +58,70 @@ folly::Synchronized<SpillStats>& localSpillStats() {
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
+SpillInput::~SpillInput() {
+  // The pending reads reference 'input_' and must finish before destruction.
+  for (auto& read : readAheads_) {
+    try {
+      read->move();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to read spill file: " << e.what();
+    }
+  }
+}
+
 void SpillInput::next(bool /*throwIfPastEnd*/) {
-  int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+  if (numReadAheadBuffers_ == 0) {
+    int32_t readBytes =
+        std::min(input_->size() - offset_, buffer_->capacity());
+    VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+    setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
+    {
+      MicrosecondTimer timer(&readWaitTimeUs_);
+      input_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    }
+    offset_ += readBytes;
+    return;
+  }
+
+  // The consumed 'buffer_' is reused for the next read.
+  freeBuffer_ = std::move(buffer_);
+  if (readAheads_.empty()) {
+    scheduleReadAhead();
+  }
+  VELOX_CHECK(!readAheads_.empty(), "Reading past end of spill file");
+  auto read = std::move(readAheads_.front());
+  readAheads_.pop_front();
+  // Reads on this thread if 'readExecutor_' has not started the read.
+  std::unique_ptr<BufferPtr> buffer;
+  {
+    MicrosecondTimer timer(&readWaitTimeUs_);
+    buffer = read->move();
+  }
+  VELOX_CHECK_NOT_NULL(buffer);
+  buffer_ = std::move(*buffer);
+  const int32_t readBytes = buffer_->size();
   setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  input_->pread(offset_, readBytes, buffer_->asMutable<char>());
   offset_ += readBytes;
+  scheduleReadAhead();
+}
+
+void SpillInput::scheduleReadAhead() {
+  while (readAheads_.size() < numReadAheadBuffers_ &&
+         readAheadOffset_ < size_) {
+    const auto readBytes = std::min(size_ - readAheadOffset_, readBufferSize_);
+    BufferPtr buffer = freeBuffer_ != nullptr
+        ? std::move(freeBuffer_)
+        : AlignedBuffer::allocate<char>(readBufferSize_, pool_);
+    buffer->setSize(readBytes);
+    auto read = std::make_shared<AsyncSource<BufferPtr>>(
+        [input = input_.get(), buffer, offset = readAheadOffset_]() {
+          input->pread(offset, buffer->size(), buffer->asMutable<char>());
+          return std::make_unique<BufferPtr>(buffer);
+        });
+    readExecutor_->add([read]() { read->prepare(); });
+    readAheads_.push_back(std::move(read));
+    readAheadOffset_ += readBytes;
+  }
 }
 
 void SpillMergeStream::pop() {
@@ -102,7 +172,8 @@ SpillFile::SpillFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     const std::string& path,
     common::CompressionKind compressionKind,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    common::SpillFileFormat fileFormat)
     : id_(id),
       type_(std::move(type)),
       numSortingKeys_(numSortingKeys),
@@ -110,11 +181,15 @@ SpillFile::SpillFile(
       ordinal_(ordinalCounter_++),
       path_(fmt::format("{}-{}", path, ordinal_)),
       compressionKind_(compressionKind),
-      pool_(pool) {
+      pool_(pool),
+      fileFormat_(fileFormat) {
   // NOTE: if the spilling operator has specified the sort comparison flags,
   // then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortingKeys_);
+  VELOX_CHECK(
+      fileFormat_ == common::SpillFileFormat::kPresto ||
+      compressionKind_ == common::CompressionKind_NONE);
 }
 
 WriteFile& SpillFile::output() {
@@ -125,28 +200,169 @@ WriteFile& SpillFile::output() {
   return *output_;
 }
 
-void SpillFile::startRead() {
-  constexpr uint64_t kMaxReadBufferSize =
-      (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+uint64_t SpillFile::readBufferSize() const {
+  return std::min<uint64_t>(size(), kMaxReadBufferSize);
+}
+
+void SpillFile::startRead(
+    folly::Executor* readExecutor,
+    int32_t numReadAheadBuffers) {
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(fileSize_, kMaxReadBufferSize), pool_);
-  input_ = std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+  auto buffer = AlignedBuffer::allocate<char>(readBufferSize(), pool_);
+  input_ = std::make_unique<SpillInput>(
+      std::move(file), std::move(buffer), readExecutor, numReadAheadBuffers);
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
+    recordReadStats();
     return false;
   }
+  MicrosecondTimer timer(&readTimeUs_);
+  if (fileFormat_ == common::SpillFileFormat::kCompactRow) {
+    nextCompactRowBatch(rowVector);
+    return true;
+  }
   serializer::presto::PrestoVectorSerde::PrestoOptions options = {
       kDefaultUseLosslessTimestamp, compressionKind_};
   VectorStreamGroup::read(input_.get(), pool_, type_, &rowVector, &options);
   return true;
 }
 
+void SpillFile::recordReadStats() {
+  if (readStatsRecorded_) {
+    return;
+  }
+  readStatsRecorded_ = true;
+  const auto readWaitTimeUs = input_->readWaitTimeUs();
+  addThreadLocalRuntimeStat(
+      "spillReadTime",
+      RuntimeCounter(
+          readTimeUs_ * Timestamp::kNanosecondsInMicrosecond,
+          RuntimeCounter::Unit::kNanos));
+  addThreadLocalRuntimeStat(
+      "spillReadWaitTime",
+      RuntimeCounter(
+          readWaitTimeUs * Timestamp::kNanosecondsInMicrosecond,
+          RuntimeCounter::Unit::kNanos));
+  addThreadLocalRuntimeStat(
+      "spillReadBytes", RuntimeCounter(size(), RuntimeCounter::Unit::kBytes));
+  REPORT_ADD_STAT_VALUE(kCounterSpillReadTimeUs, readTimeUs_);
+  REPORT_ADD_STAT_VALUE(kCounterSpillReadWaitTimeUs, readWaitTimeUs);
+  REPORT_ADD_STAT_VALUE(kCounterSpillReadBytes, size());
+}
+
+void SpillFile::nextCompactRowBatch(RowVectorPtr& rowVector) {
+  // Copies whole rows with their size prefixes into 'compactRows_' as a row
+  // may straddle the read buffers of 'input_'.
+  uint64_t numBytes = 0;
+  while (numBytes < kMaxCompactRowBatchSize && !input_->atEnd()) {
+    const auto rowSize = input_->read<uint32_t>();
+    const uint64_t newNumBytes = numBytes + sizeof(uint32_t) + rowSize;
+    if (compactRows_ == nullptr) {
+      compactRows_ = AlignedBuffer::allocate<char>(
+          std::max(newNumBytes, kMaxCompactRowBatchSize), pool_);
+    } else if (compactRows_->capacity() < newNumBytes) {
+      AlignedBuffer::reallocate<char>(&compactRows_, newNumBytes);
+    }
+    auto* rawRows = compactRows_->asMutable<char>();
+    ::memcpy(rawRows + numBytes, &rowSize, sizeof(uint32_t));
+    input_->readBytes(rawRows + numBytes + sizeof(uint32_t), rowSize);
+    numBytes = newNumBytes;
+  }
+
+  compactRowViews_.clear();
+  const auto* rawRows = compactRows_->as<char>();
+  for (uint64_t offset = 0; offset < numBytes;) {
+    uint32_t rowSize;
+    ::memcpy(&rowSize, rawRows + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    compactRowViews_.emplace_back(rawRows + offset, rowSize);
+    offset += rowSize;
+  }
+  rowVector = row::CompactRow::deserialize(compactRowViews_, type_, pool_);
+}
+
+common::CompressionKind SpillCompressionSelector::select() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSelections_ < kCandidates.size()) {
+    return kCandidates[numSelections_++];
+  }
+  ++numSelections_;
+  int32_t selected = 0;
+  std::optional<double> selectedTimeUs;
+  for (int32_t i = 0; i < kCandidates.size(); ++i) {
+    const auto timeUs = estimateTimeUsPerByteLocked(i);
+    if (timeUs.has_value() &&
+        (!selectedTimeUs.has_value() ||
+         timeUs.value() < selectedTimeUs.value())) {
+      selected = i;
+      selectedTimeUs = timeUs;
+    }
+  }
+  return kCandidates[selected];
+}
+
+void SpillCompressionSelector::recordFlush(
+    common::CompressionKind kind,
+    uint64_t inputBytes,
+    uint64_t outputBytes,
+    uint64_t timeUs) {
+  const auto index = candidateIndex(kind);
+  if (index < 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& stats = codecStats_[index];
+  stats.inputBytes += inputBytes;
+  stats.outputBytes += outputBytes;
+  stats.timeUs += timeUs;
+}
+
+void SpillCompressionSelector::recordWrite(uint64_t bytes, uint64_t timeUs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  writtenBytes_ += bytes;
+  writeTimeUs_ += timeUs;
+}
+
+std::optional<double> SpillCompressionSelector::estimateTimeUsPerByte(
+    common::CompressionKind kind) {
+  const auto index = candidateIndex(kind);
+  VELOX_CHECK_GE(index, 0, "Unexpected compression kind {}", kind);
+  std::lock_guard<std::mutex> l(mutex_);
+  return estimateTimeUsPerByteLocked(index);
+}
+
+// static
+int32_t SpillCompressionSelector::candidateIndex(
+    common::CompressionKind kind) {
+  for (int32_t i = 0; i < kCandidates.size(); ++i) {
+    if (kCandidates[i] == kind) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+std::optional<double> SpillCompressionSelector::estimateTimeUsPerByteLocked(
+    int32_t candidate) const {
+  const auto& stats = codecStats_[candidate];
+  if (stats.inputBytes == 0) {
+    return std::nullopt;
+  }
+  const double flushTimeUs =
+      static_cast<double>(stats.timeUs) / stats.inputBytes;
+  const double writeTimeUs = writtenBytes_ == 0
+      ? 0
+      : static_cast<double>(writeTimeUs_) / writtenBytes_ *
+          stats.outputBytes / stats.inputBytes;
+  return asyncWrite_ ? std::max(flushTimeUs, writeTimeUs)
+                     : flushTimeUs + writeTimeUs;
+}
+
 SpillFileList::SpillFileList(
     const RowTypePtr& type,
     int32_t numSortingKeys,
@@ -156,7 +372,10 @@ SpillFileList::SpillFileList(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    common::SpillFileFormat fileFormat,
+    SpillCompressionSelector* compressionSelector)
     : type_(type),
       numSortingKeys_(numSortingKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -165,86 +384,232 @@ SpillFileList::SpillFileList(
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      writeExecutor_(writeExecutor),
+      fileFormat_(fileFormat),
+      compressionSelector_(compressionSelector),
+      batchCompressionKind_(compressionKind) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortingKeys_);
+  VELOX_CHECK(
+      fileFormat_ == common::SpillFileFormat::kPresto ||
+          compressionKind_ == common::CompressionKind_NONE,
+      "Spill compression is not supported with CompactRow spill files");
+  VELOX_CHECK(
+      fileFormat_ == common::SpillFileFormat::kPresto ||
+          compressionSelector_ == nullptr,
+      "Spill compression is not supported with CompactRow spill files");
+}
+
+SpillFileList::~SpillFileList() {
+  // The pending write references 'this' and must finish before destruction.
+  // An error is already reported to the caller if the write was waited for.
+  try {
+    waitForPendingWrite();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to write spill file: " << e.what();
+  }
 }
 
 WriteFile& SpillFileList::currentOutput() {
   if (files_.empty() || !files_.back()->isWritable() ||
-      files_.back()->size() > targetFileSize_) {
-    if (!files_.empty() && files_.back()->isWritable()) {
-      files_.back()->finishWrite();
-      updateSpilledFiles(files_.back()->size());
-    }
+      files_.back()->size() > targetFileSize_ ||
+      files_.back()->compressionKind() != batchCompressionKind_) {
+    finishCurrentFile();
     files_.push_back(std::make_unique<SpillFile>(
         nextFileId_++,
         type_,
         numSortingKeys_,
         sortCompareFlags_,
         fmt::format("{}-{}", path_, files_.size()),
-        compressionKind_,
-        pool_));
+        batchCompressionKind_,
+        pool_,
+        fileFormat_));
   }
   return files_.back()->output();
 }
 
+void SpillFileList::finishCurrentFile() {
+  if (!files_.empty() && files_.back()->isWritable()) {
+    uint64_t closeTimeUs{0};
+    {
+      MicrosecondTimer timer(&closeTimeUs);
+      files_.back()->finishWrite();
+    }
+    stats_->wlock()->spillFileCloseTimeUs += closeTimeUs;
+    updateGlobalSpillFileCloseTime(closeTimeUs);
+    updateSpilledFiles(
+        files_.back()->size(), files_.back()->compressionKind());
+  }
+}
+
 uint64_t SpillFileList::flush() {
-  uint64_t writtenBytes = 0;
-  if (batch_) {
+  std::unique_ptr<folly::IOBuf> iobuf;
+  uint64_t flushTimeUs{0};
+  if (fileFormat_ == common::SpillFileFormat::kCompactRow) {
+    if (compactRowsSize_ == 0) {
+      return 0;
+    }
+    // The rows are already serialized. Hands them over to the write without
+    // copying.
+    auto* rows = new BufferPtr(std::move(compactRows_));
+    iobuf = folly::IOBuf::takeOwnership(
+        (*rows)->asMutable<char>(),
+        compactRowsSize_,
+        [](void* /*unused*/, void* userData) {
+          delete static_cast<BufferPtr*>(userData);
+        },
+        rows);
+    compactRowsSize_ = 0;
+  } else {
+    if (batch_ == nullptr) {
+      return 0;
+    }
+    const uint64_t batchSize = batch_->size();
     IOBufOutputStream out(
-        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
-    uint64_t flushTimeUs{0};
+        *pool_, nullptr, std::max<int64_t>(64 * 1024, batchSize));
     {
       MicrosecondTimer timer(&flushTimeUs);
       batch_->flush(&out);
     }
-
     batch_.reset();
-    auto iobuf = out.getIOBuf();
-    auto& file = currentOutput();
-    uint64_t writeTimeUs{0};
-    uint32_t numDiskWrites{0};
-    {
-      MicrosecondTimer timer(&writeTimeUs);
-      for (auto& range : *iobuf) {
-        ++numDiskWrites;
-        file.append(std::string_view(
-            reinterpret_cast<const char*>(range.data()), range.size()));
-        writtenBytes += range.size();
-      }
+    iobuf = out.getIOBuf();
+    if (compressionSelector_ != nullptr) {
+      compressionSelector_->recordFlush(
+          batchCompressionKind_,
+          batchSize,
+          iobuf->computeChainDataLength(),
+          flushTimeUs);
     }
-    updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
+  }
+  // Bounds the memory of in-flight writes to one serialized buffer.
+  waitForPendingWrite();
+  auto& file = currentOutput();
+  if (writeExecutor_ == nullptr) {
+    return writeBuffer(file, *iobuf, flushTimeUs);
+  }
+
+  const auto size = iobuf->computeChainDataLength();
+  pendingWriteBuffer_ = std::move(iobuf);
+  pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+      [this, &file, buffer = pendingWriteBuffer_.get(), flushTimeUs]() {
+        return std::make_unique<uint64_t>(
+            writeBuffer(file, *buffer, flushTimeUs));
+      });
+  writeExecutor_->add([write = pendingWrite_]() { write->prepare(); });
+  return size;
+}
+
+uint64_t SpillFileList::writeBuffer(
+    WriteFile& file,
+    const folly::IOBuf& buffer,
+    uint64_t flushTimeUs) {
+  uint64_t writtenBytes = 0;
+  uint64_t writeTimeUs{0};
+  uint32_t numDiskWrites{0};
+  {
+    MicrosecondTimer timer(&writeTimeUs);
+    for (auto& range : buffer) {
+      ++numDiskWrites;
+      file.append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+      writtenBytes += range.size();
+    }
+  }
+  updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
+  if (compressionSelector_ != nullptr) {
+    compressionSelector_->recordWrite(writtenBytes, writeTimeUs);
   }
   return writtenBytes;
 }
 
+void SpillFileList::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto write = std::move(pendingWrite_);
+  auto freeBuffer = folly::makeGuard([&]() { pendingWriteBuffer_.reset(); });
+  // Runs the write on this thread if the executor has not started it.
+  write->move();
+}
+
 uint64_t SpillFileList::write(
     const RowVectorPtr& rows,
     const folly::Range<IndexRange*>& indices) {
   uint64_t timeUs{0};
+  uint64_t bufferedSize;
   {
     MicrosecondTimer timer(&timeUs);
-    if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_};
-      batch_ = std::make_unique<VectorStreamGroup>(pool_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1000,
-          &options);
+    if (fileFormat_ == common::SpillFileFormat::kCompactRow) {
+      appendCompactRows(rows, indices);
+      bufferedSize = compactRowsSize_;
+    } else {
+      if (batch_ == nullptr) {
+        // Picks the compression of a new file. A batch appended to the
+        // current file keeps its compression.
+        if (compressionSelector_ != nullptr &&
+            (files_.empty() || !files_.back()->isWritable() ||
+             files_.back()->size() > targetFileSize_)) {
+          batchCompressionKind_ = compressionSelector_->select();
+        }
+        serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+            kDefaultUseLosslessTimestamp, batchCompressionKind_};
+        batch_ = std::make_unique<VectorStreamGroup>(pool_);
+        batch_->createStreamTree(
+            std::static_pointer_cast<const RowType>(rows->type()),
+            1000,
+            &options);
+      }
+      batch_->append(rows, indices);
+      bufferedSize = batch_->size();
     }
-    batch_->append(rows, indices);
   }
   updateAppendStats(rows->size(), timeUs);
-  if (batch_->size() < writeBufferSize_) {
+  if (bufferedSize < writeBufferSize_) {
     return 0;
   }
   return flush();
 }
 
+void SpillFileList::appendCompactRows(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  row::CompactRow compactRow(rows);
+  const auto fixedRowSize = row::CompactRow::fixedRowSize(type_);
+  uint64_t newSize = compactRowsSize_;
+  for (const auto& range : indices) {
+    if (fixedRowSize.has_value()) {
+      newSize += (sizeof(uint32_t) + fixedRowSize.value()) * range.size;
+      continue;
+    }
+    for (auto i = range.begin; i < range.begin + range.size; ++i) {
+      newSize += sizeof(uint32_t) + compactRow.rowSize(i);
+    }
+  }
+  if (compactRows_ == nullptr) {
+    compactRows_ = AlignedBuffer::allocate<char>(
+        std::max<uint64_t>(newSize, writeBufferSize_), pool_);
+  } else if (compactRows_->capacity() < newSize) {
+    AlignedBuffer::reallocate<char>(
+        &compactRows_, std::max<uint64_t>(newSize, 2 * compactRowsSize_));
+  }
+
+  auto* rawRows = compactRows_->asMutable<char>();
+  // CompactRow::serialize() expects zero-initialized memory.
+  ::memset(rawRows + compactRowsSize_, 0, newSize - compactRowsSize_);
+  for (const auto& range : indices) {
+    for (auto i = range.begin; i < range.begin + range.size; ++i) {
+      const uint32_t rowSize = compactRow.serialize(
+          i, rawRows + compactRowsSize_ + sizeof(uint32_t));
+      ::memcpy(rawRows + compactRowsSize_, &rowSize, sizeof(uint32_t));
+      compactRowsSize_ += sizeof(uint32_t) + rowSize;
+    }
+  }
+  VELOX_DCHECK_EQ(compactRowsSize_, newSize);
+}
+
 void SpillFileList::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeUs) {
@@ -268,22 +633,27 @@ void SpillFileList::updateWriteStats(
       numDiskWrites, spilledBytes, flushTimeUs, fileWriteTimeUs);
 }
 
-void SpillFileList::updateSpilledFiles(uint64_t fileSize) {
-  ++stats_->wlock()->spilledFiles;
+void SpillFileList::updateSpilledFiles(
+    uint64_t fileSize,
+    common::CompressionKind compressionKind) {
+  {
+    auto statsLocked = stats_->wlock();
+    ++statsLocked->spilledFiles;
+    if (compressionKind == common::CompressionKind_LZ4) {
+      ++statsLocked->spilledLz4Files;
+    } else if (compressionKind == common::CompressionKind_ZSTD) {
+      ++statsLocked->spilledZstdFiles;
+    }
+  }
   addThreadLocalRuntimeStat(
       "spillFileSize", RuntimeCounter(fileSize, RuntimeCounter::Unit::kBytes));
-  incrementGlobalSpilledFiles();
+  incrementGlobalSpilledFiles(compressionKind);
 }
 
 void SpillFileList::finishFile() {
   flush();
-  if (files_.empty()) {
-    return;
-  }
-  if (files_.back()->isWritable()) {
-    files_.back()->finishWrite();
-    updateSpilledFiles(files_.back()->size());
-  }
+  waitForPendingWrite();
+  finishCurrentFile();
 }
 
 std::vector<std::string> SpillFileList::testingSpilledFilePaths() const {
@@ -311,7 +681,10 @@ SpillState::SpillState(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    folly::Executor* writeExecutor,
+    common::SpillFileFormat fileFormat,
+    bool adaptiveCompression)
     : path_(path),
       maxPartitions_(maxPartitions),
       numSortingKeys_(numSortingKeys),
@@ -321,6 +694,12 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       pool_(pool),
       stats_(stats),
+      writeExecutor_(writeExecutor),
+      fileFormat_(fileFormat),
+      compressionSelector_(
+          adaptiveCompression ? std::make_unique<SpillCompressionSelector>(
+                                    writeExecutor_ != nullptr)
+                              : nullptr),
       files_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(int32_t partition) {
@@ -358,7 +737,10 @@ uint64_t SpillState::appendToPartition(
         writeBufferSize_,
         compressionKind_,
         pool_,
-        stats_);
+        stats_,
+        writeExecutor_,
+        fileFormat_,
+        compressionSelector_.get());
   }
   updateSpilledInputBytes(rows->estimateFlatSize());
 
@@ -368,13 +750,28 @@ uint64_t SpillState::appendToPartition(
 
 std::unique_ptr<TreeOfLosers<SpillMergeStream>> SpillState::startMerge(
     int32_t partition,
-    std::unique_ptr<SpillMergeStream>&& extra) {
+    std::unique_ptr<SpillMergeStream>&& extra,
+    const SpillReadAheadOptions& readAhead) {
   VELOX_CHECK_LT(partition, files_.size());
   std::vector<std::unique_ptr<SpillMergeStream>> result;
   auto list = std::move(files_[partition]);
   if (list != nullptr) {
-    for (auto& file : list->files()) {
-      result.push_back(FileSpillMergeStream::create(std::move(file)));
+    auto files = list->files();
+    int32_t numReadAheadBuffers{0};
+    if (readAhead.executor != nullptr && readAhead.numBuffers > 0) {
+      // Reads ahead the same number of buffers for all the files within the
+      // memory budget.
+      uint64_t readBufferBytes{0};
+      for (const auto& file : files) {
+        readBufferBytes += file->readBufferSize();
+      }
+      numReadAheadBuffers = std::min<uint64_t>(
+          readAhead.numBuffers,
+          readAhead.maxBytes / std::max<uint64_t>(readBufferBytes, 1));
+    }
+    for (auto& file : files) {
+      result.push_back(FileSpillMergeStream::create(
+          std::move(file), readAhead.executor, numReadAheadBuffers));
     }
   }
   if (extra != nullptr) {
@@ -384,6 +781,9 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>> SpillState::startMerge(
   if (FOLLY_UNLIKELY(result.empty())) {
     return nullptr;
   }
+  addThreadLocalRuntimeStat(
+      "spillMergeFanIn", RuntimeCounter(static_cast<int64_t>(result.size())));
+  REPORT_ADD_HISTOGRAM_VALUE(kCounterSpillMergeFanIn, result.size());
   return std::make_unique<TreeOfLosers<SpillMergeStream>>(std::move(result));
 }
 
@@ -499,7 +899,10 @@ SpillStats::SpillStats(
     uint64_t _spillDiskWrites,
     uint64_t _spillFlushTimeUs,
     uint64_t _spillWriteTimeUs,
-    uint64_t _spillMaxLevelExceededCount)
+    uint64_t _spillMaxLevelExceededCount,
+    uint64_t _spilledLz4Files,
+    uint64_t _spilledZstdFiles,
+    uint64_t _spillFileCloseTimeUs)
     : spillRuns(_spillRuns),
       spilledInputBytes(_spilledInputBytes),
       spilledBytes(_spilledBytes),
@@ -512,7 +915,10 @@ SpillStats::SpillStats(
       spillDiskWrites(_spillDiskWrites),
       spillFlushTimeUs(_spillFlushTimeUs),
       spillWriteTimeUs(_spillWriteTimeUs),
-      spillMaxLevelExceededCount(_spillMaxLevelExceededCount) {}
+      spillMaxLevelExceededCount(_spillMaxLevelExceededCount),
+      spilledLz4Files(_spilledLz4Files),
+      spilledZstdFiles(_spilledZstdFiles),
+      spillFileCloseTimeUs(_spillFileCloseTimeUs) {}
 
 bool SpillStats::empty() const {
   return spilledBytes == 0;
@@ -532,6 +938,9 @@ SpillStats& SpillStats::operator+=(const SpillStats& other) {
   spillFlushTimeUs += other.spillFlushTimeUs;
   spillWriteTimeUs += other.spillWriteTimeUs;
   spillMaxLevelExceededCount += other.spillMaxLevelExceededCount;
+  spilledLz4Files += other.spilledLz4Files;
+  spilledZstdFiles += other.spilledZstdFiles;
+  spillFileCloseTimeUs += other.spillFileCloseTimeUs;
   return *this;
 }
 
@@ -552,6 +961,10 @@ SpillStats SpillStats::operator-(const SpillStats& other) const {
   result.spillWriteTimeUs = spillWriteTimeUs - other.spillWriteTimeUs;
   result.spillMaxLevelExceededCount =
       spillMaxLevelExceededCount - other.spillMaxLevelExceededCount;
+  result.spilledLz4Files = spilledLz4Files - other.spilledLz4Files;
+  result.spilledZstdFiles = spilledZstdFiles - other.spilledZstdFiles;
+  result.spillFileCloseTimeUs =
+      spillFileCloseTimeUs - other.spillFileCloseTimeUs;
   return result;
 }
 
@@ -583,6 +996,9 @@ bool SpillStats::operator<(const SpillStats& other) const {
   UPDATE_COUNTER(spillFlushTimeUs);
   UPDATE_COUNTER(spillWriteTimeUs);
   UPDATE_COUNTER(spillMaxLevelExceededCount);
+  UPDATE_COUNTER(spilledLz4Files);
+  UPDATE_COUNTER(spilledZstdFiles);
+  UPDATE_COUNTER(spillFileCloseTimeUs);
 #undef UPDATE_COUNTER
   VELOX_CHECK(
       !((gtCount > 0) && (ltCount > 0)),
@@ -618,7 +1034,10 @@ bool SpillStats::operator==(const SpillStats& other) const {
              spillDiskWrites,
              spillFlushTimeUs,
              spillWriteTimeUs,
-             spillMaxLevelExceededCount) ==
+             spillMaxLevelExceededCount,
+             spilledLz4Files,
+             spilledZstdFiles,
+             spillFileCloseTimeUs) ==
       std::tie(
              other.spillRuns,
              other.spilledInputBytes,
@@ -632,7 +1051,10 @@ bool SpillStats::operator==(const SpillStats& other) const {
              other.spillDiskWrites,
              other.spillFlushTimeUs,
              other.spillWriteTimeUs,
-             spillMaxLevelExceededCount);
+             spillMaxLevelExceededCount,
+             other.spilledLz4Files,
+             other.spilledZstdFiles,
+             other.spillFileCloseTimeUs);
 }
 
 void SpillStats::reset() {
@@ -649,11 +1071,14 @@ void SpillStats::reset() {
   spillFlushTimeUs = 0;
   spillWriteTimeUs = 0;
   spillMaxLevelExceededCount = 0;
+  spilledLz4Files = 0;
+  spilledZstdFiles = 0;
+  spillFileCloseTimeUs = 0;
 }
 
 std::string SpillStats::toString() const {
   return fmt::format(
-      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}]",
+      "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[{}] spilledLz4Files[{}] spilledZstdFiles[{}] spillFileCloseTime[{}]",
       spillRuns,
       succinctBytes(spilledInputBytes),
       succinctBytes(spilledBytes),
@@ -666,7 +1091,10 @@ std::string SpillStats::toString() const {
       spillDiskWrites,
       succinctMicros(spillFlushTimeUs),
       succinctMicros(spillWriteTimeUs),
-      spillMaxLevelExceededCount);
+      spillMaxLevelExceededCount,
+      spilledLz4Files,
+      spilledZstdFiles,
+      succinctMicros(spillFileCloseTimeUs));
 }
 
 SpillPartitionIdSet toSpillPartitionIdSet(
@@ -690,6 +1118,7 @@ void updateGlobalSpillAppendStats(
   auto statsLocked = localSpillStats().wlock();
   statsLocked->spilledRows += numRows;
   statsLocked->spillSerializationTimeUs += serializationTimeUs;
+  REPORT_ADD_STAT_VALUE(kCounterSpillSerializationTimeUs, serializationTimeUs);
 }
 
 void incrementGlobalSpilledPartitionStats() {
@@ -714,6 +1143,8 @@ void updateGlobalSpillWriteStats(
   statsLocked->spilledBytes += spilledBytes;
   statsLocked->spillFlushTimeUs += flushTimeUs;
   statsLocked->spillWriteTimeUs += writeTimeUs;
+  REPORT_ADD_STAT_VALUE(kCounterSpillFlushTimeUs, flushTimeUs);
+  REPORT_ADD_STAT_VALUE(kCounterSpillWriteTimeUs, writeTimeUs);
 }
 
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
@@ -721,8 +1152,19 @@ void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   statsLocked->spilledInputBytes += spilledInputBytes;
 }
 
-void incrementGlobalSpilledFiles() {
-  ++localSpillStats().wlock()->spilledFiles;
+void incrementGlobalSpilledFiles(common::CompressionKind compressionKind) {
+  auto statsLocked = localSpillStats().wlock();
+  ++statsLocked->spilledFiles;
+  if (compressionKind == common::CompressionKind_LZ4) {
+    ++statsLocked->spilledLz4Files;
+  } else if (compressionKind == common::CompressionKind_ZSTD) {
+    ++statsLocked->spilledZstdFiles;
+  }
+}
+
+void updateGlobalSpillFileCloseTime(uint64_t timeUs) {
+  localSpillStats().wlock()->spillFileCloseTimeUs += timeUs;
+  REPORT_ADD_STAT_VALUE(kCounterSpillFileCloseTimeUs, timeUs);
 }
 
 void updateGlobalMaxSpillLevelExceededCount(
@@ -16,9 +16,16 @@
 
 #pragma once
 
+#include <array>
+#include <deque>
+#include <mutex>
+#include <optional>
+
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/config/SpillConfig.h"
 #include "velox/common/file/File.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/UnorderedStreamReader.h"
@@ -31,14 +38,27 @@ namespace facebook::velox::exec {
 // Input stream backed by spill file.
 class SpillInput : public ByteStream {
  public:
-  // Reads from 'input' using 'buffer' for buffering reads.
-  SpillInput(std::unique_ptr<ReadFile>&& input, BufferPtr buffer)
+  // Reads from 'input' using 'buffer' for buffering reads. If 'readExecutor'
+  // is set, up to 'numReadAheadBuffers' buffers of the same capacity as
+  // 'buffer' are read ahead of the consumer on 'readExecutor'.
+  SpillInput(
+      std::unique_ptr<ReadFile>&& input,
+      BufferPtr buffer,
+      folly::Executor* readExecutor = nullptr,
+      int32_t numReadAheadBuffers = 0)
       : input_(std::move(input)),
         buffer_(std::move(buffer)),
-        size_(input_->size()) {
+        size_(input_->size()),
+        readBufferSize_(buffer_->capacity()),
+        pool_(buffer_->pool()),
+        readExecutor_(readExecutor),
+        numReadAheadBuffers_(
+            readExecutor_ == nullptr ? 0 : numReadAheadBuffers) {
     next(true);
   }
 
+  ~SpillInput() override;
+
   void next(bool throwIfPastEnd) override;
 
   // True if all of the file has been read into vectors.
@@ -46,12 +66,32 @@ class SpillInput : public ByteStream {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
   }
 
+  // The time the consumer has spent waiting for the file reads.
+  uint64_t readWaitTimeUs() const {
+    return readWaitTimeUs_;
+  }
+
  private:
+  // Starts reads of the next buffers on 'readExecutor_' until
+  // 'numReadAheadBuffers_' reads are pending or the file is exhausted.
+  void scheduleReadAhead();
+
   std::unique_ptr<ReadFile> input_;
   BufferPtr buffer_;
   const uint64_t size_;
+  const uint64_t readBufferSize_;
+  memory::MemoryPool* const pool_;
+  folly::Executor* const readExecutor_;
+  const int32_t numReadAheadBuffers_;
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+  // Offset of first byte not in 'buffer_' or in a pending read.
+  uint64_t readAheadOffset_ = 0;
+  // The reads started ahead of the consumer in file order.
+  std::deque<std::shared_ptr<AsyncSource<BufferPtr>>> readAheads_;
+  // A consumed buffer to reuse for the next read.
+  BufferPtr freeBuffer_;
+  uint64_t readWaitTimeUs_{0};
 };
 
 /// Represents a spill file that is first in write mode and then
@@ -71,7 +111,8 @@ class SpillFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
       common::CompressionKind compressionKind,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto);
 
   uint32_t id() const {
     return id_;
@@ -85,6 +126,10 @@ class SpillFile {
     return sortCompareFlags_;
   }
 
+  common::CompressionKind compressionKind() const {
+    return compressionKind_;
+  }
+
   /// Returns a file for writing spilled data. The caller constructs
   /// this, then calls output() and writes serialized data to the file
   /// and calls finishWrite when the file has reached its final
@@ -96,19 +141,31 @@ class SpillFile {
     return output_ != nullptr;
   }
 
-  /// Finishes writing and flushes any unwritten data.
+  /// Finishes writing, and flushes and closes the file.
   void finishWrite() {
     VELOX_CHECK(output_);
     fileSize_ = output_->size();
+    output_->close();
     output_ = nullptr;
   }
 
   /// Prepares 'this' for reading. Positions the read at the first row of
   /// content. The caller must call output() and finishWrite() before this.
-  void startRead();
-
+  /// If 'readExecutor' is set, up to 'numReadAheadBuffers' read buffers are
+  /// read ahead of the consumer on 'readExecutor'.
+  void startRead(
+      folly::Executor* readExecutor = nullptr,
+      int32_t numReadAheadBuffers = 0);
+
+  /// Reads the next batch into 'rowVector'. Returns false at the end of the
+  /// file, at which point the read stats of the file are added to the runtime
+  /// stats of the current operator: 'spillReadTime' including the
+  /// deserialization, 'spillReadWaitTime' and 'spillReadBytes'.
   bool nextBatch(RowVectorPtr& rowVector);
 
+  /// Returns the byte size of the buffer used for reading 'this'.
+  uint64_t readBufferSize() const;
+
   /// Returns the file size in bytes. During the writing phase this is
   /// the current size of the file, during reading this is the final
   // size.
@@ -128,6 +185,12 @@ class SpillFile {
   }
 
  private:
+  // Reads the next batch of rows written in CompactRow format.
+  void nextCompactRowBatch(RowVectorPtr& rowVector);
+
+  // Adds the read stats of 'this' to the runtime stats once the file is read.
+  void recordReadStats();
+
   static std::atomic<int32_t> ordinalCounter_;
 
   // The spill file id which is monotonically increasing and unique for each
@@ -142,11 +205,21 @@ class SpillFile {
   const std::string path_;
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
+  const common::SpillFileFormat fileFormat_;
 
   // Byte size of the backing file. Set when finishing writing.
   uint64_t fileSize_ = 0;
   std::unique_ptr<WriteFile> output_;
   std::unique_ptr<SpillInput> input_;
+
+  // The rows of the batch being read in CompactRow format. Reused across
+  // batches.
+  BufferPtr compactRows_;
+  std::vector<std::string_view> compactRowViews_;
+
+  // The time spent in nextBatch().
+  uint64_t readTimeUs_{0};
+  bool readStatsRecorded_{false};
 };
 
 /// Provides the fine-grained spill execution stats.
@@ -182,6 +255,12 @@ struct SpillStats {
   /// The number of times that an hash build operator exceeds the max spill
   /// limit.
   uint64_t spillMaxLevelExceededCount{0};
+  /// The number of spilled files compressed with LZ4 and ZSTD. With adaptive
+  /// spill compression, these record the codec chosen for each file.
+  uint64_t spilledLz4Files{0};
+  uint64_t spilledZstdFiles{0};
+  /// The time spent on flushing and closing spill files after writing them.
+  uint64_t spillFileCloseTimeUs{0};
 
   SpillStats(
       uint64_t _spillRuns,
@@ -196,7 +275,10 @@ struct SpillStats {
       uint64_t _spillDiskWrites,
       uint64_t _spillFlushTimeUs,
       uint64_t _spillWriteTimeUs,
-      uint64_t _spillMaxLevelExceededCount);
+      uint64_t _spillMaxLevelExceededCount,
+      uint64_t _spilledLz4Files = 0,
+      uint64_t _spilledZstdFiles = 0,
+      uint64_t _spillFileCloseTimeUs = 0);
 
   SpillStats() = default;
 
@@ -226,6 +308,66 @@ FOLLY_ALWAYS_INLINE std::ostream& operator<<(
 
 using SpillFiles = std::vector<std::unique_ptr<SpillFile>>;
 
+/// Picks the compression codec of each spill file for adaptive spill
+/// compression. The first files are written once with each candidate codec
+/// to measure its compression ratio and throughput. Each following file uses
+/// the codec with the least estimated time to serialize and write a byte of
+/// spill data, given the measured disk write throughput. If the disk writes
+/// overlap with serialization, the slower of the two bounds the time.
+///
+/// NOTE: this is thread-safe as the partitions of a spiller may be written on
+/// different threads.
+class SpillCompressionSelector {
+ public:
+  static constexpr std::array<common::CompressionKind, 3> kCandidates{
+      common::CompressionKind_NONE,
+      common::CompressionKind_LZ4,
+      common::CompressionKind_ZSTD};
+
+  explicit SpillCompressionSelector(bool asyncWrite)
+      : asyncWrite_(asyncWrite) {}
+
+  /// Returns the codec for the next spill file.
+  common::CompressionKind select();
+
+  /// Records the serialization of 'inputBytes' of uncompressed spill data
+  /// into 'outputBytes' with 'kind' in 'timeUs'.
+  void recordFlush(
+      common::CompressionKind kind,
+      uint64_t inputBytes,
+      uint64_t outputBytes,
+      uint64_t timeUs);
+
+  /// Records a disk write of 'bytes' in 'timeUs'.
+  void recordWrite(uint64_t bytes, uint64_t timeUs);
+
+  /// Returns the estimated time in microseconds to serialize and write one
+  /// byte of spill data with candidate 'kind', or std::nullopt if 'kind' has
+  /// not been measured.
+  std::optional<double> estimateTimeUsPerByte(common::CompressionKind kind);
+
+ private:
+  struct CodecStats {
+    uint64_t inputBytes{0};
+    uint64_t outputBytes{0};
+    uint64_t timeUs{0};
+  };
+
+  static int32_t candidateIndex(common::CompressionKind kind);
+
+  std::optional<double> estimateTimeUsPerByteLocked(int32_t candidate) const;
+
+  const bool asyncWrite_;
+
+  std::mutex mutex_;
+  // The number of selections made so far. The first 'kCandidates.size()'
+  // select each candidate once.
+  uint32_t numSelections_{0};
+  std::array<CodecStats, kCandidates.size()> codecStats_;
+  uint64_t writtenBytes_{0};
+  uint64_t writeTimeUs_{0};
+};
+
 /// Sequence of files for one partition of the spilled data. If data is
 /// sorted, each file is sorted. The globally sorted order is produced
 /// by merging the constituent files.
@@ -239,6 +381,17 @@ class SpillFileList {
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
+  ///
+  /// If 'writeExecutor' is set, a serialized buffer is written to disk on
+  /// 'writeExecutor' while the caller serializes the next one. At most one
+  /// buffer is in flight: a flush waits for the previous write to complete.
+  ///
+  /// 'fileFormat' specifies the serialization of the written rows. With
+  /// kCompactRow the rows are serialized one by one with row::CompactRow and
+  /// 'compressionKind' must be CompressionKind_NONE.
+  ///
+  /// If 'compressionSelector' is set, it picks the compression of each file
+  /// instead of 'compressionKind'.
   SpillFileList(
       const RowTypePtr& type,
       int32_t numSortingKeys,
@@ -248,7 +401,12 @@ class SpillFileList {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      SpillCompressionSelector* compressionSelector = nullptr);
+
+  ~SpillFileList();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -264,7 +422,8 @@ class SpillFileList {
   void finishFile();
 
   SpillFiles files() {
-    VELOX_CHECK(!files_.empty() || (batch_ != nullptr));
+    VELOX_CHECK(
+        !files_.empty() || (batch_ != nullptr) || (compactRowsSize_ > 0));
     finishFile();
     return std::move(files_);
   }
@@ -277,14 +436,36 @@ class SpillFileList {
   // Returns the current file to write to and creates one if needed.
   WriteFile& currentOutput();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Serializes 'batch_' and writes it to the current output file, on
+  // 'writeExecutor_' if set. Returns the serialized size.
   uint64_t flush();
 
+  // Serializes the rows of 'rows' in 'indices' in CompactRow format and
+  // appends them to 'compactRows_'.
+  void appendCompactRows(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
+  // Writes 'buffer' to 'file' and updates the write stats. Returns the
+  // written size.
+  uint64_t writeBuffer(
+      WriteFile& file,
+      const folly::IOBuf& buffer,
+      uint64_t flushTimeUs);
+
+  // Waits for the write started by the last flush() to complete. Rethrows its
+  // error, if any.
+  void waitForPendingWrite();
+
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
   // Invoked to increment the number of spilled files and the file size.
-  void updateSpilledFiles(uint64_t fileSize);
+  void updateSpilledFiles(
+      uint64_t fileSize,
+      common::CompressionKind compressionKind);
+
+  // Finishes writing the last file and updates the spilled file stats.
+  void finishCurrentFile();
   // Invoked to update the disk write stats.
   void updateWriteStats(
       uint32_t numDiskWrites,
@@ -301,9 +482,25 @@ class SpillFileList {
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const common::SpillFileFormat fileFormat_;
+  SpillCompressionSelector* const compressionSelector_;
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // The compression of 'batch_'. It is written to a file of the same
+  // compression.
+  common::CompressionKind batchCompressionKind_;
   SpillFiles files_;
+
+  // The rows serialized in CompactRow format since the last flush. Each row
+  // is prefixed with its uint32_t byte size.
+  BufferPtr compactRows_;
+  uint64_t compactRowsSize_{0};
+
+  // The serialized buffer being written on 'writeExecutor_' and the write
+  // itself. The buffer is freed on the caller thread after the write.
+  std::unique_ptr<folly::IOBuf> pendingWriteBuffer_;
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
 };
 
 // A source of sorted spilled RowVectors coming either from a file or memory.
@@ -405,8 +602,10 @@ class SpillMergeStream : public MergeStream {
 class FileSpillMergeStream : public SpillMergeStream {
  public:
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillFile> spillFile) {
-    spillFile->startRead();
+      std::unique_ptr<SpillFile> spillFile,
+      folly::Executor* readExecutor = nullptr,
+      int32_t numReadAheadBuffers = 0) {
+    spillFile->startRead(readExecutor, numReadAheadBuffers);
     auto* spillStream = new FileSpillMergeStream(std::move(spillFile));
     spillStream->nextBatch();
     return std::unique_ptr<SpillMergeStream>(spillStream);
@@ -587,6 +786,19 @@ class SpillPartition {
 using SpillPartitionSet =
     std::map<SpillPartitionId, std::unique_ptr<SpillPartition>>;
 
+/// Specifies the asynchronous read-ahead of the spill files in a merge.
+struct SpillReadAheadOptions {
+  /// Executor for the reads. Read-ahead is disabled if nullptr.
+  folly::Executor* executor{nullptr};
+
+  /// The max number of read buffers read ahead per spill file.
+  int32_t numBuffers{0};
+
+  /// The memory budget of the read-ahead buffers of all the spill files in a
+  /// merge. Reduces the number of buffers read ahead per file as needed.
+  uint64_t maxBytes{0};
+};
+
 /// Represents all spilled data of an operator, e.g. order by or group
 /// by. This has one SpillFileList per partition of spill data.
 class SpillState {
@@ -597,7 +809,11 @@ class SpillState {
   /// 'numSortingKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'writeExecutor' is set, disk writes overlap with
+  /// serialization, see SpillFileList. 'fileFormat' specifies the
+  /// serialization of the spill files. If 'adaptiveCompression' is true, the
+  /// compression of each spill file is picked by a SpillCompressionSelector
+  /// shared by all the partitions instead of 'compressionKind'.
   SpillState(
       const std::string& path,
       int32_t maxPartitions,
@@ -607,7 +823,10 @@ class SpillState {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      folly::Executor* writeExecutor = nullptr,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      bool adaptiveCompression = false);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(int32_t partition) const {
@@ -631,6 +850,10 @@ class SpillState {
     return compressionKind_;
   }
 
+  common::SpillFileFormat fileFormat() const {
+    return fileFormat_;
+  }
+
   const std::vector<CompareFlags>& sortCompareFlags() const {
     return sortCompareFlags_;
   }
@@ -665,10 +888,12 @@ class SpillState {
 
   /// Starts reading values for 'partition'. If 'extra' is non-null, it can be
   /// a stream of rows from a RowContainer so as to merge unspilled data with
-  /// spilled data.
+  /// spilled data. 'readAhead' specifies the asynchronous read-ahead of the
+  /// spill files.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge(
       int32_t partition,
-      std::unique_ptr<SpillMergeStream>&& extra);
+      std::unique_ptr<SpillMergeStream>&& extra,
+      const SpillReadAheadOptions& readAhead = {});
 
   bool hasFiles(int32_t partition) const {
     return partition < files_.size() && files_[partition];
@@ -699,6 +924,9 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  folly::Executor* const writeExecutor_;
+  const common::SpillFileFormat fileFormat_;
+  const std::unique_ptr<SpillCompressionSelector> compressionSelector_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
@@ -742,8 +970,13 @@ void updateGlobalSpillWriteStats(
 /// Increment the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
-/// Increments the spilled files by one.
-void incrementGlobalSpilledFiles();
+/// Increments the spilled files by one. 'compressionKind' is the compression
+/// of the file.
+void incrementGlobalSpilledFiles(
+    common::CompressionKind compressionKind = common::CompressionKind_NONE);
+
+/// Updates the time spent on flushing and closing spill files.
+void updateGlobalSpillFileCloseTime(uint64_t timeUs);
 
 /// Increments the exceeded max spill level count.
 void updateGlobalMaxSpillLevelExceededCount(
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SpilledWindowPartition.h"
+
+namespace facebook::velox::exec {
+
+SpilledWindowPartition::SpilledWindowPartition(
+    RowContainer* data,
+    SpillFiles files,
+    vector_size_t numRows,
+    const std::vector<exec::RowColumn>& columns,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : WindowPartition(data, numRows, columns, sortKeyInfo),
+      reader_(SpillPartition(SpillPartitionId(0, 0), std::move(files))
+                  .createReader()) {
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+}
+
+void SpilledWindowPartition::loadRows(vector_size_t endRow) const {
+  VELOX_CHECK_LE(endRow, numRows());
+  while (startRow_ + rows_.size() < endRow) {
+    VELOX_CHECK(
+        reader_->nextBatch(batch_),
+        "Spilled window partition ends before row {}",
+        endRow);
+    decodedBatch_.resize(batch_->childrenSize());
+    for (auto i = 0; i < batch_->childrenSize(); ++i) {
+      decodedBatch_[i].decode(*batch_->childAt(i));
+    }
+    for (auto row = 0; row < batch_->size(); ++row) {
+      auto* newRow = data_->newRow();
+      for (auto i = 0; i < decodedBatch_.size(); ++i) {
+        data_->store(decodedBatch_[i], row, newRow, i);
+      }
+      rows_.push_back(newRow);
+    }
+  }
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void SpilledWindowPartition::removeRowsBefore(vector_size_t row) {
+  const auto numRemoved =
+      std::min<vector_size_t>(row - startRow_, rows_.size());
+  if (numRemoved <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range(rows_.data(), numRemoved));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemoved);
+  startRow_ += numRemoved;
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+} // namespace facebook::velox::exec
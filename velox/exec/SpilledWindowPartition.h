@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/Spill.h"
+#include "velox/exec/WindowPartition.h"
+
+namespace facebook::velox::exec {
+
+/// WindowPartition for a partition that does not fit in memory. The rows are
+/// written to spill files in partition order and are paged into the build's
+/// RowContainer as the window functions advance over the partition. The rows
+/// that are not accessed anymore are removed from the RowContainer by
+/// removeRowsBefore(). Only used if the window functions and frames access a
+/// bounded range of rows around the current row.
+class SpilledWindowPartition : public WindowPartition {
+ public:
+  /// 'files' are the spill files with the 'numRows' partition rows in order.
+  /// 'data' is the RowContainer to page the rows into. It must have no rows.
+  SpilledWindowPartition(
+      RowContainer* data,
+      SpillFiles files,
+      vector_size_t numRows,
+      const std::vector<exec::RowColumn>& columns,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  void removeRowsBefore(vector_size_t row) override;
+
+ protected:
+  void loadRows(vector_size_t endRow) const override;
+
+ private:
+  // Pointers to the partition rows in the RowContainer starting at
+  // 'startRow_'.
+  mutable std::vector<char*> rows_;
+
+  // Reads the spill files in order.
+  const std::unique_ptr<UnorderedStreamReader<BatchStream>> reader_;
+
+  // The last batch read from 'reader_' and its decoded columns.
+  mutable RowVectorPtr batch_;
+  mutable std::vector<DecodedVector> decodedBatch_;
+};
+
+} // namespace facebook::velox::exec
@@ -16,9 +16,13 @@
 
 #include "velox/exec/Spiller.h"
 #include <folly/ScopeGuard.h>
+#include <numeric>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/external/timsort/TimSort.hpp"
 
 using facebook::velox::common::testutil::TestValue;
@@ -44,7 +48,9 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::SpillFileFormat fileFormat,
+    bool adaptiveCompression)
     : Spiller(
           type,
           container,
@@ -57,7 +63,9 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          fileFormat,
+          adaptiveCompression) {
   VELOX_CHECK(
       type_ == Type::kOrderBy || type_ == Type::kAggregateInput,
       "Unexpected spiller type: {}",
@@ -74,7 +82,9 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::SpillFileFormat fileFormat,
+    bool adaptiveCompression)
     : Spiller(
           type,
           container,
@@ -87,7 +97,9 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          fileFormat,
+          adaptiveCompression) {
   VELOX_CHECK_EQ(
       type,
       Type::kAggregateOutput,
@@ -106,7 +118,9 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::SpillFileFormat fileFormat,
+    bool adaptiveCompression)
     : Spiller(
           type,
           nullptr,
@@ -119,7 +133,9 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          fileFormat,
+          adaptiveCompression) {
   VELOX_CHECK_EQ(
       type_,
       Type::kHashJoinProbe,
@@ -137,7 +153,9 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::SpillFileFormat fileFormat,
+    bool adaptiveCompression)
     : Spiller(
           type,
           container,
@@ -150,7 +168,9 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          fileFormat,
+          adaptiveCompression) {
   VELOX_CHECK_EQ(
       type_,
       Type::kHashJoinBuild,
@@ -170,7 +190,9 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::SpillFileFormat fileFormat,
+    bool adaptiveCompression)
     : type_(type),
       container_(container),
       executor_(executor),
@@ -186,7 +208,10 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool_,
-          &stats_) {
+          &stats_,
+          executor_,
+          fileFormat,
+          adaptiveCompression) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
@@ -207,9 +232,14 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
   }
   auto result = resultPtr.get();
   auto& types = container_->columnTypes();
-  for (auto i = 0; i < types.size(); ++i) {
-    container_->extractColumn(rows.data(), rows.size(), i, result->childAt(i));
-  }
+  std::vector<int32_t> columns(types.size());
+  std::iota(columns.begin(), columns.end(), 0);
+  container_->extractColumns(
+      rows.data(),
+      rows.size(),
+      columns,
+      folly::Range<const VectorPtr*>(
+          result->children().data(), types.size()));
 
   auto& accumulators = container_->accumulators();
 
@@ -333,13 +363,21 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   if (!run.sorted && needSort()) {
     MicrosecondTimer timer(&sortTimeUs);
-    gfx::timsort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    if (!PrefixSort::sort(
+            container_,
+            container_->keyTypes().size(),
+            state_.sortCompareFlags(),
+            run.rows.data(),
+            run.rows.size(),
+            pool_)) {
+      gfx::timsort(
+          run.rows.begin(),
+          run.rows.end(),
+          [&](const char* left, const char* right) {
+            return container_->compareRows(
+                       left, right, state_.sortCompareFlags()) < 0;
+          });
+    }
     run.sorted = true;
   }
   if (sortTimeUs != 0) {
@@ -466,9 +504,15 @@ void Spiller::spill(const RowContainerIterator* startRowIter) {
     }
   }
 
+  const auto prevSpilledInputBytes = stats_.rlock()->spilledInputBytes;
   fillSpillRuns(startRowIter);
   runSpill();
   checkEmptySpillRuns();
+  const auto runBytes =
+      stats_.rlock()->spilledInputBytes - prevSpilledInputBytes;
+  addThreadLocalRuntimeStat(
+      "spillRunBytes", RuntimeCounter(runBytes, RuntimeCounter::Unit::kBytes));
+  REPORT_ADD_HISTOGRAM_VALUE(kCounterSpillRunBytes, runBytes);
 }
 
 void Spiller::checkEmptySpillRuns() const {
@@ -525,7 +569,9 @@ void Spiller::finalizeSpill() {
   }
 }
 
-std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge() {
+std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge(
+    int32_t numReadAheadBuffers,
+    uint64_t maxReadAheadBytes) {
   CHECK_FINALIZED();
 
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
@@ -538,7 +584,10 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge() {
         needSort(), "Can't sort merge the unsorted spill data: {}", toString());
   }
 
-  auto merger = state_.startMerge(0, spillMergeStreamOverRows(0));
+  auto merger = state_.startMerge(
+      0,
+      spillMergeStreamOverRows(0),
+      SpillReadAheadOptions{executor_, numReadAheadBuffers, maxReadAheadBytes});
   if (merger != nullptr && type_ == Type::kAggregateOutput) {
     VELOX_CHECK_EQ(
         merger->numStreams(),
@@ -55,7 +55,9 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      bool adaptiveCompression = false);
 
   Spiller(
       Type type,
@@ -65,7 +67,9 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      bool adaptiveCompression = false);
 
   Spiller(
       Type type,
@@ -76,7 +80,9 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      bool adaptiveCompression = false);
 
   Spiller(
       Type type,
@@ -88,7 +94,9 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      common::SpillFileFormat fileFormat = common::SpillFileFormat::kPresto,
+      bool adaptiveCompression = false);
 
   Type type() const {
     return type_;
@@ -116,7 +124,12 @@ class Spiller {
   /// Invoked to finalize the spiller and flush any buffered spill to disk.
   void finalizeSpill();
 
-  std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge();
+  /// Starts the sort merge of the spilled data with the unspilled rows. Up to
+  /// 'numReadAheadBuffers' read buffers per spill file are read ahead on the
+  /// spill executor within a total of 'maxReadAheadBytes'.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge(
+      int32_t numReadAheadBuffers = 0,
+      uint64_t maxReadAheadBytes = 0);
 
   /// Extracts up to 'maxRows' or 'maxBytes' from 'rows' into 'spillVector'. The
   /// extract starts at nextBatchIndex and updates nextBatchIndex to be the
@@ -162,9 +175,9 @@ class Spiller {
 
   /// Invokes to set a set of 'partitions' as spilling.
   void setPartitionsSpilled(const SpillPartitionNumSet& partitions) {
-    VELOX_CHECK_EQ(
-        type_,
-        Spiller::Type::kHashJoinProbe,
+    VELOX_CHECK(
+        type_ == Spiller::Type::kHashJoinProbe ||
+            type_ == Spiller::Type::kHashJoinBuild,
         "Unexpected spiller type: ",
         typeName(type_));
     for (const auto& partition : partitions) {
@@ -194,7 +207,9 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      common::SpillFileFormat fileFormat,
+      bool adaptiveCompression);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
   // from row container starting at the offset pointed by 'startRowIter'.
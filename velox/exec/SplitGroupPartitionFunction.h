@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+/// Assigns all the rows of a split group to one partition. Used to
+/// repartition the output of a grouped execution whose split groups are the
+/// buckets of a table bucketed on the partitioning keys. All the rows with
+/// the same keys are then in one split group, hence in one partition, without
+/// hashing the keys of each row.
+class SplitGroupPartitionFunction : public core::PartitionFunction {
+ public:
+  SplitGroupPartitionFunction(int numPartitions, uint32_t splitGroupId)
+      : partition_{splitGroupId % numPartitions} {}
+
+  std::optional<uint32_t> partition(
+      const RowVector& /*input*/,
+      std::vector<uint32_t>& /*partitions*/) override {
+    return partition_;
+  }
+
+ private:
+  const uint32_t partition_;
+};
+
+class SplitGroupPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  std::unique_ptr<core::PartitionFunction> create(
+      int /*numPartitions*/) const override {
+    VELOX_USER_FAIL("Split group partitioning requires grouped execution");
+  }
+
+  std::unique_ptr<core::PartitionFunction> createForSplitGroup(
+      int numPartitions,
+      uint32_t splitGroupId) const override {
+    VELOX_USER_CHECK_NE(
+        splitGroupId,
+        kUngroupedGroupId,
+        "Split group partitioning requires grouped execution");
+    return std::make_unique<SplitGroupPartitionFunction>(
+        numPartitions, splitGroupId);
+  }
+
+  std::string toString() const override {
+    return "SPLIT GROUP";
+  }
+
+  folly::dynamic serialize() const override {
+    folly::dynamic obj = folly::dynamic::object;
+    obj["name"] = "SplitGroupPartitionFunctionSpec";
+    return obj;
+  }
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& /*obj*/,
+      void* /*context*/) {
+    return std::make_shared<SplitGroupPartitionFunctionSpec>();
+  }
+};
+} // namespace facebook::velox::exec
@@ -19,6 +19,19 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+bool canSpill(
+    const core::AggregationNode& node,
+    const core::QueryConfig& queryConfig) {
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+  }
+  return queryConfig.aggregationSpillEnabled();
+}
+} // namespace
+
 StreamingAggregation::StreamingAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -30,7 +43,10 @@ StreamingAggregation::StreamingAggregation(
           aggregationNode->id(),
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
-              : "Aggregation"),
+              : "Aggregation",
+          canSpill(*aggregationNode, driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       aggregationNode_{aggregationNode},
       step_{aggregationNode->step()} {}
@@ -55,6 +71,7 @@ void StreamingAggregation::initialize() {
 
   auto numAggregates = aggregationNode_->aggregates().size();
   aggregates_.reserve(numAggregates);
+  std::vector<TypePtr> spillTypes = groupingKeyTypes;
   std::vector<std::optional<column_index_t>> maskChannels;
   maskChannels.reserve(numAggregates);
   for (auto i = 0; i < numAggregates; i++) {
@@ -88,6 +105,8 @@ void StreamingAggregation::initialize() {
         aggregate.rawInputTypes,
         aggResultType,
         operatorCtx_->driverCtx()->queryConfig()));
+    spillTypes.push_back(Aggregate::intermediateType(
+        aggregate.call->name(), aggregate.rawInputTypes));
     args_.push_back(channels);
     constantArgs_.push_back(constants);
   }
@@ -97,6 +116,8 @@ void StreamingAggregation::initialize() {
   }
 
   masks_ = std::make_unique<AggregationMasks>(std::move(maskChannels));
+  spillType_ = ROW(
+      std::vector<std::string>(outputType_->names()), std::move(spillTypes));
 
   std::vector<Accumulator> accumulators;
   accumulators.reserve(aggregates_.size());
@@ -130,6 +151,11 @@ void StreamingAggregation::initialize() {
 }
 
 void StreamingAggregation::close() {
+  if (spillState_ != nullptr && noMoreInput_) {
+    recordSpillStats(spillStats_.copy());
+  }
+  spillOutputReader_.reset();
+  spillState_.reset();
   if (rows_ != nullptr) {
     rows_->clear();
   }
@@ -183,6 +209,10 @@ void StreamingAggregation::storeKeys(char* group, vector_size_t index) {
 }
 
 RowVectorPtr StreamingAggregation::createOutput(size_t numGroups) {
+  if (groupSpilled_) {
+    mergeSpilledGroup();
+  }
+
   auto output = BaseVector::create<RowVector>(outputType_, numGroups, pool());
 
   for (auto i = 0; i < groupingKeys_.size(); ++i) {
@@ -203,6 +233,128 @@ RowVectorPtr StreamingAggregation::createOutput(size_t numGroups) {
   return output;
 }
 
+RowVectorPtr StreamingAggregation::getSpilledOutput() {
+  for (;;) {
+    if (spillOutputReader_ == nullptr) {
+      if (spillState_ == nullptr ||
+          !spillState_->hasFiles(kOutputPartition)) {
+        return nullptr;
+      }
+      SpillPartition partition(
+          SpillPartitionId(0, kOutputPartition),
+          spillState_->files(kOutputPartition));
+      spillOutputReader_ = partition.createReader();
+    }
+
+    RowVectorPtr output;
+    if (spillOutputReader_->nextBatch(output)) {
+      return output;
+    }
+    // More output may have been spilled while reading.
+    spillOutputReader_.reset();
+  }
+}
+
+void StreamingAggregation::spill() {
+  VELOX_CHECK_GT(numGroups_, 0);
+  if (spillState_ == nullptr) {
+    spillState_ = std::make_unique<SpillState>(
+        spillConfig_->filePath,
+        2,
+        0,
+        std::vector<CompareFlags>{},
+        spillConfig_->maxFileSize,
+        spillConfig_->writeBufferSize,
+        spillConfig_->compressionKind,
+        pool(),
+        &spillStats_,
+        /*writeExecutor=*/nullptr,
+        spillConfig_->fileFormat,
+        spillConfig_->adaptiveCompression);
+    spillState_->setPartitionSpilled(kOutputPartition);
+    spillState_->setPartitionSpilled(kGroupPartition);
+  }
+
+  // All groups but the last one are complete. Their output is returned
+  // before the output of any later group.
+  if (numGroups_ > 1) {
+    spillState_->appendToPartition(
+        kOutputPartition, createOutput(numGroups_ - 1));
+  }
+
+  auto* group = groups_[numGroups_ - 1];
+  auto intermediate = BaseVector::create<RowVector>(spillType_, 1, pool());
+  const auto numKeys = groupingKeys_.size();
+  for (auto i = 0; i < numKeys; ++i) {
+    rows_->extractColumn(&group, 1, i, intermediate->childAt(i));
+  }
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    aggregates_[i]->extractAccumulators(
+        &group, 1, &intermediate->childAt(numKeys + i));
+  }
+  spillState_->appendToPartition(kGroupPartition, intermediate);
+
+  rows_->clear();
+  groups_.clear();
+  numGroups_ = 0;
+
+  // Recreate the open group with empty accumulators. Input for the group may
+  // still follow.
+  SelectivityVector row(1);
+  for (auto i = 0; i < numKeys; ++i) {
+    decodedKeys_[i].decode(*intermediate->childAt(i), row);
+  }
+  startNewGroup(0);
+  const vector_size_t newGroup = 0;
+  for (auto& aggregate : aggregates_) {
+    aggregate->initializeNewGroups(
+        groups_.data(), folly::Range<const vector_size_t*>(&newGroup, 1));
+  }
+  groupSpilled_ = true;
+  pool()->release();
+}
+
+void StreamingAggregation::mergeSpilledGroup() {
+  VELOX_CHECK(groupSpilled_);
+  VELOX_CHECK_GT(numGroups_, 0);
+  groupSpilled_ = false;
+
+  SpillPartition partition(
+      SpillPartitionId(0, kGroupPartition),
+      spillState_->files(kGroupPartition));
+  auto reader = partition.createReader();
+  const auto numKeys = groupingKeys_.size();
+  RowVectorPtr batch;
+  while (reader->nextBatch(batch)) {
+    SelectivityVector rows(batch->size());
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      aggregates_[i]->addSingleGroupIntermediateResults(
+          groups_[0], rows, {batch->childAt(numKeys + i)}, false);
+    }
+  }
+}
+
+bool StreamingAggregation::testingTriggerSpill() {
+  // Test-only spill path.
+  if (!spillConfig_.has_value() || spillConfig_->testSpillPct == 0) {
+    return false;
+  }
+  return folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct;
+}
+
+void StreamingAggregation::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& /*stats*/) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (numGroups_ == 0) {
+    return;
+  }
+  spill();
+}
+
 void StreamingAggregation::assignGroups() {
   auto numInput = input_->size();
 
@@ -274,10 +426,17 @@ void StreamingAggregation::evaluateAggregates() {
 }
 
 bool StreamingAggregation::isFinished() {
-  return noMoreInput_ && input_ == nullptr && numGroups_ == 0;
+  return noMoreInput_ && input_ == nullptr && numGroups_ == 0 &&
+      spillOutputReader_ == nullptr &&
+      (spillState_ == nullptr || !spillState_->hasFiles(kOutputPartition));
 }
 
 RowVectorPtr StreamingAggregation::getOutput() {
+  // The spilled output precedes the output of the groups in memory.
+  if (auto output = getSpilledOutput()) {
+    return output;
+  }
+
   if (!input_) {
     if (noMoreInput_ && numGroups_ > 0) {
       auto output = createOutput(numGroups_);
@@ -330,6 +489,10 @@ RowVectorPtr StreamingAggregation::getOutput() {
   prevInput_ = input_;
   input_ = nullptr;
 
+  if (numGroups_ > 0 && testingTriggerSpill()) {
+    spill();
+  }
+
   return output;
 }
 
@@ -18,6 +18,7 @@
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spill.h"
 
 namespace facebook::velox::exec {
 
@@ -37,7 +38,7 @@ class StreamingAggregation : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return true;
+    return input_ == nullptr;
   }
 
   BlockingReason isBlocked(ContinueFuture* /* unused */) override {
@@ -46,9 +47,21 @@ class StreamingAggregation : public Operator {
 
   bool isFinished() override;
 
+  /// Spills the groups to disk. The completed groups are written as output,
+  /// to be returned before any later group. The accumulators of the open
+  /// group are written as intermediate results and are merged back when the
+  /// group completes.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
   void close() override;
 
  private:
+  // Spill partition for the output of the completed groups.
+  static constexpr int32_t kOutputPartition = 0;
+  // Spill partition for the intermediate results of the open group.
+  static constexpr int32_t kGroupPartition = 1;
+
   // Returns the rows to aggregate with masking applied if applicable.
   const SelectivityVector& getSelectivityVector(size_t aggregateIndex) const;
 
@@ -63,6 +76,21 @@ class StreamingAggregation : public Operator {
   // of the groups_ vector.
   RowVectorPtr createOutput(size_t numGroups);
 
+  // Returns the next batch of output spilled by spill(), nullptr if there is
+  // none.
+  RowVectorPtr getSpilledOutput();
+
+  // Writes the output of the completed groups and the intermediate results of
+  // the open group to disk, then clears 'rows_' except for the keys of the
+  // open group.
+  void spill();
+
+  // Adds the intermediate results spilled for the first group to its
+  // accumulators.
+  void mergeSpilledGroup();
+
+  bool testingTriggerSpill();
+
   // Assign input rows to groups based on values of the grouping keys. Store the
   // assignments in inputGroups_.
   void assignGroups();
@@ -107,6 +135,23 @@ class StreamingAggregation : public Operator {
   // A subset of input rows to evaluate the aggregate function on. Rows
   // where aggregation mask is false are excluded.
   SelectivityVector inputRows_;
+
+  // Type of the spilled intermediate results: grouping keys followed by
+  // accumulators.
+  RowTypePtr spillType_;
+
+  folly::Synchronized<SpillStats> spillStats_;
+
+  std::unique_ptr<SpillState> spillState_;
+
+  // Reads the spilled output. Set while there is spilled output to return.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillOutputReader_;
+
+  // True if the first group has intermediate results in 'kGroupPartition'.
+  bool groupSpilled_{false};
+
+  // Counts the inputs for the test-only spill trigger.
+  uint32_t spillTestCounter_{0};
 };
 
 } // namespace facebook::velox::exec
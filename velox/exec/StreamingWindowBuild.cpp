@@ -31,6 +31,22 @@ void StreamingWindowBuild::buildNextPartition() {
   inputRows_.clear();
 }
 
+void StreamingWindowBuild::addIncompletePartitionRow(char* row) {
+  const bool newPartition = previousRow_ == nullptr ||
+      compareRowsWithKeys(previousRow_, row, partitionKeyInfo_);
+  if (newPartition) {
+    if (inputPartition_ != nullptr) {
+      inputPartition_->setComplete();
+    }
+    partitions_.push_back(std::make_unique<StreamingWindowPartition>(
+        data_.get(), inputColumns_, sortKeyInfo_));
+    inputPartition_ = partitions_.back().get();
+  }
+  inputPartition_->addRow(
+      row,
+      newPartition || compareRowsWithKeys(previousRow_, row, sortKeyInfo_));
+}
+
 void StreamingWindowBuild::addInput(RowVectorPtr input) {
   for (auto i = 0; i < inputChannels_.size(); ++i) {
     decodedInputVectors_[i].decode(*input->childAt(inputChannels_[i]));
@@ -43,6 +59,12 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
       data_->store(decodedInputVectors_[col], row, newRow, col);
     }
 
+    if (incompletePartitions_) {
+      addIncompletePartitionRow(newRow);
+      previousRow_ = newRow;
+      continue;
+    }
+
     if (previousRow_ != nullptr &&
         compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
       buildNextPartition();
@@ -54,6 +76,14 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
 }
 
 void StreamingWindowBuild::noMoreInput() {
+  if (incompletePartitions_) {
+    if (inputPartition_ != nullptr) {
+      inputPartition_->setComplete();
+      inputPartition_ = nullptr;
+    }
+    return;
+  }
+
   buildNextPartition();
 
   // Help for last partition related calculations.
@@ -61,6 +91,13 @@ void StreamingWindowBuild::noMoreInput() {
 }
 
 std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
+  if (incompletePartitions_) {
+    VELOX_CHECK(!partitions_.empty(), "No window partitions available");
+    auto partition = std::move(partitions_.front());
+    partitions_.pop_front();
+    return partition;
+  }
+
   VELOX_CHECK_GT(
       partitionStartRows_.size(), 0, "No window partitions available")
 
@@ -94,6 +131,9 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
 }
 
 bool StreamingWindowBuild::hasNextPartition() {
+  if (incompletePartitions_) {
+    return !partitions_.empty();
+  }
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < int(partitionStartRows_.size() - 2);
 }
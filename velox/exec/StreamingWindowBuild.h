@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <deque>
+
+#include "velox/exec/StreamingWindowPartition.h"
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -24,6 +27,11 @@ namespace facebook::velox::exec {
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
 /// operator to process.
+///
+/// With enableIncompletePartitions(), a partition is returned as soon as its
+/// first row arrives and its rows are added while the Window operator
+/// evaluates it. Only the rows still accessed by the window functions are
+/// kept instead of the whole partition.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
@@ -42,6 +50,11 @@ class StreamingWindowBuild : public WindowBuild {
     return std::nullopt;
   }
 
+  void enableIncompletePartitions() override {
+    VELOX_CHECK_NULL(previousRow_, "Input was added already");
+    incompletePartitions_ = true;
+  }
+
   void noMoreInput() override;
 
   bool hasNextPartition() override;
@@ -49,6 +62,11 @@ class StreamingWindowBuild : public WindowBuild {
   std::unique_ptr<WindowPartition> nextPartition() override;
 
   bool needsInput() override {
+    if (incompletePartitions_) {
+      // The partitions waiting for output can be incomplete. The last one
+      // receives the input rows once the Window operator gets to it.
+      return partitions_.empty();
+    }
     // No partitions are available or the currentPartition is the last available
     // one, so can consume input rows.
     return partitionStartRows_.size() == 0 ||
@@ -58,6 +76,9 @@ class StreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Adds 'row' to 'inputPartition_' or to a new partition if 'row' starts one.
+  void addIncompletePartitionRow(char* row);
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -77,6 +98,17 @@ class StreamingWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  // True if partitions are returned before all their rows are added.
+  bool incompletePartitions_{false};
+
+  // The partitions not taken by the Window operator yet if
+  // 'incompletePartitions_' is true.
+  std::deque<std::unique_ptr<StreamingWindowPartition>> partitions_;
+
+  // The partition the input rows are added to. Owned by 'partitions_' or by
+  // the Window operator, which keeps the partition until it is complete.
+  StreamingWindowPartition* inputPartition_{nullptr};
 };
 
 } // namespace facebook::velox::exec
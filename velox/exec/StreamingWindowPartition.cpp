@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/StreamingWindowPartition.h"
+
+namespace facebook::velox::exec {
+
+StreamingWindowPartition::StreamingWindowPartition(
+    RowContainer* data,
+    const std::vector<exec::RowColumn>& columns,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : WindowPartition(data, 0, columns, sortKeyInfo) {}
+
+StreamingWindowPartition::~StreamingWindowPartition() {
+  if (!rows_.empty()) {
+    data_->eraseRows(folly::Range(rows_.data(), rows_.size()));
+  }
+}
+
+void StreamingWindowPartition::addRow(char* row, bool newPeerGroup) {
+  VELOX_CHECK(!complete_, "Cannot add rows to a complete window partition");
+  if (newPeerGroup) {
+    lastPeerGroupStart_ = numRows_;
+  }
+  rows_.push_back(row);
+  partition_ = folly::Range(rows_.data(), rows_.size());
+  ++numRows_;
+}
+
+void StreamingWindowPartition::removeRowsBefore(vector_size_t row) {
+  const auto numRemoved =
+      std::min<vector_size_t>(row - startRow_, rows_.size());
+  if (numRemoved <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range(rows_.data(), numRemoved));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemoved);
+  startRow_ += numRemoved;
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/WindowPartition.h"
+
+namespace facebook::velox::exec {
+
+/// WindowPartition of sorted input that the StreamingWindowBuild returns before
+/// all its rows arrive. The build adds the rows to the partition as input
+/// arrives. The Window operator evaluates the rows whose peer group and
+/// following rows accessed by the window functions have been added. The rows
+/// that are not accessed anymore are removed from the RowContainer by
+/// removeRowsBefore(), so only the rows around the current row are kept.
+class StreamingWindowPartition : public WindowPartition {
+ public:
+  StreamingWindowPartition(
+      RowContainer* data,
+      const std::vector<exec::RowColumn>& columns,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Erases the rows that were not removed from the RowContainer.
+  ~StreamingWindowPartition() override;
+
+  /// Adds 'row' of the RowContainer at the end of the partition.
+  /// 'newPeerGroup' is true if 'row' is not a peer of the previous row.
+  void addRow(char* row, bool newPeerGroup);
+
+  /// Invoked by the build after the last row of the partition is added.
+  void setComplete() {
+    complete_ = true;
+  }
+
+  bool complete() const override {
+    return complete_;
+  }
+
+  vector_size_t lastPeerGroupStart() const override {
+    return lastPeerGroupStart_;
+  }
+
+  void removeRowsBefore(vector_size_t row) override;
+
+ private:
+  // Pointers to the partition rows in the RowContainer starting at
+  // 'startRow_'.
+  std::vector<char*> rows_;
+
+  bool complete_{false};
+
+  vector_size_t lastPeerGroupStart_{0};
+};
+
+} // namespace facebook::velox::exec
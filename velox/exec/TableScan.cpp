@@ -14,10 +14,14 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include <folly/json.h>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/FilterProject.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
+#include "velox/vector/VectorStream.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -25,6 +29,25 @@ DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns the serialization of 'node' without its id, so that the same scan
+// in different plans has the same key, or an empty string if 'node' is not
+// serializable.
+std::string tableScanNodeKey(const core::TableScanNode& node) {
+  try {
+    auto serialized = node.serialize();
+    serialized.erase("id");
+    folly::json::serialization_opts opts;
+    opts.sort_keys = true;
+    return folly::json::serialize(serialized, opts);
+  } catch (const std::exception& e) {
+    VLOG(1) << "Not caching the results of TableScan " << node.id() << ": "
+            << e.what();
+    return "";
+  }
+}
+} // namespace
+
 std::atomic<uint64_t> TableScan::ioWaitNanos_;
 
 TableScan::TableScan(
@@ -46,11 +69,20 @@ TableScan::TableScan(
           driverCtx_->driverId,
           operatorType(),
           tableHandle_->connectorId())),
+      maxSplitPreloadDepth_(
+          driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
-          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()) {
+          driverCtx_->queryConfig().tableScanGetOutputTimeLimitMs()),
+      fragmentResultCacheEnabled_(
+          driverCtx_->queryConfig().fragmentResultCacheEnabled()),
+      maxCachedSplitBytes_(
+          driverCtx_->queryConfig().fragmentResultCacheMaxSplitBytes()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
+  if (fragmentResultCacheEnabled_) {
+    tableScanNodeKey_ = tableScanNodeKey(*tableScanNode);
+  }
 }
 
 RowVectorPtr TableScan::getOutput() {
@@ -60,6 +92,19 @@ RowVectorPtr TableScan::getOutput() {
 
   const auto startTimeMs = getCurrentTimeMs();
   for (;;) {
+    if (readingCachedSplit_) {
+      while (!cachedOutput_.empty()) {
+        auto output = std::move(cachedOutput_.front());
+        cachedOutput_.pop_front();
+        if (output->size() > 0) {
+          return output;
+        }
+      }
+      readingCachedSplit_ = false;
+      driverCtx_->task->splitFinished();
+      needNewSplit_ = true;
+    }
+
     if (needNewSplit_) {
       // Check if our Task needs us to yield or we've been running for too long
       // w/o producing a result. In this case we return with the Yield blocking
@@ -79,15 +124,22 @@ RowVectorPtr TableScan::getOutput() {
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
       exec::Split split;
-      blockingReason_ = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId,
-          planNodeId(),
-          split,
-          blockingFuture_,
-          maxPreloadedSplits_,
-          splitPreloader_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        return nullptr;
+      // True if 'split' is a preloaded split that the previous call returned
+      // to wait for.
+      const bool preloadWaited = waitingPreloadedSplit_.hasConnectorSplit();
+      if (preloadWaited) {
+        split = std::move(waitingPreloadedSplit_);
+      } else {
+        blockingReason_ = driverCtx_->task->getSplitOrFuture(
+            driverCtx_->splitGroupId,
+            planNodeId(),
+            split,
+            blockingFuture_,
+            maxPreloadedSplits_,
+            splitPreloader_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
       }
 
       if (!split.hasConnectorSplit()) {
@@ -121,6 +173,13 @@ RowVectorPtr TableScan::getOutput() {
           connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (!preloadWaited && readCachedResult(*connectorSplit)) {
+        // A preloaded DataSource of the split is not used.
+        ++stats_.wlock()->numSplits;
+        readingCachedSplit_ = true;
+        continue;
+      }
+
       if (!dataSource_) {
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
             connectorSplit->connectorId, planNodeId(), connectorPool_);
@@ -147,11 +206,41 @@ RowVectorPtr TableScan::getOutput() {
            &debugString_});
 
       if (connectorSplit->dataSource) {
-        ++numPreloadedSplits_;
+        if (preloadWaited) {
+          preloadWaitMicros_ += getCurrentTimeMicro() - preloadWaitStartMicros_;
+        } else {
+          ++numPreloadedSplits_;
+          // The preload is still running on the connector's executor, e.g.
+          // opening a file on remote storage. The Driver waits for it off
+          // thread and the split is taken again when it is ready.
+          if (connectorSplit->dataSource->isPreparing(blockingFuture_)) {
+            ++numPreloadWaits_;
+            preloadWaitStartMicros_ = getCurrentTimeMicro();
+            adjustSplitPreloadDepth(false);
+            waitingPreloadedSplit_ = std::move(split);
+            needNewSplit_ = true;
+            blockingReason_ = BlockingReason::kWaitForConnector;
+            return nullptr;
+          }
+        }
+        const bool ready =
+            preloadWaited || connectorSplit->dataSource->hasValue();
+        numReadyPreloadedSplits_ += ready && !preloadWaited;
         // The AsyncSource returns a unique_ptr to a shared_ptr. The
         // unique_ptr will be nullptr if there was a cancellation.
-        numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
-        auto preparedDataSource = connectorSplit->dataSource->move();
+        std::unique_ptr<connector::DataSource> preparedDataSource;
+        {
+          uint64_t waitMicros{0};
+          MicrosecondTimer timer(&waitMicros);
+          preparedDataSource = connectorSplit->dataSource->move();
+          if (!ready) {
+            ++numPreloadWaits_;
+            preloadWaitMicros_ += waitMicros;
+          }
+        }
+        if (!preloadWaited) {
+          adjustSplitPreloadDepth(ready);
+        }
         stats_.wlock()->getOutputTiming.add(
             connectorSplit->dataSource->prepareTiming());
         if (!preparedDataSource) {
@@ -184,7 +273,7 @@ RowVectorPtr TableScan::getOutput() {
          },
          &debugString_});
 
-    int readBatchSize = readBatchSize_;
+    int readBatchSize = adaptiveOutputBatchRows(readBatchSize_);
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
           maxReadBatchSize_,
@@ -217,7 +306,10 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
-          return data;
+          if (auto output = applyFusedFilterProject(std::move(data))) {
+            addToCachedResult(output);
+            return output;
+          }
         }
         continue;
       }
@@ -235,13 +327,128 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numPreloadWaits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "preloadedSplitWaits", RuntimeCounter(numPreloadWaits_));
+        lockedStats->addRuntimeStat(
+            "preloadedSplitWaitNanos",
+            RuntimeCounter(
+                preloadWaitMicros_ * 1'000, RuntimeCounter::Unit::kNanos));
+        numPreloadWaits_ = 0;
+        preloadWaitMicros_ = 0;
+      }
     }
 
+    storeCachedResult();
     driverCtx_->task->splitFinished();
     needNewSplit_ = true;
   }
 }
 
+const std::string& TableScan::fragmentCacheKeyPrefix() {
+  if (fragmentCacheKeyPrefix_.has_value()) {
+    return fragmentCacheKeyPrefix_.value();
+  }
+  fragmentCacheKeyPrefix_ = "";
+  if (tableScanNodeKey_.empty() || !isRegisteredVectorSerde() ||
+      cache::AsyncDataCache::getInstance() == nullptr) {
+    return fragmentCacheKeyPrefix_.value();
+  }
+  if (fusedFilterProject_ == nullptr) {
+    fragmentCacheKeyPrefix_ = tableScanNodeKey_;
+  } else if (auto filterProjectKey = fusedFilterProject_->cacheKey();
+             !filterProjectKey.empty()) {
+    fragmentCacheKeyPrefix_ =
+        fmt::format("{} {}", tableScanNodeKey_, filterProjectKey);
+  }
+  return fragmentCacheKeyPrefix_.value();
+}
+
+bool TableScan::readCachedResult(const connector::ConnectorSplit& split) {
+  splitCacheKey_.clear();
+  splitResult_.reset();
+  splitResultBytes_ = 0;
+  if (!fragmentResultCacheEnabled_ || hasDynamicFilters_ ||
+      fragmentCacheKeyPrefix().empty()) {
+    return false;
+  }
+  auto splitKey = split.cacheKey();
+  if (splitKey.empty()) {
+    return false;
+  }
+  auto key = fmt::format("{} {}", fragmentCacheKeyPrefix(), splitKey);
+  const auto& type = fusedFilterProject_ == nullptr
+      ? outputType_
+      : fusedFilterProject_->outputType();
+  FragmentResultCache cache(cache::AsyncDataCache::getInstance());
+  auto cached = cache.get(key, type, pool());
+  if (cached.has_value()) {
+    stats_.wlock()->addRuntimeStat(
+        "fragmentResultCacheHits", RuntimeCounter(1));
+    cachedOutput_.assign(
+        std::make_move_iterator(cached->begin()),
+        std::make_move_iterator(cached->end()));
+    return true;
+  }
+  stats_.wlock()->addRuntimeStat(
+      "fragmentResultCacheMisses", RuntimeCounter(1));
+  splitCacheKey_ = std::move(key);
+  return false;
+}
+
+void TableScan::addToCachedResult(const RowVectorPtr& output) {
+  if (splitCacheKey_.empty()) {
+    return;
+  }
+  if (hasDynamicFilters_) {
+    splitCacheKey_.clear();
+    splitResult_.reset();
+    return;
+  }
+  // Loads the lazy vectors, which are not readable after the next batch.
+  output->loadedVector();
+  auto serialized =
+      std::make_unique<folly::IOBuf>(rowVectorToIOBuf(output, *pool()));
+  splitResultBytes_ += serialized->computeChainDataLength();
+  if (splitResultBytes_ > maxCachedSplitBytes_) {
+    splitCacheKey_.clear();
+    splitResult_.reset();
+    return;
+  }
+  if (splitResult_ == nullptr) {
+    splitResult_ = std::move(serialized);
+  } else {
+    splitResult_->prependChain(std::move(serialized));
+  }
+}
+
+void TableScan::storeCachedResult() {
+  if (splitCacheKey_.empty() || hasDynamicFilters_) {
+    return;
+  }
+  // A split with no output is cached as an empty vector so that a hit does
+  // not read the split.
+  if (splitResult_ == nullptr) {
+    splitResult_ = std::make_unique<folly::IOBuf>(rowVectorToIOBuf(
+        BaseVector::create<RowVector>(
+            fusedFilterProject_ == nullptr ? outputType_
+                                           : fusedFilterProject_->outputType(),
+            0,
+            pool()),
+        *pool()));
+    splitResultBytes_ = splitResult_->computeChainDataLength();
+  }
+  FragmentResultCache cache(cache::AsyncDataCache::getInstance());
+  if (cache.put(splitCacheKey_, *splitResult_)) {
+    stats_.wlock()->addRuntimeStat(
+        "fragmentResultCacheStoredBytes",
+        RuntimeCounter(splitResultBytes_, RuntimeCounter::Unit::kBytes));
+  }
+  splitCacheKey_.clear();
+  splitResult_.reset();
+  splitResultBytes_ = 0;
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -279,13 +486,13 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
 
 void TableScan::checkPreload() {
   auto executor = connector_->executor();
-  if (FLAGS_split_preload_per_driver == 0 || !executor ||
-      !connector_->supportsSplitPreload()) {
+  if (FLAGS_split_preload_per_driver == 0 || maxSplitPreloadDepth_ == 0 ||
+      !executor || !connector_->supportsSplitPreload()) {
     return;
   }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        FLAGS_split_preload_per_driver;
+        splitPreloadDepth_;
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor, this](std::shared_ptr<connector::ConnectorSplit> split) {
@@ -300,6 +507,21 @@ void TableScan::checkPreload() {
   }
 }
 
+void TableScan::adjustSplitPreloadDepth(bool preloadWasReady) {
+  // Preloaded splits hold their DataSources and the first reads of their
+  // files. These are given up first when the query is short of memory.
+  const auto* queryPool = connectorPool_->root();
+  if (queryPool->capacity() != memory::kMaxMemory &&
+      queryPool->currentBytes() > queryPool->capacity() / 2) {
+    splitPreloadDepth_ = 1;
+    return;
+  }
+  if (!preloadWasReady) {
+    splitPreloadDepth_ =
+        std::min(splitPreloadDepth_ + 1, maxSplitPreloadDepth_);
+  }
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
@@ -307,6 +529,7 @@ bool TableScan::isFinished() {
 void TableScan::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
+  hasDynamicFilters_ = true;
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   } else {
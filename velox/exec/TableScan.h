@@ -15,8 +15,11 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Split.h"
 
 DECLARE_int32(split_preload_per_driver);
 
@@ -45,6 +48,10 @@ class TableScan : public SourceOperator {
     return connector_->canAddDynamicFilter();
   }
 
+  bool canFuseFilterProject() const override {
+    return true;
+  }
+
   void addDynamicFilter(
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
@@ -63,12 +70,35 @@ class TableScan : public SourceOperator {
   // when getting splits.
   void checkPreload();
 
+  // Grows 'splitPreloadDepth_' after a preloaded split was not ready when
+  // taken, unless the query is short of memory, in which case the depth goes
+  // back to one.
+  void adjustSplitPreloadDepth(bool preloadWasReady);
+
   // Sets 'split->dataSource' to be a Asyncsource that makes a
   // DataSource to read 'split'. This source will be prepared in the
   // background on the executor of the connector. If the DataSource is
   // needed before prepare is done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Returns the part of the fragment result cache keys that identifies the
+  // fragment, i.e. the scan and any fused FilterProject, or an empty string
+  // if the results of 'this' are not cached. Computed at the first split,
+  // after the FilterProject is fused and initialized.
+  const std::string& fragmentCacheKeyPrefix();
+
+  // Looks up the output for 'split' in the fragment result cache. On a hit,
+  // sets 'cachedOutput_' and returns true. On a miss, starts collecting the
+  // output of 'split' for caching when the split finishes.
+  bool readCachedResult(const connector::ConnectorSplit& split);
+
+  // Adds 'output' to the serialized output of the current split. Stops
+  // collecting if the output exceeds 'maxCachedSplitBytes_'.
+  void addToCachedResult(const RowVectorPtr& output);
+
+  // Caches the collected output of the finished split.
+  void storeCachedResult();
+
   // Process-wide IO wait time.
   static std::atomic<uint64_t> ioWaitNanos_;
 
@@ -91,6 +121,13 @@ class TableScan : public SourceOperator {
 
   int32_t maxPreloadedSplits_{0};
 
+  // The number of splits per Driver to preload. Adjusted between 1 and
+  // 'maxSplitPreloadDepth_' by adjustSplitPreloadDepth().
+  int32_t splitPreloadDepth_{1};
+
+  // QueryConfig::maxSplitPreloadPerDriver().
+  const int32_t maxSplitPreloadDepth_;
+
   // Callback passed to getSplitOrFuture() for triggering async
   // preload. The callback's lifetime is the lifetime of 'this'. This
   // callback can schedule preloads on an executor. These preloads may
@@ -105,6 +142,16 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Count and wait time of the preloaded splits that were not ready when
+  // taken.
+  int32_t numPreloadWaits_{0};
+  uint64_t preloadWaitMicros_{0};
+
+  // The preloaded split that getOutput() returned kWaitForConnector for until
+  // its DataSource is made, and the time the wait started.
+  exec::Split waitingPreloadedSplit_;
+  uint64_t preloadWaitStartMicros_{0};
+
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
@@ -117,6 +164,33 @@ class TableScan : public SourceOperator {
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
+  // QueryConfig::fragmentResultCacheEnabled() and
+  // fragmentResultCacheMaxSplitBytes().
+  const bool fragmentResultCacheEnabled_;
+  const uint64_t maxCachedSplitBytes_;
+
+  // The serialized TableScanNode without its id. Empty if the node is not
+  // serializable or caching is disabled.
+  std::string tableScanNodeKey_;
+
+  // See fragmentCacheKeyPrefix().
+  std::optional<std::string> fragmentCacheKeyPrefix_;
+
+  // Set when a dynamic filter is added. The output then depends on the build
+  // side of a join and is neither cached nor read from the cache.
+  bool hasDynamicFilters_{false};
+
+  // The cache key of the current split and its serialized output so far.
+  // Empty if the output of the split is not being collected.
+  std::string splitCacheKey_;
+  std::unique_ptr<folly::IOBuf> splitResult_;
+  uint64_t splitResultBytes_{0};
+
+  // The cached output of the current split that is yet to be returned.
+  // 'readingCachedSplit_' is true while the split is read from the cache.
+  std::deque<RowVectorPtr> cachedOutput_;
+  bool readingCachedSplit_{false};
+
   // The last value of the IO wait time of 'this' that has been added to the
   // global static 'ioWaitNanos_'.
   uint64_t lastIoWaitNanos_{0};
@@ -292,6 +292,7 @@ Task::~Task() {
   CLEAR(splitsStates_.clear());
   CLEAR(drivers_.clear());
   CLEAR(driverFactories_.clear());
+  CLEAR(exprCompileCache_.clear());
   CLEAR(onError_ = [](std::exception_ptr) {});
   CLEAR(exchangeClientByPlanNode_.clear());
   CLEAR(exchangeClients_.clear());
@@ -1049,6 +1050,20 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   }
 }
 
+bool Task::canStartSplitGroupLocked() const {
+  if (numRunningSplitGroups_ == 0) {
+    return true;
+  }
+  const auto admissionPct =
+      queryCtx_->queryConfig().splitGroupAdmissionMemoryPct();
+  const auto* root = pool_->root();
+  const auto capacity = root->capacity();
+  if (admissionPct >= 100 || capacity == memory::kMaxMemory) {
+    return true;
+  }
+  return root->currentBytes() < capacity / 100 * admissionPct;
+}
+
 void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   // Only try creating more drivers if we are running.
   if (not isRunningLocked() or (numDriversPerSplitGroup_ == 0)) {
@@ -1056,7 +1071,7 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   }
 
   while (numRunningSplitGroups_ < concurrentSplitGroups_ and
-         not queuedSplitGroups_.empty()) {
+         not queuedSplitGroups_.empty() and canStartSplitGroupLocked()) {
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
 
@@ -1111,7 +1126,7 @@ bool Task::addSplitWithSequence(
       // duplicate splits would be ignored.
       auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
       if (sequenceId > splitsState.maxSequenceId) {
-        promise = addSplitLocked(splitsState, std::move(split));
+        promise = addSplitLocked(planNodeId, splitsState, std::move(split));
         added = true;
       }
     }
@@ -1136,7 +1151,9 @@ void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
     isTaskRunning = isRunningLocked();
     if (isTaskRunning) {
       promise = addSplitLocked(
-          getPlanNodeSplitsStateLocked(planNodeId), std::move(split));
+          planNodeId,
+          getPlanNodeSplitsStateLocked(planNodeId),
+          std::move(split));
     }
   }
 
@@ -1165,16 +1182,24 @@ void Task::addRemoteSplit(
 }
 
 std::unique_ptr<ContinuePromise> Task::addSplitLocked(
+    const core::PlanNodeId& planNodeId,
     SplitsState& splitsState,
     exec::Split&& split) {
-  ++taskStats_.numTotalSplits;
-  ++taskStats_.numQueuedSplits;
+  ++numTotalSplits_;
+  ++numQueuedSplits_;
 
   if (split.connectorSplit) {
     VELOX_CHECK_NULL(split.connectorSplit->dataSource);
+    if (!split.hasGroup() &&
+        planFragment_.leafNodeRunsGroupedExecution(planNodeId)) {
+      if (auto bucket = split.connectorSplit->bucketNumber()) {
+        split.groupId = bucket.value();
+      }
+    }
   }
 
   if (!split.hasGroup()) {
+    std::lock_guard<std::mutex> l(splitsState.mutex);
     return addSplitToStoreLocked(
         splitsState.groupSplitsStores[kUngroupedGroupId], std::move(split));
   }
@@ -1188,6 +1213,7 @@ std::unique_ptr<ContinuePromise> Task::addSplitLocked(
     // We might have some free driver slots to process this split group.
     ensureSplitGroupsAreBeingProcessedLocked();
   }
+  std::lock_guard<std::mutex> l(splitsState.mutex);
   return addSplitToStoreLocked(
       splitsState.groupSplitsStores[splitGroupId], std::move(split));
 }
@@ -1214,9 +1240,12 @@ void Task::noMoreSplitsForGroup(
     std::lock_guard<std::mutex> l(mutex_);
 
     auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
-    auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
-    splitsStore.noMoreSplits = true;
-    promises = std::move(splitsStore.splitPromises);
+    {
+      std::lock_guard<std::mutex> sl(splitsState.mutex);
+      auto& splitsStore = splitsState.groupSplitsStores[splitGroupId];
+      splitsStore.noMoreSplits = true;
+      promises = std::move(splitsStore.splitPromises);
+    }
 
     // There were no splits in this group, hence, no active drivers. Mark the
     // group complete.
@@ -1243,17 +1272,20 @@ void Task::noMoreSplits(const core::PlanNodeId& planNodeId) {
     // comes when no more split groups will arrive for that plan node.
     auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
     splitsState.noMoreSplits = true;
-    if (not splitsState.groupSplitsStores.empty()) {
-      // Mark all split stores as 'no more splits'.
-      for (auto& it : splitsState.groupSplitsStores) {
-        it.second.noMoreSplits = true;
-        splitPromises = std::move(it.second.splitPromises);
+    {
+      std::lock_guard<std::mutex> sl(splitsState.mutex);
+      if (not splitsState.groupSplitsStores.empty()) {
+        // Mark all split stores as 'no more splits'.
+        for (auto& it : splitsState.groupSplitsStores) {
+          it.second.noMoreSplits = true;
+          splitPromises = std::move(it.second.splitPromises);
+        }
+      } else if (!planFragment_.leafNodeRunsGroupedExecution(planNodeId)) {
+        // During ungrouped execution, in the unlikely case there are no split
+        // stores (this means there were no splits at all), we create one.
+        splitsState.groupSplitsStores.emplace(
+            kUngroupedGroupId, SplitsStore{{}, true, {}});
       }
-    } else if (!planFragment_.leafNodeRunsGroupedExecution(planNodeId)) {
-      // During ungrouped execution, in the unlikely case there are no split
-      // stores (this means there were no splits at all), we create one.
-      splitsState.groupSplitsStores.emplace(
-          kUngroupedGroupId, SplitsStore{{}, true, {}});
     }
 
     allFinished = checkNoMoreSplitGroupsLocked();
@@ -1301,10 +1333,30 @@ bool Task::checkNoMoreSplitGroupsLocked() {
 }
 
 bool Task::isAllSplitsFinishedLocked() {
-  return (taskStats_.numFinishedSplits == taskStats_.numTotalSplits) &&
+  return (numFinishedSplits_ == numTotalSplits_) &&
       allNodesReceivedNoMoreSplitsMessageLocked();
 }
 
+void Task::checkAllSplitsFinished() {
+  // Splits are added under 'mutex_', so the check is repeated under it.
+  if (numFinishedSplits_ != numTotalSplits_) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (isAllSplitsFinishedLocked()) {
+    taskStats_.executionEndTimeMs = getCurrentTimeMs();
+  }
+}
+
+void Task::copySplitStats(TaskStats& stats) const {
+  stats.numTotalSplits = numTotalSplits_;
+  stats.numFinishedSplits = numFinishedSplits_;
+  stats.numRunningSplits = numRunningSplits_;
+  stats.numQueuedSplits = numQueuedSplits_;
+  stats.firstSplitStartTimeMs = firstSplitStartTimeMs_;
+  stats.lastSplitStartTimeMs = lastSplitStartTimeMs_;
+}
+
 BlockingReason Task::getSplitOrFuture(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
@@ -1312,9 +1364,12 @@ BlockingReason Task::getSplitOrFuture(
     ContinueFuture& future,
     int32_t maxPreloadSplits,
     std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload) {
-  std::lock_guard<std::mutex> l(mutex_);
+  // 'splitsStates_' does not change after construction, so it is read without
+  // 'mutex_'.
+  auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+  std::lock_guard<std::mutex> l(splitsState.mutex);
   return getSplitOrFutureLocked(
-      getPlanNodeSplitsStateLocked(planNodeId).groupSplitsStores[splitGroupId],
+      splitsState.groupSplitsStores[splitGroupId],
       split,
       future,
       maxPreloadSplits,
@@ -1339,6 +1394,7 @@ BlockingReason Task::getSplitOrFutureLocked(
   }
 
   split = getSplitLocked(splitsStore, maxPreloadSplits, preload);
+  divideSplitLocked(splitsStore, split);
   return BlockingReason::kNotBlocked;
 }
 
@@ -1366,32 +1422,48 @@ exec::Split Task::getSplitLocked(
   auto split = std::move(splitsStore.splits[readySplitIndex]);
   splitsStore.splits.erase(splitsStore.splits.begin() + readySplitIndex);
 
-  --taskStats_.numQueuedSplits;
-  ++taskStats_.numRunningSplits;
-  taskStats_.lastSplitStartTimeMs = getCurrentTimeMs();
-  if (taskStats_.firstSplitStartTimeMs == 0) {
-    taskStats_.firstSplitStartTimeMs = taskStats_.lastSplitStartTimeMs;
-  }
+  --numQueuedSplits_;
+  ++numRunningSplits_;
+  const auto nowMs = getCurrentTimeMs();
+  lastSplitStartTimeMs_ = nowMs;
+  uint64_t noStartTime = 0;
+  firstSplitStartTimeMs_.compare_exchange_strong(noStartTime, nowMs);
 
   return split;
 }
 
-void Task::splitFinished() {
-  std::lock_guard<std::mutex> l(mutex_);
-  ++taskStats_.numFinishedSplits;
-  --taskStats_.numRunningSplits;
-  if (isAllSplitsFinishedLocked()) {
-    taskStats_.executionEndTimeMs = getCurrentTimeMs();
+void Task::divideSplitLocked(SplitsStore& splitsStore, exec::Split& split) {
+  const auto morselBytes = queryCtx_->queryConfig().tableScanSplitMorselBytes();
+  // A split that is preloading has its data source made for its whole range.
+  if (morselBytes == 0 || !split.hasConnectorSplit() ||
+      split.connectorSplit->dataSource != nullptr) {
+    return;
   }
+  auto morsels = split.connectorSplit->divide(morselBytes);
+  if (morsels.size() <= 1) {
+    return;
+  }
+  // The first morsel is returned and the others go to the head of the queue,
+  // where the next Driver that asks for a split takes them.
+  for (auto i = morsels.size() - 1; i > 0; --i) {
+    splitsStore.splits.emplace_front(std::move(morsels[i]), split.groupId);
+  }
+  const auto numAdded = morsels.size() - 1;
+  numTotalSplits_ += numAdded;
+  numQueuedSplits_ += numAdded;
+  split = exec::Split(std::move(morsels[0]), split.groupId);
+}
+
+void Task::splitFinished() {
+  --numRunningSplits_;
+  ++numFinishedSplits_;
+  checkAllSplitsFinished();
 }
 
 void Task::multipleSplitsFinished(int32_t numSplits) {
-  std::lock_guard<std::mutex> l(mutex_);
-  taskStats_.numFinishedSplits += numSplits;
-  taskStats_.numRunningSplits -= numSplits;
-  if (isAllSplitsFinishedLocked()) {
-    taskStats_.executionEndTimeMs = getCurrentTimeMs();
-  }
+  numRunningSplits_ -= numSplits;
+  numFinishedSplits_ += numSplits;
+  checkAllSplitsFinished();
 }
 
 bool Task::isGroupedExecution() const {
@@ -1790,6 +1862,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
     // Collect all outstanding split promises from all splits state structures.
     for (auto& pair : splitsStates_) {
       auto& splitState = pair.second;
+      std::lock_guard<std::mutex> sl(splitState.mutex);
       for (auto& it : pair.second.groupSplitsStores) {
         movePromisesOut(it.second.splitPromises, splitPromises);
       }
@@ -1879,12 +1952,17 @@ void Task::addOperatorStats(OperatorStats& stats) {
       .add(stats);
 }
 
+std::string Task::driverTimelinesToChromeTrace() const {
+  return toChromeTrace(driverTimelines_.copy());
+}
+
 TaskStats Task::taskStats() const {
   std::lock_guard<std::mutex> l(mutex_);
 
   // 'taskStats_' contains task stats plus stats for the completed drivers
   // (their operators).
   TaskStats taskStats = taskStats_;
+  copySplitStats(taskStats);
 
   taskStats.numTotalDrivers = drivers_.size();
 
@@ -1932,6 +2010,7 @@ TaskStats Task::taskStats() const {
   auto bufferManager = bufferManager_.lock();
   taskStats.outputBufferUtilization = bufferManager->getUtilization(taskId_);
   taskStats.outputBufferOverutilized = bufferManager->isOverutilized(taskId_);
+  taskStats.cpuProfile = cpuProfile_.stacks();
 
   return taskStats;
 }
@@ -1969,6 +2048,7 @@ void Task::onTaskCompletion() {
     {
       std::lock_guard<std::mutex> l(mutex_);
       stats = taskStats_;
+      copySplitStats(stats);
       state = state_;
       exception = exception_;
     }
@@ -2448,6 +2528,18 @@ ContinueFuture Task::requestPause() {
   return makeFinishFutureLocked("Task::requestPause");
 }
 
+size_t Task::clearVectorPools() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(pauseRequested_);
+  size_t numFreed = 0;
+  for (auto& driver : drivers_) {
+    if (driver != nullptr) {
+      numFreed += driver->clearVectorPools();
+    }
+  }
+  return numFreed;
+}
+
 void Task::createExchangeClientLocked(
     int32_t pipelineId,
     const core::PlanNodeId& planNodeId) {
@@ -2543,6 +2635,10 @@ uint64_t Task::MemoryReclaimer::reclaim(
   if (task->isCancelled()) {
     return 0;
   }
+  // Free the vectors cached for reuse first. This returns memory to the
+  // operator pools, which is then freed by shrinking the pools. The drivers
+  // are paused so their vector pools are not in use.
+  task->clearVectorPools();
   return memory::MemoryReclaimer::reclaim(pool, targetBytes, stats);
 }
 
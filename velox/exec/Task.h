@@ -15,14 +15,17 @@
  */
 #pragma once
 #include "velox/core/PlanFragment.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/DriverTimeline.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/expression/ExprCompileCache.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
@@ -193,6 +196,12 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Adds split for a source operator corresponding to plan node with
   /// specified ID. Does not require sequential id.
   /// Note that, the operation is silently ignored if Task is not running.
+  ///
+  /// In grouped execution, a split without a group whose connector split has
+  /// a bucket number, e.g. of a bucketed Hive table, goes to the split group
+  /// of that bucket. The splits of the same bucket of the tables on both
+  /// sides of a join or under an aggregation on the bucket keys then run in
+  /// the same split group, with no repartitioning.
   void addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split);
 
   /// We mark that for the given group there would be no more splits coming.
@@ -259,6 +268,29 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Receives the CPU samples of the Drivers of 'this' while the
+  /// process::SamplingProfiler is running.
+  process::CpuProfile& cpuProfile() {
+    return cpuProfile_;
+  }
+
+  /// Shares constant folding and function resolution between the ExprSets
+  /// that the Drivers of 'this' compile from the same plan nodes.
+  ExprCompileCache& exprCompileCache() {
+    return exprCompileCache_;
+  }
+
+  /// Adds the timeline of a Driver of 'this'. Called when the Driver is
+  /// created with QueryConfig::kDriverTimelineEnabled.
+  void addDriverTimeline(std::shared_ptr<DriverTimeline> timeline) {
+    driverTimelines_.wlock()->push_back(std::move(timeline));
+  }
+
+  /// Returns the queued, on-thread and blocked times of the Drivers of 'this'
+  /// as Chrome trace event JSON. Has no events unless
+  /// QueryConfig::kDriverTimelineEnabled is set.
+  std::string driverTimelinesToChromeTrace() const;
+
   /// Returns time (ms) since the task execution started or zero, if not
   /// started.
   uint64_t timeSinceStartMs() const;
@@ -531,6 +563,11 @@ class Task : public std::enable_shared_from_this<Task> {
   /// can be resumed with resume() after the future is realized.
   ContinueFuture requestPause();
 
+  /// Frees the vectors cached for reuse by the drivers of 'this'. Must be
+  /// called after a pause requested by requestPause() has taken effect.
+  /// Returns the number of freed vectors.
+  size_t clearVectorPools();
+
   /// Requests activity of 'this' to stop. The returned future will be
   /// realized when the last thread stops running for 'this'. This is used to
   /// mark cancellation by the user.
@@ -743,6 +780,7 @@ class Task : public std::enable_shared_from_this<Task> {
       const exec::Split& split);
 
   /// Retrieve a split or split future from the given split store structure.
+  /// The caller holds the mutex of the SplitsState of 'splitsStore'.
   BlockingReason getSplitOrFutureLocked(
       SplitsStore& splitsStore,
       exec::Split& split,
@@ -758,6 +796,11 @@ class Task : public std::enable_shared_from_this<Task> {
       int32_t maxPreloadSplits,
       std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload);
 
+  // If QueryConfig::kTableScanSplitMorselBytes is set, replaces 'split' with
+  // the first of the morsels it divides into and puts the others at the head
+  // of 'splitsStore'.
+  void divideSplitLocked(SplitsStore& splitsStore, exec::Split& split);
+
   // Creates for the given split group and fills up the 'SplitGroupState'
   // structure, which stores inter-operator state (local exchange, bridges).
   void createSplitGroupStateLocked(uint32_t splitGroupId);
@@ -767,6 +810,10 @@ class Task : public std::enable_shared_from_this<Task> {
   // processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked();
 
+  // Returns true if another split group can start next to the running ones
+  // within QueryConfig::splitGroupAdmissionMemoryPct().
+  bool canStartSplitGroupLocked() const;
+
   void driverClosedLocked();
 
   // Returns true if Task is in kRunning state, but all output drivers finished
@@ -791,7 +838,15 @@ class Task : public std::enable_shared_from_this<Task> {
   // splits coming for the task.
   bool isAllSplitsFinishedLocked();
 
+  // Sets the execution end time if all splits are finished. Called after a
+  // split finishes.
+  void checkAllSplitsFinished();
+
+  // Copies the split counts and times to 'stats'.
+  void copySplitStats(TaskStats& stats) const;
+
   std::unique_ptr<ContinuePromise> addSplitLocked(
+      const core::PlanNodeId& planNodeId,
       SplitsState& splitsState,
       exec::Split&& split);
 
@@ -1008,6 +1063,26 @@ class Task : public std::enable_shared_from_this<Task> {
 
   TaskStats taskStats_;
 
+  process::CpuProfile cpuProfile_;
+
+  // Holds vectors allocated from the operator pools in 'childPools_'.
+  ExprCompileCache exprCompileCache_;
+
+  // The split counts and times of 'taskStats_'. Updated without 'mutex_' and
+  // copied to the TaskStats returned by taskStats().
+  std::atomic<int32_t> numTotalSplits_{0};
+  std::atomic<int32_t> numFinishedSplits_{0};
+  std::atomic<int32_t> numRunningSplits_{0};
+  std::atomic<int32_t> numQueuedSplits_{0};
+  std::atomic<uint64_t> firstSplitStartTimeMs_{0};
+  std::atomic<uint64_t> lastSplitStartTimeMs_{0};
+
+  // The timelines of the Drivers with QueryConfig::kDriverTimelineEnabled.
+  // Outlive the Drivers. Not under 'mutex_', which is held when Drivers are
+  // created.
+  folly::Synchronized<std::vector<std::shared_ptr<DriverTimeline>>>
+      driverTimelines_;
+
   /// Stores inter-operator state (exchange, bridges) per split group.
   /// During ungrouped execution we use the [0] entry in this vector.
   std::unordered_map<uint32_t, SplitGroupState> splitGroupStates_;
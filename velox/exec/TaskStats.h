@@ -101,6 +101,12 @@ struct TaskStats {
   std::string longestRunningOpCall;
   /// The longest still running operator call's duration in ms.
   size_t longestRunningOpCallMs{0};
+
+  /// The number of CPU samples of each stack of the task's Drivers, taken by
+  /// process::SamplingProfiler. The stacks are 'plan node id operator type;
+  /// operator method;function...' in the folded format of flame graph tools.
+  /// Empty if the profiler has not run.
+  std::unordered_map<std::string, int64_t> cpuProfile;
 };
 
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 #pragma once
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 
@@ -66,6 +67,12 @@ struct SplitsState {
   /// Map split group id -> split store.
   std::unordered_map<uint32_t, SplitsStore> groupSplitsStores;
 
+  /// Protects 'groupSplitsStores'. Task::getSplitOrFuture() takes only this
+  /// and not the Task's mutex, so that the Drivers taking splits do not
+  /// contend with each other on the Task's mutex. When both are held, the
+  /// Task's mutex is taken first.
+  std::mutex mutex;
+
   /// We need these due to having promises in the structure.
   SplitsState() = default;
   SplitsState(SplitsState const&) = delete;
@@ -15,7 +15,9 @@
  */
 #include <folly/container/F14Map.h>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/TopN.h"
 #include "velox/vector/FlatVector.h"
 
@@ -38,7 +40,12 @@ TopN::TopN(
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
+      decodedVectors_(outputType_->children().size()),
+      firstKeyColumn_(
+          exprToChannel(topNNode->sortingKeys()[0].get(), outputType_)),
+      firstKeyOrder_(topNNode->sortingOrders()[0]),
+      filterOnThreshold_(
+          isThresholdFilterType(outputType_->childAt(firstKeyColumn_))) {
   const auto numColumns{outputType_->children().size()};
   const auto numSortingKeys{topNNode->sortingKeys().size()};
   sortingKeyColumns_.reserve(numSortingKeys);
@@ -57,16 +64,147 @@ TopN::TopN(
   }
 }
 
+vector_size_t TopN::filterCandidateRows(vector_size_t numRows) {
+  switch (outputType_->childAt(firstKeyColumn_)->kind()) {
+    case TypeKind::TINYINT:
+      return filterCandidateRows<int8_t>(numRows);
+    case TypeKind::SMALLINT:
+      return filterCandidateRows<int16_t>(numRows);
+    case TypeKind::INTEGER:
+      return filterCandidateRows<int32_t>(numRows);
+    case TypeKind::BIGINT:
+      return filterCandidateRows<int64_t>(numRows);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+template <typename T>
+vector_size_t TopN::filterCandidateRows(vector_size_t numRows) {
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(firstKeyColumn_);
+  const auto& decoded = decodedVectors_[firstKeyColumn_];
+  const bool nullsFirst = firstKeyOrder_.isNullsFirst();
+  candidateRows_.resize(numRows);
+  auto* candidates = candidateRows_.data();
+  vector_size_t numCandidates = 0;
+
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    // Only nulls sort before or with a null that sorts first. All rows sort
+    // before or with a null that sorts last.
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      candidates[numCandidates] = row;
+      numCandidates += !nullsFirst || decoded.isNullAt(row);
+    }
+    return numCandidates;
+  }
+
+  // The range of values of candidate rows. With a single key, rows equal to
+  // the top row do not enter. A threshold at the end of the range of T makes
+  // an empty range.
+  const T threshold = *reinterpret_cast<const T*>(topRow + column.offset());
+  const bool exclusive = sortingKeyColumns_.size() == 1;
+  T lower = std::numeric_limits<T>::min();
+  T upper = std::numeric_limits<T>::max();
+  if (firstKeyOrder_.isAscending()) {
+    if (!exclusive) {
+      upper = threshold;
+    } else if (threshold == std::numeric_limits<T>::min()) {
+      std::swap(lower, upper);
+    } else {
+      upper = threshold - 1;
+    }
+  } else {
+    if (!exclusive) {
+      lower = threshold;
+    } else if (threshold == std::numeric_limits<T>::max()) {
+      std::swap(lower, upper);
+    } else {
+      lower = threshold + 1;
+    }
+  }
+
+  if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+    using Batch = xsimd::batch<T>;
+    const auto* values = decoded.data<T>();
+    const auto lowerBatch = Batch::broadcast(lower);
+    const auto upperBatch = Batch::broadcast(upper);
+    vector_size_t row = 0;
+    for (; row + Batch::size <= numRows; row += Batch::size) {
+      const auto batch = Batch::load_unaligned(values + row);
+      const auto mask =
+          simd::toBitMask((batch >= lowerBatch) & (batch <= upperBatch));
+      auto bits = static_cast<std::make_unsigned_t<decltype(mask)>>(mask);
+      while (bits) {
+        candidates[numCandidates++] = row + __builtin_ctzll(bits);
+        bits &= bits - 1;
+      }
+    }
+    for (; row < numRows; ++row) {
+      candidates[numCandidates] = row;
+      numCandidates += values[row] >= lower && values[row] <= upper;
+    }
+    return numCandidates;
+  }
+
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    candidates[numCandidates] = row;
+    if (decoded.isNullAt(row)) {
+      numCandidates += nullsFirst;
+    } else {
+      const auto value = decoded.valueAt<T>(row);
+      numCandidates += value >= lower && value <= upper;
+    }
+  }
+  return numCandidates;
+}
+
+void TopN::maybePushdownThreshold() {
+  if (!pushdownThreshold_.has_value()) {
+    pushdownThreshold_ = filterOnThreshold_ &&
+        canPushdownThresholdFilter(
+            *operatorCtx_->driver(), this, firstKeyColumn_);
+  }
+  if (!pushdownThreshold_.value() || topRows_.size() < count_) {
+    return;
+  }
+  const auto threshold = thresholdAt(
+      topRows_.top(),
+      data_->columnAt(firstKeyColumn_),
+      outputType_->childAt(firstKeyColumn_)->kind());
+  if (pushedThreshold_.has_value() && pushedThreshold_.value() == threshold) {
+    return;
+  }
+  pushedThreshold_ = threshold;
+  // With a single key, rows equal to the top row do not enter.
+  auto filter = makeThresholdFilter(
+      threshold, firstKeyOrder_, sortingKeyColumns_.size() > 1);
+  if (filter != nullptr) {
+    dynamicFilters_[firstKeyColumn_] = std::move(filter);
+  }
+}
+
 void TopN::addInput(RowVectorPtr input) {
   for (const auto col : sortingKeyColumns_) {
     decodedVectors_[col].decode(*input->childAt(col));
   }
 
+  // Once 'topRows_' is full, only rows that sort before or with the top row on
+  // the first key can enter. Filter on the first key before comparing the
+  // rows on all keys.
+  const vector_size_t* candidates = nullptr;
+  vector_size_t numCandidates = input->size();
+  if (filterOnThreshold_ && topRows_.size() == count_) {
+    numCandidates = filterCandidateRows(input->size());
+    candidates = candidateRows_.data();
+  }
+
   const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
-  for (auto row = 0; row < input->size(); ++row) {
+  for (vector_size_t i = 0; i < numCandidates; ++i) {
+    const auto row = candidates != nullptr ? candidates[i] : i;
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -104,6 +242,7 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+  maybePushdownThreshold();
 }
 
 RowVectorPtr TopN::getOutput() {
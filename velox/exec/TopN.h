@@ -44,6 +44,19 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Sets 'candidateRows_' to the rows of the input whose first sorting key
+  // sorts before or, if there are more sorting keys, together with the first
+  // key of the top row. Other rows cannot enter 'topRows_'. Returns the number
+  // of candidate rows. Requires 'topRows_' to be full.
+  vector_size_t filterCandidateRows(vector_size_t numRows);
+
+  template <typename T>
+  vector_size_t filterCandidateRows(vector_size_t numRows);
+
+  // Offers the first key of the top row as a dynamic filter on the first
+  // sorting key to the upstream TableScan if it changed since the last call.
+  void maybePushdownThreshold();
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -68,5 +81,23 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Column and order of the first sorting key.
+  const column_index_t firstKeyColumn_;
+  const core::SortOrder firstKeyOrder_;
+
+  // True if input rows are filtered on the first key of the top row before
+  // they are compared on all keys.
+  const bool filterOnThreshold_;
+
+  // Input rows that passed filterCandidateRows().
+  std::vector<vector_size_t> candidateRows_;
+
+  // Set on the first call to maybePushdownThreshold().
+  std::optional<bool> pushdownThreshold_;
+
+  // The threshold last offered to the upstream TableScan. std::nullopt inside
+  // means the threshold was null.
+  std::optional<std::optional<int64_t>> pushedThreshold_;
 };
 } // namespace facebook::velox::exec
@@ -140,7 +140,8 @@ TopNRowNumber::TopNRowNumber(
           node->sortingKeys(),
           node->sortingOrders(),
           data_.get()),
-      decodedVectors_(inputType_->size()) {
+      decodedVectors_(inputType_->size()),
+      firstKeyOrder_(node->sortingOrders()[0]) {
   const auto& keys = node->partitionKeys();
   const auto numKeys = keys.size();
 
@@ -216,6 +217,36 @@ void TopNRowNumber::addInput(RowVectorPtr input) {
     for (auto i = 0; i < numInput; ++i) {
       processInputRow(i, *singlePartition_);
     }
+    maybePushdownThreshold();
+  }
+}
+
+void TopNRowNumber::maybePushdownThreshold() {
+  // The first sorting key follows the partition keys.
+  const auto keyIndex = numPartitionKeys_;
+  const auto keyChannel = inputChannels_[keyIndex];
+  if (!pushdownThreshold_.has_value()) {
+    pushdownThreshold_ =
+        isThresholdFilterType(inputType_->childAt(keyIndex)) &&
+        canPushdownThresholdFilter(*operatorCtx_->driver(), this, keyChannel);
+  }
+  auto& topRows = singlePartition_->rows;
+  if (!pushdownThreshold_.value() || topRows.size() < limit_) {
+    return;
+  }
+  const auto threshold = thresholdAt(
+      topRows.top(),
+      data_->columnAt(keyIndex),
+      inputType_->childAt(keyIndex)->kind());
+  if (pushedThreshold_.has_value() && pushedThreshold_.value() == threshold) {
+    return;
+  }
+  pushedThreshold_ = threshold;
+  // With a single key, rows equal to the top row do not enter.
+  auto filter = makeThresholdFilter(
+      threshold, firstKeyOrder_, spillCompareFlags_.size() > keyIndex + 1);
+  if (filter != nullptr) {
+    dynamicFilters_[keyChannel] = std::move(filter);
   }
 }
 
@@ -282,7 +313,8 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finalizeSpill();
     recordSpillStats(spiller_->stats());
 
-    merge_ = spiller_->startMerge();
+    merge_ = spiller_->startMerge(
+        spillConfig_->readAheadBuffers, spillConfig_->maxReadAheadBytes);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -395,6 +427,10 @@ RowVectorPtr TopNRowNumber::getOutput() {
     return nullptr;
   }
 
+  if (pendingOutput_ != nullptr) {
+    return std::move(pendingOutput_);
+  }
+
   RowVectorPtr output;
   if (merge_ != nullptr) {
     output = getOutputFromSpill();
@@ -640,13 +676,16 @@ void TopNRowNumber::reclaim(
   }
 
   if (noMoreInput_) {
-    ++stats.numNonReclaimableAttempts;
-    // TODO Add support for spilling after noMoreInput().
-    LOG(WARNING)
-        << "Can't reclaim from topNRowNumber operator which has started producing output: "
-        << pool()->name()
-        << ", usage: " << succinctBytes(pool()->currentBytes())
-        << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    if (merge_ != nullptr || abandonedPartial_) {
+      ++stats.numNonReclaimableAttempts;
+      LOG(WARNING)
+          << "Can't reclaim from topNRowNumber operator which is producing output from spilled or pass-through data: "
+          << pool()->name()
+          << ", usage: " << succinctBytes(pool()->currentBytes())
+          << ", reservation: " << succinctBytes(pool()->reservedBytes());
+      return;
+    }
+    spillRemainingOutput();
     return;
   }
 
@@ -657,6 +696,105 @@ void TopNRowNumber::reclaim(
   spill();
 }
 
+void TopNRowNumber::spillRemainingOutput() {
+  VELOX_CHECK_NULL(merge_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_NULL(pendingOutput_);
+
+  if (remainingRowsInPartition_ > 0) {
+    auto& partition = currentPartition();
+    const auto numRows = remainingRowsInPartition_;
+    const auto start = partition.rows.size() - numRows;
+    if (outputRows_.size() < numRows) {
+      outputRows_.resize(numRows);
+    }
+
+    pendingOutput_ =
+        BaseVector::create<RowVector>(outputType_, numRows, pool());
+    FlatVector<int64_t>* rowNumbers = nullptr;
+    if (generateRowNumber_) {
+      rowNumbers = pendingOutput_->children().back()->as<FlatVector<int64_t>>();
+    }
+    appendPartitionRows(partition, start, numRows, 0, rowNumbers);
+    for (int i = 0; i < inputChannels_.size(); ++i) {
+      data_->extractColumn(
+          outputRows_.data(),
+          numRows,
+          i,
+          pendingOutput_->childAt(inputChannels_[i]));
+    }
+    remainingRowsInPartition_ = 0;
+  }
+
+  // Collects the rows of the partitions that are not output yet.
+  folly::F14FastSet<char*> remainingRows;
+  auto addRemainingRows = [&](TopRows& partition) {
+    while (!partition.rows.empty()) {
+      remainingRows.insert(partition.rows.top());
+      partition.rows.pop();
+    }
+  };
+  if (table_ != nullptr) {
+    if (currentPartition_.has_value()) {
+      for (auto i = currentPartition_.value() + 1; i < numPartitions_; ++i) {
+        addRemainingRows(partitionAt(partitions_[i]));
+      }
+    }
+    while (auto numPartitions = table_->listAllRows(
+               &partitionIt_,
+               partitions_.size(),
+               RowContainer::kUnlimited,
+               partitions_.data())) {
+      for (auto i = 0; i < numPartitions; ++i) {
+        addRemainingRows(partitionAt(partitions_[i]));
+      }
+    }
+  } else if (!currentPartition_.has_value()) {
+    addRemainingRows(*singlePartition_);
+  }
+
+  // Erases the rows that are output already so that only the remaining rows
+  // are spilled.
+  std::vector<char*> outputRows;
+  RowContainerIterator iter;
+  std::vector<char*> rows(kPartitionBatchSize);
+  while (auto numRows = data_->listRows(&iter, rows.size(), rows.data())) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (!remainingRows.contains(rows[i])) {
+        outputRows.push_back(rows[i]);
+      }
+    }
+  }
+  data_->eraseRows(folly::Range(outputRows.data(), outputRows.size()));
+
+  const bool hasRemainingRows = data_->numRows() > 0;
+  if (hasRemainingRows) {
+    setupSpiller();
+    spiller_->spill();
+  }
+
+  if (table_ != nullptr) {
+    table_->clear();
+    partitionIt_.reset();
+    numPartitions_ = 0;
+    currentPartition_.reset();
+  } else {
+    // The single partition is output from 'merge_' if it has remaining rows.
+    currentPartition_ = 0;
+  }
+  data_->clear();
+  pool()->release();
+
+  if (hasRemainingRows) {
+    spiller_->finalizeSpill();
+    recordSpillStats(spiller_->stats());
+
+    merge_ = spiller_->startMerge(
+        spillConfig_->readAheadBuffers, spillConfig_->maxReadAheadBytes);
+    nextRowNumber_ = 0;
+  }
+}
+
 void TopNRowNumber::ensureInputFits(const RowVectorPtr& input) {
   if (!spillEnabled()) {
     // Spilling is disabled.
@@ -742,6 +880,8 @@ void TopNRowNumber::setupSpiller() {
       spillConfig_->writeBufferSize,
       spillConfig_->compressionKind,
       memory::spillMemoryPool(),
-      spillConfig_->executor);
+      spillConfig_->executor,
+      spillConfig_->fileFormat,
+      spillConfig_->adaptiveCompression);
 }
 } // namespace facebook::velox::exec
@@ -122,6 +122,12 @@ class TopNRowNumber : public Operator {
 
   void setupSpiller();
 
+  // Spills the rows that are not output yet after noMoreInput(). The output
+  // continues from the spilled data. The remaining rows of the partition that
+  // was partially added to the previous output batch are extracted into
+  // 'pendingOutput_' so that their row numbers continue.
+  void spillRemainingOutput();
+
   RowVectorPtr getOutputFromSpill();
 
   RowVectorPtr getOutputFromMemory();
@@ -146,6 +152,12 @@ class TopNRowNumber : public Operator {
   // Called in noMoreInput() and spill().
   void updateEstimatedOutputRowSize();
 
+  // Offers the first sorting key of the top row of 'singlePartition_' as a
+  // dynamic filter to the upstream TableScan if it changed since the last
+  // call. Rows of a partitioned input cannot be dropped on the sorting keys
+  // alone since a filter would also drop rows of partitions not seen yet.
+  void maybePushdownThreshold();
+
   // Return true if this operator runs a 'partial' stage and doesn't not reduce
   // cardinality sufficiently. Returns false if spilling was triggered earlier.
   bool abandonPartialEarly() const;
@@ -226,7 +238,21 @@ class TopNRowNumber : public Operator {
   // Used to sort-merge spilled data.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 
+  // Order of the first sorting key.
+  const core::SortOrder firstKeyOrder_;
+
+  // Set on the first call to maybePushdownThreshold().
+  std::optional<bool> pushdownThreshold_;
+
+  // The threshold last offered to the upstream TableScan. std::nullopt inside
+  // means the threshold was null.
+  std::optional<std::optional<int64_t>> pushedThreshold_;
+
   // Row number for the first row in the next output batch.
   int32_t nextRowNumber_{0};
+
+  // Output produced by spillRemainingOutput() to return before the output
+  // from 'merge_'.
+  RowVectorPtr pendingOutput_;
 };
 } // namespace facebook::velox::exec
@@ -151,6 +151,33 @@ class TreeOfLosers {
         : std::make_pair(streams_[lastIndex_].get(), result.second);
   }
 
+  /// Returns the stream with the lowest first element among the streams other
+  /// than the one last returned by next(), or nullptr if there is none. Until
+  /// that stream's first element is less than the first element of the stream
+  /// last returned by next(), next() would keep returning the same stream. The
+  /// caller may pop off these elements without calling next() in between.
+  /// Costs one comparison per level of the tree.
+  Stream* runnerUp() const {
+    if (values_.empty() || lastIndex_ == kEmpty) {
+      return nullptr;
+    }
+    // The runner-up lost only to the winner, so it is one of the losers on the
+    // winner's path to the root.
+    TIndex best = kEmpty;
+    TIndex node = parent(firstStream_ + lastIndex_);
+    for (;;) {
+      const auto value = values_[node];
+      if (value != kEmpty &&
+          (best == kEmpty || *streams_[value] < *streams_[best])) {
+        best = value;
+      }
+      if (node == 0) {
+        return best == kEmpty ? nullptr : streams_[best].get();
+      }
+      node = parent(node);
+    }
+  }
+
  private:
   static constexpr TIndex kEmpty = std::numeric_limits<TIndex>::max();
 
@@ -62,6 +62,83 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   using T = typename KindToFlatVector<Kind>::HashRowType;
   return folly::hasher<T>()(decoded.valueAt<T>(index));
 }
+
+// A flat key column for hashFlatKeys().
+template <typename T>
+struct FlatKey {
+  const T* values;
+  const uint64_t* nulls;
+};
+
+template <typename T>
+FOLLY_ALWAYS_INLINE uint64_t hashFlatKey(const FlatKey<T>& key, int32_t row) {
+  if (key.nulls && bits::isBitNull(key.nulls, row)) {
+    return VectorHasher::kNullHash;
+  }
+  return folly::hasher<T>()(key.values[row]);
+}
+
+// Hashes all 'keys' of each row in one pass, combined in the same way as
+// VectorHasher::hash() with 'mix'.
+template <typename T, typename... Rest>
+void hashFlatKeys(
+    const SelectivityVector& rows,
+    uint64_t* result,
+    const FlatKey<T>& first,
+    const FlatKey<Rest>&... rest) {
+  rows.applyToSelected([&](vector_size_t row) {
+    uint64_t hash = hashFlatKey(first, row);
+    ((hash = bits::hashMix(hash, hashFlatKey(rest, row))), ...);
+    result[row] = hash;
+  });
+}
+
+template <typename... T, size_t... I>
+void hashFlatKeys(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    uint64_t* result,
+    std::index_sequence<I...>) {
+  hashFlatKeys(
+      rows,
+      result,
+      FlatKey<T>{
+          hashers[I]->decodedVector().data<T>(),
+          hashers[I]->decodedVector().nulls()}...);
+}
+
+// Adds the type of the key after 'T' to the key types and hashes the keys
+// when all the types are known. Returns false if a key is not a flat INTEGER
+// or BIGINT or if there are more than 3 keys.
+template <typename... T>
+bool hashFlatKeys(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    uint64_t* result) {
+  constexpr auto kNumTyped = sizeof...(T);
+  if constexpr (kNumTyped > 0) {
+    if (kNumTyped == hashers.size()) {
+      hashFlatKeys<T...>(
+          hashers, rows, result, std::make_index_sequence<kNumTyped>());
+      return true;
+    }
+  }
+  if constexpr (kNumTyped < 3) {
+    auto& hasher = hashers[kNumTyped];
+    if (!hasher->decodedVector().isIdentityMapping()) {
+      return false;
+    }
+    switch (hasher->typeKind()) {
+      case TypeKind::INTEGER:
+        return hashFlatKeys<T..., int32_t>(hashers, rows, result);
+      case TypeKind::BIGINT:
+        return hashFlatKeys<T..., int64_t>(hashers, rows, result);
+      default:
+        return false;
+    }
+  }
+  return false;
+}
 } // namespace
 
 template <TypeKind Kind>
@@ -537,6 +614,19 @@ void VectorHasher::hash(
   }
 }
 
+// static
+void VectorHasher::hash(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const SelectivityVector& rows,
+    raw_vector<uint64_t>& result) {
+  if (!hashers.empty() && hashFlatKeys<>(hashers, rows, result.data())) {
+    return;
+  }
+  for (auto i = 0; i < hashers.size(); ++i) {
+    hashers[i]->hash(rows, i > 0, result);
+  }
+}
+
 void VectorHasher::hashPrecomputed(
     const SelectivityVector& rows,
     bool mix,
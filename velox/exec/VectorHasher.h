@@ -183,6 +183,16 @@ class VectorHasher {
   void
   hash(const SelectivityVector& rows, bool mix, raw_vector<uint64_t>& result);
 
+  // Computes the combined hash of the keys of 'hashers' for 'rows' into
+  // 'result', like calling hash() on each hasher with 'mix' set for all but
+  // the first. The keys must have been decoded via decode(). Hashes one to
+  // three flat INTEGER or BIGINT keys in a single pass over 'rows', with a
+  // loop specialized for the key types, instead of one pass per key.
+  static void hash(
+      const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+      const SelectivityVector& rows,
+      raw_vector<uint64_t>& result);
+
   // Computes a hash for 'rows' using precomputedHash_ (just like from a const
   // vector) and stores it in 'result'.
   // If 'mix' is true, mixes the hash with existing value in 'result'.
@@ -241,6 +251,11 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if there were too many distinct values to keep track of.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
@@ -35,25 +35,36 @@ Window::Window(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
-      windowNode_(windowNode),
-      currentPartition_(nullptr),
-      stringAllocator_(pool()) {
+      windowNode_(windowNode) {
   auto* spillConfig =
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
+  int32_t numEvaluators = 1;
   if (windowNode->inputsSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
+    numEvaluators =
+        std::max<int32_t>(1, driverCtx->queryConfig().windowParallelism());
+  }
+  for (auto i = 0; i < numEvaluators; ++i) {
+    evaluators_.push_back(std::make_unique<Evaluator>(pool()));
   }
 }
 
 void Window::initialize() {
   Operator::initialize();
   VELOX_CHECK_NOT_NULL(windowNode_);
-  createWindowFunctions();
-  createPeerAndFrameBuffers();
+  // TODO: This computation needs to be revised. It only takes into account
+  // the input columns size. We need to also account for the output columns.
+  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
+  for (auto& evaluator : evaluators_) {
+    createWindowFunctions(*evaluator);
+    createPeerAndFrameBuffers(*evaluator);
+  }
+  maybeEnableSpilledPartitions();
+  maybeEnableIncompletePartitions();
   windowNode_.reset();
 }
 
@@ -108,10 +119,10 @@ Window::WindowFrame Window::createWindowFrame(
        createFrameChannelArg(frame.endValue)});
 }
 
-void Window::createWindowFunctions() {
+void Window::createWindowFunctions(Evaluator& evaluator) {
   VELOX_CHECK_NOT_NULL(windowNode_);
-  VELOX_CHECK(windowFunctions_.empty());
-  VELOX_CHECK(windowFrames_.empty());
+  VELOX_CHECK(evaluator.windowFunctions.empty());
+  VELOX_CHECK(evaluator.windowFrames.empty());
 
   const auto& inputType = windowNode_->sources()[0]->outputType();
   for (const auto& windowNodeFunction : windowNode_->windowFunctions()) {
@@ -129,20 +140,133 @@ void Window::createWindowFunctions() {
       }
     }
 
-    windowFunctions_.push_back(WindowFunction::create(
+    evaluator.windowFunctions.push_back(WindowFunction::create(
         windowNodeFunction.functionCall->name(),
         functionArgs,
         windowNodeFunction.functionCall->type(),
         windowNodeFunction.ignoreNulls,
         operatorCtx_->pool(),
-        &stringAllocator_,
+        &evaluator.stringAllocator,
         operatorCtx_->driverCtx()->queryConfig()));
 
-    windowFrames_.push_back(
+    evaluator.windowFrames.push_back(
         createWindowFrame(windowNodeFunction.frame, inputType));
   }
 }
 
+void Window::maybeEnableSpilledPartitions() {
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+
+  // Returns true if the frame bound is bounded relative to the current row.
+  auto isBoundedFrameBound =
+      [](core::WindowNode::BoundType boundType,
+         const std::optional<FrameChannelArg>& frameArg) {
+        switch (boundType) {
+          case core::WindowNode::BoundType::kUnboundedPreceding:
+          case core::WindowNode::BoundType::kUnboundedFollowing:
+            return false;
+          case core::WindowNode::BoundType::kPreceding:
+          case core::WindowNode::BoundType::kFollowing:
+            return frameArg->index == kConstantChannel;
+          default:
+            return true;
+        }
+      };
+
+  const auto& windowFunctions = evaluators_[0]->windowFunctions;
+  const auto& windowFrames = evaluators_[0]->windowFrames;
+  int64_t maxPrecedingRows = 0;
+  for (auto i = 0; i < windowFunctions.size(); ++i) {
+    switch (windowFunctions[i]->partitionAccess()) {
+      case WindowFunction::PartitionAccess::kRandom:
+        return;
+      case WindowFunction::PartitionAccess::kForward:
+        break;
+      case WindowFunction::PartitionAccess::kFrameRows: {
+        const auto& frame = windowFrames[i];
+        if (!isBoundedFrameBound(frame.startType, frame.start) ||
+            !isBoundedFrameBound(frame.endType, frame.end)) {
+          return;
+        }
+        if (frame.startType == core::WindowNode::BoundType::kPreceding) {
+          maxPrecedingRows =
+              std::max(maxPrecedingRows, frame.start->constant.value());
+        }
+        break;
+      }
+    }
+  }
+
+  maxPrecedingRows_ = std::min<int64_t>(
+      maxPrecedingRows, std::numeric_limits<vector_size_t>::max());
+  windowBuild_->enableSpilledPartitions();
+}
+
+void Window::maybeEnableIncompletePartitions() {
+  if (!windowNode_->inputsSorted()) {
+    return;
+  }
+
+  constexpr int64_t kUnbounded = std::numeric_limits<vector_size_t>::max();
+  const auto& windowFunctions = evaluators_[0]->windowFunctions;
+  const auto& windowFrames = evaluators_[0]->windowFrames;
+  int64_t maxPrecedingRows = 0;
+  int64_t maxFollowingRows = 0;
+  for (auto i = 0; i < windowFunctions.size(); ++i) {
+    const auto rowOffsets = windowFunctions[i]->streamingRowOffsets();
+    if (!rowOffsets.has_value()) {
+      return;
+    }
+    maxPrecedingRows =
+        std::max<int64_t>(maxPrecedingRows, rowOffsets->preceding);
+    maxFollowingRows =
+        std::max<int64_t>(maxFollowingRows, rowOffsets->following);
+    if (windowFunctions[i]->partitionAccess() !=
+        WindowFunction::PartitionAccess::kFrameRows) {
+      continue;
+    }
+
+    // The rows of a frame ending at the current row or before are ready once
+    // the peer group of the current row is complete.
+    const auto& frame = windowFrames[i];
+    switch (frame.endType) {
+      case core::WindowNode::BoundType::kUnboundedFollowing:
+        return;
+      case core::WindowNode::BoundType::kFollowing:
+        if (frame.end->index != kConstantChannel) {
+          return;
+        }
+        maxFollowingRows =
+            std::max(maxFollowingRows, frame.end->constant.value());
+        break;
+      default:
+        break;
+    }
+    switch (frame.startType) {
+      case core::WindowNode::BoundType::kUnboundedPreceding:
+        maxPrecedingRows = kUnbounded;
+        break;
+      case core::WindowNode::BoundType::kPreceding:
+        maxPrecedingRows = std::max(
+            maxPrecedingRows,
+            frame.start->index == kConstantChannel
+                ? frame.start->constant.value()
+                : kUnbounded);
+        break;
+      default:
+        break;
+    }
+  }
+
+  maxFollowingRows_ = std::min(maxFollowingRows, kUnbounded);
+  if (maxPrecedingRows < kUnbounded) {
+    maxPrecedingRows_ = maxPrecedingRows;
+  }
+  windowBuild_->enableIncompletePartitions();
+}
+
 void Window::addInput(RowVectorPtr input) {
   windowBuild_->addInput(input);
   numRows_ += input->size();
@@ -168,29 +292,25 @@ void Window::reclaim(
   windowBuild_->spill();
 }
 
-void Window::createPeerAndFrameBuffers() {
-  // TODO: This computation needs to be revised. It only takes into account
-  // the input columns size. We need to also account for the output columns.
-  numRowsPerOutput_ = outputBatchRows(windowBuild_->estimateRowSize());
-
-  peerStartBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+void Window::createPeerAndFrameBuffers(Evaluator& evaluator) {
+  evaluator.peerStartBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
-  peerEndBuffer_ = AlignedBuffer::allocate<vector_size_t>(
+  evaluator.peerEndBuffer = AlignedBuffer::allocate<vector_size_t>(
       numRowsPerOutput_, operatorCtx_->pool());
 
-  auto numFuncs = windowFunctions_.size();
-  frameStartBuffers_.reserve(numFuncs);
-  frameEndBuffers_.reserve(numFuncs);
-  validFrames_.reserve(numFuncs);
+  auto numFuncs = evaluator.windowFunctions.size();
+  evaluator.frameStartBuffers.reserve(numFuncs);
+  evaluator.frameEndBuffers.reserve(numFuncs);
+  evaluator.validFrames.reserve(numFuncs);
 
   for (auto i = 0; i < numFuncs; i++) {
     BufferPtr frameStartBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
     BufferPtr frameEndBuffer = AlignedBuffer::allocate<vector_size_t>(
         numRowsPerOutput_, operatorCtx_->pool());
-    frameStartBuffers_.push_back(frameStartBuffer);
-    frameEndBuffers_.push_back(frameEndBuffer);
-    validFrames_.push_back(SelectivityVector(numRowsPerOutput_));
+    evaluator.frameStartBuffers.push_back(frameStartBuffer);
+    evaluator.frameEndBuffers.push_back(frameEndBuffer);
+    evaluator.validFrames.push_back(SelectivityVector(numRowsPerOutput_));
   }
 }
 
@@ -203,15 +323,27 @@ void Window::noMoreInput() {
   }
 }
 
-void Window::callResetPartition() {
-  partitionOffset_ = 0;
-  peerStartRow_ = 0;
-  peerEndRow_ = 0;
-  currentPartition_ = nullptr;
-  if (windowBuild_->hasNextPartition()) {
-    currentPartition_ = windowBuild_->nextPartition();
-    for (int i = 0; i < windowFunctions_.size(); i++) {
-      windowFunctions_[i]->resetPartition(currentPartition_.get());
+void Window::callResetPartition(Evaluator& evaluator) {
+  evaluator.partitionOffset = 0;
+  evaluator.peerStartRow = 0;
+  evaluator.peerEndRow = 0;
+  evaluator.currentPartition = nullptr;
+  if (parallel_) {
+    // The partitions evaluated on the executor are handed out by
+    // startPartitionGroup().
+    if (!evaluator.partitions.empty()) {
+      evaluator.currentPartition = std::move(evaluator.partitions.front());
+      evaluator.partitions.pop_front();
+    }
+  } else if (windowBuild_->hasNextPartition()) {
+    evaluator.currentPartition = windowBuild_->nextPartition();
+  } else if (auto spillStats = windowBuild_->takePartitionSpillStats()) {
+    recordSpillStats(spillStats.value());
+  }
+
+  if (evaluator.currentPartition) {
+    for (auto& windowFunction : evaluator.windowFunctions) {
+      windowFunction->resetPartition(evaluator.currentPartition.get());
     }
   }
 }
@@ -248,6 +380,7 @@ void updateKRowsOffsetsColumn(
 }; // namespace
 
 void Window::updateKRowsFrameBounds(
+    Evaluator& evaluator,
     bool isKPreceding,
     const FrameChannelArg& frameArg,
     vector_size_t startRow,
@@ -259,8 +392,8 @@ void Window::updateKRowsFrameBounds(
         startRow + (isKPreceding ? -constantOffset : constantOffset);
     std::iota(rawFrameBounds, rawFrameBounds + numRows, startValue);
   } else {
-    currentPartition_->extractColumn(
-        frameArg.index, partitionOffset_, numRows, 0, frameArg.value);
+    evaluator.currentPartition->extractColumn(
+        frameArg.index, evaluator.partitionOffset, numRows, 0, frameArg.value);
     if (frameArg.value->typeKind() == TypeKind::INTEGER) {
       updateKRowsOffsetsColumn<int32_t>(
           isKPreceding, frameArg.value, startRow, numRows, rawFrameBounds);
@@ -272,6 +405,7 @@ void Window::updateKRowsFrameBounds(
 }
 
 void Window::updateFrameBounds(
+    Evaluator& evaluator,
     const WindowFrame& windowFrame,
     const bool isStartBound,
     const vector_size_t startRow,
@@ -288,7 +422,8 @@ void Window::updateFrameBounds(
       std::fill_n(rawFrameBounds, numRows, 0);
       break;
     case core::WindowNode::BoundType::kUnboundedFollowing:
-      std::fill_n(rawFrameBounds, numRows, currentPartition_->numRows() - 1);
+      std::fill_n(
+          rawFrameBounds, numRows, evaluator.currentPartition->numRows() - 1);
       break;
     case core::WindowNode::BoundType::kCurrentRow: {
       if (windowType == core::WindowNode::WindowType::kRange) {
@@ -306,7 +441,12 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kPreceding: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            true, frameArg.value(), startRow, numRows, rawFrameBounds);
+            evaluator,
+            true,
+            frameArg.value(),
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
         VELOX_NYI("k preceding frame is only supported in ROWS mode");
       }
@@ -315,7 +455,12 @@ void Window::updateFrameBounds(
     case core::WindowNode::BoundType::kFollowing: {
       if (windowType == core::WindowNode::WindowType::kRows) {
         updateKRowsFrameBounds(
-            false, frameArg.value(), startRow, numRows, rawFrameBounds);
+            evaluator,
+            false,
+            frameArg.value(),
+            startRow,
+            numRows,
+            rawFrameBounds);
       } else {
         VELOX_NYI("k following frame is only supported in ROWS mode");
       }
@@ -362,41 +507,50 @@ void computeValidFrames(
 }; // namespace
 
 void Window::computePeerAndFrameBuffers(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow) {
   vector_size_t numRows = endRow - startRow;
-  vector_size_t numFuncs = windowFunctions_.size();
+  vector_size_t numFuncs = evaluator.windowFunctions.size();
 
   // Size buffers for the call to WindowFunction::apply.
   auto bufferSize = numRows * sizeof(vector_size_t);
-  peerStartBuffer_->setSize(bufferSize);
-  peerEndBuffer_->setSize(bufferSize);
-  auto rawPeerStarts = peerStartBuffer_->asMutable<vector_size_t>();
-  auto rawPeerEnds = peerEndBuffer_->asMutable<vector_size_t>();
+  evaluator.peerStartBuffer->setSize(bufferSize);
+  evaluator.peerEndBuffer->setSize(bufferSize);
+  auto rawPeerStarts = evaluator.peerStartBuffer->asMutable<vector_size_t>();
+  auto rawPeerEnds = evaluator.peerEndBuffer->asMutable<vector_size_t>();
 
   std::vector<vector_size_t*> rawFrameStarts;
   std::vector<vector_size_t*> rawFrameEnds;
   rawFrameStarts.reserve(numFuncs);
   rawFrameEnds.reserve(numFuncs);
   for (auto w = 0; w < numFuncs; w++) {
-    frameStartBuffers_[w]->setSize(bufferSize);
-    frameEndBuffers_[w]->setSize(bufferSize);
+    evaluator.frameStartBuffers[w]->setSize(bufferSize);
+    evaluator.frameEndBuffers[w]->setSize(bufferSize);
 
-    auto rawFrameStart = frameStartBuffers_[w]->asMutable<vector_size_t>();
-    auto rawFrameEnd = frameEndBuffers_[w]->asMutable<vector_size_t>();
+    auto rawFrameStart =
+        evaluator.frameStartBuffers[w]->asMutable<vector_size_t>();
+    auto rawFrameEnd = evaluator.frameEndBuffers[w]->asMutable<vector_size_t>();
     rawFrameStarts.push_back(rawFrameStart);
     rawFrameEnds.push_back(rawFrameEnd);
   }
 
-  std::tie(peerStartRow_, peerEndRow_) = currentPartition_->computePeerBuffers(
-      startRow, endRow, peerStartRow_, peerEndRow_, rawPeerStarts, rawPeerEnds);
+  std::tie(evaluator.peerStartRow, evaluator.peerEndRow) =
+      evaluator.currentPartition->computePeerBuffers(
+          startRow,
+          endRow,
+          evaluator.peerStartRow,
+          evaluator.peerEndRow,
+          rawPeerStarts,
+          rawPeerEnds);
 
   for (auto i = 0; i < numFuncs; i++) {
-    const auto& windowFrame = windowFrames_[i];
+    const auto& windowFrame = evaluator.windowFrames[i];
     // Default all rows to have validFrames. The invalidity of frames is only
     // computed for k rows/range frames at a later point.
-    validFrames_[i].resizeFill(numRows, true);
+    evaluator.validFrames[i].resizeFill(numRows, true);
     updateFrameBounds(
+        evaluator,
         windowFrame,
         true,
         startRow,
@@ -405,6 +559,7 @@ void Window::computePeerAndFrameBuffers(
         rawPeerEnds,
         rawFrameStarts[i]);
     updateFrameBounds(
+        evaluator,
         windowFrame,
         false,
         startRow,
@@ -412,7 +567,7 @@ void Window::computePeerAndFrameBuffers(
         rawPeerStarts,
         rawPeerEnds,
         rawFrameEnds[i]);
-    if (windowFrames_[i].start || windowFrames_[i].end) {
+    if (windowFrame.start || windowFrame.end) {
       // k preceding and k following bounds can be problematic. They can
       // go over the partition limits or result in empty frames. Fix the
       // frame boundaries and compute the validFrames SelectivityVector
@@ -420,53 +575,81 @@ void Window::computePeerAndFrameBuffers(
       // Ranking functions do not care about frames. So the function decides
       // further what to do with empty frames.
       computeValidFrames(
-          currentPartition_->numRows() - 1,
+          evaluator.currentPartition->numRows() - 1,
           numRows,
           rawFrameStarts[i],
           rawFrameEnds[i],
-          validFrames_[i]);
+          evaluator.validFrames[i]);
     }
   }
 }
 
 void Window::getInputColumns(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
   auto numRows = endRow - startRow;
   for (int i = 0; i < numInputColumns_; ++i) {
-    currentPartition_->extractColumn(
-        i, partitionOffset_, numRows, resultOffset, result->childAt(i));
+    evaluator.currentPartition->extractColumn(
+        i,
+        evaluator.partitionOffset,
+        numRows,
+        resultOffset,
+        result->childAt(i));
   }
 }
 
 void Window::callApplyForPartitionRows(
+    Evaluator& evaluator,
     vector_size_t startRow,
     vector_size_t endRow,
     vector_size_t resultOffset,
     const RowVectorPtr& result) {
-  getInputColumns(startRow, endRow, resultOffset, result);
+  getInputColumns(evaluator, startRow, endRow, resultOffset, result);
 
-  computePeerAndFrameBuffers(startRow, endRow);
-  vector_size_t numFuncs = windowFunctions_.size();
+  computePeerAndFrameBuffers(evaluator, startRow, endRow);
+  vector_size_t numFuncs = evaluator.windowFunctions.size();
   for (auto w = 0; w < numFuncs; w++) {
-    windowFunctions_[w]->apply(
-        peerStartBuffer_,
-        peerEndBuffer_,
-        frameStartBuffers_[w],
-        frameEndBuffers_[w],
-        validFrames_[w],
+    evaluator.windowFunctions[w]->apply(
+        evaluator.peerStartBuffer,
+        evaluator.peerEndBuffer,
+        evaluator.frameStartBuffers[w],
+        evaluator.frameEndBuffers[w],
+        evaluator.validFrames[w],
         resultOffset,
         result->childAt(numInputColumns_ + w));
   }
 
   vector_size_t numRows = endRow - startRow;
-  numProcessedRows_ += numRows;
-  partitionOffset_ += numRows;
+  evaluator.partitionOffset += numRows;
+
+  if (maxPrecedingRows_.has_value()) {
+    // The next batch accesses the rows from its peer group start and the
+    // preceding rows of its frames.
+    evaluator.currentPartition->removeRowsBefore(std::min<int64_t>(
+        evaluator.peerStartRow,
+        static_cast<int64_t>(evaluator.partitionOffset) -
+            maxPrecedingRows_.value()));
+  }
+}
+
+vector_size_t Window::numReadyRows(const WindowPartition& partition) const {
+  if (partition.complete()) {
+    return partition.numRows();
+  }
+  // A row is ready once the rows of its peer group and the following rows
+  // accessed by the functions are added.
+  return std::max<int64_t>(
+      0,
+      std::min<int64_t>(
+          partition.lastPeerGroupStart(),
+          static_cast<int64_t>(partition.numRows()) - maxFollowingRows_));
 }
 
 vector_size_t Window::callApplyLoop(
+    Evaluator& evaluator,
     vector_size_t numOutputRows,
     const RowVectorPtr& result) {
   // Compute outputs by traversing as many partitions as possible. This
@@ -474,23 +657,34 @@ vector_size_t Window::callApplyLoop(
   vector_size_t resultIndex = 0;
   vector_size_t numOutputRowsLeft = numOutputRows;
 
-  // This function requires that the currentPartition_ is available for output.
-  VELOX_DCHECK_NOT_NULL(currentPartition_);
+  // This function requires that the current partition is available for
+  // output.
+  VELOX_DCHECK_NOT_NULL(evaluator.currentPartition);
   while (numOutputRowsLeft > 0) {
+    const auto partitionOffset = evaluator.partitionOffset;
+    const bool partitionComplete = evaluator.currentPartition->complete();
     auto rowsForCurrentPartition =
-        currentPartition_->numRows() - partitionOffset_;
+        numReadyRows(*evaluator.currentPartition) - partitionOffset;
     if (rowsForCurrentPartition <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
-      callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + rowsForCurrentPartition,
-          resultIndex,
-          result);
-      resultIndex += rowsForCurrentPartition;
-      numOutputRowsLeft -= rowsForCurrentPartition;
-      callResetPartition();
-      if (!currentPartition_) {
+      if (rowsForCurrentPartition > 0) {
+        callApplyForPartitionRows(
+            evaluator,
+            partitionOffset,
+            partitionOffset + rowsForCurrentPartition,
+            resultIndex,
+            result);
+        resultIndex += rowsForCurrentPartition;
+        numOutputRowsLeft -= rowsForCurrentPartition;
+      }
+      if (!partitionComplete) {
+        // The other rows of the partition are output once more input rows
+        // are added to it.
+        break;
+      }
+      callResetPartition(evaluator);
+      if (!evaluator.currentPartition) {
         // The WindowBuild doesn't have any more partitions to process right
         // now. So break until the next getOutput call.
         break;
@@ -500,8 +694,9 @@ vector_size_t Window::callApplyLoop(
       // Call apply for the rows that can fit in the buffer and break from
       // outputting.
       callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + numOutputRowsLeft,
+          evaluator,
+          partitionOffset,
+          partitionOffset + numOutputRowsLeft,
           resultIndex,
           result);
       numOutputRowsLeft = 0;
@@ -523,9 +718,15 @@ RowVectorPtr Window::getOutput() {
     return nullptr;
   }
 
-  if (!currentPartition_) {
-    callResetPartition();
-    if (!currentPartition_) {
+  if (evaluators_.size() > 1 && noMoreInput_ &&
+      windowBuild_->concurrentPartitions()) {
+    return getParallelOutput();
+  }
+
+  auto& evaluator = *evaluators_[0];
+  if (!evaluator.currentPartition) {
+    callResetPartition(evaluator);
+    if (!evaluator.currentPartition) {
       // WindowBuild doesn't have a partition to output.
       return nullptr;
     }
@@ -536,10 +737,114 @@ RowVectorPtr Window::getOutput() {
       outputType_, numOutputRows, operatorCtx_->pool());
 
   // Compute the output values of window functions.
-  auto numResultRows = callApplyLoop(numOutputRows, result);
+  auto numResultRows = callApplyLoop(evaluator, numOutputRows, result);
+  if (numResultRows == 0) {
+    // The rows of the current partition wait for more input.
+    return nullptr;
+  }
+  numProcessedRows_ += numResultRows;
   return numResultRows < numOutputRows
       ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
       : result;
 }
 
+bool Window::startPartitionGroup(int32_t evaluatorIndex) {
+  auto* evaluator = evaluators_[evaluatorIndex].get();
+  VELOX_CHECK(evaluator->partitions.empty());
+  VELOX_CHECK_NULL(evaluator->currentPartition);
+
+  // Groups consecutive partitions into at least one output batch.
+  vector_size_t numGroupRows = 0;
+  while (numGroupRows < numRowsPerOutput_ &&
+         windowBuild_->hasNextPartition()) {
+    auto partition = windowBuild_->nextPartition();
+    numGroupRows += partition->numRows();
+    evaluator->partitions.push_back(std::move(partition));
+  }
+  if (numGroupRows == 0) {
+    return false;
+  }
+
+  auto output = std::make_shared<AsyncSource<std::vector<RowVectorPtr>>>(
+      [this, evaluator, numGroupRows]() {
+        return std::make_unique<std::vector<RowVectorPtr>>(
+            evaluatePartitionGroup(*evaluator, numGroupRows));
+      });
+  PartitionGroup group;
+  group.evaluatorIndex = evaluatorIndex;
+  group.output = output;
+  partitionGroups_.push_back(std::move(group));
+  if (auto* executor = operatorCtx_->task()->queryCtx()->executor()) {
+    executor->add([output]() { output->prepare(); });
+  }
+  return true;
+}
+
+std::vector<RowVectorPtr> Window::evaluatePartitionGroup(
+    Evaluator& evaluator,
+    vector_size_t numRows) {
+  std::vector<RowVectorPtr> batches;
+  if (cancelled_) {
+    return batches;
+  }
+  callResetPartition(evaluator);
+  while (numRows > 0) {
+    const auto numOutputRows = std::min(numRowsPerOutput_, numRows);
+    auto result =
+        BaseVector::create<RowVector>(outputType_, numOutputRows, pool());
+    VELOX_CHECK_EQ(
+        callApplyLoop(evaluator, numOutputRows, result), numOutputRows);
+    batches.push_back(std::move(result));
+    numRows -= numOutputRows;
+  }
+  VELOX_CHECK_NULL(evaluator.currentPartition);
+  return batches;
+}
+
+RowVectorPtr Window::getParallelOutput() {
+  parallel_ = true;
+  if (partitionGroups_.empty()) {
+    for (auto i = 0; i < evaluators_.size(); ++i) {
+      if (!startPartitionGroup(i)) {
+        break;
+      }
+    }
+    if (partitionGroups_.empty()) {
+      return nullptr;
+    }
+  }
+
+  // Returns the batches of the groups in the order of their partitions.
+  auto& group = partitionGroups_.front();
+  if (!group.batches) {
+    group.batches = group.output->move();
+    VELOX_CHECK_NOT_NULL(group.batches);
+  }
+  auto result = std::move((*group.batches)[group.nextBatch++]);
+  if (group.nextBatch == group.batches->size()) {
+    const auto evaluatorIndex = group.evaluatorIndex;
+    partitionGroups_.pop_front();
+    startPartitionGroup(evaluatorIndex);
+  }
+  numProcessedRows_ += result->size();
+  return result;
+}
+
+void Window::close() {
+  // Waits for the groups in progress on the executor. The groups that did not
+  // start return no batches.
+  cancelled_ = true;
+  for (auto& group : partitionGroups_) {
+    if (!group.batches) {
+      try {
+        group.output->move();
+      } catch (const std::exception&) {
+        // The error was reported by getOutput() or does not matter.
+      }
+    }
+  }
+  partitionGroups_.clear();
+  Operator::close();
+}
+
 } // namespace facebook::velox::exec
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/WindowBuild.h"
@@ -35,6 +38,16 @@ namespace facebook::velox::exec {
 ///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
+///
+/// With QueryConfig::kWindowParallelism > 1 and sorted input that was not
+/// spilled, groups of consecutive partitions are evaluated concurrently on the
+/// query executor. The output keeps the order of the partitions.
+///
+/// With sorted input, the rows of a partition are evaluated as soon as their
+/// peer group and the following rows accessed by the window functions arrive
+/// if no function depends on the size of the partition. Only the rows around
+/// the current row are then kept in memory if the functions access a bounded
+/// number of preceding rows.
 class Window : public Operator {
  public:
   Window(
@@ -67,6 +80,8 @@ class Window : public Operator {
   void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
       override;
 
+  void close() override;
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -88,19 +103,111 @@ class Window : public Operator {
     const std::optional<FrameChannelArg> end;
   };
 
-  // Creates WindowFunction and frame objects for this operator.
-  void createWindowFunctions();
+  // The state for evaluating the window functions over a sequence of
+  // partitions. There is one Evaluator per concurrently evaluated partition.
+  struct Evaluator {
+    explicit Evaluator(memory::MemoryPool* pool) : stringAllocator(pool) {}
+
+    // HashStringAllocator required by functions that allocate out of line
+    // buffers.
+    HashStringAllocator stringAllocator;
+
+    // Vector of WindowFunction objects required by this operator.
+    // WindowFunction is the base API implemented by all the window functions.
+    // The functions are ordered by their positions in the output columns.
+    std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions;
+
+    // Vector of WindowFrames corresponding to each windowFunction above.
+    // It represents the frame spec for the function computation.
+    std::vector<WindowFrame> windowFrames;
+
+    // The following 4 Buffers are used to pass peer and frame start and
+    // end values to the WindowFunction::apply method. These
+    // buffers can be allocated once and reused across all the getOutput
+    // calls.
+    // Only a single peer start and peer end buffer is needed across all
+    // functions (as the peer values are based on the ORDER BY clause).
+    BufferPtr peerStartBuffer;
+    BufferPtr peerEndBuffer;
+    // A separate BufferPtr is required for the frame indexes of each
+    // function. Each function has its own frame clause and style. So we
+    // have as many buffers as the number of functions.
+    std::vector<BufferPtr> frameStartBuffers;
+    std::vector<BufferPtr> frameEndBuffers;
+
+    // Frame types for kPreceding or kFollowing could result in empty
+    // frames if the frameStart > frameEnds, or frameEnds < firstPartitionRow
+    // or frameStarts > lastPartitionRow. Such frames usually evaluate to NULL
+    // in the window function.
+    // This SelectivityVector captures the valid (non-empty) frames in the
+    // buffer being worked on. The window function can use this to compute
+    // output values.
+    // There is one SelectivityVector per window function.
+    std::vector<SelectivityVector> validFrames;
+
+    // Used to access window partition rows and columns by the window
+    // operator and functions. This structure is owned by the WindowBuild.
+    std::unique_ptr<WindowPartition> currentPartition;
+
+    // The partitions to evaluate after 'currentPartition' when partitions
+    // are evaluated concurrently. Otherwise, the partitions come from the
+    // WindowBuild.
+    std::deque<std::unique_ptr<WindowPartition>> partitions;
+
+    // Tracks how far along the partition rows have been output.
+    vector_size_t partitionOffset = 0;
+
+    // When traversing input partition rows, the peers are the rows
+    // with the same values for the ORDER BY clause. These rows
+    // are equal in some ways and affect the results of ranking functions.
+    // Since all rows between the peerStartRow and peerEndRow have the same
+    // values for peerStartRow and peerEndRow, we needn't compute
+    // them for each row independently. Since these rows might
+    // cross getOutput boundaries and be called in subsequent calls to
+    // computePeerBuffers they are saved here.
+    vector_size_t peerStartRow = 0;
+    vector_size_t peerEndRow = 0;
+  };
+
+  // Consecutive partitions evaluated into output batches on the executor.
+  struct PartitionGroup {
+    // Index of the Evaluator in 'evaluators_' the group is evaluated with.
+    int32_t evaluatorIndex;
+    std::shared_ptr<AsyncSource<std::vector<RowVectorPtr>>> output;
+    // The batches of 'output' once ready and the next one to return.
+    std::unique_ptr<std::vector<RowVectorPtr>> batches;
+    size_t nextBatch{0};
+  };
+
+  // Creates WindowFunction and frame objects for 'evaluator'.
+  void createWindowFunctions(Evaluator& evaluator);
+
+  // Enables partitions paged in from spill files if spilling is enabled and
+  // every function accesses a bounded range of rows around the current row.
+  void maybeEnableSpilledPartitions();
+
+  // Enables partitions that are evaluated while their rows arrive if the input
+  // is sorted and no function depends on the size of the partition or
+  // accesses an unbounded number of following rows.
+  void maybeEnableIncompletePartitions();
+
+  // Returns the number of leading rows of 'partition' the window functions
+  // can be evaluated for with the rows added so far.
+  vector_size_t numReadyRows(const WindowPartition& partition) const;
 
   // Creates the buffers for peer and frame row
   // indices to send in window function apply invocations.
-  void createPeerAndFrameBuffers();
+  void createPeerAndFrameBuffers(Evaluator& evaluator);
 
   // Compute the peer and frame buffers for rows between
   // startRow and endRow in the current partition.
-  void computePeerAndFrameBuffers(vector_size_t startRow, vector_size_t endRow);
+  void computePeerAndFrameBuffers(
+      Evaluator& evaluator,
+      vector_size_t startRow,
+      vector_size_t endRow);
 
   // Updates all the state for the next partition.
-  void callResetPartition();
+  void callResetPartition(Evaluator& evaluator);
 
   // Computes the result vector for a subset of the current
   // partition rows starting from startRow to endRow. A single partition
@@ -109,6 +216,7 @@ class Window : public Operator {
   // offset in the result vector corresponding to the current range of
   // partition rows.
   void callApplyForPartitionRows(
+      Evaluator& evaluator,
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
@@ -117,6 +225,7 @@ class Window : public Operator {
   // Gets the input columns of the current window partition
   // between startRow and endRow in result at resultOffset.
   void getInputColumns(
+      Evaluator& evaluator,
       vector_size_t startRow,
       vector_size_t endRow,
       vector_size_t resultOffset,
@@ -127,9 +236,24 @@ class Window : public Operator {
   // window function.
   // @return The number of rows processed in the loop.
   vector_size_t callApplyLoop(
+      Evaluator& evaluator,
       vector_size_t numOutputRows,
       const RowVectorPtr& result);
 
+  // Takes the next partitions from the WindowBuild and starts evaluating
+  // them with the Evaluator at 'evaluatorIndex' on the executor. Returns
+  // false if there are no partitions left.
+  bool startPartitionGroup(int32_t evaluatorIndex);
+
+  // Evaluates the 'numRows' rows of the partitions of 'evaluator' into output
+  // batches.
+  std::vector<RowVectorPtr> evaluatePartitionGroup(
+      Evaluator& evaluator,
+      vector_size_t numRows);
+
+  // Returns the next batch of the partition groups evaluated on the executor.
+  RowVectorPtr getParallelOutput();
+
   // Converts WindowNode::Frame to Window::WindowFrame.
   WindowFrame createWindowFrame(
       core::WindowNode::Frame frame,
@@ -137,6 +261,7 @@ class Window : public Operator {
 
   // Update frame bounds for kPreceding, kFollowing row frames.
   void updateKRowsFrameBounds(
+      Evaluator& evaluator,
       bool isKPreceding,
       const FrameChannelArg& frameArg,
       vector_size_t startRow,
@@ -144,6 +269,7 @@ class Window : public Operator {
       vector_size_t* rawFrameBounds);
 
   void updateFrameBounds(
+      Evaluator& evaluator,
       const WindowFrame& windowFrame,
       const bool isStartBound,
       const vector_size_t startRow,
@@ -162,22 +288,18 @@ class Window : public Operator {
   // reset after the initialization.
   std::shared_ptr<const core::WindowNode> windowNode_;
 
-  // Used to access window partition rows and columns by the window
-  // operator and functions. This structure is owned by the WindowBuild.
-  std::unique_ptr<WindowPartition> currentPartition_;
+  // One Evaluator, or kWindowParallelism Evaluators for a sort based build.
+  std::vector<std::unique_ptr<Evaluator>> evaluators_;
 
-  // HashStringAllocator required by functions that allocate out of line
-  // buffers.
-  HashStringAllocator stringAllocator_;
+  // True once partitions are evaluated concurrently.
+  bool parallel_{false};
 
-  // Vector of WindowFunction objects required by this operator.
-  // WindowFunction is the base API implemented by all the window functions.
-  // The functions are ordered by their positions in the output columns.
-  std::vector<std::unique_ptr<exec::WindowFunction>> windowFunctions_;
+  // The partition groups started on the executor in the order of their
+  // partitions.
+  std::deque<PartitionGroup> partitionGroups_;
 
-  // Vector of WindowFrames corresponding to each windowFunction above.
-  // It represents the frame spec for the function computation.
-  std::vector<WindowFrame> windowFrames_;
+  // Set by close() to skip the partition groups that did not start.
+  std::atomic<bool> cancelled_{false};
 
   // Number of input rows.
   vector_size_t numRows_ = 0;
@@ -185,49 +307,21 @@ class Window : public Operator {
   // Number of rows that be fit into an output block.
   vector_size_t numRowsPerOutput_;
 
-  // The following 4 Buffers are used to pass peer and frame start and
-  // end values to the WindowFunction::apply method. These
-  // buffers can be allocated once and reused across all the getOutput
-  // calls.
-  // Only a single peer start and peer end buffer is needed across all
-  // functions (as the peer values are based on the ORDER BY clause).
-  BufferPtr peerStartBuffer_;
-  BufferPtr peerEndBuffer_;
-  // A separate BufferPtr is required for the frame indexes of each
-  // function. Each function has its own frame clause and style. So we
-  // have as many buffers as the number of functions.
-  std::vector<BufferPtr> frameStartBuffers_;
-  std::vector<BufferPtr> frameEndBuffers_;
-
-  // Frame types for kPreceding or kFollowing could result in empty
-  // frames if the frameStart > frameEnds, or frameEnds < firstPartitionRow
-  // or frameStarts > lastPartitionRow. Such frames usually evaluate to NULL
-  // in the window function.
-  // This SelectivityVector captures the valid (non-empty) frames in the
-  // buffer being worked on. The window function can use this to compute
-  // output values.
-  // There is one SelectivityVector per window function.
-  std::vector<SelectivityVector> validFrames_;
-
   // Number of rows output from the WindowOperator so far. The rows
   // are output in the same order of the pointers in sortedRows. This
   // value is updated as the WindowFunction::apply() function is
   // called on the partition blocks.
   vector_size_t numProcessedRows_ = 0;
 
-  // Tracks how far along the partition rows have been output.
-  vector_size_t partitionOffset_ = 0;
-
-  // When traversing input partition rows, the peers are the rows
-  // with the same values for the ORDER BY clause. These rows
-  // are equal in some ways and affect the results of ranking functions.
-  // Since all rows between the peerStartRow_ and peerEndRow_ have the same
-  // values for peerStartRow_ and peerEndRow_, we needn't compute
-  // them for each row independently. Since these rows might
-  // cross getOutput boundaries and be called in subsequent calls to
-  // computePeerBuffers they are saved here.
-  vector_size_t peerStartRow_ = 0;
-  vector_size_t peerEndRow_ = 0;
+  // The max number of rows before the current row accessed by the window
+  // functions. Set if partitions can be paged in from spill files or are
+  // evaluated while their rows arrive. The rows before are removed from such
+  // partitions after each batch.
+  std::optional<vector_size_t> maxPrecedingRows_;
+
+  // The max number of rows after the current row accessed by the window
+  // functions. Used if partitions are evaluated while their rows arrive.
+  vector_size_t maxFollowingRows_{0};
 };
 
 } // namespace facebook::velox::exec
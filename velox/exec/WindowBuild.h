@@ -50,6 +50,24 @@ class WindowBuild {
   /// Returns the spiller stats including total bytes and rows spilled so far.
   virtual std::optional<SpillStats> spilledStats() const = 0;
 
+  /// Allows the build to return a partition that does not fit in memory as a
+  /// partition that pages its rows in from spill files. Invoked by the Window
+  /// operator if its functions access a bounded range of rows around the
+  /// current row.
+  virtual void enableSpilledPartitions() {}
+
+  /// Allows the build of sorted input to return a partition before all its
+  /// rows are added. The rows are added to the partition as input arrives.
+  /// Invoked by the Window operator if its functions can be evaluated for the
+  /// rows of a partition before the partition ends.
+  virtual void enableIncompletePartitions() {}
+
+  /// Returns the stats of spilling partitions since the last call, or
+  /// std::nullopt if no partition rows were spilled.
+  virtual std::optional<SpillStats> takePartitionSpillStats() {
+    return std::nullopt;
+  }
+
   // The Window operator invokes this function to indicate that no
   // more input rows will be passed from the Window operator to the
   // WindowBuild.
@@ -70,6 +88,13 @@ class WindowBuild {
   // if called when no partition is available.
   virtual std::unique_ptr<WindowPartition> nextPartition() = 0;
 
+  /// Returns true if the partitions returned by nextPartition() stay valid
+  /// after the next call and can be read concurrently. Valid after
+  /// noMoreInput().
+  virtual bool concurrentPartitions() const {
+    return false;
+  }
+
   // Returns the average size of input rows in bytes stored in the
   // data container of the WindowBuild.
   std::optional<int64_t> estimateRowSize() {
@@ -101,6 +101,43 @@ class WindowFunction {
       vector_size_t resultOffset,
       const VectorPtr& result) = 0;
 
+  /// Describes which partition rows apply() accesses. Used to decide whether
+  /// a partition larger than memory can be paged in from spill files.
+  enum class PartitionAccess {
+    /// Any row of the partition. The partition must be fully in memory.
+    kRandom,
+    /// Only the rows of the frames of the batch.
+    kFrameRows,
+    /// Only the rows from the peer group start of the first row of the batch
+    /// onwards.
+    kForward,
+  };
+
+  /// The partition rows accessed by apply(). A function other than kRandom
+  /// must not access partition rows in resetPartition().
+  virtual PartitionAccess partitionAccess() const {
+    return PartitionAccess::kRandom;
+  }
+
+  /// The rows around the current row that apply() accesses besides the rows
+  /// of the frame and of the peer group of the current row.
+  struct RowOffsets {
+    /// Max number of rows before the current row.
+    vector_size_t preceding{0};
+    /// Max number of rows after the current row.
+    vector_size_t following{0};
+  };
+
+  /// Returns the rows around the current row accessed by apply() if apply()
+  /// does not depend on the number of rows in the partition, or std::nullopt
+  /// otherwise. Used to evaluate the rows of a partition of sorted input
+  /// before all its rows arrive. numRows() of such a partition is the number
+  /// of rows added so far and grows between calls to apply(). A function that
+  /// returns a value must not access partition rows in resetPartition().
+  virtual std::optional<RowOffsets> streamingRowOffsets() const {
+    return std::nullopt;
+  }
+
   static std::unique_ptr<WindowFunction> create(
       const std::string& name,
       const std::vector<WindowFunctionArg>& args,
@@ -24,20 +24,62 @@ WindowPartition::WindowPartition(
     const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
     : data_(data),
       partition_(rows),
+      numRows_(rows.size()),
       columns_(columns),
       sortKeyInfo_(sortKeyInfo) {}
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    vector_size_t numRows,
+    const std::vector<exec::RowColumn>& columns,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : data_(data),
+      numRows_(numRows),
+      columns_(columns),
+      sortKeyInfo_(sortKeyInfo) {}
+
+char* const* WindowPartition::rowsAt(
+    vector_size_t start,
+    vector_size_t numRows) const {
+  if (start + numRows > startRow_ + partition_.size()) {
+    loadRows(start + numRows);
+  }
+  VELOX_CHECK_GE(
+      start, startRow_, "Window partition row {} is not in memory", start);
+  return partition_.data() + (start - startRow_);
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  vector_size_t minRow = numRows_;
+  vector_size_t maxRow = -1;
+  for (auto row : rowNumbers) {
+    // Negative row numbers are for null results.
+    if (row >= 0) {
+      minRow = std::min(minRow, row);
+      maxRow = std::max(maxRow, row);
+    }
+  }
+  if (maxRow < 0) {
+    minRow = startRow_;
+    maxRow = startRow_ - 1;
+  }
+  auto* rows = rowsAt(minRow, maxRow + 1 - minRow);
+  rows -= minRow - startRow_;
+  if (startRow_ != 0) {
+    relativeRowNumbers_.resize(rowNumbers.size());
+    for (auto i = 0; i < rowNumbers.size(); ++i) {
+      relativeRowNumbers_[i] =
+          rowNumbers[i] >= 0 ? rowNumbers[i] - startRow_ : rowNumbers[i];
+    }
+    rowNumbers = folly::Range<const vector_size_t*>(
+        relativeRowNumbers_.data(), relativeRowNumbers_.size());
+  }
   RowContainer::extractColumn(
-      partition_.data(),
-      rowNumbers,
-      columns_[columnIndex],
-      resultOffset,
-      result);
+      rows, rowNumbers, columns_[columnIndex], resultOffset, result);
 }
 
 void WindowPartition::extractColumn(
@@ -47,7 +89,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      rowsAt(partitionOffset, numRows),
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -60,7 +102,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      rowsAt(partitionOffset, numRows),
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -157,8 +199,9 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
       // or when past the previous peerGroup.
       peerStart = i;
       peerEnd = i;
+      auto* peerStartRow = *rowsAt(peerStart, 1);
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(peerStartRow, *rowsAt(peerEnd, 1))) {
           break;
         }
         peerEnd++;
@@ -20,7 +20,9 @@
 
 /// Simple WindowPartition that builds over the RowContainer used for storing
 /// the input rows in the Window Operator. This works completely in-memory.
-/// TODO: This implementation will be revised for Spill to disk semantics.
+/// A partition that does not fit in memory is a SpilledWindowPartition which
+/// pages its rows in from spill files. A partition of sorted input that is
+/// evaluated while its rows arrive is a StreamingWindowPartition.
 
 namespace facebook::velox::exec {
 class WindowPartition {
@@ -40,11 +42,30 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
+  virtual ~WindowPartition() = default;
+
   /// Returns the number of rows in the current WindowPartition.
   vector_size_t numRows() const {
-    return partition_.size();
+    return numRows_;
+  }
+
+  /// Returns false for a partition of sorted input that is returned before all
+  /// its rows are added. numRows() is then the number of rows added so far.
+  virtual bool complete() const {
+    return true;
   }
 
+  /// Returns the position of the first row of the last peer group added to
+  /// the partition. The peer groups of the rows before it are complete.
+  virtual vector_size_t lastPeerGroupStart() const {
+    return numRows_;
+  }
+
+  /// Invoked by the Window operator to indicate that the rows before 'row'
+  /// are not accessed anymore. A partition paged in from spill files removes
+  /// them from memory.
+  virtual void removeRowsBefore(vector_size_t /*row*/) {}
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -107,8 +128,21 @@ class WindowPartition {
       vector_size_t* rawPeerStarts,
       vector_size_t* rawPeerEnds) const;
 
- private:
-  bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
+ protected:
+  // Constructs a partition of 'numRows' rows that are not in memory yet. The
+  // subclass sets 'partition_' and 'startRow_' in loadRows().
+  WindowPartition(
+      RowContainer* data,
+      vector_size_t numRows,
+      const std::vector<exec::RowColumn>& columns,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  // Makes the rows before 'endRow' available in 'partition_'. Only called for
+  // rows past the end of 'partition_'.
+  virtual void loadRows(vector_size_t /*endRow*/) const {
+    VELOX_UNREACHABLE();
+  }
 
   // The RowContainer associated with the partition.
   // It is owned by the WindowBuild that creates the partition.
@@ -117,8 +151,23 @@ class WindowPartition {
   // folly::Range is for the partition rows iterator provided by the
   // Window operator. The pointers are to rows from a RowContainer owned
   // by the operator. We can assume these are valid values for the lifetime
-  // of WindowPartition.
-  folly::Range<char**> partition_;
+  // of WindowPartition. Covers the partition rows from 'startRow_'.
+  mutable folly::Range<char**> partition_;
+
+  // The position in the partition of the first row in 'partition_'. Always 0
+  // for in-memory partitions.
+  mutable vector_size_t startRow_{0};
+
+  // The number of rows in the partition. Grows while rows are added to an
+  // incomplete partition.
+  vector_size_t numRows_;
+
+ private:
+  bool compareRowsWithSortKeys(const char* lhs, const char* rhs) const;
+
+  // Returns the pointers to 'numRows' partition rows from 'start'. Loads the
+  // rows if needed.
+  char* const* rowsAt(vector_size_t start, vector_size_t numRows) const;
 
   // Copy of the input RowColumn objects that are used for
   // accessing the partition row columns. These RowColumn objects
@@ -131,5 +180,9 @@ class WindowPartition {
 
   // ORDER BY column info for this partition.
   const std::vector<std::pair<column_index_t, core::SortOrder>> sortKeyInfo_;
+
+  // Row numbers relative to 'startRow_'. Used by extractColumn() for
+  // partitions that do not start at 'partition_'.
+  mutable std::vector<vector_size_t> relativeRowNumbers_;
 };
 } // namespace facebook::velox::exec
@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
+#include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
@@ -26,7 +28,9 @@
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
+#include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/UnsafeRowSerializer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 DEFINE_int32(width, 16, "Number of parties in shuffle");
@@ -40,6 +44,31 @@ DEFINE_int64(
     32,
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
+DEFINE_string(
+    serde,
+    "presto",
+    "Serde of the shuffle: presto, compact or unsafe");
+
+DEFINE_bool(
+    serde_suite,
+    false,
+    "Runs the serialize/deserialize suite instead of the shuffle benchmarks");
+DEFINE_string(suite_serdes, "presto,compact,unsafe", "Serdes in serde suite");
+DEFINE_string(
+    suite_compression,
+    "none,lz4,zstd",
+    "Compression kinds in serde suite. Only presto serde compresses");
+DEFINE_string(
+    suite_partitions,
+    "1,16,256,4096",
+    "Numbers of partitions in serde suite");
+DEFINE_string(
+    suite_encodings,
+    "flat,dictionary,constant",
+    "Column encodings in serde suite");
+DEFINE_string(suite_columns, "4,16,64", "Numbers of columns in serde suite");
+DEFINE_int32(suite_rows, 10'000, "Rows per batch in serde suite");
+DEFINE_int32(suite_repeat, 5, "Repeats of each case in serde suite");
 
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
@@ -48,6 +77,12 @@ DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 /// count the rows and send the count to a final single task stage
 /// that returns the sum of the counts. The sum is expected to be n *
 /// number of rows in constant input.
+///
+/// With --serde_suite, measures instead the serialization of a batch into
+/// each of a number of partitions and the deserialization of the resulting
+/// pages for each combination of serde, compression kind, number of
+/// partitions, column encoding and number of columns. Reports GB/s and CPU
+/// nanoseconds per byte of flat input.
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -294,6 +329,205 @@ class ExchangeBenchmark : public VectorTestBase {
   std::unordered_map<std::string, std::string> configSettings_;
 };
 
+std::unique_ptr<VectorSerde> makeSerde(const std::string& name) {
+  if (name == "presto") {
+    return std::make_unique<serializer::presto::PrestoVectorSerde>();
+  }
+  if (name == "compact") {
+    return std::make_unique<serializer::CompactRowVectorSerde>();
+  }
+  if (name == "unsafe") {
+    return std::make_unique<serializer::spark::UnsafeRowVectorSerde>();
+  }
+  VELOX_USER_FAIL("Unknown serde: {}", name);
+}
+
+template <typename T>
+std::vector<T> splitFlag(const std::string& flag) {
+  std::vector<T> values;
+  folly::split(',', flag, values);
+  return values;
+}
+
+class SerdeSuite : public VectorTestBase {
+ public:
+  void run() {
+    std::cout << fmt::format(
+                     "{:>8} {:>6} {:>10} {:>10} {:>7} {:>9} {:>9} {:>9} "
+                     "{:>9} {:>6}",
+                     "serde",
+                     "codec",
+                     "partitions",
+                     "encoding",
+                     "columns",
+                     "ser GB/s",
+                     "ser ns/B",
+                     "de GB/s",
+                     "de ns/B",
+                     "ratio")
+              << std::endl;
+    for (auto numColumns : splitFlag<int32_t>(FLAGS_suite_columns)) {
+      for (const auto& encoding :
+           splitFlag<std::string>(FLAGS_suite_encodings)) {
+        auto data = makeData(numColumns, encoding);
+        for (const auto& serdeName :
+             splitFlag<std::string>(FLAGS_suite_serdes)) {
+          auto serde = makeSerde(serdeName);
+          for (const auto& codec :
+               splitFlag<std::string>(FLAGS_suite_compression)) {
+            const auto kind = common::stringToCompressionKind(codec);
+            if (serdeName != "presto" && kind != common::CompressionKind_NONE) {
+              continue;
+            }
+            for (auto numPartitions :
+                 splitFlag<int32_t>(FLAGS_suite_partitions)) {
+              runCase(*serde, kind, numPartitions, data);
+              std::cout << fmt::format(
+                               "{:>8} {:>6} {:>10} {:>10} {:>7} ",
+                               serdeName,
+                               codec,
+                               numPartitions,
+                               encoding,
+                               numColumns)
+                        << result_.toString() << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  struct Result {
+    CpuWallTiming serialize;
+    CpuWallTiming deserialize;
+    int64_t inputBytes{0};
+    int64_t serializedBytes{0};
+
+    std::string toString() const {
+      auto gbPerSecond = [&](const CpuWallTiming& timing) {
+        return inputBytes / static_cast<double>(timing.wallNanos);
+      };
+      auto nanosPerByte = [&](const CpuWallTiming& timing) {
+        return timing.cpuNanos / static_cast<double>(inputBytes);
+      };
+      return fmt::format(
+          "{:>9.3f} {:>9.3f} {:>9.3f} {:>9.3f} {:>6.2f}",
+          gbPerSecond(serialize),
+          nanosPerByte(serialize),
+          gbPerSecond(deserialize),
+          nanosPerByte(deserialize),
+          serializedBytes / static_cast<double>(inputBytes));
+    }
+  };
+
+  // Makes a batch of 'numColumns' BIGINT, VARCHAR and DOUBLE columns with
+  // 'encoding'.
+  RowVectorPtr makeData(int32_t numColumns, const std::string& encoding) {
+    const auto numRows = FLAGS_suite_rows;
+    std::vector<VectorPtr> columns;
+    for (auto i = 0; i < numColumns; ++i) {
+      VectorPtr column;
+      switch (i % 3) {
+        case 0:
+          column = makeFlatVector<int64_t>(
+              numRows, [](auto row) { return row * 7919; });
+          break;
+        case 1:
+          column = makeFlatVector<std::string>(numRows, [](auto row) {
+            return fmt::format("string value {}", row % 1000);
+          });
+          break;
+        default:
+          column = makeFlatVector<double>(
+              numRows, [](auto row) { return row * 0.1; });
+          break;
+      }
+      if (encoding == "dictionary") {
+        auto indices = makeIndices(numRows, [&](auto row) {
+          return (row * 31) % (numRows / 10);
+        });
+        column = wrapInDictionary(indices, numRows, column);
+      } else if (encoding == "constant") {
+        column = BaseVector::wrapInConstant(numRows, 0, column);
+      } else {
+        VELOX_USER_CHECK_EQ(encoding, "flat", "Unknown encoding");
+      }
+      columns.push_back(std::move(column));
+    }
+    return makeRowVector(columns);
+  }
+
+  // Serializes the rows of 'data' round robin into 'numPartitions' pages and
+  // deserializes the pages 'FLAGS_suite_repeat' times.
+  void runCase(
+      VectorSerde& serde,
+      common::CompressionKind kind,
+      int32_t numPartitions,
+      const RowVectorPtr& data) {
+    result_ = Result();
+    const serializer::presto::PrestoVectorSerde::PrestoOptions options{
+        false, kind};
+    const auto type = asRowType(data->type());
+    std::vector<std::vector<IndexRange>> partitionRows(numPartitions);
+    for (auto i = 0; i < data->size(); ++i) {
+      partitionRows[i % numPartitions].push_back({i, 1});
+    }
+    std::vector<folly::Range<const IndexRange*>> ranges;
+    for (const auto& rows : partitionRows) {
+      ranges.emplace_back(rows.data(), rows.size());
+    }
+
+    for (auto repeat = 0; repeat < FLAGS_suite_repeat; ++repeat) {
+      std::vector<std::unique_ptr<folly::IOBuf>> pages;
+      {
+        DeltaCpuWallTimer timer(
+            [&](const auto& timing) { result_.serialize.add(timing); });
+        std::vector<std::unique_ptr<StreamArena>> arenas;
+        std::vector<std::unique_ptr<VectorSerializer>> serializers;
+        std::vector<VectorSerializer*> rawSerializers;
+        for (auto i = 0; i < numPartitions; ++i) {
+          arenas.push_back(std::make_unique<StreamArena>(pool()));
+          serializers.push_back(serde.createSerializer(
+              type, partitionRows[i].size(), arenas.back().get(), &options));
+          rawSerializers.push_back(serializers.back().get());
+        }
+        serde.scatter(data, ranges, rawSerializers);
+        for (auto i = 0; i < numPartitions; ++i) {
+          if (partitionRows[i].empty()) {
+            continue;
+          }
+          IOBufOutputStream out(*pool());
+          serializers[i]->flush(&out);
+          pages.push_back(out.getIOBuf());
+        }
+      }
+      result_.inputBytes += data->estimateFlatSize();
+
+      DeltaCpuWallTimer timer(
+          [&](const auto& timing) { result_.deserialize.add(timing); });
+      for (const auto& page : pages) {
+        result_.serializedBytes += page->computeChainDataLength();
+        std::vector<ByteRange> byteRanges;
+        for (const auto& range : *page) {
+          byteRanges.push_back(
+              {const_cast<uint8_t*>(range.data()),
+               static_cast<int32_t>(range.size()),
+               0});
+        }
+        ByteStream input;
+        input.resetInput(std::move(byteRanges));
+        while (!input.atEnd()) {
+          RowVectorPtr result;
+          serde.deserialize(&input, pool(), type, &result, &options);
+        }
+      }
+    }
+  }
+
+  Result result_;
+};
+
 ExchangeBenchmark bm;
 
 std::vector<RowVectorPtr> flat10k;
@@ -335,7 +569,12 @@ int main(int argc, char** argv) {
   functions::prestosql::registerAllScalarFunctions();
   aggregate::prestosql::registerAllAggregateFunctions();
   parse::registerTypeResolver();
-  serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  if (FLAGS_serde_suite) {
+    SerdeSuite suite;
+    suite.run();
+    return 0;
+  }
+  velox::registerVectorSerde(makeSerde(FLAGS_serde));
   exec::ExchangeSource::registerFactory(exec::test::createLocalExchangeSource);
   std::vector<std::string> flatNames = {"c0"};
   std::vector<TypePtr> flatTypes = {BIGINT()};
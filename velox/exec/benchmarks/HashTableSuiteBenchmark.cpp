@@ -0,0 +1,819 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+
+#include <cstring>
+#include <numeric>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+DEFINE_int64(
+    max_build_size,
+    1'000'000,
+    "Largest build side in rows. The build sizes are 1K, 64K, 1M, 16M, 128M "
+    "and 1B rows up to this limit");
+DEFINE_int64(probe_rows, 1'000'000, "Number of probe rows per join case");
+DEFINE_int32(
+    group_rows_per_key,
+    4,
+    "Number of input rows per distinct key in group by cases");
+DEFINE_int64(memory_capacity_gb, 16, "Capacity of the memory allocator");
+DEFINE_string(
+    key_types,
+    "bigint,bigint2,varchar,bigint_varchar",
+    "Comma separated key types to run: bigint, bigint2 (two bigint keys), "
+    "varchar, bigint_varchar");
+DEFINE_string(
+    key_layouts,
+    "dense,sparse,hash",
+    "Comma separated key layouts to run: dense (consecutive keys, kArray "
+    "mode), sparse (widely spaced keys, kNormalizedKey mode for large "
+    "tables), hash (kHash mode forced)");
+DEFINE_string(
+    hit_pcts,
+    "100,5",
+    "Comma separated percentages of probe rows that hit the build side");
+DEFINE_string(
+    duplicates,
+    "unique,uniform,skewed",
+    "Comma separated build side key distributions: unique, uniform (each key "
+    "4 times), skewed (half of the rows on 0.1% of the keys)");
+DEFINE_bool(
+    count_cache_misses,
+    true,
+    "Count cache misses with perf_event_open() where available");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+constexpr vector_size_t kBatchSize = 10'000;
+
+enum class KeyType { kBigint, kTwoBigint, kVarchar, kBigintVarchar };
+
+enum class KeyLayout { kDense, kSparse, kHash };
+
+enum class Duplicates { kUnique, kUniform, kSkewed };
+
+KeyType keyTypeFromString(const std::string& name) {
+  if (name == "bigint") {
+    return KeyType::kBigint;
+  }
+  if (name == "bigint2") {
+    return KeyType::kTwoBigint;
+  }
+  if (name == "varchar") {
+    return KeyType::kVarchar;
+  }
+  if (name == "bigint_varchar") {
+    return KeyType::kBigintVarchar;
+  }
+  VELOX_USER_FAIL("Unknown key type: {}", name);
+}
+
+std::string keyTypeString(KeyType type) {
+  switch (type) {
+    case KeyType::kBigint:
+      return "bigint";
+    case KeyType::kTwoBigint:
+      return "bigint2";
+    case KeyType::kVarchar:
+      return "varchar";
+    case KeyType::kBigintVarchar:
+      return "bigint_varchar";
+  }
+  VELOX_UNREACHABLE();
+}
+
+KeyLayout keyLayoutFromString(const std::string& name) {
+  if (name == "dense") {
+    return KeyLayout::kDense;
+  }
+  if (name == "sparse") {
+    return KeyLayout::kSparse;
+  }
+  if (name == "hash") {
+    return KeyLayout::kHash;
+  }
+  VELOX_USER_FAIL("Unknown key layout: {}", name);
+}
+
+std::string keyLayoutString(KeyLayout layout) {
+  switch (layout) {
+    case KeyLayout::kDense:
+      return "dense";
+    case KeyLayout::kSparse:
+      return "sparse";
+    case KeyLayout::kHash:
+      return "hash";
+  }
+  VELOX_UNREACHABLE();
+}
+
+Duplicates duplicatesFromString(const std::string& name) {
+  if (name == "unique") {
+    return Duplicates::kUnique;
+  }
+  if (name == "uniform") {
+    return Duplicates::kUniform;
+  }
+  if (name == "skewed") {
+    return Duplicates::kSkewed;
+  }
+  VELOX_USER_FAIL("Unknown duplicate distribution: {}", name);
+}
+
+std::string duplicatesString(Duplicates duplicates) {
+  switch (duplicates) {
+    case Duplicates::kUnique:
+      return "unique";
+    case Duplicates::kUniform:
+      return "uniform";
+    case Duplicates::kSkewed:
+      return "skewed";
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::string sizeString(int64_t size) {
+  if (size >= 1'000'000'000 && size % 1'000'000'000 == 0) {
+    return fmt::format("{}B", size / 1'000'000'000);
+  }
+  if (size >= 1'000'000 && size % 1'000'000 == 0) {
+    return fmt::format("{}M", size / 1'000'000);
+  }
+  if (size >= 1'000 && size % 1'000 == 0) {
+    return fmt::format("{}K", size / 1'000);
+  }
+  return fmt::format("{}", size);
+}
+
+template <typename T, typename F>
+std::vector<T> parseList(const std::string& flag, F fromString) {
+  std::vector<std::string> names;
+  folly::split(',', flag, names, true);
+  std::vector<T> result;
+  for (const auto& name : names) {
+    result.push_back(fromString(name));
+  }
+  return result;
+}
+
+// Counts the last level cache misses of the calling thread with
+// perf_event_open(). The counter is not available in some containers and
+// VMs, in which case total() is -1.
+class CacheMissCounter {
+ public:
+  CacheMissCounter() {
+#ifdef __linux__
+    if (!FLAGS_count_cache_misses) {
+      return;
+    }
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+  }
+
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // Adds the misses since start() to the total.
+  void stop() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t count;
+      if (read(fd_, &count, sizeof(count)) == sizeof(count)) {
+        total_ += count;
+      }
+    }
+#endif
+  }
+
+  int64_t total() const {
+    return fd_ >= 0 ? total_ : -1;
+  }
+
+ private:
+  int fd_{-1};
+  int64_t total_{0};
+};
+
+// Counts cache misses for the lifetime of 'this'.
+class CacheMissTimer {
+ public:
+  explicit CacheMissTimer(CacheMissCounter& counter) : counter_(counter) {
+    counter_.start();
+  }
+
+  ~CacheMissTimer() {
+    counter_.stop();
+  }
+
+ private:
+  CacheMissCounter& counter_;
+};
+
+std::string perRow(int64_t total, int64_t numRows) {
+  if (total < 0) {
+    return "n/a";
+  }
+  return fmt::format("{:.2f}", numRows ? total / (double)numRows : 0.0);
+}
+
+std::string perRow(const SelectivityInfo& time, int64_t numRows) {
+  // timeToDropValue() is the total time when no rows are dropped.
+  return fmt::format(
+      "{:.1f}", numRows ? time.timeToDropValue() / (double)numRows : 0.0);
+}
+
+struct JoinCase {
+  KeyType keyType;
+  KeyLayout layout;
+  int64_t buildSize;
+  int32_t hitPct;
+  Duplicates duplicates;
+
+  std::string title() const {
+    return fmt::format(
+        "join_{}_{}_{}_hit{}_{}",
+        keyTypeString(keyType),
+        keyLayoutString(layout),
+        sizeString(buildSize),
+        hitPct,
+        duplicatesString(duplicates));
+  }
+};
+
+struct GroupCase {
+  KeyType keyType;
+  KeyLayout layout;
+  int64_t numDistinct;
+
+  std::string title() const {
+    return fmt::format(
+        "group_{}_{}_{}",
+        keyTypeString(keyType),
+        keyLayoutString(layout),
+        sizeString(numDistinct));
+  }
+};
+
+struct JoinRun {
+  std::string title;
+  int64_t buildRows{0};
+  int64_t numDistinct{0};
+  BaseHashTable::HashMode hashMode;
+  SelectivityInfo insertTime;
+  SelectivityInfo prepareTime;
+  int64_t numProbed{0};
+  int64_t numHit{0};
+  int64_t numResults{0};
+  SelectivityInfo hashTime;
+  SelectivityInfo probeTime;
+  SelectivityInfo listTime;
+  int64_t probeCacheMisses{0};
+
+  std::string toString() const {
+    return fmt::format(
+        "{}: mode={} buildRows={} distinct={} insert/row={} "
+        "prepare/row={} | probed={} hit={} results={} hash/row={} "
+        "probe/row={} list/row={} probe misses/row={}",
+        title,
+        BaseHashTable::modeString(hashMode),
+        buildRows,
+        numDistinct,
+        perRow(insertTime, buildRows),
+        perRow(prepareTime, buildRows),
+        numProbed,
+        numHit,
+        numResults,
+        perRow(hashTime, numProbed),
+        perRow(probeTime, numProbed),
+        perRow(listTime, numResults),
+        perRow(probeCacheMisses, numProbed));
+  }
+};
+
+struct GroupRun {
+  std::string title;
+  int64_t numRows{0};
+  int64_t numDistinct{0};
+  // The hash modes the table went through, in order.
+  std::vector<BaseHashTable::HashMode> modes;
+  int32_t numDecideHashMode{0};
+  int64_t numRehashes{0};
+  SelectivityInfo hashTime;
+  SelectivityInfo decideTime;
+  SelectivityInfo probeTime;
+  int64_t probeCacheMisses{0};
+
+  std::string toString() const {
+    std::vector<std::string> modeNames;
+    for (auto mode : modes) {
+      modeNames.push_back(BaseHashTable::modeString(mode));
+    }
+    return fmt::format(
+        "{}: modes={} rows={} distinct={} hash/row={} probe/row={} "
+        "probe misses/row={} | decideHashMode calls={} clocks/call={} "
+        "clocks/row={} rehashes={}",
+        title,
+        folly::join(">", modeNames),
+        numRows,
+        numDistinct,
+        perRow(hashTime, numRows),
+        perRow(probeTime, numRows),
+        perRow(probeCacheMisses, numRows),
+        numDecideHashMode,
+        perRow(decideTime, numDecideHashMode),
+        perRow(decideTime, numRows),
+        numRehashes);
+  }
+};
+
+// Benchmark suite for HashTable. Join cases fill a build side, time the
+// table build with prepareJoinTable(), then probe with a given fraction of
+// hits and list the join results. Group cases insert a stream of keys with
+// groupProbe() and measure the time of the decideHashMode() and rehash
+// transitions the growing key ranges trigger. The dimensions are the build
+// size, the key types, the key layout that selects the hash mode, the hit
+// rate and the distribution of duplicate build keys. Times are in
+// folly::hardware_timestamp() clocks and cache misses are counted with
+// perf_event_open() where available.
+class HashTableSuiteBenchmark : public VectorTestBase {
+ public:
+  JoinRun runJoin(const JoinCase& joinCase) {
+    JoinRun run;
+    run.title = joinCase.title();
+    initKeys(joinCase.keyType, joinCase.layout);
+    const auto buildSize = joinCase.buildSize;
+    int64_t numHot = 0;
+    int64_t numDistinct = buildSize;
+    switch (joinCase.duplicates) {
+      case Duplicates::kUnique:
+        break;
+      case Duplicates::kUniform:
+        numDistinct = std::max<int64_t>(1, buildSize / 4);
+        break;
+      case Duplicates::kSkewed:
+        numHot = std::max<int64_t>(1, buildSize / 1'000);
+        numDistinct = numHot + buildSize / 2;
+        break;
+    }
+    const auto multiplier = coprimeMultiplier(numDistinct - numHot);
+
+    // The i'th build row has the key with this id. The ids are scattered so
+    // that consecutive probes do not hit consecutive table positions.
+    auto buildKeyId = [&](int64_t row) -> int64_t {
+      switch (joinCase.duplicates) {
+        case Duplicates::kUnique:
+          return (row * multiplier) % numDistinct;
+        case Duplicates::kUniform:
+          return ((row % numDistinct) * multiplier) % numDistinct;
+        case Duplicates::kSkewed:
+          if (row % 2 == 0) {
+            return (row / 2) % numHot;
+          }
+          return numHot + ((row / 2) * multiplier) % (numDistinct - numHot);
+      }
+      VELOX_UNREACHABLE();
+    };
+
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto i = 0; i < keyTypes_.size(); ++i) {
+      hashers.push_back(std::make_unique<VectorHasher>(keyTypes_[i], i));
+    }
+    auto table = HashTable<true>::createForJoin(
+        std::move(hashers), {BIGINT()}, true, false, 1'000, pool_.get());
+    if (joinCase.layout == KeyLayout::kHash) {
+      table->forceGenericHashMode();
+    }
+
+    std::vector<int64_t> ids(kBatchSize);
+    for (int64_t start = 0; start < buildSize; start += kBatchSize) {
+      const vector_size_t size =
+          std::min<int64_t>(kBatchSize, buildSize - start);
+      ids.resize(size);
+      for (auto i = 0; i < size; ++i) {
+        ids[i] = buildKeyId(start + i);
+      }
+      auto batch = makeBatch(ids, start);
+      SelectivityTimer timer(run.insertTime, 0);
+      insertRows(*batch, *table);
+    }
+    run.buildRows = buildSize;
+    run.numDistinct = numDistinct;
+    {
+      SelectivityTimer timer(run.prepareTime, 0);
+      table->prepareJoinTable({});
+    }
+    run.hashMode = table->hashMode();
+
+    // Probe keys hit with 'hitPct' probability. Misses have ids past the
+    // build side ids.
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    auto lookup = std::make_unique<HashLookup>(table->hashers());
+    VectorHasher::ScratchMemory scratchMemory;
+    BaseHashTable::JoinResultIterator iter;
+    std::vector<vector_size_t> resultRows(kBatchSize);
+    std::vector<char*> resultHits(kBatchSize);
+    CacheMissCounter cacheMisses;
+    auto& tableHashers = table->hashers();
+    for (int64_t start = 0; start < FLAGS_probe_rows; start += kBatchSize) {
+      const vector_size_t size =
+          std::min<int64_t>(kBatchSize, FLAGS_probe_rows - start);
+      ids.resize(size);
+      for (auto i = 0; i < size; ++i) {
+        const auto random = folly::Random::rand64(rng);
+        ids[i] = (random % 100 < joinCase.hitPct ? 0 : numDistinct) +
+            (random / 100) % numDistinct;
+      }
+      auto batch = makeBatch(ids, start);
+
+      SelectivityVector rows(size);
+      lookup->reset(size);
+      {
+        SelectivityTimer timer(run.hashTime, 0);
+        for (auto i = 0; i < tableHashers.size(); ++i) {
+          const auto& key = batch->childAt(i);
+          if (run.hashMode != BaseHashTable::HashMode::kHash) {
+            tableHashers[i]->lookupValueIds(
+                *key, rows, scratchMemory, lookup->hashes);
+          } else {
+            tableHashers[i]->decode(*key, rows);
+            tableHashers[i]->hash(rows, i > 0, lookup->hashes);
+          }
+        }
+      }
+      run.numProbed += size;
+      lookup->rows.clear();
+      rows.applyToSelected([&](auto row) { lookup->rows.push_back(row); });
+      if (lookup->rows.empty()) {
+        // The value ids disqualify all rows. The table is not consulted.
+        continue;
+      }
+      {
+        SelectivityTimer timer(run.probeTime, 0);
+        CacheMissTimer missTimer(cacheMisses);
+        table->joinProbe(*lookup);
+      }
+      for (auto row : lookup->rows) {
+        run.numHit += lookup->hits[row] != nullptr;
+      }
+      {
+        SelectivityTimer timer(run.listTime, 0);
+        iter.reset(*lookup);
+        while (!iter.atEnd()) {
+          run.numResults += table->listJoinResults(
+              iter,
+              false,
+              folly::Range<vector_size_t*>(resultRows.data(), kBatchSize),
+              folly::Range<char**>(resultHits.data(), kBatchSize));
+        }
+      }
+    }
+    run.probeCacheMisses = cacheMisses.total();
+    return run;
+  }
+
+  GroupRun runGroup(const GroupCase& groupCase) {
+    GroupRun run;
+    run.title = groupCase.title();
+    initKeys(groupCase.keyType, groupCase.layout);
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto i = 0; i < keyTypes_.size(); ++i) {
+      hashers.push_back(std::make_unique<VectorHasher>(keyTypes_[i], i));
+    }
+    auto table = HashTable<false>::createForAggregation(
+        std::move(hashers), {}, pool_.get());
+    if (groupCase.layout == KeyLayout::kHash) {
+      table->forceGenericHashMode();
+    }
+    run.modes.push_back(table->hashMode());
+
+    // The first pass over the keys widens the key ranges batch by batch and
+    // triggers the mode transitions. The next passes only hit existing
+    // groups.
+    const auto numDistinct = groupCase.numDistinct;
+    const auto numRows = numDistinct * FLAGS_group_rows_per_key;
+    HashLookup lookup(table->hashers());
+    CacheMissCounter cacheMisses;
+    std::vector<int64_t> ids(kBatchSize);
+    for (int64_t start = 0; start < numRows; start += kBatchSize) {
+      const vector_size_t size = std::min<int64_t>(kBatchSize, numRows - start);
+      ids.resize(size);
+      for (auto i = 0; i < size; ++i) {
+        ids[i] = (start + i) % numDistinct;
+      }
+      auto batch = makeBatch(ids, start);
+      insertGroups(*batch, lookup, *table, cacheMisses, run);
+    }
+    run.numRows = numRows;
+    run.numDistinct = table->numDistinct();
+    run.numRehashes = table->stats().numRehashes;
+    run.probeCacheMisses = cacheMisses.total();
+    return run;
+  }
+
+ private:
+  void initKeys(KeyType keyType, KeyLayout layout) {
+    keyType_ = keyType;
+    switch (keyType) {
+      case KeyType::kBigint:
+        keyTypes_ = {BIGINT()};
+        break;
+      case KeyType::kTwoBigint:
+        keyTypes_ = {BIGINT(), BIGINT()};
+        break;
+      case KeyType::kVarchar:
+        keyTypes_ = {VARCHAR()};
+        break;
+      case KeyType::kBigintVarchar:
+        keyTypes_ = {BIGINT(), VARCHAR()};
+        break;
+    }
+    // Widely spaced keys overflow the kArray range for all but small tables.
+    keySpacing_ = layout == KeyLayout::kSparse ? 1'000 : 1;
+  }
+
+  // Returns a multiplier that makes (i * multiplier) % 'size' a permutation
+  // of [0, size).
+  static int64_t coprimeMultiplier(int64_t size) {
+    int64_t multiplier = 2'654'435'761 % std::max<int64_t>(size, 1);
+    while (multiplier <= 1 || std::gcd(multiplier, size) != 1) {
+      if (size <= 2) {
+        return 1;
+      }
+      multiplier = (multiplier + 1) % size;
+    }
+    return multiplier;
+  }
+
+  // Makes a batch with the key columns for 'ids' followed by a BIGINT
+  // payload numbered from 'firstRow'. Multi-part keys split the id so that
+  // the combination of the parts is unique.
+  RowVectorPtr makeBatch(const std::vector<int64_t>& ids, int64_t firstRow) {
+    const vector_size_t size = ids.size();
+    auto bigints = [&](auto valueAt) {
+      return makeFlatVector<int64_t>(
+          size, [&](auto row) { return valueAt(ids[row]) * keySpacing_; });
+    };
+    auto strings = [&](auto valueAt) {
+      auto vector =
+          BaseVector::create<FlatVector<StringView>>(VARCHAR(), size, pool());
+      for (auto row = 0; row < size; ++row) {
+        const auto value = valueAt(ids[row]);
+        auto string = fmt::format("{}", value * keySpacing_);
+        // Every 10th key does not fit inline in a StringView.
+        if (value % 10 == 0) {
+          string += "-not-inlined-key";
+        }
+        vector->set(row, StringView(string));
+      }
+      return vector;
+    };
+    auto whole = [](int64_t id) { return id; };
+    auto low = [](int64_t id) { return id % 1'000; };
+    auto high = [](int64_t id) { return id / 1'000; };
+
+    std::vector<VectorPtr> children;
+    switch (keyType_) {
+      case KeyType::kBigint:
+        children.push_back(bigints(whole));
+        break;
+      case KeyType::kTwoBigint:
+        children.push_back(bigints(low));
+        children.push_back(bigints(high));
+        break;
+      case KeyType::kVarchar:
+        children.push_back(strings(whole));
+        break;
+      case KeyType::kBigintVarchar:
+        children.push_back(bigints(low));
+        children.push_back(strings(high));
+        break;
+    }
+    children.push_back(makeFlatVector<int64_t>(
+        size, [&](auto row) { return firstRow + row; }));
+    return makeRowVector(children);
+  }
+
+  // Stores the rows of 'batch' in the RowContainer of 'table' and updates
+  // the value ranges of its VectorHashers like a join build does.
+  void insertRows(const RowVector& batch, BaseHashTable& table) {
+    const SelectivityVector rows(batch.size());
+    auto& hashers = table.hashers();
+    for (auto i = 0; i < hashers.size(); ++i) {
+      hashers[i]->decode(*batch.childAt(i), rows);
+      if (table.hashMode() != BaseHashTable::HashMode::kHash &&
+          hashers[i]->mayUseValueIds()) {
+        hashers[i]->computeValueIds(rows, dummyHashes_);
+      }
+    }
+    decoded_.resize(batch.childrenSize());
+    for (auto i = 0; i < batch.childrenSize(); ++i) {
+      decoded_[i].decode(*batch.childAt(i), rows);
+    }
+    auto* rowContainer = table.rows();
+    const auto nextOffset = rowContainer->nextOffset();
+    for (auto row = 0; row < batch.size(); ++row) {
+      char* newRow = rowContainer->newRow();
+      if (nextOffset) {
+        *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+      }
+      for (auto i = 0; i < batch.childrenSize(); ++i) {
+        rowContainer->store(decoded_[i], row, newRow, i);
+      }
+    }
+  }
+
+  void insertGroups(
+      const RowVector& input,
+      HashLookup& lookup,
+      HashTable<false>& table,
+      CacheMissCounter& cacheMisses,
+      GroupRun& run) {
+    const SelectivityVector rows(input.size());
+    auto& hashers = table.hashers();
+    for (;;) {
+      lookup.reset(input.size());
+      bool rehash = false;
+      {
+        SelectivityTimer timer(run.hashTime, 0);
+        for (auto i = 0; i < hashers.size(); ++i) {
+          hashers[i]->decode(*input.childAt(hashers[i]->channel()), rows);
+          if (table.hashMode() != BaseHashTable::HashMode::kHash) {
+            if (!hashers[i]->computeValueIds(rows, lookup.hashes)) {
+              rehash = true;
+            }
+          } else {
+            hashers[i]->hash(rows, i > 0, lookup.hashes);
+          }
+        }
+      }
+      if (!rehash) {
+        break;
+      }
+      {
+        SelectivityTimer timer(run.decideTime, 0);
+        table.decideHashMode(input.size());
+      }
+      ++run.numDecideHashMode;
+      if (table.hashMode() != run.modes.back()) {
+        run.modes.push_back(table.hashMode());
+      }
+    }
+    lookup.rows.resize(input.size());
+    std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+    SelectivityTimer timer(run.probeTime, 0);
+    CacheMissTimer missTimer(cacheMisses);
+    table.groupProbe(lookup);
+  }
+
+  KeyType keyType_;
+  std::vector<TypePtr> keyTypes_;
+  int64_t keySpacing_{1};
+  raw_vector<uint64_t> dummyHashes_;
+  std::vector<DecodedVector> decoded_;
+};
+
+// Keeps the last result of each case. folly may run a case more than once.
+void addResult(
+    std::vector<std::pair<std::string, std::string>>& results,
+    std::string title,
+    std::string result) {
+  if (!results.empty() && results.back().first == title) {
+    results.back().second = std::move(result);
+    return;
+  }
+  results.emplace_back(std::move(title), std::move(result));
+}
+
+std::vector<int64_t> buildSizes() {
+  std::vector<int64_t> sizes;
+  for (int64_t size :
+       {1'000L,
+        64'000L,
+        1'000'000L,
+        16'000'000L,
+        128'000'000L,
+        1'000'000'000L}) {
+    if (size <= FLAGS_max_build_size) {
+      sizes.push_back(size);
+    }
+  }
+  return sizes;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  memory::MmapAllocator::Options options;
+  options.capacity = FLAGS_memory_capacity_gb << 30;
+  options.useMmapArena = true;
+  options.mmapArenaCapacityRatio = 1;
+
+  auto allocator = std::make_shared<memory::MmapAllocator>(options);
+  memory::MemoryAllocator::setDefaultInstance(allocator.get());
+  memory::MemoryManager::getInstance(memory::MemoryManagerOptions{
+      .capacity = static_cast<int64_t>(options.capacity),
+      .allocator = allocator.get()});
+
+  const auto keyTypes = parseList<KeyType>(FLAGS_key_types, keyTypeFromString);
+  const auto layouts =
+      parseList<KeyLayout>(FLAGS_key_layouts, keyLayoutFromString);
+  const auto hitPcts = parseList<int32_t>(
+      FLAGS_hit_pcts, [](const auto& pct) { return folly::to<int32_t>(pct); });
+  const auto duplicates =
+      parseList<Duplicates>(FLAGS_duplicates, duplicatesFromString);
+
+  auto bm = std::make_unique<HashTableSuiteBenchmark>();
+  std::vector<std::pair<std::string, std::string>> results;
+  for (auto size : buildSizes()) {
+    for (auto keyType : keyTypes) {
+      for (auto layout : layouts) {
+        for (auto hitPct : hitPcts) {
+          for (auto duplicate : duplicates) {
+            JoinCase joinCase{keyType, layout, size, hitPct, duplicate};
+            folly::addBenchmark(
+                __FILE__, joinCase.title(), [joinCase, &bm, &results]() {
+                  addResult(
+                      results,
+                      joinCase.title(),
+                      bm->runJoin(joinCase).toString());
+                  return 1;
+                });
+          }
+        }
+        GroupCase groupCase{keyType, layout, size};
+        folly::addBenchmark(
+            __FILE__, groupCase.title(), [groupCase, &bm, &results]() {
+              addResult(
+                  results,
+                  groupCase.title(),
+                  bm->runGroup(groupCase).toString());
+              return 1;
+            });
+      }
+    }
+  }
+  folly::runBenchmarks();
+  std::cout << "*** Results (clocks and cache misses per row):" << std::endl;
+  for (auto& [title, result] : results) {
+    std::cout << result << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/connectors/tpch/TpchConnector.h"
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/expression/Expr.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+DEFINE_int32(num_queries, 2'000, "Number of queries per benchmark");
+DEFINE_string(
+    concurrency,
+    "1,8,32",
+    "Comma separated numbers of clients running queries at the same time");
+DEFINE_int32(max_drivers, 1, "Number of Drivers per query");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+// Measures the fixed cost of running tiny queries, where the time goes to
+// setting up and tearing down the query rather than to processing data. Each
+// query is timed in phases:
+//
+//  queryCtx  - QueryCtx and its root memory pool.
+//  create    - Task::create.
+//  start     - Task::start: LocalPlanner, Driver factories, Drivers and
+//              operator construction.
+//  firstRow  - From start to the first output batch, including operator
+//              initialization, e.g. ExprSet compilation, and the first batch.
+//  finish    - From the first output batch to the end of the task.
+//  teardown  - Releasing the Task and the QueryCtx, including the pools.
+//  compile   - Compiling the expressions of the plan into an ExprSet once,
+//              outside of the query. Each FilterProject pays this at
+//              initialization.
+//
+// The queries run over a 100 row Values node or over the 25 rows of the
+// TPC-H nation table. Each client runs its share of the queries back to back.
+namespace {
+
+const std::string kTpchConnectorId = "test-tpch";
+
+enum Phase {
+  kQueryCtx,
+  kCreate,
+  kStart,
+  kFirstRow,
+  kFinish,
+  kTeardown,
+  kCompile,
+  kNumPhases
+};
+
+const char* const kPhaseNames[] = {
+    "queryCtx",
+    "create",
+    "start",
+    "firstRow",
+    "finish",
+    "teardown",
+    "compile"};
+
+uint64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct QueryCase {
+  std::string name;
+  core::PlanNodePtr plan;
+  // Id of the scan that takes a TPC-H split, empty for Values.
+  core::PlanNodeId scanId;
+  int64_t expectedRows;
+};
+
+class QueryLatencyBenchmark : public velox::test::VectorTestBase {
+ public:
+  QueryLatencyBenchmark() {
+    auto tpchConnector =
+        connector::getConnectorFactory(
+            connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+            ->newConnector(kTpchConnectorId, nullptr);
+    connector::registerConnector(tpchConnector);
+  }
+
+  ~QueryLatencyBenchmark() {
+    connector::unregisterConnector(kTpchConnectorId);
+  }
+
+  std::vector<QueryCase> makeQueries() {
+    std::vector<QueryCase> queries;
+    auto data = makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+         makeFlatVector<StringView>(100, [](auto row) {
+           return StringView(row % 2 ? "odd" : "even");
+         })});
+    queries.push_back(
+        {"values_filter_project",
+         PlanBuilder()
+             .values({data})
+             .filter("c0 % 3 = 1")
+             .project({"c0 + 1 AS a", "length(c1) * 2 AS b"})
+             .planNode(),
+         "",
+         33});
+    queries.push_back(
+        {"values_aggregation",
+         PlanBuilder()
+             .values({data})
+             .project({"c0 % 10 AS k", "c0"})
+             .singleAggregation({"k"}, {"sum(c0)", "count(1)"})
+             .planNode(),
+         "",
+         10});
+
+    core::PlanNodeId scanId;
+    queries.push_back(
+        {"tpch_nation_filter_project",
+         PlanBuilder()
+             .tableScan(
+                 tpch::Table::TBL_NATION,
+                 {"n_nationkey", "n_name", "n_regionkey"})
+             .capturePlanNodeId(scanId)
+             .filter("n_regionkey = 1")
+             .project({"n_nationkey * 2 AS k", "upper(n_name) AS name"})
+             .planNode(),
+         scanId,
+         5});
+    return queries;
+  }
+
+  // Runs FLAGS_num_queries instances of 'query', 'concurrency' at a time, and
+  // returns the nanoseconds spent in each phase by each query.
+  std::vector<std::vector<uint64_t>> run(
+      const QueryCase& query,
+      int32_t concurrency) {
+    std::vector<std::vector<uint64_t>> timings(kNumPhases);
+    std::mutex mutex;
+    std::vector<std::thread> clients;
+    const auto queriesPerClient = FLAGS_num_queries / concurrency;
+    for (auto client = 0; client < concurrency; ++client) {
+      clients.emplace_back([&, client]() {
+        std::vector<std::vector<uint64_t>> clientTimings(kNumPhases);
+        for (auto i = 0; i < queriesPerClient; ++i) {
+          runQuery(
+              query,
+              fmt::format("latency.{}.{}.{}", query.name, client, i),
+              clientTimings);
+        }
+        time(kCompile, clientTimings, [&]() { compile(query.plan); });
+        std::lock_guard<std::mutex> l(mutex);
+        for (auto phase = 0; phase < kNumPhases; ++phase) {
+          timings[phase].insert(
+              timings[phase].end(),
+              clientTimings[phase].begin(),
+              clientTimings[phase].end());
+        }
+      });
+    }
+    for (auto& client : clients) {
+      client.join();
+    }
+    return timings;
+  }
+
+ private:
+  template <typename F>
+  static void
+  time(Phase phase, std::vector<std::vector<uint64_t>>& timings, F func) {
+    const auto start = nowNanos();
+    func();
+    timings[phase].push_back(nowNanos() - start);
+  }
+
+  void runQuery(
+      const QueryCase& query,
+      const std::string& taskId,
+      std::vector<std::vector<uint64_t>>& timings) {
+    std::shared_ptr<core::QueryCtx> queryCtx;
+    time(kQueryCtx, timings, [&]() {
+      queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    });
+
+    std::atomic<uint64_t> firstRowNanos{0};
+    std::atomic<int64_t> numRows{0};
+    std::shared_ptr<Task> task;
+    time(kCreate, timings, [&]() {
+      task = Task::create(
+          taskId,
+          core::PlanFragment{query.plan},
+          0,
+          queryCtx,
+          [&](RowVectorPtr vector, ContinueFuture* /*future*/) {
+            if (vector != nullptr) {
+              uint64_t expected = 0;
+              firstRowNanos.compare_exchange_strong(expected, nowNanos());
+              numRows += vector->size();
+            }
+            return BlockingReason::kNotBlocked;
+          });
+    });
+
+    const auto startNanos = nowNanos();
+    task->start(FLAGS_max_drivers);
+    timings[kStart].push_back(nowNanos() - startNanos);
+    if (!query.scanId.empty()) {
+      task->addSplit(
+          query.scanId,
+          Split(std::make_shared<connector::tpch::TpchConnectorSplit>(
+              kTpchConnectorId, 1, 0)));
+      task->noMoreSplits(query.scanId);
+    }
+    VELOX_CHECK(waitForTaskCompletion(task.get(), 10'000'000));
+    const auto finishNanos = nowNanos();
+    VELOX_CHECK_EQ(numRows, query.expectedRows);
+    timings[kFirstRow].push_back(firstRowNanos - startNanos);
+    timings[kFinish].push_back(finishNanos - firstRowNanos);
+
+    time(kTeardown, timings, [&]() {
+      task.reset();
+      queryCtx.reset();
+    });
+  }
+
+  // Compiles the filters and projections of 'plan' the way a FilterProject
+  // does.
+  void compile(const core::PlanNodePtr& plan) {
+    std::vector<core::TypedExprPtr> exprs;
+    collectExprs(plan, exprs);
+    auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    auto pool = queryCtx->pool()->addLeafChild("compile");
+    core::ExecCtx execCtx(pool.get(), queryCtx.get());
+    ExprSet exprSet(exprs, &execCtx);
+  }
+
+  static void collectExprs(
+      const core::PlanNodePtr& node,
+      std::vector<core::TypedExprPtr>& exprs) {
+    if (auto filter = std::dynamic_pointer_cast<const core::FilterNode>(node)) {
+      exprs.push_back(filter->filter());
+    } else if (
+        auto project =
+            std::dynamic_pointer_cast<const core::ProjectNode>(node)) {
+      exprs.insert(
+          exprs.end(),
+          project->projections().begin(),
+          project->projections().end());
+    }
+    for (const auto& source : node->sources()) {
+      collectExprs(source, exprs);
+    }
+  }
+
+  std::unique_ptr<folly::Executor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::thread::hardware_concurrency())};
+};
+
+// Returns the mean, median and 99th percentile of 'nanos'.
+std::string summarize(std::vector<uint64_t>& nanos) {
+  if (nanos.empty()) {
+    return "-";
+  }
+  std::sort(nanos.begin(), nanos.end());
+  uint64_t sum = 0;
+  for (auto value : nanos) {
+    sum += value;
+  }
+  return fmt::format(
+      "avg {} p50 {} p99 {}",
+      succinctNanos(sum / nanos.size()),
+      succinctNanos(nanos[nanos.size() / 2]),
+      succinctNanos(nanos[(nanos.size() - 1) * 99 / 100]));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+
+  std::vector<std::string> concurrencies;
+  folly::split(',', FLAGS_concurrency, concurrencies);
+
+  auto bm = std::make_unique<QueryLatencyBenchmark>();
+  const auto queries = bm->makeQueries();
+  std::vector<std::string> results;
+  for (const auto& query : queries) {
+    for (const auto& concurrencyText : concurrencies) {
+      const auto concurrency = folly::to<int32_t>(concurrencyText);
+      const auto name = fmt::format("{}_clients_{}", query.name, concurrency);
+      folly::addBenchmark(
+          __FILE__, name, [&bm, &results, &query, name, concurrency]() {
+            const auto start = nowNanos();
+            auto timings = bm->run(query, concurrency);
+            const auto wallNanos = nowNanos() - start;
+            const auto numQueries = timings[kQueryCtx].size();
+            std::string result = fmt::format(
+                "{}: {} queries/s",
+                name,
+                numQueries * 1'000'000'000 / std::max<uint64_t>(wallNanos, 1));
+            for (auto phase = 0; phase < kNumPhases; ++phase) {
+              result += fmt::format(
+                  "\n  {}: {}", kPhaseNames[phase], summarize(timings[phase]));
+            }
+            results.push_back(std::move(result));
+            return 1;
+          });
+    }
+  }
+  folly::runBenchmarks();
+  std::cout << "*** Results (latency per query and phase):" << std::endl;
+  for (const auto& result : results) {
+    std::cout << result << std::endl;
+  }
+  return 0;
+}
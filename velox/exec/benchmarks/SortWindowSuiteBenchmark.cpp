@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/SortBuffer.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+DEFINE_int64(num_rows, 1'000'000, "Number of input rows per case");
+DEFINE_string(
+    key_types,
+    "bigint,varchar,bigint_varchar",
+    "Comma separated sort key types to run: bigint, varchar, bigint_varchar "
+    "(a bigint and a varchar key)");
+DEFINE_string(
+    cardinalities,
+    "1000,1000000",
+    "Comma separated numbers of distinct values of the first sort key");
+DEFINE_int64(
+    num_partitions,
+    1'000,
+    "Number of distinct partition keys for Window and TopNRowNumber");
+DEFINE_int32(topn_limit, 100, "Limit of the TopN and TopNRowNumber cases");
+DEFINE_string(
+    row_frame_sizes,
+    "1,100,10000",
+    "Comma separated sizes of the 'n PRECEDING' ROWS frames");
+DEFINE_string(
+    merge_fan_ins,
+    "2,16,128",
+    "Comma separated numbers of sorted LocalMerge sources");
+DEFINE_bool(
+    spill,
+    true,
+    "Also run OrderBy, TopNRowNumber and SortBuffer with spilling forced on "
+    "every input");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::test;
+
+namespace {
+
+constexpr vector_size_t kBatchSize = 10'000;
+
+enum class KeyType { kBigint, kVarchar, kBigintVarchar };
+
+KeyType keyTypeFromString(const std::string& name) {
+  if (name == "bigint") {
+    return KeyType::kBigint;
+  }
+  if (name == "varchar") {
+    return KeyType::kVarchar;
+  }
+  if (name == "bigint_varchar") {
+    return KeyType::kBigintVarchar;
+  }
+  VELOX_USER_FAIL("Unknown key type: {}", name);
+}
+
+std::string keyTypeString(KeyType type) {
+  switch (type) {
+    case KeyType::kBigint:
+      return "bigint";
+    case KeyType::kVarchar:
+      return "varchar";
+    case KeyType::kBigintVarchar:
+      return "bigint_varchar";
+  }
+  VELOX_UNREACHABLE();
+}
+
+std::string sizeString(int64_t size) {
+  if (size >= 1'000'000 && size % 1'000'000 == 0) {
+    return fmt::format("{}M", size / 1'000'000);
+  }
+  if (size >= 1'000 && size % 1'000 == 0) {
+    return fmt::format("{}K", size / 1'000);
+  }
+  return fmt::format("{}", size);
+}
+
+template <typename T, typename F>
+std::vector<T> parseList(const std::string& flag, F fromString) {
+  std::vector<std::string> names;
+  folly::split(',', flag, names, true);
+  std::vector<T> result;
+  for (const auto& name : names) {
+    result.push_back(fromString(name));
+  }
+  return result;
+}
+
+int64_t toInt64(const std::string& value) {
+  return folly::to<int64_t>(value);
+}
+
+// Input of the cases of one key type and cardinality. The columns are 'p'
+// (partition key), 'k0' and, for kBigintVarchar, 'k1' (sort keys) and 'v'
+// (payload).
+struct Dataset {
+  KeyType keyType;
+  int64_t cardinality;
+  std::vector<RowVectorPtr> batches;
+  std::vector<std::string> sortingKeys;
+
+  std::string title() const {
+    return fmt::format(
+        "{}_{}", keyTypeString(keyType), sizeString(cardinality));
+  }
+};
+
+struct Run {
+  std::string title;
+  int64_t numRows{0};
+  uint64_t wallMicros{0};
+  uint64_t peakBytes{0};
+  uint64_t spilledBytes{0};
+
+  std::string toString() const {
+    return fmt::format(
+        "{}: rows={} rows/s={:.0f} peak memory={} spilled={}",
+        title,
+        numRows,
+        wallMicros ? numRows * 1'000'000.0 / wallMicros : 0.0,
+        succinctBytes(peakBytes),
+        succinctBytes(spilledBytes));
+  }
+};
+
+// Benchmark suite for the sort based operators. Runs OrderBy, TopN,
+// TopNRowNumber and SortBuffer with and without spilling, Window with ROWS
+// frames of varying size and with RANGE frames, and LocalMerge with varying
+// fan-in, over sort keys of different types and cardinalities. Reports the
+// rows per second of wall time and the peak memory and spilled bytes of the
+// benchmarked operator.
+class SortWindowSuiteBenchmark : public VectorTestBase {
+ public:
+  Dataset makeDataset(KeyType keyType, int64_t cardinality) {
+    Dataset dataset{keyType, cardinality};
+    dataset.sortingKeys = keyType == KeyType::kBigintVarchar
+        ? std::vector<std::string>{"k0", "k1"}
+        : std::vector<std::string>{"k0"};
+    dataset.batches = makeBatches(keyType, cardinality, FLAGS_num_rows);
+    return dataset;
+  }
+
+  Run runOrderBy(const Dataset& dataset, bool spill) {
+    core::PlanNodeId nodeId;
+    auto plan = PlanBuilder()
+                    .values(dataset.batches)
+                    .orderBy(dataset.sortingKeys, false)
+                    .capturePlanNodeId(nodeId)
+                    .planNode();
+    return runPlan(
+        caseTitle("order_by", dataset, spill), plan, nodeId, spill);
+  }
+
+  Run runTopN(const Dataset& dataset) {
+    core::PlanNodeId nodeId;
+    auto plan = PlanBuilder()
+                    .values(dataset.batches)
+                    .topN(dataset.sortingKeys, FLAGS_topn_limit, false)
+                    .capturePlanNodeId(nodeId)
+                    .planNode();
+    return runPlan(caseTitle("topn", dataset, false), plan, nodeId, false);
+  }
+
+  Run runTopNRowNumber(const Dataset& dataset, bool spill) {
+    core::PlanNodeId nodeId;
+    auto plan = PlanBuilder()
+                    .values(dataset.batches)
+                    .topNRowNumber(
+                        {"p"}, dataset.sortingKeys, FLAGS_topn_limit, true)
+                    .capturePlanNodeId(nodeId)
+                    .planNode();
+    return runPlan(
+        caseTitle("topn_row_number", dataset, spill), plan, nodeId, spill);
+  }
+
+  // 'frame' is the frame clause of a sum() over the partitions of 'p'.
+  Run runWindow(
+      const Dataset& dataset,
+      const std::string& frameTitle,
+      const std::string& frame) {
+    core::PlanNodeId nodeId;
+    auto plan = PlanBuilder()
+                    .values(dataset.batches)
+                    .window({fmt::format(
+                        "sum(v) over (partition by p order by {} {}) as w",
+                        folly::join(", ", dataset.sortingKeys),
+                        frame)})
+                    .capturePlanNodeId(nodeId)
+                    .planNode();
+    return runPlan(
+        caseTitle(fmt::format("window_{}", frameTitle), dataset, false),
+        plan,
+        nodeId,
+        false);
+  }
+
+  Run runLocalMerge(const Dataset& dataset, int32_t fanIn) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<core::PlanNodePtr> sources;
+    const auto rowsPerSource = FLAGS_num_rows / fanIn;
+    for (auto i = 0; i < fanIn; ++i) {
+      auto batches =
+          makeBatches(dataset.keyType, dataset.cardinality, rowsPerSource);
+      sources.push_back(PlanBuilder(planNodeIdGenerator)
+                            .values(sort(batches, dataset.sortingKeys))
+                            .planNode());
+    }
+    core::PlanNodeId nodeId;
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .localMerge(dataset.sortingKeys, std::move(sources))
+                    .capturePlanNodeId(nodeId)
+                    .planNode();
+    return runPlan(
+        caseTitle(fmt::format("local_merge_{}", fanIn), dataset, false),
+        plan,
+        nodeId,
+        false);
+  }
+
+  Run runSortBuffer(const Dataset& dataset, bool spill) {
+    Run run;
+    run.title = caseTitle("sort_buffer", dataset, spill);
+    const auto& inputType = asRowType(dataset.batches[0]->type());
+    std::vector<column_index_t> sortColumnIndices;
+    std::vector<CompareFlags> sortCompareFlags;
+    for (const auto& key : dataset.sortingKeys) {
+      sortColumnIndices.push_back(inputType->getChildIdx(key));
+      sortCompareFlags.push_back(
+          {true, true, false, CompareFlags::NullHandlingMode::NoStop});
+    }
+
+    auto spillDirectory = TempDirectoryPath::create();
+    const common::SpillConfig spillConfig(
+        makeOperatorSpillPath(spillDirectory->path, 0, 0, 0),
+        0,
+        0,
+        0,
+        executor_.get(),
+        5,
+        10,
+        0,
+        0,
+        0,
+        0,
+        100,
+        "none");
+    auto pool = rootPool_->addLeafChild("sortBuffer");
+    tsan_atomic<bool> nonReclaimableSection{false};
+    uint32_t numSpillRuns{0};
+    const auto start = getCurrentTimeMicro();
+    {
+      SortBuffer sortBuffer(
+          inputType,
+          sortColumnIndices,
+          sortCompareFlags,
+          kBatchSize,
+          pool.get(),
+          &nonReclaimableSection,
+          &numSpillRuns,
+          spill ? &spillConfig : nullptr);
+      for (const auto& batch : dataset.batches) {
+        sortBuffer.addInput(batch);
+        run.numRows += batch->size();
+      }
+      sortBuffer.noMoreInput();
+      while (sortBuffer.getOutput() != nullptr) {
+      }
+      if (auto stats = sortBuffer.spilledStats()) {
+        run.spilledBytes = stats->spilledBytes;
+      }
+    }
+    run.wallMicros = getCurrentTimeMicro() - start;
+    run.peakBytes = pool->peakBytes();
+    return run;
+  }
+
+ private:
+  static std::string
+  caseTitle(const std::string& name, const Dataset& dataset, bool spill) {
+    return fmt::format(
+        "{}_{}{}", name, dataset.title(), spill ? "_spill" : "");
+  }
+
+  std::vector<RowVectorPtr>
+  makeBatches(KeyType keyType, int64_t cardinality, int64_t numRows) {
+    std::vector<RowVectorPtr> batches;
+    std::string temp;
+    for (int64_t start = 0; start < numRows; start += kBatchSize) {
+      const auto size = std::min<int64_t>(kBatchSize, numRows - start);
+      std::vector<std::string> names = {"p", "k0"};
+      std::vector<VectorPtr> children = {makeFlatVector<int64_t>(
+          size,
+          [&](auto /*row*/) {
+            return folly::Random::rand64(rng_) % FLAGS_num_partitions;
+          })};
+      auto key = [&]() { return folly::Random::rand64(rng_) % cardinality; };
+      if (keyType == KeyType::kVarchar) {
+        children.push_back(makeFlatVector<StringView>(size, [&](auto /*row*/) {
+          temp = fmt::format("key-{}", key());
+          return StringView(temp);
+        }));
+      } else {
+        children.push_back(makeFlatVector<int64_t>(
+            size, [&](auto /*row*/) { return key(); }));
+      }
+      if (keyType == KeyType::kBigintVarchar) {
+        names.push_back("k1");
+        children.push_back(makeFlatVector<StringView>(size, [&](auto /*row*/) {
+          temp = fmt::format("value-{}", folly::Random::rand32(rng_) % 100);
+          return StringView(temp);
+        }));
+      }
+      names.push_back("v");
+      children.push_back(makeFlatVector<int64_t>(
+          size, [&](auto /*row*/) { return folly::Random::rand64(rng_); }));
+      batches.push_back(makeRowVector(names, children));
+    }
+    return batches;
+  }
+
+  // Returns 'batches' sorted on 'keys' in batches of kBatchSize rows.
+  std::vector<RowVectorPtr> sort(
+      const std::vector<RowVectorPtr>& batches,
+      const std::vector<std::string>& keys) {
+    auto plan = PlanBuilder().values(batches).orderBy(keys, false).planNode();
+    auto sorted = AssertQueryBuilder(plan).copyResults(pool_.get());
+    std::vector<RowVectorPtr> result;
+    for (vector_size_t start = 0; start < sorted->size(); start += kBatchSize) {
+      result.push_back(std::static_pointer_cast<RowVector>(sorted->slice(
+          start, std::min<vector_size_t>(kBatchSize, sorted->size() - start))));
+    }
+    return result;
+  }
+
+  Run runPlan(
+      const std::string& title,
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& nodeId,
+      bool spill) {
+    Run run;
+    run.title = title;
+    auto spillDirectory = TempDirectoryPath::create();
+    CursorParameters params;
+    params.planNode = plan;
+    params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    if (spill) {
+      params.queryCtx->testingOverrideConfigUnsafe({
+          {core::QueryConfig::kSpillEnabled, "true"},
+          {core::QueryConfig::kOrderBySpillEnabled, "true"},
+          {core::QueryConfig::kTopNRowNumberSpillEnabled, "true"},
+          {core::QueryConfig::kTestingSpillPct, "100"},
+      });
+      params.spillDirectory = spillDirectory->path;
+    }
+
+    const auto start = getCurrentTimeMicro();
+    auto cursor = std::make_unique<TaskCursor>(params);
+    while (cursor->moveNext()) {
+    }
+    auto task = cursor->task();
+    waitForTaskCompletion(task.get());
+    run.wallMicros = getCurrentTimeMicro() - start;
+
+    const auto stats = toPlanStats(task->taskStats());
+    const auto& nodeStats = stats.at(nodeId);
+    run.numRows = nodeStats.inputRows;
+    run.peakBytes = nodeStats.peakMemoryBytes;
+    run.spilledBytes = nodeStats.spilledBytes;
+    return run;
+  }
+
+  std::shared_ptr<memory::MemoryPool> rootPool_{
+      memory::defaultMemoryManager().addRootPool("SortWindowSuiteBenchmark")};
+  std::unique_ptr<folly::Executor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::thread::hardware_concurrency())};
+  folly::Random::DefaultGenerator rng_{1};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  parse::registerTypeResolver();
+  filesystems::registerLocalFileSystem();
+  serializer::presto::PrestoVectorSerde::registerVectorSerde();
+
+  const auto keyTypes = parseList<KeyType>(FLAGS_key_types, keyTypeFromString);
+  const auto cardinalities = parseList<int64_t>(FLAGS_cardinalities, toInt64);
+  const auto rowFrameSizes =
+      parseList<int64_t>(FLAGS_row_frame_sizes, toInt64);
+  const auto fanIns = parseList<int64_t>(FLAGS_merge_fan_ins, toInt64);
+  std::vector<bool> spillModes = {false};
+  if (FLAGS_spill) {
+    spillModes.push_back(true);
+  }
+
+  auto bm = std::make_unique<SortWindowSuiteBenchmark>();
+  std::vector<std::unique_ptr<Dataset>> datasets;
+  std::vector<std::string> results;
+  auto add = [&](const std::string& title, std::function<Run()> run) {
+    folly::addBenchmark(__FILE__, title, [run, &results]() {
+      results.push_back(run().toString());
+      return 1;
+    });
+  };
+  for (auto keyType : keyTypes) {
+    for (auto cardinality : cardinalities) {
+      datasets.push_back(
+          std::make_unique<Dataset>(bm->makeDataset(keyType, cardinality)));
+      const auto* dataset = datasets.back().get();
+      const auto title = dataset->title();
+      for (auto spill : spillModes) {
+        const std::string suffix = spill ? "_spill" : "";
+        add("order_by_" + title + suffix,
+            [&, dataset, spill]() { return bm->runOrderBy(*dataset, spill); });
+        add("topn_row_number_" + title + suffix, [&, dataset, spill]() {
+          return bm->runTopNRowNumber(*dataset, spill);
+        });
+        add("sort_buffer_" + title + suffix, [&, dataset, spill]() {
+          return bm->runSortBuffer(*dataset, spill);
+        });
+      }
+      add("topn_" + title, [&, dataset]() { return bm->runTopN(*dataset); });
+      for (auto size : rowFrameSizes) {
+        const auto frameTitle = fmt::format("rows{}", sizeString(size));
+        add(fmt::format("window_{}_{}", frameTitle, title),
+            [&, dataset, frameTitle, size]() {
+              return bm->runWindow(
+                  *dataset,
+                  frameTitle,
+                  fmt::format(
+                      "rows between {} preceding and current row", size));
+            });
+      }
+      add("window_range_" + title, [&, dataset]() {
+        return bm->runWindow(
+            *dataset,
+            "range",
+            "range between unbounded preceding and current row");
+      });
+      for (auto fanIn : fanIns) {
+        add(fmt::format("local_merge_{}_{}", fanIn, title),
+            [&, dataset, fanIn]() {
+              return bm->runLocalMerge(*dataset, fanIn);
+            });
+      }
+    }
+  }
+  folly::runBenchmarks();
+  std::cout << "*** Results (rows per second of wall time, peak memory and "
+               "spilled bytes of the benchmarked operator):"
+            << std::endl;
+  for (const auto& result : results) {
+    std::cout << result << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/tpch/TpchConnector.h"
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+DEFINE_int32(num_splits, 20'000, "Number of splits per query");
+DEFINE_string(
+    num_drivers,
+    "1,8,32,64",
+    "Comma separated numbers of Drivers of the scan");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+// Measures the contention of the Drivers of one Task on taking splits and
+// updating the split stats. The scan is of the 25 rows of the TPC-H nation
+// table divided into many splits, so that most splits are empty and the time
+// goes to taking and finishing splits.
+namespace {
+
+const std::string kTpchConnectorId = "test-tpch";
+
+class TaskSplitBenchmark {
+ public:
+  TaskSplitBenchmark() {
+    auto tpchConnector =
+        connector::getConnectorFactory(
+            connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+            ->newConnector(kTpchConnectorId, nullptr);
+    connector::registerConnector(tpchConnector);
+  }
+
+  ~TaskSplitBenchmark() {
+    connector::unregisterConnector(kTpchConnectorId);
+  }
+
+  // Returns the nanoseconds of wall time per split.
+  uint64_t run(int32_t numDrivers) {
+    CursorParameters params;
+    params.planNode = PlanBuilder()
+                          .tableScan(tpch::Table::TBL_NATION, {"n_nationkey"})
+                          .planNode();
+    params.maxDrivers = numDrivers;
+    params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+
+    const auto start = getCurrentTimeMicro();
+    auto [cursor, results] = readCursor(params, [&](Task* task) {
+      for (auto i = 0; i < FLAGS_num_splits; ++i) {
+        task->addSplit(
+            "0",
+            Split(std::make_shared<connector::tpch::TpchConnectorSplit>(
+                kTpchConnectorId, FLAGS_num_splits, i)));
+      }
+      task->noMoreSplits("0");
+    });
+    const auto wallMicros = getCurrentTimeMicro() - start;
+
+    int64_t numRows = 0;
+    for (const auto& result : results) {
+      numRows += result->size();
+    }
+    VELOX_CHECK_EQ(numRows, 25);
+    VELOX_CHECK_EQ(
+        cursor->task()->taskStats().numFinishedSplits, FLAGS_num_splits);
+    return wallMicros * 1'000 / FLAGS_num_splits;
+  }
+
+ private:
+  std::unique_ptr<folly::Executor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(
+          std::thread::hardware_concurrency())};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  std::vector<std::string> driverCounts;
+  folly::split(',', FLAGS_num_drivers, driverCounts);
+
+  auto bm = std::make_unique<TaskSplitBenchmark>();
+  std::vector<std::string> results;
+  for (const auto& driverCount : driverCounts) {
+    const auto numDrivers = folly::to<int32_t>(driverCount);
+    folly::addBenchmark(
+        __FILE__,
+        fmt::format("drivers_{}", numDrivers),
+        [&bm, &results, numDrivers]() {
+          const auto nanosPerSplit = bm->run(numDrivers);
+          results.push_back(fmt::format(
+              "drivers_{}: {} per split",
+              numDrivers,
+              succinctNanos(nanosPerSplit)));
+          return 1;
+        });
+  }
+  folly::runBenchmarks();
+  std::cout << "*** Results (wall time per split):" << std::endl;
+  for (const auto& result : results) {
+    std::cout << result << std::endl;
+  }
+  return 0;
+}
@@ -585,6 +585,102 @@ TEST_F(AggregationTest, global) {
   EXPECT_EQ(NonPODInt64::constructed, NonPODInt64::destructed);
 }
 
+TEST_F(AggregationTest, sharedTables) {
+  // Each driver reads all of the input. Without a local exchange the groups
+  // are only correct if the drivers aggregate into shared tables.
+  constexpr int32_t kNumDrivers = 4;
+  auto vectors = makeVectors(rowType_, 1'000, 10);
+  vectors.push_back(makeRowVector(
+      rowType_->names(),
+      {makeFlatVector<int64_t>(100, [](auto row) { return row % 3; }),
+       makeFlatVector<int16_t>(100, [](auto row) { return row; }),
+       makeFlatVector<int32_t>(100, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+       makeFlatVector<float>(100, [](auto row) { return row; }),
+       makeFlatVector<double>(100, [](auto row) { return row; }),
+       makeFlatVector<StringView>(100, [](auto row) {
+         return StringView::makeInline(fmt::format("{}", row % 3));
+       })}));
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  for (const auto& key : {"c0", "c6"}) {
+    SCOPED_TRACE(key);
+    const auto duckDbSql = fmt::format(
+        "SELECT {0}, sum(c1), count(c2), max(c5) FROM tmp GROUP BY {0}", key);
+    auto single = PlanBuilder()
+                      .values(vectors, true)
+                      .singleAggregation(
+                          {key}, {"sum(c1)", "count(c2)", "max(c5)"})
+                      .planNode();
+    auto partialFinal = PlanBuilder()
+                            .values(vectors, true)
+                            .partialAggregation(
+                                {key}, {"sum(c1)", "count(c2)", "max(c5)"})
+                            .finalAggregation()
+                            .planNode();
+    for (const auto& plan : {single, partialFinal}) {
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(QueryConfig::kHashAggregationSharedTablesEnabled, "true")
+          .maxDrivers(kNumDrivers)
+          .assertResults(duckDbSql);
+    }
+  }
+}
+
+TEST_F(AggregationTest, denseGroups) {
+  // A few distinct keys make an array mode hash table small enough for the
+  // aggregates to accumulate raw input per dense group id.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    const vector_size_t size = 1'000;
+    auto indices = makeIndices(size, [](auto row) { return (row * 7) % 100; });
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return (row + i) % 17; }, nullEvery(101)),
+        makeFlatVector<int32_t>(
+            size, [](auto row) { return row; }, nullEvery(7)),
+        makeFlatVector<double>(size, [](auto row) { return row * 0.25; }),
+        makeConstant<int64_t>(i, size),
+        wrapInDictionary(
+            indices,
+            size,
+            makeFlatVector<int16_t>(
+                100, [](auto row) { return row - 50; }, nullEvery(11))),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::string> aggregates = {
+      "sum(c1)",
+      "count(c1)",
+      "count(1)",
+      "avg(c2)",
+      "min(c1)",
+      "max(c2)",
+      "sum(c3)",
+      "max(c4)",
+      "avg(c4)",
+      "count(c4)"};
+  const auto duckDbSql = fmt::format(
+      "SELECT c0, {} FROM tmp GROUP BY c0", folly::join(", ", aggregates));
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation({"c0"}, aggregates)
+                  .planNode();
+  assertQuery(plan, duckDbSql);
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .partialAggregation({"c0"}, aggregates)
+             .finalAggregation()
+             .planNode();
+  assertQuery(plan, duckDbSql);
+}
+
 TEST_F(AggregationTest, singleBigintKey) {
   auto vectors = makeVectors(rowType_, 10, 100);
   createDuckDbTable(vectors);
@@ -893,6 +989,51 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationResume) {
+  std::vector<RowVectorPtr> vectors;
+  // Unique keys abandon the partial aggregation after the 2nd batch.
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+        100, [&](auto row) { return i * 100 + row; })}));
+  }
+  // Repeating keys resume the partial aggregation once 200 rows have passed
+  // through and the next 100 rows have been sampled.
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(100, [](auto row) { return row % 5; })}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto resampleRows : {"0", "200"}) {
+    SCOPED_TRACE(fmt::format("resampleRows: {}", resampleRows));
+    core::PlanNodeId partialAggId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, "100")
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, "50")
+            .config(
+                QueryConfig::kAbandonPartialAggregationResampleRows,
+                resampleRows)
+            .config("max_drivers_per_task", "1")
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"sum(c0)", "count(1)"})
+                      .capturePlanNodeId(partialAggId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults(
+                "SELECT c0, sum(c0), count(1) FROM tmp GROUP BY c0");
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(partialAggId).customStats;
+    ASSERT_EQ(runtimeStats.at("abandonedPartialAggregation").count, 1);
+    if (std::string(resampleRows) == "0") {
+      ASSERT_EQ(runtimeStats.count("resumedPartialAggregation"), 0);
+    } else {
+      ASSERT_EQ(runtimeStats.at("resumedPartialAggregation").count, 1);
+    }
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -942,6 +1083,36 @@ TEST_F(AggregationTest, largeValueRangeArray) {
   EXPECT_EQ(1, stats.at(finalAggId).inputVectors);
 }
 
+TEST_F(AggregationTest, estimatedNumGroups) {
+  constexpr int32_t kNumBatches = 10;
+  constexpr int32_t kBatchSize = 10'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize,
+        [&](auto row) { return (i * kBatchSize + row) * 1'000'003L; })}));
+  }
+  createDuckDbTable(vectors);
+
+  auto testRehashes = [&](std::optional<int64_t> estimatedNumGroups) {
+    core::PlanNodeId aggId;
+    PlanBuilder builder;
+    builder.values(vectors).singleAggregation({"c0"}, {"count(1)"});
+    if (estimatedNumGroups.has_value()) {
+      builder.estimatedNumGroups(estimatedNumGroups.value());
+    }
+    auto plan = builder.capturePlanNodeId(aggId).planNode();
+    auto task = assertQuery(plan, "SELECT c0, count(1) FROM tmp GROUP BY 1");
+    auto runtimeStats = toPlanStats(task->taskStats()).at(aggId).customStats;
+    EXPECT_EQ(1, runtimeStats.count("hashtable.rehashTime"));
+    return runtimeStats.at("hashtable.numRehashes").sum;
+  };
+
+  // A table sized for all groups up front rehashes less than one that grows
+  // from the default size.
+  EXPECT_LT(testRehashes(kNumBatches * kBatchSize), testRehashes(std::nullopt));
+}
+
 TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   constexpr int64_t kGB = 1 << 30;
   constexpr int64_t kB = 1 << 10;
@@ -1311,6 +1482,34 @@ TEST_F(AggregationTest, groupingSets) {
   assertQuery(
       plan,
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
+
+  // Rollup and cube, accumulating the raw input only once at the finest
+  // grouping.
+  plan = PlanBuilder()
+             .values({data})
+             .groupingSetsAggregation(
+                 {"k1", "k2"},
+                 {{"k1", "k2"}, {"k1"}, {}},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"})
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
+
+  plan = PlanBuilder()
+             .values({data})
+             .groupingSetsAggregation(
+                 {"k1", "k2"},
+                 {{"k1", "k2"}, {"k1"}, {"k2"}, {}},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"})
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY CUBE (k1, k2)");
 }
 
 TEST_F(AggregationTest, groupingSetsOutput) {
@@ -1797,16 +1996,17 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
           .config(QueryConfig::kTestingSpillPct, "100")
           .plan(PlanBuilder()
                     .values(vectors)
-                    .singleAggregation({"c1"}, {"count(DISTINCT c0)"}, {})
+                    .singleAggregation(
+                        {"c1"}, {"count(DISTINCT c0)", "sum(DISTINCT c2)"}, {})
                     .capturePlanNodeId(aggrNodeId)
                     .planNode())
-          .assertResults("SELECT c1, count(DISTINCT c0) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
+          .assertResults(
+              "SELECT c1, count(DISTINCT c0), sum(DISTINCT c2) FROM tmp GROUP BY c1");
   const auto& queryConfig = task->queryCtx()->queryConfig();
   ASSERT_TRUE(queryConfig.spillEnabled());
   ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
   ASSERT_EQ(100, queryConfig.testingSpillPct());
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
@@ -1823,17 +2023,20 @@ TEST_F(AggregationTest, spillingForAggrsWithSorting) {
           .config(QueryConfig::kTestingSpillPct, "100")
           .plan(PlanBuilder()
                     .values(vectors)
-                    .singleAggregation({"c1"}, {"count(c0 ORDER BY c2)"}, {})
+                    .singleAggregation(
+                        {"c1"},
+                        {"count(c0 ORDER BY c2)", "array_agg(c0 ORDER BY c2)"},
+                        {})
                     .capturePlanNodeId(aggrNodeId)
                     .planNode())
           .assertResults(
-              "SELECT c1, count(c0 ORDER BY c2) FROM tmp GROUP BY c1");
-  // Verify that spilling is not triggered.
+              "SELECT c1, count(c0 ORDER BY c2), array_agg(c0 ORDER BY c2) "
+              "FROM tmp GROUP BY c1");
   const auto& queryConfig = task->queryCtx()->queryConfig();
   ASSERT_TRUE(queryConfig.spillEnabled());
   ASSERT_TRUE(queryConfig.aggregationSpillEnabled());
   ASSERT_EQ(100, queryConfig.testingSpillPct());
-  ASSERT_EQ(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
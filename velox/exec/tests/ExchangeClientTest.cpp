@@ -224,6 +224,130 @@ TEST_F(ExchangeClientTest, flowControl) {
   }
 }
 
+// Exchange source that records the requested bytes and responds on demand.
+class TestingExchangeSource : public ExchangeSource {
+ public:
+  TestingExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool) {}
+
+  bool supportsFlowControlV2() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override {
+    if (atEnd_ || requestPending_) {
+      return false;
+    }
+    requestPending_ = true;
+    return true;
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      uint32_t /*maxWaitSeconds*/) override {
+    requestedBytes.push_back(maxBytes);
+    promise_ = VeloxPromise<Response>("TestingExchangeSource::request");
+    return promise_.getSemiFuture();
+  }
+
+  // Responds to the pending request with a page of 'bytes'.
+  void respond(int64_t bytes) {
+    std::vector<ContinuePromise> promises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      auto ioBuf = folly::IOBuf::create(bytes);
+      ioBuf->append(bytes);
+      queue_->enqueueLocked(
+          std::make_unique<SerializedPage>(std::move(ioBuf)), promises);
+      requestPending_ = false;
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    promise_.setValue(Response{bytes, false});
+  }
+
+  void close() override {}
+
+  folly::F14FastMap<std::string, int64_t> stats() const override {
+    return {};
+  }
+
+  std::vector<uint32_t> requestedBytes;
+
+ private:
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+};
+
+// Verifies that requests are sized by the free queue budget and that the
+// budget of pending requests is not given out twice.
+TEST_F(ExchangeClientTest, sourceCredit) {
+  std::vector<std::shared_ptr<TestingExchangeSource>> sources;
+  ExchangeSource::factories().clear();
+  ExchangeSource::registerFactory(
+      [&](const auto& taskId, auto destination, auto queue, auto pool) {
+        sources.push_back(std::make_shared<TestingExchangeSource>(
+            taskId, destination, queue, pool));
+        return sources.back();
+      });
+
+  ExchangeClient client("credit", 17, pool(), 10'000);
+  for (auto i = 0; i < 3; ++i) {
+    client.addRemoteTaskId(fmt::format("local://t{}", i));
+  }
+
+  // Before the first response, the whole budget goes to the first source.
+  ASSERT_EQ(sources[0]->requestedBytes, std::vector<uint32_t>({10'000}));
+  ASSERT_TRUE(sources[1]->requestedBytes.empty());
+  ASSERT_TRUE(sources[2]->requestedBytes.empty());
+
+  // Once a page arrives, the rest of the budget is split into page sized
+  // credits. The first source is requested again right away.
+  sources[0]->respond(1'000);
+  ASSERT_EQ(
+      sources[0]->requestedBytes, std::vector<uint32_t>({10'000, 1'000}));
+  ASSERT_EQ(sources[1]->requestedBytes, std::vector<uint32_t>({1'000}));
+  ASSERT_EQ(sources[2]->requestedBytes, std::vector<uint32_t>({1'000}));
+
+  client.close();
+}
+
+// Verifies that raising the queue limit requests more data right away.
+TEST_F(ExchangeClientTest, setMaxQueuedBytes) {
+  std::vector<std::shared_ptr<TestingExchangeSource>> sources;
+  ExchangeSource::factories().clear();
+  ExchangeSource::registerFactory(
+      [&](const auto& taskId, auto destination, auto queue, auto pool) {
+        sources.push_back(std::make_shared<TestingExchangeSource>(
+            taskId, destination, queue, pool));
+        return sources.back();
+      });
+
+  ExchangeClient client("maxQueuedBytes", 17, pool(), 1'000);
+  client.addRemoteTaskId("local://t0");
+  ASSERT_EQ(sources[0]->requestedBytes, std::vector<uint32_t>({1'000}));
+
+  // The queue is full after the response.
+  sources[0]->respond(1'000);
+  ASSERT_EQ(sources[0]->requestedBytes, std::vector<uint32_t>({1'000}));
+
+  // A lower limit does not request.
+  client.setMaxQueuedBytes(500);
+  ASSERT_EQ(client.maxQueuedBytes(), 500);
+  ASSERT_EQ(sources[0]->requestedBytes, std::vector<uint32_t>({1'000}));
+
+  client.setMaxQueuedBytes(3'000);
+  ASSERT_EQ(client.maxQueuedBytes(), 3'000);
+  ASSERT_EQ(
+      sources[0]->requestedBytes, std::vector<uint32_t>({1'000, 1'000}));
+
+  client.close();
+}
+
 TEST_F(ExchangeClientTest, multiPageFetch) {
   ExchangeClient client("test", 17, pool(), 1 << 20);
 
@@ -426,3 +426,37 @@ TEST_F(FilterProjectTest, numSilentThrow) {
   auto planStats = toPlanStats(task->taskStats());
   ASSERT_EQ(100, planStats.at(filterId).customStats.at("numSilentThrow").sum);
 }
+
+TEST_F(FilterProjectTest, exprProfiles) {
+  auto row = makeRowVector(
+      {makeFlatVector<int64_t>(100, [&](auto row) { return row; })});
+
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values({row, row, row})
+                  .filter("c0 % 2 = 0")
+                  .project({"c0 + 1 as p"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kExprProfileSampleRate, "1")
+          .assertResults(makeRowVector({makeFlatVector<int64_t>(
+              150, [](auto row) { return (row % 50) * 2 + 1; })}));
+  const auto& stats = toPlanStats(task->taskStats()).at(projectId).customStats;
+  ASSERT_EQ(3, stats.at("expr.filter.sampledBatches").sum);
+  ASSERT_EQ(300, stats.at("expr.filter.sampledRows").sum);
+  ASSERT_EQ(3, stats.at("expr.p.sampledBatches").sum);
+  ASSERT_EQ(150, stats.at("expr.p.sampledRows").sum);
+  ASSERT_EQ(0, stats.at("expr.p.sampledNullRows").sum);
+
+  // No profiles without the config.
+  task = AssertQueryBuilder(plan).assertTypeAndNumRows(
+      ROW({"p"}, {BIGINT()}), 150);
+  ASSERT_EQ(
+      0,
+      toPlanStats(task->taskStats())
+          .at(projectId)
+          .customStats.count("expr.p.sampledRows"));
+}
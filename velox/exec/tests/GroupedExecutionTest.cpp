@@ -513,4 +513,96 @@ TEST_F(GroupedExecutionTest, groupedExecution) {
   EXPECT_EQ(numRead, numSplits * 10'000);
 }
 
+// Splits of a bucketed table added without a split group go to the split
+// group of their bucket.
+TEST_F(GroupedExecutionTest, bucketedSplitsWithoutGroup) {
+  auto vectors = makeVectors(2, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+
+  CursorParameters params;
+  params.planNode = tableScanNode(ROW({}, {}));
+  params.maxDrivers = 1;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds.emplace(params.planNode->id());
+  params.numSplitGroups = 2;
+  params.numConcurrentSplitGroups = 2;
+
+  auto cursor = std::make_unique<TaskCursor>(params);
+  auto task = cursor->task();
+  cursor->start();
+
+  for (auto bucket : {3, 7, 3}) {
+    task->addSplit(
+        "0",
+        exec::Split(HiveConnectorSplitBuilder(filePath->path)
+                        .tableBucketNumber(bucket)
+                        .build()));
+  }
+  EXPECT_EQ(2, task->numRunningDrivers());
+
+  task->noMoreSplitsForGroup("0", 7);
+  waitForFinishedDrivers(task, 1);
+  EXPECT_EQ(std::unordered_set<int32_t>({7}), getCompletedSplitGroups(task));
+
+  task->noMoreSplitsForGroup("0", 3);
+  task->noMoreSplits("0");
+
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  EXPECT_EQ(
+      std::unordered_set<int32_t>({3, 7}), getCompletedSplitGroups(task));
+  EXPECT_EQ(numRead, 3 * 2'000);
+}
+
+TEST_F(GroupedExecutionTest, splitGroupMemoryAdmission) {
+  auto vectors = makeVectors(2, 100);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+
+  CursorParameters params;
+  params.planNode = tableScanNode(ROW({}, {}));
+  params.maxDrivers = 2;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds.emplace(params.planNode->id());
+  params.numSplitGroups = 2;
+  params.numConcurrentSplitGroups = 2;
+  // The query is always over 0% of its capacity, so no split group starts
+  // next to a running one.
+  params.queryCtx = std::make_shared<core::QueryCtx>(
+      executor_.get(),
+      core::QueryConfig(
+          {{core::QueryConfig::kSplitGroupAdmissionMemoryPct, "0"}}));
+  params.queryCtx->testingOverrideMemoryPool(
+      memory::defaultMemoryManager().addRootPool(
+          params.queryCtx->queryId(), 1L << 30));
+
+  auto cursor = std::make_unique<TaskCursor>(params);
+  auto task = cursor->task();
+  cursor->start();
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 1));
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 5));
+
+  // One split group runs with 2 drivers although 2 may run concurrently.
+  EXPECT_EQ(2, task->numRunningDrivers());
+
+  // The second split group starts when the first finishes.
+  task->noMoreSplitsForGroup("0", 1);
+  waitForFinishedDrivers(task, 2);
+  EXPECT_EQ(2, task->numRunningDrivers());
+  EXPECT_EQ(std::unordered_set<int32_t>({1}), getCompletedSplitGroups(task));
+
+  task->noMoreSplitsForGroup("0", 5);
+  task->noMoreSplits("0");
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  EXPECT_EQ(numRead, 2 * 200);
+}
+
 } // namespace facebook::velox::exec::test
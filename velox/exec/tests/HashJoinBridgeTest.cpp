@@ -113,6 +113,16 @@ class HashJoinBridgeTest : public testing::Test,
     return files;
   }
 
+  // Makes 'numFiles' spill files with 'fileBytes' bytes of fake content each.
+  SpillFiles makeSpillFiles(int32_t numFiles, int32_t fileBytes) {
+    auto files = makeFakeSpillFiles(numFiles);
+    for (auto& file : files) {
+      file->output().append(std::string(fileBytes, 'x'));
+      file->finishWrite();
+    }
+    return files;
+  }
+
   SpillPartitionSet makeFakeSpillPartitionSet(uint8_t partitionBitOffset) {
     SpillPartitionSet partitionSet;
     const int32_t numPartitions =
@@ -515,6 +525,54 @@ TEST(HashJoinBridgeTest, isHashBuildMemoryPool) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, oversizedSpillPartition) {
+  const int32_t spillRunBytes = 1'000;
+  for (const bool hasSpillRun : {false, true}) {
+    SCOPED_TRACE(fmt::format("hasSpillRun: {}", hasSpillRun));
+    auto joinBridge = createJoinBridge();
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      joinBridge->addBuilder();
+    }
+    joinBridge->start();
+    if (hasSpillRun) {
+      joinBridge->addSpillRun(spillRunBytes / 2);
+      joinBridge->addSpillRun(spillRunBytes);
+    }
+
+    // Partition 0 fits in the largest spill run and partition 1 does not.
+    SpillPartitionSet spillPartitionSet;
+    for (int32_t partition = 0; partition < 2; ++partition) {
+      const SpillPartitionId id(startPartitionBitOffset_, partition);
+      const int32_t partitionBytes = partition == 0 ? spillRunBytes / 2
+                                                    : spillRunBytes * 2;
+      spillPartitionSet.emplace(
+          id,
+          std::make_unique<SpillPartition>(
+              id,
+              makeSpillFiles(numBuilders_, partitionBytes / numBuilders_)));
+    }
+    ASSERT_TRUE(joinBridge->setHashTable(
+        createFakeHashTable(), std::move(spillPartitionSet), false));
+
+    for (const bool oversized : {false, true}) {
+      ASSERT_TRUE(joinBridge->probeFinished());
+      for (int32_t i = 0; i < numBuilders_; ++i) {
+        ContinueFuture future = ContinueFuture::makeEmpty();
+        auto spillInput = joinBridge->spillInputOrFuture(&future);
+        ASSERT_TRUE(spillInput.has_value());
+        ASSERT_NE(spillInput->spillPartition, nullptr);
+        ASSERT_EQ(spillInput->repartition, hasSpillRun && oversized);
+      }
+      ASSERT_FALSE(joinBridge->setHashTable(createFakeHashTable(), {}, false));
+    }
+    ASSERT_FALSE(joinBridge->probeFinished());
+    ContinueFuture future = ContinueFuture::makeEmpty();
+    auto spillInput = joinBridge->spillInputOrFuture(&future);
+    ASSERT_TRUE(spillInput.has_value());
+    ASSERT_EQ(spillInput->spillPartition, nullptr);
+  }
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     HashJoinBridgeTest,
     HashJoinBridgeTest,
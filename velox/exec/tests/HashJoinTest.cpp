@@ -1156,6 +1156,61 @@ TEST_P(MultiThreadedHashJoinTest, filter) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, heavyHitters) {
+  // Half of the build rows have key 0 and one in 4 probe rows matches them.
+  // The filter drops most of the results.
+  std::vector<RowVectorPtr> probeVectors =
+      makeBatches(4, [&](uint32_t /*unused*/) {
+        return makeRowVector(
+            {"t0", "t1"},
+            {makeFlatVector<int32_t>(
+                 1'000, [](auto row) { return row % 4 == 0 ? 0 : row; }),
+             makeFlatVector<int32_t>(1'000, [](auto row) { return row; })});
+      });
+  std::vector<RowVectorPtr> buildVectors =
+      makeBatches(4, [&](uint32_t /*unused*/) {
+        return makeRowVector(
+            {"u0", "u1"},
+            {makeFlatVector<int32_t>(
+                 2'000, [](auto row) { return row % 2 == 0 ? 0 : row; }),
+             makeFlatVector<int32_t>(2'000, [](auto row) { return row; })});
+      });
+
+  // A time slice of 0 yields after each batch of results.
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u0"})
+      .buildVectors(std::move(buildVectors))
+      .joinFilter("(t1 + u1) % 100 = 0")
+      .joinOutputLayout({"t0", "t1", "u1"})
+      .config(core::QueryConfig::kHashJoinHeavyHitterMinRows, "1000")
+      .config(core::QueryConfig::kHashProbeHeavyHitterTimeSliceMs, "0")
+      .referenceQuery(
+          "SELECT t0, t1, u1 FROM t, u WHERE t0 = u0 AND (t1 + u1) % 100 = 0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (hasSpill) {
+          return;
+        }
+        int64_t numHeavyHitterKeys = 0;
+        int64_t numHeavyHitterProbeRows = 0;
+        for (auto& pipeline : task->taskStats().pipelineStats) {
+          for (auto& op : pipeline.operatorStats) {
+            if (op.operatorType == "HashBuild") {
+              numHeavyHitterKeys += op.runtimeStats["heavyHitterKeys"].sum;
+            } else if (op.operatorType == "HashProbe") {
+              numHeavyHitterProbeRows +=
+                  op.runtimeStats["heavyHitterProbeRows"].sum;
+            }
+          }
+        }
+        ASSERT_EQ(numHeavyHitterKeys, 1);
+        ASSERT_GT(numHeavyHitterProbeRows, 0);
+      })
+      .run();
+}
+
 TEST_P(MultiThreadedHashJoinTest, nullAwareAntiJoinWithNull) {
   struct {
     double probeNullRatio;
@@ -2160,6 +2215,57 @@ TEST_P(MultiThreadedHashJoinTest, nullAwareAntiJoinWithFilterOnNullableColumn) {
   }
 }
 
+TEST_P(MultiThreadedHashJoinTest, nullAwareAntiJoinWithFilterCrossProduct) {
+  // Probe rows with null keys are combined with all build rows and build rows
+  // with null keys are combined with all unmatched probe rows. Build sides
+  // smaller and larger than one filter batch evaluate several probe rows per
+  // batch or several batches per probe row.
+  for (const auto numBuildRows : {7, 300, 3'000}) {
+    SCOPED_TRACE(fmt::format("numBuildRows: {}", numBuildRows));
+    auto probeVectors = makeBatches(3, [&](int32_t /*unused*/) {
+      return makeRowVector(
+          {"t0", "t1"},
+          {
+              makeFlatVector<int32_t>(
+                  1'000, [](auto row) { return row % 23; }, nullEvery(3)),
+              makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+          });
+    });
+    auto buildVectors = makeBatches(1, [&](int32_t /*unused*/) {
+      return makeRowVector(
+          {"u0", "u1"},
+          {
+              makeFlatVector<int32_t>(
+                  numBuildRows,
+                  [](auto row) { return row % 17; },
+                  nullEvery(5)),
+              makeFlatVector<int32_t>(
+                  numBuildRows, [](auto row) { return row * 3; }),
+          });
+    });
+    for (const std::string& filter : {"u1 > t1", "u1 % 7 = t1 % 11"}) {
+      SCOPED_TRACE(filter);
+      auto testProbeVectors = probeVectors;
+      auto testBuildVectors = buildVectors;
+      HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+          .numDrivers(numDrivers_)
+          .probeKeys({"t0"})
+          .probeVectors(std::move(testProbeVectors))
+          .buildKeys({"u0"})
+          .buildVectors(std::move(testBuildVectors))
+          .joinType(core::JoinType::kAnti)
+          .nullAware(true)
+          .joinFilter(filter)
+          .joinOutputLayout({"t0", "t1"})
+          .referenceQuery(fmt::format(
+              "SELECT t.* FROM t WHERE t0 NOT IN (SELECT u0 FROM u WHERE {})",
+              filter))
+          .checkSpillStats(false)
+          .run();
+    }
+  }
+}
+
 TEST_P(MultiThreadedHashJoinTest, antiJoin) {
   auto probeVectors = makeBatches(4, [&](int32_t /*unused*/) {
     return makeRowVector(
@@ -4446,6 +4552,101 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilter) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 10'000;
+  // More distinct build keys than VectorHasher tracks, so that there is no
+  // exact dynamic filter.
+  const int32_t numRowsBuild = 150'000;
+  const int64_t keyRange = numRowsBuild * 10;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe,
+            [&](auto row) { return (row * 7'919 + i * 104'729) % keyRange; }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  // Every 10th value in the probe key range.
+  std::vector<RowVectorPtr> buildVectors;
+  const int32_t buildBatchSize = 10'000;
+  for (int i = 0; i < numRowsBuild / buildBatchSize; ++i) {
+    buildVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            buildBatchSize,
+            [&](auto row) { return 10 * (row + i * buildBatchSize); }),
+        makeFlatVector<int64_t>(buildBatchSize, [](auto row) { return row; }),
+    }));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(probeType)
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  for (const bool enableBloomFilter : {false, true}) {
+    SCOPED_TRACE(fmt::format("enableBloomFilter: {}", enableBloomFilter));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .config(
+            core::QueryConfig::kHashBuildBloomFilterMaxBytes,
+            enableBloomFilter ? std::to_string(1 << 20) : "0")
+        .referenceQuery("SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill || !enableBloomFilter) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(0, getFiltersAccepted(task, 0).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            // The join is not replaced by the inexact Bloom filter.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            // 10% of the probe rows match, plus a few false positives.
+            ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 5);
+          }
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
@@ -85,7 +85,13 @@ class HashTableTest : public testing::TestWithParam<bool>,
             buildType->childAt(channel), channel));
       }
       auto table = HashTable<true>::createForJoin(
-          std::move(keyHashers), dependentTypes, true, false, 1'000, pool());
+          std::move(keyHashers),
+          dependentTypes,
+          true,
+          false,
+          1'000,
+          pool(),
+          enableWideNormalizedKeys_);
 
       makeRows(size, 1, sequence, buildType, batches);
       copyVectorsToTable(batches, startOffset, table.get());
@@ -103,7 +109,11 @@ class HashTableTest : public testing::TestWithParam<bool>,
     const uint64_t estimatedTableSize =
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->currentBytes();
+    topTable_->setConcurrentJoinBuild(concurrentJoinBuild_);
+    topTable_->setInlineKeys(inlineKeys_);
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setMinTableBytesForPartitionedProbe(
+        minTableBytesForPartitionedProbe_);
     ASSERT_GE(
         estimatedTableSize,
         topTable_->rows()->pool()->currentBytes() - usedMemoryBytes);
@@ -167,8 +177,10 @@ class HashTableTest : public testing::TestWithParam<bool>,
           std::make_unique<VectorHasher>(tableType->childAt(channel), channel));
     }
 
-    return HashTable<false>::createForAggregation(
+    auto table = HashTable<false>::createForAggregation(
         std::move(keyHashers), std::vector<Accumulator>{}, pool());
+    table->setInlineKeys(inlineKeys_);
+    return table;
   }
 
   void insertGroups(
@@ -376,10 +388,12 @@ class HashTableTest : public testing::TestWithParam<bool>,
     int32_t numProbed = 0;
     int32_t numHit = 0;
     auto& hashers = topTable_->hashers();
+    const auto numFirstWordKeys = topTable_->numFirstWordKeys();
     VectorHasher::ScratchMemory scratchMemory;
     for (auto batchIndex = 0; batchIndex < batches_.size(); ++batchIndex) {
       auto batch = batches_[batchIndex];
       lookup->reset(batch->size());
+      lookup->secondNormalizedKeys.resize(batch->size());
       rows.setAll();
       numHashed += batch->size();
       {
@@ -388,7 +402,11 @@ class HashTableTest : public testing::TestWithParam<bool>,
           auto key = batch->childAt(i);
           if (mode != BaseHashTable::HashMode::kHash) {
             hashers[i]->lookupValueIds(
-                *key, rows, scratchMemory, lookup->hashes);
+                *key,
+                rows,
+                scratchMemory,
+                i < numFirstWordKeys ? lookup->hashes
+                                     : lookup->secondNormalizedKeys);
           } else {
             hashers[i]->decode(*key, rows);
             hashers[i]->hash(rows, i > 0, lookup->hashes);
@@ -501,6 +519,15 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Minimum size of the bucket array for grouping probe rows by table
+  // partition. 0 means probing in input order.
+  uint64_t minTableBytesForPartitionedProbe_ = 0;
+  // Allows two word normalized keys in join tables.
+  bool enableWideNormalizedKeys_ = false;
+  // Inserts the rows of all tables concurrently in a parallel join build.
+  bool concurrentJoinBuild_ = false;
+  // Stores normalized keys in the hash tables.
+  bool inlineKeys_ = false;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -553,6 +580,71 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, partitionedProbe) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  minTableBytesForPartitionedProbe_ = 1;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
+TEST_P(HashTableTest, partitionedProbeNormalized) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  minTableBytesForPartitionedProbe_ = 1;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, wideNormalizedKey) {
+  // Each key has too many distinct values for value ids and the key ranges
+  // together do not fit in 64 bits. Each range fits in one word.
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1L << 40;
+  enableWideNormalizedKeys_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 150000, 2, type, 2);
+  EXPECT_EQ(topTable_->numFirstWordKeys(), 1);
+}
+
+TEST_P(HashTableTest, wideNormalizedKeyDisabled) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1L << 40;
+  testCycle(BaseHashTable::HashMode::kHash, 150000, 2, type, 2);
+  EXPECT_EQ(topTable_->numFirstWordKeys(), 2);
+}
+
+TEST_P(HashTableTest, concurrentJoinBuild) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  concurrentJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+}
+
+TEST_P(HashTableTest, concurrentJoinBuildNormalized) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  concurrentJoinBuild_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 9, type, 2);
+}
+
+TEST_P(HashTableTest, inlineKeys) {
+  auto type = ROW({"k1"}, {BIGINT()});
+  keySpacing_ = 1000;
+  inlineKeys_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 9, type, 1);
+}
+
+TEST_P(HashTableTest, inlineKeysMostMiss) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 10;
+  inlineKeys_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
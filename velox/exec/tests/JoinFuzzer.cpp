@@ -532,8 +532,9 @@ void makeAlternativePlans(
                           joinNode->isNullAware())
                       .planNode());
 
-  // Use OrderBy + MergeJoin (if join type is inner or left).
-  if (joinNode->isInnerJoin() || joinNode->isLeftJoin()) {
+  // Use OrderBy + MergeJoin (if join type is inner, left, right or full).
+  if (joinNode->isInnerJoin() || joinNode->isLeftJoin() ||
+      joinNode->isRightJoin() || joinNode->isFullJoin()) {
     planNodeIdGenerator->reset();
     plans.push_back(PlanBuilder(planNodeIdGenerator)
                         .values(probeInput)
@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -24,6 +27,10 @@ using namespace facebook::velox::exec::test;
 
 class MarkDistinctTest : public OperatorTestBase {
  public:
+  MarkDistinctTest() {
+    filesystems::registerLocalFileSystem();
+  }
+
   void runBasicTest(const VectorPtr& base) {
     const vector_size_t size = base->size() * 2;
     auto indices = makeIndices(size, [](auto row) { return row / 2; });
@@ -141,3 +148,43 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+
+  auto test = [&](int32_t vectorSize) {
+    SCOPED_TRACE(vectorSize);
+    auto data = makeRowVector({
+        makeFlatVector<int32_t>(vectorSize, [](auto row) { return row; }),
+    });
+
+    core::PlanNodeId markDistinctId;
+    auto plan = PlanBuilder()
+                    .values({data, data, data})
+                    .markDistinct("c0_distinct", {"c0"})
+                    .capturePlanNodeId(markDistinctId)
+                    .singleAggregation({"c0_distinct"}, {"count(1)"})
+                    .planNode();
+
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kMarkDistinctSpillEnabled, "true")
+            .spillDirectory(spillDirectory->path)
+            .assertResults(fmt::format(
+                "VALUES (true, {}), (false, {})", vectorSize, vectorSize * 2));
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(markDistinctId);
+
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+    ASSERT_GT(stats.spilledPartitions, 0);
+  };
+
+  test(1);
+  test(100);
+  test(1'000);
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -28,7 +29,8 @@ class MergeJoinTest : public HiveConnectorTestBase {
 
   CursorParameters makeCursorParameters(
       const std::shared_ptr<const core::PlanNode>& planNode,
-      uint32_t preferredOutputBatchSize) {
+      uint32_t preferredOutputBatchSize,
+      bool dictionaryOutput = false) {
     auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
 
     CursorParameters params;
@@ -36,7 +38,9 @@ class MergeJoinTest : public HiveConnectorTestBase {
     params.queryCtx = queryCtx;
     params.queryCtx->testingOverrideConfigUnsafe(
         {{core::QueryConfig::kPreferredOutputBatchRows,
-          std::to_string(preferredOutputBatchSize)}});
+          std::to_string(preferredOutputBatchSize)},
+         {core::QueryConfig::kMergeJoinDictionaryOutputEnabled,
+          dictionaryOutput ? "true" : "false"}});
     return params;
   }
 
@@ -178,6 +182,65 @@ class MergeJoinTest : public HiveConnectorTestBase {
     assertQuery(
         makeCursorParameters(plan, 10'000),
         "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
+
+    // Test RIGHT and FULL joins.
+    for (const auto& [joinType, sqlJoinType] :
+         {std::pair{core::JoinType::kRight, "RIGHT"},
+          std::pair{core::JoinType::kFull, "FULL"}}) {
+      planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      plan = PlanBuilder(planNodeIdGenerator)
+                 .values(left)
+                 .mergeJoin(
+                     {"c0"},
+                     {"u_c0"},
+                     PlanBuilder(planNodeIdGenerator)
+                         .values(right)
+                         .project({"c1 as u_c1", "c0 as u_c0"})
+                         .planNode(),
+                     "",
+                     {"c0", "c1", "u_c1"},
+                     joinType)
+                 .planNode();
+
+      for (auto batchSize : {16, 1024, 10'000}) {
+        assertQuery(
+            makeCursorParameters(plan, batchSize),
+            fmt::format(
+                "SELECT t.c0, t.c1, u.c1 FROM t {} JOIN u ON t.c0 = u.c0",
+                sqlJoinType));
+      }
+    }
+
+    // Produce output for large sets of matching rows by wrapping the inputs
+    // in dictionaries.
+    for (const auto& [joinType, sqlJoinType] :
+         {std::pair{core::JoinType::kInner, "INNER"},
+          std::pair{core::JoinType::kLeft, "LEFT"},
+          std::pair{core::JoinType::kRight, "RIGHT"},
+          std::pair{core::JoinType::kFull, "FULL"}}) {
+      planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      plan = PlanBuilder(planNodeIdGenerator)
+                 .values(left)
+                 .mergeJoin(
+                     {"c0"},
+                     {"u_c0"},
+                     PlanBuilder(planNodeIdGenerator)
+                         .values(right)
+                         .project({"c1 as u_c1", "c0 as u_c0"})
+                         .planNode(),
+                     "",
+                     {"c0", "c1", "u_c1"},
+                     joinType)
+                 .planNode();
+
+      for (auto batchSize : {1, 3, 16}) {
+        assertQuery(
+            makeCursorParameters(plan, batchSize, true),
+            fmt::format(
+                "SELECT t.c0, t.c1, u.c1 FROM t {} JOIN u ON t.c0 = u.c0",
+                sqlJoinType));
+      }
+    }
   }
 };
 
@@ -339,6 +402,11 @@ TEST_F(MergeJoinTest, innerJoinFilter) {
   assertQuery(
       makeCursorParameters(plan("(t_c1 + u_c1) % 2 = 0"), 16),
       "SELECT t_c0, u_c0, u_c1 FROM t, u WHERE t_c0 = u_c0 AND (t_c1 + u_c1) % 2 = 0");
+
+  // Filter over output wrapped around the inputs.
+  assertQuery(
+      makeCursorParameters(plan("(t_c1 + u_c1) % 2 = 0"), 1, true),
+      "SELECT t_c0, u_c0, u_c1 FROM t, u WHERE t_c0 = u_c0 AND (t_c1 + u_c1) % 2 = 0");
 }
 
 TEST_F(MergeJoinTest, leftJoinFilter) {
@@ -415,6 +483,101 @@ TEST_F(MergeJoinTest, leftJoinFilter) {
   }
 }
 
+TEST_F(MergeJoinTest, rightJoinFilter) {
+  // Each row on the right side has at most one match on the left side.
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>({0, 10, 20, 30, 40, 50}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5}),
+      });
+
+  auto right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>({0, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = [&](const std::string& filter) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values({left})
+        .mergeJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            filter,
+            {"t_c1", "u_c0", "u_c1"},
+            core::JoinType::kRight)
+        .planNode();
+  };
+
+  // Test with different output batch sizes.
+  for (auto batchSize : {1, 3, 16}) {
+    assertQuery(
+        makeCursorParameters(plan("(t_c1 + u_c1) % 2 = 0"), batchSize),
+        "SELECT t_c1, u_c0, u_c1 FROM t RIGHT JOIN u ON t_c0 = u_c0 AND (t_c1 + u_c1) % 2 = 0");
+  }
+
+  // A right-side row with multiple matches on the left side.
+  left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>({10, 10, 10, 10, 10, 10}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5}),
+      });
+
+  right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>({5, 10}),
+          makeFlatVector<int32_t>({0, 0}),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  // Test with different filters and output batch sizes.
+  for (auto batchSize : {1, 3, 16}) {
+    for (auto filter :
+         {"t_c1 + u_c1 > 3",
+          "t_c1 + u_c1 < 3",
+          "t_c1 + u_c1 > 100",
+          "t_c1 + u_c1 < 100"}) {
+      assertQuery(
+          makeCursorParameters(plan(filter), batchSize),
+          fmt::format(
+              "SELECT t_c1, u_c0, u_c1 FROM t RIGHT JOIN u ON t_c0 = u_c0 AND {}",
+              filter));
+    }
+  }
+}
+
+TEST_F(MergeJoinTest, fullJoinFilterNotSupported) {
+  auto left = makeRowVector({"t_c0"}, {makeFlatVector<int32_t>({1, 2})});
+  auto right = makeRowVector({"u_c0"}, {makeFlatVector<int32_t>({1, 2})});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .values({left})
+          .mergeJoin(
+              {"t_c0"},
+              {"u_c0"},
+              PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+              "t_c0 > 1",
+              {"t_c0", "u_c0"},
+              core::JoinType::kFull)
+          .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool_.get()),
+      "Merge join does not support full joins with a filter yet.");
+}
+
 // Verify that both left-side and right-side pipelines feeding the merge join
 // always run single-threaded.
 TEST_F(MergeJoinTest, numDrivers) {
@@ -538,6 +701,34 @@ TEST_F(MergeJoinTest, nullKeys) {
              .planNode();
   AssertQueryBuilder(plan, duckDbQueryRunner_)
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
+
+  // Right join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kRight)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t RIGHT JOIN u ON t.t0 = u.u0");
+
+  // Full join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kFull)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
 }
 
 TEST_F(MergeJoinTest, complexTypedFilter) {
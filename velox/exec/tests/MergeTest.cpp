@@ -152,6 +152,40 @@ TEST_F(MergeTest, localMerge) {
   testTwoKeys(vectors, "c3", "c0");
 }
 
+TEST_F(MergeTest, fixedWidthKeys) {
+  // Streams compare the first key of their current rows from a cached copy for
+  // these types.
+  vector_size_t batchSize = 500;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 3; ++i) {
+    auto c0 = makeFlatVector<int8_t>(
+        batchSize, [&](auto row) { return (row + i) % 7 - 3; }, nullEvery(5));
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return batchSize * i + row; });
+    auto c2 = makeFlatVector<bool>(
+        batchSize, [](auto row) { return row % 3 == 0; }, nullEvery(7));
+    auto c3 = makeFlatVector<int64_t>(batchSize, [&](auto row) -> int64_t {
+      switch (row % 3) {
+        case 0:
+          return std::numeric_limits<int64_t>::min() + row;
+        case 1:
+          return std::numeric_limits<int64_t>::max() - row;
+        default:
+          return row * i;
+      }
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0");
+  testSingleKey(vectors, "c1");
+  testSingleKey(vectors, "c3");
+
+  testTwoKeys(vectors, "c0", "c1");
+  testTwoKeys(vectors, "c2", "c1");
+}
+
 /// Verifies an edge case where output batch fills up when one of the sources
 /// has only one row left.
 TEST_F(MergeTest, offByOne) {
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/MultiLevelDriverExecutor.h"
+
+#include <folly/synchronization/Latch.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class MultiLevelDriverExecutorTest : public OperatorTestBase {
+ protected:
+  std::vector<RowVectorPtr> makeInput(int32_t numBatches) {
+    std::vector<RowVectorPtr> input;
+    for (auto i = 0; i < numBatches; ++i) {
+      input.push_back(makeRowVector({makeFlatVector<int64_t>(
+          1'000, [&](auto row) { return i * 1'000 + row; })}));
+    }
+    return input;
+  }
+};
+
+TEST_F(MultiLevelDriverExecutorTest, funcs) {
+  MultiLevelDriverExecutor executor({.numThreads = 4});
+  constexpr int32_t kNumFuncs = 1'000;
+  folly::Latch latch(kNumFuncs);
+  std::atomic<int32_t> numRun{0};
+  for (auto i = 0; i < kNumFuncs; ++i) {
+    executor.add([&]() {
+      ++numRun;
+      latch.count_down();
+    });
+  }
+  latch.wait();
+  ASSERT_EQ(numRun, kNumFuncs);
+}
+
+TEST_F(MultiLevelDriverExecutorTest, taskLevels) {
+  // Any CPU time moves a Task past the first threshold.
+  MultiLevelDriverExecutor executor(
+      {.numThreads = 2,
+       .levelThresholdNanos = {1, std::numeric_limits<uint64_t>::max() - 1}});
+  ASSERT_EQ(executor.numLevels(), 3);
+
+  auto input = makeInput(20);
+  createDuckDbTable(input);
+  auto plan = PlanBuilder()
+                  .values(input)
+                  .project({"c0 * 2 AS c1"})
+                  .singleAggregation({}, {"sum(c1)"})
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .queryCtx(std::make_shared<core::QueryCtx>(&executor))
+                  .assertResults("SELECT sum(c0 * 2) FROM tmp");
+  ASSERT_GT(executor.taskCpuNanos(task.get()), 0);
+  ASSERT_EQ(executor.taskLevel(task.get()), 1);
+
+  // A Task that has not run on 'executor' is at the top level.
+  auto otherTask = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                       .assertResults("SELECT sum(c0 * 2) FROM tmp");
+  ASSERT_EQ(executor.taskCpuNanos(otherTask.get()), 0);
+  ASSERT_EQ(executor.taskLevel(otherTask.get()), 0);
+}
+
+TEST_F(MultiLevelDriverExecutorTest, timeSlice) {
+  MultiLevelDriverExecutor executor({.numThreads = 2});
+  auto input = makeInput(200);
+  createDuckDbTable(input);
+  auto plan = PlanBuilder()
+                  .values(input)
+                  .project({"c0 % 7 AS c1", "c0"})
+                  .singleAggregation({"c1"}, {"sum(c0)"})
+                  .planNode();
+  for (auto timeSliceMs : {0, 1}) {
+    SCOPED_TRACE(fmt::format("timeSliceMs {}", timeSliceMs));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .queryCtx(std::make_shared<core::QueryCtx>(&executor))
+            .config(
+                core::QueryConfig::kDriverCpuTimeSliceLimitMs,
+                std::to_string(timeSliceMs))
+            .assertResults("SELECT c0 % 7, sum(c0) FROM tmp GROUP BY 1");
+    if (timeSliceMs == 0) {
+      for (const auto& [nodeId, stats] : toPlanStats(task->taskStats())) {
+        ASSERT_EQ(stats.customStats.count("driverTimeSliceYields"), 0);
+      }
+    }
+  }
+}
+
+TEST_F(MultiLevelDriverExecutorTest, numaNodes) {
+  for (const auto& cpus : MultiLevelDriverExecutor::systemNumaNodeCpus()) {
+    ASSERT_FALSE(cpus.empty());
+  }
+
+  // Two nodes on CPU 0, which any host has.
+  MultiLevelDriverExecutor executor(
+      {.numThreads = 2, .numaNodeCpus = {{0}, {0}}});
+  ASSERT_EQ(executor.numNumaNodes(), 2);
+
+  auto input = makeInput(10);
+  createDuckDbTable(input);
+  auto plan = PlanBuilder()
+                  .values(input)
+                  .project({"c0 % 5 AS c1", "c0"})
+                  .singleAggregation({"c1"}, {"sum(c0)"})
+                  .planNode();
+  // A new Task goes to the node with the fewest live Tasks.
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 3; ++i) {
+    tasks.push_back(
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .queryCtx(std::make_shared<core::QueryCtx>(&executor))
+            .assertResults("SELECT c0 % 5, sum(c0) FROM tmp GROUP BY 1"));
+  }
+  ASSERT_EQ(executor.taskNumaNode(tasks[0].get()), 0);
+  ASSERT_EQ(executor.taskNumaNode(tasks[1].get()), 1);
+  ASSERT_EQ(executor.taskNumaNode(tasks[2].get()), 0);
+}
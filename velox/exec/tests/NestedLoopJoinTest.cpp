@@ -80,6 +80,13 @@ class NestedLoopJoinTest : public HiveConnectorTestBase {
 
     CursorParameters params;
     params.maxDrivers = numDrivers;
+    if (buildBlockRows_ > 0) {
+      params.queryCtx =
+          std::make_shared<core::QueryCtx>(driverExecutor_.get());
+      params.queryCtx->testingOverrideConfigUnsafe(
+          {{core::QueryConfig::kNestedLoopJoinBuildBlockRows,
+            std::to_string(buildBlockRows_)}});
+    }
     auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
 
     for (const auto joinType : joinTypes_) {
@@ -124,6 +131,7 @@ class NestedLoopJoinTest : public HiveConnectorTestBase {
       core::JoinType::kRight,
       core::JoinType::kFull};
   std::vector<std::string> outputLayout_{probeKeyName_, buildKeyName_};
+  uint32_t buildBlockRows_{0};
   std::string joinConditionStr_{probeKeyName_ + " {} " + buildKeyName_};
   std::string queryStr_{fmt::format(
       "SELECT {0}, {1} FROM t {{}} JOIN u ON t.{0} {{}} u.{1}",
@@ -137,6 +145,29 @@ TEST_F(NestedLoopJoinTest, basic) {
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
 
+TEST_F(NestedLoopJoinTest, buildBlocks) {
+  // Many small build vectors are coalesced into blocks, some of which are cut
+  // below the block size by the next vector.
+  auto probeVectors = makeBatches(20, 5, probeType_, pool_.get());
+  auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
+  for (const auto buildBlockRows : {1, 7, 1'000}) {
+    SCOPED_TRACE(fmt::format("buildBlockRows: {}", buildBlockRows));
+    buildBlockRows_ = buildBlockRows;
+    runSingleAndMultiDriverTest(probeVectors, buildVectors);
+  }
+
+  // A range join over blocks of a larger build side.
+  probeType_ = ROW({{probeKeyName_, BIGINT()}, {"t1", BIGINT()}});
+  buildType_ = ROW({{buildKeyName_, BIGINT()}, {"u1", BIGINT()}});
+  probeVectors = makeBatches(100, 10, probeType_, pool_.get());
+  buildVectors = makeBatches(10, 100, buildType_, pool_.get());
+  setComparisons({"BETWEEN"});
+  setJoinConditionStr("t0 {} u0 AND u1");
+  setQueryStr("SELECT t0, u0 FROM t {} JOIN u ON t.t0 {} u.u0 AND u.u1");
+  buildBlockRows_ = 256;
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
 TEST_F(NestedLoopJoinTest, emptyProbe) {
   auto probeVectors = makeBatches(0, 5, probeType_, pool_.get());
   auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
@@ -21,6 +21,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/SortBuffer.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
@@ -346,6 +347,51 @@ TEST_F(OrderByTest, multiBatchResult) {
   testSingleKey(vectors, "c0");
 }
 
+TEST_F(OrderByTest, parallelSort) {
+  const vector_size_t batchSize = 10'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    // Many duplicate keys so that the merges split runs of equal rows.
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (batchSize * i + row) * 7919 % 1'000; },
+        nullEvery(13));
+    auto c1 = makeFlatVector<StringView>(batchSize, [&](vector_size_t row) {
+      return StringView::makeInline(fmt::format("{}", (row * 31) % 977));
+    });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  // 100'000 rows are sorted in up to 6 runs. The string key is not encoded
+  // into a prefix.
+  ASSERT_GE(10 * batchSize / SortBuffer::kMinParallelSortRows, 6);
+  const std::vector<std::pair<std::vector<std::string>, std::string>> sorts = {
+      {{"c0 DESC NULLS LAST"}, "c0 DESC NULLS LAST"},
+      {{"c1 ASC NULLS FIRST", "c0 ASC NULLS LAST"},
+       "c1 NULLS FIRST, c0 NULLS LAST"},
+  };
+  for (const auto& [keys, sql] : sorts) {
+    auto plan = PlanBuilder().values(vectors).orderBy(keys, false).planNode();
+    const auto sortingKeys = keys.size() == 1 ? std::vector<uint32_t>{0}
+                                              : std::vector<uint32_t>{1, 0};
+    for (const auto* parallelism : {"1", "2", "3", "8"}) {
+      SCOPED_TRACE(fmt::format("{}, parallelism: {}", sql, parallelism));
+      auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+      queryCtx->testingOverrideConfigUnsafe({
+          {core::QueryConfig::kOrderBySortParallelism, parallelism},
+      });
+      CursorParameters params;
+      params.planNode = plan;
+      params.queryCtx = queryCtx;
+      assertQueryOrdered(
+          params,
+          fmt::format("SELECT * FROM tmp ORDER BY {}", sql),
+          sortingKeys);
+    }
+  }
+}
+
 TEST_F(OrderByTest, varfields) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
@@ -452,6 +452,61 @@ TEST_F(OutputBufferManagerTest, arbitrayBuffer) {
   }
 }
 
+TEST_F(OutputBufferManagerTest, broadcastBuffer) {
+  BroadcastBuffer buffer;
+  ASSERT_FALSE(buffer.hasNoMoreData());
+  ASSERT_EQ(buffer.endSequence(), 0);
+  VELOX_ASSERT_THROW(buffer.enqueue(nullptr), "Unexpected null page");
+  std::vector<SerializedPage*> rawPages;
+  for (int i = 0; i < 3; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    rawPages.push_back(page.get());
+    buffer.enqueue(std::move(page));
+  }
+  ASSERT_EQ(
+      buffer.toString(),
+      "[BROADCAST_BUFFER PAGES[3] FIRST SEQUENCE[0] NO MORE DATA[false]]");
+
+  // Two destinations read the same pages without copying them.
+  DestinationBuffer fast(&buffer);
+  DestinationBuffer slow(&buffer);
+  VELOX_ASSERT_THROW(
+      fast.enqueue(nullptr), "Broadcast destination reads from broadcast");
+  auto data = fast.getData(1'000'000'000, 0, nullptr);
+  ASSERT_EQ(data.size(), 3);
+  ASSERT_EQ(slow.getData(1'000'000'000, 0, nullptr).size(), 3);
+  ASSERT_TRUE(fast.acknowledge(3, false).empty());
+  ASSERT_TRUE(slow.acknowledge(1, false).empty());
+
+  // Only the pages passed by the slowest destination are freed.
+  auto freed = buffer.freePages(std::min(fast.sequence(), slow.sequence()));
+  ASSERT_EQ(freed.size(), 1);
+  ASSERT_EQ(freed[0].get(), rawPages[0]);
+  ASSERT_EQ(buffer.firstSequence(), 1);
+  ASSERT_EQ(buffer.page(1).get(), rawPages[1]);
+  ASSERT_EQ(slow.getData(1'000'000'000, 1, nullptr).size(), 2);
+
+  buffer.noMoreData();
+  buffer.noMoreData();
+  ASSERT_TRUE(buffer.hasNoMoreData());
+  ASSERT_EQ(buffer.endSequence(), 4);
+  VELOX_ASSERT_THROW(
+      buffer.enqueue(makeSerializedPage(rowType_, 100)),
+      "Broadcast buffer has set no more data marker");
+  data = fast.getData(1'000'000'000, 3, nullptr);
+  ASSERT_EQ(data.size(), 1);
+  ASSERT_EQ(data[0], nullptr);
+
+  // Verify the end marker is persistent.
+  ASSERT_TRUE(slow.acknowledge(4, false).empty());
+  ASSERT_TRUE(fast.acknowledge(4, false).empty());
+  ASSERT_EQ(buffer.freePages(4).size(), 2);
+  ASSERT_EQ(buffer.page(3), nullptr);
+  ASSERT_EQ(
+      buffer.toString(),
+      "[BROADCAST_BUFFER PAGES[0] FIRST SEQUENCE[3] NO MORE DATA[true]]");
+}
+
 TEST_F(OutputBufferManagerTest, outputType) {
   ASSERT_EQ(
       PartitionedOutputNode::kindString(
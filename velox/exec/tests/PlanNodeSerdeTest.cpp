@@ -88,6 +88,15 @@ TEST_F(PlanNodeSerdeTest, aggregation) {
 
   testSerde(plan);
 
+  // Aggregation with an estimated number of groups.
+  plan = PlanBuilder()
+             .values({data_})
+             .singleAggregation({"c0"}, {"sum(c1)"})
+             .estimatedNumGroups(1'000)
+             .planNode();
+
+  testSerde(plan);
+
   // Aggregation over GroupId with global grouping sets.
   plan = PlanBuilder()
              .values({data_})
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+#include "velox/exec/tests/utils/RowContainerTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class PrefixSortTest : public exec::test::RowContainerTestBase {
+ protected:
+  // Stores 'data' in 'container' and returns the rows.
+  std::vector<char*> store(RowContainer& container, const RowVectorPtr& data) {
+    std::vector<char*> rows(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      rows[i] = container.newRow();
+    }
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column));
+      for (auto i = 0; i < data->size(); ++i) {
+        container.store(decoded, i, rows[i], column);
+      }
+    }
+    return rows;
+  }
+
+  // Sorts 'data' with PrefixSort and checks the result against a stable sort
+  // with the full row comparison for all the combinations of sort orders.
+  void testSort(const RowVectorPtr& data) {
+    const auto numKeys = data->childrenSize();
+    std::vector<TypePtr> keyTypes;
+    for (const auto& child : data->children()) {
+      keyTypes.push_back(child->type());
+    }
+    auto container = std::make_unique<RowContainer>(keyTypes, pool_.get());
+    const auto rows = store(*container, data);
+
+    for (auto mask = 0; mask < (1 << (2 * numKeys)); ++mask) {
+      std::vector<CompareFlags> flags(numKeys);
+      for (auto i = 0; i < numKeys; ++i) {
+        flags[i].ascending = (mask >> (2 * i)) & 1;
+        flags[i].nullsFirst = (mask >> (2 * i + 1)) & 1;
+      }
+      SCOPED_TRACE(fmt::format("numRows: {}, mask: {}", rows.size(), mask));
+
+      auto expected = rows;
+      std::stable_sort(
+          expected.begin(),
+          expected.end(),
+          [&](const char* left, const char* right) {
+            return container->compareRows(left, right, flags) < 0;
+          });
+
+      auto actual = rows;
+      ASSERT_TRUE(PrefixSort::sort(
+          container.get(),
+          numKeys,
+          flags,
+          actual.data(),
+          actual.size(),
+          pool_.get()));
+      ASSERT_EQ(actual, expected);
+    }
+  }
+};
+
+TEST_F(PrefixSortTest, exactPrefix) {
+  for (const auto numRows : {10, 1'000}) {
+    testSort(makeRowVector({
+        makeFlatVector<int32_t>(
+            numRows, [](auto row) { return row % 11 - 5; }, nullEvery(7)),
+        makeFlatVector<int16_t>(
+            numRows, [](auto row) { return row % 3 - 1; }, nullEvery(5)),
+        makeFlatVector<bool>(
+            numRows, [](auto row) { return row % 2 == 0; }, nullEvery(3)),
+    }));
+  }
+}
+
+TEST_F(PrefixSortTest, truncatedPrefix) {
+  for (const auto numRows : {10, 1'000}) {
+    testSort(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows,
+            [](auto row) { return (row % 13 - 6) * (1LL << 40) + row % 2; },
+            nullEvery(7)),
+        makeFlatVector<int64_t>(
+            numRows,
+            [](auto row) { return (row % 5 - 2) * (1LL << 62) + row % 3; },
+            nullEvery(11)),
+        makeFlatVector<int8_t>(
+            numRows, [](auto row) { return row % 256 - 128; }, nullEvery(5)),
+    }));
+  }
+}
+
+TEST_F(PrefixSortTest, uncoveredKeys) {
+  for (const auto numRows : {10, 1'000}) {
+    testSort(makeRowVector({
+        makeFlatVector<int8_t>(
+            numRows, [](auto row) { return row % 4; }, nullEvery(9)),
+        makeFlatVector<StringView>(
+            numRows,
+            [](auto row) {
+              return StringView::makeInline(std::to_string(row % 7));
+            },
+            nullEvery(6)),
+    }));
+  }
+}
+
+TEST_F(PrefixSortTest, unsupportedKey) {
+  ASSERT_TRUE(PrefixSort::canEncode(BIGINT()));
+  ASSERT_TRUE(PrefixSort::canEncode(BOOLEAN()));
+  ASSERT_FALSE(PrefixSort::canEncode(VARCHAR()));
+  ASSERT_FALSE(PrefixSort::canEncode(DOUBLE()));
+
+  auto data = makeRowVector({
+      makeFlatVector<std::string>({"b", "a", "c"}),
+      makeFlatVector<int64_t>({1, 2, 3}),
+  });
+  RowContainer container({VARCHAR(), BIGINT()}, pool_.get());
+  auto rows = store(container, data);
+  const auto original = rows;
+  ASSERT_FALSE(PrefixSort::sort(
+      &container, 2, {}, rows.data(), rows.size(), pool_.get()));
+  ASSERT_EQ(rows, original);
+}
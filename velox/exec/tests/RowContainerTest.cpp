@@ -882,6 +882,55 @@ TEST_F(RowContainerTest, extractNulls) {
   }
 }
 
+TEST_F(RowContainerTest, extractColumns) {
+  // More rows than a tile of extractColumns() with a partial last tile.
+  constexpr int32_t kNumRows = 3 * RowContainer::kExtractColumnsTileRows + 7;
+  auto batch = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(
+          kNumRows, [](auto row) { return row % 7; }, nullEvery(3)),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(row % 20, 'a' + row % 26); },
+          nullEvery(5)),
+      makeArrayVector<int32_t>(
+          kNumRows,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; },
+          nullEvery(7)),
+  });
+  auto data = makeRowContainer(
+      {BIGINT()}, {INTEGER(), VARCHAR(), ARRAY(INTEGER())});
+  std::vector<char*> rows(kNumRows);
+  SelectivityVector allRows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  for (auto i = 0; i < batch->childrenSize(); ++i) {
+    DecodedVector decoded(*batch->childAt(i), allRows);
+    for (auto j = 0; j < kNumRows; ++j) {
+      data->store(decoded, j, rows[j], i);
+    }
+  }
+
+  // Extract a subset of the columns out of order.
+  std::vector<int32_t> columns = {3, 0, 2};
+  for (auto numRows : {5, kNumRows}) {
+    SCOPED_TRACE(fmt::format("numRows {}", numRows));
+    std::vector<VectorPtr> results;
+    for (auto column : columns) {
+      results.push_back(
+          BaseVector::create(batch->childAt(column)->type(), 0, pool()));
+    }
+    data->extractColumns(rows.data(), numRows, columns, results);
+    for (auto i = 0; i < columns.size(); ++i) {
+      ASSERT_EQ(results[i]->size(), numRows);
+      assertEqualVectors(
+          batch->childAt(columns[i])->slice(0, numRows), results[i]);
+    }
+  }
+}
+
 TEST_F(RowContainerTest, erase) {
   constexpr int32_t kNumRows = 100;
   auto data = makeRowContainer({SMALLINT()}, {SMALLINT()});
@@ -1123,6 +1172,46 @@ TEST_F(RowContainerTest, alignment) {
   }
 }
 
+TEST_F(RowContainerTest, clearDestroysOnlyExternalMemoryAccumulators) {
+  int32_t numDestroyedInternal = 0;
+  int32_t numDestroyedExternal = 0;
+  auto makeAccumulator = [](bool usesExternalMemory, int32_t& numDestroyed) {
+    return Accumulator(
+        true,
+        sizeof(int64_t),
+        usesExternalMemory,
+        1,
+        [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {},
+        [&numDestroyed](folly::Range<char**> groups) {
+          numDestroyed += groups.size();
+        });
+  };
+  std::vector<Accumulator> accumulators{
+      makeAccumulator(false, numDestroyedInternal),
+      makeAccumulator(true, numDestroyedExternal)};
+  RowContainer data(
+      {BIGINT()},
+      true,
+      accumulators,
+      {},
+      false,
+      false,
+      false,
+      false,
+      pool_.get());
+  constexpr int kNumRows = 2'500;
+  for (int i = 0; i < kNumRows; ++i) {
+    data.newRow();
+  }
+
+  // The memory of accumulators that do not use external memory is released
+  // with the container's allocator, so they are not destroyed one by one.
+  data.clear();
+  ASSERT_EQ(0, data.numRows());
+  ASSERT_EQ(0, numDestroyedInternal);
+  ASSERT_EQ(kNumRows, numDestroyedExternal);
+}
+
 // Verify comparison of fringe float values
 TEST_F(RowContainerTest, compareFloat) {
   testCompareRowContainerTypeFloat<float>(REAL());
@@ -1586,3 +1675,31 @@ TEST_F(RowContainerTest, partialWriteComplexTypedRow) {
   rowContainer->initializeFields(row);
   rowContainer->eraseRows(folly::Range<char**>(&row, 1));
 }
+
+TEST_F(RowContainerTest, contiguousRowArena) {
+  constexpr int32_t kNumRows = 100'000;
+  auto data = makeRowContainer({BIGINT()}, {BIGINT()});
+  data->setContiguousRowArena(64 << 20);
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+  }
+  EXPECT_TRUE(data->hasContiguousRows());
+
+  std::vector<char*> listed(kNumRows);
+  RowContainerIterator iter;
+  ASSERT_EQ(kNumRows, data->listRows(&iter, kNumRows, listed.data()));
+  uint32_t previousOffset = 0;
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(rows[i], listed[i]);
+    const auto offset = data->rowOffset(rows[i]);
+    ASSERT_EQ(rows[i], data->rowAt(offset));
+    if (i > 0) {
+      ASSERT_LE(previousOffset + data->fixedRowSize(), offset);
+    }
+    previousOffset = offset;
+  }
+
+  // Setting the arena after rows are added is an error.
+  VELOX_ASSERT_THROW(data->setContiguousRowArena(64 << 20), "");
+}
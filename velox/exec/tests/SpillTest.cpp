@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -160,7 +161,9 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         writeBufferSize,
         compressionKind_,
         pool(),
-        &stats_);
+        &stats_,
+        writeExecutor_,
+        fileFormat_);
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(stats_.rlock()->spilledPartitions, 0);
@@ -331,7 +334,7 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
 
     for (auto partition = 0; partition < state_->maxPartitions(); ++partition) {
       int numReadBatches = 0;
-      auto merge = state_->startMerge(partition, nullptr);
+      auto merge = state_->startMerge(partition, nullptr, readAhead_);
       // We expect all the rows in dense increasing order.
       for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
         auto stream = merge->next();
@@ -370,7 +373,7 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
     ASSERT_EQ(
         finalStats.toString(),
         fmt::format(
-            "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[0]",
+            "spillRuns[{}] spilledInputBytes[{}] spilledBytes[{}] spilledRows[{}] spilledPartitions[{}] spilledFiles[{}] spillFillTimeUs[{}] spillSortTime[{}] spillSerializationTime[{}] spillDiskWrites[{}] spillFlushTime[{}] spillWriteTime[{}] maxSpillExceededLimitCount[0] spilledLz4Files[{}] spilledZstdFiles[{}] spillFileCloseTime[{}]",
             finalStats.spillRuns,
             succinctBytes(finalStats.spilledInputBytes),
             succinctBytes(finalStats.spilledBytes),
@@ -382,7 +385,10 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
             succinctMicros(finalStats.spillSerializationTimeUs),
             finalStats.spillDiskWrites,
             succinctMicros(finalStats.spillFlushTimeUs),
-            succinctMicros(finalStats.spillWriteTimeUs)));
+            succinctMicros(finalStats.spillWriteTimeUs),
+            finalStats.spilledLz4Files,
+            finalStats.spilledZstdFiles,
+            succinctMicros(finalStats.spillFileCloseTimeUs)));
 
     // Verify the spilled files are still there after spill state destruction.
     for (const auto& spilledFile : spilledFileSet) {
@@ -390,6 +396,11 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
     }
     // Verify stats.
     ASSERT_EQ(runtimeStats_["spillFileSize"].count, spilledFiles.size());
+    // Each spilled file is read to the end once by the merges.
+    ASSERT_EQ(runtimeStats_["spillReadBytes"].count, spilledFiles.size());
+    ASSERT_EQ(runtimeStats_["spillReadBytes"].sum, totalFileBytes);
+    ASSERT_EQ(runtimeStats_["spillReadTime"].count, spilledFiles.size());
+    ASSERT_EQ(runtimeStats_["spillMergeFanIn"].sum, spilledFiles.size());
   }
 
   folly::Random::DefaultGenerator rng_;
@@ -401,6 +412,11 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
   std::string spillPath_;
   folly::Synchronized<SpillStats> stats_;
   std::unique_ptr<SpillState> state_;
+  // If set, 'state_' writes to disk on this executor.
+  folly::Executor* writeExecutor_{nullptr};
+  common::SpillFileFormat fileFormat_{common::SpillFileFormat::kPresto};
+  // The read-ahead of the spill files merged from 'state_'.
+  SpillReadAheadOptions readAhead_;
   std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
   std::unique_ptr<TestRuntimeStatWriter> statWriter_;
 };
@@ -424,6 +440,181 @@ TEST_P(SpillTest, spillState) {
   spillStateTest(kGB, 2, 8, 8, {}, 8);
 }
 
+TEST_P(SpillTest, spillStateWithAsyncWrite) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  writeExecutor_ = executor.get();
+
+  // Each append flushes a buffer, so that writes overlap with serialization
+  // of the next append.
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  // A new file is started after each batch, which waits for the write to the
+  // previous file.
+  spillStateTest(1, 2, 8, 1, {}, 8 * 2);
+
+  state_.reset();
+  writeExecutor_ = nullptr;
+}
+
+TEST_P(SpillTest, spillStateWithReadAhead) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  readAhead_ = SpillReadAheadOptions{executor.get(), 4, kGB};
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {}, 8 * 2);
+
+  // A memory budget below one read buffer per file disables read-ahead.
+  readAhead_.maxBytes = 1;
+  spillStateTest(kGB, 2, 8, 1, {}, 8);
+
+  state_.reset();
+  readAhead_ = {};
+}
+
+TEST_P(SpillTest, spillStateWithCompactRowFormat) {
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    GTEST_SKIP() << "CompactRow spill files do not support compression";
+  }
+  fileFormat_ = common::SpillFileFormat::kCompactRow;
+  spillStateTest(kGB, 2, 8, 1, {CompareFlags{true, true}}, 8);
+  spillStateTest(kGB, 2, 8, 8, {}, 8);
+  spillStateTest(1, 2, 8, 1, {}, 8 * 2);
+  ASSERT_EQ(state_->fileFormat(), common::SpillFileFormat::kCompactRow);
+
+  // Verifies variable width and complex types round trip. The rows straddle
+  // the read buffers of the spill file.
+  const auto spillPath = tempDir_->path + "/compactRow";
+  SpillState state(
+      spillPath,
+      1,
+      0,
+      {},
+      kGB,
+      64 << 10,
+      compressionKind_,
+      pool(),
+      &stats_,
+      nullptr,
+      common::SpillFileFormat::kCompactRow);
+  state.setPartitionSpilled(0);
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 4; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<std::string>(
+            1'000,
+            [&](auto row) { return std::string(100 + (row + i) % 500, 'x'); },
+            nullEvery(7)),
+        makeArrayVector<int32_t>(
+            1'000,
+            [](auto row) { return row % 5; },
+            [](auto row) { return row; },
+            nullEvery(11)),
+    }));
+    state.appendToPartition(0, batches.back());
+  }
+  state.finishWrite(0);
+
+  auto expected = BaseVector::create<RowVector>(batches[0]->type(), 0, pool());
+  for (const auto& batch : batches) {
+    expected->append(batch.get());
+  }
+  auto result = BaseVector::create<RowVector>(batches[0]->type(), 0, pool());
+  for (auto& file : state.files(0)) {
+    file->startRead();
+    RowVectorPtr batch;
+    while (file->nextBatch(batch)) {
+      result->append(batch.get());
+    }
+  }
+  facebook::velox::test::assertEqualVectors(expected, result);
+}
+
+TEST_P(SpillTest, spillStateWithAdaptiveCompression) {
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    GTEST_SKIP() << "Adaptive compression replaces the compression kind";
+  }
+  const auto spillPath = tempDir_->path + "/adaptive";
+  SpillState state(
+      spillPath,
+      1,
+      0,
+      {},
+      kGB,
+      64 << 10,
+      common::CompressionKind_NONE,
+      pool(),
+      &stats_,
+      nullptr,
+      common::SpillFileFormat::kPresto,
+      true);
+  state.setPartitionSpilled(0);
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 6; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 10 + i; }),
+        makeFlatVector<std::string>(
+            1'000, [](auto row) { return std::string(row % 20, 'x'); }),
+    }));
+    state.appendToPartition(0, batches.back());
+    // Each sorted run is written to a new file of the chosen compression.
+    state.finishWrite(0);
+  }
+
+  auto files = state.files(0);
+  ASSERT_EQ(files.size(), batches.size());
+  // The first files try each of the candidate codecs.
+  for (int i = 0; i < SpillCompressionSelector::kCandidates.size(); ++i) {
+    ASSERT_EQ(
+        files[i]->compressionKind(), SpillCompressionSelector::kCandidates[i]);
+  }
+  const auto stats = stats_.copy();
+  ASSERT_EQ(stats.spilledFiles, batches.size());
+  ASSERT_GE(stats.spilledLz4Files, 1);
+  ASSERT_GE(stats.spilledZstdFiles, 1);
+  for (int i = 0; i < files.size(); ++i) {
+    files[i]->startRead();
+    RowVectorPtr batch;
+    ASSERT_TRUE(files[i]->nextBatch(batch));
+    facebook::velox::test::assertEqualVectors(batches[i], batch);
+    ASSERT_FALSE(files[i]->nextBatch(batch));
+  }
+}
+
+TEST(SpillTest, spillCompressionSelector) {
+  const auto bestCodec = [](bool asyncWrite, uint64_t writeTimeUs) {
+    SpillCompressionSelector selector(asyncWrite);
+    for (const auto kind : SpillCompressionSelector::kCandidates) {
+      EXPECT_EQ(selector.select(), kind);
+    }
+    // Serializes 1MB with each codec.
+    selector.recordFlush(common::CompressionKind_NONE, 1 << 20, 1 << 20, 100);
+    selector.recordFlush(common::CompressionKind_LZ4, 1 << 20, 1 << 19, 1'000);
+    selector.recordFlush(
+        common::CompressionKind_ZSTD, 1 << 20, 1 << 18, 5'000);
+    selector.recordWrite(1 << 20, writeTimeUs);
+    return selector.select();
+  };
+  // Compression only slows down writes to a fast disk.
+  ASSERT_EQ(bestCodec(false, 100), common::CompressionKind_NONE);
+  // LZ4 is the cheapest for the medium write throughput.
+  ASSERT_EQ(bestCodec(false, 4'000), common::CompressionKind_LZ4);
+  // ZSTD saves the most time on a slow disk.
+  ASSERT_EQ(bestCodec(false, 40'000), common::CompressionKind_ZSTD);
+  // With async writes, a codec is free as long as it is faster than the
+  // write of its output.
+  ASSERT_EQ(bestCodec(true, 4'000), common::CompressionKind_LZ4);
+  ASSERT_EQ(bestCodec(true, 100), common::CompressionKind_NONE);
+
+  // Picks no compression until the candidates have been measured.
+  SpillCompressionSelector selector(false);
+  for (int i = 0; i < SpillCompressionSelector::kCandidates.size(); ++i) {
+    selector.select();
+  }
+  ASSERT_EQ(selector.select(), common::CompressionKind_NONE);
+  ASSERT_FALSE(
+      selector.estimateTimeUsPerByte(common::CompressionKind_LZ4).has_value());
+}
+
 TEST_P(SpillTest, spillTimestamp) {
   // Verify that timestamp type retains it nanosecond precision when spilled and
   // read back.
@@ -812,5 +1003,5 @@ TEST(SpillTest, spillStats) {
   ASSERT_EQ(zeroStats, stats1);
   ASSERT_EQ(
       stats2.toString(),
-      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] maxSpillExceededLimitCount[4]");
+      "spillRuns[100] spilledInputBytes[2.00KB] spilledBytes[1.00KB] spilledRows[1031] spilledPartitions[1025] spilledFiles[1026] spillFillTimeUs[1.03ms] spillSortTime[1.03ms] spillSerializationTime[1.03ms] spillDiskWrites[1028] spillFlushTime[1.03ms] spillWriteTime[1.03ms] maxSpillExceededLimitCount[4] spilledLz4Files[0] spilledZstdFiles[0] spillFileCloseTime[0us]");
 }
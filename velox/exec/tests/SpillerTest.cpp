@@ -727,8 +727,14 @@ class SpillerTest : public exec::test::RowContainerTestBase {
             spiller_->setPartitionsSpilled(spillPartitionNumSet), "");
 #endif
       } else {
-        VELOX_ASSERT_THROW(
-            spiller_->setPartitionsSpilled(spillPartitionNumSet), "");
+        if (type_ == Spiller::Type::kHashJoinBuild) {
+          // Marking the partitions spilled ahead of a spill is allowed for
+          // hash build to repartition an oversized spill partition.
+          spiller_->setPartitionsSpilled(spillPartitionNumSet);
+        } else {
+          VELOX_ASSERT_THROW(
+              spiller_->setPartitionsSpilled(spillPartitionNumSet), "");
+        }
         spiller_->spill();
         rowContainer_->clear();
         ASSERT_TRUE(spiller_->isAllSpilled());
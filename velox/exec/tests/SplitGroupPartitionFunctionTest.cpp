@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SplitGroupPartitionFunction.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class SplitGroupPartitionFunctionTest : public test::VectorTestBase,
+                                        public testing::Test {};
+
+TEST_F(SplitGroupPartitionFunctionTest, basic) {
+  SplitGroupPartitionFunctionSpec spec;
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  std::vector<uint32_t> partitions;
+  for (uint32_t splitGroupId : {0, 3, 10, 17}) {
+    SCOPED_TRACE(splitGroupId);
+    auto partitionFunction = spec.createForSplitGroup(10, splitGroupId);
+    for (auto i = 0; i < 3; ++i) {
+      auto partition = partitionFunction->partition(*data, partitions);
+      ASSERT_TRUE(partition.has_value());
+      ASSERT_EQ(splitGroupId % 10, partition.value());
+      ASSERT_TRUE(partitions.empty());
+    }
+  }
+
+  VELOX_ASSERT_THROW(
+      spec.create(10), "Split group partitioning requires grouped execution");
+  VELOX_ASSERT_THROW(
+      spec.createForSplitGroup(10, kUngroupedGroupId),
+      "Split group partitioning requires grouped execution");
+}
+
+TEST_F(SplitGroupPartitionFunctionTest, spec) {
+  auto spec = std::make_unique<SplitGroupPartitionFunctionSpec>();
+  auto serialized = spec->serialize();
+  auto copy = SplitGroupPartitionFunctionSpec::deserialize(serialized, pool());
+  ASSERT_EQ(spec->toString(), copy->toString());
+}
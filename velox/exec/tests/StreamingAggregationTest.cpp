@@ -15,10 +15,12 @@
  */
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/core/Expressions.h"
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/SumNonPODAggregate.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -303,6 +305,72 @@ TEST_F(StreamingAggregationTest, partialStreaming) {
   testMultiKeyAggregation(keys, {"c0"});
 }
 
+TEST_F(StreamingAggregationTest, spill) {
+  // Groups that span batches are spilled while open and merged when they
+  // complete.
+  const vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 6; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            size, [&](auto row) { return (i * size + row) / 1'500; }),
+        makeFlatVector<int64_t>(size, [&](auto row) { return i * size + row; }),
+    }));
+  }
+  createDuckDbTable(data);
+
+  const std::vector<std::string> aggregates = {
+      "count(1)",
+      "min(c1)",
+      "max(c1)",
+      "sum(c1)",
+      "sumnonpod(1)"};
+  core::PlanNodeId singleNodeId;
+  auto single = PlanBuilder()
+                    .values(data)
+                    .streamingAggregation(
+                        {"c0"},
+                        aggregates,
+                        {},
+                        core::AggregationNode::Step::kSingle,
+                        false)
+                    .capturePlanNodeId(singleNodeId)
+                    .planNode();
+  core::PlanNodeId partialNodeId;
+  auto partialFinal = PlanBuilder()
+                          .values(data)
+                          .partialStreamingAggregation({"c0"}, aggregates)
+                          .capturePlanNodeId(partialNodeId)
+                          .finalAggregation()
+                          .planNode();
+
+  for (const auto& [plan, nodeId] :
+       {std::make_pair(single, singleNodeId),
+        std::make_pair(partialFinal, partialNodeId)}) {
+    for (const auto* outputBatchSize : {"1", "1024"}) {
+      SCOPED_TRACE(outputBatchSize);
+      auto spillDirectory = TempDirectoryPath::create();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .spillDirectory(spillDirectory->path)
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kAggregationSpillEnabled, "true")
+              .config(core::QueryConfig::kTestingSpillPct, "100")
+              .config(
+                  core::QueryConfig::kPreferredOutputBatchRows,
+                  outputBatchSize)
+              .assertResults(
+                  "SELECT c0, count(1), min(c1), max(c1), sum(c1), sum(1) "
+                  "FROM tmp GROUP BY 1");
+
+      auto planStats = toPlanStats(task->taskStats());
+      ASSERT_GT(planStats.at(nodeId).spilledRows, 0);
+      EXPECT_EQ(NonPODInt64::constructed, NonPODInt64::destructed);
+      OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+    }
+  }
+}
+
 // Test StreaingAggregation being closed without being initialized. Create a
 // pipeline with Project followed by StreamingAggregation. Make
 // Project::initialize fail by using non-existent function.
@@ -290,6 +290,61 @@ TEST_F(TableScanTest, partitionKeyAlias) {
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
 
+TEST_F(TableScanTest, partitionKeyFilterSkipsSplit) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  ColumnHandleMap assignments = {
+      {"a", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  auto tableHandle =
+      makeTableHandle(singleSubfieldFilter("ds", equal("2021-12-02")));
+  auto outputType = ROW({"a", "ds"}, {BIGINT(), VARCHAR()});
+  auto op =
+      PlanBuilder().tableScan(outputType, tableHandle, assignments).planNode();
+
+  // The file of the split of the other partition does not exist, so the query
+  // fails if it is opened.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+      HiveConnectorSplitBuilder(filePath->path)
+          .partitionKey("ds", "2021-12-02")
+          .build(),
+      HiveConnectorSplitBuilder(filePath->path + ".missing")
+          .partitionKey("ds", "2021-12-01")
+          .build()};
+  auto task = OperatorTestBase::assertQuery(
+      op, splits, "SELECT c0, '2021-12-02' FROM tmp");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+}
+
+TEST_F(TableScanTest, bucketFilterSkipsSplit) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  static const char* kBucket = "$bucket";
+  ColumnHandleMap assignments = {
+      {"a", regularColumn("c0", BIGINT())},
+      {kBucket, synthesizedColumn(kBucket, INTEGER())}};
+  auto tableHandle = makeTableHandle(singleSubfieldFilter(kBucket, equal(1)));
+  auto outputType = ROW({"a"}, {BIGINT()});
+  auto op =
+      PlanBuilder().tableScan(outputType, tableHandle, assignments).planNode();
+
+  // The file of the split of the other bucket does not exist, so the query
+  // fails if it is opened.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+      HiveConnectorSplitBuilder(filePath->path).tableBucketNumber(1).build(),
+      HiveConnectorSplitBuilder(filePath->path + ".missing")
+          .tableBucketNumber(2)
+          .build()};
+  auto task = OperatorTestBase::assertQuery(op, splits, "SELECT c0 FROM tmp");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+}
+
 TEST_F(TableScanTest, columnPruning) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -744,6 +799,32 @@ TEST_F(TableScanTest, subfieldPruningRemainingFilterMap) {
   }
 }
 
+TEST_F(TableScanTest, subfieldPruningRemainingFilterElementAt) {
+  // Arrays of 0 to 4 elements, so that element_at() is out of bounds in some
+  // rows after the elements past the index are pruned.
+  auto vector = makeRowVector(
+      {"a", "b"},
+      {makeFlatVector<int64_t>(100, folly::identity),
+       makeArrayVector<int64_t>(
+           100,
+           [](auto row) { return row % 5; },
+           [](auto row, auto index) { return (row + index) % 3; })});
+  auto rowType = asRowType(vector->type());
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, {vector});
+  createDuckDbTable({vector});
+
+  auto remainingFilter = parseExpr("element_at(b, 3) = 2", rowType);
+  auto op = PlanBuilder()
+                .tableScan(
+                    ROW({"a"}, {BIGINT()}),
+                    makeTableHandle(SubfieldFilters{}, remainingFilter),
+                    {{"a", regularColumn("a", BIGINT())},
+                     {"b", regularColumn("b", rowType->childAt(1))}})
+                .planNode();
+  assertQuery(op, {filePath}, "SELECT a FROM tmp WHERE b[3] = 2");
+}
+
 TEST_F(TableScanTest, subfieldPruningMapType) {
   auto valueType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
   auto mapType = MAP(BIGINT(), valueType);
@@ -1135,6 +1216,48 @@ TEST_F(TableScanTest, batchSize) {
   }
 }
 
+TEST_F(TableScanTest, adaptiveBatchSize) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto vectors = makeVectors(5, 10'000, rowType);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  // The FilterProject after the scan makes rows 20 times wider than the
+  // scanned ones.
+  std::vector<std::string> projections = {"c0"};
+  std::vector<std::string> sqlProjections = {"c0"};
+  for (auto i = 1; i < 20; ++i) {
+    projections.push_back(fmt::format("c0 + {} AS c{}", i, i));
+    sqlProjections.push_back(fmt::format("c0 + {}", i));
+  }
+  auto plan = PlanBuilder().tableScan(rowType).project(projections).planNode();
+  const auto sql =
+      fmt::format("SELECT {} FROM tmp", folly::join(", ", sqlProjections));
+
+  auto runScan = [&](bool adaptive) {
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .plan(plan)
+            .splits(makeHiveConnectorSplits({filePath}))
+            .config(
+                QueryConfig::kAdaptiveOutputBatchSizingEnabled,
+                adaptive ? "true" : "false")
+            .config(QueryConfig::kAdaptiveOutputBatchBytes, "65536")
+            .assertResults(sql);
+    return task->taskStats().pipelineStats[0].operatorStats[0];
+  };
+
+  const auto fixedStats = runScan(false);
+  const auto adaptiveStats = runScan(true);
+  ASSERT_EQ(fixedStats.outputPositions, 50'000);
+  ASSERT_EQ(adaptiveStats.outputPositions, 50'000);
+  // The scan batches are sized for the projected rows, which take about 160
+  // bytes each.
+  ASSERT_GT(adaptiveStats.outputVectors, fixedStats.outputVectors);
+  ASSERT_LT(adaptiveStats.outputPositions / adaptiveStats.outputVectors, 1'000);
+}
+
 // Test that adding the same split with the same sequence id does not cause
 // double read and the 2nd split is ignored.
 TEST_F(TableScanTest, sequentialSplitNoDoubleRead) {
@@ -1240,10 +1363,32 @@ TEST_F(TableScanTest, multipleSplits) {
     auto stats = getTableScanRuntimeStats(task);
     if (numPrefetchSplit != 0) {
       ASSERT_GT(stats.at("preloadedSplits").sum, 10);
+      // Each preloaded split is either ready or waited for when taken.
+      auto sumOf = [&](const std::string& name) {
+        return stats.count(name) ? stats.at(name).sum : 0;
+      };
+      ASSERT_EQ(
+          sumOf("readyPreloadedSplits") + sumOf("preloadedSplitWaits"),
+          stats.at("preloadedSplits").sum);
     } else {
       ASSERT_EQ(stats.count("preloadedSplits"), 0);
     }
   }
+
+  // A preload depth of 0 turns off preload.
+  FLAGS_split_preload_per_driver = 2;
+  auto filePaths = makeFilePaths(10);
+  auto vectors = makeVectors(10, 100);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(tableScanNode())
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .config(QueryConfig::kMaxSplitPreloadPerDriver, "0")
+                  .assertResults("SELECT * FROM tmp");
+  ASSERT_EQ(getTableScanRuntimeStats(task).count("preloadedSplits"), 0);
 }
 
 TEST_F(TableScanTest, waitForSplit) {
@@ -1287,6 +1432,162 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, splitMorsels) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  const auto fileSize = fs::file_size(filePath->path);
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .plan(tableScanNode())
+          .split(makeHiveConnectorSplit(filePath->path, 0, fileSize))
+          .maxDrivers(4)
+          .config(
+              QueryConfig::kTableScanSplitMorselBytes,
+              std::to_string(fileSize / 8))
+          .assertResults("SELECT * FROM tmp");
+  // Each stripe is read by the one morsel it starts in.
+  ASSERT_GT(task->taskStats().numTotalSplits, 1);
+  ASSERT_EQ(
+      task->taskStats().numFinishedSplits, task->taskStats().numTotalSplits);
+
+  // A split with no known length is not divided.
+  task = AssertQueryBuilder(duckDbQueryRunner_)
+             .plan(tableScanNode())
+             .split(makeHiveConnectorSplit(filePath->path))
+             .config(QueryConfig::kTableScanSplitMorselBytes, "1")
+             .assertResults("SELECT * FROM tmp");
+  ASSERT_EQ(task->taskStats().numTotalSplits, 1);
+}
+
+TEST_F(TableScanTest, filterProjectFusion) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             2'000, [&](auto row) { return (i * 2'000 + row) % 301; }),
+         makeFlatVector<int32_t>(2'000, [&](auto row) { return row; })}));
+  }
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+  auto buildVectors = {makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(50, [](auto row) { return row * 7; })})};
+  createDuckDbTable("u", buildVectors);
+  const auto rowType = asRowType(vectors[0]->type());
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId scanId;
+  core::PlanNodeId scanProjectId;
+  auto scanPlan = PlanBuilder(planNodeIdGenerator)
+                      .tableScan(rowType)
+                      .capturePlanNodeId(scanId)
+                      .filter("c0 % 3 = 0")
+                      .project({"c0 + c1 AS s"})
+                      .capturePlanNodeId(scanProjectId)
+                      .planNode();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId probeProjectId;
+  auto joinPlan =
+      PlanBuilder(planNodeIdGenerator)
+          .tableScan(rowType)
+          .capturePlanNodeId(probeScanId)
+          .hashJoin(
+              {"c0"},
+              {"u0"},
+              PlanBuilder(planNodeIdGenerator).values(buildVectors).planNode(),
+              "",
+              {"c0", "c1", "u0"})
+          .filter("c1 % 2 = 0")
+          .project({"c0 * 2 AS d", "u0"})
+          .capturePlanNodeId(probeProjectId)
+          .planNode();
+
+  for (auto fused : {false, true}) {
+    SCOPED_TRACE(fmt::format("fused {}", fused));
+    auto runPlan = [&](const core::PlanNodePtr& plan,
+                       const core::PlanNodeId& scanNodeId,
+                       const core::PlanNodeId& projectNodeId,
+                       const std::string& sql) {
+      auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                      .plan(plan)
+                      .split(scanNodeId, makeHiveConnectorSplit(filePath->path))
+                      .config(
+                          QueryConfig::kFilterProjectFusionEnabled,
+                          fused ? "true" : "false")
+                      .assertResults(sql);
+      // A fused FilterProject gets the rows already filtered by the operator
+      // before it.
+      const auto stats = toPlanStats(task->taskStats()).at(projectNodeId);
+      if (fused) {
+        ASSERT_EQ(stats.inputRows, stats.outputRows);
+      } else {
+        ASSERT_GT(stats.inputRows, stats.outputRows);
+      }
+    };
+    runPlan(
+        scanPlan,
+        scanId,
+        scanProjectId,
+        "SELECT c0 + c1 FROM tmp WHERE c0 % 3 = 0");
+    runPlan(
+        joinPlan,
+        probeScanId,
+        probeProjectId,
+        "SELECT c0 * 2, u0 FROM tmp, u WHERE c0 = u0 AND c1 % 2 = 0");
+  }
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  auto vectors = makeVectors(5, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId scanId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .capturePlanNodeId(scanId)
+                  .filter("c0 % 11 = 0")
+                  .project({"c0 % 7", "c1"})
+                  .planNode();
+  auto runScan = [&](const std::string& modifiedTime) {
+    auto split = HiveConnectorSplitBuilder(filePath->path).build();
+    if (!modifiedTime.empty()) {
+      split->customSplitInfo.emplace(
+          connector::hive::HiveConnectorSplit::kFileModifiedTime,
+          modifiedTime);
+    }
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .split(scanId, split)
+            .config(QueryConfig::kFragmentResultCacheEnabled, "true")
+            .config(QueryConfig::kFilterProjectFusionEnabled, "true")
+            .assertResults("SELECT c0 % 7, c1 FROM tmp WHERE c0 % 11 = 0");
+    return getTableScanRuntimeStats(task);
+  };
+
+  // A split that does not identify the version of its file is not cached.
+  auto stats = runScan("");
+  ASSERT_EQ(stats.count("fragmentResultCacheMisses"), 0);
+  ASSERT_EQ(stats.count("fragmentResultCacheHits"), 0);
+
+  stats = runScan("100");
+  ASSERT_EQ(stats.at("fragmentResultCacheMisses").sum, 1);
+  ASSERT_GT(stats.at("fragmentResultCacheStoredBytes").sum, 0);
+
+  stats = runScan("100");
+  ASSERT_EQ(stats.at("fragmentResultCacheHits").sum, 1);
+  ASSERT_EQ(stats.count("fragmentResultCacheMisses"), 0);
+
+  // A new version of the file does not hit the results of the old one.
+  stats = runScan("200");
+  ASSERT_EQ(stats.at("fragmentResultCacheMisses").sum, 1);
+  ASSERT_EQ(stats.count("fragmentResultCacheHits"), 0);
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   CursorParameters params;
   params.planNode = tableScanNode();
@@ -2455,6 +2756,26 @@ TEST_F(TableScanTest, remainingFilter) {
           .planNode(),
       filePaths,
       "SELECT * FROM tmp WHERE not (c0 > 0 or c1 > c0)");
+
+  // Conjuncts that reference no column are evaluated before reading.
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType, {}, "c1 > c0 and rand() < 2.0")
+          .planNode(),
+      filePaths,
+      "SELECT * FROM tmp WHERE c1 > c0");
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType, {}, "rand() < 0.0")
+          .planNode(),
+      filePaths,
+      "SELECT * FROM tmp WHERE false");
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType, {"c0 >= 0::INTEGER"}, "rand() >= 0.0")
+          .planNode(),
+      filePaths,
+      "SELECT * FROM tmp WHERE c0 >= 0");
 }
 
 TEST_F(TableScanTest, remainingFilterSkippedStrides) {
@@ -3511,6 +3832,78 @@ TEST_F(TableScanTest, readMissingFieldsWithMoreColumns) {
   }
 }
 
+TEST_F(TableScanTest, topNThresholdFilter) {
+  auto filePaths = makeFilePaths(10);
+  const vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return (i * size + row) * 7'919 % 10'000; }),
+        makeFlatVector<double>(size, [](auto row) { return row * 0.1; }),
+    }));
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+  auto rowType = asRowType(vectors[0]->type());
+
+  auto filtersAccepted = [](const std::shared_ptr<Task>& task) {
+    return getTableScanRuntimeStats(task)["dynamicFiltersAccepted"].sum;
+  };
+
+  // TopN offers the first key of its top row to the scan.
+  auto plan =
+      PlanBuilder().tableScan(rowType).topN({"c0"}, 10, false).planNode();
+  auto task =
+      assertQuery(plan, filePaths, "SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+  ASSERT_GT(filtersAccepted(task), 0);
+
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .filter("c0 % 3 = 0")
+             .topN({"c0 DESC"}, 10, false)
+             .planNode();
+  task = assertQuery(
+      plan,
+      filePaths,
+      "SELECT * FROM tmp WHERE c0 % 3 = 0 ORDER BY c0 DESC LIMIT 10");
+  ASSERT_GT(filtersAccepted(task), 0);
+
+  // A filter on the scan would change the rows that pass a limit.
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .limit(0, size * filePaths.size(), false)
+             .topN({"c0"}, 10, false)
+             .planNode();
+  task =
+      assertQuery(plan, filePaths, "SELECT * FROM tmp ORDER BY c0 LIMIT 10");
+  ASSERT_EQ(filtersAccepted(task), 0);
+
+  // TopNRowNumber does the same when there are no partition keys.
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .topNRowNumber({}, {"c0 DESC"}, 10, true)
+             .planNode();
+  task = assertQuery(
+      plan,
+      filePaths,
+      "SELECT * FROM (SELECT *, row_number() OVER (ORDER BY c0 DESC) AS rn "
+      "FROM tmp) WHERE rn <= 10");
+  ASSERT_GT(filtersAccepted(task), 0);
+
+  // A filter on the sorting key would drop rows of partitions not seen yet.
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .topNRowNumber({"c1"}, {"c0"}, 2, false)
+             .planNode();
+  task = assertQuery(
+      plan,
+      filePaths,
+      "SELECT c0, c1 FROM (SELECT *, row_number() OVER "
+      "(PARTITION BY c1 ORDER BY c0) AS rn FROM tmp) WHERE rn <= 2");
+  ASSERT_EQ(filtersAccepted(task), 0);
+}
+
 TEST_F(TableScanTest, varbinaryPartitionKey) {
   auto vectors = makeVectors(1, 1'000);
   auto filePath = TempFilePath::create();
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/Task.h"
+#include <folly/json.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -24,6 +25,7 @@
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Values.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -1314,4 +1316,53 @@ TEST_F(TaskTest, driverCreationMemoryAllocationCheck) {
     }
   }
 }
+
+TEST_F(TaskTest, driverTimelines) {
+  auto probe = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 50; })});
+  auto build = makeRowVector(
+      {"u0"}, {makeFlatVector<int64_t>(20, [](auto row) { return row; })});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe}, true)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({build}, true)
+                          .planNode(),
+                      "",
+                      {"c0", "u0"})
+                  .planNode();
+  for (auto enabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("enabled {}", enabled));
+    // Each of the 2 Drivers produces the probe and build values. 2 * 400
+    // probe rows match 2 build rows each.
+    auto task = AssertQueryBuilder(plan)
+                    .maxDrivers(2)
+                    .config(
+                        core::QueryConfig::kDriverTimelineEnabled,
+                        enabled ? "true" : "false")
+                    .assertTypeAndNumRows(
+                        ROW({"c0", "u0"}, {BIGINT(), BIGINT()}), 1'600);
+    auto trace = folly::parseJson(task->driverTimelinesToChromeTrace());
+    const auto& events = trace["traceEvents"];
+    if (!enabled) {
+      ASSERT_TRUE(events.empty());
+      continue;
+    }
+    std::unordered_set<std::string> names;
+    std::unordered_set<int64_t> pipelines;
+    for (const auto& event : events) {
+      names.insert(event["name"].asString());
+      pipelines.insert(event["pid"].asInt());
+      ASSERT_EQ(event["ph"].asString(), "X");
+      ASSERT_GE(event["dur"].asInt(), 0);
+    }
+    ASSERT_EQ(names.count("Queued"), 1);
+    ASSERT_EQ(names.count("OnThread"), 1);
+    // The build and probe pipelines.
+    ASSERT_EQ(pipelines.size(), 2);
+  }
+}
 } // namespace facebook::velox::exec::test
@@ -284,6 +284,52 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, thresholdFilter) {
+  // Integer first keys of each width are filtered against the first key of the
+  // top row once the top rows are full. Values are unique, c4 has nulls, c5 is
+  // dictionary encoded and c3 has the min and max of BIGINT.
+  const vector_size_t batchSize = 50;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto value = [&](vector_size_t row) {
+      return (i * batchSize + row) * 37 % 250 - 125;
+    };
+    auto c0 = makeFlatVector<int8_t>(batchSize, value);
+    auto c1 = makeFlatVector<int16_t>(
+        batchSize, [&](auto row) { return value(row) * 100; });
+    auto c2 = makeFlatVector<int32_t>(
+        batchSize, [&](auto row) { return value(row) * 10'000; });
+    auto c3 = makeFlatVector<int64_t>(batchSize, [&](auto row) -> int64_t {
+      if (i == 2 && row == 0) {
+        return std::numeric_limits<int64_t>::max();
+      }
+      if (i == 3 && row == 1) {
+        return std::numeric_limits<int64_t>::min();
+      }
+      return value(row) * 1'000'000'000'000L;
+    });
+    auto c4 = makeFlatVector<int32_t>(batchSize, value, nullEvery(7));
+    auto c5 = wrapInDictionary(
+        makeIndicesInReverse(batchSize),
+        batchSize,
+        makeFlatVector<int64_t>(batchSize, value));
+    vectors.push_back(makeRowVector({c0, c1, c2, c3, c4, c5}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0", 10);
+  testSingleKey(vectors, "c1", 10);
+  testSingleKey(vectors, "c2", 10);
+  testSingleKey(vectors, "c3", 10);
+  testSingleKey(vectors, "c3", 1);
+  testSingleKey(vectors, "c5", 10);
+
+  // There are 40 rows where c4 is null.
+  testSingleKey(vectors, "c4", 50);
+  testTwoKeys(vectors, "c4", "c0", 10);
+  testTwoKeys(vectors, "c0", "c1", 10);
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
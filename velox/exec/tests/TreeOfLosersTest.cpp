@@ -40,6 +40,40 @@ TEST_F(TreeOfLosersTest, merge) {
   testBoth(500, 1);
 }
 
+TEST_F(TreeOfLosersTest, runnerUp) {
+  for (auto numStreams : {1, 2, 9, 32}) {
+    SCOPED_TRACE(fmt::format("numStreams: {}", numStreams));
+    // Runs of 50 consecutive values go to the same stream, which stays the
+    // winner for the run.
+    std::vector<std::vector<uint32_t>> streams(numStreams);
+    std::vector<uint32_t> allNumbers;
+    for (auto i = 0; i < 10'000; ++i) {
+      const auto stream = (i / 50) % numStreams;
+      streams[stream].push_back(i);
+      allNumbers.push_back(i);
+    }
+    std::vector<std::unique_ptr<TestingStream>> mergeStreams;
+    for (auto& stream : streams) {
+      std::reverse(stream.begin(), stream.end());
+      mergeStreams.push_back(
+          std::make_unique<TestingStream>(std::move(stream)));
+    }
+    TreeOfLosers<TestingStream> merge(std::move(mergeStreams));
+    std::vector<uint32_t> result;
+    while (auto* stream = merge.next()) {
+      result.push_back(stream->current()->value());
+      stream->pop();
+      const auto* runnerUp = merge.runnerUp();
+      while (stream->hasData() &&
+             (runnerUp == nullptr || !(*runnerUp < *stream))) {
+        result.push_back(stream->current()->value());
+        stream->pop();
+      }
+    }
+    ASSERT_EQ(result, allNumbers);
+  }
+}
+
 TEST_F(TreeOfLosersTest, nextWithEquals) {
   constexpr int32_t kNumStreams = 17;
   std::vector<std::vector<uint32_t>> streams(kNumStreams);
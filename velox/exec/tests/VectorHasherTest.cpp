@@ -328,6 +328,41 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, multipleKeys) {
+  constexpr int32_t kSize = 100;
+  std::vector<VectorPtr> keys = {
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row * 7; }, nullEvery(5)),
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % 11; }),
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row / 3; }, nullEvery(7)),
+      wrapInDictionary(
+          makeIndicesInReverse(kSize),
+          makeFlatVector<int32_t>(kSize, [](auto row) { return row; })),
+      makeFlatVector<int16_t>(kSize, [](auto row) { return row; })};
+
+  // The combined hashes of the keys must be the same as those of hashing the
+  // keys one by one, also for key shapes that are not hashed in one pass.
+  for (auto numKeys = 1; numKeys <= keys.size(); ++numKeys) {
+    for (const auto* rows : {&allRows_, &oddRows_}) {
+      SCOPED_TRACE(fmt::format(
+          "{} keys, {} rows", numKeys, rows->countSelected()));
+      std::vector<std::unique_ptr<exec::VectorHasher>> hashers;
+      raw_vector<uint64_t> expected(kSize);
+      for (auto i = 0; i < numKeys; ++i) {
+        hashers.push_back(exec::VectorHasher::create(keys[i]->type(), i));
+        hashers.back()->decode(*keys[i], *rows);
+        hashers.back()->hash(*rows, i > 0, expected);
+      }
+      raw_vector<uint64_t> hashes(kSize);
+      exec::VectorHasher::hash(hashers, *rows, hashes);
+      rows->applyToSelected([&](auto row) {
+        ASSERT_EQ(hashes[row], expected[row]) << "at " << row;
+      });
+    }
+  }
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
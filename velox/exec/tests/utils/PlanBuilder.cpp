@@ -567,14 +567,17 @@ class AggregateTypeResolver {
 
 core::PlanNodePtr PlanBuilder::createIntermediateOrFinalAggregation(
     core::AggregationNode::Step step,
-    const core::AggregationNode* partialAggNode) {
+    const core::AggregationNode* partialAggNode,
+    const std::vector<core::FieldAccessTypedExprPtr>& extraGroupingKeys) {
   // Create intermediate or final aggregation using same grouping keys and same
   // aggregate function names.
   const auto& partialAggregates = partialAggNode->aggregates();
-  const auto& groupingKeys = partialAggNode->groupingKeys();
+  auto groupingKeys = partialAggNode->groupingKeys();
+  groupingKeys.insert(
+      groupingKeys.end(), extraGroupingKeys.begin(), extraGroupingKeys.end());
 
   auto numAggregates = partialAggregates.size();
-  auto numGroupingKeys = groupingKeys.size();
+  auto numGroupingKeys = partialAggNode->groupingKeys().size();
 
   std::vector<core::AggregationNode::Aggregate> aggregates;
   aggregates.reserve(numAggregates);
@@ -837,6 +840,26 @@ PlanBuilder& PlanBuilder::streamingAggregation(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::estimatedNumGroups(int64_t numGroups) {
+  auto aggregationNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  VELOX_CHECK_NOT_NULL(
+      aggregationNode, "Current plan node must be an aggregation");
+  planNode_ = std::make_shared<core::AggregationNode>(
+      aggregationNode->id(),
+      aggregationNode->step(),
+      aggregationNode->groupingKeys(),
+      aggregationNode->preGroupedKeys(),
+      aggregationNode->aggregateNames(),
+      aggregationNode->aggregates(),
+      aggregationNode->globalGroupingSets(),
+      aggregationNode->groupId(),
+      aggregationNode->ignoreNullKeys(),
+      aggregationNode->sources()[0],
+      numGroups);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::groupId(
     const std::vector<std::string>& groupingKeys,
     const std::vector<std::vector<std::string>>& groupingSets,
@@ -879,6 +902,33 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  partialAggregation(groupingKeys, aggregates);
+  auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  for (const auto& aggregate : partialAggNode->aggregates()) {
+    VELOX_USER_CHECK(
+        !aggregate.distinct && aggregate.sortingKeys.empty(),
+        "Grouping sets aggregation does not support aggregates over distinct "
+        "or sorted inputs");
+  }
+
+  groupId(
+      groupingKeys,
+      groupingSets,
+      partialAggNode->aggregateNames(),
+      groupIdName);
+  planNode_ = createIntermediateOrFinalAggregation(
+      core::AggregationNode::Step::kFinal,
+      partialAggNode.get(),
+      {field(groupIdName)});
+  return *this;
+}
+
 namespace {
 core::PlanNodePtr createLocalMergeNode(
     const core::PlanNodeId& id,
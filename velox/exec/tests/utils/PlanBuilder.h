@@ -501,6 +501,10 @@ class PlanBuilder {
       core::AggregationNode::Step step,
       bool ignoreNullKeys);
 
+  /// Sets the estimated number of groups of the current AggregationNode. The
+  /// current plan node must be an AggregationNode.
+  PlanBuilder& estimatedNumGroups(int64_t numGroups);
+
   /// Add a GroupIdNode using the specified grouping keys, grouping sets,
   /// aggregation inputs and a groupId column name.
   /// The grouping keys can specify aliases if an input column is mapped
@@ -517,6 +521,24 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add a grouping sets aggregation that accumulates raw input only once.
+  /// Adds a partial aggregation over all 'groupingKeys', a GroupIdNode that
+  /// replicates the partial results once per grouping set, and a final
+  /// aggregation over the grouping keys and the group id column. Compared to
+  /// a GroupIdNode over raw input followed by a single aggregation, the input
+  /// rows are hashed and accumulated once instead of once per grouping set.
+  /// The GroupIdNode replicates one row per distinct combination of grouping
+  /// keys. Does not support aggregates over distinct or sorted inputs, nor
+  /// grouping key aliases.
+  ///
+  /// The output columns are the grouping keys, the group id column and the
+  /// aggregates, as for a final aggregation.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add a LocalMergeNode using specified ORDER BY clauses.
   ///
   /// For example,
@@ -891,9 +913,15 @@ class PlanBuilder {
       const RowTypePtr& inputType,
       const std::string& name);
 
+  /// Creates an intermediate or final aggregation that merges the results of
+  /// 'partialAggNode'. Groups by the grouping keys of 'partialAggNode' followed
+  /// by 'extraGroupingKeys', which must come after the intermediate results in
+  /// the input.
   core::PlanNodePtr createIntermediateOrFinalAggregation(
       core::AggregationNode::Step step,
-      const core::AggregationNode* partialAggNode);
+      const core::AggregationNode* partialAggNode,
+      const std::vector<core::FieldAccessTypedExprPtr>& extraGroupingKeys =
+          {});
 
   struct AggregatesAndNames {
     std::vector<core::AggregationNode::Aggregate> aggregates;
@@ -93,4 +93,20 @@ __device__ int32_t IdMap<T, H>::makeId(T value) {
   }
 }
 
+template <typename T, typename H>
+__device__ int32_t IdMap<T, H>::findId(T value) const {
+  if (value == kEmptyMarker) {
+    return emptyId_ > 0 ? emptyId_ : 0;
+  }
+  auto mask = capacity_ - 1;
+  for (auto i = H()(value) & mask;; i = (i + 1) & mask) {
+    if (values_[i] == value) {
+      return ids_[i];
+    }
+    if (values_[i] == kEmptyMarker) {
+      return 0;
+    }
+  }
+}
+
 } // namespace facebook::velox::wave
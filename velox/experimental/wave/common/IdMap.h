@@ -32,6 +32,10 @@ class IdMap {
 
   __device__ int32_t makeId(T value);
 
+  /// Returns the id of 'value' or 0 if 'value' has no id. Must not run
+  /// concurrently with makeId().
+  __device__ int32_t findId(T value) const;
+
   __device__ int cardinality() const {
     return lastId_;
   }
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/StagingPool.h"
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::wave {
+
+StagingBuffer::~StagingBuffer() {
+  pool_->release(data_, capacity_);
+}
+
+StagingPool::~StagingPool() {
+  for (auto& [capacity, buffers] : free_) {
+    for (auto* data : buffers) {
+      allocator_->free(data, capacity);
+    }
+  }
+}
+
+// static
+StagingPool& StagingPool::instance() {
+  static auto* pool =
+      new StagingPool(getHostAllocator(getDevice()), 256 << 20);
+  return *pool;
+}
+
+StagingBufferPtr StagingPool::get(uint64_t bytes) {
+  const auto capacity =
+      bits::nextPowerOfTwo(std::max<uint64_t>(bytes, kMinBufferBytes));
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = free_.find(capacity);
+    if (it != free_.end() && !it->second.empty()) {
+      auto* data = it->second.back();
+      it->second.pop_back();
+      cachedBytes_ -= capacity;
+      return std::make_unique<StagingBuffer>(this, data, capacity);
+    }
+  }
+  auto* data = reinterpret_cast<char*>(allocator_->allocate(capacity));
+  return std::make_unique<StagingBuffer>(this, data, capacity);
+}
+
+uint64_t StagingPool::cachedBytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cachedBytes_;
+}
+
+void StagingPool::release(char* data, uint64_t capacity) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (cachedBytes_ + capacity <= maxCachedBytes_) {
+      free_[capacity].push_back(data);
+      cachedBytes_ += capacity;
+      return;
+    }
+  }
+  allocator_->free(data, capacity);
+}
+
+} // namespace facebook::velox::wave
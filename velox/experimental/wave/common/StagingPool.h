@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "velox/experimental/wave/common/Cuda.h"
+
+namespace facebook::velox::wave {
+
+class StagingPool;
+
+/// A pinned host buffer from a StagingPool. Goes back to the pool on
+/// destruction.
+class StagingBuffer {
+ public:
+  StagingBuffer(StagingPool* pool, char* data, uint64_t capacity)
+      : pool_(pool), data_(data), capacity_(capacity) {}
+
+  ~StagingBuffer();
+
+  char* data() const {
+    return data_;
+  }
+
+  uint64_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  StagingPool* const pool_;
+  char* const data_;
+  const uint64_t capacity_;
+};
+
+using StagingBufferPtr = std::unique_ptr<StagingBuffer>;
+
+/// Caches pinned host memory for staging host to device copies. A copy from
+/// pinned memory runs asynchronously on the copy engines, so that the input of
+/// one batch is copied while the kernels of another run. Allocating pinned
+/// memory is slow, so freed buffers are kept for reuse up to
+/// 'maxCachedBytes'. Sizes are rounded up to a power of two. Thread safe.
+class StagingPool {
+ public:
+  static constexpr uint64_t kMinBufferBytes = 64 << 10;
+
+  StagingPool(GpuAllocator* allocator, uint64_t maxCachedBytes)
+      : allocator_(allocator), maxCachedBytes_(maxCachedBytes) {}
+
+  ~StagingPool();
+
+  /// Returns the process wide pool of pinned memory on the current device.
+  static StagingPool& instance();
+
+  /// Returns a buffer of at least 'bytes'.
+  StagingBufferPtr get(uint64_t bytes);
+
+  /// Returns the bytes in free buffers kept for reuse.
+  uint64_t cachedBytes() const;
+
+ private:
+  friend class StagingBuffer;
+
+  void release(char* data, uint64_t capacity);
+
+  GpuAllocator* const allocator_;
+  const uint64_t maxCachedBytes_;
+
+  mutable std::mutex mutex_;
+  // Free buffers by capacity.
+  std::map<uint64_t, std::vector<char*>> free_;
+  uint64_t cachedBytes_{0};
+};
+
+} // namespace facebook::velox::wave
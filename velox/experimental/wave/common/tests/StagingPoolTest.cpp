@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/StagingPool.h"
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::wave;
+
+namespace {
+
+class CountingAllocator : public GpuAllocator {
+ public:
+  void* allocate(size_t bytes) override {
+    ++numAllocations;
+    return malloc(bytes);
+  }
+
+  void free(void* ptr, size_t /*size*/) override {
+    ++numFrees;
+    ::free(ptr);
+  }
+
+  int32_t numAllocations{0};
+  int32_t numFrees{0};
+};
+
+TEST(StagingPoolTest, reuse) {
+  CountingAllocator allocator;
+  {
+    StagingPool pool(&allocator, 1 << 20);
+    auto buffer = pool.get(100'000);
+    EXPECT_EQ(128 << 10, buffer->capacity());
+    auto* data = buffer->data();
+    buffer.reset();
+    EXPECT_EQ(128 << 10, pool.cachedBytes());
+
+    // Same size class gets the cached buffer back.
+    buffer = pool.get(70'000);
+    EXPECT_EQ(data, buffer->data());
+    EXPECT_EQ(0, pool.cachedBytes());
+    EXPECT_EQ(1, allocator.numAllocations);
+
+    // Small sizes are rounded up to the minimum.
+    auto small = pool.get(10);
+    EXPECT_EQ(StagingPool::kMinBufferBytes, small->capacity());
+    EXPECT_EQ(2, allocator.numAllocations);
+  }
+  EXPECT_EQ(allocator.numAllocations, allocator.numFrees);
+}
+
+TEST(StagingPoolTest, maxCachedBytes) {
+  CountingAllocator allocator;
+  StagingPool pool(&allocator, 1 << 20);
+  auto first = pool.get(1 << 20);
+  auto second = pool.get(1 << 20);
+  first.reset();
+  second.reset();
+  // Only one fits in the cache, the other is freed.
+  EXPECT_EQ(1 << 20, pool.cachedBytes());
+  EXPECT_EQ(1, allocator.numFrees);
+}
+
+} // namespace
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// Descriptions of decoding work on encoded column data that has been copied to
+/// the device as is. Separate header independent of Velox headers, included
+/// for both host and device side files.
+namespace facebook::velox::wave {
+
+enum class DecodeStep {
+  kTrivial,
+  kBitpack,
+  kDictionaryOnBitpack,
+  kScatterNulls,
+};
+
+/// One step of decoding 'numRows' values. The bit packed inputs are arrays of
+/// 64 bit words with the bits filled from the least significant bit up, as in
+/// bits::setBit. The arrays must be 8 byte aligned and padded to whole words.
+/// Values in results are 1, 2, 4 or 8 bytes wide.
+struct GpuDecode {
+  /// Copies the values of 'input' to 'result'.
+  struct Trivial {
+    int32_t byteWidth;
+    const void* input;
+    void* result;
+  };
+
+  /// Unpacks unsigned integers of 'bitWidth' bits and adds 'baseline' to each.
+  struct Bitpack {
+    int32_t bitWidth;
+    int32_t byteWidth;
+    const uint64_t* input;
+    int64_t baseline;
+    void* result;
+  };
+
+  /// Unpacks dictionary indices of 'bitWidth' bits and sets 'result' to the
+  /// values of 'dictionary' at the indices.
+  struct DictionaryOnBitpack {
+    int32_t bitWidth;
+    int32_t byteWidth;
+    const uint64_t* indices;
+    const void* dictionary;
+    void* result;
+  };
+
+  /// Spreads 'input', which has a value for each non-null row, to the non-null
+  /// rows of 'result' and sets 'resultNulls' to kNull or kNotNull for each
+  /// row. A set bit in 'nulls' means not null. 'input' and 'result' must not
+  /// overlap.
+  struct ScatterNulls {
+    int32_t byteWidth;
+    const uint64_t* nulls;
+    const void* input;
+    void* result;
+    uint8_t* resultNulls;
+  };
+
+  DecodeStep step;
+  int32_t numRows;
+  union {
+    Trivial trivial;
+    Bitpack bitpack;
+    DictionaryOnBitpack dictionaryOnBitpack;
+    ScatterNulls scatterNulls;
+  } data;
+};
+
+/// Steps run in order by one thread block. A step can consume the result of an
+/// earlier step of the same program, e.g. a ScatterNulls after a Bitpack.
+struct DecodeProgram {
+  int32_t numSteps;
+  GpuDecode* steps;
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/decode/GpuDecoder.h"
+
+#include <fmt/format.h>
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Exception.h"
+#include "velox/experimental/wave/dwio/decode/GpuDecoder.cuh"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+bool isValidByteWidth(int32_t byteWidth) {
+  return byteWidth == 1 || byteWidth == 2 || byteWidth == 4 || byteWidth == 8;
+}
+
+bool isValidBitWidth(int32_t bitWidth) {
+  return bitWidth >= 0 && bitWidth <= 64;
+}
+
+void checkStep(const GpuDecode& op) {
+  bool valid = op.numRows >= 0;
+  switch (op.step) {
+    case DecodeStep::kTrivial:
+      valid &= isValidByteWidth(op.data.trivial.byteWidth);
+      break;
+    case DecodeStep::kBitpack:
+      valid &= isValidByteWidth(op.data.bitpack.byteWidth) &&
+          isValidBitWidth(op.data.bitpack.bitWidth);
+      break;
+    case DecodeStep::kDictionaryOnBitpack:
+      valid &= isValidByteWidth(op.data.dictionaryOnBitpack.byteWidth) &&
+          isValidBitWidth(op.data.dictionaryOnBitpack.bitWidth);
+      break;
+    case DecodeStep::kScatterNulls:
+      valid &= isValidByteWidth(op.data.scatterNulls.byteWidth);
+      break;
+    default:
+      valid = false;
+  }
+  if (!valid) {
+    waveError(fmt::format(
+        "Malformed decode step {} for {} rows",
+        static_cast<int32_t>(op.step),
+        op.numRows));
+  }
+}
+
+__global__ void decodeGlobalKernel(DecodeProgram* programs) {
+  __shared__ cub::BlockScan<int32_t, kBlockSize>::TempStorage temp;
+  auto& program = programs[blockIdx.x];
+  for (auto i = 0; i < program.numSteps; ++i) {
+    decodeStep<kBlockSize>(program.steps[i], &temp);
+    // The next step may read the result of this one.
+    __syncthreads();
+  }
+}
+
+} // namespace
+
+void decodeGlobal(
+    Stream& stream,
+    int32_t numPrograms,
+    DecodeProgram* programs) {
+  for (auto i = 0; i < numPrograms; ++i) {
+    for (auto j = 0; j < programs[i].numSteps; ++j) {
+      checkStep(programs[i].steps[j]);
+    }
+  }
+  if (numPrograms == 0) {
+    return;
+  }
+  decodeGlobalKernel<<<numPrograms, kBlockSize, 0, stream.stream()->stream>>>(
+      programs);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
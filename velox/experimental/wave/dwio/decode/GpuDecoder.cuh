@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cub/block/block_scan.cuh>
+
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+/// Device side decoding functions. Each runs a GpuDecode on all the threads of
+/// a thread block, so that kernels can decode their own input before using it.
+namespace facebook::velox::wave {
+
+/// Returns the 'index'th value of 'bitWidth' bits in 'words'.
+__device__ inline uint64_t
+loadBits(const uint64_t* words, int32_t bitWidth, int64_t index) {
+  if (bitWidth == 0) {
+    return 0;
+  }
+  const auto bit = index * bitWidth;
+  const auto shift = bit & 63;
+  const auto* word = words + (bit >> 6);
+  auto value = word[0] >> shift;
+  if (shift + bitWidth > 64) {
+    value |= word[1] << (64 - shift);
+  }
+  return bitWidth == 64 ? value : value & ((1ULL << bitWidth) - 1);
+}
+
+__device__ inline uint64_t
+loadValue(const void* values, int32_t byteWidth, int32_t index) {
+  switch (byteWidth) {
+    case 1:
+      return reinterpret_cast<const uint8_t*>(values)[index];
+    case 2:
+      return reinterpret_cast<const uint16_t*>(values)[index];
+    case 4:
+      return reinterpret_cast<const uint32_t*>(values)[index];
+    default:
+      return reinterpret_cast<const uint64_t*>(values)[index];
+  }
+}
+
+__device__ inline void
+storeValue(void* values, int32_t byteWidth, int32_t index, uint64_t value) {
+  switch (byteWidth) {
+    case 1:
+      reinterpret_cast<uint8_t*>(values)[index] = value;
+      break;
+    case 2:
+      reinterpret_cast<uint16_t*>(values)[index] = value;
+      break;
+    case 4:
+      reinterpret_cast<uint32_t*>(values)[index] = value;
+      break;
+    default:
+      reinterpret_cast<uint64_t*>(values)[index] = value;
+  }
+}
+
+__device__ inline void decodeTrivial(const GpuDecode& op) {
+  auto& trivial = op.data.trivial;
+  for (int32_t row = threadIdx.x; row < op.numRows; row += blockDim.x) {
+    storeValue(
+        trivial.result,
+        trivial.byteWidth,
+        row,
+        loadValue(trivial.input, trivial.byteWidth, row));
+  }
+}
+
+__device__ inline void decodeBitpack(const GpuDecode& op) {
+  auto& bitpack = op.data.bitpack;
+  for (int32_t row = threadIdx.x; row < op.numRows; row += blockDim.x) {
+    storeValue(
+        bitpack.result,
+        bitpack.byteWidth,
+        row,
+        loadBits(bitpack.input, bitpack.bitWidth, row) + bitpack.baseline);
+  }
+}
+
+__device__ inline void decodeDictionaryOnBitpack(const GpuDecode& op) {
+  auto& dictionary = op.data.dictionaryOnBitpack;
+  for (int32_t row = threadIdx.x; row < op.numRows; row += blockDim.x) {
+    auto index = loadBits(dictionary.indices, dictionary.bitWidth, row);
+    storeValue(
+        dictionary.result,
+        dictionary.byteWidth,
+        row,
+        loadValue(dictionary.dictionary, dictionary.byteWidth, index));
+  }
+}
+
+/// The non-null rows of each blockDim.x rows are numbered with a block wide
+/// scan. 'temp' is the TempStorage of a cub::BlockScan<int32_t, blockSize>.
+template <int32_t blockSize>
+__device__ void decodeScatterNulls(const GpuDecode& op, void* temp) {
+  using Scan = cub::BlockScan<int32_t, blockSize>;
+  auto& scatter = op.data.scatterNulls;
+  auto& storage = *reinterpret_cast<typename Scan::TempStorage*>(temp);
+  int32_t numNonNull = 0;
+  for (int32_t base = 0; base < op.numRows; base += blockDim.x) {
+    const int32_t row = base + threadIdx.x;
+    const int32_t notNull =
+        row < op.numRows && (scatter.nulls[row >> 6] >> (row & 63)) & 1;
+    int32_t offset;
+    int32_t total;
+    Scan(storage).ExclusiveSum(notNull, offset, total);
+    if (row < op.numRows) {
+      scatter.resultNulls[row] = notNull ? kNotNull : kNull;
+      if (notNull) {
+        storeValue(
+            scatter.result,
+            scatter.byteWidth,
+            row,
+            loadValue(scatter.input, scatter.byteWidth, numNonNull + offset));
+      }
+    }
+    numNonNull += total;
+    // 'storage' is reused by the next scan.
+    __syncthreads();
+  }
+}
+
+template <int32_t blockSize>
+__device__ void decodeStep(const GpuDecode& op, void* temp) {
+  switch (op.step) {
+    case DecodeStep::kTrivial:
+      decodeTrivial(op);
+      break;
+    case DecodeStep::kBitpack:
+      decodeBitpack(op);
+      break;
+    case DecodeStep::kDictionaryOnBitpack:
+      decodeDictionaryOnBitpack(op);
+      break;
+    case DecodeStep::kScatterNulls:
+      decodeScatterNulls<blockSize>(op, temp);
+      break;
+  }
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+
+namespace facebook::velox::wave {
+
+/// Enqueues a kernel on 'stream' that runs each of 'programs' on a thread
+/// block of its own. The programs, their steps and the data they refer to must
+/// be accessible from the device, e.g. allocated from a GpuArena. The encoded
+/// data can be copied to the device without decoding with
+/// Stream::hostToDeviceAsync() before. Throws if a step is malformed.
+void decodeGlobal(Stream& stream, int32_t numPrograms, DecodeProgram* programs);
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+#include <random>
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/dwio/decode/GpuDecoder.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+std::random_device::result_type randomSeed() {
+  auto seed = std::random_device{}();
+  LOG(INFO) << "Random seed: " << seed;
+  return seed;
+}
+
+uint64_t lowMask(int32_t bitWidth) {
+  return bitWidth == 64 ? ~0ULL : (1ULL << bitWidth) - 1;
+}
+
+// Packs 'values' into words of 'bitWidth' bits per value, lowest bits first.
+GpuAllocator::UniquePtr<uint64_t[]> pack(
+    GpuAllocator* allocator,
+    const std::vector<uint64_t>& values,
+    int32_t bitWidth) {
+  auto numWords = roundUp(values.size() * bitWidth, 64) / 64 + 1;
+  auto words = allocator->allocate<uint64_t>(numWords);
+  std::fill(words.get(), words.get() + numWords, 0);
+  for (auto i = 0; i < values.size(); ++i) {
+    for (auto bit = 0; bit < bitWidth; ++bit) {
+      if (values[i] >> bit & 1) {
+        auto position = i * bitWidth + bit;
+        words[position / 64] |= 1ULL << (position % 64);
+      }
+    }
+  }
+  return words;
+}
+
+std::vector<uint64_t>
+randomValues(std::default_random_engine& gen, int32_t size, int32_t bitWidth) {
+  std::uniform_int_distribution<uint64_t> dist;
+  std::vector<uint64_t> values(size);
+  for (auto& value : values) {
+    value = dist(gen) & lowMask(bitWidth);
+  }
+  return values;
+}
+
+void decode(int32_t numPrograms, DecodeProgram* programs) {
+  Stream stream;
+  decodeGlobal(stream, numPrograms, programs);
+  stream.wait();
+}
+
+TEST(GpuDecoderTest, bitpack) {
+  auto* allocator = getAllocator(getDevice());
+  std::default_random_engine gen(randomSeed());
+  const std::vector<int32_t> bitWidths = {0, 1, 5, 13, 31, 32, 47, 63, 64};
+  constexpr int32_t kNumRows = 2000;
+  auto steps = allocator->allocate<GpuDecode>(bitWidths.size());
+  auto programs = allocator->allocate<DecodeProgram>(bitWidths.size());
+  std::vector<std::vector<uint64_t>> values;
+  std::vector<GpuAllocator::UniquePtr<uint64_t[]>> packed;
+  std::vector<GpuAllocator::UniquePtr<uint64_t[]>> results;
+  for (auto i = 0; i < bitWidths.size(); ++i) {
+    values.push_back(randomValues(gen, kNumRows, bitWidths[i]));
+    packed.push_back(pack(allocator, values.back(), bitWidths[i]));
+    results.push_back(allocator->allocate<uint64_t>(kNumRows));
+    auto& step = steps[i];
+    step.step = DecodeStep::kBitpack;
+    step.numRows = kNumRows;
+    step.data.bitpack.bitWidth = bitWidths[i];
+    step.data.bitpack.byteWidth = 8;
+    step.data.bitpack.input = packed.back().get();
+    step.data.bitpack.baseline = i;
+    step.data.bitpack.result = results.back().get();
+    programs[i].numSteps = 1;
+    programs[i].steps = &steps[i];
+  }
+  decode(bitWidths.size(), programs.get());
+  for (auto i = 0; i < bitWidths.size(); ++i) {
+    for (auto row = 0; row < kNumRows; ++row) {
+      ASSERT_EQ(values[i][row] + i, results[i][row])
+          << "bitWidth " << bitWidths[i] << " row " << row;
+    }
+  }
+}
+
+TEST(GpuDecoderTest, dictionaryWithNulls) {
+  auto* allocator = getAllocator(getDevice());
+  std::default_random_engine gen(randomSeed());
+  constexpr int32_t kNumRows = 3001;
+  constexpr int32_t kDictionarySize = 100;
+  constexpr int32_t kBitWidth = 7;
+  auto dictionary = allocator->allocate<int32_t>(kDictionarySize);
+  for (auto i = 0; i < kDictionarySize; ++i) {
+    dictionary[i] = i * 1'000'003;
+  }
+  auto nulls = allocator->allocate<uint64_t>(roundUp(kNumRows, 64) / 64);
+  std::vector<uint64_t> indices;
+  std::uniform_int_distribution<> nullDist(0, 3);
+  std::uniform_int_distribution<> indexDist(0, kDictionarySize - 1);
+  for (auto row = 0; row < kNumRows; ++row) {
+    if (row % 64 == 0) {
+      nulls[row / 64] = 0;
+    }
+    if (nullDist(gen) != 0) {
+      nulls[row / 64] |= 1ULL << (row % 64);
+      indices.push_back(indexDist(gen));
+    }
+  }
+  auto packed = pack(allocator, indices, kBitWidth);
+  auto dense = allocator->allocate<int32_t>(indices.size());
+  auto result = allocator->allocate<int32_t>(kNumRows);
+  auto resultNulls = allocator->allocate<uint8_t>(kNumRows);
+
+  auto steps = allocator->allocate<GpuDecode>(2);
+  steps[0].step = DecodeStep::kDictionaryOnBitpack;
+  steps[0].numRows = indices.size();
+  steps[0].data.dictionaryOnBitpack.bitWidth = kBitWidth;
+  steps[0].data.dictionaryOnBitpack.byteWidth = 4;
+  steps[0].data.dictionaryOnBitpack.indices = packed.get();
+  steps[0].data.dictionaryOnBitpack.dictionary = dictionary.get();
+  steps[0].data.dictionaryOnBitpack.result = dense.get();
+  steps[1].step = DecodeStep::kScatterNulls;
+  steps[1].numRows = kNumRows;
+  steps[1].data.scatterNulls.byteWidth = 4;
+  steps[1].data.scatterNulls.nulls = nulls.get();
+  steps[1].data.scatterNulls.input = dense.get();
+  steps[1].data.scatterNulls.result = result.get();
+  steps[1].data.scatterNulls.resultNulls = resultNulls.get();
+  auto program = allocator->allocate<DecodeProgram>();
+  program->numSteps = 2;
+  program->steps = steps.get();
+  decode(1, program.get());
+
+  int32_t numNonNull = 0;
+  for (auto row = 0; row < kNumRows; ++row) {
+    if (nulls[row / 64] >> (row % 64) & 1) {
+      ASSERT_EQ(kNotNull, resultNulls[row]) << row;
+      ASSERT_EQ(dictionary[indices[numNonNull++]], result[row]) << row;
+    } else {
+      ASSERT_EQ(kNull, resultNulls[row]) << row;
+    }
+  }
+  ASSERT_EQ(indices.size(), numNonNull);
+}
+
+TEST(GpuDecoderTest, trivial) {
+  auto* allocator = getAllocator(getDevice());
+  constexpr int32_t kNumRows = 1000;
+  auto input = allocator->allocate<int16_t>(kNumRows);
+  auto result = allocator->allocate<int16_t>(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    input[i] = i * 31 - 5000;
+  }
+  auto step = allocator->allocate<GpuDecode>();
+  step->step = DecodeStep::kTrivial;
+  step->numRows = kNumRows;
+  step->data.trivial.byteWidth = 2;
+  step->data.trivial.input = input.get();
+  step->data.trivial.result = result.get();
+  auto program = allocator->allocate<DecodeProgram>();
+  program->numSteps = 1;
+  program->steps = step.get();
+  decode(1, program.get());
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(input[i], result[i]);
+  }
+
+  step->data.trivial.byteWidth = 3;
+  Stream stream;
+  EXPECT_ANY_THROW(decodeGlobal(stream, 1, program.get()));
+}
+
+} // namespace
+} // namespace facebook::velox::wave
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::Init follyInit(&argc, &argv);
+  if (int device; cudaGetDevice(&device) != cudaSuccess) {
+    LOG(WARNING) << "No CUDA detected, skipping all tests";
+    return 0;
+  }
+  return RUN_ALL_TESTS();
+}
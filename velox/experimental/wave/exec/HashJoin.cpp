@@ -0,0 +1,572 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include <numeric>
+
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/common/IdMap.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+DECLARE_int64(velox_wave_arena_unit_size);
+
+namespace facebook::velox::wave {
+
+namespace {
+
+constexpr int32_t kMinTableCapacity = 64;
+
+bool isFixedWidth(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// True if all of the plan below and including 'node' is converted to Wave.
+bool isWaveSubtree(const core::PlanNode& node) {
+  if (auto* join = dynamic_cast<const core::HashJoinNode*>(&node)) {
+    return isWaveHashJoin(*join);
+  }
+  if (!dynamic_cast<const core::ValuesNode*>(&node) &&
+      !dynamic_cast<const core::ProjectNode*>(&node) &&
+      !dynamic_cast<const core::AggregationNode*>(&node)) {
+    return false;
+  }
+  for (auto& source : node.sources()) {
+    if (!isWaveSubtree(*source)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the channels of the build side input that are copied to the table:
+// the key followed by the other build side columns of the join output.
+std::vector<int32_t> tableChannels(const core::HashJoinNode& node) {
+  auto& buildType = node.sources()[1]->outputType();
+  std::vector<int32_t> channels = {
+      exec::exprToChannel(node.rightKeys()[0].get(), buildType)};
+  for (auto& name : node.outputType()->names()) {
+    auto channel = buildType->getChildIdxIfExists(name);
+    if (channel.has_value() && channel.value() != channels[0]) {
+      channels.push_back(channel.value());
+    }
+  }
+  return channels;
+}
+
+template <typename T>
+void* makeIdMap(
+    GpuArena& arena,
+    int32_t capacity,
+    std::vector<WaveBufferPtr>& buffers) {
+  auto* idMap = arena.allocate<IdMap<T>>(1, buffers.emplace_back());
+  auto* keys = arena.allocate<T>(capacity, buffers.emplace_back());
+  auto* ids = arena.allocate<int32_t>(capacity, buffers.emplace_back());
+  bzero(keys, capacity * sizeof(T));
+  bzero(ids, capacity * sizeof(int32_t));
+  idMap->init(capacity, keys, ids);
+  return idMap;
+}
+
+// The thread block programs of a kernel launch over batches of rows.
+struct Launch {
+  int32_t numBlocks{0};
+  hashjoin::ThreadBlockProgram* programs{nullptr};
+  int32_t* baseIndices{nullptr};
+  BlockStatus* status{nullptr};
+};
+
+// Makes a launch with a thread block for each kBlockSize rows of each of
+// 'sizes'. The blocks of the ith batch run the 'instructionsPerBatch'
+// instructions starting at 'instructions + i * instructionsPerBatch'.
+Launch makeLaunch(
+    GpuArena& arena,
+    const std::vector<int32_t>& sizes,
+    hashjoin::Instruction* instructions,
+    int32_t instructionsPerBatch,
+    std::vector<WaveBufferPtr>& buffers) {
+  Launch launch;
+  for (auto size : sizes) {
+    launch.numBlocks += bits::roundUp(size, kBlockSize) / kBlockSize;
+  }
+  if (launch.numBlocks == 0) {
+    return launch;
+  }
+  launch.programs = arena.allocate<hashjoin::ThreadBlockProgram>(
+      launch.numBlocks, buffers.emplace_back());
+  launch.baseIndices =
+      arena.allocate<int32_t>(launch.numBlocks, buffers.emplace_back());
+  launch.status =
+      arena.allocate<BlockStatus>(launch.numBlocks, buffers.emplace_back());
+  bzero(launch.status, launch.numBlocks * sizeof(BlockStatus));
+  int32_t block = 0;
+  for (auto i = 0; i < sizes.size(); ++i) {
+    const auto firstBlock = block;
+    const auto numBlocks = bits::roundUp(sizes[i], kBlockSize) / kBlockSize;
+    for (auto j = 0; j < numBlocks; ++j, ++block) {
+      launch.programs[block].numInstructions = instructionsPerBatch;
+      launch.programs[block].instructions =
+          instructions + i * instructionsPerBatch;
+      launch.baseIndices[block] = firstBlock;
+    }
+  }
+  return launch;
+}
+
+void run(Stream& stream, const Launch& launch) {
+  if (launch.numBlocks > 0) {
+    hashjoin::call(
+        stream,
+        launch.numBlocks,
+        launch.programs,
+        launch.baseIndices,
+        launch.status);
+  }
+}
+
+// Runs 'launch' and waits for it. Throws if a thread block reports an error.
+void runAndWait(const Launch& launch) {
+  auto stream = WaveStream::streamFromReserve();
+  run(*stream, launch);
+  stream->wait();
+  WaveStream::releaseStream(std::move(stream));
+  for (auto i = 0; i < launch.numBlocks; ++i) {
+    for (auto error : launch.status[i].errors) {
+      VELOX_CHECK(
+          error == ErrorCode::kOk,
+          "Wave hash join kernel failed with error {}",
+          static_cast<int32_t>(error));
+    }
+  }
+}
+
+std::mutex& bridgesMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+using BridgeKey = std::tuple<const exec::Task*, uint32_t, core::PlanNodeId>;
+
+std::map<BridgeKey, std::weak_ptr<WaveJoinBridge>>& bridges() {
+  static std::map<BridgeKey, std::weak_ptr<WaveJoinBridge>> bridges;
+  return bridges;
+}
+
+} // namespace
+
+bool isWaveHashJoin(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.leftKeys().size() != 1) {
+    return false;
+  }
+  auto& keyType = node.leftKeys()[0]->type();
+  if ((keyType->kind() != TypeKind::INTEGER &&
+       keyType->kind() != TypeKind::BIGINT) ||
+      !keyType->equivalent(*node.rightKeys()[0]->type())) {
+    return false;
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isFixedWidth(type)) {
+      return false;
+    }
+  }
+  return isWaveSubtree(*node.sources()[0]) && isWaveSubtree(*node.sources()[1]);
+}
+
+// static
+std::shared_ptr<WaveJoinBridge> WaveJoinBridge::get(
+    const exec::Task& task,
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::mutex> l(bridgesMutex());
+  auto& map = bridges();
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->second.expired()) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  auto& entry = map[{&task, splitGroupId, planNodeId}];
+  if (auto bridge = entry.lock()) {
+    return bridge;
+  }
+  auto bridge = std::make_shared<WaveJoinBridge>();
+  entry = bridge;
+  return bridge;
+}
+
+WaveJoinBridge::WaveJoinBridge()
+    : arena_(std::make_unique<GpuArena>(
+          FLAGS_velox_wave_arena_unit_size,
+          getAllocator(getDevice()))) {}
+
+void WaveJoinBridge::addBuildInput(std::vector<WaveVectorPtr> input) {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (auto& batch : input) {
+    buildInput_.push_back(std::move(batch));
+  }
+}
+
+std::vector<WaveVectorPtr> WaveJoinBridge::takeBuildInput() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return std::move(buildInput_);
+}
+
+void WaveJoinBridge::setTable(std::unique_ptr<WaveJoinTable> table) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NULL(table_);
+    table_ = std::move(table);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+const WaveJoinTable* WaveJoinBridge::tableOrFuture(ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting hash table after join is aborted");
+  if (table_) {
+    return table_.get();
+  }
+  promises_.emplace_back("WaveJoinBridge::tableOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return nullptr;
+}
+
+HashBuild::HashBuild(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, ROW({}, {})),
+      planNodeId_(node.id()),
+      driverCtx_(state.driver().driverCtx()),
+      bridge_(WaveJoinBridge::get(
+          *driverCtx_->task,
+          driverCtx_->splitGroupId,
+          planNodeId_)),
+      channels_(tableChannels(node)) {
+  auto& buildType = node.sources()[1]->outputType();
+  for (auto channel : channels_) {
+    types_.push_back(buildType->childAt(channel));
+  }
+}
+
+void HashBuild::flush(bool noMoreInput) {
+  if (!noMoreInput || noMoreInput_) {
+    return;
+  }
+  noMoreInput_ = true;
+  bridge_->addBuildInput(std::move(buffered_));
+  buffered_.clear();
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<exec::Driver>> peers;
+  // The Drivers that are not last wait until the last one has made the table
+  // from their input.
+  if (!driverCtx_->task->allPeersFinished(
+          planNodeId_, driverCtx_->driver, &future_, promises, peers)) {
+    return;
+  }
+  buildTable();
+  peers.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+exec::BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
+  if (!future_.valid()) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  *future = std::move(future_);
+  return exec::BlockingReason::kWaitForJoinBuild;
+}
+
+void HashBuild::buildTable() {
+  auto input = bridge_->takeBuildInput();
+  auto& arena = bridge_->arena();
+  auto table = std::make_unique<WaveJoinTable>();
+  auto& buffers = table->buffers;
+  int32_t numRows = 0;
+  for (auto& batch : input) {
+    numRows += batch->size();
+  }
+  // At most half full so that the IdMap does not run out of space.
+  const int32_t capacity = bits::nextPowerOfTwo(
+      std::max<int32_t>(kMinTableCapacity, 2 * numRows));
+  const int32_t numColumns = channels_.size();
+  auto* joinTable =
+      arena.allocate<hashjoin::JoinTable>(1, buffers.emplace_back());
+  table->table = joinTable;
+  joinTable->keyType = fromCpuType(*types_[0]);
+  switch (joinTable->keyType.kind) {
+    case PhysicalType::kInt32:
+      joinTable->idMap = makeIdMap<int32_t>(arena, capacity, buffers);
+      break;
+    case PhysicalType::kInt64:
+      joinTable->idMap = makeIdMap<int64_t>(arena, capacity, buffers);
+      break;
+    default:
+      VELOX_UNSUPPORTED("{}", joinTable->keyType.kind);
+  }
+  // Ids start at 1.
+  joinTable->firstRow =
+      arena.allocate<int32_t>(capacity + 1, buffers.emplace_back());
+  std::fill(joinTable->firstRow, joinTable->firstRow + capacity + 1, -1);
+  joinTable->nextRow =
+      arena.allocate<int32_t>(std::max(numRows, 1), buffers.emplace_back());
+  joinTable->numRows = numRows;
+  joinTable->numColumns = numColumns;
+  joinTable->keyColumn = 0;
+  joinTable->columnTypes =
+      arena.allocate<PhysicalType>(numColumns, buffers.emplace_back());
+  joinTable->columns =
+      arena.allocate<Operand>(numColumns, buffers.emplace_back());
+  for (auto i = 0; i < numColumns; ++i) {
+    joinTable->columnTypes[i] = fromCpuType(*types_[i]);
+    table->columns.push_back(WaveVector::create(types_[i], arena));
+    // At least one row so that the Operand has a buffer.
+    table->columns.back()->resize(std::max(numRows, 1));
+    table->columns.back()->toOperand(&joinTable->columns[i]);
+  }
+
+  if (!input.empty()) {
+    std::vector<WaveBufferPtr> launchBuffers;
+    auto* instructions = arena.allocate<hashjoin::Instruction>(
+        input.size(), launchBuffers.emplace_back());
+    std::vector<int32_t> sizes;
+    int32_t rowOffset = 0;
+    for (auto i = 0; i < input.size(); ++i) {
+      instructions[i].opCode = hashjoin::OpCode::kBuild;
+      auto& build = instructions[i]._.build;
+      build.table = joinTable;
+      build.inputs =
+          arena.allocate<Operand>(numColumns, launchBuffers.emplace_back());
+      for (auto j = 0; j < numColumns; ++j) {
+        input[i]->childAt(channels_[j]).toOperand(&build.inputs[j]);
+      }
+      build.rowOffset = rowOffset;
+      rowOffset += input[i]->size();
+      sizes.push_back(input[i]->size());
+    }
+    runAndWait(makeLaunch(arena, sizes, instructions, 1, launchBuffers));
+  }
+  VLOG(1) << "Built Wave hash table with " << numRows << " rows";
+  bridge_->setTable(std::move(table));
+}
+
+HashProbe::HashProbe(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType()) {
+  auto* driverCtx = state.driver().driverCtx();
+  bridge_ = WaveJoinBridge::get(
+      *driverCtx->task, driverCtx->splitGroupId, node.id());
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  keyChannel_ = exec::exprToChannel(node.leftKeys()[0].get(), probeType);
+  auto channels = tableChannels(node);
+  for (auto& name : outputType_->names()) {
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      outputColumns_.push_back({false, static_cast<int32_t>(channel.value())});
+      continue;
+    }
+    auto it = std::find(
+        channels.begin(), channels.end(), buildType->getChildIdx(name));
+    VELOX_CHECK(it != channels.end());
+    outputColumns_.push_back(
+        {true, static_cast<int32_t>(it - channels.begin())});
+  }
+}
+
+exec::BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (!table_) {
+    table_ = bridge_->tableOrFuture(future);
+    if (!table_) {
+      return exec::BlockingReason::kWaitForJoinBuild;
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void HashProbe::countMatches() {
+  auto& arena = driver_->arena();
+  inputs_ = std::move(buffered_);
+  buffered_.clear();
+  std::vector<WaveBufferPtr> buffers;
+  auto* instructions = arena.allocate<hashjoin::Instruction>(
+      inputs_.size(), buffers.emplace_back());
+  auto* keys = arena.allocate<Operand>(inputs_.size(), buffers.emplace_back());
+  std::vector<int32_t> sizes;
+  offsets_.resize(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    const auto size = inputs_[i]->size();
+    inputs_[i]->childAt(keyChannel_).toOperand(&keys[i]);
+    instructions[i].opCode = hashjoin::OpCode::kCountMatches;
+    auto& countMatches = instructions[i]._.countMatches;
+    countMatches.table = table_->table;
+    countMatches.key = &keys[i];
+    countMatches.counts =
+        arena.allocate<int32_t>(std::max(size, 1), offsets_[i]);
+    sizes.push_back(size);
+  }
+  runAndWait(makeLaunch(arena, sizes, instructions, 1, buffers));
+
+  // Turns the counts into the position of the first match of each row.
+  numMatches_.resize(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    auto* counts = offsets_[i]->as<int32_t>();
+    int32_t numMatches = 0;
+    for (auto row = 0; row < sizes[i]; ++row) {
+      const auto count = counts[row];
+      counts[row] = numMatches;
+      numMatches += count;
+    }
+    numMatches_[i] = numMatches;
+  }
+}
+
+int32_t HashProbe::canAdvance() {
+  if (!table_) {
+    return 0;
+  }
+  while (inputs_.empty() && !buffered_.empty()) {
+    countMatches();
+    if (std::accumulate(numMatches_.begin(), numMatches_.end(), 0) == 0) {
+      inputs_.clear();
+      offsets_.clear();
+      numMatches_.clear();
+    }
+  }
+  return std::accumulate(numMatches_.begin(), numMatches_.end(), 0);
+}
+
+void HashProbe::schedule(WaveStream& stream, int32_t maxRows) {
+  VELOX_CHECK(!inputs_.empty());
+  auto& arena = stream.arena();
+  const int32_t numColumns = outputColumns_.size();
+  const int32_t numBatches = inputs_.size();
+  auto exe = std::make_unique<Executable>();
+  auto& deviceData = exe->deviceData;
+  exe->outputOperands = outputIds_;
+  exe->operands =
+      arena.allocate<Operand>(numColumns, deviceData.emplace_back());
+
+  // The outputs of the Executable are in the order of their operand ids.
+  std::vector<int32_t> order(numColumns);
+  std::iota(order.begin(), order.end(), 0);
+  auto operandId = [&](int32_t column) {
+    return defines(Value(subfields_[column]))->id;
+  };
+  std::sort(order.begin(), order.end(), [&](int32_t left, int32_t right) {
+    return operandId(left) < operandId(right);
+  });
+  for (auto column : order) {
+    auto vector = WaveVector::create(outputType_->childAt(column), arena);
+    vector->resize(maxRows);
+    vector->toOperand(&exe->operands[column]);
+    exe->output.push_back(std::move(vector));
+  }
+
+  // Row numbers of the probe and build sides of the matches.
+  auto* probeRows = arena.allocate<int32_t>(maxRows, deviceData.emplace_back());
+  auto* buildRows = arena.allocate<int32_t>(maxRows, deviceData.emplace_back());
+  auto* probeInstructions = arena.allocate<hashjoin::Instruction>(
+      numBatches, deviceData.emplace_back());
+  auto* gatherInstructions = arena.allocate<hashjoin::Instruction>(
+      numBatches * numColumns, deviceData.emplace_back());
+  auto* inputOperands = arena.allocate<Operand>(
+      numBatches * (numColumns + 1), deviceData.emplace_back());
+  std::vector<int32_t> sizes;
+  int32_t firstMatch = 0;
+  for (auto i = 0; i < numBatches; ++i) {
+    auto* operands = inputOperands + i * (numColumns + 1);
+    inputs_[i]->childAt(keyChannel_).toOperand(&operands[numColumns]);
+    probeInstructions[i].opCode = hashjoin::OpCode::kProbe;
+    auto& probe = probeInstructions[i]._.probe;
+    probe.table = table_->table;
+    probe.key = &operands[numColumns];
+    probe.offsets = offsets_[i]->as<int32_t>();
+    probe.probeRows = probeRows + firstMatch;
+    probe.buildRows = buildRows + firstMatch;
+    sizes.push_back(inputs_[i]->size());
+
+    for (auto j = 0; j < numColumns; ++j) {
+      auto& instruction = gatherInstructions[i * numColumns + j];
+      instruction.opCode = hashjoin::OpCode::kGather;
+      auto& gather = instruction._.gather;
+      gather.type = fromCpuType(*outputType_->childAt(j));
+      if (outputColumns_[j].fromBuild) {
+        gather.input = &table_->table->columns[outputColumns_[j].channel];
+        gather.rows = buildRows + firstMatch;
+      } else {
+        inputs_[i]->childAt(outputColumns_[j].channel).toOperand(&operands[j]);
+        gather.input = &operands[j];
+        gather.rows = probeRows + firstMatch;
+      }
+      gather.numRows = numMatches_[i];
+      gather.result = &exe->operands[j];
+      gather.resultOffset = firstMatch;
+    }
+    firstMatch += numMatches_[i];
+  }
+  VELOX_CHECK_EQ(firstMatch, maxRows);
+  auto probeLaunch = makeLaunch(arena, sizes, probeInstructions, 1, deviceData);
+  auto gatherLaunch = makeLaunch(
+      arena, numMatches_, gatherInstructions, numColumns, deviceData);
+
+  // The probe input and the offsets of the matches stay live until the
+  // kernels are done.
+  for (auto& offsets : offsets_) {
+    deviceData.push_back(std::move(offsets));
+  }
+  exe->intermediates = std::move(inputs_);
+  inputs_.clear();
+  offsets_.clear();
+  numMatches_.clear();
+
+  folly::Range<Executable**> empty(nullptr, nullptr);
+  stream.prepareProgramLaunch(
+      id_,
+      maxRows,
+      empty,
+      bits::roundUp(maxRows, kBlockSize) / kBlockSize,
+      true,
+      nullptr);
+  stream.installExecutables(
+      folly::Range(&exe, 1),
+      [&](Stream* out, folly::Range<Executable**> exes) {
+        // The gathers read the row numbers written by all blocks of the probe,
+        // so they are a separate launch on the same stream.
+        run(*out, probeLaunch);
+        run(*out, gatherLaunch);
+        stream.markLaunch(*out, *exes[0]);
+      });
+}
+
+vector_size_t HashProbe::outputSize(WaveStream& stream) const {
+  auto& control = stream.launchControls(id_);
+  VELOX_CHECK(!control.empty());
+  return control[0]->inputRows;
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/JoinBridge.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// True if 'node' is an inner equi-join on a single integer key with fixed
+/// width output columns and both of its inputs can run on Wave. The build and
+/// probe sides must make the same choice because the Wave hash table is not
+/// visible to the CPU HashProbe and vice versa.
+bool isWaveHashJoin(const core::HashJoinNode& node);
+
+/// The device side hash table of a join with the memory it is in.
+struct WaveJoinTable {
+  hashjoin::JoinTable* table{nullptr};
+  std::vector<WaveBufferPtr> buffers;
+  // Backing memory for the Operands in 'table->columns'.
+  std::vector<WaveVectorPtr> columns;
+};
+
+/// Hands the hash table of a join from the build side WaveDrivers to the probe
+/// side WaveDrivers. The table is in the arena of 'this' so that it stays live
+/// after the build Drivers finish.
+class WaveJoinBridge : public exec::JoinBridge {
+ public:
+  /// Returns the bridge for the join 'planNodeId' in split group
+  /// 'splitGroupId' of 'task'. The bridge is made on first use and lives as
+  /// long as one of its users does.
+  static std::shared_ptr<WaveJoinBridge> get(
+      const exec::Task& task,
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
+  WaveJoinBridge();
+
+  GpuArena& arena() {
+    return *arena_;
+  }
+
+  /// Adds the input of one build Driver. The buffers of 'input' are in the
+  /// arena of the build Driver, which waits for the last build Driver to
+  /// make the table.
+  void addBuildInput(std::vector<WaveVectorPtr> input);
+
+  /// Returns the input of all build Drivers. Called by the last build Driver.
+  std::vector<WaveVectorPtr> takeBuildInput();
+
+  /// Sets the table and continues the probe Drivers waiting for it.
+  void setTable(std::unique_ptr<WaveJoinTable> table);
+
+  /// Returns the table if it is made. Otherwise returns nullptr and sets
+  /// 'future' to be realized when the table is made.
+  const WaveJoinTable* tableOrFuture(ContinueFuture* future);
+
+ private:
+  std::unique_ptr<GpuArena> arena_;
+  std::vector<WaveVectorPtr> buildInput_;
+  std::unique_ptr<WaveJoinTable> table_;
+};
+
+/// Makes the hash table of a join from all the input of the build side. The
+/// last build Driver to finish makes the table on device from the input of all
+/// build Drivers.
+class HashBuild : public WaveOperator {
+ public:
+  HashBuild(CompileState& state, const core::HashJoinNode& node);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void schedule(WaveStream& /*stream*/, int32_t /*maxRows*/) override {
+    VELOX_FAIL("HashBuild produces no output");
+  }
+
+  bool isFinished() const override {
+    return noMoreInput_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return 0;
+  }
+
+  std::string toString() const override {
+    return "HashBuild";
+  }
+
+ private:
+  void buildTable();
+
+  const core::PlanNodeId planNodeId_;
+  exec::DriverCtx* const driverCtx_;
+  std::shared_ptr<WaveJoinBridge> bridge_;
+
+  // The input channel of each column of the table. The key is first.
+  std::vector<int32_t> channels_;
+  std::vector<TypePtr> types_;
+
+  std::vector<WaveVectorPtr> buffered_;
+
+  // Realized when the last build Driver has made the table.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  bool noMoreInput_{false};
+};
+
+/// Joins batches of probe side input to the hash table of the build side. All
+/// buffered batches are probed in one kernel launch. The results gather the
+/// probe and build side columns through the row numbers of the matches.
+class HashProbe : public WaveOperator {
+ public:
+  HashProbe(CompileState& state, const core::HashJoinNode& node);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override {
+    noMoreInput_ |= noMoreInput;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && inputs_.empty();
+  }
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  std::string toString() const override {
+    return "HashProbe";
+  }
+
+ private:
+  struct OutputColumn {
+    // True if the column comes from the table, false if from the probe input.
+    bool fromBuild;
+    // Index of the column in the table or probe input.
+    int32_t channel;
+  };
+
+  // Moves 'buffered_' to 'inputs_' and counts the matches of each row.
+  void countMatches();
+
+  std::shared_ptr<WaveJoinBridge> bridge_;
+  const WaveJoinTable* table_{nullptr};
+  int32_t keyChannel_;
+  std::vector<OutputColumn> outputColumns_;
+
+  std::vector<WaveVectorPtr> buffered_;
+
+  // The batches being probed. For each, the position of the first match of
+  // each row in the result of the batch and the number of matches.
+  std::vector<WaveVectorPtr> inputs_;
+  std::vector<WaveBufferPtr> offsets_;
+  std::vector<int32_t> numMatches_;
+
+  bool noMoreInput_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/IdMap.cuh"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+#define VELOX_WAVE_RETURN_NOT_OK(_expr)            \
+  if (auto _ec = (_expr); _ec != ErrorCode::kOk) { \
+    return _ec;                                    \
+  }
+
+#ifdef NDEBUG
+#define LOG_TYPE_DISPATCH_ERROR(_kind)
+#else
+#define LOG_TYPE_DISPATCH_ERROR(_kind) \
+  printf("%s:%d: Unsupported type %d\n", __FILE__, __LINE__, _kind)
+#endif
+
+#define KEY_TYPE_DISPATCH(_func, _kindExpr, ...) \
+  [&]() {                                        \
+    auto _kind = (_kindExpr);                    \
+    switch (_kind) {                             \
+      case PhysicalType::kInt32:                 \
+        return _func<int32_t>(__VA_ARGS__);      \
+      case PhysicalType::kInt64:                 \
+        return _func<int64_t>(__VA_ARGS__);      \
+      default:                                   \
+        LOG_TYPE_DISPATCH_ERROR(_kind);          \
+        return ErrorCode::kError;                \
+    };                                           \
+  }()
+
+#define VALUE_TYPE_DISPATCH(_func, _kindExpr, ...) \
+  [&]() {                                          \
+    auto _kind = (_kindExpr);                      \
+    switch (_kind) {                               \
+      case PhysicalType::kInt8:                    \
+        return _func<int8_t>(__VA_ARGS__);         \
+      case PhysicalType::kInt16:                   \
+        return _func<int16_t>(__VA_ARGS__);        \
+      case PhysicalType::kInt32:                   \
+        return _func<int32_t>(__VA_ARGS__);        \
+      case PhysicalType::kInt64:                   \
+        return _func<int64_t>(__VA_ARGS__);        \
+      case PhysicalType::kFloat32:                 \
+        return _func<float>(__VA_ARGS__);          \
+      case PhysicalType::kFloat64:                 \
+        return _func<double>(__VA_ARGS__);         \
+      default:                                     \
+        LOG_TYPE_DISPATCH_ERROR(_kind);            \
+        return ErrorCode::kError;                  \
+    };                                             \
+  }()
+
+namespace facebook::velox::wave::hashjoin {
+
+namespace {
+
+struct BlockInfo {
+  int base;
+};
+
+__device__ inline bool isNullAt(Operand* op, int32_t row) {
+  return op->nulls && op->nulls[row] == kNull;
+}
+
+template <typename T>
+__device__ ErrorCode
+copyValue(Operand* input, int32_t row, Operand* result, int32_t resultRow) {
+  reinterpret_cast<T*>(result->base)[resultRow] = value<T>(input, row);
+  if (result->nulls) {
+    result->nulls[resultRow] = input->nulls ? input->nulls[row] : kNotNull;
+  }
+  return ErrorCode::kOk;
+}
+
+// Rows with a null key are copied but not chained, so that they never match.
+template <typename T>
+__device__ ErrorCode
+insert(JoinTable* table, Operand* key, int32_t row, int32_t tableRow) {
+  if (isNullAt(key, row)) {
+    table->nextRow[tableRow] = -1;
+    return ErrorCode::kOk;
+  }
+  auto* idMap = reinterpret_cast<IdMap<T>*>(table->idMap);
+  auto id = idMap->makeId(value<T>(key, row));
+  if (id == -1) {
+    return ErrorCode::kInsuffcientMemory;
+  }
+  table->nextRow[tableRow] = atomicExch(&table->firstRow[id], tableRow);
+  return ErrorCode::kOk;
+}
+
+template <typename T>
+__device__ int32_t
+firstMatchTyped(JoinTable* table, Operand* key, int32_t row) {
+  auto* idMap = reinterpret_cast<IdMap<T>*>(table->idMap);
+  auto id = idMap->findId(value<T>(key, row));
+  return id == 0 ? -1 : table->firstRow[id];
+}
+
+// Returns the first build row matching 'row' of 'key' or -1 if none.
+__device__ int32_t firstMatch(JoinTable* table, Operand* key, int32_t row) {
+  if (isNullAt(key, row)) {
+    return -1;
+  }
+  switch (table->keyType.kind) {
+    case PhysicalType::kInt32:
+      return firstMatchTyped<int32_t>(table, key, row);
+    case PhysicalType::kInt64:
+      return firstMatchTyped<int64_t>(table, key, row);
+    default:
+      LOG_TYPE_DISPATCH_ERROR(table->keyType.kind);
+      return -1;
+  }
+}
+
+__device__ ErrorCode run(BlockInfo* block, Build* build) {
+  auto* table = build->table;
+  auto row = block->base + threadIdx.x;
+  if (row >= build->inputs[table->keyColumn].size) {
+    return ErrorCode::kOk;
+  }
+  auto tableRow = build->rowOffset + row;
+  for (auto i = 0; i < table->numColumns; ++i) {
+    VELOX_WAVE_RETURN_NOT_OK(VALUE_TYPE_DISPATCH(
+        copyValue,
+        table->columnTypes[i].kind,
+        &build->inputs[i],
+        row,
+        &table->columns[i],
+        tableRow));
+  }
+  return KEY_TYPE_DISPATCH(
+      insert,
+      table->keyType.kind,
+      table,
+      &build->inputs[table->keyColumn],
+      row,
+      tableRow);
+}
+
+__device__ ErrorCode run(BlockInfo* block, CountMatches* countMatches) {
+  auto row = block->base + threadIdx.x;
+  if (row >= countMatches->key->size) {
+    return ErrorCode::kOk;
+  }
+  auto* table = countMatches->table;
+  int32_t count = 0;
+  for (auto match = firstMatch(table, countMatches->key, row); match != -1;
+       match = table->nextRow[match]) {
+    ++count;
+  }
+  countMatches->counts[row] = count;
+  return ErrorCode::kOk;
+}
+
+__device__ ErrorCode run(BlockInfo* block, Probe* probe) {
+  auto row = block->base + threadIdx.x;
+  if (row >= probe->key->size) {
+    return ErrorCode::kOk;
+  }
+  auto* table = probe->table;
+  auto out = probe->offsets[row];
+  for (auto match = firstMatch(table, probe->key, row); match != -1;
+       match = table->nextRow[match]) {
+    probe->probeRows[out] = row;
+    probe->buildRows[out] = match;
+    ++out;
+  }
+  return ErrorCode::kOk;
+}
+
+__device__ ErrorCode run(BlockInfo* block, Gather* gather) {
+  auto row = block->base + threadIdx.x;
+  if (row >= gather->numRows) {
+    return ErrorCode::kOk;
+  }
+  return VALUE_TYPE_DISPATCH(
+      copyValue,
+      gather->type.kind,
+      gather->input,
+      gather->rows[row],
+      gather->result,
+      gather->resultOffset + row);
+}
+
+__global__ void runPrograms(
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* blockStatusArray) {
+  int baseIndex = baseIndices ? baseIndices[blockIdx.x] : 0;
+  BlockInfo block = {
+      .base = (int)(blockDim.x * (blockIdx.x - baseIndex)),
+  };
+  auto& status = blockStatusArray[blockIdx.x];
+  auto& program = programs[blockIdx.x];
+  for (auto i = 0; i < program.numInstructions; ++i) {
+    if (status.errors[threadIdx.x] != ErrorCode::kOk) {
+      break;
+    }
+    auto& instruction = program.instructions[i];
+    switch (instruction.opCode) {
+      case OpCode::kBuild:
+        status.errors[threadIdx.x] = run(&block, &instruction._.build);
+        break;
+      case OpCode::kCountMatches:
+        status.errors[threadIdx.x] = run(&block, &instruction._.countMatches);
+        break;
+      case OpCode::kProbe:
+        status.errors[threadIdx.x] = run(&block, &instruction._.probe);
+        break;
+      case OpCode::kGather:
+        status.errors[threadIdx.x] = run(&block, &instruction._.gather);
+        break;
+      default:
+#ifndef NDEBUG
+        printf(
+            "%s:%d: Unsupported OpCode %d\n",
+            __FILE__,
+            __LINE__,
+            instruction.opCode);
+#endif
+        status.errors[threadIdx.x] = ErrorCode::kError;
+    }
+  }
+}
+
+} // namespace
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* status) {
+  runPrograms<<<numBlocks, kBlockSize, 0, stream.stream()->stream>>>(
+      programs, baseIndices, status);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::hashjoin
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/exec/ErrorCode.h"
+
+namespace facebook::velox::wave::hashjoin {
+
+/// Device side hash table of a hash join. The distinct keys are numbered by
+/// 'idMap'. The build rows with the same key are chained from 'firstRow' of the
+/// key's id through 'nextRow'. The key and dependent columns of the build rows
+/// are copied to 'columns'.
+struct JoinTable {
+  PhysicalType keyType;
+  // IdMap of 'keyType'.
+  void* idMap;
+  // First build row for each key id. -1 terminates a chain.
+  int32_t* firstRow;
+  // Next build row with the same key for each build row.
+  int32_t* nextRow;
+  int32_t numRows;
+  int32_t numColumns;
+  // Index of the key in 'columns'.
+  int32_t keyColumn;
+  PhysicalType* columnTypes;
+  Operand* columns;
+};
+
+/// Copies the rows of a build side batch to 'table' starting at 'rowOffset' and
+/// adds them to the chains of their keys.
+struct Build {
+  JoinTable* table;
+  // One operand for each of the table columns.
+  Operand* inputs;
+  int32_t rowOffset;
+};
+
+/// Sets 'counts' to the number of build rows matching each probe row.
+struct CountMatches {
+  JoinTable* table;
+  Operand* key;
+  int32_t* counts;
+};
+
+/// Writes the probe and build row numbers of the matches of each probe row,
+/// starting at the probe row's position in 'offsets'.
+struct Probe {
+  JoinTable* table;
+  Operand* key;
+  int32_t* offsets;
+  int32_t* probeRows;
+  int32_t* buildRows;
+};
+
+/// Sets 'result' at 'resultOffset + i' to 'input' at 'rows[i]' for 'numRows'
+/// rows.
+struct Gather {
+  PhysicalType type;
+  Operand* input;
+  int32_t* rows;
+  int32_t numRows;
+  Operand* result;
+  int32_t resultOffset;
+};
+
+enum class OpCode {
+  kBuild,
+  kCountMatches,
+  kProbe,
+  kGather,
+};
+
+struct Instruction {
+  OpCode opCode;
+  union {
+    Build build;
+    CountMatches countMatches;
+    Probe probe;
+    Gather gather;
+  } _;
+};
+
+struct ThreadBlockProgram {
+  int32_t numInstructions;
+  Instruction* instructions;
+};
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* status);
+
+} // namespace facebook::velox::wave::hashjoin
@@ -17,6 +17,7 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/Values.h"
 #include "velox/experimental/wave/exec/WaveDriver.h"
@@ -326,6 +327,24 @@ bool CompileState::addOperator(
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "HashBuild") {
+    // The build side pipeline ends in the HashBuild, which is not one of the
+    // pipeline's plan nodes.
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.consumerNode.get());
+    if (!node || !isWaveHashJoin(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashBuild>(*this, *node));
+    outputType = ROW({}, {});
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    if (!node || !isWaveHashJoin(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashProbe>(*this, *node));
+    outputType = node->outputType();
   } else {
     return false;
   }
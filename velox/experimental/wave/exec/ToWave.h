@@ -74,6 +74,11 @@ class CompileState {
     return *arena_;
   }
 
+  /// The Driver whose Operators are replaced.
+  exec::Driver& driver() const {
+    return driver_;
+  }
+
  private:
   bool
   addOperator(exec::Operator* op, int32_t& nodeIndex, RowTypePtr& outputType);
@@ -17,6 +17,12 @@
 #include "velox/experimental/wave/exec/Wave.h"
 #include "velox/experimental/wave/exec/Vectors.h"
 
+DEFINE_bool(
+    velox_wave_pinned_staging,
+    true,
+    "Copy host data to the device from pinned host buffers with asynchronous "
+    "copies instead of writing it to unified memory.");
+
 namespace facebook::velox::wave {
 
 WaveStream::~WaveStream() {
@@ -113,6 +119,27 @@ void copyData(std::vector<Transfer>& transfers) {
     ::memcpy(transfer.to, transfer.from, transfer.size);
   }
 }
+
+// Copies the sources of 'transfers' to a pinned staging buffer and makes the
+// transfers copy from there. The copy to the device can then run
+// asynchronously with kernels on other streams.
+StagingBufferPtr stageData(std::vector<Transfer>& transfers) {
+  uint64_t bytes = 0;
+  for (auto& transfer : transfers) {
+    bytes += bits::roundUp(transfer.size, 8);
+  }
+  if (bytes == 0) {
+    return nullptr;
+  }
+  auto staging = StagingPool::instance().get(bytes);
+  auto* data = staging->data();
+  for (auto& transfer : transfers) {
+    ::memcpy(data, transfer.from, transfer.size);
+    transfer.from = data;
+    data += bits::roundUp(transfer.size, 8);
+  }
+  return staging;
+}
 } // namespace
 
 void Executable::startTransfer(
@@ -128,13 +155,26 @@ void Executable::startTransfer(
   exe->deviceData.push_back(operands);
   exe->operands = operands->as<Operand>();
   exe->outputOperands = outputOperands;
-  copyData(exe->transfers);
+  if (FLAGS_velox_wave_pinned_staging) {
+    exe->staging = stageData(exe->transfers);
+    for (auto& transfer : exe->transfers) {
+      waveStream.addStagedBytes(transfer.size);
+    }
+  } else {
+    copyData(exe->transfers);
+  }
   auto* device = waveStream.device();
   waveStream.installExecutables(
       folly::Range(&exe, 1),
       [&](Stream* stream, folly::Range<Executable**> executables) {
-        for (auto& transfer : executables[0]->transfers) {
-          stream->prefetch(device, transfer.to, transfer.size);
+        auto* transferExe = executables[0];
+        for (auto& transfer : transferExe->transfers) {
+          if (transferExe->staging) {
+            stream->hostToDeviceAsync(
+                transfer.to, transfer.from, transfer.size);
+          } else {
+            stream->prefetch(device, transfer.to, transfer.size);
+          }
         }
         waveStream.markLaunch(*stream, *executables[0]);
       });
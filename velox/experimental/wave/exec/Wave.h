@@ -23,6 +23,7 @@
 #include "velox/type/Subfield.h"
 
 #include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/common/StagingPool.h"
 #include "velox/experimental/wave/exec/ExprKernel.h"
 #include "velox/experimental/wave/vector/WaveVector.h"
 
@@ -131,6 +132,10 @@ struct Executable {
   // If this represents data transfer, the ranges to transfer.
   std::vector<Transfer> transfers;
 
+  // Pinned host memory the 'transfers' are copied from. nullptr if the data is
+  // copied directly to unified memory.
+  StagingBufferPtr staging;
+
   // The stream on which this is enqueued. Set by
   // WaveStream::installExecutables(). Cleared after the kernel containing this
   // is seen to realize dependent event.
@@ -299,6 +304,16 @@ class WaveStream {
   Device* device() const {
     return getDevice();
   }
+
+  /// Returns the bytes copied to the device through pinned staging buffers.
+  int64_t stagedBytes() const {
+    return stagedBytes_;
+  }
+
+  void addStagedBytes(int64_t bytes) {
+    stagedBytes_ += bytes;
+  }
+
   /// Returns a new stream, assigns it an id and keeps it owned by 'this'. The
   /// Stream will be returned to the static pool of streams on destruction of
   /// 'this'.
@@ -371,6 +386,8 @@ class WaveStream {
       launchControl_;
 
   folly::F14FastMap<int32_t, WaveBufferPtr> extraData_;
+
+  int64_t stagedBytes_{0};
 };
 
 /// Describes all the control data for launching a kernel executing
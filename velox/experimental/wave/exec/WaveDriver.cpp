@@ -18,6 +18,13 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_streams_per_pipeline,
+    4,
+    "Maximum number of batches in flight on the device in each pipeline of a "
+    "WaveDriver. More than one lets the transfer of a batch overlap with the "
+    "kernels of the previous ones.");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -96,6 +103,10 @@ RowVectorPtr WaveDriver::getOutput() {
       running = true;
     }
     if (!running) {
+      if (checkBlocked()) {
+        VLOG(1) << "Blocked";
+        return nullptr;
+      }
       VLOG(1) << "No more output";
       finished_ = true;
       return nullptr;
@@ -103,6 +114,30 @@ RowVectorPtr WaveDriver::getOutput() {
   }
 }
 
+exec::BlockingReason WaveDriver::isBlocked(ContinueFuture* future) {
+  if (blockingFuture_.valid() || checkBlocked()) {
+    *future = std::move(blockingFuture_);
+    return blockingReason_;
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
+bool WaveDriver::checkBlocked() {
+  if (blockingFuture_.valid()) {
+    return true;
+  }
+  for (auto& pipeline : pipelines_) {
+    for (auto& op : pipeline.operators) {
+      auto reason = op->isBlocked(&blockingFuture_);
+      if (reason != exec::BlockingReason::kNotBlocked) {
+        blockingReason_ = reason;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 bool WaveDriver::streamAtEnd(WaveStream& stream) {
   return true;
 }
@@ -148,6 +183,10 @@ RowVectorPtr WaveDriver::makeResult(
 void WaveDriver::startMore() {
   for (int i = 0; i < pipelines_.size(); ++i) {
     auto& ops = pipelines_[i].operators;
+    if (pipelines_[i].streams.size() >=
+        FLAGS_velox_wave_max_streams_per_pipeline) {
+      continue;
+    }
     if (auto rows = ops[0]->canAdvance()) {
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
       auto stream = std::make_unique<WaveStream>(*arena_);
@@ -157,12 +196,31 @@ void WaveDriver::startMore() {
       if (i == pipelines_.size() - 1) {
         prefetchReturn(*stream);
       }
+      recordStreamStats(*stream);
       pipelines_[i].streams.push_back(std::move(stream));
       break;
     }
   }
 }
 
+void WaveDriver::recordStreamStats(WaveStream& stream) {
+  int32_t numPending = 0;
+  for (auto& pipeline : pipelines_) {
+    numPending += pipeline.streams.size();
+  }
+  // The transfers of a stream started while others are pending overlap with
+  // the kernels of those.
+  addRuntimeStat("waveStreamsInFlight", RuntimeCounter(numPending + 1));
+  if (numPending > 0) {
+    addRuntimeStat("waveOverlappedStreams", RuntimeCounter(1));
+  }
+  if (stream.stagedBytes() > 0) {
+    addRuntimeStat(
+        "waveStagedBytes",
+        RuntimeCounter(stream.stagedBytes(), RuntimeCounter::Unit::kBytes));
+  }
+}
+
 void WaveDriver::prefetchReturn(WaveStream& stream) {
   // Schedule return buffers from last op to be on host side.
 }
@@ -179,7 +237,9 @@ LaunchControl* WaveDriver::inputControl(
     for (auto i = operatorId - 1; i >= 0; --i) {
       if (i == 0 || pipeline.operators[i]->isFilter() ||
           pipeline.operators[i]->isExpanding()) {
-        return stream.launchControls(i).back().get();
+        return stream.launchControls(pipeline.operators[i]->operatorId())
+            .back()
+            .get();
       }
     }
   }
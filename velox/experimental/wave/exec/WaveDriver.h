@@ -39,13 +39,7 @@ class WaveDriver : public exec::SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  exec::BlockingReason isBlocked(ContinueFuture* future) override {
-    if (blockingFuture_.valid()) {
-      *future = std::move(blockingFuture_);
-      return blockingReason_;
-    }
-    return exec::BlockingReason::kNotBlocked;
-  }
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -87,6 +81,14 @@ class WaveDriver : public exec::SourceOperator {
   // and there is space in the arena.
   void startMore();
 
+  // Sets 'blockingFuture_' and 'blockingReason_' from the first WaveOperator
+  // that is blocked. Returns true if one is blocked.
+  bool checkBlocked();
+
+  // Adds runtime stats on in flight streams and staged transfers when starting
+  // 'stream'.
+  void recordStreamStats(WaveStream& stream);
+
   // Enqueus a prefetch from device to host for the buffers of output vectors.
   void prefetchReturn(WaveStream& stream);
 
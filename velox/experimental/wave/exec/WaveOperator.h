@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Driver.h"
 #include "velox/experimental/wave/exec/Wave.h"
 #include "velox/experimental/wave/vector/WaveVector.h"
 
@@ -62,6 +63,12 @@ class WaveOperator {
     return nullptr;
   }
 
+  /// Returns the reason 'this' cannot make progress and sets 'future' to be
+  /// realized when it can, e.g. a hash probe waiting for its build side.
+  virtual exec::BlockingReason isBlocked(ContinueFuture* /*future*/) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
   /// Returns how many rows of output are available from 'this'. Source
   /// operators and cardinality increasing operators must return a correct
   /// answer if they are ready to produce data. Others should return 0.
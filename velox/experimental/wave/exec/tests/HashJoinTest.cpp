@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+  }
+};
+
+TEST_F(HashJoinTest, singleKey) {
+  constexpr int kProbeSize = 100;
+  auto probe = makeRowVector(
+      {"c0", "c1"},
+      {
+          makeFlatVector<int64_t>(kProbeSize, [](int i) { return i % 10; }),
+          makeFlatVector<int64_t>(kProbeSize, folly::identity),
+      });
+  // Keys 0 to 4, each twice.
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(10, [](int i) { return i % 5; }),
+          makeFlatVector<double>(10, [](int i) { return i * 0.5; }),
+      });
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan = PlanBuilder(planNodeIdGenerator).values({build}).planNode();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin({"c0"}, {"u0"}, buildPlan, "", {"c0", "c1", "u1"})
+                  .planNode();
+
+  std::vector<int64_t> keys;
+  std::vector<int64_t> probeValues;
+  std::vector<double> buildValues;
+  for (auto i = 0; i < kProbeSize; ++i) {
+    for (auto j = 0; j < 10; ++j) {
+      if (i % 10 == j % 5) {
+        keys.push_back(i % 10);
+        probeValues.push_back(i);
+        buildValues.push_back(j * 0.5);
+      }
+    }
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(keys),
+      makeFlatVector<int64_t>(probeValues),
+      makeFlatVector<double>(buildValues),
+  });
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+TEST_F(HashJoinTest, multipleBatches) {
+  std::vector<RowVectorPtr> probe;
+  std::vector<RowVectorPtr> build;
+  for (auto batch = 0; batch < 4; ++batch) {
+    probe.push_back(makeRowVector(
+        {"c0", "c1"},
+        {
+            makeFlatVector<int32_t>(
+                1000, [&](int i) { return batch * 1000 + i; }),
+            makeFlatVector<int32_t>(1000, [](int i) { return i % 7; }),
+        }));
+  }
+  // Matches every third probe row.
+  for (auto batch = 0; batch < 2; ++batch) {
+    build.push_back(makeRowVector(
+        {"u0"},
+        {makeFlatVector<int32_t>(
+            700, [&](int i) { return (batch * 700 + i) * 3; })}));
+  }
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      PlanBuilder(planNodeIdGenerator).values(build).planNode(),
+                      "",
+                      {"c0", "c1"})
+                  .planNode();
+
+  std::vector<int32_t> keys;
+  std::vector<int32_t> values;
+  for (auto i = 0; i < 4000; i += 3) {
+    keys.push_back(i);
+    values.push_back(i % 1000 % 7);
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(keys),
+      makeFlatVector<int32_t>(values),
+  });
+  AssertQueryBuilder(plan).assertResults(expected);
+}
+
+} // namespace
+} // namespace facebook::velox::wave
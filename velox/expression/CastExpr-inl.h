@@ -16,6 +16,7 @@
 #pragma once
 
 #include <charconv>
+#include <limits>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/core/CoreTypeSystem.h"
@@ -126,6 +127,25 @@ StringView convertToStringView(
   return StringView(startPosition, writePosition - startPosition);
 }
 
+template <TypeKind Kind>
+constexpr bool isIntegralKind() {
+  return Kind == TypeKind::TINYINT || Kind == TypeKind::SMALLINT ||
+      Kind == TypeKind::INTEGER || Kind == TypeKind::BIGINT;
+}
+
+template <TypeKind Kind>
+constexpr bool isStringKind() {
+  return Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY;
+}
+
+// Upper bound of the characters of an integer of 'Kind' in base 10,
+// including the sign.
+template <TypeKind Kind>
+constexpr int32_t maxIntegralChars() {
+  using T = typename TypeTraits<Kind>::NativeType;
+  return std::numeric_limits<T>::digits10 + 2;
+}
+
 } // namespace
 
 template <bool adjustForTimeZone>
@@ -221,6 +241,27 @@ void CastExpr::applyCastKernel(
           return;
         }
       }
+      // TRY_CAST of text that cannot be an integer sets a null without
+      // throwing.
+      if constexpr (isIntegralKind<ToKind>() && !Truncate) {
+        if (setNullInResultAtError() &&
+            !util::mayBeIntegral(folly::StringPiece(inputRowValue))) {
+          result->setNull(row, true);
+          return;
+        }
+      }
+    }
+
+    // Integers are formatted in place instead of through a std::string.
+    if constexpr (isStringKind<ToKind>() && isIntegralKind<FromKind>()) {
+      auto writer = exec::StringWriter<>(result, row);
+      writer.resize(maxIntegralChars<FromKind>());
+      auto [position, errorCode] = std::to_chars(
+          writer.data(), writer.data() + writer.size(), inputRowValue);
+      VELOX_DCHECK(errorCode == std::errc());
+      writer.resize(position - writer.data());
+      writer.finalize();
+      return;
     }
 
     auto output = util::Converter<ToKind, void, Truncate, LegacyCast>::cast(
@@ -504,6 +545,12 @@ void CastExpr::applyCastPrimitives(
   const auto& queryConfig = context.execCtx()->queryCtx()->queryConfig();
   auto& resultType = resultFlatVector->type();
 
+  if constexpr (isStringKind<ToKind>() && isIntegralKind<FromKind>()) {
+    // Reserves space for the formatted integers of all rows at once.
+    resultFlatVector->getBufferWithSpace(
+        rows.countSelected() * maxIntegralChars<FromKind>());
+  }
+
   if (!queryConfig.isCastToIntByTruncate()) {
     if (!queryConfig.isLegacyCast()) {
       applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
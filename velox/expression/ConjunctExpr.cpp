@@ -127,6 +127,7 @@ void ConjunctExpr::evalSpecialForm(
   auto activeRows = activeRowsHolder.get();
   VELOX_DCHECK(activeRows != nullptr);
   int32_t numActive = activeRows->countSelected();
+  const int32_t numRows = numActive;
   for (int32_t i = 0; i < inputs_.size(); ++i) {
     VectorPtr inputResult;
     VectorRecycler inputResultRecycler(inputResult, context.vectorPool());
@@ -135,15 +136,16 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
     if (evaluatesArgumentsOnNonIncreasingSelection()) {
       // Exclude loading rows that we know for sure will have a false result.
+      // The loading is not timed since it is not a cost of this input.
       for (auto* field : inputs_[inputOrder_[i]]->distinctFields()) {
         if (multiplyReferencedFields_.count(field) > 0) {
           context.ensureFieldLoaded(field->index(context), *activeRows);
         }
       }
     }
+    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
     inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
     if (context.errors()) {
       handleErrors = true;
@@ -178,11 +180,21 @@ void ConjunctExpr::evalSpecialForm(
     reorderEnabledChecked_ = true;
   }
   if (reorderEnabled_) {
-    maybeReorderInputs();
+    maybeReorderInputs(numRows);
   }
 }
 
-void ConjunctExpr::maybeReorderInputs() {
+void ConjunctExpr::maybeReorderInputs(int32_t numRows) {
+  numRowsSinceDecay_ += numRows;
+  if (numRowsSinceDecay_ >= kDecayRows) {
+    for (auto& selectivity : selectivity_) {
+      selectivity.decay();
+    }
+    numRowsSinceDecay_ = 0;
+  }
+  // The expected cost of an input per row is its time per row times the
+  // fraction of rows that reach it. Sorting by time per dropped row minimizes
+  // the sum if the inputs are independent.
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
     if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
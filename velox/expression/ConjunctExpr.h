@@ -23,6 +23,9 @@ namespace facebook::velox::exec {
 
 class ConjunctExpr : public SpecialForm {
  public:
+  /// Number of evaluated rows after which the input statistics are decayed.
+  static constexpr int64_t kDecayRows = 1 << 20;
+
   ConjunctExpr(
       TypePtr type,
       std::vector<ExprPtr>&& inputs,
@@ -74,7 +77,9 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
-  void maybeReorderInputs();
+  // Sorts the inputs by the time per dropped row of the recent batches.
+  // 'numRows' is the number of rows of the batch just evaluated.
+  void maybeReorderInputs(int32_t numRows);
 
   void updateResult(
       BaseVector* inputResult,
@@ -96,8 +101,11 @@ class ConjunctExpr : public SpecialForm {
   BufferPtr tempNulls_;
   bool reorderEnabledChecked_ = false;
   bool reorderEnabled_;
+  // Time and pass rate of each input. Decayed every kDecayRows rows so that
+  // the order follows changes in the data.
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  int64_t numRowsSinceDecay_{0};
 
   friend class ConjunctCallToSpecialForm;
 };
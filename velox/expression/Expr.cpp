@@ -21,6 +21,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/process/SamplingProfiler.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/core/Expressions.h"
@@ -1000,17 +1001,31 @@ Expr::PeelEncodingsResult Expr::peelEncodings(
     context.setPeeled(fieldIndex, peeledVectors[i]);
   }
 
-  // If the expression depends on one dictionary, results are cacheable.
+  // If the expression depends on one dictionary and otherwise only on
+  // constants, results are cacheable. The memo is keyed on the base of the
+  // dictionary and the values of the constants.
   bool mayCache = false;
-  if (context.cacheEnabled()) {
-    mayCache = distinctFields_.size() == 1 &&
-        VectorEncoding::isDictionary(context.wrapEncoding()) &&
-        !peeledVectors[0]->memoDisabled();
+  int32_t memoField = 0;
+  if (context.cacheEnabled() &&
+      VectorEncoding::isDictionary(context.wrapEncoding())) {
+    int32_t numNonConstant = 0;
+    for (auto i = 0; i < peeledVectors.size(); ++i) {
+      if (!peeledVectors[i]->isConstantEncoding()) {
+        ++numNonConstant;
+        memoField = i;
+      }
+    }
+    // The memo holds the base and a result per base position. Very large
+    // bases, e.g. a file-wide dictionary, are not memoized.
+    mayCache = numNonConstant == 1 &&
+        !peeledVectors[memoField]->memoDisabled() &&
+        peeledVectors[memoField]->size() <=
+            context.execCtx()->exprMaxMemoBaseSize();
   }
 
   common::testutil::TestValue::adjust(
       "facebook::velox::exec::Expr::peelEncodings::mayCache", &mayCache);
-  return {newRows, finalRowsHolder.get(), mayCache};
+  return {newRows, finalRowsHolder.get(), mayCache, memoField};
 }
 
 void Expr::evalEncodings(
@@ -1042,14 +1057,20 @@ void Expr::evalEncodings(
             newRowsHolder,
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
+        ++stats_.numPeelAttempts;
         if (newRows) {
+          ++stats_.numPeeled;
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity vector
           // if all selected values we are waiting for are nulls. So, here we
           // check for such a case.
           if (newRows->hasSelections()) {
             if (peelEncodingsResult.mayCache) {
-              evalWithMemo(*newRows, context, peeledResult);
+              evalWithMemo(
+                  *newRows,
+                  context,
+                  peeledResult,
+                  peelEncodingsResult.memoField);
             } else {
               evalWithNulls(*newRows, context, peeledResult);
             }
@@ -1151,18 +1172,49 @@ void Expr::evalWithNulls(
 // be memory intensive. Therefore in order to reduce this consumption and ensure
 // it is only employed for cases where it can be useful, it only starts caching
 // result after it encounters the same base at least twice.
+bool Expr::memoConstantsMatch(const EvalCtx& context, int32_t memoField)
+    const {
+  if (memoConstants_.size() != distinctFields_.size()) {
+    return false;
+  }
+  for (auto i = 0; i < distinctFields_.size(); ++i) {
+    if (i == memoField) {
+      continue;
+    }
+    const auto& constant =
+        context.getField(distinctFields_[i]->index(context));
+    if (memoConstants_[i] == nullptr ||
+        !memoConstants_[i]->equalValueAt(constant.get(), 0, 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Expr::setMemoConstants(const EvalCtx& context, int32_t memoField) {
+  memoConstants_.resize(distinctFields_.size());
+  for (auto i = 0; i < distinctFields_.size(); ++i) {
+    memoConstants_[i] = i == memoField
+        ? nullptr
+        : context.getField(distinctFields_[i]->index(context));
+  }
+}
+
 void Expr::evalWithMemo(
     const SelectivityVector& rows,
     EvalCtx& context,
-    VectorPtr& result) {
+    VectorPtr& result,
+    int32_t memoField) {
   VectorPtr base;
-  distinctFields_[0]->evalSpecialForm(rows, context, base);
+  distinctFields_[memoField]->evalSpecialForm(rows, context, base);
 
   if (base.get() != baseOfDictionaryRawPtr_ ||
-      baseOfDictionaryWeakPtr_.expired()) {
+      baseOfDictionaryWeakPtr_.expired() ||
+      !memoConstantsMatch(context, memoField)) {
     baseOfDictionaryRepeats_ = 0;
     baseOfDictionaryWeakPtr_ = base;
     baseOfDictionaryRawPtr_ = base.get();
+    setMemoConstants(context, memoField);
     context.releaseVector(baseOfDictionary_);
     context.releaseVector(dictionaryCache_);
     evalWithNulls(rows, context, result);
@@ -1471,6 +1523,7 @@ void Expr::applyFunction(
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
   auto timer = cpuWallTimer();
+  process::ScopedProfileFrame profileFrame(name());
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
   auto isAscii = type()->isVarchar()
@@ -1681,6 +1734,13 @@ common::Subfield extractSubfield(
       default:
         return {};
     }
+    // A non-positive array index needs all elements, e.g. element_at() counts
+    // negative indices from the end.
+    if (expr->inputs()[0]->type()->isArray() &&
+        static_cast<const common::Subfield::LongSubscript*>(path.back().get())
+                ->index() <= 0) {
+      return {};
+    }
     expr = expr->inputs()[0].get();
   }
 }
@@ -1710,9 +1770,14 @@ std::vector<common::Subfield> Expr::extractSubfields() const {
 ExprSet::ExprSet(
     const std::vector<core::TypedExprPtr>& sources,
     core::ExecCtx* execCtx,
-    bool enableConstantFolding)
-    : execCtx_(execCtx) {
+    bool enableConstantFolding,
+    ExprCompileCache* compileCache)
+    : execCtx_(execCtx),
+      compileCache_(compileCache),
+      profileSampleRate_(
+          execCtx->queryCtx()->queryConfig().exprProfileSampleRate()) {
   exprs_ = compileExpressions(sources, execCtx, this, enableConstantFolding);
+  profiles_.resize(exprs_.size());
   std::vector<FieldReference*> allDistinctFields;
   for (auto& expr : exprs_) {
     Expr::mergeFields(
@@ -1748,6 +1813,20 @@ std::string makeUuid() {
 }
 } // namespace
 
+std::vector<ExprProfile> ExprSet::profiles() const {
+  auto profiles = profiles_;
+  for (auto i = 0; i < exprs_.size(); ++i) {
+    std::unordered_map<std::string, exec::ExprStats> stats;
+    std::unordered_set<const exec::Expr*> uniqueExprs;
+    addStats(*exprs_[i], stats, uniqueExprs);
+    for (const auto& [name, exprStats] : stats) {
+      profiles[i].numPeelAttempts += exprStats.numPeelAttempts;
+      profiles[i].numPeeled += exprStats.numPeeled;
+    }
+  }
+  return profiles;
+}
+
 std::unordered_map<std::string, exec::ExprStats> ExprSet::stats() const {
   std::unordered_map<std::string, exec::ExprStats> stats;
   std::unordered_set<const exec::Expr*> uniqueExprs;
@@ -1883,11 +1962,37 @@ void ExprSet::eval(
     return;
   }
 
+  if (profileSampleRate_ > 0 && numEvals_++ % profileSampleRate_ == 0) {
+    for (int32_t i = begin; i < end; ++i) {
+      evalProfiled(i, rows, context, result[i]);
+    }
+    return;
+  }
+
   for (int32_t i = begin; i < end; ++i) {
     exprs_[i]->eval(rows, context, result[i], this);
   }
 }
 
+void ExprSet::evalProfiled(
+    int32_t index,
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  auto& profile = profiles_[index];
+  {
+    CpuWallTimer timer(profile.timing);
+    exprs_[index]->eval(rows, context, result, this);
+  }
+  ++profile.numSampledVectors;
+  profile.numSampledRows += rows.countSelected();
+  if (result && result->mayHaveNulls()) {
+    rows.applyToSelected([&](auto row) {
+      profile.numSampledNullRows += result->isNullAt(row);
+    });
+  }
+}
+
 void ExprSet::clearSharedSubexprs() {
   for (auto& expr : toReset_) {
     expr->reset();
@@ -1921,12 +2026,14 @@ void ExprSetSimplified::eval(
 
 std::unique_ptr<ExprSet> makeExprSetFromFlag(
     std::vector<core::TypedExprPtr>&& source,
-    core::ExecCtx* execCtx) {
+    core::ExecCtx* execCtx,
+    ExprCompileCache* compileCache) {
   if (execCtx->queryCtx()->queryConfig().exprEvalSimplified() ||
       FLAGS_force_eval_simplified) {
     return std::make_unique<ExprSetSimplified>(std::move(source), execCtx);
   }
-  return std::make_unique<ExprSet>(std::move(source), execCtx);
+  return std::make_unique<ExprSet>(
+      std::move(source), execCtx, /*enableConstantFolding*/ true, compileCache);
 }
 
 std::string printExprWithStats(const exec::ExprSet& exprSet) {
@@ -44,6 +44,7 @@ DECLARE_string(velox_save_input_on_expression_system_failure_path);
 
 namespace facebook::velox::exec {
 
+class ExprCompileCache;
 class ExprSet;
 class FieldReference;
 class VectorFunction;
@@ -59,10 +60,17 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of attempts to peel off the encodings of the inputs and the
+  /// number of attempts that succeeded.
+  uint64_t numPeelAttempts{0};
+  uint64_t numPeeled{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numPeelAttempts += other.numPeelAttempts;
+    numPeeled += other.numPeeled;
   }
 
   std::string toString() const {
@@ -74,6 +82,26 @@ struct ExprStats {
   }
 };
 
+/// Runtime profile of a top level expression of an ExprSet collected on a
+/// sample of the batches. See QueryConfig::kExprProfileSampleRate.
+struct ExprProfile {
+  /// Time spent evaluating the whole expression tree in sampled batches.
+  CpuWallTiming timing;
+
+  /// Number of sampled batches.
+  uint64_t numSampledVectors{0};
+
+  /// Number of rows evaluated in sampled batches and the number of these
+  /// with a null result.
+  uint64_t numSampledRows{0};
+  uint64_t numSampledNullRows{0};
+
+  /// Peeling attempts and successes in all batches, summed over the
+  /// expression tree.
+  uint64_t numPeelAttempts{0};
+  uint64_t numPeeled{0};
+};
+
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -257,6 +285,7 @@ class Expr {
     baseOfDictionaryRawPtr_ = nullptr;
     dictionaryCache_ = nullptr;
     cachedDictionaryIndices_ = nullptr;
+    memoConstants_.clear();
   }
 
   const TypePtr& type() const {
@@ -400,9 +429,12 @@ class Expr {
     SelectivityVector* FOLLY_NULLABLE newRows;
     SelectivityVector* FOLLY_NULLABLE newFinalSelection;
     bool mayCache;
+    // Index in 'distinctFields_' of the dictionary-encoded field whose base
+    // keys the memo if 'mayCache' is true. The other fields are constant.
+    int32_t memoField;
 
     static PeelEncodingsResult empty() {
-      return {nullptr, nullptr, false};
+      return {nullptr, nullptr, false, 0};
     }
   };
 
@@ -422,7 +454,16 @@ class Expr {
   void evalWithMemo(
       const SelectivityVector& rows,
       EvalCtx& context,
-      VectorPtr& result);
+      VectorPtr& result,
+      int32_t memoField);
+
+  // Returns true if the constant fields, i.e. all fields other than
+  // 'memoField', have the values in 'memoConstants_'.
+  bool memoConstantsMatch(const EvalCtx& context, int32_t memoField) const;
+
+  // Saves the constant fields, i.e. all fields other than 'memoField', into
+  // 'memoConstants_'.
+  void setMemoConstants(const EvalCtx& context, int32_t memoField);
 
   void evalWithNulls(
       const SelectivityVector& rows,
@@ -633,6 +674,12 @@ class Expr {
   // The indices that are valid in 'dictionaryCache_'.
   std::unique_ptr<SelectivityVector> cachedDictionaryIndices_;
 
+  // The constant inputs 'dictionaryCache_' was computed with, 1:1 to
+  // 'distinctFields_'. nullptr for the dictionary-encoded field. A different
+  // constant, e.g. the next partition key, invalidates the memo like a new
+  // base.
+  std::vector<VectorPtr> memoConstants_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
@@ -663,10 +710,14 @@ using ExprPtr = std::shared_ptr<Expr>;
 // with partial loading.
 class ExprSet {
  public:
+  /// @param compileCache If not null, shares constant folding and function
+  /// resolution with the other ExprSets compiled with the same cache. See
+  /// ExprCompileCache.
   explicit ExprSet(
       const std::vector<core::TypedExprPtr>& source,
       core::ExecCtx* FOLLY_NONNULL execCtx,
-      bool enableConstantFolding = true);
+      bool enableConstantFolding = true,
+      ExprCompileCache* FOLLY_NULLABLE compileCache = nullptr);
 
   virtual ~ExprSet();
 
@@ -693,6 +744,10 @@ class ExprSet {
     return execCtx_;
   }
 
+  ExprCompileCache* FOLLY_NULLABLE compileCache() const {
+    return compileCache_;
+  }
+
   auto size() const {
     return exprs_.size();
   }
@@ -732,9 +787,22 @@ class ExprSet {
   /// evaluated.
   std::unordered_map<std::string, exec::ExprStats> stats() const;
 
+  /// Returns the sampled profile of each top level expression, 1:1 to
+  /// exprs(). Empty profiles unless QueryConfig::kExprProfileSampleRate is
+  /// set.
+  std::vector<ExprProfile> profiles() const;
+
  protected:
   void clearSharedSubexprs();
 
+  // Evaluates 'exprs_[index]' and records the time, rows and null results in
+  // 'profiles_[index]'.
+  void evalProfiled(
+      int32_t index,
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
   std::vector<std::shared_ptr<Expr>> exprs_;
 
   // The distinct references to input columns among all expressions in ExprSet.
@@ -750,6 +818,13 @@ class ExprSet {
   // Exprs which retain memoized state, e.g. from running over dictionaries.
   std::unordered_set<Expr*> memoizingExprs_;
   core::ExecCtx* FOLLY_NONNULL const execCtx_;
+  ExprCompileCache* FOLLY_NULLABLE const compileCache_;
+
+  // Every 'profileSampleRate_'th call to eval() is profiled. 0 if profiling
+  // is disabled.
+  const uint32_t profileSampleRate_;
+  uint64_t numEvals_{0};
+  std::vector<ExprProfile> profiles_;
 };
 
 class ExprSetSimplified : public ExprSet {
@@ -779,10 +854,12 @@ class ExprSetSimplified : public ExprSet {
 };
 
 // Factory method that takes `kExprEvalSimplified` (query parameter) into
-// account and instantiates the correct ExprSet class.
+// account and instantiates the correct ExprSet class. 'compileCache' is only
+// used by ExprSet.
 std::unique_ptr<ExprSet> makeExprSetFromFlag(
     std::vector<core::TypedExprPtr>&& source,
-    core::ExecCtx* FOLLY_NONNULL execCtx);
+    core::ExecCtx* FOLLY_NONNULL execCtx,
+    ExprCompileCache* FOLLY_NULLABLE compileCache = nullptr);
 
 /// Returns a string representation of the expression trees annotated with
 /// runtime statistics. Expected to be called after calling ExprSet::eval one or
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprCompileCache.h"
+
+namespace facebook::velox::exec {
+
+std::optional<ExprCompileCache::FoldedConstant>
+ExprCompileCache::foldedConstant(const core::ITypedExpr* expr) const {
+  auto entries = entries_.rlock();
+  auto it = entries->find(expr);
+  if (it == entries->end() || !it->second.folded.has_value()) {
+    return std::nullopt;
+  }
+  ++numHits_;
+  return it->second.folded;
+}
+
+void ExprCompileCache::addFoldedConstant(
+    const core::TypedExprPtr& expr,
+    VectorPtr value) {
+  auto entries = entries_.wlock();
+  auto& entry = entryLocked(*entries, expr);
+  if (!entry.folded.has_value()) {
+    entry.folded = FoldedConstant{std::move(value)};
+  }
+}
+
+std::shared_ptr<VectorFunction> ExprCompileCache::vectorFunction(
+    const core::ITypedExpr* call) const {
+  auto entries = entries_.rlock();
+  auto it = entries->find(call);
+  if (it == entries->end() || it->second.function == nullptr) {
+    return nullptr;
+  }
+  ++numHits_;
+  return it->second.function;
+}
+
+void ExprCompileCache::addVectorFunction(
+    const core::TypedExprPtr& call,
+    std::shared_ptr<VectorFunction> function) {
+  auto entries = entries_.wlock();
+  auto& entry = entryLocked(*entries, call);
+  if (entry.function == nullptr) {
+    entry.function = std::move(function);
+  }
+}
+
+ExprCompileCache::Entry& ExprCompileCache::entryLocked(
+    folly::F14FastMap<const core::ITypedExpr*, Entry>& entries,
+    const core::TypedExprPtr& expr) {
+  auto& entry = entries[expr.get()];
+  if (entry.expr == nullptr) {
+    entry.expr = expr;
+  }
+  return entry;
+}
+
+} // namespace facebook::velox::exec
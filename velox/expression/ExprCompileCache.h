@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/core/ITypedExpr.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::exec {
+
+class VectorFunction;
+
+/// Shares the immutable results of compiling the same expression trees
+/// between the ExprSets of one task, e.g. the FilterProjects of all drivers of
+/// a pipeline. Each ExprSet still has its own Expr tree, since Exprs keep
+/// per-evaluation state, but subtrees that fold to a constant are evaluated
+/// once and calls to stateless vector functions are resolved once.
+///
+/// Entries are keyed on the ITypedExpr nodes, which the cache keeps alive. The
+/// folded constants are allocated from the pool of the ExprSet that folded
+/// them, which must outlive the entries. Task keeps all operator pools until
+/// it is destroyed. Thread safe.
+class ExprCompileCache {
+ public:
+  /// The outcome of constant folding 'expr'. 'value' is null if folding
+  /// failed, in which case the subtree is compiled as is.
+  struct FoldedConstant {
+    VectorPtr value;
+  };
+
+  /// Returns the result of folding 'expr' by an earlier compilation, or
+  /// std::nullopt if 'expr' was not folded yet.
+  std::optional<FoldedConstant> foldedConstant(
+      const core::ITypedExpr* expr) const;
+
+  void addFoldedConstant(const core::TypedExprPtr& expr, VectorPtr value);
+
+  /// Returns the stateless vector function that 'call' resolved to in an
+  /// earlier compilation, or nullptr.
+  std::shared_ptr<VectorFunction> vectorFunction(
+      const core::ITypedExpr* call) const;
+
+  void addVectorFunction(
+      const core::TypedExprPtr& call,
+      std::shared_ptr<VectorFunction> function);
+
+  /// Returns the number of lookups that found an entry.
+  uint64_t numHits() const {
+    return numHits_;
+  }
+
+  size_t size() const {
+    return entries_.rlock()->size();
+  }
+
+  /// Drops all entries. Must be called before the pools of the folded
+  /// constants are destroyed.
+  void clear() {
+    entries_.wlock()->clear();
+  }
+
+ private:
+  struct Entry {
+    // Keeps the key alive so that its address is not reused.
+    core::TypedExprPtr expr;
+    std::optional<FoldedConstant> folded;
+    std::shared_ptr<VectorFunction> function;
+  };
+
+  Entry& entryLocked(
+      folly::F14FastMap<const core::ITypedExpr*, Entry>& entries,
+      const core::TypedExprPtr& expr);
+
+  folly::Synchronized<folly::F14FastMap<const core::ITypedExpr*, Entry>>
+      entries_;
+  mutable std::atomic<uint64_t> numHits_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -15,12 +15,17 @@
  */
 
 #include "velox/expression/ExprCompiler.h"
+
+#include <typeinfo>
+
 #include "velox/expression/CastExpr.h"
 #include "velox/expression/CoalesceExpr.h"
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprCompileCache.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -39,19 +44,93 @@ using core::TypedExprPtr;
 const char* const kAnd = "and";
 const char* const kOr = "or";
 
+// Returns the column name if 'expr' references a top level column. A column
+// may be referenced with or without an InputTypedExpr input. Parsed
+// expressions have the input, expressions built by hand or by a planner often
+// do not. Both forms must dedup to the same compiled Expr.
+const std::string* inputColumnName(const ITypedExpr* expr) {
+  auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr);
+  if (field == nullptr || !field->isInputColumn()) {
+    return nullptr;
+  }
+  return &field->name();
+}
+
+size_t structuralHash(const ITypedExpr* expr) {
+  size_t hash = bits::hashMix(expr->type()->hashKind(), expr->localHash());
+  if (inputColumnName(expr)) {
+    return hash;
+  }
+  for (const auto& input : expr->inputs()) {
+    hash = bits::hashMix(hash, structuralHash(input.get()));
+  }
+  return hash;
+}
+
+// Compares the non-input properties of 'lhs' and 'rhs'.
+bool equalsIgnoringInputs(const ITypedExpr* lhs, const ITypedExpr* rhs) {
+  if (typeid(*lhs) != typeid(*rhs) || *lhs->type() != *rhs->type()) {
+    return false;
+  }
+  if (auto* call = dynamic_cast<const core::CallTypedExpr*>(lhs)) {
+    return call->name() == static_cast<const core::CallTypedExpr*>(rhs)->name();
+  }
+  if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(lhs)) {
+    return cast->nullOnFailure() ==
+        static_cast<const core::CastTypedExpr*>(rhs)->nullOnFailure();
+  }
+  if (auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(lhs)) {
+    return field->name() ==
+        static_cast<const core::FieldAccessTypedExpr*>(rhs)->name();
+  }
+  if (auto* deref = dynamic_cast<const core::DereferenceTypedExpr*>(lhs)) {
+    return deref->index() ==
+        static_cast<const core::DereferenceTypedExpr*>(rhs)->index();
+  }
+  if (dynamic_cast<const core::ConcatTypedExpr*>(lhs)) {
+    return true;
+  }
+  // Constants and lambdas.
+  return *lhs == *rhs;
+}
+
+bool structurallyEqual(const ITypedExpr* lhs, const ITypedExpr* rhs) {
+  if (lhs == rhs) {
+    return true;
+  }
+  auto* lhsColumn = inputColumnName(lhs);
+  auto* rhsColumn = inputColumnName(rhs);
+  if (lhsColumn || rhsColumn) {
+    return lhsColumn && rhsColumn && *lhsColumn == *rhsColumn &&
+        *lhs->type() == *rhs->type();
+  }
+  if (lhs->inputs().size() != rhs->inputs().size() ||
+      !equalsIgnoringInputs(lhs, rhs)) {
+    return false;
+  }
+  for (auto i = 0; i < lhs->inputs().size(); ++i) {
+    if (!structurallyEqual(lhs->inputs()[i].get(), rhs->inputs()[i].get())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 struct ITypedExprHasher {
   size_t operator()(const ITypedExpr* expr) const {
-    return expr->hash();
+    return structuralHash(expr);
   }
 };
 
 struct ITypedExprComparer {
   bool operator()(const ITypedExpr* lhs, const ITypedExpr* rhs) const {
-    return *lhs == *rhs;
+    return structurallyEqual(lhs, rhs);
   }
 };
 
-// Map for deduplicating ITypedExpr trees.
+// Map for deduplicating ITypedExpr trees. Structurally equal trees compile to
+// one Expr, also across the expressions of one ExprSet, e.g. the filter and
+// projections of a FilterProject.
 using ExprDedupMap = folly::F14FastMap<
     const ITypedExpr*,
     std::shared_ptr<Expr>,
@@ -299,8 +378,23 @@ std::shared_ptr<Expr> compileLambda(
       config.exprTrackCpuUsage());
 }
 
-ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
+// Folds 'expr' compiled from 'source' into a ConstantExpr if it is constant.
+// The outcome is recorded in the compile cache of the ExprSet, if any.
+ExprPtr tryFoldIfConstant(
+    const ExprPtr& expr,
+    const TypedExprPtr& source,
+    Scope* scope) {
   if (expr->isConstant() && scope->exprSet->execCtx()) {
+    auto* compileCache = scope->exprSet->compileCache();
+    if (compileCache) {
+      // Folded by another compile since compileRewrittenExpression() looked.
+      if (auto folded = compileCache->foldedConstant(source.get())) {
+        if (folded->value) {
+          return std::make_shared<ConstantExpr>(folded->value);
+        }
+        return expr;
+      }
+    }
     try {
       auto rowType = ROW({}, {});
       auto execCtx = scope->exprSet->execCtx();
@@ -311,6 +405,9 @@ ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
       SelectivityVector rows(1);
       expr->eval(rows, context, result);
       auto constantVector = BaseVector::wrapInConstant(1, 0, result);
+      if (compileCache) {
+        compileCache->addFoldedConstant(source, constantVector);
+      }
 
       return std::make_shared<ConstantExpr>(constantVector);
     }
@@ -326,11 +423,43 @@ ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
     // instance, if other arguments are all null in a function with default null
     // behavior), the query won't fail.
     catch (const VeloxUserError&) {
+      if (compileCache) {
+        compileCache->addFoldedConstant(source, nullptr);
+      }
     }
   }
   return expr;
 }
 
+// Returns the vector function for 'call' or nullptr if there is none. A
+// stateless function is resolved once per compile cache.
+std::shared_ptr<VectorFunction> getCachedVectorFunction(
+    const TypedExprPtr& expr,
+    const core::CallTypedExpr* call,
+    const std::vector<TypePtr>& inputTypes,
+    const std::vector<ExprPtr>& compiledInputs,
+    const core::QueryConfig& config,
+    ExprCompileCache* compileCache) {
+  if (compileCache == nullptr) {
+    return getVectorFunction(
+        call->name(), inputTypes, getConstantInputs(compiledInputs), config);
+  }
+  if (auto func = compileCache->vectorFunction(expr.get())) {
+    return func;
+  }
+  bool stateless = false;
+  auto func = getVectorFunction(
+      call->name(),
+      inputTypes,
+      getConstantInputs(compiledInputs),
+      config,
+      &stateless);
+  if (func && stateless) {
+    compileCache->addVectorFunction(expr, func);
+  }
+  return func;
+}
+
 /// Returns a vector aligned with exprs vector where elements that correspond to
 /// constant expressions are set to constant values of these expressions.
 /// Elements that correspond to non-constant expressions are set to null.
@@ -376,6 +505,18 @@ ExprPtr compileRewrittenExpression(
     return alreadyCompiled;
   }
 
+  auto* compileCache = scope->exprSet->compileCache();
+  if (enableConstantFolding && compileCache) {
+    auto folded = compileCache->foldedConstant(expr.get());
+    if (folded.has_value() && folded->value) {
+      // Folded by an earlier compile. The inputs need not be compiled.
+      auto result = std::make_shared<ConstantExpr>(folded->value);
+      result->computeMetadata();
+      scope->visited[expr.get()] = result;
+      return result;
+    }
+  }
+
   const bool trackCpuUsage = config.exprTrackCpuUsage();
 
   ExprPtr result;
@@ -411,11 +552,13 @@ ExprPtr compileRewrittenExpression(
             trackCpuUsage)) {
       result = specialForm;
     } else if (
-        auto func = getVectorFunction(
-            call->name(),
+        auto func = getCachedVectorFunction(
+            expr,
+            call,
             inputTypes,
-            getConstantInputs(compiledInputs),
-            config)) {
+            compiledInputs,
+            config,
+            compileCache)) {
       result = std::make_shared<Expr>(
           resultType,
           std::move(compiledInputs),
@@ -510,9 +653,16 @@ ExprPtr compileRewrittenExpression(
 
   result->computeMetadata();
 
+  if (config.exprFuseArithmetic()) {
+    if (auto fused = FusedArithmeticExpr::tryFuse(result)) {
+      fused->computeMetadata();
+      result = fused;
+    }
+  }
+
   // If the expression is constant folding it is redundant.
   auto folded = enableConstantFolding && !isConstantExpr
-      ? tryFoldIfConstant(result, scope)
+      ? tryFoldIfConstant(result, expr, scope)
       : result;
   scope->visited[expr.get()] = folded;
   return folded;
@@ -585,11 +735,23 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  std::vector<TypedExprPtr> rewrittenSources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto rewritten =
+        rewrite(rewrittenSources.empty() ? sources : rewrittenSources);
+    if (!rewritten.empty()) {
+      VELOX_CHECK_EQ(rewritten.size(), sources.size());
+      rewrittenSources = std::move(rewritten);
+    }
+  }
+  const auto& compiledSources =
+      rewrittenSources.empty() ? sources : rewrittenSources;
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(compiledSources);
 
-  for (auto& source : sources) {
+  for (auto& source : compiledSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
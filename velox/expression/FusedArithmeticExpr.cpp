@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedArithmeticExpr.h"
+
+#include <folly/Synchronized.h>
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+folly::Synchronized<std::unordered_map<std::string, FusedOp>>&
+fusedFunctions() {
+  static folly::Synchronized<std::unordered_map<std::string, FusedOp>>
+      functions;
+  return functions;
+}
+
+bool isComparison(FusedOp op) {
+  switch (op) {
+    case FusedOp::kEq:
+    case FusedOp::kNeq:
+    case FusedOp::kLt:
+    case FusedOp::kLte:
+    case FusedOp::kGt:
+    case FusedOp::kGte:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename Func>
+void arithmeticLoop(
+    const double* left,
+    const double* right,
+    int32_t numRows,
+    double* result,
+    Func func) {
+  for (auto i = 0; i < numRows; ++i) {
+    result[i] = func(left[i], right[i]);
+  }
+}
+
+void arithmeticBlock(
+    FusedOp op,
+    const double* left,
+    const double* right,
+    int32_t numRows,
+    double* result) {
+  switch (op) {
+    case FusedOp::kPlus:
+      arithmeticLoop(
+          left, right, numRows, result, [](auto l, auto r) { return l + r; });
+      break;
+    case FusedOp::kMinus:
+      arithmeticLoop(
+          left, right, numRows, result, [](auto l, auto r) { return l - r; });
+      break;
+    case FusedOp::kMultiply:
+      arithmeticLoop(
+          left, right, numRows, result, [](auto l, auto r) { return l * r; });
+      break;
+    case FusedOp::kDivide:
+      arithmeticLoop(
+          left, right, numRows, result, [](auto l, auto r) { return l / r; });
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Sets bit i of 'bits' to the result of comparing 'left[i]' and 'right[i]'.
+template <typename Func>
+void compareLoop(
+    const double* left,
+    const double* right,
+    int32_t numRows,
+    uint64_t* bits,
+    Func func) {
+  for (auto i = 0; i < numRows; i += 64) {
+    const auto numBits = std::min(64, numRows - i);
+    uint64_t word = 0;
+    for (auto j = 0; j < numBits; ++j) {
+      word |= static_cast<uint64_t>(func(left[i + j], right[i + j])) << j;
+    }
+    bits[i / 64] = word;
+  }
+}
+
+void compareBlock(
+    FusedOp op,
+    const double* left,
+    const double* right,
+    int32_t numRows,
+    uint64_t* bits) {
+  switch (op) {
+    case FusedOp::kEq:
+      compareLoop(
+          left, right, numRows, bits, [](auto l, auto r) { return l == r; });
+      break;
+    case FusedOp::kNeq:
+      compareLoop(
+          left, right, numRows, bits, [](auto l, auto r) { return l != r; });
+      break;
+    case FusedOp::kLt:
+      compareLoop(
+          left, right, numRows, bits, [](auto l, auto r) { return l < r; });
+      break;
+    case FusedOp::kLte:
+      compareLoop(
+          left, right, numRows, bits, [](auto l, auto r) { return l <= r; });
+      break;
+    case FusedOp::kGt:
+      compareLoop(
+          left, right, numRows, bits, [](auto l, auto r) { return l > r; });
+      break;
+    case FusedOp::kGte:
+      compareLoop(
+          left, right, numRows, bits, [](auto l, auto r) { return l >= r; });
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+bool isFusableInput(const ExprPtr& input) {
+  if (input->type()->kind() != TypeKind::DOUBLE) {
+    return false;
+  }
+  if (input->is<FusedArithmeticExpr>()) {
+    return true;
+  }
+  if (input->is<FieldReference>()) {
+    // Only top level fields. Dereferences of struct fields are not fused.
+    return input->inputs().empty();
+  }
+  if (auto* constant = input->as<ConstantExpr>()) {
+    return !constant->value()->isNullAt(0);
+  }
+  return false;
+}
+
+} // namespace
+
+void registerFusedFunction(const std::string& name, FusedOp op) {
+  fusedFunctions().wlock()->insert_or_assign(name, op);
+}
+
+std::optional<FusedOp> getFusedFunction(const std::string& name) {
+  auto functions = fusedFunctions().rlock();
+  auto it = functions->find(name);
+  if (it == functions->end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+// static
+ExprPtr FusedArithmeticExpr::tryFuse(const ExprPtr& expr) {
+  if (expr->isSpecialForm() || expr->inputs().size() != 2) {
+    return nullptr;
+  }
+  const auto op = getFusedFunction(expr->name());
+  if (!op.has_value()) {
+    return nullptr;
+  }
+  const auto resultKind =
+      isComparison(*op) ? TypeKind::BOOLEAN : TypeKind::DOUBLE;
+  if (expr->type()->kind() != resultKind) {
+    return nullptr;
+  }
+  for (const auto& input : expr->inputs()) {
+    if (!isFusableInput(input)) {
+      return nullptr;
+    }
+  }
+  return std::shared_ptr<FusedArithmeticExpr>(new FusedArithmeticExpr(expr));
+}
+
+FusedArithmeticExpr::FusedArithmeticExpr(const ExprPtr& original)
+    : SpecialForm(
+          original->type(),
+          {original},
+          "fused_arithmetic",
+          false /* supportsFlatNoNullsFastPath */,
+          false /* trackCpuUsage */) {
+  addProgram(original);
+  int32_t depth = 0;
+  for (const auto& instruction : program_) {
+    depth += instruction.kind == Instruction::Kind::kOp ? -1 : 1;
+    maxDepth_ = std::max(maxDepth_, depth);
+  }
+  VELOX_CHECK_EQ(depth, 1);
+  registers_.resize(maxDepth_ * kBlockSize);
+  resultValues_.resize(kBlockSize);
+  resultBits_.resize(kBlockSize / 64);
+}
+
+void FusedArithmeticExpr::addProgram(const ExprPtr& expr) {
+  auto addField = [&](FieldReference* field) {
+    auto it = std::find(fields_.begin(), fields_.end(), field);
+    program_.push_back(
+        {Instruction::Kind::kField,
+         static_cast<int32_t>(it - fields_.begin()),
+         FusedOp::kPlus});
+    if (it == fields_.end()) {
+      fields_.push_back(field);
+    }
+  };
+  auto addConstant = [&](double value) {
+    program_.push_back(
+        {Instruction::Kind::kConstant,
+         static_cast<int32_t>(constants_.size()),
+         FusedOp::kPlus});
+    constants_.push_back(value);
+  };
+
+  if (auto* fused = expr->as<FusedArithmeticExpr>()) {
+    for (const auto& instruction : fused->program_) {
+      switch (instruction.kind) {
+        case Instruction::Kind::kField:
+          addField(fused->fields_[instruction.operand]);
+          break;
+        case Instruction::Kind::kConstant:
+          addConstant(fused->constants_[instruction.operand]);
+          break;
+        case Instruction::Kind::kOp:
+          program_.push_back(instruction);
+          break;
+      }
+    }
+  } else if (auto* field = expr->as<FieldReference>()) {
+    addField(field);
+  } else if (auto* constant = expr->as<ConstantExpr>()) {
+    addConstant(constant->value()->as<SimpleVector<double>>()->valueAt(0));
+  } else {
+    addProgram(expr->inputs()[0]);
+    addProgram(expr->inputs()[1]);
+    program_.push_back(
+        {Instruction::Kind::kOp, 0, getFusedFunction(expr->name()).value()});
+  }
+}
+
+void FusedArithmeticExpr::evalBlock(
+    const std::vector<const double*>& fieldValues,
+    vector_size_t begin,
+    vector_size_t end,
+    void* target) {
+  const int32_t numRows = end - begin;
+  std::vector<const double*> operands(maxDepth_);
+  int32_t depth = 0;
+  for (auto i = 0; i < program_.size(); ++i) {
+    const auto& instruction = program_[i];
+    switch (instruction.kind) {
+      case Instruction::Kind::kField:
+        operands[depth++] = fieldValues[instruction.operand] + begin;
+        break;
+      case Instruction::Kind::kConstant: {
+        auto* values = registers_.data() + depth * kBlockSize;
+        std::fill(values, values + numRows, constants_[instruction.operand]);
+        operands[depth++] = values;
+        break;
+      }
+      case Instruction::Kind::kOp: {
+        --depth;
+        const auto* left = operands[depth - 1];
+        const auto* right = operands[depth];
+        const bool isLast = i == program_.size() - 1;
+        if (isComparison(instruction.op)) {
+          VELOX_DCHECK(isLast);
+          compareBlock(
+              instruction.op,
+              left,
+              right,
+              numRows,
+              reinterpret_cast<uint64_t*>(target));
+        } else {
+          // The result replaces the left operand on the stack. Writing over
+          // the left operand's register is safe since each row only reads its
+          // own position.
+          auto* values = isLast ? reinterpret_cast<double*>(target)
+                                : registers_.data() + (depth - 1) * kBlockSize;
+          arithmeticBlock(instruction.op, left, right, numRows, values);
+          operands[depth - 1] = values;
+        }
+        break;
+      }
+    }
+  }
+}
+
+void FusedArithmeticExpr::evalSpecialForm(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  std::vector<const double*> fieldValues(fields_.size());
+  for (auto i = 0; i < fields_.size(); ++i) {
+    const auto field =
+        context.ensureFieldLoaded(fields_[i]->index(context), rows);
+    // Null rows are only safe to compute over if they are excluded from
+    // 'rows'. Their values are arbitrary but arithmetic on doubles does not
+    // fail.
+    if (!field->isFlatEncoding() ||
+        (field->mayHaveNulls() && !context.nullsPruned())) {
+      inputs_[0]->eval(rows, context, result);
+      return;
+    }
+    fieldValues[i] = field->asUnchecked<FlatVector<double>>()->rawValues();
+  }
+
+  context.ensureWritable(rows, type(), result);
+  VELOX_CHECK(result->isFlatEncoding());
+  result->clearNulls(rows);
+
+  const bool isBoolean = type()->kind() == TypeKind::BOOLEAN;
+  const bool allSelected = rows.isAllSelected();
+  uint64_t* rawBits = nullptr;
+  double* rawValues = nullptr;
+  if (isBoolean) {
+    rawBits = result->asUnchecked<FlatVector<bool>>()
+                  ->template mutableRawValues<uint64_t>();
+  } else {
+    rawValues = result->asUnchecked<FlatVector<double>>()->mutableRawValues();
+  }
+
+  for (auto begin = rows.begin(); begin < rows.end(); begin += kBlockSize) {
+    const auto end = std::min(begin + kBlockSize, rows.end());
+    if (isBoolean) {
+      evalBlock(fieldValues, begin, end, resultBits_.data());
+      if (allSelected) {
+        bits::copyBits(resultBits_.data(), 0, rawBits, begin, end - begin);
+      } else {
+        bits::forEachSetBit(rows.asRange().bits(), begin, end, [&](auto row) {
+          bits::setBit(
+              rawBits, row, bits::isBitSet(resultBits_.data(), row - begin));
+        });
+      }
+    } else if (allSelected) {
+      evalBlock(fieldValues, begin, end, rawValues + begin);
+    } else {
+      evalBlock(fieldValues, begin, end, resultValues_.data());
+      bits::forEachSetBit(rows.asRange().bits(), begin, end, [&](auto row) {
+        rawValues[row] = resultValues_[row - begin];
+      });
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
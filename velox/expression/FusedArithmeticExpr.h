@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+
+#include "velox/expression/SpecialForm.h"
+
+namespace facebook::velox::exec {
+
+class FieldReference;
+
+/// Binary operations on doubles that can be fused into a single-pass
+/// evaluation of an expression tree.
+enum class FusedOp {
+  kPlus,
+  kMinus,
+  kMultiply,
+  kDivide,
+  kEq,
+  kNeq,
+  kLt,
+  kLte,
+  kGt,
+  kGte,
+};
+
+/// Declares that the scalar function 'name' computes 'op' with IEEE semantics
+/// for two DOUBLE arguments, without errors and with default null behavior.
+/// Registered by function libraries alongside the function itself.
+void registerFusedFunction(const std::string& name, FusedOp op);
+
+/// Returns the operation registered for 'name', if any.
+std::optional<FusedOp> getFusedFunction(const std::string& name);
+
+/// Evaluates a tree of fusable DOUBLE functions over fields and constants,
+/// e.g. a * b + c > d, in one pass over blocks of rows. Intermediate results
+/// live in small per-block registers instead of a vector per node. Falls back
+/// to the original tree when an input is not flat or has nulls that were not
+/// pruned. Enabled by QueryConfig::kExprFuseArithmetic.
+class FusedArithmeticExpr : public SpecialForm {
+ public:
+  /// Returns a fused replacement for 'expr' if 'expr' is a call of a fused
+  /// function whose arguments are fields, constants or fused expressions.
+  /// Returns nullptr otherwise.
+  static ExprPtr tryFuse(const ExprPtr& expr);
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result) override;
+
+  std::string toString(bool recursive = true) const override {
+    return inputs_[0]->toString(recursive);
+  }
+
+  std::string toSql(
+      std::vector<VectorPtr>* complexConstants = nullptr) const override {
+    return inputs_[0]->toSql(complexConstants);
+  }
+
+ private:
+  static constexpr int32_t kBlockSize = 1024;
+
+  struct Instruction {
+    enum class Kind { kField, kConstant, kOp };
+    Kind kind;
+    // Index into 'fields_' or 'constants_' for kField and kConstant.
+    int32_t operand;
+    FusedOp op;
+  };
+
+  explicit FusedArithmeticExpr(const ExprPtr& original);
+
+  void computePropagatesNulls() override {
+    propagatesNulls_ = inputs_[0]->propagatesNulls();
+  }
+
+  // Appends the postfix program computing 'expr' to 'program_'.
+  void addProgram(const ExprPtr& expr);
+
+  // Computes the rows [begin, end) into 'target' for a DOUBLE result or into
+  // the bits of 'target' starting at bit 0 for a BOOLEAN result.
+  void evalBlock(
+      const std::vector<const double*>& fieldValues,
+      vector_size_t begin,
+      vector_size_t end,
+      void* target);
+
+  // Postfix program evaluated on a stack of operand pointers.
+  std::vector<Instruction> program_;
+  std::vector<FieldReference*> fields_;
+  std::vector<double> constants_;
+  int32_t maxDepth_{0};
+
+  // 'maxDepth_' registers of 'kBlockSize' doubles.
+  std::vector<double> registers_;
+
+  // The result of a block for a partial selection of rows or a BOOLEAN
+  // result.
+  std::vector<double> resultValues_;
+  std::vector<uint64_t> resultBits_;
+};
+
+} // namespace facebook::velox::exec
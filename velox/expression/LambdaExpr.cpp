@@ -41,6 +41,14 @@ class ExprCallable : public Callable {
     return capture_->childrenSize() > signature_->size();
   }
 
+  const RowTypePtr& signature() const override {
+    return signature_;
+  }
+
+  const Expr& body() const override {
+    return *body_;
+  }
+
   void apply(
       const SelectivityVector& rows,
       const SelectivityVector* validRowsInReusedResult,
@@ -81,6 +81,11 @@ class SimpleFunctionAdapter : public VectorFunction {
   static constexpr bool fastPathIteration =
       return_type_traits::isPrimitiveType && return_type_traits::isFixedWidth;
 
+  // Whether the UDF can be called in a plain loop over all rows. Boolean
+  // results are excluded since they are written bit by bit.
+  static constexpr bool vectorizedIteration = FUNC::is_vectorizable &&
+      fastPathIteration && return_type_traits::typeKind != TypeKind::BOOLEAN;
+
   // Check that the argument at POSITION is a primitive type, that is not
   // boolean.
   template <int32_t POSITION>
@@ -573,6 +578,22 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
 
     // Iterate the rows.
+    if constexpr (vectorizedIteration) {
+      // The function neither throws nor returns null and nulls in the inputs
+      // have been removed from 'rows' by default null handling, so no error
+      // or null handling is needed per row. The loop over contiguous rows
+      // without branches auto-vectorizes for flat and constant inputs.
+      const auto& rows = *applyContext.rows;
+      if (rows.isAllSelected()) {
+        auto* data = applyContext.resultWriter.data_;
+        const auto end = rows.end();
+        for (auto row = rows.begin(); row < end; ++row) {
+          doApplyNotNull<0>(row, data[row], readers...);
+        }
+        return;
+      }
+    }
+
     if constexpr (fastPathIteration) {
       uint64_t* nullBuffer = nullptr;
       auto getRawData = [&]() {
@@ -58,7 +58,8 @@ std::shared_ptr<VectorFunction> getVectorFunction(
     const std::string& name,
     const std::vector<TypePtr>& inputTypes,
     const std::vector<VectorPtr>& constantInputs,
-    const core::QueryConfig& config) {
+    const core::QueryConfig& config,
+    bool* stateless) {
   auto sanitizedName = sanitizeName(name);
 
   if (!constantInputs.empty()) {
@@ -78,10 +79,13 @@ std::shared_ptr<VectorFunction> getVectorFunction(
   }
 
   return vectorFunctionFactories().withRLock(
-      [&sanitizedName, &inputArgs, &config, &inputTypes](
+      [&sanitizedName, &inputArgs, &config, &inputTypes, stateless](
           auto& functionMap) -> std::shared_ptr<VectorFunction> {
         if (resolveVectorFunction(sanitizedName, inputTypes)) {
           auto functionIterator = functionMap.find(sanitizedName);
+          if (stateless != nullptr) {
+            *stateless = functionIterator->second.stateless;
+          }
           return functionIterator->second.factory(
               sanitizedName, inputArgs, config);
         }
@@ -89,33 +93,43 @@ std::shared_ptr<VectorFunction> getVectorFunction(
       });
 }
 
-/// Registers a new vector function. When overwrite = true, previous functions
-/// with the given name will be replaced.
-/// Returns true iff an insertion actually happened
-bool registerStatefulVectorFunction(
+namespace {
+bool registerVectorFunctionEntry(
     const std::string& name,
-    std::vector<FunctionSignaturePtr> signatures,
-    VectorFunctionFactory factory,
-    VectorFunctionMetadata metadata,
+    VectorFunctionEntry entry,
     bool overwrite) {
   auto sanitizedName = sanitizeName(name);
 
   if (overwrite) {
     vectorFunctionFactories().withWLock([&](auto& functionMap) {
       // Insert/overwrite.
-      functionMap[sanitizedName] = {
-          std::move(signatures), std::move(factory), std::move(metadata)};
+      functionMap[sanitizedName] = std::move(entry);
     });
     return true;
   }
 
   return vectorFunctionFactories().withWLock([&](auto& functionMap) {
-    auto [iterator, inserted] = functionMap.insert(
-        {sanitizedName,
-         {std::move(signatures), std::move(factory), std::move(metadata)}});
+    auto [iterator, inserted] =
+        functionMap.insert({sanitizedName, std::move(entry)});
     return inserted;
   });
 }
+} // namespace
+
+/// Registers a new vector function. When overwrite = true, previous functions
+/// with the given name will be replaced.
+/// Returns true iff an insertion actually happened
+bool registerStatefulVectorFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    VectorFunctionFactory factory,
+    VectorFunctionMetadata metadata,
+    bool overwrite) {
+  return registerVectorFunctionEntry(
+      name,
+      {std::move(signatures), std::move(factory), std::move(metadata)},
+      overwrite);
+}
 
 // Returns true iff an insertion actually happened
 bool registerVectorFunction(
@@ -129,8 +143,13 @@ bool registerVectorFunction(
                      const auto& /*name*/,
                      const auto& /*vectorArg*/,
                      const auto& /*config*/) { return sharedFunc; };
-  return registerStatefulVectorFunction(
-      name, signatures, factory, metadata, overwrite);
+  return registerVectorFunctionEntry(
+      name,
+      {std::move(signatures),
+       std::move(factory),
+       std::move(metadata),
+       /*stateless*/ true},
+      overwrite);
 }
 
 std::vector<ExpressionRewrite>& expressionRewrites() {
@@ -142,4 +161,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExpressionSetRewrite>& expressionSetRewrites() {
+  static std::vector<ExpressionSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite) {
+  expressionSetRewrites().emplace_back(rewrite);
+}
+
 } // namespace facebook::velox::exec
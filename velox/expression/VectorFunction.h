@@ -193,11 +193,15 @@ std::shared_ptr<const Type> resolveVectorFunction(
 /// constantInputs should be aligned with inputTypes if there is at least one
 /// constant input; non-constant inputs should be represented as nullptr;
 /// constant inputs must be instances of ConstantVector.
+/// If 'stateless' is not null, it is set to true if the function was
+/// registered with registerVectorFunction, i.e. the returned instance is
+/// shared by all expressions.
 std::shared_ptr<VectorFunction> getVectorFunction(
     const std::string& name,
     const std::vector<TypePtr>& inputTypes,
     const std::vector<VectorPtr>& constantInputs,
-    const core::QueryConfig& config);
+    const core::QueryConfig& config,
+    bool* stateless = nullptr);
 
 struct VectorFunctionMetadata {
   /// Boolean indicating whether this function supports flattening, i.e.
@@ -243,6 +247,8 @@ struct VectorFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   VectorFunctionFactory factory;
   VectorFunctionMetadata metadata;
+  // True if 'factory' returns the same instance for all expressions.
+  bool stateless{false};
 };
 
 // TODO: Use folly::Singleton here
@@ -295,6 +301,21 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all expressions compiled together into one ExprSet
+/// and returns equivalent expressions, or an empty vector if re-write is not
+/// possible. Unlike ExpressionRewrite, it can share work between expressions,
+/// e.g. by replacing similar calls with references to a common call.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. Expression set re-writes
+/// are applied in the order they were registered, each to the result of the
+/// previous one, before 'expressionRewrites'.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
@@ -889,6 +889,90 @@ TEST_F(CastExprTest, primitiveInvalidCornerCases) {
   }
 }
 
+TEST_F(CastExprTest, stringToIntegral) {
+  setCastIntByTruncate(false);
+  auto data = makeRowVector({makeFlatVector<std::string>({
+      "0",
+      "-7",
+      "007",
+      "127",
+      "-128",
+      "128",
+      " 12",
+      "+12",
+      "1a",
+      "abc",
+      "999999999999999999",
+      "9223372036854775807",
+      "-9223372036854775808",
+      "9223372036854775808",
+  })});
+
+  assertEqualVectors(
+      makeNullableFlatVector<int8_t>(
+          {0,
+           -7,
+           7,
+           127,
+           -128,
+           std::nullopt,
+           12,
+           12,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt,
+           std::nullopt}),
+      evaluate("try_cast(c0 as tinyint)", data));
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {0,
+           -7,
+           7,
+           127,
+           -128,
+           128,
+           12,
+           12,
+           std::nullopt,
+           std::nullopt,
+           999999999999999999,
+           std::numeric_limits<int64_t>::max(),
+           std::numeric_limits<int64_t>::min(),
+           std::nullopt}),
+      evaluate("try_cast(c0 as bigint)", data));
+
+  // Errors are the same with and without the fast paths.
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "cast(c0 as bigint)",
+          makeRowVector({makeFlatVector<std::string>({"1a"})})),
+      "Cannot cast VARCHAR '1a' to BIGINT. Non-whitespace character found after end of conversion");
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "cast(c0 as tinyint)",
+          makeRowVector({makeFlatVector<std::string>({"128"})})),
+      "Cannot cast VARCHAR '128' to TINYINT");
+}
+
+TEST_F(CastExprTest, integralToString) {
+  auto data = makeRowVector({
+      makeFlatVector<int8_t>({0, -128, 127}),
+      makeFlatVector<int64_t>(
+          {0,
+           std::numeric_limits<int64_t>::min(),
+           std::numeric_limits<int64_t>::max()}),
+  });
+  assertEqualVectors(
+      makeFlatVector<std::string>({"0", "-128", "127"}),
+      evaluate("cast(c0 as varchar)", data));
+  assertEqualVectors(
+      makeFlatVector<std::string>(
+          {"0", "-9223372036854775808", "9223372036854775807"}),
+      evaluate("cast(c1 as varchar)", data));
+}
+
 TEST_F(CastExprTest, primitiveValidCornerCases) {
   setCastIntByTruncate(false);
   // To integer.
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprCompileCache.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -310,6 +311,33 @@ TEST_F(ExprCompilerTest, eliminateUnnecessaryCast) {
   ASSERT_TRUE(dynamic_cast<const FieldReference*>(exprSet->expr(0).get()));
 }
 
+TEST_F(ExprCompilerTest, commonSubexpressions) {
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto field = makeField(rowType);
+
+  // A parsed filter references columns through an InputTypedExpr. A hand
+  // built projection does not. Both share length(c0).
+  auto exprSet = std::make_unique<ExprSet>(
+      std::vector<core::TypedExprPtr>{
+          makeTypedExpr("length(c0) > 3", rowType),
+          call("length", {field("c0")}),
+          call("length", {field("c1")})},
+      execCtx_.get());
+  ASSERT_EQ(exprSet->size(), 3);
+  ASSERT_EQ(exprSet->expr(0)->inputs()[0], exprSet->expr(1));
+  ASSERT_TRUE(exprSet->expr(1)->isMultiplyReferenced());
+  ASSERT_NE(exprSet->expr(1), exprSet->expr(2));
+  ASSERT_FALSE(exprSet->expr(2)->isMultiplyReferenced());
+
+  // Distinct constants are not shared.
+  exprSet = std::make_unique<ExprSet>(
+      std::vector<core::TypedExprPtr>{
+          makeTypedExpr("substr(c0, 1)", rowType),
+          call("substr", {field("c0"), bigint(2)})},
+      execCtx_.get());
+  ASSERT_NE(exprSet->expr(0), exprSet->expr(1));
+}
+
 TEST_F(ExprCompilerTest, lambdaExpr) {
   // Ensure that metadata computation correctly pulls in distinct fields from
   // captured columns.
@@ -332,4 +360,45 @@ TEST_F(ExprCompilerTest, lambdaExpr) {
   ASSERT_EQ(distinctFields.size(), 2);
 }
 
+TEST_F(ExprCompilerTest, compileCache) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  ExprCompileCache cache;
+  auto compileCached = [&](const core::TypedExprPtr& expr) {
+    return std::make_unique<ExprSet>(
+        std::vector<core::TypedExprPtr>{expr},
+        execCtx_.get(),
+        /*enableConstantFolding*/ true,
+        &cache);
+  };
+
+  // The second compile reuses the folded 1 + 5.
+  auto expression = makeTypedExpr("a + (1 + 5)", rowType);
+  auto first = compileCached(expression);
+  ASSERT_EQ(0, cache.numHits());
+  auto second = compileCached(expression);
+  ASSERT_EQ(1, cache.numHits());
+  ASSERT_EQ("plus(a, 6:BIGINT)", second->toString());
+  ASSERT_NE(first->expr(0), second->expr(0));
+
+  // A constant that fails to fold is compiled as is.
+  expression = makeTypedExpr("a + (1 / 0)", rowType);
+  first = compileCached(expression);
+  ASSERT_EQ(1, cache.numHits());
+  second = compileCached(expression);
+  // Found before compiling the inputs and again instead of folding.
+  ASSERT_EQ(3, cache.numHits());
+  ASSERT_EQ(first->toString(), second->toString());
+
+  // Stateless vector functions are resolved once.
+  expression = makeTypedExpr("a = 5", rowType);
+  first = compileCached(expression);
+  second = compileCached(expression);
+  ASSERT_EQ(4, cache.numHits());
+  ASSERT_EQ(
+      first->expr(0)->vectorFunction(), second->expr(0)->vectorFunction());
+
+  cache.clear();
+  ASSERT_EQ(0, cache.size());
+}
+
 } // namespace facebook::velox::exec::test
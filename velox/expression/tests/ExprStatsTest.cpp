@@ -303,6 +303,47 @@ TEST_F(ExprStatsTest, listener) {
   ASSERT_EQ(3, events.size());
 }
 
+TEST_F(ExprStatsTest, profiles) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprProfileSampleRate, "2"},
+  });
+  vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row % 7; }, nullEvery(4)),
+  });
+  auto exprSet = compileExpressions(
+      {"c0 + 1", "c0 * c1"}, asRowType(data->type()));
+
+  // Every other batch is sampled.
+  for (auto i = 0; i < 5; ++i) {
+    evaluate(*exprSet, data);
+  }
+  auto profiles = exprSet->profiles();
+  ASSERT_EQ(2, profiles.size());
+  for (const auto& profile : profiles) {
+    ASSERT_EQ(3, profile.numSampledVectors);
+    ASSERT_EQ(3, profile.timing.count);
+    ASSERT_EQ(3 * size, profile.numSampledRows);
+  }
+  ASSERT_EQ(0, profiles[0].numSampledNullRows);
+  ASSERT_EQ(3 * size / 4, profiles[1].numSampledNullRows);
+
+  // Peeling is counted in all batches.
+  auto indices = makeIndicesInReverse(size);
+  evaluate(
+      *exprSet,
+      makeRowVector({
+          wrapInDictionary(indices, size, data->childAt(0)),
+          wrapInDictionary(indices, size, data->childAt(1)),
+      }));
+  profiles = exprSet->profiles();
+  ASSERT_EQ(3, profiles[0].numSampledVectors);
+  ASSERT_LE(1, profiles[1].numPeeled);
+  ASSERT_LE(profiles[1].numPeeled, profiles[1].numPeelAttempts);
+}
+
 TEST_F(ExprStatsTest, specialForms) {
   vector_size_t size = 1'024;
 
@@ -444,6 +444,40 @@ TEST_P(ParameterizedExprTest, reorder) {
   }
 }
 
+TEST_P(ParameterizedExprTest, reorderByCost) {
+  constexpr int32_t kBatchSize = 1'000;
+  constexpr int32_t kNumBatches = 10;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; }),
+       makeFlatVector<std::string>(kBatchSize, [](auto row) {
+         return std::string(100 + row % 10, 'a');
+       })});
+  // The expensive regular expression drops no rows and comes first in the
+  // plan. The cheap comparison drops 99% of the rows.
+  auto exprSet = compileExpression(
+      "regexp_like(c1, '^(a|b)*$') and c0 % 100 = 0",
+      asRowType(data->type()));
+  for (auto i = 0; i < kNumBatches; ++i) {
+    auto result = evaluate(exprSet.get(), data);
+    auto expected = makeFlatVector<bool>(
+        kBatchSize, [](auto row) { return row % 100 == 0; });
+    assertEqualVectors(expected, result);
+  }
+
+  auto conjunct =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(conjunct != nullptr);
+  // After the first batch the comparison runs first and sees all rows. The
+  // regular expression sees only the rows that pass the comparison.
+  EXPECT_EQ(kBatchSize * kNumBatches, conjunct->selectivityAt(0).numIn());
+  EXPECT_EQ(
+      kBatchSize * kNumBatches / 100, conjunct->selectivityAt(0).numOut());
+  EXPECT_EQ(
+      kBatchSize + (kNumBatches - 1) * kBatchSize / 100,
+      conjunct->selectivityAt(1).numIn());
+}
+
 TEST_P(ParameterizedExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -2132,6 +2166,80 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, memoWithConstant) {
+  // Verify that an expression over one dictionary and a constant, e.g. a
+  // partition key, is memoized and that a different constant invalidates the
+  // memo.
+  auto base = makeFlatVector<int64_t>(1'000, [](auto row) { return row % 7; });
+  auto evenIndices = makeIndices(100, [](auto row) { return 8 + row * 2; });
+
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto exprSet = compileExpression("c0 = c1", rowType);
+
+  auto makeInput = [&](int64_t constant) {
+    return makeRowVector(
+        {wrapInDictionary(evenIndices, 100, base),
+         makeConstant<int64_t>(constant, 100)});
+  };
+  auto expected = [&](int64_t constant) {
+    return makeFlatVector<bool>(
+        100, [&](auto row) { return (8 + row * 2) % 7 == constant; });
+  };
+
+  auto [result, stats] = evaluateWithStats(exprSet.get(), makeInput(3));
+  assertEqualVectors(expected(3), result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 100);
+
+  // The second sighting of the base caches the results.
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), makeInput(3));
+  assertEqualVectors(expected(3), result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 200);
+
+  // All rows come from the cache.
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), makeInput(3));
+  assertEqualVectors(expected(3), result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 200);
+
+  // A different constant is evaluated afresh.
+  std::tie(result, stats) = evaluateWithStats(exprSet.get(), makeInput(5));
+  assertEqualVectors(expected(5), result);
+  ASSERT_EQ(stats["eq"].numProcessedRows, 300);
+}
+
+TEST_F(ExprTest, memoMaxBaseSize) {
+  queryCtx_ = std::make_shared<core::QueryCtx>(
+      nullptr,
+      core::QueryConfig({{core::QueryConfig::kExprMaxMemoBaseSize, "999"}}));
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+
+  auto evenIndices = makeIndices(100, [](auto row) { return 8 + row * 2; });
+  auto expected = makeFlatVector<bool>(
+      100, [](auto row) { return (8 + row * 2) % 7 == 3; });
+  auto exprSet = compileExpression("c0 % 7 = 3", ROW({"c0"}, {BIGINT()}));
+
+  // A base above the limit is evaluated for every batch.
+  auto base = makeFlatVector<int64_t>(1'000, folly::identity);
+  for (auto i = 1; i <= 3; ++i) {
+    auto [result, stats] = evaluateWithStats(
+        exprSet.get(),
+        makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+    assertEqualVectors(expected, result);
+    ASSERT_EQ(stats["eq"].numProcessedRows, 100 * i);
+  }
+  ASSERT_TRUE(base.unique());
+
+  // A base within the limit is memoized.
+  base = makeFlatVector<int64_t>(999, folly::identity);
+  for (auto i = 1; i <= 3; ++i) {
+    auto [result, stats] = evaluateWithStats(
+        exprSet.get(),
+        makeRowVector({wrapInDictionary(evenIndices, 100, base)}));
+    assertEqualVectors(expected, result);
+    ASSERT_EQ(stats["eq"].numProcessedRows, 300 + 100 * std::min(i, 2));
+  }
+  ASSERT_FALSE(base.unique());
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -4260,6 +4368,9 @@ TEST_P(ParameterizedExprTest, extractSubfields) {
   validate("c0[1].c0c1['foo'] > 0", {"c0[1].c0c1[\"foo\"]"});
   validate("c0[1].c0c0[c1[1]] > 0", {"c0[1].c0c0", "c1[1]"});
   validate("element_at(c1, -1)", {"c1"});
+  validate("element_at(c1, 2) > 0", {"c1[2]"});
+  validate("element_at(c0[1].c0c1, 'foo') > 0", {"c0[1].c0c1[\"foo\"]"});
+  validate("element_at(c0[1].c0c0, -1) > 0", {"c0[1].c0c0[-1]"});
   validate("transform(c0, x -> x.c0c0[0] + c1[1])", {"c0", "c1[1]"});
   validate("transform(c0, c1 -> c1.c0c0[0])", {"c0"});
   validate("reduce(c1, 0, (c0, c3) -> c0 + c3, c2 -> c2)", {"c1"});
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FusedArithmeticExpr.h"
+#include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+
+class FusedArithmeticExprTest : public functions::test::FunctionBaseTest {
+ protected:
+  void SetUp() override {
+    FunctionBaseTest::SetUp();
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kExprFuseArithmetic, "true"}});
+  }
+
+  RowVectorPtr makeData(vector_size_t size) {
+    return makeRowVector({
+        makeFlatVector<double>(size, [](auto row) { return row * 0.5; }),
+        makeFlatVector<double>(size, [](auto row) { return row % 11; }),
+        makeFlatVector<double>(size, [](auto row) { return row % 7 - 3; }),
+        makeFlatVector<double>(size, [](auto row) { return row % 5 * 100; }),
+    });
+  }
+};
+
+TEST_F(FusedArithmeticExprTest, fusion) {
+  auto rowType = ROW(
+      {"c0", "c1", "c2", "c3", "c4"},
+      {DOUBLE(), DOUBLE(), DOUBLE(), DOUBLE(), BIGINT()});
+
+  auto exprSet = compileExpression("c0 * c1 + c2 > c3", rowType);
+  auto* fused = exprSet->expr(0).get();
+  ASSERT_TRUE(fused->is<exec::FusedArithmeticExpr>());
+  ASSERT_EQ(fused->toString(), "gt(plus(multiply(c0, c1), c2), c3)");
+
+  // A cast input is not fused. Its sibling is.
+  exprSet = compileExpression("c0 * c1 + cast(c4 as double)", rowType);
+  auto* plus = exprSet->expr(0).get();
+  ASSERT_FALSE(plus->is<exec::FusedArithmeticExpr>());
+  ASSERT_TRUE(plus->inputs()[0]->is<exec::FusedArithmeticExpr>());
+
+  // Without the config nothing is fused.
+  queryCtx_->testingOverrideConfigUnsafe({});
+  exprSet = compileExpression("c0 * c1 + c2 > c3", rowType);
+  ASSERT_FALSE(exprSet->expr(0)->is<exec::FusedArithmeticExpr>());
+}
+
+TEST_F(FusedArithmeticExprTest, arithmetic) {
+  // Several blocks and a partial last word.
+  const vector_size_t size = 3'000;
+  auto data = makeData(size);
+
+  auto result = evaluate("c0 * c1 + c2 / 2.0 - c3", data);
+  assertEqualVectors(
+      makeFlatVector<double>(
+          size,
+          [](auto row) {
+            return row * 0.5 * (row % 11) + (row % 7 - 3) / 2.0 - row % 5 * 100;
+          }),
+      result);
+
+  // A field used several times.
+  result = evaluate("c0 * c0 + c0", data);
+  assertEqualVectors(
+      makeFlatVector<double>(
+          size, [](auto row) { return row * 0.5 * row * 0.5 + row * 0.5; }),
+      result);
+}
+
+TEST_F(FusedArithmeticExprTest, comparison) {
+  const vector_size_t size = 3'000;
+  auto data = makeData(size);
+
+  auto result = evaluate("c0 * c1 + c2 > c3", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(
+          size,
+          [](auto row) {
+            return row * 0.5 * (row % 11) + (row % 7 - 3) > row % 5 * 100;
+          }),
+      result);
+
+  result = evaluate("c1 - c2 = 1.0", data);
+  assertEqualVectors(
+      makeFlatVector<bool>(
+          size, [](auto row) { return row % 11 - (row % 7 - 3) == 1; }),
+      result);
+}
+
+TEST_F(FusedArithmeticExprTest, nullsAndSelection) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<double>(
+          size, [](auto row) { return row * 0.5; }, nullEvery(7)),
+      makeFlatVector<double>(size, [](auto row) { return row % 11; }),
+  });
+
+  auto result = evaluate("c0 * c1 + 1.0", data);
+  assertEqualVectors(
+      makeFlatVector<double>(
+          size,
+          [](auto row) { return row * 0.5 * (row % 11) + 1; },
+          nullEvery(7)),
+      result);
+
+  // The fused expression is evaluated on a subset of rows.
+  result = evaluate("if(c1 > 5.0, c1 * 2.0 + 1.0, 0.0)", data);
+  assertEqualVectors(
+      makeFlatVector<double>(
+          size,
+          [](auto row) { return row % 11 > 5 ? (row % 11) * 2.0 + 1 : 0; }),
+      result);
+
+  // Dictionary-encoded inputs.
+  auto indices = makeIndicesInReverse(size);
+  result = evaluate(
+      "c0 * c1 < 100.0",
+      makeRowVector({
+          wrapInDictionary(indices, size, data->childAt(0)),
+          wrapInDictionary(indices, size, data->childAt(1)),
+      }));
+  assertEqualVectors(
+      makeFlatVector<bool>(
+          size,
+          [](auto row) {
+            const auto i = size - 1 - row;
+            return i * 0.5 * (i % 11) < 100;
+          },
+          [](auto row) { return (size - 1 - row) % 7 == 0; }),
+      result);
+}
@@ -587,6 +587,58 @@ struct NonDefaultNullBehaviorFunction {
   }
 };
 
+template <typename T>
+struct VectorizableFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  static constexpr bool is_vectorizable = true;
+
+  FOLLY_ALWAYS_INLINE void call(int64_t& out, int64_t a, int64_t b) {
+    out = a * 2 + b;
+  }
+};
+
+TEST_F(SimpleFunctionTest, vectorizable) {
+  registerFunction<VectorizableFunction, int64_t, int64_t, int64_t>(
+      {"vectorizable"});
+
+  const vector_size_t size = 1'000;
+  auto a = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto b = makeFlatVector<int64_t>(size, [](auto row) { return row % 7; });
+  auto aNulls = makeFlatVector<int64_t>(
+      size, [](auto row) { return row; }, nullEvery(5));
+
+  // Flat inputs, all rows selected.
+  auto result = evaluate("vectorizable(c0, c1)", makeRowVector({a, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 2 + row % 7; }),
+      result);
+
+  // Flat and constant inputs.
+  result = evaluate("vectorizable(c0, 3)", makeRowVector({a}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 2 + 3; }),
+      result);
+
+  // Null inputs leave gaps in the rows.
+  result = evaluate("vectorizable(c0, c1)", makeRowVector({aNulls, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 2 + row % 7; }, nullEvery(5)),
+      result);
+
+  // Non-flat inputs.
+  auto indices = makeIndicesInReverse(size);
+  result = evaluate(
+      "vectorizable(c0, c1)",
+      makeRowVector({wrapInDictionary(indices, size, a), b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (size - 1 - row) * 2 + row % 7; }),
+      result);
+}
+
 TEST_F(SimpleFunctionTest, nonDefaultNullBehavior) {
   registerFunction<NonDefaultNullBehaviorFunction, bool, int64_t>(
       {"non_default_null_behavior"});
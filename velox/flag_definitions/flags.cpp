@@ -62,6 +62,12 @@ DEFINE_bool(avx2, true, "Enables use of AVX2 when available");
 
 DEFINE_bool(bmi2, true, "Enables use of BMI2 when available");
 
+DEFINE_bool(
+    avx512,
+    true,
+    "Enables use of AVX-512 in the kernels that check for it at run time when "
+    "available");
+
 // Used in exec/Expr.cpp
 
 DEFINE_string(
@@ -91,6 +97,16 @@ DEFINE_bool(
     false,
     "If true, 'MemoryPool' will be running in debug mode to track the allocation and free call sites to detect the source of memory leak for testing purpose");
 
+DEFINE_uint32(
+    velox_memory_pool_debug_sample_interval,
+    1,
+    "If 'velox_memory_pool_debug_enabled' is true, 'MemoryPool' records the call site of one in this many allocations. 1 records all allocations");
+
+DEFINE_uint64(
+    velox_memory_pool_debug_snapshot_bytes,
+    0,
+    "If 'velox_memory_pool_debug_enabled' is true and this is not 0, a leaf 'MemoryPool' logs its top allocation call sites when its usage first exceeds this many bytes and every time the usage doubles after that");
+
 // TODO: deprecate this after solves all the use cases that can cause
 // significant performance regression by memory usage tracking.
 DEFINE_bool(
@@ -19,6 +19,7 @@
 #include <velox/common/base/Exceptions.h>
 #include <cstring>
 #include <stdexcept>
+#include <unordered_set>
 #include "velox/external/date/date.h"
 #include "velox/external/date/tz.h"
 #include "velox/functions/lib/DateTimeFormatterBuilder.h"
@@ -925,8 +926,252 @@ void parseFromPattern(
   }
 }
 
+constexpr int64_t kSecondsInDay = 86'400;
+
+// Returns the number of characters 'pattern' formats to if it is the same for
+// all timestamps in the years 1 to 9999.
+std::optional<size_t> fixedWidth(const FormatPattern& pattern) {
+  switch (pattern.specifier) {
+    case DateTimeFormatSpecifier::YEAR:
+    case DateTimeFormatSpecifier::YEAR_OF_ERA:
+      if (pattern.minRepresentDigits == 4) {
+        return 4;
+      }
+      return std::nullopt;
+    case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+    case DateTimeFormatSpecifier::DAY_OF_MONTH:
+    case DateTimeFormatSpecifier::HOUR_OF_DAY:
+    case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+    case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+      if (pattern.minRepresentDigits == 2) {
+        return 2;
+      }
+      return std::nullopt;
+    case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+      return pattern.minRepresentDigits;
+    default:
+      return std::nullopt;
+  }
+}
+
+// Writes the 'numDigits' low decimal digits of 'value' to 'out'.
+inline void writeDigits(char* out, int64_t value, size_t numDigits) {
+  for (auto i = numDigits; i > 0; --i) {
+    out[i - 1] = '0' + value % 10;
+    value /= 10;
+  }
+}
+
+// Returns the number in the 'numDigits' bytes at 'in' or -1 if one of them is
+// not a digit.
+inline int32_t readDigits(const char* in, size_t numDigits) {
+  int32_t number = 0;
+  for (auto i = 0; i < numDigits; ++i) {
+    if (!characterIsDigit(in[i])) {
+      return -1;
+    }
+    number = number * 10 + (in[i] - '0');
+  }
+  return number;
+}
+
+struct CivilDate {
+  int64_t year;
+  int32_t month;
+  int32_t day;
+};
+
+// Returns the proleptic Gregorian date of 'days' since the epoch. See
+// http://howardhinnant.github.io/date_algorithms.html#civil_from_days.
+CivilDate civilFromDays(int64_t days) {
+  const int64_t z = days + 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const int64_t dayOfEra = z - era * 146097;
+  const int64_t yearOfEra =
+      (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) /
+      365;
+  const int64_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const int64_t monthFromMarch = (5 * dayOfYear + 2) / 153;
+  const int32_t day = dayOfYear - (153 * monthFromMarch + 2) / 5 + 1;
+  const int32_t month =
+      monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9;
+  return {yearOfEra + era * 400 + (month <= 2), month, day};
+}
+
 } // namespace
 
+// static
+std::optional<size_t> DateTimeFormatter::computeFixedFormatSize(
+    const std::vector<DateTimeToken>& tokens) {
+  size_t size = 0;
+  for (const auto& token : tokens) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      size += token.literal.size();
+    } else if (auto width = fixedWidth(token.pattern)) {
+      size += *width;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return size;
+}
+
+bool DateTimeFormatter::supportsFixedWidthParse() const {
+  if (!fixedFormatSize_.has_value() || type_ != DateTimeFormatterType::JODA) {
+    return false;
+  }
+  std::unordered_set<DateTimeFormatSpecifier> specifiers;
+  for (auto i = 0; i < tokens_.size(); ++i) {
+    const auto& token = tokens_[i];
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      for (auto c : token.literal) {
+        if (characterIsDigit(c)) {
+          return false;
+        }
+      }
+      continue;
+    }
+    if (token.pattern.specifier ==
+            DateTimeFormatSpecifier::FRACTION_OF_SECOND ||
+        !specifiers.insert(token.pattern.specifier).second) {
+      return false;
+    }
+    // Adjacent fields limit each other's number of digits in parse().
+    if (i + 1 < tokens_.size() &&
+        tokens_[i + 1].type == DateTimeToken::Type::kPattern) {
+      return false;
+    }
+  }
+  return (specifiers.count(DateTimeFormatSpecifier::YEAR) ||
+          specifiers.count(DateTimeFormatSpecifier::YEAR_OF_ERA)) &&
+      specifiers.count(DateTimeFormatSpecifier::MONTH_OF_YEAR) &&
+      specifiers.count(DateTimeFormatSpecifier::DAY_OF_MONTH);
+}
+
+bool DateTimeFormatter::formatFixedWidth(
+    const Timestamp& timestamp,
+    const date::time_zone* timezone,
+    char* result) const {
+  Timestamp t = timestamp;
+  if (timezone != nullptr) {
+    t.toTimezone(*timezone);
+  }
+  const auto seconds = t.getSeconds();
+  const auto days = seconds >= 0 ? seconds / kSecondsInDay
+                                 : (seconds + 1) / kSecondsInDay - 1;
+  const auto date = civilFromDays(days);
+  if (date.year < 1 || date.year > 9999) {
+    return false;
+  }
+  const auto secondOfDay = seconds - days * kSecondsInDay;
+  const auto millis = t.getNanos() / 1'000'000;
+
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      std::memcpy(result, token.literal.data(), token.literal.size());
+      result += token.literal.size();
+      continue;
+    }
+    const auto width = token.pattern.minRepresentDigits;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        writeDigits(result, date.year, width);
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        writeDigits(result, date.month, width);
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        writeDigits(result, date.day, width);
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        writeDigits(result, secondOfDay / 3'600, width);
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        writeDigits(result, secondOfDay / 60 % 60, width);
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        writeDigits(result, secondOfDay % 60, width);
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        // Milliseconds followed by zeros, truncated to 'width'.
+        if (width >= 3) {
+          writeDigits(result, millis, 3);
+          std::memset(result + 3, '0', width - 3);
+        } else {
+          char digits[3];
+          writeDigits(digits, millis, 3);
+          std::memcpy(result, digits, width);
+        }
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    result += width;
+  }
+  return true;
+}
+
+std::optional<DateTimeResult> DateTimeFormatter::tryParseFixedWidth(
+    const std::string_view& input) const {
+  int32_t year = 0;
+  int32_t month = 0;
+  int32_t day = 0;
+  int32_t hour = 0;
+  int32_t minute = 0;
+  int32_t second = 0;
+  const char* cur = input.data();
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      if (std::memcmp(cur, token.literal.data(), token.literal.size()) != 0) {
+        return std::nullopt;
+      }
+      cur += token.literal.size();
+      continue;
+    }
+    const auto width = token.pattern.minRepresentDigits;
+    const auto number = readDigits(cur, width);
+    if (number < 0) {
+      return std::nullopt;
+    }
+    cur += width;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::YEAR:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+        year = number;
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+        month = number;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+        day = number;
+        break;
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+        hour = number;
+        break;
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+        minute = number;
+        break;
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        second = number;
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  if (year < 1 || month < 1 || month > 12 ||
+      !util::isValidDate(year, month, day) || hour > 23 || minute > 59 ||
+      second > 59) {
+    return std::nullopt;
+  }
+  return DateTimeResult{
+      util::fromDatetime(
+          util::daysSinceEpochFromDate(year, month, day),
+          util::fromTime(hour, minute, second, 0)),
+      -1};
+}
+
 std::string DateTimeFormatter::format(
     const Timestamp& timestamp,
     const date::time_zone* timezone) const {
@@ -1109,6 +1354,12 @@ std::string DateTimeFormatter::format(
 }
 
 DateTimeResult DateTimeFormatter::parse(const std::string_view& input) const {
+  if (fixedWidthParse_ && input.size() == *fixedFormatSize_) {
+    if (auto result = tryParseFixedWidth(input)) {
+      return *result;
+    }
+  }
+
   Date date;
   const char* cur = input.data();
   const char* end = cur + input.size();
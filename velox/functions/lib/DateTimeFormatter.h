@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <cstring>
+#include <optional>
 #include <string>
 #include <vector>
 #include "velox/common/base/Exceptions.h"
@@ -159,7 +161,9 @@ class DateTimeFormatter {
       : literalBuf_(std::move(literalBuf)),
         bufSize_(bufSize),
         tokens_(std::move(tokens)),
-        type_(type) {}
+        type_(type),
+        fixedFormatSize_(computeFixedFormatSize(tokens_)),
+        fixedWidthParse_(supportsFixedWidthParse()) {}
 
   const std::unique_ptr<char[]>& literalBuf() const {
     return literalBuf_;
@@ -179,11 +183,61 @@ class DateTimeFormatter {
       const Timestamp& timestamp,
       const date::time_zone* timezone) const;
 
+  /// Same as above but writes to 'result', e.g. a StringWriter. Formats that
+  /// only have fixed-width fields, e.g. 'yyyy-MM-dd HH:mm:ss', are written in
+  /// place without temporaries.
+  template <typename TOutString>
+  void format(
+      const Timestamp& timestamp,
+      const date::time_zone* timezone,
+      TOutString& result) const {
+    if (fixedFormatSize_.has_value()) {
+      result.resize(*fixedFormatSize_);
+      if (formatFixedWidth(timestamp, timezone, result.data())) {
+        return;
+      }
+    }
+    const auto formatted = format(timestamp, timezone);
+    result.resize(formatted.size());
+    if (!formatted.empty()) {
+      std::memcpy(result.data(), formatted.data(), formatted.size());
+    }
+  }
+
+  /// Returns the size of all format() results for years 1 to 9999 if the
+  /// format only has literals and fixed-width fields.
+  std::optional<size_t> fixedFormatSize() const {
+    return fixedFormatSize_;
+  }
+
  private:
+  static std::optional<size_t> computeFixedFormatSize(
+      const std::vector<DateTimeToken>& tokens);
+
+  // Returns true if inputs of exactly 'fixedFormatSize_' bytes can be parsed
+  // by tryParseFixedWidth(). Requires a Joda format with year, month and day
+  // and, optionally, hour, minute and second of 2 digits, each followed by a
+  // literal without digits or by the end of the format.
+  bool supportsFixedWidthParse() const;
+
+  // Writes the 'fixedFormatSize_' bytes of the formatted 'timestamp' to
+  // 'result'. Returns false if the year is not in [1, 9999].
+  bool formatFixedWidth(
+      const Timestamp& timestamp,
+      const date::time_zone* timezone,
+      char* result) const;
+
+  // Parses 'input' if all fields are digits and in range and all literals
+  // match. Returns std::nullopt otherwise so that parse() reports the error.
+  std::optional<DateTimeResult> tryParseFixedWidth(
+      const std::string_view& input) const;
+
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
   std::vector<DateTimeToken> tokens_;
   DateTimeFormatterType type_;
+  const std::optional<size_t> fixedFormatSize_;
+  const bool fixedWidthParse_;
 };
 
 std::shared_ptr<DateTimeFormatter> buildMysqlDateTimeFormatter(
@@ -31,7 +31,10 @@ constexpr uint8_t kMaxLevel = 60;
 // serialization format changes, this needs to be increased and a new
 // deserializer should be added.  An adapter to convert serialization of
 // previous version to serialization of current version should also be added.
-constexpr int16_t kVersion = 1;
+//
+// Version 2 writes only the retained items, with the level boundaries relative
+// to the first retained item and without size prefixes.
+constexpr int16_t kVersion = 2;
 
 uint32_t computeTotalCapacity(uint32_t k, uint8_t numLevels);
 
@@ -230,14 +233,6 @@ void write(T value, char* out, size_t& offset) {
   offset += sizeof(T);
 }
 
-template <typename T, typename A>
-void writeVector(const std::vector<T, A>& data, char* out, size_t& offset) {
-  write(data.size(), out, offset);
-  auto bytes = sizeof(T) * data.size();
-  memcpy(out + offset, data.data(), bytes);
-  offset += bytes;
-}
-
 template <typename T>
 void read(const char* data, size_t& offset, T& out) {
   out = *reinterpret_cast<const T*>(data + offset);
@@ -631,29 +626,44 @@ void KllSketch<T, A, C>::mergeViews(const folly::Range<const View*>& others) {
       auto gt = [](const Entry& x, const Entry& y) {
         return C()(*y.first, *x.first);
       };
-      std::priority_queue<Entry, std::vector<Entry, AllocEntry>, decltype(gt)>
-          pq(gt, AllocEntry(allocator_));
+      std::vector<Entry, AllocEntry> runs{AllocEntry(allocator_)};
       if (auto sz = safeLevelSize(lvl); sz > 0) {
-        pq.emplace(
+        runs.emplace_back(
             items_.data() + levels_[lvl], items_.data() + levels_[lvl] + sz);
       }
       for (auto& other : others) {
         if (auto sz = other.safeLevelSize(lvl); sz > 0) {
-          pq.emplace(
+          runs.emplace_back(
               &other.items[other.levels[lvl]],
               &other.items[other.levels[lvl]] + sz);
         }
       }
-      int outIndex = worklevels[lvl];
-      while (!pq.empty()) {
-        auto [s, t] = pq.top();
-        pq.pop();
-        workbuf[outIndex++] = *s++;
-        if (s < t) {
-          pq.emplace(s, t);
+      auto* out = workbuf.data() + worklevels[lvl];
+      if (runs.size() == 1) {
+        out = std::copy(runs[0].first, runs[0].second, out);
+      } else if (runs.size() == 2) {
+        // Merging one other sketch, e.g. from mergeDeserialized(), needs no
+        // heap.
+        out = std::merge(
+            runs[0].first,
+            runs[0].second,
+            runs[1].first,
+            runs[1].second,
+            out,
+            C());
+      } else if (runs.size() > 2) {
+        std::priority_queue<Entry, std::vector<Entry, AllocEntry>, decltype(gt)>
+            pq(gt, std::move(runs));
+        while (!pq.empty()) {
+          auto [s, t] = pq.top();
+          pq.pop();
+          *out++ = *s++;
+          if (s < t) {
+            pq.emplace(s, t);
+          }
         }
       }
-      worklevels[lvl + 1] = outIndex;
+      worklevels[lvl + 1] = out - workbuf.data();
     }
     auto result = detail::generalCompress<T, C>(
         k_,
@@ -752,8 +762,8 @@ template <typename T, typename A, typename C>
 size_t KllSketch<T, A, C>::serializedByteSize() const {
   size_t ans = sizeof detail::kVersion + sizeof k_ + sizeof n_;
   ans += sizeof minValue_ + sizeof maxValue_;
-  ans += sizeof(size_t) + sizeof(T) * items_.size();
-  ans += sizeof(size_t) + sizeof(uint32_t) * levels_.size();
+  ans += sizeof(uint8_t) + sizeof(uint32_t) * levels_.size();
+  ans += sizeof(T) * getNumRetained();
   return ans;
 }
 
@@ -765,8 +775,13 @@ void KllSketch<T, A, C>::serialize(char* out) const {
   detail::write(n_, out, i);
   detail::write(minValue_, out, i);
   detail::write(maxValue_, out, i);
-  detail::writeVector(items_, out, i);
-  detail::writeVector(levels_, out, i);
+  detail::write(numLevels(), out, i);
+  for (auto level : levels_) {
+    detail::write<uint32_t>(level - levels_[0], out, i);
+  }
+  const auto bytes = sizeof(T) * getNumRetained();
+  memcpy(out + i, items_.data() + levels_[0], bytes);
+  i += bytes;
   VELOX_DCHECK_EQ(i, serializedByteSize());
 }
 
@@ -775,13 +790,24 @@ void KllSketch<T, A, C>::View::deserialize(const char* data) {
   size_t i = 0;
   int16_t version;
   detail::read(data, i, version);
-  VELOX_CHECK_EQ(version, detail::kVersion, "Unsupported version: {}", version);
+  VELOX_CHECK(
+      version == 1 || version == detail::kVersion,
+      "Unsupported version: {}",
+      version);
   detail::read(data, i, k);
   detail::read(data, i, n);
   detail::read(data, i, minValue);
   detail::read(data, i, maxValue);
-  detail::readRange(data, i, items);
-  detail::readRange(data, i, levels);
+  if (version == 1) {
+    detail::readRange(data, i, items);
+    detail::readRange(data, i, levels);
+    return;
+  }
+  uint8_t numLevels;
+  detail::read(data, i, numLevels);
+  levels.reset(reinterpret_cast<const uint32_t*>(data + i), numLevels + 1);
+  i += sizeof(uint32_t) * levels.size();
+  items.reset(reinterpret_cast<const T*>(data + i), levels.back());
 }
 
 template <typename T, typename A, typename C>
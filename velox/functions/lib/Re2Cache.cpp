@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/lib/Re2Cache.h"
+
+#include <fmt/format.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox::functions {
+
+Re2Cache::Re2Cache(int64_t maxProgramSize) : maxProgramSize_(maxProgramSize) {
+  VELOX_CHECK_GE(maxProgramSize, 0);
+}
+
+// static
+Re2Cache& Re2Cache::instance() {
+  static Re2Cache cache;
+  return cache;
+}
+
+// static
+std::string Re2Cache::makeKey(
+    std::string_view pattern,
+    const RE2::Options& options) {
+  // ParseFlags() covers the boolean options that change the compiled program.
+  // log_errors does not but is part of the returned object's behavior.
+  std::string key = fmt::format(
+      "{}:{}:{}:",
+      options.ParseFlags(),
+      options.log_errors(),
+      options.max_mem());
+  key.append(pattern);
+  return key;
+}
+
+std::shared_ptr<const RE2> Re2Cache::get(
+    std::string_view pattern,
+    const RE2::Options& options) {
+  auto key = makeKey(pattern, options);
+  auto& shard = shards_[folly::hasher<std::string>()(key) % kNumShards];
+  {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      ++numHits_;
+      REPORT_ADD_STAT_VALUE(kCounterRegexCacheHits);
+      return it->second->second;
+    }
+  }
+
+  // Compile outside of the lock. Concurrent misses on the same pattern may
+  // compile it more than once. The first one to finish is cached.
+  ++numMisses_;
+  REPORT_ADD_STAT_VALUE(kCounterRegexCacheMisses);
+  auto re = std::make_shared<const RE2>(
+      re2::StringPiece(pattern.data(), pattern.size()), options);
+  const int64_t size = re->ok() ? re->ProgramSize() : 0;
+  const auto limit = shardLimit();
+  if (size > limit) {
+    return re;
+  }
+
+  uint64_t numEvictions = 0;
+  {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+      return it->second->second;
+    }
+    shard.lru.emplace_front(std::move(key), re);
+    shard.index.emplace(shard.lru.front().first, shard.lru.begin());
+    shard.programSize += size;
+    shard.evictOverLimit(limit, numEvictions);
+  }
+  if (numEvictions > 0) {
+    numEvictions_ += numEvictions;
+    REPORT_ADD_STAT_VALUE(kCounterRegexCacheEvictions, numEvictions);
+  }
+  return re;
+}
+
+void Re2Cache::Shard::evictOverLimit(int64_t limit, uint64_t& numEvictions) {
+  while (programSize > limit && !lru.empty()) {
+    auto& [key, re] = lru.back();
+    programSize -= re->ok() ? re->ProgramSize() : 0;
+    index.erase(key);
+    lru.pop_back();
+    ++numEvictions;
+  }
+}
+
+Re2Cache::Stats Re2Cache::stats() const {
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    stats.programSize += shard.programSize;
+    stats.numEntries += shard.index.size();
+  }
+  return stats;
+}
+
+void Re2Cache::clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.programSize = 0;
+  }
+}
+
+void Re2Cache::setMaxProgramSize(int64_t maxProgramSize) {
+  VELOX_CHECK_GE(maxProgramSize, 0);
+  maxProgramSize_ = maxProgramSize;
+  const auto limit = shardLimit();
+  uint64_t numEvictions = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    shard.evictOverLimit(limit, numEvictions);
+  }
+  numEvictions_ += numEvictions;
+}
+
+} // namespace facebook::velox::functions
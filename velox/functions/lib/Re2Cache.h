@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <folly/container/F14Map.h>
+#include <re2/re2.h>
+
+namespace facebook::velox::functions {
+
+/// Process-wide cache of compiled regular expressions shared by all drivers.
+/// Functions with non-constant patterns look up each distinct pattern here
+/// instead of compiling it per row. Entries are keyed by the pattern and the
+/// RE2 options and evicted in LRU order when the total RE2 program size
+/// exceeds the limit. The cache is split into shards, each with its own lock
+/// and an equal part of the limit.
+class Re2Cache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    /// Sum of RE2::ProgramSize() of the cached expressions.
+    int64_t programSize{0};
+    int64_t numEntries{0};
+  };
+
+  static constexpr int64_t kDefaultMaxProgramSize = 1 << 20;
+
+  explicit Re2Cache(int64_t maxProgramSize = kDefaultMaxProgramSize);
+
+  static Re2Cache& instance();
+
+  /// Returns the compiled 'pattern'. Compiles and caches it on a miss. The
+  /// result may have failed to compile. Callers check ok() as for any RE2.
+  /// Expressions whose program is larger than a shard's limit are returned
+  /// without being cached.
+  std::shared_ptr<const RE2> get(
+      std::string_view pattern,
+      const RE2::Options& options);
+
+  Stats stats() const;
+
+  void clear();
+
+  /// Sets the limit on the total program size and evicts entries over it.
+  void setMaxProgramSize(int64_t maxProgramSize);
+
+ private:
+  static constexpr int32_t kNumShards = 16;
+
+  struct Shard {
+    using Entry = std::pair<std::string, std::shared_ptr<const RE2>>;
+
+    void evictOverLimit(int64_t limit, uint64_t& numEvictions);
+
+    mutable std::mutex mutex;
+    // Most recently used first.
+    std::list<Entry> lru;
+    folly::F14FastMap<std::string_view, std::list<Entry>::iterator> index;
+    int64_t programSize{0};
+  };
+
+  // Returns the cache key made of 'options' and 'pattern'.
+  static std::string makeKey(
+      std::string_view pattern,
+      const RE2::Options& options);
+
+  int64_t shardLimit() const {
+    return maxProgramSize_ / kNumShards;
+  }
+
+  std::atomic<int64_t> maxProgramSize_;
+  std::atomic<uint64_t> numHits_{0};
+  std::atomic<uint64_t> numMisses_{0};
+  std::atomic<uint64_t> numEvictions_{0};
+  Shard shards_[kNumShards];
+};
+
+} // namespace facebook::velox::functions
@@ -16,11 +16,18 @@
 #include "velox/functions/lib/Re2Functions.h"
 
 #include <re2/re2.h>
+#include <array>
+#include <cctype>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/Re2Cache.h"
 #include "velox/type/StringView.h"
 #include "velox/vector/BaseVector.h"
 
@@ -62,6 +69,38 @@ std::optional<T> getIfConstant(const BaseVector& v) {
   return std::nullopt;
 }
 
+// Returns the compiled expressions of non-constant patterns from the
+// process-wide Re2Cache. Remembers the last pattern since consecutive rows
+// often have the same one.
+class CachedRe2Lookup {
+ public:
+  explicit CachedRe2Lookup(RE2::Options options = RE2::Quiet)
+      : options_(std::move(options)) {}
+
+  const RE2& get(std::string_view pattern) {
+    if (re_ == nullptr || pattern != lastPattern_) {
+      re_ = Re2Cache::instance().get(pattern, options_);
+      lastPattern_ = re_->pattern();
+    }
+    return *re_;
+  }
+
+  const RE2& get(StringView pattern) {
+    return get(std::string_view(pattern));
+  }
+
+  std::shared_ptr<const RE2> getShared(std::string_view pattern) {
+    get(pattern);
+    return re_;
+  }
+
+ private:
+  const RE2::Options options_;
+  std::shared_ptr<const RE2> re_;
+  // Points into 're_'.
+  std::string_view lastPattern_;
+};
+
 void checkForBadPattern(const RE2& re) {
   if (UNLIKELY(!re.ok())) {
     VELOX_USER_FAIL("invalid regular expression:{}", re.error());
@@ -212,6 +251,125 @@ class Re2MatchConstantPattern final : public VectorFunction {
   RE2 re_;
 };
 
+// Returns the alternatives of a regular expression that is a '|' separated
+// list of ASCII literals, such as 'error|warn|fatal' or 'a\.b'. Returns
+// std::nullopt if the pattern uses any other syntax.
+std::optional<std::vector<std::string>> parseLiteralAlternatives(
+    StringView pattern) {
+  static constexpr std::string_view kMetaCharacters{".^$*+?()[]{}"};
+  std::vector<std::string> literals(1);
+  for (auto i = 0; i < pattern.size(); ++i) {
+    const char c = pattern.data()[i];
+    if (static_cast<unsigned char>(c) >= 0x80) {
+      return std::nullopt;
+    }
+    if (c == '|') {
+      literals.emplace_back();
+    } else if (c == '\\') {
+      // Only escaped punctuation is literal. Escapes like \d are classes.
+      if (i + 1 == pattern.size() || !std::ispunct(pattern.data()[i + 1])) {
+        return std::nullopt;
+      }
+      literals.back().push_back(pattern.data()[++i]);
+    } else if (kMetaCharacters.find(c) != std::string_view::npos) {
+      return std::nullopt;
+    } else {
+      literals.back().push_back(c);
+    }
+  }
+  return literals;
+}
+
+// Searches for any of several literals without a regular expression. A
+// single literal is searched with simd::simdStrstr. Several literals are
+// found with one pass over the input that filters start positions by a bitmap
+// of the first two bytes of the literals and compares the literals only at
+// positions that pass.
+class Re2SearchLiterals final : public VectorFunction {
+ public:
+  explicit Re2SearchLiterals(std::vector<std::string> literals)
+      : literals_(std::move(literals)) {
+    for (const auto& literal : literals_) {
+      matchesEmpty_ |= literal.empty();
+    }
+    if (matchesEmpty_ || literals_.size() == 1) {
+      return;
+    }
+    pairBits_.resize(bits::nwords(1 << 16));
+    for (auto i = 0; i < literals_.size(); ++i) {
+      const auto& literal = literals_[i];
+      const auto first = static_cast<uint8_t>(literal[0]);
+      if (literal.size() == 1) {
+        singleBytes_[first] = true;
+        continue;
+      }
+      const auto pair = first << 8 | static_cast<uint8_t>(literal[1]);
+      bits::setBit(pairBits_.data(), pair);
+      byPair_[pair].push_back(i);
+    }
+  }
+
+  bool match(StringView input) const {
+    if (matchesEmpty_) {
+      return true;
+    }
+    const char* data = input.data();
+    const size_t size = input.size();
+    if (literals_.size() == 1) {
+      const auto& literal = literals_[0];
+      return simd::simdStrstr(data, size, literal.data(), literal.size()) !=
+          std::string_view::npos;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      const auto first = static_cast<uint8_t>(data[i]);
+      if (singleBytes_[first]) {
+        return true;
+      }
+      if (i + 1 == size) {
+        break;
+      }
+      const auto pair = first << 8 | static_cast<uint8_t>(data[i + 1]);
+      if (!bits::isBitSet(pairBits_.data(), pair)) {
+        continue;
+      }
+      for (auto index : byPair_.at(pair)) {
+        const auto& literal = literals_[index];
+        if (literal.size() <= size - i &&
+            std::memcmp(data + i + 2, literal.data() + 2, literal.size() - 2) ==
+                0) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK_EQ(args.size(), 2);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+      result.set(i, match(toSearch->valueAt<StringView>(i)));
+    });
+  }
+
+ private:
+  const std::vector<std::string> literals_;
+  bool matchesEmpty_{false};
+  // First bytes of literals of one byte.
+  std::array<bool, 256> singleBytes_{};
+  // Bit (first byte << 8 | second byte) is set if a literal starts with these
+  // bytes.
+  std::vector<uint64_t> pairBits_;
+  // Indices in 'literals_' by their first two bytes.
+  folly::F14FastMap<uint16_t, std::vector<int32_t>> byPair_;
+};
+
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2Match final : public VectorFunction {
  public:
@@ -231,8 +389,9 @@ class Re2Match final : public VectorFunction {
     FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     exec::LocalDecodedVector pattern(context, *args[1], rows);
+    CachedRe2Lookup lookup;
     context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-      RE2 re(toStringPiece(pattern->valueAt<StringView>(row)), RE2::Quiet);
+      const auto& re = lookup.get(pattern->valueAt<StringView>(row));
       checkForBadPattern(re);
       result.set(row, Fn(toSearch->valueAt<StringView>(row), re));
     });
@@ -349,18 +508,19 @@ class Re2SearchAndExtract final : public VectorFunction {
       return;
     }
 
-    // The general case. Further optimizations are possible to avoid regex
-    // recompilation, but a constant pattern is by far the most common case.
+    // The general case. The compiled patterns come from the process-wide
+    // cache.
     FlatVector<StringView>& result =
         ensureWritableStringView(rows, context, resultRef);
     exec::LocalDecodedVector toSearch(context, *args[0], rows);
     exec::LocalDecodedVector pattern(context, *args[1], rows);
+    CachedRe2Lookup lookup;
     bool mustRefSourceStrings = false;
     FOLLY_DECLARE_REUSED(groups, std::vector<re2::StringPiece>);
     if (args.size() == 2) {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(i)), RE2::Quiet);
+        const auto& re = lookup.get(pattern->valueAt<StringView>(i));
         checkForBadPattern(re);
         mustRefSourceStrings |=
             re2Extract(result, i, re, toSearch, groups, 0, emptyNoMatch_);
@@ -369,7 +529,7 @@ class Re2SearchAndExtract final : public VectorFunction {
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         const auto groupId = groupIds->valueAt<T>(i);
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(i)), RE2::Quiet);
+        const auto& re = lookup.get(pattern->valueAt<StringView>(i));
         checkForBadPattern(re);
         checkForBadGroupId(groupId, re);
         groups.resize(groupId + 1);
@@ -479,6 +639,147 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
   vector_size_t reducedPatternLength_;
 };
 
+// A LIKE pattern made of literals separated by '%' wildcards, such as
+// '%foo%bar%', 'foo%bar' or '%a#%b%' with escape character '#'.
+struct SubstringsPattern {
+  // The literals between '%' in order. An escaped '%' or '_' is part of a
+  // literal.
+  std::vector<std::string> literals;
+  // True if the pattern does not start with '%'.
+  bool anchoredStart{true};
+  // True if the pattern does not end with '%'.
+  bool anchoredEnd{true};
+};
+
+// Returns the literals and anchors of 'pattern' or std::nullopt if 'pattern'
+// has a '_' wildcard or an invalid escape.
+std::optional<SubstringsPattern> parseSubstringsPattern(
+    StringView pattern,
+    std::optional<char> escapeChar) {
+  SubstringsPattern result;
+  std::string literal;
+  bool lastIsWildcard = false;
+  for (auto i = 0; i < pattern.size(); ++i) {
+    const char c = pattern.data()[i];
+    lastIsWildcard = false;
+    if (escapeChar.has_value() && c == escapeChar.value()) {
+      if (i + 1 == pattern.size()) {
+        return std::nullopt;
+      }
+      const char escaped = pattern.data()[++i];
+      if (escaped != '%' && escaped != '_' && escaped != escapeChar.value()) {
+        return std::nullopt;
+      }
+      literal.push_back(escaped);
+    } else if (c == '_') {
+      return std::nullopt;
+    } else if (c == '%') {
+      if (i == 0) {
+        result.anchoredStart = false;
+      }
+      if (!literal.empty()) {
+        result.literals.push_back(std::move(literal));
+        literal.clear();
+      }
+      lastIsWildcard = true;
+    } else {
+      literal.push_back(c);
+    }
+  }
+  if (!literal.empty()) {
+    result.literals.push_back(std::move(literal));
+  }
+  result.anchoredEnd = !lastIsWildcard;
+  return result;
+}
+
+// Matches LIKE patterns of literals separated by '%' by searching for the
+// literals in order with simd::simdStrstr. The leftmost match of each literal
+// leaves the most room for the next ones, so no backtracking is needed.
+class LikeWithSubstrings final : public VectorFunction {
+ public:
+  explicit LikeWithSubstrings(SubstringsPattern pattern)
+      : pattern_(std::move(pattern)) {}
+
+  bool match(StringView input) const {
+    const auto& literals = pattern_.literals;
+    if (literals.empty()) {
+      return !pattern_.anchoredStart || input.size() == 0;
+    }
+    const char* data = input.data();
+    size_t begin = 0;
+    size_t end = input.size();
+    size_t first = 0;
+    size_t last = literals.size();
+    if (pattern_.anchoredStart) {
+      const auto& prefix = literals[0];
+      if (end < prefix.size() ||
+          std::memcmp(data, prefix.data(), prefix.size()) != 0) {
+        return false;
+      }
+      begin = prefix.size();
+      ++first;
+    }
+    if (pattern_.anchoredEnd) {
+      if (first == last) {
+        // The pattern is a single literal without '%'.
+        return begin == end;
+      }
+      const auto& suffix = literals[last - 1];
+      if (end - begin < suffix.size() ||
+          std::memcmp(
+              data + end - suffix.size(), suffix.data(), suffix.size()) != 0) {
+        return false;
+      }
+      end -= suffix.size();
+      --last;
+    }
+    for (auto i = first; i < last; ++i) {
+      const auto& literal = literals[i];
+      const auto offset = simd::simdStrstr(
+          data + begin, end - begin, literal.data(), literal.size());
+      if (offset == std::string_view::npos) {
+        return false;
+      }
+      begin += offset + literal.size();
+    }
+    return true;
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK(args.size() == 2 || args.size() == 3);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto toSearch = decodedArgs.at(0);
+
+    if (toSearch->isIdentityMapping()) {
+      auto input = toSearch->data<StringView>();
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, match(input[i])); });
+      return;
+    }
+    if (toSearch->isConstantMapping()) {
+      bool matchResult = match(toSearch->valueAt<StringView>(0));
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, matchResult); });
+      return;
+    }
+
+    // Since the likePattern and escapeChar (2nd and 3rd args) are both
+    // constants, so the first arg is expected to be either of flat or constant
+    // vector only. This code path is unreachable.
+    VELOX_UNREACHABLE();
+  }
+
+ private:
+  const SubstringsPattern pattern_;
+};
+
 // This function is used when pattern and escape are constants. And there is not
 // fast path that avoids compiling the regular expression.
 class LikeWithRe2 final : public VectorFunction {
@@ -547,7 +848,8 @@ class LikeWithRe2 final : public VectorFunction {
 // This function is constructed when pattern or escape are not constants.
 // It allows up to kMaxCompiledRegexes different regular expressions to be
 // compiled throughout the query life per function, note that optimized regular
-// expressions that are not compiled are not counted.
+// expressions that are not compiled are not counted. The compiled expressions
+// are shared with other drivers through the process-wide Re2Cache.
 class LikeGeneric final : public VectorFunction {
   void apply(
       const SelectivityVector& rows,
@@ -556,23 +858,29 @@ class LikeGeneric final : public VectorFunction {
       EvalCtx& context,
       VectorPtr& result) const final {
     VectorPtr localResult;
+    RE2::Options opt{RE2::Quiet};
+    opt.set_dot_nl(true);
+    CachedRe2Lookup lookup(opt);
 
     auto applyWithRegex = [&](const StringView& input,
                               const StringView& pattern,
                               const std::optional<char>& escapeChar) -> bool {
-      RE2::Options opt{RE2::Quiet};
-      opt.set_dot_nl(true);
+      auto key = std::pair<std::string, std::optional<char>>{
+          std::string(pattern), escapeChar};
+      auto it = compiledRegularExpressions_.find(key);
+      if (it != compiledRegularExpressions_.end()) {
+        checkForBadPattern(*it->second);
+        return re2FullMatch(input, *it->second);
+      }
+
       bool validEscapeUsage;
       auto regex = likePatternToRe2(pattern, escapeChar, validEscapeUsage);
       VELOX_USER_CHECK(
           validEscapeUsage,
           "Escape character must be followed by '%', '_' or the escape character itself");
 
-      auto key =
-          std::pair<StringView, std::optional<char>>{pattern, escapeChar};
-
-      auto [it, inserted] = compiledRegularExpressions_.emplace(
-          key, std::make_unique<RE2>(toStringPiece(regex), opt));
+      it = compiledRegularExpressions_.emplace(key, lookup.getShared(regex))
+               .first;
       VELOX_CHECK_LE(
           compiledRegularExpressions_.size(),
           kMaxCompiledRegexes,
@@ -648,7 +956,7 @@ class LikeGeneric final : public VectorFunction {
  private:
   mutable folly::F14FastMap<
       std::pair<std::string, std::optional<char>>,
-      std::unique_ptr<RE2>>
+      std::shared_ptr<const RE2>>
       compiledRegularExpressions_;
 };
 
@@ -785,13 +1093,14 @@ class Re2ExtractAll final : public VectorFunction {
     exec::LocalDecodedVector inputStrs(context, *args[0], rows);
     exec::LocalDecodedVector pattern(context, *args[1], rows);
     FOLLY_DECLARE_REUSED(groups, std::vector<re2::StringPiece>);
+    CachedRe2Lookup lookup;
 
     if (args.size() == 2) {
       // Case 1: No groupId -- use 0 as the default groupId
       //
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(row)), RE2::Quiet);
+        const auto& re = lookup.get(pattern->valueAt<StringView>(row));
         checkForBadPattern(re);
         re2ExtractAll(resultWriter, re, inputStrs, row, groups, 0);
       });
@@ -801,7 +1110,7 @@ class Re2ExtractAll final : public VectorFunction {
       exec::LocalDecodedVector groupIds(context, *args[2], rows);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t row) {
         const T groupId = groupIds->valueAt<T>(row);
-        RE2 re(toStringPiece(pattern->valueAt<StringView>(row)), RE2::Quiet);
+        const auto& re = lookup.get(pattern->valueAt<StringView>(row));
         checkForBadPattern(re);
         checkForBadGroupId(groupId, re);
         groups.resize(groupId + 1);
@@ -862,6 +1171,15 @@ std::shared_ptr<VectorFunction> makeRe2Search(
     const std::string& name,
     const std::vector<VectorFunctionArg>& inputArgs,
     const core::QueryConfig& /*config*/) {
+  if (inputArgs.size() == 2 && inputArgs[0].type->isVarchar()) {
+    BaseVector* constantPattern = inputArgs[1].constantValue.get();
+    if (constantPattern != nullptr && !constantPattern->isNullAt(0)) {
+      if (auto literals = parseLiteralAlternatives(
+              constantPattern->as<ConstantVector<StringView>>()->valueAt(0))) {
+        return std::make_shared<Re2SearchLiterals>(std::move(*literals));
+      }
+    }
+  }
   return makeRe2MatchImpl<re2PartialMatch>(name, inputArgs);
 }
 
@@ -1091,11 +1409,13 @@ std::shared_ptr<exec::VectorFunction> makeLike(
         return std::make_shared<OptimizedLikeWithMemcmp<PatternKind::kSuffix>>(
             pattern, reducedLength);
       default:
-
-        return std::make_shared<LikeWithRe2>(pattern, escapeChar);
+        break;
     }
   }
 
+  if (auto substrings = parseSubstringsPattern(pattern, escapeChar)) {
+    return std::make_shared<LikeWithSubstrings>(std::move(*substrings));
+  }
   return std::make_shared<LikeWithRe2>(pattern, escapeChar);
 }
 
@@ -19,6 +19,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <folly/container/F14Set.h>
+
 #include "velox/common/memory/MemoryPool.h"
 #include "velox/functions/lib/SubscriptUtil.h"
 #include "velox/type/Type.h"
@@ -57,15 +59,15 @@ VectorPtr applyMapTyped(
   static constexpr vector_size_t kMinCachedMapSize = 100;
   using TKey = typename TypeTraits<kind>::NativeType;
 
+  LookupTable<kind>* typedLookupTable = nullptr;
   if (triggeCaching) {
     if (!cachedLookupTablePtr) {
       cachedLookupTablePtr =
           std::make_shared<LookupTable<kind>>(*context.pool());
     }
+    typedLookupTable = &cachedLookupTablePtr->typedTable<kind>();
   }
 
-  auto& typedLookupTable = cachedLookupTablePtr->typedTable<kind>();
-
   auto* pool = context.pool();
   BufferPtr indices = allocateIndices(rows.end(), pool);
   auto rawIndices = indices->asMutable<vector_size_t>();
@@ -94,6 +96,44 @@ VectorPtr applyMapTyped(
   auto rawSizes = baseMap->rawSizes();
   auto rawOffsets = baseMap->rawOffsets();
 
+  // Without a cached table, a large map that several rows of this batch look
+  // up, e.g. a constant or dictionary encoded map, is indexed on its second
+  // lookup. The table lives for this call only.
+  const bool indexRepeatedMaps =
+      !triggeCaching && !decodedMap->isIdentityMapping();
+  std::unique_ptr<LookupTable<kind>> batchLookupTable;
+  folly::F14FastSet<vector_size_t> seenMapIndices;
+
+  // Returns the table to index the map at 'mapIndex' in or nullptr to scan
+  // the map.
+  auto lookupTableFor = [&](vector_size_t mapIndex,
+                            vector_size_t size) -> LookupTable<kind>* {
+    if (size < kMinCachedMapSize) {
+      return nullptr;
+    }
+    if (typedLookupTable) {
+      return typedLookupTable;
+    }
+    if (!indexRepeatedMaps) {
+      return nullptr;
+    }
+    if (batchLookupTable && batchLookupTable->containsMapAtIndex(mapIndex)) {
+      return batchLookupTable.get();
+    }
+    if (seenMapIndices.insert(mapIndex).second) {
+      return nullptr;
+    }
+    if (!batchLookupTable) {
+      batchLookupTable = std::make_unique<LookupTable<kind>>(*pool);
+    }
+    return batchLookupTable.get();
+  };
+
+  // Position of the last key found, relative to the start of its map. Maps
+  // that share a key layout, e.g. flat maps read from DWRF, usually have the
+  // next key at the same position, so it is checked before scanning.
+  vector_size_t lastFoundPosition = -1;
+
   // Lambda that does the search for a key, for each row.
   auto processRow = [&](vector_size_t row, TKey searchKey) {
     size_t mapIndex = mapIndices[row];
@@ -102,18 +142,18 @@ VectorPtr applyMapTyped(
     size_t offsetEnd = offsetStart + size;
     bool found = false;
 
-    if (triggeCaching && size >= kMinCachedMapSize) {
+    if (auto* lookupTable = lookupTableFor(mapIndex, size)) {
       // Create map for mapIndex if not created.
-      if (!typedLookupTable.containsMapAtIndex(mapIndex)) {
-        typedLookupTable.ensureMapAtIndex(mapIndex);
+      if (!lookupTable->containsMapAtIndex(mapIndex)) {
+        lookupTable->ensureMapAtIndex(mapIndex);
         // Materialize the map at index row.
-        auto& map = typedLookupTable.getMapAtIndex(mapIndex);
+        auto& map = lookupTable->getMapAtIndex(mapIndex);
         for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
           map.emplace(decodedMapKeys->valueAt<TKey>(offset), offset);
         }
       }
 
-      auto& map = typedLookupTable.getMapAtIndex(mapIndex);
+      auto& map = lookupTable->getMapAtIndex(mapIndex);
 
       // Fast lookup.
       auto value = map.find(searchKey);
@@ -122,11 +162,18 @@ VectorPtr applyMapTyped(
         found = true;
       }
 
+    } else if (
+        lastFoundPosition >= 0 && lastFoundPosition < size &&
+        decodedMapKeys->valueAt<TKey>(offsetStart + lastFoundPosition) ==
+            searchKey) {
+      rawIndices[row] = offsetStart + lastFoundPosition;
+      found = true;
     } else {
       // Search map without caching.
       for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
         if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
           rawIndices[row] = offset;
+          lastFoundPosition = offset - offsetStart;
           found = true;
           break;
         }
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <optional>
+
 #include <velox/type/Timestamp.h>
 #include "velox/core/QueryConfig.h"
 #include "velox/external/date/tz.h"
@@ -101,6 +103,21 @@ struct InitSessionTimezone {
       const core::QueryConfig& config,
       const arg_type<Timestamp>* /*timestamp*/) {
     timeZone_ = getTimeZoneFromConfig(config);
+    if (timeZone_ != nullptr) {
+      sessionTimezoneOffsets_.emplace(timeZone_);
+    }
+  }
+
+  /// Same as getDateTime(timestamp, timeZone_) but looks up the time zone only
+  /// when 'timestamp' is in a different transition interval than the last one.
+  FOLLY_ALWAYS_INLINE std::tm toSessionDateTime(Timestamp timestamp) {
+    if (sessionTimezoneOffsets_.has_value()) {
+      sessionTimezoneOffsets_->toTimezone(timestamp);
+    }
+    return getDateTime(timestamp, nullptr);
   }
+
+ private:
+  std::optional<TimezoneOffsetCache> sessionTimezoneOffsets_;
 };
 } // namespace facebook::velox::functions
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Aggregate.h"
 #include "velox/functions/lib/aggregates/DecimalAggregate.h"
+#include "velox/functions/lib/aggregates/DenseGroupAccumulators.h"
 #include "velox/type/DecimalUtil.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
@@ -172,6 +173,55 @@ class AverageAggregateBase : public exec::Aggregate {
     }
   }
 
+  void addRawInputForDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    decodedRaw_.decode(*args[0], rows);
+    if (decodedRaw_.isConstantMapping() && decodedRaw_.isNullAt(0)) {
+      return;
+    }
+
+    denseAccumulators_.reset(numGroupIds);
+    auto add = [&](vector_size_t i, TAccumulator value) {
+      denseAccumulators_.add(
+          groups[i],
+          groupIds[i],
+          SumCount<TAccumulator>{value, 1},
+          [](SumCount<TAccumulator>& sumCount,
+             const SumCount<TAccumulator>& other) {
+            sumCount.sum += other.sum;
+            sumCount.count += other.count;
+          });
+    };
+    if (decodedRaw_.isConstantMapping()) {
+      const TAccumulator value(decodedRaw_.valueAt<TInput>(0));
+      rows.applyToSelected([&](vector_size_t i) { add(i, value); });
+    } else if (decodedRaw_.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decodedRaw_.isNullAt(i)) {
+          add(i, TAccumulator(decodedRaw_.valueAt<TInput>(i)));
+        }
+      });
+    } else if (decodedRaw_.isIdentityMapping()) {
+      auto data = decodedRaw_.data<TInput>();
+      rows.applyToSelected(
+          [&](vector_size_t i) { add(i, TAccumulator(data[i])); });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        add(i, TAccumulator(decodedRaw_.valueAt<TInput>(i)));
+      });
+    }
+
+    denseAccumulators_.forEach(
+        [&](char* group, const SumCount<TAccumulator>& sumCount) {
+          updateNonNullValue(group, sumCount.count, sumCount.sum);
+        });
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -387,6 +437,8 @@ class AverageAggregateBase : public exec::Aggregate {
 
   DecodedVector decodedRaw_;
   DecodedVector decodedPartial_;
+  // Scratch for addRawInputForDenseGroups().
+  DenseGroupAccumulators<SumCount<TAccumulator>> denseAccumulators_;
 };
 
 template <typename TUnscaledType>
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RawVector.h"
+
+namespace facebook::velox::functions::aggregate {
+
+/// Scratch accumulators indexed by dense group id. Used by
+/// exec::Aggregate::addRawInputForDenseGroups() implementations to combine
+/// the rows of a batch per group in a small contiguous array before
+/// updating each group row of the hash table once.
+template <typename T>
+class DenseGroupAccumulators {
+ public:
+  /// Clears the accumulators and prepares for group ids below 'numGroupIds'.
+  void reset(int32_t numGroupIds) {
+    numGroupIds_ = numGroupIds;
+    values_.resize(numGroupIds);
+    groups_.resize(numGroupIds);
+    hasValue_.resize(bits::nwords(numGroupIds));
+    std::fill(hasValue_.begin(), hasValue_.end(), 0);
+  }
+
+  /// Combines 'value' into the accumulator of 'groupId' with
+  /// 'update(T& accumulator, const T& value)'. The first value of a group
+  /// initializes its accumulator. 'group' is the row of 'groupId'.
+  template <typename Update>
+  FOLLY_ALWAYS_INLINE void
+  add(char* group, uint64_t groupId, const T& value, Update update) {
+    VELOX_DCHECK_LT(groupId, numGroupIds_);
+    if (bits::isBitSet(hasValue_.data(), groupId)) {
+      update(values_[groupId], value);
+    } else {
+      bits::setBit(hasValue_.data(), groupId);
+      values_[groupId] = value;
+      groups_[groupId] = group;
+    }
+  }
+
+  /// Calls 'func(char* group, const T& accumulator)' for each group that
+  /// received a value since the last reset().
+  template <typename Func>
+  void forEach(Func func) const {
+    bits::forEachSetBit(hasValue_.data(), 0, numGroupIds_, [&](auto groupId) {
+      func(groups_[groupId], values_[groupId]);
+    });
+  }
+
+ private:
+  int32_t numGroupIds_{0};
+  raw_vector<T> values_;
+  raw_vector<char*> groups_;
+  std::vector<uint64_t> hasValue_;
+};
+
+} // namespace facebook::velox::functions::aggregate
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
+#include "velox/functions/lib/aggregates/DenseGroupAccumulators.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/LazyVector.h"
@@ -141,6 +142,55 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Same as updateGroups() for groups with dense ids below 'numGroupIds'.
+  // Combines the values of each group in 'denseAccumulators_' and updates
+  // each group once. 'updateSingleValue' must be commutative and associative
+  // since the values are not combined in row order.
+  template <
+      bool tableHasNulls,
+      typename TValue = TInput,
+      typename UpdateSingleValue>
+  void updateDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      UpdateSingleValue updateSingleValue) {
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping() && decoded.isNullAt(0)) {
+      return;
+    }
+
+    denseAccumulators_.reset(numGroupIds);
+    auto add = [&](vector_size_t i, TAccumulator value) {
+      denseAccumulators_.add(groups[i], groupIds[i], value, updateSingleValue);
+    };
+    if (decoded.isConstantMapping()) {
+      const TAccumulator value(decoded.valueAt<TValue>(0));
+      rows.applyToSelected([&](vector_size_t i) { add(i, value); });
+    } else if (decoded.mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          add(i, TAccumulator(decoded.valueAt<TValue>(i)));
+        }
+      });
+    } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+      auto data = decoded.data<TValue>();
+      rows.applyToSelected(
+          [&](vector_size_t i) { add(i, TAccumulator(data[i])); });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        add(i, TAccumulator(decoded.valueAt<TValue>(i)));
+      });
+    }
+
+    denseAccumulators_.forEach([&](char* group, TAccumulator value) {
+      updateNonNullValue<tableHasNulls, TAccumulator>(
+          group, value, updateSingleValue);
+    });
+  }
+
   // TData is used to store the updated group state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
@@ -159,6 +209,17 @@ class SimpleNumericAggregate : public exec::Aggregate {
       UpdateDuplicate updateDuplicateValues,
       bool /*mayPushdown*/,
       TData initialValue) {
+    if (arg->encoding() == VectorEncoding::Simple::SEQUENCE &&
+        rows.isAllSelected()) {
+      updateOneGroupFromRuns<TData, TValue>(
+          group,
+          rows.end(),
+          *arg,
+          updateSingleValue,
+          updateDuplicateValues,
+          initialValue);
+      return;
+    }
     DecodedVector decoded(*arg, rows);
 
     // Do row by row if not all rows are selected.
@@ -192,6 +253,39 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Updates 'group' with the first 'numRows' rows of 'sequenceVector' once
+  // per run, with the value of the run repeated for the length of the run, as
+  // the constant case in updateOneGroup() does for a whole vector.
+  template <
+      typename TData,
+      typename TValue,
+      typename UpdateSingle,
+      typename UpdateDuplicate>
+  void updateOneGroupFromRuns(
+      char* group,
+      vector_size_t numRows,
+      const BaseVector& sequenceVector,
+      UpdateSingle updateSingleValue,
+      UpdateDuplicate updateDuplicateValues,
+      TData initialValue) {
+    const auto* lengths = sequenceVector.wrapInfo()->as<vector_size_t>();
+    const auto& runValues = sequenceVector.valueVector();
+    DecodedVector decodedRuns(*runValues);
+    vector_size_t row = 0;
+    for (vector_size_t run = 0; run < runValues->size() && row < numRows;
+         ++run) {
+      const auto length = std::min(lengths[run], numRows - row);
+      row += length;
+      if (decodedRuns.isNullAt(run)) {
+        continue;
+      }
+      TData runValue = initialValue;
+      updateDuplicateValues(
+          runValue, TData(decodedRuns.valueAt<TValue>(run)), length);
+      updateNonNullValue<true, TData>(group, runValue, updateSingleValue);
+    }
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
@@ -225,6 +319,9 @@ class SimpleNumericAggregate : public exec::Aggregate {
         RowSet(indices, numIndices), &hook);
   }
 
+  // Scratch for updateDenseGroups().
+  DenseGroupAccumulators<TAccumulator> denseAccumulators_;
+
  private:
   // TData is either TAccumulator or TResult, which in most cases are the same,
   // but for sum(real) can differ.
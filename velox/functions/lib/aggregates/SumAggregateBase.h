@@ -79,6 +79,38 @@ class SumAggregateBase
     updateInternal<TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  void addRawInputForDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    const auto& arg = args[0];
+    if (mayPushdown && arg->isLazy()) {
+      updateInternal<TAccumulator>(groups, rows, args, mayPushdown);
+      return;
+    }
+
+    if (exec::Aggregate::numNulls_) {
+      BaseAggregate::template updateDenseGroups<true>(
+          groups,
+          groupIds,
+          numGroupIds,
+          rows,
+          arg,
+          &updateSingleValue<TAccumulator>);
+    } else {
+      BaseAggregate::template updateDenseGroups<false>(
+          groups,
+          groupIds,
+          numGroupIds,
+          rows,
+          arg,
+          &updateSingleValue<TAccumulator>);
+    }
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -17,6 +17,7 @@
 #include <velox/common/base/VeloxException.h>
 #include <velox/type/StringView.h>
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/external/date/tz.h"
 #include "velox/functions/lib/DateTimeFormatterBuilder.h"
 #include "velox/type/TimestampConversion.h"
@@ -1355,6 +1356,75 @@ TEST_F(JodaDateTimeFormatterTest, parseConsecutiveSpecifiers) {
   EXPECT_THROW(parseJoda("12312", "yyH"), VeloxUserError);
 }
 
+TEST_F(JodaDateTimeFormatterTest, fixedWidth) {
+  EXPECT_EQ(10, buildJodaDateTimeFormatter("yyyy-MM-dd")->fixedFormatSize());
+  EXPECT_EQ(
+      23,
+      buildJodaDateTimeFormatter("yyyy-MM-dd'T'HH:mm:ss.SSS")
+          ->fixedFormatSize());
+  EXPECT_FALSE(
+      buildJodaDateTimeFormatter("yyyy-M-d")->fixedFormatSize().has_value());
+  EXPECT_FALSE(
+      buildJodaDateTimeFormatter("yyyy-MMM")->fixedFormatSize().has_value());
+
+  // Formatting in place gives the same results as the general path, also
+  // for years that are not formatted in 4 digits.
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  for (const auto* format :
+       {"yyyy-MM-dd", "yyyy-MM-dd HH:mm:ss", "yyyy-MM-dd'T'HH:mm:ss.SSSSSS",
+        "dd/MM/yyyy HH:mm:ss.S", "YYYY"}) {
+    auto formatter = buildJodaDateTimeFormatter(format);
+    for (auto seconds :
+         {0L,
+          -1L,
+          951782400L,
+          1615712399L,
+          1615712400L,
+          253402300799L,
+          253402300800L,
+          -62135596800L,
+          -62135596801L}) {
+      Timestamp timestamp(seconds, 123'456'789);
+      for (const auto* zone : {timezone, (const date::time_zone*)nullptr}) {
+        std::string result;
+        formatter->format(timestamp, zone, result);
+        EXPECT_EQ(formatter->format(timestamp, zone), result)
+            << format << " " << seconds;
+      }
+    }
+  }
+}
+
+TEST_F(JodaDateTimeFormatterTest, parseFixedWidth) {
+  EXPECT_EQ(
+      util::fromTimestampString("2019-07-03 11:04:10"),
+      parseJoda("2019-07-03 11:04:10", "yyyy-MM-dd HH:mm:ss").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2020-02-29"),
+      parseJoda("2020-02-29", "yyyy-MM-dd").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("2019-07-03 11:04:10"),
+      parseJoda("03/07/2019T11:04:10", "dd/MM/yyyy'T'HH:mm:ss").timestamp);
+  EXPECT_EQ(-1, parseJoda("2020-02-29", "yyyy-MM-dd").timezoneId);
+
+  // Inputs that do not fit the fixed-width layout go through the general
+  // parser with its errors.
+  EXPECT_EQ(
+      util::fromTimestampString("2019-07-03"),
+      parseJoda("2019-7-3", "yyyy-MM-dd").timestamp);
+  EXPECT_EQ(
+      util::fromTimestampString("20190-07-03"),
+      parseJoda("20190-07-03", "yyyy-MM-dd").timestamp);
+  VELOX_ASSERT_THROW(
+      parseJoda("2019-13-03", "yyyy-MM-dd"),
+      "Value 13 for monthOfYear must be in the range [1,12]");
+  VELOX_ASSERT_THROW(
+      parseJoda("2019-02-29", "yyyy-MM-dd"),
+      "Value 29 for dayOfMonth must be in the range [1,28]");
+  VELOX_ASSERT_THROW(
+      parseJoda("2019-02-2x", "yyyy-MM-dd"), "Invalid format");
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
@@ -241,6 +241,26 @@ TEST(KllSketchTest, serialize) {
   EXPECT_EQ(v, v2);
 }
 
+TEST(KllSketchTest, serializeRetainedItemsOnly) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  insertRandomData(0, N, kll, nullptr);
+  kll.finish();
+  // The random values have no duplicates, so compaction only drops the free
+  // space below the bottom level, which is not serialized either.
+  auto compacted = kll;
+  compacted.compact();
+  EXPECT_EQ(kll.serializedByteSize(), compacted.serializedByteSize());
+  std::vector<char> data(kll.serializedByteSize());
+  kll.serialize(data.data());
+  auto kll2 = KllSketch<double>::deserialize(data.data());
+  auto q = linspace(M);
+  auto v = kll.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  auto v2 = kll2.estimateQuantiles(folly::Range(q.begin(), q.end()));
+  EXPECT_EQ(v, v2);
+}
+
 TEST(KllSketchTest, deserialize) {
   constexpr int N = 1e5;
   constexpr int M = 1001;
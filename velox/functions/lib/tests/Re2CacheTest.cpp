@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/lib/Re2Cache.h"
+
+#include <thread>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::functions;
+
+TEST(Re2CacheTest, hitsAndMisses) {
+  Re2Cache cache;
+  auto re = cache.get("a+b", RE2::Quiet);
+  ASSERT_TRUE(re->ok());
+  EXPECT_TRUE(RE2::FullMatch("aab", *re));
+  EXPECT_EQ(re, cache.get("a+b", RE2::Quiet));
+
+  // The options are part of the key.
+  RE2::Options options{RE2::Quiet};
+  options.set_case_sensitive(false);
+  auto caseInsensitive = cache.get("a+b", options);
+  EXPECT_NE(re, caseInsensitive);
+  EXPECT_TRUE(RE2::FullMatch("AAB", *caseInsensitive));
+
+  // Invalid patterns are returned and cached like any other.
+  EXPECT_FALSE(cache.get("(a", RE2::Quiet)->ok());
+
+  auto stats = cache.stats();
+  EXPECT_EQ(1, stats.numHits);
+  EXPECT_EQ(3, stats.numMisses);
+  EXPECT_EQ(0, stats.numEvictions);
+  EXPECT_EQ(3, stats.numEntries);
+  EXPECT_EQ(
+      re->ProgramSize() + caseInsensitive->ProgramSize(), stats.programSize);
+
+  cache.clear();
+  EXPECT_EQ(0, cache.stats().numEntries);
+  EXPECT_NE(re, cache.get("a+b", RE2::Quiet));
+}
+
+TEST(Re2CacheTest, eviction) {
+  // Each shard holds a few small expressions.
+  Re2Cache cache(16 * 100);
+  for (auto i = 0; i < 1'000; ++i) {
+    cache.get(fmt::format("a{}b", i), RE2::Quiet);
+  }
+  auto stats = cache.stats();
+  EXPECT_EQ(1'000, stats.numMisses);
+  EXPECT_LT(0, stats.numEvictions);
+  EXPECT_EQ(1'000, stats.numEntries + stats.numEvictions);
+  EXPECT_GE(16 * 100, stats.programSize);
+
+  // Expressions larger than a shard's limit are not cached.
+  auto large = cache.get("(abc|def|ghi){1,50}", RE2::Quiet);
+  ASSERT_LT(100, large->ProgramSize());
+  EXPECT_NE(large, cache.get("(abc|def|ghi){1,50}", RE2::Quiet));
+
+  cache.setMaxProgramSize(0);
+  stats = cache.stats();
+  EXPECT_EQ(0, stats.numEntries);
+  EXPECT_EQ(0, stats.programSize);
+}
+
+TEST(Re2CacheTest, concurrency) {
+  Re2Cache cache;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 8; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < 1'000; ++j) {
+        auto re = cache.get(fmt::format("x{}y", j % 50), RE2::Quiet);
+        ASSERT_TRUE(RE2::FullMatch(fmt::format("x{}y", j % 50), *re));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto stats = cache.stats();
+  EXPECT_EQ(50, stats.numEntries);
+  EXPECT_EQ(8'000, stats.numHits + stats.numMisses);
+}
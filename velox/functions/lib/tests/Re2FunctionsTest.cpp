@@ -369,6 +369,39 @@ void testRe2Extract(F&& regexExtract) {
   EXPECT_EQ(regexExtract(" 123 ", "\\d+", std::nullopt), std::nullopt);
 }
 
+TEST_F(Re2FunctionsTest, regexSearchLiterals) {
+  // Alternations of literals are matched without RE2. Compare with the
+  // non-constant pattern, which always uses RE2.
+  auto search = [&](const std::string& str, const std::string& pattern) {
+    auto result = evaluateOnce<bool>(
+        "re2_search(c0, '" + pattern + "')", std::optional<std::string>(str));
+    EXPECT_EQ(
+        result,
+        evaluateOnce<bool>(
+            "re2_search(c0, c1)",
+            std::optional<std::string>(str),
+            std::optional<std::string>(pattern)))
+        << str << " " << pattern;
+    return result.value();
+  };
+
+  EXPECT_TRUE(search("an error occurred", "warn|error|fatal"));
+  EXPECT_TRUE(search("fatal", "warn|error|fatal"));
+  EXPECT_FALSE(search("all good", "warn|error|fatal"));
+  EXPECT_FALSE(search("erro", "warn|error|fatal"));
+  EXPECT_TRUE(search("abc", "z|c"));
+  EXPECT_FALSE(search("abc", "z|d|error"));
+  EXPECT_TRUE(search("xyz", "xyz"));
+  EXPECT_TRUE(search("a.b", "a\\.b"));
+  EXPECT_FALSE(search("axb", "a\\.b"));
+  EXPECT_TRUE(search("abc", "x|"));
+  EXPECT_TRUE(search("", ""));
+  EXPECT_EQ(
+      evaluateOnce<bool>(
+          "re2_search(c0, 'a|b')", std::optional<std::string>(std::nullopt)),
+      std::nullopt);
+}
+
 TEST_F(Re2FunctionsTest, regexExtract) {
   testRe2Extract([&](std::optional<std::string> str,
                      std::optional<std::string> pattern,
@@ -634,6 +667,26 @@ TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
       !evaluateOnce<bool>("like('a', 'a', cast(null as varchar))").has_value());
 }
 
+TEST_F(Re2FunctionsTest, likePatternSubstrings) {
+  testLike("abcdef", "%b%d%", true);
+  testLike("abcdef", "%d%b%", false);
+  testLike("abcdef", "a%c%f", true);
+  testLike("abcdef", "a%c%e", false);
+  testLike("abcdef", "%c%ef", true);
+  testLike("abab", "ab%ab", true);
+  testLike("aba", "ab%ba", false);
+  testLike("xaaay", "%aa%aa%", false);
+  testLike("xaaaay", "%aa%aa%", true);
+  testLike("a%b_c", "%#%%#_%", '#', true);
+  testLike("a_b%c", "%#%%#_%", '#', false);
+  testLike("a#b", "a##%", '#', true);
+  testLike("a#", "%a##", '#', true);
+
+  auto longString = generateString(kLikePatternCharacterSet, 500);
+  testLike(longString, "%abc%XYZ%@#$%", true);
+  testLike(longString, "%abc%XYZ%@#%zyx%", false);
+}
+
 TEST_F(Re2FunctionsTest, likePatternAndEscape) {
   testLike("a_c", "%#_%", '#', true);
   testLike("_cd", "%#_%", '#', true);
@@ -100,6 +100,14 @@ class NthValueFunction : public exec::WindowFunction {
     partitionOffset_ += numRows;
   }
 
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kFrameRows;
+  }
+
+  std::optional<RowOffsets> streamingRowOffsets() const override {
+    return RowOffsets{};
+  }
+
  private:
   // The below functions build the rowNumbers for column extraction.
   // The rowNumbers map for each output row, as per nth_value function
@@ -45,7 +45,7 @@ class RankFunction : public exec::WindowFunction {
 
   void apply(
       const BufferPtr& peerGroupStarts,
-      const BufferPtr& /*peerGroupEnds*/,
+      const BufferPtr& peerGroupEnds,
       const BufferPtr& /*frameStarts*/,
       const BufferPtr& /*frameEnds*/,
       const SelectivityVector& validRows,
@@ -53,9 +53,12 @@ class RankFunction : public exec::WindowFunction {
       const VectorPtr& result) override {
     int numRows = peerGroupStarts->size() / sizeof(vector_size_t);
     auto* rawPeerStarts = peerGroupStarts->as<vector_size_t>();
+    auto* rawPeerEnds = peerGroupEnds->as<vector_size_t>();
     auto rawValues = result->asFlatVector<TResult>()->mutableRawValues();
 
-    for (int i = 0; i < numRows; i++) {
+    // All the rows of a peer group have the same rank. Fills the rows of the
+    // batch one peer group at a time.
+    for (int i = 0; i < numRows;) {
       auto start = rawPeerStarts[i];
       if (start != currentPeerGroupStart_) {
         currentPeerGroupStart_ = start;
@@ -69,14 +72,35 @@ class RankFunction : public exec::WindowFunction {
         previousPeerCount_ = 0;
       }
 
+      // Partition row number of row 'i'.
+      const auto row = currentPeerGroupStart_ + previousPeerCount_;
+      const auto numPeers = std::min<vector_size_t>(
+          numRows - i, rawPeerEnds[i] - row + 1);
       if constexpr (TRank == RankType::kPercentRank) {
-        rawValues[resultOffset + i] = (numPartitionRows_ == 1)
-            ? 0
-            : double(rank_ - 1) / (numPartitionRows_ - 1);
+        std::fill_n(
+            rawValues + resultOffset + i,
+            numPeers,
+            (numPartitionRows_ == 1)
+                ? 0
+                : double(rank_ - 1) / (numPartitionRows_ - 1));
       } else {
-        rawValues[resultOffset + i] = rank_;
+        std::fill_n(rawValues + resultOffset + i, numPeers, rank_);
       }
-      previousPeerCount_ += 1;
+      previousPeerCount_ += numPeers;
+      i += numPeers;
+    }
+  }
+
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kForward;
+  }
+
+  // percent_rank() depends on the number of rows in the partition.
+  std::optional<RowOffsets> streamingRowOffsets() const override {
+    if constexpr (TRank == RankType::kPercentRank) {
+      return std::nullopt;
+    } else {
+      return RowOffsets{};
     }
   }
 
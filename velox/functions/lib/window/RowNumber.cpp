@@ -59,6 +59,14 @@ class RowNumberFunction : public exec::WindowFunction {
     }
   }
 
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kForward;
+  }
+
+  std::optional<RowOffsets> streamingRowOffsets() const override {
+    return RowOffsets{};
+  }
+
  private:
   int64_t rowNumber_ = 1;
 };
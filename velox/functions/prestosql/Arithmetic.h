@@ -44,6 +44,8 @@ namespace {
 
 template <typename T>
 struct PlusFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -53,6 +55,8 @@ struct PlusFunction {
 
 template <typename T>
 struct MinusFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -62,6 +66,8 @@ struct MinusFunction {
 
 template <typename T>
 struct MultiplyFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
@@ -71,6 +77,8 @@ struct MultiplyFunction {
 
 template <typename T>
 struct DivideFunction {
+  static constexpr bool is_vectorizable = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b)
@@ -74,9 +74,20 @@ struct TimestampWithTimezoneSupport {
   Timestamp toTimestamp(
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     const auto milliseconds = *timestampWithTimezone.template at<0>();
+    const auto tzID = *timestampWithTimezone.template at<1>();
     Timestamp timestamp = Timestamp::fromMillis(milliseconds);
-    timestamp.toTimezone(*timestampWithTimezone.template at<1>());
+    if (tzID <= kMaxFixedOffsetTimezoneId) {
+      timestamp.toTimezone(tzID);
+      return timestamp;
+    }
 
+    // Looking up the zone by name is expensive. Rows usually have the same
+    // zone as the previous row.
+    if (!timezoneOffsets_.has_value() || tzID != timezoneId_) {
+      timezoneOffsets_.emplace(date::locate_zone(util::getTimeZoneName(tzID)));
+      timezoneId_ = tzID;
+    }
+    timezoneOffsets_->toTimezone(timestamp);
     return timestamp;
   }
 
@@ -95,6 +106,15 @@ struct TimestampWithTimezoneSupport {
     // Get offset in seconds with GMT and convert to hour
     return (inputTimeStamp.getSeconds() - gmtTimeStamp.getSeconds());
   }
+
+ private:
+  // Ids up to this one are fixed offsets, e.g. +01:00, that are converted
+  // without a zone lookup.
+  static constexpr int16_t kMaxFixedOffsetTimezoneId = 1680;
+
+  // The offsets of the zone of the last row with a named zone.
+  std::optional<TimezoneOffsetCache> timezoneOffsets_;
+  int16_t timezoneId_{0};
 };
 
 } // namespace
@@ -211,7 +231,7 @@ struct WeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getWeek(getDateTime(timestamp, this->timeZone_));
+    result = getWeek(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -238,7 +258,7 @@ struct YearFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getYear(getDateTime(timestamp, this->timeZone_));
+    result = getYear(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -265,7 +285,7 @@ struct QuarterFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getQuarter(getDateTime(timestamp, this->timeZone_));
+    result = getQuarter(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -292,7 +312,7 @@ struct MonthFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getMonth(getDateTime(timestamp, this->timeZone_));
+    result = getMonth(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -315,7 +335,7 @@ struct DayFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_mday;
+    result = this->toSessionDateTime(timestamp).tm_mday;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -338,7 +358,7 @@ struct LastDayOfMonthFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       out_type<Date>& result,
       const arg_type<Timestamp>& timestamp) {
-    auto dt = getDateTime(timestamp, this->timeZone_);
+    auto dt = this->toSessionDateTime(timestamp);
     result = util::lastDayOfMonthSinceEpochFromDate(dt);
   }
 
@@ -424,7 +444,7 @@ struct DayOfWeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfWeek(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -451,7 +471,7 @@ struct DayOfYearFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfYear(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfYear(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -495,7 +515,7 @@ struct YearOfWeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = computeYearOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = computeYearOfWeek(this->toSessionDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -518,7 +538,7 @@ struct HourFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_hour;
+    result = this->toSessionDateTime(timestamp).tm_hour;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -541,7 +561,7 @@ struct MinuteFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_min;
+    result = this->toSessionDateTime(timestamp).tm_min;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -1112,12 +1132,7 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
           std::string_view(formatString.data(), formatString.size()));
     }
 
-    auto formattedResult = mysqlDateTime_->format(timestamp, sessionTimeZone_);
-    auto resultSize = formattedResult.size();
-    result.resize(resultSize);
-    if (resultSize != 0) {
-      std::memcpy(result.data(), formattedResult.data(), resultSize);
-    }
+    mysqlDateTime_->format(timestamp, sessionTimeZone_, result);
     return true;
   }
 
@@ -1204,12 +1219,7 @@ struct FormatDateTimeFunction {
           std::string_view(formatString.data(), formatString.size()));
     }
 
-    auto formattedResult = jodaDateTime_->format(timestamp, sessionTimeZone_);
-    auto resultSize = formattedResult.size();
-    result.resize(resultSize);
-    if (resultSize != 0) {
-      std::memcpy(result.data(), formattedResult.data(), resultSize);
-    }
+    jodaDateTime_->format(timestamp, sessionTimeZone_, result);
     return true;
   }
 };
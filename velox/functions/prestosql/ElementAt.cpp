@@ -36,6 +36,13 @@ class ElementAtFunction : public SubscriptImpl<
                               /* indexStartsAtOne */ true> {
  public:
   explicit ElementAtFunction(bool allowcaching) : SubscriptImpl(allowcaching) {}
+
+  /// A missing key or index gives NULL, so a reader that reads only the
+  /// subscripted map keys or the array elements up to the index gives the
+  /// same result.
+  bool canPushdown() const override {
+    return true;
+  }
 };
 } // namespace
 
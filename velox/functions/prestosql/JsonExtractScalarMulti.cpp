@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/JsonExtractScalarMulti.h"
+
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/SpecialForm.h"
+#include "velox/functions/prestosql/json/SIMDJsonMultiPathExtractor.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+class JsonExtractScalarMultiExpr : public exec::SpecialForm {
+ public:
+  JsonExtractScalarMultiExpr(
+      TypePtr type,
+      std::vector<exec::ExprPtr>&& inputs,
+      const std::vector<std::string>& paths,
+      bool trackCpuUsage)
+      : SpecialForm(
+            std::move(type),
+            std::move(inputs),
+            JsonExtractScalarMultiCallToSpecialForm::kName,
+            false /* supportsFlatNoNullsFastPath */,
+            trackCpuUsage),
+        extractor_(paths) {}
+
+  void evalSpecialForm(
+      const SelectivityVector& rows,
+      exec::EvalCtx& context,
+      VectorPtr& result) override {
+    // The other inputs are the constant paths.
+    VectorPtr input;
+    inputs_[0]->eval(rows, context, input);
+    exec::LocalDecodedVector decoded(context, *input, rows);
+
+    auto localResult =
+        BaseVector::create<RowVector>(type(), rows.end(), context.pool());
+    std::vector<FlatVector<StringView>*> fields(extractor_.numPaths());
+    for (auto i = 0; i < fields.size(); ++i) {
+      fields[i] = localResult->childAt(i)->asFlatVector<StringView>();
+    }
+
+    rows.applyToSelected([&](auto row) {
+      if (decoded->isNullAt(row)) {
+        for (auto* field : fields) {
+          field->setNull(row, true);
+        }
+        return;
+      }
+      const auto json = decoded->valueAt<StringView>(row);
+      extractor_.extract(std::string_view(json.data(), json.size()), values_);
+      for (auto i = 0; i < fields.size(); ++i) {
+        if (values_[i].has_value()) {
+          const auto& value = *values_[i];
+          fields[i]->set(row, StringView(value.data(), value.size()));
+        } else {
+          fields[i]->setNull(row, true);
+        }
+      }
+    });
+
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  void computePropagatesNulls() override {
+    // A null input gives a row of null fields.
+    propagatesNulls_ = false;
+  }
+
+  SIMDJsonMultiPathExtractor extractor_;
+  std::vector<std::optional<std::string_view>> values_;
+};
+
+// Returns the path of a json_extract_scalar call that can be extracted
+// together with other paths from the same input.
+std::optional<std::string> sharedPath(
+    const std::string& functionName,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != functionName ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  if (!dynamic_cast<const core::FieldAccessTypedExpr*>(
+          call->inputs()[0].get())) {
+    return std::nullopt;
+  }
+  auto* constant =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (constant == nullptr || constant->hasValueVector() ||
+      constant->value().isNull()) {
+    return std::nullopt;
+  }
+  const auto& path = constant->value().value<TypeKind::VARCHAR>();
+  if (!SIMDJsonMultiPathExtractor::isSupported(path)) {
+    return std::nullopt;
+  }
+  return path;
+}
+
+struct PathGroup {
+  core::TypedExprPtr input;
+  std::vector<std::string> paths;
+  // The common call extracting 'paths'. Set if there are at least 2 paths.
+  core::TypedExprPtr extract;
+};
+
+PathGroup* findGroup(
+    std::vector<PathGroup>& groups,
+    const core::TypedExprPtr& input) {
+  for (auto& group : groups) {
+    if (*group.input == *input) {
+      return &group;
+    }
+  }
+  return nullptr;
+}
+
+void collectPaths(
+    const std::string& functionName,
+    const core::TypedExprPtr& expr,
+    std::vector<PathGroup>& groups) {
+  // Lambda bodies may refer to lambda arguments that have the names of
+  // columns.
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return;
+  }
+  if (auto path = sharedPath(functionName, expr)) {
+    const auto& input = expr->inputs()[0];
+    auto* group = findGroup(groups, input);
+    if (group == nullptr) {
+      group = &groups.emplace_back(PathGroup{input, {}, nullptr});
+    }
+    if (std::find(group->paths.begin(), group->paths.end(), *path) ==
+        group->paths.end()) {
+      group->paths.push_back(std::move(*path));
+    }
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectPaths(functionName, input, groups);
+  }
+}
+
+// Returns a copy of 'expr' with 'inputs' or nullptr if 'expr' is not a kind of
+// expression that can be copied.
+core::TypedExprPtr withInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>&& inputs) {
+  if (auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        call->type(), std::move(inputs), call->name());
+  }
+  if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        cast->type(), inputs, cast->nullOnFailure());
+  }
+  if (auto* field =
+          dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get())) {
+    return std::make_shared<core::FieldAccessTypedExpr>(
+        field->type(), inputs[0], field->name());
+  }
+  if (auto* dereference =
+          dynamic_cast<const core::DereferenceTypedExpr*>(expr.get())) {
+    return std::make_shared<core::DereferenceTypedExpr>(
+        dereference->type(), inputs[0], dereference->index());
+  }
+  if (dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
+    return std::make_shared<core::ConcatTypedExpr>(
+        expr->type()->asRow().names(), inputs);
+  }
+  return nullptr;
+}
+
+core::TypedExprPtr rewritePaths(
+    const std::string& functionName,
+    const core::TypedExprPtr& expr,
+    std::vector<PathGroup>& groups) {
+  if (dynamic_cast<const core::LambdaTypedExpr*>(expr.get())) {
+    return expr;
+  }
+  if (auto path = sharedPath(functionName, expr)) {
+    auto* group = findGroup(groups, expr->inputs()[0]);
+    if (group->extract == nullptr) {
+      return expr;
+    }
+    const auto index =
+        std::find(group->paths.begin(), group->paths.end(), *path) -
+        group->paths.begin();
+    return std::make_shared<core::DereferenceTypedExpr>(
+        expr->type(), group->extract, index);
+  }
+
+  std::vector<core::TypedExprPtr> inputs;
+  bool changed = false;
+  for (const auto& input : expr->inputs()) {
+    inputs.push_back(rewritePaths(functionName, input, groups));
+    changed |= inputs.back() != input;
+  }
+  if (!changed) {
+    return expr;
+  }
+  auto rewritten = withInputs(expr, std::move(inputs));
+  return rewritten != nullptr ? rewritten : expr;
+}
+
+} // namespace
+
+TypePtr JsonExtractScalarMultiCallToSpecialForm::resolveType(
+    const std::vector<TypePtr>& argTypes) {
+  VELOX_USER_CHECK_GE(
+      argTypes.size(), 2, "{} requires at least one path", kName);
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (auto i = 1; i < argTypes.size(); ++i) {
+    names.push_back(fmt::format("c{}", i - 1));
+    types.push_back(VARCHAR());
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+exec::ExprPtr JsonExtractScalarMultiCallToSpecialForm::constructSpecialForm(
+    const TypePtr& type,
+    std::vector<exec::ExprPtr>&& compiledChildren,
+    bool trackCpuUsage,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_GE(compiledChildren.size(), 2);
+  VELOX_CHECK_EQ(type->size(), compiledChildren.size() - 1);
+  std::vector<std::string> paths;
+  for (auto i = 1; i < compiledChildren.size(); ++i) {
+    auto* constant = compiledChildren[i]->as<exec::ConstantExpr>();
+    VELOX_USER_CHECK_NOT_NULL(constant, "{} requires constant paths", kName);
+    paths.push_back(constant->value()
+                        ->as<ConstantVector<StringView>>()
+                        ->valueAt(0)
+                        .str());
+  }
+  return std::make_shared<JsonExtractScalarMultiExpr>(
+      type, std::move(compiledChildren), paths, trackCpuUsage);
+}
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  const auto functionName = prefix + "json_extract_scalar";
+  std::vector<PathGroup> groups;
+  for (const auto& expr : exprs) {
+    collectPaths(functionName, expr, groups);
+  }
+
+  bool shared = false;
+  for (auto& group : groups) {
+    if (group.paths.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{group.input};
+    std::vector<std::string> names;
+    for (auto i = 0; i < group.paths.size(); ++i) {
+      inputs.push_back(
+          std::make_shared<core::ConstantTypedExpr>(VARCHAR(), group.paths[i]));
+      names.push_back(fmt::format("c{}", i));
+    }
+    group.extract = std::make_shared<core::CallTypedExpr>(
+        ROW(std::move(names),
+            std::vector<TypePtr>(group.paths.size(), VARCHAR())),
+        std::move(inputs),
+        JsonExtractScalarMultiCallToSpecialForm::kName);
+    shared = true;
+  }
+  if (!shared) {
+    return {};
+  }
+
+  std::vector<core::TypedExprPtr> rewritten;
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewritePaths(functionName, expr, groups));
+  }
+  return rewritten;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/FunctionCallToSpecialForm.h"
+
+namespace facebook::velox::functions {
+
+/// Special form that extracts the scalar values of several constant JSON paths
+/// from one input with SIMDJsonMultiPathExtractor, parsing each row once.
+/// Returns a ROW of VARCHAR with one field per path. Only created by
+/// rewriteJsonExtractScalarCalls.
+class JsonExtractScalarMultiCallToSpecialForm
+    : public exec::FunctionCallToSpecialForm {
+ public:
+  static constexpr const char* kName = "$internal$json_extract_scalar_multi";
+
+  TypePtr resolveType(const std::vector<TypePtr>& argTypes) override;
+
+  exec::ExprPtr constructSpecialForm(
+      const TypePtr& type,
+      std::vector<exec::ExprPtr>&& compiledChildren,
+      bool trackCpuUsage,
+      const core::QueryConfig& config) override;
+};
+
+/// Finds json_extract_scalar(x, '<path>') calls in 'exprs' that extract
+/// constant paths from the same column or struct field x. If there are at
+/// least two distinct paths for some x, replaces these calls with references
+/// to the fields of one $internal$json_extract_scalar_multi(x, '<path1>',
+/// '<path2>', ...) call. The common call is then evaluated once per batch.
+/// For example,
+///     json_extract_scalar(p, '$.a'), json_extract_scalar(p, '$.b.c')
+/// becomes
+///     multi.c0, multi.c1 with multi = $internal$json_extract_scalar_multi(p,
+///     '$.a', '$.b.c')
+///
+/// Lambda bodies and paths with wildcards are not rewritten. Returns an empty
+/// vector if no rewrite is possible.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+} // namespace facebook::velox::functions
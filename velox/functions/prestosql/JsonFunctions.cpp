@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
@@ -64,6 +65,17 @@ class JsonFormatFunction : public exec::VectorFunction {
 
 class JsonParseFunction : public exec::VectorFunction {
  public:
+  // Validates the syntax of 'json' with the thread local simdjson parser,
+  // which reuses its buffers across rows.
+  static void validate(const StringView& json) {
+    auto error =
+        simdjsonParseDom(std::string_view(json.data(), json.size())).error();
+    if (error != simdjson::SUCCESS) {
+      VELOX_USER_FAIL(
+          "Invalid JSON: {}: {}", simdjson::error_message(error), json);
+    }
+  }
+
   void apply(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -73,14 +85,12 @@ class JsonParseFunction : public exec::VectorFunction {
     VectorPtr localResult;
 
     // Input can be constant or flat.
-    // TODO(arpitporwal2293) Replace folly::parseJson with a lightweight
-    // validation of JSON syntax that doesn't allocate memory or copy data.
     assert(args.size() > 0);
     const auto& arg = args[0];
     if (arg->isConstantEncoding()) {
       auto value = arg->as<ConstantVector<StringView>>()->valueAt(0);
       try {
-        folly::parseJson(value);
+        validate(value);
       } catch (const std::exception& e) {
         context.setErrors(rows, std::current_exception());
         return;
@@ -94,7 +104,7 @@ class JsonParseFunction : public exec::VectorFunction {
       VELOX_CHECK_LE(rows.end(), flatInput->size());
 
       context.applyToSelectedNoThrow(
-          rows, [&](auto row) { folly::parseJson(flatInput->valueAt(row)); });
+          rows, [&](auto row) { validate(flatInput->valueAt(row)); });
       localResult = std::make_shared<FlatVector<StringView>>(
           context.pool(),
           JSON(),
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 
@@ -52,6 +54,69 @@ bool toNthElementRows(
   return arrayRows.hasSelections();
 }
 
+/// Returns true if 'callable' is (s, x) -> s + x over DOUBLE state and
+/// elements, where + is registered as a fused plus, i.e. has IEEE semantics
+/// and no errors.
+bool isDoubleSum(const Callable& callable) {
+  const auto& signature = callable.signature();
+  if (callable.hasCapture() || signature->size() != 2 ||
+      signature->childAt(0)->kind() != TypeKind::DOUBLE ||
+      signature->childAt(1)->kind() != TypeKind::DOUBLE) {
+    return false;
+  }
+  const auto* body = &callable.body();
+  if (body->is<exec::FusedArithmeticExpr>()) {
+    body = body->inputs()[0].get();
+  }
+  if (body->isSpecialForm() || body->inputs().size() != 2 ||
+      exec::getFusedFunction(body->name()) != exec::FusedOp::kPlus) {
+    return false;
+  }
+  auto isParameter = [&](const exec::ExprPtr& input, int32_t index) {
+    auto* field = input->as<exec::FieldReference>();
+    return field != nullptr && field->inputs().empty() &&
+        field->field() == signature->nameOf(index);
+  };
+  return isParameter(body->inputs()[0], 0) && isParameter(body->inputs()[1], 1);
+}
+
+/// Computes the state of reduce(array, initialState, (s, x) -> s + x, ...)
+/// for 'rows' of 'flatArray' into 'partialResult' in a loop over the elements
+/// of each array. Adds in the same order as the lambda would, so results are
+/// bit for bit the same.
+void sumArrays(
+    const ArrayVectorPtr& flatArray,
+    const VectorPtr& initialState,
+    const SelectivityVector& rows,
+    exec::EvalCtx& context,
+    VectorPtr& partialResult) {
+  exec::LocalDecodedVector initialDecoder(context, *initialState, rows);
+  auto& decodedInitial = *initialDecoder.get();
+  exec::LocalDecodedVector elementsDecoder(context);
+  elementsDecoder.get()->decode(*flatArray->elements());
+  auto& decodedElements = *elementsDecoder.get();
+
+  auto* rawSizes = flatArray->rawSizes();
+  auto* rawOffsets = flatArray->rawOffsets();
+  auto* flatResult = partialResult->asFlatVector<double>();
+  rows.applyToSelected([&](auto row) {
+    if (decodedInitial.isNullAt(row)) {
+      flatResult->setNull(row, true);
+      return;
+    }
+    double sum = decodedInitial.valueAt<double>(row);
+    const auto end = rawOffsets[row] + rawSizes[row];
+    for (auto i = rawOffsets[row]; i < end; ++i) {
+      if (decodedElements.isNullAt(i)) {
+        flatResult->setNull(row, true);
+        return;
+      }
+      sum += decodedElements.valueAt<double>(i);
+    }
+    flatResult->set(row, sum);
+  });
+}
+
 /// See documentation at
 /// https://prestodb.io/docs/current/functions/array.html#reduce
 class ReduceFunction : public exec::VectorFunction {
@@ -116,6 +181,11 @@ class ReduceFunction : public exec::VectorFunction {
     // At each step the number of arrays being processed will get smaller as
     // some arrays will run out of elements.
     while (auto entry = inputFuncIt.next()) {
+      if (isDoubleSum(*entry.callable)) {
+        sumArrays(flatArray, initialState, *entry.rows, context, partialResult);
+        continue;
+      }
+
       VectorPtr state = initialState;
 
       vector_size_t n = 0;
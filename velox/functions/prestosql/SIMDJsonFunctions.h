@@ -20,45 +20,30 @@
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
 #include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
 
-struct ParserContext {
- public:
-  explicit ParserContext() noexcept;
-  explicit ParserContext(const char* data, size_t length) noexcept
-      : padded_json(data, length) {}
-  void parseElement() {
-    jsonEle = domParser.parse(padded_json);
-  }
-  void parseDocument() {
-    jsonDoc = ondemandParser.iterate(padded_json);
-  }
-  simdjson::dom::element jsonEle;
-  simdjson::ondemand::document jsonDoc;
-
- private:
-  simdjson::padded_string padded_json;
-  simdjson::dom::parser domParser;
-  simdjson::ondemand::parser ondemandParser;
-};
+// Parses 'json' with the thread local On-Demand parser. Throws
+// simdjson_error if 'json' is not valid.
+inline simdjson::ondemand::document parseJsonDocument(const StringView& json) {
+  return simdjsonParseOndemand(std::string_view(json.data(), json.size()));
+}
 
 template <typename T>
 struct SIMDIsJsonScalarFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   FOLLY_ALWAYS_INLINE void call(bool& result, const arg_type<Json>& json) {
-    ParserContext ctx(json.data(), json.size());
-
-    ctx.parseDocument();
-
+    auto jsonDoc = parseJsonDocument(json);
+    const auto type = jsonDoc.type().value();
     result =
-        (ctx.jsonDoc.type() == simdjson::ondemand::json_type::number ||
-         ctx.jsonDoc.type() == simdjson::ondemand::json_type::string ||
-         ctx.jsonDoc.type() == simdjson::ondemand::json_type::boolean ||
-         ctx.jsonDoc.type() == simdjson::ondemand::json_type::null);
+        (type == simdjson::ondemand::json_type::number ||
+         type == simdjson::ondemand::json_type::string ||
+         type == simdjson::ondemand::json_type::boolean ||
+         type == simdjson::ondemand::json_type::null);
   }
 };
 
@@ -68,20 +53,20 @@ struct SIMDJsonArrayContainsFunction {
   template <typename TInput>
   FOLLY_ALWAYS_INLINE bool
   call(bool& result, const arg_type<Json>& json, const TInput& value) {
-    ParserContext ctx(json.data(), json.size());
     result = false;
 
+    simdjson::ondemand::document jsonDoc;
     try {
-      ctx.parseDocument();
+      jsonDoc = parseJsonDocument(json);
     } catch (const simdjson::simdjson_error&) {
       return false;
     }
 
-    if (ctx.jsonDoc.type() != simdjson::ondemand::json_type::array) {
+    if (jsonDoc.type() != simdjson::ondemand::json_type::array) {
       return false;
     }
 
-    for (auto&& v : ctx.jsonDoc) {
+    for (auto&& v : jsonDoc) {
       try {
         if constexpr (std::is_same_v<TInput, bool>) {
           if (v.type() == simdjson::ondemand::json_type::boolean &&
@@ -141,20 +126,19 @@ struct SIMDJsonArrayLengthFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   FOLLY_ALWAYS_INLINE bool call(int64_t& len, const arg_type<Json>& json) {
-    ParserContext ctx(json.data(), json.size());
-
+    simdjson::ondemand::document jsonDoc;
     try {
-      ctx.parseDocument();
+      jsonDoc = parseJsonDocument(json);
     } catch (const simdjson::simdjson_error&) {
       return false;
     }
 
-    if (ctx.jsonDoc.type() != simdjson::ondemand::json_type::array) {
+    if (jsonDoc.type() != simdjson::ondemand::json_type::array) {
       return false;
     }
 
     try {
-      len = ctx.jsonDoc.count_elements();
+      len = jsonDoc.count_elements();
     } catch (const simdjson::simdjson_error&) {
       return false;
     }
@@ -17,6 +17,7 @@
 
 #include <boost/regex.hpp>
 #include <cctype>
+#include <cstring>
 #include "velox/functions/Macros.h"
 
 namespace facebook::velox::functions {
@@ -242,6 +243,9 @@ template <typename T>
 struct UrlExtractPathFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
+  // Results without escapes refer to strings in the first argument.
+  static constexpr int32_t reuse_strings_from_arg = 0;
+
   // Input is always ASCII, but result may or may not be ASCII.
 
   FOLLY_ALWAYS_INLINE void call(
@@ -265,7 +269,12 @@ struct UrlExtractPathFunction {
       } else {
         escapedPath = submatch(match, 2);
       }
-      urlUnescape(result, escapedPath);
+      if (std::memchr(escapedPath.data(), '%', escapedPath.size()) ||
+          std::memchr(escapedPath.data(), '+', escapedPath.size())) {
+        urlUnescape(result, escapedPath);
+      } else {
+        result.setNoCopy(escapedPath);
+      }
     }
   }
 };
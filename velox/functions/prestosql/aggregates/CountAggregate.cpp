@@ -78,6 +78,42 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     }
   }
 
+  void addRawInputForDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool /*mayPushdown*/) override {
+    auto& counts = BaseAggregate::denseAccumulators_;
+    counts.reset(numGroupIds);
+    auto addOne = [&](vector_size_t i) {
+      counts.add(groups[i], groupIds[i], 1, [](int64_t& count, int64_t n) {
+        count += n;
+      });
+    };
+    if (args.empty()) {
+      rows.applyToSelected(addOne);
+    } else {
+      DecodedVector decoded(*args[0], rows);
+      if (decoded.isConstantMapping()) {
+        if (!decoded.isNullAt(0)) {
+          rows.applyToSelected(addOne);
+        }
+      } else if (decoded.mayHaveNulls()) {
+        rows.applyToSelected([&](vector_size_t i) {
+          if (!decoded.isNullAt(i)) {
+            addOne(i);
+          }
+        });
+      } else {
+        rows.applyToSelected(addOne);
+      }
+    }
+    counts.forEach(
+        [&](char* group, int64_t count) { addToGroup(group, count); });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -156,6 +156,30 @@ class MaxAggregate : public MinMaxAggregate<T> {
         mayPushdown);
   }
 
+  void addRawInputForDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    if (mayPushdown && args[0]->isLazy()) {
+      addRawInput(groups, rows, args, mayPushdown);
+      return;
+    }
+    BaseAggregate::template updateDenseGroups<true>(
+        groups,
+        groupIds,
+        numGroupIds,
+        rows,
+        args[0],
+        [](T& result, T value) {
+          if (result < value) {
+            result = value;
+          }
+        });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -241,6 +265,30 @@ class MinAggregate : public MinMaxAggregate<T> {
         mayPushdown);
   }
 
+  void addRawInputForDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      bool mayPushdown) override {
+    if (mayPushdown && args[0]->isLazy()) {
+      addRawInput(groups, rows, args, mayPushdown);
+      return;
+    }
+    BaseAggregate::template updateDenseGroups<true>(
+        groups,
+        groupIds,
+        numGroupIds,
+        rows,
+        args[0],
+        [](T& result, T value) {
+          if (result > value) {
+            result = value;
+          }
+        });
+  }
+
   void addIntermediateResults(
       char** groups,
       const SelectivityVector& rows,
@@ -383,6 +383,15 @@ TEST_F(SumTest, emptyValues) {
   testAggregations({vector}, {"c0"}, {"sum(c1)"}, "");
 }
 
+TEST_F(SumTest, sequenceInput) {
+  // Runs of repeated values and nulls are added once per run.
+  auto data = makeRowVector({vectorMaker_.sequenceVector<int64_t>(
+      {1, 1, 1, std::nullopt, std::nullopt, 5, 5, 7, 7, 7, 7})});
+  auto plan =
+      PlanBuilder().values({data}).singleAggregation({}, {"sum(c0)"}).planNode();
+  assertQuery(plan, "SELECT 41");
+}
+
 /// Test aggregating over lots of null values.
 TEST_F(SumTest, nulls) {
   vector_size_t size = 10'000;
@@ -42,12 +42,6 @@ namespace facebook::velox::functions::detail {
   return *it.first->second;
 }
 
-simdjson::simdjson_result<simdjson::ondemand::document>
-SIMDJsonExtractor::parse(const simdjson::padded_string& json) {
-  thread_local static simdjson::ondemand::parser parser;
-  return parser.iterate(json);
-}
-
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
@@ -23,6 +23,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Macros.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
 #include "velox/type/StringView.h"
 
@@ -61,9 +62,6 @@ class SIMDJsonExtractor {
     return tokens_.empty();
   }
 
-  simdjson::simdjson_result<simdjson::ondemand::document> parse(
-      const simdjson::padded_string& json);
-
  private:
   // Use this method to get an instance of SIMDJsonExtractor given a JSON path.
   // Given the nature of the cache, it's important this is only used by
@@ -181,8 +179,9 @@ bool simdJsonExtract(
   // If extractor fails to parse the path, this will throw a VeloxUserError, and
   // we want to let this exception bubble up to the client.
   auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
-  simdjson::padded_string paddedJson(json.data(), json.size());
-  SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, extractor.parse(paddedJson));
+  SIMDJSON_ASSIGN_OR_RAISE(
+      auto jsonDoc,
+      simdjsonParseOndemand(std::string_view(json.data(), json.size())));
 
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/json/SIMDJsonMultiPathExtractor.h"
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+
+#include "velox/functions/prestosql/json/JsonPathTokenizer.h"
+#include "velox/functions/prestosql/json/SIMDJsonExtractor.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+std::optional<std::vector<std::string>> tokenize(const std::string& path) {
+  JsonPathTokenizer tokenizer;
+  if (!tokenizer.reset(folly::trimWhitespace(path))) {
+    return std::nullopt;
+  }
+  std::vector<std::string> tokens;
+  while (tokenizer.hasNext()) {
+    auto token = tokenizer.getNext();
+    if (!token) {
+      return std::nullopt;
+    }
+    tokens.push_back(std::move(token.value()));
+  }
+  return tokens;
+}
+
+} // namespace
+
+// static
+bool SIMDJsonMultiPathExtractor::isSupported(const std::string& path) {
+  auto tokens = tokenize(path);
+  if (!tokens.has_value() || tokens->empty()) {
+    return false;
+  }
+  return std::find(tokens->begin(), tokens->end(), "*") == tokens->end();
+}
+
+SIMDJsonMultiPathExtractor::SIMDJsonMultiPathExtractor(
+    const std::vector<std::string>& paths)
+    : numPaths_(paths.size()) {
+  nodes_.emplace_back();
+  for (auto i = 0; i < paths.size(); ++i) {
+    VELOX_USER_CHECK(
+        isSupported(paths[i]),
+        "Unsupported JSON path for multi-path extraction: {}",
+        paths[i]);
+    int32_t node = 0;
+    for (const auto& token : tokenize(paths[i]).value()) {
+      auto it = nodes_[node].keyChildren.find(token);
+      if (it != nodes_[node].keyChildren.end()) {
+        node = it->second;
+        continue;
+      }
+      const int32_t child = nodes_.size();
+      nodes_.emplace_back();
+      nodes_[node].keyChildren.emplace(token, child);
+      // Like json_extract_scalar, a token that is a number also subscripts
+      // arrays.
+      auto index = folly::tryTo<int32_t>(token);
+      if (index.hasValue() && index.value() >= 0) {
+        auto& indexChildren = nodes_[node].indexChildren;
+        indexChildren.emplace_back(index.value(), child);
+        std::sort(indexChildren.begin(), indexChildren.end());
+      }
+      node = child;
+    }
+    nodes_[node].paths.push_back(i);
+  }
+}
+
+bool SIMDJsonMultiPathExtractor::extract(
+    std::string_view json,
+    std::vector<std::optional<std::string_view>>& results) {
+  results.assign(numPaths_, std::nullopt);
+  ++epoch_;
+  auto extractAll = [&]() {
+    SIMDJSON_ASSIGN_OR_RAISE(auto document, simdjsonParseOndemand(json));
+    SIMDJSON_ASSIGN_OR_RAISE(auto value, document.get_value());
+    return extract(0, value, results);
+  };
+  if (!extractAll()) {
+    results.assign(numPaths_, std::nullopt);
+    return false;
+  }
+  return true;
+}
+
+bool SIMDJsonMultiPathExtractor::extract(
+    int32_t nodeIndex,
+    simdjson::ondemand::value value,
+    std::vector<std::optional<std::string_view>>& results) {
+  auto& node = nodes_[nodeIndex];
+  SIMDJSON_ASSIGN_OR_RAISE(auto type, value.type());
+  switch (type) {
+    case simdjson::ondemand::json_type::object: {
+      auto numUnmatched = node.keyChildren.size();
+      if (numUnmatched == 0) {
+        return true;
+      }
+      SIMDJSON_ASSIGN_OR_RAISE(auto object, value.get_object());
+      for (auto field : object) {
+        SIMDJSON_ASSIGN_OR_RAISE(auto key, field.unescaped_key());
+        auto it = node.keyChildren.find(folly::StringPiece(key));
+        if (it == node.keyChildren.end() ||
+            nodes_[it->second].matchedEpoch == epoch_) {
+          continue;
+        }
+        nodes_[it->second].matchedEpoch = epoch_;
+        if (!extract(it->second, field.value(), results)) {
+          return false;
+        }
+        if (--numUnmatched == 0) {
+          break;
+        }
+      }
+      return true;
+    }
+    case simdjson::ondemand::json_type::array: {
+      if (node.indexChildren.empty()) {
+        return true;
+      }
+      SIMDJSON_ASSIGN_OR_RAISE(auto array, value.get_array());
+      int32_t index = 0;
+      auto next = node.indexChildren.begin();
+      for (auto element : array) {
+        if (index++ != next->first) {
+          continue;
+        }
+        SIMDJSON_ASSIGN_OR_RAISE(auto child, element.value());
+        if (!extract(next->second, child, results)) {
+          return false;
+        }
+        if (++next == node.indexChildren.end()) {
+          break;
+        }
+      }
+      return true;
+    }
+    case simdjson::ondemand::json_type::null:
+      return true;
+    default:
+      break;
+  }
+
+  if (node.paths.empty()) {
+    return true;
+  }
+  std::string_view scalar;
+  if (type == simdjson::ondemand::json_type::boolean) {
+    SIMDJSON_ASSIGN_OR_RAISE(bool boolValue, value.get_bool());
+    scalar = boolValue ? "true" : "false";
+  } else if (type == simdjson::ondemand::json_type::string) {
+    SIMDJSON_ASSIGN_OR_RAISE(scalar, value.get_string());
+  } else {
+    SIMDJSON_ASSIGN_OR_RAISE(scalar, simdjson::to_json_string(value));
+  }
+  for (auto path : node.paths) {
+    results[path] = scalar;
+  }
+  return true;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+namespace facebook::velox::functions {
+
+/// Extracts the scalar values of several JSON paths from a document with one
+/// parse and one traversal. The tokens of the paths are compiled into a trie
+/// so that a prefix shared by several paths is walked once. The extracted
+/// values are the same as json_extract_scalar returns for each path.
+class SIMDJsonMultiPathExtractor {
+ public:
+  /// Throws a user error if a path is not supported.
+  explicit SIMDJsonMultiPathExtractor(const std::vector<std::string>& paths);
+
+  /// Returns true if 'path' is a valid JSON path that is not the root "$" and
+  /// has no wildcards.
+  static bool isSupported(const std::string& path);
+
+  size_t numPaths() const {
+    return numPaths_;
+  }
+
+  /// Sets 'results[i]' to the scalar value at the i-th path of 'json' or to
+  /// std::nullopt if there is none. The values point into 'json' or the
+  /// thread local parser and are valid until the next parse on this thread.
+  /// Returns false and sets all results to std::nullopt if 'json' is
+  /// malformed.
+  bool extract(
+      std::string_view json,
+      std::vector<std::optional<std::string_view>>& results);
+
+ private:
+  struct Node {
+    // Indices of the paths that end at this node.
+    std::vector<int32_t> paths;
+    // Children by object key.
+    folly::F14FastMap<std::string, int32_t> keyChildren;
+    // Children by array index, sorted by index.
+    std::vector<std::pair<int32_t, int32_t>> indexChildren;
+    // The value of 'epoch_' when this node was last matched. A key that
+    // appears several times in an object only matches the first time.
+    uint64_t matchedEpoch{0};
+  };
+
+  bool extract(
+      int32_t node,
+      simdjson::ondemand::value value,
+      std::vector<std::optional<std::string_view>>& results);
+
+  const size_t numPaths_;
+  // The root is nodes_[0].
+  std::vector<Node> nodes_;
+  uint64_t epoch_{0};
+};
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
+
+#include <folly/CPortability.h>
+
+#include <string>
+
+namespace facebook::velox::functions {
+
+namespace {
+// The smallest page size on supported platforms. A read inside the page of
+// a readable byte does not fault.
+constexpr uintptr_t kPageSize = 4096;
+
+bool paddingOnSamePage(std::string_view json) {
+#ifdef FOLLY_SANITIZE_ADDRESS
+  // Reads past the end of an allocation are reported by ASan.
+  return false;
+#else
+  if (json.empty()) {
+    return false;
+  }
+  const auto last = reinterpret_cast<uintptr_t>(json.data() + json.size() - 1);
+  return last / kPageSize == (last + SIMDJSON_PADDING) / kPageSize;
+#endif
+}
+} // namespace
+
+simdjson::padded_string_view simdjsonPadded(std::string_view json) {
+  if (paddingOnSamePage(json)) {
+    return simdjson::padded_string_view(
+        json.data(), json.size(), json.size() + SIMDJSON_PADDING);
+  }
+  thread_local std::string buffer;
+  if (buffer.size() < json.size() + SIMDJSON_PADDING) {
+    buffer.resize(json.size() + SIMDJSON_PADDING);
+  }
+  if (!json.empty()) {
+    memcpy(buffer.data(), json.data(), json.size());
+  }
+  return simdjson::padded_string_view(
+      buffer.data(), json.size(), buffer.size());
+}
+
+simdjson::ondemand::parser& simdjsonOndemandParser() {
+  thread_local simdjson::ondemand::parser parser;
+  return parser;
+}
+
+simdjson::dom::parser& simdjsonDomParser() {
+  thread_local simdjson::dom::parser parser;
+  return parser;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string_view>
+
+#include "velox/functions/prestosql/json/SIMDJsonWrapper.h"
+
+namespace facebook::velox::functions {
+
+/// Returns 'json' as input simdjson can parse, i.e. followed by
+/// SIMDJSON_PADDING readable bytes. The contents of the padding do not
+/// matter. Points to 'json' itself if the padding is on the same memory page
+/// as the last byte of 'json'. Otherwise points to a copy in a thread local
+/// buffer that is reused across calls, so the result is valid until the next
+/// call on the same thread.
+simdjson::padded_string_view simdjsonPadded(std::string_view json);
+
+/// Thread local parsers. A parser keeps its buffers between documents, so
+/// reusing it avoids allocating per parsed value.
+simdjson::ondemand::parser& simdjsonOndemandParser();
+simdjson::dom::parser& simdjsonDomParser();
+
+/// Parses 'json' with the thread local On-Demand parser. The document is valid
+/// until the next parse on the same thread.
+inline simdjson::simdjson_result<simdjson::ondemand::document>
+simdjsonParseOndemand(std::string_view json) {
+  return simdjsonOndemandParser().iterate(simdjsonPadded(json));
+}
+
+/// Parses and fully validates 'json' with the thread local DOM parser. The
+/// element is valid until the next DOM parse on the same thread.
+inline simdjson::simdjson_result<simdjson::dom::element> simdjsonParseDom(
+    std::string_view json) {
+  auto padded = simdjsonPadded(json);
+  return simdjsonDomParser().parse(padded.data(), padded.length(), false);
+}
+
+} // namespace facebook::velox::functions
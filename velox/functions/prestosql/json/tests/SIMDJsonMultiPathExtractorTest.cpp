@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/json/SIMDJsonMultiPathExtractor.h"
+
+#include "gtest/gtest.h"
+#include "velox/common/base/VeloxException.h"
+
+namespace {
+using facebook::velox::VeloxUserError;
+using facebook::velox::functions::SIMDJsonMultiPathExtractor;
+
+std::vector<std::optional<std::string>> extract(
+    SIMDJsonMultiPathExtractor& extractor,
+    const std::string& json) {
+  std::vector<std::optional<std::string_view>> results;
+  extractor.extract(json, results);
+  std::vector<std::optional<std::string>> copies;
+  for (const auto& result : results) {
+    copies.push_back(
+        result.has_value() ? std::optional<std::string>(*result)
+                           : std::nullopt);
+  }
+  return copies;
+}
+
+TEST(SIMDJsonMultiPathExtractorTest, extract) {
+  SIMDJsonMultiPathExtractor extractor(
+      {"$.a", "$.b.c", "$.b.d[1]", "$.b", "$.e", "$[\"f g\"]", "$.a"});
+  using Results = std::vector<std::optional<std::string>>;
+
+  EXPECT_EQ(
+      extract(
+          extractor,
+          R"({"a": 1, "b": {"d": [true, "x"], "c": 2.5}, "f g": null})"),
+      Results({"1", "2.5", "x", std::nullopt, std::nullopt, std::nullopt,
+               "1"}));
+
+  // Of duplicate keys, the first is used. Values of the wrong kind give null.
+  EXPECT_EQ(
+      extract(extractor, R"({"a": "s", "a": "t", "b": [1], "f g": false})"),
+      Results({"s", std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+               "false", "s"}));
+
+  EXPECT_EQ(extract(extractor, "[1, 2]"), Results(7, std::nullopt));
+  EXPECT_EQ(extract(extractor, "5"), Results(7, std::nullopt));
+
+  std::vector<std::optional<std::string_view>> results;
+  EXPECT_FALSE(extractor.extract(R"({"a": 1, "b": )", results));
+  EXPECT_EQ(results.size(), 7);
+}
+
+TEST(SIMDJsonMultiPathExtractorTest, arrayIndices) {
+  SIMDJsonMultiPathExtractor extractor({"$[2]", "$[0].k", "$.0"});
+  using Results = std::vector<std::optional<std::string>>;
+  EXPECT_EQ(
+      extract(extractor, R"([{"k": "v"}, 1, 2, 3])"),
+      Results({"2", "v", std::nullopt}));
+  EXPECT_EQ(
+      extract(extractor, R"({"0": 10, "2": 12})"),
+      Results({"12", std::nullopt, "10"}));
+}
+
+TEST(SIMDJsonMultiPathExtractorTest, unsupported) {
+  EXPECT_TRUE(SIMDJsonMultiPathExtractor::isSupported("$.a.b[0]"));
+  EXPECT_FALSE(SIMDJsonMultiPathExtractor::isSupported("$"));
+  EXPECT_FALSE(SIMDJsonMultiPathExtractor::isSupported("$.a[*]"));
+  EXPECT_FALSE(SIMDJsonMultiPathExtractor::isSupported("$.a["));
+  EXPECT_THROW(SIMDJsonMultiPathExtractor({"$.a", "$.*"}), VeloxUserError);
+}
+
+} // namespace
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Arithmetic.h"
@@ -28,6 +29,10 @@ void registerSimpleFunctions(const std::string& prefix) {
   registerBinaryFloatingPoint<MinusFunction>({prefix + "minus"});
   registerBinaryFloatingPoint<MultiplyFunction>({prefix + "multiply"});
   registerBinaryFloatingPoint<DivideFunction>({prefix + "divide"});
+  exec::registerFusedFunction(prefix + "plus", exec::FusedOp::kPlus);
+  exec::registerFusedFunction(prefix + "minus", exec::FusedOp::kMinus);
+  exec::registerFusedFunction(prefix + "multiply", exec::FusedOp::kMultiply);
+  exec::registerFusedFunction(prefix + "divide", exec::FusedOp::kDivide);
   registerBinaryFloatingPoint<ModulusFunction>({prefix + "mod"});
   registerUnaryNumeric<CeilFunction>({prefix + "ceil", prefix + "ceiling"});
   registerUnaryNumeric<FloorFunction>({prefix + "floor"});
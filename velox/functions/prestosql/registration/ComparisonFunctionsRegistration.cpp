@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/FusedArithmeticExpr.h"
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
 #include "velox/functions/prestosql/Comparisons.h"
@@ -46,6 +47,13 @@ void registerComparisonFunctions(const std::string& prefix) {
   registerNonSimdizableScalar<GteFunction, bool>({prefix + "gte"});
   VELOX_REGISTER_VECTOR_FUNCTION(udf_simd_comparison_gte, prefix + "gte");
 
+  exec::registerFusedFunction(prefix + "eq", exec::FusedOp::kEq);
+  exec::registerFusedFunction(prefix + "neq", exec::FusedOp::kNeq);
+  exec::registerFusedFunction(prefix + "lt", exec::FusedOp::kLt);
+  exec::registerFusedFunction(prefix + "gt", exec::FusedOp::kGt);
+  exec::registerFusedFunction(prefix + "lte", exec::FusedOp::kLte);
+  exec::registerFusedFunction(prefix + "gte", exec::FusedOp::kGte);
+
   registerBinaryScalar<DistinctFromFunction, bool>({prefix + "distinct_from"});
 
   registerFunction<BetweenFunction, bool, int8_t, int8_t, int8_t>(
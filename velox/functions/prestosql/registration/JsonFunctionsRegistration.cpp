@@ -14,7 +14,10 @@
  * limitations under the License.
  */
 
+#include "velox/expression/SpecialFormRegistry.h"
+#include "velox/expression/VectorFunction.h"
 #include "velox/functions/Registerer.h"
+#include "velox/functions/prestosql/JsonExtractScalarMulti.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/SIMDJsonFunctions.h"
 
@@ -32,6 +35,14 @@ void registerJsonFunctions(const std::string& prefix) {
   registerFunction<SIMDJsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
 
+  // Extracts constant paths from the same input with one parse per row.
+  exec::registerFunctionCallToSpecialForm(
+      JsonExtractScalarMultiCallToSpecialForm::kName,
+      std::make_unique<JsonExtractScalarMultiCallToSpecialForm>());
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalarCalls(prefix, exprs);
+  });
+
   registerFunction<SIMDJsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
   registerFunction<SIMDJsonExtractFunction, Json, Varchar, Varchar>(
@@ -1086,3 +1086,48 @@ TEST_F(ElementAtTest, testCachingOptimzation) {
     test::assertEqualVectors(result, result1);
   }
 }
+
+TEST_F(ElementAtTest, repeatedLargeMaps) {
+  // Maps with 200 keys each. Map i has keys i, i + 1, ..., i + 199 with values
+  // key * 10.
+  const vector_size_t numMaps = 10;
+  const vector_size_t mapSize = 200;
+  auto keyAt = [&](auto idx) { return idx / mapSize + idx % mapSize; };
+  auto maps = makeMapVector<int64_t, int64_t>(
+      numMaps,
+      [&](auto /*row*/) { return mapSize; },
+      keyAt,
+      [&](auto idx) { return keyAt(idx) * 10; });
+
+  // Each map is referenced by many rows. The maps are indexed within the
+  // batch.
+  const vector_size_t size = 1'000;
+  auto indices = makeIndices(size, [&](auto row) { return row % numMaps; });
+  auto data = makeRowVector({
+      wrapInDictionary(indices, size, maps),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 250; }),
+  });
+
+  auto expected = makeFlatVector<int64_t>(
+      size,
+      [](auto row) { return row % 250 * 10; },
+      [&](auto row) {
+        const auto mapIndex = row % numMaps;
+        const auto key = row % 250;
+        return key < mapIndex || key >= mapIndex + mapSize;
+      });
+  test::assertEqualVectors(expected, evaluate("element_at(c0, c1)", data));
+  test::assertEqualVectors(expected, evaluate("c0[c1]", data));
+
+  // Constant keys over flat maps share the position of the key across maps.
+  data = makeRowVector({maps});
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(numMaps, [](auto /*row*/) { return 1500; }),
+      evaluate("element_at(c0, 150)", data));
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(
+          numMaps,
+          [](auto /*row*/) { return 50; },
+          [](auto row) { return row > 5; }),
+      evaluate("element_at(c0, 5)", data));
+}
@@ -799,16 +799,11 @@ TEST_F(JsonCastTest, toInteger) {
       TINYINT(),
       {"-1223456"_sv},
       "Cannot cast from Json value -1223456 to TINYINT: Negative overflow during arithmetic conversion: (signed char) -1223456");
+  // Infinity and NaN are not valid JSON.
   testThrow<JsonNativeType, int8_t>(
-      JSON(),
-      TINYINT(),
-      {"Infinity"_sv},
-      "Cannot cast from Json value Infinity to TINYINT: value is out of range [-128, 127]: inf");
+      JSON(), TINYINT(), {"Infinity"_sv}, "Not a JSON input");
   testThrow<JsonNativeType, int8_t>(
-      JSON(),
-      TINYINT(),
-      {"NaN"_sv},
-      "Cannot cast from Json value NaN to TINYINT: value is out of range [-128, 127]: nan");
+      JSON(), TINYINT(), {"NaN"_sv}, "Not a JSON input");
   testThrow<JsonNativeType, int8_t>(
       JSON(), TINYINT(), {""_sv}, "Not a JSON input");
 }
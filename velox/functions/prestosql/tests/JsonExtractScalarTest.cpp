@@ -206,6 +206,29 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {R"({"a": 1, "b": {"c": "x"}})",
+       R"({"b": {"c": true}, "a": [1]})",
+       std::nullopt,
+       R"({"a": )"},
+      JSON())});
+  const std::string expression =
+      "concat(coalesce(json_extract_scalar(c0, '$.a'), '?'), "
+      "coalesce(json_extract_scalar(c0, '$.b.c'), '?'), "
+      "coalesce(json_extract_scalar(c0, '$.a'), '?'))";
+
+  // Both paths are extracted by one call.
+  auto exprSet = compileExpression(expression, asRowType(data->type()));
+  EXPECT_NE(
+      exprSet->toString().find("$internal$json_extract_scalar_multi"),
+      std::string::npos);
+
+  velox::test::assertEqualVectors(
+      makeFlatVector<StringView>({"1x1", "?true?", "???", "???"}),
+      evaluate(expression, data));
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -197,10 +197,9 @@ TEST_F(JsonFunctionsTest, jsonParse) {
   EXPECT_EQ(jsonParse(R"({"k1":"v1"})"), R"({"k1":"v1"})");
   EXPECT_EQ(jsonParse(R"(["k1", "v1"])"), R"(["k1", "v1"])");
 
-  VELOX_ASSERT_THROW(jsonParse(R"({"k1":})"), "expected json value");
-  VELOX_ASSERT_THROW(
-      jsonParse(R"({:"k1"})"), "json parse error on line 0 near `:\"k1\"}");
-  VELOX_ASSERT_THROW(jsonParse(R"(not_json)"), "expected json value");
+  VELOX_ASSERT_THROW(jsonParse(R"({"k1":})"), "Invalid JSON");
+  VELOX_ASSERT_THROW(jsonParse(R"({:"k1"})"), "Invalid JSON");
+  VELOX_ASSERT_THROW(jsonParse(R"(not_json)"), "Invalid JSON");
 
   EXPECT_EQ(jsonParseWithTry(R"(not_json)"), std::nullopt);
   EXPECT_EQ(jsonParseWithTry(R"({"k1":})"), std::nullopt);
@@ -221,9 +220,7 @@ TEST_F(JsonFunctionsTest, jsonParse) {
   velox::test::assertEqualVectors(
       expectedVector, evaluate("try(json_parse(c0))", data));
 
-  VELOX_ASSERT_THROW(
-      evaluate("json_parse(c0)", data),
-      "json parse error on line 0 near `:': parsing didn't consume all input");
+  VELOX_ASSERT_THROW(evaluate("json_parse(c0)", data), "Invalid JSON");
 
   data = makeRowVector({makeFlatVector<StringView>(
       {R"("This is a long sentence")", R"("This is some other sentence")"})});
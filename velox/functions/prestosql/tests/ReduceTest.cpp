@@ -242,3 +242,32 @@ TEST_F(ReduceTest, nullArray) {
   assertEqualVectors(
       makeNullableFlatVector<int64_t>({std::nullopt, std::nullopt}), result);
 }
+
+TEST_F(ReduceTest, doubleSum) {
+  // (s, x) -> s + x over doubles is computed without applying the lambda.
+  // (s, x) -> x + s is not recognized and gives the same results.
+  vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeArrayVector<double>(
+          size,
+          modN(7),
+          [](vector_size_t index) { return index * 0.1; },
+          nullEvery(11),
+          nullEvery(13)),
+      makeFlatVector<double>(
+          size, [](auto row) { return row * 0.01; }, nullEvery(17)),
+  });
+
+  auto result =
+      evaluate("reduce(c0, c1, (s, x) -> s + x, s -> s * 2.0)", data);
+  auto expected =
+      evaluate("reduce(c0, c1, (s, x) -> x + s, s -> s * 2.0)", data);
+  assertEqualVectors(expected, result);
+  ASSERT_TRUE(result->isNullAt(11));
+  ASSERT_TRUE(result->isNullAt(17));
+  ASSERT_FALSE(result->isNullAt(2));
+
+  result = evaluate("reduce(c0, 0.0, (s, x) -> s + x, s -> s)", data);
+  expected = evaluate("reduce(c0, 0.0, (s, x) -> x + s, s -> s)", data);
+  assertEqualVectors(expected, result);
+}
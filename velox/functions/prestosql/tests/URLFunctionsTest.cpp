@@ -109,6 +109,23 @@ TEST_F(URLFunctionsTest, extractPath) {
       "/media/set/Books and Magazines.php",
       extractPath(
           "https://www.cnn.com/media/set/Books%20and%20Magazines.php?foo=bar"));
+  ASSERT_EQ(
+      "/media/set/Books+and+Magazines.php",
+      extractPath(
+          "https://www.cnn.com/media/set/Books%2Band%2BMagazines.php?foo=bar"));
+  ASSERT_EQ("/a b", extractPath("https://www.cnn.com/a+b"));
+
+  // Paths without escapes refer to the input strings.
+  auto input = makeFlatVector<std::string>(
+      {"https://www.cnn.com/media/set/books.php?foo=bar",
+       "https://www.cnn.com/media/set/Books%20and%20Magazines.php"});
+  auto result = evaluate<SimpleVector<StringView>>(
+      "url_extract_path(c0)", makeRowVector({input}));
+  const auto path = result->valueAt(0);
+  const auto url = input->valueAt(0);
+  ASSERT_EQ("/media/set/books.php", path.str());
+  ASSERT_TRUE(path.data() >= url.data() && path.data() < url.end());
+  ASSERT_EQ("/media/set/Books and Magazines.php", result->valueAt(1).str());
 }
 
 TEST_F(URLFunctionsTest, extractParameter) {
@@ -30,6 +30,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorWriters.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox {
@@ -508,10 +509,162 @@ void castToJsonFromRow(
   });
 }
 
-// Write object to writer at the current offset.
+using simdjson::dom::element_type;
+
+// Conversions of JSON scalars follow folly::dynamic::asInt() and friends, so
+// casts give the same results and errors as when JSON was parsed into
+// folly::dynamic.
+[[noreturn]] void throwUnexpectedJson(
+    const simdjson::dom::element& value,
+    const char* expected) {
+  VELOX_USER_FAIL(
+      "Expected a JSON {}, got: {}", expected, simdjson::minify(value));
+}
+
+int64_t jsonAsInt(const simdjson::dom::element& value) {
+  switch (value.type()) {
+    case element_type::INT64:
+      return value.get_int64().value();
+    case element_type::UINT64:
+      return folly::to<int64_t>(value.get_uint64().value());
+    case element_type::DOUBLE:
+      return folly::to<int64_t>(value.get_double().value());
+    case element_type::BOOL:
+      return value.get_bool().value() ? 1 : 0;
+    case element_type::STRING:
+      return folly::to<int64_t>(folly::StringPiece(value.get_string().value()));
+    default:
+      throwUnexpectedJson(value, "number");
+  }
+}
+
+double jsonAsDouble(const simdjson::dom::element& value) {
+  switch (value.type()) {
+    case element_type::INT64:
+      return value.get_int64().value();
+    case element_type::UINT64:
+      return value.get_uint64().value();
+    case element_type::DOUBLE:
+      return value.get_double().value();
+    case element_type::BOOL:
+      return value.get_bool().value() ? 1 : 0;
+    case element_type::STRING:
+      return folly::to<double>(folly::StringPiece(value.get_string().value()));
+    default:
+      throwUnexpectedJson(value, "number");
+  }
+}
+
+bool jsonAsBool(const simdjson::dom::element& value) {
+  switch (value.type()) {
+    case element_type::INT64:
+      return value.get_int64().value() != 0;
+    case element_type::UINT64:
+      return value.get_uint64().value() != 0;
+    case element_type::DOUBLE:
+      return value.get_double().value() != 0;
+    case element_type::BOOL:
+      return value.get_bool().value();
+    case element_type::STRING:
+      return folly::to<bool>(folly::StringPiece(value.get_string().value()));
+    default:
+      throwUnexpectedJson(value, "boolean");
+  }
+}
+
+void appendJsonAsString(
+    const simdjson::dom::element& value,
+    exec::StringWriter<false>& writer) {
+  switch (value.type()) {
+    case element_type::INT64:
+      writer.append(folly::to<std::string>(value.get_int64().value()));
+      break;
+    case element_type::UINT64:
+      writer.append(folly::to<std::string>(value.get_uint64().value()));
+      break;
+    case element_type::DOUBLE:
+      writer.append(folly::to<std::string>(value.get_double().value()));
+      break;
+    case element_type::BOOL:
+      writer.append(value.get_bool().value() ? "true" : "false");
+      break;
+    case element_type::STRING:
+      writer.append(value.get_string().value());
+      break;
+    default:
+      throwUnexpectedJson(value, "scalar");
+  }
+}
+
+// Appends 'value' to 'out' as JSON with the keys of objects sorted to match
+// Presto's behavior. Of duplicate keys, the last one is kept.
+void appendSortedJson(const simdjson::dom::element& value, std::string& out) {
+  static const folly::json::serialization_opts kOpts;
+  switch (value.type()) {
+    case element_type::ARRAY: {
+      out.push_back('[');
+      bool first = true;
+      for (auto child : value.get_array()) {
+        if (!first) {
+          out.push_back(',');
+        }
+        first = false;
+        appendSortedJson(child, out);
+      }
+      out.push_back(']');
+      break;
+    }
+    case element_type::OBJECT: {
+      std::vector<std::pair<std::string_view, simdjson::dom::element>> fields;
+      for (auto field : value.get_object()) {
+        fields.emplace_back(field.key, field.value);
+      }
+      std::stable_sort(
+          fields.begin(), fields.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+          });
+      out.push_back('{');
+      bool first = true;
+      for (auto i = 0; i < fields.size(); ++i) {
+        if (i + 1 < fields.size() && fields[i + 1].first == fields[i].first) {
+          continue;
+        }
+        if (!first) {
+          out.push_back(',');
+        }
+        first = false;
+        folly::json::escapeString(fields[i].first, out, kOpts);
+        out.push_back(':');
+        appendSortedJson(fields[i].second, out);
+      }
+      out.push_back('}');
+      break;
+    }
+    case element_type::STRING:
+      folly::json::escapeString(value.get_string().value(), out, kOpts);
+      break;
+    case element_type::INT64:
+      folly::toAppend(value.get_int64().value(), &out);
+      break;
+    case element_type::UINT64:
+      folly::toAppend(value.get_uint64().value(), &out);
+      break;
+    case element_type::DOUBLE:
+      out.append(folly::toJson(folly::dynamic(value.get_double().value())));
+      break;
+    case element_type::BOOL:
+      out.append(value.get_bool().value() ? "true" : "false");
+      break;
+    case element_type::NULL_VALUE:
+      out.append("null");
+      break;
+  }
+}
+
+// Write 'value' to writer at the current offset.
 template <TypeKind kind>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped(
-    const folly::dynamic& /*object*/,
+    const simdjson::dom::element& /*value*/,
     exec::GenericWriter&
     /*writer*/) {
   VELOX_NYI(
@@ -521,155 +674,182 @@ FOLLY_ALWAYS_INLINE void castFromJsonTyped(
 // Forward declarations.
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ARRAY>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer);
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::MAP>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer);
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ROW>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer);
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::VARCHAR>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
   if (isJsonType(writer.type())) {
-    // Sort keys to match Presto's behavior.
-    folly::json::serialization_opts opts;
-    opts.sort_keys = true;
-    writer.castTo<Varchar>().append(folly::json::serialize(object, opts));
-  } else if (object.isBool()) {
-    writer.castTo<Varchar>().append(object.asBool() ? "true" : "false");
+    std::string json;
+    appendSortedJson(value, json);
+    writer.castTo<Varchar>().append(json);
   } else {
-    writer.castTo<Varchar>().append(object.asString());
+    appendJsonAsString(value, writer.castTo<Varchar>());
   }
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::BOOLEAN>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<bool>() = object.asBool();
+  writer.castTo<bool>() = jsonAsBool(value);
 }
 
 template <typename T>
-FOLLY_ALWAYS_INLINE T castJsonToInt(const folly::dynamic& object) {
-  if (object.isDouble()) {
+FOLLY_ALWAYS_INLINE T castJsonToInt(const simdjson::dom::element& value) {
+  if (value.is_double()) {
     constexpr double kIntMaxAsDouble =
         static_cast<double>(std::numeric_limits<T>::max());
     constexpr double kIntMinAsDouble =
         static_cast<double>(std::numeric_limits<T>::min());
 
-    double value = object.asDouble();
-    if (value <= kIntMaxAsDouble && value >= kIntMinAsDouble) {
-      return static_cast<T>(value);
+    double doubleValue = value.get_double().value();
+    if (doubleValue <= kIntMaxAsDouble && doubleValue >= kIntMinAsDouble) {
+      return static_cast<T>(doubleValue);
     }
 
     VELOX_USER_FAIL(
         "value is out of range [{}, {}]: {}",
         kIntMinAsDouble,
         kIntMaxAsDouble,
-        value);
+        doubleValue);
   } else {
-    return folly::to<T>(object.asInt());
+    return folly::to<T>(jsonAsInt(value));
   }
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::TINYINT>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<int8_t>() = castJsonToInt<int8_t>(object);
+  writer.castTo<int8_t>() = castJsonToInt<int8_t>(value);
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::SMALLINT>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<int16_t>() = castJsonToInt<int16_t>(object);
+  writer.castTo<int16_t>() = castJsonToInt<int16_t>(value);
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::INTEGER>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<int32_t>() = castJsonToInt<int32_t>(object);
+  writer.castTo<int32_t>() = castJsonToInt<int32_t>(value);
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::BIGINT>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<int64_t>() = castJsonToInt<int64_t>(object);
+  writer.castTo<int64_t>() = castJsonToInt<int64_t>(value);
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::REAL>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<float>() = folly::to<float>(object.asDouble());
+  writer.castTo<float>() = folly::to<float>(jsonAsDouble(value));
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::DOUBLE>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
-  writer.castTo<double>() = folly::to<double>(object.asDouble());
+  writer.castTo<double>() = jsonAsDouble(value);
 }
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ARRAY>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
+  VELOX_USER_CHECK(
+      value.is_array(), "Only casting from JSON array to ARRAY is supported.");
   auto& writerTyped = writer.castTo<Array<Any>>();
+  const auto& elementType = writer.type()->childAt(0);
 
-  for (auto it = object.begin(); it != object.end(); ++it) {
+  for (auto element : value.get_array()) {
     // If casting to array of JSON, nulls in array elements should become the
     // JSON text "null".
-    if (!isJsonType(writer.type()->childAt(0)) && it->isNull()) {
+    if (!isJsonType(elementType) && element.is_null()) {
       writerTyped.add_null();
     } else {
       VELOX_DYNAMIC_TYPE_DISPATCH(
           castFromJsonTyped,
-          writer.type()->childAt(0)->kind(),
-          *it,
+          elementType->kind(),
+          element,
           writerTyped.add_item());
     }
   }
 }
 
+// Writes a key of a JSON object. Keys are strings, which are converted like
+// JSON string values.
+template <TypeKind kind>
+FOLLY_ALWAYS_INLINE void castFromJsonKey(
+    std::string_view key,
+    exec::GenericWriter& writer) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const folly::StringPiece keyPiece(key);
+  if constexpr (kind == TypeKind::VARCHAR) {
+    writer.castTo<Varchar>().append(key);
+  } else if constexpr (kind == TypeKind::BOOLEAN) {
+    writer.castTo<bool>() = folly::to<bool>(keyPiece);
+  } else if constexpr (std::is_integral_v<T>) {
+    writer.castTo<T>() = folly::to<T>(folly::to<int64_t>(keyPiece));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    writer.castTo<T>() = folly::to<T>(folly::to<double>(keyPiece));
+  } else {
+    VELOX_NYI(
+        "Casting from JSON to MAP with {} keys is not supported.",
+        TypeTraits<kind>::name);
+  }
+}
+
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::MAP>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
+  VELOX_USER_CHECK(
+      value.is_object(), "Only casting from JSON object to MAP is supported.");
   auto& writerTyped = writer.castTo<Map<Any, Any>>();
+  const auto& keyType = writer.type()->childAt(0);
+  const auto& valueType = writer.type()->childAt(1);
+
+  // Of duplicate keys, the last one is kept.
+  folly::F14FastMap<std::string_view, simdjson::dom::element> fields;
+  for (auto field : value.get_object()) {
+    fields.insert_or_assign(field.key, field.value);
+  }
 
-  for (const auto& pair : object.items()) {
+  for (const auto& [key, fieldValue] : fields) {
     // If casting to map of JSON values, nulls in map values should become the
     // JSON text "null".
-    if (!isJsonType(writer.type()->childAt(1)) && pair.second.isNull()) {
+    if (!isJsonType(valueType) && fieldValue.is_null()) {
       auto& keyWriter = writerTyped.add_null();
       VELOX_DYNAMIC_TYPE_DISPATCH(
-          castFromJsonTyped,
-          writer.type()->childAt(0)->kind(),
-          pair.first,
-          keyWriter);
+          castFromJsonKey, keyType->kind(), key, keyWriter);
     } else {
       auto writerPair = writerTyped.add_item();
       VELOX_DYNAMIC_TYPE_DISPATCH(
-          castFromJsonTyped,
-          writer.type()->childAt(0)->kind(),
-          pair.first,
-          std::get<0>(writerPair));
+          castFromJsonKey, keyType->kind(), key, std::get<0>(writerPair));
       VELOX_DYNAMIC_TYPE_DISPATCH(
           castFromJsonTyped,
-          writer.type()->childAt(1)->kind(),
-          pair.second,
+          valueType->kind(),
+          fieldValue,
           std::get<1>(writerPair));
     }
   }
@@ -677,47 +857,50 @@ FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::MAP>(
 
 template <>
 FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ROW>(
-    const folly::dynamic& object,
+    const simdjson::dom::element& value,
     exec::GenericWriter& writer) {
   VELOX_USER_CHECK(
-      object.isArray() || object.isObject(),
+      value.is_array() || value.is_object(),
       "Only casting from JSON array or object to ROW is supported.");
 
   auto& writerTyped = writer.castTo<DynamicRow>();
 
-  if (object.isArray()) {
+  if (value.is_array()) {
+    auto array = value.get_array().value();
     VELOX_USER_CHECK_EQ(
         writer.type()->size(),
-        object.size(),
+        array.size(),
         "Cannot cast a JSON array of size {} to ROW with {} fields.",
-        object.size(),
+        array.size(),
         writer.type()->size());
 
     column_index_t i = 0;
-    for (auto it = object.begin(); it != object.end(); ++it, ++i) {
-      if (it->isNull()) {
+    for (auto element : array) {
+      if (element.is_null()) {
         writerTyped.set_null_at(i);
       } else {
         VELOX_DYNAMIC_TYPE_DISPATCH(
             castFromJsonTyped,
             writer.type()->childAt(i)->kind(),
-            *it,
+            element,
             writerTyped.get_writer_at(i));
       }
+      ++i;
     }
   } else {
     auto rowType = writer.type()->asRow();
     column_index_t fieldCount = rowType.size();
 
-    folly::F14FastMap<std::string, const folly::dynamic*> lowerCaseKeys;
+    auto object = value.get_object().value();
+    folly::F14FastMap<std::string, simdjson::dom::element> lowerCaseKeys;
     lowerCaseKeys.reserve(object.size());
 
-    for (const auto& [key, value] : object.items()) {
+    for (auto field : object) {
       // Skip null values.
-      if (!value.isNull()) {
-        const auto lowerCaseKey =
-            boost::algorithm::to_lower_copy(key.asString());
-        lowerCaseKeys.insert({lowerCaseKey, &value});
+      if (!field.value.is_null()) {
+        lowerCaseKeys.insert_or_assign(
+            boost::algorithm::to_lower_copy(std::string(field.key)),
+            field.value);
       }
     }
 
@@ -731,7 +914,7 @@ FOLLY_ALWAYS_INLINE void castFromJsonTyped<TypeKind::ROW>(
         VELOX_DYNAMIC_TYPE_DISPATCH(
             castFromJsonTyped,
             rowType.childAt(i)->kind(),
-            *(it->second),
+            it->second,
             writerTyped.get_writer_at(i));
       }
     }
@@ -752,25 +935,27 @@ void castFromJson(
   // input is guaranteed to be in flat or constant encodings when passed in.
   auto* inputVector = input.as<SimpleVector<StringView>>();
 
-  folly::dynamic object;
   context.applyToSelectedNoThrow(rows, [&](auto row) {
     writer.setOffset(row);
 
     if (inputVector->isNullAt(row)) {
       writer.commitNull();
     } else {
-      try {
-        object = folly::parseJson(inputVector->valueAt(row));
-      } catch (const std::exception& e) {
+      const auto json = inputVector->valueAt(row);
+      // Parsing with the thread local DOM parser validates the whole input
+      // without allocating per row.
+      simdjson::dom::element value;
+      const std::string_view jsonView(json.data(), json.size());
+      if (functions::simdjsonParseDom(jsonView).get(value)) {
         writer.commitNull();
-        VELOX_USER_FAIL("Not a JSON input: {}", inputVector->valueAt(row));
+        VELOX_USER_FAIL("Not a JSON input: {}", json);
       }
 
-      if (object.isNull()) {
+      if (value.is_null()) {
         writer.commitNull();
       } else {
         try {
-          castFromJsonTyped<kind>(object, writer.current());
+          castFromJsonTyped<kind>(value, writer.current());
         } catch (const VeloxException& ve) {
           if (!ve.isUserError()) {
             throw;
@@ -778,14 +963,14 @@ void castFromJson(
           writer.commitNull();
           VELOX_USER_FAIL(
               "Cannot cast from Json value {} to {}: {}",
-              inputVector->valueAt(row),
+              json,
               result.type()->toString(),
               ve.message());
         } catch (const std::exception& e) {
           writer.commitNull();
           VELOX_USER_FAIL(
               "Cannot cast from Json value {} to {}: {}",
-              inputVector->valueAt(row),
+              json,
               result.type()->toString(),
               e.what());
         }
@@ -30,6 +30,7 @@ class CumeDistFunction : public exec::WindowFunction {
     runningTotal_ = 0;
     cumeDist_ = 0;
     currentPeerGroupStart_ = -1;
+    partitionRow_ = 0;
     numPartitionRows_ = partition->numRows();
   }
 
@@ -46,21 +47,34 @@ class CumeDistFunction : public exec::WindowFunction {
     auto* peerGroupStartsVector = peerGroupStarts->as<vector_size_t>();
     auto* peerGroupEndsVector = peerGroupEnds->as<vector_size_t>();
 
-    for (int i = 0; i < numRows; i++) {
+    // All the rows of a peer group have the same value. Fills the rows of
+    // the batch one peer group at a time.
+    for (int i = 0; i < numRows;) {
       auto peerStart = peerGroupStartsVector[i];
+      auto peerEnd = peerGroupEndsVector[i];
       if (peerStart != currentPeerGroupStart_) {
         currentPeerGroupStart_ = peerStart;
-        runningTotal_ += peerGroupEndsVector[i] - peerStart + 1;
+        runningTotal_ += peerEnd - peerStart + 1;
         cumeDist_ = double(runningTotal_) / numPartitionRows_;
       }
-      rawValues[resultOffset + i] = cumeDist_;
+      const auto numPeers = std::min<vector_size_t>(
+          numRows - i, peerEnd - (partitionRow_ + i) + 1);
+      std::fill_n(rawValues + resultOffset + i, numPeers, cumeDist_);
+      i += numPeers;
     }
+    partitionRow_ += numRows;
+  }
+
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kForward;
   }
 
  private:
   int64_t runningTotal_ = 0;
   double cumeDist_ = 0;
   int64_t currentPeerGroupStart_ = -1;
+  // Partition row number of the first row of the next batch.
+  vector_size_t partitionRow_ = 0;
   vector_size_t numPartitionRows_ = 1;
 };
 
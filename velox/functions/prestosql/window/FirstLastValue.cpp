@@ -66,11 +66,26 @@ class FirstLastValueFunction : public exec::WindowFunction {
     }
 
     setRowNumbersForEmptyFrames(validRows);
+    if (consecutiveRowNumbers(numRows)) {
+      // Sliding frames, e.g. ROWS BETWEEN n PRECEDING AND CURRENT ROW, read
+      // consecutive partition rows, which are copied in one range.
+      partition_->extractColumn(
+          valueIndex_, rowNumbers_[0], numRows, resultOffset, result);
+      return;
+    }
     auto rowNumbersRange = folly::Range(rowNumbers_.data(), numRows);
     partition_->extractColumn(
         valueIndex_, rowNumbersRange, resultOffset, result);
   }
 
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kFrameRows;
+  }
+
+  std::optional<RowOffsets> streamingRowOffsets() const override {
+    return RowOffsets{};
+  }
+
  private:
   void setRowNumbersForEmptyFrames(const SelectivityVector& validRows) {
     if (validRows.isAllSelected()) {
@@ -83,6 +98,20 @@ class FirstLastValueFunction : public exec::WindowFunction {
     invalidRows_.applyToSelected([&](auto i) { rowNumbers_[i] = kNullRow; });
   }
 
+  // Returns true if 'rowNumbers_' is a run of increasing consecutive
+  // partition rows without kNullRow.
+  bool consecutiveRowNumbers(vector_size_t numRows) const {
+    if (numRows == 0 || rowNumbers_[0] == kNullRow) {
+      return false;
+    }
+    for (auto i = 1; i < numRows; ++i) {
+      if (rowNumbers_[i] != rowNumbers_[i - 1] + 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void setRowNumbersRespectNulls(
       const SelectivityVector& validRows,
       const BufferPtr& frameStarts,
@@ -77,15 +77,45 @@ class LeadLagFunction : public exec::WindowFunction {
       }
     }
 
-    auto rowNumbersRange = folly::Range(rowNumbers_.data(), numRows);
-    partition_->extractColumn(
-        valueIndex_, rowNumbersRange, resultOffset, result);
+    if (constantOffset_.has_value() && !ignoreNullsForPartition_) {
+      extractConsecutiveRows(numRows, resultOffset, result);
+    } else {
+      auto rowNumbersRange = folly::Range(rowNumbers_.data(), numRows);
+      partition_->extractColumn(
+          valueIndex_, rowNumbersRange, resultOffset, result);
+    }
 
     setDefaultValue(result, resultOffset);
 
     partitionOffset_ += numRows;
   }
 
+  // lag() reads rows before the current row and ignoreNulls reads the nulls
+  // of the whole partition in resetPartition().
+  PartitionAccess partitionAccess() const override {
+    return !isLag && !ignoreNulls_ ? PartitionAccess::kForward
+                                   : PartitionAccess::kRandom;
+  }
+
+  // lead() needs the number of rows in the partition to null out the rows
+  // past its end unless the offset is constant. A non-constant lag() offset
+  // can reach any row before the current row.
+  std::optional<RowOffsets> streamingRowOffsets() const override {
+    if (ignoreNulls_) {
+      return std::nullopt;
+    }
+    if (isConstantOffsetNull_) {
+      return RowOffsets{};
+    }
+    if (!isLag && !constantOffset_.has_value()) {
+      return std::nullopt;
+    }
+    const vector_size_t offset = std::min<int64_t>(
+        constantOffset_.value_or(std::numeric_limits<vector_size_t>::max()),
+        std::numeric_limits<vector_size_t>::max());
+    return isLag ? RowOffsets{offset, 0} : RowOffsets{0, offset};
+  }
+
  private:
   void initializeOffset(const std::vector<exec::WindowFunctionArg>& args) {
     if (args.size() == 1) {
@@ -190,6 +220,38 @@ class LeadLagFunction : public exec::WindowFunction {
     }
   }
 
+  // With a constant offset and no nulls to skip, the rows other than kNullRow
+  // are a run of consecutive partition rows. Copies them with one contiguous
+  // extractColumn() and sets the rows before and after the run to null.
+  void extractConsecutiveRows(
+      vector_size_t numRows,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    vector_size_t begin = 0;
+    while (begin < numRows && rowNumbers_[begin] == kNullRow) {
+      ++begin;
+    }
+    vector_size_t end = numRows;
+    while (end > begin && rowNumbers_[end - 1] == kNullRow) {
+      --end;
+    }
+
+    if (begin < end) {
+      partition_->extractColumn(
+          valueIndex_,
+          rowNumbers_[begin],
+          end - begin,
+          resultOffset + begin,
+          result);
+    }
+    for (auto i = 0; i < begin; ++i) {
+      result->setNull(resultOffset + i, true);
+    }
+    for (auto i = end; i < numRows; ++i) {
+      result->setNull(resultOffset + i, true);
+    }
+  }
+
   vector_size_t rowNumberIgnoreNull(
       const uint64_t* rawNulls,
       vector_size_t offset,
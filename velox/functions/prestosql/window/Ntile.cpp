@@ -81,6 +81,10 @@ class NtileFunction : public exec::WindowFunction {
     partitionOffset_ += numRows;
   }
 
+  PartitionAccess partitionAccess() const override {
+    return PartitionAccess::kForward;
+  }
+
  private:
   // These are some intermediate values required for bucket computation when the
   // number of rows in the partition exceeds the number of buckets.
@@ -110,22 +114,30 @@ class NtileFunction : public exec::WindowFunction {
 
     // Compute the bucket value for a fixed bucket number for a vector
     // of rows. The vector starts at the partitionOffset index in the
-    // partition rows.
+    // partition rows. Buckets are runs of consecutive rows, so the result is
+    // filled one bucket at a time.
     void computeBucketValue(
         vector_size_t numRows,
         int64_t partitionOffset,
         vector_size_t resultOffset,
         int64_t* rawResultValues) {
       int64_t i = 0;
-      // This loop terminates if it reaches extraBucketBoundary or numRows
-      // in the result vector are filled.
-      for (int64_t j = partitionOffset; i < numRows && j < extraBucketsBoundary;
-           i++, j++) {
-        rawResultValues[resultOffset + i] = j / (rowsPerBucket + 1) + 1;
-      }
-      for (; i < numRows; i++) {
-        rawResultValues[resultOffset + i] =
-            (partitionOffset + i - bucketsWithExtraRow) / rowsPerBucket + 1;
+      while (i < numRows) {
+        const auto row = partitionOffset + i;
+        int64_t bucket;
+        int64_t bucketEnd;
+        if (row < extraBucketsBoundary) {
+          bucket = row / (rowsPerBucket + 1);
+          bucketEnd = (bucket + 1) * (rowsPerBucket + 1);
+        } else {
+          bucket = (row - bucketsWithExtraRow) / rowsPerBucket;
+          bucketEnd = bucketsWithExtraRow + (bucket + 1) * rowsPerBucket;
+        }
+        const auto numBucketRows =
+            std::min<int64_t>(numRows - i, bucketEnd - row);
+        std::fill_n(
+            rawResultValues + resultOffset + i, numBucketRows, bucket + 1);
+        i += numBucketRows;
       }
     }
   };
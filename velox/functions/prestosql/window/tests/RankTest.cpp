@@ -103,5 +103,38 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     RankTest,
     testing::ValuesIn(getRankTestParams()));
 
+class RankPeerGroupTest : public WindowTestBase {
+ protected:
+  void SetUp() override {
+    WindowTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+  }
+};
+
+// Tests peer groups and ntile buckets of many rows, which are filled one run
+// at a time, including runs that span input vectors and partitions.
+TEST_F(RankPeerGroupTest, largePeerGroups) {
+  auto makeInput = [&](vector_size_t size, vector_size_t base) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            size, [&](auto row) { return (base + row) / 500; }),
+        makeFlatVector<int32_t>(
+            size, [&](auto row) { return (base + row) % 500 / 37; }),
+    });
+  };
+  std::vector<RowVectorPtr> input = {makeInput(700, 0), makeInput(800, 700)};
+  for (const auto& function :
+       {"rank()",
+        "dense_rank()",
+        "percent_rank()",
+        "cume_dist()",
+        "ntile(7)",
+        "lag(c1, 3)",
+        "lead(c1, 40)"}) {
+    WindowTestBase::testWindowFunction(
+        input, function, {"partition by c0 order by c1"});
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -182,6 +182,167 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, spillLargePartitions) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 3; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  // The functions access a bounded range of rows around the current row, so
+  // the partitions are paged in from spill files.
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "rank() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s "
+      "rows between 2 preceding and current row)",
+      "lead(d, 2) over (partition by p order by s)",
+      "first_value(d) over (partition by p order by s "
+      "rows between 1 preceding and 1 following)",
+  };
+
+  core::PlanNodeId windowId;
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .capturePlanNodeId(windowId)
+                  .planNode();
+
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+          .config(core::QueryConfig::kTestingSpillPct, "100")
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kWindowSpillEnabled, "true")
+          .spillDirectory(spillDirectory->path)
+          .assertResults(fmt::format(
+              "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at(windowId);
+
+  // Both the input rows and the partition rows are spilled.
+  ASSERT_GT(stats.spilledRows, size);
+}
+
+// Frames of hundreds of rows are aggregated with a segment tree.
+TEST_F(WindowTest, largeSlidingFrames) {
+  const vector_size_t size = 3'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 97 - 40; }, nullEvery(13)),
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 2; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 300 preceding and 37 following",
+      "rows between current row and 500 following",
+      "rows between 70 following and 200 following",
+  };
+  for (const auto& function :
+       {"sum(d)", "min(d)", "max(d)", "count(d)", "avg(d)"}) {
+    testWindowFunction(
+        {data}, function, {"partition by p order by s"}, frameClauses);
+  }
+}
+
+TEST_F(WindowTest, parallelPartitions) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 61; }),
+          // Partitions of very different sizes.
+          makeFlatVector<int32_t>(
+              size, [](auto row) { return row % 7 == 0 ? 0 : row % 997; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  const std::vector<std::string> functions = {
+      "row_number() over (partition by p order by s)",
+      "sum(d) over (partition by p order by s "
+      "rows between 10 preceding and current row)",
+      "max(d) over (partition by p)",
+  };
+  auto plan = PlanBuilder()
+                  .values(split(data, 10))
+                  .window(functions)
+                  .planNode();
+
+  for (const auto* parallelism : {"1", "4", "16"}) {
+    SCOPED_TRACE(fmt::format("parallelism: {}", parallelism));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .config(core::QueryConfig::kWindowParallelism, parallelism)
+        .assertResults(fmt::format(
+            "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+  }
+}
+
+TEST_F(WindowTest, incompletePartitions) {
+  const vector_size_t size = 10'000;
+  // Sorted by 'p' and 's'. 'd' is the same for the peers of each row so the
+  // results do not depend on the order of the peers.
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row / 3 * 7 % 101; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 2'500; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 3; }),
+      });
+
+  createDuckDbTable({data});
+
+  // The first set of functions is evaluated while the rows of the partitions
+  // arrive. ntile() needs the size of the partition.
+  const std::vector<std::vector<std::string>> functionSets = {
+      {
+          "row_number() over (partition by p order by s)",
+          "rank() over (partition by p order by s)",
+          "dense_rank() over (partition by p order by s)",
+          "sum(d) over (partition by p order by s "
+          "rows between 5 preceding and 2 following)",
+          "lead(d, 4) over (partition by p order by s)",
+          "lag(d, 3) over (partition by p order by s)",
+          "first_value(d) over (partition by p order by s "
+          "rows between 1 preceding and 7 following)",
+          "max(d) over (partition by p order by s)",
+      },
+      {
+          "row_number() over (partition by p order by s)",
+          "ntile(7) over (partition by p order by s)",
+      },
+  };
+
+  for (const auto& functions : functionSets) {
+    SCOPED_TRACE(folly::join(", ", functions));
+    auto plan = PlanBuilder()
+                    .values(split(data, 37))
+                    .streamingWindow(functions)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(fmt::format(
+            "SELECT *, {} FROM tmp", folly::join(", ", functions)));
+  }
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -479,6 +479,20 @@ int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
 
 namespace {
 
+// Reads a single non-null fixed-width value from 'buffer'.
+template <typename T>
+FOLLY_ALWAYS_INLINE T readFixedWidthValue(const char* buffer) {
+  if constexpr (std::is_same_v<T, Timestamp>) {
+    int64_t micros;
+    memcpy(&micros, buffer, sizeof(int64_t));
+    return Timestamp::fromMicros(micros);
+  } else {
+    T value;
+    memcpy(&value, buffer, sizeof(T));
+    return value;
+  }
+}
+
 // Reads single fixed-width value from buffer into flatVector[index].
 template <typename T>
 void readFixedWidthValue(
@@ -488,14 +502,8 @@ void readFixedWidthValue(
     vector_size_t index) {
   if (isNull) {
     flatVector->setNull(index, true);
-  } else if constexpr (std::is_same_v<T, Timestamp>) {
-    int64_t micros;
-    memcpy(&micros, buffer, sizeof(int64_t));
-    flatVector->set(index, Timestamp::fromMicros(micros));
   } else {
-    T value;
-    memcpy(&value, buffer, sizeof(T));
-    flatVector->set(index, value);
+    flatVector->set(index, readFixedWidthValue<T>(buffer));
   }
 }
 
@@ -528,10 +536,26 @@ VectorPtr deserializeFixedWidth(
 
   auto* rawNulls = nulls->as<uint64_t>();
 
-  for (auto i = 0; i < numRows; ++i) {
-    const bool isNull = bits::isBitNull(rawNulls, i);
-    readFixedWidthValue<T>(
-        isNull, data[i].data() + offsets[i], flatVector.get(), i);
+  // Writes the values buffer directly and takes 'nulls' as is instead of
+  // setting values and nulls one by one.
+  if constexpr (std::is_same_v<T, bool>) {
+    auto* rawValues = flatVector->template mutableRawValues<uint64_t>();
+    for (auto i = 0; i < numRows; ++i) {
+      bits::setBit(
+          rawValues,
+          i,
+          !bits::isBitNull(rawNulls, i) && data[i][offsets[i]] != 0);
+    }
+  } else {
+    auto* rawValues = flatVector->mutableRawValues();
+    for (auto i = 0; i < numRows; ++i) {
+      rawValues[i] = bits::isBitNull(rawNulls, i)
+          ? T()
+          : readFixedWidthValue<T>(data[i].data() + offsets[i]);
+    }
+  }
+  if (!bits::isAllSet(rawNulls, 0, numRows)) {
+    flatVector->setNulls(nulls);
   }
 
   return flatVector;
@@ -633,15 +657,23 @@ VectorPtr deserializeStrings(
       BaseVector::create<FlatVector<StringView>>(type, numRows, pool);
 
   auto* rawNulls = nulls->as<uint64_t>();
+  auto* rawValues = flatVector->mutableRawValues();
 
+  // The strings point into 'data'. Writes the views directly as in
+  // deserializeFixedWidth().
   for (auto i = 0; i < numRows; ++i) {
     if (bits::isBitNull(rawNulls, i)) {
-      flatVector->setNull(i, true);
+      rawValues[i] = StringView();
     } else {
-      offsets[i] +=
-          readString(data[i].data() + offsets[i], flatVector.get(), i);
+      const auto* buffer = data[i].data() + offsets[i];
+      const auto size = readInt32(buffer);
+      rawValues[i] = StringView(buffer + kSizeBytes, size);
+      offsets[i] += kSizeBytes + size;
     }
   }
+  if (!bits::isAllSet(rawNulls, 0, numRows)) {
+    flatVector->setNulls(nulls);
+  }
 
   return flatVector;
 }
@@ -931,16 +963,24 @@ RowVectorPtr deserializeRows(
   auto* rawNulls = nulls != nullptr ? nulls->as<uint64_t>() : nullptr;
 
   std::vector<BufferPtr> fieldNulls;
+  std::vector<uint64_t*> rawFieldNulls;
   fieldNulls.reserve(numFields);
+  rawFieldNulls.reserve(numFields);
   for (auto i = 0; i < numFields; ++i) {
-    fieldNulls.emplace_back(allocateNulls(numRows, pool));
-    auto* rawFieldNulls = fieldNulls.back()->asMutable<uint8_t>();
-    for (auto row = 0; row < numRows; ++row) {
-      auto* serializedNulls = readNulls(data[row].data() + offsets[row]);
-      const auto isNull =
-          (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) ||
-          bits::isBitSet(serializedNulls, i);
-      bits::setBit(rawFieldNulls, row, !isNull);
+    // All null, so that only the non-null fields of non-null rows are set.
+    fieldNulls.emplace_back(allocateNulls(numRows, pool, bits::kNull));
+    rawFieldNulls.push_back(fieldNulls.back()->asMutable<uint64_t>());
+  }
+  // Reads the null flags of each row once for all fields.
+  for (auto row = 0; row < numRows; ++row) {
+    if (rawNulls != nullptr && bits::isBitNull(rawNulls, row)) {
+      continue;
+    }
+    auto* serializedNulls = readNulls(data[row].data() + offsets[row]);
+    for (auto i = 0; i < numFields; ++i) {
+      if (!bits::isBitSet(serializedNulls, i)) {
+        bits::setBit(rawFieldNulls[i], row);
+      }
     }
   }
 
@@ -155,6 +155,139 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::rowSizes(
+    folly::Range<const vector_size_t*> rows,
+    int32_t* sizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  const int32_t fixedSize = rowNullBytes_ + children_.size() * kFieldWidth;
+  std::fill(sizes, sizes + rows.size(), fixedSize);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    const bool isString = child.typeKind_ == TypeKind::VARCHAR ||
+        child.typeKind_ == TypeKind::VARBINARY;
+    for (auto j = 0; j < rows.size(); ++j) {
+      const auto childIndex = decoded_.index(rows[j]);
+      if (child.isNullAt(childIndex)) {
+        continue;
+      }
+      if (isString) {
+        sizes[j] += alignBytes(
+            child.decoded_.valueAt<StringView>(childIndex).size());
+      } else {
+        sizes[j] += alignBytes(child.variableWidthRowSize(childIndex));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    folly::Range<const vector_size_t*> rows,
+    char* const* buffers) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  bool hasVariableWidth = false;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      serializeFixedWidthField(i, rows, buffers);
+    } else {
+      hasVariableWidth = true;
+    }
+  }
+  if (!hasVariableWidth) {
+    return;
+  }
+
+  std::vector<int64_t> offsets(
+      rows.size(), rowNullBytes_ + children_.size() * kFieldWidth);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (!childIsFixedWidth_[i]) {
+      serializeVariableWidthField(i, rows, buffers, offsets.data());
+    }
+  }
+}
+
+void UnsafeRowFast::serializeFixedWidthField(
+    int32_t field,
+    folly::Range<const vector_size_t*> rows,
+    char* const* buffers) {
+  auto& child = children_[field];
+  if (child.supportsBulkCopy_) {
+    switch (child.valueBytes_) {
+      case 1:
+        return copyFixedWidthField<int8_t>(field, rows, buffers);
+      case 2:
+        return copyFixedWidthField<int16_t>(field, rows, buffers);
+      case 4:
+        return copyFixedWidthField<int32_t>(field, rows, buffers);
+      case 8:
+        return copyFixedWidthField<int64_t>(field, rows, buffers);
+      default:
+        break;
+    }
+  }
+
+  const auto fieldOffset = rowNullBytes_ + field * kFieldWidth;
+  for (auto j = 0; j < rows.size(); ++j) {
+    const auto childIndex = decoded_.index(rows[j]);
+    if (child.isNullAt(childIndex)) {
+      bits::setBit(buffers[j], field, true);
+    } else {
+      child.serializeFixedWidth(childIndex, buffers[j] + fieldOffset);
+    }
+  }
+}
+
+template <typename T>
+void UnsafeRowFast::copyFixedWidthField(
+    int32_t field,
+    folly::Range<const vector_size_t*> rows,
+    char* const* buffers) {
+  auto& child = children_[field];
+  const auto fieldOffset = rowNullBytes_ + field * kFieldWidth;
+  // The values can be null if all values are null.
+  const auto* values = child.decoded_.data<T>();
+  if (!child.decoded_.mayHaveNulls()) {
+    for (auto j = 0; j < rows.size(); ++j) {
+      *reinterpret_cast<T*>(buffers[j] + fieldOffset) =
+          values[decoded_.index(rows[j])];
+    }
+    return;
+  }
+  for (auto j = 0; j < rows.size(); ++j) {
+    const auto childIndex = decoded_.index(rows[j]);
+    if (child.isNullAt(childIndex)) {
+      bits::setBit(buffers[j], field, true);
+    } else {
+      *reinterpret_cast<T*>(buffers[j] + fieldOffset) = values[childIndex];
+    }
+  }
+}
+
+void UnsafeRowFast::serializeVariableWidthField(
+    int32_t field,
+    folly::Range<const vector_size_t*> rows,
+    char* const* buffers,
+    int64_t* offsets) {
+  auto& child = children_[field];
+  const auto fieldOffset = rowNullBytes_ + field * kFieldWidth;
+  for (auto j = 0; j < rows.size(); ++j) {
+    const auto childIndex = decoded_.index(rows[j]);
+    if (child.isNullAt(childIndex)) {
+      bits::setBit(buffers[j], field, true);
+      continue;
+    }
+    const auto size =
+        child.serializeVariableWidth(childIndex, buffers[j] + offsets[j]);
+    // Write size and offset.
+    *reinterpret_cast<uint64_t*>(buffers[j] + fieldOffset) =
+        offsets[j] << 32 | size;
+    offsets[j] += alignBytes(size);
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
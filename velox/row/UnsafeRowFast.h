@@ -36,6 +36,17 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Computes the serialized sizes of 'rows' into 'sizes' column by column.
+  /// Use only if 'fixedRowSize' returned std::nullopt.
+  void rowSizes(folly::Range<const vector_size_t*> rows, int32_t* sizes);
+
+  /// Serializes 'rows' into 'buffers' column by column. The fixed-width fields
+  /// of all rows are written first, then the variable-width fields.
+  /// 'buffers[i]' must have the size of 'rows[i]' and be set to all zeros.
+  void serialize(
+      folly::Range<const vector_size_t*> rows,
+      char* const* buffers);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -101,6 +112,28 @@ class UnsafeRowFast {
   /// Serializes struct value to buffer. Value must not be null.
   int32_t serializeRow(vector_size_t index, char* buffer);
 
+  /// Writes the fixed-width struct field 'field' of 'rows' into 'buffers'.
+  void serializeFixedWidthField(
+      int32_t field,
+      folly::Range<const vector_size_t*> rows,
+      char* const* buffers);
+
+  /// Copies the values of fixed-width struct field 'field' of 'rows' into
+  /// 'buffers'. The field must support bulk copy.
+  template <typename T>
+  void copyFixedWidthField(
+      int32_t field,
+      folly::Range<const vector_size_t*> rows,
+      char* const* buffers);
+
+  /// Writes the variable-width struct field 'field' of 'rows' into 'buffers'
+  /// at 'offsets' and advances 'offsets' past the written values.
+  void serializeVariableWidthField(
+      int32_t field,
+      folly::Range<const vector_size_t*> rows,
+      char* const* buffers,
+      int64_t* offsets);
+
   const TypeKind typeKind_;
   DecodedVector decoded_;
 
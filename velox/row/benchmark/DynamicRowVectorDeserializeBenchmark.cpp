@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include <random>
 
+#include "velox/row/CompactRow.h"
 #include "velox/row/UnsafeRowDeserializers.h"
 #include "velox/row/UnsafeRowFast.h"
 #include "velox/type/Type.h"
@@ -33,30 +34,72 @@ using facebook::velox::test::VectorMaker;
 class Deserializer {
  public:
   virtual ~Deserializer() = default;
-  virtual void deserialize(
-      const std::vector<std::optional<std::string_view>>& data,
-      const TypePtr& type) = 0;
+
+  // Serializes 'nRows' copies of the single row of 'input' for deserialize().
+  virtual void serialize(const RowVectorPtr& input, int nRows) = 0;
+
+  virtual void deserialize(const TypePtr& type) = 0;
+
+ protected:
+  // Returns a buffer for one serialized row that lives as long as 'this'.
+  char* newRowBuffer(int32_t size) {
+    buffers_.push_back(AlignedBuffer::allocate<char>(size, pool_.get(), true));
+    return buffers_.back()->asMutable<char>();
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::addDefaultLeafMemoryPool();
+
+ private:
+  std::vector<BufferPtr> buffers_;
 };
 
 class UnsaferowBatchDeserializer : public Deserializer {
  public:
-  UnsaferowBatchDeserializer() {}
+  void serialize(const RowVectorPtr& input, int nRows) override {
+    UnsafeRowFast unsafeRow(input);
+    data_.reserve(nRows);
+    for (int32_t i = 0; i < nRows; ++i) {
+      char* buffer = newRowBuffer(1024);
+      auto rowSize = unsafeRow.serialize(0, buffer);
+      data_.push_back(std::string_view(buffer, rowSize));
+    }
+  }
 
-  void deserialize(
-      const std::vector<std::optional<std::string_view>>& data,
-      const TypePtr& type) override {
-    UnsafeRowDeserializer::deserialize(data, type, pool_.get());
+  void deserialize(const TypePtr& type) override {
+    UnsafeRowDeserializer::deserialize(data_, type, pool_.get());
   }
 
  private:
-  std::shared_ptr<memory::MemoryPool> pool_ =
-      memory::addDefaultLeafMemoryPool();
+  std::vector<std::optional<std::string_view>> data_;
+};
+
+// Measures the column by column deserialization of CompactRow.
+class CompactRowBatchDeserializer : public Deserializer {
+ public:
+  void serialize(const RowVectorPtr& input, int nRows) override {
+    CompactRow compactRow(input);
+    const auto rowSize = compactRow.rowSize(0);
+    data_.reserve(nRows);
+    for (int32_t i = 0; i < nRows; ++i) {
+      char* buffer = newRowBuffer(rowSize);
+      compactRow.serialize(0, buffer);
+      data_.push_back(std::string_view(buffer, rowSize));
+    }
+  }
+
+  void deserialize(const TypePtr& type) override {
+    CompactRow::deserialize(data_, asRowType(type), pool_.get());
+  }
+
+ private:
+  std::vector<std::string_view> data_;
 };
 
 class BenchmarkHelper {
  public:
-  std::tuple<std::vector<std::optional<std::string_view>>, TypePtr>
-  randomUnsaferows(int nFields, int nRows, bool stringOnly) {
+  // Returns a random row with 'nFields' fields.
+  RowVectorPtr randomRow(int nFields, bool stringOnly) {
     RowTypePtr rowType;
     std::vector<std::string> names;
     std::vector<TypePtr> types;
@@ -85,19 +128,7 @@ class BenchmarkHelper {
 
     auto seed = folly::Random::rand32();
     VectorFuzzer fuzzer(opts, pool_.get(), seed);
-    const auto inputVector = fuzzer.fuzzInputRow(rowType);
-    std::vector<std::optional<std::string_view>> results;
-    results.reserve(nRows);
-    // Serialize rowVector into bytes.
-    UnsafeRowFast unsafeRow(inputVector);
-    for (int32_t i = 0; i < nRows; ++i) {
-      BufferPtr bufferPtr =
-          AlignedBuffer::allocate<char>(1024, pool_.get(), true);
-      char* buffer = bufferPtr->asMutable<char>();
-      auto rowSize = unsafeRow.serialize(0, buffer);
-      results.push_back(std::string_view(buffer, rowSize));
-    }
-    return {results, rowType};
+    return fuzzer.fuzzInputRow(rowType);
   }
 
  private:
@@ -127,11 +158,12 @@ int deserialize(
     std::unique_ptr<Deserializer> deserializer) {
   folly::BenchmarkSuspender suspender;
   BenchmarkHelper helper;
-  auto [data, rowType] = helper.randomUnsaferows(nFields, nRows, variable);
+  auto input = helper.randomRow(nFields, variable);
+  deserializer->serialize(input, nRows);
   suspender.dismiss();
 
   for (int i = 0; i < nIters; i++) {
-    deserializer->deserialize(data, rowType);
+    deserializer->deserialize(input->type());
   }
 
   return nIters * nFields * nRows;
@@ -145,6 +177,14 @@ BENCHMARK_NAMED_PARAM_MULTI(
     true,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    compact_batch_10_100k_string_only,
+    10,
+    100000,
+    true,
+    std::make_unique<CompactRowBatchDeserializer>());
+
 BENCHMARK_NAMED_PARAM_MULTI(
     deserialize,
     batch_100_100k_string_only,
@@ -153,6 +193,14 @@ BENCHMARK_NAMED_PARAM_MULTI(
     true,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    compact_batch_100_100k_string_only,
+    100,
+    100000,
+    true,
+    std::make_unique<CompactRowBatchDeserializer>());
+
 BENCHMARK_NAMED_PARAM_MULTI(
     deserialize,
     batch_10_100k_all_types,
@@ -161,6 +209,14 @@ BENCHMARK_NAMED_PARAM_MULTI(
     false,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    compact_batch_10_100k_all_types,
+    10,
+    100000,
+    false,
+    std::make_unique<CompactRowBatchDeserializer>());
+
 BENCHMARK_NAMED_PARAM_MULTI(
     deserialize,
     batch_100_100k_all_types,
@@ -169,6 +225,14 @@ BENCHMARK_NAMED_PARAM_MULTI(
     false,
     std::make_unique<UnsaferowBatchDeserializer>());
 
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    deserialize,
+    compact_batch_100_100k_all_types,
+    100,
+    100000,
+    false,
+    std::make_unique<CompactRowBatchDeserializer>());
+
 } // namespace
 } // namespace facebook::spark::benchmarks
 
@@ -94,8 +94,8 @@ class UnsafeRowFuzzTests : public ::testing::Test {
       memory::addDefaultLeafMemoryPool();
 };
 
-TEST_F(UnsafeRowFuzzTests, fast) {
-  auto rowType = ROW({
+RowTypePtr fuzzRowType() {
+  return ROW({
       BOOLEAN(),
       TINYINT(),
       SMALLINT(),
@@ -158,6 +158,10 @@ TEST_F(UnsafeRowFuzzTests, fast) {
       ARRAY({ROW({BIGINT(), VARCHAR()})}),
       MAP(BIGINT(), ROW({BOOLEAN(), TINYINT(), REAL()})),
   });
+}
+
+TEST_F(UnsafeRowFuzzTests, fast) {
+  auto rowType = fuzzRowType();
 
   doTest(rowType, [&](const RowVectorPtr& data) {
     std::vector<std::optional<std::string_view>> serialized;
@@ -176,5 +180,42 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, batch) {
+  auto rowType = fuzzRowType();
+  doTest(rowType, [&](const RowVectorPtr& data) {
+    UnsafeRowFast fast(data);
+    // Serialize the rows in reverse order.
+    std::vector<vector_size_t> rows;
+    for (auto i = data->size() - 1; i >= 0; --i) {
+      rows.push_back(i);
+    }
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), rows.size());
+    std::vector<int32_t> sizes(rows.size());
+    fast.rowSizes(rowRange, sizes.data());
+    std::vector<char*> batchBuffers;
+    for (auto i = 0; i < rows.size(); ++i) {
+      VELOX_CHECK_LE(sizes[i], kBufferSize);
+      EXPECT_EQ(sizes[i], fast.rowSize(rows[i]));
+      batchBuffers.push_back(buffers_[i]);
+    }
+    fast.serialize(rowRange, batchBuffers.data());
+
+    // The batch serialization must match the serialization of single rows.
+    std::vector<char> expected(kBufferSize);
+    for (auto i = 0; i < rows.size(); ++i) {
+      std::fill(expected.begin(), expected.end(), 0);
+      EXPECT_EQ(sizes[i], fast.serialize(rows[i], expected.data()));
+      EXPECT_EQ(0, std::memcmp(expected.data(), buffers_[i], sizes[i]))
+          << rows[i] << ", " << data->toString(rows[i]);
+    }
+
+    std::vector<std::optional<std::string_view>> serialized(data->size());
+    for (auto i = 0; i < rows.size(); ++i) {
+      serialized[rows[i]] = std::string_view(buffers_[i], sizes[i]);
+    }
+    return serialized;
+  });
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -37,10 +37,21 @@ class CompactRowVectorSerializer : public VectorSerializer {
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) override {
-    size_t totalSize = 0;
     row::CompactRow row(vector);
-    if (auto fixedRowSize =
-            row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
+    append(
+        row,
+        row::CompactRow::fixedRowSize(asRowType(vector->type())),
+        ranges);
+  }
+
+  // Appends the rows in 'ranges' of a vector already converted to 'row'. Lets
+  // several serializers share the conversion.
+  void append(
+      row::CompactRow& row,
+      std::optional<int32_t> fixedRowSize,
+      const folly::Range<const IndexRange*>& ranges) {
+    size_t totalSize = 0;
+    if (fixedRowSize.has_value()) {
       for (const auto& range : ranges) {
         totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
       }
@@ -126,6 +137,20 @@ std::unique_ptr<VectorSerializer> CompactRowVectorSerde::createSerializer(
   return std::make_unique<CompactRowVectorSerializer>(streamArena);
 }
 
+void CompactRowVectorSerde::scatter(
+    const RowVectorPtr& vector,
+    const std::vector<folly::Range<const IndexRange*>>& ranges,
+    const std::vector<VectorSerializer*>& serializers) {
+  VELOX_CHECK_EQ(ranges.size(), serializers.size());
+  row::CompactRow row(vector);
+  const auto fixedRowSize =
+      row::CompactRow::fixedRowSize(asRowType(vector->type()));
+  for (auto i = 0; i < serializers.size(); ++i) {
+    static_cast<CompactRowVectorSerializer*>(serializers[i])
+        ->append(row, fixedRowSize, ranges[i]);
+  }
+}
+
 void CompactRowVectorSerde::deserialize(
     ByteStream* source,
     velox::memory::MemoryPool* pool,
@@ -37,6 +37,13 @@ class CompactRowVectorSerde : public VectorSerde {
       StreamArena* streamArena,
       const Options* options) override;
 
+  // Converts 'vector' to CompactRow once and copies the rows of each of
+  // 'ranges' from it into the matching serializer.
+  void scatter(
+      const RowVectorPtr& vector,
+      const std::vector<folly::Range<const IndexRange*>>& ranges,
+      const std::vector<VectorSerializer*>& serializers) override;
+
   // This method is used when reading data from the exchange.
   void deserialize(
       ByteStream* source,
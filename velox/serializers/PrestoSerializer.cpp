@@ -16,6 +16,7 @@
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
+#include "velox/common/compression/Codec.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/BiasVector.h"
@@ -29,6 +30,10 @@ namespace {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// The page is compressed with the ZSTD dictionary of the stream.
+constexpr int8_t kDictionaryBitMask = 8;
+// The frame holds the ZSTD dictionary of the stream instead of rows.
+constexpr int8_t kDictionaryFrameBitMask = 16;
 static inline const std::string_view kRLE{"RLE"};
 static inline const std::string_view kDictionary{"DICTIONARY"};
 
@@ -99,6 +104,14 @@ bool isChecksumBitSet(int8_t codec) {
   return (codec & kCheckSumBitMask) == kCheckSumBitMask;
 }
 
+bool isDictionaryBitSet(int8_t codec) {
+  return (codec & kDictionaryBitMask) == kDictionaryBitMask;
+}
+
+bool isDictionaryFrameBitSet(int8_t codec) {
+  return (codec & kDictionaryFrameBitMask) == kDictionaryFrameBitMask;
+}
+
 std::string_view typeToEncodingName(const TypePtr& type) {
   switch (type->kind()) {
     case TypeKind::BOOLEAN:
@@ -422,7 +435,8 @@ void readColumns(
     const std::vector<TypePtr>& types,
     std::vector<VectorPtr>& result,
     vector_size_t resultOffset,
-    bool useLosslessTimestamp);
+    bool useLosslessTimestamp,
+    const std::shared_ptr<void>& sourceHolder = nullptr);
 
 void readConstantVector(
     ByteStream* source,
@@ -966,13 +980,184 @@ void checkTypeEncoding(std::string_view encoding, const TypePtr& type) {
       encoding);
 }
 
+// Keeps the memory of a deserialized page alive while buffers point into it.
+class SourceReleaser {
+ public:
+  explicit SourceReleaser(std::shared_ptr<void> sourceHolder)
+      : sourceHolder_(std::move(sourceHolder)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<void> sourceHolder_;
+};
+
+// Returns the next 'numBytes' of 'source'. The result is a view on the memory
+// of 'source' owned by 'sourceHolder' if the bytes are contiguous and aligned
+// to 'alignment'. Otherwise they are copied into a buffer from 'pool'.
+BufferPtr readBuffer(
+    ByteStream* source,
+    int32_t numBytes,
+    int32_t alignment,
+    const std::shared_ptr<void>& sourceHolder,
+    velox::memory::MemoryPool* pool) {
+  const auto view = source->nextView(numBytes);
+  if (view.size() == numBytes &&
+      reinterpret_cast<uintptr_t>(view.data()) % alignment == 0) {
+    return BufferView<SourceReleaser>::create(
+        reinterpret_cast<const uint8_t*>(view.data()),
+        numBytes,
+        SourceReleaser(sourceHolder));
+  }
+  auto buffer = AlignedBuffer::allocate<char>(numBytes, pool);
+  auto* rawBuffer = buffer->asMutable<char>();
+  if (!view.empty()) {
+    memcpy(rawBuffer, view.data(), view.size());
+  }
+  source->readBytes(rawBuffer + view.size(), numBytes - view.size());
+  return buffer;
+}
+
+// Reads the null flags of 'size' rows into a new buffer. Returns nullptr if
+// there are no nulls.
+BufferPtr readNullBuffer(
+    ByteStream* source,
+    vector_size_t size,
+    velox::memory::MemoryPool* pool,
+    vector_size_t& nullCount) {
+  nullCount = 0;
+  if (source->readByte() == 0) {
+    return nullptr;
+  }
+  auto nulls = allocateNulls(size, pool);
+  auto* rawNulls = nulls->asMutable<uint8_t>();
+  const auto numBytes = BaseVector::byteSize<bool>(size);
+  source->readBytes(rawNulls, numBytes);
+  bits::reverseBits(rawNulls, numBytes);
+  bits::negate(reinterpret_cast<char*>(rawNulls), numBytes * 8);
+  nullCount = BaseVector::countNulls(nulls, 0, size);
+  return nulls;
+}
+
+template <typename T>
+void readZeroCopy(
+    ByteStream* source,
+    const TypePtr& type,
+    velox::memory::MemoryPool* pool,
+    VectorPtr& result,
+    const std::shared_ptr<void>& sourceHolder) {
+  const int32_t size = source->read<int32_t>();
+  vector_size_t nullCount;
+  auto nulls = readNullBuffer(source, size, pool, nullCount);
+
+  BufferPtr values;
+  if (nullCount > 0 || size == 0) {
+    // Nulls have no value on the wire. The values must be spread out.
+    values = AlignedBuffer::allocate<T>(size, pool);
+    readValues<T>(source, size, 0, nulls, nullCount, values);
+  } else {
+    values =
+        readBuffer(source, size * sizeof(T), alignof(T), sourceHolder, pool);
+  }
+  result = std::make_shared<FlatVector<T>>(
+      pool,
+      type,
+      std::move(nulls),
+      size,
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+template <>
+void readZeroCopy<StringView>(
+    ByteStream* source,
+    const TypePtr& type,
+    velox::memory::MemoryPool* pool,
+    VectorPtr& result,
+    const std::shared_ptr<void>& sourceHolder) {
+  const int32_t size = source->read<int32_t>();
+
+  auto values = AlignedBuffer::allocate<StringView>(size, pool);
+  auto* rawValues = values->asMutable<StringView>();
+  for (int32_t i = 0; i < size; ++i) {
+    // Set the first int32_t of each StringView to be the offset.
+    *reinterpret_cast<int32_t*>(&rawValues[i]) = source->read<int32_t>();
+  }
+  vector_size_t nullCount;
+  auto nulls = readNullBuffer(source, size, pool, nullCount);
+
+  std::vector<BufferPtr> stringBuffers;
+  const int32_t dataSize = source->read<int32_t>();
+  if (dataSize == 0) {
+    std::fill(rawValues, rawValues + size, StringView());
+  } else {
+    auto strings = readBuffer(source, dataSize, 1, sourceHolder, pool);
+    auto* rawChars = strings->as<char>();
+    int32_t previousOffset = 0;
+    for (int32_t i = 0; i < size; ++i) {
+      int32_t offset = rawValues[i].size();
+      rawValues[i] =
+          StringView(rawChars + previousOffset, offset - previousOffset);
+      previousOffset = offset;
+    }
+    stringBuffers.push_back(std::move(strings));
+  }
+  result = std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      std::move(nulls),
+      size,
+      std::move(values),
+      std::move(stringBuffers));
+}
+
+// Reads a flat column of 'type' into a new vector whose value and string
+// buffers point into the memory of 'source' when possible. Returns false
+// without reading if 'type' needs converting on read.
+bool tryReadZeroCopy(
+    ByteStream* source,
+    const TypePtr& type,
+    velox::memory::MemoryPool* pool,
+    VectorPtr& result,
+    const std::shared_ptr<void>& sourceHolder) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+      readZeroCopy<int8_t>(source, type, pool, result, sourceHolder);
+      return true;
+    case TypeKind::SMALLINT:
+      readZeroCopy<int16_t>(source, type, pool, result, sourceHolder);
+      return true;
+    case TypeKind::INTEGER:
+      readZeroCopy<int32_t>(source, type, pool, result, sourceHolder);
+      return true;
+    case TypeKind::BIGINT:
+      readZeroCopy<int64_t>(source, type, pool, result, sourceHolder);
+      return true;
+    case TypeKind::REAL:
+      readZeroCopy<float>(source, type, pool, result, sourceHolder);
+      return true;
+    case TypeKind::DOUBLE:
+      readZeroCopy<double>(source, type, pool, result, sourceHolder);
+      return true;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      readZeroCopy<StringView>(source, type, pool, result, sourceHolder);
+      return true;
+    default:
+      return false;
+  }
+}
+
 void readColumns(
     ByteStream* source,
     velox::memory::MemoryPool* pool,
     const std::vector<TypePtr>& types,
     std::vector<VectorPtr>& results,
     vector_size_t resultOffset,
-    bool useLosslessTimestamp) {
+    bool useLosslessTimestamp,
+    const std::shared_ptr<void>& sourceHolder) {
   static const std::unordered_map<
       TypeKind,
       std::function<void(
@@ -1024,6 +1209,11 @@ void readColumns(
           useLosslessTimestamp);
     } else {
       checkTypeEncoding(encoding, columnType);
+      if (sourceHolder != nullptr && resultOffset == 0 &&
+          tryReadZeroCopy(
+              source, columnType, pool, columnResult, sourceHolder)) {
+        continue;
+      }
       const auto it = readers.find(columnType->kind());
       VELOX_CHECK(
           it != readers.end(),
@@ -1710,6 +1900,41 @@ void serializeColumn(
   }
 }
 
+template <TypeKind kind>
+void scatterFlatVector(
+    const BaseVector* vector,
+    const std::vector<folly::Range<const IndexRange*>>& ranges,
+    const std::vector<VectorStream*>& streams) {
+  for (auto i = 0; i < streams.size(); ++i) {
+    if (!ranges[i].empty()) {
+      serializeFlatVector<kind>(vector, ranges[i], streams[i]);
+    }
+  }
+}
+
+// Serializes 'vector' rows in 'ranges[i]' into 'streams[i]'. Loads and
+// dispatches on the type of 'vector' once for all the streams.
+void scatterColumn(
+    const BaseVector* vector,
+    const std::vector<folly::Range<const IndexRange*>>& ranges,
+    const std::vector<VectorStream*>& streams) {
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH_ALL(
+          scatterFlatVector, vector->typeKind(), vector, ranges, streams);
+      break;
+    case VectorEncoding::Simple::LAZY:
+      scatterColumn(vector->loadedVector(), ranges, streams);
+      break;
+    default:
+      for (auto i = 0; i < streams.size(); ++i) {
+        if (!ranges[i].empty()) {
+          serializeColumn(vector, ranges[i], streams[i]);
+        }
+      }
+  }
+}
+
 template <TypeKind Kind>
 void serializeConstantColumn(
     const BaseVector* vector,
@@ -2043,9 +2268,19 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       bool useLosslessTimestamp,
-      common::CompressionKind compressionKind)
+      common::CompressionKind compressionKind,
+      bool preserveEncodings,
+      std::shared_ptr<PrestoCompressionDictionary> compressionDictionary)
       : streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(compressionKind)) {
+        codec_(common::compressionKindToCodec(compressionKind)),
+        useLosslessTimestamp_(useLosslessTimestamp),
+        preserveEncodings_(preserveEncodings && encodings.empty()),
+        compressionDictionary_(std::move(compressionDictionary)) {
+    VELOX_CHECK(
+        compressionDictionary_ == nullptr ||
+            compressionKind == common::CompressionKind_ZSTD,
+        "Compression dictionary requires ZSTD compression: {}",
+        common::compressionKindToString(compressionKind));
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -2063,14 +2298,48 @@ class PrestoVectorSerializer : public VectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) override {
     auto newRows = rangesTotalSize(ranges);
-    if (newRows > 0) {
-      numRows_ += newRows;
-      for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+    if (newRows == 0) {
+      return;
+    }
+    if (preserveEncodings_ && numRows_ == 0) {
+      chooseEncodings(vector, newRows);
+    }
+    numRows_ += newRows;
+    for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+      if (!encodedColumns_.empty() && encodedColumns_[i].has_value()) {
+        appendEncodedColumn(i, vector->childAt(i), ranges, newRows);
+      } else {
         serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
       }
     }
   }
 
+  // Appends the rows of 'vector' in 'ranges[i]' to 'serializers[i]' column by
+  // column.
+  static void scatter(
+      const RowVectorPtr& vector,
+      const std::vector<folly::Range<const IndexRange*>>& ranges,
+      const std::vector<PrestoVectorSerializer*>& serializers) {
+    for (auto* serializer : serializers) {
+      if (serializer->preserveEncodings_) {
+        for (auto i = 0; i < serializers.size(); ++i) {
+          serializers[i]->append(vector, ranges[i]);
+        }
+        return;
+      }
+    }
+    for (auto i = 0; i < serializers.size(); ++i) {
+      serializers[i]->numRows_ += rangesTotalSize(ranges[i]);
+    }
+    std::vector<VectorStream*> streams(serializers.size());
+    for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+      for (auto j = 0; j < serializers.size(); ++j) {
+        streams[j] = serializers[j]->streams_[i].get();
+      }
+      scatterColumn(vector->childAt(i).get(), ranges, streams);
+    }
+  }
+
   void appendEncoded(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) {
@@ -2093,6 +2362,11 @@ class PrestoVectorSerializer : public VectorSerializer {
     auto compressedSize = needCompression(*codec_)
         ? codec_->maxCompressedLength(dataSize)
         : dataSize;
+    if (compressionDictionary_ != nullptr &&
+        compressionDictionary_->needsSend()) {
+      compressedSize +=
+          kHeaderSize + compressionDictionary_->dictionary()->data().size();
+    }
     return kHeaderSize + compressedSize;
   }
 
@@ -2172,10 +2446,16 @@ class PrestoVectorSerializer : public VectorSerializer {
       OutputStream* output,
       PrestoOutputStreamListener* listener) {
     const int32_t offset = output->tellp();
+    const auto* dictionary = compressionDictionary_ != nullptr
+        ? compressionDictionary_->dictionary()
+        : nullptr;
     char codec = kCompressedBitMask;
     if (listener) {
       codec |= kCheckSumBitMask;
     }
+    if (dictionary != nullptr) {
+      codec |= kDictionaryBitMask;
+    }
 
     // Pause CRC computation
     if (listener) {
@@ -2198,7 +2478,16 @@ class PrestoVectorSerializer : public VectorSerializer {
         uncompressedSize,
         codec_->maxUncompressedLength(),
         "UncompressedSize exceeds limit");
-    auto compressed = codec_->compress(out.getIOBuf().get());
+    auto uncompressed = out.getIOBuf();
+    std::unique_ptr<folly::IOBuf> compressed;
+    if (dictionary != nullptr) {
+      compressed = compressWithDictionary(*dictionary, *uncompressed);
+    } else {
+      compressed = codec_->compress(uncompressed.get());
+      if (compressionDictionary_ != nullptr) {
+        compressionDictionary_->addSample(*uncompressed);
+      }
+    }
     const int32_t compressedSize = compressed->length();
     writeInt32(output, uncompressedSize);
     writeInt32(output, compressedSize);
@@ -2226,8 +2515,167 @@ class PrestoVectorSerializer : public VectorSerializer {
     output->seekp(endSize);
   }
 
+  static std::unique_ptr<folly::IOBuf> compressWithDictionary(
+      const common::ZstdDictionary& dictionary,
+      folly::IOBuf& uncompressed) {
+    const auto data = uncompressed.coalesce();
+    const auto maxSize =
+        common::ZstdDictionary::maxCompressedLength(data.size());
+    auto compressed = folly::IOBuf::create(maxSize);
+    compressed->append(dictionary.compress(
+        reinterpret_cast<const char*>(data.data()),
+        data.size(),
+        reinterpret_cast<char*>(compressed->writableData()),
+        maxSize));
+    return compressed;
+  }
+
+  // Writes the dictionary of 'compressionDictionary_' as a frame with the
+  // page header and no rows. The frame precedes the first page compressed
+  // with the dictionary.
+  void flushDictionaryFrame(OutputStream* out) {
+    const auto& data = compressionDictionary_->dictionary()->data();
+    writeInt32(out, 0);
+    const char codec = kDictionaryFrameBitMask;
+    out->write(&codec, 1);
+    writeInt32(out, data.size());
+    writeInt32(out, data.size());
+    writeInt64(out, 0);
+    out->write(data.data(), data.size());
+    compressionDictionary_->setSent();
+  }
+
+  // A column serialized as a DICTIONARY or RLE block. 'base' is the
+  // dictionary values or the constant vector. 'indices' are the dictionary
+  // indices appended so far. They are kept to rewrite the column as a flat
+  // block if a later append does not fit the encoding.
+  struct EncodedColumn {
+    VectorEncoding::Simple encoding;
+    VectorPtr base;
+    std::vector<vector_size_t> indices;
+    vector_size_t numRows{0};
+  };
+
+  // Minimum number of rows per distinct dictionary value for a dictionary
+  // column to be serialized as a DICTIONARY block. The whole dictionary is
+  // serialized, so a lower reuse makes the block larger than a flat one.
+  static constexpr int32_t kMinDictionaryReuse = 2;
+
+  // Decides on the first append which columns keep their encoding.
+  // Constant columns are serialized as RLE blocks and dictionary columns
+  // without nulls added by the dictionary whose values are referenced at
+  // least 'kMinDictionaryReuse' times on average as DICTIONARY blocks.
+  void chooseEncodings(const RowVectorPtr& vector, vector_size_t numRows) {
+    encodedColumns_.resize(vector->childrenSize());
+    for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+      const auto& column = vector->childAt(i);
+      std::optional<VectorEncoding::Simple> encoding;
+      if (column->encoding() == VectorEncoding::Simple::CONSTANT) {
+        encoding = VectorEncoding::Simple::CONSTANT;
+      } else if (
+          column->encoding() == VectorEncoding::Simple::DICTIONARY &&
+          column->nulls() == nullptr &&
+          numRows >= kMinDictionaryReuse * column->valueVector()->size()) {
+        encoding = VectorEncoding::Simple::DICTIONARY;
+      }
+      if (!encoding.has_value()) {
+        continue;
+      }
+      streams_[i] = std::make_unique<VectorStream>(
+          column->type(),
+          encoding,
+          streamArena_,
+          numRows,
+          useLosslessTimestamp_);
+      encodedColumns_[i] = EncodedColumn{encoding.value()};
+    }
+  }
+
+  // Appends 'ranges' of 'column' to the DICTIONARY or RLE block of column
+  // 'i'. Rewrites the block as a flat block if 'column' has a different
+  // dictionary or constant value than the previous appends.
+  void appendEncodedColumn(
+      int32_t i,
+      const VectorPtr& column,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t numRows) {
+    auto& encoded = encodedColumns_[i].value();
+    auto* stream = streams_[i].get();
+    if (encoded.encoding == VectorEncoding::Simple::CONSTANT) {
+      if (encoded.numRows == 0) {
+        serializeEncodedColumn(column.get(), ranges, stream);
+        encoded.base = column;
+        encoded.numRows = numRows;
+        return;
+      }
+      if (column->encoding() == VectorEncoding::Simple::CONSTANT &&
+          column->equalValueAt(encoded.base.get(), 0, 0)) {
+        stream->appendNonNull(numRows);
+        encoded.numRows += numRows;
+        return;
+      }
+    } else if (
+        column->encoding() == VectorEncoding::Simple::DICTIONARY &&
+        column->nulls() == nullptr &&
+        (encoded.numRows == 0 || column->valueVector() == encoded.base)) {
+      const auto indices = column->wrapInfo();
+      auto* rawIndices = indices->as<vector_size_t>();
+      if (encoded.numRows == 0) {
+        serializeEncodedColumn(column.get(), ranges, stream);
+        encoded.base = column->valueVector();
+      } else {
+        for (const auto& range : ranges) {
+          stream->appendNonNull(range.size);
+          stream->append<int32_t>(
+              folly::Range(&rawIndices[range.begin], range.size));
+        }
+      }
+      for (const auto& range : ranges) {
+        encoded.indices.insert(
+            encoded.indices.end(),
+            rawIndices + range.begin,
+            rawIndices + range.begin + range.size);
+      }
+      encoded.numRows += numRows;
+      return;
+    }
+    flattenEncodedColumn(i);
+    serializeColumn(column.get(), ranges, streams_[i].get());
+  }
+
+  // Rewrites the DICTIONARY or RLE block of column 'i' as a flat block.
+  void flattenEncodedColumn(int32_t i) {
+    auto& encoded = encodedColumns_[i].value();
+    auto flatStream = std::make_unique<VectorStream>(
+        encoded.base->type(),
+        std::nullopt,
+        streamArena_,
+        numRows_,
+        useLosslessTimestamp_);
+    if (encoded.encoding == VectorEncoding::Simple::CONSTANT) {
+      const IndexRange allRows{0, encoded.numRows};
+      serializeColumn(
+          BaseVector::wrapInConstant(encoded.numRows, 0, encoded.base).get(),
+          folly::Range(&allRows, 1),
+          flatStream.get());
+    } else {
+      std::vector<IndexRange> ranges;
+      ranges.reserve(encoded.indices.size());
+      for (auto index : encoded.indices) {
+        ranges.push_back({index, 1});
+      }
+      serializeColumn(encoded.base.get(), ranges, flatStream.get());
+    }
+    streams_[i] = std::move(flatStream);
+    encodedColumns_[i].reset();
+  }
+
   // Writes the contents to 'stream' in wire format
   void flushInternal(int32_t numRows, OutputStream* out) {
+    if (compressionDictionary_ != nullptr &&
+        compressionDictionary_->needsSend()) {
+      flushDictionaryFrame(out);
+    }
     auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
     // Reset CRC computation
     if (listener) {
@@ -2246,11 +2694,44 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const bool useLosslessTimestamp_;
+  const bool preserveEncodings_;
+  // Set if the pages of the stream are compressed with a shared ZSTD
+  // dictionary.
+  const std::shared_ptr<PrestoCompressionDictionary> compressionDictionary_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+  // Columns serialized as DICTIONARY or RLE blocks. Empty unless
+  // 'preserveEncodings_' is set.
+  std::vector<std::optional<EncodedColumn>> encodedColumns_;
 };
 } // namespace
 
+void PrestoCompressionDictionary::addSample(const folly::IOBuf& page) {
+  if (dictionary_ != nullptr || trainingFailed_) {
+    return;
+  }
+  size_t size = 0;
+  for (const auto& range : page) {
+    samples_.append(reinterpret_cast<const char*>(range.data()), range.size());
+    size += range.size();
+  }
+  sampleSizes_.push_back(size);
+  if (samples_.size() < kTrainingBytes) {
+    return;
+  }
+  dictionary_ = common::ZstdDictionary::train(
+      samples_, sampleSizes_, kMaxDictionarySize);
+  trainingFailed_ = dictionary_ == nullptr;
+  samples_.clear();
+  samples_.shrink_to_fit();
+  sampleSizes_.clear();
+}
+
+void PrestoCompressionDictionary::setDictionary(std::string data) {
+  dictionary_ = std::make_unique<common::ZstdDictionary>(std::move(data));
+}
+
 void PrestoVectorSerde::estimateSerializedSize(
     VectorPtr vector,
     const folly::Range<const IndexRange*>& ranges,
@@ -2270,7 +2751,23 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
       numRows,
       streamArena,
       prestoOptions.useLosslessTimestamp,
-      prestoOptions.compressionKind);
+      prestoOptions.compressionKind,
+      prestoOptions.preserveEncodings,
+      prestoOptions.compressionDictionary);
+}
+
+void PrestoVectorSerde::scatter(
+    const RowVectorPtr& vector,
+    const std::vector<folly::Range<const IndexRange*>>& ranges,
+    const std::vector<VectorSerializer*>& serializers) {
+  VELOX_CHECK_EQ(ranges.size(), serializers.size());
+  std::vector<PrestoVectorSerializer*> prestoSerializers;
+  prestoSerializers.reserve(serializers.size());
+  for (auto* serializer : serializers) {
+    prestoSerializers.push_back(
+        static_cast<PrestoVectorSerializer*>(serializer));
+  }
+  PrestoVectorSerializer::scatter(vector, ranges, prestoSerializers);
 }
 
 void PrestoVectorSerde::serializeEncoded(
@@ -2285,13 +2782,15 @@ void PrestoVectorSerde::serializeEncoded(
       ->flushEncoded(vector, out);
 }
 
-void PrestoVectorSerde::deserialize(
+namespace {
+void deserializePage(
     ByteStream* source,
     velox::memory::MemoryPool* pool,
     RowTypePtr type,
     RowVectorPtr* result,
     vector_size_t resultOffset,
-    const Options* options) {
+    const VectorSerde::Options* options,
+    const std::shared_ptr<void>& sourceHolder) {
   const auto prestoOptions = toPrestoOptions(options);
   const bool useLosslessTimestamp = prestoOptions.useLosslessTimestamp;
   const auto codec =
@@ -2319,6 +2818,21 @@ void PrestoVectorSerde::deserialize(
   const auto compressedSize = source->read<int32_t>();
   const auto checksum = source->read<int64_t>();
 
+  if (isDictionaryFrameBitSet(pageCodecMarker)) {
+    VELOX_CHECK_EQ(numRows, 0);
+    VELOX_CHECK_NOT_NULL(
+        prestoOptions.compressionDictionary,
+        "Received a ZSTD dictionary without compression dictionary option");
+    std::string data(compressedSize, '\0');
+    source->readBytes(data.data(), compressedSize);
+    prestoOptions.compressionDictionary->setDictionary(std::move(data));
+    // The frame is followed by the first page compressed with the dictionary.
+    VELOX_CHECK(!source->atEnd(), "ZSTD dictionary frame without a page");
+    deserializePage(
+        source, pool, type, result, resultOffset, options, sourceHolder);
+    return;
+  }
+
   int64_t actualCheckSum = 0;
   if (isChecksumBitSet(pageCodecMarker)) {
     actualCheckSum =
@@ -2341,12 +2855,53 @@ void PrestoVectorSerde::deserialize(
     const auto numColumns = source->read<int32_t>();
     VELOX_CHECK_EQ(numColumns, type->size());
     readColumns(
-        source, pool, childTypes, children, resultOffset, useLosslessTimestamp);
+        source,
+        pool,
+        childTypes,
+        children,
+        resultOffset,
+        useLosslessTimestamp,
+        sourceHolder);
   } else {
     auto compressBuf = folly::IOBuf::create(compressedSize);
     source->readBytes(compressBuf->writableData(), compressedSize);
     compressBuf->append(compressedSize);
-    auto uncompress = codec->uncompress(compressBuf.get(), uncompressedSize);
+    std::unique_ptr<folly::IOBuf> uncompress;
+    if (isDictionaryBitSet(pageCodecMarker)) {
+      const auto* dictionary = prestoOptions.compressionDictionary != nullptr
+          ? prestoOptions.compressionDictionary->dictionary()
+          : nullptr;
+      VELOX_CHECK_NOT_NULL(
+          dictionary, "Received a page compressed with unknown dictionary");
+      const auto* compressedData =
+          reinterpret_cast<const char*>(compressBuf->data());
+      VELOX_CHECK_EQ(
+          common::ZstdDictionary::frameDictionaryId(
+              compressedData, compressedSize),
+          dictionary->id());
+      uncompress = folly::IOBuf::create(uncompressedSize);
+      dictionary->decompress(
+          compressedData,
+          compressedSize,
+          reinterpret_cast<char*>(uncompress->writableData()),
+          uncompressedSize);
+      uncompress->append(uncompressedSize);
+    } else if (
+        auto* blockCodec =
+            common::threadLocalCodec(prestoOptions.compressionKind)) {
+      // Decompresses straight into the result with the thread's codec state.
+      uncompress = folly::IOBuf::create(uncompressedSize);
+      VELOX_CHECK_EQ(
+          uncompressedSize,
+          blockCodec->decompress(
+              reinterpret_cast<const char*>(compressBuf->data()),
+              compressedSize,
+              reinterpret_cast<char*>(uncompress->writableData()),
+              uncompressedSize));
+      uncompress->append(uncompressedSize);
+    } else {
+      uncompress = codec->uncompress(compressBuf.get(), uncompressedSize);
+    }
     ByteRange byteRange{
         uncompress->writableData(), (int32_t)uncompress->length(), 0};
     ByteStream uncompressedSource;
@@ -2366,6 +2921,31 @@ void PrestoVectorSerde::deserialize(
   scatterStructNulls(
       (*result)->size(), 0, nullptr, nullptr, **result, resultOffset);
 }
+} // namespace
+
+void PrestoVectorSerde::deserialize(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    vector_size_t resultOffset,
+    const Options* options) {
+  deserializePage(source, pool, type, result, resultOffset, options, nullptr);
+}
+
+void PrestoVectorSerde::deserializeZeroCopy(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    std::shared_ptr<void> sourceHolder,
+    const Options* options) {
+  VELOX_CHECK_NOT_NULL(sourceHolder);
+  // The columns are replaced by vectors over the page, so 'result' is not
+  // reused.
+  *result = nullptr;
+  deserializePage(source, pool, type, result, 0, options, sourceHolder);
+}
 
 void testingScatterStructNulls(
     vector_size_t size,
@@ -17,10 +17,64 @@
 
 #include "velox/common/base/Crc.h"
 #include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionary.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::serializer::presto {
 
+/// State of ZSTD dictionary compression for the pages of one stream, e.g. one
+/// destination of a PartitionedOutput on the sending side or one exchange
+/// source on the receiving side. It is shared by the serializers of the
+/// successive pages of the stream through PrestoOptions.
+///
+/// The sender compresses the first pages without a dictionary and keeps
+/// their uncompressed contents as training samples until 'kTrainingBytes'
+/// are collected. The trained dictionary is then written once as a
+/// dictionary frame ahead of the next page and the later pages are
+/// compressed against it. The receiver keeps the dictionary from the frame
+/// for decompressing the later pages.
+///
+/// NOTE: this class is not thread-safe.
+class PrestoCompressionDictionary {
+ public:
+  static constexpr int64_t kTrainingBytes = 1 << 20;
+  static constexpr size_t kMaxDictionarySize = 64 << 10;
+
+  /// Returns the dictionary to compress or decompress pages with or nullptr
+  /// if not trained or received yet.
+  const common::ZstdDictionary* dictionary() const {
+    return dictionary_.get();
+  }
+
+  /// Returns true if the dictionary is trained but not yet written to the
+  /// stream.
+  bool needsSend() const {
+    return dictionary_ != nullptr && !sent_;
+  }
+
+  void setSent() {
+    sent_ = true;
+  }
+
+  /// Adds the uncompressed contents of a page compressed without a
+  /// dictionary as a training sample. Trains the dictionary once enough
+  /// samples are collected.
+  void addSample(const folly::IOBuf& page);
+
+  /// Sets the dictionary received from the sender.
+  void setDictionary(std::string data);
+
+ private:
+  std::unique_ptr<common::ZstdDictionary> dictionary_;
+  bool sent_{false};
+  // Set if the training failed, in which case the pages are compressed
+  // without a dictionary.
+  bool trainingFailed_{false};
+  // The training samples back to back.
+  std::string samples_;
+  std::vector<size_t> sampleSizes_;
+};
+
 class PrestoVectorSerde : public VectorSerde {
  public:
   // Input options that the serializer recognizes.
@@ -41,6 +95,14 @@ class PrestoVectorSerde : public VectorSerde {
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
     std::vector<VectorEncoding::Simple> encodings;
+    // Serializes constant columns as RLE blocks and dictionary columns with
+    // enough reuse of the dictionary values as DICTIONARY blocks instead of
+    // flattening them. Ignored if 'encodings' is set.
+    bool preserveEncodings{false};
+    // If set, the pages are compressed with a ZSTD dictionary trained on the
+    // first pages of the stream. Requires ZSTD 'compressionKind'. The same
+    // instance must be used for all the pages of one stream.
+    std::shared_ptr<PrestoCompressionDictionary> compressionDictionary;
   };
 
   void estimateSerializedSize(
@@ -54,6 +116,14 @@ class PrestoVectorSerde : public VectorSerde {
       StreamArena* streamArena,
       const Options* options) override;
 
+  /// Serializes each column of 'vector' once for all of 'serializers'. Lazy
+  /// columns are loaded and flat columns dispatched on their type once per
+  /// call instead of once per serializer.
+  void scatter(
+      const RowVectorPtr& vector,
+      const std::vector<folly::Range<const IndexRange*>>& ranges,
+      const std::vector<VectorSerializer*>& serializers) override;
+
   /// Serializes a flat RowVector with possibly encoded children. Preserves
   /// first level of encodings. Dictionary vectors must not have nulls added by
   /// the dictionary.
@@ -86,6 +156,21 @@ class PrestoVectorSerde : public VectorSerde {
       vector_size_t resultOffset,
       const Options* options) override;
 
+  bool supportsZeroCopyDeserialize() const override {
+    return true;
+  }
+
+  /// Reads uncompressed top level fixed-width and string columns into
+  /// vectors whose value and string buffers point into 'source'. Columns of
+  /// other types, nested columns and compressed pages are copied.
+  void deserializeZeroCopy(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      std::shared_ptr<void> sourceHolder,
+      const Options* options) override;
+
   static void registerVectorSerde();
 };
 
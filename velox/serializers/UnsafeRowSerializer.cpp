@@ -38,42 +38,48 @@ class UnsafeRowVectorSerializer : public VectorSerializer {
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) override {
-    size_t totalSize = 0;
+    rows_.clear();
+    for (const auto& range : ranges) {
+      for (auto i = range.begin; i < range.begin + range.size; ++i) {
+        rows_.push_back(i);
+      }
+    }
+    if (rows_.empty()) {
+      return;
+    }
+
+    // Compute the sizes of all rows column by column, then write all rows
+    // column by column into their offsets in one buffer.
     row::UnsafeRowFast unsafeRow(vector);
+    rowSizes_.resize(rows_.size());
     if (auto fixedRowSize =
             row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
-
+      std::fill(rowSizes_.begin(), rowSizes_.end(), fixedRowSize.value());
     } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += unsafeRow.rowSize(i) + sizeof(TRowSize);
-        }
-      }
+      unsafeRow.rowSizes(
+          folly::Range(rows_.data(), rows_.size()), rowSizes_.data());
     }
 
-    if (totalSize == 0) {
-      return;
+    size_t totalSize = 0;
+    for (auto size : rowSizes_) {
+      totalSize += size + sizeof(TRowSize);
     }
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    rowBuffers_.resize(rows_.size());
     size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size =
-            unsafeRow.serialize(i, rawBuffer + offset + sizeof(TRowSize));
-
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    for (auto i = 0; i < rows_.size(); ++i) {
+      // Write raw size. Needs to be in big endian order.
+      *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(
+          static_cast<TRowSize>(rowSizes_[i]));
+      rowBuffers_[i] = rawBuffer + offset + sizeof(TRowSize);
+      offset += sizeof(TRowSize) + rowSizes_[i];
     }
+    unsafeRow.serialize(
+        folly::Range(rows_.data(), rows_.size()), rowBuffers_.data());
   }
 
   size_t maxSerializedSize() const override {
@@ -94,6 +100,10 @@ class UnsafeRowVectorSerializer : public VectorSerializer {
  private:
   memory::MemoryPool* const FOLLY_NONNULL pool_;
   std::vector<BufferPtr> buffers_;
+  // Reused across append() calls.
+  std::vector<vector_size_t> rows_;
+  std::vector<int32_t> rowSizes_;
+  std::vector<char*> rowBuffers_;
 };
 
 // Read from the stream until the full row is concatenated.
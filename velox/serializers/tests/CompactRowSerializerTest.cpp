@@ -135,5 +135,63 @@ TEST_F(CompactRowSerializerTest, fuzz) {
   testRoundTrip(data);
 }
 
+TEST_F(CompactRowSerializerTest, scatter) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeNullableFlatVector<std::string>(
+          {"a", std::nullopt, "a longer string than inline", "b"}),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row % 3; },
+          [](auto row) { return row; }),
+  });
+  data = makeRowVector({
+      data->childAt(0),
+      BaseVector::wrapInDictionary(
+          nullptr,
+          makeIndices(100, [](auto row) { return row % 4; }),
+          100,
+          data->childAt(1)),
+      data->childAt(2),
+  });
+
+  constexpr int32_t kNumSerializers = 3;
+  std::vector<std::vector<IndexRange>> rows(kNumSerializers);
+  for (vector_size_t row = 0; row < data->size(); ++row) {
+    rows[row % kNumSerializers].push_back({row, 1});
+  }
+  std::vector<folly::Range<const IndexRange*>> ranges;
+  for (const auto& serializerRows : rows) {
+    ranges.emplace_back(serializerRows.data(), serializerRows.size());
+  }
+
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto rowType = asRowType(data->type());
+  std::vector<std::unique_ptr<VectorSerializer>> serializers;
+  std::vector<VectorSerializer*> rawSerializers;
+  for (auto i = 0; i < kNumSerializers; ++i) {
+    serializers.push_back(
+        serde_->createSerializer(rowType, data->size(), arena.get()));
+    rawSerializers.push_back(serializers.back().get());
+  }
+  serde_->scatter(data, ranges, rawSerializers);
+
+  for (auto i = 0; i < kNumSerializers; ++i) {
+    std::ostringstream out;
+    OStreamOutputStream stream(&out);
+    serializers[i]->flush(&stream);
+
+    auto deserialized = deserialize(rowType, out.str());
+    auto expected = BaseVector::wrapInDictionary(
+        nullptr,
+        makeIndices(
+            rows[i].size(),
+            [&](auto row) { return row * kNumSerializers + i; }),
+        rows[i].size(),
+        data);
+    test::assertEqualVectors(expected, deserialized);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::serializer
@@ -17,6 +17,7 @@
 #include <folly/Random.h>
 #include <gtest/gtest.h>
 #include <vector>
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -548,6 +549,255 @@ TEST_P(PrestoSerializerTest, roundTrip) {
   }
 }
 
+TEST_P(PrestoSerializerTest, scatter) {
+  VectorFuzzer::Options opts;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMilliSeconds;
+  opts.nullRatio = 0.1;
+  VectorFuzzer fuzzer(opts, pool_.get());
+
+  constexpr int32_t kNumSerializers = 5;
+  const auto paramOptions = getParamSerdeOptions(nullptr);
+  for (auto i = 0; i < 10; ++i) {
+    auto rowType = fuzzer.randRowType();
+    auto rowVector = fuzzer.fuzzInputRow(rowType);
+
+    // Assign rows round robin, leaving the last serializer empty.
+    std::vector<std::vector<IndexRange>> rows(kNumSerializers);
+    for (vector_size_t row = 0; row < rowVector->size(); ++row) {
+      rows[row % (kNumSerializers - 1)].push_back({row, 1});
+    }
+    std::vector<folly::Range<const IndexRange*>> ranges;
+    for (const auto& serializerRows : rows) {
+      ranges.emplace_back(serializerRows.data(), serializerRows.size());
+    }
+
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    std::vector<std::unique_ptr<VectorSerializer>> expected;
+    std::vector<std::unique_ptr<VectorSerializer>> actual;
+    std::vector<VectorSerializer*> scattered;
+    for (auto j = 0; j < kNumSerializers; ++j) {
+      expected.push_back(serde_->createSerializer(
+          rowType, rowVector->size(), arena.get(), &paramOptions));
+      expected.back()->append(rowVector, ranges[j]);
+      actual.push_back(serde_->createSerializer(
+          rowType, rowVector->size(), arena.get(), &paramOptions));
+      scattered.push_back(actual.back().get());
+    }
+    serde_->scatter(rowVector, ranges, scattered);
+
+    for (auto j = 0; j < kNumSerializers; ++j) {
+      std::ostringstream expectedOut;
+      OStreamOutputStream expectedStream(&expectedOut);
+      expected[j]->flush(&expectedStream);
+      std::ostringstream actualOut;
+      OStreamOutputStream actualStream(&actualOut);
+      actual[j]->flush(&actualStream);
+      ASSERT_EQ(expectedOut.str(), actualOut.str());
+    }
+  }
+}
+
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  constexpr vector_size_t kSize = 1'000;
+  auto makeData = [&](const VectorPtr& dictionaryValues) {
+    return makeRowVector({
+        makeConstant<int64_t>(7, kSize),
+        BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndices(kSize, [](auto row) { return row % 3; }),
+            kSize,
+            dictionaryValues),
+        makeFlatVector<int32_t>(kSize, [](auto row) { return row; }),
+        // Too little reuse of the dictionary values to keep the encoding.
+        BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndicesInReverse(kSize),
+            kSize,
+            makeFlatVector<int32_t>(kSize, [](auto row) { return row; })),
+    });
+  };
+  auto dictionaryValues = makeFlatVector<std::string>(
+      {"a long string value", "another long string value", "a third one"});
+  auto data = makeData(dictionaryValues);
+
+  auto options = getParamSerdeOptions(nullptr);
+  options.preserveEncodings = true;
+  auto rowType = asRowType(data->type());
+  auto serializeAndRead = [&](const std::vector<RowVectorPtr>& batches,
+                              const VectorSerde::Options* serdeOptions) {
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer =
+        serde_->createSerializer(rowType, kSize, arena.get(), serdeOptions);
+    for (const auto& batch : batches) {
+      serializer->append(batch);
+    }
+    std::ostringstream out;
+    OStreamOutputStream stream(&out);
+    serializer->flush(&stream);
+
+    auto byteStream = toByteStream(out.str());
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, serdeOptions);
+    return std::make_pair(result, out.str().size());
+  };
+
+  auto [result, encodedSize] = serializeAndRead({data, data}, &options);
+  auto expected = BaseVector::create<RowVector>(rowType, 0, pool());
+  expected->append(data.get());
+  expected->append(data.get());
+  assertEqualVectors(expected, result);
+  ASSERT_EQ(
+      result->childAt(0)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(
+      result->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(result->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(result->childAt(3)->encoding(), VectorEncoding::Simple::FLAT);
+
+  auto flatOptions = getParamSerdeOptions(nullptr);
+  auto [flatResult, flatSize] = serializeAndRead({data, data}, &flatOptions);
+  assertEqualVectors(expected, flatResult);
+  if (options.compressionKind == common::CompressionKind_NONE) {
+    ASSERT_LT(encodedSize, flatSize);
+  }
+
+  // A batch with another dictionary and constant value turns the blocks
+  // flat.
+  auto otherData = makeData(makeFlatVector<std::string>({"x", "y", "z"}));
+  otherData->childAt(0) = makeConstant<int64_t>(8, kSize);
+  std::tie(result, encodedSize) =
+      serializeAndRead({data, otherData}, &options);
+  expected = BaseVector::create<RowVector>(rowType, 0, pool());
+  expected->append(data.get());
+  expected->append(otherData.get());
+  assertEqualVectors(expected, result);
+  ASSERT_EQ(result->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(result->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
+TEST_P(PrestoSerializerTest, zeroCopyDeserialize) {
+  auto data = makeRowVector({
+      makeFlatVector<int8_t>({1, 2, 3}),
+      makeNullableFlatVector<int32_t>({1, std::nullopt, 3}),
+      makeFlatVector<std::string>(
+          {"a string longer than inline",
+           "another string longer than inline",
+           "short"}),
+      makeArrayVector<int32_t>({{1, 2}, {3}, {}}),
+  });
+
+  std::ostringstream out;
+  serialize(data, &out, nullptr);
+  auto page = std::make_shared<std::string>(out.str());
+  auto byteStream = toByteStream(*page);
+
+  auto paramOptions = getParamSerdeOptions(nullptr);
+  RowVectorPtr result;
+  serde_->deserializeZeroCopy(
+      byteStream.get(),
+      pool_.get(),
+      asRowType(data->type()),
+      &result,
+      page,
+      &paramOptions);
+  assertEqualVectors(data, result);
+
+  if (paramOptions.compressionKind != common::CompressionKind_NONE) {
+    ASSERT_EQ(page.use_count(), 1);
+    return;
+  }
+  // Wider fixed-width values are copied unless they happen to be aligned in
+  // the page.
+  ASSERT_TRUE(result->childAt(0)->asFlatVector<int8_t>()->values()->isView());
+  // Values of nullable rows are spread out, hence copied.
+  ASSERT_FALSE(result->childAt(1)->asFlatVector<int32_t>()->values()->isView());
+  auto* strings = result->childAt(2)->asFlatVector<StringView>();
+  ASSERT_EQ(strings->stringBuffers().size(), 1);
+  ASSERT_TRUE(strings->stringBuffers()[0]->isView());
+  ASSERT_GT(page.use_count(), 1);
+
+  result.reset();
+  ASSERT_EQ(page.use_count(), 1);
+}
+
+TEST_P(PrestoSerializerTest, compressionDictionary) {
+  if (GetParam() != common::CompressionKind_ZSTD) {
+    return;
+  }
+  using PrestoCompressionDictionary =
+      serializer::presto::PrestoCompressionDictionary;
+  serializer::presto::PrestoVectorSerde::PrestoOptions writeOptions{
+      false, common::CompressionKind_ZSTD};
+  writeOptions.compressionDictionary =
+      std::make_shared<PrestoCompressionDictionary>();
+  auto readOptions = writeOptions;
+  readOptions.compressionDictionary =
+      std::make_shared<PrestoCompressionDictionary>();
+
+  auto data = makeTestVector(100);
+  auto rowType = asRowType(data->type());
+  auto serializePage = [&]() {
+    std::ostringstream output;
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createSerializer(
+        rowType, data->size(), arena.get(), &writeOptions);
+    serializer->append(data);
+    const auto maxSize = serializer->maxSerializedSize();
+    serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    EXPECT_GE(maxSize, output.str().size());
+    return output.str();
+  };
+
+  // The first pages are compressed without a dictionary until enough
+  // samples are collected.
+  std::string pages;
+  std::string page;
+  int32_t numPages = 0;
+  while (writeOptions.compressionDictionary->dictionary() == nullptr) {
+    ASSERT_LT(numPages, 10'000);
+    page = serializePage();
+    pages += page;
+    ++numPages;
+  }
+  const auto pageSize = page.size();
+
+  // The next page is preceded by the dictionary and the later pages are
+  // smaller with the dictionary.
+  ASSERT_TRUE(writeOptions.compressionDictionary->needsSend());
+  pages += serializePage();
+  ASSERT_FALSE(writeOptions.compressionDictionary->needsSend());
+  for (auto i = 0; i < 2; ++i) {
+    page = serializePage();
+    ASSERT_LT(page.size(), pageSize);
+    pages += page;
+  }
+  numPages += 3;
+
+  auto byteStream = toByteStream(pages);
+  for (auto i = 0; i < numPages; ++i) {
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(), pool_.get(), rowType, &result, 0, &readOptions);
+    assertEqualVectors(data, result);
+  }
+  ASSERT_TRUE(byteStream->atEnd());
+  ASSERT_EQ(
+      readOptions.compressionDictionary->dictionary()->id(),
+      writeOptions.compressionDictionary->dictionary()->id());
+
+  // Pages compressed with a dictionary can't be read without it.
+  auto plainOptions = getParamSerdeOptions(nullptr);
+  auto pageStream = toByteStream(page);
+  RowVectorPtr result;
+  VELOX_ASSERT_THROW(
+      serde_->deserialize(
+          pageStream.get(), pool_.get(), rowType, &result, 0, &plainOptions),
+      "Received a page compressed with unknown dictionary");
+}
+
 TEST_P(PrestoSerializerTest, emptyArrayOfRowVector) {
   // The value of nullCount_ + nonNullCount_ of the inner RowVector is 0.
   auto arrayOfRow = makeArrayOfRowVector(ROW({UNKNOWN()}), {{}});
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+namespace facebook::velox::substrait {
+namespace {
+// Returns the serialization of 'plan' with the map fields in key order, so
+// that equal plans have equal keys.
+std::string cacheKey(const ::substrait::Plan& plan) {
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream stream(&key);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    output.SetSerializationDeterministic(true);
+    VELOX_CHECK(
+        plan.SerializeToCodedStream(&output),
+        "Failed to serialize Substrait plan");
+  }
+  return key;
+}
+} // namespace
+
+std::shared_ptr<const SubstraitPlanCache::CachedPlan>
+SubstraitPlanCache::toVeloxPlan(const ::substrait::Plan& substraitPlan) {
+  auto key = cacheKey(substraitPlan);
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (auto cached = cache_.get(key)) {
+      return cached.value();
+    }
+  }
+
+  // Converted outside of the lock. Concurrent misses on the same plan convert
+  // it more than once and the first one added stays in the cache.
+  SubstraitVeloxPlanConverter converter(pool_);
+  auto converted = std::make_shared<CachedPlan>();
+  converted->plan = converter.toVeloxPlan(substraitPlan);
+  converted->splitInfos = converter.splitInfos();
+
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.add(key, converted);
+  return converted;
+}
+
+SimpleLRUCacheStats SubstraitPlanCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.getStats();
+}
+
+void SubstraitPlanCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.clear();
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace facebook::velox::substrait {
+
+/// Caches the Velox plans converted from Substrait plans, so that a plan that
+/// is submitted repeatedly is parsed and converted once. Velox plans are
+/// immutable and may run in any number of tasks at the same time. The key is
+/// the deterministic serialization of the Substrait plan, so that only
+/// identical plans, including their literals, share a Velox plan.
+///
+/// Values nodes and constant expressions of the cached plans hold vectors
+/// allocated from 'pool', which must outlive the cache and the tasks running
+/// its plans. Thread safe.
+class SubstraitPlanCache {
+ public:
+  struct CachedPlan {
+    core::PlanNodePtr plan;
+    std::unordered_map<
+        core::PlanNodeId,
+        std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+        splitInfos;
+  };
+
+  SubstraitPlanCache(memory::MemoryPool* pool, size_t maxEntries)
+      : pool_(pool), cache_(maxEntries) {}
+
+  /// Returns the Velox plan of 'substraitPlan' and the split infos of its
+  /// scans, converting the plan if it is not in the cache.
+  std::shared_ptr<const CachedPlan> toVeloxPlan(
+      const ::substrait::Plan& substraitPlan);
+
+  SimpleLRUCacheStats stats() const;
+
+  void clear();
+
+ private:
+  memory::MemoryPool* const pool_;
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const CachedPlan>> cache_;
+};
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/tests/JsonToProtoConverter.h"
+
+#include "velox/dwio/common/tests/utils/DataFiles.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::substrait;
+
+class SubstraitPlanCacheTest : public OperatorTestBase {
+ protected:
+  ::substrait::Plan readPlan(const std::string& name) {
+    ::substrait::Plan plan;
+    JsonToProtoConverter::readFromFile(
+        getDataFilePath("velox/substrait/tests", "data/" + name), plan);
+    return plan;
+  }
+};
+
+TEST_F(SubstraitPlanCacheTest, repeatedPlan) {
+  SubstraitPlanCache cache(pool_.get(), 10);
+  const auto substraitPlan = readPlan("substrait_virtualTable.json");
+
+  auto first = cache.toVeloxPlan(substraitPlan);
+  auto second = cache.toVeloxPlan(substraitPlan);
+  // An equal plan parsed again hits too.
+  auto third = cache.toVeloxPlan(readPlan("substrait_virtualTable.json"));
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first, third);
+  EXPECT_EQ(SimpleLRUCacheStats(10, 1, 2, 3), cache.stats());
+
+  RowVectorPtr expectedData = makeRowVector(
+      {makeFlatVector<int64_t>(
+           {2499109626526694126, 2342493223442167775, 4077358421272316858}),
+       makeFlatVector<int32_t>({581869302, -708632711, -133711905}),
+       makeFlatVector<double>(
+           {0.90579193414549275, 0.96886777112423139, 0.63235925003444637}),
+       makeFlatVector<bool>({true, false, false}),
+       makeFlatVector<int32_t>(3, nullptr, nullEvery(1))});
+  createDuckDbTable({expectedData});
+  // The cached plan runs in more than one task.
+  assertQuery(first->plan, "SELECT * FROM tmp");
+  assertQuery(second->plan, "SELECT * FROM tmp");
+}
+
+TEST_F(SubstraitPlanCacheTest, differentPlans) {
+  SubstraitPlanCache cache(pool_.get(), 1);
+  auto substraitPlan = readPlan("substrait_virtualTable.json");
+  auto first = cache.toVeloxPlan(substraitPlan);
+
+  // A plan with a different literal is a different entry.
+  auto* values = substraitPlan.mutable_relations(0)
+                     ->mutable_root()
+                     ->mutable_input()
+                     ->mutable_read()
+                     ->mutable_virtual_table()
+                     ->mutable_values(0)
+                     ->mutable_fields(0);
+  values->set_i64(values->i64() + 1);
+  auto second = cache.toVeloxPlan(substraitPlan);
+  EXPECT_NE(first, second);
+
+  // The first plan was evicted.
+  auto third = cache.toVeloxPlan(readPlan("substrait_virtualTable.json"));
+  EXPECT_NE(first, third);
+  EXPECT_EQ(SimpleLRUCacheStats(1, 1, 0, 3), cache.stats());
+
+  cache.clear();
+  EXPECT_EQ(0, cache.stats().curSize);
+}
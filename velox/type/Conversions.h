@@ -18,6 +18,8 @@
 
 #include <folly/Conv.h>
 #include <cctype>
+#include <limits>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -28,6 +30,52 @@ DECLARE_bool(experimental_enable_legacy_cast);
 
 namespace facebook::velox::util {
 
+/// Parses 'v' as a base 10 integer if it is an optional '-' followed by at
+/// most 18 digits and the value fits in T. Returns std::nullopt otherwise.
+/// Accepted inputs give the same value as folly::to<T>, which is left to
+/// handle whitespace, '+', longer inputs and errors.
+template <typename T>
+std::optional<T> tryParseIntegral(folly::StringPiece v) {
+  static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
+  const char* begin = v.begin();
+  const char* end = v.end();
+  const bool negative = begin < end && *begin == '-';
+  begin += negative;
+  // 18 digits always fit in int64_t.
+  const auto numDigits = end - begin;
+  if (numDigits == 0 || numDigits > 18) {
+    return std::nullopt;
+  }
+  int64_t value = 0;
+  for (; begin < end; ++begin) {
+    const uint8_t digit = *begin - '0';
+    if (digit > 9) {
+      return std::nullopt;
+    }
+    value = value * 10 + digit;
+  }
+  if (negative) {
+    value = -value;
+  }
+  if (value < std::numeric_limits<T>::min() ||
+      value > std::numeric_limits<T>::max()) {
+    return std::nullopt;
+  }
+  return static_cast<T>(value);
+}
+
+/// Returns false if 'v' has a character other than a digit, a sign or
+/// whitespace. folly::to fails on such inputs for all integral types.
+inline bool mayBeIntegral(folly::StringPiece v) {
+  for (auto c : v) {
+    const auto ch = static_cast<unsigned char>(c);
+    if (!std::isdigit(ch) && !std::isspace(ch) && ch != '-' && ch != '+') {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <
     TypeKind KIND,
     typename = void,
@@ -156,11 +204,23 @@ struct Converter<
     }
   }
 
+  // folly::to<T> with a fast path for plain decimal integers.
+  static T convertStringToIntStrict(folly::StringPiece v) {
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int128_t>) {
+      return folly::to<T>(v);
+    } else {
+      if (auto value = tryParseIntegral<T>(v)) {
+        return value.value();
+      }
+      return folly::to<T>(v);
+    }
+  }
+
   static T cast(folly::StringPiece v) {
     if constexpr (TRUNCATE) {
       return convertStringToInt(v);
     } else {
-      return folly::to<T>(v);
+      return convertStringToIntStrict(v);
     }
   }
 
@@ -168,7 +228,7 @@ struct Converter<
     if constexpr (TRUNCATE) {
       return convertStringToInt(folly::StringPiece(v));
     } else {
-      return folly::to<T>(folly::StringPiece(v));
+      return convertStringToIntStrict(folly::StringPiece(v));
     }
   }
 
@@ -176,7 +236,7 @@ struct Converter<
     if constexpr (TRUNCATE) {
       return convertStringToInt(v);
     } else {
-      return folly::to<T>(v);
+      return convertStringToIntStrict(v);
     }
   }
 
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -978,6 +981,95 @@ class BigintValuesUsingHashTable final : public Filter {
   int32_t sizeMask_;
 };
 
+/// IN-list filter for integral data types backed by a Bloom filter. Used for
+/// sets too large for an exact hash table or bitmask, e.g. the join keys of a
+/// large hash join build side. Passes all values in the set plus a small
+/// fraction of false positives, so that it can only be used where passing
+/// extra values is harmless, e.g. as a dynamic filter in front of a join.
+/// Values outside of [min, max] are rejected exactly.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value in the set.
+  /// @param max Maximum value in the set.
+  /// @param bloomFilter Contains hashValue() of each value in the set.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(min),
+        max_(max),
+        bloomFilter_(std::move(bloomFilter)) {
+    VELOX_CHECK_LE(min_, max_);
+    VELOX_CHECK(bloomFilter_ != nullptr && bloomFilter_->isSet());
+  }
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash of 'value' to add to and test against the Bloom filter.
+  static uint64_t hashValue(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return value >= min_ && value <= max_ &&
+        bloomFilter_->mayContain(hashValue(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  /// Merges exactly with ranges and IN-lists. Other filters are returned as
+  /// is, dropping the Bloom filter, which is correct since the Bloom filter
+  /// may pass any value.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  // Shared between the clones of a filter pushed into multiple scans.
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 /// IN-list filter for int128_t data type, implemented as a hash table.
 class HugeintValuesUsingHashTable final : public Filter {
  public:
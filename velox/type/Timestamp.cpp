@@ -122,6 +122,32 @@ void Timestamp::toTimezone(const date::time_zone& zone) {
   seconds_ = std::chrono::floor<std::chrono::seconds>(epoch).count();
 }
 
+void TimezoneOffsetCache::convertAndCache(Timestamp& timestamp) {
+  using namespace std::chrono;
+  // The range accepted by validateTimePoint(). Timestamps outside of it are
+  // never cached so that they fail like in Timestamp::toTimezone().
+  static const int64_t kMinSeconds =
+      duration_cast<seconds>(
+          date::sys_days{date::year_month_day(
+                             date::year::min(), date::month(1), date::day(1))}
+              .time_since_epoch())
+          .count();
+  static const int64_t kMaxSeconds =
+      duration_cast<seconds>(
+          date::sys_days{date::year_month_day(
+                             date::year::max(), date::month(12), date::day(31))}
+              .time_since_epoch())
+          .count();
+
+  const auto gmtSeconds = timestamp.getSeconds();
+  timestamp.toTimezone(*zone_);
+  const auto info = zone_->get_info(date::sys_seconds{seconds(gmtSeconds)});
+  begin_ = std::max<int64_t>(
+      info.begin.time_since_epoch().count(), kMinSeconds + 1);
+  end_ = std::min<int64_t>(info.end.time_since_epoch().count(), kMaxSeconds);
+  offset_ = info.offset.count();
+}
+
 void Timestamp::toTimezone(int16_t tzID) {
   if (tzID == 0) {
     // No conversion required for time zone id 0, as it is '+00:00'.
@@ -19,6 +19,7 @@
 #include <sstream>
 #include <string>
 
+#include <folly/Likely.h>
 #include <folly/dynamic.h>
 
 #include "velox/common/base/CheckedArithmetic.h"
@@ -334,6 +335,40 @@ struct Timestamp {
   uint64_t nanos_;
 };
 
+// Converts GMT timestamps to the time at one zone like
+// Timestamp::toTimezone(). Remembers the zone's offset over the transition
+// interval of the last conversion. Timestamps in that interval, e.g. a whole
+// batch without a DST change, are converted without a time zone lookup.
+class TimezoneOffsetCache {
+ public:
+  explicit TimezoneOffsetCache(const date::time_zone* zone) : zone_(zone) {}
+
+  void toTimezone(Timestamp& timestamp) {
+    const auto seconds = timestamp.getSeconds();
+    if (FOLLY_UNLIKELY(seconds < begin_ || seconds >= end_)) {
+      convertAndCache(timestamp);
+      return;
+    }
+    timestamp = Timestamp(seconds + offset_, timestamp.getNanos());
+  }
+
+  const date::time_zone* zone() const {
+    return zone_;
+  }
+
+ private:
+  // Converts 'timestamp' with a time zone lookup and caches the offset of its
+  // transition interval.
+  void convertAndCache(Timestamp& timestamp);
+
+  const date::time_zone* const zone_;
+
+  // The transition interval [begin_, end_) in GMT seconds and its offset.
+  int64_t begin_{0};
+  int64_t end_{0};
+  int64_t offset_{0};
+};
+
 void parseTo(folly::StringPiece in, ::facebook::velox::Timestamp& out);
 
 template <typename T>
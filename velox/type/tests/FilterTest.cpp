@@ -454,6 +454,65 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(i * 7));
+  }
+  BigintValuesUsingBloomFilter filter(0, 999 * 7, bloomFilter, false);
+
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter.testInt64(i * 7));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 999 * 7; ++i) {
+    if (i % 7 != 0 && filter.testInt64(i)) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 6 * 999 / 10);
+  EXPECT_FALSE(filter.testNull());
+  EXPECT_FALSE(filter.testInt64(-7));
+  EXPECT_FALSE(filter.testInt64(1'000 * 7));
+
+  EXPECT_TRUE(filter.testInt64Range(0, 10, false));
+  EXPECT_TRUE(filter.testInt64Range(14, 14, false));
+  EXPECT_FALSE(filter.testInt64Range(-10, -1, false));
+  EXPECT_FALSE(filter.testInt64Range(7'000, 8'000, false));
+
+  // Merging with a range narrows the range and keeps the Bloom filter.
+  auto merged = filter.mergeWith(between(100, 200).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(105));
+  EXPECT_FALSE(merged->testInt64(98));
+  EXPECT_FALSE(merged->testInt64(203));
+  merged = between(100, 200)->mergeWith(&filter);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_FALSE(merged->testInt64Range(201, 300, false));
+
+  // Merging with an IN-list is exact.
+  merged = in({7, 14, 21, 10'000})->mergeWith(&filter);
+  EXPECT_TRUE(merged->testInt64(7));
+  EXPECT_TRUE(merged->testInt64(14));
+  EXPECT_TRUE(merged->testInt64(21));
+  EXPECT_FALSE(merged->testInt64(10'000));
+  EXPECT_FALSE(merged->testNull());
+
+  // Filters that can't be combined with the Bloom filter are kept as is.
+  merged = filter.mergeWith(notEqual(14, true).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kNegatedBigintRange);
+  EXPECT_FALSE(merged->testInt64(14));
+  EXPECT_FALSE(merged->testNull());
+
+  merged = filter.mergeWith(in({-1, 10'000}).get());
+  ASSERT_EQ(merged->kind(), FilterKind::kAlwaysFalse);
+
+  auto clone = filter.clone(true);
+  EXPECT_TRUE(clone->testNull());
+  EXPECT_TRUE(clone->testInt64(14));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
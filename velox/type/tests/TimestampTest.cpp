@@ -299,6 +299,35 @@ TEST(TimestampTest, outOfRange) {
       t.toTimePoint(), "Timestamp is outside of supported range");
   VELOX_ASSERT_THROW(
       t.toTimezone(*timezone), "Timestamp is outside of supported range");
+
+  // Out of range timestamps are not converted from a cached offset.
+  TimezoneOffsetCache offsets(timezone);
+  Timestamp inRange(0, 0);
+  offsets.toTimezone(inRange);
+  VELOX_ASSERT_THROW(
+      offsets.toTimezone(t), "Timestamp is outside of supported range");
+}
+
+TEST(TimestampTest, timezoneOffsetCache) {
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  TimezoneOffsetCache offsets(timezone);
+  // Hourly timestamps over 2021, crossing both DST transitions, then back
+  // and forth across them.
+  std::vector<int64_t> seconds;
+  for (int64_t i = 1609459200; i < 1640995200; i += 3'600) {
+    seconds.push_back(i);
+  }
+  for (auto i = 0; i < 100; ++i) {
+    seconds.push_back(1615712400 + (i % 2 ? -1 : 1) * i * 60);
+    seconds.push_back(1636275600 + (i % 2 ? -1 : 1) * i * 60);
+  }
+  for (auto second : seconds) {
+    Timestamp expected(second, 123);
+    expected.toTimezone(*timezone);
+    Timestamp actual(second, 123);
+    offsets.toTimezone(actual);
+    ASSERT_EQ(expected, actual) << second;
+  }
 }
 
 void checkTm(const std::tm& actual, const std::tm& expected) {
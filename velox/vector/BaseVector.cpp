@@ -853,6 +853,65 @@ void BaseVector::flattenVector(VectorPtr& vector) {
   }
 }
 
+// static
+void BaseVector::compactStringBuffers(VectorPtr& vector, int32_t minLivePct) {
+  if (!vector) {
+    return;
+  }
+  // Vectors that are referenced elsewhere are not changed in place.
+  const bool isUnique = vector.use_count() == 1;
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (isUnique &&
+          (vector->typeKind() == TypeKind::VARCHAR ||
+           vector->typeKind() == TypeKind::VARBINARY)) {
+        vector->asUnchecked<FlatVector<StringView>>()->compactStringBuffers(
+            minLivePct);
+      }
+      return;
+    case VectorEncoding::Simple::ROW:
+      if (isUnique) {
+        for (auto& child : vector->asUnchecked<RowVector>()->children()) {
+          compactStringBuffers(child, minLivePct);
+        }
+      }
+      return;
+    case VectorEncoding::Simple::ARRAY:
+      if (isUnique) {
+        compactStringBuffers(
+            vector->asUnchecked<ArrayVector>()->elements(), minLivePct);
+      }
+      return;
+    case VectorEncoding::Simple::MAP: {
+      if (!isUnique) {
+        return;
+      }
+      auto* mapVector = vector->asUnchecked<MapVector>();
+      compactStringBuffers(mapVector->mapKeys(), minLivePct);
+      compactStringBuffers(mapVector->mapValues(), minLivePct);
+      return;
+    }
+    case VectorEncoding::Simple::DICTIONARY: {
+      const int64_t baseSize = vector->valueVector()->size();
+      if (int64_t{vector->size()} * 100 >= baseSize * minLivePct) {
+        return;
+      }
+      flattenVector(vector);
+      compactStringBuffers(vector, minLivePct);
+      return;
+    }
+    case VectorEncoding::Simple::LAZY:
+      if (isUnique && vector->asUnchecked<LazyVector>()->isLoaded()) {
+        // The loaded vector replaces the wrapper, which releases it.
+        vector = BaseVector::loadedVectorShared(vector);
+        compactStringBuffers(vector, minLivePct);
+      }
+      return;
+    default:
+      return;
+  }
+}
+
 void BaseVector::prepareForReuse(VectorPtr& vector, vector_size_t size) {
   if (!vector.unique() || !isReusableEncoding(vector->encoding())) {
     vector = BaseVector::create(vector->type(), size, vector->pool());
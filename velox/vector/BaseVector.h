@@ -580,6 +580,14 @@ class BaseVector {
   // Flattens the input vector and all of its children.
   static void flattenVector(VectorPtr& vector);
 
+  /// Compacts the string buffers of the VARCHAR and VARBINARY vectors in
+  /// 'vector' and its children with FlatVector::compactStringBuffers(). A
+  /// dictionary with fewer than 'minLivePct' percent of the rows of its base
+  /// is flattened first, so that it no longer retains the whole base. Vectors
+  /// referenced by other VectorPtrs are not changed in place. Used before
+  /// holding on to a vector across batches.
+  static void compactStringBuffers(VectorPtr& vector, int32_t minLivePct);
+
   template <typename T>
   static inline uint64_t byteSize(vector_size_t count) {
     return sizeof(T) * count;
@@ -572,35 +572,65 @@ void ArrayVectorBase::copyRangesImpl(
           }
         });
     outRanges.reserve(totalCount);
-    applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
-      if (source->isNullAt(sourceIndex)) {
-        setNull(targetIndex, true);
-      } else {
-        if (setNotNulls) {
-          setNull(targetIndex, false);
+
+    // Appends the elements of a source row to the elements to copy.
+    auto addRow = [&](vector_size_t targetIndex,
+                      vector_size_t copyOffset,
+                      vector_size_t copySize) {
+      if (copySize > 0) {
+        // If we're copying two adjacent ranges, merge them.  This only
+        // works if they're consecutive.
+        if (!outRanges.empty() &&
+            (outRanges.back().sourceIndex + outRanges.back().count ==
+             copyOffset)) {
+          outRanges.back().count += copySize;
+        } else {
+          outRanges.push_back({copyOffset, childSize, copySize});
         }
-        auto wrappedIndex = source->wrappedIndex(sourceIndex);
-        auto copySize = sourceArray->sizeAt(wrappedIndex);
-
-        if (copySize > 0) {
-          auto copyOffset = sourceArray->offsetAt(wrappedIndex);
-
-          // If we're copying two adjacent ranges, merge them.  This only
-          // works if they're consecutive.
-          if (!outRanges.empty() &&
-              (outRanges.back().sourceIndex + outRanges.back().count ==
-               copyOffset)) {
-            outRanges.back().count += copySize;
-          } else {
-            outRanges.push_back({copyOffset, childSize, copySize});
+      }
+      mutableOffsets[targetIndex] = childSize;
+      mutableSizes[targetIndex] = copySize;
+      childSize += copySize;
+    };
+
+    if (source->encoding() == encoding()) {
+      // The nulls of a flat source are copied a range at a time and its
+      // offsets and sizes are read directly.
+      const auto* sourceNulls = source->rawNulls();
+      const auto* sourceOffsets = sourceArray->rawOffsets();
+      const auto* sourceSizes = sourceArray->rawSizes();
+      if (sourceNulls) {
+        BaseVector::copyNulls(mutableRawNulls(), sourceNulls, ranges);
+      } else if (setNotNulls) {
+        BaseVector::setNulls(mutableRawNulls(), ranges, false);
+      }
+      applyToEachRange(
+          ranges, [&](auto targetIndex, auto sourceIndex, auto count) {
+            for (vector_size_t i = 0; i < count; ++i) {
+              const auto row = sourceIndex + i;
+              if (sourceNulls && bits::isBitNull(sourceNulls, row)) {
+                addRow(targetIndex + i, 0, 0);
+              } else {
+                addRow(targetIndex + i, sourceOffsets[row], sourceSizes[row]);
+              }
+            }
+          });
+    } else {
+      applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
+        if (source->isNullAt(sourceIndex)) {
+          setNull(targetIndex, true);
+        } else {
+          if (setNotNulls) {
+            setNull(targetIndex, false);
           }
+          auto wrappedIndex = source->wrappedIndex(sourceIndex);
+          addRow(
+              targetIndex,
+              sourceArray->offsetAt(wrappedIndex),
+              sourceArray->sizeAt(wrappedIndex));
         }
-
-        mutableOffsets[targetIndex] = childSize;
-        mutableSizes[targetIndex] = copySize;
-        childSize += copySize;
-      }
-    });
+      });
+    }
 
     targetValues->get()->resize(childSize);
     targetValues->get()->copyRanges(sourceValues, outRanges);
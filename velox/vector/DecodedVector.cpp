@@ -16,11 +16,31 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/LazyVector.h"
 
 namespace facebook::velox {
 
+namespace {
+// Sets 'result[i]' to 'newIndices[indices[i]]' for the first 'numRows' rows.
+// 'result' may be 'indices'.
+void combineIndices(
+    const vector_size_t* indices,
+    const vector_size_t* newIndices,
+    vector_size_t numRows,
+    vector_size_t* result) {
+  constexpr int32_t kBatchSize = xsimd::batch<vector_size_t>::size;
+  vector_size_t row = 0;
+  for (; row + kBatchSize <= numRows; row += kBatchSize) {
+    simd::gather(newIndices, indices + row).store_unaligned(result + row);
+  }
+  for (; row < numRows; ++row) {
+    result[row] = newIndices[indices[row]];
+  }
+}
+} // namespace
+
 uint64_t DecodedVector::constantNullMask_;
 
 namespace {
@@ -146,6 +166,12 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // The runs become indices into the run values, which stay encoded.
+    copiedIndices_.resize(std::max<vector_size_t>(size_, 1));
+    expandRuns(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = vector->valueVector().get();
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -180,6 +206,11 @@ void DecodedVector::combineWrappers(
         values = values->valueVector().get();
         break;
       }
+      case VectorEncoding::Simple::SEQUENCE: {
+        applySequenceWrapper(*values, rows);
+        values = values->valueVector().get();
+        break;
+      }
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -213,6 +244,14 @@ void DecodedVector::applyDictionaryWrapper(
     indices_ = copiedIndices_.data();
   }
 
+  if (!nulls_ && (!rows || rows->isAllSelected())) {
+    // No nulls to check per row, so the indices of all rows are combined with
+    // gathers.
+    combineIndices(
+        currentIndices, newIndices, end(rows), copiedIndices_.data());
+    return;
+  }
+
   applyToRows(rows, [&](vector_size_t row) {
     if (!nulls_ || !bits::isBitNull(nulls_, row)) {
       auto wrappedIndex = currentIndices[row];
@@ -225,6 +264,43 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+// static
+void DecodedVector::expandRuns(
+    const BaseVector& sequenceVector,
+    vector_size_t size,
+    vector_size_t* indices) {
+  const auto* lengths = sequenceVector.wrapInfo()->as<vector_size_t>();
+  const auto numRuns = sequenceVector.valueVector()->size();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns && row < size; ++run) {
+    const auto end = std::min(size, row + lengths[run]);
+    std::fill(indices + row, indices + end, run);
+    row = end;
+  }
+}
+
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    // No further processing is needed.
+    return;
+  }
+  // A SequenceVector has no nulls of its own, only those of its values.
+  std::vector<vector_size_t> runIndices(sequenceVector.size());
+  expandRuns(sequenceVector, runIndices.size(), runIndices.data());
+  auto currentIndices = indices_;
+  if (indicesNotCopied()) {
+    copiedIndices_.resize(size_);
+    indices_ = copiedIndices_.data();
+  }
+  applyToRows(rows, [&](vector_size_t row) {
+    if (!nulls_ || !bits::isBitNull(nulls_, row)) {
+      copiedIndices_[row] = runIndices[currentIndices[row]];
+    }
+  });
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
@@ -335,6 +335,19 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Maps the rows of a SequenceVector that is wrapped in the wrappers
+  // applied so far to the indices of its run values.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
+  // Sets the first 'size' of 'indices' to the index of the run of each row of
+  // 'sequenceVector'.
+  static void expandRuns(
+      const BaseVector& sequenceVector,
+      vector_size_t size,
+      vector_size_t* indices);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices();
@@ -78,6 +78,63 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
   return rawBuffer;
 }
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(int32_t minLivePct) {
+  if (stringBuffers_.empty() || !rawValues_) {
+    return false;
+  }
+  uint64_t retainedBytes = 0;
+  for (const auto& buffer : stringBuffers_) {
+    retainedBytes += buffer->capacity();
+  }
+  uint64_t liveBytes = 0;
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    if (!BaseVector::isNullAt(i) && !rawValues_[i].isInline()) {
+      liveBytes += rawValues_[i].size();
+    }
+  }
+  if (liveBytes * 100 >= retainedBytes * minLivePct) {
+    return false;
+  }
+
+  // The views may be shared with other vectors that reference the old string
+  // buffers.
+  if (!values_->isMutable()) {
+    auto newValues = AlignedBuffer::allocate<StringView>(
+        BaseVector::length_, BaseVector::pool_);
+    memcpy(
+        newValues->asMutable<StringView>(),
+        rawValues_,
+        BaseVector::length_ * sizeof(StringView));
+    values_ = std::move(newValues);
+    rawValues_ = values_->asMutable<StringView>();
+  }
+
+  BufferPtr buffer;
+  char* rawBuffer = nullptr;
+  if (liveBytes > 0) {
+    buffer = AlignedBuffer::allocate<char>(liveBytes, BaseVector::pool_);
+    rawBuffer = buffer->asMutable<char>();
+  }
+  for (auto i = 0; i < BaseVector::length_; ++i) {
+    auto& value = rawValues_[i];
+    if (BaseVector::isNullAt(i)) {
+      // Null rows must not reference the released buffers.
+      value = StringView();
+    } else if (!value.isInline()) {
+      memcpy(rawBuffer, value.data(), value.size());
+      value = StringView(rawBuffer, value.size());
+      rawBuffer += value.size();
+    }
+  }
+  if (buffer) {
+    setStringBuffers({std::move(buffer)});
+  } else {
+    clearStringBuffers();
+  }
+  return true;
+}
+
 template <>
 void FlatVector<StringView>::prepareForReuse() {
   BaseVector::prepareForReuse();
@@ -466,6 +466,17 @@ class FlatVector final : public SimpleVector<T> {
     return nullptr;
   }
 
+  /// This API is available only for string vectors (T = StringView).
+  ///
+  /// Copies the non-inlined strings into one new string buffer that replaces
+  /// 'stringBuffers' if the strings take less than 'minLivePct' percent of
+  /// the capacity of the string buffers, e.g. after a filter or a copy of a
+  /// few rows left most of the shared buffers unreferenced. Returns true if
+  /// the strings were copied.
+  bool compactStringBuffers(int32_t /*minLivePct*/) {
+    return false;
+  }
+
   void ensureWritable(const SelectivityVector& rows) override;
 
   bool isWritable() const override {
@@ -580,6 +591,9 @@ char* FlatVector<StringView>::getRawStringBufferWithSpace(
 template <>
 void FlatVector<StringView>::prepareForReuse();
 
+template <>
+bool FlatVector<StringView>::compactStringBuffers(int32_t minLivePct);
+
 template <typename T>
 using FlatVectorPtr = std::shared_ptr<FlatVector<T>>;
 
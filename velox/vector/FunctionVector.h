@@ -22,6 +22,7 @@ namespace facebook::velox {
 
 namespace exec {
 class EvalCtx;
+class Expr;
 } // namespace exec
 
 // Represents a function with possible captures.
@@ -31,6 +32,14 @@ class Callable {
 
   virtual bool hasCapture() const = 0;
 
+  /// Returns the names and types of the parameters passed by the caller.
+  virtual const RowTypePtr& signature() const = 0;
+
+  /// Returns the expression computed by 'this' over the parameters in
+  /// signature() and the captures. Lets functions recognize simple lambdas,
+  /// e.g. (s, x) -> s + x, and evaluate these without applying the lambda.
+  virtual const exec::Expr& body() const = 0;
+
   /// Applies 'this' to 'args' for 'rows' and returns the result in
   /// '*result'.
   /// @param rows The rows that this callable applies to. It is the element rows
@@ -19,13 +19,13 @@ namespace facebook::velox {
 
 namespace {
 
-/// Checks if specified type is supported and returns an index of the
-/// corresponding TypePool cache in VectorPool::vectors_ array. Return -1 if
-/// type is not supported, i.e. not a built-in singleton type.
-FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
-  static constexpr int32_t kNumCachedVectorTypes =
-      static_cast<int32_t>(TypeKind::HUGEINT) + 1;
+constexpr int32_t kNumCachedVectorTypes =
+    static_cast<int32_t>(TypeKind::HUGEINT) + 1;
 
+/// Checks if specified type is a built-in singleton type and returns an index
+/// of the corresponding TypePool cache in VectorPool::vectors_ array. Return -1
+/// otherwise.
+FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
   static std::array<const Type*, kNumCachedVectorTypes> kSupportedTypes = {
       BOOLEAN().get(),
       TINYINT().get(),
@@ -37,7 +37,7 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
       VARCHAR().get(),
       VARBINARY().get(),
       TIMESTAMP().get(),
-      DATE().get(),
+      HUGEINT().get(),
   };
 
   auto index = static_cast<int32_t>(type->kind());
@@ -47,12 +47,47 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+/// Returns true if 'type' is a scalar type whose flat vectors can be recycled.
+FOLLY_ALWAYS_INLINE bool isScalar(const TypePtr& type) {
+  return static_cast<int32_t>(type->kind()) < kNumCachedVectorTypes;
+}
 } // namespace
 
+VectorPool::TypePool* VectorPool::typePool(const TypePtr& type, bool create) {
+  const auto cacheIndex = toCacheIndex(type);
+  if (FOLLY_LIKELY(cacheIndex >= 0)) {
+    return &vectors_[cacheIndex];
+  }
+  if (!isScalar(type)) {
+    return nullptr;
+  }
+  for (auto& [otherType, otherPool] : otherTypes_) {
+    if (*otherType == *type) {
+      return &otherPool;
+    }
+  }
+  if (!create || otherTypes_.size() >= kMaxOtherTypes) {
+    return nullptr;
+  }
+  otherTypes_.emplace_back(type, TypePool{});
+  return &otherTypes_.back().second;
+}
+
+VectorPtr VectorPool::tryGet(const TypePtr& type, vector_size_t size) {
+  if (auto* cache = typePool(type, false)) {
+    if (auto vector = cache->pop(size)) {
+      return vector;
+    }
+  }
+  return parent_ != nullptr ? parent_->tryGet(type, size) : nullptr;
+}
+
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    if (auto vector = tryGet(type, size)) {
+      return vector;
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -65,11 +100,14 @@ bool VectorPool::release(VectorPtr& vector) {
     return false;
   }
 
-  auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  auto* cache = typePool(vector->type(), true);
+  if (cache == nullptr) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  if (cache->maybePushBack(vector)) {
+    return true;
+  }
+  return parent_ != nullptr && parent_->release(vector);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -84,6 +122,42 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
   return numReleased;
 }
 
+size_t VectorPool::clear() {
+  const auto numVectors = numCachedVectors();
+  for (auto& cache : vectors_) {
+    cache.clear();
+  }
+  otherTypes_.clear();
+  return numVectors;
+}
+
+size_t VectorPool::numCachedVectors() const {
+  size_t numVectors = 0;
+  for (const auto& cache : vectors_) {
+    numVectors += cache.size;
+  }
+  for (const auto& [_, cache] : otherTypes_) {
+    numVectors += cache.size;
+  }
+  return numVectors;
+}
+
+uint64_t VectorPool::retainedSize() const {
+  uint64_t size = 0;
+  auto addSize = [&](const TypePool& cache) {
+    for (auto i = 0; i < cache.size; ++i) {
+      size += cache.vectors[i]->retainedSize();
+    }
+  };
+  for (const auto& cache : vectors_) {
+    addSize(cache);
+  }
+  for (const auto& [_, cache] : otherTypes_) {
+    addSize(cache);
+  }
+  return size;
+}
+
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
@@ -99,32 +173,36 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   return true;
 }
 
-VectorPtr VectorPool::TypePool::pop(
-    const TypePtr& type,
-    vector_size_t vectorSize,
-    memory::MemoryPool& pool) {
-  if (size) {
-    auto result = std::move(vectors[--size]);
-    if (UNLIKELY(result->rawNulls() != nullptr)) {
-      // This is a recyclable vector, no need to check uniqueness.
-      simd::memset(
-          const_cast<uint64_t*>(result->rawNulls()),
-          bits::kNotNullByte,
-          bits::roundUp(std::min<int32_t>(vectorSize, result->size()), 64) / 8);
-    }
-    if (UNLIKELY(
-            result->typeKind() == TypeKind::VARCHAR ||
-            result->typeKind() == TypeKind::VARBINARY)) {
-      simd::memset(
-          const_cast<void*>(result->valuesAsVoid()),
-          0,
-          std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
-    }
-    if (result->size() != vectorSize) {
-      result->resize(vectorSize);
-    }
-    return result;
+VectorPtr VectorPool::TypePool::pop(vector_size_t vectorSize) {
+  if (size == 0) {
+    return nullptr;
+  }
+  auto result = std::move(vectors[--size]);
+  if (UNLIKELY(result->rawNulls() != nullptr)) {
+    // This is a recyclable vector, no need to check uniqueness.
+    simd::memset(
+        const_cast<uint64_t*>(result->rawNulls()),
+        bits::kNotNullByte,
+        bits::roundUp(std::min<int32_t>(vectorSize, result->size()), 64) / 8);
+  }
+  if (UNLIKELY(
+          result->typeKind() == TypeKind::VARCHAR ||
+          result->typeKind() == TypeKind::VARBINARY)) {
+    simd::memset(
+        const_cast<void*>(result->valuesAsVoid()),
+        0,
+        std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
+  }
+  if (result->size() != vectorSize) {
+    result->resize(vectorSize);
+  }
+  return result;
+}
+
+void VectorPool::TypePool::clear() {
+  for (auto i = 0; i < size; ++i) {
+    vectors[i].reset();
   }
-  return BaseVector::create(type, vectorSize, &pool);
+  size = 0;
 }
 } // namespace facebook::velox
@@ -23,13 +23,23 @@ namespace facebook::velox {
 /// A thread-level cache of pre-allocated flat vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
 /// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
+/// Scalar types are supported. Singleton built-in types have a dedicated cache.
+/// Up to 8 other scalar types, e.g. decimal, date or custom types, are cached
+/// by type equality. Complex types are not supported. Calling 'get' for an
 /// unsupported type already returns a newly allocated vector. Calling 'release'
 /// for an unsupported type is a no-op.
+///
+/// A pool can have a 'parent' pool that is shared by the pools of the
+/// operators of a Driver. A vector that does not fit in 'this' on release()
+/// goes to 'parent' and get() takes a vector from 'parent' before allocating a
+/// new one. This way vectors freed by one operator of a pipeline are reused by
+/// the next. Vectors keep being accounted to the pool they were allocated
+/// from. Neither 'this' nor 'parent' are thread-safe, all the pools of a
+/// Driver are used from the thread running the Driver.
 class VectorPool {
  public:
-  explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
+  explicit VectorPool(memory::MemoryPool* pool, VectorPool* parent = nullptr)
+      : pool_{pool}, parent_{parent} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
   /// 'pool_' if no pre-allocated vector or type is a complex type.
@@ -42,11 +52,23 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  /// Frees all the vectors cached in 'this', e.g. on memory pressure. Does not
+  /// free the vectors in 'parent'. Returns the number of freed vectors.
+  size_t clear();
+
+  /// Returns the number of vectors cached in 'this'.
+  size_t numCachedVectors() const;
+
+  /// Returns the memory retained by the vectors cached in 'this'.
+  uint64_t retainedSize() const;
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  /// Max number of non-singleton scalar types cached in 'otherTypes_'.
+  static constexpr int32_t kMaxOtherTypes = 8;
 
   struct TypePool {
     int32_t size{0};
@@ -54,19 +76,33 @@ class VectorPool {
 
     bool maybePushBack(VectorPtr& vector);
 
-    VectorPtr pop(
-        const TypePtr& type,
-        vector_size_t vectorSize,
-        memory::MemoryPool& pool);
+    /// Returns a recycled vector resized to 'vectorSize' or nullptr if there
+    /// is no vector.
+    VectorPtr pop(vector_size_t vectorSize);
+
+    void clear();
   };
 
+  /// Returns the cache for 'type' or nullptr if 'type' is not supported. If
+  /// 'create' is true, adds a cache for a non-singleton scalar type if there
+  /// are fewer than kMaxOtherTypes.
+  TypePool* FOLLY_NULLABLE typePool(const TypePtr& type, bool create);
+
+  /// Returns a recycled vector from 'this' or 'parent_' or nullptr if none.
+  VectorPtr tryGet(const TypePtr& type, vector_size_t size);
+
   memory::MemoryPool* const pool_;
 
+  VectorPool* const parent_;
+
   static constexpr int32_t kNumCachedVectorTypes =
       static_cast<int32_t>(TypeKind::HUGEINT) + 1;
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated vectors of non-singleton scalar types.
+  std::vector<std::pair<TypePtr, TypePool>> otherTypes_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -23,6 +23,18 @@ void VectorSerializer::append(const RowVectorPtr& vector) {
   append(vector, folly::Range(&allRows, 1));
 }
 
+void VectorSerde::scatter(
+    const RowVectorPtr& vector,
+    const std::vector<folly::Range<const IndexRange*>>& ranges,
+    const std::vector<VectorSerializer*>& serializers) {
+  VELOX_CHECK_EQ(ranges.size(), serializers.size());
+  for (auto i = 0; i < serializers.size(); ++i) {
+    if (!ranges[i].empty()) {
+      serializers[i]->append(vector, ranges[i]);
+    }
+  }
+}
+
 namespace {
 
 std::unique_ptr<VectorSerde>& getVectorSerdeImpl() {
@@ -110,6 +122,26 @@ void VectorStreamGroup::append(const RowVectorPtr& vector) {
   serializer_->append(vector);
 }
 
+// static
+void VectorStreamGroup::scatter(
+    const RowVectorPtr& vector,
+    const std::vector<VectorStreamGroup*>& groups,
+    const std::vector<folly::Range<const IndexRange*>>& ranges) {
+  VELOX_CHECK_EQ(groups.size(), ranges.size());
+  if (groups.empty()) {
+    return;
+  }
+  auto* serde = groups[0]->serde_;
+  std::vector<VectorSerializer*> serializers;
+  serializers.reserve(groups.size());
+  for (auto* group : groups) {
+    VELOX_CHECK(
+        group->serde_ == serde, "Scattered stream groups must share a serde");
+    serializers.push_back(group->serializer_.get());
+  }
+  serde->scatter(vector, ranges, serializers);
+}
+
 void VectorStreamGroup::flush(OutputStream* out) {
   serializer_->flush(out);
 }
@@ -81,6 +81,16 @@ class VectorSerde {
       StreamArena* streamArena,
       const Options* options = nullptr) = 0;
 
+  /// Appends the rows of 'vector' in 'ranges[i]' to 'serializers[i]'. All of
+  /// 'serializers' must be created by this serde for the type of 'vector'.
+  /// The default appends to each serializer in turn. Serdes override this to
+  /// make a single pass over each column of 'vector' for all the
+  /// serializers.
+  virtual void scatter(
+      const RowVectorPtr& vector,
+      const std::vector<folly::Range<const IndexRange*>>& ranges,
+      const std::vector<VectorSerializer*>& serializers);
+
   virtual void deserialize(
       ByteStream* source,
       velox::memory::MemoryPool* pool,
@@ -113,6 +123,24 @@ class VectorSerde {
     }
     VELOX_UNSUPPORTED();
   }
+
+  /// Returns true if implements 'deserializeZeroCopy'.
+  virtual bool supportsZeroCopyDeserialize() const {
+    return false;
+  }
+
+  /// Deserializes data from 'source' like 'deserialize' but lets the result
+  /// use the memory of 'source' instead of copying it. 'sourceHolder' owns
+  /// that memory. The result holds a reference to it until freed.
+  virtual void deserializeZeroCopy(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      std::shared_ptr<void> sourceHolder,
+      const Options* options = nullptr) {
+    VELOX_UNSUPPORTED();
+  }
 };
 
 /// Register/deregister the "default" vector serde.
@@ -164,6 +192,13 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// Appends the rows of 'vector' in 'ranges[i]' to 'groups[i]' with a single
+  /// VectorSerde::scatter() call. All of 'groups' must use the same serde.
+  static void scatter(
+      const RowVectorPtr& vector,
+      const std::vector<VectorStreamGroup*>& groups,
+      const std::vector<folly::Range<const IndexRange*>>& ranges);
+
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
@@ -29,17 +29,22 @@ namespace facebook::velox {
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). Binary views use one buffer per string buffer and
+// one for the string buffer sizes instead of the offsets.
 static constexpr size_t kMaxBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Sets the number of buffers. Invalidates the pointer returned by
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -56,7 +61,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -87,11 +92,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -213,6 +218,7 @@ static void releaseArrowSchema(ArrowSchema* arrowSchema) {
 // Returns the Arrow C data interface format type for a given Velox type.
 const char* exportArrowFormatStr(
     const TypePtr& type,
+    const ArrowOptions& options,
     std::string& formatBuffer) {
   if (type->isDecimal()) {
     // Decimal types encode the precision, scale values.
@@ -240,12 +246,12 @@ const char* exportArrowFormatStr(
       return "f"; // float32
     case TypeKind::DOUBLE:
       return "g"; // float64
-    // We always map VARCHAR and VARBINARY to the "small" version (lower case
-    // format string), which uses 32 bit offsets.
+    // We map VARCHAR and VARBINARY to the "small" version (lower case format
+    // string), which uses 32 bit offsets, unless exporting to views.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
 
     case TypeKind::TIMESTAMP:
       return "ttn"; // time64 [nanoseconds]
@@ -578,12 +584,131 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Layout of an Arrow binary view of a non-inlined string. The view of an
+// inlined string has the layout of an inlined StringView.
+struct ArrowBinaryView {
+  int32_t size;
+  char prefix[StringView::kPrefixSize];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+static_assert(sizeof(ArrowBinaryView) == sizeof(StringView));
+
+// Exports strings as Arrow binary views that reference the string buffers of
+// 'vec'. Only the views are written, the string buffers are shared. Strings
+// that are not in the string buffers of 'vec' are copied to an extra buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  // The start addresses of the non-empty string buffers in increasing order,
+  // with the buffer indices.
+  std::vector<std::pair<const char*, int32_t>> starts;
+  for (int32_t i = 0; i < stringBuffers.size(); ++i) {
+    if (stringBuffers[i]->size() > 0) {
+      starts.emplace_back(stringBuffers[i]->as<char>(), i);
+    }
+  }
+  std::sort(starts.begin(), starts.end());
+
+  // Returns the index of the string buffer that holds 'string' at an offset
+  // that fits in a view, or -1 if there is none.
+  auto findBuffer = [&](const StringView& string) -> int32_t {
+    auto it = std::upper_bound(
+        starts.begin(),
+        starts.end(),
+        std::make_pair(string.data(), std::numeric_limits<int32_t>::max()));
+    if (it == starts.begin()) {
+      return -1;
+    }
+    --it;
+    const uint64_t offset = string.data() - it->first;
+    if (offset + string.size() > stringBuffers[it->second]->size() ||
+        offset > std::numeric_limits<int32_t>::max()) {
+      return -1;
+    }
+    return it->second;
+  };
+
+  size_t copiedBytes = 0;
+  rows.apply([&](vector_size_t i) {
+    if (!vec.isNullAt(i)) {
+      auto string = vec.valueAtFast(i);
+      if (!string.isInline() && findBuffer(string) < 0) {
+        copiedBytes += string.size();
+      }
+    }
+  });
+  VELOX_CHECK_LE(copiedBytes, std::numeric_limits<int32_t>::max());
+  const int32_t copiedIndex = stringBuffers.size();
+  BufferPtr copied;
+  char* rawCopied = nullptr;
+  if (copiedBytes > 0) {
+    copied = AlignedBuffer::allocate<char>(copiedBytes, pool);
+    rawCopied = copied->asMutable<char>();
+  }
+
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<StringView>();
+  vector_size_t j = 0;
+  int32_t copiedOffset = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[j++];
+    if (vec.isNullAt(i)) {
+      view = StringView();
+      return;
+    }
+    auto string = vec.valueAtFast(i);
+    if (string.isInline()) {
+      view = string;
+      return;
+    }
+    ArrowBinaryView arrowView;
+    arrowView.size = string.size();
+    memcpy(arrowView.prefix, string.data(), StringView::kPrefixSize);
+    arrowView.bufferIndex = findBuffer(string);
+    if (arrowView.bufferIndex >= 0) {
+      arrowView.offset =
+          string.data() - stringBuffers[arrowView.bufferIndex]->as<char>();
+    } else {
+      memcpy(rawCopied + copiedOffset, string.data(), string.size());
+      arrowView.bufferIndex = copiedIndex;
+      arrowView.offset = copiedOffset;
+      copiedOffset += string.size();
+    }
+    memcpy(&view, &arrowView, sizeof(view));
+  });
+
+  // The nulls, the views, the string buffers and the sizes of the string
+  // buffers.
+  const auto numDataBuffers = stringBuffers.size() + (copied ? 1 : 0);
+  holder.resizeBuffers(numDataBuffers + 3);
+  out.buffers = holder.getArrowBuffers();
+  out.n_buffers = numDataBuffers + 3;
+  holder.setBuffer(1, views);
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+    rawSizes[i] = stringBuffers[i]->size();
+  }
+  if (copied) {
+    holder.setBuffer(2 + copiedIndex, copied);
+    rawSizes[copiedIndex] = copiedBytes;
+  }
+  holder.setBuffer(numDataBuffers + 2, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   out.n_children = 0;
   out.children = nullptr;
   switch (vec.typeKind()) {
@@ -600,8 +725,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -614,14 +752,16 @@ void exportToArrowImpl(
     const BaseVector&,
     const Selection&,
     ArrowArray&,
-    memory::MemoryPool*);
+    memory::MemoryPool*,
+    const ArrowOptions&);
 
 void exportRows(
     const RowVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   out.n_buffers = 1;
   holder.resizeChildren(vec.childrenSize());
   out.n_children = vec.childrenSize();
@@ -632,7 +772,8 @@ void exportRows(
           *vec.childAt(i)->loadedVector(),
           rows,
           *holder.allocateChild(i),
-          pool);
+          pool,
+          options);
     } catch (const VeloxException&) {
       for (column_index_t j = 0; j < i; ++j) {
         // When exception is thrown, i th child is guaranteed unset.
@@ -693,7 +834,8 @@ void exportArrays(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   Selection childRows(vec.elements()->size());
   exportOffsets(vec, rows, out, pool, holder, childRows);
   holder.resizeChildren(1);
@@ -701,7 +843,8 @@ void exportArrays(
       *vec.elements()->loadedVector(),
       childRows,
       *holder.allocateChild(0),
-      pool);
+      pool,
+      options);
   out.n_children = 1;
   out.children = holder.getChildrenArrays();
 }
@@ -711,7 +854,8 @@ void exportMaps(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   RowVector child(
       pool,
       ROW({"key", "value"}, {vec.mapKeys()->type(), vec.mapValues()->type()}),
@@ -721,7 +865,8 @@ void exportMaps(
   Selection childRows(child.size());
   exportOffsets(vec, rows, out, pool, holder, childRows);
   holder.resizeChildren(1);
-  exportToArrowImpl(child, childRows, *holder.allocateChild(0), pool);
+  exportToArrowImpl(
+      child, childRows, *holder.allocateChild(0), pool, options);
   out.n_children = 1;
   out.children = holder.getChildrenArrays();
 }
@@ -731,7 +876,8 @@ void exportDictionary(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   out.n_buffers = 2;
   out.n_children = 0;
   if (rows.changed()) {
@@ -743,7 +889,8 @@ void exportDictionary(
   }
   auto& values = *vec.valueVector()->loadedVector();
   out.dictionary = holder.allocateDictionary();
-  exportToArrowImpl(values, Selection(values.size()), *out.dictionary, pool);
+  exportToArrowImpl(
+      values, Selection(values.size()), *out.dictionary, pool, options);
 }
 
 // Set the array as using "Null Layout" - no buffers are allocated.
@@ -762,7 +909,8 @@ void setNullArray(ArrowArray& array, size_t length) {
 void exportConstantValue(
     const BaseVector& vec,
     ArrowArray& out,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
   VectorPtr valuesVector;
   Selection selection(1);
 
@@ -790,7 +938,7 @@ void exportConstantValue(
         wrapInBufferViewAsViewer(vec.valuesAsVoid(), bufferSize),
         vec.mayHaveNulls() ? 1 : 0);
   }
-  exportToArrowImpl(*valuesVector, selection, out, pool);
+  exportToArrowImpl(*valuesVector, selection, out, pool, options);
 }
 
 // Velox constant vectors are exported as Arrow REE containing a single run
@@ -800,7 +948,8 @@ void exportConstant(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
-    VeloxToArrowBridgeHolder& holder) {
+    VeloxToArrowBridgeHolder& holder,
+    const ArrowOptions& options) {
   // As per Arrow spec, REE has zero buffers and two children, `run_ends` and
   // `values`.
   out.n_buffers = 0;
@@ -809,7 +958,7 @@ void exportConstant(
   out.n_children = 2;
   holder.resizeChildren(2);
   out.children = holder.getChildrenArrays();
-  exportConstantValue(vec, *holder.allocateChild(1), pool);
+  exportConstantValue(vec, *holder.allocateChild(1), pool, options);
 
   // Create the run ends child.
   auto* runEnds = holder.allocateChild(0);
@@ -837,7 +986,8 @@ void exportToArrowImpl(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
   auto holder = std::make_unique<VeloxToArrowBridgeHolder>();
   out.buffers = holder->getArrowBuffers();
   out.length = rows.count();
@@ -847,22 +997,25 @@ void exportToArrowImpl(
 
   switch (vec.encoding()) {
     case VectorEncoding::Simple::FLAT:
-      exportFlat(vec, rows, out, pool, *holder);
+      exportFlat(vec, rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::ROW:
-      exportRows(*vec.asUnchecked<RowVector>(), rows, out, pool, *holder);
+      exportRows(
+          *vec.asUnchecked<RowVector>(), rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::ARRAY:
-      exportArrays(*vec.asUnchecked<ArrayVector>(), rows, out, pool, *holder);
+      exportArrays(
+          *vec.asUnchecked<ArrayVector>(), rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::MAP:
-      exportMaps(*vec.asUnchecked<MapVector>(), rows, out, pool, *holder);
+      exportMaps(
+          *vec.asUnchecked<MapVector>(), rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::DICTIONARY:
-      exportDictionary(vec, rows, out, pool, *holder);
+      exportDictionary(vec, rows, out, pool, *holder, options);
       break;
     case VectorEncoding::Simple::CONSTANT:
-      exportConstant(vec, rows, out, pool, *holder);
+      exportConstant(vec, rows, out, pool, *holder, options);
       break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
@@ -876,11 +1029,16 @@ void exportToArrowImpl(
 void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
-    memory::MemoryPool* pool) {
-  exportToArrowImpl(*vector, Selection(vector->size()), arrowArray, pool);
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
+  exportToArrowImpl(
+      *vector, Selection(vector->size()), arrowArray, pool, options);
 }
 
-void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
+void exportToArrow(
+    const VectorPtr& vec,
+    ArrowSchema& arrowSchema,
+    const ArrowOptions& options) {
   auto& type = vec->type();
 
   arrowSchema.name = nullptr;
@@ -900,7 +1058,7 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
     arrowSchema.format = "i";
     bridgeHolder->dictionary = std::make_unique<ArrowSchema>();
     arrowSchema.dictionary = bridgeHolder->dictionary.get();
-    exportToArrow(vec->valueVector(), *arrowSchema.dictionary);
+    exportToArrow(vec->valueVector(), *arrowSchema.dictionary, options);
 
   } else if (vec->encoding() == VectorEncoding::Simple::CONSTANT) {
     // Arrow REE spec available in
@@ -914,10 +1072,10 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
 
     // Contants of complex types are stored in the `values` vector.
     if (valueVector != nullptr) {
-      exportToArrow(valueVector, *valuesChild);
+      exportToArrow(valueVector, *valuesChild, options);
     } else {
       valuesChild->format =
-          exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+          exportArrowFormatStr(type, options, bridgeHolder->formatBuffer);
     }
 
     bridgeHolder->setChildAtIndex(
@@ -925,7 +1083,8 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
     bridgeHolder->setChildAtIndex(1, std::move(valuesChild), arrowSchema);
 
   } else {
-    arrowSchema.format = exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+    arrowSchema.format =
+        exportArrowFormatStr(type, options, bridgeHolder->formatBuffer);
     arrowSchema.dictionary = nullptr;
 
     if (type->kind() == TypeKind::MAP) {
@@ -940,14 +1099,14 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
           0,
           std::vector<VectorPtr>{maps.mapKeys(), maps.mapValues()},
           maps.getNullCount());
-      exportToArrow(rows, *child);
+      exportToArrow(rows, *child, options);
       child->name = "entries";
       bridgeHolder->setChildAtIndex(0, std::move(child), arrowSchema);
 
     } else if (type->kind() == TypeKind::ARRAY) {
       auto child = std::make_unique<ArrowSchema>();
       auto& arrays = *vec->asUnchecked<ArrayVector>();
-      exportToArrow(arrays.elements(), *child);
+      exportToArrow(arrays.elements(), *child, options);
       // Name is required, and "item" is the default name used in arrow itself.
       child->name = "item";
       bridgeHolder->setChildAtIndex(0, std::move(child), arrowSchema);
@@ -980,7 +1139,7 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
         try {
           auto& currentSchema = bridgeHolder->childrenOwned[i];
           currentSchema = std::make_unique<ArrowSchema>();
-          exportToArrow(rows.childAt(i), *currentSchema);
+          exportToArrow(rows.childAt(i), *currentSchema, options);
           currentSchema->name = bridgeHolder->rowType->nameOf(i).data();
           arrowSchema.children[i] = currentSchema.get();
         } catch (const VeloxException& e) {
@@ -1035,6 +1194,16 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       // Mapping it to ttn for now.
       if (format[1] == 't' && format[2] == 'n') {
@@ -1102,6 +1271,12 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
           return ROW(std::move(childNames), std::move(childTypes));
         }
 
+        // Run-end encoded. The type is the type of the values.
+        case 'r':
+          VELOX_CHECK_EQ(arrowSchema.n_children, 2);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[1]);
+          return importFromArrow(*arrowSchema.children[1]);
+
         default:
           break;
       }
@@ -1248,6 +1423,120 @@ VectorPtr createDictionaryVector(
       std::move(wrapped));
 }
 
+// Imports run-end encoded arrays as a constant vector if there is one run and
+// as a dictionary over the values otherwise. The values are not copied.
+VectorPtr createRunEndEncodedVector(
+    memory::MemoryPool* pool,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer) {
+  VELOX_USER_CHECK_EQ(
+      arrowArray.n_children,
+      2,
+      "Expecting two children for run-end encoded arrays.");
+  const auto& runEnds = *arrowArray.children[0];
+  VELOX_USER_CHECK_EQ(
+      runEnds.offset,
+      0,
+      "Offsets are not supported during arrow conversion yet.");
+  auto values = importFromArrowImpl(
+      *arrowSchema.children[1], *arrowArray.children[1], pool, isViewer);
+  const auto length = arrowArray.length;
+  if (runEnds.length == 1) {
+    return BaseVector::wrapInConstant(length, 0, std::move(values));
+  }
+
+  auto indices = allocateIndices(length, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  auto expandRuns = [&](const auto* rawRunEnds) {
+    int64_t row = 0;
+    for (int64_t run = 0; run < runEnds.length && row < length; ++run) {
+      const auto end = std::min<int64_t>(rawRunEnds[run], length);
+      std::fill(rawIndices + row, rawIndices + end, run);
+      row = end;
+    }
+    VELOX_USER_CHECK_EQ(row, length, "Run ends do not cover the array.");
+  };
+  const auto runEndsType = importFromArrow(*arrowSchema.children[0]);
+  switch (runEndsType->kind()) {
+    case TypeKind::SMALLINT:
+      expandRuns(static_cast<const int16_t*>(runEnds.buffers[1]));
+      break;
+    case TypeKind::INTEGER:
+      expandRuns(static_cast<const int32_t*>(runEnds.buffers[1]));
+      break;
+    case TypeKind::BIGINT:
+      expandRuns(static_cast<const int64_t*>(runEnds.buffers[1]));
+      break;
+    default:
+      VELOX_USER_FAIL(
+          "Unsupported run ends type: {}", runEndsType->toString());
+  }
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), length, std::move(values));
+}
+
+// Imports Arrow string or binary views. The views of non-inlined strings are
+// rewritten to point into the data buffers, which are not copied.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* views =
+      static_cast<const ArrowBinaryView*>(arrowArray.buffers[1]);
+  const auto* bufferSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+
+  const auto length = arrowArray.length;
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  std::vector<bool> usedBuffers(numDataBuffers);
+  for (int64_t i = 0; i < length; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+      continue;
+    }
+    const auto& view = views[i];
+    if (StringView::isInline(view.size)) {
+      rawStringViews[i] = StringView(
+          reinterpret_cast<const char*>(&view) + sizeof(view.size), view.size);
+      continue;
+    }
+    VELOX_USER_CHECK_LT(view.bufferIndex, numDataBuffers);
+    rawStringViews[i] = StringView(
+        static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]) +
+            view.offset,
+        view.size);
+    usedBuffers[view.bufferIndex] = true;
+  }
+
+  std::vector<BufferPtr> stringBuffers;
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    if (usedBuffers[i]) {
+      stringBuffers.push_back(
+          wrapInBufferView(arrowArray.buffers[2 + i], bufferSizes[i]));
+    }
+  }
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 VectorPtr createTimestampVector(
     memory::MemoryPool* pool,
     const TypePtr& type,
@@ -1318,6 +1607,15 @@ VectorPtr importFromArrowImpl(
         pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
   }
 
+  if (strcmp(arrowSchema.format, "+r") == 0) {
+    return createRunEndEncodedVector(pool, arrowSchema, arrowArray, isViewer);
+  }
+
+  if (arrowSchema.format[0] == 'v') {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  }
+
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
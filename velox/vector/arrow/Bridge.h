@@ -27,6 +27,16 @@ struct ArrowSchema;
 
 namespace facebook::velox {
 
+/// Options of the export of a Velox vector and its type to Arrow. Pass the
+/// same options to the export of the ArrowArray and of the ArrowSchema.
+struct ArrowOptions {
+  /// Export VARCHAR and VARBINARY as Arrow string and binary views (formats
+  /// "vu" and "vz"), which reference the string buffers of the vector instead
+  /// of copying the strings into one buffer. The consumer must support the
+  /// view layout, which is new in Arrow 15.
+  bool exportToStringView{false};
+};
+
 /// Export a generic Velox Vector to an ArrowArray, as defined by Arrow's C data
 /// interface:
 ///
@@ -57,7 +67,8 @@ namespace facebook::velox {
 void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    const ArrowOptions& options = {});
 
 /// Export the type of a Velox vector to an ArrowSchema.
 ///
@@ -78,7 +89,10 @@ void exportToArrow(
 ///
 /// NOTE: Since Arrow couples type and encoding, we need both Velox type and
 /// actual data (containing encoding) to create an ArrowSchema.
-void exportToArrow(const VectorPtr&, ArrowSchema&);
+void exportToArrow(
+    const VectorPtr&,
+    ArrowSchema&,
+    const ArrowOptions& options = {});
 
 /// Import an ArrowSchema into a Velox Type object.
 ///
@@ -107,7 +121,9 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema);
 /// carry a pointer to it, but not really used in most cases - unless the
 /// conversion itself requires a new allocation. In most cases no new
 /// allocations are required, unless for arrays of varchars (or varbinaries) and
-/// complex types written out of order.
+/// complex types written out of order. String and binary views and run-end
+/// encoded arrays are imported without copying the strings or the values;
+/// only the views and the indices of the runs are written.
 ///
 /// The new Velox vector returned contains only references to the underlying
 /// buffers, so it's the client's responsibility to ensure the buffer's
@@ -1318,6 +1318,110 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     });
   }
 
+  // Exports 'input' with 'options' and imports it back.
+  VectorPtr roundTrip(const VectorPtr& input, const ArrowOptions& options) {
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    velox::exportToArrow(input, arrowSchema, options);
+    velox::exportToArrow(input, arrowArray, pool_.get(), options);
+    auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    if (isViewer()) {
+      // Keeps the exported buffers alive while 'output' is used.
+      exported_.push_back({arrowSchema, arrowArray});
+    } else {
+      EXPECT_FALSE(arrowSchema.release);
+      EXPECT_FALSE(arrowArray.release);
+    }
+    return output;
+  }
+
+  void assertEqualValues(const VectorPtr& expected, const VectorPtr& actual) {
+    ASSERT_EQ(*expected->type(), *actual->type());
+    ASSERT_EQ(expected->size(), actual->size());
+    for (auto i = 0; i < expected->size(); ++i) {
+      ASSERT_TRUE(expected->equalValueAt(actual.get(), i, i)) << i;
+    }
+  }
+
+  void testImportStringView() {
+    static const char* kNotInStringBuffers =
+        "a string that is not in the string buffers of the vector";
+    auto input = vectorMaker_.flatVectorNullable<std::string>({
+        "inlined",
+        "a string that is too long to be inlined",
+        std::nullopt,
+        "",
+        "another string that is too long to be inlined",
+        "",
+    });
+    input->asFlatVector<StringView>()->setNoCopy(
+        5, StringView(kNotInStringBuffers));
+
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    const ArrowOptions options{.exportToStringView = true};
+    velox::exportToArrow(input, arrowSchema, options);
+    velox::exportToArrow(input, arrowArray, pool_.get(), options);
+    EXPECT_STREQ(arrowSchema.format, "vu");
+    // The nulls, the views, the string buffers of 'input', the copy of the
+    // string that is not in them and the sizes of the string buffers.
+    const auto numStringBuffers =
+        input->asFlatVector<StringView>()->stringBuffers().size();
+    EXPECT_EQ(arrowArray.n_buffers, numStringBuffers + 4);
+    arrowSchema.release(&arrowSchema);
+    arrowArray.release(&arrowArray);
+
+    auto output = roundTrip(input, options);
+    assertEqualValues(input, output);
+    // The non-inlined strings point into the exported string buffers.
+    EXPECT_EQ(
+        output->asFlatVector<StringView>()->valueAt(1).data(),
+        input->asFlatVector<StringView>()->valueAt(1).data());
+
+    auto binary = vectorMaker_.flatVectorNullable<std::string>(
+        {"binary that is not inlined", std::nullopt, "binary"}, VARBINARY());
+    assertEqualValues(binary, roundTrip(binary, options));
+
+    using StringArray = std::vector<std::optional<std::string>>;
+    auto strings = vectorMaker_.arrayVectorNullable<std::string>(
+        {StringArray{"a", "a string that is too long to be inlined"},
+         std::nullopt,
+         StringArray{"b"}});
+    assertEqualValues(strings, roundTrip(strings, options));
+  }
+
+  void testImportRunEndEncoded() {
+    // Constant vectors are exported as one run.
+    auto constant = BaseVector::createConstant(
+        VARCHAR(), std::string("a constant string"), 1'000, pool_.get());
+    auto output = roundTrip(constant, {});
+    EXPECT_EQ(output->encoding(), VectorEncoding::Simple::CONSTANT);
+    assertEqualValues(constant, output);
+
+    // Several runs of int16 run ends.
+    const int16_t runEnds[] = {3, 4, 8};
+    const int64_t values[] = {10, 20, 30};
+    const void* runEndsBuffers[] = {nullptr, runEnds};
+    const void* valuesBuffers[] = {nullptr, values};
+    auto runEndsSchema = makeArrowSchema("s");
+    auto valuesSchema = makeArrowSchema("l");
+    auto runEndsArray = makeArrowArray(runEndsBuffers, 2, 3, 0);
+    auto valuesArray = makeArrowArray(valuesBuffers, 2, 3, 0);
+    ArrowSchema* schemaChildren[] = {&runEndsSchema, &valuesSchema};
+    ArrowArray* arrayChildren[] = {&runEndsArray, &valuesArray};
+    auto arrowSchema = makeArrowSchema("+r");
+    arrowSchema.n_children = 2;
+    arrowSchema.children = schemaChildren;
+    auto arrowArray = makeArrowArray(nullptr, 0, 8, 0);
+    arrowArray.n_children = 2;
+    arrowArray.children = arrayChildren;
+    output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    EXPECT_EQ(output->encoding(), VectorEncoding::Simple::DICTIONARY);
+    assertEqualValues(
+        vectorMaker_.flatVector<int64_t>({10, 10, 10, 20, 30, 30, 30, 30}),
+        output);
+  }
+
   void testImportFailures() {
     ArrowSchema arrowSchema;
     ArrowArray arrowArray;
@@ -1377,6 +1481,21 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
   }
 
   std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+
+  struct Exported {
+    ArrowSchema schema;
+    ArrowArray array;
+  };
+
+  void TearDown() override {
+    for (auto& exported : exported_) {
+      exported.schema.release(&exported.schema);
+      exported.array.release(&exported.array);
+    }
+  }
+
+  // The exports of roundTrip() in viewer mode.
+  std::vector<Exported> exported_;
 };
 
 class ArrowBridgeArrayImportAsViewerTest : public ArrowBridgeArrayImportTest {
@@ -1421,6 +1540,14 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, dictionary) {
   testImportDictionary();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
+TEST_F(ArrowBridgeArrayImportAsViewerTest, runEndEncoded) {
+  testImportRunEndEncoded();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, failures) {
   testImportFailures();
 }
@@ -1468,6 +1595,14 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, dictionary) {
   testImportDictionary();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, runEndEncoded) {
+  testImportRunEndEncoded();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, failures) {
   testImportFailures();
 }
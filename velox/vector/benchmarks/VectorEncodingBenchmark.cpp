@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <sstream>
+
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/VectorSaver.h"
+#include "velox/vector/arrow/Bridge.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int32(vector_size, 10'000, "Number of rows of the benchmarked vectors");
+DEFINE_double(null_ratio, 0.1, "Ratio of nulls in the benchmarked vectors");
+DEFINE_int32(fuzzer_seed, 1, "Seed of the VectorFuzzer making the vectors");
+
+// Measures the core vector APIs over vectors of different types and encodings
+// made by VectorFuzzer. Each benchmark processes all rows of one vector per
+// iteration, so that the reported iters/s is rows per second. Run with --json
+// to get the results in a form that can be compared across releases.
+
+using namespace facebook::velox;
+
+namespace {
+
+enum class Encoding { kFlat, kConstant, kDictionary };
+
+std::string encodingName(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kFlat:
+      return "flat";
+    case Encoding::kConstant:
+      return "constant";
+    case Encoding::kDictionary:
+      return "dictionary";
+  }
+  VELOX_UNREACHABLE();
+}
+
+class VectorEncodingBenchmark {
+ public:
+  VectorEncodingBenchmark() : fuzzer_(fuzzerOptions(), pool_.get()) {}
+
+  void addBenchmarks(const TypePtr& type, Encoding encoding) {
+    auto vector = makeVector(type, encoding);
+    const auto name = fmt::format(
+        "{}_{}", encodingName(encoding), type->toString());
+    const auto size = vector->size();
+    const SelectivityVector rows(size);
+
+    add("decode", name, [vector, rows]() {
+      DecodedVector decoded(*vector, rows);
+      folly::doNotOptimizeAway(decoded.base());
+    });
+
+    add("compare", name, [vector, size]() {
+      const CompareFlags flags;
+      for (auto i = 0; i < size; ++i) {
+        folly::doNotOptimizeAway(
+            vector->compare(vector.get(), i, (i + 1) % size, flags));
+      }
+    });
+
+    add("hashValueAt", name, [vector, size]() {
+      for (auto i = 0; i < size; ++i) {
+        folly::doNotOptimizeAway(vector->hashValueAt(i));
+      }
+    });
+
+    // Copies every other range of 16 rows.
+    std::vector<BaseVector::CopyRange> ranges;
+    for (auto i = 0; i + 16 <= size; i += 32) {
+      ranges.push_back({i, i, 16});
+    }
+    add("copyRanges", name, [this, vector, size, ranges]() {
+      auto target = BaseVector::create(vector->type(), size, pool_.get());
+      target->copyRanges(vector.get(), ranges);
+      folly::doNotOptimizeAway(target);
+    });
+
+    add("wrapInDictionary", name, [this, vector, size]() {
+      auto indices = allocateIndices(size, pool_.get());
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      for (auto i = 0; i < size; ++i) {
+        rawIndices[i] = size - 1 - i;
+      }
+      folly::doNotOptimizeAway(
+          BaseVector::wrapInDictionary(nullptr, indices, size, vector));
+    });
+
+    add("flattenVector", name, [vector]() {
+      auto copy = vector;
+      BaseVector::flattenVector(copy);
+      folly::doNotOptimizeAway(copy);
+    });
+
+    add("vectorSaver", name, [this, vector]() {
+      std::stringstream stream;
+      saveVector(*vector, stream);
+      folly::doNotOptimizeAway(restoreVector(stream, pool_.get()));
+    });
+
+    add("arrowBridge", name, [this, vector]() {
+      ArrowArray array;
+      ArrowSchema schema;
+      exportToArrow(vector, array, pool_.get());
+      exportToArrow(vector, schema);
+      folly::doNotOptimizeAway(
+          importFromArrowAsOwner(schema, array, pool_.get()));
+    });
+  }
+
+ private:
+  static VectorFuzzer::Options fuzzerOptions() {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_vector_size;
+    options.nullRatio = FLAGS_null_ratio;
+    options.stringVariableLength = true;
+    options.containerVariableLength = true;
+    return options;
+  }
+
+  VectorPtr makeVector(const TypePtr& type, Encoding encoding) {
+    fuzzer_.reSeed(FLAGS_fuzzer_seed);
+    switch (encoding) {
+      case Encoding::kFlat:
+        return fuzzer_.fuzzFlat(type);
+      case Encoding::kConstant:
+        return fuzzer_.fuzzConstant(type);
+      case Encoding::kDictionary:
+        return fuzzer_.fuzzDictionary(fuzzer_.fuzzFlat(type));
+    }
+    VELOX_UNREACHABLE();
+  }
+
+  // Adds a benchmark that runs 'func' once per iteration and counts the rows
+  // of the vector as the iterations.
+  void add(
+      const std::string& operation,
+      const std::string& name,
+      std::function<void()> func) {
+    folly::addBenchmark(
+        __FILE__,
+        fmt::format("{}_{}", operation, name),
+        [func = std::move(func)](unsigned iters) {
+          for (auto i = 0; i < iters; ++i) {
+            func();
+          }
+          return iters * FLAGS_vector_size;
+        });
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::addDefaultLeafMemoryPool()};
+  VectorFuzzer fuzzer_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  VectorEncodingBenchmark benchmark;
+  const std::vector<TypePtr> types = {
+      BIGINT(),
+      DOUBLE(),
+      VARCHAR(),
+      ARRAY(BIGINT()),
+      MAP(BIGINT(), VARCHAR()),
+      ROW({BIGINT(), VARCHAR()})};
+  for (const auto& type : types) {
+    for (auto encoding :
+         {Encoding::kFlat, Encoding::kConstant, Encoding::kDictionary}) {
+      benchmark.addBenchmarks(type, encoding);
+    }
+  }
+  folly::runBenchmarks();
+  return 0;
+}
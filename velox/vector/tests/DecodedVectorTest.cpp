@@ -565,6 +565,76 @@ TEST_F(DecodedVectorTest, dictionary) {
       1000, [](vector_size_t i) { return std::make_shared<int>(i % 5); });
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  std::vector<std::optional<int64_t>> data = {
+      1, 1, 1, 2, 2, std::nullopt, std::nullopt, 3, 3, 3, 3, 4};
+  auto sequence = vectorMaker_.sequenceVector<int64_t>(data);
+  ASSERT_EQ(sequence->encoding(), VectorEncoding::Simple::SEQUENCE);
+
+  SelectivityVector rows(data.size());
+  DecodedVector decoded(*sequence, rows);
+  ASSERT_FALSE(decoded.isIdentityMapping());
+  ASSERT_FALSE(decoded.isConstantMapping());
+  // The run values are the base and are not expanded.
+  ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+  for (auto i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(decoded.isNullAt(i), !data[i].has_value()) << i;
+    if (data[i].has_value()) {
+      ASSERT_EQ(decoded.valueAt<int64_t>(i), data[i].value()) << i;
+    }
+  }
+
+  // A dictionary over the runs.
+  auto indices = makeIndices(
+      data.size(), [&](auto row) { return data.size() - 1 - row; });
+  auto dictionary =
+      BaseVector::wrapInDictionary(nullptr, indices, data.size(), sequence);
+  decoded.decode(*dictionary, rows);
+  ASSERT_EQ(decoded.base(), sequence->valueVector().get());
+  for (auto i = 0; i < data.size(); ++i) {
+    const auto& expected = data[data.size() - 1 - i];
+    ASSERT_EQ(decoded.isNullAt(i), !expected.has_value()) << i;
+    if (expected.has_value()) {
+      ASSERT_EQ(decoded.valueAt<int64_t>(i), expected.value()) << i;
+    }
+  }
+}
+
+TEST_F(DecodedVectorTest, nestedDictionaryWithoutNulls) {
+  // A size that is not a multiple of the SIMD width.
+  constexpr vector_size_t kSize = 1'003;
+  auto flat = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto innerIndices =
+      makeIndices(kSize, [](auto row) { return (row * 7) % kSize; });
+  auto outerIndices =
+      makeIndices(kSize, [](auto row) { return kSize - row - 1; });
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr,
+      outerIndices,
+      kSize,
+      BaseVector::wrapInDictionary(nullptr, innerIndices, kSize, flat));
+  auto expected = [&](auto row) { return ((kSize - row - 1) * 7) % kSize; };
+
+  SelectivityVector allRows(kSize);
+  DecodedVector decoded(*dictionary, allRows);
+  ASSERT_EQ(decoded.base(), flat.get());
+  for (auto i = 0; i < kSize; ++i) {
+    ASSERT_EQ(decoded.index(i), expected(i)) << i;
+    ASSERT_EQ(decoded.valueAt<int64_t>(i), expected(i)) << i;
+  }
+
+  // Some rows selected.
+  SelectivityVector someRows(kSize, false);
+  for (auto i = 0; i < kSize; i += 3) {
+    someRows.setValid(i, true);
+  }
+  someRows.updateBounds();
+  decoded.decode(*dictionary, someRows);
+  someRows.applyToSelected([&](auto row) {
+    ASSERT_EQ(decoded.valueAt<int64_t>(row), expected(row)) << row;
+  });
+}
+
 TEST_F(DecodedVectorTest, dictionaryOverLazy) {
   constexpr vector_size_t size = 1000;
   auto lazyVector = vectorMaker_.lazyFlatVector<int32_t>(
@@ -15,6 +15,7 @@
  */
 #include "velox/vector/VectorPool.h"
 #include <gtest/gtest.h>
+#include <unordered_set>
 #include "velox/functions/prestosql/types/JsonType.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
@@ -146,4 +147,75 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, otherScalarTypes) {
+  VectorPool vectorPool(pool());
+
+  const std::vector<TypePtr> types = {
+      DATE(), DECIMAL(10, 2), DECIMAL(20, 4), HUGEINT()};
+  std::vector<BaseVector*> rawVectors;
+  for (const auto& type : types) {
+    auto vector = vectorPool.get(type, 1'000);
+    rawVectors.push_back(vector.get());
+    ASSERT_TRUE(vectorPool.release(vector));
+  }
+  ASSERT_EQ(types.size(), vectorPool.numCachedVectors());
+
+  // Equal types get the recycled vector of the same type back.
+  for (auto i = 0; i < types.size(); ++i) {
+    auto vector = vectorPool.get(types[i], 1'000);
+    ASSERT_EQ(rawVectors[i], vector.get());
+    ASSERT_TRUE(vector->type()->equivalent(*types[i]));
+  }
+  ASSERT_EQ(0, vectorPool.numCachedVectors());
+
+  // A different decimal type does not reuse a cached decimal vector.
+  auto vector = vectorPool.get(DECIMAL(10, 2), 1'000);
+  auto* rawVector = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  vector = vectorPool.get(DECIMAL(12, 2), 1'000);
+  ASSERT_NE(rawVector, vector.get());
+  ASSERT_EQ(1, vectorPool.numCachedVectors());
+
+  // Complex types are not supported.
+  vector = vectorPool.get(ARRAY(BIGINT()), 1'000);
+  ASSERT_FALSE(vectorPool.release(vector));
+}
+
+TEST_F(VectorPoolTest, parent) {
+  VectorPool parent(nullptr);
+  VectorPool first(pool(), &parent);
+  VectorPool second(pool(), &parent);
+
+  // Vectors that do not fit in 'first' go to 'parent'.
+  std::vector<VectorPtr> vectors;
+  for (auto i = 0; i < 15; ++i) {
+    vectors.push_back(first.get(BIGINT(), 1'000));
+  }
+  std::unordered_set<BaseVector*> rawVectors;
+  for (auto& vector : vectors) {
+    rawVectors.insert(vector.get());
+  }
+  ASSERT_EQ(15, first.release(vectors));
+  ASSERT_EQ(10, first.numCachedVectors());
+  ASSERT_EQ(5, parent.numCachedVectors());
+
+  // 'second' reuses the vectors released by 'first' through 'parent'.
+  for (auto i = 0; i < 5; ++i) {
+    auto vector = second.get(BIGINT(), 1'000);
+    ASSERT_EQ(1, rawVectors.count(vector.get()));
+  }
+  ASSERT_EQ(0, parent.numCachedVectors());
+  auto vector = second.get(BIGINT(), 1'000);
+  ASSERT_EQ(0, rawVectors.count(vector.get()));
+
+  // Clearing 'first' does not affect 'parent'.
+  ASSERT_TRUE(second.release(vector));
+  ASSERT_GE(first.retainedSize(), 10 * 1'000 * sizeof(int64_t));
+  ASSERT_EQ(10, first.clear());
+  ASSERT_EQ(0, first.numCachedVectors());
+  ASSERT_EQ(0, first.retainedSize());
+  ASSERT_EQ(1, second.numCachedVectors());
+  ASSERT_EQ(0, parent.numCachedVectors());
+}
 } // namespace facebook::velox::test
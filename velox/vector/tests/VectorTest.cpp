@@ -1767,6 +1767,67 @@ TEST_F(VectorTest, copyNoRows) {
   }
 }
 
+TEST_F(VectorTest, copyRangesOfFlatArrays) {
+  auto source = makeArrayVectorFromJson<int32_t>(
+      {"[1, 2]", "null", "[]", "[3]", "[4, 5, 6]", "null", "[7]"});
+  auto target = makeArrayVectorFromJson<int32_t>(
+      {"[10]", "[11, 12]", "null", "[13]", "[14]", "[15]"});
+  const std::vector<BaseVector::CopyRange> ranges = {
+      {.sourceIndex = 0, .targetIndex = 1, .count = 2},
+      {.sourceIndex = 3, .targetIndex = 3, .count = 3},
+  };
+  target->copyRanges(source.get(), ranges);
+  auto expected = makeArrayVectorFromJson<int32_t>(
+      {"[10]", "[1, 2]", "null", "[3]", "[4, 5, 6]", "null"});
+  test::assertEqualVectors(expected, target);
+
+  auto maps = makeMapVectorFromJson<int32_t, int64_t>(
+      {"{1: 10}", "null", "{2: 20, 3: 30}"});
+  auto mapTarget =
+      makeMapVectorFromJson<int32_t, int64_t>({"{}", "{4: 40}", "{5: 50}"});
+  const std::vector<BaseVector::CopyRange> mapRanges = {
+      {.sourceIndex = 1, .targetIndex = 0, .count = 2},
+  };
+  mapTarget->copyRanges(maps.get(), mapRanges);
+  test::assertEqualVectors(
+      makeMapVectorFromJson<int32_t, int64_t>(
+          {"null", "{2: 20, 3: 30}", "{5: 50}"}),
+      mapTarget);
+}
+
+TEST_F(VectorTest, compactStringBuffers) {
+  auto source = makeFlatVector<std::string>(1'000, [](auto row) {
+    return fmt::format("a string that is not inlined {}", row);
+  });
+
+  // A copy of a few rows shares the string buffers of 'source'.
+  VectorPtr copy = BaseVector::create(VARCHAR(), 10, pool_.get());
+  copy->copy(source.get(), 0, 500, 10);
+  const auto retainedSize = copy->retainedSize();
+  auto expected = makeFlatVector<std::string>(10, [](auto row) {
+    return fmt::format("a string that is not inlined {}", 500 + row);
+  });
+  ASSERT_TRUE(copy->asFlatVector<StringView>()->compactStringBuffers(50));
+  ASSERT_LT(copy->retainedSize(), retainedSize);
+  test::assertEqualVectors(expected, copy);
+  // Nothing more to compact.
+  ASSERT_FALSE(copy->asFlatVector<StringView>()->compactStringBuffers(50));
+
+  // A dictionary over a few rows of 'source' is flattened and compacted. A
+  // vector referenced elsewhere is not changed.
+  VectorPtr dictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndices(10, [](auto row) { return 500 + row; }), 10, source);
+  auto row = makeRowVector({dictionary, source});
+  VectorPtr rowVector = row;
+  row.reset();
+  BaseVector::compactStringBuffers(rowVector, 50);
+  auto* rowChildren = rowVector->asUnchecked<RowVector>();
+  ASSERT_EQ(rowChildren->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_LT(rowChildren->childAt(0)->retainedSize(), source->retainedSize());
+  test::assertEqualVectors(expected, rowChildren->childAt(0));
+  ASSERT_EQ(rowChildren->childAt(1), source);
+}
+
 TEST_F(VectorTest, copyAscii) {
   std::vector<std::string> stringData = {"a", "b", "c"};
   auto source = makeFlatVector(stringData);